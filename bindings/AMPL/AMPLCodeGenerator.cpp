@@ -0,0 +1,480 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include "AMPLCodeGenerator.hpp"
+#include "symbolic/Range.hpp"
+
+// include the fg reader of the AMPL Solver Library (ASL): its expression graphs are not rewritten for the evaluation of Hessians.
+// The opcodes are stored instead of the evaluation functions (as in nlc)
+extern "C" {
+#include "nlp.h"
+#include "opcode.hd"
+}
+
+namespace uno {
+   namespace {
+      // node of the expression graph of a function
+      struct Node {
+         std::string statements{}; // statements that precede the definition of the value
+         std::string value{}; // expression of the value in terms of the locals of the previous nodes
+         std::vector<std::pair<size_t, std::string>> partial_derivatives{}; // (argument node, partial derivative)
+         int variable_index{-1}; // index of the variable if the node is a leaf
+      };
+
+      std::string literal(double number) {
+         if (std::isnan(number)) {
+            return "NAN";
+         }
+         if (std::isinf(number)) {
+            return (0. < number) ? "INFINITY" : "(-INFINITY)";
+         }
+         // hexadecimal literals are exact
+         std::ostringstream stream;
+         stream << '(' << std::hexfloat << number << ')';
+         return stream.str();
+      }
+
+      std::string local(size_t node_index) {
+         return "t" + std::to_string(node_index);
+      }
+
+      std::string adjoint(size_t node_index) {
+         return "a" + std::to_string(node_index);
+      }
+
+      // linearization of the expression graph of a function in topological order
+      class Tape {
+      public:
+         explicit Tape(ASL_fg* asl): asl(asl) { }
+
+         size_t record(const expr* expression) {
+            const auto [iterator, inserted] = this->expression_nodes.try_emplace(expression, 0);
+            if (inserted) {
+               iterator->second = this->record_node(expression);
+            }
+            return iterator->second;
+         }
+
+         [[nodiscard]] const std::vector<Node>& get_nodes() const {
+            return this->nodes;
+         }
+
+      private:
+         ASL_fg* const asl;
+         std::vector<Node> nodes{};
+         std::unordered_map<const expr*, size_t> expression_nodes{};
+         std::unordered_map<int, size_t> variable_nodes{}; // variables and common expressions
+
+         size_t add(Node&& node) {
+            this->nodes.emplace_back(std::move(node));
+            return this->nodes.size() - 1;
+         }
+
+         size_t unary_node(const expr* expression, const std::string& function, const std::string& derivative) {
+            const size_t argument = this->record(expression->L.e);
+            const std::string a = local(argument);
+            const std::string t = local(this->nodes.size());
+            std::string partial_derivative = derivative;
+            // the placeholders "a" (argument) and "t" (value) are replaced with the locals
+            for (size_t position = partial_derivative.find('#'); position != std::string::npos; position = partial_derivative.find('#')) {
+               partial_derivative.replace(position, 2, (partial_derivative[position + 1] == 'a') ? a : t);
+            }
+            return this->add({"", function + "(" + a + ")", {{argument, partial_derivative}}, -1});
+         }
+
+         size_t constant_node(const std::string& value) {
+            return this->add({"", value, {}, -1});
+         }
+
+         size_t variable_node(int index) {
+            const auto iterator = this->variable_nodes.find(index);
+            if (iterator != this->variable_nodes.end()) {
+               return iterator->second;
+            }
+            size_t node_index;
+            const int number_variables = this->asl->i.n_var_;
+            if (index < number_variables) {
+               node_index = this->add({"", "x[" + std::to_string(index) + "]", {}, index});
+            }
+            else {
+               // common expression: nonlinear part + linear part
+               const int number_common_expressions0 = this->asl->i.comb_ + this->asl->i.comc_ + this->asl->i.como_;
+               const int common_expression_index = index - number_variables;
+               const expr* nonlinear_part;
+               const linpart* linear_part;
+               int linear_part_size;
+               if (common_expression_index < number_common_expressions0) {
+                  const cexp& common_expression = this->asl->I.cexps_[common_expression_index];
+                  nonlinear_part = common_expression.e;
+                  linear_part = common_expression.L;
+                  linear_part_size = common_expression.nlin;
+               }
+               else {
+                  const cexp1& common_expression = this->asl->I.cexps1_[common_expression_index - number_common_expressions0];
+                  nonlinear_part = common_expression.e;
+                  linear_part = common_expression.L;
+                  linear_part_size = common_expression.nlin;
+               }
+               Node node{};
+               const size_t nonlinear_node = this->record(nonlinear_part);
+               node.value = local(nonlinear_node);
+               node.partial_derivatives.emplace_back(nonlinear_node, "1.");
+               for (int term_index = 0; term_index < linear_part_size; term_index++) {
+                  // the linear terms point to the values of the variables (or common expressions) in var_e
+                  const expr_v* variable = reinterpret_cast<const expr_v*>(reinterpret_cast<const char*>(linear_part[term_index].v.rp) -
+                        offsetof(expr_v, v));
+                  const size_t term_node = this->variable_node(static_cast<int>(variable - this->asl->I.var_e_));
+                  const std::string coefficient = literal(linear_part[term_index].fac);
+                  node.value += " + " + coefficient + "*" + local(term_node);
+                  node.partial_derivatives.emplace_back(term_node, coefficient);
+               }
+               node_index = this->add(std::move(node));
+            }
+            this->variable_nodes[index] = node_index;
+            return node_index;
+         }
+
+         // minimum or maximum of a list: the partial derivatives select the first extremal argument
+         size_t extremum_node(const expr* expression, const char* comparison) {
+            std::vector<size_t> arguments{};
+            for (expr** argument = expression->L.ep; argument < expression->R.ep; argument++) {
+               arguments.emplace_back(this->record(*argument));
+            }
+            const size_t node_index = this->nodes.size();
+            const std::string selected = "i" + std::to_string(node_index);
+            Node node{};
+            node.statements = "double m" + std::to_string(node_index) + " = " + local(arguments[0]) + "; int " + selected + " = 0;\n";
+            for (size_t argument_index: Range(1, arguments.size())) {
+               node.statements += "   if (" + local(arguments[argument_index]) + " " + comparison + " m" + std::to_string(node_index) +
+                     ") { m" + std::to_string(node_index) + " = " + local(arguments[argument_index]) + "; " + selected + " = " +
+                     std::to_string(argument_index) + "; }\n";
+            }
+            node.value = "m" + std::to_string(node_index);
+            for (size_t argument_index: Range(arguments.size())) {
+               node.partial_derivatives.emplace_back(arguments[argument_index], "(" + selected + " == " + std::to_string(argument_index) +
+                     " ? 1. : 0.)");
+            }
+            return this->add(std::move(node));
+         }
+
+         size_t record_node(const expr* expression) {
+            const int opcode = static_cast<int>(reinterpret_cast<std::uintptr_t>(expression->op));
+            switch (opcode) {
+               case OPNUM:
+                  return this->constant_node(literal(reinterpret_cast<const expr_n*>(expression)->v));
+               case OPVARVAL:
+                  return this->variable_node(static_cast<int>(reinterpret_cast<const expr_v*>(expression) - this->asl->I.var_e_));
+               case OPUMINUS:
+                  return this->unary_node(expression, "-", "-1.");
+               case FLOOR:
+                  return this->unary_node(expression, "std::floor", "0.");
+               case CEIL:
+                  return this->unary_node(expression, "std::ceil", "0.");
+               case ABS:
+                  return this->unary_node(expression, "std::fabs", "(0. <= #a ? 1. : -1.)");
+               case OP2POW:
+                  return this->unary_node(expression, "square", "2.*#a");
+               case OP_sqrt:
+                  return this->unary_node(expression, "std::sqrt", "0.5/#t");
+               case OP_exp:
+                  return this->unary_node(expression, "std::exp", "#t");
+               case OP_log:
+                  return this->unary_node(expression, "std::log", "1./#a");
+               case OP_log10:
+                  return this->unary_node(expression, "std::log10", "1./(#a*std::log(10.))");
+               case OP_sin:
+                  return this->unary_node(expression, "std::sin", "std::cos(#a)");
+               case OP_cos:
+                  return this->unary_node(expression, "std::cos", "-std::sin(#a)");
+               case OP_tan:
+                  return this->unary_node(expression, "std::tan", "(1. + #t*#t)");
+               case OP_sinh:
+                  return this->unary_node(expression, "std::sinh", "std::cosh(#a)");
+               case OP_cosh:
+                  return this->unary_node(expression, "std::cosh", "std::sinh(#a)");
+               case OP_tanh:
+                  return this->unary_node(expression, "std::tanh", "(1. - #t*#t)");
+               case OP_asin:
+                  return this->unary_node(expression, "std::asin", "1./std::sqrt(1. - #a*#a)");
+               case OP_acos:
+                  return this->unary_node(expression, "std::acos", "-1./std::sqrt(1. - #a*#a)");
+               case OP_atan:
+                  return this->unary_node(expression, "std::atan", "1./(1. + #a*#a)");
+               case OP_asinh:
+                  return this->unary_node(expression, "std::asinh", "1./std::sqrt(#a*#a + 1.)");
+               case OP_acosh:
+                  return this->unary_node(expression, "std::acosh", "1./std::sqrt(#a*#a - 1.)");
+               case OP_atanh:
+                  return this->unary_node(expression, "std::atanh", "1./(1. - #a*#a)");
+               case OPNOT: {
+                  const size_t argument = this->record(expression->L.e);
+                  return this->constant_node("(" + local(argument) + " == 0. ? 1. : 0.)");
+               }
+               case OP1POW: {
+                  // constant exponent
+                  const size_t base = this->record(expression->L.e);
+                  const std::string exponent = literal(reinterpret_cast<const expr_n*>(expression->R.e)->v);
+                  return this->add({"", "std::pow(" + local(base) + ", " + exponent + ")",
+                     {{base, exponent + "*std::pow(" + local(base) + ", " + exponent + " - 1.)"}}, -1});
+               }
+               case OPCPOW: {
+                  // constant base
+                  const std::string base = literal(reinterpret_cast<const expr_n*>(expression->L.e)->v);
+                  const size_t exponent = this->record(expression->R.e);
+                  const std::string t = local(this->nodes.size());
+                  return this->add({"", "std::pow(" + base + ", " + local(exponent) + ")", {{exponent, t + "*std::log(" + base + ")"}}, -1});
+               }
+               case OPSUMLIST: {
+                  Node node{};
+                  for (expr** argument = expression->L.ep; argument < expression->R.ep; argument++) {
+                     const size_t argument_node = this->record(*argument);
+                     node.value += (node.value.empty() ? "" : " + ") + local(argument_node);
+                     node.partial_derivatives.emplace_back(argument_node, "1.");
+                  }
+                  if (node.value.empty()) {
+                     node.value = "0.";
+                  }
+                  return this->add(std::move(node));
+               }
+               case MINLIST:
+                  return this->extremum_node(expression, "<");
+               case MAXLIST:
+                  return this->extremum_node(expression, ">");
+               case OPIFnl: {
+                  const expr_if* conditional = reinterpret_cast<const expr_if*>(expression);
+                  const size_t condition = this->record(conditional->e);
+                  const size_t then_branch = this->record(conditional->T);
+                  const size_t else_branch = this->record(conditional->F);
+                  const std::string c = local(condition);
+                  return this->add({"", "(" + c + " != 0. ? " + local(then_branch) + " : " + local(else_branch) + ")",
+                     {{then_branch, "(" + c + " != 0. ? 1. : 0.)"}, {else_branch, "(" + c + " != 0. ? 0. : 1.)"}}, -1});
+               }
+               default:
+                  return this->binary_node(expression, opcode);
+            }
+         }
+
+         size_t binary_node(const expr* expression, int opcode) {
+            std::string value, left_derivative, right_derivative;
+            const size_t left = this->record(expression->L.e);
+            const size_t right = this->record(expression->R.e);
+            const std::string a = local(left);
+            const std::string b = local(right);
+            const std::string t = local(this->nodes.size());
+            switch (opcode) {
+               case OPPLUS:
+                  value = a + " + " + b; left_derivative = "1."; right_derivative = "1.";
+                  break;
+               case OPMINUS:
+                  value = a + " - " + b; left_derivative = "1."; right_derivative = "-1.";
+                  break;
+               case OPMULT:
+                  value = a + "*" + b; left_derivative = b; right_derivative = a;
+                  break;
+               case OPDIV:
+                  value = a + "/" + b; left_derivative = "1./" + b; right_derivative = "-" + t + "/" + b;
+                  break;
+               case OPREM:
+                  value = "std::fmod(" + a + ", " + b + ")"; left_derivative = "1."; right_derivative = "-std::trunc(" + a + "/" + b + ")";
+                  break;
+               case OPPOW:
+                  value = "std::pow(" + a + ", " + b + ")"; left_derivative = b + "*std::pow(" + a + ", " + b + " - 1.)";
+                  right_derivative = "(0. < " + a + " ? " + t + "*std::log(" + a + ") : 0.)";
+                  break;
+               case OPLESS:
+                  value = "(" + a + " < " + b + " ? 0. : " + a + " - " + b + ")"; left_derivative = "(" + a + " < " + b + " ? 0. : 1.)";
+                  right_derivative = "(" + a + " < " + b + " ? 0. : -1.)";
+                  break;
+               case OP_atan2:
+                  value = "std::atan2(" + a + ", " + b + ")"; left_derivative = b + "/(" + a + "*" + a + " + " + b + "*" + b + ")";
+                  right_derivative = "-" + a + "/(" + a + "*" + a + " + " + b + "*" + b + ")";
+                  break;
+               case OPintDIV:
+                  value = "std::trunc(" + a + "/" + b + ")"; left_derivative = "0."; right_derivative = "0.";
+                  break;
+               case OPround:
+                  value = "std::round(" + a + "*std::pow(10., " + b + "))/std::pow(10., " + b + ")"; left_derivative = "0."; right_derivative = "0.";
+                  break;
+               case OPtrunc:
+                  value = "std::trunc(" + a + "*std::pow(10., " + b + "))/std::pow(10., " + b + ")"; left_derivative = "0."; right_derivative = "0.";
+                  break;
+               // logical operators and comparisons: piecewise constant
+               case OPOR: value = "(" + a + " != 0. || " + b + " != 0. ? 1. : 0.)"; break;
+               case OPAND: value = "(" + a + " != 0. && " + b + " != 0. ? 1. : 0.)"; break;
+               case LT: value = "(" + a + " < " + b + " ? 1. : 0.)"; break;
+               case LE: value = "(" + a + " <= " + b + " ? 1. : 0.)"; break;
+               case EQ: value = "(" + a + " == " + b + " ? 1. : 0.)"; break;
+               case GE: value = "(" + a + " >= " + b + " ? 1. : 0.)"; break;
+               case GT: value = "(" + a + " > " + b + " ? 1. : 0.)"; break;
+               case NE: value = "(" + a + " != " + b + " ? 1. : 0.)"; break;
+               default:
+                  throw std::runtime_error("The AMPL operator " + std::to_string(opcode) + " is not supported by the code generator");
+            }
+            Node node{"", value, {}, -1};
+            if (!left_derivative.empty()) {
+               node.partial_derivatives.emplace_back(left, left_derivative);
+               node.partial_derivatives.emplace_back(right, right_derivative);
+            }
+            return this->add(std::move(node));
+         }
+      };
+
+      // function of the form nonlinear part + sum of linear terms. The gradient is written at the given positions
+      void generate_function(std::ostream& stream, ASL_fg* asl, const std::string& name, const expr* nonlinear_part,
+            const std::vector<std::pair<int, double>>& linear_part, const std::unordered_map<int, size_t>& gradient_positions) {
+         Tape tape(asl);
+         const size_t root = tape.record(nonlinear_part);
+         const std::vector<Node>& nodes = tape.get_nodes();
+
+         stream << "static int " << name << "(const double* x, double* value, double* gradient) {\n";
+         for (size_t node_index: Range(nodes.size())) {
+            if (!nodes[node_index].statements.empty()) {
+               stream << "   " << nodes[node_index].statements;
+            }
+            stream << "   const double " << local(node_index) << " = " << nodes[node_index].value << ";\n";
+         }
+         stream << "   *value = " << local(root);
+         for (const auto& [variable_index, coefficient]: linear_part) {
+            // the variables that only appear nonlinearly have a zero coefficient
+            if (coefficient != 0.) {
+               stream << " + " << literal(coefficient) << "*x[" << variable_index << "]";
+            }
+         }
+         stream << ";\n";
+         stream << "   if (!std::isfinite(*value)) { return 1; }\n";
+         stream << "   if (gradient == nullptr) { return 0; }\n";
+
+         // linear part
+         for (const auto& [variable_index, coefficient]: linear_part) {
+            stream << "   gradient[" << gradient_positions.at(variable_index) << "] = " << literal(coefficient) << ";\n";
+         }
+         // reverse pass: the adjoints are propagated from the root to the leaves. The nodes with a zero adjoint are skipped, so that
+         // the branches that are not taken do not propagate non-finite partial derivatives
+         for (size_t node_index: Range(root + 1)) {
+            stream << "   double " << adjoint(node_index) << " = " << ((node_index == root) ? "1." : "0.") << ";\n";
+         }
+         for (size_t node_index = root + 1; 0 < node_index--;) {
+            const Node& node = nodes[node_index];
+            if (0 <= node.variable_index) {
+               const auto position = gradient_positions.find(node.variable_index);
+               if (position == gradient_positions.end()) {
+                  throw std::runtime_error("The variable " + std::to_string(node.variable_index) + " of the function " + name +
+                        " is not in its sparsity pattern");
+               }
+               stream << "   gradient[" << position->second << "] += " << adjoint(node_index) << ";\n";
+            }
+            else if (!node.partial_derivatives.empty()) {
+               stream << "   if (" << adjoint(node_index) << " != 0.) {\n";
+               for (const auto& [argument, partial_derivative]: node.partial_derivatives) {
+                  stream << "      " << adjoint(argument) << " += " << adjoint(node_index) << "*(" << partial_derivative << ");\n";
+               }
+               stream << "   }\n";
+            }
+         }
+         for (const auto& [variable_index, coefficient]: linear_part) {
+            stream << "   if (!std::isfinite(gradient[" << gradient_positions.at(variable_index) << "])) { return 1; }\n";
+         }
+         stream << "   return 0;\n}\n\n";
+      }
+   } // namespace
+
+   void AMPLCodeGenerator::generate(const std::string& nl_file_name, const std::vector<size_t>& jacobian_row_starts,
+         const std::vector<size_t>& jacobian_column_indices, std::ostream& stream) {
+      ASL* asl = ASL_alloc(ASL_read_fg);
+      ASL_fg* asl_fg = reinterpret_cast<ASL_fg*>(asl);
+      FILE* nl = jac0dim_ASL(asl, const_cast<char*>(nl_file_name.data()), static_cast<int>(nl_file_name.size()));
+      asl->i.Fortran_ = 0;
+      // store the opcodes in the expression graphs
+      efunc* opcodes[N_OPS];
+      for (int opcode = 0; opcode < N_OPS; opcode++) {
+         opcodes[opcode] = reinterpret_cast<efunc*>(static_cast<std::uintptr_t>(opcode));
+      }
+      asl_fg->I.r_ops_ = opcodes;
+      asl->i.want_derivs_ = 0;
+      fg_read_ASL(asl, nl, 0);
+
+      try {
+         const int number_variables = asl->i.n_var_;
+         const int number_constraints = asl->i.n_con_;
+         const int number_nonlinear_constraints = asl->i.nlc_;
+         stream << "// generated by Uno from " << nl_file_name << "\n";
+         stream << "#include <cmath>\n\n";
+         stream << "static inline double square(double x) { return x*x; }\n\n";
+
+         // objective: dense gradient
+         if (0 < asl->i.n_obj_) {
+            std::vector<std::pair<int, double>> linear_part{};
+            std::unordered_map<int, size_t> gradient_positions{};
+            for (ograd* term = asl->i.Ograd_[0]; term != nullptr; term = term->next) {
+               linear_part.emplace_back(term->varno, term->coef);
+               gradient_positions[term->varno] = static_cast<size_t>(term->varno);
+            }
+            generate_function(stream, asl_fg, "objective", asl_fg->I.obj_de_[0].e, linear_part, gradient_positions);
+         }
+         else {
+            stream << "static int objective(const double*, double* value, double*) {\n   *value = 0.;\n   return 0;\n}\n\n";
+         }
+
+         // nonlinear constraints: gradients in the order of the CSR rows
+         for (int constraint_index = 0; constraint_index < number_constraints && constraint_index < number_nonlinear_constraints; constraint_index++) {
+            std::vector<std::pair<int, double>> linear_part{};
+            std::unordered_map<int, size_t> gradient_positions{};
+            const size_t row_start = jacobian_row_starts[static_cast<size_t>(constraint_index)];
+            for (size_t nonzero_index: Range(row_start, jacobian_row_starts[static_cast<size_t>(constraint_index) + 1])) {
+               gradient_positions[static_cast<int>(jacobian_column_indices[nonzero_index])] = nonzero_index - row_start;
+            }
+            for (cgrad* term = asl->i.Cgrad_[constraint_index]; term != nullptr; term = term->next) {
+               if (gradient_positions.find(term->varno) == gradient_positions.end()) {
+                  throw std::runtime_error("The Jacobian pattern of the constraint " + std::to_string(constraint_index) + " does not match");
+               }
+               linear_part.emplace_back(term->varno, term->coef);
+            }
+            generate_function(stream, asl_fg, "constraint" + std::to_string(constraint_index), asl_fg->I.con_de_[constraint_index].e,
+                  linear_part, gradient_positions);
+         }
+
+         // exported functions
+         stream << "extern \"C\" int uno_compiled_interface(int* n, int* m, int* number_nonlinear_constraints) {\n";
+         stream << "   *n = " << number_variables << "; *m = " << number_constraints << "; *number_nonlinear_constraints = " <<
+               number_nonlinear_constraints << ";\n";
+         stream << "   return " << AMPLCodeGenerator::INTERFACE_VERSION << ";\n}\n\n";
+         stream << "extern \"C\" int uno_objective(const double* x, double* value, double* gradient) {\n";
+         stream << "   return objective(x, value, gradient);\n}\n\n";
+         if (0 < number_nonlinear_constraints) {
+            stream << "static int (*const constraints[])(const double*, double*, double*) = {";
+            for (int constraint_index = 0; constraint_index < number_nonlinear_constraints; constraint_index++) {
+               stream << ((constraint_index == 0) ? "" : ", ") << "constraint" << constraint_index;
+            }
+            stream << "};\n";
+            stream << "static const int row_starts[] = {";
+            for (int constraint_index = 0; constraint_index < number_nonlinear_constraints; constraint_index++) {
+               stream << ((constraint_index == 0) ? "" : ", ") << jacobian_row_starts[static_cast<size_t>(constraint_index)];
+            }
+            stream << "};\n\n";
+            stream << "extern \"C\" int uno_constraint(int j, const double* x, double* value, double* gradient) {\n";
+            stream << "   return constraints[j](x, value, gradient);\n}\n\n";
+            stream << "extern \"C\" int uno_jacobian(const double* x, double* values) {\n";
+            stream << "   double value;\n";
+            stream << "   for (int j = 0; j < " << number_nonlinear_constraints << "; j++) {\n";
+            stream << "      if (constraints[j](x, &value, values + row_starts[j]) != 0) { return 1; }\n";
+            stream << "   }\n   return 0;\n}\n";
+         }
+         else {
+            stream << "extern \"C\" int uno_constraint(int, const double*, double*, double*) {\n   return 1;\n}\n\n";
+            stream << "extern \"C\" int uno_jacobian(const double*, double*) {\n   return 0;\n}\n";
+         }
+      }
+      catch (...) {
+         ASL_free(&asl);
+         throw;
+      }
+      ASL_free(&asl);
+   }
+} // namespace
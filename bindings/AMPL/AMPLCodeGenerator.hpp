@@ -0,0 +1,37 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_AMPLCODEGENERATOR_H
+#define UNO_AMPLCODEGENERATOR_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace uno {
+   /*! \class AMPLCodeGenerator
+    * \brief Generation of C++ code that evaluates the functions of an AMPL model
+    *
+    *  The expression graphs of the .nl file are read by the fg reader of ASL and walked once. Each function (objective and
+    *  nonlinear constraints) becomes a straight-line C++ function: a forward pass computes one local per node of the graph, and an
+    *  optional reverse pass accumulates the adjoints into the gradient. The common subexpressions are inlined in each function that
+    *  uses them. The generated code exports the C functions:
+    *  - int uno_compiled_interface(int* n, int* m, int* number_nonlinear_constraints): returns INTERFACE_VERSION
+    *  - int uno_objective(const double* x, double* value, double* gradient): dense gradient (nonzeros of Ograd_ only), may be null
+    *  - int uno_constraint(int j, const double* x, double* value, double* gradient): gradient in the order of the CSR row, may be null
+    *  - int uno_jacobian(const double* x, double* values): rows of the nonlinear constraints in the CSR order
+    *  They return a nonzero value if an evaluation is not finite.
+    */
+   class AMPLCodeGenerator {
+   public:
+      static constexpr int INTERFACE_VERSION = 1;
+
+      // the gradients of the nonlinear constraints are written in the CSR order (jacobian_row_starts, jacobian_column_indices).
+      // Throws std::runtime_error if the model contains an operator that is not supported (imported functions, piecewise-linear
+      // terms, counting operators, ...)
+      static void generate(const std::string& nl_file_name, const std::vector<size_t>& jacobian_row_starts,
+            const std::vector<size_t>& jacobian_column_indices, std::ostream& stream);
+   };
+} // namespace
+
+#endif // UNO_AMPLCODEGENERATOR_H
@@ -0,0 +1,181 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <dlfcn.h>
+#include "AMPLCompiledModel.hpp"
+#include "AMPLCodeGenerator.hpp"
+#include "AMPLModelCache.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "optimization/EvaluationErrors.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   AMPLCompiledModel::AMPLCompiledModel(const std::string& file_name, const Options& options): AMPLModel(file_name, options) {
+      try {
+         this->load_library(this->compile(file_name, options));
+         this->compiled_jacobian_values.resize(this->jacobian_row_starts[this->number_nonlinear_constraints]);
+         DISCRETE << "The functions of the model are evaluated by compiled code\n";
+      }
+      catch (const std::runtime_error& exception) {
+         WARNING << "The compiled backend is not used (" << exception.what() << "): the functions are evaluated by ASL\n";
+      }
+   }
+
+   AMPLCompiledModel::~AMPLCompiledModel() {
+      if (this->library != nullptr) {
+         dlclose(this->library);
+      }
+   }
+
+   double AMPLCompiledModel::evaluate_objective(const Vector<double>& x) const {
+      if (this->library == nullptr) {
+         return AMPLModel::evaluate_objective(x);
+      }
+      double value;
+      if (this->compiled_objective(x.data(), &value, nullptr) != 0) {
+         throw FunctionEvaluationError();
+      }
+      return this->objective_sign * value;
+   }
+
+   void AMPLCompiledModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      if (this->library == nullptr) {
+         AMPLModel::evaluate_objective_gradient(x, gradient);
+         return;
+      }
+      double value;
+      if (this->compiled_objective(x.data(), &value, this->asl_gradient.data()) != 0) {
+         throw GradientEvaluationError();
+      }
+      for (const size_t variable_index: this->objective_gradient_indices) {
+         gradient.insert(variable_index, this->objective_sign * this->asl_gradient[variable_index]);
+      }
+   }
+
+   void AMPLCompiledModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      if (this->library == nullptr) {
+         AMPLModel::evaluate_constraints(x, constraints);
+         return;
+      }
+      for (size_t constraint_index: Range(this->number_nonlinear_constraints)) {
+         if (this->compiled_constraint(static_cast<int>(constraint_index), x.data(), &constraints[constraint_index], nullptr) != 0) {
+            throw FunctionEvaluationError();
+         }
+      }
+      for (const size_t constraint_index: this->linear_constraints) {
+         constraints[constraint_index] = dot(x, this->linear_constraint_gradients[constraint_index]);
+      }
+   }
+
+   void AMPLCompiledModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      if (this->library == nullptr || this->constraint_type[constraint_index] == LINEAR) {
+         AMPLModel::evaluate_constraint_gradient(x, constraint_index, gradient);
+         return;
+      }
+      gradient.clear();
+      double value;
+      if (this->compiled_constraint(static_cast<int>(constraint_index), x.data(), &value, this->asl_gradient.data()) != 0) {
+         throw GradientEvaluationError();
+      }
+      const size_t row_start = this->jacobian_row_starts[constraint_index];
+      for (size_t nonzero_index: Range(row_start, this->jacobian_row_starts[constraint_index + 1])) {
+         gradient.insert(this->jacobian_column_indices[nonzero_index], this->asl_gradient[nonzero_index - row_start]);
+      }
+   }
+
+   void AMPLCompiledModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      if (this->library == nullptr) {
+         AMPLModel::evaluate_constraint_jacobian(x, constraint_jacobian);
+         return;
+      }
+      if (this->compiled_jacobian(x.data(), this->compiled_jacobian_values.data()) != 0) {
+         throw GradientEvaluationError();
+      }
+      for (size_t constraint_index: Range(this->number_nonlinear_constraints)) {
+         auto constraint_gradient = constraint_jacobian[constraint_index];
+         constraint_gradient.clear();
+         for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+            constraint_gradient.insert(this->jacobian_column_indices[nonzero_index], this->compiled_jacobian_values[nonzero_index]);
+         }
+      }
+      for (const size_t constraint_index: this->linear_constraints) {
+         auto constraint_gradient = constraint_jacobian[constraint_index];
+         constraint_gradient.clear();
+         for (const auto [variable_index, derivative]: this->linear_constraint_gradients[constraint_index]) {
+            constraint_gradient.insert(variable_index, derivative);
+         }
+      }
+   }
+
+   bool AMPLCompiledModel::is_compiled() const {
+      return (this->library != nullptr);
+   }
+
+   // generate and compile the code, unless the library of the same .nl file already exists. Returns the name of the library
+   std::string AMPLCompiledModel::compile(const std::string& file_name, const Options& options) const {
+      const std::filesystem::path nl_file = AMPLModelCache::nl_file_path(file_name);
+      std::ostringstream hash;
+      hash << std::hex << std::setw(16) << std::setfill('0') << AMPLModelCache::hash_file(nl_file.string());
+      std::filesystem::path directory = options.get_string("AMPL_compiled_cache_directory");
+      if (directory.empty()) {
+         directory = nl_file.has_parent_path() ? nl_file.parent_path() : std::filesystem::path(".");
+      }
+      const std::string base_name = "uno_compiled_v" + std::to_string(AMPLCodeGenerator::INTERFACE_VERSION) + "_" + hash.str();
+      const std::filesystem::path library_name = directory / (base_name + ".so");
+      if (std::filesystem::exists(library_name)) {
+         DISCRETE << "The compiled functions were loaded from " << library_name.string() << '\n';
+         return library_name.string();
+      }
+
+      const std::filesystem::path source_name = directory / (base_name + ".cpp");
+      {
+         std::ofstream source(source_name);
+         if (!source) {
+            throw std::runtime_error("The file " + source_name.string() + " could not be created");
+         }
+         AMPLCodeGenerator::generate(nl_file.string(), this->jacobian_row_starts, this->jacobian_column_indices, source);
+      }
+      // the library is compiled under a temporary name, then renamed: concurrent runs never load a partially written library
+      const std::filesystem::path temporary_name = directory / (base_name + ".so.tmp" + std::to_string(reinterpret_cast<std::uintptr_t>(this)));
+      const std::string command = options.get_string("AMPL_compiler") + " " + options.get_string("AMPL_compiler_flags") + " -shared -fPIC -o \"" +
+            temporary_name.string() + "\" \"" + source_name.string() + "\"";
+      DISCRETE << "Compiling the functions of the model: " << command << '\n';
+      if (std::system(command.c_str()) != 0) {
+         std::filesystem::remove(temporary_name);
+         throw std::runtime_error("the compilation of " + source_name.string() + " failed");
+      }
+      std::filesystem::rename(temporary_name, library_name);
+      std::filesystem::remove(source_name);
+      return library_name.string();
+   }
+
+   void AMPLCompiledModel::load_library(const std::string& library_name) {
+      this->library = dlopen(library_name.c_str(), RTLD_NOW | RTLD_LOCAL);
+      if (this->library == nullptr) {
+         throw std::runtime_error("the library " + library_name + " could not be loaded: " + dlerror());
+      }
+      using Interface = int (*)(int*, int*, int*);
+      const Interface interface = reinterpret_cast<Interface>(dlsym(this->library, "uno_compiled_interface"));
+      this->compiled_objective = reinterpret_cast<CompiledFunction>(dlsym(this->library, "uno_objective"));
+      this->compiled_constraint = reinterpret_cast<CompiledConstraint>(dlsym(this->library, "uno_constraint"));
+      this->compiled_jacobian = reinterpret_cast<CompiledJacobian>(dlsym(this->library, "uno_jacobian"));
+      int number_variables = 0, number_constraints = 0, number_nonlinear_constraints = 0;
+      if (interface == nullptr || this->compiled_objective == nullptr || this->compiled_constraint == nullptr || this->compiled_jacobian == nullptr ||
+            interface(&number_variables, &number_constraints, &number_nonlinear_constraints) != AMPLCodeGenerator::INTERFACE_VERSION ||
+            static_cast<size_t>(number_variables) != this->number_variables || static_cast<size_t>(number_constraints) != this->number_constraints ||
+            static_cast<size_t>(number_nonlinear_constraints) != this->number_nonlinear_constraints) {
+         dlclose(this->library);
+         this->library = nullptr;
+         throw std::runtime_error("the library " + library_name + " does not match the model");
+      }
+   }
+} // namespace
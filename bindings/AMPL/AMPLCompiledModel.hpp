@@ -0,0 +1,48 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_AMPLCOMPILEDMODEL_H
+#define UNO_AMPLCOMPILEDMODEL_H
+
+#include <string>
+#include <vector>
+#include "AMPLModel.hpp"
+
+namespace uno {
+   /*! \class AMPLCompiledModel
+    * \brief AMPL model whose functions and first derivatives are evaluated by compiled code
+    *
+    *  The code generated by AMPLCodeGenerator is compiled into the shared library uno_compiled_v<version>_<hash>.so, where hash is
+    *  the hash of the .nl file, and reused while the file is unchanged. The linear constraints keep their constant gradients and the
+    *  Lagrangian Hessian is evaluated by ASL. If the code cannot be generated, compiled or loaded, the model falls back to ASL
+    */
+   class AMPLCompiledModel: public AMPLModel {
+   public:
+      AMPLCompiledModel(const std::string& file_name, const Options& options);
+      ~AMPLCompiledModel() override;
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+
+      [[nodiscard]] bool is_compiled() const;
+
+   private:
+      using CompiledFunction = int (*)(const double*, double*, double*);
+      using CompiledConstraint = int (*)(int, const double*, double*, double*);
+      using CompiledJacobian = int (*)(const double*, double*);
+
+      void* library{nullptr};
+      CompiledFunction compiled_objective{nullptr};
+      CompiledConstraint compiled_constraint{nullptr};
+      CompiledJacobian compiled_jacobian{nullptr};
+      mutable std::vector<double> compiled_jacobian_values{}; /*!< Jacobian of the nonlinear constraints, in the order of the CSR map */
+
+      [[nodiscard]] std::string compile(const std::string& file_name, const Options& options) const;
+      void load_library(const std::string& library_name);
+   };
+} // namespace
+
+#endif // UNO_AMPLCOMPILEDMODEL_H
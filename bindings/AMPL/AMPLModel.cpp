@@ -1,11 +1,16 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <optional>
 #include <stdexcept>
+#include <utility>
 #include "AMPLModel.hpp"
+#include "AMPLModelCache.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
+#include "model/EvaluationScaling.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "optimization/EvaluationErrors.hpp"
 #include "optimization/Iterate.hpp"
@@ -32,6 +37,19 @@ namespace uno {
       asl->i.X0_ = static_cast<double*>(M1zapalloc_ASL(&asl->i, sizeof(double) * static_cast<size_t>(asl->i.n_var_)));
       asl->i.pi0_ = static_cast<double*>(M1zapalloc_ASL(&asl->i, sizeof(double) * static_cast<size_t>(asl->i.n_con_)));
 
+      // suffixes (all declared before reading the file). Input: user-provided scaling factors of the variables, basis statuses of the
+      // variables and constraints, bound duals and stages of the variables and constraints. Output: bound duals
+      std::array<SufDecl, 7> suffixes{
+         SufDecl{const_cast<char*>("scaling_factor"), nullptr, ASL_Sufkind_var | ASL_Sufkind_real, 0},
+         SufDecl{const_cast<char*>("sstatus"), nullptr, ASL_Sufkind_var, 0},
+         SufDecl{const_cast<char*>("sstatus"), nullptr, ASL_Sufkind_con, 0},
+         SufDecl{const_cast<char*>("lower_bound_duals"), nullptr, ASL_Sufkind_var | ASL_Sufkind_real, 0},
+         SufDecl{const_cast<char*>("upper_bound_duals"), nullptr, ASL_Sufkind_var | ASL_Sufkind_real, 0},
+         SufDecl{const_cast<char*>("stage"), nullptr, ASL_Sufkind_var, 0},
+         SufDecl{const_cast<char*>("stage"), nullptr, ASL_Sufkind_con, 0}
+      };
+      suf_declare_ASL(asl, suffixes.data(), static_cast<int>(suffixes.size()));
+
       // read the file_name.nl file
       pfgh_read_ASL(asl, nl, ASL_findgroups);
       return asl;
@@ -45,16 +63,22 @@ namespace uno {
          Model(file_name, static_cast<size_t>(asl->i.n_var_), static_cast<size_t>(asl->i.n_con_), (asl->i.objtype_[0] == 1) ? -1. : 1.),
          asl(asl),
          write_solution_to_file(options.get_bool("AMPL_write_solution_to_file")),
+         parallel_hessian(options.get_bool("AMPL_parallel_hessian")),
          // allocate vectors
          asl_gradient(this->number_variables),
+         asl_jacobian(static_cast<size_t>(asl->i.nzc_)),
          variable_lower_bounds(this->number_variables),
          variable_upper_bounds(this->number_variables),
          constraint_lower_bounds(this->number_constraints),
          constraint_upper_bounds(this->number_constraints),
          variable_status(this->number_variables),
+         objective_type((asl->i.nlo_ == 0) ? LINEAR : NONLINEAR),
+         number_nonlinear_constraints(static_cast<size_t>(asl->i.nlc_)),
          constraint_type(this->number_constraints),
+         linear_constraint_gradients(this->number_constraints),
          constraint_status(this->number_constraints),
          multipliers_with_flipped_sign(this->number_constraints),
+         known_point(this->number_variables),
          linear_constraints_collection(this->linear_constraints),
          equality_constraints_collection(this->equality_constraints),
          inequality_constraints_collection(this->inequality_constraints),
@@ -65,32 +89,73 @@ namespace uno {
       // evaluate the constraint Jacobian in sparse mode
       this->asl->i.congrd_mode = 1;
 
-      // variables
-      this->lower_bounded_variables.reserve(this->number_variables);
-      this->upper_bounded_variables.reserve(this->number_variables);
-      this->single_lower_bounded_variables.reserve(this->number_variables);
-      this->single_upper_bounded_variables.reserve(this->number_variables);
-      this->fixed_variables.reserve(this->number_variables);
-      this->generate_variables();
-
-      // constraints
-      this->equality_constraints.reserve(this->number_constraints);
-      this->inequality_constraints.reserve(this->number_constraints);
-      this->linear_constraints.reserve(this->number_constraints);
-      this->generate_constraints();
+      this->read_bounds();
+      // the structure of the model is derived from the .nl file, or loaded from the model cache if the file has not changed
+      const size_t number_asl_jacobian_nonzeros = static_cast<size_t>(asl->i.nzc_);
+      std::optional<AMPLModelCache> model_cache{};
+      std::optional<AMPLModelStructure> structure{};
+      if (options.get_bool("AMPL_model_cache")) {
+         model_cache.emplace(file_name);
+         structure = model_cache->load(this->number_variables, this->number_constraints, number_asl_jacobian_nonzeros);
+      }
+      if (structure.has_value()) {
+         DISCRETE << "The structure of the model was loaded from the model cache\n";
+         this->restore_structure(std::move(*structure));
+      }
+      else {
+         // variables
+         this->lower_bounded_variables.reserve(this->number_variables);
+         this->upper_bounded_variables.reserve(this->number_variables);
+         this->single_lower_bounded_variables.reserve(this->number_variables);
+         this->single_upper_bounded_variables.reserve(this->number_variables);
+         this->fixed_variables.reserve(this->number_variables);
+         this->generate_variables();
+
+         // constraints
+         this->equality_constraints.reserve(this->number_constraints);
+         this->inequality_constraints.reserve(this->number_constraints);
+         this->linear_constraints.reserve(this->number_constraints);
+         this->generate_constraints();
+         this->evaluate_linear_constraint_gradients();
+         this->compute_jacobian_offsets();
+         this->compute_objective_gradient_indices();
+         if (model_cache.has_value()) {
+            model_cache->store(this->extract_structure(), this->number_variables, this->number_constraints, number_asl_jacobian_nonzeros);
+         }
+      }
 
-      // compute sparsity pattern and number of nonzeros of Lagrangian Hessian
-      this->compute_lagrangian_hessian_sparsity();
+      // additional ASL instances for the parallel evaluation of the nonlinear constraints and their Jacobian: each thread evaluates
+      // a block of constraints with its own workspace
+      const size_t number_threads = options.get_unsigned_int("AMPL_evaluation_threads");
+      if (number_threads == 0) {
+         throw std::invalid_argument("The number of AMPL evaluation threads should be positive");
+      }
+      if (1 < number_threads && 0 < this->number_nonlinear_constraints) {
+         this->evaluation_contexts.reserve(number_threads - 1);
+         for ([[maybe_unused]] size_t thread_index: Range(1, number_threads)) {
+            ASL* context = generate_asl(file_name);
+            context->i.congrd_mode = 1;
+            this->evaluation_contexts.emplace_back(context);
+         }
+         this->parallel_jacobian.resize(number_asl_jacobian_nonzeros);
+      }
+      // the sparsity pattern of the Lagrangian Hessian (Sphset, which also sets up the structures used by Sphes) is computed upon
+      // the first call to number_hessian_nonzeros or to a Hessian evaluation: the first-order methods do not pay for it
    }
 
    AMPLModel::~AMPLModel() {
       ASL_free(&this->asl);
+      for (ASL* context: this->evaluation_contexts) {
+         ASL_free(&context);
+      }
    }
 
    double AMPLModel::evaluate_objective(const Vector<double>& x) const {
+      this->set_current_point(x);
       fint error_flag = 0;
       double result = this->objective_sign * (*(this->asl)->p.Objval)(this->asl, 0, const_cast<double*>(x.data()), &error_flag);
       if (0 < error_flag) {
+         this->invalidate_point();
          throw FunctionEvaluationError();
       }
       return result;
@@ -98,28 +163,32 @@ namespace uno {
 
    // sparse gradient
    void AMPLModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->evaluate_scaled_objective_gradient(x, EvaluationScaling{}, gradient);
+   }
+
+   void AMPLModel::evaluate_scaled_objective_gradient(const Vector<double>& x, const EvaluationScaling& scaling, SparseVector<double>& gradient) const {
+      this->set_current_point(x);
       fint error_flag = 0;
-      // prevent ASL to crash by catching all evaluation errors
-      Jmp_buf err_jmp_uno;
-      asl->i.err_jmp_ = &err_jmp_uno;
-      asl->i.err_jmp1_ = &err_jmp_uno;
-      if (setjmp(err_jmp_uno.jb)) {
+      // prevent ASL to crash by catching all evaluation errors. The jump buffer is a member, but the jump target must be set in
+      // the current frame and is unregistered after the call, so that no other evaluation jumps to a stale frame
+      this->asl->i.err_jmp_ = &this->error_jump_buffer;
+      this->asl->i.err_jmp1_ = &this->error_jump_buffer;
+      if (setjmp(this->error_jump_buffer.jb)) {
          error_flag = 1;
       }
-      // evaluate the ASL gradient (always in a dense vector)
+      // evaluate the ASL gradient (ASL always writes into a dense vector)
       (*(this->asl)->p.Objgrd)(this->asl, 0, const_cast<double*>(x.data()), const_cast<double*>(this->asl_gradient.data()), &error_flag);
+      this->asl->i.err_jmp_ = nullptr;
+      this->asl->i.err_jmp1_ = nullptr;
       if (0 < error_flag) {
+         this->invalidate_point();
          throw GradientEvaluationError();
       }
 
-      // create the Uno sparse vector
-      ograd* asl_variables_tmp = this->asl->i.Ograd_[0];
-      while (asl_variables_tmp != nullptr) {
-         const size_t variable_index = static_cast<size_t>(asl_variables_tmp->varno);
-         // scale by the objective sign
-         const double partial_derivative = this->objective_sign*this->asl_gradient[variable_index];
-         gradient.insert(variable_index, partial_derivative);
-         asl_variables_tmp = asl_variables_tmp->next;
+      // gather the nonzeros at the precomputed indices, scaled by the objective sign
+      const double objective_factor = this->objective_sign * scaling.objective;
+      for (const size_t variable_index: this->objective_gradient_indices) {
+         gradient.insert(variable_index, objective_factor * scaling.variable(variable_index) * this->asl_gradient[variable_index]);
       }
    }
 
@@ -135,76 +204,289 @@ namespace uno {
    */
 
    void AMPLModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      // if all the constraints are linear, evaluate them as sparse dot products with their constant gradients (AMPL moves the
+      // constant terms of the linear constraints into their bounds)
+      if (this->number_nonlinear_constraints == 0) {
+         for (const size_t constraint_index: this->linear_constraints) {
+            constraints[constraint_index] = dot(x, this->linear_constraint_gradients[constraint_index]);
+         }
+         return;
+      }
+      if (!this->evaluation_contexts.empty()) {
+         const bool success = this->evaluate_nonlinear_constraints_in_parallel(x, [&](ASL* context, size_t constraint_index, fint* error_flag) {
+            constraints[constraint_index] = (*(context)->p.Conival)(context, static_cast<int>(constraint_index), const_cast<double*>(x.data()),
+                  error_flag);
+         });
+         if (!success) {
+            throw FunctionEvaluationError();
+         }
+         for (const size_t constraint_index: this->linear_constraints) {
+            constraints[constraint_index] = dot(x, this->linear_constraint_gradients[constraint_index]);
+         }
+         return;
+      }
+      this->set_current_point(x);
       fint error_flag = 0;
       (*(this->asl)->p.Conval)(this->asl, const_cast<double*>(x.data()), constraints.data(), &error_flag);
       if (0 < error_flag) {
+         this->invalidate_point();
          throw FunctionEvaluationError();
       }
    }
 
    // sparse gradient
    void AMPLModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      gradient.clear();
+      if (this->constraint_type[constraint_index] == LINEAR) {
+         // constant gradient
+         for (const auto [variable_index, derivative]: this->linear_constraint_gradients[constraint_index]) {
+            gradient.insert(variable_index, derivative);
+         }
+         return;
+      }
       // compute the AMPL sparse gradient
+      this->set_current_point(x);
       fint error_flag = 0;
       (*(this->asl)->p.Congrd)(this->asl, static_cast<int>(constraint_index), const_cast<double*>(x.data()), const_cast<double*>(this->asl_gradient.data()),
             &error_flag);
       if (0 < error_flag) {
+         this->invalidate_point();
          throw GradientEvaluationError();
       }
+      this->copy_asl_constraint_gradient(constraint_index, gradient);
+   }
 
-      // construct the Uno sparse vector
-      gradient.clear();
-      cgrad* asl_variables_tmp = this->asl->i.Cgrad_[constraint_index];
-      size_t sparse_asl_index = 0;
-      while (asl_variables_tmp != nullptr) {
-         const size_t variable_index = static_cast<size_t>(asl_variables_tmp->varno);
-         gradient.insert(variable_index, this->asl_gradient[sparse_asl_index]);
-         asl_variables_tmp = asl_variables_tmp->next;
-         sparse_asl_index++;
+   // the rows of the linear constraints are copied from their constant gradients. The rows of the nonlinear constraints (AMPL orders
+   // them first) are evaluated by a single Jacval call, then scattered into the CSR Jacobian through the precomputed offsets
+   void AMPLModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      this->evaluate_scaled_constraint_jacobian(x, EvaluationScaling{}, constraint_jacobian);
+   }
+
+   void AMPLModel::evaluate_scaled_constraint_jacobian(const Vector<double>& x, const EvaluationScaling& scaling,
+         RectangularMatrix<double>& constraint_jacobian) const {
+      if (!this->is_constrained()) {
+         return;
+      }
+      if (!this->evaluation_contexts.empty()) {
+         // in sparse mode, Congrd writes the nonzeros of a row in the order of Cgrad_, that is in the slice of the row in the CSR map
+         const bool success = this->evaluate_nonlinear_constraints_in_parallel(x, [&](ASL* context, size_t constraint_index, fint* error_flag) {
+            (*(context)->p.Congrd)(context, static_cast<int>(constraint_index), const_cast<double*>(x.data()),
+                  this->parallel_jacobian.data() + this->jacobian_row_starts[constraint_index], error_flag);
+         });
+         if (!success) {
+            throw GradientEvaluationError();
+         }
+         // the rows of the CSR Jacobian may be relocated when they are filled: they are filled sequentially
+         for (size_t constraint_index: Range(this->number_nonlinear_constraints)) {
+            auto constraint_gradient = constraint_jacobian[constraint_index];
+            constraint_gradient.clear();
+            const double row_scaling = scaling.constraint(constraint_index);
+            for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+               const size_t variable_index = this->jacobian_column_indices[nonzero_index];
+               constraint_gradient.insert(variable_index, row_scaling * scaling.variable(variable_index) * this->parallel_jacobian[nonzero_index]);
+            }
+         }
+      }
+      else if (0 < this->number_nonlinear_constraints) {
+         this->set_current_point(x);
+         fint error_flag = 0;
+         (*(this->asl)->p.Jacval)(this->asl, const_cast<double*>(x.data()), this->asl_jacobian.data(), &error_flag);
+         if (0 < error_flag) {
+            this->invalidate_point();
+            throw GradientEvaluationError();
+         }
+         for (size_t constraint_index: Range(this->number_nonlinear_constraints)) {
+            // fill the row of the CSR Jacobian directly
+            auto constraint_gradient = constraint_jacobian[constraint_index];
+            constraint_gradient.clear();
+            const double row_scaling = scaling.constraint(constraint_index);
+            for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+               const size_t variable_index = this->jacobian_column_indices[nonzero_index];
+               constraint_gradient.insert(variable_index, row_scaling * scaling.variable(variable_index) *
+                  this->asl_jacobian[this->jacobian_offsets[nonzero_index]]);
+            }
+         }
+      }
+      for (const size_t constraint_index: this->linear_constraints) {
+         auto constraint_gradient = constraint_jacobian[constraint_index];
+         constraint_gradient.clear();
+         const double row_scaling = scaling.constraint(constraint_index);
+         for (const auto [variable_index, derivative]: this->linear_constraint_gradients[constraint_index]) {
+            constraint_gradient.insert(variable_index, row_scaling * scaling.variable(variable_index) * derivative);
+         }
       }
    }
 
-   void AMPLModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
-      for (size_t constraint_index: Range(this->number_constraints)) {
-         constraint_jacobian[constraint_index].clear();
-         this->evaluate_constraint_gradient(x, constraint_index, constraint_jacobian[constraint_index]);
+   // the nonlinear constraints are partitioned into contiguous blocks, one per ASL instance. Each thread registers x with its instance,
+   // then evaluates its block. Returns false if an evaluation failed
+   template <typename Evaluation>
+   bool AMPLModel::evaluate_nonlinear_constraints_in_parallel(const Vector<double>& x, const Evaluation& evaluation) const {
+      this->set_current_point(x);
+      const size_t number_threads = this->evaluation_contexts.size() + 1;
+      bool success = true;
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) num_threads(static_cast<int>(number_threads)) reduction(&&: success)
+#endif
+      for (int thread_index = 0; thread_index < static_cast<int>(number_threads); thread_index++) {
+         const size_t thread = static_cast<size_t>(thread_index);
+         ASL* context = (thread == 0) ? this->asl : this->evaluation_contexts[thread - 1];
+         fint error_flag = 0;
+         if (0 < thread) {
+            (*(context)->p.Xknown)(context, const_cast<double*>(x.data()), &error_flag);
+            // if the common subexpressions cannot be evaluated, the error is raised by the evaluations themselves
+            error_flag = 0;
+         }
+         const size_t block_start = thread * this->number_nonlinear_constraints / number_threads;
+         const size_t block_end = (thread + 1) * this->number_nonlinear_constraints / number_threads;
+         for (size_t constraint_index = block_start; constraint_index < block_end && error_flag == 0; constraint_index++) {
+            evaluation(context, constraint_index, &error_flag);
+         }
+         if (0 < thread) {
+            context->i.x_known = 0;
+         }
+         success = success && (error_flag == 0);
+      }
+      if (!success) {
+         this->invalidate_point();
       }
+      return success;
    }
 
-   void AMPLModel::evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& multipliers,
+   void AMPLModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
          SymmetricMatrix<size_t, double>& hessian) const {
+      this->evaluate_scaled_lagrangian_hessian(x, objective_multiplier, multipliers, EvaluationScaling{}, hessian);
+   }
+
+   // the function factors scale the weights of Sphes, the variable factors are applied while the nonzeros are copied
+   void AMPLModel::evaluate_scaled_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         const EvaluationScaling& scaling, SymmetricMatrix<size_t, double>& hessian) const {
+      this->ensure_hessian_sparsity();
       assert(hessian.capacity() >= this->number_asl_hessian_nonzeros);
 
-      // register the vector of variables
-      //(*(this->asl)->p.Xknown)(this->asl, const_cast<double*>(x.data()), nullptr);
+      // register the vector of variables: Sphes is evaluated at the known point
+      this->set_current_point(x);
 
-      // evaluate the Hessian: store the matrix in a preallocated array this->asl_hessian
       const int objective_number = -1;
-      objective_multiplier *= this->objective_sign;
+      objective_multiplier *= this->objective_sign * scaling.objective;
       // flip the signs of the multipliers: in AMPL, the Lagrangian is f + lambda.g, while Uno uses f - lambda.g
-      this->multipliers_with_flipped_sign = -multipliers;
-      (*(this->asl)->p.Sphes)(this->asl, nullptr, const_cast<double*>(this->asl_hessian.data()), objective_number, &objective_multiplier,
-            const_cast<double*>(this->multipliers_with_flipped_sign.data()));
-
-      // generate the sparsity pattern in the right sparse format
-      const fint* asl_column_start = this->asl->i.sputinfo_->hcolstarts;
-      const fint* asl_row_index = this->asl->i.sputinfo_->hrownos;
-      // check that the column pointers are sorted in increasing order
-      // TODO throw exception
-      assert(in_increasing_order(asl_column_start, this->number_variables + 1) && "AMPLModel::evaluate_lagrangian_hessian: column starts are not ordered");
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->multipliers_with_flipped_sign[constraint_index] = -scaling.constraint(constraint_index) * multipliers[constraint_index];
+      }
 
-      // copy the nonzeros in the Hessian
+      // the pattern of Sphes is fixed: in COO format, Sphes writes the values directly into the storage of the Hessian. Otherwise,
+      // the Hessian is evaluated in a preallocated array this->asl_hessian and the nonzeros are copied
       hessian.reset();
+      double* hessian_values = hessian.insert_block(this->hessian_row_indices.data(), this->hessian_column_indices.data(),
+         this->number_asl_hessian_nonzeros);
+      double* const values = (hessian_values != nullptr) ? hessian_values : this->asl_hessian.data();
+      // the functions with a zero multiplier are excluded from the evaluation (null weights for Sphes); the pattern is unchanged.
+      // Only the nonlinear constraints (the first ones in the AMPL ordering) contribute to the Hessian
+      const double* const nonlinear_multipliers = this->multipliers_with_flipped_sign.data();
+      const bool has_objective_contribution = (objective_multiplier != 0.);
+      const bool has_constraint_contributions = !AMPLModel::are_zero(nonlinear_multipliers,
+         nonlinear_multipliers + this->number_nonlinear_constraints);
+      if (!has_objective_contribution && !has_constraint_contributions) {
+         std::fill(values, values + this->number_asl_hessian_nonzeros, 0.);
+      }
+      else if (!this->hessian_contributions.empty()) {
+         this->evaluate_lagrangian_hessian_in_parallel(x, objective_multiplier, values);
+      }
+      else {
+         (*(this->asl)->p.Sphes)(this->asl, nullptr, values, objective_number, has_objective_contribution ? &objective_multiplier : nullptr,
+               has_constraint_contributions ? const_cast<double*>(nonlinear_multipliers) : nullptr);
+      }
+      if (hessian_values != nullptr) {
+         // Sphes wrote into the storage of the Hessian: the variable factors are applied in place
+         if (scaling.variables != nullptr) {
+            for (size_t nonzero_index: Range(this->number_asl_hessian_nonzeros)) {
+               hessian_values[nonzero_index] *= scaling.variables[this->hessian_row_indices[nonzero_index]] *
+                  scaling.variables[this->hessian_column_indices[nonzero_index]];
+            }
+         }
+         for (size_t column_index: Range(this->number_variables)) {
+            hessian.finalize_column(column_index);
+         }
+         return;
+      }
+
+      const fint* asl_column_start = this->asl->i.sputinfo_->hcolstarts;
       for (size_t column_index: Range(this->number_variables)) {
+         const double column_scaling = scaling.variable(column_index);
          for (size_t k: Range(static_cast<size_t>(asl_column_start[column_index]), static_cast<size_t>(asl_column_start[column_index + 1]))) {
-            const size_t row_index = static_cast<size_t>(asl_row_index[k]);
-            const double entry = this->asl_hessian[k];
-            hessian.insert(entry, row_index, column_index);
+            const size_t row_index = this->hessian_row_indices[k];
+            hessian.insert(scaling.variable(row_index) * column_scaling * this->asl_hessian[k], row_index, column_index);
          }
          hessian.finalize_column(column_index);
       }
-      // unregister the vector of variables
-      //this->asl->i.x_known = 0;
+   }
+
+   // the Lagrangian is partially separable in its functions: each thread evaluates with its own ASL instance the Hessian of its
+   // block of nonlinear constraints (Sphes skips the zero multipliers), and of the objective for thread 0. The contributions have
+   // the same pattern (that of Sphset) and are summed into hessian_values. A block whose functions all have zero multipliers is not
+   // evaluated
+   void AMPLModel::evaluate_lagrangian_hessian_in_parallel(const Vector<double>& x, double objective_multiplier, double* hessian_values) const {
+      const int objective_number = -1;
+      const size_t number_threads = this->evaluation_contexts.size() + 1;
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) num_threads(static_cast<int>(number_threads))
+#endif
+      for (int thread_index = 0; thread_index < static_cast<int>(number_threads); thread_index++) {
+         const size_t thread = static_cast<size_t>(thread_index);
+         ASL* context = (thread == 0) ? this->asl : this->evaluation_contexts[thread - 1];
+         const size_t block_start = thread * this->number_nonlinear_constraints / number_threads;
+         const size_t block_end = (thread + 1) * this->number_nonlinear_constraints / number_threads;
+         double block_objective_multiplier = (thread == 0) ? objective_multiplier : 0.;
+         double* block_values = (thread == 0) ? hessian_values : this->hessian_contributions[thread - 1].data();
+         const double* multipliers = this->multipliers_with_flipped_sign.data();
+         const bool has_constraint_contributions = !AMPLModel::are_zero(multipliers + block_start, multipliers + block_end);
+         if (block_objective_multiplier == 0. && !has_constraint_contributions) {
+            std::fill(block_values, block_values + this->number_asl_hessian_nonzeros, 0.);
+            continue;
+         }
+         if (0 < thread) {
+            fint error_flag = 0;
+            (*(context)->p.Xknown)(context, const_cast<double*>(x.data()), &error_flag);
+         }
+         Vector<double>& block_multipliers = this->hessian_block_multipliers[thread];
+         block_multipliers.fill(0.);
+         for (size_t constraint_index: Range(block_start, block_end)) {
+            block_multipliers[constraint_index] = this->multipliers_with_flipped_sign[constraint_index];
+         }
+         (*(context)->p.Sphes)(context, nullptr, block_values, objective_number,
+               (block_objective_multiplier != 0.) ? &block_objective_multiplier : nullptr,
+               has_constraint_contributions ? block_multipliers.data() : nullptr);
+         if (0 < thread) {
+            context->i.x_known = 0;
+         }
+      }
+
+      // sum the contributions
+      const int number_nonzeros = static_cast<int>(this->number_asl_hessian_nonzeros);
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) num_threads(static_cast<int>(number_threads))
+#endif
+      for (int nonzero_index = 0; nonzero_index < number_nonzeros; nonzero_index++) {
+         for (const std::vector<double>& contribution: this->hessian_contributions) {
+            hessian_values[nonzero_index] += contribution[static_cast<size_t>(nonzero_index)];
+         }
+      }
+   }
+
+   void AMPLModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      // register the vector of variables: hvcomp is evaluated at the known point
+      this->set_current_point(x);
+
+      const int objective_number = -1;
+      objective_multiplier *= this->objective_sign;
+      // flip the signs of the multipliers: in AMPL, the Lagrangian is f + lambda.g, while Uno uses f - lambda.g
+      this->multipliers_with_flipped_sign = -multipliers;
+      // int (*Hvinit) (ASL*, int ihd_limit, int nobj, real* ow, real* y);
+      (*(this->asl)->p.Hvinit)(this->asl, this->asl->p.ihd_limit_, objective_number, &objective_multiplier,
+            this->multipliers_with_flipped_sign.data());
+      // void (*Hvcomp) (ASL*, real* hv, real* p, int nobj, real* ow, real* y);
+      (*(this->asl)->p.Hvcomp)(this->asl, result.data(), const_cast<double*>(vector.data()), objective_number, &objective_multiplier,
+            this->multipliers_with_flipped_sign.data());
    }
 
    double AMPLModel::variable_lower_bound(size_t variable_index) const {
@@ -251,6 +533,10 @@ namespace uno {
       return this->constraint_upper_bounds[constraint_index];
    }
 
+   FunctionType AMPLModel::get_objective_type() const {
+      return this->objective_type;
+   }
+
    FunctionType AMPLModel::get_constraint_type(size_t constraint_index) const {
       return this->constraint_type[constraint_index];
    }
@@ -309,11 +595,7 @@ namespace uno {
          iterate.multipliers.upper_bounds *= this->objective_sign;
          iterate.evaluations.objective *= this->objective_sign;
 
-         // include the bound duals in the .sol file, using suffixes
-         SufDecl lower_bound_suffix{const_cast<char*>("lower_bound_duals"), nullptr, ASL_Sufkind_var | ASL_Sufkind_real, 0};
-         SufDecl upper_bound_suffix{const_cast<char*>("upper_bound_duals"), nullptr, ASL_Sufkind_var | ASL_Sufkind_real, 0};
-         std::array<SufDecl, 2> suffixes{lower_bound_suffix, upper_bound_suffix};
-         suf_declare_ASL(this->asl, suffixes.data(), suffixes.size());
+         // include the bound duals in the .sol file, using the suffixes declared in generate_asl
          suf_rput_ASL(this->asl, "lower_bound_duals", ASL_Sufkind_var, iterate.multipliers.lower_bounds.data());
          suf_rput_ASL(this->asl, "upper_bound_duals", ASL_Sufkind_var, iterate.multipliers.upper_bounds.data());
 
@@ -334,13 +616,23 @@ namespace uno {
    }
 
    size_t AMPLModel::number_hessian_nonzeros() const {
+      this->ensure_hessian_sparsity();
       return this->number_asl_hessian_nonzeros;
    }
 
-   void AMPLModel::generate_variables() {
+   void AMPLModel::read_bounds() {
       for (size_t variable_index: Range(this->number_variables)) {
          this->variable_lower_bounds[variable_index] = (this->asl->i.LUv_ != nullptr) ? this->asl->i.LUv_[2*variable_index] : -INF<double>;
          this->variable_upper_bounds[variable_index] = (this->asl->i.LUv_ != nullptr) ? this->asl->i.LUv_[2*variable_index + 1] : INF<double>;
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->constraint_lower_bounds[constraint_index] = (this->asl->i.LUrhs_ != nullptr) ? this->asl->i.LUrhs_[2*constraint_index] : -INF<double>;
+         this->constraint_upper_bounds[constraint_index] = (this->asl->i.LUrhs_ != nullptr) ? this->asl->i.LUrhs_[2*constraint_index + 1] : INF<double>;
+      }
+   }
+
+   void AMPLModel::generate_variables() {
+      for (size_t variable_index: Range(this->number_variables)) {
          if (this->variable_lower_bounds[variable_index] == this->variable_upper_bounds[variable_index]) {
             WARNING << "Variable x" << variable_index << " has identical bounds\n";
             this->fixed_variables.emplace_back(variable_index);
@@ -366,10 +658,6 @@ namespace uno {
    }
 
    void AMPLModel::generate_constraints() {
-      for (size_t constraint_index: Range(this->number_constraints)) {
-         this->constraint_lower_bounds[constraint_index] = (this->asl->i.LUrhs_ != nullptr) ? this->asl->i.LUrhs_[2*constraint_index] : -INF<double>;
-         this->constraint_upper_bounds[constraint_index] = (this->asl->i.LUrhs_ != nullptr) ? this->asl->i.LUrhs_[2*constraint_index + 1] : INF<double>;
-      }
       AMPLModel::determine_bounds_types(this->constraint_lower_bounds, this->constraint_upper_bounds, this->constraint_status);
 
       // partition equality and inequality constraints
@@ -383,28 +671,268 @@ namespace uno {
       }
 
       // AMPL orders the constraints based on the function type: nonlinear first, then linear
-      const size_t number_nonlinear_constraints = static_cast<size_t>(this->asl->i.nlc_);
-      for (size_t constraint_index: Range(number_nonlinear_constraints)) {
+      for (size_t constraint_index: Range(this->number_nonlinear_constraints)) {
          this->constraint_type[constraint_index] = NONLINEAR;
       }
-      for (size_t constraint_index: Range(number_nonlinear_constraints, this->number_constraints)) {
+      for (size_t constraint_index: Range(this->number_nonlinear_constraints, this->number_constraints)) {
          this->constraint_type[constraint_index] = LINEAR;
          this->linear_constraints.emplace_back(constraint_index);
       }
    }
 
-   void AMPLModel::compute_lagrangian_hessian_sparsity() {
+   AMPLModelStructure AMPLModel::extract_structure() const {
+      AMPLModelStructure structure{this->variable_status, this->constraint_status, this->constraint_type,
+         std::vector<size_t>(this->fixed_variables.data(), this->fixed_variables.data() + this->fixed_variables.size()),
+         this->lower_bounded_variables, this->upper_bounded_variables, this->single_lower_bounded_variables,
+         this->single_upper_bounded_variables, this->equality_constraints, this->inequality_constraints, this->linear_constraints,
+         {}, {}, {}, this->jacobian_row_starts, this->jacobian_column_indices, this->jacobian_offsets, this->objective_gradient_indices};
+      structure.linear_gradient_starts.reserve(this->number_constraints + 1);
+      structure.linear_gradient_starts.emplace_back(0);
+      for (const SparseVector<double>& linear_constraint_gradient: this->linear_constraint_gradients) {
+         for (const auto [variable_index, derivative]: linear_constraint_gradient) {
+            structure.linear_gradient_indices.emplace_back(variable_index);
+            structure.linear_gradient_values.emplace_back(derivative);
+         }
+         structure.linear_gradient_starts.emplace_back(structure.linear_gradient_indices.size());
+      }
+      return structure;
+   }
+
+   void AMPLModel::restore_structure(AMPLModelStructure&& structure) {
+      this->variable_status = std::move(structure.variable_status);
+      this->constraint_status = std::move(structure.constraint_status);
+      this->constraint_type = std::move(structure.constraint_type);
+      for (size_t variable_index: structure.fixed_variables) {
+         this->fixed_variables.emplace_back(variable_index);
+      }
+      this->lower_bounded_variables = std::move(structure.lower_bounded_variables);
+      this->upper_bounded_variables = std::move(structure.upper_bounded_variables);
+      this->single_lower_bounded_variables = std::move(structure.single_lower_bounded_variables);
+      this->single_upper_bounded_variables = std::move(structure.single_upper_bounded_variables);
+      this->equality_constraints = std::move(structure.equality_constraints);
+      this->inequality_constraints = std::move(structure.inequality_constraints);
+      this->linear_constraints = std::move(structure.linear_constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         SparseVector<double>& linear_constraint_gradient = this->linear_constraint_gradients[constraint_index];
+         for (size_t nonzero_index: Range(structure.linear_gradient_starts[constraint_index], structure.linear_gradient_starts[constraint_index + 1])) {
+            linear_constraint_gradient.insert(structure.linear_gradient_indices[nonzero_index], structure.linear_gradient_values[nonzero_index]);
+         }
+      }
+      this->jacobian_row_starts = std::move(structure.jacobian_row_starts);
+      this->jacobian_column_indices = std::move(structure.jacobian_column_indices);
+      this->jacobian_offsets = std::move(structure.jacobian_offsets);
+      this->objective_gradient_indices = std::move(structure.objective_gradient_indices);
+   }
+
+   // the gradients of the linear constraints are constant: evaluate them once (at x = 0)
+   void AMPLModel::evaluate_linear_constraint_gradients() {
+      const Vector<double> x(this->number_variables, 0.);
+      this->set_current_point(x);
+      for (const size_t constraint_index: this->linear_constraints) {
+         fint error_flag = 0;
+         (*(this->asl)->p.Congrd)(this->asl, static_cast<int>(constraint_index), const_cast<double*>(x.data()),
+               const_cast<double*>(this->asl_gradient.data()), &error_flag);
+         if (0 < error_flag) {
+            throw GradientEvaluationError();
+         }
+         this->copy_asl_constraint_gradient(constraint_index, this->linear_constraint_gradients[constraint_index]);
+      }
+   }
+
+   // walk the Cgrad_ lists once: the nonzeros of each row are stored in the order of Congrd, with their offsets in the Jacval array
+   void AMPLModel::compute_jacobian_offsets() {
+      const size_t number_nonzeros = static_cast<size_t>(this->asl->i.nzc_);
+      this->jacobian_row_starts.reserve(this->number_constraints + 1);
+      this->jacobian_column_indices.reserve(number_nonzeros);
+      this->jacobian_offsets.reserve(number_nonzeros);
+      this->jacobian_row_starts.emplace_back(0);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         cgrad* asl_variables_tmp = this->asl->i.Cgrad_[constraint_index];
+         while (asl_variables_tmp != nullptr) {
+            this->jacobian_column_indices.emplace_back(static_cast<size_t>(asl_variables_tmp->varno));
+            this->jacobian_offsets.emplace_back(static_cast<size_t>(asl_variables_tmp->goff));
+            asl_variables_tmp = asl_variables_tmp->next;
+         }
+         this->jacobian_row_starts.emplace_back(this->jacobian_column_indices.size());
+      }
+   }
+
+   // walk the Ograd_ list once: the nonzeros of the objective gradient are gathered from the dense ASL gradient in this order
+   void AMPLModel::compute_objective_gradient_indices() {
+      if (this->asl->i.n_obj_ == 0) {
+         return;
+      }
+      this->objective_gradient_indices.reserve(static_cast<size_t>(this->asl->i.nzo_));
+      ograd* asl_variables_tmp = this->asl->i.Ograd_[0];
+      while (asl_variables_tmp != nullptr) {
+         this->objective_gradient_indices.emplace_back(static_cast<size_t>(asl_variables_tmp->varno));
+         asl_variables_tmp = asl_variables_tmp->next;
+      }
+   }
+
+   // copy the ASL sparse gradient of a constraint (stored in this->asl_gradient) into a Uno sparse vector or row
+   template <typename Gradient>
+   void AMPLModel::copy_asl_constraint_gradient(size_t constraint_index, Gradient& gradient) const {
+      cgrad* asl_variables_tmp = this->asl->i.Cgrad_[constraint_index];
+      size_t sparse_asl_index = 0;
+      while (asl_variables_tmp != nullptr) {
+         const size_t variable_index = static_cast<size_t>(asl_variables_tmp->varno);
+         gradient.insert(variable_index, this->asl_gradient[sparse_asl_index]);
+         asl_variables_tmp = asl_variables_tmp->next;
+         sparse_asl_index++;
+      }
+   }
+
+   // the concurrent requests (e.g. from the multistart or portfolio runs on a shared model) compute the sparsity once
+   void AMPLModel::ensure_hessian_sparsity() const {
+      std::call_once(this->hessian_sparsity_flag, [this]() { this->compute_lagrangian_hessian_sparsity(); });
+   }
+
+   void AMPLModel::compute_lagrangian_hessian_sparsity() const {
       // compute the maximum number of nonzero elements, provided that all multipliers are non-zero
       // int (*Sphset) (ASL*, SputInfo**, int nobj, int ow, int y, int uptri);
       const int objective_number = -1;
       const int upper_triangular = 1;
       this->number_asl_hessian_nonzeros = static_cast<size_t>((*(this->asl)->p.Sphset)(this->asl, nullptr, objective_number, 1, 1, upper_triangular));
-      this->asl_hessian.reserve(this->number_asl_hessian_nonzeros);
+      this->asl_hessian.resize(this->number_asl_hessian_nonzeros);
 
       // sparsity pattern
-      [[maybe_unused]] const fint* asl_column_start = this->asl->i.sputinfo_->hcolstarts;
+      const fint* asl_column_start = this->asl->i.sputinfo_->hcolstarts;
+      const fint* asl_row_index = this->asl->i.sputinfo_->hrownos;
       // check that the column pointers are sorted in increasing order
       assert(in_increasing_order(asl_column_start, this->number_variables + 1) && "AMPLModel::evaluate_lagrangian_hessian: column starts are not ordered");
+      // the evaluation threads evaluate the Hessian with the same pattern
+      if (this->parallel_hessian && !this->evaluation_contexts.empty()) {
+         for (ASL* context: this->evaluation_contexts) {
+            const size_t number_context_nonzeros = static_cast<size_t>((*(context)->p.Sphset)(context, nullptr, objective_number, 1, 1,
+               upper_triangular));
+            if (number_context_nonzeros != this->number_asl_hessian_nonzeros) {
+               throw std::runtime_error("AMPLModel: the ASL instances have different Hessian patterns");
+            }
+         }
+         this->hessian_contributions.assign(this->evaluation_contexts.size(), std::vector<double>(this->number_asl_hessian_nonzeros));
+         this->hessian_block_multipliers.assign(this->evaluation_contexts.size() + 1, Vector<double>(this->number_constraints));
+      }
+
+      // coordinates of the nonzeros, in the order of the values computed by Sphes
+      this->hessian_row_indices.resize(this->number_asl_hessian_nonzeros);
+      this->hessian_column_indices.resize(this->number_asl_hessian_nonzeros);
+      for (size_t column_index: Range(this->number_variables)) {
+         for (size_t k: Range(static_cast<size_t>(asl_column_start[column_index]), static_cast<size_t>(asl_column_start[column_index + 1]))) {
+            this->hessian_row_indices[k] = static_cast<size_t>(asl_row_index[k]);
+            this->hessian_column_indices[k] = column_index;
+         }
+      }
+   }
+
+   // the point is registered only if it differs from the known point, so that all the evaluations at the same point share the
+   // common subexpressions. The evaluations at unregistered points register them too
+   void AMPLModel::set_current_point(const Vector<double>& x) const {
+      if (!this->is_point_known || !std::equal(x.data(), x.data() + this->number_variables, this->known_point.data())) {
+         std::copy(x.data(), x.data() + this->number_variables, this->known_point.data());
+         fint error_flag = 0;
+         (*(this->asl)->p.Xknown)(this->asl, this->known_point.data(), &error_flag);
+         // if the common subexpressions cannot be evaluated, the error is raised by the evaluation itself
+         if (0 < error_flag) {
+            this->invalidate_point();
+            return;
+         }
+         this->is_point_known = true;
+      }
+   }
+
+   void AMPLModel::invalidate_point() const {
+      this->asl->i.x_known = 0;
+      this->is_point_known = false;
+   }
+
+   bool AMPLModel::get_user_variable_scaling(Vector<double>& scaling_factors) const {
+      const SufDesc* suffix = suf_get_ASL(this->asl, "scaling_factor", ASL_Sufkind_var);
+      if (suffix == nullptr || suffix->u.r == nullptr) {
+         return false;
+      }
+      // Uno divides the variables by its scaling factors. The variables without a positive suffix value are not scaled
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double scaling_factor = suffix->u.r[variable_index];
+         scaling_factors[variable_index] = (0. < scaling_factor) ? 1. / scaling_factor : 1.;
+      }
+      return true;
+   }
+
+   // AMPL's sstatus suffix values: 1 (bas), 2 (sup), 3 (low), 4 (upp), 5 (equ), 6 (btw). Superbasic and "between" entries are basic
+   bool AMPLModel::get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const {
+      const SufDesc* variable_suffix = suf_get_ASL(this->asl, "sstatus", ASL_Sufkind_var);
+      const SufDesc* constraint_suffix = suf_get_ASL(this->asl, "sstatus", ASL_Sufkind_con);
+      if (variable_suffix == nullptr || variable_suffix->u.i == nullptr || constraint_suffix == nullptr || constraint_suffix->u.i == nullptr) {
+         return false;
+      }
+      // a basis without any status (e.g. no previous solve) is discarded
+      const int* variable_statuses_begin = variable_suffix->u.i;
+      const int* constraint_statuses_begin = constraint_suffix->u.i;
+      const auto is_zero = [](int status) { return status == 0; };
+      if (std::all_of(variable_statuses_begin, variable_statuses_begin + this->number_variables, is_zero) &&
+            std::all_of(constraint_statuses_begin, constraint_statuses_begin + this->number_constraints, is_zero)) {
+         return false;
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         variable_statuses[variable_index] = AMPLModel::to_basis_status(variable_statuses_begin[variable_index]);
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraint_statuses[constraint_index] = AMPLModel::to_basis_status(constraint_statuses_begin[constraint_index]);
+      }
+      return true;
+   }
+
+   bool AMPLModel::get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const {
+      const SufDesc* lower_bound_suffix = suf_get_ASL(this->asl, "lower_bound_duals", ASL_Sufkind_var);
+      const SufDesc* upper_bound_suffix = suf_get_ASL(this->asl, "upper_bound_duals", ASL_Sufkind_var);
+      if (lower_bound_suffix == nullptr || lower_bound_suffix->u.r == nullptr || upper_bound_suffix == nullptr ||
+            upper_bound_suffix->u.r == nullptr) {
+         return false;
+      }
+      // the signs are flipped if we maximize (see postprocess_solution)
+      for (size_t variable_index: Range(this->number_variables)) {
+         lower_bound_multipliers[variable_index] = this->objective_sign * lower_bound_suffix->u.r[variable_index];
+         upper_bound_multipliers[variable_index] = this->objective_sign * upper_bound_suffix->u.r[variable_index];
+      }
+      return true;
+   }
+
+   bool AMPLModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      const SufDesc* variable_suffix = suf_get_ASL(this->asl, "stage", ASL_Sufkind_var);
+      if (variable_suffix == nullptr || variable_suffix->u.i == nullptr) {
+         return false;
+      }
+      const auto to_stage = [](int stage) { return (0 < stage) ? static_cast<size_t>(stage - 1) : Model::no_stage; };
+      for (size_t variable_index: Range(this->number_variables)) {
+         variable_stages[variable_index] = to_stage(variable_suffix->u.i[variable_index]);
+      }
+      // the constraints without suffix take the stage of their variables (see BlockTridiagonalSolver)
+      const SufDesc* constraint_suffix = suf_get_ASL(this->asl, "stage", ASL_Sufkind_con);
+      if (constraint_suffix != nullptr && constraint_suffix->u.i != nullptr) {
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            constraint_stages[constraint_index] = to_stage(constraint_suffix->u.i[constraint_index]);
+         }
+      }
+      return true;
+   }
+
+   BasisStatus AMPLModel::to_basis_status(int sstatus) {
+      switch (sstatus) {
+         case 3: // low
+         case 5: // equ
+            return BasisStatus::AT_LOWER_BOUND;
+         case 4: // upp
+            return BasisStatus::AT_UPPER_BOUND;
+         default:
+            return BasisStatus::BASIC;
+      }
+   }
+
+   bool AMPLModel::are_zero(const double* multipliers_begin, const double* multipliers_end) {
+      return std::all_of(multipliers_begin, multipliers_end, [](double multiplier) {
+         return multiplier == 0.;
+      });
    }
 
    void AMPLModel::determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds, std::vector<BoundType>& status) {
@@ -4,6 +4,7 @@
 #ifndef UNO_AMPLMODEL_H
 #define UNO_AMPLMODEL_H
 
+#include <mutex>
 #include <vector>
 #include "model/Model.hpp"
 #include "linear_algebra/SparseVector.hpp"
@@ -20,6 +21,7 @@ extern "C" {
 namespace uno {
    // forward reference
    class Options;
+   struct AMPLModelStructure;
 
    /*! \class AMPLModel
     * \brief AMPL model
@@ -38,6 +40,14 @@ namespace uno {
       void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
       void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
             SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+      // the scaling factors are applied while the ASL outputs are gathered or scattered
+      void evaluate_scaled_objective_gradient(const Vector<double>& x, const EvaluationScaling& scaling, SparseVector<double>& gradient) const override;
+      void evaluate_scaled_constraint_jacobian(const Vector<double>& x, const EvaluationScaling& scaling,
+            RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_scaled_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const EvaluationScaling& scaling, SymmetricMatrix<size_t, double>& hessian) const override;
 
       [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
       [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
@@ -51,6 +61,7 @@ namespace uno {
 
       [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override;
       [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override;
+      [[nodiscard]] FunctionType get_objective_type() const override;
       [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
       [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override;
       [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override;
@@ -65,26 +76,60 @@ namespace uno {
       [[nodiscard]] size_t number_jacobian_nonzeros() const override;
       [[nodiscard]] size_t number_hessian_nonzeros() const override;
 
-   private:
-      // private constructor to pass the dimensions to the Model base constructor
+      void set_current_point(const Vector<double>& x) const override;
+      void invalidate_point() const override;
+      // the scaled variables are scaling_factor * x (suffix scaling_factor, as in Ipopt)
+      [[nodiscard]] bool get_user_variable_scaling(Vector<double>& scaling_factors) const override;
+      // basis statuses (suffix sstatus) and bound duals (suffixes lower_bound_duals and upper_bound_duals) of a previous solve
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override;
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override;
+      // stages (suffix stage, numbered from 1; 0 stands for no stage)
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override;
+
+   protected:
+      // constructor to pass the dimensions to the Model base constructor
       AMPLModel(const std::string& file_name, ASL* asl, const Options& options);
 
       // mutable: can be modified by const methods (internal state not seen by user)
       mutable ASL* asl; /*!< Instance of the AMPL Solver Library class */
       const bool write_solution_to_file;
+      std::vector<ASL*> evaluation_contexts{}; /*!< Additional ASL instances for the parallel evaluation of the nonlinear constraints */
+      mutable std::vector<double> parallel_jacobian{}; /*!< Jacobian values evaluated in parallel, in the order of the CSR map */
+      const bool parallel_hessian; /*!< the evaluation threads also evaluate the Lagrangian Hessian */
+      // Hessian contributions of the additional ASL instances (in the order of Sphes) and multipliers of the block of each thread
+      mutable std::vector<std::vector<double>> hessian_contributions{};
+      mutable std::vector<Vector<double>> hessian_block_multipliers{};
       mutable std::vector<double> asl_gradient{};
+      std::vector<size_t> objective_gradient_indices{}; /*!< Indices of the nonzeros of the objective gradient, in the order of Ograd_ */
+      mutable Jmp_buf error_jump_buffer{}; /*!< Target of the ASL evaluation errors */
       mutable std::vector<double> asl_hessian{};
-      size_t number_asl_hessian_nonzeros{0}; /*!< Number of nonzero elements in the Hessian */
+      mutable std::vector<double> asl_jacobian{}; /*!< Jacobian values evaluated by Jacval, in the goff layout of ASL */
+      // CSR map from the Jacobian nonzeros to their offsets (goff) in asl_jacobian, precomputed from the Cgrad_ lists
+      std::vector<size_t> jacobian_row_starts{};
+      std::vector<size_t> jacobian_column_indices{};
+      std::vector<size_t> jacobian_offsets{};
+      // the Hessian sparsity is computed upon the first request (see ensure_hessian_sparsity)
+      mutable std::once_flag hessian_sparsity_flag{};
+      mutable size_t number_asl_hessian_nonzeros{0}; /*!< Number of nonzero elements in the Hessian */
+      // coordinates of the Hessian nonzeros, in the order of Sphes
+      mutable std::vector<size_t> hessian_row_indices{};
+      mutable std::vector<size_t> hessian_column_indices{};
 
       std::vector<double> variable_lower_bounds;
       std::vector<double> variable_upper_bounds;
       std::vector<double> constraint_lower_bounds;
       std::vector<double> constraint_upper_bounds;
       std::vector<BoundType> variable_status; /*!< Status of the variables (EQUALITY, BOUNDED_LOWER, BOUNDED_UPPER, BOUNDED_BOTH_SIDES) */
+      FunctionType objective_type{NONLINEAR}; /*!< Type of the objective (LINEAR, NONLINEAR) */
+      const size_t number_nonlinear_constraints; /*!< Number of nonlinear constraints, ordered first by AMPL */
       std::vector<FunctionType> constraint_type; /*!< Types of the constraints (LINEAR, QUADRATIC, NONLINEAR) */
+      std::vector<SparseVector<double>> linear_constraint_gradients; /*!< Constant gradients of the linear constraints, evaluated at load */
       std::vector<BoundType> constraint_status; /*!< Status of the constraints (EQUAL_BOUNDS, BOUNDED_LOWER, BOUNDED_UPPER, BOUNDED_BOTH_SIDES,
     * UNBOUNDED) */
       mutable Vector<double> multipliers_with_flipped_sign;
+      // point registered with Xknown: the common subexpressions are shared by the evaluations at this point
+      mutable Vector<double> known_point;
+      mutable bool is_point_known{false};
 
       // lists of variables and constraints + corresponding collection objects
       std::vector<size_t> linear_constraints{};
@@ -104,10 +149,26 @@ namespace uno {
       CollectionAdapter<std::vector<size_t>&> single_upper_bounded_variables_collection;
       Vector<size_t> fixed_variables;
 
+      void read_bounds();
       void generate_variables();
       void generate_constraints();
-
-      void compute_lagrangian_hessian_sparsity();
+      [[nodiscard]] AMPLModelStructure extract_structure() const;
+      void restore_structure(AMPLModelStructure&& structure);
+      void evaluate_linear_constraint_gradients();
+      void compute_jacobian_offsets();
+      void compute_objective_gradient_indices();
+      template <typename Gradient>
+      void copy_asl_constraint_gradient(size_t constraint_index, Gradient& gradient) const;
+
+      void compute_lagrangian_hessian_sparsity() const;
+      // computes the Hessian sparsity once, when a Hessian model requests it (the first-order methods never do)
+      void ensure_hessian_sparsity() const;
+      template <typename Evaluation>
+      [[nodiscard]] bool evaluate_nonlinear_constraints_in_parallel(const Vector<double>& x, const Evaluation& evaluation) const;
+      void evaluate_lagrangian_hessian_in_parallel(const Vector<double>& x, double objective_multiplier, double* hessian_values) const;
+      // the multipliers are all zero: the functions do not contribute to the Lagrangian Hessian
+      [[nodiscard]] static bool are_zero(const double* multipliers_begin, const double* multipliers_end);
+      [[nodiscard]] static BasisStatus to_basis_status(int sstatus);
       static void determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds, std::vector<BoundType>& status);
    };
 
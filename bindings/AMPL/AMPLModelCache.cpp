@@ -0,0 +1,117 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include "AMPLModelCache.hpp"
+
+namespace uno {
+   namespace {
+      constexpr std::uint64_t FILE_FORMAT_VERSION = 1;
+      constexpr std::uint64_t HEADER_SIZE = 6;
+
+      template <typename ElementType>
+      void write_array(std::ofstream& file, const std::vector<ElementType>& array) {
+         static_assert(std::is_trivially_copyable_v<ElementType>);
+         const std::uint64_t size = array.size();
+         file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+         file.write(reinterpret_cast<const char*>(array.data()), static_cast<std::streamsize>(size * sizeof(ElementType)));
+      }
+
+      template <typename ElementType>
+      bool read_array(std::ifstream& file, std::vector<ElementType>& array) {
+         static_assert(std::is_trivially_copyable_v<ElementType>);
+         std::uint64_t size = 0;
+         if (!file.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+            return false;
+         }
+         array.resize(size);
+         return static_cast<bool>(file.read(reinterpret_cast<char*>(array.data()), static_cast<std::streamsize>(size * sizeof(ElementType))));
+      }
+
+      // the ASL accepts the file name with or without the .nl extension
+      // the order of the arrays defines the file format
+      template <typename Structure, typename Function>
+      bool for_each_array(Structure& structure, const Function& function) {
+         return function(structure.variable_status) && function(structure.constraint_status) && function(structure.constraint_type) &&
+            function(structure.fixed_variables) && function(structure.lower_bounded_variables) && function(structure.upper_bounded_variables) &&
+            function(structure.single_lower_bounded_variables) && function(structure.single_upper_bounded_variables) &&
+            function(structure.equality_constraints) && function(structure.inequality_constraints) && function(structure.linear_constraints) &&
+            function(structure.linear_gradient_starts) && function(structure.linear_gradient_indices) &&
+            function(structure.linear_gradient_values) && function(structure.jacobian_row_starts) &&
+            function(structure.jacobian_column_indices) && function(structure.jacobian_offsets) && function(structure.objective_gradient_indices);
+      }
+   } // namespace
+
+   AMPLModelCache::AMPLModelCache(const std::string& nl_file_name):
+         file_name(AMPLModelCache::nl_file_path(nl_file_name) + ".unocache"),
+         nl_file_hash(AMPLModelCache::hash_file(AMPLModelCache::nl_file_path(nl_file_name))) {
+   }
+
+   std::string AMPLModelCache::nl_file_path(const std::string& nl_file_name) {
+      if (std::ifstream(nl_file_name, std::ios::binary)) {
+         return nl_file_name;
+      }
+      return nl_file_name + ".nl";
+   }
+
+   std::optional<AMPLModelStructure> AMPLModelCache::load(size_t number_variables, size_t number_constraints,
+         size_t number_jacobian_nonzeros) const {
+      std::ifstream file(this->file_name, std::ios::binary);
+      std::uint64_t header[HEADER_SIZE]{};
+      if (!file || !file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+         return std::nullopt;
+      }
+      // the cache is stale if the .nl file has changed
+      const std::uint64_t expected_header[HEADER_SIZE]{FILE_FORMAT_VERSION, sizeof(size_t), this->nl_file_hash, number_variables,
+         number_constraints, number_jacobian_nonzeros};
+      if (!std::equal(header, header + HEADER_SIZE, expected_header)) {
+         return std::nullopt;
+      }
+      AMPLModelStructure structure{};
+      const bool success = for_each_array(structure, [&](auto& array) {
+         return read_array(file, array);
+      });
+      // guard against truncated files
+      if (!success || structure.variable_status.size() != number_variables || structure.constraint_status.size() != number_constraints ||
+            structure.jacobian_offsets.size() != number_jacobian_nonzeros) {
+         return std::nullopt;
+      }
+      return structure;
+   }
+
+   void AMPLModelCache::store(const AMPLModelStructure& structure, size_t number_variables, size_t number_constraints,
+         size_t number_jacobian_nonzeros) const {
+      std::ofstream file(this->file_name, std::ios::binary | std::ios::trunc);
+      if (!file) {
+         throw std::runtime_error("The model cache could not be written to " + this->file_name);
+      }
+      const std::uint64_t header[HEADER_SIZE]{FILE_FORMAT_VERSION, sizeof(size_t), this->nl_file_hash, number_variables, number_constraints,
+         number_jacobian_nonzeros};
+      file.write(reinterpret_cast<const char*>(header), sizeof(header));
+      for_each_array(structure, [&](const auto& array) {
+         write_array(file, array);
+         return true;
+      });
+   }
+
+   // FNV-1a hash of the contents of the file, read by blocks
+   std::uint64_t AMPLModelCache::hash_file(const std::string& file_name) {
+      std::ifstream file(file_name, std::ios::binary);
+      if (!file) {
+         throw std::runtime_error("The file " + file_name + " could not be opened");
+      }
+      std::uint64_t hash = 14695981039346656037ULL;
+      std::vector<char> block(1 << 20);
+      while (file) {
+         file.read(block.data(), static_cast<std::streamsize>(block.size()));
+         const std::streamsize number_bytes = file.gcount();
+         for (std::streamsize byte_index = 0; byte_index < number_bytes; byte_index++) {
+            hash = (hash ^ static_cast<unsigned char>(block[static_cast<size_t>(byte_index)])) * 1099511628211ULL;
+         }
+      }
+      return hash;
+   }
+} // namespace
@@ -0,0 +1,62 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_AMPLMODELCACHE_H
+#define UNO_AMPLMODELCACHE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "model/Model.hpp"
+
+namespace uno {
+   // structure of an AMPL model derived from the .nl file at load time
+   struct AMPLModelStructure {
+      std::vector<BoundType> variable_status{};
+      std::vector<BoundType> constraint_status{};
+      std::vector<FunctionType> constraint_type{};
+      std::vector<size_t> fixed_variables{};
+      std::vector<size_t> lower_bounded_variables{};
+      std::vector<size_t> upper_bounded_variables{};
+      std::vector<size_t> single_lower_bounded_variables{};
+      std::vector<size_t> single_upper_bounded_variables{};
+      std::vector<size_t> equality_constraints{};
+      std::vector<size_t> inequality_constraints{};
+      std::vector<size_t> linear_constraints{};
+      // constant gradients of the linear constraints (CSR, one row per constraint)
+      std::vector<size_t> linear_gradient_starts{};
+      std::vector<size_t> linear_gradient_indices{};
+      std::vector<double> linear_gradient_values{};
+      // map from the Jacobian nonzeros to their offsets in the Jacval array
+      std::vector<size_t> jacobian_row_starts{};
+      std::vector<size_t> jacobian_column_indices{};
+      std::vector<size_t> jacobian_offsets{};
+      std::vector<size_t> objective_gradient_indices{};
+   };
+
+   /*! \class AMPLModelCache
+    * \brief Binary file <model>.nl.unocache that stores the structure of an AMPL model
+    *
+    *  The structure is valid as long as the hash of the .nl file matches the one stored in the file. The arrays are stored
+    *  contiguously with fixed-width elements after a header, so that the file can be memory-mapped
+    */
+   class AMPLModelCache {
+   public:
+      explicit AMPLModelCache(const std::string& nl_file_name);
+
+      [[nodiscard]] std::optional<AMPLModelStructure> load(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros) const;
+      void store(const AMPLModelStructure& structure, size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros) const;
+
+      // name of the .nl file of a model given with or without its extension
+      [[nodiscard]] static std::string nl_file_path(const std::string& nl_file_name);
+      // FNV-1a hash of the content of a file
+      [[nodiscard]] static std::uint64_t hash_file(const std::string& file_name);
+
+   protected:
+      const std::string file_name;
+      const std::uint64_t nl_file_hash;
+   };
+} // namespace
+
+#endif // UNO_AMPLMODELCACHE_H
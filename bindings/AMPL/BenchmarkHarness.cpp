@@ -0,0 +1,179 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include "BenchmarkHarness.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "AMPLModel.hpp"
+#include "Uno.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Timer.hpp"
+
+#ifdef UNO_BENCHMARK_HAS_PROCESSES
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace uno {
+   std::vector<std::string> find_models(const std::string& model_directory) {
+      std::vector<std::string> model_files{};
+      for (const auto& entry: std::filesystem::directory_iterator(model_directory)) {
+         if (entry.is_regular_file() && entry.path().extension() == ".nl") {
+            model_files.emplace_back(entry.path().string());
+         }
+      }
+      std::sort(model_files.begin(), model_files.end());
+      return model_files;
+   }
+
+   BenchmarkRecord solve_model(const std::string& model_file, const Configuration& configuration) {
+      const std::string model_name = std::filesystem::path(model_file).stem().string();
+      const Timer timer{};
+      try {
+         // the options are read (and marked as used) by the solve
+         const Options options = configuration.options;
+         Logger::set_logger(options.get_string("logger"));
+         std::unique_ptr<Model> ampl_model = std::make_unique<AMPLModel>(model_file, options);
+         std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(ampl_model), options);
+
+         Iterate initial_iterate(model->number_variables, model->number_constraints);
+         model->initial_primal_point(initial_iterate.primals);
+         model->project_onto_variable_bounds(initial_iterate.primals);
+         model->initial_dual_point(initial_iterate.multipliers.constraints);
+         initial_iterate.feasibility_multipliers.reset();
+
+         auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*model, options);
+         auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+         Uno uno = Uno(*globalization_mechanism, options);
+         const Result result = uno.solve(*model, initial_iterate, options);
+         return BenchmarkRecord::from_result(model_name, configuration.name, result);
+      }
+      catch (const std::exception& exception) {
+         return BenchmarkRecord::from_error(model_name, configuration.name, exception.what(), timer.get_duration());
+      }
+   }
+
+   static void run_sequentially(const std::vector<std::string>& model_files, const std::vector<Configuration>& configurations,
+         BenchmarkReport& report) {
+      for (const std::string& model_file: model_files) {
+         for (const Configuration& configuration: configurations) {
+            report.add(solve_model(model_file, configuration));
+            std::cout << report.get_records().back().to_csv() << std::endl;
+         }
+      }
+   }
+
+#ifdef UNO_BENCHMARK_HAS_PROCESSES
+   // each solve runs in a child process that sends its record through a pipe
+   static void run_in_processes(const std::vector<std::string>& model_files, const std::vector<Configuration>& configurations,
+         size_t number_processes, BenchmarkReport& report) {
+      struct Job {
+         std::string model_file;
+         const Configuration* configuration;
+         int pipe_descriptor;
+         Timer timer;
+      };
+      std::map<pid_t, Job> running_jobs{};
+      std::vector<BenchmarkRecord> records(model_files.size() * configurations.size());
+      std::map<pid_t, size_t> job_indices{};
+
+      const auto wait_for_job = [&]() {
+         int status;
+         const pid_t pid = waitpid(-1, &status, 0);
+         const auto iterator = running_jobs.find(pid);
+         if (iterator == running_jobs.end()) {
+            throw std::runtime_error("The benchmark harness waited for an unknown process");
+         }
+         Job& job = iterator->second;
+         std::string line{};
+         char buffer[4096];
+         ssize_t number_bytes;
+         while ((number_bytes = read(job.pipe_descriptor, buffer, sizeof(buffer))) > 0) {
+            line.append(buffer, static_cast<size_t>(number_bytes));
+         }
+         close(job.pipe_descriptor);
+         if (!line.empty() && line.back() == '\n') {
+            line.pop_back();
+         }
+         BenchmarkRecord& record = records[job_indices[pid]];
+         if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && !line.empty()) {
+            record = BenchmarkRecord::from_csv(line);
+         }
+         else {
+            const std::string error = WIFSIGNALED(status) ? "Crash (signal " + std::to_string(WTERMSIG(status)) + ")" :
+               "Crash (exit code " + std::to_string(WEXITSTATUS(status)) + ")";
+            record = BenchmarkRecord::from_error(std::filesystem::path(job.model_file).stem().string(), job.configuration->name, error,
+               job.timer.get_duration());
+         }
+         std::cout << record.to_csv() << std::endl;
+         running_jobs.erase(iterator);
+      };
+
+      size_t job_index = 0;
+      for (const std::string& model_file: model_files) {
+         for (const Configuration& configuration: configurations) {
+            if (number_processes <= running_jobs.size()) {
+               wait_for_job();
+            }
+            int pipe_descriptors[2];
+            if (pipe(pipe_descriptors) != 0) {
+               throw std::runtime_error("The benchmark harness could not create a pipe");
+            }
+            // the buffered output would be duplicated in the child
+            std::cout.flush();
+            const pid_t pid = fork();
+            if (pid < 0) {
+               throw std::runtime_error("The benchmark harness could not create a process");
+            }
+            else if (pid == 0) {
+               close(pipe_descriptors[0]);
+               const std::string line = solve_model(model_file, configuration).to_csv() + '\n';
+               [[maybe_unused]] const ssize_t number_bytes = write(pipe_descriptors[1], line.data(), line.size());
+               close(pipe_descriptors[1]);
+               _exit(0);
+            }
+            close(pipe_descriptors[1]);
+            running_jobs.emplace(pid, Job{model_file, &configuration, pipe_descriptors[0], Timer{}});
+            job_indices[pid] = job_index++;
+         }
+      }
+      while (!running_jobs.empty()) {
+         wait_for_job();
+      }
+      for (BenchmarkRecord& record: records) {
+         report.add(std::move(record));
+      }
+   }
+#endif
+
+   void run_solves(const std::vector<std::string>& model_files, const std::vector<Configuration>& configurations, size_t number_processes,
+         BenchmarkReport& report) {
+#ifdef UNO_BENCHMARK_HAS_PROCESSES
+      if (1 < number_processes) {
+         run_in_processes(model_files, configurations, number_processes, report);
+         return;
+      }
+#endif
+      run_sequentially(model_files, configurations, report);
+   }
+
+   void write_file(const std::string& file_name, const std::function<void(std::ostream&)>& write) {
+      std::ofstream file(file_name);
+      if (!file) {
+         throw std::runtime_error("The file " + file_name + " could not be opened");
+      }
+      write(file);
+      std::cout << "Written " << file_name << '\n';
+   }
+} // namespace
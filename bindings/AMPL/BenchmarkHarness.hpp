@@ -0,0 +1,36 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BENCHMARKHARNESS_H
+#define UNO_BENCHMARKHARNESS_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "options/Options.hpp"
+#include "tools/BenchmarkReport.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define UNO_BENCHMARK_HAS_PROCESSES
+#endif
+
+// solves of .nl models with several configurations, shared by the benchmark harness (uno_benchmark) and the option tuner (uno_tune).
+// The ASL is not thread-safe: the solves run in parallel in child processes (which also isolates the harness from crashes)
+
+namespace uno {
+   struct Configuration {
+      std::string name;
+      Options options;
+   };
+
+   // .nl files of a directory, sorted by name
+   std::vector<std::string> find_models(const std::string& model_directory);
+   BenchmarkRecord solve_model(const std::string& model_file, const Configuration& configuration);
+   // solves every (model, configuration) pair, on number_processes processes if available. The records are printed as they come
+   void run_solves(const std::vector<std::string>& model_files, const std::vector<Configuration>& configurations, size_t number_processes,
+         BenchmarkReport& report);
+   void write_file(const std::string& file_name, const std::function<void(std::ostream&)>& write);
+} // namespace
+
+#endif // UNO_BENCHMARKHARNESS_H
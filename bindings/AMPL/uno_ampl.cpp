@@ -1,39 +1,72 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <csignal>
 #include <string>
 #include <stdexcept>
 #include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
 #include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
 #include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
 #include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "AMPLCompiledModel.hpp"
 #include "AMPLModel.hpp"
 #include "AMPLUserCallbacks.hpp"
+#include "DecompositionSolver.hpp"
+#include "Multistart.hpp"
+#include "Portfolio.hpp"
 #include "Uno.hpp"
 #include "model/ModelFactory.hpp"
 #include "options/DefaultOptions.hpp"
 #include "options/Options.hpp"
 #include "options/Presets.hpp"
+#include "tools/Checkpoint.hpp"
 #include "tools/Logger.hpp"
-
-/*
-size_t memory_allocation_amount = 0;
-
-void* operator new(size_t size) {
-   memory_allocation_amount += size;
-   std::cout << "Memory: " << size << '\n';
-   return malloc(size);
-}
-*/
+#include "tools/MemoryPolicy.hpp"
+#include "tools/ThreadPool.hpp"
 
 namespace uno {
+   extern "C" void request_checkpoint(int /*signal*/) {
+      CheckpointRequest::request();
+   }
+
    void run_uno_ampl(const std::string& model_name, const Options& options) {
       try {
+         // the large buffers of the model and of the solver are placed according to the memory policy
+         MemoryPolicy::set_from_options(options);
+         // the parallel components of the solves (multistart runs, concurrent evaluations, linear solvers) share the threads of the pool
+         const std::unique_ptr<ThreadPool> thread_pool = ThreadPool::create(options);
+         const ThreadPool::Scope thread_pool_scope(thread_pool.get());
+
          // AMPL model
-         std::unique_ptr<Model> ampl_model = std::make_unique<AMPLModel>(model_name, options);
+         std::unique_ptr<Model> ampl_model;
+         if (options.get_bool("AMPL_compiled_backend")) {
+            ampl_model = std::make_unique<AMPLCompiledModel>(model_name, options);
+         }
+         else {
+            ampl_model = std::make_unique<AMPLModel>(model_name, options);
+         }
          DISCRETE << "Original model " << ampl_model->name << '\n' << ampl_model->number_variables << " variables, " <<
             ampl_model->number_constraints << " constraints\n";
 
+         // solve from several starting points: the model is loaded once and shared by the starts
+         if (1 < options.get_unsigned_int("multistart_starts")) {
+            Multistart multistart(options);
+            multistart.solve(*ampl_model, options);
+            return;
+         }
+         // race several presets on the model
+         if (!options.get_string("portfolio_presets").empty()) {
+            Portfolio portfolio(options);
+            portfolio.solve(*ampl_model, options);
+            return;
+         }
+         // solve the independent components of the model concurrently
+         if (options.get_bool("decompose_model")) {
+            DecompositionSolver decomposition_solver(options);
+            decomposition_solver.solve(*ampl_model, options);
+            return;
+         }
+
          // reformulate (scale, add slacks, relax the bounds, ...) if necessary
          std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(ampl_model), options);
          DISCRETE << "Reformulated model " << model->name << '\n' << model->number_variables << " variables, " <<
@@ -44,6 +77,10 @@ namespace uno {
          model->initial_primal_point(initial_iterate.primals);
          model->project_onto_variable_bounds(initial_iterate.primals);
          model->initial_dual_point(initial_iterate.multipliers.constraints);
+         // bound duals of a previous solve (if any), e.g. for a warm-started interior-point method
+         if (model->get_initial_bound_duals(initial_iterate.multipliers.lower_bounds, initial_iterate.multipliers.upper_bounds)) {
+            DISCRETE << "The initial bound duals are read from the suffixes lower_bound_duals and upper_bound_duals\n";
+         }
          initial_iterate.feasibility_multipliers.reset();
 
          // create the constraint relaxation strategy, the globalization mechanism and the Uno solver
@@ -54,15 +91,23 @@ namespace uno {
          // create the user callbacks
          AMPLUserCallbacks user_callbacks{};
 
-         // solve the instance
-         Result result = uno.solve(*model, initial_iterate, options, user_callbacks);
+#ifdef SIGUSR1
+         // kill -USR1 writes a checkpoint at the end of the current iteration
+         if (!options.get_string("checkpoint_file").empty()) {
+            std::signal(SIGUSR1, request_checkpoint);
+         }
+#endif
+
+         // solve the instance, or resume a checkpointed solve
+         const std::string& resumed_checkpoint_file = options.get_string("checkpoint_resume_file");
+         Result result = resumed_checkpoint_file.empty() ? uno.solve(*model, initial_iterate, options, user_callbacks) :
+            uno.resume(*model, initial_iterate, resumed_checkpoint_file, options, user_callbacks);
          if (result.optimization_status == OptimizationStatus::SUCCESS) {
             // check result.solution.status
          }
          else {
             // ...
          }
-         // std::cout << "memory_allocation_amount = " << memory_allocation_amount << '\n';
       }
       catch (std::exception& exception) {
          DISCRETE << exception.what() << '\n';
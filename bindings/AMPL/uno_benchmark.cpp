@@ -0,0 +1,154 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "BenchmarkHarness.hpp"
+#include "Uno.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "tools/BenchmarkReport.hpp"
+
+// benchmark harness: solves the .nl models of a directory with several configurations and writes
+// - <output>.csv: one record per (model, configuration) pair with the status, iterations, evaluations, factorizations and wall time
+// - <output>_profiles.csv: the Dolan-Moré performance profiles of the configurations for each metric
+// - <output>_regressions.json: the changes with respect to a baseline (a <output>.csv file of a previous campaign), if any
+
+namespace uno {
+   struct HarnessSettings {
+      size_t number_processes{1};
+      std::string output{"uno_benchmark"};
+      std::string baseline{};
+      RegressionTolerances tolerances{};
+   };
+
+   // each configuration is a preset (e.g. filtersqp) or an option file. The options common to all configurations are applied on top
+   std::vector<Configuration> create_configurations(const std::string& configuration_list, const Options& common_options) {
+      std::vector<Configuration> configurations{};
+      std::istringstream configuration_stream(configuration_list);
+      std::string configuration;
+      while (std::getline(configuration_stream, configuration, ',')) {
+         if (configuration.empty()) {
+            continue;
+         }
+         Options options = DefaultOptions::load();
+         options.overwrite_with(DefaultOptions::determine_solvers());
+         options["logger"] = "SILENT";
+         std::string name;
+         if (std::filesystem::is_regular_file(configuration)) {
+            name = std::filesystem::path(configuration).stem().string();
+            const Options file_options = Options::load_option_file(configuration);
+            options.overwrite_with(Presets::get_preset_options(file_options.get_string_optional("preset")));
+            options.overwrite_with(file_options);
+         }
+         else {
+            name = configuration;
+            options.overwrite_with(Presets::get_preset_options(configuration));
+         }
+         options.overwrite_with(common_options);
+         configurations.push_back({name, std::move(options)});
+      }
+      if (configurations.empty()) {
+         throw std::invalid_argument("The benchmark should contain at least one configuration");
+      }
+      return configurations;
+   }
+
+   int run_benchmark(const std::string& model_directory, const std::vector<Configuration>& configurations, const HarnessSettings& settings) {
+      const std::vector<std::string> model_files = find_models(model_directory);
+      std::cout << "Benchmark of " << configurations.size() << " configurations on " << model_files.size() << " models\n";
+      BenchmarkReport report{};
+      run_solves(model_files, configurations, settings.number_processes, report);
+
+      // number of solved models per configuration
+      for (const Configuration& configuration: configurations) {
+         const auto number_solved = std::count_if(report.get_records().cbegin(), report.get_records().cend(), [&](const BenchmarkRecord& record) {
+            return record.configuration == configuration.name && record.solved;
+         });
+         std::cout << configuration.name << ": " << number_solved << "/" << model_files.size() << " models solved\n";
+      }
+      write_file(settings.output + ".csv", [&](std::ostream& stream) { report.write(stream); });
+      write_file(settings.output + "_profiles.csv", [&](std::ostream& stream) { report.write_performance_profiles(stream); });
+
+      // comparison with the baseline
+      if (!settings.baseline.empty()) {
+         std::ifstream baseline_file(settings.baseline);
+         if (!baseline_file) {
+            throw std::runtime_error("The baseline " + settings.baseline + " could not be opened");
+         }
+         const BenchmarkReport baseline = BenchmarkReport::read(baseline_file);
+         const RegressionReport regression_report = report.compare(baseline, settings.tolerances);
+         write_file(settings.output + "_regressions.json", [&](std::ostream& stream) { regression_report.write_json(stream); });
+         std::cout << regression_report.number_regressions() << " regressions, " << regression_report.number_improvements() <<
+            " improvements with respect to the baseline\n";
+         if (0 < regression_report.number_regressions()) {
+            return EXIT_FAILURE;
+         }
+      }
+      return EXIT_SUCCESS;
+   }
+
+   // the settings of the harness are separated from the solver options
+   HarnessSettings extract_settings(const Options& command_line_options, Options& solver_options) {
+      HarnessSettings settings{};
+      for (const auto& [option_name, option_value]: command_line_options) {
+         if (option_name == "benchmark_processes") {
+            settings.number_processes = std::max(size_t(1), static_cast<size_t>(std::stoul(option_value)));
+         }
+         else if (option_name == "benchmark_output") {
+            settings.output = option_value;
+         }
+         else if (option_name == "benchmark_baseline") {
+            settings.baseline = option_value;
+         }
+         else if (option_name == "benchmark_count_tolerance") {
+            settings.tolerances.relative_count_tolerance = std::stod(option_value);
+         }
+         else if (option_name == "benchmark_time_tolerance") {
+            settings.tolerances.relative_time_tolerance = std::stod(option_value);
+         }
+         else {
+            solver_options[option_name] = option_value;
+         }
+      }
+      return settings;
+   }
+
+   void print_benchmark_instructions() {
+      std::cout << "Benchmark harness of Uno " << Uno::current_version() << '\n';
+      std::cout << "Usage: ./uno_benchmark model_directory configuration[,configuration ...] [option_name=option_value ...]\n";
+      std::cout << "Each configuration is a preset (filtersqp, ipopt, byrd, ...) or an option file\n";
+      std::cout << "The solver options of the command line are common to all configurations. The harness options are:\n";
+      std::cout << "- benchmark_processes=N: number of solves run in parallel (default: 1)\n";
+      std::cout << "- benchmark_output=prefix: prefix of the output files (default: uno_benchmark)\n";
+      std::cout << "- benchmark_baseline=file: records of a previous campaign, compared with the current records\n";
+      std::cout << "- benchmark_count_tolerance=0.1, benchmark_time_tolerance=0.25: relative changes reported as regressions\n";
+   }
+} // namespace
+
+int main(int argc, char* argv[]) {
+   using namespace uno;
+
+   try {
+      if (argc < 3) {
+         print_benchmark_instructions();
+         return EXIT_SUCCESS;
+      }
+      const Options command_line_options = Options::get_command_line_options(argc, argv, 3);
+      Options solver_options(false);
+      const HarnessSettings settings = extract_settings(command_line_options, solver_options);
+      const std::vector<Configuration> configurations = create_configurations(argv[2], solver_options);
+      return run_benchmark(argv[1], configurations, settings);
+   }
+   catch (std::exception& exception) {
+      std::cout << exception.what() << '\n';
+      return EXIT_FAILURE;
+   }
+}
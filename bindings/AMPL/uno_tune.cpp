@@ -0,0 +1,127 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "BenchmarkHarness.hpp"
+#include "Uno.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "tools/BenchmarkReport.hpp"
+#include "tools/OptionTuner.hpp"
+
+// option tuner: searches the option values (and presets) of a search-space file that minimize a metric of the benchmark harness over
+// the .nl models of a training directory, and writes the winning configuration as an option file (option_file=... of uno_ampl)
+
+namespace uno {
+   struct TunerSettings {
+      BenchmarkMetric metric{BenchmarkMetric::WALL_TIME};
+      TuningStrategy strategy{TuningStrategy::SUCCESSIVE_HALVING};
+      size_t number_configurations{27};
+      unsigned int seed{0};
+      size_t number_processes{1};
+      std::string output{"uno_tuned.opt"};
+   };
+
+   // the settings of the tuner are separated from the solver options
+   TunerSettings extract_settings(const Options& command_line_options, Options& solver_options) {
+      TunerSettings settings{};
+      for (const auto& [option_name, option_value]: command_line_options) {
+         if (option_name == "tune_metric") {
+            settings.metric = benchmark_metric_from_string(option_value);
+         }
+         else if (option_name == "tune_strategy") {
+            settings.strategy = OptionTuner::strategy_from_string(option_value);
+         }
+         else if (option_name == "tune_configurations") {
+            settings.number_configurations = static_cast<size_t>(std::stoul(option_value));
+         }
+         else if (option_name == "tune_seed") {
+            settings.seed = static_cast<unsigned int>(std::stoul(option_value));
+         }
+         else if (option_name == "tune_output") {
+            settings.output = option_value;
+         }
+         else if (option_name == "benchmark_processes") {
+            settings.number_processes = std::max(size_t(1), static_cast<size_t>(std::stoul(option_value)));
+         }
+         else {
+            solver_options[option_name] = option_value;
+         }
+      }
+      return settings;
+   }
+
+   int run_tuner(const std::string& model_directory, const std::string& search_space_file, const Options& common_options,
+         const TunerSettings& settings) {
+      std::ifstream search_space_stream(search_space_file);
+      if (!search_space_stream) {
+         throw std::runtime_error("The search space " + search_space_file + " could not be opened");
+      }
+      std::vector<std::string> model_files = find_models(model_directory);
+      // the subsets of successive halving are the first models of a random permutation of the training set
+      std::mt19937 generator(settings.seed);
+      std::shuffle(model_files.begin(), model_files.end(), generator);
+      std::cout << "Tuning of " << settings.number_configurations << " configurations on " << model_files.size() << " models\n";
+
+      const auto evaluate = [&](const std::string& configuration_name, const Options& parameters, size_t number_models) {
+         Options options = DefaultOptions::load();
+         options.overwrite_with(DefaultOptions::determine_solvers());
+         options["logger"] = "SILENT";
+         options.overwrite_with(Presets::get_preset_options(parameters.get_string_optional("preset")));
+         options.overwrite_with(common_options);
+         options.overwrite_with(parameters);
+         const std::vector<std::string> training_models(model_files.cbegin(), model_files.cbegin() + static_cast<long>(number_models));
+         BenchmarkReport report{};
+         run_solves(training_models, {Configuration{configuration_name, std::move(options)}}, settings.number_processes, report);
+         return report.get_records();
+      };
+      OptionTuner tuner(OptionTuner::read_search_space(search_space_stream), settings.metric, settings.strategy,
+            settings.number_configurations, settings.seed);
+      const TunedConfiguration best_configuration = tuner.tune(model_files.size(), evaluate);
+      std::cout << best_configuration.name << " is the best configuration: " << best_configuration.score.number_failures <<
+            " unsolved models, mean " << benchmark_metric_to_string(settings.metric) << " " << best_configuration.score.metric_mean << '\n';
+      write_file(settings.output, [&](std::ostream& stream) { OptionTuner::write_option_file(stream, best_configuration); });
+      return EXIT_SUCCESS;
+   }
+
+   void print_tuner_instructions() {
+      std::cout << "Option tuner of Uno " << Uno::current_version() << '\n';
+      std::cout << "Usage: ./uno_tune model_directory search_space_file [option_name=option_value ...]\n";
+      std::cout << "Each line of the search space is \"option value|value|...\" or \"option lower:upper[:log][:int]\"\n";
+      std::cout << "(e.g. \"preset filtersqp|ipopt\" or \"TR_radius 0.1:100:log\")\n";
+      std::cout << "The solver options of the command line are common to all configurations. The tuner options are:\n";
+      std::cout << "- tune_metric=wall_time: metric minimized after the number of unsolved models\n";
+      std::cout << "  (iterations|evaluations|factorizations|wall_time)\n";
+      std::cout << "- tune_strategy=successive_halving: search strategy (random|successive_halving)\n";
+      std::cout << "- tune_configurations=27: number of sampled configurations\n";
+      std::cout << "- tune_seed=0: seed of the sampling and of the order of the models\n";
+      std::cout << "- tune_output=uno_tuned.opt: option file of the best configuration\n";
+      std::cout << "- benchmark_processes=N: number of solves run in parallel (default: 1)\n";
+   }
+} // namespace
+
+int main(int argc, char* argv[]) {
+   using namespace uno;
+
+   try {
+      if (argc < 3) {
+         print_tuner_instructions();
+         return EXIT_SUCCESS;
+      }
+      const Options command_line_options = Options::get_command_line_options(argc, argv, 3);
+      Options solver_options(false);
+      const TunerSettings settings = extract_settings(command_line_options, solver_options);
+      return run_tuner(argv[1], argv[2], solver_options, settings);
+   }
+   catch (std::exception& exception) {
+      std::cout << exception.what() << '\n';
+      return EXIT_FAILURE;
+   }
+}
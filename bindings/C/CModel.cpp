@@ -0,0 +1,505 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include "CModel.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "model/EvaluationScaling.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/BatchEvaluation.hpp"
+#include "optimization/EvaluationErrors.hpp"
+#include "optimization/Iterate.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   namespace {
+      FunctionType to_function_type(int32_t function_type) {
+         switch (function_type) {
+            case UNO_LINEAR:
+               return LINEAR;
+            case UNO_QUADRATIC:
+               return QUADRATIC;
+            case UNO_NONLINEAR:
+               return NONLINEAR;
+            default:
+               throw std::invalid_argument("The function type " + std::to_string(function_type) + " is unknown");
+         }
+      }
+
+      size_t to_index(int32_t index, size_t dimension) {
+         if (index < 0 || dimension <= static_cast<size_t>(index)) {
+            throw std::invalid_argument("The index " + std::to_string(index) + " is out of bounds");
+         }
+         return static_cast<size_t>(index);
+      }
+   } // namespace
+
+   CModel::CModel(size_t number_variables, const double* variables_lower_bounds, const double* variables_upper_bounds, size_t number_constraints,
+         const double* constraints_lower_bounds, const double* constraints_upper_bounds, double objective_sign):
+         Model("C model", number_variables, number_constraints, objective_sign),
+         functions_point(number_variables),
+         cached_constraints(number_constraints),
+         derivatives_point(number_variables),
+         multipliers_with_sign(number_constraints),
+         variable_lower_bounds(variables_lower_bounds, variables_lower_bounds + number_variables),
+         variable_upper_bounds(variables_upper_bounds, variables_upper_bounds + number_variables),
+         constraint_lower_bounds(constraints_lower_bounds, constraints_lower_bounds + number_constraints),
+         constraint_upper_bounds(constraints_upper_bounds, constraints_upper_bounds + number_constraints),
+         variable_status(number_variables),
+         constraint_status(number_constraints),
+         constraint_type(number_constraints, NONLINEAR),
+         initial_primals(number_variables, 0.),
+         initial_multipliers(number_constraints, 0.),
+         linear_constraints_collection(this->linear_constraints),
+         equality_constraints_collection(this->equality_constraints),
+         inequality_constraints_collection(this->inequality_constraints),
+         lower_bounded_variables_collection(this->lower_bounded_variables),
+         upper_bounded_variables_collection(this->upper_bounded_variables),
+         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
+         single_upper_bounded_variables_collection(this->single_upper_bounded_variables) {
+      if (objective_sign != 1. && objective_sign != -1.) {
+         throw std::invalid_argument("The objective sign should be " + std::to_string(UNO_MINIMIZE) + " or " + std::to_string(UNO_MAXIMIZE));
+      }
+      // variables
+      this->lower_bounded_variables.reserve(this->number_variables);
+      this->upper_bounded_variables.reserve(this->number_variables);
+      this->single_lower_bounded_variables.reserve(this->number_variables);
+      this->single_upper_bounded_variables.reserve(this->number_variables);
+      this->fixed_variables.reserve(this->number_variables);
+      this->generate_variables();
+
+      // constraints
+      this->equality_constraints.reserve(this->number_constraints);
+      this->inequality_constraints.reserve(this->number_constraints);
+      this->linear_constraints.reserve(this->number_constraints);
+      this->generate_constraints();
+   }
+
+   void CModel::set_objective(FunctionType objective_type, UnoObjective objective, size_t number_gradient_nonzeros,
+         const int32_t* gradient_indices, UnoObjectiveGradient objective_gradient) {
+      this->objective_type = objective_type;
+      this->objective = objective;
+      this->objective_gradient = objective_gradient;
+      this->gradient_indices.resize(number_gradient_nonzeros);
+      for (size_t nonzero_index: Range(number_gradient_nonzeros)) {
+         this->gradient_indices[nonzero_index] = to_index(gradient_indices[nonzero_index], this->number_variables);
+      }
+      this->gradient_values.resize(number_gradient_nonzeros);
+   }
+
+   void CModel::set_constraints(const int32_t* constraint_types, UnoConstraints constraints, size_t number_jacobian_nonzeros,
+         const int32_t* jacobian_row_indices, const int32_t* jacobian_column_indices, UnoJacobian constraint_jacobian) {
+      this->constraints = constraints;
+      this->constraint_jacobian = constraint_jacobian;
+      this->linear_constraints.clear();
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->constraint_type[constraint_index] = (constraint_types != nullptr) ? to_function_type(constraint_types[constraint_index]) : NONLINEAR;
+         if (this->constraint_type[constraint_index] == LINEAR) {
+            this->linear_constraints.emplace_back(constraint_index);
+         }
+      }
+      // sort the nonzeros by row
+      std::vector<size_t> row_indices(number_jacobian_nonzeros);
+      std::vector<size_t> column_indices(number_jacobian_nonzeros);
+      for (size_t nonzero_index: Range(number_jacobian_nonzeros)) {
+         row_indices[nonzero_index] = to_index(jacobian_row_indices[nonzero_index], this->number_constraints);
+         column_indices[nonzero_index] = to_index(jacobian_column_indices[nonzero_index], this->number_variables);
+      }
+      CModel::compress(this->number_constraints, row_indices, column_indices, this->jacobian_row_starts, this->jacobian_column_indices,
+            this->jacobian_positions);
+      this->jacobian_values.resize(number_jacobian_nonzeros);
+   }
+
+   void CModel::set_lagrangian_hessian(size_t number_hessian_nonzeros, const int32_t* hessian_row_indices, const int32_t* hessian_column_indices,
+         UnoLagrangianHessian lagrangian_hessian) {
+      this->lagrangian_hessian = lagrangian_hessian;
+      // store the upper triangle (row <= column) sorted by column
+      std::vector<size_t> row_indices(number_hessian_nonzeros);
+      std::vector<size_t> column_indices(number_hessian_nonzeros);
+      for (size_t nonzero_index: Range(number_hessian_nonzeros)) {
+         const size_t row_index = to_index(hessian_row_indices[nonzero_index], this->number_variables);
+         const size_t column_index = to_index(hessian_column_indices[nonzero_index], this->number_variables);
+         row_indices[nonzero_index] = std::min(row_index, column_index);
+         column_indices[nonzero_index] = std::max(row_index, column_index);
+      }
+      CModel::compress(this->number_variables, column_indices, row_indices, this->hessian_column_starts, this->hessian_row_indices,
+            this->hessian_positions);
+      this->hessian_values.resize(number_hessian_nonzeros);
+   }
+
+   void CModel::set_batched_evaluations(UnoBatchedFunctions functions, UnoBatchedDerivatives derivatives) {
+      this->batched_functions = functions;
+      this->batched_derivatives = derivatives;
+      this->invalidate_point();
+   }
+
+   void CModel::set_multi_point_evaluations(UnoMultiPointEvaluations evaluations) {
+      this->multi_point_evaluations = evaluations;
+   }
+
+   void CModel::set_user_data(void* user_data) {
+      this->user_data = user_data;
+   }
+
+   void CModel::set_initial_point(const double* initial_primals, const double* initial_multipliers) {
+      std::copy(initial_primals, initial_primals + this->number_variables, this->initial_primals.begin());
+      if (initial_multipliers != nullptr) {
+         std::copy(initial_multipliers, initial_multipliers + this->number_constraints, this->initial_multipliers.begin());
+      }
+      else {
+         std::fill(this->initial_multipliers.begin(), this->initial_multipliers.end(), 0.);
+      }
+   }
+
+   void CModel::set_stages(const int32_t* variable_stages, const int32_t* constraint_stages) {
+      const auto to_stage = [](int32_t stage) { return (stage < 0) ? Model::no_stage : static_cast<size_t>(stage); };
+      this->variable_stages.resize(this->number_variables);
+      std::transform(variable_stages, variable_stages + this->number_variables, this->variable_stages.begin(), to_stage);
+      this->constraint_stages.resize(this->number_constraints);
+      std::transform(constraint_stages, constraint_stages + this->number_constraints, this->constraint_stages.begin(), to_stage);
+   }
+
+   bool CModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      if (this->variable_stages.empty()) {
+         return false;
+      }
+      std::copy(this->variable_stages.cbegin(), this->variable_stages.cend(), variable_stages.begin());
+      std::copy(this->constraint_stages.cbegin(), this->constraint_stages.cend(), constraint_stages.begin());
+      return true;
+   }
+
+   // the objective and its gradient are required, as well as the constraints and their Jacobian if the model is constrained, unless
+   // batched callbacks are set. The Hessian is required unless the problem is linear
+   bool CModel::is_complete() const {
+      const bool has_batched_evaluations = (this->batched_functions != nullptr && this->batched_derivatives != nullptr);
+      if (!has_batched_evaluations && (this->objective == nullptr || this->objective_gradient == nullptr)) {
+         return false;
+      }
+      if (!has_batched_evaluations && this->is_constrained() && (this->constraints == nullptr || this->constraint_jacobian == nullptr)) {
+         return false;
+      }
+      return (this->lagrangian_hessian != nullptr || this->hessian_positions.empty());
+   }
+
+   double CModel::evaluate_objective(const Vector<double>& x) const {
+      if (this->batched_functions != nullptr) {
+         this->evaluate_batched_functions(x);
+         return this->objective_sign * this->cached_objective;
+      }
+      double objective_value = 0.;
+      if (this->objective(static_cast<int32_t>(this->number_variables), x.data(), &objective_value, this->user_data) != 0) {
+         throw FunctionEvaluationError();
+      }
+      return this->objective_sign * objective_value;
+   }
+
+   void CModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->evaluate_scaled_objective_gradient(x, EvaluationScaling{}, gradient);
+   }
+
+   void CModel::evaluate_scaled_objective_gradient(const Vector<double>& x, const EvaluationScaling& scaling, SparseVector<double>& gradient) const {
+      if (this->batched_derivatives != nullptr) {
+         this->evaluate_batched_derivatives(x);
+      }
+      else if (this->objective_gradient(static_cast<int32_t>(this->number_variables), x.data(), this->gradient_values.data(),
+            this->user_data) != 0) {
+         throw GradientEvaluationError();
+      }
+      // scale by the objective sign
+      const double objective_factor = this->objective_sign * scaling.objective;
+      for (size_t nonzero_index: Range(this->gradient_indices.size())) {
+         const size_t variable_index = this->gradient_indices[nonzero_index];
+         gradient.insert(variable_index, objective_factor * scaling.variable(variable_index) * this->gradient_values[nonzero_index]);
+      }
+   }
+
+   void CModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      this->evaluate_scaled_constraints(x, EvaluationScaling{}, constraints);
+   }
+
+   void CModel::evaluate_scaled_constraints(const Vector<double>& x, const EvaluationScaling& scaling, std::vector<double>& constraints) const {
+      if (!this->is_constrained()) {
+         return;
+      }
+      if (this->batched_functions != nullptr) {
+         this->evaluate_batched_functions(x);
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            constraints[constraint_index] = scaling.constraint(constraint_index) * this->cached_constraints[constraint_index];
+         }
+         return;
+      }
+      if (this->constraints(static_cast<int32_t>(this->number_variables), static_cast<int32_t>(this->number_constraints), x.data(),
+            constraints.data(), this->user_data) != 0) {
+         throw FunctionEvaluationError();
+      }
+      // the callback writes into the output: it is scaled in place
+      if (scaling.constraints != nullptr) {
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            constraints[constraint_index] *= scaling.constraints[constraint_index];
+         }
+      }
+   }
+
+   // the callback computes the whole Jacobian: only the row of the constraint is copied
+   void CModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      if (this->batched_derivatives != nullptr) {
+         this->evaluate_batched_derivatives(x);
+      }
+      else if (this->constraint_jacobian(static_cast<int32_t>(this->number_variables), static_cast<int32_t>(this->jacobian_positions.size()), x.data(),
+            this->jacobian_values.data(), this->user_data) != 0) {
+         throw GradientEvaluationError();
+      }
+      gradient.clear();
+      for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+         gradient.insert(this->jacobian_column_indices[nonzero_index], this->jacobian_values[this->jacobian_positions[nonzero_index]]);
+      }
+   }
+
+   void CModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      this->evaluate_scaled_constraint_jacobian(x, EvaluationScaling{}, constraint_jacobian);
+   }
+
+   void CModel::evaluate_scaled_constraint_jacobian(const Vector<double>& x, const EvaluationScaling& scaling,
+         RectangularMatrix<double>& constraint_jacobian) const {
+      if (!this->is_constrained()) {
+         return;
+      }
+      if (this->batched_derivatives != nullptr) {
+         this->evaluate_batched_derivatives(x);
+      }
+      else if (this->constraint_jacobian(static_cast<int32_t>(this->number_variables), static_cast<int32_t>(this->jacobian_positions.size()), x.data(),
+            this->jacobian_values.data(), this->user_data) != 0) {
+         throw GradientEvaluationError();
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         // fill the row of the CSR Jacobian directly
+         auto constraint_gradient = constraint_jacobian[constraint_index];
+         constraint_gradient.clear();
+         const double row_scaling = scaling.constraint(constraint_index);
+         for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+            const size_t variable_index = this->jacobian_column_indices[nonzero_index];
+            constraint_gradient.insert(variable_index, row_scaling * scaling.variable(variable_index) *
+               this->jacobian_values[this->jacobian_positions[nonzero_index]]);
+         }
+      }
+   }
+
+   void CModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      this->evaluate_scaled_lagrangian_hessian(x, objective_multiplier, multipliers, EvaluationScaling{}, hessian);
+   }
+
+   void CModel::evaluate_scaled_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         const EvaluationScaling& scaling, SymmetricMatrix<size_t, double>& hessian) const {
+      assert(hessian.capacity() >= this->hessian_positions.size());
+      hessian.reset();
+      if (!this->hessian_positions.empty()) {
+         // the user objective is scaled by the objective sign; the Lagrangian of the C API and that of Uno share the sign of the multipliers
+         objective_multiplier *= this->objective_sign * scaling.objective;
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            this->multipliers_with_sign[constraint_index] = scaling.constraint(constraint_index) * multipliers[constraint_index];
+         }
+         if (this->lagrangian_hessian(static_cast<int32_t>(this->number_variables), static_cast<int32_t>(this->number_constraints),
+               static_cast<int32_t>(this->hessian_positions.size()), x.data(), objective_multiplier, this->multipliers_with_sign.data(),
+               this->hessian_values.data(), this->user_data) != 0) {
+            throw GradientEvaluationError();
+         }
+      }
+      // copy the nonzeros column by column
+      for (size_t column_index: Range(this->number_variables)) {
+         if (!this->hessian_positions.empty()) {
+            for (size_t nonzero_index: Range(this->hessian_column_starts[column_index], this->hessian_column_starts[column_index + 1])) {
+               const size_t row_index = this->hessian_row_indices[nonzero_index];
+               hessian.insert(scaling.variable(row_index) * scaling.variable(column_index) * this->hessian_values[this->hessian_positions[nonzero_index]],
+                  row_index, column_index);
+            }
+         }
+         hessian.finalize_column(column_index);
+      }
+   }
+
+   void CModel::initial_primal_point(Vector<double>& x) const {
+      assert(x.size() >= this->number_variables);
+      std::copy(this->initial_primals.cbegin(), this->initial_primals.cend(), x.begin());
+   }
+
+   void CModel::initial_dual_point(Vector<double>& multipliers) const {
+      assert(multipliers.size() >= this->number_constraints);
+      std::copy(this->initial_multipliers.cbegin(), this->initial_multipliers.cend(), multipliers.begin());
+   }
+
+   // flip the signs of the multipliers and the objective if we maximize
+   void CModel::postprocess_solution(Iterate& iterate, IterateStatus /*termination_status*/) const {
+      iterate.multipliers.constraints *= this->objective_sign;
+      iterate.multipliers.lower_bounds *= this->objective_sign;
+      iterate.multipliers.upper_bounds *= this->objective_sign;
+      iterate.evaluations.objective *= this->objective_sign;
+   }
+
+   void CModel::evaluate_batch(BatchEvaluation& evaluation) const {
+      if (this->multi_point_evaluations == nullptr) {
+         Model::evaluate_batch(evaluation);
+         return;
+      }
+      const size_t number_points = evaluation.number_points();
+      const size_t number_gradient_nonzeros = this->gradient_indices.size();
+      this->batch_points.resize(number_points * this->number_variables);
+      this->batch_objectives.resize(number_points);
+      this->batch_constraints.resize(number_points * this->number_constraints);
+      this->batch_gradients.resize(evaluation.evaluate_objective_gradients ? number_points * number_gradient_nonzeros : 0);
+      this->batch_statuses.assign(number_points, 0);
+      for (size_t point_index: Range(number_points)) {
+         const Vector<double>& x = evaluation.points[point_index];
+         std::copy(x.data(), x.data() + this->number_variables, this->batch_points.data() + point_index * this->number_variables);
+      }
+      const int32_t status = this->multi_point_evaluations(static_cast<int32_t>(number_points), static_cast<int32_t>(this->number_variables),
+            static_cast<int32_t>(this->number_constraints), static_cast<int32_t>(number_gradient_nonzeros), this->batch_points.data(),
+            this->batch_objectives.data(), this->batch_constraints.data(),
+            evaluation.evaluate_objective_gradients ? this->batch_gradients.data() : nullptr, this->batch_statuses.data(), this->user_data);
+      // scatter the values, scaled by the objective sign
+      for (size_t point_index: Range(number_points)) {
+         if (status != 0 || this->batch_statuses[point_index] != 0) {
+            evaluation.errors[point_index] = std::make_exception_ptr(FunctionEvaluationError());
+            continue;
+         }
+         evaluation.errors[point_index] = nullptr;
+         evaluation.objectives[point_index] = this->objective_sign * this->batch_objectives[point_index];
+         std::copy(this->batch_constraints.data() + point_index * this->number_constraints,
+               this->batch_constraints.data() + (point_index + 1) * this->number_constraints, evaluation.constraints[point_index].data());
+         if (evaluation.evaluate_objective_gradients) {
+            SparseVector<double>& gradient = evaluation.objective_gradients[point_index];
+            gradient.clear();
+            for (size_t nonzero_index: Range(number_gradient_nonzeros)) {
+               gradient.insert(this->gradient_indices[nonzero_index],
+                     this->objective_sign * this->batch_gradients[point_index * number_gradient_nonzeros + nonzero_index]);
+            }
+         }
+      }
+   }
+
+   void CModel::invalidate_point() const {
+      this->are_functions_cached = false;
+      this->are_derivatives_cached = false;
+   }
+
+   // a single callback computes the objective and the constraints at x
+   void CModel::evaluate_batched_functions(const Vector<double>& x) const {
+      if (this->are_functions_cached && this->is_cached_point(x, this->functions_point)) {
+         return;
+      }
+      this->are_functions_cached = false;
+      if (this->batched_functions(static_cast<int32_t>(this->number_variables), static_cast<int32_t>(this->number_constraints), x.data(),
+            &this->cached_objective, this->cached_constraints.data(), this->user_data) != 0) {
+         throw FunctionEvaluationError();
+      }
+      std::copy(x.data(), x.data() + this->number_variables, this->functions_point.data());
+      this->are_functions_cached = true;
+   }
+
+   // a single callback computes the objective gradient and the constraint Jacobian at x
+   void CModel::evaluate_batched_derivatives(const Vector<double>& x) const {
+      if (this->are_derivatives_cached && this->is_cached_point(x, this->derivatives_point)) {
+         return;
+      }
+      this->are_derivatives_cached = false;
+      if (this->batched_derivatives(static_cast<int32_t>(this->number_variables), static_cast<int32_t>(this->gradient_indices.size()),
+            static_cast<int32_t>(this->jacobian_positions.size()), x.data(), this->gradient_values.data(), this->jacobian_values.data(),
+            this->user_data) != 0) {
+         throw GradientEvaluationError();
+      }
+      std::copy(x.data(), x.data() + this->number_variables, this->derivatives_point.data());
+      this->are_derivatives_cached = true;
+   }
+
+   bool CModel::is_cached_point(const Vector<double>& x, const Vector<double>& point) const {
+      return std::equal(x.data(), x.data() + this->number_variables, point.data());
+   }
+
+   void CModel::generate_variables() {
+      for (size_t variable_index: Range(this->number_variables)) {
+         if (this->variable_lower_bounds[variable_index] == this->variable_upper_bounds[variable_index]) {
+            WARNING << "Variable x" << variable_index << " has identical bounds\n";
+            this->fixed_variables.emplace_back(variable_index);
+         }
+      }
+      CModel::determine_bounds_types(this->variable_lower_bounds, this->variable_upper_bounds, this->variable_status);
+      // figure out the bounded variables
+      for (size_t variable_index: Range(this->number_variables)) {
+         const BoundType status = this->get_variable_bound_type(variable_index);
+         if (status == BOUNDED_LOWER || status == BOUNDED_BOTH_SIDES) {
+            this->lower_bounded_variables.emplace_back(variable_index);
+            if (status == BOUNDED_LOWER) {
+               this->single_lower_bounded_variables.emplace_back(variable_index);
+            }
+         }
+         if (status == BOUNDED_UPPER || status == BOUNDED_BOTH_SIDES) {
+            this->upper_bounded_variables.emplace_back(variable_index);
+            if (status == BOUNDED_UPPER) {
+               this->single_upper_bounded_variables.emplace_back(variable_index);
+            }
+         }
+      }
+   }
+
+   void CModel::generate_constraints() {
+      CModel::determine_bounds_types(this->constraint_lower_bounds, this->constraint_upper_bounds, this->constraint_status);
+      // partition equality and inequality constraints
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (this->get_constraint_bound_type(constraint_index) == EQUAL_BOUNDS) {
+            this->equality_constraints.emplace_back(constraint_index);
+         }
+         else {
+            this->inequality_constraints.emplace_back(constraint_index);
+         }
+      }
+   }
+
+   void CModel::determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds, std::vector<BoundType>& status) {
+      assert(lower_bounds.size() == status.size());
+      assert(upper_bounds.size() == status.size());
+      for (size_t index: Range(lower_bounds.size())) {
+         if (lower_bounds[index] == upper_bounds[index]) {
+            status[index] = EQUAL_BOUNDS;
+         }
+         else if (is_finite(lower_bounds[index]) && is_finite(upper_bounds[index])) {
+            status[index] = BOUNDED_BOTH_SIDES;
+         }
+         else if (is_finite(lower_bounds[index])) {
+            status[index] = BOUNDED_LOWER;
+         }
+         else if (is_finite(upper_bounds[index])) {
+            status[index] = BOUNDED_UPPER;
+         }
+         else {
+            status[index] = UNBOUNDED;
+         }
+      }
+   }
+
+   // the sort is stable: within a row (or column), the nonzeros keep the order in which they were declared
+   void CModel::compress(size_t dimension, const std::vector<size_t>& major_indices, const std::vector<size_t>& minor_indices,
+         std::vector<size_t>& starts, std::vector<size_t>& sorted_minor_indices, std::vector<size_t>& positions) {
+      const size_t number_nonzeros = major_indices.size();
+      starts.assign(dimension + 1, 0);
+      for (size_t major_index: major_indices) {
+         starts[major_index + 1]++;
+      }
+      for (size_t index: Range(dimension)) {
+         starts[index + 1] += starts[index];
+      }
+      sorted_minor_indices.resize(number_nonzeros);
+      positions.resize(number_nonzeros);
+      std::vector<size_t> next_slot(starts.cbegin(), starts.cend() - 1);
+      for (size_t nonzero_index: Range(number_nonzeros)) {
+         const size_t slot = next_slot[major_indices[nonzero_index]]++;
+         sorted_minor_indices[slot] = minor_indices[nonzero_index];
+         positions[slot] = nonzero_index;
+      }
+   }
+} // namespace
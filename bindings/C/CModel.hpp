@@ -0,0 +1,175 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CMODEL_H
+#define UNO_CMODEL_H
+
+#include <vector>
+#include "Uno_C_API.h"
+#include "model/Model.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+
+namespace uno {
+   /*! \class CModel
+    * \brief Model described by the C API
+    *
+    *  The bounds are stored as arrays and the sparsity patterns of the derivatives are declared once. The callbacks write the values
+    *  into preallocated arrays, which are scattered into the Uno data structures through maps precomputed from the patterns.
+    *  The constraints are evaluated directly into the buffer of Uno. With batched callbacks, the functions and the first derivatives
+    *  are each evaluated once per point and cached until another point is evaluated. With a multi-point callback, the batches of points
+    *  are evaluated by a single call
+    */
+   class CModel: public Model {
+   public:
+      CModel(size_t number_variables, const double* variables_lower_bounds, const double* variables_upper_bounds, size_t number_constraints,
+            const double* constraints_lower_bounds, const double* constraints_upper_bounds, double objective_sign);
+
+      void set_objective(FunctionType objective_type, UnoObjective objective, size_t number_gradient_nonzeros, const int32_t* gradient_indices,
+            UnoObjectiveGradient objective_gradient);
+      void set_constraints(const int32_t* constraint_types, UnoConstraints constraints, size_t number_jacobian_nonzeros,
+            const int32_t* jacobian_row_indices, const int32_t* jacobian_column_indices, UnoJacobian constraint_jacobian);
+      void set_lagrangian_hessian(size_t number_hessian_nonzeros, const int32_t* hessian_row_indices, const int32_t* hessian_column_indices,
+            UnoLagrangianHessian lagrangian_hessian);
+      void set_batched_evaluations(UnoBatchedFunctions functions, UnoBatchedDerivatives derivatives);
+      void set_multi_point_evaluations(UnoMultiPointEvaluations evaluations);
+      void set_user_data(void* user_data);
+      void set_initial_point(const double* initial_primals, const double* initial_multipliers);
+      // negative values stand for no stage
+      void set_stages(const int32_t* variable_stages, const int32_t* constraint_stages);
+      [[nodiscard]] bool is_complete() const;
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      // the scaling factors are applied while the callback outputs are copied
+      void evaluate_scaled_objective_gradient(const Vector<double>& x, const EvaluationScaling& scaling, SparseVector<double>& gradient) const override;
+      void evaluate_scaled_constraints(const Vector<double>& x, const EvaluationScaling& scaling, std::vector<double>& constraints) const override;
+      void evaluate_scaled_constraint_jacobian(const Vector<double>& x, const EvaluationScaling& scaling,
+            RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_scaled_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const EvaluationScaling& scaling, SymmetricMatrix<size_t, double>& hessian) const override;
+      // a single call of the multi-point callback, if set
+      void evaluate_batch(BatchEvaluation& evaluation) const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->variable_lower_bounds[variable_index]; }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->variable_upper_bounds[variable_index]; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override { return this->variable_status[variable_index]; }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->lower_bounded_variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override {
+         return this->single_lower_bounded_variables_collection;
+      }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+         return this->single_upper_bounded_variables_collection;
+      }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->constraint_lower_bounds[constraint_index]; }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->constraint_upper_bounds[constraint_index]; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return this->objective_type; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->constraint_type[constraint_index]; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override { return this->constraint_status[constraint_index]; }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->equality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->inequality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->linear_constraints_collection; }
+
+      void initial_primal_point(Vector<double>& x) const override;
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override;
+      void invalidate_point() const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->gradient_indices.size(); }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->jacobian_positions.size(); }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->hessian_positions.size(); }
+
+   private:
+      void* user_data{nullptr};
+      UnoObjective objective{nullptr};
+      UnoObjectiveGradient objective_gradient{nullptr};
+      UnoConstraints constraints{nullptr};
+      UnoJacobian constraint_jacobian{nullptr};
+      UnoLagrangianHessian lagrangian_hessian{nullptr};
+      UnoBatchedFunctions batched_functions{nullptr};
+      UnoBatchedDerivatives batched_derivatives{nullptr};
+      UnoMultiPointEvaluations multi_point_evaluations{nullptr};
+
+      // batched evaluations: values at the last evaluated points (the trial points are evaluated more often than the derivatives)
+      mutable Vector<double> functions_point{};
+      mutable bool are_functions_cached{false};
+      mutable double cached_objective{0.};
+      mutable std::vector<double> cached_constraints{};
+      mutable Vector<double> derivatives_point{};
+      mutable bool are_derivatives_cached{false};
+
+      // multi-point evaluations: contiguous points and values of a batch
+      mutable std::vector<double> batch_points{};
+      mutable std::vector<double> batch_objectives{};
+      mutable std::vector<double> batch_constraints{};
+      mutable std::vector<double> batch_gradients{};
+      mutable std::vector<int32_t> batch_statuses{};
+
+      // sparsity patterns: the values written by the callbacks are gathered through the positions
+      std::vector<size_t> gradient_indices{};
+      mutable std::vector<double> gradient_values{};
+      std::vector<size_t> jacobian_row_starts{}; // CSR
+      std::vector<size_t> jacobian_column_indices{};
+      std::vector<size_t> jacobian_positions{};
+      mutable std::vector<double> jacobian_values{};
+      std::vector<size_t> hessian_column_starts{}; // CSC, upper triangle
+      std::vector<size_t> hessian_row_indices{};
+      std::vector<size_t> hessian_positions{};
+      mutable std::vector<double> hessian_values{};
+      mutable Vector<double> multipliers_with_sign{};
+
+      std::vector<double> variable_lower_bounds;
+      std::vector<double> variable_upper_bounds;
+      std::vector<double> constraint_lower_bounds;
+      std::vector<double> constraint_upper_bounds;
+      std::vector<BoundType> variable_status;
+      std::vector<BoundType> constraint_status;
+      FunctionType objective_type{NONLINEAR};
+      std::vector<FunctionType> constraint_type;
+      std::vector<double> initial_primals;
+      std::vector<double> initial_multipliers;
+      std::vector<size_t> variable_stages{}; // empty if the model has no stages
+      std::vector<size_t> constraint_stages{};
+
+      std::vector<size_t> linear_constraints{};
+      CollectionAdapter<std::vector<size_t>&> linear_constraints_collection;
+      std::vector<size_t> equality_constraints{};
+      CollectionAdapter<std::vector<size_t>&> equality_constraints_collection;
+      std::vector<size_t> inequality_constraints{};
+      CollectionAdapter<std::vector<size_t>&> inequality_constraints_collection;
+      SparseVector<size_t> slacks{};
+      std::vector<size_t> lower_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> lower_bounded_variables_collection;
+      std::vector<size_t> upper_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> upper_bounded_variables_collection;
+      std::vector<size_t> single_lower_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> single_lower_bounded_variables_collection;
+      std::vector<size_t> single_upper_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> single_upper_bounded_variables_collection;
+      Vector<size_t> fixed_variables{};
+
+      void evaluate_batched_functions(const Vector<double>& x) const;
+      void evaluate_batched_derivatives(const Vector<double>& x) const;
+      [[nodiscard]] bool is_cached_point(const Vector<double>& x, const Vector<double>& point) const;
+      void generate_variables();
+      void generate_constraints();
+      static void determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds,
+            std::vector<BoundType>& status);
+      // counting sort of the nonzeros (major_indices[k], minor_indices[k]) by major index
+      static void compress(size_t dimension, const std::vector<size_t>& major_indices, const std::vector<size_t>& minor_indices,
+            std::vector<size_t>& starts, std::vector<size_t>& sorted_minor_indices, std::vector<size_t>& positions);
+   };
+} // namespace
+
+#endif // UNO_CMODEL_H
@@ -0,0 +1,413 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Uno_C_API.h"
+#include "CModel.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "Uno.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Metrics.hpp"
+
+using namespace uno;
+
+// description of the model. The CModel is built from it by each call to uno_optimize, since the reformulations take ownership
+// of the model
+struct UnoModel {
+   size_t number_variables;
+   size_t number_constraints;
+   std::vector<double> variables_lower_bounds;
+   std::vector<double> variables_upper_bounds;
+   std::vector<double> constraints_lower_bounds;
+   std::vector<double> constraints_upper_bounds;
+   double objective_sign;
+
+   FunctionType objective_type{NONLINEAR};
+   UnoObjective objective{nullptr};
+   std::vector<int32_t> gradient_indices{};
+   UnoObjectiveGradient objective_gradient{nullptr};
+
+   std::optional<std::vector<int32_t>> constraint_types{};
+   UnoConstraints constraints{nullptr};
+   std::vector<int32_t> jacobian_row_indices{};
+   std::vector<int32_t> jacobian_column_indices{};
+   UnoJacobian constraint_jacobian{nullptr};
+
+   std::vector<int32_t> hessian_row_indices{};
+   std::vector<int32_t> hessian_column_indices{};
+   UnoLagrangianHessian lagrangian_hessian{nullptr};
+
+   void* user_data{nullptr};
+   std::vector<double> initial_primals;
+   std::vector<double> initial_multipliers;
+   std::vector<int32_t> variable_stages{}; // empty if the model has no stages
+   std::vector<int32_t> constraint_stages{};
+
+   UnoBatchedFunctions batched_functions{nullptr};
+   UnoBatchedDerivatives batched_derivatives{nullptr};
+   UnoMultiPointEvaluations multi_point_evaluations{nullptr};
+};
+
+struct UnoSolver {
+   Options options{DefaultOptions::load()};
+   std::optional<std::string> preset{};
+   Options user_options{false};
+   std::unique_ptr<Result> result{};
+   // dimensions of the last solved model
+   size_t number_variables{0};
+   size_t number_constraints{0};
+   // metrics aggregated over the calls to uno_optimize (nullptr if disabled)
+   std::unique_ptr<MetricsRegistry> metrics{};
+};
+
+namespace {
+   std::unique_ptr<CModel> generate_model(const UnoModel& description) {
+      auto model = std::make_unique<CModel>(description.number_variables, description.variables_lower_bounds.data(),
+            description.variables_upper_bounds.data(), description.number_constraints, description.constraints_lower_bounds.data(),
+            description.constraints_upper_bounds.data(), description.objective_sign);
+      model->set_objective(description.objective_type, description.objective, description.gradient_indices.size(),
+            description.gradient_indices.data(), description.objective_gradient);
+      model->set_constraints(description.constraint_types.has_value() ? description.constraint_types->data() : nullptr, description.constraints,
+            description.jacobian_row_indices.size(), description.jacobian_row_indices.data(), description.jacobian_column_indices.data(),
+            description.constraint_jacobian);
+      model->set_lagrangian_hessian(description.hessian_row_indices.size(), description.hessian_row_indices.data(),
+            description.hessian_column_indices.data(), description.lagrangian_hessian);
+      model->set_batched_evaluations(description.batched_functions, description.batched_derivatives);
+      model->set_multi_point_evaluations(description.multi_point_evaluations);
+      model->set_user_data(description.user_data);
+      model->set_initial_point(description.initial_primals.data(), description.initial_multipliers.data());
+      if (!description.variable_stages.empty()) {
+         model->set_stages(description.variable_stages.data(), description.constraint_stages.data());
+      }
+      if (!model->is_complete()) {
+         throw std::invalid_argument("The model is missing callbacks");
+      }
+      return model;
+   }
+
+   void copy_solution(const Vector<double>& solution, size_t dimension, double* destination) {
+      if (destination != nullptr) {
+         std::copy(solution.data(), solution.data() + dimension, destination);
+      }
+   }
+} // namespace
+
+extern "C" {
+   UnoModel* uno_create_model(int32_t number_variables, const double* variables_lower_bounds, const double* variables_upper_bounds,
+         int32_t number_constraints, const double* constraints_lower_bounds, const double* constraints_upper_bounds, double objective_sign) {
+      if (number_variables <= 0 || number_constraints < 0 || variables_lower_bounds == nullptr || variables_upper_bounds == nullptr ||
+            (0 < number_constraints && (constraints_lower_bounds == nullptr || constraints_upper_bounds == nullptr)) ||
+            (objective_sign != UNO_MINIMIZE && objective_sign != UNO_MAXIMIZE)) {
+         return nullptr;
+      }
+      const size_t n = static_cast<size_t>(number_variables);
+      const size_t m = static_cast<size_t>(number_constraints);
+      return new UnoModel{n, m, std::vector<double>(variables_lower_bounds, variables_lower_bounds + n),
+         std::vector<double>(variables_upper_bounds, variables_upper_bounds + n),
+         (0 < m) ? std::vector<double>(constraints_lower_bounds, constraints_lower_bounds + m) : std::vector<double>{},
+         (0 < m) ? std::vector<double>(constraints_upper_bounds, constraints_upper_bounds + m) : std::vector<double>{},
+         objective_sign, NONLINEAR, nullptr, {}, nullptr, {}, nullptr, {}, {}, nullptr, {}, {}, nullptr, nullptr,
+         std::vector<double>(n, 0.), std::vector<double>(m, 0.)};
+   }
+
+   bool uno_set_objective(UnoModel* model, int32_t objective_type, UnoObjective objective, int32_t number_gradient_nonzeros,
+         const int32_t* gradient_indices, UnoObjectiveGradient objective_gradient) {
+      if (model == nullptr || number_gradient_nonzeros < 0 ||
+            (0 < number_gradient_nonzeros && gradient_indices == nullptr)) {
+         return false;
+      }
+      switch (objective_type) {
+         case UNO_LINEAR:
+            model->objective_type = LINEAR;
+            break;
+         case UNO_QUADRATIC:
+            model->objective_type = QUADRATIC;
+            break;
+         case UNO_NONLINEAR:
+            model->objective_type = NONLINEAR;
+            break;
+         default:
+            return false;
+      }
+      model->objective = objective;
+      model->gradient_indices.assign(gradient_indices, gradient_indices + number_gradient_nonzeros);
+      model->objective_gradient = objective_gradient;
+      return true;
+   }
+
+   bool uno_set_constraints(UnoModel* model, const int32_t* constraint_types, UnoConstraints constraints, int32_t number_jacobian_nonzeros,
+         const int32_t* jacobian_row_indices, const int32_t* jacobian_column_indices, UnoJacobian constraint_jacobian) {
+      if (model == nullptr || number_jacobian_nonzeros < 0 ||
+            (0 < number_jacobian_nonzeros && (jacobian_row_indices == nullptr || jacobian_column_indices == nullptr))) {
+         return false;
+      }
+      if (constraint_types != nullptr) {
+         model->constraint_types = std::vector<int32_t>(constraint_types, constraint_types + model->number_constraints);
+      }
+      else {
+         model->constraint_types.reset();
+      }
+      model->constraints = constraints;
+      model->jacobian_row_indices.assign(jacobian_row_indices, jacobian_row_indices + number_jacobian_nonzeros);
+      model->jacobian_column_indices.assign(jacobian_column_indices, jacobian_column_indices + number_jacobian_nonzeros);
+      model->constraint_jacobian = constraint_jacobian;
+      return true;
+   }
+
+   bool uno_set_lagrangian_hessian(UnoModel* model, int32_t number_hessian_nonzeros, const int32_t* hessian_row_indices,
+         const int32_t* hessian_column_indices, UnoLagrangianHessian lagrangian_hessian) {
+      if (model == nullptr || lagrangian_hessian == nullptr || number_hessian_nonzeros < 0 ||
+            (0 < number_hessian_nonzeros && (hessian_row_indices == nullptr || hessian_column_indices == nullptr))) {
+         return false;
+      }
+      model->hessian_row_indices.assign(hessian_row_indices, hessian_row_indices + number_hessian_nonzeros);
+      model->hessian_column_indices.assign(hessian_column_indices, hessian_column_indices + number_hessian_nonzeros);
+      model->lagrangian_hessian = lagrangian_hessian;
+      return true;
+   }
+
+   bool uno_set_batched_evaluations(UnoModel* model, UnoBatchedFunctions functions, UnoBatchedDerivatives derivatives) {
+      if (model == nullptr || functions == nullptr || derivatives == nullptr) {
+         return false;
+      }
+      model->batched_functions = functions;
+      model->batched_derivatives = derivatives;
+      return true;
+   }
+
+   bool uno_set_multi_point_evaluations(UnoModel* model, UnoMultiPointEvaluations evaluations) {
+      if (model == nullptr || evaluations == nullptr) {
+         return false;
+      }
+      model->multi_point_evaluations = evaluations;
+      return true;
+   }
+
+   bool uno_set_user_data(UnoModel* model, void* user_data) {
+      if (model == nullptr) {
+         return false;
+      }
+      model->user_data = user_data;
+      return true;
+   }
+
+   bool uno_set_initial_point(UnoModel* model, const double* initial_primals, const double* initial_multipliers) {
+      if (model == nullptr || initial_primals == nullptr) {
+         return false;
+      }
+      std::copy(initial_primals, initial_primals + model->number_variables, model->initial_primals.begin());
+      if (initial_multipliers != nullptr) {
+         std::copy(initial_multipliers, initial_multipliers + model->number_constraints, model->initial_multipliers.begin());
+      }
+      else {
+         std::fill(model->initial_multipliers.begin(), model->initial_multipliers.end(), 0.);
+      }
+      return true;
+   }
+
+   bool uno_set_stages(UnoModel* model, const int32_t* variable_stages, const int32_t* constraint_stages) {
+      if (model == nullptr || variable_stages == nullptr) {
+         return false;
+      }
+      model->variable_stages.assign(variable_stages, variable_stages + model->number_variables);
+      if (constraint_stages != nullptr) {
+         model->constraint_stages.assign(constraint_stages, constraint_stages + model->number_constraints);
+      }
+      else {
+         model->constraint_stages.assign(model->number_constraints, -1);
+      }
+      return true;
+   }
+
+   void uno_destroy_model(UnoModel* model) {
+      delete model;
+   }
+
+   UnoSolver* uno_create_solver(void) {
+      try {
+         auto* solver = new UnoSolver{};
+         // determine the default solvers based on the available libraries
+         solver->options.overwrite_with(DefaultOptions::determine_solvers());
+         return solver;
+      }
+      catch (const std::exception& exception) {
+         DISCRETE << exception.what() << '\n';
+         return nullptr;
+      }
+   }
+
+   bool uno_set_solver_option(UnoSolver* solver, const char* option_name, const char* option_value) {
+      if (solver == nullptr || option_name == nullptr || option_value == nullptr) {
+         return false;
+      }
+      solver->user_options[option_name] = option_value;
+      return true;
+   }
+
+   bool uno_set_solver_preset(UnoSolver* solver, const char* preset_name) {
+      if (solver == nullptr || preset_name == nullptr) {
+         return false;
+      }
+      solver->preset = preset_name;
+      return true;
+   }
+
+   bool uno_optimize(UnoSolver* solver, UnoModel* model) {
+      if (solver == nullptr || model == nullptr) {
+         return false;
+      }
+      solver->result.reset();
+      solver->number_variables = model->number_variables;
+      solver->number_constraints = model->number_constraints;
+      try {
+         // the preset and the user options are applied on top of the default options
+         Options options = solver->options;
+         options.overwrite_with(Presets::get_preset_options(solver->preset));
+         options.overwrite_with(solver->user_options);
+         Logger::set_logger(options.get_string("logger"));
+
+         // reformulate (scale, add slacks, relax the bounds, ...) if necessary
+         std::unique_ptr<Model> model_to_solve = ModelFactory::reformulate(generate_model(*model), options);
+
+         // initialize initial primal and dual points
+         Iterate initial_iterate(model_to_solve->number_variables, model_to_solve->number_constraints);
+         model_to_solve->initial_primal_point(initial_iterate.primals);
+         model_to_solve->project_onto_variable_bounds(initial_iterate.primals);
+         model_to_solve->initial_dual_point(initial_iterate.multipliers.constraints);
+         initial_iterate.feasibility_multipliers.reset();
+
+         // create the constraint relaxation strategy, the globalization mechanism and the Uno solver
+         auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*model_to_solve, options);
+         auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+         Uno uno = Uno(*globalization_mechanism, options);
+
+         // solve the instance
+         const MetricsRegistry::Scope metrics_scope(solver->metrics.get());
+         solver->result = std::make_unique<Result>(uno.solve(*model_to_solve, initial_iterate, options));
+         return true;
+      }
+      catch (const std::exception& exception) {
+         DISCRETE << exception.what() << '\n';
+         return false;
+      }
+   }
+
+   bool uno_enable_metrics(UnoSolver* solver, bool enabled) {
+      if (solver == nullptr) {
+         return false;
+      }
+      if (!enabled) {
+         solver->metrics.reset();
+      }
+      else if (solver->metrics == nullptr) {
+         solver->metrics = std::make_unique<MetricsRegistry>();
+      }
+      return true;
+   }
+
+   void uno_reset_metrics(UnoSolver* solver) {
+      if (solver != nullptr && solver->metrics != nullptr) {
+         solver->metrics->clear();
+      }
+   }
+
+   int32_t uno_get_metrics(const UnoSolver* solver, char* buffer, int32_t buffer_size) {
+      if (solver == nullptr || solver->metrics == nullptr) {
+         return -1;
+      }
+      const std::string exposition = solver->metrics->to_openmetrics();
+      if (buffer != nullptr && 0 < buffer_size) {
+         const size_t length = std::min(exposition.size(), static_cast<size_t>(buffer_size) - 1);
+         std::memcpy(buffer, exposition.data(), length);
+         buffer[length] = '\0';
+      }
+      return static_cast<int32_t>(exposition.size());
+   }
+
+   double uno_get_metric_value(const UnoSolver* solver, const char* metric_name) {
+      if (solver == nullptr || solver->metrics == nullptr || metric_name == nullptr) {
+         return NAN;
+      }
+      const std::optional<Metric> metric = MetricsRegistry::find(metric_name);
+      if (!metric.has_value()) {
+         return NAN;
+      }
+      if (MetricsRegistry::definition(*metric).type == MetricType::HISTOGRAM) {
+         return static_cast<double>(solver->metrics->histogram(*metric).count);
+      }
+      return solver->metrics->value(*metric);
+   }
+
+   void uno_destroy_solver(UnoSolver* solver) {
+      delete solver;
+   }
+
+   int32_t uno_get_optimization_status(const UnoSolver* solver) {
+      if (solver == nullptr || solver->result == nullptr) {
+         return UNO_ALGORITHMIC_ERROR;
+      }
+      return static_cast<int32_t>(solver->result->optimization_status);
+   }
+
+   int32_t uno_get_solution_status(const UnoSolver* solver) {
+      if (solver == nullptr || solver->result == nullptr) {
+         return UNO_NOT_OPTIMAL;
+      }
+      return static_cast<int32_t>(solver->result->solution.status);
+   }
+
+   double uno_get_solution_objective(const UnoSolver* solver) {
+      if (solver == nullptr || solver->result == nullptr) {
+         return INF<double>;
+      }
+      return solver->result->solution.evaluations.objective;
+   }
+
+   // the solution of the reformulated model may have additional variables (e.g. slacks): only the original ones are copied
+   void uno_get_primal_solution(const UnoSolver* solver, double* primal_solution) {
+      if (solver != nullptr && solver->result != nullptr) {
+         copy_solution(solver->result->solution.primals, solver->number_variables, primal_solution);
+      }
+   }
+
+   void uno_get_constraint_dual_solution(const UnoSolver* solver, double* constraint_dual_solution) {
+      if (solver != nullptr && solver->result != nullptr) {
+         copy_solution(solver->result->solution.multipliers.constraints, solver->number_constraints, constraint_dual_solution);
+      }
+   }
+
+   void uno_get_lower_bound_dual_solution(const UnoSolver* solver, double* lower_bound_dual_solution) {
+      if (solver != nullptr && solver->result != nullptr) {
+         copy_solution(solver->result->solution.multipliers.lower_bounds, solver->number_variables, lower_bound_dual_solution);
+      }
+   }
+
+   void uno_get_upper_bound_dual_solution(const UnoSolver* solver, double* upper_bound_dual_solution) {
+      if (solver != nullptr && solver->result != nullptr) {
+         copy_solution(solver->result->solution.multipliers.upper_bounds, solver->number_variables, upper_bound_dual_solution);
+      }
+   }
+
+   int32_t uno_get_number_iterations(const UnoSolver* solver) {
+      if (solver == nullptr || solver->result == nullptr) {
+         return 0;
+      }
+      return static_cast<int32_t>(solver->result->iteration);
+   }
+} // extern "C"
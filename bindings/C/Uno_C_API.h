@@ -0,0 +1,130 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_C_API_H
+#define UNO_C_API_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+   // optimization sense
+   #define UNO_MINIMIZE 1.
+   #define UNO_MAXIMIZE -1.
+
+   // function types
+   #define UNO_LINEAR 0
+   #define UNO_QUADRATIC 1
+   #define UNO_NONLINEAR 2
+
+   // optimization status
+   #define UNO_SUCCESS 0
+   #define UNO_ITERATION_LIMIT 1
+   #define UNO_TIME_LIMIT 2
+   #define UNO_EVALUATION_ERROR 3
+   #define UNO_ALGORITHMIC_ERROR 4
+   #define UNO_USER_TERMINATION 5
+   #define UNO_OBJECTIVE_CUTOFF 6
+
+   // iterate status
+   #define UNO_NOT_OPTIMAL 0
+   #define UNO_FEASIBLE_KKT_POINT 1
+   #define UNO_FEASIBLE_FJ_POINT 2
+   #define UNO_INFEASIBLE_STATIONARY_POINT 3
+   #define UNO_FEASIBLE_SMALL_STEP 4
+   #define UNO_INFEASIBLE_SMALL_STEP 5
+   #define UNO_UNBOUNDED 6
+
+   // opaque types
+   typedef struct UnoModel UnoModel;
+   typedef struct UnoSolver UnoSolver;
+
+   // callbacks: the sparsity patterns are declared once, and each callback fills a preallocated array of values in the order of its
+   // pattern. A callback returns 0 on success, and a nonzero value if the function cannot be evaluated at x
+   typedef int32_t (*UnoObjective)(int32_t number_variables, const double* x, double* objective_value, void* user_data);
+   typedef int32_t (*UnoConstraints)(int32_t number_variables, int32_t number_constraints, const double* x, double* constraint_values,
+      void* user_data);
+   // values of the objective gradient at the indices declared in uno_set_objective
+   typedef int32_t (*UnoObjectiveGradient)(int32_t number_variables, const double* x, double* gradient_values, void* user_data);
+   // values of the constraint Jacobian at the (row, column) pairs declared in uno_set_constraints
+   typedef int32_t (*UnoJacobian)(int32_t number_variables, int32_t number_jacobian_nonzeros, const double* x, double* jacobian_values,
+      void* user_data);
+   // values of the Hessian of the Lagrangian objective_multiplier * f(x) - sum_j multipliers[j] * c_j(x) at the (row, column) pairs
+   // declared in uno_set_lagrangian_hessian (one triangle)
+   typedef int32_t (*UnoLagrangianHessian)(int32_t number_variables, int32_t number_constraints, int32_t number_hessian_nonzeros,
+      const double* x, double objective_multiplier, const double* multipliers, double* hessian_values, void* user_data);
+   // batched callbacks: the functions (objective and constraints) and the first derivatives (objective gradient and constraint
+   // Jacobian, in the order of the patterns) are each evaluated by a single call per point. A model that evaluates on an accelerator
+   // transfers x and the values once instead of once per quantity
+   typedef int32_t (*UnoBatchedFunctions)(int32_t number_variables, int32_t number_constraints, const double* x, double* objective_value,
+      double* constraint_values, void* user_data);
+   typedef int32_t (*UnoBatchedDerivatives)(int32_t number_variables, int32_t number_gradient_nonzeros, int32_t number_jacobian_nonzeros,
+      const double* x, double* gradient_values, double* jacobian_values, void* user_data);
+   // multi-point callback: the objective, the constraints and (if gradient_values is not NULL) the objective gradient at number_points
+   // points stored contiguously (the point k starts at x[k * number_variables], its constraints at constraint_values[k * number_constraints]
+   // and its gradient at gradient_values[k * number_gradient_nonzeros]). statuses[k] is set to 0 if the point k was evaluated, and to a
+   // nonzero value otherwise. A model that vectorizes across the points or evaluates them on an accelerator evaluates a batch in one call
+   typedef int32_t (*UnoMultiPointEvaluations)(int32_t number_points, int32_t number_variables, int32_t number_constraints,
+      int32_t number_gradient_nonzeros, const double* x, double* objective_values, double* constraint_values, double* gradient_values,
+      int32_t* statuses, void* user_data);
+
+   // model: the bounds are copied (+/-INFINITY for missing bounds). The arrays of indices use 0-based indexing
+   UnoModel* uno_create_model(int32_t number_variables, const double* variables_lower_bounds, const double* variables_upper_bounds,
+      int32_t number_constraints, const double* constraints_lower_bounds, const double* constraints_upper_bounds, double objective_sign);
+   // the function callbacks may be NULL if batched evaluations are set (uno_set_batched_evaluations)
+   bool uno_set_objective(UnoModel* model, int32_t objective_type, UnoObjective objective, int32_t number_gradient_nonzeros,
+      const int32_t* gradient_indices, UnoObjectiveGradient objective_gradient);
+   // constraint_types may be NULL (all nonlinear)
+   bool uno_set_constraints(UnoModel* model, const int32_t* constraint_types, UnoConstraints constraints, int32_t number_jacobian_nonzeros,
+      const int32_t* jacobian_row_indices, const int32_t* jacobian_column_indices, UnoJacobian constraint_jacobian);
+   bool uno_set_lagrangian_hessian(UnoModel* model, int32_t number_hessian_nonzeros, const int32_t* hessian_row_indices,
+      const int32_t* hessian_column_indices, UnoLagrangianHessian lagrangian_hessian);
+   // the batched callbacks replace the objective, constraint, gradient and Jacobian callbacks. The sparsity patterns are still
+   // declared by uno_set_objective and uno_set_constraints
+   bool uno_set_batched_evaluations(UnoModel* model, UnoBatchedFunctions functions, UnoBatchedDerivatives derivatives);
+   // optional: the batches of points (e.g. the speculative line-search trials) are evaluated by the multi-point callback instead of
+   // one point at a time
+   bool uno_set_multi_point_evaluations(UnoModel* model, UnoMultiPointEvaluations evaluations);
+   bool uno_set_user_data(UnoModel* model, void* user_data);
+   // initial_multipliers may be NULL (zero multipliers)
+   bool uno_set_initial_point(UnoModel* model, const double* initial_primals, const double* initial_multipliers);
+   // stages of a stage-structured model (e.g. the time steps of a discretized optimal-control problem), exploited by the linear
+   // solver block_tridiagonal. A negative value stands for no stage. constraint_stages may be NULL (no stage)
+   bool uno_set_stages(UnoModel* model, const int32_t* variable_stages, const int32_t* constraint_stages);
+   void uno_destroy_model(UnoModel* model);
+
+   // solver
+   UnoSolver* uno_create_solver(void);
+   bool uno_set_solver_option(UnoSolver* solver, const char* option_name, const char* option_value);
+   bool uno_set_solver_preset(UnoSolver* solver, const char* preset_name);
+   // solves the model. Returns false if the solve could not be carried out (e.g. invalid options or missing callbacks)
+   bool uno_optimize(UnoSolver* solver, UnoModel* model);
+   void uno_destroy_solver(UnoSolver* solver);
+
+   // solution of the last call to uno_optimize
+   int32_t uno_get_optimization_status(const UnoSolver* solver);
+   int32_t uno_get_solution_status(const UnoSolver* solver);
+   double uno_get_solution_objective(const UnoSolver* solver);
+   void uno_get_primal_solution(const UnoSolver* solver, double* primal_solution);
+   void uno_get_constraint_dual_solution(const UnoSolver* solver, double* constraint_dual_solution);
+   void uno_get_lower_bound_dual_solution(const UnoSolver* solver, double* lower_bound_dual_solution);
+   void uno_get_upper_bound_dual_solution(const UnoSolver* solver, double* upper_bound_dual_solution);
+   int32_t uno_get_number_iterations(const UnoSolver* solver);
+
+   // metrics (counters, gauges and histograms) aggregated over the calls to uno_optimize, disabled by default
+   bool uno_enable_metrics(UnoSolver* solver, bool enabled);
+   void uno_reset_metrics(UnoSolver* solver);
+   // writes the metrics in the OpenMetrics text format into buffer (truncated and null-terminated, buffer may be NULL). Returns the
+   // length of the whole text (without the null character), or -1 if the metrics are disabled
+   int32_t uno_get_metrics(const UnoSolver* solver, char* buffer, int32_t buffer_size);
+   // value of a counter or a gauge, number of observations of a histogram (e.g. "uno_solves"). NAN if unknown or disabled
+   double uno_get_metric_value(const UnoSolver* solver, const char* metric_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UNO_C_API_H
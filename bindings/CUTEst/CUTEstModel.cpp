@@ -0,0 +1,569 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <dlfcn.h>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include "CUTEstModel.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "optimization/EvaluationErrors.hpp"
+#include "optimization/Iterate.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   namespace {
+      // the bounds of magnitude at least 1e20 are infinite in CUTEst
+      constexpr double cutest_infinity = 1e20;
+
+      double to_uno_bound(double bound) {
+         if (bound <= -cutest_infinity) {
+            return -INF<double>;
+         }
+         if (cutest_infinity <= bound) {
+            return INF<double>;
+         }
+         return bound;
+      }
+   } // namespace
+
+   struct CUTEstLibrary {
+      using integer = int;
+      using logical = int;
+
+      // status of the tools: 0 (success), 1 (allocation error), 2 (array bound error), 3 (evaluation error)
+      static constexpr integer evaluation_error = 3;
+
+      using Open = void (*)(const integer* funit, const char* file_name, integer* error);
+      using Close = void (*)(const integer* funit, integer* error);
+      using Dimensions = void (*)(integer* status, const integer* funit, integer* n, integer* m);
+      using ConstrainedSetup = void (*)(integer* status, const integer* funit, const integer* iout, const integer* io_buffer, integer* n,
+            integer* m, double* x, double* x_l, double* x_u, double* y, double* c_l, double* c_u, logical* equatn, logical* linear,
+            const integer* e_order, const integer* l_order, const integer* v_order);
+      using UnconstrainedSetup = void (*)(integer* status, const integer* funit, const integer* iout, const integer* io_buffer, integer* n,
+            double* x, double* x_l, double* x_u);
+      using ObjectiveAndGradient = void (*)(integer* status, const integer* n, const double* x, double* f, double* g, const logical* grad);
+      using ConstraintsAndJacobian = void (*)(integer* status, const integer* n, const integer* m, const double* x, double* c, integer* nnzj,
+            const integer* lj, double* j_val, integer* j_var, integer* j_fun, const logical* grad);
+      using Size = void (*)(integer* status, integer* size);
+      using GradientsPattern = void (*)(integer* status, const integer* n, integer* nnzj, const integer* lj, integer* j_var, integer* j_fun);
+      using HessianPattern = void (*)(integer* status, const integer* n, integer* nnzh, const integer* lh, integer* h_row, integer* h_col);
+      using ConstrainedHessian = void (*)(integer* status, const integer* n, const integer* m, const double* x, const double* y0,
+            const double* y, integer* nnzh, const integer* lh, double* h_val, integer* h_row, integer* h_col);
+      using UnconstrainedHessian = void (*)(integer* status, const integer* n, const double* x, integer* nnzh, const integer* lh,
+            double* h_val, integer* h_row, integer* h_col);
+      using ConstrainedHessianProduct = void (*)(integer* status, const integer* n, const integer* m, const logical* goth, const double* x,
+            const double* y0, const double* y, double* p, double* result);
+      using UnconstrainedHessianProduct = void (*)(integer* status, const integer* n, const logical* goth, const double* x, double* p,
+            double* result);
+      using Terminate = void (*)(integer* status);
+
+      void* handle{nullptr};
+      integer number_variables{0};
+      integer number_constraints{0};
+      // data of the setup
+      std::vector<double> x{}, x_lower{}, x_upper{}, y{}, c_lower{}, c_upper{};
+      std::vector<logical> equatn{}, linear{};
+
+      ObjectiveAndGradient objective_and_gradient{nullptr};
+      ConstraintsAndJacobian constraints_and_jacobian{nullptr};
+      Size jacobian_size{nullptr};
+      GradientsPattern gradients_pattern{nullptr};
+      Size hessian_size{nullptr};
+      HessianPattern hessian_pattern{nullptr};
+      ConstrainedHessian constrained_hessian{nullptr};
+      UnconstrainedHessian unconstrained_hessian{nullptr};
+      ConstrainedHessianProduct constrained_hessian_product{nullptr};
+      UnconstrainedHessianProduct unconstrained_hessian_product{nullptr};
+      Terminate terminate{nullptr};
+
+      CUTEstLibrary() = default;
+      CUTEstLibrary(const CUTEstLibrary&) = delete;
+      CUTEstLibrary& operator=(const CUTEstLibrary&) = delete;
+
+      ~CUTEstLibrary() {
+         if (this->terminate != nullptr) {
+            integer status = 0;
+            this->terminate(&status);
+         }
+         if (this->handle != nullptr) {
+            dlclose(this->handle);
+         }
+      }
+
+      [[nodiscard]] bool is_constrained() const {
+         return 0 < this->number_constraints;
+      }
+
+      template <typename Function>
+      [[nodiscard]] Function resolve(const char* symbol) const {
+         const Function function = reinterpret_cast<Function>(dlsym(this->handle, symbol));
+         if (function == nullptr) {
+            throw std::runtime_error(std::string("CUTEstModel: the CUTEst tool ") + symbol + " was not found");
+         }
+         return function;
+      }
+
+      // the allocation and array bound errors are not recoverable; the evaluation errors are reported by the caller
+      static void check(integer status, const char* tool) {
+         if (status != 0 && status != evaluation_error) {
+            throw std::runtime_error(std::string("CUTEstModel: the CUTEst tool ") + tool + " failed with status " + std::to_string(status));
+         }
+      }
+
+      static std::unique_ptr<CUTEstLibrary> load(const std::filesystem::path& problem_directory) {
+         auto library = std::make_unique<CUTEstLibrary>();
+         const std::string library_name = (problem_directory / ("lib" + problem_directory.filename().string() + ".so")).string();
+         library->handle = dlopen(library_name.c_str(), RTLD_NOW | RTLD_LOCAL);
+         if (library->handle == nullptr) {
+            throw std::runtime_error("CUTEstModel: the library " + library_name + " could not be loaded: " + dlerror());
+         }
+         const Open open = library->resolve<Open>("fortran_open_");
+         const Close close = library->resolve<Close>("fortran_close_");
+         const Dimensions dimensions = library->resolve<Dimensions>("cutest_cdimen_");
+
+         // read the problem data from OUTSDIF.d
+         const integer funit = 42, iout = 6, io_buffer = 11;
+         const std::string outsdif_file = (problem_directory / "OUTSDIF.d").string();
+         integer status = 0;
+         open(&funit, outsdif_file.c_str(), &status);
+         if (status != 0) {
+            throw std::runtime_error("CUTEstModel: the file " + outsdif_file + " could not be opened");
+         }
+         dimensions(&status, &funit, &library->number_variables, &library->number_constraints);
+         CUTEstLibrary::check(status, "cdimen");
+         const size_t n = static_cast<size_t>(library->number_variables);
+         const size_t m = static_cast<size_t>(library->number_constraints);
+         library->x.resize(n);
+         library->x_lower.resize(n);
+         library->x_upper.resize(n);
+         library->y.resize(m);
+         library->c_lower.resize(m);
+         library->c_upper.resize(m);
+         library->equatn.resize(m);
+         library->linear.resize(m);
+         if (library->is_constrained()) {
+            const integer e_order = 0, l_order = 0, v_order = 0;
+            const ConstrainedSetup setup = library->resolve<ConstrainedSetup>("cutest_csetup_");
+            setup(&status, &funit, &iout, &io_buffer, &library->number_variables, &library->number_constraints, library->x.data(),
+                  library->x_lower.data(), library->x_upper.data(), library->y.data(), library->c_lower.data(), library->c_upper.data(),
+                  library->equatn.data(), library->linear.data(), &e_order, &l_order, &v_order);
+            CUTEstLibrary::check(status, "csetup");
+            library->terminate = library->resolve<Terminate>("cutest_cterminate_");
+            library->objective_and_gradient = library->resolve<ObjectiveAndGradient>("cutest_cofg_");
+            library->constraints_and_jacobian = library->resolve<ConstraintsAndJacobian>("cutest_ccfsg_");
+            library->jacobian_size = library->resolve<Size>("cutest_cdimj_");
+            library->gradients_pattern = library->resolve<GradientsPattern>("cutest_csgrp_");
+            library->hessian_size = library->resolve<Size>("cutest_cdimsh_");
+            library->hessian_pattern = library->resolve<HessianPattern>("cutest_cshp_");
+            library->constrained_hessian = library->resolve<ConstrainedHessian>("cutest_cshj_");
+            library->constrained_hessian_product = library->resolve<ConstrainedHessianProduct>("cutest_chjprod_");
+         }
+         else {
+            const UnconstrainedSetup setup = library->resolve<UnconstrainedSetup>("cutest_usetup_");
+            setup(&status, &funit, &iout, &io_buffer, &library->number_variables, library->x.data(), library->x_lower.data(),
+                  library->x_upper.data());
+            CUTEstLibrary::check(status, "usetup");
+            library->terminate = library->resolve<Terminate>("cutest_uterminate_");
+            library->objective_and_gradient = library->resolve<ObjectiveAndGradient>("cutest_uofg_");
+            library->hessian_size = library->resolve<Size>("cutest_udimsh_");
+            library->hessian_pattern = library->resolve<HessianPattern>("cutest_ushp_");
+            library->unconstrained_hessian = library->resolve<UnconstrainedHessian>("cutest_ush_");
+            library->unconstrained_hessian_product = library->resolve<UnconstrainedHessianProduct>("cutest_uhprod_");
+         }
+         close(&funit, &status);
+         return library;
+      }
+   };
+
+   CUTEstModel::CUTEstModel(const std::string& problem_directory):
+         CUTEstModel(problem_directory, CUTEstLibrary::load(std::filesystem::path(problem_directory))) {
+   }
+
+   CUTEstModel::CUTEstModel(const std::string& problem_directory, std::unique_ptr<CUTEstLibrary> library):
+         Model(std::filesystem::path(problem_directory).filename().string(), static_cast<size_t>(library->number_variables),
+            static_cast<size_t>(library->number_constraints), 1.),
+         library(std::move(library)),
+         objective_point(this->number_variables),
+         dense_gradient(this->number_variables),
+         constraints_point(this->number_variables),
+         cached_constraints(this->number_constraints),
+         multipliers_with_flipped_sign(this->number_constraints),
+         initial_primals(this->library->x),
+         initial_multipliers(this->number_constraints),
+         variable_lower_bounds(this->number_variables),
+         variable_upper_bounds(this->number_variables),
+         constraint_lower_bounds(this->number_constraints),
+         constraint_upper_bounds(this->number_constraints),
+         variable_status(this->number_variables),
+         constraint_status(this->number_constraints),
+         constraint_type(this->number_constraints, NONLINEAR),
+         linear_constraints_collection(this->linear_constraints),
+         equality_constraints_collection(this->equality_constraints),
+         inequality_constraints_collection(this->inequality_constraints),
+         lower_bounded_variables_collection(this->lower_bounded_variables),
+         upper_bounded_variables_collection(this->upper_bounded_variables),
+         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
+         single_upper_bounded_variables_collection(this->single_upper_bounded_variables) {
+      // variables
+      std::transform(this->library->x_lower.cbegin(), this->library->x_lower.cend(), this->variable_lower_bounds.begin(), to_uno_bound);
+      std::transform(this->library->x_upper.cbegin(), this->library->x_upper.cend(), this->variable_upper_bounds.begin(), to_uno_bound);
+      this->generate_variables();
+
+      // constraints. The Lagrangian of CUTEst is f + y^T c, that of Uno is f - y^T c
+      std::transform(this->library->c_lower.cbegin(), this->library->c_lower.cend(), this->constraint_lower_bounds.begin(), to_uno_bound);
+      std::transform(this->library->c_upper.cbegin(), this->library->c_upper.cend(), this->constraint_upper_bounds.begin(), to_uno_bound);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->initial_multipliers[constraint_index] = -this->library->y[constraint_index];
+         if (this->library->linear[constraint_index]) {
+            this->constraint_type[constraint_index] = LINEAR;
+            this->linear_constraints.emplace_back(constraint_index);
+         }
+      }
+      this->generate_constraints();
+
+      // sparsity of the objective gradient and the Jacobian (the unconstrained problems have a dense gradient)
+      if (this->library->is_constrained()) {
+         CUTEstLibrary::integer status = 0, lj = 0;
+         this->library->jacobian_size(&status, &lj);
+         CUTEstLibrary::check(status, "cdimj");
+         std::vector<CUTEstLibrary::integer> variables(static_cast<size_t>(lj)), functions(static_cast<size_t>(lj));
+         CUTEstLibrary::integer number_nonzeros = 0;
+         this->library->gradients_pattern(&status, &this->library->number_variables, &number_nonzeros, &lj, variables.data(), functions.data());
+         CUTEstLibrary::check(status, "csgrp");
+         for (size_t nonzero_index: Range(static_cast<size_t>(number_nonzeros))) {
+            // the function 0 is the objective
+            if (functions[nonzero_index] == 0) {
+               this->gradient_indices.emplace_back(static_cast<size_t>(variables[nonzero_index] - 1));
+            }
+            else {
+               this->number_jacobian_entries++;
+            }
+         }
+         std::sort(this->gradient_indices.begin(), this->gradient_indices.end());
+         this->jacobian_values.resize(static_cast<size_t>(lj));
+         this->jacobian_variables.resize(static_cast<size_t>(lj));
+         this->jacobian_functions.resize(static_cast<size_t>(lj));
+      }
+      else {
+         this->gradient_indices.resize(this->number_variables);
+         for (size_t variable_index: Range(this->number_variables)) {
+            this->gradient_indices[variable_index] = variable_index;
+         }
+      }
+   }
+
+   CUTEstModel::~CUTEstModel() = default;
+
+   double CUTEstModel::evaluate_objective(const Vector<double>& x) const {
+      this->evaluate_objective_and_gradient(x);
+      return this->cached_objective;
+   }
+
+   void CUTEstModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->evaluate_objective_and_gradient(x);
+      for (const size_t variable_index: this->gradient_indices) {
+         gradient.insert(variable_index, this->dense_gradient[variable_index]);
+      }
+   }
+
+   void CUTEstModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      if (!this->is_constrained()) {
+         return;
+      }
+      this->evaluate_constraints_and_jacobian(x);
+      std::copy(this->cached_constraints.cbegin(), this->cached_constraints.cend(), constraints.begin());
+   }
+
+   void CUTEstModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      this->evaluate_constraints_and_jacobian(x);
+      gradient.clear();
+      for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+         gradient.insert(this->jacobian_column_indices[nonzero_index], this->jacobian_values[this->jacobian_positions[nonzero_index]]);
+      }
+   }
+
+   void CUTEstModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      if (!this->is_constrained()) {
+         return;
+      }
+      this->evaluate_constraints_and_jacobian(x);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         // fill the row of the CSR Jacobian directly
+         auto constraint_gradient = constraint_jacobian[constraint_index];
+         constraint_gradient.clear();
+         for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+            constraint_gradient.insert(this->jacobian_column_indices[nonzero_index], this->jacobian_values[this->jacobian_positions[nonzero_index]]);
+         }
+      }
+   }
+
+   // Hessian of the John function y0 f + y^T c, with y0 = objective_multiplier and y = -multipliers
+   void CUTEstModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      this->ensure_hessian_sparsity();
+      assert(hessian.capacity() >= this->number_hessian_entries);
+      CUTEstLibrary::integer status = 0, number_nonzeros = 0;
+      const CUTEstLibrary::integer lh = static_cast<CUTEstLibrary::integer>(this->hessian_values.size());
+      if (this->library->is_constrained()) {
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            this->multipliers_with_flipped_sign[constraint_index] = -multipliers[constraint_index];
+         }
+         this->library->constrained_hessian(&status, &this->library->number_variables, &this->library->number_constraints, x.data(),
+               &objective_multiplier, this->multipliers_with_flipped_sign.data(), &number_nonzeros, &lh, this->hessian_values.data(),
+               this->hessian_rows.data(), this->hessian_columns.data());
+         CUTEstLibrary::check(status, "cshj");
+      }
+      else {
+         this->library->unconstrained_hessian(&status, &this->library->number_variables, x.data(), &number_nonzeros, &lh,
+               this->hessian_values.data(), this->hessian_rows.data(), this->hessian_columns.data());
+         CUTEstLibrary::check(status, "ush");
+         for (size_t nonzero_index: Range(static_cast<size_t>(number_nonzeros))) {
+            this->hessian_values[nonzero_index] *= objective_multiplier;
+         }
+      }
+      if (status == CUTEstLibrary::evaluation_error) {
+         throw GradientEvaluationError();
+      }
+      // the map of the nonzeros is recomputed if their coordinates changed
+      if (!std::equal(this->hessian_rows.cbegin(), this->hessian_rows.cbegin() + number_nonzeros, this->hessian_pattern_rows.cbegin(),
+               this->hessian_pattern_rows.cend()) || !std::equal(this->hessian_columns.cbegin(), this->hessian_columns.cbegin() + number_nonzeros,
+               this->hessian_pattern_columns.cbegin(), this->hessian_pattern_columns.cend())) {
+         if (this->number_hessian_entries < static_cast<size_t>(number_nonzeros)) {
+            throw std::runtime_error("CUTEstModel: the Hessian has more nonzeros than its sparsity pattern");
+         }
+         this->hessian_pattern_rows.assign(this->hessian_rows.cbegin(), this->hessian_rows.cbegin() + number_nonzeros);
+         this->hessian_pattern_columns.assign(this->hessian_columns.cbegin(), this->hessian_columns.cbegin() + number_nonzeros);
+         // upper triangle (row_index <= column_index)
+         std::vector<size_t> row_indices(static_cast<size_t>(number_nonzeros)), column_indices(static_cast<size_t>(number_nonzeros));
+         for (size_t nonzero_index: Range(static_cast<size_t>(number_nonzeros))) {
+            const size_t first_index = static_cast<size_t>(this->hessian_rows[nonzero_index] - 1);
+            const size_t second_index = static_cast<size_t>(this->hessian_columns[nonzero_index] - 1);
+            row_indices[nonzero_index] = std::min(first_index, second_index);
+            column_indices[nonzero_index] = std::max(first_index, second_index);
+         }
+         CUTEstModel::compress(this->number_variables, column_indices, row_indices, this->hessian_column_starts, this->hessian_row_indices,
+               this->hessian_positions);
+      }
+      // copy the nonzeros column by column
+      hessian.reset();
+      for (size_t column_index: Range(this->number_variables)) {
+         for (size_t nonzero_index: Range(this->hessian_column_starts[column_index], this->hessian_column_starts[column_index + 1])) {
+            hessian.insert(this->hessian_values[this->hessian_positions[nonzero_index]], this->hessian_row_indices[nonzero_index], column_index);
+         }
+         hessian.finalize_column(column_index);
+      }
+   }
+
+   void CUTEstModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      CUTEstLibrary::integer status = 0;
+      // the Hessian is not reused between products
+      const CUTEstLibrary::logical goth = 0;
+      if (this->library->is_constrained()) {
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            this->multipliers_with_flipped_sign[constraint_index] = -multipliers[constraint_index];
+         }
+         this->library->constrained_hessian_product(&status, &this->library->number_variables, &this->library->number_constraints, &goth,
+               x.data(), &objective_multiplier, this->multipliers_with_flipped_sign.data(), const_cast<double*>(vector.data()), result.data());
+         CUTEstLibrary::check(status, "chjprod");
+      }
+      else {
+         this->library->unconstrained_hessian_product(&status, &this->library->number_variables, &goth, x.data(),
+               const_cast<double*>(vector.data()), result.data());
+         CUTEstLibrary::check(status, "uhprod");
+         for (size_t variable_index: Range(this->number_variables)) {
+            result[variable_index] *= objective_multiplier;
+         }
+      }
+      if (status == CUTEstLibrary::evaluation_error) {
+         throw GradientEvaluationError();
+      }
+   }
+
+   void CUTEstModel::initial_primal_point(Vector<double>& x) const {
+      assert(x.size() >= this->number_variables);
+      std::copy(this->initial_primals.cbegin(), this->initial_primals.cend(), x.begin());
+   }
+
+   void CUTEstModel::initial_dual_point(Vector<double>& multipliers) const {
+      assert(multipliers.size() >= this->number_constraints);
+      std::copy(this->initial_multipliers.cbegin(), this->initial_multipliers.cend(), multipliers.begin());
+   }
+
+   // the CUTEst problems are minimization problems
+   void CUTEstModel::postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const {
+   }
+
+   void CUTEstModel::invalidate_point() const {
+      this->is_objective_cached = false;
+      this->are_constraints_cached = false;
+   }
+
+   size_t CUTEstModel::number_hessian_nonzeros() const {
+      this->ensure_hessian_sparsity();
+      return this->number_hessian_entries;
+   }
+
+   // a single call computes the objective and its dense gradient at x
+   void CUTEstModel::evaluate_objective_and_gradient(const Vector<double>& x) const {
+      if (this->is_objective_cached && std::equal(x.data(), x.data() + this->number_variables, this->objective_point.data())) {
+         return;
+      }
+      this->is_objective_cached = false;
+      CUTEstLibrary::integer status = 0;
+      const CUTEstLibrary::logical grad = 1;
+      this->library->objective_and_gradient(&status, &this->library->number_variables, x.data(), &this->cached_objective,
+            this->dense_gradient.data(), &grad);
+      CUTEstLibrary::check(status, this->library->is_constrained() ? "cofg" : "uofg");
+      if (status == CUTEstLibrary::evaluation_error || !std::isfinite(this->cached_objective)) {
+         throw FunctionEvaluationError();
+      }
+      std::copy(x.data(), x.data() + this->number_variables, this->objective_point.data());
+      this->is_objective_cached = true;
+   }
+
+   // a single call computes the constraints and their sparse Jacobian at x
+   void CUTEstModel::evaluate_constraints_and_jacobian(const Vector<double>& x) const {
+      if (this->are_constraints_cached && std::equal(x.data(), x.data() + this->number_variables, this->constraints_point.data())) {
+         return;
+      }
+      this->are_constraints_cached = false;
+      CUTEstLibrary::integer status = 0, number_nonzeros = 0;
+      const CUTEstLibrary::integer lj = static_cast<CUTEstLibrary::integer>(this->jacobian_values.size());
+      const CUTEstLibrary::logical grad = 1;
+      this->library->constraints_and_jacobian(&status, &this->library->number_variables, &this->library->number_constraints, x.data(),
+            this->cached_constraints.data(), &number_nonzeros, &lj, this->jacobian_values.data(), this->jacobian_variables.data(),
+            this->jacobian_functions.data(), &grad);
+      CUTEstLibrary::check(status, "ccfsg");
+      if (status == CUTEstLibrary::evaluation_error) {
+         throw FunctionEvaluationError();
+      }
+      // the map of the nonzeros is recomputed if their coordinates changed (first evaluation)
+      if (!std::equal(this->jacobian_variables.cbegin(), this->jacobian_variables.cbegin() + number_nonzeros,
+               this->jacobian_pattern_variables.cbegin(), this->jacobian_pattern_variables.cend()) ||
+            !std::equal(this->jacobian_functions.cbegin(), this->jacobian_functions.cbegin() + number_nonzeros,
+               this->jacobian_pattern_functions.cbegin(), this->jacobian_pattern_functions.cend())) {
+         if (this->number_jacobian_entries < static_cast<size_t>(number_nonzeros)) {
+            throw std::runtime_error("CUTEstModel: the Jacobian has more nonzeros than its sparsity pattern");
+         }
+         this->jacobian_pattern_variables.assign(this->jacobian_variables.cbegin(), this->jacobian_variables.cbegin() + number_nonzeros);
+         this->jacobian_pattern_functions.assign(this->jacobian_functions.cbegin(), this->jacobian_functions.cbegin() + number_nonzeros);
+         std::vector<size_t> row_indices(static_cast<size_t>(number_nonzeros)), column_indices(static_cast<size_t>(number_nonzeros));
+         for (size_t nonzero_index: Range(static_cast<size_t>(number_nonzeros))) {
+            row_indices[nonzero_index] = static_cast<size_t>(this->jacobian_functions[nonzero_index] - 1);
+            column_indices[nonzero_index] = static_cast<size_t>(this->jacobian_variables[nonzero_index] - 1);
+         }
+         CUTEstModel::compress(this->number_constraints, row_indices, column_indices, this->jacobian_row_starts, this->jacobian_column_indices,
+               this->jacobian_positions);
+      }
+      std::copy(x.data(), x.data() + this->number_variables, this->constraints_point.data());
+      this->are_constraints_cached = true;
+   }
+
+   // the concurrent requests compute the sparsity once
+   void CUTEstModel::ensure_hessian_sparsity() const {
+      std::call_once(this->hessian_sparsity_flag, [this]() {
+         CUTEstLibrary::integer status = 0, lh = 0;
+         this->library->hessian_size(&status, &lh);
+         CUTEstLibrary::check(status, this->library->is_constrained() ? "cdimsh" : "udimsh");
+         this->hessian_values.resize(static_cast<size_t>(lh));
+         this->hessian_rows.resize(static_cast<size_t>(lh));
+         this->hessian_columns.resize(static_cast<size_t>(lh));
+         CUTEstLibrary::integer number_nonzeros = 0;
+         this->library->hessian_pattern(&status, &this->library->number_variables, &number_nonzeros, &lh, this->hessian_rows.data(),
+               this->hessian_columns.data());
+         CUTEstLibrary::check(status, this->library->is_constrained() ? "cshp" : "ushp");
+         this->number_hessian_entries = static_cast<size_t>(number_nonzeros);
+      });
+   }
+
+   void CUTEstModel::generate_variables() {
+      for (size_t variable_index: Range(this->number_variables)) {
+         if (this->variable_lower_bounds[variable_index] == this->variable_upper_bounds[variable_index]) {
+            WARNING << "Variable x" << variable_index << " has identical bounds\n";
+            this->fixed_variables.emplace_back(variable_index);
+         }
+      }
+      CUTEstModel::determine_bounds_types(this->variable_lower_bounds, this->variable_upper_bounds, this->variable_status);
+      // figure out the bounded variables
+      for (size_t variable_index: Range(this->number_variables)) {
+         const BoundType status = this->get_variable_bound_type(variable_index);
+         if (status == BOUNDED_LOWER || status == BOUNDED_BOTH_SIDES) {
+            this->lower_bounded_variables.emplace_back(variable_index);
+            if (status == BOUNDED_LOWER) {
+               this->single_lower_bounded_variables.emplace_back(variable_index);
+            }
+         }
+         if (status == BOUNDED_UPPER || status == BOUNDED_BOTH_SIDES) {
+            this->upper_bounded_variables.emplace_back(variable_index);
+            if (status == BOUNDED_UPPER) {
+               this->single_upper_bounded_variables.emplace_back(variable_index);
+            }
+         }
+      }
+   }
+
+   void CUTEstModel::generate_constraints() {
+      CUTEstModel::determine_bounds_types(this->constraint_lower_bounds, this->constraint_upper_bounds, this->constraint_status);
+      // partition equality and inequality constraints
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (this->get_constraint_bound_type(constraint_index) == EQUAL_BOUNDS) {
+            this->equality_constraints.emplace_back(constraint_index);
+         }
+         else {
+            this->inequality_constraints.emplace_back(constraint_index);
+         }
+      }
+   }
+
+   void CUTEstModel::determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds,
+         std::vector<BoundType>& status) {
+      assert(lower_bounds.size() == status.size());
+      assert(upper_bounds.size() == status.size());
+      for (size_t index: Range(lower_bounds.size())) {
+         if (lower_bounds[index] == upper_bounds[index]) {
+            status[index] = EQUAL_BOUNDS;
+         }
+         else if (is_finite(lower_bounds[index]) && is_finite(upper_bounds[index])) {
+            status[index] = BOUNDED_BOTH_SIDES;
+         }
+         else if (is_finite(lower_bounds[index])) {
+            status[index] = BOUNDED_LOWER;
+         }
+         else if (is_finite(upper_bounds[index])) {
+            status[index] = BOUNDED_UPPER;
+         }
+         else {
+            status[index] = UNBOUNDED;
+         }
+      }
+   }
+
+   // the sort is stable: within a row (or column), the nonzeros keep the order in which the tools returned them
+   void CUTEstModel::compress(size_t dimension, const std::vector<size_t>& major_indices, const std::vector<size_t>& minor_indices,
+         std::vector<size_t>& starts, std::vector<size_t>& sorted_minor_indices, std::vector<size_t>& positions) {
+      const size_t number_nonzeros = major_indices.size();
+      starts.assign(dimension + 1, 0);
+      for (size_t major_index: major_indices) {
+         starts[major_index + 1]++;
+      }
+      for (size_t index: Range(dimension)) {
+         starts[index + 1] += starts[index];
+      }
+      sorted_minor_indices.resize(number_nonzeros);
+      positions.resize(number_nonzeros);
+      std::vector<size_t> next_slot(starts.cbegin(), starts.cend() - 1);
+      for (size_t nonzero_index: Range(number_nonzeros)) {
+         const size_t slot = next_slot[major_indices[nonzero_index]]++;
+         sorted_minor_indices[slot] = minor_indices[nonzero_index];
+         positions[slot] = nonzero_index;
+      }
+   }
+} // namespace
@@ -0,0 +1,160 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CUTESTMODEL_H
+#define UNO_CUTESTMODEL_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "model/Model.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+
+namespace uno {
+   // CUTEst tools (Fortran interface: default INTEGER and LOGICAL kinds, trailing underscore) resolved in the library of a problem
+   struct CUTEstLibrary;
+
+   /*! \class CUTEstModel
+    * \brief CUTEst problem evaluated by the CUTEst tools
+    *
+    *  The problem directory contains the OUTSDIF.d file and the shared library lib<PROBLEM>.so, where PROBLEM is the name of the
+    *  directory, obtained by decoding the SIF file and linking the decoded routines with the CUTEst tools:
+    *     sifdecoder PROBLEM.SIF
+    *     gfortran -shared -fPIC -o libPROBLEM.so ELFUN.f EXTER.f GROUP.f RANGE.f -L$CUTEST/objects/$MYARCH/double -lcutest
+    *  The evaluations use the combined calls of the tools: the objective and its dense gradient come from one call (cofg), the
+    *  constraints and their sparse Jacobian from another (ccfsg). Both are cached until another point is evaluated, so that the
+    *  requests of the function values and of the first derivatives at the same point cost a single call. The Lagrangian Hessian
+    *  (cshj) and its sparsity (cshp) are only evaluated upon request. The unconstrained problems use the u tools. The CUTEst tools
+    *  have a global state: a process loads a single problem, and the evaluations are not concurrent
+    */
+   class CUTEstModel: public Model {
+   public:
+      explicit CUTEstModel(const std::string& problem_directory);
+      ~CUTEstModel() override;
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->variable_lower_bounds[variable_index]; }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->variable_upper_bounds[variable_index]; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override { return this->variable_status[variable_index]; }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->lower_bounded_variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override {
+         return this->single_lower_bounded_variables_collection;
+      }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+         return this->single_upper_bounded_variables_collection;
+      }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->constraint_lower_bounds[constraint_index]; }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->constraint_upper_bounds[constraint_index]; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return NONLINEAR; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->constraint_type[constraint_index]; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override { return this->constraint_status[constraint_index]; }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->equality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->inequality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->linear_constraints_collection; }
+
+      void initial_primal_point(Vector<double>& x) const override;
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override;
+      void invalidate_point() const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->gradient_indices.size(); }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->number_jacobian_entries; }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+
+   private:
+      // delegating constructor: the dimensions are read before the Model base is constructed
+      CUTEstModel(const std::string& problem_directory, std::unique_ptr<CUTEstLibrary> library);
+
+      const std::unique_ptr<CUTEstLibrary> library;
+
+      // combined evaluations: values at the last evaluated points
+      mutable Vector<double> objective_point;
+      mutable bool is_objective_cached{false};
+      mutable double cached_objective{0.};
+      mutable std::vector<double> dense_gradient;
+      mutable Vector<double> constraints_point;
+      mutable bool are_constraints_cached{false};
+      mutable std::vector<double> cached_constraints;
+
+      // the tools return the coordinates (1-based) of the nonzeros with their values: the maps to the Uno structures are recomputed
+      // if the coordinates differ from those of the previous evaluation
+      std::vector<size_t> gradient_indices{};
+      size_t number_jacobian_entries{0};
+      mutable std::vector<double> jacobian_values{};
+      mutable std::vector<int> jacobian_variables{};
+      mutable std::vector<int> jacobian_functions{};
+      mutable std::vector<int> jacobian_pattern_variables{};
+      mutable std::vector<int> jacobian_pattern_functions{};
+      mutable std::vector<size_t> jacobian_row_starts{}; // CSR
+      mutable std::vector<size_t> jacobian_column_indices{};
+      mutable std::vector<size_t> jacobian_positions{};
+      // the Hessian sparsity is computed upon the first request (see ensure_hessian_sparsity)
+      mutable std::once_flag hessian_sparsity_flag{};
+      mutable size_t number_hessian_entries{0};
+      mutable std::vector<double> hessian_values{};
+      mutable std::vector<int> hessian_rows{};
+      mutable std::vector<int> hessian_columns{};
+      mutable std::vector<int> hessian_pattern_rows{};
+      mutable std::vector<int> hessian_pattern_columns{};
+      mutable std::vector<size_t> hessian_column_starts{}; // CSC, upper triangle
+      mutable std::vector<size_t> hessian_row_indices{};
+      mutable std::vector<size_t> hessian_positions{};
+      mutable Vector<double> multipliers_with_flipped_sign;
+
+      std::vector<double> initial_primals;
+      std::vector<double> initial_multipliers;
+      std::vector<double> variable_lower_bounds;
+      std::vector<double> variable_upper_bounds;
+      std::vector<double> constraint_lower_bounds;
+      std::vector<double> constraint_upper_bounds;
+      std::vector<BoundType> variable_status;
+      std::vector<BoundType> constraint_status;
+      std::vector<FunctionType> constraint_type;
+
+      std::vector<size_t> linear_constraints{};
+      CollectionAdapter<std::vector<size_t>&> linear_constraints_collection;
+      std::vector<size_t> equality_constraints{};
+      CollectionAdapter<std::vector<size_t>&> equality_constraints_collection;
+      std::vector<size_t> inequality_constraints{};
+      CollectionAdapter<std::vector<size_t>&> inequality_constraints_collection;
+      SparseVector<size_t> slacks{};
+      std::vector<size_t> lower_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> lower_bounded_variables_collection;
+      std::vector<size_t> upper_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> upper_bounded_variables_collection;
+      std::vector<size_t> single_lower_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> single_lower_bounded_variables_collection;
+      std::vector<size_t> single_upper_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> single_upper_bounded_variables_collection;
+      Vector<size_t> fixed_variables{};
+
+      void evaluate_objective_and_gradient(const Vector<double>& x) const;
+      void evaluate_constraints_and_jacobian(const Vector<double>& x) const;
+      void ensure_hessian_sparsity() const;
+      void generate_variables();
+      void generate_constraints();
+      static void determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds,
+            std::vector<BoundType>& status);
+      // counting sort of the nonzeros (major_indices[k], minor_indices[k]) by major index
+      static void compress(size_t dimension, const std::vector<size_t>& major_indices, const std::vector<size_t>& minor_indices,
+            std::vector<size_t>& starts, std::vector<size_t>& sorted_minor_indices, std::vector<size_t>& positions);
+   };
+} // namespace
+
+#endif // UNO_CUTESTMODEL_H
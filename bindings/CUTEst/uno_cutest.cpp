@@ -0,0 +1,144 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "CUTEstModel.hpp"
+#include "Uno.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "tools/BenchmarkReport.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+#include "tools/Timer.hpp"
+
+namespace uno {
+   // appends the record to the benchmark report in the file (created if necessary), so that the solves of a CUTEst campaign
+   // produce a report that can be compared with uno_benchmark
+   void append_benchmark_record(const std::string& file_name, BenchmarkRecord record) {
+      BenchmarkReport report{};
+      if (std::ifstream file(file_name); file.good() && file.peek() != std::ifstream::traits_type::eof()) {
+         report = BenchmarkReport::read(file);
+      }
+      report.add(std::move(record));
+      std::ofstream file(file_name);
+      if (!file) {
+         throw std::runtime_error("The benchmark file " + file_name + " could not be written");
+      }
+      report.write(file);
+   }
+
+   void run_uno_cutest(const std::string& problem_directory, const Options& options) {
+      const std::string problem_name = std::filesystem::path(problem_directory).filename().string();
+      const std::string& benchmark_file = options.get_string("CUTEst_benchmark_file");
+      const std::string& configuration = options.get_string("CUTEst_configuration");
+      const Timer timer{};
+      try {
+         // the parallel components of the solve share the threads of the pool
+         const std::unique_ptr<ThreadPool> thread_pool = ThreadPool::create(options);
+         const ThreadPool::Scope thread_pool_scope(thread_pool.get());
+
+         // CUTEst model
+         std::unique_ptr<Model> cutest_model = std::make_unique<CUTEstModel>(problem_directory);
+         DISCRETE << "Original model " << cutest_model->name << '\n' << cutest_model->number_variables << " variables, " <<
+            cutest_model->number_constraints << " constraints\n";
+
+         // reformulate (scale, add slacks, relax the bounds, ...) if necessary
+         std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(cutest_model), options);
+         DISCRETE << "Reformulated model " << model->name << '\n' << model->number_variables << " variables, " <<
+                  model->number_constraints << " constraints\n";
+
+         // initialize initial primal and dual points
+         Iterate initial_iterate(model->number_variables, model->number_constraints);
+         model->initial_primal_point(initial_iterate.primals);
+         model->project_onto_variable_bounds(initial_iterate.primals);
+         model->initial_dual_point(initial_iterate.multipliers.constraints);
+         initial_iterate.feasibility_multipliers.reset();
+
+         // create the constraint relaxation strategy, the globalization mechanism and the Uno solver
+         auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*model, options);
+         auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+         Uno uno = Uno(*globalization_mechanism, options);
+         const Result result = uno.solve(*model, initial_iterate, options);
+         if (!benchmark_file.empty()) {
+            append_benchmark_record(benchmark_file, BenchmarkRecord::from_result(problem_name, configuration, result));
+         }
+      }
+      catch (std::exception& exception) {
+         DISCRETE << exception.what() << '\n';
+         if (!benchmark_file.empty()) {
+            append_benchmark_record(benchmark_file, BenchmarkRecord::from_error(problem_name, configuration, exception.what(),
+               timer.get_duration()));
+         }
+      }
+   }
+
+   void print_uno_instructions() {
+      std::cout << "Welcome in Uno " << Uno::current_version() << '\n';
+      std::cout << "To solve a CUTEst problem, type ./uno_cutest problem_directory [option_name=option_value ...]\n";
+      std::cout << "The directory PROBLEM contains the OUTSDIF.d file and the library libPROBLEM.so decoded from PROBLEM.SIF\n";
+      std::cout << "To choose a preset, use the argument preset=[filtersqp|ipopt|byrd]\n";
+      std::cout << "To append the outcome of the solve to a benchmark report, use the argument CUTEst_benchmark_file=report.csv\n";
+      std::cout << "The options can be combined in the same command line.\n";
+   }
+} // namespace
+
+int main(int argc, char* argv[]) {
+   using namespace uno;
+
+   try {
+      if (argc == 1 || std::string(argv[1]) == "--v") {
+         print_uno_instructions();
+      }
+      else if (std::string(argv[1]) == "--strategies") {
+         Uno::print_available_strategies();
+      }
+      else {
+         // problem directory
+         const std::string problem_directory = std::string(argv[1]);
+
+         Options options = DefaultOptions::load();
+
+         // determine the default solvers based on the available libraries
+         Options solvers_options = DefaultOptions::determine_solvers();
+         options.overwrite_with(solvers_options);
+
+         // get the command line arguments (options start at index 2)
+         Options command_line_options = Options::get_command_line_options(argc, argv, 2);
+
+         // possibly set options from an option file
+         const auto optional_option_file = command_line_options.get_string_optional("option_file");
+         if (optional_option_file.has_value()) {
+            Options file_options = Options::load_option_file(*optional_option_file);
+            options.overwrite_with(file_options);
+         }
+
+         // possibly set a preset
+         const auto optional_preset = command_line_options.get_string_optional("preset");
+         Options preset_options = Presets::get_preset_options(optional_preset);
+         options.overwrite_with(preset_options);
+
+         // overwrite the options with the command line arguments
+         options.overwrite_with(command_line_options);
+
+         // solve the problem
+         Logger::set_logger(options.get_string("logger"));
+         run_uno_cutest(problem_directory, options);
+      }
+   }
+   catch (std::exception& exception) {
+      DISCRETE << exception.what() << '\n';
+   }
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,486 @@
+# Copyright (c) 2018-2024 Charlie Vanaret
+# Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+# MathOptInterface wrapper of the C interface of Uno (bindings/C/Uno_C_API.h).
+# The model is handed over to Uno through MOI's nonlinear evaluator: the sparsity patterns of the Jacobian and of the Hessian are
+# declared once, and each callback evaluates into the preallocated array of Uno (no .nl file is written)
+module UnoSolver
+
+import MathOptInterface as MOI
+
+# shared library uno_c (see the C API target of CMakeLists.txt)
+const libuno_c = get(ENV, "UNO_C_LIBRARY", "libuno_c")
+
+# constants of Uno_C_API.h
+const UNO_MINIMIZE = 1.0
+const UNO_MAXIMIZE = -1.0
+const UNO_LINEAR = Cint(0)
+const UNO_QUADRATIC = Cint(1)
+const UNO_NONLINEAR = Cint(2)
+
+const UNO_SUCCESS = 0
+const UNO_ITERATION_LIMIT = 1
+const UNO_TIME_LIMIT = 2
+const UNO_EVALUATION_ERROR = 3
+const UNO_ALGORITHMIC_ERROR = 4
+const UNO_USER_TERMINATION = 5
+const UNO_OBJECTIVE_CUTOFF = 6
+
+const UNO_NOT_OPTIMAL = 0
+const UNO_FEASIBLE_KKT_POINT = 1
+const UNO_FEASIBLE_FJ_POINT = 2
+const UNO_INFEASIBLE_STATIONARY_POINT = 3
+const UNO_FEASIBLE_SMALL_STEP = 4
+const UNO_INFEASIBLE_SMALL_STEP = 5
+const UNO_UNBOUNDED = 6
+
+const _SETS = Union{MOI.GreaterThan{Float64},MOI.LessThan{Float64},MOI.EqualTo{Float64},MOI.Interval{Float64}}
+const _FUNCTIONS = Union{MOI.ScalarAffineFunction{Float64},MOI.ScalarQuadraticFunction{Float64},MOI.ScalarNonlinearFunction}
+
+_bounds(set::MOI.GreaterThan{Float64}) = (set.lower, Inf)
+_bounds(set::MOI.LessThan{Float64}) = (-Inf, set.upper)
+_bounds(set::MOI.EqualTo{Float64}) = (set.value, set.value)
+_bounds(set::MOI.Interval{Float64}) = (set.lower, set.upper)
+
+_function_type(::MOI.ScalarAffineFunction{Float64}) = UNO_LINEAR
+_function_type(::MOI.VariableIndex) = UNO_LINEAR
+_function_type(::MOI.ScalarQuadraticFunction{Float64}) = UNO_QUADRATIC
+_function_type(::MOI.ScalarNonlinearFunction) = UNO_NONLINEAR
+
+# solution of the last call to optimize!
+mutable struct _Solution
+    optimization_status::Int
+    solution_status::Int
+    objective_value::Float64
+    primals::Vector{Float64}
+    constraint_values::Vector{Float64}
+    constraint_duals::Vector{Float64}
+    lower_bound_duals::Vector{Float64}
+    upper_bound_duals::Vector{Float64}
+    iterations::Int
+    solve_time::Float64
+end
+
+mutable struct Optimizer <: MOI.AbstractOptimizer
+    variables::MOI.Utilities.VariablesContainer{Float64}
+    variable_primal_start::Vector{Union{Nothing,Float64}}
+    # the objective and the constraints (affine, quadratic, nonlinear) are stored in a nonlinear model, or given as an NLP block
+    nlp_model::MOI.Nonlinear.Model
+    nlp_block::Union{Nothing,MOI.NLPBlockData}
+    constraint_bounds::Vector{Tuple{Float64,Float64}}
+    constraint_types::Vector{Cint}
+    objective_type::Cint
+    has_objective::Bool
+    sense::MOI.OptimizationSense
+    options::Dict{String,String}
+    silent::Bool
+    # state of a solve, accessed by the callbacks
+    evaluator::Union{Nothing,MOI.AbstractNLPEvaluator}
+    negated_multipliers::Vector{Float64}
+    callback_error::Union{Nothing,Exception}
+    solution::Union{Nothing,_Solution}
+
+    function Optimizer(; kwargs...)
+        optimizer = new(MOI.Utilities.VariablesContainer{Float64}(), Union{Nothing,Float64}[], MOI.Nonlinear.Model(), nothing,
+            Tuple{Float64,Float64}[], Cint[], UNO_LINEAR, false, MOI.FEASIBILITY_SENSE, Dict{String,String}(), false, nothing,
+            Float64[], nothing, nothing)
+        for (name, value) in kwargs
+            MOI.set(optimizer, MOI.RawOptimizerAttribute(string(name)), value)
+        end
+        return optimizer
+    end
+end
+
+MOI.get(::Optimizer, ::MOI.SolverName) = "Uno"
+
+function MOI.is_empty(model::Optimizer)
+    return MOI.is_empty(model.variables) && isempty(model.constraint_bounds) && model.nlp_block === nothing &&
+        !model.has_objective && model.sense == MOI.FEASIBILITY_SENSE
+end
+
+function MOI.empty!(model::Optimizer)
+    MOI.empty!(model.variables)
+    empty!(model.variable_primal_start)
+    model.nlp_model = MOI.Nonlinear.Model()
+    model.nlp_block = nothing
+    empty!(model.constraint_bounds)
+    empty!(model.constraint_types)
+    model.objective_type = UNO_LINEAR
+    model.has_objective = false
+    model.sense = MOI.FEASIBILITY_SENSE
+    model.evaluator = nothing
+    model.solution = nothing
+    return
+end
+
+MOI.supports_incremental_interface(::Optimizer) = true
+MOI.copy_to(model::Optimizer, source::MOI.ModelLike) = MOI.Utilities.default_copy_to(model, source)
+
+# options: the presets and the options of Uno (see uno/options/DefaultOptions.cpp) are raw attributes
+MOI.supports(::Optimizer, ::MOI.RawOptimizerAttribute) = true
+MOI.set(model::Optimizer, attribute::MOI.RawOptimizerAttribute, value) = (model.options[attribute.name] = string(value))
+function MOI.get(model::Optimizer, attribute::MOI.RawOptimizerAttribute)
+    if !haskey(model.options, attribute.name)
+        throw(MOI.GetAttributeNotAllowed(attribute, "the option $(attribute.name) was not set"))
+    end
+    return model.options[attribute.name]
+end
+
+MOI.supports(::Optimizer, ::MOI.Silent) = true
+MOI.set(model::Optimizer, ::MOI.Silent, value::Bool) = (model.silent = value)
+MOI.get(model::Optimizer, ::MOI.Silent) = model.silent
+
+MOI.supports(::Optimizer, ::MOI.TimeLimitSec) = true
+function MOI.set(model::Optimizer, ::MOI.TimeLimitSec, value::Union{Nothing,Real})
+    if value === nothing
+        delete!(model.options, "time_limit")
+    else
+        model.options["time_limit"] = string(Float64(value))
+    end
+    return
+end
+MOI.get(model::Optimizer, ::MOI.TimeLimitSec) = haskey(model.options, "time_limit") ? parse(Float64, model.options["time_limit"]) : nothing
+
+# variables and bounds
+MOI.add_variable(model::Optimizer) = (push!(model.variable_primal_start, nothing); MOI.add_variable(model.variables))
+MOI.is_valid(model::Optimizer, x::MOI.VariableIndex) = MOI.is_valid(model.variables, x)
+MOI.get(model::Optimizer, attribute::MOI.NumberOfVariables) = MOI.get(model.variables, attribute)
+MOI.get(model::Optimizer, attribute::MOI.ListOfVariableIndices) = MOI.get(model.variables, attribute)
+
+MOI.supports_constraint(::Optimizer, ::Type{MOI.VariableIndex}, ::Type{<:_SETS}) = true
+MOI.add_constraint(model::Optimizer, x::MOI.VariableIndex, set::_SETS) = MOI.add_constraint(model.variables, x, set)
+MOI.is_valid(model::Optimizer, index::MOI.ConstraintIndex{MOI.VariableIndex,<:_SETS}) = MOI.is_valid(model.variables, index)
+MOI.set(model::Optimizer, attribute::MOI.ConstraintSet, index::MOI.ConstraintIndex{MOI.VariableIndex,S}, set::S) where {S<:_SETS} =
+    MOI.set(model.variables, attribute, index, set)
+MOI.delete(model::Optimizer, index::MOI.ConstraintIndex{MOI.VariableIndex,<:_SETS}) = MOI.delete(model.variables, index)
+
+MOI.supports(::Optimizer, ::MOI.VariablePrimalStart, ::Type{MOI.VariableIndex}) = true
+MOI.set(model::Optimizer, ::MOI.VariablePrimalStart, x::MOI.VariableIndex, value::Union{Nothing,Real}) =
+    (model.variable_primal_start[x.value] = value)
+
+# general constraints: the row of a constraint is the value of its index
+MOI.supports_constraint(::Optimizer, ::Type{<:_FUNCTIONS}, ::Type{<:_SETS}) = true
+function MOI.add_constraint(model::Optimizer, f::F, set::S) where {F<:_FUNCTIONS,S<:_SETS}
+    if model.nlp_block !== nothing
+        throw(MOI.AddConstraintNotAllowed{F,S}("the constraints cannot be combined with an NLP block"))
+    end
+    MOI.Nonlinear.add_constraint(model.nlp_model, f, set)
+    push!(model.constraint_bounds, _bounds(set))
+    push!(model.constraint_types, _function_type(f))
+    return MOI.ConstraintIndex{F,S}(length(model.constraint_bounds))
+end
+
+# NLP block (legacy nonlinear interface of JuMP)
+MOI.supports(::Optimizer, ::MOI.NLPBlock) = true
+function MOI.set(model::Optimizer, ::MOI.NLPBlock, block::MOI.NLPBlockData)
+    if !isempty(model.constraint_bounds)
+        throw(MOI.SetAttributeNotAllowed(MOI.NLPBlock(), "the NLP block cannot be combined with other constraints"))
+    end
+    model.nlp_block = block
+    return
+end
+
+# objective
+MOI.supports(::Optimizer, ::MOI.ObjectiveSense) = true
+MOI.set(model::Optimizer, ::MOI.ObjectiveSense, sense::MOI.OptimizationSense) = (model.sense = sense)
+MOI.get(model::Optimizer, ::MOI.ObjectiveSense) = model.sense
+
+MOI.supports(::Optimizer, ::MOI.ObjectiveFunction{<:Union{MOI.VariableIndex,_FUNCTIONS}}) = true
+function MOI.set(model::Optimizer, ::MOI.ObjectiveFunction{F}, f::F) where {F<:Union{MOI.VariableIndex,_FUNCTIONS}}
+    MOI.Nonlinear.set_objective(model.nlp_model, f)
+    model.objective_type = _function_type(f)
+    model.has_objective = true
+    return
+end
+
+# callbacks of the C interface: they evaluate into the arrays of Uno. The exceptions cannot cross the C stack: they are stored
+# and rethrown after the solve
+function _evaluate(evaluation, user_data::Ptr{Cvoid})
+    model = unsafe_pointer_to_objref(user_data)::Optimizer
+    try
+        evaluation(model)
+        return Cint(0)
+    catch exception
+        # domain errors are evaluation errors (Uno then shortens the step)
+        if !(exception isa DomainError)
+            model.callback_error = exception
+        end
+        return Cint(1)
+    end
+end
+
+function _objective(n::Cint, x::Ptr{Cdouble}, objective_value::Ptr{Cdouble}, user_data::Ptr{Cvoid})::Cint
+    return _evaluate(user_data) do model
+        value = model.has_objective ? MOI.eval_objective(model.evaluator, unsafe_wrap(Array, x, n)) : 0.0
+        unsafe_store!(objective_value, value)
+    end
+end
+
+function _objective_gradient(n::Cint, x::Ptr{Cdouble}, gradient::Ptr{Cdouble}, user_data::Ptr{Cvoid})::Cint
+    return _evaluate(user_data) do model
+        # without objective, the gradient has no declared nonzeros
+        if model.has_objective
+            MOI.eval_objective_gradient(model.evaluator, unsafe_wrap(Array, gradient, n), unsafe_wrap(Array, x, n))
+        end
+    end
+end
+
+function _constraints(n::Cint, m::Cint, x::Ptr{Cdouble}, constraints::Ptr{Cdouble}, user_data::Ptr{Cvoid})::Cint
+    return _evaluate(user_data) do model
+        MOI.eval_constraint(model.evaluator, unsafe_wrap(Array, constraints, m), unsafe_wrap(Array, x, n))
+    end
+end
+
+function _jacobian(n::Cint, nnz::Cint, x::Ptr{Cdouble}, jacobian::Ptr{Cdouble}, user_data::Ptr{Cvoid})::Cint
+    return _evaluate(user_data) do model
+        MOI.eval_constraint_jacobian(model.evaluator, unsafe_wrap(Array, jacobian, nnz), unsafe_wrap(Array, x, n))
+    end
+end
+
+# the Lagrangian of Uno is σ f(x) - λ^T c(x), that of MOI is σ f(x) + μ^T c(x)
+function _hessian(n::Cint, m::Cint, nnz::Cint, x::Ptr{Cdouble}, objective_multiplier::Cdouble, multipliers::Ptr{Cdouble},
+        hessian::Ptr{Cdouble}, user_data::Ptr{Cvoid})::Cint
+    return _evaluate(user_data) do model
+        model.negated_multipliers .= .-unsafe_wrap(Array, multipliers, m)
+        σ = model.has_objective ? objective_multiplier : 0.0
+        MOI.eval_hessian_lagrangian(model.evaluator, unsafe_wrap(Array, hessian, nnz), unsafe_wrap(Array, x, n), σ,
+            model.negated_multipliers)
+    end
+end
+
+_check(success::Bool, function_name::String) = success || error("$(function_name) failed")
+
+# indices of (row, column) pairs, 0-based
+_rows(structure) = Cint[row - 1 for (row, _) in structure]
+_columns(structure) = Cint[column - 1 for (_, column) in structure]
+
+function MOI.optimize!(model::Optimizer)
+    model.solution = nothing
+    model.callback_error = nothing
+    variables = MOI.get(model.variables, MOI.ListOfVariableIndices())
+    n = length(variables)
+    if n == 0
+        error("Uno requires at least one variable")
+    end
+    if model.nlp_block !== nothing
+        if model.has_objective && !model.nlp_block.has_objective
+            error("the objective of an NLP block model should be nonlinear")
+        end
+        model.evaluator = model.nlp_block.evaluator
+        model.has_objective = model.nlp_block.has_objective
+        model.objective_type = UNO_NONLINEAR
+        constraint_bounds = [(bound.lower, bound.upper) for bound in model.nlp_block.constraint_bounds]
+        constraint_types = fill(UNO_NONLINEAR, length(constraint_bounds))
+    else
+        model.evaluator = MOI.Nonlinear.Evaluator(model.nlp_model, MOI.Nonlinear.SparseReverseMode(), variables)
+        constraint_bounds = model.constraint_bounds
+        constraint_types = model.constraint_types
+    end
+    m = length(constraint_bounds)
+    features = MOI.features_available(model.evaluator)
+    has_hessian = (:Hess in features)
+    MOI.initialize(model.evaluator, has_hessian ? [:Grad, :Jac, :Hess] : [:Grad, :Jac])
+    model.negated_multipliers = zeros(m)
+
+    # model
+    objective_sign = (model.sense == MOI.MAX_SENSE) ? UNO_MAXIMIZE : UNO_MINIMIZE
+    constraints_lower_bounds = Float64[bounds[1] for bounds in constraint_bounds]
+    constraints_upper_bounds = Float64[bounds[2] for bounds in constraint_bounds]
+    uno_model = ccall((:uno_create_model, libuno_c), Ptr{Cvoid},
+        (Cint, Ptr{Cdouble}, Ptr{Cdouble}, Cint, Ptr{Cdouble}, Ptr{Cdouble}, Cdouble),
+        n, model.variables.lower, model.variables.upper, m, constraints_lower_bounds, constraints_upper_bounds, objective_sign)
+    if uno_model == C_NULL
+        error("Uno could not create the model")
+    end
+    solver = C_NULL
+    try
+        # the dense gradient is evaluated by MOI
+        gradient_indices = (model.has_objective) ? Cint.(0:(n - 1)) : Cint[]
+        objective_type = (model.has_objective) ? model.objective_type : UNO_LINEAR
+        _check(ccall((:uno_set_objective, libuno_c), Bool, (Ptr{Cvoid}, Cint, Ptr{Cvoid}, Cint, Ptr{Cint}, Ptr{Cvoid}),
+            uno_model, objective_type, @cfunction(_objective, Cint, (Cint, Ptr{Cdouble}, Ptr{Cdouble}, Ptr{Cvoid})),
+            length(gradient_indices), gradient_indices,
+            @cfunction(_objective_gradient, Cint, (Cint, Ptr{Cdouble}, Ptr{Cdouble}, Ptr{Cvoid}))), "uno_set_objective")
+        if 0 < m
+            jacobian_structure = MOI.jacobian_structure(model.evaluator)
+            _check(ccall((:uno_set_constraints, libuno_c), Bool, (Ptr{Cvoid}, Ptr{Cint}, Ptr{Cvoid}, Cint, Ptr{Cint}, Ptr{Cint}, Ptr{Cvoid}),
+                uno_model, constraint_types, @cfunction(_constraints, Cint, (Cint, Cint, Ptr{Cdouble}, Ptr{Cdouble}, Ptr{Cvoid})),
+                length(jacobian_structure), _rows(jacobian_structure), _columns(jacobian_structure),
+                @cfunction(_jacobian, Cint, (Cint, Cint, Ptr{Cdouble}, Ptr{Cdouble}, Ptr{Cvoid}))), "uno_set_constraints")
+        end
+        if has_hessian
+            hessian_structure = MOI.hessian_lagrangian_structure(model.evaluator)
+            _check(ccall((:uno_set_lagrangian_hessian, libuno_c), Bool, (Ptr{Cvoid}, Cint, Ptr{Cint}, Ptr{Cint}, Ptr{Cvoid}),
+                uno_model, length(hessian_structure), _rows(hessian_structure), _columns(hessian_structure),
+                @cfunction(_hessian, Cint, (Cint, Cint, Cint, Ptr{Cdouble}, Cdouble, Ptr{Cdouble}, Ptr{Cdouble}, Ptr{Cvoid}))),
+                "uno_set_lagrangian_hessian")
+        end
+        ccall((:uno_set_user_data, libuno_c), Bool, (Ptr{Cvoid}, Ptr{Cvoid}), uno_model, pointer_from_objref(model))
+        # the starting point is projected onto the bounds by Uno
+        initial_primals = Float64[something(start, 0.0) for start in model.variable_primal_start]
+        ccall((:uno_set_initial_point, libuno_c), Bool, (Ptr{Cvoid}, Ptr{Cdouble}, Ptr{Cdouble}), uno_model, initial_primals, C_NULL)
+
+        # solver
+        solver = ccall((:uno_create_solver, libuno_c), Ptr{Cvoid}, ())
+        options = copy(model.options)
+        if !has_hessian && !haskey(options, "hessian_model")
+            options["hessian_model"] = "LBFGS"
+        end
+        if model.silent
+            options["logger"] = "SILENT"
+        end
+        preset = pop!(options, "preset", nothing)
+        if preset !== nothing
+            ccall((:uno_set_solver_preset, libuno_c), Bool, (Ptr{Cvoid}, Cstring), solver, preset)
+        end
+        for (name, value) in options
+            ccall((:uno_set_solver_option, libuno_c), Bool, (Ptr{Cvoid}, Cstring, Cstring), solver, name, value)
+        end
+        start_time = time()
+        solved = GC.@preserve model ccall((:uno_optimize, libuno_c), Bool, (Ptr{Cvoid}, Ptr{Cvoid}), solver, uno_model)
+        solve_time = time() - start_time
+        if model.callback_error !== nothing
+            throw(model.callback_error)
+        end
+        if !solved
+            error("Uno could not solve the model (invalid options or missing callbacks)")
+        end
+
+        # solution
+        solution = _Solution(
+            ccall((:uno_get_optimization_status, libuno_c), Cint, (Ptr{Cvoid},), solver),
+            ccall((:uno_get_solution_status, libuno_c), Cint, (Ptr{Cvoid},), solver),
+            ccall((:uno_get_solution_objective, libuno_c), Cdouble, (Ptr{Cvoid},), solver),
+            zeros(n), zeros(m), zeros(m), zeros(n), zeros(n),
+            ccall((:uno_get_number_iterations, libuno_c), Cint, (Ptr{Cvoid},), solver), solve_time)
+        ccall((:uno_get_primal_solution, libuno_c), Cvoid, (Ptr{Cvoid}, Ptr{Cdouble}), solver, solution.primals)
+        ccall((:uno_get_constraint_dual_solution, libuno_c), Cvoid, (Ptr{Cvoid}, Ptr{Cdouble}), solver, solution.constraint_duals)
+        ccall((:uno_get_lower_bound_dual_solution, libuno_c), Cvoid, (Ptr{Cvoid}, Ptr{Cdouble}), solver, solution.lower_bound_duals)
+        ccall((:uno_get_upper_bound_dual_solution, libuno_c), Cvoid, (Ptr{Cvoid}, Ptr{Cdouble}), solver, solution.upper_bound_duals)
+        if 0 < m
+            MOI.eval_constraint(model.evaluator, solution.constraint_values, solution.primals)
+        end
+        if !model.has_objective
+            solution.objective_value = 0.0
+        end
+        model.solution = solution
+    finally
+        if solver != C_NULL
+            ccall((:uno_destroy_solver, libuno_c), Cvoid, (Ptr{Cvoid},), solver)
+        end
+        ccall((:uno_destroy_model, libuno_c), Cvoid, (Ptr{Cvoid},), uno_model)
+    end
+    return
+end
+
+# results
+function MOI.get(model::Optimizer, ::MOI.TerminationStatus)
+    if model.solution === nothing
+        return MOI.OPTIMIZE_NOT_CALLED
+    end
+    status = model.solution.optimization_status
+    if status == UNO_SUCCESS
+        solution_status = model.solution.solution_status
+        if solution_status == UNO_FEASIBLE_KKT_POINT
+            return MOI.LOCALLY_SOLVED
+        elseif solution_status == UNO_FEASIBLE_FJ_POINT
+            return MOI.ALMOST_LOCALLY_SOLVED
+        elseif solution_status == UNO_INFEASIBLE_STATIONARY_POINT
+            return MOI.LOCALLY_INFEASIBLE
+        elseif solution_status == UNO_UNBOUNDED
+            return MOI.NORM_LIMIT
+        else
+            return MOI.SLOW_PROGRESS
+        end
+    elseif status == UNO_ITERATION_LIMIT
+        return MOI.ITERATION_LIMIT
+    elseif status == UNO_TIME_LIMIT
+        return MOI.TIME_LIMIT
+    elseif status == UNO_EVALUATION_ERROR
+        return MOI.NUMERICAL_ERROR
+    elseif status == UNO_USER_TERMINATION
+        return MOI.INTERRUPTED
+    elseif status == UNO_OBJECTIVE_CUTOFF
+        return MOI.OBJECTIVE_LIMIT
+    end
+    return MOI.OTHER_ERROR
+end
+
+function MOI.get(model::Optimizer, ::MOI.RawStatusString)
+    return (model.solution === nothing) ? "optimize not called" :
+        "optimization status $(model.solution.optimization_status), solution status $(model.solution.solution_status)"
+end
+
+MOI.get(model::Optimizer, ::MOI.ResultCount) = (model.solution === nothing) ? 0 : 1
+
+function MOI.get(model::Optimizer, attribute::MOI.PrimalStatus)
+    if model.solution === nothing || attribute.result_index != 1
+        return MOI.NO_SOLUTION
+    end
+    solution_status = model.solution.solution_status
+    if solution_status in (UNO_FEASIBLE_KKT_POINT, UNO_FEASIBLE_FJ_POINT, UNO_FEASIBLE_SMALL_STEP)
+        return MOI.FEASIBLE_POINT
+    elseif solution_status in (UNO_INFEASIBLE_STATIONARY_POINT, UNO_INFEASIBLE_SMALL_STEP)
+        return MOI.INFEASIBLE_POINT
+    end
+    return MOI.UNKNOWN_RESULT_STATUS
+end
+
+function MOI.get(model::Optimizer, attribute::MOI.DualStatus)
+    if model.solution === nothing || attribute.result_index != 1
+        return MOI.NO_SOLUTION
+    end
+    return (model.solution.solution_status == UNO_FEASIBLE_KKT_POINT) ? MOI.FEASIBLE_POINT : MOI.UNKNOWN_RESULT_STATUS
+end
+
+function MOI.get(model::Optimizer, attribute::MOI.ObjectiveValue)
+    MOI.check_result_index_bounds(model, attribute)
+    return model.solution.objective_value
+end
+
+MOI.get(model::Optimizer, ::MOI.SolveTimeSec) = (model.solution === nothing) ? NaN : model.solution.solve_time
+MOI.get(model::Optimizer, ::MOI.BarrierIterations) = (model.solution === nothing) ? 0 : model.solution.iterations
+
+function MOI.get(model::Optimizer, attribute::MOI.VariablePrimal, x::MOI.VariableIndex)
+    MOI.check_result_index_bounds(model, attribute)
+    return model.solution.primals[x.value]
+end
+
+function MOI.get(model::Optimizer, attribute::MOI.ConstraintPrimal, index::MOI.ConstraintIndex{<:_FUNCTIONS,<:_SETS})
+    MOI.check_result_index_bounds(model, attribute)
+    return model.solution.constraint_values[index.value]
+end
+
+function MOI.get(model::Optimizer, attribute::MOI.ConstraintPrimal, index::MOI.ConstraintIndex{MOI.VariableIndex,<:_SETS})
+    MOI.check_result_index_bounds(model, attribute)
+    return model.solution.primals[index.value]
+end
+
+# the multipliers of Uno satisfy ∇f = J^T λ + z_L + z_U with λ and z_L nonnegative at active lower bounds, as the duals of MOI
+function MOI.get(model::Optimizer, attribute::MOI.ConstraintDual, index::MOI.ConstraintIndex{<:_FUNCTIONS,<:_SETS})
+    MOI.check_result_index_bounds(model, attribute)
+    return model.solution.constraint_duals[index.value]
+end
+
+function MOI.get(model::Optimizer, attribute::MOI.ConstraintDual, index::MOI.ConstraintIndex{MOI.VariableIndex,MOI.GreaterThan{Float64}})
+    MOI.check_result_index_bounds(model, attribute)
+    return model.solution.lower_bound_duals[index.value]
+end
+
+function MOI.get(model::Optimizer, attribute::MOI.ConstraintDual, index::MOI.ConstraintIndex{MOI.VariableIndex,MOI.LessThan{Float64}})
+    MOI.check_result_index_bounds(model, attribute)
+    return model.solution.upper_bound_duals[index.value]
+end
+
+function MOI.get(model::Optimizer, attribute::MOI.ConstraintDual,
+        index::MOI.ConstraintIndex{MOI.VariableIndex,<:Union{MOI.EqualTo{Float64},MOI.Interval{Float64}}})
+    MOI.check_result_index_bounds(model, attribute)
+    return model.solution.lower_bound_duals[index.value] + model.solution.upper_bound_duals[index.value]
+end
+
+function MOI.get(model::Optimizer, attribute::MOI.NLPBlockDual)
+    MOI.check_result_index_bounds(model, attribute)
+    return model.solution.constraint_duals
+end
+
+end # module
@@ -0,0 +1,371 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include "CModel.hpp"
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "model/InstanceModel.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "tools/Logger.hpp"
+
+namespace py = pybind11;
+using namespace uno;
+
+// The model is a CModel whose C callbacks forward to Python functions: there is exactly one Python call per evaluation (objective,
+// gradient, constraints, Jacobian, Hessian). The arguments and the output arrays are NumPy views onto the buffers of Uno and of
+// the CModel (no copy): x and the multipliers are read-only, and the callbacks write the values of the derivatives in the order
+// of their declared sparsity pattern into the output array
+namespace {
+   using IndexArray = py::array_t<int32_t, py::array::c_style | py::array::forcecast>;
+   using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+   // Python functions of a model
+   struct PythonCallbacks {
+      py::function objective{};
+      py::function objective_gradient{};
+      py::function constraints{};
+      py::function constraint_jacobian{};
+      py::function lagrangian_hessian{};
+      size_t number_gradient_nonzeros{0};
+      // base object of the views: NumPy does not copy the data of an array that has a base. The data are kept alive by Uno
+      py::capsule base{static_cast<const void*>(this)};
+   };
+
+   py::array_t<double> view(double* data, size_t size, const py::handle& base) {
+      return py::array_t<double>({static_cast<py::ssize_t>(size)}, {static_cast<py::ssize_t>(sizeof(double))}, data, base);
+   }
+
+   py::array_t<double> read_only_view(const double* data, size_t size, const py::handle& base) {
+      py::array_t<double> array = view(const_cast<double*>(data), size, base);
+      py::detail::array_proxy(array.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+      return array;
+   }
+
+   // arithmetic and domain errors raised by a callback are evaluation errors (Uno then shortens the step). The other exceptions
+   // interrupt the solve and are raised in Python
+   template <typename Evaluation>
+   int32_t evaluate(Evaluation&& evaluation) {
+      try {
+         evaluation();
+         return 0;
+      }
+      catch (py::error_already_set& error) {
+         if (error.matches(PyExc_ArithmeticError) || error.matches(PyExc_ValueError)) {
+            return 1;
+         }
+         throw;
+      }
+   }
+
+   int32_t python_objective(int32_t number_variables, const double* x, double* objective_value, void* user_data) {
+      const PythonCallbacks& callbacks = *static_cast<PythonCallbacks*>(user_data);
+      return evaluate([&]() {
+         *objective_value = callbacks.objective(read_only_view(x, static_cast<size_t>(number_variables), callbacks.base)).cast<double>();
+      });
+   }
+
+   int32_t python_objective_gradient(int32_t number_variables, const double* x, double* gradient_values, void* user_data) {
+      const PythonCallbacks& callbacks = *static_cast<PythonCallbacks*>(user_data);
+      return evaluate([&]() {
+         callbacks.objective_gradient(read_only_view(x, static_cast<size_t>(number_variables), callbacks.base),
+            view(gradient_values, callbacks.number_gradient_nonzeros, callbacks.base));
+      });
+   }
+
+   int32_t python_constraints(int32_t number_variables, int32_t number_constraints, const double* x, double* constraint_values,
+         void* user_data) {
+      const PythonCallbacks& callbacks = *static_cast<PythonCallbacks*>(user_data);
+      return evaluate([&]() {
+         callbacks.constraints(read_only_view(x, static_cast<size_t>(number_variables), callbacks.base),
+            view(constraint_values, static_cast<size_t>(number_constraints), callbacks.base));
+      });
+   }
+
+   int32_t python_constraint_jacobian(int32_t number_variables, int32_t number_jacobian_nonzeros, const double* x, double* jacobian_values,
+         void* user_data) {
+      const PythonCallbacks& callbacks = *static_cast<PythonCallbacks*>(user_data);
+      return evaluate([&]() {
+         callbacks.constraint_jacobian(read_only_view(x, static_cast<size_t>(number_variables), callbacks.base),
+            view(jacobian_values, static_cast<size_t>(number_jacobian_nonzeros), callbacks.base));
+      });
+   }
+
+   int32_t python_lagrangian_hessian(int32_t number_variables, int32_t number_constraints, int32_t number_hessian_nonzeros, const double* x,
+         double objective_multiplier, const double* multipliers, double* hessian_values, void* user_data) {
+      const PythonCallbacks& callbacks = *static_cast<PythonCallbacks*>(user_data);
+      return evaluate([&]() {
+         callbacks.lagrangian_hessian(read_only_view(x, static_cast<size_t>(number_variables), callbacks.base), objective_multiplier,
+            read_only_view(multipliers, static_cast<size_t>(number_constraints), callbacks.base),
+            view(hessian_values, static_cast<size_t>(number_hessian_nonzeros), callbacks.base));
+      });
+   }
+
+   FunctionType to_function_type(int32_t function_type) {
+      switch (function_type) {
+         case UNO_LINEAR:
+            return LINEAR;
+         case UNO_QUADRATIC:
+            return QUADRATIC;
+         case UNO_NONLINEAR:
+            return NONLINEAR;
+         default:
+            throw std::invalid_argument("The function type " + std::to_string(function_type) + " is unknown");
+      }
+   }
+
+   void check_size(const py::array& array, size_t expected_size, const std::string& name) {
+      if (static_cast<size_t>(array.size()) != expected_size) {
+         throw std::invalid_argument("The array " + name + " should have " + std::to_string(expected_size) + " elements");
+      }
+   }
+
+   // model: the bounds are copied, and the callbacks and patterns are declared once
+   struct PythonModel {
+      // the callbacks are not moved: the CModel points to them
+      std::unique_ptr<PythonCallbacks> callbacks{std::make_unique<PythonCallbacks>()};
+      std::unique_ptr<CModel> model;
+
+      PythonModel(const DoubleArray& variables_lower_bounds, const DoubleArray& variables_upper_bounds, const DoubleArray& constraints_lower_bounds,
+            const DoubleArray& constraints_upper_bounds, double objective_sign) {
+         const size_t number_variables = static_cast<size_t>(variables_lower_bounds.size());
+         const size_t number_constraints = static_cast<size_t>(constraints_lower_bounds.size());
+         check_size(variables_upper_bounds, number_variables, "variables_upper_bounds");
+         check_size(constraints_upper_bounds, number_constraints, "constraints_upper_bounds");
+         if (number_variables == 0) {
+            throw std::invalid_argument("The model should have at least one variable");
+         }
+         this->model = std::make_unique<CModel>(number_variables, variables_lower_bounds.data(), variables_upper_bounds.data(),
+               number_constraints, constraints_lower_bounds.data(), constraints_upper_bounds.data(), objective_sign);
+         this->model->set_user_data(this->callbacks.get());
+      }
+
+      void set_objective(int32_t objective_type, py::function objective, const IndexArray& gradient_indices, py::function objective_gradient) {
+         this->callbacks->objective = std::move(objective);
+         this->callbacks->objective_gradient = std::move(objective_gradient);
+         this->callbacks->number_gradient_nonzeros = static_cast<size_t>(gradient_indices.size());
+         this->model->set_objective(to_function_type(objective_type), python_objective, this->callbacks->number_gradient_nonzeros,
+               gradient_indices.data(),
+               python_objective_gradient);
+      }
+
+      void set_constraints(py::function constraints, const IndexArray& jacobian_row_indices, const IndexArray& jacobian_column_indices,
+            py::function constraint_jacobian, const std::optional<IndexArray>& constraint_types) {
+         check_size(jacobian_column_indices, static_cast<size_t>(jacobian_row_indices.size()), "jacobian_column_indices");
+         if (constraint_types.has_value()) {
+            check_size(*constraint_types, this->model->number_constraints, "constraint_types");
+         }
+         this->callbacks->constraints = std::move(constraints);
+         this->callbacks->constraint_jacobian = std::move(constraint_jacobian);
+         this->model->set_constraints(constraint_types.has_value() ? constraint_types->data() : nullptr, python_constraints,
+               static_cast<size_t>(jacobian_row_indices.size()), jacobian_row_indices.data(), jacobian_column_indices.data(),
+               python_constraint_jacobian);
+      }
+
+      void set_lagrangian_hessian(const IndexArray& hessian_row_indices, const IndexArray& hessian_column_indices, py::function lagrangian_hessian) {
+         check_size(hessian_column_indices, static_cast<size_t>(hessian_row_indices.size()), "hessian_column_indices");
+         this->callbacks->lagrangian_hessian = std::move(lagrangian_hessian);
+         this->model->set_lagrangian_hessian(static_cast<size_t>(hessian_row_indices.size()), hessian_row_indices.data(),
+               hessian_column_indices.data(), python_lagrangian_hessian);
+      }
+
+      void set_initial_point(const DoubleArray& initial_primals, const std::optional<DoubleArray>& initial_multipliers) {
+         check_size(initial_primals, this->model->number_variables, "initial_primals");
+         if (initial_multipliers.has_value()) {
+            check_size(*initial_multipliers, this->model->number_constraints, "initial_multipliers");
+         }
+         this->model->set_initial_point(initial_primals.data(), initial_multipliers.has_value() ? initial_multipliers->data() : nullptr);
+      }
+   };
+
+
+   // solver: the strategies of the last solve are kept, so that resolve reuses the structure of the model
+   struct PythonSolver {
+      Options options{DefaultOptions::load()};
+      std::optional<std::string> preset{};
+      Options user_options{false};
+
+      // state of the last solve
+      const PythonModel* solved_model{nullptr};
+      Options solve_options{false};
+      std::unique_ptr<Model> reformulated_model{};
+      std::unique_ptr<ConstraintRelaxationStrategy> constraint_relaxation_strategy{};
+      std::unique_ptr<GlobalizationMechanism> globalization_mechanism{};
+      std::unique_ptr<Uno> uno{};
+
+      PythonSolver() {
+         // determine the default solvers based on the available libraries
+         this->options.overwrite_with(DefaultOptions::determine_solvers());
+      }
+
+      Result solve(const PythonModel& model) {
+         if (!model.model->is_complete()) {
+            throw std::invalid_argument("The model is missing callbacks");
+         }
+         this->reset();
+         // the preset and the user options are applied on top of the default options
+         this->solve_options = this->options;
+         this->solve_options.overwrite_with(Presets::get_preset_options(this->preset));
+         this->solve_options.overwrite_with(this->user_options);
+         Logger::set_logger(this->solve_options.get_string("logger"));
+
+         // the reformulations take ownership of a view of the model, which is owned by Python
+         this->reformulated_model = ModelFactory::reformulate(std::make_unique<InstanceModel>(*model.model), this->solve_options);
+         this->constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*this->reformulated_model, this->solve_options);
+         this->globalization_mechanism = GlobalizationMechanismFactory::create(*this->constraint_relaxation_strategy, this->solve_options);
+         this->uno = std::make_unique<Uno>(*this->globalization_mechanism, this->solve_options);
+         this->solved_model = &model;
+         Iterate initial_iterate = this->generate_initial_iterate();
+         return this->restrict_to_model(this->uno->solve(*this->reformulated_model, initial_iterate, this->solve_options));
+      }
+
+      // re-solves the model of the last solve from its (possibly new) initial point, with the options of the last solve
+      Result resolve(const PythonModel& model) {
+         if (this->solved_model == nullptr) {
+            return this->solve(model);
+         }
+         if (this->solved_model != &model) {
+            throw std::invalid_argument("resolve requires the model of the previous solve");
+         }
+         // the functions of a model may depend on Python parameters that changed since the last solve: the reformulations discard
+         // their cached evaluations
+         this->reformulated_model->refresh();
+         Iterate initial_iterate = this->generate_initial_iterate();
+         return this->restrict_to_model(this->uno->resolve(*this->reformulated_model, initial_iterate, this->solve_options));
+      }
+
+      // the solution of the reformulated model may have additional variables (e.g. slacks): the result covers the original ones
+      Result restrict_to_model(Result result) const {
+         result.number_variables = this->solved_model->model->number_variables;
+         result.number_constraints = this->solved_model->model->number_constraints;
+         return result;
+      }
+
+      Iterate generate_initial_iterate() const {
+         Iterate initial_iterate(this->reformulated_model->number_variables, this->reformulated_model->number_constraints);
+         this->reformulated_model->initial_primal_point(initial_iterate.primals);
+         this->reformulated_model->project_onto_variable_bounds(initial_iterate.primals);
+         this->reformulated_model->initial_dual_point(initial_iterate.multipliers.constraints);
+         initial_iterate.feasibility_multipliers.reset();
+         return initial_iterate;
+      }
+
+      void reset() {
+         this->uno.reset();
+         this->globalization_mechanism.reset();
+         this->constraint_relaxation_strategy.reset();
+         this->reformulated_model.reset();
+         this->solved_model = nullptr;
+      }
+   };
+
+   // the views keep the Result alive
+   py::array_t<double> solution_view(const py::object& result, const Vector<double>& vector, size_t size) {
+      return read_only_view(vector.data(), size, result);
+   }
+} // namespace
+
+PYBIND11_MODULE(unopy, python_module) {
+   python_module.doc() = "Python interface of Uno, a unifying framework for nonlinearly constrained optimization";
+
+   python_module.attr("MINIMIZE") = UNO_MINIMIZE;
+   python_module.attr("MAXIMIZE") = UNO_MAXIMIZE;
+   python_module.attr("LINEAR") = UNO_LINEAR;
+   python_module.attr("QUADRATIC") = UNO_QUADRATIC;
+   python_module.attr("NONLINEAR") = UNO_NONLINEAR;
+
+   py::enum_<OptimizationStatus>(python_module, "OptimizationStatus")
+      .value("SUCCESS", OptimizationStatus::SUCCESS)
+      .value("ITERATION_LIMIT", OptimizationStatus::ITERATION_LIMIT)
+      .value("TIME_LIMIT", OptimizationStatus::TIME_LIMIT)
+      .value("EVALUATION_ERROR", OptimizationStatus::EVALUATION_ERROR)
+      .value("ALGORITHMIC_ERROR", OptimizationStatus::ALGORITHMIC_ERROR)
+      .value("USER_TERMINATION", OptimizationStatus::USER_TERMINATION)
+      .value("OBJECTIVE_CUTOFF", OptimizationStatus::OBJECTIVE_CUTOFF);
+
+   py::enum_<IterateStatus>(python_module, "IterateStatus")
+      .value("NOT_OPTIMAL", IterateStatus::NOT_OPTIMAL)
+      .value("FEASIBLE_KKT_POINT", IterateStatus::FEASIBLE_KKT_POINT)
+      .value("FEASIBLE_FJ_POINT", IterateStatus::FEASIBLE_FJ_POINT)
+      .value("INFEASIBLE_STATIONARY_POINT", IterateStatus::INFEASIBLE_STATIONARY_POINT)
+      .value("FEASIBLE_SMALL_STEP", IterateStatus::FEASIBLE_SMALL_STEP)
+      .value("INFEASIBLE_SMALL_STEP", IterateStatus::INFEASIBLE_SMALL_STEP)
+      .value("UNBOUNDED", IterateStatus::UNBOUNDED);
+
+   // callbacks (x and the multipliers are read-only NumPy arrays, out is written in place):
+   // - objective(x) -> float
+   // - objective_gradient(x, out): values at gradient_indices
+   // - constraints(x, out)
+   // - constraint_jacobian(x, out): values at the (row, column) pairs of the pattern
+   // - lagrangian_hessian(x, objective_multiplier, multipliers, out): Hessian of objective_multiplier * f(x) - multipliers^T c(x)
+   //   at the (row, column) pairs of the pattern (one triangle)
+   py::class_<PythonModel>(python_module, "Model")
+      .def(py::init<const DoubleArray&, const DoubleArray&, const DoubleArray&, const DoubleArray&, double>(),
+         py::arg("variables_lower_bounds"), py::arg("variables_upper_bounds"), py::arg("constraints_lower_bounds"),
+         py::arg("constraints_upper_bounds"), py::arg("objective_sign") = UNO_MINIMIZE)
+      .def("set_objective", &PythonModel::set_objective, py::arg("objective_type"), py::arg("objective"), py::arg("gradient_indices"),
+         py::arg("objective_gradient"))
+      .def("set_constraints", &PythonModel::set_constraints, py::arg("constraints"), py::arg("jacobian_row_indices"),
+         py::arg("jacobian_column_indices"), py::arg("constraint_jacobian"), py::arg("constraint_types") = py::none())
+      .def("set_lagrangian_hessian", &PythonModel::set_lagrangian_hessian, py::arg("hessian_row_indices"), py::arg("hessian_column_indices"),
+         py::arg("lagrangian_hessian"))
+      .def("set_initial_point", &PythonModel::set_initial_point, py::arg("initial_primals"), py::arg("initial_multipliers") = py::none())
+      .def_property_readonly("number_variables", [](const PythonModel& model) { return model.model->number_variables; })
+      .def_property_readonly("number_constraints", [](const PythonModel& model) { return model.model->number_constraints; });
+
+   py::class_<Result>(python_module, "Result")
+      .def_readonly("optimization_status", &Result::optimization_status)
+      .def_property_readonly("solution_status", [](const Result& result) { return result.solution.status; })
+      .def_property_readonly("objective", [](const Result& result) { return result.solution.evaluations.objective; })
+      .def_property_readonly("primal_feasibility", [](const Result& result) { return result.solution.primal_feasibility; })
+      .def_property_readonly("primals", [](const py::object& self) {
+         const Result& result = self.cast<const Result&>();
+         return solution_view(self, result.solution.primals, result.number_variables);
+      })
+      .def_property_readonly("constraint_multipliers", [](const py::object& self) {
+         const Result& result = self.cast<const Result&>();
+         return solution_view(self, result.solution.multipliers.constraints, result.number_constraints);
+      })
+      .def_property_readonly("lower_bound_multipliers", [](const py::object& self) {
+         const Result& result = self.cast<const Result&>();
+         return solution_view(self, result.solution.multipliers.lower_bounds, result.number_variables);
+      })
+      .def_property_readonly("upper_bound_multipliers", [](const py::object& self) {
+         const Result& result = self.cast<const Result&>();
+         return solution_view(self, result.solution.multipliers.upper_bounds, result.number_variables);
+      })
+      .def_readonly("iterations", &Result::iteration)
+      .def_readonly("solve_time", &Result::solve_time)
+      .def_readonly("objective_evaluations", &Result::objective_evaluations)
+      .def_readonly("constraint_evaluations", &Result::constraint_evaluations)
+      .def_readonly("objective_gradient_evaluations", &Result::objective_gradient_evaluations)
+      .def_readonly("jacobian_evaluations", &Result::jacobian_evaluations)
+      .def_readonly("hessian_evaluations", &Result::hessian_evaluations)
+      .def_readonly("number_subproblems_solved", &Result::number_subproblems_solved);
+
+   py::class_<PythonSolver>(python_module, "Solver")
+      .def(py::init<>())
+      .def("set_option", [](PythonSolver& solver, const std::string& option_name, const std::string& option_value) {
+         solver.user_options[option_name] = option_value;
+      }, py::arg("option_name"), py::arg("option_value"))
+      .def("set_preset", [](PythonSolver& solver, const std::string& preset_name) {
+         solver.preset = preset_name;
+      }, py::arg("preset_name"))
+      // the model must outlive the solver, or the next call to solve
+      .def("solve", &PythonSolver::solve, py::arg("model"), py::keep_alive<1, 2>())
+      .def("resolve", &PythonSolver::resolve, py::arg("model"), py::keep_alive<1, 2>());
+}
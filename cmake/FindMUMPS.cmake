@@ -26,6 +26,12 @@ find_library(MUMPS_LIBRARY
   PATHS ${MUMPS_PKGCONF_LIBRARY_DIRS}
 )
 
+# single-precision arithmetic (optional)
+find_library(MUMPS_SINGLE_LIBRARY
+  NAMES libsmumps
+  PATHS ${MUMPS_PKGCONF_LIBRARY_DIRS}
+)
+
 find_library(MUMPS_COMMON_LIBRARY 
   NAMES libmumps_common
   PATHS ${MUMPS_PKGCONF_LIBRARY_DIRS}
@@ -0,0 +1,154 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "BatchSolver.hpp"
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "model/InstanceModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+
+namespace uno {
+   BatchSolver::BatchSolver(size_t number_threads): number_threads(number_threads) { }
+
+   void BatchSolver::solve(const std::vector<const Model*>& instances, const Options& options) {
+      BatchSolver::check_structure(instances);
+      BatchSolver::check_options(options);
+      const size_t number_instances = instances.size();
+      this->results = std::vector<std::optional<Result>>(number_instances);
+      this->exceptions = std::vector<std::exception_ptr>(number_instances);
+      if (number_instances == 0) {
+         return;
+      }
+
+      // the options are not shared: reading an option marks it as used, which is not thread-safe. The logs of concurrent solves
+      // would interleave
+      const size_t number_workers = this->determine_number_threads(instances);
+      std::vector<Options> options_per_worker(number_workers, options);
+      for (Options& worker_options: options_per_worker) {
+         worker_options["logger"] = "SILENT";
+         worker_options["checkpoint_file"] = "";
+      }
+
+      std::atomic<size_t> next_instance{0};
+      const auto solve_instances = [&](size_t worker_index) {
+         const Options& worker_options = options_per_worker[worker_index];
+         const Logger::Scope logger_scope(worker_options.get_string("logger"));
+         size_t instance_index = next_instance++;
+         if (number_instances <= instance_index) {
+            return;
+         }
+         // the strategies and the solver are created once for the view, then reused for each instance
+         InstanceModel model(*instances[instance_index]);
+         std::unique_ptr<ConstraintRelaxationStrategy> constraint_relaxation_strategy{};
+         std::unique_ptr<GlobalizationMechanism> globalization_mechanism{};
+         std::unique_ptr<Uno> uno{};
+         try {
+            constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(model, worker_options);
+            globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, worker_options);
+            uno = std::make_unique<Uno>(*globalization_mechanism, worker_options);
+         }
+         catch (...) {
+            // the setup failed: none of the instances of this worker can be solved
+            this->exceptions[instance_index] = std::current_exception();
+            return;
+         }
+         Iterate initial_iterate(model.number_variables, model.number_constraints);
+         do {
+            try {
+               model.set_instance(*instances[instance_index]);
+               initial_iterate.reset(model.number_variables, model.number_constraints);
+               model.initial_primal_point(initial_iterate.primals);
+               model.project_onto_variable_bounds(initial_iterate.primals);
+               model.initial_dual_point(initial_iterate.multipliers.constraints);
+               initial_iterate.feasibility_multipliers.reset();
+               // the first call is a solve
+               this->results[instance_index].emplace(uno->resolve(model, initial_iterate, worker_options));
+            }
+            catch (...) {
+               this->exceptions[instance_index] = std::current_exception();
+            }
+         } while ((instance_index = next_instance++) < number_instances);
+      };
+      // the calling thread is one of the workers, which run on the installed thread pool (if any)
+      run_workers(number_workers, solve_instances);
+   }
+
+   size_t BatchSolver::number_instances() const {
+      return this->results.size();
+   }
+
+   const std::optional<Result>& BatchSolver::get_result(size_t instance_index) const {
+      return this->results[instance_index];
+   }
+
+   const std::exception_ptr& BatchSolver::get_exception(size_t instance_index) const {
+      return this->exceptions[instance_index];
+   }
+
+   void BatchSolver::check_structure(const std::vector<const Model*>& instances) {
+      if (instances.empty()) {
+         return;
+      }
+      const Model& reference = *instances[0];
+      for (size_t instance_index: Range(1, instances.size())) {
+         const Model& instance = *instances[instance_index];
+         bool is_identical = (instance.number_variables == reference.number_variables &&
+               instance.number_constraints == reference.number_constraints &&
+               instance.objective_sign == reference.objective_sign &&
+               instance.number_objective_gradient_nonzeros() == reference.number_objective_gradient_nonzeros() &&
+               instance.number_jacobian_nonzeros() == reference.number_jacobian_nonzeros() &&
+               instance.number_hessian_nonzeros() == reference.number_hessian_nonzeros() &&
+               instance.get_objective_type() == reference.get_objective_type());
+         for (size_t constraint_index: Range(reference.number_constraints)) {
+            is_identical = is_identical && (instance.get_constraint_type(constraint_index) == reference.get_constraint_type(constraint_index));
+         }
+         if (!is_identical) {
+            throw std::invalid_argument("BatchSolver: the instance " + std::to_string(instance_index) +
+               " does not have the structure of the first instance");
+         }
+      }
+   }
+
+   void BatchSolver::check_options(const Options& options) {
+      const std::string& subproblem = options.get_string("subproblem");
+      if (subproblem == "primal_dual_interior_point" || subproblem == "interior_point_crossover") {
+         throw std::invalid_argument("BatchSolver: the interior-point subproblems require a reformulation of the instances");
+      }
+      if (options.get_string("hessian_model") != "exact") {
+         throw std::invalid_argument("BatchSolver: the quasi-Newton Hessian models are not supported");
+      }
+      if (options.get_bool("scale_functions") || options.get_string("scale_variables") != "none" ||
+            options.get_bool("presolve_linear_constraints") || options.get_bool("eliminate_fixed_variables")) {
+         throw std::invalid_argument("BatchSolver: the scaling and the presolve are not supported");
+      }
+   }
+
+   size_t BatchSolver::determine_number_threads(const std::vector<const Model*>& instances) const {
+      // the instances may share data (e.g. an interface to a modeling language): they are solved concurrently only if they all
+      // support concurrent evaluations
+      const bool supports_concurrency = std::all_of(instances.begin(), instances.end(), [](const Model* instance) {
+         return instance->supports_concurrent_evaluations();
+      });
+      if (!supports_concurrency) {
+         if (this->number_threads != 1 && 1 < instances.size()) {
+            WARNING << "The instances do not support concurrent evaluations: they are solved sequentially\n";
+         }
+         return 1;
+      }
+      // 0: the threads of the installed pool, or the hardware threads
+      const size_t requested_threads = (this->number_threads == 0) ? ThreadPool::available_threads() : this->number_threads;
+      return std::min(requested_threads, instances.size());
+   }
+} // namespace
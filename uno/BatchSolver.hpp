@@ -0,0 +1,48 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BATCHSOLVER_H
+#define UNO_BATCHSOLVER_H
+
+#include <exception>
+#include <optional>
+#include <vector>
+#include "optimization/Result.hpp"
+
+namespace uno {
+   // forward declarations
+   class Model;
+   class Options;
+
+   /*! \class BatchSolver
+    * \brief Solves of a batch of instances with identical structure
+    *
+    *  The instances (e.g. the MPC problems of a horizon with different initial states) must have the same dimensions, sparsity
+    *  patterns and function types. Each thread creates the strategies and the solver once, then re-solves them for each instance
+    *  it pulls: the setup (allocations, symbolic analyses) is paid once per thread instead of once per instance, and each instance
+    *  terminates independently. The instances are solved from their own initial points. The reformulations of ModelFactory derive
+    *  data from the values of the model and are not applied; the options that require them are rejected
+    */
+   class BatchSolver {
+   public:
+      explicit BatchSolver(size_t number_threads);
+
+      void solve(const std::vector<const Model*>& instances, const Options& options);
+      [[nodiscard]] size_t number_instances() const;
+      // empty if the solve of the instance failed
+      [[nodiscard]] const std::optional<Result>& get_result(size_t instance_index) const;
+      [[nodiscard]] const std::exception_ptr& get_exception(size_t instance_index) const;
+
+      static void check_structure(const std::vector<const Model*>& instances);
+      static void check_options(const Options& options);
+
+   private:
+      const size_t number_threads; /*!< 0: number of hardware threads */
+      std::vector<std::optional<Result>> results{};
+      std::vector<std::exception_ptr> exceptions{};
+
+      [[nodiscard]] size_t determine_number_threads(const std::vector<const Model*>& instances) const;
+   };
+} // namespace
+
+#endif // UNO_BATCHSOLVER_H
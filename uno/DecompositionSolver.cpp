@@ -0,0 +1,177 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include "DecompositionSolver.hpp"
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/ComponentModel.hpp"
+#include "model/ModelDecomposition.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+#include "tools/Timer.hpp"
+
+namespace uno {
+   DecompositionSolver::DecompositionSolver(const Options& options):
+         number_threads(options.get_unsigned_int("decomposition_threads")),
+         minimum_component_size(options.get_unsigned_int("decomposition_min_component_size")) {
+   }
+
+   Result DecompositionSolver::solve(const Model& model, const Options& options) {
+      const Logger::Scope logger_scope(options.get_string("logger"));
+      Timer timer{};
+      // the variables outside a component keep their values at the reference point
+      Vector<double> reference_point(model.number_variables);
+      model.initial_primal_point(reference_point);
+      model.project_onto_variable_bounds(reference_point);
+      const ModelDecomposition decomposition = ModelFactory::decompose(model, reference_point, this->minimum_component_size);
+      const size_t number_components = decomposition.number_components();
+      this->results = std::vector<std::optional<Result>>(number_components);
+      this->exceptions = std::vector<std::exception_ptr>(number_components);
+      DISCRETE << "Decomposition of " << model.name << " into " << number_components << " independent components\n";
+
+      // the options are not shared: reading an option marks it as used, which is not thread-safe. The logs of concurrent solves
+      // would interleave, and their checkpoints would overwrite each other
+      const size_t number_workers = this->determine_number_threads(model, number_components);
+      std::vector<Options> options_per_worker(number_workers, options);
+      for (Options& worker_options: options_per_worker) {
+         worker_options["logger"] = "SILENT";
+         worker_options["checkpoint_file"] = "";
+      }
+
+      std::atomic<size_t> next_component{0};
+      const auto solve_components = [&](size_t worker_index) {
+         const Options& worker_options = options_per_worker[worker_index];
+         const Logger::Scope worker_logger_scope(worker_options.get_string("logger"));
+         size_t component_index;
+         while ((component_index = next_component++) < number_components) {
+            try {
+               // the view and its workspaces only live during the solve of the component
+               std::unique_ptr<Model> component_model = ModelFactory::reformulate(
+                     std::make_unique<ComponentModel>(model, decomposition, component_index, reference_point), worker_options);
+
+               Iterate initial_iterate(component_model->number_variables, component_model->number_constraints);
+               component_model->initial_primal_point(initial_iterate.primals);
+               component_model->project_onto_variable_bounds(initial_iterate.primals);
+               component_model->initial_dual_point(initial_iterate.multipliers.constraints);
+               initial_iterate.feasibility_multipliers.reset();
+
+               auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*component_model, worker_options);
+               auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, worker_options);
+               Uno uno(*globalization_mechanism, worker_options);
+               this->results[component_index].emplace(uno.solve(*component_model, initial_iterate, worker_options));
+            }
+            catch (...) {
+               this->exceptions[component_index] = std::current_exception();
+            }
+         }
+      };
+      // the calling thread is one of the workers, which run on the installed thread pool (if any)
+      run_workers(number_workers, solve_components);
+      for (const std::exception_ptr& exception: this->exceptions) {
+         if (exception != nullptr) {
+            std::rethrow_exception(exception);
+         }
+      }
+
+      Result result = this->merge_results(model, decomposition, options, timer.get_duration());
+      DISCRETE << "\nUno " << Uno::current_version() << " (" << Uno::get_strategy_combination(options) << ")\n";
+      DISCRETE << "Decomposition: " << number_components << " components\n";
+      DISCRETE << Timer::get_current_date();
+      DISCRETE << "────────────────────────────────────────\n";
+      result.print(options.get_bool("print_solution"));
+      return result;
+   }
+
+   size_t DecompositionSolver::get_number_components() const {
+      return this->results.size();
+   }
+
+   const std::optional<Result>& DecompositionSolver::get_component_result(size_t component_index) const {
+      return this->results[component_index];
+   }
+
+   size_t DecompositionSolver::determine_number_threads(const Model& model, size_t number_components) const {
+      if (!model.supports_concurrent_evaluations()) {
+         if (this->number_threads != 1 && 1 < number_components) {
+            WARNING << "The model does not support concurrent evaluations: the components are solved sequentially\n";
+         }
+         return 1;
+      }
+      // 0: the threads of the installed pool, or the hardware threads
+      const size_t requested_threads = (this->number_threads == 0) ? ThreadPool::available_threads() : this->number_threads;
+      return std::min(requested_threads, number_components);
+   }
+
+   Result DecompositionSolver::merge_results(const Model& model, const ModelDecomposition& decomposition, const Options& options,
+         double solve_time) {
+      Iterate solution(model.number_variables, model.number_constraints);
+      solution.status = IterateStatus::FEASIBLE_KKT_POINT;
+      solution.residuals.stationarity = 0.;
+      solution.residuals.complementarity = 0.;
+      solution.progress.infeasibility = 0.;
+      solution.progress.auxiliary = 0.;
+      OptimizationStatus optimization_status = OptimizationStatus::SUCCESS;
+      Result result{optimization_status, Iterate(0, 0), model.number_variables, model.number_constraints, 0, solve_time, 0, 0, 0, 0, 0,
+         0, 0, 0, 0, 0, {}};
+      for (size_t component_index: Range(decomposition.number_components())) {
+         const Result& component_result = *this->results[component_index];
+         const Iterate& component_solution = component_result.solution;
+         const std::vector<size_t>& variables = decomposition.variables[component_index];
+         const std::vector<size_t>& constraints = decomposition.constraints[component_index];
+         for (size_t variable_index: Range(variables.size())) {
+            solution.primals[variables[variable_index]] = component_solution.primals[variable_index];
+            solution.multipliers.lower_bounds[variables[variable_index]] = component_solution.multipliers.lower_bounds[variable_index];
+            solution.multipliers.upper_bounds[variables[variable_index]] = component_solution.multipliers.upper_bounds[variable_index];
+         }
+         for (size_t constraint_index: Range(constraints.size())) {
+            solution.multipliers.constraints[constraints[constraint_index]] = component_solution.multipliers.constraints[constraint_index];
+         }
+         // the components are independent: the dual residuals of the merged solution are those of the worst component
+         solution.residuals.stationarity = std::max(solution.residuals.stationarity, component_solution.residuals.stationarity);
+         solution.residuals.complementarity = std::max(solution.residuals.complementarity, component_solution.residuals.complementarity);
+         solution.progress.infeasibility += component_solution.progress.infeasibility;
+         solution.progress.auxiliary += component_solution.progress.auxiliary;
+         if (solution.status == IterateStatus::FEASIBLE_KKT_POINT && component_solution.status != IterateStatus::FEASIBLE_KKT_POINT) {
+            solution.status = component_solution.status;
+            solution.objective_multiplier = component_solution.objective_multiplier;
+         }
+         if (optimization_status == OptimizationStatus::SUCCESS) {
+            optimization_status = component_result.optimization_status;
+         }
+         // the components are solved concurrently
+         result.iteration = std::max(result.iteration, component_result.iteration);
+         result.objective_evaluations += component_result.objective_evaluations;
+         result.constraint_evaluations += component_result.constraint_evaluations;
+         result.objective_gradient_evaluations += component_result.objective_gradient_evaluations;
+         result.jacobian_evaluations += component_result.jacobian_evaluations;
+         result.hessian_evaluations += component_result.hessian_evaluations;
+         result.number_subproblems_solved += component_result.number_subproblems_solved;
+         result.number_factorizations += component_result.number_factorizations;
+         result.peak_subproblem_workspace_size = std::max(result.peak_subproblem_workspace_size, component_result.peak_subproblem_workspace_size);
+         result.evaluation_cache_hits += component_result.evaluation_cache_hits;
+         result.evaluation_cache_misses += component_result.evaluation_cache_misses;
+         result.factorization_statistics.accumulate(component_result.factorization_statistics);
+      }
+      // the objective of the model is the sum of the objectives of the components
+      solution.evaluate_objective(model);
+      solution.evaluate_constraints(model);
+      solution.progress.objective = ObjectiveMeasure::scaled(solution.evaluations.objective);
+      solution.primal_feasibility = model.constraint_violation(solution.evaluations.constraints,
+            norm_from_string(options.get_string("residual_norm")));
+      model.postprocess_solution(solution, solution.status);
+      result.optimization_status = optimization_status;
+      result.solution = std::move(solution);
+      return result;
+   }
+} // namespace
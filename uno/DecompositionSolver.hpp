@@ -0,0 +1,50 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DECOMPOSITIONSOLVER_H
+#define UNO_DECOMPOSITIONSOLVER_H
+
+#include <exception>
+#include <optional>
+#include <vector>
+#include "optimization/Result.hpp"
+
+namespace uno {
+   // forward declarations
+   class Model;
+   class ModelDecomposition;
+   class Options;
+
+   /*! \class DecompositionSolver
+    * \brief Concurrent solves of the independent components of a model
+    *
+    *  The model is decomposed into independent components (see ModelFactory::decompose), e.g. the scenarios of a batch-generated
+    *  model. The threads pull the components in order; each component is a ComponentModel view with its own reformulation,
+    *  strategies and solver, created when the component is solved. The primal-dual solutions of the components are merged and
+    *  postprocessed by the original model
+    */
+   class DecompositionSolver {
+   public:
+      explicit DecompositionSolver(const Options& options);
+
+      // the merged solution is a KKT point if all the components reached a KKT point. Otherwise, its status is that of the first
+      // component that did not. Its evaluation counts and solve time are those of the whole decomposition; its number of iterations
+      // is the largest number of iterations of the components
+      Result solve(const Model& model, const Options& options);
+      [[nodiscard]] size_t get_number_components() const;
+      // empty if the solve of the component failed
+      [[nodiscard]] const std::optional<Result>& get_component_result(size_t component_index) const;
+
+   private:
+      const size_t number_threads; /*!< 0: number of hardware threads */
+      const size_t minimum_component_size;
+      std::vector<std::optional<Result>> results{};
+      std::vector<std::exception_ptr> exceptions{};
+
+      [[nodiscard]] size_t determine_number_threads(const Model& model, size_t number_components) const;
+      [[nodiscard]] Result merge_results(const Model& model, const ModelDecomposition& decomposition, const Options& options,
+            double solve_time);
+   };
+} // namespace
+
+#endif // UNO_DECOMPOSITIONSOLVER_H
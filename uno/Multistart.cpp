@@ -0,0 +1,111 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include "Multistart.hpp"
+#include "ParallelSolver.hpp"
+#include "Uno.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/Model.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Timer.hpp"
+
+namespace uno {
+   Multistart::Multistart(const Options& options):
+         number_starts(options.get_unsigned_int("multistart_starts")),
+         number_threads(options.get_unsigned_int("multistart_threads")),
+         method(options.get_string("multistart_method")),
+         radius(options.get_double("multistart_radius")),
+         seed(options.get_unsigned_int("multistart_seed")),
+         target_objective(options.get_double("multistart_target_objective")) {
+      if (this->number_starts == 0) {
+         throw std::invalid_argument("The number of multistart starts should be positive");
+      }
+      if (this->method != "perturbation" && this->method != "latin_hypercube") {
+         throw std::invalid_argument("The multistart method " + this->method + " does not exist");
+      }
+   }
+
+   Result Multistart::solve(const Model& model, const Options& options) {
+      const Logger::Scope logger_scope(options.get_string("logger"));
+      Timer timer{};
+      const auto reaches_target = [&](const Result& result) {
+         return result.solution.status == IterateStatus::FEASIBLE_KKT_POINT && result.solution.evaluations.objective <= this->target_objective;
+      };
+      ParallelSolver parallel_solver(this->number_threads);
+      parallel_solver.solve(model, this->generate_starting_points(model), std::vector<Options>(this->number_starts, options), reaches_target);
+      for (size_t start_index: Range(this->number_starts)) {
+         if (parallel_solver.get_exception(start_index) != nullptr) {
+            std::rethrow_exception(parallel_solver.get_exception(start_index));
+         }
+         const std::optional<Result>& result = parallel_solver.get_result(start_index);
+         if (result.has_value()) {
+            DISCRETE << "Start " << start_index << ": " << optimization_status_to_message(result->optimization_status) << ", " <<
+               iterate_status_to_message(result->solution.status) << ", objective " << result->solution.evaluations.objective << ", " <<
+               result->iteration << " iterations\n";
+         }
+      }
+      // start 0 is always solved
+      this->best_start = *parallel_solver.get_best_run();
+      Result result = parallel_solver.extract_result(this->best_start, timer.get_duration());
+
+      DISCRETE << "\nUno " << Uno::current_version() << " (" << Uno::get_strategy_combination(options) << ")\n";
+      DISCRETE << "Multistart: best start " << this->best_start << " out of " << this->number_starts << '\n';
+      DISCRETE << Timer::get_current_date();
+      DISCRETE << "────────────────────────────────────────\n";
+      result.print(options.get_bool("print_solution"));
+      return result;
+   }
+
+   size_t Multistart::get_best_start() const {
+      return this->best_start;
+   }
+
+   // start 0 is the initial point of the model. The other starts are sampled in an interval around the initial point (perturbation)
+   // or in the bound box whose infinite bounds are replaced by this interval (Latin hypercube)
+   std::vector<Vector<double>> Multistart::generate_starting_points(const Model& model) const {
+      std::vector<Vector<double>> starting_points(this->number_starts, Vector<double>(model.number_variables));
+      Vector<double>& initial_point = starting_points[0];
+      model.initial_primal_point(initial_point);
+      model.project_onto_variable_bounds(initial_point);
+
+      std::mt19937_64 generator(this->seed);
+      std::uniform_real_distribution<double> distribution(0., 1.);
+      const size_t number_sampled_starts = this->number_starts - 1;
+      std::vector<size_t> strata(number_sampled_starts);
+      for (size_t variable_index: Range(model.number_variables)) {
+         const double lower_bound = model.variable_lower_bound(variable_index);
+         const double upper_bound = model.variable_upper_bound(variable_index);
+         const double initial_value = initial_point[variable_index];
+         const double half_width = this->radius * std::max(1., std::abs(initial_value));
+         double lower_end, upper_end;
+         if (this->method == "perturbation") {
+            lower_end = std::max(lower_bound, initial_value - half_width);
+            upper_end = std::min(upper_bound, initial_value + half_width);
+         }
+         else {
+            lower_end = std::isfinite(lower_bound) ? lower_bound : std::min(upper_bound, initial_value) - half_width;
+            upper_end = std::isfinite(upper_bound) ? upper_bound : std::max(lower_bound, initial_value) + half_width;
+            // each start lies in a different stratum of each variable
+            std::iota(strata.begin(), strata.end(), size_t(0));
+            std::shuffle(strata.begin(), strata.end(), generator);
+         }
+         for (size_t start_index: Range(1, this->number_starts)) {
+            double position = distribution(generator);
+            if (this->method == "latin_hypercube") {
+               position = (static_cast<double>(strata[start_index - 1]) + position) / static_cast<double>(number_sampled_starts);
+            }
+            starting_points[start_index][variable_index] = lower_end + position * (upper_end - lower_end);
+         }
+      }
+      return starting_points;
+   }
+} // namespace
@@ -0,0 +1,49 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MULTISTART_H
+#define UNO_MULTISTART_H
+
+#include <string>
+#include <vector>
+#include "optimization/Result.hpp"
+
+namespace uno {
+   // forward declarations
+   class Model;
+   class Options;
+   template <typename ElementType>
+   class Vector;
+
+   /*! \class Multistart
+    * \brief Multistart driver
+    *
+    *  Solves a model from several starting points on a pool of threads and returns the best result. Start 0 is the initial point
+    *  of the model, the others are random perturbations of it or a Latin hypercube sample of the (possibly truncated) bound box.
+    *  The model is shared by the starts and is only read; each start has its own reformulation, strategies and solver.
+    *  Once a start reaches a KKT point whose objective is below the target, the pending starts are skipped and the running
+    *  starts are terminated
+    */
+   class Multistart {
+   public:
+      explicit Multistart(const Options& options);
+
+      // the best result is a KKT point with the lowest objective or, if no start reached a KKT point, the least infeasible
+      // solution. Its evaluation counts and solve time are those of the whole multistart
+      Result solve(const Model& model, const Options& options);
+      [[nodiscard]] size_t get_best_start() const;
+
+   private:
+      const size_t number_starts;
+      const size_t number_threads; /*!< 0: number of hardware threads */
+      const std::string method;
+      const double radius;
+      const size_t seed;
+      const double target_objective;
+      size_t best_start{0};
+
+      [[nodiscard]] std::vector<Vector<double>> generate_starting_points(const Model& model) const;
+   };
+} // namespace
+
+#endif // UNO_MULTISTART_H
@@ -0,0 +1,197 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include "ParallelSolver.hpp"
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/ModelFactory.hpp"
+#include "model/SharedModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+#include "tools/Timeline.hpp"
+
+namespace uno {
+   namespace {
+      // KKT points are better than the other solutions, then the objective (KKT points) or the infeasibility (other solutions) decides
+      bool is_better(const Result& candidate, const Result& incumbent) {
+         const bool is_candidate_kkt_point = (candidate.solution.status == IterateStatus::FEASIBLE_KKT_POINT);
+         const bool is_incumbent_kkt_point = (incumbent.solution.status == IterateStatus::FEASIBLE_KKT_POINT);
+         if (is_candidate_kkt_point != is_incumbent_kkt_point) {
+            return is_candidate_kkt_point;
+         }
+         else if (is_candidate_kkt_point) {
+            return candidate.solution.evaluations.objective < incumbent.solution.evaluations.objective;
+         }
+         return candidate.solution.primal_feasibility < incumbent.solution.primal_feasibility;
+      }
+   } // namespace
+
+   ParallelSolver::ParallelSolver(size_t number_threads): number_threads(number_threads) { }
+
+   ParallelSolver::~ParallelSolver() = default;
+
+   void ParallelSolver::solve(const Model& model, std::vector<Vector<double>> starting_points, std::vector<Options> options_per_run,
+         const std::function<bool(const Result&)>& is_satisfactory) {
+      if (starting_points.size() != options_per_run.size()) {
+         throw std::invalid_argument("ParallelSolver: each run should have a starting point and options");
+      }
+      const size_t number_runs = starting_points.size();
+      this->runs = std::vector<Run>(number_runs);
+      // the runs share the timeline of the first run (one track per thread)
+      const std::string timeline_file = options_per_run.empty() ? "" : options_per_run[0].get_string("timeline_file");
+      const bool deterministic = !options_per_run.empty() && options_per_run[0].get_bool("deterministic");
+      std::optional<Timeline> timeline{};
+      if (!timeline_file.empty()) {
+         timeline.emplace();
+      }
+      // the logs of concurrent runs would interleave, and their checkpoints would overwrite each other
+      for (Options& run_options: options_per_run) {
+         run_options["logger"] = "SILENT";
+         run_options["checkpoint_file"] = "";
+      }
+
+      std::atomic<size_t> next_run{0};
+      // terminates the running solves once a result is satisfactory. In deterministic mode, each run has its own token and only the
+      // runs after the first satisfactory run (in the order of the runs) are terminated: the runs before it are completed, whatever
+      // the thread timings
+      std::vector<CancellationToken> cancellation_tokens(deterministic ? number_runs : 1);
+      std::atomic<size_t> first_satisfactory_run{number_runs};
+      const auto is_terminated = [&](size_t run_index) {
+         return deterministic ? (first_satisfactory_run.load() < run_index) : cancellation_tokens[0].is_cancelled();
+      };
+      const auto terminate_runs_after = [&](size_t run_index) {
+         if (deterministic) {
+            size_t current_first_run = first_satisfactory_run.load();
+            while (run_index < current_first_run && !first_satisfactory_run.compare_exchange_weak(current_first_run, run_index)) { }
+            for (size_t other_run_index: Range(run_index + 1, number_runs)) {
+               cancellation_tokens[other_run_index].cancel();
+            }
+         }
+         else {
+            cancellation_tokens[0].cancel();
+         }
+      };
+      // the options are not shared: reading an option marks it as used, which is not thread-safe
+      const auto solve_runs = [&](size_t /*worker_index*/) {
+         const Timeline::Scope timeline_scope(timeline.has_value() ? &*timeline : nullptr);
+         size_t run_index;
+         while ((run_index = next_run++) < number_runs && !is_terminated(run_index)) {
+            Run& run = this->runs[run_index];
+            try {
+               const Options& run_options = options_per_run[run_index];
+               const Logger::Scope logger_scope(run_options.get_string("logger"));
+               auto shared_model = std::make_unique<SharedModel>(model, std::move(starting_points[run_index]));
+               run.shared_model = shared_model.get();
+               run.model = ModelFactory::reformulate(std::move(shared_model), run_options);
+
+               Iterate initial_iterate(run.model->number_variables, run.model->number_constraints);
+               run.model->initial_primal_point(initial_iterate.primals);
+               run.model->project_onto_variable_bounds(initial_iterate.primals);
+               run.model->initial_dual_point(initial_iterate.multipliers.constraints);
+               initial_iterate.feasibility_multipliers.reset();
+
+               auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*run.model, run_options);
+               auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, run_options);
+               Uno uno(*globalization_mechanism, run_options);
+               uno.set_cancellation_token(&cancellation_tokens[deterministic ? run_index : 0]);
+               run.result.emplace(uno.solve(*run.model, initial_iterate, run_options));
+               if (is_satisfactory(*run.result)) {
+                  terminate_runs_after(run_index);
+               }
+            }
+            catch (...) {
+               run.exception = std::current_exception();
+            }
+         }
+      };
+      // the calling thread is one of the workers, which run on the installed thread pool (if any)
+      const size_t number_workers = this->determine_number_threads(model, number_runs);
+      run_workers(number_workers, solve_runs);
+      // the runs after the first satisfactory run may or may not have started, depending on the thread timings: they are discarded
+      if (deterministic) {
+         for (size_t run_index: Range(std::min(first_satisfactory_run.load() + 1, number_runs), number_runs)) {
+            this->runs[run_index].result.reset();
+            this->runs[run_index].exception = nullptr;
+         }
+      }
+      if (timeline.has_value()) {
+         timeline->write(timeline_file);
+      }
+   }
+
+   size_t ParallelSolver::number_runs() const {
+      return this->runs.size();
+   }
+
+   const std::optional<Result>& ParallelSolver::get_result(size_t run_index) const {
+      return this->runs[run_index].result;
+   }
+
+   const std::exception_ptr& ParallelSolver::get_exception(size_t run_index) const {
+      return this->runs[run_index].exception;
+   }
+
+   std::optional<size_t> ParallelSolver::get_best_run() const {
+      std::optional<size_t> best_run{};
+      for (size_t run_index: Range(this->runs.size())) {
+         const std::optional<Result>& result = this->runs[run_index].result;
+         if (result.has_value() && (!best_run.has_value() || is_better(*result, *this->runs[*best_run].result))) {
+            best_run = run_index;
+         }
+      }
+      return best_run;
+   }
+
+   Result ParallelSolver::extract_result(size_t run_index, double solve_time) {
+      Run& run = this->runs[run_index];
+      if (!run.result.has_value()) {
+         throw std::runtime_error("ParallelSolver: the run " + std::to_string(run_index) + " has no result");
+      }
+      Result result = std::move(*run.result);
+      run.result.reset();
+      result.solve_time = solve_time;
+      for (const Run& other_run: this->runs) {
+         if (other_run.result.has_value()) {
+            result.objective_evaluations += other_run.result->objective_evaluations;
+            result.constraint_evaluations += other_run.result->constraint_evaluations;
+            result.objective_gradient_evaluations += other_run.result->objective_gradient_evaluations;
+            result.jacobian_evaluations += other_run.result->jacobian_evaluations;
+            result.hessian_evaluations += other_run.result->hessian_evaluations;
+            result.number_subproblems_solved += other_run.result->number_subproblems_solved;
+            result.number_factorizations += other_run.result->number_factorizations;
+            result.peak_subproblem_workspace_size = std::max(result.peak_subproblem_workspace_size,
+                  other_run.result->peak_subproblem_workspace_size);
+            result.evaluation_cache_hits += other_run.result->evaluation_cache_hits;
+            result.evaluation_cache_misses += other_run.result->evaluation_cache_misses;
+            result.factorization_statistics.accumulate(other_run.result->factorization_statistics);
+         }
+      }
+      // only the extracted solution is postprocessed by the original model
+      run.shared_model->enable_postprocessing();
+      run.model->postprocess_solution(result.solution, result.solution.status);
+      return result;
+   }
+
+   size_t ParallelSolver::determine_number_threads(const Model& model, size_t number_runs) const {
+      if (!model.supports_concurrent_evaluations()) {
+         if (this->number_threads != 1 && 1 < number_runs) {
+            WARNING << "The model does not support concurrent evaluations: the runs are solved sequentially\n";
+         }
+         return 1;
+      }
+      // 0: the threads of the installed pool, or the hardware threads
+      const size_t requested_threads = (this->number_threads == 0) ? ThreadPool::available_threads() : this->number_threads;
+      return std::min(requested_threads, number_runs);
+   }
+} // namespace
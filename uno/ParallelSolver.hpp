@@ -0,0 +1,62 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PARALLELSOLVER_H
+#define UNO_PARALLELSOLVER_H
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+
+namespace uno {
+   // forward declarations
+   class Model;
+   class SharedModel;
+   template <typename ElementType>
+   class Vector;
+
+   /*! \class ParallelSolver
+    * \brief Independent solves of a shared model on a pool of threads
+    *
+    *  Each run solves the model from its own starting point with its own options, and has its own reformulation, strategies and
+    *  solver; the model is shared and only read. The threads pull the runs in order. Once a result is satisfactory, the pending
+    *  runs are skipped and the running ones are terminated. With the option deterministic, only the runs after the first
+    *  satisfactory run are skipped or terminated (and discarded), so that the results do not depend on the thread timings. Models
+    *  that do not support concurrent evaluations are solved on a single thread
+    */
+   class ParallelSolver {
+   public:
+      explicit ParallelSolver(size_t number_threads);
+      ~ParallelSolver();
+
+      void solve(const Model& model, std::vector<Vector<double>> starting_points, std::vector<Options> options_per_run,
+            const std::function<bool(const Result&)>& is_satisfactory);
+      [[nodiscard]] size_t number_runs() const;
+      // empty if the run was skipped or failed
+      [[nodiscard]] const std::optional<Result>& get_result(size_t run_index) const;
+      [[nodiscard]] const std::exception_ptr& get_exception(size_t run_index) const;
+      // KKT point with the lowest objective or, if no run reached a KKT point, the least infeasible solution
+      [[nodiscard]] std::optional<size_t> get_best_run() const;
+      // result of a run, with the cost (evaluations, subproblems) of all the runs. The solution is postprocessed by the original model
+      [[nodiscard]] Result extract_result(size_t run_index, double solve_time);
+
+   private:
+      struct Run {
+         std::unique_ptr<Model> model{}; // reformulation of the shared model
+         SharedModel* shared_model{nullptr};
+         std::optional<Result> result{};
+         std::exception_ptr exception{};
+      };
+
+      const size_t number_threads; /*!< 0: number of hardware threads */
+      std::vector<Run> runs{};
+
+      [[nodiscard]] size_t determine_number_threads(const Model& model, size_t number_runs) const;
+   };
+} // namespace
+
+#endif // UNO_PARALLELSOLVER_H
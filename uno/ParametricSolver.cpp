@@ -0,0 +1,152 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "ParametricSolver.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "model/ModelFactory.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/UserCallbacks.hpp"
+
+namespace uno {
+   namespace {
+      // forwards the notifications to the callbacks of the caller and records the last iterate. The iterates are those of the
+      // reformulated model, before the solution is postprocessed (unscaled, reordered, ...) for the original model
+      class LastIterateRecorder: public UserCallbacks {
+      public:
+         LastIterateRecorder(UserCallbacks& user_callbacks, Vector<double>& primals, Multipliers& multipliers):
+               UserCallbacks(), user_callbacks(user_callbacks), primals(primals), multipliers(multipliers) { }
+
+         void notify_acceptable_iterate(const Vector<double>& primals, const Multipliers& multipliers, double objective_multiplier) override {
+            this->user_callbacks.notify_acceptable_iterate(primals, multipliers, objective_multiplier);
+         }
+         // the buffers are allocated before the solve
+         void notify_new_primals(const Vector<double>& primals) override {
+            for (size_t variable_index: Range(this->primals.size())) {
+               this->primals[variable_index] = primals[variable_index];
+            }
+            this->has_recorded = true;
+            this->user_callbacks.notify_new_primals(primals);
+         }
+         void notify_new_multipliers(const Multipliers& multipliers) override {
+            for (size_t variable_index: Range(this->multipliers.lower_bounds.size())) {
+               this->multipliers.lower_bounds[variable_index] = multipliers.lower_bounds[variable_index];
+               this->multipliers.upper_bounds[variable_index] = multipliers.upper_bounds[variable_index];
+            }
+            for (size_t constraint_index: Range(this->multipliers.constraints.size())) {
+               this->multipliers.constraints[constraint_index] = multipliers.constraints[constraint_index];
+            }
+            this->user_callbacks.notify_new_multipliers(multipliers);
+         }
+         [[nodiscard]] bool should_terminate() override { return this->user_callbacks.should_terminate(); }
+
+         bool has_recorded{false};
+
+      protected:
+         UserCallbacks& user_callbacks;
+         Vector<double>& primals;
+         Multipliers& multipliers;
+      };
+   } // namespace
+
+   ParametricSolver::ParametricSolver(std::unique_ptr<Model> original_model, const Options& options):
+         options(options),
+         model(ParametricSolver::reformulate(std::move(original_model), this->options, this->editable_model)),
+         constraint_relaxation_strategy(ConstraintRelaxationStrategyFactory::create(*this->model, this->options)),
+         globalization_mechanism(GlobalizationMechanismFactory::create(*this->constraint_relaxation_strategy, this->options)),
+         uno(*this->globalization_mechanism, this->options),
+         initial_iterate(this->model->number_variables, this->model->number_constraints),
+         previous_primals(this->model->number_variables),
+         previous_multipliers(this->model->number_variables, this->model->number_constraints) {
+   }
+
+   ParametricSolver::~ParametricSolver() = default;
+
+   // the editable model is the innermost model of the stack of reformulations
+   std::unique_ptr<Model> ParametricSolver::reformulate(std::unique_ptr<Model> original_model, const Options& options,
+         EditableModel*& editable_model) {
+      auto new_editable_model = std::make_unique<EditableModel>(std::move(original_model), 0, 0);
+      editable_model = new_editable_model.get();
+      return ModelFactory::reformulate(std::move(new_editable_model), options);
+   }
+
+   // the bound types that determine the reformulations (fixed variables, equality constraints) are checked before any change
+   void ParametricSolver::update_parameters(const ParameterUpdate& update) {
+      EditableModel& edits = *this->editable_model;
+      for (const BoundChange& bound_change: update.variable_bounds) {
+         if (edits.number_variables <= bound_change.variable_index) {
+            throw std::invalid_argument("ParametricSolver: the variable " + std::to_string(bound_change.variable_index) + " does not exist");
+         }
+         const bool is_fixed = (edits.variable_lower_bound(bound_change.variable_index) == edits.variable_upper_bound(bound_change.variable_index));
+         if (is_fixed != (bound_change.lower_bound == bound_change.upper_bound)) {
+            throw std::invalid_argument("ParametricSolver: the variable " + std::to_string(bound_change.variable_index) +
+               " cannot become fixed or free, since the reformulations depend on the fixed variables");
+         }
+      }
+      for (const ConstraintBoundChange& bound_change: update.constraint_bounds) {
+         if (edits.number_constraints <= bound_change.constraint_index) {
+            throw std::invalid_argument("ParametricSolver: the constraint " + std::to_string(bound_change.constraint_index) + " does not exist");
+         }
+         const bool is_equality = (edits.get_constraint_bound_type(bound_change.constraint_index) == EQUAL_BOUNDS);
+         if (is_equality != (bound_change.lower_bound == bound_change.upper_bound)) {
+            throw std::invalid_argument("ParametricSolver: the constraint " + std::to_string(bound_change.constraint_index) +
+               " cannot switch between equality and inequality, since the reformulations depend on the equality constraints");
+         }
+      }
+      edits.set_variable_bounds(update.variable_bounds);
+      for (const ConstraintBoundChange& bound_change: update.constraint_bounds) {
+         edits.set_constraint_bounds(bound_change.constraint_index, bound_change.lower_bound, bound_change.upper_bound);
+      }
+      this->functions_changed = this->functions_changed || update.functions_changed;
+      if (this->functions_changed) {
+         this->model->invalidate_point();
+      }
+      // the reformulations recompute their bounds and collections, and discard their cached evaluations
+      this->model->refresh();
+   }
+
+   Result ParametricSolver::resolve() {
+      NoUserCallbacks user_callbacks{};
+      return this->resolve(user_callbacks);
+   }
+
+   // the first solve analyzes the structure of the problem, the next ones reuse it
+   Result ParametricSolver::resolve(UserCallbacks& user_callbacks) {
+      this->set_initial_iterate();
+      LastIterateRecorder recorder(user_callbacks, this->previous_primals, this->previous_multipliers);
+      WarmstartInformation model_changes = this->editable_model->get_changes();
+      if (this->functions_changed) {
+         model_changes.objective_changed = true;
+         model_changes.constraints_changed = true;
+      }
+      Result result = (this->number_solves == 0) ? this->uno.solve(*this->model, this->initial_iterate, this->options, recorder) :
+         this->uno.resolve(*this->model, this->initial_iterate, this->options, model_changes, recorder);
+      this->has_previous_point = this->has_previous_point || recorder.has_recorded;
+      this->editable_model->clear_changes();
+      this->functions_changed = false;
+      this->number_solves++;
+      return result;
+   }
+
+   // the previous point is projected onto the new bounds; its evaluations depend on the previous parameters
+   void ParametricSolver::set_initial_iterate() {
+      this->initial_iterate.reset(this->model->number_variables, this->model->number_constraints);
+      if (this->has_previous_point) {
+         for (size_t variable_index: Range(this->model->number_variables)) {
+            this->initial_iterate.primals[variable_index] = this->previous_primals[variable_index];
+         }
+         this->initial_iterate.multipliers = this->previous_multipliers;
+      }
+      else {
+         this->model->initial_primal_point(this->initial_iterate.primals);
+         this->model->initial_dual_point(this->initial_iterate.multipliers.constraints);
+      }
+      this->model->project_onto_variable_bounds(this->initial_iterate.primals);
+      this->initial_iterate.feasibility_multipliers.reset();
+   }
+} // namespace
@@ -0,0 +1,85 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PARAMETRICSOLVER_H
+#define UNO_PARAMETRICSOLVER_H
+
+#include <memory>
+#include <vector>
+#include "Uno.hpp"
+#include "model/EditableModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+
+namespace uno {
+   // forward declarations
+   class ConstraintRelaxationStrategy;
+   class GlobalizationMechanism;
+   class Model;
+   class UserCallbacks;
+
+   // new bounds of a general constraint (e.g. a right-hand side)
+   struct ConstraintBoundChange {
+      size_t constraint_index;
+      double lower_bound;
+      double upper_bound;
+   };
+
+   // changes of the parameters of the problem between two solves
+   struct ParameterUpdate {
+      std::vector<BoundChange> variable_bounds{};
+      std::vector<ConstraintBoundChange> constraint_bounds{};
+      // the values of the functions of the original model (e.g. coefficients modified in place by the caller) changed, not their
+      // sparsity
+      bool functions_changed{false};
+   };
+
+   /*! \class ParametricSolver
+    * \brief Persistent solver of a sequence of problems that only differ in their parameters
+    *
+    *  The original model is wrapped into an EditableModel and reformulated once. The stack of models, the strategies and their
+    *  buffers, the sparsity patterns and the symbolic factorizations persist across the solves; the algorithmic state (trust-region
+    *  radius, penalty parameter, filter or funnel, ...) is reset by each solve. A solve starts from the primal-dual point of the last
+    *  iterate of the previous solve (in the space of the reformulated model, projected onto the new bounds). The interior point
+    *  method is warm-started from this point with barrier_warm_start=yes: its initial barrier parameter is then
+    *  barrier_warm_start_initial_parameter, and its bound multipliers are those of the previous solve.
+    *  The changes of the bounds should preserve the structure of the reformulation: the fixed variables and the equality
+    *  constraints remain fixed and equality constraints, respectively (see EditableModel)
+    */
+   class ParametricSolver {
+   public:
+      ParametricSolver(std::unique_ptr<Model> original_model, const Options& options);
+      ~ParametricSolver();
+
+      // applies the changes to the model. They are taken into account by the next solve
+      void update_parameters(const ParameterUpdate& update);
+      // solves the problem with the current parameters, from the previous solution (the initial point of the model for the first solve)
+      Result resolve();
+      Result resolve(UserCallbacks& user_callbacks);
+
+      [[nodiscard]] const Model& get_model() const { return *this->model; }
+      [[nodiscard]] size_t get_number_solves() const { return this->number_solves; }
+
+   private:
+      const Options options;
+      EditableModel* editable_model{nullptr}; /*!< underneath the reformulations, owned by model */
+      const std::unique_ptr<Model> model; /*!< reformulated model */
+      const std::unique_ptr<ConstraintRelaxationStrategy> constraint_relaxation_strategy;
+      const std::unique_ptr<GlobalizationMechanism> globalization_mechanism;
+      Uno uno;
+      Iterate initial_iterate;
+      // primal-dual point of the last iterate of the previous solve
+      Vector<double> previous_primals;
+      Multipliers previous_multipliers;
+      bool has_previous_point{false};
+      bool functions_changed{false};
+      size_t number_solves{0};
+
+      [[nodiscard]] static std::unique_ptr<Model> reformulate(std::unique_ptr<Model> original_model, const Options& options,
+            EditableModel*& editable_model);
+      void set_initial_iterate();
+   };
+} // namespace
+
+#endif // UNO_PARAMETRICSOLVER_H
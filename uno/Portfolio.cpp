@@ -0,0 +1,105 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <exception>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include "Portfolio.hpp"
+#include "ParallelSolver.hpp"
+#include "Uno.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/Model.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Timer.hpp"
+
+namespace uno {
+   namespace {
+      std::string exception_message(const std::exception_ptr& exception) {
+         try {
+            std::rethrow_exception(exception);
+         }
+         catch (const std::exception& caught_exception) {
+            return caught_exception.what();
+         }
+         catch (...) {
+            return "unknown error";
+         }
+      }
+   } // namespace
+
+   Portfolio::Portfolio(const Options& options): number_threads(options.get_unsigned_int("portfolio_threads")) {
+      // comma-separated list of presets
+      std::istringstream preset_list(options.get_string("portfolio_presets"));
+      std::string preset;
+      while (std::getline(preset_list, preset, ',')) {
+         if (!preset.empty()) {
+            try {
+               static_cast<void>(Presets::get_preset_options(preset));
+            }
+            catch (const std::exception& exception) {
+               throw std::invalid_argument(exception.what());
+            }
+            this->presets.emplace_back(preset);
+         }
+      }
+      if (this->presets.empty()) {
+         throw std::invalid_argument("The portfolio should contain at least one preset");
+      }
+   }
+
+   Result Portfolio::solve(const Model& model, const Options& options) {
+      const Logger::Scope logger_scope(options.get_string("logger"));
+      Timer timer{};
+      const size_t number_presets = this->presets.size();
+      Vector<double> initial_point(model.number_variables);
+      model.initial_primal_point(initial_point);
+      model.project_onto_variable_bounds(initial_point);
+      std::vector<Options> options_per_preset(number_presets, options);
+      for (size_t preset_index: Range(number_presets)) {
+         options_per_preset[preset_index].overwrite_with(Presets::get_preset_options(this->presets[preset_index]));
+      }
+      const auto converges = [](const Result& result) {
+         return result.solution.status == IterateStatus::FEASIBLE_KKT_POINT;
+      };
+      ParallelSolver parallel_solver(this->number_threads);
+      parallel_solver.solve(model, std::vector<Vector<double>>(number_presets, initial_point), options_per_preset, converges);
+
+      // among the presets that converged, the fastest wins. In deterministic mode, the first one (in the order of the presets) wins
+      const bool deterministic = options.get_bool("deterministic");
+      std::optional<size_t> winner{};
+      for (size_t preset_index: Range(number_presets)) {
+         const std::optional<Result>& result = parallel_solver.get_result(preset_index);
+         if (parallel_solver.get_exception(preset_index) != nullptr) {
+            WARNING << "Preset " << this->presets[preset_index] << " failed: " <<
+               exception_message(parallel_solver.get_exception(preset_index)) << '\n';
+         }
+         else if (result.has_value()) {
+            DISCRETE << "Preset " << this->presets[preset_index] << ": " << optimization_status_to_message(result->optimization_status) << ", " <<
+               iterate_status_to_message(result->solution.status) << ", " << result->iteration << " iterations, " << result->solve_time << "s\n";
+            if (converges(*result) && (!winner.has_value() ||
+                  (!deterministic && result->solve_time < parallel_solver.get_result(*winner)->solve_time))) {
+               winner = preset_index;
+            }
+         }
+      }
+      if (!winner.has_value()) {
+         winner = parallel_solver.get_best_run();
+         if (!winner.has_value()) {
+            throw std::runtime_error("All the presets of the portfolio failed");
+         }
+      }
+      Result result = parallel_solver.extract_result(*winner, timer.get_duration());
+      result.preset = this->presets[*winner];
+
+      DISCRETE << "\nUno " << Uno::current_version() << " (" << Uno::get_strategy_combination(options_per_preset[*winner]) << ")\n";
+      DISCRETE << "Portfolio: preset " << result.preset << " out of " << number_presets << " presets\n";
+      DISCRETE << Timer::get_current_date();
+      DISCRETE << "────────────────────────────────────────\n";
+      result.print(options.get_bool("print_solution"));
+      return result;
+   }
+} // namespace
@@ -0,0 +1,36 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PORTFOLIO_H
+#define UNO_PORTFOLIO_H
+
+#include <string>
+#include <vector>
+#include "optimization/Result.hpp"
+
+namespace uno {
+   // forward declarations
+   class Model;
+   class Options;
+
+   /*! \class Portfolio
+    * \brief Portfolio of presets
+    *
+    *  Races several presets (e.g. filtersqp, ipopt, byrd) on a model, on a pool of threads. Each preset overwrites the options and
+    *  has its own strategies; the model is shared and only read. Once a preset reaches a KKT point, the others are terminated.
+    *  The result records the winning preset (with the option deterministic, the first preset of the list that reaches a KKT point)
+    */
+   class Portfolio {
+   public:
+      explicit Portfolio(const Options& options);
+
+      // the winner is the preset that converged first or, if none converged, the preset with the least infeasible solution
+      Result solve(const Model& model, const Options& options);
+
+   private:
+      std::vector<std::string> presets{};
+      const size_t number_threads; /*!< 0: number of hardware threads */
+   };
+} // namespace
+
+#endif // UNO_PORTFOLIO_H
@@ -0,0 +1,110 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include <utility>
+#include "RealTimeIteration.hpp"
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/Model.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+#include "tools/UserCallbacks.hpp"
+
+namespace uno {
+   RealTimeIteration::RealTimeIteration(const Model& model, const Options& options):
+         model(model),
+         options(RealTimeIteration::real_time_options(options)),
+         constraint_relaxation_strategy(ConstraintRelaxationStrategyFactory::create(model, this->options)),
+         globalization_mechanism(GlobalizationMechanismFactory::create(*this->constraint_relaxation_strategy, this->options)),
+         statistics(Uno::create_statistics(model, this->options)),
+         current_iterate(model.number_variables, model.number_constraints),
+         trial_iterate(model.number_variables, model.number_constraints) {
+   }
+
+   RealTimeIteration::~RealTimeIteration() = default;
+
+   // the globalization is skipped
+   Options RealTimeIteration::real_time_options(const Options& options) {
+      Options real_time_options = options;
+      real_time_options["globalization_mechanism"] = "none";
+      return real_time_options;
+   }
+
+   void RealTimeIteration::initialize(const Iterate& initial_iterate) {
+      const Logger::Scope logger_scope(this->options.get_string("logger"));
+      this->current_iterate = initial_iterate;
+      this->statistics.start_new_line();
+      this->globalization_mechanism->initialize(this->statistics, this->current_iterate, this->options);
+      this->current_iterate.status = IterateStatus::NOT_OPTIMAL;
+      // the trial iterate has the dimensions of the initialized iterate
+      this->trial_iterate = this->current_iterate;
+      this->warmstart_information.whole_problem_changed();
+      this->number_iterations = 0;
+      this->is_initialized = true;
+   }
+
+   void RealTimeIteration::shift(size_t variable_shift, size_t constraint_shift) {
+      this->check_initialized();
+      if (this->model.number_variables < variable_shift || this->model.number_constraints < constraint_shift) {
+         throw std::invalid_argument("RealTimeIteration::shift: the shift exceeds the dimensions of the model");
+      }
+      const auto shift_vector = [](Vector<double>& vector, size_t size, size_t shift) {
+         for (size_t index: Range(size - shift)) {
+            vector[index] = vector[index + shift];
+         }
+      };
+      shift_vector(this->current_iterate.primals, this->model.number_variables, variable_shift);
+      shift_vector(this->current_iterate.multipliers.lower_bounds, this->model.number_variables, variable_shift);
+      shift_vector(this->current_iterate.multipliers.upper_bounds, this->model.number_variables, variable_shift);
+      shift_vector(this->current_iterate.multipliers.constraints, this->model.number_constraints, constraint_shift);
+      // the evaluations belong to the previous point
+      this->current_iterate.is_objective_computed = false;
+      this->current_iterate.are_constraints_computed = false;
+      this->current_iterate.is_objective_gradient_computed = false;
+      this->current_iterate.is_constraint_jacobian_computed = false;
+      this->current_iterate.are_feasibility_residuals_computed = false;
+      this->current_iterate.progress.reset();
+   }
+
+   // the subproblem of the feedback phase reuses the evaluations of the iterate
+   void RealTimeIteration::prepare() {
+      this->check_initialized();
+      const Logger::Scope logger_scope(this->options.get_string("logger"));
+      this->current_iterate.evaluate_objective(this->model);
+      this->current_iterate.evaluate_constraints(this->model);
+      this->current_iterate.evaluate_objective_gradient(this->model);
+      this->current_iterate.evaluate_constraint_jacobian(this->model);
+   }
+
+   const Iterate& RealTimeIteration::feedback() {
+      NoUserCallbacks user_callbacks{};
+      return this->feedback(user_callbacks);
+   }
+
+   const Iterate& RealTimeIteration::feedback(UserCallbacks& user_callbacks) {
+      this->check_initialized();
+      const Logger::Scope logger_scope(this->options.get_string("logger"));
+      this->number_iterations++;
+      this->statistics.start_new_line();
+      this->statistics.set("iter", this->number_iterations);
+      this->globalization_mechanism->compute_next_iterate(this->statistics, this->model, this->current_iterate, this->trial_iterate,
+            this->warmstart_information, user_callbacks);
+      user_callbacks.notify_new_primals(this->trial_iterate.primals);
+      user_callbacks.notify_new_multipliers(this->trial_iterate.multipliers);
+      std::swap(this->current_iterate, this->trial_iterate);
+      // the bounds (the initial state) may change before the next feedback
+      this->warmstart_information.iterate_changed();
+      return this->current_iterate;
+   }
+
+   void RealTimeIteration::check_initialized() const {
+      if (!this->is_initialized) {
+         throw std::runtime_error("RealTimeIteration: the initial iterate was not set");
+      }
+   }
+} // namespace
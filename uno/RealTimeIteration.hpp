@@ -0,0 +1,65 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_REALTIMEITERATION_H
+#define UNO_REALTIMEITERATION_H
+
+#include <memory>
+#include "optimization/Iterate.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "options/Options.hpp"
+#include "tools/Statistics.hpp"
+
+namespace uno {
+   // forward declarations
+   class ConstraintRelaxationStrategy;
+   class GlobalizationMechanism;
+   class Model;
+   class UserCallbacks;
+
+   /*! \class RealTimeIteration
+    * \brief Real-time iteration (RTI) driver for nonlinear model predictive control (Diehl, Bock and Schlöder, 2005)
+    *
+    *  A single full-step SQP iteration (globalization mechanism "none") is performed per sampling instant, split into a
+    *  preparation phase that evaluates the functions and derivatives at the current iterate before the new initial state is known,
+    *  and a feedback phase that solves one subproblem once the new initial state has been inserted into the model (e.g. as the
+    *  bounds of the initial state variables). The strategies, the subproblem solver and its warm start (e.g. the active set of BQPD
+    *  or of the dense QP solver) persist across the sampling instants
+    */
+   class RealTimeIteration {
+   public:
+      RealTimeIteration(const Model& model, const Options& options);
+      ~RealTimeIteration();
+
+      // initializes the strategies at the initial iterate
+      void initialize(const Iterate& initial_iterate);
+      // shift initialization of the previous horizon: the first components are discarded and the last ones are duplicated
+      void shift(size_t variable_shift, size_t constraint_shift);
+      // preparation phase, before the new initial state is known
+      void prepare();
+      // feedback phase: one subproblem is solved at the prepared iterate. The model may only have changed in its bounds since
+      // the preparation. Returns the new iterate, whose first primal components are typically the feedback control
+      const Iterate& feedback();
+      const Iterate& feedback(UserCallbacks& user_callbacks);
+
+      [[nodiscard]] const Iterate& get_current_iterate() const { return this->current_iterate; }
+      [[nodiscard]] size_t get_number_iterations() const { return this->number_iterations; }
+
+   private:
+      const Model& model;
+      const Options options; /*!< globalization mechanism set to "none" */
+      const std::unique_ptr<ConstraintRelaxationStrategy> constraint_relaxation_strategy;
+      const std::unique_ptr<GlobalizationMechanism> globalization_mechanism;
+      Statistics statistics;
+      WarmstartInformation warmstart_information{};
+      Iterate current_iterate;
+      Iterate trial_iterate;
+      size_t number_iterations{0};
+      bool is_initialized{false};
+
+      [[nodiscard]] static Options real_time_options(const Options& options);
+      void check_initialized() const;
+   };
+} // namespace
+
+#endif // UNO_REALTIMEITERATION_H
@@ -1,7 +1,11 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include "Uno.hpp"
 #include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
 #include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
@@ -12,13 +16,25 @@
 #include "ingredients/subproblem_solvers/LPSolverFactory.hpp"
 #include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "model/EditableModel.hpp"
 #include "model/Model.hpp"
+#include "optimization/EvaluationCounters.hpp"
 #include "optimization/Iterate.hpp"
 #include "optimization/WarmstartInformation.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/AllocationTracker.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Checkpoint.hpp"
+#include "tools/Infinity.hpp"
 #include "tools/Logger.hpp"
+#include "tools/MemoryReport.hpp"
+#include "tools/Metrics.hpp"
+#include "tools/Profiler.hpp"
+#include "tools/SolutionFile.hpp"
 #include "optimization/OptimizationStatus.hpp"
 #include "options/Options.hpp"
 #include "tools/Statistics.hpp"
+#include "tools/Timeline.hpp"
 #include "tools/Timer.hpp"
 #include "tools/UserCallbacks.hpp"
 
@@ -27,10 +43,26 @@ namespace uno {
          globalization_mechanism(globalization_mechanism),
          max_iterations(options.get_unsigned_int("max_iterations")),
          time_limit(options.get_double("time_limit")),
+         return_best_iterate(options.get_bool("return_best_iterate")),
+         tolerance(options.get_double("tolerance")),
          print_solution(options.get_bool("print_solution")),
-         strategy_combination(Uno::get_strategy_combination(options)) { }
+         solution_file(options.get_string("solution_file")),
+         strategy_combination(Uno::get_strategy_combination(options)),
+         use_profiler(options.get_bool("profiler")),
+         forbid_loop_allocations(options.get_bool("forbid_loop_allocations")),
+         memory_report(options.get_bool("memory_report")),
+         timeline_file(options.get_string("timeline_file")),
+         checkpoint_file(options.get_string("checkpoint_file")),
+         checkpoint_frequency(options.get_unsigned_int("checkpoint_frequency")),
+         objective_cutoff(INF<double>),
+         // the solves carried out by the workers of a pool (e.g. multistart runs) share this pool
+         thread_pool((ThreadPool::current() == nullptr) ? ThreadPool::create(options) : nullptr) {
+      if (this->forbid_loop_allocations && !AllocationTracker::is_enabled) {
+         WARNING << "The option forbid_loop_allocations has no effect: Uno was built without WITH_ALLOCATION_TRACKING\n";
+      }
+   }
    
-   Level Logger::level = INFO;
+   thread_local Level Logger::level = INFO;
 
    // solve without user callbacks
    Result Uno::solve(const Model& model, Iterate& current_iterate, const Options& options) {
@@ -41,39 +73,190 @@ namespace uno {
 
    // solve with user callbacks
    Result Uno::solve(const Model& model, Iterate& current_iterate, const Options& options, UserCallbacks& user_callbacks) {
+      return this->optimize(model, current_iterate, options, user_callbacks, false, nullptr);
+   }
+
+   // re-solve without user callbacks
+   Result Uno::resolve(const Model& model, Iterate& current_iterate, const Options& options) {
+      NoUserCallbacks user_callbacks{};
+      return this->resolve(model, current_iterate, options, user_callbacks);
+   }
+
+   // re-solve with user callbacks: the model has the same structure as in the previous solve
+   Result Uno::resolve(const Model& model, Iterate& current_iterate, const Options& options, UserCallbacks& user_callbacks) {
+      // without a previous solve, there is no structure to reuse
+      return this->optimize(model, current_iterate, options, user_callbacks, this->has_solved, nullptr);
+   }
+
+   // re-solve a modified model without user callbacks
+   Result Uno::resolve(const Model& model, Iterate& current_iterate, const Options& options, const WarmstartInformation& model_changes) {
+      NoUserCallbacks user_callbacks{};
+      return this->resolve(model, current_iterate, options, model_changes, user_callbacks);
+   }
+
+   // re-solve a modified model with user callbacks: new sparsity patterns require new symbolic factorizations
+   Result Uno::resolve(const Model& model, Iterate& current_iterate, const Options& options, const WarmstartInformation& model_changes,
+         UserCallbacks& user_callbacks) {
+      const bool same_structure = this->has_solved && !model_changes.hessian_sparsity_changed && !model_changes.jacobian_sparsity_changed;
+      return this->optimize(model, current_iterate, options, user_callbacks, same_structure, nullptr);
+   }
+
+   // the functions do not depend on the bounds: the evaluations of the parent solution remain valid, unless the solution is
+   // projected onto the bounds of the node
+   Result Uno::solve_node(Model& model, EditableModel& editable_model, const Iterate& parent_solution,
+         const std::vector<BoundChange>& bound_changes, double objective_cutoff, const Options& options) {
+      editable_model.clear_changes();
+      editable_model.set_variable_bounds(bound_changes);
+      model.refresh();
+      // the reformulations may have discarded the additional variables (e.g. slacks) of the parent solution
+      Iterate node_iterate = parent_solution;
+      node_iterate.set_number_variables(model.number_variables);
+      bool is_point_projected = false;
+      for (size_t variable_index: Range(model.number_variables)) {
+         const double projected_value = std::min(std::max(node_iterate.primals[variable_index], model.variable_lower_bound(variable_index)),
+               model.variable_upper_bound(variable_index));
+         is_point_projected = is_point_projected || (projected_value != node_iterate.primals[variable_index]);
+         node_iterate.primals[variable_index] = projected_value;
+      }
+      if (is_point_projected) {
+         node_iterate.is_objective_computed = false;
+         node_iterate.is_objective_gradient_computed = false;
+         node_iterate.are_constraints_computed = false;
+         node_iterate.is_constraint_jacobian_computed = false;
+         node_iterate.are_feasibility_residuals_computed = false;
+      }
+      this->objective_cutoff = objective_cutoff;
+      NoUserCallbacks user_callbacks{};
+      Result result = this->optimize(model, node_iterate, options, user_callbacks, this->has_solved, nullptr);
+      this->objective_cutoff = INF<double>;
+      editable_model.clear_changes();
+      return result;
+   }
+
+   // resume without user callbacks
+   Result Uno::resume(const Model& model, Iterate& current_iterate, const std::string& checkpoint_file, const Options& options) {
+      NoUserCallbacks user_callbacks{};
+      return this->resume(model, current_iterate, checkpoint_file, options, user_callbacks);
+   }
+
+   // resume with user callbacks: the strategies are initialized, then their state is overwritten by that of the checkpoint
+   Result Uno::resume(const Model& model, Iterate& current_iterate, const std::string& checkpoint_file, const Options& options,
+         UserCallbacks& user_callbacks) {
+      // a checkpoint of another model or other strategies is rejected before the solve
+      CheckpointReader reader(checkpoint_file);
+      this->read_checkpoint_header(reader, model);
+      return this->optimize(model, current_iterate, options, user_callbacks, false, &reader);
+   }
+
+   Result Uno::optimize(const Model& model, Iterate& current_iterate, const Options& options, UserCallbacks& user_callbacks,
+         bool same_structure, CheckpointReader* checkpoint) {
+      // the evaluation counters and the logger level belong to this solve: concurrent solves on other threads do not interfere
+      EvaluationCounters evaluation_counters{};
+      const EvaluationCounters::Scope evaluation_counters_scope(evaluation_counters);
+      // the allocations of the setup, then of the iterations
+      AllocationCounters setup_allocations{}, loop_allocations{};
+      size_t peak_iteration_allocations = 0;
+      std::optional<AllocationTracker::Scope> allocation_scope;
+      allocation_scope.emplace(setup_allocations);
+      const Logger::Scope logger_scope(options.get_string("logger"));
+      // the parallel components of the solve run on the pool of this solver, or on the pool installed by the caller (if any)
+      const ThreadPool::Scope thread_pool_scope((this->thread_pool != nullptr) ? this->thread_pool.get() : ThreadPool::current());
+      Profiler profiler{};
+      const Profiler::Scope profiler_scope(this->use_profiler ? &profiler : nullptr);
+      // the metrics of the solve are recorded separately, then merged into the registry installed by the caller (if any)
+      MetricsRegistry* const metrics_registry = MetricsRegistry::current();
+      std::optional<MetricsRegistry> solve_metrics{};
+      if (metrics_registry != nullptr) {
+         solve_metrics.emplace();
+      }
+      const MetricsRegistry::Scope metrics_scope(solve_metrics.has_value() ? &*solve_metrics : nullptr);
+      // the events are recorded in the timeline installed by the caller (e.g. ParallelSolver), or in the timeline of this solve
+      std::optional<Timeline> timeline{};
+      if (!this->timeline_file.empty() && Timeline::current() == nullptr) {
+         timeline.emplace();
+      }
+      const Timeline::Scope timeline_scope(timeline.has_value() ? &*timeline : Timeline::current());
       Timer timer{};
+      // the inner loops terminate the solve upon cancellation or when the time limit is reached
+      const Cancellation::Scope cancellation_scope(this->cancellation_token, this->time_limit);
       Statistics statistics = Uno::create_statistics(model, options);
+      // contiguous copy of the constraint bounds for the vectorized constraint violation
+      model.materialize_constraint_bounds();
       WarmstartInformation warmstart_information{};
-      warmstart_information.whole_problem_changed();
+      // with the same structure, the sparsity patterns (and the symbolic factorizations) of the previous solve remain valid
+      if (same_structure) {
+         warmstart_information.iterate_changed();
+      }
+      else {
+         warmstart_information.whole_problem_changed();
+      }
+      // the counters of the globalization mechanism accumulate across solves
+      const size_t initial_number_subproblems_solved = this->globalization_mechanism.get_number_subproblems_solved();
+      const size_t initial_number_factorizations = this->globalization_mechanism.get_number_factorizations();
+      const size_t initial_number_hessian_evaluations = this->globalization_mechanism.get_hessian_evaluation_count();
+      const FactorizationStatistics initial_factorization_statistics = this->globalization_mechanism.get_factorization_statistics();
 
       size_t major_iterations = 0;
       OptimizationStatus optimization_status = OptimizationStatus::SUCCESS;
       try {
          // use the initial primal-dual point to initialize the strategies and generate the initial iterate
          this->initialize(statistics, current_iterate, options);
-         // allocate the trial iterate once and for all here
-         Iterate trial_iterate(current_iterate);
+         if (checkpoint != nullptr) {
+            major_iterations = this->load_checkpoint(*checkpoint, current_iterate);
+         }
+         // the trial iterate is allocated once and for all, and recycled across solves
+         this->iterate_pool.release_all();
+         Iterate& trial_iterate = this->iterate_pool.acquire(current_iterate);
+         // the best iterate is allocated in the setup as well
+         Iterate* best_iterate = this->return_best_iterate ? &this->iterate_pool.acquire(current_iterate) : nullptr;
 
+         allocation_scope.emplace(loop_allocations);
          try {
             bool termination = false;
             // check for termination
             while (!termination) {
                major_iterations++;
+               // the first iteration may allocate (e.g. the workspaces of the subproblem solvers)
+               const AllocationTracker::Prohibition allocation_prohibition(this->forbid_loop_allocations && 1 < major_iterations);
+               const Timeline::Event iteration_event(Timeline::current(), "iteration");
+               const size_t initial_loop_allocations = loop_allocations.allocations;
                statistics.start_new_line();
                statistics.set("iter", major_iterations);
                DEBUG << "### Outer iteration " << major_iterations << '\n';
 
                // compute an acceptable iterate by solving a subproblem at the current point
-               warmstart_information.iterate_changed();
-               this->globalization_mechanism.compute_next_iterate(statistics, model, current_iterate, trial_iterate, warmstart_information, user_callbacks);
-               termination = this->termination_criteria(trial_iterate.status, major_iterations, timer.get_duration(), optimization_status);
+               {
+                  const ScopedTimer globalization_timer("globalization");
+                  this->globalization_mechanism.compute_next_iterate(statistics, model, current_iterate, trial_iterate, warmstart_information,
+                        user_callbacks);
+               }
                user_callbacks.notify_new_primals(trial_iterate.primals);
                user_callbacks.notify_new_multipliers(trial_iterate.multipliers);
+               termination = this->termination_criteria(trial_iterate, major_iterations, timer.get_duration(),
+                     user_callbacks.should_terminate() || Cancellation::is_cancelled(), optimization_status);
 
                // the trial iterate becomes the current iterate for the next iteration
                std::swap(current_iterate, trial_iterate);
+               warmstart_information.iterate_changed();
+               if (best_iterate != nullptr && this->is_better(current_iterate, *best_iterate)) {
+                  *best_iterate = current_iterate;
+               }
+               peak_iteration_allocations = std::max(peak_iteration_allocations, loop_allocations.allocations - initial_loop_allocations);
+               if (!termination && !this->checkpoint_file.empty() && ((0 < this->checkpoint_frequency &&
+                     major_iterations % this->checkpoint_frequency == 0) || CheckpointRequest::consume())) {
+                  // writing a checkpoint is not part of the iteration
+                  const AllocationTracker::Prohibition checkpoint_permission(false);
+                  this->save_checkpoint(model, current_iterate, major_iterations);
+               }
             }
          }
+         catch (const SolveInterruption& interruption) {
+            // the current iterate is the last accepted iterate
+            statistics.start_new_line();
+            statistics.set("status", interruption.what());
+            if (Logger::level == INFO) statistics.print_current_line();
+            optimization_status = interruption.status;
+         }
          catch (std::exception& exception) {
             statistics.start_new_line();
             statistics.set("status", exception.what());
@@ -83,18 +266,59 @@ namespace uno {
          }
          if (Logger::level == INFO) statistics.print_footer();
 
+         // the last iterate is not optimal: fall back on the best iterate
+         if (best_iterate != nullptr && current_iterate.status == IterateStatus::NOT_OPTIMAL && this->is_better(*best_iterate, current_iterate)) {
+            DEBUG << "The best accepted iterate is returned instead of the last one\n";
+            current_iterate = *best_iterate;
+         }
          Uno::postprocess_iterate(model, current_iterate, current_iterate.status);
       }
+      catch (const SolveInterruption& interruption) {
+         DISCRETE << "The solve was interrupted at the initial iterate: " << interruption.what() << '\n';
+         optimization_status = interruption.status;
+      }
       catch (const std::exception& e) {
          DISCRETE  << "An error occurred at the initial iterate: " << e.what()  << '\n';
          optimization_status = OptimizationStatus::EVALUATION_ERROR;
       }
-      Result result = this->create_result(model, optimization_status, current_iterate, major_iterations, timer);
+      this->has_solved = true;
+      allocation_scope.reset();
+      if (timeline.has_value()) {
+         try {
+            timeline->write(this->timeline_file);
+         }
+         catch (const std::exception& exception) {
+            WARNING << exception.what() << '\n';
+         }
+      }
+      // the memory is measured before the current iterate is moved into the result
+      std::vector<MemoryUsage> memory_usages = this->memory_report ? this->report_memory(current_iterate) : std::vector<MemoryUsage>{};
+      Result result = this->create_result(model, optimization_status, current_iterate, major_iterations, timer, evaluation_counters, profiler,
+            initial_number_subproblems_solved, initial_number_factorizations, initial_number_hessian_evaluations,
+            initial_factorization_statistics);
+      result.setup_allocations = setup_allocations;
+      result.loop_allocations = loop_allocations;
+      result.peak_iteration_allocations = peak_iteration_allocations;
+      result.memory_usages = std::move(memory_usages);
+      if (solve_metrics.has_value()) {
+         Uno::record_solve_metrics(*solve_metrics, result, evaluation_counters.time);
+         metrics_registry->merge(*solve_metrics);
+      }
       this->print_optimization_summary(result);
+      // a solution file that cannot be written does not discard the result
+      if (!this->solution_file.empty()) {
+         try {
+            SolutionFile::write(this->solution_file, result);
+         }
+         catch (const std::runtime_error& exception) {
+            WARNING << exception.what() << '\n';
+         }
+      }
       return result;
    }
 
    void Uno::initialize(Statistics& statistics, Iterate& current_iterate, const Options& options) {
+      const ScopedTimer initialization_timer("initialization");
       statistics.start_new_line();
       statistics.set("iter", 0);
       statistics.set("status", "initial point");
@@ -104,9 +328,79 @@ namespace uno {
       current_iterate.status = IterateStatus::NOT_OPTIMAL;
    }
 
+   // a checkpoint that cannot be written does not interrupt the solve
+   void Uno::save_checkpoint(const Model& model, const Iterate& current_iterate, size_t iteration) const {
+      try {
+         CheckpointWriter writer(this->checkpoint_file);
+         writer.write(this->strategy_combination);
+         writer.write(model.number_variables);
+         writer.write(model.number_constraints);
+         writer.write(iteration);
+         // current iterate
+         writer.write(current_iterate.number_variables);
+         writer.write(current_iterate.primals);
+         writer.write(current_iterate.multipliers.constraints);
+         writer.write(current_iterate.multipliers.lower_bounds);
+         writer.write(current_iterate.multipliers.upper_bounds);
+         writer.write(current_iterate.feasibility_multipliers.constraints);
+         writer.write(current_iterate.feasibility_multipliers.lower_bounds);
+         writer.write(current_iterate.feasibility_multipliers.upper_bounds);
+         writer.write(current_iterate.objective_multiplier);
+         // algorithmic state
+         this->globalization_mechanism.save_state(writer);
+         writer.close();
+         DEBUG << "Checkpoint written in " << this->checkpoint_file << " at iteration " << iteration << '\n';
+      }
+      catch (const std::runtime_error& exception) {
+         WARNING << exception.what() << '\n';
+      }
+   }
+
+   void Uno::read_checkpoint_header(CheckpointReader& reader, const Model& model) const {
+      const std::string checkpoint_strategy_combination = reader.read_string();
+      if (checkpoint_strategy_combination != this->strategy_combination) {
+         throw std::runtime_error("The checkpoint was written with the strategies " + checkpoint_strategy_combination + " instead of " +
+            this->strategy_combination);
+      }
+      const size_t number_variables = reader.read_size_t();
+      const size_t number_constraints = reader.read_size_t();
+      if (number_variables != model.number_variables || number_constraints != model.number_constraints) {
+         throw std::runtime_error("The checkpoint was written for a model with " + std::to_string(number_variables) + " variables and " +
+            std::to_string(number_constraints) + " constraints");
+      }
+   }
+
+   // returns the iteration of the checkpoint
+   size_t Uno::load_checkpoint(CheckpointReader& reader, Iterate& current_iterate) {
+      const size_t iteration = reader.read_size_t();
+      // current iterate
+      current_iterate.set_number_variables(reader.read_size_t());
+      reader.read(current_iterate.primals);
+      reader.read(current_iterate.multipliers.constraints);
+      reader.read(current_iterate.multipliers.lower_bounds);
+      reader.read(current_iterate.multipliers.upper_bounds);
+      reader.read(current_iterate.feasibility_multipliers.constraints);
+      reader.read(current_iterate.feasibility_multipliers.lower_bounds);
+      reader.read(current_iterate.feasibility_multipliers.upper_bounds);
+      current_iterate.objective_multiplier = reader.read_double();
+      current_iterate.progress.reset();
+      current_iterate.is_objective_computed = false;
+      current_iterate.is_objective_gradient_computed = false;
+      current_iterate.are_constraints_computed = false;
+      current_iterate.is_constraint_jacobian_computed = false;
+      current_iterate.are_feasibility_residuals_computed = false;
+      // algorithmic state (the measures of the iterate are recomputed)
+      this->globalization_mechanism.load_state(reader, current_iterate);
+      current_iterate.status = IterateStatus::NOT_OPTIMAL;
+      DISCRETE << "Resuming the solve at iteration " << iteration << '\n';
+      return iteration;
+   }
+
    Statistics Uno::create_statistics(const Model& model, const Options& options) {
       Statistics statistics(options);
       statistics.add_column("iter", Statistics::int_width, options.get_int("statistics_major_column_order"));
+      statistics.add_column("iter time", Statistics::double_width - 5, options.get_int("statistics_iteration_time_column_order"));
+      statistics.add_column("eval time", Statistics::double_width - 5, options.get_int("statistics_evaluation_time_column_order"));
       statistics.add_column("step norm", Statistics::double_width - 5, options.get_int("statistics_step_norm_column_order"));
       statistics.add_column("objective", Statistics::double_width - 5, options.get_int("statistics_objective_column_order"));
       if (model.is_constrained()) {
@@ -118,8 +412,9 @@ namespace uno {
       return statistics;
    }
 
-   bool Uno::termination_criteria(IterateStatus current_status, size_t iteration, double current_time, OptimizationStatus& optimization_status) const {
-      if (current_status != IterateStatus::NOT_OPTIMAL) {
+   bool Uno::termination_criteria(const Iterate& trial_iterate, size_t iteration, double current_time, bool user_termination,
+         OptimizationStatus& optimization_status) const {
+      if (trial_iterate.status != IterateStatus::NOT_OPTIMAL) {
          return true;
       }
       else if (this->max_iterations <= iteration) {
@@ -130,23 +425,130 @@ namespace uno {
          optimization_status = OptimizationStatus::TIME_LIMIT;
          return true;
       }
+      else if (user_termination) {
+         optimization_status = OptimizationStatus::USER_TERMINATION;
+         return true;
+      }
+      // branch and bound: a feasible iterate worse than the incumbent
+      else if (trial_iterate.is_objective_computed && trial_iterate.primal_feasibility <= this->tolerance &&
+            this->objective_cutoff < trial_iterate.evaluations.objective) {
+         optimization_status = OptimizationStatus::OBJECTIVE_CUTOFF;
+         return true;
+      }
       return false;
    }
 
+   // smaller constraint violation (the violations below the tolerance are equivalent), then smaller objective
+   bool Uno::is_better(const Iterate& iterate, const Iterate& other_iterate) const {
+      const double violation = std::max(iterate.primal_feasibility, this->tolerance);
+      const double other_violation = std::max(other_iterate.primal_feasibility, this->tolerance);
+      if (violation != other_violation) {
+         return violation < other_violation;
+      }
+      return iterate.evaluations.objective < other_iterate.evaluations.objective;
+   }
+
    void Uno::postprocess_iterate(const Model& model, Iterate& iterate, IterateStatus termination_status) {
-      // in case the objective was not yet evaluated, evaluate it
+      // in case the objective was not yet evaluated (e.g. in the restoration phase), evaluate it and set the objective measure
       iterate.evaluate_objective(model);
+      if (iterate.progress.objective && std::isnan(iterate.progress.objective(1.))) {
+         iterate.progress.objective = ObjectiveMeasure::scaled(iterate.evaluations.objective);
+      }
       model.postprocess_solution(iterate, termination_status);
       DEBUG2 << "Final iterate:\n" << iterate;
    }
 
+   std::vector<MemoryUsage> Uno::report_memory(const Iterate& current_iterate) const {
+      MemoryReport report{};
+      // current iterate, trial iterate (and best iterate)
+      report.add("iterates", current_iterate.memory_size() + this->iterate_pool.memory_size());
+      this->globalization_mechanism.report_memory(report);
+      return report.get_usages();
+   }
+
+   // metrics of the whole solve. The metrics recorded by the components during the solve (e.g. the restoration phases) are in the
+   // registry of the solve
+   void Uno::record_solve_metrics(MetricsRegistry& metrics_registry, const Result& result, double evaluation_time) {
+      metrics_registry.increment(Metric::SOLVES);
+      if (0. < metrics_registry.value(Metric::RESTORATION_PHASES)) {
+         metrics_registry.increment(Metric::SOLVES_WITH_RESTORATION);
+      }
+      metrics_registry.increment(Metric::ITERATIONS, static_cast<double>(result.iteration));
+      metrics_registry.increment(Metric::FUNCTION_EVALUATIONS, static_cast<double>(result.objective_evaluations + result.constraint_evaluations));
+      metrics_registry.increment(Metric::DERIVATIVE_EVALUATIONS, static_cast<double>(result.objective_gradient_evaluations +
+         result.jacobian_evaluations + result.hessian_evaluations));
+      metrics_registry.increment(Metric::SOLVE_TIME, result.solve_time);
+      metrics_registry.increment(Metric::EVALUATION_TIME, evaluation_time);
+      metrics_registry.set(Metric::LAST_SOLVE_TIME, result.solve_time);
+      metrics_registry.observe(Metric::SOLVE_ITERATIONS, static_cast<double>(result.iteration));
+      metrics_registry.observe(Metric::SOLVE_FACTORIZATIONS, static_cast<double>(result.factorization_statistics.number_factorizations));
+      if (0. < result.solve_time) {
+         metrics_registry.observe(Metric::SOLVE_EVALUATION_TIME_SHARE, std::min(1., evaluation_time / result.solve_time));
+      }
+   }
+
    Result Uno::create_result(const Model& model, OptimizationStatus optimization_status, Iterate& current_iterate, size_t major_iterations,
-         const Timer& timer) {
-      const size_t number_subproblems_solved = this->globalization_mechanism.get_number_subproblems_solved();
-      const size_t number_hessian_evaluations = this->globalization_mechanism.get_hessian_evaluation_count();
-      return {optimization_status, std::move(current_iterate), model.number_variables, model.number_constraints, major_iterations,
-            timer.get_duration(), Iterate::number_eval_objective, Iterate::number_eval_constraints, Iterate::number_eval_objective_gradient,
-            Iterate::number_eval_jacobian, number_hessian_evaluations, number_subproblems_solved};
+         const Timer& timer, const EvaluationCounters& evaluation_counters,
+         const Profiler& profiler, size_t initial_number_subproblems_solved, size_t initial_number_factorizations,
+         size_t initial_number_hessian_evaluations, const FactorizationStatistics& initial_factorization_statistics) {
+      const size_t number_subproblems_solved = this->globalization_mechanism.get_number_subproblems_solved() - initial_number_subproblems_solved;
+      const size_t number_factorizations = this->globalization_mechanism.get_number_factorizations() - initial_number_factorizations;
+      const size_t number_hessian_evaluations = this->globalization_mechanism.get_hessian_evaluation_count() - initial_number_hessian_evaluations;
+      const size_t peak_workspace_size = this->globalization_mechanism.get_peak_workspace_size();
+      Result result{optimization_status, std::move(current_iterate), model.number_variables, model.number_constraints, major_iterations,
+            timer.get_duration(), evaluation_counters.objective, evaluation_counters.constraints, evaluation_counters.objective_gradient,
+            evaluation_counters.jacobian, number_hessian_evaluations, number_subproblems_solved, number_factorizations,
+            peak_workspace_size, evaluation_counters.cache_hits, evaluation_counters.cache_misses, profiler.get_phase_timings()};
+      // the statistics of the linear solvers accumulate across solves
+      result.factorization_statistics = this->globalization_mechanism.get_factorization_statistics().since(initial_factorization_statistics);
+      if (result.solution.status == IterateStatus::INFEASIBLE_STATIONARY_POINT || result.solution.status == IterateStatus::UNBOUNDED) {
+         result.certificate = this->globalization_mechanism.get_certificate();
+      }
+      return result;
+   }
+
+   // the KKT conditions ∇L(x, λ, p) = 0, c(x, p) = 0 are differentiated with respect to p:
+   // [W J^T; J 0] [dx/dp; -dλ/dp] = -[d∇L/dp; dc/dp], solved with the factors of the last iteration
+   Sensitivity Uno::compute_sensitivity(const Result& result, const Vector<double>& lagrangian_gradient_derivatives,
+         const Vector<double>& constraint_derivatives, size_t number_parameters) {
+      if (!this->has_solved) {
+         throw std::runtime_error("Uno::compute_sensitivity: the model was not solved");
+      }
+      const size_t number_variables = result.number_variables;
+      const size_t number_constraints = result.number_constraints;
+      if (lagrangian_gradient_derivatives.size() != number_variables * number_parameters ||
+            constraint_derivatives.size() != number_constraints * number_parameters) {
+         throw std::invalid_argument("Uno::compute_sensitivity: the derivatives do not match the dimensions of the model");
+      }
+      const size_t dimension = number_variables + number_constraints;
+      Vector<double> rhs(dimension * number_parameters);
+      for (size_t parameter_index: Range(number_parameters)) {
+         for (size_t variable_index: Range(number_variables)) {
+            rhs[parameter_index * dimension + variable_index] = -lagrangian_gradient_derivatives[parameter_index * number_variables + variable_index];
+         }
+         for (size_t constraint_index: Range(number_constraints)) {
+            rhs[parameter_index * dimension + number_variables + constraint_index] =
+               -constraint_derivatives[parameter_index * number_constraints + constraint_index];
+         }
+      }
+      Vector<double> solution(dimension * number_parameters);
+      this->globalization_mechanism.solve_sensitivity_systems(rhs, solution, number_parameters);
+
+      Sensitivity sensitivity(number_variables, number_constraints, number_parameters);
+      for (size_t parameter_index: Range(number_parameters)) {
+         for (size_t variable_index: Range(number_variables)) {
+            sensitivity.primal_derivatives[parameter_index * number_variables + variable_index] = solution[parameter_index * dimension + variable_index];
+         }
+         for (size_t constraint_index: Range(number_constraints)) {
+            sensitivity.constraint_multiplier_derivatives[parameter_index * number_constraints + constraint_index] =
+               -solution[parameter_index * dimension + number_variables + constraint_index];
+         }
+      }
+      return sensitivity;
+   }
+
+   void Uno::set_cancellation_token(const CancellationToken* token) {
+      this->cancellation_token = token;
    }
 
    std::string Uno::current_version() {
@@ -5,16 +5,27 @@
 #define UNO_H
 
 #include "optimization/Result.hpp"
+#include "optimization/IteratePool.hpp"
 #include "optimization/IterateStatus.hpp"
+#include "optimization/Sensitivity.hpp"
+#include "tools/ThreadPool.hpp"
 
 namespace uno {
    // forward declarations
+   class CancellationToken;
+   class CheckpointReader;
+   class EditableModel;
+   struct EvaluationCounters;
    class GlobalizationMechanism;
+   class MetricsRegistry;
    class Model;
    class Options;
+   class Profiler;
    class Statistics;
    class Timer;
    class UserCallbacks;
+   struct BoundChange;
+   struct WarmstartInformation;
 
    class Uno {
    public:
@@ -23,26 +34,84 @@ namespace uno {
       // solve with or without user callbacks
       Result solve(const Model& model, Iterate& initial_iterate, const Options& options);
       Result solve(const Model& model, Iterate& initial_iterate, const Options& options, UserCallbacks& user_callbacks);
+      // re-solve a model whose values (not the structure) changed since the previous solve. The strategies, their buffers and the
+      // symbolic factorizations are reused; only the algorithmic state (radius, penalty and barrier parameters, filter, ...) is reset
+      Result resolve(const Model& model, Iterate& initial_iterate, const Options& options);
+      Result resolve(const Model& model, Iterate& initial_iterate, const Options& options, UserCallbacks& user_callbacks);
+      // re-solve a model modified in place (see EditableModel and Model::refresh) with the dimensions of the previous solve. The
+      // symbolic factorizations are reused, unless the changes alter the sparsity patterns
+      Result resolve(const Model& model, Iterate& initial_iterate, const Options& options, const WarmstartInformation& model_changes);
+      Result resolve(const Model& model, Iterate& initial_iterate, const Options& options, const WarmstartInformation& model_changes,
+            UserCallbacks& user_callbacks);
+      // branch-and-bound node solve. The bounds of editable_model (underneath the reformulated model) are those of the parent node:
+      // they are tightened by the bound changes, then the node is solved from the solution of the parent node with the structures
+      // of the previous solve (symbolic factorizations, active set of the QP solver; the interior point method is warm-started with
+      // barrier_warm_start). The solve terminates as soon as a feasible iterate has an objective larger than objective_cutoff
+      // (OptimizationStatus::OBJECTIVE_CUTOFF). The bounds of the node remain in editable_model after the solve
+      Result solve_node(Model& model, EditableModel& editable_model, const Iterate& parent_solution, const std::vector<BoundChange>& bound_changes,
+            double objective_cutoff, const Options& options);
+      // resume a solve from a checkpoint (see the options checkpoint_file and checkpoint_frequency) of the same model with the same
+      // strategies. The iterate and the algorithmic state of the strategies are those of the checkpoint; the iterations resume at the
+      // iteration of the checkpoint
+      Result resume(const Model& model, Iterate& current_iterate, const std::string& checkpoint_file, const Options& options);
+      Result resume(const Model& model, Iterate& current_iterate, const std::string& checkpoint_file, const Options& options,
+            UserCallbacks& user_callbacks);
+
+      // post-solve parametric sensitivity (sIPOPT-style) of the solution of the last solve, with the factors of the primal-dual system of its
+      // last iteration (interior point methods with a direct linear solver only). The parameter derivatives of the Lagrangian gradient
+      // d(∇f - Σ λ_j ∇c_j)/dp (the objective multiplied by the objective sign) and of the constraints dc/dp are column-major blocks of
+      // number_variables x number_parameters and number_constraints x number_parameters
+      [[nodiscard]] Sensitivity compute_sensitivity(const Result& result, const Vector<double>& lagrangian_gradient_derivatives,
+            const Vector<double>& constraint_derivatives, size_t number_parameters);
+
+      // the token may be cancelled by another thread: the solve then terminates at the current iterate, at the next cancellation point
+      void set_cancellation_token(const CancellationToken* token);
 
       static std::string current_version();
       static void print_available_strategies();
       static std::string get_strategy_combination(const Options& options);
+      // columns of the major iterations
+      [[nodiscard]] static Statistics create_statistics(const Model& model, const Options& options);
       void print_optimization_summary(const Result& result);
 
    private:
       GlobalizationMechanism& globalization_mechanism; /*!< Globalization mechanism */
       const size_t max_iterations; /*!< Maximum number of iterations */
-      const double time_limit; /*!< CPU time limit (can be inf) */
+      const double time_limit; /*!< wall-clock time limit (can be inf) */
+      const bool return_best_iterate; /*!< upon a non-optimal termination, return the best accepted iterate */
+      const double tolerance;
       const bool print_solution;
+      const std::string solution_file; /*!< "": no binary solution file */
       const std::string strategy_combination;
+      const bool use_profiler;
+      const bool forbid_loop_allocations;
+      const bool memory_report;
+      const std::string timeline_file; /*!< "": no timeline */
+      const std::string checkpoint_file; /*!< "": no checkpoint */
+      const size_t checkpoint_frequency; /*!< 0: only upon request (see CheckpointRequest) */
+      IteratePool iterate_pool{}; /*!< Iterates reused across solves */
+      bool has_solved{false};
+      const CancellationToken* cancellation_token{nullptr};
+      double objective_cutoff; /*!< objective of the incumbent of a branch and bound (inf: no cutoff) */
+      std::unique_ptr<ThreadPool> thread_pool; /*!< nullptr: no pool, or the pool installed by the caller is used */
+
+      Result optimize(const Model& model, Iterate& current_iterate, const Options& options, UserCallbacks& user_callbacks, bool same_structure,
+            CheckpointReader* checkpoint);
 
       void initialize(Statistics& statistics, Iterate& current_iterate, const Options& options);
-      [[nodiscard]] static Statistics create_statistics(const Model& model, const Options& options);
-      [[nodiscard]] bool termination_criteria(IterateStatus current_status, size_t iteration, double current_time,
+      void save_checkpoint(const Model& model, const Iterate& current_iterate, size_t iteration) const;
+      void read_checkpoint_header(CheckpointReader& reader, const Model& model) const;
+      [[nodiscard]] size_t load_checkpoint(CheckpointReader& reader, Iterate& current_iterate);
+      [[nodiscard]] bool termination_criteria(const Iterate& trial_iterate, size_t iteration, double current_time, bool user_termination,
             OptimizationStatus& optimization_status) const;
+      [[nodiscard]] bool is_better(const Iterate& iterate, const Iterate& other_iterate) const;
       static void postprocess_iterate(const Model& model, Iterate& iterate, IterateStatus termination_status);
+      [[nodiscard]] std::vector<MemoryUsage> report_memory(const Iterate& current_iterate) const;
       [[nodiscard]] Result create_result(const Model& model, OptimizationStatus optimization_status, Iterate& current_iterate,
-            size_t major_iterations, const Timer& timer);
+            size_t major_iterations, const Timer& timer, const EvaluationCounters& evaluation_counters,
+            const Profiler& profiler, size_t initial_number_subproblems_solved, size_t initial_number_factorizations,
+            size_t initial_number_hessian_evaluations, const FactorizationStatistics& initial_factorization_statistics);
+      static void record_solve_metrics(MetricsRegistry& metrics_registry, const Result& result, double evaluation_time);
    };
 } // namespace
 
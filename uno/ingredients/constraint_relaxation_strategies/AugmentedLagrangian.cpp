@@ -0,0 +1,276 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "AugmentedLagrangian.hpp"
+#include "ingredients/globalization_strategies/GlobalizationStrategy.hpp"
+#include "ingredients/globalization_strategies/ProgressMeasures.hpp"
+#include "ingredients/inequality_handling_methods/InequalityHandlingMethod.hpp"
+#include "ingredients/inequality_handling_methods/InequalityHandlingMethodFactory.hpp"
+#include "model/Model.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Expression.hpp"
+#include "tools/Checkpoint.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Profiler.hpp"
+#include "tools/Statistics.hpp"
+#include "tools/UserCallbacks.hpp"
+
+/*
+ * A globally convergent augmented Lagrangian algorithm for optimization with general constraints and simple bounds
+ * Andrew R. Conn, Nicholas I. M. Gould and Philippe L. Toint
+ * https://doi.org/10.1137/0728030
+ */
+
+namespace uno {
+   AugmentedLagrangian::AugmentedLagrangian(const Model& model, const Options& options) :
+         // the subproblems have one slack per constraint and no general constraints
+         ConstraintRelaxationStrategy(model, model.number_variables + model.number_constraints, 0,
+               model.number_objective_gradient_nonzeros() + model.number_jacobian_nonzeros() + model.number_constraints, 0,
+               // the Hessian sparsity is only requested if the subproblems use the Hessian
+               InequalityHandlingMethodFactory::uses_lagrangian_hessian(0, options) ? model.number_hessian_nonzeros() : 0, options),
+         augmented_lagrangian_problem(model, options.get_double("AL_initial_penalty_parameter")),
+         optimality_problem(model),
+         parameters({
+               options.get_double("AL_initial_penalty_parameter"),
+               options.get_double("AL_penalty_increase_factor"),
+               options.get_double("AL_max_penalty_parameter")
+         }),
+         tolerance(options.get_double("tolerance")),
+         augmented_lagrangian_gradient(this->augmented_lagrangian_problem.number_variables),
+         updated_multipliers(model.number_constraints) {
+      if (this->parameters.initial_penalty_parameter <= 0.) {
+         throw std::invalid_argument("The option AL_initial_penalty_parameter should be positive");
+      }
+      if (this->parameters.penalty_increase_factor <= 1.) {
+         throw std::invalid_argument("The option AL_penalty_increase_factor should be greater than 1");
+      }
+   }
+
+   void AugmentedLagrangian::initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) {
+      // a new solve starts with the initial penalty parameter and the initial multipliers
+      this->augmented_lagrangian_problem.set_penalty_parameter(this->parameters.initial_penalty_parameter);
+      this->augmented_lagrangian_problem.set_multiplier_estimates(initial_iterate.multipliers.constraints);
+      this->constraint_tolerance = 1. / std::pow(this->parameters.initial_penalty_parameter, 0.1);
+      this->subproblem_tolerance = 1. / this->parameters.initial_penalty_parameter;
+      this->reset_early_termination();
+
+      // statistics
+      this->inequality_handling_method->initialize_statistics(statistics, options);
+      statistics.add_column("penalty", Statistics::double_width - 5, options.get_int("statistics_penalty_parameter_column_order"));
+      statistics.set("penalty", this->augmented_lagrangian_problem.get_penalty_parameter());
+
+      // initial iterate: the slacks are the projections of the constraints onto their bounds
+      initial_iterate.set_number_variables(this->augmented_lagrangian_problem.number_variables);
+      initial_iterate.feasibility_residuals.lagrangian_gradient.resize(this->augmented_lagrangian_problem.number_variables);
+      initial_iterate.feasibility_multipliers.lower_bounds.resize(this->augmented_lagrangian_problem.number_variables);
+      initial_iterate.feasibility_multipliers.upper_bounds.resize(this->augmented_lagrangian_problem.number_variables);
+      this->augmented_lagrangian_problem.set_slack_values(initial_iterate);
+      this->inequality_handling_method->forget_hessian_evaluation();
+      this->inequality_handling_method->generate_initial_iterate(statistics, this->augmented_lagrangian_problem, initial_iterate);
+      this->evaluate_progress_measures(initial_iterate);
+      this->compute_primal_dual_residuals(initial_iterate);
+      this->set_statistics(statistics, initial_iterate);
+      this->globalization_strategy->reset();
+      this->globalization_strategy->initialize(statistics, initial_iterate, options);
+   }
+
+   void AugmentedLagrangian::compute_feasible_direction(Statistics& statistics, Iterate& current_iterate, Direction& direction,
+         WarmstartInformation& warmstart_information) {
+      this->update_parameters(statistics, current_iterate);
+      statistics.set("penalty", this->augmented_lagrangian_problem.get_penalty_parameter());
+      direction.reset();
+      this->solve_subproblem(statistics, current_iterate, direction, warmstart_information);
+   }
+
+   // the problem is abandoned when the penalty parameter cannot be increased any more
+   bool AugmentedLagrangian::solving_feasibility_problem() const {
+      return (this->parameters.max_penalty_parameter <= this->augmented_lagrangian_problem.get_penalty_parameter());
+   }
+
+   // the line search failed: the penalty parameter is increased and the subproblem is solved again
+   void AugmentedLagrangian::switch_to_feasibility_problem(Statistics& statistics, Iterate& current_iterate,
+         WarmstartInformation& warmstart_information) {
+      this->increase_penalty_parameter();
+      DEBUG << "Line search failure: the penalty parameter is increased to " << this->augmented_lagrangian_problem.get_penalty_parameter() << '\n';
+      this->globalization_strategy->reset();
+      this->evaluate_progress_measures(current_iterate);
+      statistics.set("penalty", this->augmented_lagrangian_problem.get_penalty_parameter());
+      warmstart_information.only_objective_changed();
+   }
+
+   // outer iteration: once the subproblem is solved to the current tolerance, the multipliers or the penalty parameter are updated
+   void AugmentedLagrangian::update_parameters(Statistics& statistics, Iterate& current_iterate) {
+      this->augmented_lagrangian_problem.evaluate_objective_gradient(current_iterate, this->augmented_lagrangian_gradient);
+      if (this->subproblem_tolerance < this->projected_gradient_norm(current_iterate)) {
+         return;
+      }
+      const double penalty_parameter = this->augmented_lagrangian_problem.get_penalty_parameter();
+      if (this->augmented_lagrangian_problem.slack_residual_norm(current_iterate) <= this->constraint_tolerance) {
+         // first-order multiplier update: the shifted multipliers of the last gradient evaluation
+         this->augmented_lagrangian_problem.compute_shifted_multipliers(current_iterate, this->updated_multipliers);
+         this->augmented_lagrangian_problem.set_multiplier_estimates(this->updated_multipliers);
+         this->constraint_tolerance = std::max(this->constraint_tolerance / std::pow(penalty_parameter, 0.9), this->tolerance);
+         this->subproblem_tolerance = std::max(this->subproblem_tolerance / penalty_parameter, this->tolerance);
+         DEBUG << "Multiplier update, new tolerances eta = " << this->constraint_tolerance << " and omega = " << this->subproblem_tolerance << '\n';
+         statistics.set("status", "multiplier update");
+      }
+      else {
+         this->increase_penalty_parameter();
+         DEBUG << "Penalty parameter increased to " << this->augmented_lagrangian_problem.get_penalty_parameter() << '\n';
+         statistics.set("status", "penalty update");
+      }
+      // the globalization strategy is restarted on the new subproblem
+      this->inequality_handling_method->subproblem_definition_changed = true;
+      this->globalization_strategy->reset();
+      this->evaluate_progress_measures(current_iterate);
+      this->augmented_lagrangian_problem.evaluate_objective_gradient(current_iterate, this->augmented_lagrangian_gradient);
+   }
+
+   void AugmentedLagrangian::increase_penalty_parameter() {
+      const double penalty_parameter = std::min(this->parameters.penalty_increase_factor * this->augmented_lagrangian_problem.get_penalty_parameter(),
+            this->parameters.max_penalty_parameter);
+      this->augmented_lagrangian_problem.set_penalty_parameter(penalty_parameter);
+      this->constraint_tolerance = std::max(1. / std::pow(penalty_parameter, 0.1), this->tolerance);
+      this->subproblem_tolerance = std::max(1. / penalty_parameter, this->tolerance);
+      this->inequality_handling_method->subproblem_definition_changed = true;
+   }
+
+   // ||P(z - nabla phi(z)) - z||_inf, where P is the projection onto the bounds
+   double AugmentedLagrangian::projected_gradient_norm(const Iterate& current_iterate) const {
+      double projected_gradient_norm = 0.;
+      for (const auto [variable_index, derivative]: this->augmented_lagrangian_gradient) {
+         const double projected_point = std::min(std::max(current_iterate.primals[variable_index] - derivative,
+            this->augmented_lagrangian_problem.variable_lower_bound(variable_index)),
+            this->augmented_lagrangian_problem.variable_upper_bound(variable_index));
+         projected_gradient_norm = std::max(projected_gradient_norm, std::abs(projected_point - current_iterate.primals[variable_index]));
+      }
+      return projected_gradient_norm;
+   }
+
+   void AugmentedLagrangian::solve_subproblem(Statistics& statistics, Iterate& current_iterate, Direction& direction,
+         WarmstartInformation& warmstart_information) {
+      DEBUG << "Solving the augmented Lagrangian subproblem with penalty parameter " << this->augmented_lagrangian_problem.get_penalty_parameter() << "\n\n";
+      direction.set_dimensions(this->augmented_lagrangian_problem.number_variables, this->augmented_lagrangian_problem.number_constraints);
+      const ScopedTimer subproblem_timer("subproblem");
+      this->inequality_handling_method->solve(statistics, this->augmented_lagrangian_problem, current_iterate, current_iterate.multipliers, direction,
+            warmstart_information);
+      if (direction.status == SubproblemStatus::UNBOUNDED_PROBLEM) {
+         throw std::runtime_error("AugmentedLagrangian::solve_subproblem: the subproblem is unbounded, this should not happen. If the subproblem "
+            "has curvature, use regularization. If not, use a trust-region method.\n");
+      }
+      direction.norm = norm_inf(direction.primals);
+      DEBUG3 << direction << '\n';
+
+      // the predicted reduction of the augmented Lagrangian only depends on the direction
+      this->directional_derivative = dot(direction.primals, this->augmented_lagrangian_gradient);
+      this->quadratic_term = this->first_order_predicted_reduction ? 0. :
+         this->inequality_handling_method->hessian_quadratic_product(direction.primals);
+   }
+
+   bool AugmentedLagrangian::is_iterate_acceptable(Statistics& statistics, Iterate& current_iterate, Iterate& trial_iterate, const Direction& direction,
+         double step_length, WarmstartInformation& /*warmstart_information*/, UserCallbacks& user_callbacks) {
+      this->inequality_handling_method->postprocess_iterate(this->augmented_lagrangian_problem, trial_iterate);
+      trial_iterate.objective_multiplier = 1.;
+      // the progress measures of the current iterate were recomputed when the parameters were updated
+      this->inequality_handling_method->subproblem_definition_changed = false;
+      this->evaluate_progress_measures(trial_iterate);
+
+      bool accept_iterate = false;
+      if (direction.norm == 0.) {
+         DEBUG << "Zero step acceptable\n";
+         accept_iterate = true;
+         statistics.set("status", "0 primal step");
+      }
+      else {
+         // invoke the globalization strategy for acceptance
+         const double derivative = this->directional_derivative;
+         const double quadratic = this->quadratic_term;
+         const ProgressMeasures predicted_reduction = {
+            0.,
+            {-step_length * step_length / 2. * quadratic, -step_length * derivative},
+            this->inequality_handling_method->compute_predicted_auxiliary_reduction_model(this->model, current_iterate, direction.primals, step_length)
+         };
+         accept_iterate = this->globalization_strategy->is_iterate_acceptable(statistics, current_iterate.progress, trial_iterate.progress,
+               predicted_reduction, 1.);
+      }
+      if (accept_iterate) {
+         user_callbacks.notify_acceptable_iterate(trial_iterate.primals, trial_iterate.multipliers, 1.);
+      }
+      this->set_progress_statistics(statistics, trial_iterate);
+      // the progress measures do not contain the constraint violation
+      if (this->model.is_constrained()) {
+         statistics.set("primal feas", this->model.constraint_violation(trial_iterate.evaluations.constraints, this->progress_norm));
+      }
+      return accept_iterate;
+   }
+
+   // the constraint multipliers of the original problem are the shifted multipliers lambda - mu (c(x) - s)
+   void AugmentedLagrangian::compute_primal_dual_residuals(Iterate& iterate) {
+      this->augmented_lagrangian_problem.compute_shifted_multipliers(iterate, iterate.multipliers.constraints);
+      ConstraintRelaxationStrategy::compute_primal_dual_residuals(this->optimality_problem, iterate);
+   }
+
+   // at an infeasible stationary point of the augmented Lagrangian, J^T (c(x) - s) - z/mu vanishes as mu grows: the feasibility
+   // multipliers are estimated from the constraint residuals and the scaled bound multipliers
+   void AugmentedLagrangian::compute_feasibility_residuals(Iterate& iterate) const {
+      if (iterate.are_feasibility_residuals_computed) {
+         return;
+      }
+      iterate.evaluate_constraints(this->model);
+      const double penalty_parameter = this->augmented_lagrangian_problem.get_penalty_parameter();
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         iterate.feasibility_multipliers.constraints[constraint_index] = iterate.primals[this->model.number_variables + constraint_index] -
+            iterate.evaluations.constraints[constraint_index];
+      }
+      for (size_t variable_index: Range(this->model.number_variables)) {
+         iterate.feasibility_multipliers.lower_bounds[variable_index] = iterate.multipliers.lower_bounds[variable_index] / penalty_parameter;
+         iterate.feasibility_multipliers.upper_bounds[variable_index] = iterate.multipliers.upper_bounds[variable_index] / penalty_parameter;
+      }
+      ConstraintRelaxationStrategy::compute_feasibility_residuals(this->optimality_problem, iterate);
+   }
+
+   // the objective measure is the augmented Lagrangian, the subproblems have no constraints
+   void AugmentedLagrangian::evaluate_progress_measures(Iterate& iterate) const {
+      iterate.progress.infeasibility = 0.;
+      const double augmented_lagrangian = this->augmented_lagrangian_problem.evaluate_augmented_lagrangian(iterate);
+      iterate.progress.objective = ObjectiveMeasure::scaled(augmented_lagrangian);
+      this->inequality_handling_method->set_auxiliary_measure(this->model, iterate);
+   }
+
+   size_t AugmentedLagrangian::maximum_number_variables() const {
+      return this->augmented_lagrangian_problem.number_variables;
+   }
+
+   // the iterates carry the multipliers of the original constraints
+   size_t AugmentedLagrangian::maximum_number_constraints() const {
+      return this->model.number_constraints;
+   }
+
+   void AugmentedLagrangian::set_dual_residuals_statistics(Statistics& statistics, const Iterate& iterate) const {
+      statistics.set("stationarity", iterate.residuals.stationarity);
+      statistics.set("complementarity", iterate.residuals.complementarity);
+   }
+
+   void AugmentedLagrangian::save_state(CheckpointWriter& writer) const {
+      writer.write(this->augmented_lagrangian_problem.get_penalty_parameter());
+      writer.write(this->constraint_tolerance);
+      writer.write(this->subproblem_tolerance);
+      writer.write(this->augmented_lagrangian_problem.get_multiplier_estimates());
+      ConstraintRelaxationStrategy::save_state(writer);
+   }
+
+   void AugmentedLagrangian::load_state(CheckpointReader& reader, Iterate& current_iterate) {
+      this->augmented_lagrangian_problem.set_penalty_parameter(reader.read_double());
+      this->constraint_tolerance = reader.read_double();
+      this->subproblem_tolerance = reader.read_double();
+      reader.read(this->updated_multipliers);
+      this->augmented_lagrangian_problem.set_multiplier_estimates(this->updated_multipliers);
+      ConstraintRelaxationStrategy::load_state(reader, current_iterate);
+   }
+} // namespace
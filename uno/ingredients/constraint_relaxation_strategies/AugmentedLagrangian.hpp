@@ -0,0 +1,76 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_AUGMENTEDLAGRANGIAN_H
+#define UNO_AUGMENTEDLAGRANGIAN_H
+
+#include "ConstraintRelaxationStrategy.hpp"
+#include "AugmentedLagrangianProblem.hpp"
+#include "OptimalityProblem.hpp"
+#include "linear_algebra/SparseVector.hpp"
+
+namespace uno {
+   struct AugmentedLagrangianParameters {
+      double initial_penalty_parameter;
+      double penalty_increase_factor;
+      double max_penalty_parameter;
+   };
+
+   /*! \class AugmentedLagrangian
+    * \brief Bound-constrained augmented Lagrangian method (LANCELOT-style first-order multiplier updates)
+    *
+    *  The subproblems are the bound-constrained augmented Lagrangian problems, whose inner iterations are the iterations of the
+    *  globalization mechanism. Once the projected gradient of the augmented Lagrangian is below the inner tolerance omega, the
+    *  multipliers are updated (lambda <- lambda - mu (c(x) - s)) if the constraint residual is below the tolerance eta, otherwise
+    *  the penalty parameter mu is increased (Conn, Gould and Toint, 1991)
+    */
+   class AugmentedLagrangian : public ConstraintRelaxationStrategy {
+   public:
+      AugmentedLagrangian(const Model& model, const Options& options);
+
+      void initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) override;
+
+      [[nodiscard]] size_t maximum_number_variables() const override;
+      [[nodiscard]] size_t maximum_number_constraints() const override;
+
+      // direction computation
+      void compute_feasible_direction(Statistics& statistics, Iterate& current_iterate, Direction& direction,
+            WarmstartInformation& warmstart_information) override;
+      [[nodiscard]] bool solving_feasibility_problem() const override;
+      void switch_to_feasibility_problem(Statistics& statistics, Iterate& current_iterate, WarmstartInformation& warmstart_information) override;
+
+      // trial iterate acceptance
+      [[nodiscard]] bool is_iterate_acceptable(Statistics& statistics, Iterate& current_iterate, Iterate& trial_iterate, const Direction& direction,
+            double step_length, WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) override;
+
+      // primal-dual residuals
+      void compute_primal_dual_residuals(Iterate& iterate) override;
+      void compute_feasibility_residuals(Iterate& iterate) const override;
+      void set_dual_residuals_statistics(Statistics& statistics, const Iterate& iterate) const override;
+
+      void save_state(CheckpointWriter& writer) const override;
+      void load_state(CheckpointReader& reader, Iterate& current_iterate) override;
+
+   protected:
+      AugmentedLagrangianProblem augmented_lagrangian_problem;
+      const OptimalityProblem optimality_problem;
+      const AugmentedLagrangianParameters parameters;
+      const double tolerance;
+      double constraint_tolerance{1.}; /*!< eta: tolerance on the constraint residual for a multiplier update */
+      double subproblem_tolerance{1.}; /*!< omega: tolerance on the projected gradient of the augmented Lagrangian */
+      // gradient of the augmented Lagrangian at the current iterate and derivative along the direction
+      SparseVector<double> augmented_lagrangian_gradient;
+      double directional_derivative{0.};
+      double quadratic_term{0.};
+      // preallocated multiplier estimates
+      Vector<double> updated_multipliers;
+
+      void update_parameters(Statistics& statistics, Iterate& current_iterate);
+      void increase_penalty_parameter();
+      [[nodiscard]] double projected_gradient_norm(const Iterate& current_iterate) const;
+      void solve_subproblem(Statistics& statistics, Iterate& current_iterate, Direction& direction, WarmstartInformation& warmstart_information);
+      void evaluate_progress_measures(Iterate& iterate) const override;
+   };
+} // namespace
+
+#endif // UNO_AUGMENTEDLAGRANGIAN_H
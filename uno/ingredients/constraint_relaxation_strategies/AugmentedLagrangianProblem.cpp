@@ -0,0 +1,234 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include "AugmentedLagrangianProblem.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/LagrangianGradient.hpp"
+#include "symbolic/Expression.hpp"
+#include "symbolic/VectorExpression.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   AugmentedLagrangianProblem::AugmentedLagrangianProblem(const Model& model, double penalty_parameter):
+         // the slacks of the constraints are additional variables
+         OptimizationProblem(model, model.number_variables + model.number_constraints, 0),
+         penalty_parameter(penalty_parameter),
+         multiplier_estimates(model.number_constraints),
+         lower_bounded_variables_collection(this->lower_bounded_variables),
+         upper_bounded_variables_collection(this->upper_bounded_variables),
+         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
+         single_upper_bounded_variables_collection(this->single_upper_bounded_variables),
+         shifted_multipliers(model.number_constraints),
+         dense_gradient(model.number_variables),
+         slack_residuals(model.number_constraints) {
+      for (size_t variable_index: model.get_lower_bounded_variables()) {
+         this->lower_bounded_variables.emplace_back(variable_index);
+      }
+      for (size_t variable_index: model.get_upper_bounded_variables()) {
+         this->upper_bounded_variables.emplace_back(variable_index);
+      }
+      for (size_t variable_index: model.get_single_lower_bounded_variables()) {
+         this->single_lower_bounded_variables.emplace_back(variable_index);
+      }
+      for (size_t variable_index: model.get_single_upper_bounded_variables()) {
+         this->single_upper_bounded_variables.emplace_back(variable_index);
+      }
+      // the slacks take the bounds of the constraints
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         const size_t slack_index = model.number_variables + constraint_index;
+         const bool has_lower_bound = is_finite(model.constraint_lower_bound(constraint_index));
+         const bool has_upper_bound = is_finite(model.constraint_upper_bound(constraint_index));
+         if (has_lower_bound) {
+            this->lower_bounded_variables.emplace_back(slack_index);
+            if (!has_upper_bound) {
+               this->single_lower_bounded_variables.emplace_back(slack_index);
+            }
+         }
+         if (has_upper_bound) {
+            this->upper_bounded_variables.emplace_back(slack_index);
+            if (!has_lower_bound) {
+               this->single_upper_bounded_variables.emplace_back(slack_index);
+            }
+         }
+      }
+   }
+
+   // gradient of the augmented Lagrangian (nabla f(x) - J(x)^T y, y) with the shifted multipliers y = lambda - mu (c(x) - s)
+   void AugmentedLagrangianProblem::evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const {
+      this->accumulate_gradient(iterate, 1.);
+      objective_gradient.clear();
+      for (size_t variable_index: Range(this->model.number_variables)) {
+         objective_gradient.insert(variable_index, this->dense_gradient[variable_index]);
+      }
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         objective_gradient.insert(this->model.number_variables + constraint_index, this->shifted_multipliers[constraint_index]);
+      }
+      // the Hessian-vector products are evaluated at this point
+      this->hessian_jacobian = &iterate.evaluations.constraint_jacobian;
+   }
+
+   void AugmentedLagrangianProblem::evaluate_constraints(Iterate& /*iterate*/, std::vector<double>& /*constraints*/) const {
+      // no general constraints
+   }
+
+   void AugmentedLagrangianProblem::evaluate_constraint_jacobian(Iterate& /*iterate*/, RectangularMatrixView<double>& /*constraint_jacobian*/) const {
+      // no general constraints
+   }
+
+   void AugmentedLagrangianProblem::evaluate_lagrangian_hessian(const Vector<double>& /*x*/, const Vector<double>& /*multipliers*/,
+         SymmetricMatrix<size_t, double>& /*hessian*/) const {
+      throw std::runtime_error("The Hessian of the augmented Lagrangian is only available through Hessian-vector products");
+   }
+
+   // (nabla^2 L(x, y) v_x + mu J^T (J v_x - v_s), -mu (J v_x - v_s))
+   void AugmentedLagrangianProblem::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& /*multipliers*/,
+         const Vector<double>& vector, Vector<double>& result) const {
+      assert(this->hessian_jacobian != nullptr && "AugmentedLagrangianProblem: the gradient was not evaluated");
+      this->model.evaluate_lagrangian_hessian_vector_product(x, 1., this->shifted_multipliers, vector, result);
+      jacobian_product(*this->hessian_jacobian, vector, this->slack_residuals);
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         this->slack_residuals[constraint_index] -= vector[this->model.number_variables + constraint_index];
+      }
+      add_jacobian_transposed_product(*this->hessian_jacobian, this->slack_residuals, this->penalty_parameter, result);
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         result[this->model.number_variables + constraint_index] = -this->penalty_parameter * this->slack_residuals[constraint_index];
+      }
+   }
+
+   double AugmentedLagrangianProblem::variable_lower_bound(size_t variable_index) const {
+      if (variable_index < this->model.number_variables) { // model variable
+         return this->model.variable_lower_bound(variable_index);
+      }
+      else { // slack
+         return this->model.constraint_lower_bound(variable_index - this->model.number_variables);
+      }
+   }
+
+   double AugmentedLagrangianProblem::variable_upper_bound(size_t variable_index) const {
+      if (variable_index < this->model.number_variables) { // model variable
+         return this->model.variable_upper_bound(variable_index);
+      }
+      else { // slack
+         return this->model.constraint_upper_bound(variable_index - this->model.number_variables);
+      }
+   }
+
+   double AugmentedLagrangianProblem::constraint_lower_bound(size_t /*constraint_index*/) const {
+      return -INF<double>;
+   }
+
+   double AugmentedLagrangianProblem::constraint_upper_bound(size_t /*constraint_index*/) const {
+      return INF<double>;
+   }
+
+   size_t AugmentedLagrangianProblem::number_objective_gradient_nonzeros() const {
+      // the gradient is dense in the model variables that appear in the objective or the constraints
+      return std::min(this->model.number_variables, this->model.number_objective_gradient_nonzeros() + this->model.number_jacobian_nonzeros()) +
+         this->model.number_constraints;
+   }
+
+   // Lagrangian gradient split in two parts: objective contribution (gradient of the augmented Lagrangian) and bound multipliers
+   void AugmentedLagrangianProblem::evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate,
+         const Multipliers& multipliers) const {
+      this->accumulate_gradient(iterate, 1.);
+      for (size_t variable_index: Range(this->model.number_variables)) {
+         lagrangian_gradient.objective_contribution[variable_index] = this->dense_gradient[variable_index];
+      }
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         lagrangian_gradient.objective_contribution[this->model.number_variables + constraint_index] = this->shifted_multipliers[constraint_index];
+      }
+      lagrangian_gradient.constraints_contribution.fill(0.);
+      this->subtract_bound_multipliers(multipliers, lagrangian_gradient.constraints_contribution);
+   }
+
+   double AugmentedLagrangianProblem::evaluate_stationarity_error(Vector<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers,
+         double objective_multiplier, Norm residual_norm) const {
+      this->accumulate_gradient(iterate, objective_multiplier);
+      for (size_t variable_index: Range(this->number_variables)) {
+         lagrangian_gradient[variable_index] = (variable_index < this->model.number_variables) ? this->dense_gradient[variable_index] :
+            this->shifted_multipliers[variable_index - this->model.number_variables];
+      }
+      this->subtract_bound_multipliers(multipliers, lagrangian_gradient);
+      return fused_norm(residual_norm, this->number_variables, [&](size_t variable_index) {
+         return lagrangian_gradient[variable_index];
+      });
+   }
+
+   // complementary slackness error of the bound constraints (model variables and slacks)
+   double AugmentedLagrangianProblem::complementarity_error(const Vector<double>& primals, const std::vector<double>& /*constraints*/,
+         const Multipliers& multipliers, double shift_value, Norm residual_norm) const {
+      return fused_norm(residual_norm, [&](const auto& accumulate) {
+         this->sweep_bound_complementarity(primals, multipliers, shift_value, accumulate);
+      });
+   }
+
+   // f(x) - lambda^T (c(x) - s) + mu/2 ||c(x) - s||^2
+   double AugmentedLagrangianProblem::evaluate_augmented_lagrangian(Iterate& iterate) const {
+      iterate.evaluate_objective(this->model);
+      iterate.evaluate_constraints(this->model);
+      double augmented_lagrangian = iterate.evaluations.objective;
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         const double residual = iterate.evaluations.constraints[constraint_index] - iterate.primals[this->model.number_variables + constraint_index];
+         augmented_lagrangian += residual * (-this->multiplier_estimates[constraint_index] + 0.5 * this->penalty_parameter * residual);
+      }
+      return augmented_lagrangian;
+   }
+
+   void AugmentedLagrangianProblem::compute_shifted_multipliers(Iterate& iterate, Vector<double>& shifted_multipliers) const {
+      iterate.evaluate_constraints(this->model);
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         const double residual = iterate.evaluations.constraints[constraint_index] - iterate.primals[this->model.number_variables + constraint_index];
+         shifted_multipliers[constraint_index] = this->multiplier_estimates[constraint_index] - this->penalty_parameter * residual;
+      }
+   }
+
+   double AugmentedLagrangianProblem::slack_residual_norm(Iterate& iterate) const {
+      iterate.evaluate_constraints(this->model);
+      double residual_norm = 0.;
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         residual_norm = std::max(residual_norm, std::abs(iterate.evaluations.constraints[constraint_index] -
+            iterate.primals[this->model.number_variables + constraint_index]));
+      }
+      return residual_norm;
+   }
+
+   void AugmentedLagrangianProblem::set_slack_values(Iterate& iterate) const {
+      iterate.evaluate_constraints(this->model);
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         iterate.primals[this->model.number_variables + constraint_index] = std::min(std::max(iterate.evaluations.constraints[constraint_index],
+               this->model.constraint_lower_bound(constraint_index)), this->model.constraint_upper_bound(constraint_index));
+      }
+   }
+
+   void AugmentedLagrangianProblem::set_penalty_parameter(double new_penalty_parameter) {
+      assert(0. < new_penalty_parameter && "The penalty parameter should be positive");
+      this->penalty_parameter = new_penalty_parameter;
+   }
+
+   void AugmentedLagrangianProblem::set_multiplier_estimates(const Vector<double>& new_multiplier_estimates) {
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         this->multiplier_estimates[constraint_index] = new_multiplier_estimates[constraint_index];
+      }
+   }
+
+   // dense_gradient = objective_multiplier nabla f(x) - J(x)^T y and shifted_multipliers = y
+   void AugmentedLagrangianProblem::accumulate_gradient(Iterate& iterate, double objective_multiplier) const {
+      iterate.evaluate_objective_gradient(this->model);
+      iterate.evaluate_constraint_jacobian(this->model);
+      this->compute_shifted_multipliers(iterate, this->shifted_multipliers);
+      this->dense_gradient.fill(0.);
+      if (objective_multiplier != 0.) {
+         for (const auto [variable_index, derivative]: iterate.evaluations.objective_gradient) {
+            this->dense_gradient[variable_index] += objective_multiplier * derivative;
+         }
+      }
+      add_jacobian_transposed_product(iterate.evaluations.constraint_jacobian, this->shifted_multipliers, -1., this->dense_gradient);
+   }
+} // namespace
@@ -0,0 +1,97 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_AUGMENTEDLAGRANGIANPROBLEM_H
+#define UNO_AUGMENTEDLAGRANGIANPROBLEM_H
+
+#include <vector>
+#include "OptimizationProblem.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+
+namespace uno {
+   /*! \class AugmentedLagrangianProblem
+    * \brief Bound-constrained augmented Lagrangian subproblem
+    *
+    *  min_{x, s} f(x) - lambda^T (c(x) - s) + mu/2 ||c(x) - s||^2 s.t. x_L <= x <= x_U, c_L <= s <= c_U.
+    *  The slacks s (one per constraint, stored after the model variables) take the constraint bounds, so that the problem has
+    *  no general constraints. The Hessian is only available through Hessian-vector products
+    *  (nabla^2 L(x, y) + mu J^T J, with the shifted multipliers y = lambda - mu (c(x) - s)), evaluated at the point of the last gradient
+    *  evaluation
+    */
+   class AugmentedLagrangianProblem: public OptimizationProblem {
+   public:
+      AugmentedLagrangianProblem(const Model& model, double penalty_parameter);
+
+      [[nodiscard]] double get_objective_multiplier() const override { return 1.; }
+      void evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const override;
+      void evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const override;
+      void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrixView<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers, SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& multipliers, const Vector<double>& vector,
+            Vector<double>& result) const override;
+      [[nodiscard]] bool has_constant_hessian() const override { return false; }
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->lower_bounded_variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override {
+         return this->single_lower_bounded_variables_collection;
+      }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+         return this->single_upper_bounded_variables_collection;
+      }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override;
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 0; }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->model.number_hessian_nonzeros(); }
+
+      void evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers) const override;
+      [[nodiscard]] double evaluate_stationarity_error(Vector<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers,
+            double objective_multiplier, Norm residual_norm) const override;
+      [[nodiscard]] double complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
+            const Multipliers& multipliers, double shift_value, Norm residual_norm) const override;
+
+      // augmented Lagrangian function
+      [[nodiscard]] double evaluate_augmented_lagrangian(Iterate& iterate) const;
+      // y = lambda - mu (c(x) - s)
+      void compute_shifted_multipliers(Iterate& iterate, Vector<double>& shifted_multipliers) const;
+      // ||c(x) - s||_inf
+      [[nodiscard]] double slack_residual_norm(Iterate& iterate) const;
+      // s = projection of c(x) onto [c_L, c_U]
+      void set_slack_values(Iterate& iterate) const;
+
+      // parameterization
+      [[nodiscard]] double get_penalty_parameter() const { return this->penalty_parameter; }
+      void set_penalty_parameter(double new_penalty_parameter);
+      [[nodiscard]] const Vector<double>& get_multiplier_estimates() const { return this->multiplier_estimates; }
+      void set_multiplier_estimates(const Vector<double>& new_multiplier_estimates);
+
+   protected:
+      double penalty_parameter;
+      Vector<double> multiplier_estimates;
+      std::vector<size_t> lower_bounded_variables{};
+      std::vector<size_t> upper_bounded_variables{};
+      std::vector<size_t> single_lower_bounded_variables{};
+      std::vector<size_t> single_upper_bounded_variables{};
+      const CollectionAdapter<std::vector<size_t>> lower_bounded_variables_collection;
+      const CollectionAdapter<std::vector<size_t>> upper_bounded_variables_collection;
+      const CollectionAdapter<std::vector<size_t>> single_lower_bounded_variables_collection;
+      const CollectionAdapter<std::vector<size_t>> single_upper_bounded_variables_collection;
+
+      // point of the Hessian-vector products: shifted multipliers and Jacobian of the last gradient evaluation
+      mutable Vector<double> shifted_multipliers;
+      mutable const RectangularMatrix<double>* hessian_jacobian{nullptr};
+      // preallocated dense gradient and residual of the slacks
+      mutable Vector<double> dense_gradient;
+      mutable Vector<double> slack_residuals;
+
+      void accumulate_gradient(Iterate& iterate, double objective_multiplier) const;
+   };
+} // namespace
+
+#endif // UNO_AUGMENTEDLAGRANGIANPROBLEM_H
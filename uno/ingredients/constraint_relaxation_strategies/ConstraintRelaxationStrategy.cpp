@@ -1,6 +1,9 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include "ConstraintRelaxationStrategy.hpp"
 #include "OptimizationProblem.hpp"
 #include "ingredients/globalization_strategies/GlobalizationStrategy.hpp"
@@ -8,6 +11,7 @@
 #include "optimization/Direction.hpp"
 #include "ingredients/inequality_handling_methods/InequalityHandlingMethod.hpp"
 #include "ingredients/inequality_handling_methods/InequalityHandlingMethodFactory.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "model/Model.hpp"
 #include "optimization/Iterate.hpp"
@@ -15,6 +19,10 @@
 #include "symbolic/VectorView.hpp"
 #include "symbolic/Expression.hpp"
 #include "options/Options.hpp"
+#include "tools/AllocationTracker.hpp"
+#include "tools/Checkpoint.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/MemoryReport.hpp"
 #include "tools/Statistics.hpp"
 
 namespace uno {
@@ -31,7 +39,20 @@ namespace uno {
          loose_tolerance(options.get_double("loose_tolerance")),
          loose_tolerance_consecutive_iteration_threshold(options.get_unsigned_int("loose_tolerance_consecutive_iteration_threshold")),
          unbounded_objective_threshold(options.get_double("unbounded_objective_threshold")),
-         first_order_predicted_reduction(options.get_string("globalization_mechanism") == "LS") {
+         early_termination(options.get_bool("early_termination")),
+         early_termination_window(options.get_unsigned_int("early_termination_window")),
+         early_infeasibility_stall_reduction(options.get_double("early_infeasibility_stall_reduction")),
+         early_infeasibility_tolerance(options.get_double("early_infeasibility_tolerance")),
+         dual_ray_threshold(options.get_double("dual_ray_threshold")),
+         unbounded_divergence_threshold(options.get_double("unbounded_divergence_threshold")),
+         infeasibility_history(this->early_termination_window + 1),
+         objective_history(this->early_termination_window + 1),
+         previous_primals(model.number_variables),
+         first_order_predicted_reduction(options.get_string("globalization_mechanism") == "LS"),
+         linearized_constraints(model.number_constraints) {
+      if (this->early_termination && this->early_termination_window == 0) {
+         throw std::invalid_argument("The option early_termination_window should be positive");
+      }
    }
 
    ConstraintRelaxationStrategy::~ConstraintRelaxationStrategy() { }
@@ -47,6 +68,11 @@ namespace uno {
       this->compute_feasible_direction(statistics, current_iterate, direction, warmstart_information);
    }
 
+   bool ConstraintRelaxationStrategy::compute_second_order_correction(Iterate& /*current_iterate*/, Iterate& /*trial_iterate*/,
+         Direction& /*direction*/) {
+      return false;
+   }
+
    // infeasibility measure: constraint violation
    void ConstraintRelaxationStrategy::set_infeasibility_measure(Iterate& iterate) const {
       iterate.evaluate_constraints(this->model);
@@ -57,42 +83,95 @@ namespace uno {
    void ConstraintRelaxationStrategy::set_objective_measure(Iterate& iterate) const {
       iterate.evaluate_objective(this->model);
       const double objective = iterate.evaluations.objective;
-      iterate.progress.objective = [=](double objective_multiplier) {
-         return objective_multiplier * objective;
-      };
+      iterate.progress.objective = ObjectiveMeasure::scaled(objective);
    }
 
    double ConstraintRelaxationStrategy::compute_predicted_infeasibility_reduction_model(const Iterate& current_iterate,
-         const Vector<double>& primal_direction, double step_length) const {
+         const Direction& direction, double step_length) const {
       // predicted infeasibility reduction: "‖c(x)‖ - ‖c(x) + ∇c(x)^T (αd)‖"
       const double current_constraint_violation = this->model.constraint_violation(current_iterate.evaluations.constraints, this->progress_norm);
-      const double trial_linearized_constraint_violation = this->model.constraint_violation(current_iterate.evaluations.constraints + step_length *
-                                                                                                                                      (current_iterate.evaluations.constraint_jacobian * primal_direction), this->progress_norm);
+      const double trial_linearized_constraint_violation = this->compute_linearized_constraint_violation(current_iterate, direction,
+            step_length, this->progress_norm);
       return current_constraint_violation - trial_linearized_constraint_violation;
    }
 
-   std::function<double(double)> ConstraintRelaxationStrategy::compute_predicted_objective_reduction_model(const Iterate& current_iterate,
-         const Vector<double>& primal_direction, double step_length) const {
-      // predicted objective reduction: "-∇f(x)^T (αd) - α^2/2 d^T H d"
-      const double directional_derivative = dot(primal_direction, current_iterate.evaluations.objective_gradient);
-      const double quadratic_term = this->first_order_predicted_reduction ? 0. : this->inequality_handling_method->hessian_quadratic_product(primal_direction);
-      return [=](double objective_multiplier) {
-         return step_length * (-objective_multiplier*directional_derivative) - step_length*step_length/2. * quadratic_term;
+   ProgressMeasures ConstraintRelaxationStrategy::compute_unit_step_predicted_reductions(const Iterate& current_iterate,
+         const Direction& direction) const {
+      return {
+         this->compute_predicted_infeasibility_reduction_model(current_iterate, direction, 1.),
+         this->compute_predicted_objective_reduction_model(current_iterate, direction, 1.),
+         this->inequality_handling_method->compute_predicted_auxiliary_reduction_model(this->model, current_iterate, direction.primals, 1.)
       };
    }
 
-   void ConstraintRelaxationStrategy::compute_progress_measures(Iterate& current_iterate, Iterate& trial_iterate) {
+   // J d and d^T H d do not depend on the step length: they are computed once per direction (the line search tries several step lengths)
+   void ConstraintRelaxationStrategy::cache_direction_products(const Iterate& current_iterate, const Direction& direction) const {
+      if (!direction.are_products_cached) {
+         jacobian_product(current_iterate.evaluations.constraint_jacobian, direction.primals, direction.jacobian_product);
+         direction.hessian_quadratic_product = this->first_order_predicted_reduction ? 0. :
+            this->inequality_handling_method->hessian_quadratic_product(direction.primals);
+         direction.are_products_cached = true;
+      }
+   }
+
+   // linearized constraint violation: "‖c(x) + α J d‖" with the cached product J d
+   double ConstraintRelaxationStrategy::compute_linearized_constraint_violation(const Iterate& current_iterate, const Direction& direction,
+         double step_length, Norm norm) const {
+      this->cache_direction_products(current_iterate, direction);
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         this->linearized_constraints[constraint_index] = current_iterate.evaluations.constraints[constraint_index] +
+            step_length * direction.jacobian_product[constraint_index];
+      }
+      return this->model.constraint_violation(this->linearized_constraints, norm);
+   }
+
+   // linearized constraint violation: "‖c(x) + ∇c(x)^T (αd)‖"
+   double ConstraintRelaxationStrategy::compute_linearized_constraint_violation(const Iterate& current_iterate, const Vector<double>& primal_direction,
+         double step_length, Norm norm) const {
+      // materialize the Jacobian-direction product once
+      jacobian_product(current_iterate.evaluations.constraint_jacobian, primal_direction, this->linearized_constraints);
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         this->linearized_constraints[constraint_index] = current_iterate.evaluations.constraints[constraint_index] +
+            step_length * this->linearized_constraints[constraint_index];
+      }
+      return this->model.constraint_violation(this->linearized_constraints, norm);
+   }
+
+   ObjectiveMeasure ConstraintRelaxationStrategy::compute_predicted_objective_reduction_model(const Iterate& current_iterate,
+         const Direction& direction, double step_length) const {
+      // predicted objective reduction: "-∇f(x)^T (αd) - α^2/2 d^T H d"
+      // (the objective gradient is not evaluated when the objective does not contribute, e.g. in the restoration phase)
+      const double directional_derivative = current_iterate.is_objective_gradient_computed ?
+         dot(direction.primals, current_iterate.evaluations.objective_gradient) : 0.;
+      this->cache_direction_products(current_iterate, direction);
+      const double quadratic_term = direction.hessian_quadratic_product;
+      return {-step_length*step_length/2. * quadratic_term, -step_length * directional_derivative};
+   }
+
+   // the constraints are evaluated first: a regular trial iterate that the globalization strategy rejects on infeasibility alone is
+   // rejected (return false) without evaluating the objective and the auxiliary measure
+   bool ConstraintRelaxationStrategy::compute_progress_measures(Iterate& current_iterate, Iterate& trial_iterate, const Direction& direction,
+         double objective_multiplier) {
       if (this->inequality_handling_method->subproblem_definition_changed) {
          DEBUG << "The subproblem definition changed, the globalization strategy is reset and the auxiliary measure is recomputed\n";
          this->globalization_strategy->reset();
          this->inequality_handling_method->set_auxiliary_measure(this->model, current_iterate);
          this->inequality_handling_method->subproblem_definition_changed = false;
       }
+      if (direction.norm != 0. && objective_multiplier != 0.) {
+         this->set_infeasibility_measure(trial_iterate);
+         if (!this->globalization_strategy->is_infeasibility_acceptable(trial_iterate.progress.infeasibility)) {
+            DEBUG << "Trial iterate rejected on infeasibility, the objective was not evaluated\n";
+            return false;
+         }
+      }
       this->evaluate_progress_measures(trial_iterate);
+      return true;
    }
 
-   void ConstraintRelaxationStrategy::compute_primal_dual_residuals(const OptimizationProblem& optimality_problem, const OptimizationProblem& feasibility_problem,
-         Iterate& iterate) {
+   void ConstraintRelaxationStrategy::compute_primal_dual_residuals(const OptimizationProblem& optimality_problem, Iterate& iterate) const {
+      // the objective of a trial iterate rejected on infeasibility was not evaluated
+      iterate.evaluate_objective(this->model);
       iterate.evaluate_objective_gradient(this->model);
       iterate.evaluate_constraints(this->model);
       iterate.evaluate_constraint_jacobian(this->model);
@@ -100,13 +179,8 @@ namespace uno {
       // stationarity errors:
       // - for KKT conditions: with standard multipliers and current objective multiplier
       // - for FJ conditions: with standard multipliers and 0 objective multiplier
-      // - for feasibility problem: with feasibility multipliers and 0 objective multiplier
-      optimality_problem.evaluate_lagrangian_gradient(iterate.residuals.lagrangian_gradient, iterate, iterate.multipliers);
-      iterate.residuals.stationarity = OptimizationProblem::stationarity_error(iterate.residuals.lagrangian_gradient, iterate.objective_multiplier,
-            this->residual_norm);
-      feasibility_problem.evaluate_lagrangian_gradient(iterate.feasibility_residuals.lagrangian_gradient, iterate, iterate.feasibility_multipliers);
-      iterate.feasibility_residuals.stationarity = OptimizationProblem::stationarity_error(iterate.feasibility_residuals.lagrangian_gradient, 0.,
-            this->residual_norm);
+      iterate.residuals.stationarity = optimality_problem.evaluate_stationarity_error(iterate.residuals.lagrangian_gradient, iterate,
+            iterate.multipliers, iterate.objective_multiplier, this->residual_norm);
 
       // constraint violation of the original problem
       iterate.primal_feasibility = this->model.constraint_violation(iterate.evaluations.constraints, this->residual_norm);
@@ -115,14 +189,30 @@ namespace uno {
       const double shift_value = 0.;
       iterate.residuals.complementarity = optimality_problem.complementarity_error(iterate.primals, iterate.evaluations.constraints,
             iterate.multipliers, shift_value, this->residual_norm);
-      iterate.feasibility_residuals.complementarity = feasibility_problem.complementarity_error(iterate.primals, iterate.evaluations.constraints,
-            iterate.feasibility_multipliers, shift_value, this->residual_norm);
 
       // scaling factors
       iterate.residuals.stationarity_scaling = this->compute_stationarity_scaling(iterate.multipliers);
       iterate.residuals.complementarity_scaling = this->compute_complementarity_scaling(iterate.multipliers);
+      // the multipliers may have changed: the feasibility residuals are recomputed on demand
+      iterate.are_feasibility_residuals_computed = false;
+   }
+
+   // stationarity error of the feasibility problem: with feasibility multipliers and 0 objective multiplier
+   void ConstraintRelaxationStrategy::compute_feasibility_residuals(const OptimizationProblem& feasibility_problem, Iterate& iterate) const {
+      if (iterate.are_feasibility_residuals_computed) {
+         return;
+      }
+      // the objective does not contribute (0 objective multiplier): its gradient is not needed
+      iterate.evaluate_constraints(this->model);
+      iterate.evaluate_constraint_jacobian(this->model);
+      iterate.feasibility_residuals.stationarity = feasibility_problem.evaluate_stationarity_error(iterate.feasibility_residuals.lagrangian_gradient,
+            iterate, iterate.feasibility_multipliers, 0., this->residual_norm);
+      const double shift_value = 0.;
+      iterate.feasibility_residuals.complementarity = feasibility_problem.complementarity_error(iterate.primals, iterate.evaluations.constraints,
+            iterate.feasibility_multipliers, shift_value, this->residual_norm);
       iterate.feasibility_residuals.stationarity_scaling = this->compute_stationarity_scaling(iterate.feasibility_multipliers);
       iterate.feasibility_residuals.complementarity_scaling = this->compute_complementarity_scaling(iterate.feasibility_multipliers);
+      iterate.are_feasibility_residuals_computed = true;
    }
 
    double ConstraintRelaxationStrategy::compute_stationarity_scaling(const Multipliers& multipliers) const {
@@ -132,11 +222,8 @@ namespace uno {
       }
       else {
          const double scaling_factor = this->residual_scaling_threshold * static_cast<double>(total_size);
-         const double multiplier_norm = norm_1(
-               view(multipliers.constraints, 0, this->model.number_constraints),
-               view(multipliers.lower_bounds, 0, this->model.number_variables),
-               view(multipliers.upper_bounds, 0, this->model.number_variables)
-         );
+         const double multiplier_norm = norm_1(view(multipliers.constraints, 0, this->model.number_constraints)) +
+               this->bound_multipliers_norm_1(multipliers);
          return std::max(1., multiplier_norm / scaling_factor);
       }
    }
@@ -148,15 +235,44 @@ namespace uno {
       }
       else {
          const double scaling_factor = this->residual_scaling_threshold * static_cast<double>(total_size);
-         const double bound_multiplier_norm = norm_1(
-               view(multipliers.lower_bounds, 0, this->model.number_variables),
-               view(multipliers.upper_bounds, 0, this->model.number_variables)
-         );
+         const double bound_multiplier_norm = this->bound_multipliers_norm_1(multipliers);
          return std::max(1., bound_multiplier_norm / scaling_factor);
       }
    }
 
+   // the bound multipliers of the unbounded variables are zero
+   double ConstraintRelaxationStrategy::bound_multipliers_norm_1(const Multipliers& multipliers) const {
+      double result = 0.;
+      this->model.get_lower_bounded_variables().for_each([&](size_t variable_index) {
+         result += std::abs(multipliers.lower_bounds[variable_index]);
+      });
+      this->model.get_upper_bounded_variables().for_each([&](size_t variable_index) {
+         result += std::abs(multipliers.upper_bounds[variable_index]);
+      });
+      return result;
+   }
+
    IterateStatus ConstraintRelaxationStrategy::check_termination(Iterate& iterate) {
+      IterateStatus status = this->check_convergence(iterate);
+      if (status == IterateStatus::INFEASIBLE_STATIONARY_POINT) {
+         this->set_infeasibility_certificate(iterate.feasibility_multipliers, "stationary point", iterate.feasibility_residuals.stationarity);
+      }
+      else if (status == IterateStatus::UNBOUNDED) {
+         this->set_unboundedness_certificate(iterate, "objective threshold");
+      }
+      else if (status == IterateStatus::NOT_OPTIMAL && this->early_termination) {
+         this->record_iterate(iterate);
+         status = this->check_early_termination(iterate);
+      }
+      // the primal ray of an unbounded termination is the last step
+      for (size_t variable_index: Range(this->model.number_variables)) {
+         this->previous_primals[variable_index] = iterate.primals[variable_index];
+      }
+      this->has_previous_primals = true;
+      return status;
+   }
+
+   IterateStatus ConstraintRelaxationStrategy::check_convergence(Iterate& iterate) {
       if (iterate.is_objective_computed && iterate.evaluations.objective < this->unbounded_objective_threshold) {
          return IterateStatus::UNBOUNDED;
       }
@@ -189,32 +305,151 @@ namespace uno {
       }
    }
 
+   void ConstraintRelaxationStrategy::reset_early_termination() {
+      this->number_recorded_iterates = 0;
+      this->has_previous_primals = false;
+      this->certificate = Certificate{};
+   }
+
+   void ConstraintRelaxationStrategy::record_iterate(const Iterate& iterate) {
+      const size_t position = this->number_recorded_iterates % this->infeasibility_history.size();
+      this->infeasibility_history[position] = iterate.primal_feasibility;
+      this->objective_history[position] = iterate.is_objective_computed ? iterate.evaluations.objective : INF<double>;
+      this->number_recorded_iterates++;
+   }
+
+   double ConstraintRelaxationStrategy::recorded_measure(const std::vector<double>& history, size_t lag) const {
+      assert(lag < this->number_recorded_iterates && lag < history.size() && "The measure was not recorded");
+      return history[(this->number_recorded_iterates - 1 - lag) % history.size()];
+   }
+
+   // early detection of hopeless solves, at an accepted iterate that does not satisfy the termination criteria:
+   // - dual ray test: in an infeasible problem, the multipliers of the interior-point and penalty methods diverge. The normalized
+   //   multipliers (y, z)/||(y, z)|| satisfy ||J^T y + z|| <= (||σ ∇f - J^T y - z|| + σ ||∇f||) / ||(y, z)||, which vanishes
+   // - stalled restoration: the infeasibility stopped decreasing at a point that is almost stationary for the feasibility problem
+   // - objective divergence: the objective decreases monotonically at feasible points and its magnitude doubles over the window
+   IterateStatus ConstraintRelaxationStrategy::check_early_termination(Iterate& iterate) {
+      const size_t window = this->early_termination_window;
+      const bool is_window_full = (window < this->number_recorded_iterates);
+      if (this->model.is_constrained() && this->tight_tolerance < iterate.primal_feasibility) {
+         const double multipliers_norm = norm_inf(iterate.multipliers.constraints, iterate.multipliers.lower_bounds,
+               iterate.multipliers.upper_bounds);
+         if (this->dual_ray_threshold <= multipliers_norm && (iterate.objective_multiplier == 0. || iterate.is_objective_gradient_computed)) {
+            const double gradient_norm = (iterate.objective_multiplier == 0.) ? 0. : norm_inf(iterate.evaluations.objective_gradient);
+            const double ray_residual = (iterate.residuals.stationarity + iterate.objective_multiplier * gradient_norm) / multipliers_norm;
+            DEBUG << "Dual ray residual: " << ray_residual << '\n';
+            if (ray_residual <= this->early_infeasibility_tolerance) {
+               this->set_infeasibility_certificate(iterate.multipliers, "dual ray", ray_residual);
+               return IterateStatus::INFEASIBLE_STATIONARY_POINT;
+            }
+         }
+         if (is_window_full) {
+            const double past_infeasibility = this->recorded_measure(this->infeasibility_history, window);
+            const bool is_stalled = ((1. - this->early_infeasibility_stall_reduction) * past_infeasibility <= iterate.primal_feasibility);
+            // the residuals of the feasibility problem were computed by check_first_order_convergence
+            if (is_stalled && iterate.are_feasibility_residuals_computed &&
+                  iterate.feasibility_residuals.stationarity <= this->early_infeasibility_tolerance &&
+                  iterate.feasibility_residuals.complementarity <= this->early_infeasibility_tolerance &&
+                  iterate.feasibility_multipliers.not_all_zero(this->model.number_variables, this->early_infeasibility_tolerance)) {
+               DEBUG << "The restoration stalled at an almost stationary point of the infeasibility\n";
+               this->set_infeasibility_certificate(iterate.feasibility_multipliers, "stalled restoration",
+                     iterate.feasibility_residuals.stationarity);
+               return IterateStatus::INFEASIBLE_STATIONARY_POINT;
+            }
+         }
+      }
+      else if (is_window_full && iterate.is_objective_computed) {
+         bool is_diverging = (iterate.evaluations.objective <= -this->unbounded_divergence_threshold) &&
+            (iterate.evaluations.objective <= 2. * this->recorded_measure(this->objective_history, window));
+         for (size_t lag = 0; is_diverging && lag < window; lag++) {
+            is_diverging = (this->recorded_measure(this->objective_history, lag) < this->recorded_measure(this->objective_history, lag + 1));
+         }
+         if (is_diverging) {
+            DEBUG << "The objective diverges\n";
+            this->set_unboundedness_certificate(iterate, "objective divergence");
+            return IterateStatus::UNBOUNDED;
+         }
+      }
+      return IterateStatus::NOT_OPTIMAL;
+   }
+
+   // the certificate is built once, upon termination
+   void ConstraintRelaxationStrategy::set_infeasibility_certificate(const Multipliers& multipliers, const std::string& test, double residual) {
+      const AllocationTracker::Prohibition certificate_permission(false);
+      const size_t number_variables = this->model.number_variables;
+      const size_t number_constraints = this->model.number_constraints;
+      const double multipliers_norm = norm_inf(view(multipliers.constraints, 0, number_constraints),
+            view(multipliers.lower_bounds, 0, number_variables), view(multipliers.upper_bounds, 0, number_variables));
+      const double scaling = (0. < multipliers_norm) ? 1. / multipliers_norm : 1.;
+      this->certificate.type = CertificateType::INFEASIBILITY;
+      this->certificate.test = test;
+      this->certificate.residual = residual;
+      this->certificate.constraint_multipliers.resize(number_constraints);
+      for (size_t constraint_index: Range(number_constraints)) {
+         this->certificate.constraint_multipliers[constraint_index] = scaling * multipliers.constraints[constraint_index];
+      }
+      this->certificate.lower_bound_multipliers.resize(number_variables);
+      this->certificate.upper_bound_multipliers.resize(number_variables);
+      for (size_t variable_index: Range(number_variables)) {
+         this->certificate.lower_bound_multipliers[variable_index] = scaling * multipliers.lower_bounds[variable_index];
+         this->certificate.upper_bound_multipliers[variable_index] = scaling * multipliers.upper_bounds[variable_index];
+      }
+      this->certificate.primal_ray.clear();
+   }
+
+   void ConstraintRelaxationStrategy::set_unboundedness_certificate(const Iterate& iterate, const std::string& test) {
+      const AllocationTracker::Prohibition certificate_permission(false);
+      const size_t number_variables = this->model.number_variables;
+      this->certificate.type = CertificateType::UNBOUNDEDNESS;
+      this->certificate.test = test;
+      this->certificate.residual = 0.;
+      this->certificate.constraint_multipliers.clear();
+      this->certificate.lower_bound_multipliers.clear();
+      this->certificate.upper_bound_multipliers.clear();
+      this->certificate.primal_ray.clear();
+      // without a previous iterate, there is no ray
+      if (this->has_previous_primals) {
+         this->certificate.primal_ray.resize(number_variables);
+         double ray_norm = 0.;
+         for (size_t variable_index: Range(number_variables)) {
+            this->certificate.primal_ray[variable_index] = iterate.primals[variable_index] - this->previous_primals[variable_index];
+            ray_norm = std::max(ray_norm, std::abs(this->certificate.primal_ray[variable_index]));
+         }
+         if (0. < ray_norm) {
+            for (double& element: this->certificate.primal_ray) {
+               element /= ray_norm;
+            }
+         }
+      }
+   }
+
    IterateStatus ConstraintRelaxationStrategy::check_first_order_convergence(Iterate& current_iterate, double tolerance) const {
       // evaluate termination conditions based on optimality conditions
       const bool stationarity = (current_iterate.residuals.stationarity / current_iterate.residuals.stationarity_scaling <= tolerance);
       const bool primal_feasibility = (current_iterate.primal_feasibility <= tolerance);
       const bool complementarity = (current_iterate.residuals.complementarity / current_iterate.residuals.complementarity_scaling <= tolerance);
 
-      const bool feasibility_stationarity = (current_iterate.feasibility_residuals.stationarity <= tolerance);
-      const bool feasibility_complementarity = (current_iterate.feasibility_residuals.complementarity <= tolerance);
-      const bool no_trivial_duals = current_iterate.feasibility_multipliers.not_all_zero(this->model.number_variables, tolerance);
-
       DEBUG << "\nTermination criteria for tolerance = " << tolerance << ":\n";
       DEBUG << "Stationarity: " << std::boolalpha << stationarity << '\n';
       DEBUG << "Primal feasibility: " << std::boolalpha << primal_feasibility << '\n';
       DEBUG << "Complementarity: " << std::boolalpha << complementarity << '\n';
 
-      DEBUG << "Feasibility stationarity: " << std::boolalpha << feasibility_stationarity << '\n';
-      DEBUG << "Feasibility complementarity: " << std::boolalpha << feasibility_complementarity << '\n';
-      DEBUG << "Not all zero multipliers: " << std::boolalpha << no_trivial_duals << "\n\n";
-
       if (stationarity && primal_feasibility && 0. < current_iterate.objective_multiplier && complementarity) {
          // feasible regular stationary point
          return IterateStatus::FEASIBLE_KKT_POINT;
       }
-      else if (this->model.is_constrained() && feasibility_stationarity && !primal_feasibility && feasibility_complementarity && no_trivial_duals) {
-         // no primal feasibility, stationary point of constraint violation
-         return IterateStatus::INFEASIBLE_STATIONARY_POINT;
+      else if (this->model.is_constrained() && !primal_feasibility) {
+         this->compute_feasibility_residuals(current_iterate);
+         const bool feasibility_stationarity = (current_iterate.feasibility_residuals.stationarity <= tolerance);
+         const bool feasibility_complementarity = (current_iterate.feasibility_residuals.complementarity <= tolerance);
+         const bool no_trivial_duals = current_iterate.feasibility_multipliers.not_all_zero(this->model.number_variables, tolerance);
+         DEBUG << "Feasibility stationarity: " << std::boolalpha << feasibility_stationarity << '\n';
+         DEBUG << "Feasibility complementarity: " << std::boolalpha << feasibility_complementarity << '\n';
+         DEBUG << "Not all zero multipliers: " << std::boolalpha << no_trivial_duals << "\n\n";
+         if (feasibility_stationarity && feasibility_complementarity && no_trivial_duals) {
+            // no primal feasibility, stationary point of constraint violation
+            return IterateStatus::INFEASIBLE_STATIONARY_POINT;
+         }
       }
       return IterateStatus::NOT_OPTIMAL;
    }
@@ -225,7 +460,9 @@ namespace uno {
    }
 
    void ConstraintRelaxationStrategy::set_progress_statistics(Statistics& statistics, const Iterate& iterate) const {
-      statistics.set("objective", iterate.evaluations.objective);
+      if (iterate.is_objective_computed) {
+         statistics.set("objective", iterate.evaluations.objective);
+      }
       if (this->model.is_constrained()) {
          statistics.set("primal feas", iterate.progress.infeasibility);
       }
@@ -238,4 +475,40 @@ namespace uno {
    size_t ConstraintRelaxationStrategy::get_number_subproblems_solved() const {
       return this->inequality_handling_method->number_subproblems_solved;
    }
+
+   size_t ConstraintRelaxationStrategy::get_number_factorizations() const {
+      return this->inequality_handling_method->number_factorizations;
+   }
+
+   void ConstraintRelaxationStrategy::save_state(CheckpointWriter& writer) const {
+      writer.write(this->loose_tolerance_consecutive_iterations);
+      this->globalization_strategy->save_state(writer);
+      this->inequality_handling_method->save_state(writer);
+   }
+
+   void ConstraintRelaxationStrategy::load_state(CheckpointReader& reader, Iterate& current_iterate) {
+      this->loose_tolerance_consecutive_iterations = reader.read_size_t();
+      this->globalization_strategy->load_state(reader);
+      this->inequality_handling_method->load_state(reader);
+      // the measures depend on the restored parameters (e.g. the barrier parameter)
+      this->evaluate_progress_measures(current_iterate);
+      this->compute_primal_dual_residuals(current_iterate);
+   }
+
+   size_t ConstraintRelaxationStrategy::get_peak_workspace_size() const {
+      return this->inequality_handling_method->get_peak_workspace_size();
+   }
+
+   FactorizationStatistics ConstraintRelaxationStrategy::get_factorization_statistics() const {
+      return this->inequality_handling_method->get_factorization_statistics();
+   }
+
+   void ConstraintRelaxationStrategy::solve_sensitivity_systems(const Vector<double>& rhs, Vector<double>& result, size_t number_rhs) {
+      this->inequality_handling_method->solve_sensitivity_systems(rhs, result, number_rhs);
+   }
+
+   void ConstraintRelaxationStrategy::report_memory(MemoryReport& report) const {
+      report.add("constraint relaxation/linearized constraints", this->linearized_constraints.memory_size());
+      this->inequality_handling_method->report_memory(report);
+   }
 } // namespace
\ No newline at end of file
@@ -6,27 +6,35 @@
 
 #include <cstddef>
 #include <memory>
+#include <string>
+#include <vector>
 #include "linear_algebra/Norm.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "ingredients/subproblem_solvers/FactorizationStatistics.hpp"
+#include "optimization/Certificate.hpp"
 #include "optimization/IterateStatus.hpp"
 
 namespace uno {
    // forward declarations
+   class CheckpointReader;
+   class CheckpointWriter;
    class Direction;
    class GlobalizationStrategy;
    class Iterate;
+   class MemoryReport;
    template <typename ElementType>
    class LagrangianGradient;
    class Model;
    class Multipliers;
    class OptimizationProblem;
    class Options;
+   class ObjectiveMeasure;
+   struct ProgressMeasures;
    class Statistics;
    class InequalityHandlingMethod;
    template <typename IndexType, typename ElementType>
    class SymmetricMatrix;
    class UserCallbacks;
-   template <typename ElementType>
-   class Vector;
    struct WarmstartInformation;
 
    class ConstraintRelaxationStrategy {
@@ -48,18 +56,39 @@ namespace uno {
             const Vector<double>& initial_point, WarmstartInformation& warmstart_information);
       [[nodiscard]] virtual bool solving_feasibility_problem() const = 0;
       virtual void switch_to_feasibility_problem(Statistics& statistics, Iterate& current_iterate, WarmstartInformation& warmstart_information) = 0;
+      // second-order correction of the direction, given the rejected trial iterate. Returns false if no correction is available
+      [[nodiscard]] virtual bool compute_second_order_correction(Iterate& current_iterate, Iterate& trial_iterate, Direction& direction);
 
       // trial iterate acceptance
       [[nodiscard]] virtual bool is_iterate_acceptable(Statistics& statistics, Iterate& current_iterate, Iterate& trial_iterate, const Direction& direction,
             double step_length, WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) = 0;
+      // termination tests of an accepted iterate. An infeasible or unbounded termination comes with a certificate (see get_certificate)
       [[nodiscard]] IterateStatus check_termination(Iterate& iterate);
+      // certificate of the last infeasible or unbounded termination
+      [[nodiscard]] const Certificate& get_certificate() const { return this->certificate; }
+      // first-order predicted reductions of the progress measures for a unit step along the direction (their opposites are the slopes
+      // of the measures at the current iterate)
+      [[nodiscard]] ProgressMeasures compute_unit_step_predicted_reductions(const Iterate& current_iterate, const Direction& direction) const;
 
       // primal-dual residuals
       virtual void compute_primal_dual_residuals(Iterate& iterate) = 0;
+      // the residuals of the feasibility problem are only needed in the restoration phase and to detect infeasible stationary points:
+      // they are computed on demand
+      virtual void compute_feasibility_residuals(Iterate& iterate) const = 0;
       virtual void set_dual_residuals_statistics(Statistics& statistics, const Iterate& iterate) const = 0;
 
+      // algorithmic state of the strategy and its ingredients in a checkpoint. Once the state is loaded, the measures and residuals
+      // of the current iterate are recomputed
+      virtual void save_state(CheckpointWriter& writer) const;
+      virtual void load_state(CheckpointReader& reader, Iterate& current_iterate);
+
       [[nodiscard]] size_t get_hessian_evaluation_count() const;
       [[nodiscard]] size_t get_number_subproblems_solved() const;
+      [[nodiscard]] size_t get_number_factorizations() const;
+      [[nodiscard]] size_t get_peak_workspace_size() const;
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const;
+      void solve_sensitivity_systems(const Vector<double>& rhs, Vector<double>& result, size_t number_rhs);
+      void report_memory(MemoryReport& report) const;
 
    protected:
       const Model& model;
@@ -73,24 +102,57 @@ namespace uno {
       size_t loose_tolerance_consecutive_iterations{0};
       const size_t loose_tolerance_consecutive_iteration_threshold;
       const double unbounded_objective_threshold;
+      // early termination (see check_early_termination): measures of the last accepted iterates (circular buffers)
+      const bool early_termination;
+      const size_t early_termination_window;
+      const double early_infeasibility_stall_reduction;
+      const double early_infeasibility_tolerance;
+      const double dual_ray_threshold;
+      const double unbounded_divergence_threshold;
+      std::vector<double> infeasibility_history;
+      std::vector<double> objective_history;
+      size_t number_recorded_iterates{0};
+      Vector<double> previous_primals;
+      bool has_previous_primals{false};
+      Certificate certificate{};
       // first_order_predicted_reduction is true when the predicted reduction can be taken as first-order (e.g. in line-search methods)
       const bool first_order_predicted_reduction;
+      // preallocated linearized constraints c(x) + α ∇c(x)^T d
+      mutable Vector<double> linearized_constraints;
 
       void set_objective_measure(Iterate& iterate) const;
       void set_infeasibility_measure(Iterate& iterate) const;
-      [[nodiscard]] double compute_predicted_infeasibility_reduction_model(const Iterate& current_iterate, const Vector<double>& primal_direction,
+      [[nodiscard]] double compute_linearized_constraint_violation(const Iterate& current_iterate, const Vector<double>& primal_direction,
+            double step_length, Norm norm) const;
+      // linearized constraint violation along a direction whose products are cached
+      [[nodiscard]] double compute_linearized_constraint_violation(const Iterate& current_iterate, const Direction& direction,
+            double step_length, Norm norm) const;
+      void cache_direction_products(const Iterate& current_iterate, const Direction& direction) const;
+      [[nodiscard]] double compute_predicted_infeasibility_reduction_model(const Iterate& current_iterate, const Direction& direction,
             double step_length) const;
-      [[nodiscard]] std::function<double(double)> compute_predicted_objective_reduction_model(const Iterate& current_iterate,
-            const Vector<double>& primal_direction, double step_length) const;
-      void compute_progress_measures(Iterate& current_iterate, Iterate& trial_iterate);
+      [[nodiscard]] ObjectiveMeasure compute_predicted_objective_reduction_model(const Iterate& current_iterate,
+            const Direction& direction, double step_length) const;
+      [[nodiscard]] bool compute_progress_measures(Iterate& current_iterate, Iterate& trial_iterate, const Direction& direction,
+            double objective_multiplier);
       virtual void evaluate_progress_measures(Iterate& iterate) const = 0;
 
-      void compute_primal_dual_residuals(const OptimizationProblem& optimality_problem, const OptimizationProblem& feasibility_problem, Iterate& iterate);
+      void compute_primal_dual_residuals(const OptimizationProblem& optimality_problem, Iterate& iterate) const;
+      void compute_feasibility_residuals(const OptimizationProblem& feasibility_problem, Iterate& iterate) const;
 
       [[nodiscard]] double compute_stationarity_scaling(const Multipliers& multipliers) const;
       [[nodiscard]] double compute_complementarity_scaling(const Multipliers& multipliers) const;
+      [[nodiscard]] double bound_multipliers_norm_1(const Multipliers& multipliers) const;
 
       [[nodiscard]] IterateStatus check_first_order_convergence(Iterate& current_iterate, double tolerance) const;
+      [[nodiscard]] IterateStatus check_convergence(Iterate& iterate);
+      // the early termination tests are reset at the beginning of a solve
+      void reset_early_termination();
+      void record_iterate(const Iterate& iterate);
+      [[nodiscard]] IterateStatus check_early_termination(Iterate& iterate);
+      // measure of the accepted iterate that precedes the current one by a given lag
+      [[nodiscard]] double recorded_measure(const std::vector<double>& history, size_t lag) const;
+      void set_infeasibility_certificate(const Multipliers& multipliers, const std::string& test, double residual);
+      void set_unboundedness_certificate(const Iterate& iterate, const std::string& test);
 
       void set_statistics(Statistics& statistics, const Iterate& iterate) const;
       void set_progress_statistics(Statistics& statistics, const Iterate& iterate) const;
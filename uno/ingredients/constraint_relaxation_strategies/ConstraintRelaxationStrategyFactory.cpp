@@ -3,6 +3,7 @@
 
 #include <string>
 #include "ConstraintRelaxationStrategyFactory.hpp"
+#include "AugmentedLagrangian.hpp"
 #include "FeasibilityRestoration.hpp"
 #include "l1Relaxation.hpp"
 #include "options/Options.hpp"
@@ -11,15 +12,30 @@ namespace uno {
    std::unique_ptr<ConstraintRelaxationStrategy> ConstraintRelaxationStrategyFactory::create(const Model& model, const Options& options) {
       const std::string constraint_relaxation_type = options.get_string("constraint_relaxation_strategy");
       if (constraint_relaxation_type == "feasibility_restoration") {
-         return std::make_unique<FeasibilityRestoration>(model, options);
+         // compile-time pipelines of the ipopt and filtersqp presets. Without general constraints, the subproblem is replaced
+         // with a matrix-free method (see InequalityHandlingMethodFactory) and the runtime pipeline is used
+         if (options.get_bool("specialized_pipelines") && 0 < model.number_constraints) {
+            const std::string& subproblem_strategy = options.get_string("subproblem");
+            const std::string& globalization_strategy = options.get_string("globalization_strategy");
+            if (subproblem_strategy == "primal_dual_interior_point" && globalization_strategy == "waechter_filter_method") {
+               return std::make_unique<InteriorPointFeasibilityRestoration>(model, options);
+            }
+            if (subproblem_strategy == "QP" && globalization_strategy == "fletcher_filter_method") {
+               return std::make_unique<SQPFeasibilityRestoration>(model, options);
+            }
+         }
+         return std::make_unique<FeasibilityRestoration<>>(model, options);
       }
       else if (constraint_relaxation_type == "l1_relaxation") {
          return std::make_unique<l1Relaxation>(model, options);
       }
+      else if (constraint_relaxation_type == "augmented_lagrangian") {
+         return std::make_unique<AugmentedLagrangian>(model, options);
+      }
       throw std::invalid_argument("ConstraintRelaxationStrategy " + constraint_relaxation_type + " is not supported");
    }
 
    std::vector<std::string> ConstraintRelaxationStrategyFactory::available_strategies() {
-      return {"feasibility_restoration", "l1_relaxation"};
+      return {"feasibility_restoration", "l1_relaxation", "augmented_lagrangian"};
    }
 } // namespace
@@ -3,44 +3,32 @@
 
 #include "ElasticVariables.hpp"
 #include "model/Model.hpp"
+#include "symbolic/Range.hpp"
 #include "tools/Infinity.hpp"
 
 namespace uno {
-   ElasticVariables::ElasticVariables(size_t number_positive_variables, size_t number_negative_variables):
-         positive(number_positive_variables), negative(number_negative_variables) { }
+   ElasticVariables::ElasticVariables(size_t number_constraints):
+         positive(number_constraints, ElasticVariables::none), negative(number_constraints, ElasticVariables::none) { }
 
    ElasticVariables ElasticVariables::generate(const Model& model) {
-      const ElasticVariablesSizes sizes = ElasticVariables::count(model);
-      ElasticVariables elastic_variables(sizes.positive, sizes.negative);
+      ElasticVariables elastic_variables(model.number_constraints);
 
       // generate elastic variables to relax the constraints
       size_t elastic_index = model.number_variables;
       for (size_t constraint_index: Range(model.number_constraints)) {
          if (is_finite(model.constraint_upper_bound(constraint_index))) {
             // nonnegative variable p that captures the positive part of the constraint violation
-            elastic_variables.positive.insert(constraint_index, elastic_index);
+            elastic_variables.positive[constraint_index] = elastic_index;
+            elastic_variables.number_positive++;
             elastic_index++;
          }
          if (is_finite(model.constraint_lower_bound(constraint_index))) {
             // nonpositive variable n that captures the negative part of the constraint violation
-            elastic_variables.negative.insert(constraint_index, elastic_index);
+            elastic_variables.negative[constraint_index] = elastic_index;
+            elastic_variables.number_negative++;
             elastic_index++;
          }
       }
       return elastic_variables;
    }
-
-   ElasticVariablesSizes ElasticVariables::count(const Model& model) {
-      ElasticVariablesSizes number_elastic_variables;
-      // if the subproblem uses slack variables, the bounds of the constraints are [0, 0]
-      for (size_t constraint_index: Range(model.number_constraints)) {
-         if (is_finite(model.constraint_upper_bound(constraint_index))) {
-            number_elastic_variables.positive++;
-         }
-         if (is_finite(model.constraint_lower_bound(constraint_index))) {
-            number_elastic_variables.negative++;
-         }
-      }
-      return number_elastic_variables;
-   }
-} // namespace
\ No newline at end of file
+} // namespace
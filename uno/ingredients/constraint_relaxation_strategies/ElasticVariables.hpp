@@ -4,30 +4,37 @@
 #ifndef UNO_ELASTICVARIABLES_H
 #define UNO_ELASTICVARIABLES_H
 
-#include "linear_algebra/SparseVector.hpp"
+#include <cstddef>
+#include <limits>
+#include <vector>
 
 namespace uno {
    // forward declaration
    class Model;
 
-   struct ElasticVariablesSizes {
-      size_t positive{0};
-      size_t negative{0};
-   };
-
+   /*! \class ElasticVariables
+    * \brief Elastic variables of the l1-relaxed constraints
+    *
+    *  Dense arrays indexed by constraint: positive[j] (resp. negative[j]) is the index of the elastic variable p_j (resp. n_j)
+    *  that captures the positive (resp. negative) part of the violation of constraint j, or ElasticVariables::none.
+    *  The elastic variables are numbered contiguously after the model variables, p_j before n_j
+    */
    class ElasticVariables {
    public:
-      SparseVector<size_t> positive{};
-      SparseVector<size_t> negative{};
+      static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+      std::vector<size_t> positive{};
+      std::vector<size_t> negative{};
 
-      ElasticVariables(size_t number_positive_variables, size_t number_negative_variables);
-      [[nodiscard]] size_t size() const { return this->positive.size() + this->negative.size(); }
+      explicit ElasticVariables(size_t number_constraints);
+      [[nodiscard]] size_t size() const { return this->number_positive + this->number_negative; }
 
       static ElasticVariables generate(const Model& model);
 
    protected:
-      static ElasticVariablesSizes count(const Model& model);
+      size_t number_positive{0};
+      size_t number_negative{0};
    };
 } // namespace
 
-#endif // UNO_ELASTICVARIABLES_H
\ No newline at end of file
+#endif // UNO_ELASTICVARIABLES_H
@@ -2,9 +2,18 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include <functional>
+#include <limits>
+#include <stdexcept>
 #include "FeasibilityRestoration.hpp"
+#include <typeinfo>
+#include <type_traits>
 #include "ingredients/globalization_strategies/GlobalizationStrategy.hpp"
+#include "ingredients/globalization_strategies/switching_methods/filter_methods/FletcherFilterMethod.hpp"
+#include "ingredients/globalization_strategies/switching_methods/filter_methods/WaechterFilterMethod.hpp"
 #include "ingredients/inequality_handling_methods/InequalityHandlingMethod.hpp"
+#include "ingredients/inequality_handling_methods/InequalityHandlingMethodFactory.hpp"
+#include "ingredients/inequality_handling_methods/inequality_constrained_methods/QPSubproblem.hpp"
+#include "ingredients/inequality_handling_methods/interior_point_methods/PrimalDualInteriorPointMethod.hpp"
 #include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
 #include "model/Model.hpp"
 #include "optimization/Direction.hpp"
@@ -12,19 +21,41 @@
 #include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
 #include "symbolic/VectorView.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Checkpoint.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Metrics.hpp"
+#include "tools/Profiler.hpp"
 #include "tools/UserCallbacks.hpp"
 
 namespace uno {
-   FeasibilityRestoration::FeasibilityRestoration(const Model& model, const Options& options) :
+   namespace {
+      // the ingredient created by the factory from the options must have the type of the specialized pipeline
+      template <typename Type, typename Ingredient>
+      Type& statically_typed(Ingredient& ingredient) {
+         if constexpr (!std::is_same_v<Type, Ingredient>) {
+            if (typeid(ingredient) != typeid(Type)) {
+               throw std::logic_error("The ingredient does not have the type of the specialized pipeline");
+            }
+         }
+         return static_cast<Type&>(ingredient);
+      }
+   } // namespace
+
+   template <typename Method, typename Strategy>
+   FeasibilityRestoration<Method, Strategy>::FeasibilityRestoration(const Model& model, const Options& options) :
          // call delegating constructor
          FeasibilityRestoration(model, OptimalityProblem(model),
                // create the (restoration phase) feasibility problem (objective multiplier = 0)
-               l1RelaxedProblem(model, 0., options.get_double("l1_constraint_violation_coefficient"), 0., nullptr),
+               l1RelaxedProblem(model, 0., options.get_double("l1_constraint_violation_coefficient"), 0., nullptr,
+                     FeasibilityRestoration::is_gauss_newton_hessian_requested(options)),
                options) {
    }
 
    // private delegating constructor
-   FeasibilityRestoration::FeasibilityRestoration(const Model& model, OptimalityProblem&& optimality_problem, l1RelaxedProblem&& feasibility_problem,
+   template <typename Method, typename Strategy>
+   FeasibilityRestoration<Method, Strategy>::FeasibilityRestoration(const Model& model, OptimalityProblem&& optimality_problem,
+         l1RelaxedProblem&& feasibility_problem,
             const Options& options) :
          ConstraintRelaxationStrategy(model,
                // allocate the largest size necessary to solve the optimality subproblem or the feasibility subproblem
@@ -32,35 +63,61 @@ namespace uno {
                std::max(optimality_problem.number_constraints, feasibility_problem.number_constraints),
                std::max(optimality_problem.number_objective_gradient_nonzeros(), feasibility_problem.number_objective_gradient_nonzeros()),
                std::max(optimality_problem.number_jacobian_nonzeros(), feasibility_problem.number_jacobian_nonzeros()),
-               std::max(optimality_problem.number_hessian_nonzeros(), feasibility_problem.number_hessian_nonzeros()),
+               // the Hessian sparsity is only requested if the subproblems use the Hessian
+               InequalityHandlingMethodFactory::uses_lagrangian_hessian(std::max(optimality_problem.number_constraints,
+                  feasibility_problem.number_constraints), options) ?
+                  std::max(optimality_problem.number_hessian_nonzeros(), feasibility_problem.number_hessian_nonzeros()) : 0,
                options),
          optimality_problem(std::forward<OptimalityProblem>(optimality_problem)),
          feasibility_problem(std::forward<l1RelaxedProblem>(feasibility_problem)),
          subproblem_strategy(options.get_string("subproblem")),
          linear_feasibility_tolerance(options.get_double("tolerance")),
          switch_to_optimality_requires_linearized_feasibility(options.get_bool("switch_to_optimality_requires_linearized_feasibility")),
-         reference_optimality_primals(optimality_problem.number_variables) {
+         reference_optimality_primals(optimality_problem.number_variables),
+         typed_inequality_handling_method(statically_typed<Method>(*this->inequality_handling_method)),
+         typed_globalization_strategy(statically_typed<Strategy>(*this->globalization_strategy)) {
       this->feasibility_problem.set_proximal_center(this->reference_optimality_primals.data());
    }
 
-   void FeasibilityRestoration::initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) {
+   template <typename Method, typename Strategy>
+   bool FeasibilityRestoration<Method, Strategy>::is_gauss_newton_hessian_requested(const Options& options) {
+      const std::string& restoration_hessian_model = options.get_string("restoration_hessian_model");
+      if (restoration_hessian_model == "exact") {
+         return false;
+      }
+      else if (restoration_hessian_model == "gauss_newton") {
+         return true;
+      }
+      throw std::invalid_argument("The restoration Hessian model " + restoration_hessian_model + " is not supported");
+   }
+
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) {
       // statistics
-      this->inequality_handling_method->initialize_statistics(statistics, options);
+      this->typed_inequality_handling_method.initialize_statistics(statistics, options);
       statistics.add_column("phase", Statistics::int_width, options.get_int("statistics_restoration_phase_column_order"));
       statistics.set("phase", "OPT");
 
+      // a new solve starts in the optimality phase
+      this->current_phase = Phase::OPTIMALITY;
+      this->reset_early_termination();
+
       // initial iterate
       initial_iterate.feasibility_residuals.lagrangian_gradient.resize(this->feasibility_problem.number_variables);
       initial_iterate.feasibility_multipliers.lower_bounds.resize(this->feasibility_problem.number_variables);
       initial_iterate.feasibility_multipliers.upper_bounds.resize(this->feasibility_problem.number_variables);
-      this->inequality_handling_method->generate_initial_iterate(this->optimality_problem, initial_iterate);
+      this->typed_inequality_handling_method.forget_hessian_evaluation();
+      this->typed_inequality_handling_method.generate_initial_iterate(statistics, this->optimality_problem, initial_iterate);
       this->evaluate_progress_measures(initial_iterate);
       this->compute_primal_dual_residuals(initial_iterate);
       this->set_statistics(statistics, initial_iterate);
-      this->globalization_strategy->initialize(statistics, initial_iterate, options);
+      this->typed_globalization_strategy.reset();
+      this->typed_globalization_strategy.initialize(statistics, initial_iterate, options);
    }
 
-   void FeasibilityRestoration::compute_feasible_direction(Statistics& statistics, Iterate& current_iterate, Direction& direction,
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::compute_feasible_direction(Statistics& statistics, Iterate& current_iterate,
+         Direction& direction,
          WarmstartInformation& warmstart_information) {
       direction.reset();
       // if we are in the optimality phase, solve the optimality problem
@@ -74,7 +131,7 @@ namespace uno {
                statistics.set("status", std::string("infeasible " + this->subproblem_strategy));
                DEBUG << "/!\\ The subproblem is infeasible\n";
                this->switch_to_feasibility_problem(statistics, current_iterate, warmstart_information);
-               this->inequality_handling_method->set_initial_point(direction.primals);
+               this->typed_inequality_handling_method.set_initial_point(direction.primals);
             }
             else {
                warmstart_information.no_changes();
@@ -87,6 +144,7 @@ namespace uno {
       }
 
       // solve the feasibility problem (minimize the constraint violation)
+      Cancellation::check();
       DEBUG << "Solving the feasibility subproblem\n";
       statistics.set("phase", "FEAS");
       // note: failure of regularization should not happen here, since the feasibility Jacobian has full rank
@@ -95,65 +153,106 @@ namespace uno {
       std::swap(direction.multipliers, direction.feasibility_multipliers);
    }
 
-   bool FeasibilityRestoration::solving_feasibility_problem() const {
+   template <typename Method, typename Strategy>
+   bool FeasibilityRestoration<Method, Strategy>::solving_feasibility_problem() const {
       return (this->current_phase == Phase::FEASIBILITY_RESTORATION);
    }
 
    // precondition: this->current_phase == Phase::OPTIMALITY
-   void FeasibilityRestoration::switch_to_feasibility_problem(Statistics& statistics, Iterate& current_iterate,
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::switch_to_feasibility_problem(Statistics& statistics, Iterate& current_iterate,
          WarmstartInformation& warmstart_information) {
       DEBUG << "Switching from optimality to restoration phase\n";
       this->current_phase = Phase::FEASIBILITY_RESTORATION;
-      this->globalization_strategy->notify_switch_to_feasibility(current_iterate.progress);
-      this->inequality_handling_method->initialize_feasibility_problem(this->feasibility_problem, current_iterate);
+      metrics::increment(Metric::RESTORATION_PHASES);
+      this->typed_globalization_strategy.notify_switch_to_feasibility(current_iterate.progress);
+      this->typed_inequality_handling_method.initialize_feasibility_problem(this->feasibility_problem, current_iterate);
       // save the current point (progress and primals) upon switching
       this->reference_optimality_progress = current_iterate.progress;
       this->reference_optimality_primals = current_iterate.primals;
-      this->feasibility_problem.set_proximal_multiplier(this->inequality_handling_method->proximal_coefficient(current_iterate));
+      this->feasibility_problem.set_proximal_multiplier(this->typed_inequality_handling_method.proximal_coefficient(current_iterate));
 
       current_iterate.set_number_variables(this->feasibility_problem.number_variables);
-      this->inequality_handling_method->set_elastic_variable_values(this->feasibility_problem, current_iterate);
+      this->typed_inequality_handling_method.set_elastic_variable_values(this->feasibility_problem, current_iterate);
       DEBUG2 << "Current iterate:\n" << current_iterate << '\n';
 
       if (Logger::level == INFO) statistics.print_current_line();
+      // the structure changes. The linear solvers keep the symbolic analysis of each phase (see SymbolicAnalysisRepository) and
+      // restore it when the pattern reappears
       warmstart_information.whole_problem_changed();
    }
 
-   void FeasibilityRestoration::solve_subproblem(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+   // second-order corrections are computed in the optimality phase only
+   template <typename Method, typename Strategy>
+   bool FeasibilityRestoration<Method, Strategy>::compute_second_order_correction(Iterate& current_iterate, Iterate& trial_iterate,
+         Direction& direction) {
+      if (this->current_phase != Phase::OPTIMALITY) {
+         return false;
+      }
+      if (!this->typed_inequality_handling_method.compute_second_order_correction(this->optimality_problem, current_iterate, current_iterate.multipliers,
+            trial_iterate, direction)) {
+         return false;
+      }
+      direction.invalidate_cached_products();
+      direction.norm = norm_inf(view(direction.primals, 0, this->model.number_variables));
+      DEBUG3 << direction << '\n';
+      return true;
+   }
+
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::solve_subproblem(Statistics& statistics, const OptimizationProblem& problem,
+         Iterate& current_iterate,
          const Multipliers& current_multipliers, Direction& direction, WarmstartInformation& warmstart_information) {
       direction.set_dimensions(problem.number_variables, problem.number_constraints);
-      this->inequality_handling_method->solve(statistics, problem, current_iterate, current_multipliers, direction, warmstart_information);
+      const ScopedTimer subproblem_timer("subproblem");
+      this->typed_inequality_handling_method.solve(statistics, problem, current_iterate, current_multipliers, direction, warmstart_information);
       direction.norm = norm_inf(view(direction.primals, 0, this->model.number_variables));
       DEBUG3 << direction << '\n';
    }
 
-   bool FeasibilityRestoration::can_switch_to_optimality_phase(const Iterate& current_iterate, const Iterate& trial_iterate, const Direction& direction,
+   template <typename Method, typename Strategy>
+   bool FeasibilityRestoration<Method, Strategy>::can_switch_to_optimality_phase(const Iterate& current_iterate,
+         const Iterate& trial_iterate, const Direction& direction,
          double step_length) {
-      return this->globalization_strategy->is_infeasibility_sufficiently_reduced(this->reference_optimality_progress, trial_iterate.progress) &&
+      return this->typed_globalization_strategy.is_infeasibility_sufficiently_reduced(this->reference_optimality_progress, trial_iterate.progress) &&
          (!this->switch_to_optimality_requires_linearized_feasibility ||
-         this->model.constraint_violation(current_iterate.evaluations.constraints + step_length*(current_iterate.evaluations.constraint_jacobian *
-         direction.primals), this->residual_norm) <= this->linear_feasibility_tolerance);
+         this->compute_linearized_constraint_violation(current_iterate, direction, step_length, this->residual_norm) <=
+         this->linear_feasibility_tolerance);
    }
 
-   void FeasibilityRestoration::switch_to_optimality_phase(Iterate& current_iterate, Iterate& trial_iterate, WarmstartInformation& warmstart_information) {
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::switch_to_optimality_phase(Iterate& current_iterate, Iterate& trial_iterate,
+         WarmstartInformation& warmstart_information) {
       DEBUG << "Switching from restoration to optimality phase\n";
       this->current_phase = Phase::OPTIMALITY;
-      this->globalization_strategy->notify_switch_to_optimality(current_iterate.progress);
+      // the objective was not evaluated in the restoration phase. The optimality phase compares the objective measures of both
+      // iterates and predicts the objective reduction from the current iterate
+      this->set_objective_measure(current_iterate);
+      this->set_objective_measure(trial_iterate);
+      current_iterate.evaluate_objective_gradient(this->model);
+      this->typed_globalization_strategy.notify_switch_to_optimality(current_iterate.progress);
       current_iterate.set_number_variables(this->optimality_problem.number_variables);
       trial_iterate.set_number_variables(this->optimality_problem.number_variables);
       current_iterate.objective_multiplier = trial_iterate.objective_multiplier = 1.;
 
-      this->inequality_handling_method->exit_feasibility_problem(this->optimality_problem, trial_iterate);
-      // set a cold start in the subproblem solver
+      this->typed_inequality_handling_method.exit_feasibility_problem(this->optimality_problem, trial_iterate);
+      // set a cold start in the subproblem solver (the symbolic analysis of the optimality phase is restored)
       warmstart_information.whole_problem_changed();
    }
 
-   bool FeasibilityRestoration::is_iterate_acceptable(Statistics& statistics, Iterate& current_iterate, Iterate& trial_iterate, const Direction& direction,
+   template <typename Method, typename Strategy>
+   bool FeasibilityRestoration<Method, Strategy>::is_iterate_acceptable(Statistics& statistics, Iterate& current_iterate,
+         Iterate& trial_iterate, const Direction& direction,
          double step_length, WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) {
       // TODO pick right multipliers
-      this->inequality_handling_method->postprocess_iterate(this->current_problem(), trial_iterate);
-      this->compute_progress_measures(current_iterate, trial_iterate);
+      this->typed_inequality_handling_method.postprocess_iterate(this->current_problem(), trial_iterate);
       trial_iterate.objective_multiplier = this->current_problem().get_objective_multiplier();
+      if (!this->compute_progress_measures(current_iterate, trial_iterate, direction, trial_iterate.objective_multiplier)) {
+         warmstart_information.no_changes();
+         statistics.set("status", "✘ (infeasibility)");
+         ConstraintRelaxationStrategy::set_progress_statistics(statistics, trial_iterate);
+         return false;
+      }
 
       // possibly go from restoration phase to optimality phase
       if (this->current_phase == Phase::FEASIBILITY_RESTORATION && this->can_switch_to_optimality_phase(current_iterate, trial_iterate, direction, step_length)) {
@@ -173,7 +272,7 @@ namespace uno {
       else {
          // invoke the globalization strategy for acceptance
          const ProgressMeasures predicted_reduction = this->compute_predicted_reduction_models(current_iterate, direction, step_length);
-         accept_iterate = this->globalization_strategy->is_iterate_acceptable(statistics, current_iterate.progress, trial_iterate.progress,
+         accept_iterate = this->typed_globalization_strategy.is_iterate_acceptable(statistics, current_iterate.progress, trial_iterate.progress,
                predicted_reduction, this->current_problem().get_objective_multiplier());
       }
       ConstraintRelaxationStrategy::set_progress_statistics(statistics, trial_iterate);
@@ -185,11 +284,39 @@ namespace uno {
       return accept_iterate;
    }
 
-   void FeasibilityRestoration::compute_primal_dual_residuals(Iterate& iterate) {
-      ConstraintRelaxationStrategy::compute_primal_dual_residuals(this->optimality_problem, this->feasibility_problem, iterate);
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::compute_primal_dual_residuals(Iterate& iterate) {
+      if (this->current_phase == Phase::OPTIMALITY) {
+         ConstraintRelaxationStrategy::compute_primal_dual_residuals(this->optimality_problem, iterate);
+         return;
+      }
+      // the restoration phase monitors the residuals of the feasibility problem. The objective and its gradient (stationarity of the
+      // optimality problem) are only evaluated at (nearly) feasible points, where the iterates are compared on their objective
+      iterate.evaluate_constraints(this->model);
+      iterate.primal_feasibility = this->model.constraint_violation(iterate.evaluations.constraints, this->residual_norm);
+      if (iterate.primal_feasibility <= this->linear_feasibility_tolerance) {
+         ConstraintRelaxationStrategy::compute_primal_dual_residuals(this->optimality_problem, iterate);
+      }
+      else {
+         iterate.evaluate_constraint_jacobian(this->model);
+         iterate.residuals.stationarity = INF<double>;
+         const double shift_value = 0.;
+         iterate.residuals.complementarity = this->optimality_problem.complementarity_error(iterate.primals, iterate.evaluations.constraints,
+               iterate.multipliers, shift_value, this->residual_norm);
+         iterate.residuals.stationarity_scaling = this->compute_stationarity_scaling(iterate.multipliers);
+         iterate.residuals.complementarity_scaling = this->compute_complementarity_scaling(iterate.multipliers);
+         iterate.are_feasibility_residuals_computed = false;
+      }
+      this->compute_feasibility_residuals(iterate);
+   }
+
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::compute_feasibility_residuals(Iterate& iterate) const {
+      ConstraintRelaxationStrategy::compute_feasibility_residuals(this->feasibility_problem, iterate);
    }
 
-   const OptimizationProblem& FeasibilityRestoration::current_problem() const {
+   template <typename Method, typename Strategy>
+   const OptimizationProblem& FeasibilityRestoration<Method, Strategy>::current_problem() const {
       if (this->current_phase == Phase::OPTIMALITY) {
          return this->optimality_problem;
       }
@@ -198,31 +325,67 @@ namespace uno {
       }
    }
 
-   void FeasibilityRestoration::evaluate_progress_measures(Iterate& iterate) const {
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::evaluate_progress_measures(Iterate& iterate) const {
       this->set_infeasibility_measure(iterate);
-      this->set_objective_measure(iterate);
-      this->inequality_handling_method->set_auxiliary_measure(this->model, iterate);
+      if (this->current_phase == Phase::OPTIMALITY) {
+         this->set_objective_measure(iterate);
+      }
+      else {
+         // the restoration phase works with a zero objective multiplier: the objective is not evaluated (it is evaluated upon switching
+         // to the optimality phase)
+         iterate.progress.objective = ObjectiveMeasure::scaled(std::numeric_limits<double>::quiet_NaN());
+      }
+      this->typed_inequality_handling_method.set_auxiliary_measure(this->model, iterate);
    }
 
-   ProgressMeasures FeasibilityRestoration::compute_predicted_reduction_models(Iterate& current_iterate, const Direction& direction, double step_length) {
+   template <typename Method, typename Strategy>
+   ProgressMeasures FeasibilityRestoration<Method, Strategy>::compute_predicted_reduction_models(Iterate& current_iterate,
+         const Direction& direction, double step_length) {
       return {
-         this->compute_predicted_infeasibility_reduction_model(current_iterate, direction.primals, step_length),
-         this->compute_predicted_objective_reduction_model(current_iterate, direction.primals, step_length),
-         this->inequality_handling_method->compute_predicted_auxiliary_reduction_model(this->model, current_iterate, direction.primals, step_length)
+         this->compute_predicted_infeasibility_reduction_model(current_iterate, direction, step_length),
+         this->compute_predicted_objective_reduction_model(current_iterate, direction, step_length),
+         this->typed_inequality_handling_method.compute_predicted_auxiliary_reduction_model(this->model, current_iterate, direction.primals, step_length)
       };
    }
 
-   size_t FeasibilityRestoration::maximum_number_variables() const {
+   template <typename Method, typename Strategy>
+   size_t FeasibilityRestoration<Method, Strategy>::maximum_number_variables() const {
       return std::max(this->optimality_problem.number_variables, this->feasibility_problem.number_variables);
    }
 
-   size_t FeasibilityRestoration::maximum_number_constraints() const {
+   template <typename Method, typename Strategy>
+   size_t FeasibilityRestoration<Method, Strategy>::maximum_number_constraints() const {
       return std::max(this->optimality_problem.number_constraints, this->feasibility_problem.number_constraints);
    }
 
-   void FeasibilityRestoration::set_dual_residuals_statistics(Statistics& statistics, const Iterate& iterate) const {
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::set_dual_residuals_statistics(Statistics& statistics, const Iterate& iterate) const {
       const auto& residuals = (this->current_phase == Phase::OPTIMALITY) ? iterate.residuals : iterate.feasibility_residuals;
       statistics.set("stationarity", residuals.stationarity);
       statistics.set("complementarity", residuals.complementarity);
    }
+
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::save_state(CheckpointWriter& writer) const {
+      writer.write(this->current_phase == Phase::FEASIBILITY_RESTORATION);
+      this->reference_optimality_progress.save(writer);
+      writer.write(this->reference_optimality_primals);
+      writer.write(this->feasibility_problem.get_proximal_multiplier());
+      ConstraintRelaxationStrategy::save_state(writer);
+   }
+
+   template <typename Method, typename Strategy>
+   void FeasibilityRestoration<Method, Strategy>::load_state(CheckpointReader& reader, Iterate& current_iterate) {
+      this->current_phase = reader.read_bool() ? Phase::FEASIBILITY_RESTORATION : Phase::OPTIMALITY;
+      this->reference_optimality_progress.load(reader);
+      reader.read(this->reference_optimality_primals);
+      this->feasibility_problem.set_proximal_center(this->reference_optimality_primals.data());
+      this->feasibility_problem.set_proximal_multiplier(reader.read_double());
+      ConstraintRelaxationStrategy::load_state(reader, current_iterate);
+   }
+
+   template class FeasibilityRestoration<InequalityHandlingMethod, GlobalizationStrategy>;
+   template class FeasibilityRestoration<PrimalDualInteriorPointMethod, WaechterFilterMethod>;
+   template class FeasibilityRestoration<QPSubproblem, FletcherFilterMethod>;
 } // namespace
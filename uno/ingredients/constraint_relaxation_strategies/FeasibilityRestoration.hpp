@@ -11,9 +11,18 @@
 #include "l1RelaxedProblem.hpp"
 
 namespace uno {
+   // forward declarations
+   class FletcherFilterMethod;
+   class PrimalDualInteriorPointMethod;
+   class QPSubproblem;
+   class WaechterFilterMethod;
+
    enum class Phase {FEASIBILITY_RESTORATION = 1, OPTIMALITY = 2};
 
-   class FeasibilityRestoration : public ConstraintRelaxationStrategy {
+   // Method and Strategy are the static types of the inequality handling method and of the globalization strategy. The default
+   // base types are combined at runtime by the factories; with final types, the calls to the ingredients are resolved at compile time
+   template <typename Method = InequalityHandlingMethod, typename Strategy = GlobalizationStrategy>
+   class FeasibilityRestoration final : public ConstraintRelaxationStrategy {
    public:
       FeasibilityRestoration(const Model& model, const Options& options);
 
@@ -23,9 +32,11 @@ namespace uno {
       [[nodiscard]] size_t maximum_number_constraints() const override;
 
       // direction computation
+      using ConstraintRelaxationStrategy::compute_feasible_direction;
       void compute_feasible_direction(Statistics& statistics, Iterate& current_iterate, Direction& direction, WarmstartInformation& warmstart_information) override;
       [[nodiscard]] bool solving_feasibility_problem() const override;
       void switch_to_feasibility_problem(Statistics& statistics, Iterate& current_iterate, WarmstartInformation& warmstart_information) override;
+      [[nodiscard]] bool compute_second_order_correction(Iterate& current_iterate, Iterate& trial_iterate, Direction& direction) override;
 
       // trial iterate acceptance
       [[nodiscard]] bool is_iterate_acceptable(Statistics& statistics, Iterate& current_iterate, Iterate& trial_iterate, const Direction& direction,
@@ -33,8 +44,12 @@ namespace uno {
 
       // primal-dual residuals
       void compute_primal_dual_residuals(Iterate& iterate) override;
+      void compute_feasibility_residuals(Iterate& iterate) const override;
       void set_dual_residuals_statistics(Statistics& statistics, const Iterate& iterate) const override;
 
+      void save_state(CheckpointWriter& writer) const override;
+      void load_state(CheckpointReader& reader, Iterate& current_iterate) override;
+
    private:
       const OptimalityProblem optimality_problem;
       l1RelaxedProblem feasibility_problem;
@@ -44,10 +59,13 @@ namespace uno {
       const bool switch_to_optimality_requires_linearized_feasibility;
       ProgressMeasures reference_optimality_progress{};
       Vector<double> reference_optimality_primals{};
+      Method& typed_inequality_handling_method;
+      Strategy& typed_globalization_strategy;
 
       // delegating constructor
       FeasibilityRestoration(const Model& model, OptimalityProblem&& optimality_problem, l1RelaxedProblem&& feasibility_problem, const Options& options);
 
+      [[nodiscard]] static bool is_gauss_newton_hessian_requested(const Options& options);
       [[nodiscard]] const OptimizationProblem& current_problem() const;
       void solve_subproblem(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
             Direction& direction, WarmstartInformation& warmstart_information);
@@ -58,6 +76,10 @@ namespace uno {
       [[nodiscard]] bool can_switch_to_optimality_phase(const Iterate& current_iterate, const Iterate& trial_iterate, const Direction& direction,
             double step_length);
    };
+
+   // compile-time pipelines of the ipopt and filtersqp presets
+   using InteriorPointFeasibilityRestoration = FeasibilityRestoration<PrimalDualInteriorPointMethod, WaechterFilterMethod>;
+   using SQPFeasibilityRestoration = FeasibilityRestoration<QPSubproblem, FletcherFilterMethod>;
 } // namespace
 
 #endif //UNO_FEASIBILITYRESTORATION_H
@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include "OptimalityProblem.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
 #include "optimization/Iterate.hpp"
 #include "optimization/LagrangianGradient.hpp"
 #include "symbolic/Expression.hpp"
@@ -21,10 +22,9 @@ namespace uno {
       constraints = iterate.evaluations.constraints;
    }
 
-   void OptimalityProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const {
+   void OptimalityProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrixView<double>& constraint_jacobian) const {
       iterate.evaluate_constraint_jacobian(this->model);
-      // TODO change this
-      constraint_jacobian = iterate.evaluations.constraint_jacobian;
+      constraint_jacobian.reset(iterate.evaluations.constraint_jacobian);
    }
 
    void OptimalityProblem::evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers,
@@ -32,59 +32,65 @@ namespace uno {
       this->model.evaluate_lagrangian_hessian(x, this->get_objective_multiplier(), multipliers, hessian);
    }
 
+   void OptimalityProblem::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& multipliers,
+         const Vector<double>& vector, Vector<double>& result) const {
+      this->model.evaluate_lagrangian_hessian_vector_product(x, this->get_objective_multiplier(), multipliers, vector, result);
+   }
+
    // Lagrangian gradient split in two parts: objective contribution and constraints' contribution
    void OptimalityProblem::evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate,
          const Multipliers& multipliers) const {
       lagrangian_gradient.objective_contribution.fill(0.);
-      lagrangian_gradient.constraints_contribution.fill(0.);
 
       // objective gradient
       for (auto [variable_index, derivative]: iterate.evaluations.objective_gradient) {
          lagrangian_gradient.objective_contribution[variable_index] += derivative;
       }
 
-      // constraints
-      for (size_t constraint_index: Range(this->number_constraints)) {
-         if (multipliers.constraints[constraint_index] != 0.) {
-            for (auto [variable_index, derivative]: iterate.evaluations.constraint_jacobian[constraint_index]) {
-               lagrangian_gradient.constraints_contribution[variable_index] -= multipliers.constraints[constraint_index] * derivative;
-            }
-         }
-      }
+      // constraints: J^T y (overwrites the whole constraints contribution)
+      jacobian_transposed_product(iterate.evaluations.constraint_jacobian, multipliers.constraints, lagrangian_gradient.constraints_contribution);
 
-      // bound constraints of original variables
+      // the constraints contribute -J^T y. The bound multipliers are nonzero only for the bounded variables
       for (size_t variable_index: Range(this->number_variables)) {
-         lagrangian_gradient.constraints_contribution[variable_index] -= (multipliers.lower_bounds[variable_index] +
-                                                                          multipliers.upper_bounds[variable_index]);
+         lagrangian_gradient.constraints_contribution[variable_index] = -lagrangian_gradient.constraints_contribution[variable_index];
       }
+      this->subtract_bound_multipliers(multipliers, lagrangian_gradient.constraints_contribution);
    }
 
-   double OptimalityProblem::complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
-         const Multipliers& multipliers, double shift_value, Norm residual_norm) const {
-      // bound constraints
-      const Range variables_range = Range(this->model.number_variables);
-      const VectorExpression variable_complementarity{variables_range, [&](size_t variable_index) {
-         if (0. < multipliers.lower_bounds[variable_index]) {
-            return multipliers.lower_bounds[variable_index] * (primals[variable_index] - this->model.variable_lower_bound(variable_index)) - shift_value;
-         }
-         if (multipliers.upper_bounds[variable_index] < 0.) {
-            return multipliers.upper_bounds[variable_index] * (primals[variable_index] - this->model.variable_upper_bound(variable_index)) - shift_value;
+   double OptimalityProblem::evaluate_stationarity_error(Vector<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers,
+         double objective_multiplier, Norm residual_norm) const {
+      // scaled objective gradient and constraints' contribution -J^T y, scattered into the same vector
+      lagrangian_gradient.fill(0.);
+      if (objective_multiplier != 0.) {
+         for (auto [variable_index, derivative]: iterate.evaluations.objective_gradient) {
+            lagrangian_gradient[variable_index] += objective_multiplier * derivative;
          }
-         return 0.;
-      }};
+      }
+      add_jacobian_transposed_product(iterate.evaluations.constraint_jacobian, multipliers.constraints, -1., lagrangian_gradient);
 
-      // inequality constraints
-      const VectorExpression constraint_complementarity{this->model.get_inequality_constraints(), [&](size_t constraint_index) {
-         if (0. < multipliers.constraints[constraint_index]) { // lower bound
-            return multipliers.constraints[constraint_index] * (constraints[constraint_index] - this->model.constraint_lower_bound(constraint_index)) -
-                   shift_value;
-         }
-         else if (multipliers.constraints[constraint_index] < 0.) { // upper bound
-            return multipliers.constraints[constraint_index] * (constraints[constraint_index] - this->model.constraint_upper_bound(constraint_index)) -
-                   shift_value;
-         }
-         return 0.;
-      }};
-      return norm(residual_norm, variable_complementarity, constraint_complementarity);
+      // bound constraints
+      this->subtract_bound_multipliers(multipliers, lagrangian_gradient);
+      return fused_norm(residual_norm, this->number_variables, [&](size_t variable_index) {
+         return lagrangian_gradient[variable_index];
+      });
+   }
+
+   double OptimalityProblem::complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
+         const Multipliers& multipliers, double shift_value, Norm residual_norm) const {
+      return fused_norm(residual_norm, [&](const auto& accumulate) {
+         // bound constraints
+         this->sweep_bound_complementarity(primals, multipliers, shift_value, accumulate);
+         // inequality constraints
+         this->model.get_inequality_constraints().for_each([&](size_t constraint_index) {
+            if (0. < multipliers.constraints[constraint_index]) { // lower bound
+               accumulate(multipliers.constraints[constraint_index] * (constraints[constraint_index] -
+                  this->model.constraint_lower_bound(constraint_index)) - shift_value);
+            }
+            else if (multipliers.constraints[constraint_index] < 0.) { // upper bound
+               accumulate(multipliers.constraints[constraint_index] * (constraints[constraint_index] -
+                  this->model.constraint_upper_bound(constraint_index)) - shift_value);
+            }
+         });
+      });
    }
 } // namespace
\ No newline at end of file
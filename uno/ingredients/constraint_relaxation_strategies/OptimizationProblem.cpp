@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include "OptimizationProblem.hpp"
+#include "symbolic/Range.hpp"
 
 namespace uno {
    OptimizationProblem::OptimizationProblem(const Model& model, size_t number_variables, size_t number_constraints):
@@ -20,14 +21,58 @@ namespace uno {
       return (!this->model.get_fixed_variables().empty());
    }
 
+   bool OptimizationProblem::has_constant_jacobian() const {
+      return this->model.has_constant_jacobian();
+   }
+
+   bool OptimizationProblem::has_constant_hessian() const {
+      return this->model.has_constant_hessian();
+   }
+
+   void OptimizationProblem::evaluate_hessian_low_rank_term(Vector<double>& factors, Vector<double>& middle_matrix) const {
+      this->model.evaluate_hessian_low_rank_term(factors, this->number_variables, middle_matrix);
+      for (size_t column_index: Range(this->model.hessian_low_rank_dimension())) {
+         for (size_t variable_index: Range(this->model.number_variables, this->number_variables)) {
+            factors[variable_index + column_index * this->number_variables] = 0.;
+         }
+      }
+   }
+
    size_t OptimizationProblem::get_number_original_variables() const {
       return this->model.number_variables;
    }
 
+   bool OptimizationProblem::get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const {
+      if (this->number_constraints != this->model.number_constraints || this->number_variables < this->model.number_variables) {
+         return false;
+      }
+      variable_statuses.assign(this->number_variables, BasisStatus::AT_LOWER_BOUND);
+      constraint_statuses.assign(this->number_constraints, BasisStatus::BASIC);
+      return this->model.get_initial_basis(variable_statuses, constraint_statuses);
+   }
+
+   bool OptimizationProblem::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      if (this->number_constraints != this->model.number_constraints || this->number_variables < this->model.number_variables) {
+         return false;
+      }
+      variable_stages.assign(this->number_variables, Model::no_stage);
+      constraint_stages.assign(this->number_constraints, Model::no_stage);
+      return this->model.get_stages(variable_stages, constraint_stages);
+   }
+
    double OptimizationProblem::stationarity_error(const LagrangianGradient<double>& lagrangian_gradient, double objective_multiplier,
          Norm residual_norm) {
       // norm of the scaled Lagrangian gradient
       const auto scaled_lagrangian = objective_multiplier * lagrangian_gradient.objective_contribution + lagrangian_gradient.constraints_contribution;
       return norm(residual_norm, scaled_lagrangian);
    }
+
+   void OptimizationProblem::subtract_bound_multipliers(const Multipliers& multipliers, Vector<double>& lagrangian_gradient) const {
+      this->get_lower_bounded_variables().for_each([&](size_t variable_index) {
+         lagrangian_gradient[variable_index] -= multipliers.lower_bounds[variable_index];
+      });
+      this->get_upper_bounded_variables().for_each([&](size_t variable_index) {
+         lagrangian_gradient[variable_index] -= multipliers.upper_bounds[variable_index];
+      });
+   }
 } // namespace
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "linear_algebra/Norm.hpp"
 #include "model/Model.hpp"
 #include "optimization/LagrangianGradient.hpp"
+#include "optimization/Multipliers.hpp"
 #include "symbolic/Expression.hpp"
 
 namespace uno {
@@ -15,9 +16,8 @@ namespace uno {
    template <typename ElementType>
    class Collection;
    class Iterate;
-   class Multipliers;
    template <typename ElementType>
-   class RectangularMatrix;
+   class RectangularMatrixView;
    template <typename ElementType>
    class SparseVector;
    template <typename IndexType, typename ElementType>
@@ -35,15 +35,29 @@ namespace uno {
       [[nodiscard]] bool is_constrained() const;
       [[nodiscard]] bool has_inequality_constraints() const;
       [[nodiscard]] bool has_fixed_variables() const;
+      // the derivatives do not depend on the primal-dual point (LP/QP structure)
+      [[nodiscard]] bool has_constant_jacobian() const;
+      [[nodiscard]] virtual bool has_constant_hessian() const;
 
       // function evaluations
       [[nodiscard]] virtual double get_objective_multiplier() const = 0;
       virtual void evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const = 0;
       virtual void evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const = 0;
-      virtual void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const = 0;
+      // binds the view to the Jacobian of the iterate (no copy) and adds the columns of the reformulation variables
+      virtual void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrixView<double>& constraint_jacobian) const = 0;
       virtual void evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers, SymmetricMatrix<size_t, double>& hessian) const = 0;
+      virtual void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& multipliers, const Vector<double>& vector,
+            Vector<double>& result) const = 0;
+      // low-rank term of the Lagrangian Hessian of the last evaluation (see Model::evaluate_hessian_low_rank_term), with
+      // number_variables rows. The additional variables (e.g. elastic variables) do not enter it
+      virtual void evaluate_hessian_low_rank_term(Vector<double>& factors, Vector<double>& middle_matrix) const;
 
       [[nodiscard]] size_t get_number_original_variables() const;
+      // basis provided by the user for the model (see Model::get_initial_basis). The additional variables (e.g. elastic variables) are
+      // at their lower bound. No basis is available if the reformulation changes the constraints
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const;
+      // stages of the model (see Model::get_stages). The additional variables (e.g. elastic variables) have no stage
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const;
       [[nodiscard]] virtual double variable_lower_bound(size_t variable_index) const = 0;
       [[nodiscard]] virtual double variable_upper_bound(size_t variable_index) const = 0;
       [[nodiscard]] virtual double constraint_lower_bound(size_t constraint_index) const = 0;
@@ -57,12 +71,42 @@ namespace uno {
       [[nodiscard]] virtual size_t number_jacobian_nonzeros() const = 0;
       [[nodiscard]] virtual size_t number_hessian_nonzeros() const = 0;
 
+      // split Lagrangian gradient: needed when the objective multiplier varies (KKT vs FJ stationarity, quasi-Newton updates)
       [[nodiscard]] static double stationarity_error(const LagrangianGradient<double>& lagrangian_gradient, double objective_multiplier,
             Norm residual_norm);
       virtual void evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers) const = 0;
+      // fused kernel for a fixed objective multiplier: accumulates the scaled Lagrangian gradient (objective gradient, J^T y and bound
+      // multipliers) in a single vector and returns its norm, computed in the same sweep as the bound multipliers
+      [[nodiscard]] virtual double evaluate_stationarity_error(Vector<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers,
+            double objective_multiplier, Norm residual_norm) const = 0;
       [[nodiscard]] virtual double complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
             const Multipliers& multipliers, double shift_value, Norm residual_norm) const = 0;
+
+   protected:
+      // the bound multipliers are stored densely, but are nonzero only for the bounded variables: the kernels below sweep the
+      // bounded variables only
+      void subtract_bound_multipliers(const Multipliers& multipliers, Vector<double>& lagrangian_gradient) const;
+      // passes the complementarity errors of the active bounds to the accumulation function (see fused_norm). A variable whose lower
+      // bound is active is not counted again for its upper bound
+      template <typename Accumulation>
+      void sweep_bound_complementarity(const Vector<double>& primals, const Multipliers& multipliers, double shift_value,
+            const Accumulation& accumulate) const;
    };
+
+   template <typename Accumulation>
+   void OptimizationProblem::sweep_bound_complementarity(const Vector<double>& primals, const Multipliers& multipliers, double shift_value,
+         const Accumulation& accumulate) const {
+      this->get_lower_bounded_variables().for_each([&](size_t variable_index) {
+         if (0. < multipliers.lower_bounds[variable_index]) {
+            accumulate(multipliers.lower_bounds[variable_index] * (primals[variable_index] - this->variable_lower_bound(variable_index)) - shift_value);
+         }
+      });
+      this->get_upper_bounded_variables().for_each([&](size_t variable_index) {
+         if (multipliers.upper_bounds[variable_index] < 0. && multipliers.lower_bounds[variable_index] <= 0.) {
+            accumulate(multipliers.upper_bounds[variable_index] * (primals[variable_index] - this->variable_upper_bound(variable_index)) - shift_value);
+         }
+      });
+   }
 } // namespace
 
 #endif // UNO_OPTIMIZATIONPROBLEM_H
\ No newline at end of file
@@ -5,11 +5,15 @@
 #include "l1Relaxation.hpp"
 #include "ingredients/globalization_strategies/GlobalizationStrategy.hpp"
 #include "ingredients/inequality_handling_methods/InequalityHandlingMethod.hpp"
+#include "ingredients/inequality_handling_methods/InequalityHandlingMethodFactory.hpp"
 #include "optimization/Direction.hpp"
 #include "optimization/Iterate.hpp"
 #include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
 #include "symbolic/VectorView.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Checkpoint.hpp"
+#include "tools/Profiler.hpp"
 #include "tools/Statistics.hpp"
 #include "tools/UserCallbacks.hpp"
 
@@ -35,10 +39,13 @@ namespace uno {
    l1Relaxation::l1Relaxation(const Model& model, l1RelaxedProblem&& feasibility_problem, l1RelaxedProblem&& l1_relaxed_problem, const Options& options) :
          ConstraintRelaxationStrategy(model, l1_relaxed_problem.number_variables, l1_relaxed_problem.number_constraints,
                l1_relaxed_problem.number_objective_gradient_nonzeros(), l1_relaxed_problem.number_jacobian_nonzeros(),
-               l1_relaxed_problem.number_hessian_nonzeros(), options),
+               // the Hessian sparsity is only requested if the subproblems use the Hessian
+               InequalityHandlingMethodFactory::uses_lagrangian_hessian(l1_relaxed_problem.number_constraints, options) ?
+                  l1_relaxed_problem.number_hessian_nonzeros() : 0, options),
          feasibility_problem(std::forward<l1RelaxedProblem>(feasibility_problem)),
          l1_relaxed_problem(std::forward<l1RelaxedProblem>(l1_relaxed_problem)),
-         penalty_parameter(options.get_double("l1_relaxation_initial_parameter")),
+         initial_penalty_parameter(options.get_double("l1_relaxation_initial_parameter")),
+         penalty_parameter(this->initial_penalty_parameter),
          tolerance(options.get_double("tolerance")),
          parameters({
                options.get_bool("l1_relaxation_fixed_parameter"),
@@ -48,10 +55,16 @@ namespace uno {
                options.get_double("l1_relaxation_residual_small_threshold")
          }),
          small_duals_threshold(options.get_double("l1_small_duals_threshold")),
-         trial_multipliers(this->l1_relaxed_problem.number_variables, model.number_constraints) {
+         trial_multipliers(this->l1_relaxed_problem.number_variables, model.number_constraints),
+         trial_lagrangian_gradient(this->feasibility_problem.number_variables) {
    }
 
    void l1Relaxation::initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) {
+      // a new solve starts with the initial penalty parameter
+      this->penalty_parameter = this->initial_penalty_parameter;
+      this->l1_relaxed_problem.set_objective_multiplier(this->penalty_parameter);
+      this->reset_early_termination();
+
       // statistics
       this->inequality_handling_method->initialize_statistics(statistics, options);
       statistics.add_column("penalty", Statistics::double_width - 5, options.get_int("statistics_penalty_parameter_column_order"));
@@ -62,10 +75,12 @@ namespace uno {
       initial_iterate.feasibility_multipliers.lower_bounds.resize(this->feasibility_problem.number_variables);
       initial_iterate.feasibility_multipliers.upper_bounds.resize(this->feasibility_problem.number_variables);
       this->inequality_handling_method->set_elastic_variable_values(this->l1_relaxed_problem, initial_iterate);
-      this->inequality_handling_method->generate_initial_iterate(this->l1_relaxed_problem, initial_iterate);
+      this->inequality_handling_method->forget_hessian_evaluation();
+      this->inequality_handling_method->generate_initial_iterate(statistics, this->l1_relaxed_problem, initial_iterate);
       this->evaluate_progress_measures(initial_iterate);
       this->compute_primal_dual_residuals(initial_iterate);
       this->set_statistics(statistics, initial_iterate);
+      this->globalization_strategy->reset();
       this->globalization_strategy->initialize(statistics, initial_iterate, options);
    }
 
@@ -95,8 +110,7 @@ namespace uno {
 
       // penalty update: if penalty parameter is already 0 or fixed by the user, no need to decrease it
       if (0. < this->penalty_parameter && !this->parameters.fixed_parameter) {
-         double linearized_residual = this->model.constraint_violation(current_iterate.evaluations.constraints +
-               current_iterate.evaluations.constraint_jacobian * direction.primals, Norm::L1);
+         double linearized_residual = this->compute_linearized_constraint_violation(current_iterate, direction.primals, 1., Norm::L1);
          DEBUG << "Linearized infeasibility mk(dk): " << linearized_residual << "\n\n";
 
          // terminate if the current direction is already feasible, otherwise adjust the penalty parameter
@@ -110,17 +124,15 @@ namespace uno {
             this->solve_subproblem(statistics, this->feasibility_problem, current_iterate, current_iterate.feasibility_multipliers, feasibility_direction,
                   warmstart_information);
             std::swap(direction.multipliers, direction.feasibility_multipliers);
-            const double residual_lowest_violation = this->model.constraint_violation(current_iterate.evaluations.constraints +
-                  current_iterate.evaluations.constraint_jacobian * feasibility_direction.primals, Norm::L1);
+            const double residual_lowest_violation = this->compute_linearized_constraint_violation(current_iterate, feasibility_direction.primals, 1., Norm::L1);
             DEBUG << "Lowest linearized infeasibility mk(dk): " << residual_lowest_violation << '\n';
             this->inequality_handling_method->exit_feasibility_problem(this->feasibility_problem, current_iterate);
 
             // stage f: update the penalty parameter based on the current dual error
             this->decrease_parameter_aggressively(current_iterate, feasibility_direction);
             if (this->penalty_parameter < current_penalty_parameter) {
-               this->solve_l1_relaxed_problem(statistics, current_iterate, direction, this->penalty_parameter, warmstart_information);
-               linearized_residual = this->model.constraint_violation(current_iterate.evaluations.constraints +
-                     current_iterate.evaluations.constraint_jacobian * direction.primals, Norm::L1);
+               this->resolve_l1_relaxed_problem(statistics, current_iterate, direction, this->penalty_parameter, warmstart_information);
+               linearized_residual = this->compute_linearized_constraint_violation(current_iterate, direction.primals, 1., Norm::L1);
             }
 
             // stage d: further decrease penalty parameter to reach a fraction of the ideal decrease
@@ -141,6 +153,7 @@ namespace uno {
 
       // solve the subproblem
       direction.set_dimensions(problem.number_variables, problem.number_constraints);
+      const ScopedTimer subproblem_timer("subproblem");
       this->inequality_handling_method->solve(statistics, problem, current_iterate, current_multipliers, direction, warmstart_information);
       direction.norm = norm_inf(view(direction.primals, 0, this->model.number_variables));
       DEBUG3 << direction << '\n';
@@ -157,6 +170,14 @@ namespace uno {
       }
    }
 
+   // only the objective changed since the previous solve: the subproblem solver keeps its factorization/active set and starts from the
+   // previous direction, and the Hessian model interpolates the Hessian in the penalty parameter instead of evaluating it again
+   void l1Relaxation::resolve_l1_relaxed_problem(Statistics& statistics, Iterate& current_iterate, Direction& direction,
+         double current_penalty_parameter, WarmstartInformation& warmstart_information) {
+      this->inequality_handling_method->set_initial_point(direction.primals);
+      this->solve_l1_relaxed_problem(statistics, current_iterate, direction, current_penalty_parameter, warmstart_information);
+   }
+
    void l1Relaxation::decrease_parameter_aggressively(Iterate& current_iterate, const Direction& direction) {
       this->trial_multipliers.constraints = current_iterate.feasibility_multipliers.constraints + direction.feasibility_multipliers.constraints;
       this->trial_multipliers.lower_bounds = current_iterate.feasibility_multipliers.lower_bounds + direction.feasibility_multipliers.lower_bounds;
@@ -178,9 +199,9 @@ namespace uno {
 
    // measure that combines KKT error and complementarity error
    double l1Relaxation::compute_infeasible_dual_error(Iterate& current_iterate) {
-      // stationarity error
-      this->feasibility_problem.evaluate_lagrangian_gradient(current_iterate.feasibility_residuals.lagrangian_gradient, current_iterate, this->trial_multipliers);
-      double error = norm_1(current_iterate.residuals.lagrangian_gradient.constraints_contribution);
+      // stationarity error of the feasibility problem (0 objective multiplier) with the trial multipliers
+      double error = this->feasibility_problem.evaluate_stationarity_error(this->trial_lagrangian_gradient, current_iterate,
+            this->trial_multipliers, 0., Norm::L1);
 
       // complementarity error
       const double shift_value = 0.;
@@ -193,14 +214,14 @@ namespace uno {
          double linearized_residual, double residual_lowest_violation, WarmstartInformation& warmstart_information) {
       while (0. < this->penalty_parameter && !this->linearized_residual_sufficient_decrease(current_iterate, linearized_residual,
             residual_lowest_violation)) {
+         Cancellation::check();
          // decrease the penalty parameter and re-solve the problem
          this->penalty_parameter /= this->parameters.decrease_factor;
          DEBUG << "Further decrease the penalty parameter to " << this->penalty_parameter << '\n';
-         this->solve_l1_relaxed_problem(statistics, current_iterate, direction, this->penalty_parameter, warmstart_information);
+         this->resolve_l1_relaxed_problem(statistics, current_iterate, direction, this->penalty_parameter, warmstart_information);
 
          // recompute the linearized residual
-         linearized_residual = this->model.constraint_violation(current_iterate.evaluations.constraints +
-               current_iterate.evaluations.constraint_jacobian * direction.primals, Norm::L1);
+         linearized_residual = this->compute_linearized_constraint_violation(current_iterate, direction.primals, 1., Norm::L1);
          DEBUG << "Linearized infeasibility mk(dk): " << linearized_residual << "\n\n";
       }
       DEBUG << "Condition enforce_linearized_residual_sufficient_decrease is true\n";
@@ -225,10 +246,11 @@ namespace uno {
    void l1Relaxation::enforce_descent_direction_for_l1_merit(Statistics& statistics, Iterate& current_iterate, Direction& direction,
          const Direction& feasibility_direction, WarmstartInformation& warmstart_information) {
       while (0. < this->penalty_parameter && !this->is_descent_direction_for_l1_merit_function(current_iterate, direction, feasibility_direction)) {
+         Cancellation::check();
          // decrease the penalty parameter and re-solve the problem
          this->penalty_parameter /= this->parameters.decrease_factor;
          DEBUG << "Further decrease the penalty parameter to " << this->penalty_parameter << '\n';
-         this->solve_l1_relaxed_problem(statistics, current_iterate, direction, this->penalty_parameter, warmstart_information);
+         this->resolve_l1_relaxed_problem(statistics, current_iterate, direction, this->penalty_parameter, warmstart_information);
       }
       DEBUG << "Condition enforce_descent_direction_for_l1_merit is true\n\n";
    }
@@ -243,8 +265,12 @@ namespace uno {
    bool l1Relaxation::is_iterate_acceptable(Statistics& statistics, Iterate& current_iterate, Iterate& trial_iterate, const Direction& direction,
          double step_length, WarmstartInformation& /*warmstart_information*/, UserCallbacks& user_callbacks) {
       this->inequality_handling_method->postprocess_iterate(this->l1_relaxed_problem, trial_iterate);
-      this->compute_progress_measures(current_iterate, trial_iterate);
       trial_iterate.objective_multiplier = this->l1_relaxed_problem.get_objective_multiplier();
+      if (!this->compute_progress_measures(current_iterate, trial_iterate, direction, trial_iterate.objective_multiplier)) {
+         statistics.set("status", "✘ (infeasibility)");
+         this->set_progress_statistics(statistics, trial_iterate);
+         return false;
+      }
 
       bool accept_iterate = false;
       if (direction.norm == 0.) {
@@ -269,7 +295,11 @@ namespace uno {
    }
 
    void l1Relaxation::compute_primal_dual_residuals(Iterate& iterate) {
-      ConstraintRelaxationStrategy::compute_primal_dual_residuals(this->l1_relaxed_problem, this->feasibility_problem, iterate);
+      ConstraintRelaxationStrategy::compute_primal_dual_residuals(this->l1_relaxed_problem, iterate);
+   }
+
+   void l1Relaxation::compute_feasibility_residuals(Iterate& iterate) const {
+      ConstraintRelaxationStrategy::compute_feasibility_residuals(this->feasibility_problem, iterate);
    }
 
    void l1Relaxation::evaluate_progress_measures(Iterate& iterate) const {
@@ -280,8 +310,8 @@ namespace uno {
 
    ProgressMeasures l1Relaxation::compute_predicted_reduction_models(Iterate& current_iterate, const Direction& direction, double step_length) {
       return {
-         this->compute_predicted_infeasibility_reduction_model(current_iterate, direction.primals, step_length),
-         this->compute_predicted_objective_reduction_model(current_iterate, direction.primals, step_length),
+         this->compute_predicted_infeasibility_reduction_model(current_iterate, direction, step_length),
+         this->compute_predicted_objective_reduction_model(current_iterate, direction, step_length),
          this->inequality_handling_method->compute_predicted_auxiliary_reduction_model(this->model, current_iterate, direction.primals, step_length)
       };
    }
@@ -306,4 +336,15 @@ namespace uno {
       statistics.set("stationarity", iterate.residuals.stationarity);
       statistics.set("complementarity", iterate.residuals.complementarity);
    }
+
+   void l1Relaxation::save_state(CheckpointWriter& writer) const {
+      writer.write(this->penalty_parameter);
+      ConstraintRelaxationStrategy::save_state(writer);
+   }
+
+   void l1Relaxation::load_state(CheckpointReader& reader, Iterate& current_iterate) {
+      this->penalty_parameter = reader.read_double();
+      this->l1_relaxed_problem.set_objective_multiplier(this->penalty_parameter);
+      ConstraintRelaxationStrategy::load_state(reader, current_iterate);
+   }
 } // namespace
@@ -40,17 +40,23 @@ namespace uno {
 
       // primal-dual residuals
       void compute_primal_dual_residuals(Iterate& iterate) override;
+      void compute_feasibility_residuals(Iterate& iterate) const override;
       void set_dual_residuals_statistics(Statistics& statistics, const Iterate& iterate) const override;
 
+      void save_state(CheckpointWriter& writer) const override;
+      void load_state(CheckpointReader& reader, Iterate& current_iterate) override;
+
    protected:
       const l1RelaxedProblem feasibility_problem;
       l1RelaxedProblem l1_relaxed_problem;
+      const double initial_penalty_parameter;
       double penalty_parameter;
       const double tolerance;
       const l1RelaxationParameters parameters;
       const double small_duals_threshold;
       // preallocated temporary multipliers
       Multipliers trial_multipliers;
+      Vector<double> trial_lagrangian_gradient;
 
       // delegating constructor
       l1Relaxation(const Model& model, l1RelaxedProblem&& feasibility_problem, l1RelaxedProblem&& l1_relaxed_problem, const Options& options);
@@ -59,6 +65,8 @@ namespace uno {
             WarmstartInformation& warmstart_information);
       void solve_l1_relaxed_problem(Statistics& statistics, Iterate& current_iterate, Direction& direction, double current_penalty_parameter,
             WarmstartInformation& warmstart_information);
+      void resolve_l1_relaxed_problem(Statistics& statistics, Iterate& current_iterate, Direction& direction, double current_penalty_parameter,
+            WarmstartInformation& warmstart_information);
       void solve_subproblem(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
             Direction& direction, WarmstartInformation& warmstart_information);
 
@@ -1,9 +1,12 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include "l1RelaxedProblem.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "model/Model.hpp"
+#include "optimization/EvaluationCounters.hpp"
 #include "optimization/Iterate.hpp"
 #include "optimization/LagrangianGradient.hpp"
 #include "symbolic/Expression.hpp"
@@ -13,15 +16,15 @@
 
 namespace uno {
    l1RelaxedProblem::l1RelaxedProblem(const Model& model, double objective_multiplier, double constraint_violation_coefficient,
-         double proximal_coefficient, double const* proximal_center):
+         double proximal_coefficient, double const* proximal_center, bool gauss_newton_hessian):
    // call delegating constructor
          l1RelaxedProblem(model, ElasticVariables::generate(model), objective_multiplier, constraint_violation_coefficient, proximal_coefficient,
-               proximal_center) {
+               proximal_center, gauss_newton_hessian) {
    }
 
    // private delegating constructor
    l1RelaxedProblem::l1RelaxedProblem(const Model& model, ElasticVariables&& elastic_variables, double objective_multiplier,
-         double constraint_violation_coefficient, double proximal_coefficient, double const* proximal_center):
+         double constraint_violation_coefficient, double proximal_coefficient, double const* proximal_center, bool gauss_newton_hessian):
          OptimizationProblem(model, model.number_variables + elastic_variables.size(), model.number_constraints),
          objective_multiplier(objective_multiplier),
          constraint_violation_coefficient(constraint_violation_coefficient),
@@ -32,7 +35,23 @@ namespace uno {
          lower_bounded_variables(concatenate(this->model.get_lower_bounded_variables(), Range(model.number_variables,
                model.number_variables + this->elastic_variables.size()))),
          single_lower_bounded_variables(concatenate(this->model.get_single_lower_bounded_variables(),
-               Range(model.number_variables, model.number_variables + this->elastic_variables.size()))) {
+               Range(model.number_variables, model.number_variables + this->elastic_variables.size()))),
+         gauss_newton_hessian(gauss_newton_hessian),
+         gauss_newton_jacobian(gauss_newton_hessian ? model.number_constraints : 0, gauss_newton_hessian ? model.number_variables : 0),
+         gauss_newton_column(gauss_newton_hessian ? model.number_variables : 0),
+         gauss_newton_jacobian_product(gauss_newton_hessian ? model.number_constraints : 0) {
+      if (this->gauss_newton_hessian) {
+         this->jacobian_column_starts.resize(model.number_variables + 1);
+         this->gauss_newton_column_markers.resize(model.number_variables, 0);
+         // the sparsity pattern of J^T J (upper triangle + diagonal) is determined at the initial point
+         Vector<double> initial_point(model.number_variables);
+         model.initial_primal_point(initial_point);
+         this->evaluate_gauss_newton_jacobian(initial_point);
+         for (size_t column_index: Range(model.number_variables)) {
+            this->compute_gauss_newton_column(column_index);
+            this->number_gauss_newton_hessian_nonzeros += this->gauss_newton_column_pattern.size();
+         }
+      }
    }
 
    double l1RelaxedProblem::get_objective_multiplier() const {
@@ -51,11 +70,8 @@ namespace uno {
          objective_gradient.clear();
       }
 
-      // constraint violation (through elastic variables) contribution
-      for (const auto [_, elastic_index]: this->elastic_variables.positive) {
-         objective_gradient.insert(elastic_index, this->constraint_violation_coefficient);
-      }
-      for (const auto [_, elastic_index]: this->elastic_variables.negative) {
+      // constraint violation (through elastic variables) contribution: the elastics are contiguous
+      for (size_t elastic_index: Range(this->model.number_variables, this->number_variables)) {
          objective_gradient.insert(elastic_index, this->constraint_violation_coefficient);
       }
 
@@ -73,29 +89,47 @@ namespace uno {
       iterate.evaluate_constraints(this->model);
       constraints = iterate.evaluations.constraints;
       // add the contribution of the elastics
-      for (const auto [constraint_index, elastic_index]: this->elastic_variables.positive) {
-         constraints[constraint_index] -= iterate.primals[elastic_index];
-      }
-      for (const auto [constraint_index, elastic_index]: this->elastic_variables.negative) {
-         constraints[constraint_index] += iterate.primals[elastic_index];
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (const size_t elastic_index = this->elastic_variables.positive[constraint_index]; elastic_index != ElasticVariables::none) {
+            constraints[constraint_index] -= iterate.primals[elastic_index];
+         }
+         if (const size_t elastic_index = this->elastic_variables.negative[constraint_index]; elastic_index != ElasticVariables::none) {
+            constraints[constraint_index] += iterate.primals[elastic_index];
+         }
       }
    }
 
-   void l1RelaxedProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const {
+   void l1RelaxedProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrixView<double>& constraint_jacobian) const {
       iterate.evaluate_constraint_jacobian(this->model);
-      // TODO change this
-      constraint_jacobian = iterate.evaluations.constraint_jacobian;
-      // add the contribution of the elastics
-      for (const auto [constraint_index, elastic_index]: this->elastic_variables.positive) {
-         constraint_jacobian[constraint_index].insert(elastic_index, -1.);
-      }
-      for (const auto [constraint_index, elastic_index]: this->elastic_variables.negative) {
-         constraint_jacobian[constraint_index].insert(elastic_index, 1.);
-      }
+      constraint_jacobian.reset(iterate.evaluations.constraint_jacobian);
+      // the elastics contribute -p_j + n_j to constraint j: they are enumerated lazily by the view
+      static_assert(ElasticVariables::none == RectangularMatrixView<double>::none);
+      constraint_jacobian.add_structured_column(this->elastic_variables.positive, -1.);
+      constraint_jacobian.add_structured_column(this->elastic_variables.negative, 1.);
    }
 
    void l1RelaxedProblem::evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers,
          SymmetricMatrix<size_t, double>& hessian) const {
+      if (this->uses_gauss_newton_hessian()) {
+         // Gauss-Newton model sigma J^T J + proximal term, assembled column by column (upper triangle)
+         hessian.reset();
+         this->evaluate_gauss_newton_jacobian(x);
+         for (size_t column_index: Range(this->model.number_variables)) {
+            this->compute_gauss_newton_column(column_index);
+            for (size_t row_index: this->gauss_newton_column_pattern) {
+               double entry = this->constraint_violation_coefficient * this->gauss_newton_column[row_index];
+               if (row_index == column_index) {
+                  entry += this->proximal_hessian_term(column_index);
+               }
+               hessian.insert(entry, row_index, column_index);
+            }
+            hessian.finalize_column(column_index);
+         }
+         for (size_t elastic_index: Range(this->model.number_variables, this->number_variables)) {
+            hessian.finalize_column(elastic_index);
+         }
+         return;
+      }
       this->model.evaluate_lagrangian_hessian(x, this->objective_multiplier, multipliers, hessian);
 
       // proximal contribution
@@ -113,41 +147,97 @@ namespace uno {
       }
    }
 
+   void l1RelaxedProblem::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& multipliers,
+         const Vector<double>& vector, Vector<double>& result) const {
+      if (this->uses_gauss_newton_hessian()) {
+         // sigma J^T (J v) + proximal term
+         this->evaluate_gauss_newton_jacobian(x);
+         jacobian_product(this->gauss_newton_jacobian, vector, this->gauss_newton_jacobian_product);
+         for (size_t variable_index: Range(this->model.number_variables)) {
+            result[variable_index] = this->proximal_hessian_term(variable_index) * vector[variable_index];
+         }
+         for (size_t constraint_index: Range(this->model.number_constraints)) {
+            const double scaled_product = this->constraint_violation_coefficient * this->gauss_newton_jacobian_product[constraint_index];
+            for (const auto [variable_index, derivative]: this->gauss_newton_jacobian[constraint_index]) {
+               result[variable_index] += derivative * scaled_product;
+            }
+         }
+         for (size_t elastic_index: Range(this->model.number_variables, this->number_variables)) {
+            result[elastic_index] = 0.;
+         }
+         return;
+      }
+      this->model.evaluate_lagrangian_hessian_vector_product(x, this->objective_multiplier, multipliers, vector, result);
+
+      // proximal contribution
+      if (this->proximal_center != nullptr && this->proximal_coefficient != 0.) {
+         for (size_t variable_index: Range(this->model.number_variables)) {
+            const double scaling = std::min(1., 1./std::abs(this->proximal_center[variable_index]));
+            result[variable_index] += this->proximal_coefficient * scaling * scaling * vector[variable_index];
+         }
+      }
+
+      // the elastics do not enter the Hessian
+      for (size_t elastic_index: Range(this->model.number_variables, this->number_variables)) {
+         result[elastic_index] = 0.;
+      }
+   }
+
+   void l1RelaxedProblem::evaluate_hessian_low_rank_term(Vector<double>& factors, Vector<double>& middle_matrix) const {
+      if (this->uses_gauss_newton_hessian()) {
+         // the Gauss-Newton model has no low-rank term: W = 0, and M is a diagonal matrix with the expected inertia
+         const size_t dimension = this->model.hessian_low_rank_dimension();
+         for (size_t column_index: Range(dimension)) {
+            for (size_t variable_index: Range(this->number_variables)) {
+               factors[variable_index + column_index * this->number_variables] = 0.;
+            }
+            for (size_t row_index: Range(dimension)) {
+               middle_matrix[row_index + column_index * dimension] = (row_index != column_index) ? 0. : (column_index < dimension / 2) ? 1. : -1.;
+            }
+         }
+         return;
+      }
+      OptimizationProblem::evaluate_hessian_low_rank_term(factors, middle_matrix);
+   }
+
+   // the proximal term is updated at each iteration
+   bool l1RelaxedProblem::has_constant_hessian() const {
+      const bool has_constant_constraint_hessian = this->uses_gauss_newton_hessian() ? this->model.has_constant_jacobian() :
+            this->model.has_constant_hessian();
+      return has_constant_constraint_hessian && (this->proximal_center == nullptr || this->proximal_coefficient == 0.);
+   }
+
    // Lagrangian gradient split in two parts: objective contribution and constraints' contribution
    void l1RelaxedProblem::evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate,
          const Multipliers& multipliers) const {
       lagrangian_gradient.objective_contribution.fill(0.);
-      lagrangian_gradient.constraints_contribution.fill(0.);
 
       // objective gradient
       for (auto [variable_index, derivative]: iterate.evaluations.objective_gradient) {
          lagrangian_gradient.objective_contribution[variable_index] += derivative;
       }
 
-      // constraints
-      for (size_t constraint_index: Range(this->number_constraints)) {
-         if (multipliers.constraints[constraint_index] != 0.) {
-            for (auto [variable_index, derivative]: iterate.evaluations.constraint_jacobian[constraint_index]) {
-               lagrangian_gradient.constraints_contribution[variable_index] -= multipliers.constraints[constraint_index] * derivative;
-            }
-         }
-      }
+      // constraints: J^T y (overwrites the whole constraints contribution)
+      jacobian_transposed_product(iterate.evaluations.constraint_jacobian, multipliers.constraints, lagrangian_gradient.constraints_contribution);
 
-      // bound constraints of original variables
+      // the constraints contribute -J^T y
       for (size_t variable_index: Range(this->model.number_variables)) {
-         lagrangian_gradient.constraints_contribution[variable_index] -= (multipliers.lower_bounds[variable_index] +
-                                                                          multipliers.upper_bounds[variable_index]);
+         lagrangian_gradient.constraints_contribution[variable_index] = -lagrangian_gradient.constraints_contribution[variable_index];
       }
 
       // elastic variables
-      for (const auto [constraint_index, elastic_index]: this->elastic_variables.positive) {
-         lagrangian_gradient.constraints_contribution[elastic_index] += this->constraint_violation_coefficient +
-            multipliers.constraints[constraint_index] - multipliers.lower_bounds[elastic_index];
-      }
-      for (const auto [constraint_index, elastic_index]: this->elastic_variables.negative) {
-         lagrangian_gradient.constraints_contribution[elastic_index] += this->constraint_violation_coefficient -
-            multipliers.constraints[constraint_index] - multipliers.lower_bounds[elastic_index];
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (const size_t elastic_index = this->elastic_variables.positive[constraint_index]; elastic_index != ElasticVariables::none) {
+            lagrangian_gradient.constraints_contribution[elastic_index] += this->constraint_violation_coefficient +
+               multipliers.constraints[constraint_index];
+         }
+         if (const size_t elastic_index = this->elastic_variables.negative[constraint_index]; elastic_index != ElasticVariables::none) {
+            lagrangian_gradient.constraints_contribution[elastic_index] += this->constraint_violation_coefficient -
+               multipliers.constraints[constraint_index];
+         }
       }
+      // bound constraints of the original and elastic variables
+      this->subtract_bound_multipliers(multipliers, lagrangian_gradient.constraints_contribution);
 
       // proximal contribution
       if (this->proximal_center != nullptr && this->proximal_coefficient != 0.) {
@@ -160,21 +250,45 @@ namespace uno {
       }
    }
 
-   // complementary slackness error: expression for violated constraints depends on the definition of the relaxed problem
-   double l1RelaxedProblem::complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
-         const Multipliers& multipliers, double shift_value, Norm residual_norm) const {
-      // bound constraints
-      const Range variables_range = Range(this->number_variables);
-      const VectorExpression bounds_complementarity{variables_range, [&](size_t variable_index) {
-         if (0. < multipliers.lower_bounds[variable_index]) {
-            return multipliers.lower_bounds[variable_index] * (primals[variable_index] - this->variable_lower_bound(variable_index)) - shift_value;
+   double l1RelaxedProblem::evaluate_stationarity_error(Vector<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers,
+         double objective_multiplier, Norm residual_norm) const {
+      // scaled objective gradient and constraints' contribution -J^T y, scattered into the same vector
+      lagrangian_gradient.fill(0.);
+      if (objective_multiplier != 0.) {
+         for (auto [variable_index, derivative]: iterate.evaluations.objective_gradient) {
+            lagrangian_gradient[variable_index] += objective_multiplier * derivative;
+         }
+      }
+      add_jacobian_transposed_product(iterate.evaluations.constraint_jacobian, multipliers.constraints, -1., lagrangian_gradient);
+
+      // elastic variables
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (const size_t elastic_index = this->elastic_variables.positive[constraint_index]; elastic_index != ElasticVariables::none) {
+            lagrangian_gradient[elastic_index] += this->constraint_violation_coefficient + multipliers.constraints[constraint_index];
          }
-         if (multipliers.upper_bounds[variable_index] < 0.) {
-            return multipliers.upper_bounds[variable_index] * (primals[variable_index] - this->variable_upper_bound(variable_index)) - shift_value;
+         if (const size_t elastic_index = this->elastic_variables.negative[constraint_index]; elastic_index != ElasticVariables::none) {
+            lagrangian_gradient[elastic_index] += this->constraint_violation_coefficient - multipliers.constraints[constraint_index];
          }
-         return 0.;
-      }};
+      }
+
+      // bound constraints of the original and elastic variables
+      this->subtract_bound_multipliers(multipliers, lagrangian_gradient);
 
+      // proximal contribution, fused with the norm
+      const bool has_proximal_term = (this->proximal_center != nullptr && this->proximal_coefficient != 0.);
+      return fused_norm(residual_norm, this->number_variables, [&](size_t variable_index) {
+         if (has_proximal_term && variable_index < this->model.number_variables) {
+            const double scaling = std::min(1., 1./std::abs(this->proximal_center[variable_index]));
+            const double proximal_term = this->proximal_coefficient * scaling * scaling;
+            lagrangian_gradient[variable_index] += proximal_term * (iterate.primals[variable_index] - this->proximal_center[variable_index]);
+         }
+         return lagrangian_gradient[variable_index];
+      });
+   }
+
+   // complementary slackness error: expression for violated constraints depends on the definition of the relaxed problem
+   double l1RelaxedProblem::complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
+         const Multipliers& multipliers, double shift_value, Norm residual_norm) const {
       // general constraints
       // TODO use the values of the relaxed constraints
       const Range constraints_range = Range(this->number_constraints);
@@ -189,7 +303,10 @@ namespace uno {
          }
          return 0.;
       }};
-      return norm(residual_norm, bounds_complementarity);
+      // bound constraints
+      return fused_norm(residual_norm, [&](const auto& accumulate) {
+         this->sweep_bound_complementarity(primals, multipliers, shift_value, accumulate);
+      });
    }
 
    double l1RelaxedProblem::variable_lower_bound(size_t variable_index) const {
@@ -252,6 +369,9 @@ namespace uno {
    }
 
    size_t l1RelaxedProblem::number_hessian_nonzeros() const {
+      if (this->uses_gauss_newton_hessian()) {
+         return this->number_gauss_newton_hessian_nonzeros;
+      }
       return this->model.number_hessian_nonzeros();
    }
 
@@ -260,6 +380,10 @@ namespace uno {
       this->objective_multiplier = new_objective_multiplier;
    }
 
+   double l1RelaxedProblem::get_proximal_multiplier() const {
+      return this->proximal_coefficient;
+   }
+
    void l1RelaxedProblem::set_proximal_multiplier(double new_proximal_coefficient) {
       this->proximal_coefficient = new_proximal_coefficient;
    }
@@ -271,11 +395,88 @@ namespace uno {
    void l1RelaxedProblem::set_elastic_variable_values(Iterate& iterate, const std::function<void(Iterate&, size_t, size_t, double)>&
    elastic_setting_function) const {
       iterate.set_number_variables(this->number_variables);
-      for (const auto [constraint_index, elastic_index]: this->elastic_variables.positive) {
-         elastic_setting_function(iterate, constraint_index, elastic_index, -1.);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (const size_t elastic_index = this->elastic_variables.positive[constraint_index]; elastic_index != ElasticVariables::none) {
+            elastic_setting_function(iterate, constraint_index, elastic_index, -1.);
+         }
+         if (const size_t elastic_index = this->elastic_variables.negative[constraint_index]; elastic_index != ElasticVariables::none) {
+            elastic_setting_function(iterate, constraint_index, elastic_index, 1.);
+         }
+      }
+   }
+
+   // the Gauss-Newton model only replaces the Hessian of the constraints when the objective does not contribute
+   bool l1RelaxedProblem::uses_gauss_newton_hessian() const {
+      return this->gauss_newton_hessian && this->objective_multiplier == 0.;
+   }
+
+   // evaluate the model Jacobian and store its transpose
+   void l1RelaxedProblem::evaluate_gauss_newton_jacobian(const Vector<double>& x) const {
+      this->gauss_newton_jacobian.clear();
+      if (this->model.is_constrained()) {
+         this->model.set_current_point(x);
+         this->model.evaluate_constraint_jacobian(x, this->gauss_newton_jacobian);
+         EvaluationCounters::current().jacobian++;
+      }
+
+      // counting sort of the nonzeros by column
+      std::fill(this->jacobian_column_starts.begin(), this->jacobian_column_starts.end(), size_t(0));
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         for (const auto [variable_index, derivative]: this->gauss_newton_jacobian[constraint_index]) {
+            this->jacobian_column_starts[variable_index + 1]++;
+         }
+      }
+      for (size_t variable_index: Range(this->model.number_variables)) {
+         this->jacobian_column_starts[variable_index + 1] += this->jacobian_column_starts[variable_index];
+      }
+      const size_t number_nonzeros = this->jacobian_column_starts[this->model.number_variables];
+      this->jacobian_column_constraints.resize(number_nonzeros);
+      this->jacobian_column_values.resize(number_nonzeros);
+      for (size_t constraint_index: Range(this->model.number_constraints)) {
+         for (const auto [variable_index, derivative]: this->gauss_newton_jacobian[constraint_index]) {
+            const size_t position = this->jacobian_column_starts[variable_index]++;
+            this->jacobian_column_constraints[position] = constraint_index;
+            this->jacobian_column_values[position] = derivative;
+         }
+      }
+      // the column starts were shifted by the insertion: restore them
+      for (size_t variable_index = this->model.number_variables; 0 < variable_index; variable_index--) {
+         this->jacobian_column_starts[variable_index] = this->jacobian_column_starts[variable_index - 1];
+      }
+      this->jacobian_column_starts[0] = 0;
+   }
+
+   // accumulate the upper triangle of column column_index of J^T J. The sorted row indices (including the diagonal) are stored in
+   // gauss_newton_column_pattern and the entries in gauss_newton_column
+   void l1RelaxedProblem::compute_gauss_newton_column(size_t column_index) const {
+      this->gauss_newton_column_pattern.clear();
+      // the markers are stamped with column_index + 1
+      const size_t stamp = column_index + 1;
+      this->gauss_newton_column_markers[column_index] = stamp;
+      this->gauss_newton_column_pattern.emplace_back(column_index);
+      this->gauss_newton_column[column_index] = 0.;
+      for (size_t position: Range(this->jacobian_column_starts[column_index], this->jacobian_column_starts[column_index + 1])) {
+         const size_t constraint_index = this->jacobian_column_constraints[position];
+         const double column_derivative = this->jacobian_column_values[position];
+         for (const auto [row_index, row_derivative]: this->gauss_newton_jacobian[constraint_index]) {
+            if (row_index <= column_index) {
+               if (this->gauss_newton_column_markers[row_index] != stamp) {
+                  this->gauss_newton_column_markers[row_index] = stamp;
+                  this->gauss_newton_column_pattern.emplace_back(row_index);
+                  this->gauss_newton_column[row_index] = 0.;
+               }
+               this->gauss_newton_column[row_index] += row_derivative * column_derivative;
+            }
+         }
       }
-      for (const auto [constraint_index, elastic_index]: this->elastic_variables.negative) {
-         elastic_setting_function(iterate, constraint_index, elastic_index, 1.);
+      std::sort(this->gauss_newton_column_pattern.begin(), this->gauss_newton_column_pattern.end());
+   }
+
+   double l1RelaxedProblem::proximal_hessian_term(size_t variable_index) const {
+      if (this->proximal_center != nullptr && this->proximal_coefficient != 0.) {
+         const double scaling = std::min(1., 1./std::abs(this->proximal_center[variable_index]));
+         return this->proximal_coefficient * scaling * scaling;
       }
+      return 0.;
    }
 } // namespace
\ No newline at end of file
@@ -4,21 +4,30 @@
 #ifndef UNO_L1RELAXEDPROBLEM_H
 #define UNO_L1RELAXEDPROBLEM_H
 
+#include <vector>
 #include "OptimizationProblem.hpp"
 #include "ElasticVariables.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
 #include "symbolic/Concatenation.hpp"
 
 namespace uno {
+   // when gauss_newton_hessian is set and the objective multiplier is 0, the Hessian of the constraints is replaced with the
+   // Gauss-Newton model sigma J^T J of the constraint violation, which requires no second derivatives
    class l1RelaxedProblem: public OptimizationProblem {
    public:
       l1RelaxedProblem(const Model& model, double objective_multiplier, double constraint_violation_coefficient, double proximal_coefficient,
-            double const* proximal_center);
+            double const* proximal_center, bool gauss_newton_hessian = false);
 
       [[nodiscard]] double get_objective_multiplier() const override;
       void evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const override;
       void evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const override;
-      void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrixView<double>& constraint_jacobian) const override;
       void evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers, SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& multipliers, const Vector<double>& vector,
+            Vector<double>& result) const override;
+      void evaluate_hessian_low_rank_term(Vector<double>& factors, Vector<double>& middle_matrix) const override;
+      [[nodiscard]] bool has_constant_hessian() const override;
 
       [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
       [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
@@ -35,12 +44,15 @@ namespace uno {
       [[nodiscard]] size_t number_hessian_nonzeros() const override;
 
       void evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers) const override;
+      [[nodiscard]] double evaluate_stationarity_error(Vector<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers,
+            double objective_multiplier, Norm residual_norm) const override;
       [[nodiscard]] double complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
             const Multipliers& multipliers, double shift_value, Norm residual_norm) const override;
 
       // parameterization
       void set_objective_multiplier(double new_objective_multiplier);
 
+      [[nodiscard]] double get_proximal_multiplier() const;
       void set_proximal_multiplier(double new_proximal_coefficient);
       void set_proximal_center(double const* new_proximal_center);
       void set_elastic_variable_values(Iterate& iterate, const std::function<void(Iterate&, size_t, size_t, double)>& elastic_setting_function) const;
@@ -54,9 +66,26 @@ namespace uno {
       const Concatenation<const Collection<size_t>&, ForwardRange> lower_bounded_variables; // model variables + elastic variables
       const Concatenation<const Collection<size_t>&, ForwardRange> single_lower_bounded_variables; // model variables + elastic variables
 
+      // Gauss-Newton Hessian: the model Jacobian is also stored by columns (its transpose) to assemble J^T J column by column
+      const bool gauss_newton_hessian;
+      size_t number_gauss_newton_hessian_nonzeros{0};
+      mutable RectangularMatrix<double> gauss_newton_jacobian;
+      mutable std::vector<size_t> jacobian_column_starts{};
+      mutable std::vector<size_t> jacobian_column_constraints{};
+      mutable std::vector<double> jacobian_column_values{};
+      mutable Vector<double> gauss_newton_column;
+      mutable std::vector<size_t> gauss_newton_column_pattern{};
+      mutable std::vector<size_t> gauss_newton_column_markers{};
+      mutable Vector<double> gauss_newton_jacobian_product;
+
       // delegating constructor
       l1RelaxedProblem(const Model& model, ElasticVariables&& elastic_variables, double objective_multiplier, double constraint_violation_coefficient,
-            double proximal_coefficient, double const* proximal_center);
+            double proximal_coefficient, double const* proximal_center, bool gauss_newton_hessian);
+
+      [[nodiscard]] bool uses_gauss_newton_hessian() const;
+      void evaluate_gauss_newton_jacobian(const Vector<double>& x) const;
+      void compute_gauss_newton_column(size_t column_index) const;
+      [[nodiscard]] double proximal_hessian_term(size_t variable_index) const;
    };
 } // namespace
 
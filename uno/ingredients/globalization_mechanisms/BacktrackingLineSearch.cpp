@@ -1,51 +1,83 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <cassert>
-#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include <stdexcept>
+#include <utility>
+#include "ingredients/constraint_relaxation_strategies/FeasibilityRestoration.hpp"
 #include "BacktrackingLineSearch.hpp"
+#include "StepLengthInterpolation.hpp"
 #include "model/Model.hpp"
+#include "optimization/EvaluationCounters.hpp"
 #include "optimization/EvaluationErrors.hpp"
 #include "optimization/Iterate.hpp"
 #include "optimization/WarmstartInformation.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Infinity.hpp"
 #include "tools/Logger.hpp"
 #include "options/Options.hpp"
 #include "tools/Statistics.hpp"
+#include "tools/Timeline.hpp"
 
 namespace uno {
-   BacktrackingLineSearch::BacktrackingLineSearch(ConstraintRelaxationStrategy& constraint_relaxation_strategy, const Options& options):
+   template <typename Relaxation>
+   BacktrackingLineSearch<Relaxation>::BacktrackingLineSearch(Relaxation& constraint_relaxation_strategy, const Options& options):
          GlobalizationMechanism(constraint_relaxation_strategy),
+         relaxation_strategy(constraint_relaxation_strategy),
          backtracking_ratio(options.get_double("LS_backtracking_ratio")),
          minimum_step_length(options.get_double("LS_min_step_length")),
-         scale_duals_with_step_length(options.get_bool("LS_scale_duals_with_step_length")) {
+         max_backtracks(options.get_unsigned_int("LS_max_backtracks")),
+         scale_duals_with_step_length(options.get_bool("LS_scale_duals_with_step_length")),
+         max_second_order_corrections(options.get_unsigned_int("LS_max_second_order_corrections")),
+         second_order_correction_decrease(options.get_double("LS_second_order_correction_decrease")),
+         second_order_direction(this->constraint_relaxation_strategy.maximum_number_variables(),
+               this->constraint_relaxation_strategy.maximum_number_constraints()),
+         number_speculative_trials(options.get_unsigned_int("LS_speculative_trials")),
+         interpolate_step_length(options.get_bool("LS_interpolate_step_length")) {
       // check the initial and minimal step lengths
       assert(0 < this->backtracking_ratio && this->backtracking_ratio < 1. && "The LS backtracking ratio should be in (0, 1)");
       assert(0 < this->minimum_step_length && this->minimum_step_length < 1. && "The LS minimum step length should be in (0, 1)");
+      if (this->number_speculative_trials == 0) {
+         throw std::invalid_argument("The number of speculative LS trials should be positive");
+      }
    }
 
-   void BacktrackingLineSearch::initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) {
+   template <typename Relaxation>
+   void BacktrackingLineSearch<Relaxation>::initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) {
       statistics.add_column("LS iter", Statistics::int_width + 2, options.get_int("statistics_minor_column_order"));
       statistics.add_column("step length", Statistics::double_width - 4, options.get_int("statistics_LS_step_length_column_order"));
       
-      this->constraint_relaxation_strategy.initialize(statistics, initial_iterate, options);
+      this->relaxation_strategy.initialize(statistics, initial_iterate, options);
    }
 
-   void BacktrackingLineSearch::compute_next_iterate(Statistics& statistics, const Model& model, Iterate& current_iterate, Iterate& trial_iterate,
+   template <typename Relaxation>
+   void BacktrackingLineSearch<Relaxation>::compute_next_iterate(Statistics& statistics, const Model& model, Iterate& current_iterate,
+         Iterate& trial_iterate,
          WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) {
       DEBUG2 << "Current iterate\n" << current_iterate << '\n';
 
-      this->constraint_relaxation_strategy.compute_feasible_direction(statistics, current_iterate, this->direction, warmstart_information);
+      this->relaxation_strategy.compute_feasible_direction(statistics, current_iterate, this->direction, warmstart_information);
       BacktrackingLineSearch::check_unboundedness(this->direction);
       this->backtrack_along_direction(statistics, model, current_iterate, trial_iterate, warmstart_information, user_callbacks);
    }
 
    // go a fraction along the direction by finding an acceptable step length
-   void BacktrackingLineSearch::backtrack_along_direction(Statistics& statistics, const Model& model, Iterate& current_iterate,
+   template <typename Relaxation>
+   void BacktrackingLineSearch<Relaxation>::backtrack_along_direction(Statistics& statistics, const Model& model, Iterate& current_iterate,
          Iterate& trial_iterate, WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) {
       double step_length = 1.;
       bool termination = false;
       size_t number_iterations = 0;
+      const bool speculative_trials = (1 < this->number_speculative_trials && model.supports_concurrent_evaluations());
+      // discard the speculative iterates of the previous direction
+      this->next_speculative_index = this->speculative_iterates.size();
+      this->reset_interpolation();
+      // the interpolation needs trial iterates along the direction (not after second-order corrections)
+      bool is_trial_along_direction = true;
       while (!termination) {
+         Cancellation::check();
          number_iterations++;
          DEBUG << "\n\tLine-search iteration " << number_iterations << ", step_length " << step_length << '\n';
          if (1 < number_iterations) { statistics.start_new_line(); }
@@ -53,83 +85,247 @@ namespace uno {
 
          bool is_acceptable = false;
          try {
+            const Timeline::Event trial_event(Timeline::current(), "line-search trial");
             // take a step as a fraction of the direction
-            GlobalizationMechanism::assemble_trial_iterate(model, current_iterate, trial_iterate, this->direction, step_length,
-                  // scale or not the constraint dual direction with the LS step length
-                  this->scale_duals_with_step_length ? step_length : 1.);
+            if (speculative_trials) {
+               this->assemble_speculative_trial_iterate(model, current_iterate, trial_iterate, step_length);
+            }
+            else {
+               GlobalizationMechanism::assemble_trial_iterate(model, current_iterate, trial_iterate, this->direction, step_length,
+                     // scale or not the constraint dual direction with the LS step length
+                     this->scale_duals_with_step_length ? step_length : 1.);
+            }
 
-            is_acceptable = this->constraint_relaxation_strategy.is_iterate_acceptable(statistics, current_iterate, trial_iterate, this->direction,
+            is_acceptable = this->relaxation_strategy.is_iterate_acceptable(statistics, current_iterate, trial_iterate, this->direction,
                   step_length, warmstart_information, user_callbacks);
             this->set_statistics(statistics, trial_iterate, this->direction, step_length, number_iterations);
+            // the full step was rejected and did not reduce the infeasibility: try second-order corrections
+            if (!is_acceptable && number_iterations == 1 && 0 < this->max_second_order_corrections && model.is_constrained() &&
+                  current_iterate.progress.infeasibility <= trial_iterate.progress.infeasibility) {
+               is_trial_along_direction = false;
+               is_acceptable = this->apply_second_order_corrections(statistics, model, current_iterate, trial_iterate, warmstart_information,
+                     user_callbacks);
+            }
          }
          catch (const EvaluationError& e) {
             this->set_statistics(statistics, number_iterations);
             statistics.set("status", "eval. error");
+            is_trial_along_direction = false;
          }
 
          if (is_acceptable) {
-            trial_iterate.status = this->constraint_relaxation_strategy.check_termination(trial_iterate);
-            this->constraint_relaxation_strategy.set_dual_residuals_statistics(statistics, trial_iterate);
+            trial_iterate.status = this->relaxation_strategy.check_termination(trial_iterate);
+            this->relaxation_strategy.set_dual_residuals_statistics(statistics, trial_iterate);
             termination = true;
             if (Logger::level == INFO) statistics.print_current_line();
          }
-         else if (step_length >= this->minimum_step_length) {
-            step_length = this->decrease_step_length(step_length);
+         else if (step_length >= this->minimum_step_length && (this->max_backtracks == 0 || number_iterations < this->max_backtracks)) {
+            step_length = (this->interpolate_step_length && !speculative_trials && is_trial_along_direction) ?
+               this->interpolate_trial_step_length(current_iterate, trial_iterate, step_length) : this->decrease_step_length(step_length);
+            is_trial_along_direction = true;
             if (Logger::level == INFO) statistics.print_current_line();
          }
-         else { // minimum_step_length reached
-            DEBUG << "The line search step length is smaller than " << this->minimum_step_length << '\n';
+         else { // minimum_step_length or maximum number of backtracks reached
+            DEBUG << "The line search step length is smaller than " << this->minimum_step_length <<
+               " or the maximum number of backtracks is reached\n";
             // check if we can terminate at a first-order point
             termination = this->terminate_with_small_step_length(statistics, trial_iterate);
             if (!termination) {
                // test if we can switch to solving the feasibility problem
-               if (this->constraint_relaxation_strategy.solving_feasibility_problem() || !model.is_constrained()) {
+               if (this->relaxation_strategy.solving_feasibility_problem() || !model.is_constrained()) {
                   throw std::runtime_error("LS failed");
                }
                // switch to solving the feasibility problem
                statistics.set("status", "small step length");
-               this->constraint_relaxation_strategy.switch_to_feasibility_problem(statistics, current_iterate, warmstart_information);
-               this->constraint_relaxation_strategy.compute_feasible_direction(statistics, current_iterate, this->direction, this->direction.primals,
+               this->relaxation_strategy.switch_to_feasibility_problem(statistics, current_iterate, warmstart_information);
+               this->relaxation_strategy.compute_feasible_direction(statistics, current_iterate, this->direction, this->direction.primals,
                      warmstart_information);
                BacktrackingLineSearch::check_unboundedness(this->direction);
                // restart backtracking
                step_length = 1.;
                number_iterations = 0;
+               this->next_speculative_index = this->speculative_iterates.size();
+               this->reset_interpolation();
+               is_trial_along_direction = true;
             }
          }
       } // end while loop
    }
 
-   bool BacktrackingLineSearch::terminate_with_small_step_length(Statistics& statistics, Iterate& trial_iterate) {
+   // the trial iterate is taken from the ladder of speculative iterates. When the ladder is exhausted, the trial iterates of the
+   // next step lengths are evaluated
+   template <typename Relaxation>
+   void BacktrackingLineSearch<Relaxation>::assemble_speculative_trial_iterate(const Model& model, Iterate& current_iterate,
+         Iterate& trial_iterate,
+         double step_length) {
+      if (this->next_speculative_index == this->speculative_iterates.size()) {
+         this->evaluate_speculative_iterates(model, current_iterate, step_length);
+      }
+      trial_iterate = this->speculative_iterates[this->next_speculative_index];
+      this->next_speculative_index++;
+   }
+
+   // the objective and constraints at the step lengths step_length, ratio*step_length, ... are evaluated as a batch (concurrently, or
+   // by a multi-point evaluation of the model). The globalization strategy then tests them in decreasing order, which accepts the
+   // largest acceptable step length
+   template <typename Relaxation>
+   void BacktrackingLineSearch<Relaxation>::evaluate_speculative_iterates(const Model& model, Iterate& current_iterate, double step_length) {
+      if (this->speculative_iterates.empty()) {
+         this->speculative_iterates.resize(this->number_speculative_trials, current_iterate);
+         this->speculative_batch.emplace(this->number_speculative_trials, current_iterate.primals.size(),
+               current_iterate.evaluations.constraints.size(), false);
+      }
+      // same sequence of step lengths as decrease_step_length
+      BatchEvaluation& batch = *this->speculative_batch;
+      for (size_t trial_index: Range(this->speculative_iterates.size())) {
+         Iterate& speculative_iterate = this->speculative_iterates[trial_index];
+         GlobalizationMechanism::assemble_trial_iterate(model, current_iterate, speculative_iterate, this->direction, step_length,
+               this->scale_duals_with_step_length ? step_length : 1.);
+         batch.points[trial_index] = speculative_iterate.primals;
+         step_length *= this->backtracking_ratio;
+      }
+      model.evaluate_batch(batch);
+      for (size_t trial_index: Range(this->speculative_iterates.size())) {
+         // the evaluation flags of a failed evaluation are left unset: the evaluation error is raised again when the trial iterate is
+         // evaluated by the globalization strategy
+         if (!batch.is_evaluated(trial_index)) {
+            continue;
+         }
+         Iterate& speculative_iterate = this->speculative_iterates[trial_index];
+         speculative_iterate.evaluations.objective = batch.objectives[trial_index];
+         speculative_iterate.is_objective_computed = is_finite(speculative_iterate.evaluations.objective);
+         if (model.is_constrained()) {
+            // the constraint vectors are exchanged without copy
+            std::swap(speculative_iterate.evaluations.constraints, batch.constraints[trial_index]);
+            speculative_iterate.are_constraints_computed = std::all_of(speculative_iterate.evaluations.constraints.cbegin(),
+               speculative_iterate.evaluations.constraints.cend(), [](double constraint_j) {
+                  return is_finite(constraint_j);
+               });
+         }
+         else {
+            speculative_iterate.are_constraints_computed = true;
+         }
+      }
+      // the worker threads do not see the counters of the solve: count the speculative evaluations on the solving thread
+      EvaluationCounters& evaluation_counters = EvaluationCounters::current();
+      evaluation_counters.objective += this->speculative_iterates.size();
+      if (model.is_constrained()) {
+         evaluation_counters.constraints += this->speculative_iterates.size();
+      }
+      this->next_speculative_index = 0;
+   }
+
+   // the corrected directions are computed in a separate direction, so that backtracking can resume along the original direction
+   template <typename Relaxation>
+   bool BacktrackingLineSearch<Relaxation>::apply_second_order_corrections(Statistics& statistics, const Model& model, Iterate& current_iterate,
+         Iterate& trial_iterate, WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) {
+      this->second_order_direction = this->direction;
+      double previous_infeasibility = trial_iterate.progress.infeasibility;
+      for (size_t correction_index: Range(this->max_second_order_corrections)) {
+         if (!this->relaxation_strategy.compute_second_order_correction(current_iterate, trial_iterate, this->second_order_direction)) {
+            return false;
+         }
+         DEBUG << "\n\tSecond-order correction " << (correction_index + 1) << '\n';
+         GlobalizationMechanism::assemble_trial_iterate(model, current_iterate, trial_iterate, this->second_order_direction, 1., 1.);
+         const bool is_acceptable = this->relaxation_strategy.is_iterate_acceptable(statistics, current_iterate, trial_iterate,
+               this->second_order_direction, 1., warmstart_information, user_callbacks);
+         if (is_acceptable) {
+            statistics.set("status", "accepted (SOC)");
+            this->set_statistics(statistics, trial_iterate, this->second_order_direction, 1., correction_index + 1);
+            return true;
+         }
+         // stop if the infeasibility does not decrease sufficiently
+         if (this->second_order_correction_decrease * previous_infeasibility < trial_iterate.progress.infeasibility) {
+            break;
+         }
+         previous_infeasibility = trial_iterate.progress.infeasibility;
+      }
+      return false;
+   }
+
+   template <typename Relaxation>
+   bool BacktrackingLineSearch<Relaxation>::terminate_with_small_step_length(Statistics& statistics, Iterate& trial_iterate) {
       bool termination = false;
-      trial_iterate.status = this->constraint_relaxation_strategy.check_termination(trial_iterate);
+      trial_iterate.status = this->relaxation_strategy.check_termination(trial_iterate);
       if (trial_iterate.status != IterateStatus::NOT_OPTIMAL) {
          statistics.set("status", "accepted (small step length)");
-         this->constraint_relaxation_strategy.set_dual_residuals_statistics(statistics, trial_iterate);
+         this->relaxation_strategy.set_dual_residuals_statistics(statistics, trial_iterate);
          termination = true;
       }
       return termination;
    }
 
    // step length follows the following sequence: 1, ratio, ratio^2, ratio^3, ...
-   double BacktrackingLineSearch::decrease_step_length(double step_length) const {
+   template <typename Relaxation>
+   double BacktrackingLineSearch<Relaxation>::decrease_step_length(double step_length) const {
       step_length *= this->backtracking_ratio;
       assert(0 < step_length && step_length <= 1 && "The line-search step length is not in (0, 1]");
       return step_length;
    }
 
-   void BacktrackingLineSearch::check_unboundedness(const Direction& direction) {
+   template <typename Relaxation>
+   void BacktrackingLineSearch<Relaxation>::reset_interpolation() {
+      this->are_predicted_reductions_computed = false;
+      this->previous_measure = InterpolatedMeasure::NONE;
+   }
+
+   // the measure that caused the rejection is interpolated: the infeasibility if it increased (or if the optimality measure was not
+   // evaluated), the optimality measure (objective and auxiliary terms) otherwise. The fixed ratio is used if the measure does not
+   // decrease along the direction or if the interpolation is not defined
+   template <typename Relaxation>
+   double BacktrackingLineSearch<Relaxation>::interpolate_trial_step_length(const Iterate& current_iterate, const Iterate& trial_iterate,
+         double step_length) {
+      if (!this->are_predicted_reductions_computed) {
+         this->unit_step_predicted_reductions = this->relaxation_strategy.compute_unit_step_predicted_reductions(current_iterate,
+               this->direction);
+         this->are_predicted_reductions_computed = true;
+      }
+      const double objective_multiplier = trial_iterate.objective_multiplier;
+      const auto optimality_measure = [&](const ProgressMeasures& progress) {
+         return static_cast<bool>(progress.objective) ? progress.objective(objective_multiplier) + progress.auxiliary : INF<double>;
+      };
+      const double trial_optimality = optimality_measure(trial_iterate.progress);
+      const bool interpolate_infeasibility = !is_finite(trial_optimality) ||
+         current_iterate.progress.infeasibility < trial_iterate.progress.infeasibility;
+      const InterpolatedMeasure measure = interpolate_infeasibility ? InterpolatedMeasure::INFEASIBILITY : InterpolatedMeasure::OPTIMALITY;
+      const double initial_value = interpolate_infeasibility ? current_iterate.progress.infeasibility :
+         optimality_measure(current_iterate.progress);
+      const double slope = interpolate_infeasibility ? -this->unit_step_predicted_reductions.infeasibility :
+         -(this->unit_step_predicted_reductions.objective(objective_multiplier) + this->unit_step_predicted_reductions.auxiliary);
+      const double value = interpolate_infeasibility ? trial_iterate.progress.infeasibility : trial_optimality;
+
+      double new_step_length = this->decrease_step_length(step_length);
+      if (slope < 0. && is_finite(initial_value) && is_finite(value)) {
+         const double minimizer = interpolated_step_length_minimizer(initial_value, slope, step_length, value,
+               this->previous_step_length, this->previous_measure_value, this->previous_measure == measure);
+         if (is_finite(minimizer)) {
+            new_step_length = std::max(BacktrackingLineSearch::minimum_interpolation_ratio * step_length,
+               std::min(minimizer, BacktrackingLineSearch::maximum_interpolation_ratio * step_length));
+            DEBUG << "Interpolated step length " << new_step_length << " (" << (interpolate_infeasibility ? "infeasibility" : "optimality") <<
+               " measure)\n";
+         }
+      }
+      this->previous_measure = measure;
+      this->previous_step_length = step_length;
+      this->previous_measure_value = value;
+      return new_step_length;
+   }
+
+   template <typename Relaxation>
+   void BacktrackingLineSearch<Relaxation>::check_unboundedness(const Direction& direction) {
       if (direction.status == SubproblemStatus::UNBOUNDED_PROBLEM) {
          throw std::runtime_error("The subproblem is unbounded, this should not happen. If the subproblem has curvature, use regularization. If not, "
                                   "use a trust-region method.\n");
       }
    }
 
-   void BacktrackingLineSearch::set_statistics(Statistics& statistics, size_t number_iterations) const {
+   template <typename Relaxation>
+   void BacktrackingLineSearch<Relaxation>::set_statistics(Statistics& statistics, size_t number_iterations) const {
       statistics.set("LS iter", number_iterations);
    }
 
-   void BacktrackingLineSearch::set_statistics(Statistics& statistics, const Iterate& trial_iterate, const Direction& direction,
+   template <typename Relaxation>
+   void BacktrackingLineSearch<Relaxation>::set_statistics(Statistics& statistics, const Iterate& trial_iterate, const Direction& direction,
          double primal_dual_step_length, size_t number_iterations) const {
       if (trial_iterate.is_objective_computed) {
          statistics.set("objective", trial_iterate.evaluations.objective);
@@ -137,4 +333,7 @@ namespace uno {
       statistics.set("step norm", primal_dual_step_length * direction.norm);
       this->set_statistics(statistics, number_iterations);
    }
+
+   template class BacktrackingLineSearch<ConstraintRelaxationStrategy>;
+   template class BacktrackingLineSearch<InteriorPointFeasibilityRestoration>;
 } // namespace
@@ -4,29 +4,65 @@
 #ifndef UNO_BACKTRACKINGLINESEARCH_H
 #define UNO_BACKTRACKINGLINESEARCH_H
 
+#include <optional>
+#include <vector>
 #include "GlobalizationMechanism.hpp"
+#include "ingredients/globalization_strategies/ProgressMeasures.hpp"
+#include "model/BatchEvaluation.hpp"
+#include "optimization/Iterate.hpp"
 
 namespace uno {
    // forward declaration
    struct WarmstartInformation;
 
+   // Relaxation is the static type of the constraint relaxation strategy: with a final type (e.g. in the pipeline of the
+   // ipopt preset), the calls to the strategy are resolved at compile time
+   template <typename Relaxation = ConstraintRelaxationStrategy>
    class BacktrackingLineSearch : public GlobalizationMechanism {
    public:
-      BacktrackingLineSearch(ConstraintRelaxationStrategy& constraint_relaxation_strategy, const Options& options);
+      BacktrackingLineSearch(Relaxation& constraint_relaxation_strategy, const Options& options);
 
       void initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) override;
       void compute_next_iterate(Statistics& statistics, const Model& model, Iterate& current_iterate, Iterate& trial_iterate,
             WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) override;
 
    private:
+      Relaxation& relaxation_strategy;
       const double backtracking_ratio;
       const double minimum_step_length;
+      const size_t max_backtracks; /*!< 0: no limit */
       const bool scale_duals_with_step_length;
+      const size_t max_second_order_corrections;
+      const double second_order_correction_decrease; // required decrease of the infeasibility between two corrections
+      Direction second_order_direction;
+      // speculative mode: the trial iterates of a ladder of step lengths are evaluated concurrently, then tested in decreasing order
+      const size_t number_speculative_trials;
+      std::vector<Iterate> speculative_iterates{};
+      std::optional<BatchEvaluation> speculative_batch{};
+      size_t next_speculative_index{0};
+      // step-length interpolation: the predicted reductions of a unit step give the slopes of the measures at the current iterate.
+      // The measure of the previous rejected trial (if it was the same measure) allows a cubic interpolation
+      enum class InterpolatedMeasure {NONE, INFEASIBILITY, OPTIMALITY};
+      const bool interpolate_step_length;
+      ProgressMeasures unit_step_predicted_reductions{};
+      bool are_predicted_reductions_computed{false};
+      InterpolatedMeasure previous_measure{InterpolatedMeasure::NONE};
+      double previous_step_length{0.};
+      double previous_measure_value{0.};
+      // safeguards of the interpolated step length, relative to the rejected step length
+      static constexpr double minimum_interpolation_ratio{0.1};
+      static constexpr double maximum_interpolation_ratio{0.5};
 
       void backtrack_along_direction(Statistics& statistics, const Model& model, Iterate& current_iterate, Iterate& trial_iterate,
             WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks);
+      void assemble_speculative_trial_iterate(const Model& model, Iterate& current_iterate, Iterate& trial_iterate, double step_length);
+      void evaluate_speculative_iterates(const Model& model, Iterate& current_iterate, double step_length);
+      [[nodiscard]] bool apply_second_order_corrections(Statistics& statistics, const Model& model, Iterate& current_iterate,
+            Iterate& trial_iterate, WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks);
       [[nodiscard]] bool terminate_with_small_step_length(Statistics& statistics, Iterate& trial_iterate);
       [[nodiscard]] double decrease_step_length(double step_length) const;
+      void reset_interpolation();
+      [[nodiscard]] double interpolate_trial_step_length(const Iterate& current_iterate, const Iterate& trial_iterate, double step_length);
       static void check_unboundedness(const Direction& direction);
       void set_statistics(Statistics& statistics, size_t number_iterations) const;
       void set_statistics(Statistics& statistics, const Iterate& trial_iterate, const Direction& direction, double primal_dual_step_length,
@@ -0,0 +1,41 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include "FullStep.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "optimization/Iterate.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Statistics.hpp"
+
+namespace uno {
+   FullStep::FullStep(ConstraintRelaxationStrategy& constraint_relaxation_strategy):
+         GlobalizationMechanism(constraint_relaxation_strategy) {
+   }
+
+   void FullStep::initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) {
+      this->constraint_relaxation_strategy.initialize(statistics, initial_iterate, options);
+   }
+
+   void FullStep::compute_next_iterate(Statistics& statistics, const Model& model, Iterate& current_iterate, Iterate& trial_iterate,
+         WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) {
+      DEBUG2 << "Current iterate\n" << current_iterate << '\n';
+
+      this->constraint_relaxation_strategy.compute_feasible_direction(statistics, current_iterate, this->direction, warmstart_information);
+      if (this->direction.status == SubproblemStatus::UNBOUNDED_PROBLEM) {
+         throw std::runtime_error("The subproblem is unbounded: a full step cannot be taken");
+      }
+      GlobalizationMechanism::assemble_trial_iterate(model, current_iterate, trial_iterate, this->direction, 1., 1.);
+      // the acceptance test evaluates the progress measures of the trial iterate
+      [[maybe_unused]] const bool is_acceptable = this->constraint_relaxation_strategy.is_iterate_acceptable(statistics, current_iterate,
+            trial_iterate, this->direction, 1., warmstart_information, user_callbacks);
+      statistics.set("step norm", this->direction.norm);
+      statistics.set("status", "full step");
+      if (trial_iterate.is_objective_computed) {
+         statistics.set("objective", trial_iterate.evaluations.objective);
+      }
+      trial_iterate.status = this->constraint_relaxation_strategy.check_termination(trial_iterate);
+      this->constraint_relaxation_strategy.set_dual_residuals_statistics(statistics, trial_iterate);
+      if (Logger::level == INFO) statistics.print_current_line();
+   }
+} // namespace
@@ -0,0 +1,26 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FULLSTEP_H
+#define UNO_FULLSTEP_H
+
+#include "GlobalizationMechanism.hpp"
+
+namespace uno {
+   /*! \class FullStep
+    * \brief No globalization: the full step along the direction is always taken
+    *
+    *  The acceptance test of the constraint relaxation strategy is only invoked to evaluate the progress measures of the trial
+    *  iterate; its verdict is ignored. Convergence is therefore only local (e.g. real-time iterations, see RealTimeIteration)
+    */
+   class FullStep : public GlobalizationMechanism {
+   public:
+      explicit FullStep(ConstraintRelaxationStrategy& constraint_relaxation_strategy);
+
+      void initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) override;
+      void compute_next_iterate(Statistics& statistics, const Model& model, Iterate& current_iterate, Iterate& trial_iterate,
+            WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) override;
+   };
+} // namespace
+
+#endif // UNO_FULLSTEP_H
@@ -7,6 +7,7 @@
 #include "optimization/Iterate.hpp"
 #include "symbolic/Expression.hpp"
 #include "options/Options.hpp"
+#include "tools/MemoryReport.hpp"
 
 namespace uno {
    GlobalizationMechanism::GlobalizationMechanism(ConstraintRelaxationStrategy& constraint_relaxation_strategy) :
@@ -33,9 +34,18 @@ namespace uno {
       trial_iterate.is_objective_gradient_computed = false;
       trial_iterate.are_constraints_computed = false;
       trial_iterate.is_constraint_jacobian_computed = false;
+      trial_iterate.are_feasibility_residuals_computed = false;
       trial_iterate.status = IterateStatus::NOT_OPTIMAL;
    }
 
+   void GlobalizationMechanism::save_state(CheckpointWriter& writer) const {
+      this->constraint_relaxation_strategy.save_state(writer);
+   }
+
+   void GlobalizationMechanism::load_state(CheckpointReader& reader, Iterate& current_iterate) {
+      this->constraint_relaxation_strategy.load_state(reader, current_iterate);
+   }
+
    size_t GlobalizationMechanism::get_hessian_evaluation_count() const {
       return this->constraint_relaxation_strategy.get_hessian_evaluation_count();
    }
@@ -43,4 +53,30 @@ namespace uno {
    size_t GlobalizationMechanism::get_number_subproblems_solved() const {
       return this->constraint_relaxation_strategy.get_number_subproblems_solved();
    }
+
+   size_t GlobalizationMechanism::get_number_factorizations() const {
+      return this->constraint_relaxation_strategy.get_number_factorizations();
+   }
+
+   size_t GlobalizationMechanism::get_peak_workspace_size() const {
+      return this->constraint_relaxation_strategy.get_peak_workspace_size();
+   }
+
+   FactorizationStatistics GlobalizationMechanism::get_factorization_statistics() const {
+      return this->constraint_relaxation_strategy.get_factorization_statistics();
+   }
+
+   Certificate GlobalizationMechanism::get_certificate() const {
+      return this->constraint_relaxation_strategy.get_certificate();
+   }
+
+   void GlobalizationMechanism::solve_sensitivity_systems(const Vector<double>& rhs, Vector<double>& result, size_t number_rhs) {
+      this->constraint_relaxation_strategy.solve_sensitivity_systems(rhs, result, number_rhs);
+   }
+
+   void GlobalizationMechanism::report_memory(MemoryReport& report) const {
+      report.add("direction", this->direction.primals.memory_size() + this->direction.multipliers.memory_size() +
+            this->direction.feasibility_multipliers.memory_size() + this->direction.jacobian_product.memory_size());
+      this->constraint_relaxation_strategy.report_memory(report);
+   }
 } // namespace
@@ -4,12 +4,17 @@
 #ifndef UNO_GLOBALIZATIONMECHANISM_H
 #define UNO_GLOBALIZATIONMECHANISM_H
 
+#include "ingredients/subproblem_solvers/FactorizationStatistics.hpp"
+#include "optimization/Certificate.hpp"
 #include "optimization/Direction.hpp"
 
 namespace uno {
    // forward declarations
+   class CheckpointReader;
+   class CheckpointWriter;
    class ConstraintRelaxationStrategy;
    class Iterate;
+   class MemoryReport;
    class Model;
    class Options;
    class Statistics;
@@ -24,9 +29,21 @@ namespace uno {
       virtual void initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) = 0;
       virtual void compute_next_iterate(Statistics& statistics, const Model& model, Iterate& current_iterate, Iterate& trial_iterate,
             WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) = 0;
+      // algorithmic state in a checkpoint, along with that of the constraint relaxation strategy
+      virtual void save_state(CheckpointWriter& writer) const;
+      virtual void load_state(CheckpointReader& reader, Iterate& current_iterate);
 
       [[nodiscard]] size_t get_hessian_evaluation_count() const;
       [[nodiscard]] size_t get_number_subproblems_solved() const;
+      [[nodiscard]] size_t get_number_factorizations() const;
+      [[nodiscard]] size_t get_peak_workspace_size() const;
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const;
+      // certificate of an infeasible or unbounded termination (see ConstraintRelaxationStrategy::check_termination)
+      [[nodiscard]] Certificate get_certificate() const;
+      // post-solve sensitivity with the factors of the last iteration (see InequalityHandlingMethod::solve_sensitivity_systems)
+      void solve_sensitivity_systems(const Vector<double>& rhs, Vector<double>& result, size_t number_rhs);
+      // memory of the buffers of the strategies and of the subproblem solvers, per component
+      void report_memory(MemoryReport& report) const;
 
    protected:
       // reference to allow polymorphism
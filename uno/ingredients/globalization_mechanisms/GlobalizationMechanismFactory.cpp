@@ -4,25 +4,36 @@
 #include <string>
 #include "GlobalizationMechanism.hpp"
 #include "GlobalizationMechanismFactory.hpp"
-#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/FeasibilityRestoration.hpp"
 #include "ingredients/globalization_mechanisms/TrustRegionStrategy.hpp"
 #include "ingredients/globalization_mechanisms/BacktrackingLineSearch.hpp"
+#include "ingredients/globalization_mechanisms/FullStep.hpp"
 #include "options/Options.hpp"
 
 namespace uno {
    std::unique_ptr<GlobalizationMechanism> GlobalizationMechanismFactory::create(
          ConstraintRelaxationStrategy& constraint_relaxation_strategy, const Options& options) {
       const std::string& mechanism_type = options.get_string("globalization_mechanism");
+       // the compile-time pipelines of the filtersqp and ipopt presets are detected from the type of the strategy
        if (mechanism_type == "TR") {
-           return std::make_unique<TrustRegionStrategy>(constraint_relaxation_strategy, options);
+           if (auto* strategy = dynamic_cast<SQPFeasibilityRestoration*>(&constraint_relaxation_strategy)) {
+              return std::make_unique<TrustRegionStrategy<SQPFeasibilityRestoration>>(*strategy, options);
+           }
+           return std::make_unique<TrustRegionStrategy<>>(constraint_relaxation_strategy, options);
        }
        else if (mechanism_type == "LS") {
-           return std::make_unique<BacktrackingLineSearch>(constraint_relaxation_strategy, options);
+           if (auto* strategy = dynamic_cast<InteriorPointFeasibilityRestoration*>(&constraint_relaxation_strategy)) {
+              return std::make_unique<BacktrackingLineSearch<InteriorPointFeasibilityRestoration>>(*strategy, options);
+           }
+           return std::make_unique<BacktrackingLineSearch<>>(constraint_relaxation_strategy, options);
+       }
+       else if (mechanism_type == "none") {
+           return std::make_unique<FullStep>(constraint_relaxation_strategy);
        }
        throw std::invalid_argument("GlobalizationMechanism " + mechanism_type + " is not supported");
    }
 
    std::vector<std::string> GlobalizationMechanismFactory::available_strategies() {
-      return {"TR", "LS"};
+      return {"TR", "LS", "none"};
    }
 } // namespace
@@ -0,0 +1,40 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_STEPLENGTHINTERPOLATION_H
+#define UNO_STEPLENGTHINTERPOLATION_H
+
+#include <cmath>
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   // minimizer of the quadratic that interpolates phi(0), phi'(0) < 0 and phi(step_length), or of the cubic that also interpolates
+   // phi(previous_step_length). Returns INF if the model has no positive minimizer (e.g. phi(step_length) is below the linear model)
+   inline double interpolated_step_length_minimizer(double initial_value, double slope, double step_length, double value,
+         double previous_step_length, double previous_value, bool has_previous_trial) {
+      const double residual = value - initial_value - slope * step_length;
+      if (!has_previous_trial) {
+         return (0. < residual) ? -slope * step_length * step_length / (2. * residual) : INF<double>;
+      }
+      // phi(t) = a t^3 + b t^2 + phi'(0) t + phi(0)
+      const double previous_residual = previous_value - initial_value - slope * previous_step_length;
+      const double denominator = previous_step_length * previous_step_length * step_length * step_length * (step_length - previous_step_length);
+      if (denominator == 0.) {
+         return INF<double>;
+      }
+      const double a = (previous_step_length * previous_step_length * residual - step_length * step_length * previous_residual) / denominator;
+      const double b = (-previous_step_length * previous_step_length * previous_step_length * residual +
+         step_length * step_length * step_length * previous_residual) / denominator;
+      if (a == 0.) {
+         return (0. < b) ? -slope / (2. * b) : INF<double>;
+      }
+      const double discriminant = b * b - 3. * a * slope;
+      if (discriminant < 0.) {
+         return INF<double>;
+      }
+      const double minimizer = (-b + std::sqrt(discriminant)) / (3. * a);
+      return (0. < minimizer) ? minimizer : INF<double>;
+   }
+} // namespace
+
+#endif // UNO_STEPLENGTHINTERPOLATION_H
@@ -7,15 +7,22 @@
 #include "GlobalizationMechanism.hpp"
 
 namespace uno {
+   // Relaxation is the static type of the constraint relaxation strategy: with a final type (e.g. in the pipeline of the
+   // filtersqp preset), the calls to the strategy are resolved at compile time
+   template <typename Relaxation = ConstraintRelaxationStrategy>
    class TrustRegionStrategy : public GlobalizationMechanism {
    public:
-      TrustRegionStrategy(ConstraintRelaxationStrategy& constraint_relaxation_strategy, const Options& options);
+      TrustRegionStrategy(Relaxation& constraint_relaxation_strategy, const Options& options);
 
       void initialize(Statistics& statistics, Iterate& initial_iterate, const Options& options) override;
       void compute_next_iterate(Statistics& statistics, const Model& model, Iterate& current_iterate, Iterate& trial_iterate,
             WarmstartInformation& warmstart_information, UserCallbacks& user_callbacks) override;
+      void save_state(CheckpointWriter& writer) const override;
+      void load_state(CheckpointReader& reader, Iterate& current_iterate) override;
 
    private:
+      Relaxation& relaxation_strategy;
+      const double initial_radius;
       double radius; /*!< Current trust region radius */
       const double increase_factor;
       const double decrease_factor;
@@ -12,6 +12,18 @@ namespace uno {
       protect_actual_reduction_against_roundoff(options.get_bool("protect_actual_reduction_against_roundoff")) {
    }
 
+   // by default, the acceptance depends on the objective
+   bool GlobalizationStrategy::is_infeasibility_acceptable(double /*trial_infeasibility*/) const {
+      return true;
+   }
+
+   // by default, the strategy has no state
+   void GlobalizationStrategy::save_state(CheckpointWriter& /*writer*/) const {
+   }
+
+   void GlobalizationStrategy::load_state(CheckpointReader& /*reader*/) {
+   }
+
    bool GlobalizationStrategy::armijo_sufficient_decrease(double predicted_reduction, double actual_reduction) const {
       return (actual_reduction >= this->armijo_decrease_fraction * std::max(0., predicted_reduction - this->armijo_tolerance));
    }
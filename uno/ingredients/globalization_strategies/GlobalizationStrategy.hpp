@@ -6,6 +6,8 @@
 
 namespace uno {
    // forward declarations
+   class CheckpointReader;
+   class CheckpointWriter;
    class Iterate;
    struct ProgressMeasures;
    class Statistics;
@@ -23,8 +25,13 @@ namespace uno {
       [[nodiscard]] virtual bool is_iterate_acceptable(Statistics& statistics, const ProgressMeasures& current_progress,
             const ProgressMeasures& trial_progress, const ProgressMeasures& predicted_reduction, double objective_multiplier) = 0;
       [[nodiscard]] virtual bool is_infeasibility_sufficiently_reduced(const ProgressMeasures& reference_progress, const ProgressMeasures& trial_progress) const = 0;
+      // necessary condition for the acceptance of a regular (nonzero objective multiplier) trial iterate, tested before the objective is evaluated
+      [[nodiscard]] virtual bool is_infeasibility_acceptable(double trial_infeasibility) const;
 
       virtual void reset() = 0;
+      // algorithmic state (e.g. the filter entries) in a checkpoint
+      virtual void save_state(CheckpointWriter& writer) const;
+      virtual void load_state(CheckpointReader& reader);
 
       virtual void notify_switch_to_feasibility(const ProgressMeasures& current_progress) = 0;
       virtual void notify_switch_to_optimality(const ProgressMeasures& current_progress) = 0;
@@ -6,6 +6,7 @@
 #include "GlobalizationStrategy.hpp"
 #include "GlobalizationStrategyFactory.hpp"
 #include "l1MeritFunction.hpp"
+#include "NonmonotoneMeritFunction.hpp"
 #include "switching_methods/filter_methods/FletcherFilterMethod.hpp"
 #include "switching_methods/filter_methods/WaechterFilterMethod.hpp"
 #include "switching_methods/funnel_methods/FunnelMethod.hpp"
@@ -15,6 +16,9 @@ namespace uno {
       if (strategy_type == "l1_merit") {
          return std::make_unique<l1MeritFunction>(options);
       }
+      else if (strategy_type == "nonmonotone_l1_merit") {
+         return std::make_unique<NonmonotoneMeritFunction>(options);
+      }
       else if (strategy_type == "fletcher_filter_method") {
          return std::make_unique<FletcherFilterMethod>(options);
       }
@@ -28,6 +32,6 @@ namespace uno {
    }
 
    std::vector<std::string> GlobalizationStrategyFactory::available_strategies() {
-      return {"l1_merit", "fletcher_filter_method", "waechter_filter_method", "funnel_method"};
+      return {"l1_merit", "nonmonotone_l1_merit", "fletcher_filter_method", "waechter_filter_method", "funnel_method"};
    }
 }
@@ -0,0 +1,109 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <stdexcept>
+#include "NonmonotoneMeritFunction.hpp"
+#include "tools/Logger.hpp"
+#include "options/Options.hpp"
+#include "tools/Statistics.hpp"
+
+namespace uno {
+   NonmonotoneMeritFunction::NonmonotoneMeritFunction(const Options& options): l1MeritFunction(options),
+         memory(options.get_unsigned_int("nonmonotone_merit_memory")),
+         maximum_watchdog_iterations(options.get_unsigned_int("nonmonotone_merit_watchdog_iterations")) {
+      if (this->memory == 0) {
+         throw std::invalid_argument("The memory of the nonmonotone merit function should be positive");
+      }
+   }
+
+   void NonmonotoneMeritFunction::reset() {
+      this->accepted_progress.clear();
+      this->number_watchdog_iterations = 0;
+      this->is_first_trial = true;
+   }
+
+   void NonmonotoneMeritFunction::save_state(CheckpointWriter& writer) const {
+      l1MeritFunction::save_state(writer);
+      writer.write(this->accepted_progress.size());
+      for (const ProgressMeasures& progress: this->accepted_progress) {
+         progress.save(writer);
+      }
+      writer.write(this->number_watchdog_iterations);
+      writer.write(this->is_first_trial);
+   }
+
+   void NonmonotoneMeritFunction::load_state(CheckpointReader& reader) {
+      l1MeritFunction::load_state(reader);
+      const size_t number_accepted_iterates = reader.read_size_t();
+      if (this->memory < number_accepted_iterates) {
+         throw std::runtime_error("The nonmonotone memory of the checkpoint exceeds the memory of the merit function");
+      }
+      this->accepted_progress.resize(number_accepted_iterates);
+      for (ProgressMeasures& progress: this->accepted_progress) {
+         progress.load(reader);
+      }
+      this->number_watchdog_iterations = reader.read_size_t();
+      this->is_first_trial = reader.read_bool();
+   }
+
+   // the merit function of the feasibility problem differs from that of the optimality problem
+   void NonmonotoneMeritFunction::notify_switch_to_feasibility(const ProgressMeasures& /*current_progress*/) {
+      this->reset();
+   }
+
+   void NonmonotoneMeritFunction::notify_switch_to_optimality(const ProgressMeasures& /*current_progress*/) {
+      this->reset();
+   }
+
+   bool NonmonotoneMeritFunction::is_iterate_acceptable(Statistics& statistics, const ProgressMeasures& current_progress,
+         const ProgressMeasures& trial_progress, const ProgressMeasures& predicted_reduction, double objective_multiplier) {
+      if (this->accepted_progress.empty()) {
+         this->accepted_progress.push_back(current_progress);
+      }
+      const double constrained_predicted_reduction = l1MeritFunction::constrained_merit_function(predicted_reduction, objective_multiplier);
+      DEBUG << "Constrained predicted reduction: " << constrained_predicted_reduction << '\n';
+      const double reference_merit_value = this->reference_merit_value(objective_multiplier);
+      const double trial_merit_value = l1MeritFunction::constrained_merit_function(trial_progress, objective_multiplier);
+      const double actual_reduction = this->compute_merit_actual_reduction(reference_merit_value, trial_merit_value);
+      DEBUG << "Reference merit: " << reference_merit_value << '\n';
+      DEBUG << "Trial merit:     " << trial_merit_value << '\n';
+      DEBUG << "Actual reduction: " << reference_merit_value << " - " << trial_merit_value << " = " << actual_reduction << '\n';
+      statistics.set("penalty", objective_multiplier);
+
+      // nonmonotone Armijo sufficient decrease condition
+      bool accept = this->armijo_sufficient_decrease(constrained_predicted_reduction, actual_reduction);
+      if (accept) {
+         DEBUG << "Trial iterate was accepted by satisfying the nonmonotone Armijo condition\n";
+         this->accepted_progress.push_back(trial_progress);
+         if (this->memory < this->accepted_progress.size()) {
+            this->accepted_progress.pop_front();
+         }
+         this->number_watchdog_iterations = 0;
+         statistics.set("status", "✔ (Armijo)");
+      }
+      // watchdog: tentatively accept the first trial iterate
+      else if (this->is_first_trial && this->number_watchdog_iterations < this->maximum_watchdog_iterations && is_finite(trial_merit_value)) {
+         DEBUG << "Trial iterate was tentatively accepted by the watchdog\n";
+         accept = true;
+         this->number_watchdog_iterations++;
+         statistics.set("status", "✔ (watchdog)");
+      }
+      else {
+         statistics.set("status", "✘ (Armijo)");
+      }
+      if (accept) {
+         this->smallest_known_infeasibility = std::min(this->smallest_known_infeasibility, trial_progress.infeasibility);
+      }
+      this->is_first_trial = accept;
+      return accept;
+   }
+
+   double NonmonotoneMeritFunction::reference_merit_value(double objective_multiplier) const {
+      double reference_merit_value = -INF<double>;
+      for (const ProgressMeasures& progress: this->accepted_progress) {
+         reference_merit_value = std::max(reference_merit_value, l1MeritFunction::constrained_merit_function(progress, objective_multiplier));
+      }
+      return reference_merit_value;
+   }
+} // namespace
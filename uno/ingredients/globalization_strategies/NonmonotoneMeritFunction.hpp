@@ -0,0 +1,44 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NONMONOTONEMERITFUNCTION_H
+#define UNO_NONMONOTONEMERITFUNCTION_H
+
+#include <deque>
+#include "l1MeritFunction.hpp"
+#include "ProgressMeasures.hpp"
+
+namespace uno {
+   /*! \class NonmonotoneMeritFunction
+    * \brief l1 merit function with nonmonotone acceptance and watchdog
+    *
+    *  The Armijo condition is tested with respect to the largest merit value of the last iterates accepted by sufficient decrease
+    *  (Grippo, Lampariello and Lucidi). The merit values are recomputed with the current penalty parameter. Watchdog: the first
+    *  trial iterate of an iteration (the full step for a line search) is tentatively accepted for a limited number of consecutive
+    *  iterations. The tentative iterates do not enter the memory, so once the watchdog is exhausted, the iterates must achieve a
+    *  sufficient decrease with respect to the reference value before the watchdog started
+    */
+   class NonmonotoneMeritFunction : public l1MeritFunction {
+   public:
+      explicit NonmonotoneMeritFunction(const Options& options);
+
+      [[nodiscard]] bool is_iterate_acceptable(Statistics& statistics, const ProgressMeasures& current_progress,
+            const ProgressMeasures& trial_progress, const ProgressMeasures& predicted_reduction, double objective_multiplier) override;
+      void reset() override;
+      void save_state(CheckpointWriter& writer) const override;
+      void load_state(CheckpointReader& reader) override;
+      void notify_switch_to_feasibility(const ProgressMeasures& current_progress) override;
+      void notify_switch_to_optimality(const ProgressMeasures& current_progress) override;
+
+   protected:
+      const size_t memory; /*!< Number of merit values in the reference */
+      const size_t maximum_watchdog_iterations;
+      std::deque<ProgressMeasures> accepted_progress{}; /*!< Progress measures of the last iterates accepted by sufficient decrease */
+      size_t number_watchdog_iterations{0};
+      bool is_first_trial{true};
+
+      [[nodiscard]] double reference_merit_value(double objective_multiplier) const;
+   };
+} // namespace
+
+#endif // UNO_NONMONOTONEMERITFUNCTION_H
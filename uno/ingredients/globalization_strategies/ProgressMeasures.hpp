@@ -4,20 +4,67 @@
 #ifndef UNO_PROGRESSMEASURES_H
 #define UNO_PROGRESSMEASURES_H
 
-#include <functional>
+#include "tools/Checkpoint.hpp"
 #include "tools/Infinity.hpp"
 
 namespace uno {
+   // objective measure, affine in the objective multiplier: constant_term + objective_multiplier * linear_term. The linear term is
+   // NaN if the objective was not evaluated (restoration phase): the value at 0 remains valid. A default-constructed measure is
+   // undefined
+   class ObjectiveMeasure {
+   public:
+      ObjectiveMeasure() = default;
+      ObjectiveMeasure(double constant_term, double linear_term): constant_term(constant_term), linear_term(linear_term), is_defined(true) { }
+
+      // objective_multiplier * objective
+      [[nodiscard]] static ObjectiveMeasure scaled(double objective) { return {0., objective}; }
+
+      [[nodiscard]] double operator()(double objective_multiplier) const {
+         return (objective_multiplier == 0.) ? this->constant_term : this->constant_term + objective_multiplier * this->linear_term;
+      }
+      explicit operator bool() const { return this->is_defined; }
+
+   protected:
+      double constant_term{0.};
+      double linear_term{0.};
+      bool is_defined{false};
+   };
+
    struct ProgressMeasures {
       double infeasibility{}; // constraint violation
-      std::function<double(double objective_multiplier)> objective{}; // objective measure (scaled by penalty parameter): objective, Lagrangian
+      ObjectiveMeasure objective{}; // objective measure (scaled by penalty parameter): objective, Lagrangian
       double auxiliary{}; // auxiliary terms (independent of penalty parameter): barrier terms, proximal term, ...
 
       void reset() {
          this->infeasibility = INF<double>;
-         this->objective = [](double) { return INF<double>; };
+         this->objective = ObjectiveMeasure(INF<double>, INF<double>);
          this->auxiliary = INF<double>;
       }
+
+      // the objective measure is stored as its values at 0 and 1
+      void save(CheckpointWriter& writer) const {
+         writer.write(this->infeasibility);
+         const bool has_objective = static_cast<bool>(this->objective);
+         writer.write(has_objective);
+         if (has_objective) {
+            writer.write(this->objective(0.));
+            writer.write(this->objective(1.));
+         }
+         writer.write(this->auxiliary);
+      }
+
+      void load(CheckpointReader& reader) {
+         this->infeasibility = reader.read_double();
+         if (reader.read_bool()) {
+            const double constant_term = reader.read_double();
+            const double linear_term = reader.read_double() - constant_term;
+            this->objective = ObjectiveMeasure(constant_term, linear_term);
+         }
+         else {
+            this->objective = ObjectiveMeasure();
+         }
+         this->auxiliary = reader.read_double();
+      }
    };
 } // namespace
 
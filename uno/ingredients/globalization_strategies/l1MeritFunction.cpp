@@ -3,6 +3,7 @@
 
 #include "l1MeritFunction.hpp"
 #include "ProgressMeasures.hpp"
+#include "tools/Checkpoint.hpp"
 #include "tools/Logger.hpp"
 #include "options/Options.hpp"
 #include "tools/Statistics.hpp"
@@ -18,6 +19,14 @@ namespace uno {
    void l1MeritFunction::reset() {
    }
 
+   void l1MeritFunction::save_state(CheckpointWriter& writer) const {
+      writer.write(this->smallest_known_infeasibility);
+   }
+
+   void l1MeritFunction::load_state(CheckpointReader& reader) {
+      this->smallest_known_infeasibility = reader.read_double();
+   }
+
    void l1MeritFunction::notify_switch_to_feasibility(const ProgressMeasures& /*current_progress*/) {
    }
 
@@ -17,6 +17,8 @@ namespace uno {
             const ProgressMeasures& trial_progress, const ProgressMeasures& predicted_reduction, double objective_multiplier) override;
       [[nodiscard]] bool is_infeasibility_sufficiently_reduced(const ProgressMeasures& current_progress, const ProgressMeasures& trial_progress) const override;
       void reset() override;
+      void save_state(CheckpointWriter& writer) const override;
+      void load_state(CheckpointReader& reader) override;
       void notify_switch_to_feasibility(const ProgressMeasures& current_progress) override;
       void notify_switch_to_optimality(const ProgressMeasures& current_progress) override;
 
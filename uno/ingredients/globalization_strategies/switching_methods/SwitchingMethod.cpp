@@ -59,7 +59,6 @@ namespace uno {
       else {
          DEBUG << "Trial iterate (h-type) was rejected by violating the Armijo condition\n";
       }
-      Iterate::number_eval_objective--;
       statistics.set("status", std::string(accept ? "✔" : "✘") + " (restoration)");
       return accept;
    }
@@ -28,6 +28,14 @@ namespace uno {
       this->filter->reset();
    }
 
+   void FilterMethod::save_state(CheckpointWriter& writer) const {
+      this->filter->save_state(writer);
+   }
+
+   void FilterMethod::load_state(CheckpointReader& reader) {
+      this->filter->load_state(reader);
+   }
+
    void FilterMethod::notify_switch_to_feasibility(const ProgressMeasures& current_progress) {
       const double current_objective_measure = SwitchingMethod::unconstrained_merit_function(current_progress);
       this->filter->add(current_progress.infeasibility, current_objective_measure);
@@ -38,6 +46,11 @@ namespace uno {
       this->filter->add(current_progress.infeasibility, current_objective_measure);
    }
 
+   // the trial iterate cannot be filter acceptable above the upper bound
+   bool FilterMethod::is_infeasibility_acceptable(double trial_infeasibility) const {
+      return this->filter->acceptable_wrt_upper_bound(trial_infeasibility);
+   }
+
    double FilterMethod::compute_actual_objective_reduction(double current_objective_measure, double current_infeasibility, double trial_objective_measure) {
       double actual_reduction = this->filter->compute_actual_objective_reduction(current_objective_measure, current_infeasibility, trial_objective_measure);
       if (this->protect_actual_reduction_against_roundoff) {
@@ -29,8 +29,11 @@ namespace uno {
 
       void initialize(Statistics& statistics, const Iterate& initial_iterate, const Options& options) override;
       void reset() override;
+      void save_state(CheckpointWriter& writer) const override;
+      void load_state(CheckpointReader& reader) override;
       void notify_switch_to_feasibility(const ProgressMeasures& current_progress) override;
       void notify_switch_to_optimality(const ProgressMeasures& current_progress) override;
+      [[nodiscard]] bool is_infeasibility_acceptable(double trial_infeasibility) const override;
 
    protected:
       // pointer to allow polymorphism
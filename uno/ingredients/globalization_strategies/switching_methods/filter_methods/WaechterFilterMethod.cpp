@@ -5,6 +5,7 @@
 #include "filters/Filter.hpp"
 #include "ingredients/globalization_strategies/ProgressMeasures.hpp"
 #include "optimization/Iterate.hpp"
+#include "tools/Checkpoint.hpp"
 #include "tools/Logger.hpp"
 #include "options/Options.hpp"
 #include "tools/Statistics.hpp"
@@ -22,6 +23,16 @@ namespace uno {
       FilterMethod::initialize(statistics, initial_iterate, options);
    }
 
+   void WaechterFilterMethod::save_state(CheckpointWriter& writer) const {
+      writer.write(this->initial_infeasibility);
+      FilterMethod::save_state(writer);
+   }
+
+   void WaechterFilterMethod::load_state(CheckpointReader& reader) {
+      this->initial_infeasibility = reader.read_double();
+      FilterMethod::load_state(reader);
+   }
+
    bool WaechterFilterMethod::is_regular_iterate_acceptable(Statistics& statistics, const ProgressMeasures& current_progress,
          const ProgressMeasures& trial_progress, const ProgressMeasures& predicted_reduction) {
       // in filter methods, we construct an unconstrained measure by ignoring infeasibility and scaling the objective measure by 1
@@ -8,12 +8,14 @@
 #include "tools/Infinity.hpp"
 
 namespace uno {
-   class WaechterFilterMethod : public FilterMethod {
+   class WaechterFilterMethod final : public FilterMethod {
    public:
       explicit WaechterFilterMethod(const Options& options);
       ~WaechterFilterMethod();
 
       void initialize(Statistics& statistics, const Iterate& initial_iterate, const Options& options) override;
+      void save_state(CheckpointWriter& writer) const override;
+      void load_state(CheckpointReader& reader) override;
       [[nodiscard]] bool is_infeasibility_sufficiently_reduced(const ProgressMeasures& reference_progress, const ProgressMeasures& trial_progress) const override;
 
    protected:
@@ -4,9 +4,11 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <stdexcept>
 #include <string>
 #include "Filter.hpp"
 #include "symbolic/Range.hpp"
+#include "tools/Checkpoint.hpp"
 #include "tools/Logger.hpp"
 #include "options/Options.hpp"
 
@@ -40,34 +42,64 @@ namespace uno {
       this->infeasibility_upper_bound = new_upper_bound;
    }
 
-   void Filter::left_shift(size_t start, size_t shift_size) {
-      for (size_t position: Range(start, this->number_entries - shift_size)) {
-         this->infeasibility[position] = this->infeasibility[position + shift_size];
-         this->objective[position] = this->objective[position + shift_size];
+   void Filter::save_state(CheckpointWriter& writer) const {
+      writer.write(this->infeasibility_upper_bound);
+      writer.write(this->number_entries);
+      for (size_t position: Range(this->number_entries)) {
+         writer.write(this->infeasibility[position]);
+         writer.write(this->objective[position]);
       }
    }
 
-   void Filter::right_shift(size_t start, size_t shift_size) {
-      for (size_t position: BackwardRange(this->number_entries, start)) {
-         this->infeasibility[position] = this->infeasibility[position - shift_size];
-         this->objective[position] = this->objective[position - shift_size];
+   void Filter::load_state(CheckpointReader& reader) {
+      this->infeasibility_upper_bound = reader.read_double();
+      this->number_entries = reader.read_size_t();
+      if (this->capacity < this->number_entries) {
+         throw std::runtime_error("The filter of the checkpoint exceeds the filter capacity");
+      }
+      for (size_t position: Range(this->number_entries)) {
+         this->infeasibility[position] = reader.read_double();
+         this->objective[position] = reader.read_double();
       }
    }
 
-   //  add (infeasibility, objective) to the filter
-   void Filter::add(double current_infeasibility, double current_objective) {
-      // remove dominated filter entries
-      // find position in filter without margin
-      size_t start_position = 0;
-      while (start_position < this->number_entries && this->infeasibility[start_position] < current_infeasibility) {
-         start_position++;
-      }
+   // the entries [start + shift_size, number_entries) are moved to [start, number_entries - shift_size)
+   void Filter::left_shift(size_t start, size_t shift_size) {
+      std::copy(this->infeasibility.begin() + static_cast<std::ptrdiff_t>(start + shift_size),
+         this->infeasibility.begin() + static_cast<std::ptrdiff_t>(this->number_entries), this->infeasibility.begin() + static_cast<std::ptrdiff_t>(start));
+      std::copy(this->objective.begin() + static_cast<std::ptrdiff_t>(start + shift_size),
+         this->objective.begin() + static_cast<std::ptrdiff_t>(this->number_entries), this->objective.begin() + static_cast<std::ptrdiff_t>(start));
+   }
 
-      // find redundant entries starting from position
-      size_t end_position = start_position;
-      while (end_position < this->number_entries && current_objective <= this->objective[end_position]) {
-         end_position++;
-      }
+   // the entries [start, number_entries) are moved to [start + shift_size, number_entries + shift_size)
+   void Filter::right_shift(size_t start, size_t shift_size) {
+      std::copy_backward(this->infeasibility.begin() + static_cast<std::ptrdiff_t>(start),
+         this->infeasibility.begin() + static_cast<std::ptrdiff_t>(this->number_entries),
+         this->infeasibility.begin() + static_cast<std::ptrdiff_t>(this->number_entries + shift_size));
+      std::copy_backward(this->objective.begin() + static_cast<std::ptrdiff_t>(start),
+         this->objective.begin() + static_cast<std::ptrdiff_t>(this->number_entries),
+         this->objective.begin() + static_cast<std::ptrdiff_t>(this->number_entries + shift_size));
+   }
+
+   // binary search: position of the first entry that does not satisfy the predicate (the entries satisfying it form a prefix of [start, number_entries))
+   template <typename Predicate>
+   size_t Filter::partition_point(const std::vector<double>& measures, size_t start, const Predicate& predicate) const {
+      const auto first_entry = measures.begin();
+      return static_cast<size_t>(std::partition_point(first_entry + static_cast<std::ptrdiff_t>(start),
+         first_entry + static_cast<std::ptrdiff_t>(this->number_entries), predicate) - first_entry);
+   }
+
+   //  add (infeasibility, objective) to the filter. Invariant: the entries form a Pareto front, sorted by increasing infeasibility
+   //  (and therefore decreasing objective)
+   void Filter::add(double current_infeasibility, double current_objective) {
+      // position of the new entry: first entry whose infeasibility is not lower
+      size_t start_position = this->partition_point(this->infeasibility, 0, [=](double entry_infeasibility) {
+         return entry_infeasibility < current_infeasibility;
+      });
+      // the entries dominated by the new entry (objective not lower) are contiguous from this position
+      const size_t end_position = this->partition_point(this->objective, start_position, [=](double entry_objective) {
+         return current_objective <= entry_objective;
+      });
 
       // remove entries [position:end_position] from filter
       const size_t number_redundant_entries = end_position - start_position;
@@ -82,13 +114,9 @@ namespace uno {
          this->set_infeasibility_upper_bound(this->parameters.beta * largest_filter_infeasibility);
          // create space in filter: remove last entry
          this->number_entries--;
+         start_position = std::min(start_position, this->number_entries);
       }
 
-      // add new entry to the filter at position
-      start_position = 0;
-      while (start_position < this->number_entries && !this->infeasibility_sufficient_reduction(this->infeasibility[start_position], current_infeasibility)) {
-         start_position++;
-      }
       // shift entries by one to right to make room for new entry
       if (start_position < this->number_entries) {
          this->right_shift(start_position, 1);
@@ -111,11 +139,10 @@ namespace uno {
          return false;
       }
 
-      // TODO: use binary search
-      size_t position = 0;
-      while (position < this->number_entries && !this->infeasibility_sufficient_reduction(this->infeasibility[position], trial_infeasibility)) {
-         position++;
-      }
+      // first entry whose infeasibility is sufficiently reduced by the trial iterate (binary search on the sorted infeasibilities)
+      const size_t position = this->partition_point(this->infeasibility, 0, [&](double entry_infeasibility) {
+         return !this->infeasibility_sufficient_reduction(entry_infeasibility, trial_infeasibility);
+      });
 
       // check acceptability
       if (position == 0) {
@@ -9,7 +9,9 @@
 #include "tools/Infinity.hpp"
 
 namespace uno {
-   // forward declaration
+   // forward declarations
+   class CheckpointReader;
+   class CheckpointWriter;
    class Options;
 
    struct FilterParameters {
@@ -25,6 +27,8 @@ namespace uno {
       void reset();
       [[nodiscard]] double get_smallest_infeasibility() const;
       void set_infeasibility_upper_bound(double new_upper_bound);
+      void save_state(CheckpointWriter& writer) const;
+      void load_state(CheckpointReader& reader);
 
       virtual void add(double current_infeasibility, double current_objective);
       [[nodiscard]] virtual bool acceptable(double trial_infeasibility, double trial_objective);
@@ -32,6 +36,7 @@ namespace uno {
             double trial_objective) const;
       [[nodiscard]] virtual double compute_actual_objective_reduction(double current_objective, double current_infeasibility, double trial_objective);
 
+      [[nodiscard]] bool acceptable_wrt_upper_bound(double trial_infeasibility) const;
       [[nodiscard]] bool infeasibility_sufficient_reduction(double current_infeasibility, double trial_infeasibility) const;
       [[nodiscard]] bool objective_sufficient_reduction(double current_objective, double trial_objective, double trial_infeasibility) const;
 
@@ -39,16 +44,18 @@ namespace uno {
 
    protected:
       const size_t capacity; /*!< Max filter size */
-      std::vector<double> infeasibility{}; // infeasibility increases
-      std::vector<double> objective{}; // objective decreases
+      // preallocated entries [0, number_entries), sorted by increasing infeasibility and decreasing objective
+      std::vector<double> infeasibility{};
+      std::vector<double> objective{};
       double infeasibility_upper_bound{INF<double>}; /*!< Upper bound on infeasibility measure */
       size_t number_entries{0};
       const FilterParameters parameters; /*!< Set of parameters */
 
       [[nodiscard]] bool is_empty() const;
-      [[nodiscard]] bool acceptable_wrt_upper_bound(double trial_infeasibility) const;
       void left_shift(size_t start, size_t shift_size);
       void right_shift(size_t start, size_t shift_size);
+      template <typename Predicate>
+      [[nodiscard]] size_t partition_point(const std::vector<double>& measures, size_t start, const Predicate& predicate) const;
    };
 } // namespace
 
@@ -20,8 +20,9 @@ namespace uno {
          if ((this->objective[entry_index] > current_objective) && (this->infeasibility[entry_index] > current_infeasibility)) {
             number_dominated = 1;
          }
-         // find other filter entries that dominate ith entry
-         for (size_t other_entry_index: Range(this->number_entries)) {
+         // find other filter entries that dominate ith entry (the count is only compared to the maximum number of dominated entries)
+         for (size_t other_entry_index = 0; other_entry_index < this->number_entries && number_dominated <= this->max_number_dominated_entries;
+               other_entry_index++) {
             if ((this->objective[entry_index] > this->objective[other_entry_index]) && (this->infeasibility[entry_index] > this->infeasibility[other_entry_index])) {
                number_dominated++;
             }
@@ -46,9 +47,11 @@ namespace uno {
       this->number_entries++;
    }
 
+   // the count stops as soon as it exceeds the maximum number of dominated entries: the trial iterate is then rejected
    size_t NonmonotoneFilter::compute_number_dominated_entries(double trial_infeasibility, double trial_objective) const {
       size_t number_dominated_entries = 0;
-      for (size_t entry_index: Range(this->number_entries)) {
+      for (size_t entry_index = 0; entry_index < this->number_entries && number_dominated_entries <= this->max_number_dominated_entries;
+            entry_index++) {
          if (!this->objective_sufficient_reduction(this->objective[entry_index], trial_objective, trial_infeasibility) &&
                !this->infeasibility_sufficient_reduction(this->infeasibility[entry_index], trial_infeasibility)) {
             number_dominated_entries++;
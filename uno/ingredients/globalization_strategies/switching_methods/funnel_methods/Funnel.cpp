@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include "Funnel.hpp"
+#include "tools/Checkpoint.hpp"
 #include "tools/Logger.hpp"
 #include "options/Options.hpp"
 
@@ -16,6 +17,14 @@ namespace uno {
       this->width = new_upper_bound;
    }
 
+   void Funnel::save_state(CheckpointWriter& writer) const {
+      writer.write(this->width);
+   }
+
+   void Funnel::load_state(CheckpointReader& reader) {
+      this->width = reader.read_double();
+   }
+
    double Funnel::current_width() const {
       return this->width;
    }
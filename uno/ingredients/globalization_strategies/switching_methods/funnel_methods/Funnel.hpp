@@ -7,7 +7,9 @@
 #include "tools/Infinity.hpp"
 
 namespace uno {
-   // forward reference
+   // forward references
+   class CheckpointReader;
+   class CheckpointWriter;
    class Options;
 
    class Funnel {
@@ -16,6 +18,8 @@ namespace uno {
       ~Funnel() = default;
 
       void set_infeasibility_upper_bound(double new_upper_bound);
+      void save_state(CheckpointWriter& writer) const;
+      void load_state(CheckpointReader& reader);
       [[nodiscard]] double current_width() const;
       [[nodiscard]] bool acceptable(double trial_infeasibility) const;
       [[nodiscard]] bool sufficient_decrease_condition(double trial_infeasibility) const;
@@ -99,10 +99,23 @@ namespace uno {
              trial_progress.infeasibility <= this->parameters.beta * reference_progress.infeasibility;
    }
 
+   // the trial iterate cannot be accepted outside the funnel
+   bool FunnelMethod::is_infeasibility_acceptable(double trial_infeasibility) const {
+      return this->funnel.acceptable(trial_infeasibility);
+   }
+
    void FunnelMethod::reset() {
       // do nothing
    }
 
+   void FunnelMethod::save_state(CheckpointWriter& writer) const {
+      this->funnel.save_state(writer);
+   }
+
+   void FunnelMethod::load_state(CheckpointReader& reader) {
+      this->funnel.load_state(reader);
+   }
+
    void FunnelMethod::notify_switch_to_feasibility(const ProgressMeasures& /*current_progress_measures*/) {
    }
 
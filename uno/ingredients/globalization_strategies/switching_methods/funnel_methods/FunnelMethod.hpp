@@ -35,8 +35,11 @@ namespace uno {
       [[nodiscard]] bool is_infeasibility_sufficiently_reduced(const ProgressMeasures& reference_progress,
             const ProgressMeasures& trial_progress) const override;
       void reset() override;
+      void save_state(CheckpointWriter& writer) const override;
+      void load_state(CheckpointReader& reader) override;
       void notify_switch_to_feasibility(const ProgressMeasures& current_progress_measures) override;
       void notify_switch_to_optimality(const ProgressMeasures& current_progress_measures) override;
+      [[nodiscard]] bool is_infeasibility_acceptable(double trial_infeasibility) const override;
 
       [[nodiscard]] bool acceptable_wrt_current_iterate(double current_infeasibility, double current_objective, double trial_infeasibility,
             double trial_objective) const;
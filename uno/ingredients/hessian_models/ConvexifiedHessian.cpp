@@ -1,25 +1,32 @@
 // Copyright (c) 2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <cmath>
 #include "ConvexifiedHessian.hpp"
 #include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
 #include "ingredients/hessian_models/UnstableRegularization.hpp"
-#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
 #include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 #include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
+#include "optimization/EvaluationCounters.hpp"
 #include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Infinity.hpp"
 #include "tools/Logger.hpp"
+#include "tools/Profiler.hpp"
 #include "tools/Statistics.hpp"
 
 namespace uno {
-   ConvexifiedHessian::ConvexifiedHessian(size_t dimension, size_t maximum_number_nonzeros, const Options& options):
-         HessianModel(),
+   ConvexifiedHessian::ConvexifiedHessian(size_t dimension, size_t maximum_number_nonzeros, bool is_affine_in_objective_multiplier,
+         const Options& options):
+         HessianModel(is_affine_in_objective_multiplier),
          // inertia-based convexification needs a linear solver
          linear_solver(SymmetricIndefiniteLinearSolverFactory::create(dimension, maximum_number_nonzeros, options)),
          regularization_initial_value(options.get_double("regularization_initial_value")),
          regularization_increase_factor(options.get_double("regularization_increase_factor")),
-         regularization_failure_threshold(options.get_double("regularization_failure_threshold")) {
+         regularization_failure_threshold(options.get_double("regularization_failure_threshold")),
+         regularization_max_factorizations(options.get_unsigned_int("regularization_max_factorizations")) {
    }
 
    void ConvexifiedHessian::initialize_statistics(Statistics& statistics, const Options& options) const {
@@ -28,24 +35,47 @@ namespace uno {
 
    void ConvexifiedHessian::evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
          const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) {
+      // the matrix already holds the convexified Hessian: neither evaluate nor factorize again
+      if (this->is_evaluation_current(problem, primal_variables, constraint_multipliers, hessian)) {
+         statistics.set("regulariz", this->regularization_factor);
+         return;
+      }
       // evaluate Lagrangian Hessian
       hessian.set_dimension(problem.number_variables);
-      problem.evaluate_lagrangian_hessian(primal_variables, constraint_multipliers, hessian);
-      this->evaluation_count++;
+      if (!this->interpolate_evaluation(problem, primal_variables, constraint_multipliers, hessian)) {
+         const EvaluationTimer evaluation_timer("Hessian evaluation");
+         problem.evaluate_lagrangian_hessian(primal_variables, constraint_multipliers, hessian);
+         this->evaluation_count++;
+         this->sample_evaluation(problem, primal_variables, constraint_multipliers, hessian);
+      }
       // regularize (only on the original variables) to convexify the problem
       this->regularize(statistics, hessian, problem.get_number_original_variables());
+      this->record_evaluation(problem, primal_variables, constraint_multipliers, hessian);
+   }
+
+   size_t ConvexifiedHessian::memory_size() const {
+      return HessianModel::memory_size() + (this->linear_solver != nullptr ? this->linear_solver->memory_size() : 0) +
+            this->gershgorin_radii.capacity() * sizeof(double);
    }
 
-   // Nocedal and Wright, p51
+   // Nocedal and Wright, p51. The regularization factor is bracketed: the smallest diagonal entry gives a lower bound and the
+   // Gershgorin discs give an upper bound beyond which the matrix is positive definite without factorization. Within the bracket,
+   // the factor is bisected (geometrically) between the last failed and the last successful factors
    void ConvexifiedHessian::regularize(Statistics& statistics, SymmetricMatrix<size_t, double>& hessian, size_t number_original_variables) {
       DEBUG << "Current Hessian:\n" << hessian << '\n';
       const double smallest_diagonal_entry = hessian.smallest_diagonal_entry(number_original_variables);
       DEBUG << "The minimal diagonal entry of the matrix is " << smallest_diagonal_entry << '\n';
+      const double gershgorin_bound = this->compute_gershgorin_bound(hessian, number_original_variables);
+      DEBUG << "The Gershgorin discs bound the regularization factor by " << gershgorin_bound << '\n';
 
+      double failed_factor = 0.; // largest factor with a wrong inertia
+      double successful_factor = gershgorin_bound + this->regularization_initial_value; // smallest factor with the correct inertia
+      bool factorization_failed = false;
       double regularization_factor = (smallest_diagonal_entry > 0.) ? 0. : this->regularization_initial_value - smallest_diagonal_entry;
-      bool good_inertia = false;
       bool symbolic_analysis_performed = false;
-      while (!good_inertia) {
+      size_t number_factorizations = 0;
+      while (regularization_factor < successful_factor) {
+         Cancellation::check();
          DEBUG << "Testing factorization with regularization factor " << regularization_factor << '\n';
          if (0. < regularization_factor) {
             hessian.set_regularization([=](size_t variable_index) {
@@ -56,22 +86,81 @@ namespace uno {
 
          // perform the symbolic analysis only once
          if (!symbolic_analysis_performed) {
+            const ScopedTimer symbolic_analysis_timer("symbolic analysis");
             this->linear_solver->do_symbolic_analysis(hessian);
             symbolic_analysis_performed = true;
          }
-         this->linear_solver->do_numerical_factorization(hessian);
+         {
+            const ScopedTimer factorization_timer("numerical factorization");
+            this->linear_solver->do_numerical_factorization(hessian);
+            number_factorizations++;
+         }
          if (this->linear_solver->rank() == number_original_variables && this->linear_solver->number_negative_eigenvalues() == 0) {
-            good_inertia = true;
             DEBUG << "Factorization was a success\n";
+            successful_factor = regularization_factor;
+            // without failure, the first factor is kept
+            if (!factorization_failed) {
+               break;
+            }
          }
          else {
             DEBUG << "rank: " << this->linear_solver->rank() << ", negative eigenvalues: " << this->linear_solver->number_negative_eigenvalues() << '\n';
-            regularization_factor = (regularization_factor == 0.) ? this->regularization_initial_value : this->regularization_increase_factor * regularization_factor;
-            if (regularization_factor > this->regularization_failure_threshold) {
+            failed_factor = regularization_factor;
+            factorization_failed = true;
+            if (failed_factor > this->regularization_failure_threshold) {
                throw UnstableRegularization();
             }
          }
+         // stop when the bracket is as tight as a geometric increase would make it
+         if (0. < failed_factor && successful_factor <= this->regularization_increase_factor * failed_factor) {
+            break;
+         }
+         // the number of factorizations is capped: the smallest successful factor (or the Gershgorin bound) is kept
+         if (0 < this->regularization_max_factorizations && this->regularization_max_factorizations <= number_factorizations) {
+            DEBUG << "The maximum number of factorizations of the regularization is reached\n";
+            break;
+         }
+         regularization_factor = (failed_factor == 0.) ? this->regularization_initial_value : std::sqrt(failed_factor * successful_factor);
+      }
+      regularization_factor = successful_factor;
+      if (regularization_factor > this->regularization_failure_threshold) {
+         throw UnstableRegularization();
       }
+      // the last factorization may have been performed with another factor
+      if (0. < regularization_factor) {
+         hessian.set_regularization([=](size_t variable_index) {
+            return (variable_index < number_original_variables) ? regularization_factor : 0.;
+         });
+      }
+      this->regularization_factor = regularization_factor;
       statistics.set("regulariz", regularization_factor);
    }
+
+   // smallest shift that makes the discs of the original variables lie in the positive half-line: max_i (sum_{j != i} |H_ij| - H_ii).
+   // No bound (INF) if the other variables have nonzero entries
+   double ConvexifiedHessian::compute_gershgorin_bound(const SymmetricMatrix<size_t, double>& hessian, size_t number_original_variables) {
+      this->gershgorin_radii.assign(hessian.dimension(), 0.);
+      bool other_variables_have_entries = false;
+      hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+         if (element != 0. && (number_original_variables <= row_index || number_original_variables <= column_index)) {
+            other_variables_have_entries = true;
+         }
+         else if (row_index == column_index) {
+            this->gershgorin_radii[row_index] -= element;
+         }
+         else {
+            // the duplicates are overestimated: the bound remains valid
+            this->gershgorin_radii[row_index] += std::abs(element);
+            this->gershgorin_radii[column_index] += std::abs(element);
+         }
+      });
+      if (other_variables_have_entries) {
+         return INF<double>;
+      }
+      double bound = 0.;
+      for (size_t variable_index: Range(number_original_variables)) {
+         bound = std::max(bound, this->gershgorin_radii[variable_index]);
+      }
+      return bound;
+   }
 } // namespace
@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include <memory>
+#include <vector>
 #include "HessianModel.hpp"
 
 namespace uno {
@@ -13,18 +14,23 @@ namespace uno {
    // Hessian with convexification (inertia correction)
    class ConvexifiedHessian : public HessianModel {
    public:
-      ConvexifiedHessian(size_t dimension, size_t maximum_number_nonzeros, const Options& options);
+      ConvexifiedHessian(size_t dimension, size_t maximum_number_nonzeros, bool is_affine_in_objective_multiplier, const Options& options);
 
       void initialize_statistics(Statistics& statistics, const Options& options) const override;
       void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
             const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) override;
+      [[nodiscard]] size_t memory_size() const override;
 
    protected:
       std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> linear_solver; /*!< Solver that computes the inertia */
       const double regularization_initial_value{};
       const double regularization_increase_factor{};
       const double regularization_failure_threshold{};
+      const size_t regularization_max_factorizations{}; /*!< 0: no limit */
+      double regularization_factor{0.}; /*!< regularization of the last convexified Hessian */
+      std::vector<double> gershgorin_radii{}; /*!< radii minus centers of the Gershgorin discs */
 
       void regularize(Statistics& statistics, SymmetricMatrix<size_t, double>& hessian, size_t number_original_variables);
+      [[nodiscard]] double compute_gershgorin_bound(const SymmetricMatrix<size_t, double>& hessian, size_t number_original_variables);
    };
 } // namespace
\ No newline at end of file
@@ -4,20 +4,35 @@
 #include "ExactHessian.hpp"
 #include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/EvaluationCounters.hpp"
 #include "options/Options.hpp"
 
 namespace uno {
    // exact Hessian
-   ExactHessian::ExactHessian(): HessianModel() {
+   ExactHessian::ExactHessian(bool is_affine_in_objective_multiplier): HessianModel(is_affine_in_objective_multiplier) {
    }
 
    void ExactHessian::initialize_statistics(Statistics& /*statistics*/, const Options& /*options*/) const { }
 
    void ExactHessian::evaluate(Statistics& /*statistics*/, const OptimizationProblem& problem, const Vector<double>& primal_variables,
          const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) {
+      if (this->is_evaluation_current(problem, primal_variables, constraint_multipliers, hessian)) {
+         return;
+      }
       // evaluate Lagrangian Hessian
       hessian.set_dimension(problem.number_variables);
-      problem.evaluate_lagrangian_hessian(primal_variables, constraint_multipliers, hessian);
-      this->evaluation_count++;
+      if (!this->interpolate_evaluation(problem, primal_variables, constraint_multipliers, hessian)) {
+         const EvaluationTimer evaluation_timer("Hessian evaluation");
+         problem.evaluate_lagrangian_hessian(primal_variables, constraint_multipliers, hessian);
+         this->evaluation_count++;
+         this->sample_evaluation(problem, primal_variables, constraint_multipliers, hessian);
+      }
+      this->record_evaluation(problem, primal_variables, constraint_multipliers, hessian);
+   }
+
+   void ExactHessian::compute_hessian_vector_product(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers, const Vector<double>& vector, Vector<double>& result) {
+      problem.evaluate_lagrangian_hessian_vector_product(primal_variables, constraint_multipliers, vector, result);
    }
 } // namespace
\ No newline at end of file
@@ -7,10 +7,13 @@ namespace uno {
    // exact Hessian
    class ExactHessian : public HessianModel {
    public:
-      ExactHessian();
+      explicit ExactHessian(bool is_affine_in_objective_multiplier);
 
       void initialize_statistics(Statistics& statistics, const Options& options) const override;
       void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
             const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) override;
+      [[nodiscard]] bool supports_matrix_free_products() const override { return true; }
+      void compute_hessian_vector_product(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers, const Vector<double>& vector, Vector<double>& result) override;
    };
 } // namespace
\ No newline at end of file
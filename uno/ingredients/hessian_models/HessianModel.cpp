@@ -1,8 +1,136 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
+#include <stdexcept>
 #include "HessianModel.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
 
 namespace uno {
+   HessianModel::HessianModel(bool is_affine_in_objective_multiplier): is_affine_in_objective_multiplier(is_affine_in_objective_multiplier) {
+   }
+
    HessianModel::~HessianModel() { }
-} // namespace
\ No newline at end of file
+
+   bool HessianModel::supports_matrix_free_products() const {
+      return false;
+   }
+
+   size_t HessianModel::memory_size() const {
+      size_t size = this->evaluated_primals.memory_size() + this->evaluated_multipliers.memory_size() + this->sampled_primals.memory_size() +
+            this->sampled_multipliers.memory_size() + (this->sampled_sparsity.capacity() + this->sparsity_buffer.capacity()) *
+            sizeof(std::pair<size_t, size_t>);
+      for (const auto& [objective_multiplier, values]: this->samples) {
+         size += values.capacity() * sizeof(double);
+      }
+      return size;
+   }
+
+   void HessianModel::forget_evaluation() {
+      this->evaluated_problem = nullptr;
+      this->evaluated_matrix = nullptr;
+      this->sampled_problem = nullptr;
+      this->sampled_matrix = nullptr;
+      this->samples.clear();
+   }
+
+   void HessianModel::compute_hessian_vector_product(const OptimizationProblem& /*problem*/, const Vector<double>& /*primal_variables*/,
+         const Vector<double>& /*constraint_multipliers*/, const Vector<double>& /*vector*/, Vector<double>& /*result*/) {
+      throw std::runtime_error("The Hessian model does not support matrix-free products");
+   }
+
+   namespace {
+      bool are_equal(const Vector<double>& x, const Vector<double>& y) {
+         return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+      }
+   } // namespace
+
+   bool HessianModel::is_evaluation_current(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers, const SymmetricMatrix<size_t, double>& hessian) {
+      if (this->evaluated_problem == &problem && this->evaluated_matrix == &hessian &&
+            this->evaluated_objective_multiplier == problem.get_objective_multiplier() &&
+            are_equal(this->evaluated_primals, primal_variables) && are_equal(this->evaluated_multipliers, constraint_multipliers)) {
+         return true;
+      }
+      // the matrix is about to be overwritten
+      this->evaluated_problem = nullptr;
+      this->evaluated_matrix = nullptr;
+      return false;
+   }
+
+   void HessianModel::record_evaluation(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers, const SymmetricMatrix<size_t, double>& hessian) {
+      this->evaluated_problem = &problem;
+      this->evaluated_matrix = &hessian;
+      this->evaluated_objective_multiplier = problem.get_objective_multiplier();
+      this->evaluated_primals = primal_variables;
+      this->evaluated_multipliers = constraint_multipliers;
+   }
+
+   bool HessianModel::interpolate_evaluation(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) {
+      if (!this->is_affine_in_objective_multiplier || this->samples.size() < 2 || this->sampled_problem != &problem ||
+            this->sampled_matrix != &hessian || hessian.number_nonzeros() != this->sampled_sparsity.size() ||
+            !are_equal(this->sampled_primals, primal_variables) || !are_equal(this->sampled_multipliers, constraint_multipliers)) {
+         return false;
+      }
+      // the matrix may have been overwritten by another problem in the meantime: check that the sparsity pattern is the sampled one
+      size_t nonzero_index = 0;
+      bool same_sparsity = true;
+      hessian.for_each([&](size_t row_index, size_t column_index, double /*element*/) {
+         same_sparsity = same_sparsity && (this->sampled_sparsity[nonzero_index] == std::pair<size_t, size_t>{row_index, column_index});
+         nonzero_index++;
+      });
+      if (!same_sparsity) {
+         return false;
+      }
+      const auto& [first_objective_multiplier, first_values] = this->samples[0];
+      const auto& [second_objective_multiplier, second_values] = this->samples[1];
+      const double ratio = (problem.get_objective_multiplier() - first_objective_multiplier) / (second_objective_multiplier - first_objective_multiplier);
+      double* values = hessian.data_pointer();
+      for (size_t nonzero_index: Range(this->sampled_sparsity.size())) {
+         values[nonzero_index] = first_values[nonzero_index] + ratio * (second_values[nonzero_index] - first_values[nonzero_index]);
+      }
+DEBUG << "The Hessian was interpolated in the objective multiplier\n";
+      return true;
+   }
+
+   void HessianModel::sample_evaluation(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers, const SymmetricMatrix<size_t, double>& hessian) {
+      if (!this->is_affine_in_objective_multiplier) {
+         return;
+      }
+      // another problem evaluated at the same primal point (e.g. the feasibility problem between two l1-relaxed subproblems) is not
+      // sampled and does not discard the samples
+      if (this->sampled_problem != &problem && !this->samples.empty() && are_equal(this->sampled_primals, primal_variables)) {
+         return;
+      }
+      // the samples are discarded at a new point
+      if (this->sampled_problem != &problem || this->sampled_matrix != &hessian || !are_equal(this->sampled_primals, primal_variables) ||
+            !are_equal(this->sampled_multipliers, constraint_multipliers)) {
+         this->samples.clear();
+         this->sampled_problem = &problem;
+         this->sampled_matrix = &hessian;
+         this->sampled_primals = primal_variables;
+         this->sampled_multipliers = constraint_multipliers;
+      }
+      this->sparsity_buffer.clear();
+      hessian.for_each([&](size_t row_index, size_t column_index, double /*element*/) {
+         this->sparsity_buffer.emplace_back(row_index, column_index);
+      });
+      const double objective_multiplier = problem.get_objective_multiplier();
+      // the samples must share the sparsity pattern and differ in the objective multiplier
+      if (this->samples.size() == 2 || (!this->samples.empty() && (this->sparsity_buffer != this->sampled_sparsity ||
+            this->samples[0].first == objective_multiplier))) {
+         this->samples.clear();
+      }
+      if (this->samples.empty()) {
+         std::swap(this->sampled_sparsity, this->sparsity_buffer);
+      }
+      const double* values = hessian.data_pointer();
+      this->samples.emplace_back(objective_multiplier, std::vector<double>(values, values + hessian.number_nonzeros()));
+   }
+} // namespace
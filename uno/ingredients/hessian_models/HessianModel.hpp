@@ -5,6 +5,9 @@
 #define UNO_HESSIANMODEL_H
 
 #include <cstddef>
+#include <utility>
+#include <vector>
+#include "linear_algebra/Vector.hpp"
 
 namespace uno {
    // forward declarations
@@ -13,12 +16,11 @@ namespace uno {
    class Statistics;
    template <typename IndexType, typename ElementType>
    class SymmetricMatrix;
-   template <typename ElementType>
-   class Vector;
 
    class HessianModel {
    public:
-      HessianModel() = default;
+      // the exact Lagrangian Hessian is affine in the objective multiplier
+      explicit HessianModel(bool is_affine_in_objective_multiplier = false);
       virtual ~HessianModel();
 
       size_t evaluation_count{0};
@@ -26,6 +28,49 @@ namespace uno {
       virtual void initialize_statistics(Statistics& statistics, const Options& options) const = 0;
       virtual void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
             const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian) = 0;
+      // matrix-free products: only the models whose matrix does not depend on a factorization support them
+      [[nodiscard]] virtual bool supports_matrix_free_products() const;
+      virtual void compute_hessian_vector_product(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers, const Vector<double>& vector, Vector<double>& result);
+      // memory of the buffers of the model (in bytes), without the Hessian matrix
+      [[nodiscard]] virtual size_t memory_size() const;
+      // the functions may have changed since the last evaluation (e.g. re-solve of a modified model): the next evaluation is carried
+      // out, even at the same primal-dual point
+      void forget_evaluation();
+
+   protected:
+      // the Hessian stored in the matrix is still valid if it was last evaluated into the same matrix for the same problem, primal point,
+      // multipliers and objective multiplier (rejected trial steps, trust-region radius decreases). Otherwise, the last evaluation is forgotten
+      [[nodiscard]] bool is_evaluation_current(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers, const SymmetricMatrix<size_t, double>& hessian);
+      // to be called once the matrix holds the (possibly convexified) Hessian
+      void record_evaluation(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers, const SymmetricMatrix<size_t, double>& hessian);
+      // if the Hessian is affine in the objective multiplier, two evaluations at the same primal-dual point with different objective
+      // multipliers (e.g. the l1-relaxed subproblems with decreasing penalty parameters) determine all the others: the values are then
+      // interpolated in the matrix, which still holds the common sparsity pattern. Returns false if no interpolation is possible
+      [[nodiscard]] bool interpolate_evaluation(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers, SymmetricMatrix<size_t, double>& hessian);
+      // to be called once the matrix holds the evaluated Lagrangian Hessian, before any modification (e.g. regularization)
+      void sample_evaluation(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers, const SymmetricMatrix<size_t, double>& hessian);
+
+   private:
+      const OptimizationProblem* evaluated_problem{nullptr};
+      const SymmetricMatrix<size_t, double>* evaluated_matrix{nullptr};
+      double evaluated_objective_multiplier{0.};
+      Vector<double> evaluated_primals{};
+      Vector<double> evaluated_multipliers{};
+
+      const bool is_affine_in_objective_multiplier;
+      const OptimizationProblem* sampled_problem{nullptr};
+      const SymmetricMatrix<size_t, double>* sampled_matrix{nullptr};
+      Vector<double> sampled_primals{};
+      Vector<double> sampled_multipliers{};
+      std::vector<std::pair<size_t, size_t>> sampled_sparsity{};
+      std::vector<std::pair<size_t, size_t>> sparsity_buffer{};
+      // (objective multiplier, values) of at most two evaluations
+      std::vector<std::pair<double, std::vector<double>>> samples{};
    };
 } // namespace
 
@@ -12,12 +12,17 @@
 namespace uno {
    std::unique_ptr<HessianModel> HessianModelFactory::create(const std::string& hessian_model, size_t dimension, size_t maximum_number_nonzeros,
          bool convexify, const Options& options) {
-      if (hessian_model == "exact") {
+      // the quasi-Newton and finite-difference approximations are provided by the model (QuasiNewtonModel, FiniteDifferenceHessianModel)
+      // and are used as the exact Hessian. SR1 and the finite differences may be indefinite and are convexified like an exact Hessian
+      if (hessian_model == "exact" || hessian_model == "LBFGS" || hessian_model == "BFGS" || hessian_model == "SR1" ||
+            hessian_model == "finite_differences") {
+         // only the exact Hessian is affine in the objective multiplier (the approximations are not)
+         const bool is_affine_in_objective_multiplier = (hessian_model == "exact");
          if (convexify) {
-            return std::make_unique<ConvexifiedHessian>(dimension, maximum_number_nonzeros + dimension, options);
+            return std::make_unique<ConvexifiedHessian>(dimension, maximum_number_nonzeros + dimension, is_affine_in_objective_multiplier, options);
          }
          else {
-            return std::make_unique<ExactHessian>();
+            return std::make_unique<ExactHessian>(is_affine_in_objective_multiplier);
          }
       }
       else if (hessian_model == "zero") {
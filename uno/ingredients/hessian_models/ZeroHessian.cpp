@@ -4,7 +4,9 @@
 #include "ZeroHessian.hpp"
 #include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
 #include "options/Options.hpp"
+#include "symbolic/Range.hpp"
 
 namespace uno {
    void ZeroHessian::initialize_statistics(Statistics& /*statistics*/, const Options& /*options*/) const { }
@@ -14,4 +16,11 @@ namespace uno {
       hessian.set_dimension(problem.number_variables);
       hessian.reset();
    }
+
+   void ZeroHessian::compute_hessian_vector_product(const OptimizationProblem& problem, const Vector<double>& /*primal_variables*/,
+         const Vector<double>& /*constraint_multipliers*/, const Vector<double>& /*vector*/, Vector<double>& result) {
+      for (size_t variable_index: Range(problem.number_variables)) {
+         result[variable_index] = 0.;
+      }
+   }
 }
\ No newline at end of file
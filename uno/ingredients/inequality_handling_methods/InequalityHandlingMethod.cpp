@@ -2,8 +2,10 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include <cassert>
+#include <stdexcept>
 #include "InequalityHandlingMethod.hpp"
 #include "ingredients/hessian_models/HessianModelFactory.hpp"
+#include "tools/MemoryReport.hpp"
 
 namespace uno {
    InequalityHandlingMethod::InequalityHandlingMethod(const std::string& hessian_model, size_t dimension, size_t number_hessian_nonzeros, bool convexify,
@@ -16,7 +18,40 @@ namespace uno {
       this->trust_region_radius = new_trust_region_radius;
    }
 
+   void InequalityHandlingMethod::forget_hessian_evaluation() {
+      this->hessian_model->forget_evaluation();
+   }
+
+   // by default, no second-order correction
+   bool InequalityHandlingMethod::compute_second_order_correction(const OptimizationProblem& /*problem*/, Iterate& /*current_iterate*/,
+         const Multipliers& /*current_multipliers*/, Iterate& /*trial_iterate*/, Direction& /*direction*/) {
+      return false;
+   }
+
    size_t InequalityHandlingMethod::get_hessian_evaluation_count() const {
       return this->hessian_model->evaluation_count;
    }
+
+   size_t InequalityHandlingMethod::get_peak_workspace_size() const {
+      return 0;
+   }
+
+   FactorizationStatistics InequalityHandlingMethod::get_factorization_statistics() const {
+      return {};
+   }
+
+   void InequalityHandlingMethod::solve_sensitivity_systems(const Vector<double>& /*rhs*/, Vector<double>& /*result*/, size_t /*number_rhs*/) {
+      throw std::runtime_error("The sensitivities require the factorization of the primal-dual system of an interior point method");
+   }
+
+   void InequalityHandlingMethod::report_memory(MemoryReport& report) const {
+      report.add("Hessian model", this->hessian_model->memory_size());
+   }
+
+   // by default, the method has no state
+   void InequalityHandlingMethod::save_state(CheckpointWriter& /*writer*/) const {
+   }
+
+   void InequalityHandlingMethod::load_state(CheckpointReader& /*reader*/) {
+   }
 } // namespace
\ No newline at end of file
@@ -7,13 +7,17 @@
 #include <memory>
 #include <string>
 #include "ingredients/hessian_models/HessianModel.hpp"
+#include "ingredients/subproblem_solvers/FactorizationStatistics.hpp"
 #include "tools/Infinity.hpp"
 
 namespace uno {
    // forward declarations
+   class CheckpointReader;
+   class CheckpointWriter;
    class Direction;
    class Iterate;
    class l1RelaxedProblem;
+   class MemoryReport;
    class Model;
    class Multipliers;
    class OptimizationProblem;
@@ -32,11 +36,16 @@ namespace uno {
 
       // virtual methods implemented by subclasses
       virtual void initialize_statistics(Statistics& statistics, const Options& options) = 0;
-      virtual void generate_initial_iterate(const OptimizationProblem& problem, Iterate& initial_iterate) = 0;
+      virtual void generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) = 0;
       virtual void solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
             Direction& direction, WarmstartInformation& warmstart_information) = 0;
+      // second-order correction of the last direction, given the rejected trial iterate. Returns false if no correction is available
+      [[nodiscard]] virtual bool compute_second_order_correction(const OptimizationProblem& problem, Iterate& current_iterate,
+            const Multipliers& current_multipliers, Iterate& trial_iterate, Direction& direction);
 
       void set_trust_region_radius(double new_trust_region_radius);
+      // a new solve: the functions may have changed since the last evaluation of the Hessian
+      virtual void forget_hessian_evaluation();
       virtual void initialize_feasibility_problem(const l1RelaxedProblem& problem, Iterate& current_iterate) = 0;
       virtual void set_elastic_variable_values(const l1RelaxedProblem& problem, Iterate& current_iterate) = 0;
       [[nodiscard]] virtual double proximal_coefficient(const Iterate& current_iterate) const = 0;
@@ -50,10 +59,23 @@ namespace uno {
 
       virtual void postprocess_iterate(const OptimizationProblem& problem, Iterate& iterate) = 0;
 
-      [[nodiscard]] size_t get_hessian_evaluation_count() const;
+      [[nodiscard]] virtual size_t get_hessian_evaluation_count() const;
+      // memory of the workspaces of the subproblem solver (in bytes)
+      [[nodiscard]] virtual size_t get_peak_workspace_size() const;
+      // analyses and factorizations of the linear solvers since their creation
+      [[nodiscard]] virtual FactorizationStatistics get_factorization_statistics() const;
+      // post-solve sensitivity: solve the primal-dual system of the last iteration with the current factors for a block of number_rhs
+      // right-hand sides (column-major, dimension number_variables + number_constraints)
+      virtual void solve_sensitivity_systems(const Vector<double>& rhs, Vector<double>& result, size_t number_rhs);
+      // memory of the buffers of the method and of its solvers, per component
+      virtual void report_memory(MemoryReport& report) const;
       virtual void set_initial_point(const Vector<double>& initial_point) = 0;
+      // algorithmic state (e.g. the barrier parameter) in a checkpoint
+      virtual void save_state(CheckpointWriter& writer) const;
+      virtual void load_state(CheckpointReader& reader);
 
       size_t number_subproblems_solved{0};
+      size_t number_factorizations{0}; // numerical factorizations of the linear systems (0 if the method does not factorize)
       // when the parameterization of the subproblem (e.g. penalty or barrier parameter) is updated, signal it
       bool subproblem_definition_changed{false};
 
@@ -4,9 +4,15 @@
 #include <string>
 #include "InequalityHandlingMethod.hpp"
 #include "InequalityHandlingMethodFactory.hpp"
+#include "inequality_constrained_methods/LBFGSBSubproblem.hpp"
 #include "inequality_constrained_methods/QPSubproblem.hpp"
 #include "inequality_constrained_methods/LPSubproblem.hpp"
+#include "inequality_constrained_methods/ReducedSpaceSubproblem.hpp"
+#include "inequality_constrained_methods/SLQPSubproblem.hpp"
+#include "inequality_constrained_methods/TruncatedCGSubproblem.hpp"
+#include "interior_point_methods/InteriorPointCrossoverMethod.hpp"
 #include "interior_point_methods/PrimalDualInteriorPointMethod.hpp"
+#include "ingredients/subproblem_solvers/LPSolverFactory.hpp"
 #include "ingredients/subproblem_solvers/QPSolverFactory.hpp"
 #include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
 #include "options/Options.hpp"
@@ -15,8 +21,17 @@ namespace uno {
    std::unique_ptr<InequalityHandlingMethod> InequalityHandlingMethodFactory::create(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
          size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options) {
       const std::string subproblem_strategy = options.get_string("subproblem");
+      // without general constraints, the line-search subproblem is solved by projected L-BFGS with no factorization
+      if (InequalityHandlingMethodFactory::uses_LBFGSB_subproblem(number_constraints, options)) {
+         return std::make_unique<LBFGSBSubproblem>(number_variables, options);
+      }
+      // without general constraints, the trust-region QP is solved matrix-free by truncated CG
+      if (subproblem_strategy == "truncated_CG" || (subproblem_strategy == "QP" && number_constraints == 0 &&
+            options.get_string("globalization_mechanism") == "TR")) {
+         return std::make_unique<TruncatedCGSubproblem>(number_variables, number_hessian_nonzeros, options);
+      }
       // active-set methods
-      if (subproblem_strategy == "QP") {
+      else if (subproblem_strategy == "QP") {
          return std::make_unique<QPSubproblem>(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros,
                number_hessian_nonzeros, options);
       }
@@ -24,11 +39,25 @@ namespace uno {
          return std::make_unique<LPSubproblem>(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros,
                options);
       }
+      // LP active-set estimation followed by an equality-constrained QP
+      else if (subproblem_strategy == "SLQP") {
+         return std::make_unique<SLQPSubproblem>(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros,
+               number_hessian_nonzeros, options);
+      }
+      // null-space method with a basis of the equality Jacobian and a quasi-Newton reduced Hessian
+      else if (subproblem_strategy == "reduced_space") {
+         return std::make_unique<ReducedSpaceSubproblem>(number_variables, number_constraints, number_jacobian_nonzeros, options);
+      }
       // interior-point method
       else if (subproblem_strategy == "primal_dual_interior_point") {
          return std::make_unique<PrimalDualInteriorPointMethod>(number_variables, number_constraints, number_jacobian_nonzeros,
                number_hessian_nonzeros, options);
       }
+      // interior-point method followed by a crossover to the QP subproblem
+      else if (subproblem_strategy == "interior_point_crossover") {
+         return std::make_unique<InteriorPointCrossoverMethod>(number_variables, number_constraints, number_objective_gradient_nonzeros,
+               number_jacobian_nonzeros, number_hessian_nonzeros, options);
+      }
       throw std::invalid_argument("Subproblem strategy " + subproblem_strategy + " is not supported");
    }
 
@@ -40,7 +69,51 @@ namespace uno {
       }
       if (!SymmetricIndefiniteLinearSolverFactory::available_solvers().empty()) {
          strategies.emplace_back("primal_dual_interior_point");
+         if (!QPSolverFactory::available_solvers().empty()) {
+            strategies.emplace_back("interior_point_crossover");
+         }
+         if (!LPSolverFactory::available_solvers().empty()) {
+            strategies.emplace_back("SLQP");
+         }
       }
+      // sparse LU of the basis of the equality Jacobian
+      strategies.emplace_back("reduced_space");
+      // matrix-free, for problems without general constraints
+      strategies.emplace_back("truncated_CG");
+      strategies.emplace_back("LBFGSB");
       return strategies;
    }
+
+   bool InequalityHandlingMethodFactory::uses_LBFGSB_subproblem(size_t number_constraints, const Options& options) {
+      const std::string& subproblem_strategy = options.get_string("subproblem");
+      if (subproblem_strategy == "LBFGSB") {
+         return true;
+      }
+      // the trust-region subproblem without general constraints is handled by truncated CG
+      return (number_constraints == 0 && options.get_string("globalization_mechanism") == "LS" &&
+         options.get_string("bound_constrained_subproblem") == "LBFGSB" && (subproblem_strategy == "QP" ||
+         subproblem_strategy == "primal_dual_interior_point" || subproblem_strategy == "interior_point_crossover"));
+   }
+
+   bool InequalityHandlingMethodFactory::uses_lagrangian_hessian(size_t number_constraints, const Options& options) {
+      const std::string& subproblem_strategy = options.get_string("subproblem");
+      if (subproblem_strategy == "LP" || subproblem_strategy == "reduced_space" ||
+            InequalityHandlingMethodFactory::uses_LBFGSB_subproblem(number_constraints, options)) {
+         return false;
+      }
+      // the interior-point methods always use the exact Hessian (possibly approximated by the model)
+      if (subproblem_strategy == "primal_dual_interior_point" || subproblem_strategy == "interior_point_crossover") {
+         return true;
+      }
+      return (options.get_string("hessian_model") != "zero");
+   }
+
+   size_t InequalityHandlingMethodFactory::hessian_low_rank_dimension(const Options& options) {
+      // the static pivoting of the quasi-definite mode does not apply to the indefinite middle matrix
+      if (options.get_string("hessian_model") != "LBFGS" || options.get_string("subproblem") != "primal_dual_interior_point" ||
+            options.get_string("constraint_relaxation_strategy") == "augmented_lagrangian" || options.get_bool("quasi_definite_regularization")) {
+         return 0;
+      }
+      return 2 * options.get_unsigned_int("LBFGS_memory_size");
+   }
 } // namespace
@@ -18,6 +18,15 @@ namespace uno {
                size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options);
 
          static std::vector<std::string> available_strategies();
+         // whether the projected quasi-Newton (L-BFGS-B) subproblem is used: the model is then neither reformulated nor given a
+         // quasi-Newton Hessian
+         [[nodiscard]] static bool uses_LBFGSB_subproblem(size_t number_constraints, const Options& options);
+         // whether the subproblems evaluate the Lagrangian Hessian of the model. Otherwise (LP and L-BFGS-B subproblems, reduced-space
+         // method, zero Hessian model), its sparsity is not requested and the models that compute it on demand skip it
+         [[nodiscard]] static bool uses_lagrangian_hessian(size_t number_constraints, const Options& options);
+         // dimension of the low-rank term of the Hessian model kept in compact form in the augmented system of the interior-point method
+         // (2 x LBFGS_memory_size for the L-BFGS model, 0 otherwise). The other subproblems use the materialized Hessian
+         [[nodiscard]] static size_t hessian_low_rank_dimension(const Options& options);
    };
 } // namespace
 
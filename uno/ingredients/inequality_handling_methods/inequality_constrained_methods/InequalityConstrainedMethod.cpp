@@ -4,10 +4,12 @@
 #include "InequalityConstrainedMethod.hpp"
 #include "optimization/Direction.hpp"
 #include "optimization/Iterate.hpp"
+#include "optimization/WarmstartInformation.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "ingredients/constraint_relaxation_strategies/l1RelaxedProblem.hpp"
 #include "options/Options.hpp"
 #include "symbolic/VectorView.hpp"
+#include "tools/MemoryReport.hpp"
 
 namespace uno {
    InequalityConstrainedMethod::InequalityConstrainedMethod(const std::string& hessian_model, size_t number_variables, size_t number_constraints,
@@ -17,10 +19,7 @@ namespace uno {
          direction_lower_bounds(number_variables),
          direction_upper_bounds(number_variables),
          linearized_constraints_lower_bounds(number_constraints),
-         linearized_constraints_upper_bounds(number_constraints),
-         objective_gradient(number_variables),
-         constraints(number_constraints),
-         constraint_jacobian(number_constraints, number_variables) {
+         linearized_constraints_upper_bounds(number_constraints) {
    }
 
    void InequalityConstrainedMethod::initialize_statistics(Statistics& statistics, const Options& options) {
@@ -52,6 +51,20 @@ namespace uno {
       // do nothing
    }
 
+   // the LP/QP solver keeps the data of the last subproblem: if the problem or its objective multiplier differ (e.g. after a rejected
+   // trust-region step in a sequence of l1-relaxed subproblems), the objective must be re-evaluated
+   void InequalityConstrainedMethod::check_solved_problem(const OptimizationProblem& problem, WarmstartInformation& warmstart_information) {
+      if (this->solved_problem != nullptr && (this->solved_problem->number_variables != problem.number_variables ||
+            this->solved_problem->number_constraints != problem.number_constraints)) {
+         warmstart_information.whole_problem_changed();
+      }
+      else if (this->solved_problem != &problem || this->solved_objective_multiplier != problem.get_objective_multiplier()) {
+         warmstart_information.objective_changed = true;
+      }
+      this->solved_problem = &problem;
+      this->solved_objective_multiplier = problem.get_objective_multiplier();
+   }
+
    void InequalityConstrainedMethod::set_direction_bounds(const OptimizationProblem& problem, const Iterate& current_iterate) {
       // bounds of original variables intersected with trust region
       for (size_t variable_index: Range(problem.get_number_original_variables())) {
@@ -95,4 +108,12 @@ namespace uno {
 
    void InequalityConstrainedMethod::postprocess_iterate(const OptimizationProblem& /*problem*/, Iterate& /*iterate*/) {
    }
+
+   void InequalityConstrainedMethod::report_memory(MemoryReport& report) const {
+      InequalityHandlingMethod::report_memory(report);
+      report.add("subproblem/bounds", MemoryReport::memory_size(this->direction_lower_bounds) +
+            MemoryReport::memory_size(this->direction_upper_bounds) + MemoryReport::memory_size(this->linearized_constraints_lower_bounds) +
+            MemoryReport::memory_size(this->linearized_constraints_upper_bounds));
+      report.add("subproblem/initial point", this->initial_point.memory_size());
+   }
 } // namespace
@@ -5,8 +5,6 @@
 #define UNO_INEQUALITYCONSTRAINEDMETHOD_H
 
 #include "../InequalityHandlingMethod.hpp"
-#include "linear_algebra/RectangularMatrix.hpp"
-#include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/Vector.hpp"
 
 namespace uno {
@@ -27,6 +25,7 @@ namespace uno {
       [[nodiscard]] double compute_predicted_auxiliary_reduction_model(const Model& model, const Iterate&, const Vector<double>&, double) const override;
 
       void postprocess_iterate(const OptimizationProblem& model, Iterate& iterate) override;
+      void report_memory(MemoryReport& report) const override;
 
    protected:
       Vector<double> initial_point{};
@@ -34,13 +33,13 @@ namespace uno {
       std::vector<double> direction_upper_bounds{};
       std::vector<double> linearized_constraints_lower_bounds{};
       std::vector<double> linearized_constraints_upper_bounds{};
-
-      SparseVector<double> objective_gradient; /*!< Sparse Jacobian of the objective */
-      std::vector<double> constraints; /*!< Constraint values (size \f$m)\f$ */
-      RectangularMatrix<double> constraint_jacobian; /*!< Sparse Jacobian of the constraints */
+      // problem (and objective multiplier) whose data the LP/QP solver currently holds
+      const OptimizationProblem* solved_problem{nullptr};
+      double solved_objective_multiplier{0.};
 
       void set_direction_bounds(const OptimizationProblem& problem, const Iterate& current_iterate);
       void set_linearized_constraint_bounds(const OptimizationProblem& problem, const std::vector<double>& current_constraints);
+      void check_solved_problem(const OptimizationProblem& problem, WarmstartInformation& warmstart_information);
       static void compute_dual_displacements(const Multipliers& current_multipliers, Multipliers& direction_multipliers);
    };
 } // namespace
@@ -0,0 +1,453 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "LBFGSBSubproblem.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+#include "tools/MemoryReport.hpp"
+
+namespace uno {
+   namespace {
+      // order of a min-heap of breakpoints
+      bool is_later_breakpoint(const std::pair<double, size_t>& first_breakpoint, const std::pair<double, size_t>& second_breakpoint) {
+         return second_breakpoint.first < first_breakpoint.first;
+      }
+
+      double dot(const std::vector<double>& x, const std::vector<double>& y, size_t dimension) {
+         double product = 0.;
+         for (size_t index: Range(dimension)) {
+            product += x[index] * y[index];
+         }
+         return product;
+      }
+   } // namespace
+
+   LBFGSBSubproblem::LBFGSBSubproblem(size_t number_variables, const Options& options):
+         // the curvature is approximated by the L-BFGS pairs: the Hessian of the problem is not evaluated
+         InequalityConstrainedMethod("zero", number_variables, 0, 0, false, options),
+         memory_size(options.get_unsigned_int("LBFGS_memory_size")),
+         objective_gradient(number_variables),
+         gradient(number_variables),
+         s_vectors(this->memory_size, Vector<double>(number_variables)),
+         y_vectors(this->memory_size, Vector<double>(number_variables)),
+         ss_products(this->memory_size * this->memory_size),
+         sy_products(this->memory_size * this->memory_size),
+         previous_primals(number_variables),
+         previous_gradient(number_variables),
+         path_direction(number_variables),
+         is_free(number_variables),
+         residual(number_variables),
+         low_rank_row(2 * this->memory_size),
+         path_projection(2 * this->memory_size),
+         point_projection(2 * this->memory_size),
+         reduced_projection(2 * this->memory_size),
+         product_projection(2 * this->memory_size),
+         hessian_product(number_variables) {
+      if (this->memory_size == 0) {
+         throw std::invalid_argument("The L-BFGS memory size should be positive");
+      }
+      this->breakpoints.reserve(number_variables);
+      this->middle_matrices.reserve(this->memory_size);
+      this->reduced_matrices.reserve(this->memory_size);
+      for (size_t number_pairs: Range(1, this->memory_size + 1)) {
+         this->middle_matrices.emplace_back(2 * number_pairs);
+         this->reduced_matrices.emplace_back(2 * number_pairs);
+      }
+   }
+
+   void LBFGSBSubproblem::generate_initial_iterate(Statistics& /*statistics*/, const OptimizationProblem& /*problem*/, Iterate& /*initial_iterate*/) {
+   }
+
+   void LBFGSBSubproblem::solve(Statistics& /*statistics*/, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers, Direction& direction, WarmstartInformation& /*warmstart_information*/) {
+      if (0 < problem.number_constraints) {
+         throw std::runtime_error("The L-BFGS-B subproblem does not handle general constraints");
+      }
+      this->number_variables = problem.number_variables;
+      problem.evaluate_objective_gradient(current_iterate, this->objective_gradient);
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->gradient[variable_index] = 0.;
+      }
+      for (const auto [variable_index, derivative]: this->objective_gradient) {
+         this->gradient[variable_index] = derivative;
+      }
+      this->update_pairs(problem, current_iterate);
+      this->set_direction_bounds(problem, current_iterate);
+
+      Vector<double>& primal_direction = direction.primals;
+      if (!this->compute_cauchy_point(primal_direction)) {
+         DEBUG << "L-BFGS-B: the projected gradient path is unbounded\n";
+         direction.status = SubproblemStatus::UNBOUNDED_PROBLEM;
+         return;
+      }
+      this->minimize_subspace(primal_direction);
+      DEBUG << "L-BFGS-B: " << this->number_pairs << " pairs, scaling " << this->scaling << '\n';
+
+      // model gradient r = g + B d at the solution
+      this->compute_product(primal_direction, this->residual);
+      direction.subproblem_objective = 0.;
+      for (size_t variable_index: Range(this->number_variables)) {
+         direction.subproblem_objective += primal_direction[variable_index] * (this->gradient[variable_index] + 0.5 * this->residual[variable_index]);
+         this->residual[variable_index] += this->gradient[variable_index];
+      }
+      this->set_multipliers(primal_direction, direction.multipliers);
+      InequalityConstrainedMethod::compute_dual_displacements(current_multipliers, direction.multipliers);
+      direction.status = SubproblemStatus::OPTIMAL;
+      this->number_subproblems_solved++;
+   }
+
+   double LBFGSBSubproblem::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      if (this->previous_problem == nullptr) {
+         return 0.;
+      }
+      this->compute_product(primal_direction, this->hessian_product);
+      double product = 0.;
+      for (size_t variable_index: Range(this->number_variables)) {
+         product += primal_direction[variable_index] * this->hessian_product[variable_index];
+      }
+      return product;
+   }
+
+   void LBFGSBSubproblem::report_memory(MemoryReport& report) const {
+      InequalityConstrainedMethod::report_memory(report);
+      size_t pairs_size = MemoryReport::memory_size(this->ss_products) + MemoryReport::memory_size(this->sy_products);
+      for (size_t pair_index: Range(this->memory_size)) {
+         pairs_size += this->s_vectors[pair_index].memory_size() + this->y_vectors[pair_index].memory_size();
+      }
+      for (size_t pair_index: Range(this->memory_size)) {
+         pairs_size += this->middle_matrices[pair_index].memory_size() + this->reduced_matrices[pair_index].memory_size();
+      }
+      report.add("subproblem/L-BFGS pairs", pairs_size);
+      report.add("subproblem/objective gradient", this->objective_gradient.memory_size());
+      report.add("subproblem/L-BFGS-B vectors", this->gradient.memory_size() + this->previous_primals.memory_size() +
+            this->previous_gradient.memory_size() + this->path_direction.memory_size() + this->residual.memory_size() +
+            this->hessian_product.memory_size() + this->breakpoints.capacity() * sizeof(std::pair<double, size_t>) + this->is_free.capacity() / 8);
+   }
+
+   // a new pair (s, y) is formed from the previous iterate. The pairs are discarded when the problem, its objective multiplier or
+   // its definition (e.g. the parameters of an augmented Lagrangian) change, since they then describe another function
+   void LBFGSBSubproblem::update_pairs(const OptimizationProblem& problem, const Iterate& current_iterate) {
+      if (this->previous_problem == &problem && this->previous_objective_multiplier == problem.get_objective_multiplier() &&
+            !this->subproblem_definition_changed) {
+         for (size_t variable_index: Range(this->number_variables)) {
+            this->previous_primals[variable_index] = current_iterate.primals[variable_index] - this->previous_primals[variable_index];
+            this->previous_gradient[variable_index] = this->gradient[variable_index] - this->previous_gradient[variable_index];
+         }
+         this->add_pair(this->previous_primals, this->previous_gradient);
+      }
+      else {
+         this->first_pair = 0;
+         this->number_pairs = 0;
+         this->scaling = 1.;
+      }
+      this->previous_problem = &problem;
+      this->previous_objective_multiplier = problem.get_objective_multiplier();
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->previous_primals[variable_index] = current_iterate.primals[variable_index];
+         this->previous_gradient[variable_index] = this->gradient[variable_index];
+      }
+   }
+
+   void LBFGSBSubproblem::add_pair(const Vector<double>& s, const Vector<double>& y) {
+      double ss = 0.;
+      double sy = 0.;
+      double yy = 0.;
+      for (size_t variable_index: Range(this->number_variables)) {
+         ss += s[variable_index] * s[variable_index];
+         sy += s[variable_index] * y[variable_index];
+         yy += y[variable_index] * y[variable_index];
+      }
+      // skip the pairs with vanishing curvature: B remains positive definite
+      if (sy <= 1e-8 * std::sqrt(ss * yy)) {
+         DEBUG << "L-BFGS-B: the pair is skipped (s^T y = " << sy << ")\n";
+         return;
+      }
+      // the oldest pair is overwritten if the memory is full
+      size_t new_pair;
+      if (this->number_pairs == this->memory_size) {
+         new_pair = this->first_pair;
+         this->first_pair = (this->first_pair + 1) % this->memory_size;
+      }
+      else {
+         new_pair = this->storage_index(this->number_pairs);
+         this->number_pairs++;
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->s_vectors[new_pair][variable_index] = s[variable_index];
+         this->y_vectors[new_pair][variable_index] = y[variable_index];
+      }
+      for (size_t pair_index: Range(this->number_pairs)) {
+         const size_t other_pair = this->storage_index(pair_index);
+         double s_other_s = 0.;
+         double s_other_y = 0.;
+         double other_s_y = 0.;
+         for (size_t variable_index: Range(this->number_variables)) {
+            s_other_s += s[variable_index] * this->s_vectors[other_pair][variable_index];
+            s_other_y += s[variable_index] * this->y_vectors[other_pair][variable_index];
+            other_s_y += this->s_vectors[other_pair][variable_index] * y[variable_index];
+         }
+         this->ss_products[new_pair * this->memory_size + other_pair] = s_other_s;
+         this->ss_products[other_pair * this->memory_size + new_pair] = s_other_s;
+         this->sy_products[new_pair * this->memory_size + other_pair] = s_other_y;
+         this->sy_products[other_pair * this->memory_size + new_pair] = other_s_y;
+      }
+      this->scaling = yy / sy;
+      this->factorize_middle_matrix();
+   }
+
+   void LBFGSBSubproblem::factorize_middle_matrix() {
+      DenseLDLT<double>& middle_matrix = this->middle_matrices[this->number_pairs - 1];
+      this->assemble_middle_matrix(middle_matrix);
+      middle_matrix.factorize();
+   }
+
+   // M = [delta S^T S, L; L^T, -D], with L the strictly lower triangular part of S^T Y and D its diagonal (lower triangle)
+   void LBFGSBSubproblem::assemble_middle_matrix(DenseLDLT<double>& matrix) const {
+      const size_t number_pairs = this->number_pairs;
+      matrix.reset();
+      for (size_t i: Range(number_pairs)) {
+         const size_t pair_i = this->storage_index(i);
+         for (size_t j: Range(i + 1)) {
+            const size_t pair_j = this->storage_index(j);
+            matrix.entry(i, j) = this->scaling * this->ss_products[pair_i * this->memory_size + pair_j];
+            if (j < i) {
+               matrix.entry(number_pairs + j, i) = this->sy_products[pair_i * this->memory_size + pair_j];
+            }
+         }
+         matrix.entry(number_pairs + i, number_pairs + i) = -this->sy_products[pair_i * this->memory_size + pair_i];
+      }
+   }
+
+   void LBFGSBSubproblem::compute_low_rank_row(size_t variable_index, std::vector<double>& row) const {
+      for (size_t pair_index: Range(this->number_pairs)) {
+         const size_t pair = this->storage_index(pair_index);
+         row[pair_index] = this->scaling * this->s_vectors[pair][variable_index];
+         row[this->number_pairs + pair_index] = this->y_vectors[pair][variable_index];
+      }
+   }
+
+   void LBFGSBSubproblem::compute_low_rank_projection(const Vector<double>& vector, std::vector<double>& projection) const {
+      for (size_t pair_index: Range(this->number_pairs)) {
+         const size_t pair = this->storage_index(pair_index);
+         double sv = 0.;
+         double yv = 0.;
+         for (size_t variable_index: Range(this->number_variables)) {
+            sv += this->s_vectors[pair][variable_index] * vector[variable_index];
+            yv += this->y_vectors[pair][variable_index] * vector[variable_index];
+         }
+         projection[pair_index] = this->scaling * sv;
+         projection[this->number_pairs + pair_index] = yv;
+      }
+   }
+
+   void LBFGSBSubproblem::solve_middle_system(std::vector<double>& rhs) const {
+      this->middle_matrices[this->number_pairs - 1].solve(rhs.data());
+   }
+
+   // B v = delta v - W M^{-1} W^T v, in O(nk) operations
+   void LBFGSBSubproblem::compute_product(const Vector<double>& vector, Vector<double>& result) const {
+      const size_t number_pairs = this->number_pairs;
+      if (0 < number_pairs) {
+         this->compute_low_rank_projection(vector, this->product_projection);
+         this->solve_middle_system(this->product_projection);
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         double entry = this->scaling * vector[variable_index];
+         for (size_t pair_index: Range(number_pairs)) {
+            const size_t pair = this->storage_index(pair_index);
+            entry -= this->scaling * this->s_vectors[pair][variable_index] * this->product_projection[pair_index] +
+               this->y_vectors[pair][variable_index] * this->product_projection[number_pairs + pair_index];
+         }
+         result[variable_index] = entry;
+      }
+   }
+
+   // generalized Cauchy point: first local minimizer of the model along the projected gradient path d(t) = P(d0 - t g), where d0 is
+   // the projection of 0 onto the box. The breakpoints are visited in increasing order (min-heap); on each segment, the directional
+   // derivatives f' = (g + B d)^T p and f'' = p^T B p are updated in O(k) operations. Returns false if the path is unbounded
+   bool LBFGSBSubproblem::compute_cauchy_point(Vector<double>& primal_direction) {
+      const size_t number_pairs = this->number_pairs;
+      const size_t dimension = 2 * number_pairs;
+      this->breakpoints.clear();
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double lower_bound = this->direction_lower_bounds[variable_index];
+         const double upper_bound = this->direction_upper_bounds[variable_index];
+         primal_direction[variable_index] = std::min(std::max(0., lower_bound), upper_bound);
+         const double component = -this->gradient[variable_index];
+         double breakpoint = INF<double>;
+         if (component < 0.) {
+            breakpoint = (lower_bound - primal_direction[variable_index]) / component;
+         }
+         else if (0. < component) {
+            breakpoint = (upper_bound - primal_direction[variable_index]) / component;
+         }
+         // the variables at a blocking bound do not move
+         this->path_direction[variable_index] = (breakpoint == 0.) ? 0. : component;
+         if (0. < breakpoint && breakpoint < INF<double>) {
+            this->breakpoints.emplace_back(breakpoint, variable_index);
+         }
+      }
+
+      // directional derivatives at d0: f' = g^T p + delta d0^T p - (W^T p)^T M^{-1} W^T d0 and f'' = delta p^T p - (W^T p)^T M^{-1} W^T p
+      double first_derivative = 0.;
+      double second_derivative = 0.;
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double component = this->path_direction[variable_index];
+         first_derivative += (this->gradient[variable_index] + this->scaling * primal_direction[variable_index]) * component;
+         second_derivative += this->scaling * component * component;
+      }
+      if (0 < number_pairs) {
+         this->compute_low_rank_projection(primal_direction, this->point_projection);
+         this->compute_low_rank_projection(this->path_direction, this->path_projection);
+         std::copy(this->point_projection.cbegin(), this->point_projection.cbegin() + static_cast<std::ptrdiff_t>(dimension),
+               this->reduced_projection.begin());
+         this->solve_middle_system(this->reduced_projection);
+         first_derivative -= dot(this->path_projection, this->reduced_projection, dimension);
+         std::copy(this->path_projection.cbegin(), this->path_projection.cbegin() + static_cast<std::ptrdiff_t>(dimension),
+               this->reduced_projection.begin());
+         this->solve_middle_system(this->reduced_projection);
+         second_derivative -= dot(this->path_projection, this->reduced_projection, dimension);
+      }
+
+      std::make_heap(this->breakpoints.begin(), this->breakpoints.end(), is_later_breakpoint);
+      auto heap_end = this->breakpoints.end();
+      double path_parameter = 0.;
+      while (first_derivative < 0.) {
+         const double step_to_minimizer = (0. < second_derivative) ? -first_derivative / second_derivative : INF<double>;
+         if (heap_end == this->breakpoints.begin()) {
+            if (step_to_minimizer == INF<double>) {
+               return false;
+            }
+            path_parameter += step_to_minimizer;
+            break;
+         }
+         std::pop_heap(this->breakpoints.begin(), heap_end, is_later_breakpoint);
+         --heap_end;
+         const auto [breakpoint, variable_index] = *heap_end;
+         const double step_to_breakpoint = breakpoint - path_parameter;
+         if (step_to_minimizer < step_to_breakpoint) {
+            path_parameter += step_to_minimizer;
+            break;
+         }
+         // move to the breakpoint, where the variable is fixed at its bound
+         const double component = this->path_direction[variable_index];
+         const double bound = (0. < component) ? this->direction_upper_bounds[variable_index] : this->direction_lower_bounds[variable_index];
+         double model_gradient = this->gradient[variable_index] + this->scaling * bound; // (g + B d)_b
+         double hessian_product_component = this->scaling * component; // (B p)_b
+         double hessian_diagonal = this->scaling; // B_bb
+         if (0 < number_pairs) {
+            for (size_t index: Range(dimension)) {
+               this->point_projection[index] += step_to_breakpoint * this->path_projection[index];
+            }
+            this->compute_low_rank_row(variable_index, this->low_rank_row);
+            std::copy(this->low_rank_row.cbegin(), this->low_rank_row.cbegin() + static_cast<std::ptrdiff_t>(dimension),
+                  this->reduced_projection.begin());
+            this->solve_middle_system(this->reduced_projection);
+            model_gradient -= dot(this->reduced_projection, this->point_projection, dimension);
+            hessian_product_component -= dot(this->reduced_projection, this->path_projection, dimension);
+            hessian_diagonal -= dot(this->reduced_projection, this->low_rank_row, dimension);
+            for (size_t index: Range(dimension)) {
+               this->path_projection[index] -= component * this->low_rank_row[index];
+            }
+         }
+         first_derivative += step_to_breakpoint * second_derivative - component * model_gradient;
+         second_derivative += component * (component * hessian_diagonal - 2. * hessian_product_component);
+         this->path_direction[variable_index] = 0.;
+         primal_direction[variable_index] = bound;
+         path_parameter = breakpoint;
+      }
+      // the variables that did not reach their bounds
+      for (size_t variable_index: Range(this->number_variables)) {
+         primal_direction[variable_index] += path_parameter * this->path_direction[variable_index];
+      }
+      return true;
+   }
+
+   // minimization of the model over the variables F that are free at the Cauchy point d^c: the Newton step on F is
+   // -(B_FF)^{-1} r with r = (g + B d^c)_F, and (B_FF)^{-1} = 1/delta I + 1/delta^2 W_F (M - 1/delta W_F^T W_F)^{-1} W_F^T. The step
+   // is truncated at the box
+   void LBFGSBSubproblem::minimize_subspace(Vector<double>& primal_direction) {
+      const size_t number_pairs = this->number_pairs;
+      const size_t dimension = 2 * number_pairs;
+      bool has_free_variables = false;
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->is_free[variable_index] = (this->direction_lower_bounds[variable_index] < primal_direction[variable_index] &&
+            primal_direction[variable_index] < this->direction_upper_bounds[variable_index]);
+         has_free_variables = has_free_variables || this->is_free[variable_index];
+      }
+      if (!has_free_variables) {
+         return;
+      }
+      // reduced gradient
+      this->compute_product(primal_direction, this->residual);
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->residual[variable_index] += this->gradient[variable_index];
+      }
+      if (0 < number_pairs) {
+         DenseLDLT<double>& reduced_matrix = this->reduced_matrices[number_pairs - 1];
+         this->assemble_middle_matrix(reduced_matrix);
+         std::fill(this->reduced_projection.begin(), this->reduced_projection.end(), 0.);
+         for (size_t variable_index: Range(this->number_variables)) {
+            if (this->is_free[variable_index]) {
+               this->compute_low_rank_row(variable_index, this->low_rank_row);
+               for (size_t row_index: Range(dimension)) {
+                  this->reduced_projection[row_index] += this->low_rank_row[row_index] * this->residual[variable_index];
+                  for (size_t column_index: Range(row_index + 1)) {
+                     reduced_matrix.entry(row_index, column_index) -= this->low_rank_row[row_index] * this->low_rank_row[column_index] / this->scaling;
+                  }
+               }
+            }
+         }
+         reduced_matrix.factorize();
+         if (reduced_matrix.is_singular()) {
+            DEBUG << "L-BFGS-B: the reduced matrix is singular, the Cauchy point is kept\n";
+            return;
+         }
+         reduced_matrix.solve(this->reduced_projection.data());
+      }
+      // Newton step on the free variables and largest step length in [0, 1] that keeps the direction in the box
+      double step_length = 1.;
+      for (size_t variable_index: Range(this->number_variables)) {
+         if (this->is_free[variable_index]) {
+            double component = -this->residual[variable_index] / this->scaling;
+            if (0 < number_pairs) {
+               this->compute_low_rank_row(variable_index, this->low_rank_row);
+               component -= dot(this->low_rank_row, this->reduced_projection, dimension) / (this->scaling * this->scaling);
+            }
+            this->path_direction[variable_index] = component;
+            if (0. < component) {
+               step_length = std::min(step_length, (this->direction_upper_bounds[variable_index] - primal_direction[variable_index]) / component);
+            }
+            else if (component < 0.) {
+               step_length = std::min(step_length, (this->direction_lower_bounds[variable_index] - primal_direction[variable_index]) / component);
+            }
+         }
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         if (this->is_free[variable_index]) {
+            primal_direction[variable_index] += step_length * this->path_direction[variable_index];
+         }
+      }
+   }
+
+   // the bound multipliers are the components of the model gradient r = g + B d at the active bounds
+   void LBFGSBSubproblem::set_multipliers(const Vector<double>& primal_direction, Multipliers& direction_multipliers) const {
+      direction_multipliers.reset();
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double residual_component = this->residual[variable_index];
+         if (primal_direction[variable_index] <= this->direction_lower_bounds[variable_index] && 0. < residual_component) {
+            direction_multipliers.lower_bounds[variable_index] = residual_component;
+         }
+         else if (this->direction_upper_bounds[variable_index] <= primal_direction[variable_index] && residual_component < 0.) {
+            direction_multipliers.upper_bounds[variable_index] = residual_component;
+         }
+      }
+   }
+} // namespace
@@ -0,0 +1,93 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_LBFGSBSUBPROBLEM_H
+#define UNO_LBFGSBSUBPROBLEM_H
+
+#include <utility>
+#include <vector>
+#include "InequalityConstrainedMethod.hpp"
+#include "linear_algebra/DenseLDLT.hpp"
+#include "linear_algebra/SparseVector.hpp"
+
+namespace uno {
+   /*! \class LBFGSBSubproblem
+    * \brief Projected quasi-Newton subproblem (L-BFGS-B) for problems without general constraints
+    *
+    *  The quadratic model g^T d + 1/2 d^T B d uses a limited-memory BFGS approximation B = delta I - W M^{-1} W^T in compact form,
+    *  with W = [delta S, Y] and M = [delta S^T S, L; L^T, -D] (Byrd, Lu, Nocedal and Zhu, 1995). The pairs (s, y) are formed from
+    *  the successive iterates and objective gradients. The model is minimized over the box defined by the variable bounds and the
+    *  (infinity-norm) trust region: the generalized Cauchy point is the first local minimizer along the projected gradient path,
+    *  then the model is minimized over the variables that are free at the Cauchy point (Sherman-Morrison-Woodbury formula), and
+    *  the step is truncated at the box. No matrix is factorized, apart from small matrices of size 2 LBFGS_memory_size; the memory
+    *  is O(n LBFGS_memory_size)
+    */
+   class LBFGSBSubproblem : public InequalityConstrainedMethod {
+   public:
+      LBFGSBSubproblem(size_t number_variables, const Options& options);
+
+      void generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) override;
+      void solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
+            Direction& direction, WarmstartInformation& warmstart_information) override;
+      [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      void report_memory(MemoryReport& report) const override;
+
+      [[nodiscard]] size_t number_stored_pairs() const { return this->number_pairs; }
+
+   protected:
+      const size_t memory_size;
+      size_t number_variables{0}; // number of variables of the current problem
+      SparseVector<double> objective_gradient;
+      Vector<double> gradient;
+
+      // pairs (s, y) in a circular buffer: the i-th pair (0: oldest) is stored at (first_pair + i) % memory_size
+      std::vector<Vector<double>> s_vectors;
+      std::vector<Vector<double>> y_vectors;
+      size_t first_pair{0};
+      size_t number_pairs{0};
+      double scaling{1.}; /*!< delta = y^T y / s^T y of the most recent pair */
+      // products s_i^T s_j and s_i^T y_j (storage indices)
+      std::vector<double> ss_products;
+      std::vector<double> sy_products;
+      // middle matrices M and reduced matrices M - 1/delta W_F^T W_F, indexed by the number of pairs - 1
+      std::vector<DenseLDLT<double>> middle_matrices{};
+      std::vector<DenseLDLT<double>> reduced_matrices{};
+
+      // previous iterate and gradient, from which the next pair is formed
+      const OptimizationProblem* previous_problem{nullptr};
+      double previous_objective_multiplier{0.};
+      Vector<double> previous_primals;
+      Vector<double> previous_gradient;
+
+      // workspaces
+      Vector<double> path_direction;
+      std::vector<std::pair<double, size_t>> breakpoints{};
+      std::vector<bool> is_free{};
+      Vector<double> residual;
+      std::vector<double> low_rank_row{};
+      std::vector<double> path_projection{};
+      std::vector<double> point_projection{};
+      std::vector<double> reduced_projection{};
+      mutable std::vector<double> product_projection{};
+      mutable Vector<double> hessian_product;
+
+      void update_pairs(const OptimizationProblem& problem, const Iterate& current_iterate);
+      void add_pair(const Vector<double>& s, const Vector<double>& y);
+      void factorize_middle_matrix();
+      void assemble_middle_matrix(DenseLDLT<double>& matrix) const;
+      [[nodiscard]] size_t storage_index(size_t pair_index) const { return (this->first_pair + pair_index) % this->memory_size; }
+      // row of W = [delta S, Y] associated with a variable
+      void compute_low_rank_row(size_t variable_index, std::vector<double>& row) const;
+      // W^T v
+      void compute_low_rank_projection(const Vector<double>& vector, std::vector<double>& projection) const;
+      // solves M z = rhs in place
+      void solve_middle_system(std::vector<double>& rhs) const;
+      // B v
+      void compute_product(const Vector<double>& vector, Vector<double>& result) const;
+      [[nodiscard]] bool compute_cauchy_point(Vector<double>& primal_direction);
+      void minimize_subspace(Vector<double>& primal_direction);
+      void set_multipliers(const Vector<double>& primal_direction, Multipliers& direction_multipliers) const;
+   };
+} // namespace
+
+#endif // UNO_LBFGSBSUBPROBLEM_H
@@ -8,6 +8,7 @@
 #include "ingredients/subproblem_solvers/LPSolver.hpp"
 #include "ingredients/subproblem_solvers/LPSolverFactory.hpp"
 #include "options/Options.hpp"
+#include "tools/Metrics.hpp"
 
 namespace uno {
    LPSubproblem::LPSubproblem(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
@@ -19,14 +20,16 @@ namespace uno {
 
    LPSubproblem::~LPSubproblem() { }
 
-   void LPSubproblem::generate_initial_iterate(const OptimizationProblem& /*problem*/, Iterate& /*initial_iterate*/) {
+   void LPSubproblem::generate_initial_iterate(Statistics& /*statistics*/, const OptimizationProblem& /*problem*/, Iterate& /*initial_iterate*/) {
    }
 
    void LPSubproblem::solve(Statistics& /*statistics*/, const OptimizationProblem& problem, Iterate& current_iterate,
          const Multipliers& current_multipliers, Direction& direction, WarmstartInformation& warmstart_information) {
+      this->check_solved_problem(problem, warmstart_information);
       this->solver->solve_LP(problem, current_iterate, this->initial_point, direction, this->trust_region_radius, warmstart_information);
       InequalityConstrainedMethod::compute_dual_displacements(current_multipliers, direction.multipliers);
       this->number_subproblems_solved++;
+      metrics::increment(Metric::LP_SUBPROBLEMS);
       // reset the initial point
       this->initial_point.fill(0.);
    }
@@ -34,4 +37,17 @@ namespace uno {
    double LPSubproblem::hessian_quadratic_product(const Vector<double>& /*primal_direction*/) const {
       return 0.;
    }
+
+   size_t LPSubproblem::get_peak_workspace_size() const {
+      return this->solver->get_peak_workspace_size();
+   }
+
+   FactorizationStatistics LPSubproblem::get_factorization_statistics() const {
+      return this->solver->get_factorization_statistics();
+   }
+
+   void LPSubproblem::report_memory(MemoryReport& report) const {
+      InequalityConstrainedMethod::report_memory(report);
+      this->solver->report_memory(report);
+   }
 } // namespace
\ No newline at end of file
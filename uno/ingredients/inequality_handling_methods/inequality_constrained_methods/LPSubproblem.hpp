@@ -17,10 +17,13 @@ namespace uno {
             const Options& options);
       ~LPSubproblem();
 
-      void generate_initial_iterate(const OptimizationProblem& problem, Iterate& initial_iterate) override;
+      void generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) override;
       void solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,  const Multipliers& current_multipliers,
             Direction& direction, WarmstartInformation& warmstart_information) override;
       [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      [[nodiscard]] size_t get_peak_workspace_size() const override;
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const override;
+      void report_memory(MemoryReport& report) const override;
 
    private:
       // pointer to allow polymorphism
@@ -11,13 +11,17 @@
 #include "ingredients/subproblem_solvers/QPSolver.hpp"
 #include "ingredients/subproblem_solvers/QPSolverFactory.hpp"
 #include "options/Options.hpp"
+#include "tools/Metrics.hpp"
 #include "tools/Statistics.hpp"
 
 namespace uno {
    QPSubproblem::QPSubproblem(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
          size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options) :
          InequalityConstrainedMethod(options.get_string("hessian_model"), number_variables, number_constraints, number_hessian_nonzeros,
-               options.get_string("globalization_mechanism") != "TR" || options.get_bool("convexify_QP"), options),
+               // HiGHS and the interior-point solver only solve convex QPs
+               options.get_string("globalization_mechanism") == "LS" || options.get_bool("convexify_QP") || options.get_string("QP_solver") == "HiGHS" ||
+               options.get_string("QP_solver") == "InteriorPointQP",
+               options),
          enforce_linear_constraints_at_initial_iterate(options.get_bool("enforce_linear_constraints")),
          // maximum number of Hessian nonzeros = number nonzeros + possible diagonal inertia correction
          solver(QPSolverFactory::create(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros,
@@ -28,18 +32,25 @@ namespace uno {
 
    QPSubproblem::~QPSubproblem() { }
 
-   void QPSubproblem::generate_initial_iterate(const OptimizationProblem& problem, Iterate& initial_iterate) {
+   void QPSubproblem::initialize_statistics(Statistics& statistics, const Options& options) {
+      InequalityConstrainedMethod::initialize_statistics(statistics, options);
+      this->solver->initialize_statistics(statistics, options);
+   }
+
+   void QPSubproblem::generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) {
       if (this->enforce_linear_constraints_at_initial_iterate) {
-         Preprocessing::enforce_linear_constraints(problem.model, initial_iterate.primals, initial_iterate.multipliers, *this->solver);
+         Preprocessing::enforce_linear_constraints(statistics, problem.model, initial_iterate, *this->solver);
       }
    }
 
    void QPSubproblem::solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,  const Multipliers& current_multipliers,
          Direction& direction, WarmstartInformation& warmstart_information) {
+      this->check_solved_problem(problem, warmstart_information);
       this->solver->solve_QP(statistics, problem, current_iterate, current_multipliers.constraints, this->initial_point, direction,
             *this->hessian_model, this->trust_region_radius, warmstart_information);
       InequalityConstrainedMethod::compute_dual_displacements(current_multipliers, direction.multipliers);
       this->number_subproblems_solved++;
+      metrics::increment(Metric::QP_SUBPROBLEMS);
       // reset the initial point
       this->initial_point.fill(0.);
    }
@@ -47,4 +58,17 @@ namespace uno {
    double QPSubproblem::hessian_quadratic_product(const Vector<double>& primal_direction) const {
       return this->solver->hessian_quadratic_product(primal_direction);
    }
+
+   size_t QPSubproblem::get_peak_workspace_size() const {
+      return this->solver->get_peak_workspace_size();
+   }
+
+   FactorizationStatistics QPSubproblem::get_factorization_statistics() const {
+      return this->solver->get_factorization_statistics();
+   }
+
+   void QPSubproblem::report_memory(MemoryReport& report) const {
+      InequalityConstrainedMethod::report_memory(report);
+      this->solver->report_memory(report);
+   }
 } // namespace
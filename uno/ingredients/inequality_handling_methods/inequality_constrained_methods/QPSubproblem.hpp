@@ -11,16 +11,20 @@ namespace uno {
    // forward reference
    class QPSolver;
 
-   class QPSubproblem : public InequalityConstrainedMethod {
+   class QPSubproblem final : public InequalityConstrainedMethod {
    public:
       QPSubproblem(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros, size_t number_jacobian_nonzeros,
             size_t number_hessian_nonzeros, const Options& options);
       ~QPSubproblem();
 
-      void generate_initial_iterate(const OptimizationProblem& problem, Iterate& initial_iterate) override;
+      void initialize_statistics(Statistics& statistics, const Options& options) override;
+      void generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) override;
       void solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,  const Multipliers& current_multipliers,
             Direction& direction, WarmstartInformation& warmstart_information) override;
       [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      [[nodiscard]] size_t get_peak_workspace_size() const override;
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const override;
+      void report_memory(MemoryReport& report) const override;
 
    protected:
       const bool enforce_linear_constraints_at_initial_iterate;
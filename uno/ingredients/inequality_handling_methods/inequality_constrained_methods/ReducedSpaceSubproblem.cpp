@@ -0,0 +1,554 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "ReducedSpaceSubproblem.hpp"
+#include "ingredients/constraint_relaxation_strategies/l1RelaxedProblem.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+#include "tools/MemoryReport.hpp"
+
+namespace uno {
+   namespace {
+      // a variable is at a bound if its distance to the bound is below this (relative) tolerance
+      constexpr double bound_tolerance = 1e-10;
+
+      bool is_at_bound(double distance, double value) {
+         return distance <= bound_tolerance * (1. + std::abs(value));
+      }
+   } // namespace
+
+   ReducedSpaceSubproblem::ReducedSpaceSubproblem(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros,
+         const Options& options):
+         // the curvature is approximated by the reduced BFGS matrix: the Hessian of the problem is not evaluated
+         InequalityConstrainedMethod("zero", number_variables, number_constraints, 0, false, options),
+         pivot_tolerance(options.get_double("reduced_space_pivot_tolerance")),
+         objective_gradient(number_variables),
+         gradient(number_variables),
+         constraints(number_constraints),
+         column_starts(number_variables + 1),
+         bound_distances(number_variables),
+         basis_positions(number_variables, SparseLU<double>::none),
+         is_excluded(number_variables),
+         basis_factorization(number_constraints),
+         multipliers(number_constraints),
+         reduced_gradient(number_variables),
+         free_hessian(0),
+         is_free(number_variables),
+         previous_primals(number_variables),
+         previous_reduced_gradient(number_variables),
+         row_workspace(number_constraints),
+         step_workspace(number_constraints),
+         nonbasic_direction(number_variables),
+         elastic_shift(number_variables),
+         hessian_product(number_variables) {
+      if (this->pivot_tolerance <= 0. || 1. <= this->pivot_tolerance) {
+         throw std::invalid_argument("The reduced-space pivot tolerance should be in (0, 1)");
+      }
+      this->column_rows.reserve(number_jacobian_nonzeros);
+      this->column_values.reserve(number_jacobian_nonzeros);
+      this->candidate_columns.reserve(number_variables);
+      this->nonbasic_variables.reserve(number_variables);
+      this->previous_nonbasic_variables.reserve(number_variables);
+      this->free_variables.reserve(number_variables);
+   }
+
+   void ReducedSpaceSubproblem::generate_initial_iterate(Statistics& /*statistics*/, const OptimizationProblem& /*problem*/,
+         Iterate& /*initial_iterate*/) {
+   }
+
+   void ReducedSpaceSubproblem::solve(Statistics& /*statistics*/, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers, Direction& direction, WarmstartInformation& /*warmstart_information*/) {
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         if (problem.constraint_lower_bound(constraint_index) != problem.constraint_upper_bound(constraint_index)) {
+            throw std::runtime_error("The reduced-space subproblem only handles equality constraints");
+         }
+      }
+      this->number_variables = problem.number_variables;
+      this->number_constraints = problem.number_constraints;
+      this->evaluate_functions(problem, current_iterate);
+      this->assemble_jacobian_columns();
+      this->compute_elastic_shift(problem, current_iterate);
+      Vector<double>& primal_direction = direction.primals;
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->is_excluded[variable_index] = false;
+      }
+      // a basic variable at a bound whose step points outwards blocks the step: it is excluded from the basis and the basis is refactorized
+      for (size_t number_exchanges: Range(ReducedSpaceSubproblem::maximum_number_exchanges + 1)) {
+         if (!this->select_and_factorize_basis(problem, current_iterate)) {
+            DEBUG << "Reduced space: the Jacobian is rank deficient (rank " << this->basis_factorization.rank() << " < " <<
+               this->number_constraints << ")\n";
+            // the linearized constraints may be inconsistent
+            direction.status = SubproblemStatus::INFEASIBLE;
+            this->previous_problem = nullptr;
+            return;
+         }
+         this->compute_reduced_gradient();
+         this->update_reduced_hessian(problem, current_iterate);
+         this->compute_nonbasic_direction(problem, current_iterate);
+         this->compute_basic_direction(primal_direction);
+         const size_t blocking_variable = this->find_blocking_basic_variable(problem, current_iterate, primal_direction);
+         if (blocking_variable == SparseLU<double>::none || number_exchanges == ReducedSpaceSubproblem::maximum_number_exchanges) {
+            break;
+         }
+         DEBUG << "Reduced space: the basic variable " << blocking_variable << " blocks the step and leaves the basis\n";
+         this->is_excluded[blocking_variable] = true;
+      }
+      this->truncate_direction(problem, current_iterate, primal_direction);
+      for (size_t variable_index: Range(this->number_variables)) {
+         primal_direction[variable_index] += this->elastic_shift[variable_index];
+      }
+      DEBUG << "Reduced space: " << this->number_variables - this->number_constraints << " nonbasic variables, " <<
+         this->free_variables.size() << " free\n";
+
+      direction.subproblem_objective = 0.5 * this->hessian_quadratic_product(primal_direction);
+      for (size_t variable_index: Range(this->number_variables)) {
+         direction.subproblem_objective += this->gradient[variable_index] * primal_direction[variable_index];
+      }
+      this->set_multipliers(problem, direction.multipliers);
+      InequalityConstrainedMethod::compute_dual_displacements(current_multipliers, direction.multipliers);
+      direction.status = SubproblemStatus::OPTIMAL;
+      this->number_subproblems_solved++;
+   }
+
+   // the elastic variables absorb the violation of the constraints c(x) - p + n = 0: they are basic candidates and the multipliers
+   // of the basis reflect the l1 norm of the violation
+   void ReducedSpaceSubproblem::set_elastic_variable_values(const l1RelaxedProblem& problem, Iterate& current_iterate) {
+      current_iterate.evaluate_constraints(problem.model);
+      problem.set_elastic_variable_values(current_iterate, [&](Iterate& iterate, size_t constraint_index, size_t elastic_index,
+            double jacobian_coefficient) {
+         const double residual = iterate.evaluations.constraints[constraint_index] - problem.model.constraint_lower_bound(constraint_index);
+         iterate.primals[elastic_index] = std::max(0., -jacobian_coefficient * residual);
+         iterate.feasibility_multipliers.lower_bounds[elastic_index] = (iterate.primals[elastic_index] == 0.) ? 1. : 0.;
+         iterate.feasibility_multipliers.upper_bounds[elastic_index] = 0.;
+      });
+   }
+
+   double ReducedSpaceSubproblem::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      if (this->previous_problem == nullptr) {
+         return 0.;
+      }
+      const size_t dimension = this->number_quasi_newton_variables;
+      double product = 0.;
+      for (size_t column: Range(dimension)) {
+         const double column_value = primal_direction[this->nonbasic_variables[column]];
+         if (column_value != 0.) {
+            double column_product = 0.;
+            for (size_t row: Range(dimension)) {
+               column_product += this->reduced_hessian[column * dimension + row] * primal_direction[this->nonbasic_variables[row]];
+            }
+            product += column_value * column_product;
+         }
+      }
+      for (size_t position: Range(dimension, this->nonbasic_variables.size())) {
+         const double value = primal_direction[this->nonbasic_variables[position]];
+         product += this->diagonal_scaling * value * value;
+      }
+      return product;
+   }
+
+   FactorizationStatistics ReducedSpaceSubproblem::get_factorization_statistics() const {
+      return this->factorization_statistics;
+   }
+
+   void ReducedSpaceSubproblem::report_memory(MemoryReport& report) const {
+      InequalityConstrainedMethod::report_memory(report);
+      report.add("subproblem/basis factorization", this->basis_factorization.memory_size());
+      report.add("subproblem/Jacobian columns", MemoryReport::memory_size(this->column_starts) + MemoryReport::memory_size(this->column_rows) +
+            MemoryReport::memory_size(this->column_values));
+      report.add("subproblem/reduced Hessian", MemoryReport::memory_size(this->reduced_hessian) + this->free_hessian.memory_size() +
+            MemoryReport::memory_size(this->s_vector) + MemoryReport::memory_size(this->y_vector));
+      report.add("subproblem/objective gradient", this->objective_gradient.memory_size());
+      report.add("subproblem/reduced-space vectors", this->gradient.memory_size() + MemoryReport::memory_size(this->constraints) +
+            MemoryReport::memory_size(this->candidate_columns) + MemoryReport::memory_size(this->bound_distances) +
+            MemoryReport::memory_size(this->basis_positions) + MemoryReport::memory_size(this->nonbasic_variables) +
+            MemoryReport::memory_size(this->previous_nonbasic_variables) + MemoryReport::memory_size(this->free_variables) +
+            this->multipliers.memory_size() + this->reduced_gradient.memory_size() + this->previous_primals.memory_size() +
+            this->previous_reduced_gradient.memory_size() + this->row_workspace.memory_size() + this->step_workspace.memory_size() +
+            this->nonbasic_direction.memory_size() + this->elastic_shift.memory_size() + this->hessian_product.memory_size() + (this->is_free.capacity() + this->is_excluded.capacity()) / 8);
+   }
+
+   void ReducedSpaceSubproblem::evaluate_functions(const OptimizationProblem& problem, Iterate& current_iterate) {
+      problem.evaluate_objective_gradient(current_iterate, this->objective_gradient);
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->gradient[variable_index] = 0.;
+      }
+      for (const auto [variable_index, derivative]: this->objective_gradient) {
+         this->gradient[variable_index] += derivative;
+      }
+      // residuals of the equality constraints
+      problem.evaluate_constraints(current_iterate, this->constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->constraints[constraint_index] -= problem.constraint_lower_bound(constraint_index);
+      }
+      // the view is rebound at no cost: the Jacobian is not copied
+      problem.evaluate_constraint_jacobian(current_iterate, this->constraint_jacobian);
+   }
+
+   // in an l1-relaxed problem, the elastic variables are shifted to the values that absorb the violation of the linearized constraints
+   // at the current point, c(x) - (p + shift_p) + (n + shift_n) = 0. The range-space step then vanishes and the basis only generates
+   // the null-space step. The shift is part of the direction
+   void ReducedSpaceSubproblem::compute_elastic_shift(const OptimizationProblem& problem, Iterate& current_iterate) {
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->elastic_shift[variable_index] = 0.;
+      }
+      if (const auto* relaxed_problem = dynamic_cast<const l1RelaxedProblem*>(&problem)) {
+         relaxed_problem->set_elastic_variable_values(current_iterate, [&](Iterate& iterate, size_t constraint_index, size_t elastic_index,
+               double jacobian_coefficient) {
+            // residual of the model constraint (without the elastic variables)
+            const double residual = this->constraints[constraint_index] - jacobian_coefficient * iterate.primals[elastic_index];
+            const double shifted_value = std::max(0., -jacobian_coefficient * residual);
+            this->elastic_shift[elastic_index] = shifted_value - iterate.primals[elastic_index];
+         });
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
+               this->constraints[constraint_index] += derivative * this->elastic_shift[variable_index];
+            }
+         }
+      }
+   }
+
+   // the rows of the Jacobian are transposed into columns (counting sort)
+   void ReducedSpaceSubproblem::assemble_jacobian_columns() {
+      const size_t n = this->number_variables;
+      std::fill(this->column_starts.begin(), this->column_starts.begin() + static_cast<std::ptrdiff_t>(n + 1), 0);
+      size_t number_nonzeros = 0;
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
+            this->column_starts[variable_index + 1]++;
+            number_nonzeros++;
+         }
+      }
+      for (size_t variable_index: Range(n)) {
+         this->column_starts[variable_index + 1] += this->column_starts[variable_index];
+      }
+      this->column_rows.resize(number_nonzeros);
+      this->column_values.resize(number_nonzeros);
+      // column_starts[i] is the next free position of column i, then the start of column i + 1
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
+            const size_t position = this->column_starts[variable_index]++;
+            this->column_rows[position] = constraint_index;
+            this->column_values[position] = derivative;
+         }
+      }
+      for (size_t variable_index = n; 0 < variable_index; variable_index--) {
+         this->column_starts[variable_index] = this->column_starts[variable_index - 1];
+      }
+      this->column_starts[0] = 0;
+   }
+
+   // the columns of the previous basis whose variables are not at a bound are tried first, then the variables by decreasing distance to
+   // their bounds (free variables first)
+   bool ReducedSpaceSubproblem::select_and_factorize_basis(const OptimizationProblem& problem, const Iterate& current_iterate) {
+      const size_t n = this->number_variables;
+      for (size_t variable_index: Range(n)) {
+         const double value = this->shifted_primal(current_iterate, variable_index);
+         this->bound_distances[variable_index] = std::min(value - problem.variable_lower_bound(variable_index),
+            problem.variable_upper_bound(variable_index) - value);
+         // marker of the candidate columns
+         this->is_free[variable_index] = this->is_excluded[variable_index];
+      }
+      this->candidate_columns.clear();
+      for (const size_t variable_index: this->basis_factorization.get_basic_columns()) {
+         if (variable_index < n && !this->is_excluded[variable_index] &&
+               !is_at_bound(this->bound_distances[variable_index], this->shifted_primal(current_iterate, variable_index))) {
+            this->candidate_columns.emplace_back(variable_index);
+            this->is_free[variable_index] = true;
+         }
+      }
+      const size_t number_previous_columns = this->candidate_columns.size();
+      for (size_t variable_index: Range(n)) {
+         if (!this->is_free[variable_index]) {
+            this->candidate_columns.emplace_back(variable_index);
+         }
+      }
+      std::stable_sort(this->candidate_columns.begin() + static_cast<std::ptrdiff_t>(number_previous_columns), this->candidate_columns.end(),
+         [&](size_t first_index, size_t second_index) {
+            return this->bound_distances[second_index] < this->bound_distances[first_index];
+         });
+
+      const size_t number_matrix_nonzeros = this->column_rows.size();
+      this->factorization_statistics.record_analysis(number_matrix_nonzeros, number_matrix_nonzeros);
+      const size_t rank = this->basis_factorization.factorize(this->number_constraints, this->column_starts, this->column_rows,
+         this->column_values, this->candidate_columns, this->pivot_tolerance);
+      this->factorization_statistics.record_factorization(this->basis_factorization.number_factor_nonzeros(),
+         this->basis_factorization.flops(), this->basis_factorization.memory_size(), 0, 0, 0);
+      this->number_factorizations++;
+      if (rank < this->number_constraints) {
+         return false;
+      }
+
+      // partition: the nonbasic original variables come first
+      std::fill(this->basis_positions.begin(), this->basis_positions.begin() + static_cast<std::ptrdiff_t>(n), SparseLU<double>::none);
+      const std::vector<size_t>& basic_variables = this->basis_factorization.get_basic_columns();
+      for (size_t step: Range(basic_variables.size())) {
+         this->basis_positions[basic_variables[step]] = step;
+      }
+      this->nonbasic_variables.clear();
+      const size_t number_original_variables = problem.get_number_original_variables();
+      for (size_t variable_index: Range(n)) {
+         if (this->basis_positions[variable_index] == SparseLU<double>::none && variable_index < number_original_variables) {
+            this->nonbasic_variables.emplace_back(variable_index);
+         }
+      }
+      this->number_quasi_newton_variables = this->nonbasic_variables.size();
+      for (size_t variable_index: Range(number_original_variables, n)) {
+         if (this->basis_positions[variable_index] == SparseLU<double>::none) {
+            this->nonbasic_variables.emplace_back(variable_index);
+         }
+      }
+      return true;
+   }
+
+   // B^T lambda = g_B, then z = g_N - N^T lambda
+   void ReducedSpaceSubproblem::compute_reduced_gradient() {
+      const std::vector<size_t>& basic_variables = this->basis_factorization.get_basic_columns();
+      for (size_t step: Range(this->number_constraints)) {
+         this->step_workspace[step] = this->gradient[basic_variables[step]];
+      }
+      this->basis_factorization.solve_transpose(this->step_workspace.data(), this->multipliers.data());
+      for (const size_t variable_index: this->nonbasic_variables) {
+         double reduced_derivative = this->gradient[variable_index];
+         for (size_t position: Range(this->column_starts[variable_index], this->column_starts[variable_index + 1])) {
+            reduced_derivative -= this->column_values[position] * this->multipliers[this->column_rows[position]];
+         }
+         this->reduced_gradient[variable_index] = reduced_derivative;
+      }
+   }
+
+   // damped BFGS update (Powell) of the reduced Hessian with s = x_N - previous x_N and y = z - previous z. The matrix is reset when
+   // the problem, its objective multiplier, its definition or the partition change, since the pairs then describe another function
+   void ReducedSpaceSubproblem::update_reduced_hessian(const OptimizationProblem& problem, const Iterate& current_iterate) {
+      const size_t dimension = this->number_quasi_newton_variables;
+      const bool same_partition = (this->previous_problem == &problem && this->previous_objective_multiplier == problem.get_objective_multiplier() &&
+            !this->subproblem_definition_changed && this->nonbasic_variables == this->previous_nonbasic_variables);
+      if (!same_partition) {
+         this->reduced_hessian.assign(dimension * dimension, 0.);
+         for (size_t index: Range(dimension)) {
+            this->reduced_hessian[index * dimension + index] = 1.;
+         }
+         this->diagonal_scaling = 1.;
+         this->has_curvature_pair = false;
+      }
+      else if (0 < dimension) {
+         this->s_vector.resize(dimension);
+         this->y_vector.resize(dimension);
+         double ss = 0.;
+         double sy = 0.;
+         double yy = 0.;
+         for (size_t position: Range(dimension)) {
+            const size_t variable_index = this->nonbasic_variables[position];
+            this->s_vector[position] = current_iterate.primals[variable_index] - this->previous_primals[variable_index];
+            this->y_vector[position] = this->reduced_gradient[variable_index] - this->previous_reduced_gradient[variable_index];
+            ss += this->s_vector[position] * this->s_vector[position];
+            sy += this->s_vector[position] * this->y_vector[position];
+            yy += this->y_vector[position] * this->y_vector[position];
+         }
+         if (0. < ss) {
+            // initial scaling y^T y / s^T y of the identity (Nocedal and Wright, 2006, eq. 6.20)
+            if (!this->has_curvature_pair && 0. < sy) {
+               this->diagonal_scaling = yy / sy;
+               for (size_t index: Range(dimension)) {
+                  this->reduced_hessian[index * dimension + index] = this->diagonal_scaling;
+               }
+            }
+            this->compute_reduced_product(this->s_vector.data(), this->hessian_product.data());
+            double sHs = 0.;
+            for (size_t position: Range(dimension)) {
+               sHs += this->s_vector[position] * this->hessian_product[position];
+            }
+            // damping: y is moved towards H s so that s^T y >= 0.2 s^T H s
+            if (sy < 0.2 * sHs) {
+               const double theta = 0.8 * sHs / (sHs - sy);
+               sy = 0.;
+               for (size_t position: Range(dimension)) {
+                  this->y_vector[position] = theta * this->y_vector[position] + (1. - theta) * this->hessian_product[position];
+                  sy += this->s_vector[position] * this->y_vector[position];
+               }
+            }
+            if (0. < sHs && 0. < sy) {
+               for (size_t column: Range(dimension)) {
+                  for (size_t row: Range(dimension)) {
+                     this->reduced_hessian[column * dimension + row] += this->y_vector[row] * this->y_vector[column] / sy -
+                        this->hessian_product[row] * this->hessian_product[column] / sHs;
+                  }
+               }
+               this->has_curvature_pair = true;
+            }
+         }
+      }
+      this->previous_problem = &problem;
+      this->previous_objective_multiplier = problem.get_objective_multiplier();
+      this->previous_nonbasic_variables = this->nonbasic_variables;
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->previous_primals[variable_index] = current_iterate.primals[variable_index];
+         this->previous_reduced_gradient[variable_index] = this->reduced_gradient[variable_index];
+      }
+   }
+
+   // the nonbasic variables at a bound whose reduced derivative points outwards are blocked. The reduced model is minimized over the
+   // free nonbasic variables, then the step is projected onto the bounds and the trust region
+   void ReducedSpaceSubproblem::compute_nonbasic_direction(const OptimizationProblem& problem, const Iterate& current_iterate) {
+      this->free_variables.clear();
+      for (size_t position: Range(this->nonbasic_variables.size())) {
+         const size_t variable_index = this->nonbasic_variables[position];
+         const double value = this->shifted_primal(current_iterate, variable_index);
+         const double lower_bound = problem.variable_lower_bound(variable_index);
+         const double upper_bound = problem.variable_upper_bound(variable_index);
+         const double reduced_derivative = this->reduced_gradient[variable_index];
+         const bool is_blocked = (lower_bound == upper_bound) ||
+            (is_at_bound(value - lower_bound, value) && 0. <= reduced_derivative) ||
+            (is_at_bound(upper_bound - value, value) && reduced_derivative <= 0.);
+         this->is_free[variable_index] = !is_blocked;
+         this->nonbasic_direction[variable_index] = 0.;
+         if (!is_blocked) {
+            this->free_variables.emplace_back(position);
+         }
+      }
+
+      // H_FF d_F = -z_F
+      const size_t dimension = this->number_quasi_newton_variables;
+      const size_t number_free_variables = this->free_variables.size();
+      this->free_hessian.resize(number_free_variables);
+      for (size_t column: Range(number_free_variables)) {
+         const size_t column_position = this->free_variables[column];
+         for (size_t row: Range(column, number_free_variables)) {
+            const size_t row_position = this->free_variables[row];
+            if (row_position < dimension && column_position < dimension) {
+               this->free_hessian.entry(row, column) = this->reduced_hessian[column_position * dimension + row_position];
+            }
+            else {
+               this->free_hessian.entry(row, column) = (row == column) ? this->diagonal_scaling : 0.;
+            }
+         }
+         this->hessian_product[column] = -this->reduced_gradient[this->nonbasic_variables[column_position]];
+      }
+      if (this->free_hessian.factorize(1e-14)) {
+         this->free_hessian.solve(this->hessian_product.data());
+      }
+      else {
+         // steepest descent
+         WARNING << "Reduced space: the reduced Hessian is not positive definite\n";
+         for (size_t column: Range(number_free_variables)) {
+            this->hessian_product[column] /= this->diagonal_scaling;
+         }
+      }
+
+      const size_t number_original_variables = problem.get_number_original_variables();
+      for (size_t column: Range(number_free_variables)) {
+         const size_t variable_index = this->nonbasic_variables[this->free_variables[column]];
+         const double value = this->shifted_primal(current_iterate, variable_index);
+         double lower_bound = problem.variable_lower_bound(variable_index) - value;
+         double upper_bound = problem.variable_upper_bound(variable_index) - value;
+         if (variable_index < number_original_variables) {
+            lower_bound = std::max(lower_bound, -this->trust_region_radius);
+            upper_bound = std::min(upper_bound, this->trust_region_radius);
+         }
+         this->nonbasic_direction[variable_index] = std::min(std::max(this->hessian_product[column], lower_bound), upper_bound);
+      }
+   }
+
+   // B d_B = -c - N d_N, where c are the residuals at the shifted point
+   void ReducedSpaceSubproblem::compute_basic_direction(Vector<double>& primal_direction) {
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->row_workspace[constraint_index] = -this->constraints[constraint_index];
+      }
+      for (const size_t variable_index: this->nonbasic_variables) {
+         const double step = this->nonbasic_direction[variable_index];
+         primal_direction[variable_index] = step;
+         if (step != 0.) {
+            for (size_t position: Range(this->column_starts[variable_index], this->column_starts[variable_index + 1])) {
+               this->row_workspace[this->column_rows[position]] -= this->column_values[position] * step;
+            }
+         }
+      }
+      this->basis_factorization.solve(this->row_workspace.data(), this->step_workspace.data());
+      const std::vector<size_t>& basic_variables = this->basis_factorization.get_basic_columns();
+      for (size_t step: Range(this->number_constraints)) {
+         primal_direction[basic_variables[step]] = this->step_workspace[step];
+      }
+   }
+
+   size_t ReducedSpaceSubproblem::find_blocking_basic_variable(const OptimizationProblem& problem, const Iterate& current_iterate,
+         const Vector<double>& primal_direction) const {
+      for (const size_t variable_index: this->basis_factorization.get_basic_columns()) {
+         const double step = primal_direction[variable_index];
+         const double value = this->shifted_primal(current_iterate, variable_index);
+         if ((step < 0. && is_at_bound(value - problem.variable_lower_bound(variable_index), value)) ||
+               (0. < step && is_at_bound(problem.variable_upper_bound(variable_index) - value, value))) {
+            return variable_index;
+         }
+      }
+      return SparseLU<double>::none;
+   }
+
+   // the whole step is scaled so that the basic variables remain within their bounds and the trust region
+   void ReducedSpaceSubproblem::truncate_direction(const OptimizationProblem& problem, const Iterate& current_iterate,
+         Vector<double>& primal_direction) const {
+      const size_t number_original_variables = problem.get_number_original_variables();
+      double step_length = 1.;
+      for (const size_t variable_index: this->basis_factorization.get_basic_columns()) {
+         const double step = primal_direction[variable_index];
+         const double value = this->shifted_primal(current_iterate, variable_index);
+         if (step < 0.) {
+            step_length = std::min(step_length, std::max(0., (problem.variable_lower_bound(variable_index) - value) / step));
+         }
+         else if (0. < step) {
+            step_length = std::min(step_length, std::max(0., (problem.variable_upper_bound(variable_index) - value) / step));
+         }
+         if (variable_index < number_original_variables && this->trust_region_radius < std::abs(step)) {
+            step_length = std::min(step_length, this->trust_region_radius / std::abs(step));
+         }
+      }
+      if (step_length < 1.) {
+         DEBUG << "Reduced space: the step is truncated by a factor " << step_length << '\n';
+         for (size_t variable_index: Range(this->number_variables)) {
+            primal_direction[variable_index] *= step_length;
+         }
+      }
+   }
+
+   // lambda estimates the constraint multipliers. The multipliers of the blocked nonbasic variables are their reduced derivatives
+   void ReducedSpaceSubproblem::set_multipliers(const OptimizationProblem& problem, Multipliers& direction_multipliers) const {
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         direction_multipliers.constraints[constraint_index] = this->multipliers[constraint_index];
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         direction_multipliers.lower_bounds[variable_index] = 0.;
+         direction_multipliers.upper_bounds[variable_index] = 0.;
+      }
+      for (const size_t variable_index: this->nonbasic_variables) {
+         if (!this->is_free[variable_index]) {
+            const double reduced_derivative = this->reduced_gradient[variable_index];
+            if (0. < reduced_derivative && is_finite(problem.variable_lower_bound(variable_index))) {
+               direction_multipliers.lower_bounds[variable_index] = reduced_derivative;
+            }
+            else if (reduced_derivative < 0. && is_finite(problem.variable_upper_bound(variable_index))) {
+               direction_multipliers.upper_bounds[variable_index] = reduced_derivative;
+            }
+         }
+      }
+   }
+
+   // H v over the positions of the nonbasic variables
+   void ReducedSpaceSubproblem::compute_reduced_product(const double* vector, double* result) const {
+      const size_t dimension = this->number_quasi_newton_variables;
+      for (size_t row: Range(dimension)) {
+         result[row] = 0.;
+      }
+      for (size_t column: Range(dimension)) {
+         if (vector[column] != 0.) {
+            for (size_t row: Range(dimension)) {
+               result[row] += this->reduced_hessian[column * dimension + row] * vector[column];
+            }
+         }
+      }
+   }
+} // namespace
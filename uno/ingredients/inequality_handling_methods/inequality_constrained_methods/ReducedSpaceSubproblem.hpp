@@ -0,0 +1,121 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_REDUCEDSPACESUBPROBLEM_H
+#define UNO_REDUCEDSPACESUBPROBLEM_H
+
+#include <vector>
+#include "InequalityConstrainedMethod.hpp"
+#include "optimization/Iterate.hpp"
+#include "linear_algebra/DenseCholesky.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
+#include "linear_algebra/SparseLU.hpp"
+#include "linear_algebra/SparseVector.hpp"
+
+namespace uno {
+   /*! \class ReducedSpaceSubproblem
+    * \brief Reduced-space (null-space) SQP subproblem for equality-constrained problems with few degrees of freedom
+    *
+    *  The Jacobian J = [B N] of the equality constraints c(x) = 0 is partitioned into a basis B (m columns) and the n - m nonbasic
+    *  columns N. The basis is selected and factorized by a sparse LU (see SparseLU): the columns of the previous basis come first,
+    *  then the variables by decreasing distance to their bounds, so that the basis only changes when a basic variable reaches a
+    *  bound (a basic variable at a bound that blocks the step is excluded and the basis is refactorized). The step is
+    *  d = Y d_Y + Z d_N, with the range-space step B d_B = -c and the null space Z = [-B^-1 N; I]. The nonbasic step minimizes
+    *  the reduced model z^T d_N + 1/2 d_N^T H d_N over the nonbasic variables that are not blocked by their bounds, where z = g_N - N^T lambda is the reduced gradient and B^T lambda = g_B. The reduced Hessian H (dense, of size the number of
+    *  nonbasic original variables) is a damped BFGS approximation updated with the reduced gradients; it is reset when the partition
+    *  changes. No second derivatives are evaluated and the cross term Z^T W Y d_Y is neglected. The nonbasic step is projected onto
+    *  the bounds and the trust region, and the whole step is truncated at the bounds of the basic variables. The bound multipliers
+    *  of the blocked nonbasic variables are the components of the reduced gradient. A rank-deficient Jacobian makes the subproblem
+    *  infeasible (the l1-relaxed problem always has a basis). In the l1-relaxed problem, the elastic variables are first shifted to
+    *  absorb the violation of the linearized constraints
+    */
+   class ReducedSpaceSubproblem : public InequalityConstrainedMethod {
+   public:
+      ReducedSpaceSubproblem(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros, const Options& options);
+
+      void generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) override;
+      void solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
+            Direction& direction, WarmstartInformation& warmstart_information) override;
+      void set_elastic_variable_values(const l1RelaxedProblem& problem, Iterate& current_iterate) override;
+      [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const override;
+      void report_memory(MemoryReport& report) const override;
+
+      [[nodiscard]] const std::vector<size_t>& get_basic_variables() const { return this->basis_factorization.get_basic_columns(); }
+      [[nodiscard]] size_t number_reduced_variables() const { return this->number_quasi_newton_variables; }
+
+   protected:
+      const double pivot_tolerance;
+      size_t number_variables{0}; // dimensions of the current problem
+      size_t number_constraints{0};
+      SparseVector<double> objective_gradient;
+      Vector<double> gradient;
+      std::vector<double> constraints;
+      RectangularMatrixView<double> constraint_jacobian{};
+
+      // Jacobian stored by columns
+      std::vector<size_t> column_starts;
+      std::vector<size_t> column_rows{};
+      std::vector<double> column_values{};
+
+      // partition: position of a variable in the basis (or SparseLU::none), nonbasic variables (original variables first)
+      std::vector<size_t> candidate_columns{};
+      std::vector<double> bound_distances;
+      std::vector<size_t> basis_positions;
+      std::vector<bool> is_excluded; // basic variables that blocked the step at the current iterate
+      std::vector<size_t> nonbasic_variables{};
+      size_t number_quasi_newton_variables{0}; // nonbasic original variables
+      SparseLU<double> basis_factorization;
+      FactorizationStatistics factorization_statistics{};
+
+      // reduced model
+      Vector<double> multipliers;
+      Vector<double> reduced_gradient;
+      std::vector<double> reduced_hessian{}; // dense column-major, of dimension number_quasi_newton_variables
+      double diagonal_scaling{1.}; // curvature of the nonbasic additional (e.g. elastic) variables
+      bool has_curvature_pair{false};
+      std::vector<double> s_vector{};
+      std::vector<double> y_vector{};
+      DenseCholesky<double> free_hessian;
+      std::vector<size_t> free_variables{};
+      std::vector<bool> is_free; // nonbasic variables that are not blocked by their bounds
+
+      // previous iterate and reduced gradient, from which the next pair is formed
+      const OptimizationProblem* previous_problem{nullptr};
+      double previous_objective_multiplier{0.};
+      std::vector<size_t> previous_nonbasic_variables{};
+      Vector<double> previous_primals;
+      Vector<double> previous_reduced_gradient;
+
+      // maximum number of basic variables excluded from the basis at an iterate
+      static constexpr size_t maximum_number_exchanges{10};
+
+      // workspaces
+      Vector<double> row_workspace;
+      Vector<double> step_workspace;
+      Vector<double> nonbasic_direction;
+      Vector<double> elastic_shift;
+      Vector<double> hessian_product;
+
+      void evaluate_functions(const OptimizationProblem& problem, Iterate& current_iterate);
+      void compute_elastic_shift(const OptimizationProblem& problem, Iterate& current_iterate);
+      [[nodiscard]] double shifted_primal(const Iterate& current_iterate, size_t variable_index) const {
+         return current_iterate.primals[variable_index] + this->elastic_shift[variable_index];
+      }
+      void assemble_jacobian_columns();
+      [[nodiscard]] bool select_and_factorize_basis(const OptimizationProblem& problem, const Iterate& current_iterate);
+      void compute_reduced_gradient();
+      void update_reduced_hessian(const OptimizationProblem& problem, const Iterate& current_iterate);
+      void compute_nonbasic_direction(const OptimizationProblem& problem, const Iterate& current_iterate);
+      void compute_basic_direction(Vector<double>& primal_direction);
+      // basic variable at a bound whose step points outwards (SparseLU::none if there is none)
+      [[nodiscard]] size_t find_blocking_basic_variable(const OptimizationProblem& problem, const Iterate& current_iterate,
+            const Vector<double>& primal_direction) const;
+      void truncate_direction(const OptimizationProblem& problem, const Iterate& current_iterate, Vector<double>& primal_direction) const;
+      void set_multipliers(const OptimizationProblem& problem, Multipliers& direction_multipliers) const;
+      // H v over the nonbasic variables
+      void compute_reduced_product(const double* vector, double* result) const;
+   };
+} // namespace
+
+#endif // UNO_REDUCEDSPACESUBPROBLEM_H
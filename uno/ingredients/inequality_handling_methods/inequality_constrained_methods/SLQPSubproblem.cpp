@@ -0,0 +1,350 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include "SLQPSubproblem.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "ingredients/hessian_models/UnstableRegularization.hpp"
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "ingredients/subproblem_solvers/LPSolver.hpp"
+#include "ingredients/subproblem_solvers/LPSolverFactory.hpp"
+#include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+#include "tools/MemoryReport.hpp"
+#include "tools/Metrics.hpp"
+#include "tools/Statistics.hpp"
+
+namespace uno {
+   SLQPSubproblem::SLQPSubproblem(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
+         size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options) :
+         // the inertia of the EQP matrix is corrected: the Hessian is not convexified
+         InequalityConstrainedMethod(options.get_string("hessian_model"), number_variables, number_constraints, number_hessian_nonzeros,
+               false, options),
+         LP_solver(LPSolverFactory::create(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros,
+               options)),
+         LP_direction(number_variables, number_constraints),
+         LP_trust_region_radius(options.get_double("SLQP_LP_trust_region_radius")),
+         active_set_tolerance(options.get_double("SLQP_active_set_tolerance")),
+         dual_regularization_parameter(options.get_double("SLQP_dual_regularization")),
+         objective_gradient(number_objective_gradient_nonzeros),
+         constraints(number_constraints),
+         hessian(number_variables, number_hessian_nonzeros, false, "COO"),
+         // at most one row per constraint and per variable bound
+         working_jacobian(number_constraints + number_variables, number_variables),
+         working_set_rhs(number_constraints + number_variables),
+         augmented_system("COO", 2 * number_variables + number_constraints,
+               number_hessian_nonzeros + number_jacobian_nonzeros + number_variables /* Jacobian and bounds of the working set */,
+               true, /* use regularization */
+               options, 1 /* Fortran indices */),
+         linear_solver(SymmetricIndefiniteLinearSolverFactory::create<int>(2 * number_variables + number_constraints,
+               number_hessian_nonzeros
+               + 2 * number_variables + number_constraints /* regularization */
+               + number_jacobian_nonzeros + number_variables, /* Jacobian and bounds of the working set */
+               options)),
+         cauchy_direction(number_variables),
+         EQP_direction(number_variables),
+         cauchy_jacobian_product(number_constraints),
+         EQP_jacobian_product(number_constraints) {
+   }
+
+   SLQPSubproblem::~SLQPSubproblem() { }
+
+   void SLQPSubproblem::initialize_statistics(Statistics& statistics, const Options& options) {
+      InequalityConstrainedMethod::initialize_statistics(statistics, options);
+      statistics.add_column("regulariz", Statistics::double_width - 4, options.get_int("statistics_regularization_column_order"));
+      statistics.add_column("factoriz", Statistics::int_width + 3, options.get_int("statistics_factorizations_column_order"));
+      statistics.add_column("fact time", Statistics::double_width - 4, options.get_int("statistics_factorization_time_column_order"));
+      statistics.add_column("fill", Statistics::double_width - 4, options.get_int("statistics_fill_column_order"));
+      statistics.add_column("delayed", Statistics::int_width + 2, options.get_int("statistics_delayed_pivots_column_order"));
+   }
+
+   void SLQPSubproblem::generate_initial_iterate(Statistics& /*statistics*/, const OptimizationProblem& /*problem*/, Iterate& /*initial_iterate*/) {
+   }
+
+   void SLQPSubproblem::solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers, Direction& direction, WarmstartInformation& warmstart_information) {
+      this->check_solved_problem(problem, warmstart_information);
+
+      // active-set estimation: the LP is solved within a (smaller) LP trust region
+      const double LP_radius = std::min(this->trust_region_radius, this->LP_trust_region_radius);
+      this->LP_solver->solve_LP(problem, current_iterate, this->initial_point, this->LP_direction, LP_radius, warmstart_information);
+      this->number_subproblems_solved++;
+      metrics::increment(Metric::LP_SUBPROBLEMS);
+      // reset the initial point
+      this->initial_point.fill(0.);
+      if (this->LP_direction.status != SubproblemStatus::OPTIMAL) {
+         // the relaxation strategy handles the infeasible or unbounded LPs
+         direction.status = this->LP_direction.status;
+         direction.primals = this->LP_direction.primals;
+         direction.multipliers = this->LP_direction.multipliers;
+         direction.subproblem_objective = this->LP_direction.subproblem_objective;
+         InequalityConstrainedMethod::compute_dual_displacements(current_multipliers, direction.multipliers);
+         return;
+      }
+
+      this->evaluate_local_model(statistics, problem, current_iterate, current_multipliers);
+      this->compute_working_set(problem, current_iterate);
+      this->compute_cauchy_step(problem);
+
+      direction.status = SubproblemStatus::OPTIMAL;
+      direction.primals.fill(0.);
+      if (this->solve_EQP(statistics, problem, warmstart_information)) {
+         // step from the Cauchy point towards the EQP step, truncated by the linearized constraints and the bounds
+         const double step_length = this->compute_maximum_step_length(problem);
+         DEBUG << "SLQP: working set of size " << this->working_set.size() << ", EQP step length " << step_length << '\n';
+         for (size_t variable_index: Range(problem.number_variables)) {
+            direction.primals[variable_index] = this->cauchy_direction[variable_index] +
+                  step_length * (this->EQP_direction[variable_index] - this->cauchy_direction[variable_index]);
+         }
+         // the combined step must not increase the model with respect to the Cauchy point
+         if (this->evaluate_quadratic_model(this->cauchy_direction) < this->evaluate_quadratic_model(direction.primals)) {
+            DEBUG << "SLQP: the EQP step is rejected, the Cauchy step is taken\n";
+            for (size_t variable_index: Range(problem.number_variables)) {
+               direction.primals[variable_index] = this->cauchy_direction[variable_index];
+            }
+         }
+         this->set_multipliers(problem, direction.multipliers);
+      }
+      else {
+         // the augmented matrix could not be regularized: Cauchy step and LP multipliers
+         DEBUG << "SLQP: the EQP could not be solved, the Cauchy step is taken\n";
+         for (size_t variable_index: Range(problem.number_variables)) {
+            direction.primals[variable_index] = this->cauchy_direction[variable_index];
+         }
+         direction.multipliers = this->LP_direction.multipliers;
+      }
+      direction.subproblem_objective = this->evaluate_quadratic_model(direction.primals);
+      InequalityConstrainedMethod::compute_dual_displacements(current_multipliers, direction.multipliers);
+   }
+
+   double SLQPSubproblem::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      return this->hessian.quadratic_product(primal_direction, primal_direction);
+   }
+
+   size_t SLQPSubproblem::get_peak_workspace_size() const {
+      return std::max(this->LP_solver->get_peak_workspace_size(), this->linear_solver->get_peak_workspace_size());
+   }
+
+   FactorizationStatistics SLQPSubproblem::get_factorization_statistics() const {
+      FactorizationStatistics statistics = this->augmented_system.get_factorization_statistics(*this->linear_solver);
+      statistics.accumulate(this->LP_solver->get_factorization_statistics());
+      return statistics;
+   }
+
+   void SLQPSubproblem::report_memory(MemoryReport& report) const {
+      InequalityConstrainedMethod::report_memory(report);
+      this->LP_solver->report_memory(report);
+      report.add("subproblem/objective gradient", this->objective_gradient.memory_size());
+      report.add("subproblem/constraints", MemoryReport::memory_size(this->constraints));
+      report.add("subproblem/Hessian", this->hessian.memory_size());
+      report.add("subproblem/working set", MemoryReport::memory_size(this->working_set) + MemoryReport::memory_size(this->previous_working_set) +
+            this->working_jacobian.memory_size() + this->working_set_rhs.memory_size());
+      size_t directions_size = 0;
+      for (const Vector<double>* vector: {&this->cauchy_direction, &this->EQP_direction, &this->cauchy_jacobian_product,
+            &this->EQP_jacobian_product}) {
+         directions_size += vector->memory_size();
+      }
+      report.add("subproblem/directions", directions_size);
+      report.add("subproblem/augmented system", this->augmented_system.memory_size());
+      report.add("subproblem/linear solver", this->linear_solver->memory_size());
+   }
+
+   // the evaluations are cached in the iterate: the LP solver has already evaluated the functions
+   void SLQPSubproblem::evaluate_local_model(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers) {
+      problem.evaluate_objective_gradient(current_iterate, this->objective_gradient);
+      problem.evaluate_constraints(current_iterate, this->constraints);
+      problem.evaluate_constraint_jacobian(current_iterate, this->constraint_jacobian);
+      this->hessian_model->evaluate(statistics, problem, current_iterate.primals, current_multipliers.constraints, this->hessian);
+      this->set_direction_bounds(problem, current_iterate);
+      this->set_linearized_constraint_bounds(problem, this->constraints);
+   }
+
+   // constraints and variable bounds (not the trust region) active at the LP solution, and rows of the equality constraints of the EQP
+   void SLQPSubproblem::compute_working_set(const OptimizationProblem& problem, const Iterate& current_iterate) {
+      std::swap(this->working_set, this->previous_working_set);
+      this->working_set.clear();
+      this->working_jacobian.clear();
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints = problem.number_constraints;
+
+      this->compute_jacobian_product(problem, this->LP_direction.primals, this->EQP_jacobian_product);
+      for (size_t constraint_index: Range(number_constraints)) {
+         const double linearized_constraint = this->EQP_jacobian_product[constraint_index];
+         const bool is_lower_active = this->is_active(linearized_constraint, this->linearized_constraints_lower_bounds[constraint_index]);
+         if (is_lower_active || this->is_active(linearized_constraint, this->linearized_constraints_upper_bounds[constraint_index])) {
+            const size_t row_index = this->working_set.size();
+            for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
+               this->working_jacobian[row_index].insert(variable_index, derivative);
+            }
+            this->working_set_rhs[row_index] = is_lower_active ?
+                  this->linearized_constraints_lower_bounds[constraint_index] : this->linearized_constraints_upper_bounds[constraint_index];
+            this->working_set.emplace_back(constraint_index);
+         }
+      }
+      for (size_t variable_index: Range(number_variables)) {
+         const double lower_bound = problem.variable_lower_bound(variable_index) - current_iterate.primals[variable_index];
+         const double upper_bound = problem.variable_upper_bound(variable_index) - current_iterate.primals[variable_index];
+         const double LP_step = this->LP_direction.primals[variable_index];
+         const bool is_lower_active = this->is_active(LP_step, lower_bound);
+         if (is_lower_active || this->is_active(LP_step, upper_bound)) {
+            const size_t row_index = this->working_set.size();
+            this->working_jacobian[row_index].insert(variable_index, 1.);
+            this->working_set_rhs[row_index] = is_lower_active ? lower_bound : upper_bound;
+            this->working_set.emplace_back(number_constraints + (is_lower_active ? 0 : number_variables) + variable_index);
+         }
+      }
+   }
+
+   bool SLQPSubproblem::is_active(double value, double bound) const {
+      return is_finite(bound) && std::abs(value - bound) <= this->active_set_tolerance * std::max(1., std::abs(bound));
+   }
+
+   bool SLQPSubproblem::is_origin_feasible(const OptimizationProblem& problem) const {
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         if (0. < this->linearized_constraints_lower_bounds[constraint_index] || this->linearized_constraints_upper_bounds[constraint_index] < 0.) {
+            return false;
+         }
+      }
+      for (size_t variable_index: Range(problem.number_variables)) {
+         if (0. < this->direction_lower_bounds[variable_index] || this->direction_upper_bounds[variable_index] < 0.) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   // minimizer of the quadratic model along the LP step. If the linearized constraints are violated at d = 0, the LP step is kept to
+   // remain feasible
+   void SLQPSubproblem::compute_cauchy_step(const OptimizationProblem& problem) {
+      double step_length = 1.;
+      if (this->is_origin_feasible(problem)) {
+         double directional_derivative = 0.;
+         for (const auto [variable_index, derivative]: this->objective_gradient) {
+            directional_derivative += derivative * this->LP_direction.primals[variable_index];
+         }
+         const double curvature = this->hessian.quadratic_product(this->LP_direction.primals, this->LP_direction.primals);
+         if (0. < curvature) {
+            step_length = std::max(0., std::min(1., -directional_derivative / curvature));
+         }
+      }
+      for (size_t variable_index: Range(problem.number_variables)) {
+         this->cauchy_direction[variable_index] = step_length * this->LP_direction.primals[variable_index];
+      }
+      for (size_t variable_index: Range(problem.number_variables, this->cauchy_direction.size())) {
+         this->cauchy_direction[variable_index] = 0.;
+      }
+      this->compute_jacobian_product(problem, this->cauchy_direction, this->cauchy_jacobian_product);
+   }
+
+   // EQP: min g^T d + 1/2 d^T H d s.t. A_W d = b_W. The augmented system [H A_W^T; A_W 0] [d; -y_W] = [-g; b_W] is factorized once, and
+   // its inertia is corrected so that H is positive definite on the null space of A_W
+   bool SLQPSubproblem::solve_EQP(Statistics& statistics, const OptimizationProblem& problem, const WarmstartInformation& warmstart_information) {
+      const size_t number_variables = problem.number_variables;
+      const size_t working_set_size = this->working_set.size();
+      // a new working set changes the sparsity pattern of the augmented matrix
+      const bool sparsity_changed = warmstart_information.hessian_sparsity_changed || warmstart_information.jacobian_sparsity_changed ||
+            this->working_set != this->previous_working_set;
+      this->augmented_system_warmstart_information.hessian_sparsity_changed = sparsity_changed;
+      this->augmented_system_warmstart_information.jacobian_sparsity_changed = sparsity_changed;
+      try {
+         this->augmented_system.assemble_matrix(this->hessian, this->working_jacobian, number_variables, working_set_size,
+               this->augmented_system_warmstart_information);
+         this->augmented_system.factorize_and_regularize_matrix(statistics, *this->linear_solver, number_variables, working_set_size,
+               this->dual_regularization_parameter, this->augmented_system_warmstart_information);
+         this->number_factorizations += this->augmented_system.get_number_factorizations();
+      }
+      catch (const UnstableRegularization&) {
+         this->number_factorizations += this->augmented_system.get_number_factorizations();
+         // the working set must be reassembled from scratch
+         this->previous_working_set.clear();
+         return false;
+      }
+
+      // rhs [-g; b_W]
+      for (size_t variable_index: Range(number_variables)) {
+         this->augmented_system.rhs[variable_index] = 0.;
+      }
+      for (const auto [variable_index, derivative]: this->objective_gradient) {
+         this->augmented_system.rhs[variable_index] = -derivative;
+      }
+      for (size_t row_index: Range(working_set_size)) {
+         this->augmented_system.rhs[number_variables + row_index] = this->working_set_rhs[row_index];
+      }
+      this->augmented_system.solve(*this->linear_solver);
+      for (size_t variable_index: Range(number_variables)) {
+         this->EQP_direction[variable_index] = this->augmented_system.solution[variable_index];
+      }
+      for (size_t variable_index: Range(number_variables, this->EQP_direction.size())) {
+         this->EQP_direction[variable_index] = 0.;
+      }
+      this->compute_jacobian_product(problem, this->EQP_direction, this->EQP_jacobian_product);
+      return true;
+   }
+
+   // largest step length in [0, 1] along the segment [d_C, d_EQP] that satisfies the linearized constraints and the direction bounds
+   double SLQPSubproblem::compute_maximum_step_length(const OptimizationProblem& problem) const {
+      double step_length = 1.;
+      const auto truncate = [&](double value, double displacement, double lower_bound, double upper_bound) {
+         if (displacement < 0. && is_finite(lower_bound)) {
+            step_length = std::min(step_length, std::max(0., (lower_bound - value) / displacement));
+         }
+         else if (0. < displacement && is_finite(upper_bound)) {
+            step_length = std::min(step_length, std::max(0., (upper_bound - value) / displacement));
+         }
+      };
+      for (size_t variable_index: Range(problem.number_variables)) {
+         truncate(this->cauchy_direction[variable_index], this->EQP_direction[variable_index] - this->cauchy_direction[variable_index],
+               this->direction_lower_bounds[variable_index], this->direction_upper_bounds[variable_index]);
+      }
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         truncate(this->cauchy_jacobian_product[constraint_index],
+               this->EQP_jacobian_product[constraint_index] - this->cauchy_jacobian_product[constraint_index],
+               this->linearized_constraints_lower_bounds[constraint_index], this->linearized_constraints_upper_bounds[constraint_index]);
+      }
+      return step_length;
+   }
+
+   void SLQPSubproblem::compute_jacobian_product(const OptimizationProblem& problem, const Vector<double>& vector, Vector<double>& result) const {
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         double product = 0.;
+         for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
+            product += derivative * vector[variable_index];
+         }
+         result[constraint_index] = product;
+      }
+   }
+
+   // g^T d + 1/2 d^T H d
+   double SLQPSubproblem::evaluate_quadratic_model(const Vector<double>& primal_direction) const {
+      double linear_term = 0.;
+      for (const auto [variable_index, derivative]: this->objective_gradient) {
+         linear_term += derivative * primal_direction[variable_index];
+      }
+      return linear_term + 0.5 * this->hessian.quadratic_product(primal_direction, primal_direction);
+   }
+
+   // the multipliers of the working set are those of the EQP (note the minus sign); the inactive constraints and bounds have zero multipliers
+   void SLQPSubproblem::set_multipliers(const OptimizationProblem& problem, Multipliers& direction_multipliers) const {
+      direction_multipliers.reset();
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints = problem.number_constraints;
+      for (size_t row_index: Range(this->working_set.size())) {
+         const size_t index = this->working_set[row_index];
+         const double multiplier = -this->augmented_system.solution[number_variables + row_index];
+         if (index < number_constraints) {
+            direction_multipliers.constraints[index] = multiplier;
+         }
+         else if (index < number_constraints + number_variables) {
+            direction_multipliers.lower_bounds[index - number_constraints] = multiplier;
+         }
+         else {
+            direction_multipliers.upper_bounds[index - number_constraints - number_variables] = multiplier;
+         }
+      }
+   }
+} // namespace
@@ -0,0 +1,94 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SLQPSUBPROBLEM_H
+#define UNO_SLQPSUBPROBLEM_H
+
+#include <memory>
+#include <vector>
+#include "InequalityConstrainedMethod.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/WarmstartInformation.hpp"
+
+namespace uno {
+   // forward declarations
+   template <typename IndexType, typename ElementType>
+   class DirectSymmetricIndefiniteLinearSolver;
+   class LPSolver;
+
+   /*! \class SLQPSubproblem
+    * \brief Sequential linear-quadratic programming (SLQP) subproblem
+    *
+    *  The LP min g^T d s.t. linearized constraints, bounds and infinity-norm LP trust region estimates the active set. The step is
+    *  then computed from the equality-constrained QP min g^T d + 1/2 d^T H d s.t. the working set (constraints and bounds active at
+    *  the LP solution) is satisfied as equalities, i.e. from a single factorization of the augmented matrix [H A_W^T; A_W 0], whose
+    *  inertia is corrected. The EQP step is finally truncated along the segment that joins the Cauchy point (minimizer of the
+    *  quadratic model along the LP step) to the EQP step, so that the linearized constraints and the bounds remain satisfied
+    *  (Byrd, Gould, Nocedal and Waltz, 2004)
+    */
+   class SLQPSubproblem : public InequalityConstrainedMethod {
+   public:
+      SLQPSubproblem(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros, size_t number_jacobian_nonzeros,
+            size_t number_hessian_nonzeros, const Options& options);
+      ~SLQPSubproblem() override;
+
+      void initialize_statistics(Statistics& statistics, const Options& options) override;
+      void generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) override;
+      void solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
+            Direction& direction, WarmstartInformation& warmstart_information) override;
+      [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      [[nodiscard]] size_t get_peak_workspace_size() const override;
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const override;
+      void report_memory(MemoryReport& report) const override;
+
+      [[nodiscard]] size_t working_set_size() const { return this->working_set.size(); }
+
+   protected:
+      const std::unique_ptr<LPSolver> LP_solver;
+      Direction LP_direction;
+      const double LP_trust_region_radius;
+      const double active_set_tolerance;
+      const double dual_regularization_parameter;
+
+      // local model
+      SparseVector<double> objective_gradient;
+      std::vector<double> constraints;
+      RectangularMatrixView<double> constraint_jacobian; /*!< view of the Jacobian of the current iterate */
+      SymmetricMatrix<size_t, double> hessian;
+
+      // working set at the LP solution: constraint j (index j), lower bound of variable i (index m + i) or upper bound of variable i
+      // (index m + n + i)
+      std::vector<size_t> working_set{};
+      std::vector<size_t> previous_working_set{};
+      RectangularMatrix<double> working_jacobian;
+      Vector<double> working_set_rhs;
+      SymmetricIndefiniteLinearSystem<int, double> augmented_system;
+      const std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<int, double>> linear_solver;
+      WarmstartInformation augmented_system_warmstart_information{};
+
+      // Cauchy and EQP steps, and their Jacobian products
+      Vector<double> cauchy_direction;
+      Vector<double> EQP_direction;
+      Vector<double> cauchy_jacobian_product;
+      Vector<double> EQP_jacobian_product;
+
+      void evaluate_local_model(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+            const Multipliers& current_multipliers);
+      void compute_working_set(const OptimizationProblem& problem, const Iterate& current_iterate);
+      [[nodiscard]] bool is_origin_feasible(const OptimizationProblem& problem) const;
+      [[nodiscard]] bool is_active(double value, double bound) const;
+      void compute_cauchy_step(const OptimizationProblem& problem);
+      [[nodiscard]] bool solve_EQP(Statistics& statistics, const OptimizationProblem& problem, const WarmstartInformation& warmstart_information);
+      [[nodiscard]] double compute_maximum_step_length(const OptimizationProblem& problem) const;
+      void compute_jacobian_product(const OptimizationProblem& problem, const Vector<double>& vector, Vector<double>& result) const;
+      [[nodiscard]] double evaluate_quadratic_model(const Vector<double>& primal_direction) const;
+      void set_multipliers(const OptimizationProblem& problem, Multipliers& direction_multipliers) const;
+   };
+} // namespace
+
+#endif // UNO_SLQPSUBPROBLEM_H
@@ -0,0 +1,198 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <stdexcept>
+#include "TruncatedCGSubproblem.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+#include "tools/MemoryReport.hpp"
+
+namespace uno {
+   TruncatedCGSubproblem::TruncatedCGSubproblem(size_t number_variables, size_t number_hessian_nonzeros, const Options& options):
+         // CG handles negative curvature: no convexification
+         InequalityConstrainedMethod(options.get_string("hessian_model"), number_variables, 0, number_hessian_nonzeros, false, options),
+         max_iterations(options.get_unsigned_int("truncated_CG_max_iterations")),
+         objective_gradient(number_variables),
+         gradient(number_variables),
+         residual(number_variables),
+         cg_direction(number_variables),
+         hessian_cg_direction(number_variables),
+         is_free(number_variables),
+         hessian_product(number_variables) {
+   }
+
+   void TruncatedCGSubproblem::generate_initial_iterate(Statistics& /*statistics*/, const OptimizationProblem& /*problem*/, Iterate& /*initial_iterate*/) {
+   }
+
+   void TruncatedCGSubproblem::solve(Statistics& /*statistics*/, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers, Direction& direction, WarmstartInformation& /*warmstart_information*/) {
+      if (0 < problem.number_constraints) {
+         throw std::runtime_error("The truncated CG subproblem does not handle general constraints");
+      }
+      const size_t number_variables = problem.number_variables;
+      problem.evaluate_objective_gradient(current_iterate, this->objective_gradient);
+      for (size_t variable_index: Range(number_variables)) {
+         this->gradient[variable_index] = 0.;
+      }
+      for (const auto [variable_index, derivative]: this->objective_gradient) {
+         this->gradient[variable_index] = derivative;
+      }
+      this->set_direction_bounds(problem, current_iterate);
+      this->hessian_problem = &problem;
+      this->hessian_primals = current_iterate.primals;
+      this->hessian_multipliers = current_multipliers.constraints;
+
+      // start from the projection of 0 onto the box, with the residual r = g + H d
+      Vector<double>& primal_direction = direction.primals;
+      for (size_t variable_index: Range(number_variables)) {
+         primal_direction[variable_index] = std::min(std::max(0., this->direction_lower_bounds[variable_index]),
+               this->direction_upper_bounds[variable_index]);
+      }
+      this->compute_hessian_product(number_variables, primal_direction, this->residual);
+      for (size_t variable_index: Range(number_variables)) {
+         this->residual[variable_index] += this->gradient[variable_index];
+      }
+
+      // Steihaug's forcing term
+      double residual_norm = this->determine_free_variables(number_variables, primal_direction);
+      const double tolerance = std::min(0.5, std::sqrt(residual_norm)) * residual_norm;
+      size_t number_iterations = 0;
+      while (tolerance < residual_norm && number_iterations < this->max_iterations) {
+         // CG on the free variables, until the convergence or a bound is hit
+         for (size_t variable_index: Range(number_variables)) {
+            this->cg_direction[variable_index] = this->is_free[variable_index] ? -this->residual[variable_index] : 0.;
+         }
+         double squared_residual_norm = residual_norm * residual_norm;
+         bool is_bound_hit = false;
+         while (!is_bound_hit && tolerance * tolerance < squared_residual_norm && number_iterations < this->max_iterations) {
+            number_iterations++;
+            this->compute_hessian_product(number_variables, this->cg_direction, this->hessian_cg_direction);
+            double curvature = 0.;
+            double max_step_length = INF<double>;
+            size_t blocking_variable = number_variables;
+            for (size_t variable_index: Range(number_variables)) {
+               const double component = this->cg_direction[variable_index];
+               curvature += component * this->hessian_cg_direction[variable_index];
+               if (component != 0.) {
+                  const double bound = (component < 0.) ? this->direction_lower_bounds[variable_index] :
+                     this->direction_upper_bounds[variable_index];
+                  const double step_length = (bound - primal_direction[variable_index]) / component;
+                  if (step_length < max_step_length) {
+                     max_step_length = step_length;
+                     blocking_variable = variable_index;
+                  }
+               }
+            }
+            // negative curvature: go to the boundary of the box
+            if (curvature <= 0. && max_step_length == INF<double>) {
+               DEBUG << "Truncated CG: direction of negative curvature in an unbounded box\n";
+               direction.status = SubproblemStatus::UNBOUNDED_PROBLEM;
+               return;
+            }
+            is_bound_hit = (curvature <= 0. || max_step_length <= squared_residual_norm / curvature);
+            const double step_length = is_bound_hit ? max_step_length : squared_residual_norm / curvature;
+            for (size_t variable_index: Range(number_variables)) {
+               primal_direction[variable_index] += step_length * this->cg_direction[variable_index];
+               this->residual[variable_index] += step_length * this->hessian_cg_direction[variable_index];
+            }
+            if (is_bound_hit) {
+               primal_direction[blocking_variable] = (this->cg_direction[blocking_variable] < 0.) ?
+                  this->direction_lower_bounds[blocking_variable] : this->direction_upper_bounds[blocking_variable];
+            }
+            else {
+               double new_squared_residual_norm = 0.;
+               for (size_t variable_index: Range(number_variables)) {
+                  if (this->is_free[variable_index]) {
+                     new_squared_residual_norm += this->residual[variable_index] * this->residual[variable_index];
+                  }
+               }
+               const double beta = new_squared_residual_norm / squared_residual_norm;
+               for (size_t variable_index: Range(number_variables)) {
+                  if (this->is_free[variable_index]) {
+                     this->cg_direction[variable_index] = -this->residual[variable_index] + beta * this->cg_direction[variable_index];
+                  }
+               }
+               squared_residual_norm = new_squared_residual_norm;
+            }
+         }
+         residual_norm = this->determine_free_variables(number_variables, primal_direction);
+      }
+      DEBUG << "Truncated CG: " << number_iterations << " iterations, free residual norm " << residual_norm << '\n';
+
+      // exact residual at the final point
+      this->compute_hessian_product(number_variables, primal_direction, this->residual);
+      direction.subproblem_objective = 0.;
+      for (size_t variable_index: Range(number_variables)) {
+         direction.subproblem_objective += primal_direction[variable_index] * (this->gradient[variable_index] + 0.5 * this->residual[variable_index]);
+         this->residual[variable_index] += this->gradient[variable_index];
+      }
+      this->set_multipliers(number_variables, primal_direction, direction.multipliers);
+      InequalityConstrainedMethod::compute_dual_displacements(current_multipliers, direction.multipliers);
+      direction.status = SubproblemStatus::OPTIMAL;
+      this->number_subproblems_solved++;
+   }
+
+   double TruncatedCGSubproblem::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      if (this->hessian_problem == nullptr) {
+         return 0.;
+      }
+      const size_t number_variables = this->hessian_problem->number_variables;
+      this->compute_hessian_product(number_variables, primal_direction, this->hessian_product);
+      double product = 0.;
+      for (size_t variable_index: Range(number_variables)) {
+         product += primal_direction[variable_index] * this->hessian_product[variable_index];
+      }
+      return product;
+   }
+
+   void TruncatedCGSubproblem::report_memory(MemoryReport& report) const {
+      InequalityConstrainedMethod::report_memory(report);
+      report.add("subproblem/objective gradient", this->objective_gradient.memory_size());
+      report.add("subproblem/CG vectors", this->gradient.memory_size() + this->residual.memory_size() + this->cg_direction.memory_size() +
+            this->hessian_cg_direction.memory_size() + this->hessian_primals.memory_size() + this->hessian_multipliers.memory_size() +
+            this->hessian_product.memory_size() + this->is_free.capacity() / 8);
+   }
+
+   void TruncatedCGSubproblem::compute_hessian_product(size_t number_variables, const Vector<double>& vector, Vector<double>& result) const {
+      for (size_t variable_index: Range(number_variables)) {
+         result[variable_index] = 0.;
+      }
+      this->hessian_model->compute_hessian_vector_product(*this->hessian_problem, this->hessian_primals, this->hessian_multipliers, vector, result);
+   }
+
+   double TruncatedCGSubproblem::determine_free_variables(size_t number_variables, const Vector<double>& primal_direction) {
+      double squared_norm = 0.;
+      for (size_t variable_index: Range(number_variables)) {
+         const double lower_bound = this->direction_lower_bounds[variable_index];
+         const double upper_bound = this->direction_upper_bounds[variable_index];
+         const double component = primal_direction[variable_index];
+         const double residual_component = this->residual[variable_index];
+         this->is_free[variable_index] = !(lower_bound == upper_bound || (component <= lower_bound && 0. <= residual_component) ||
+            (upper_bound <= component && residual_component <= 0.));
+         if (this->is_free[variable_index]) {
+            squared_norm += residual_component * residual_component;
+         }
+      }
+      return std::sqrt(squared_norm);
+   }
+
+   // the bound multipliers are the components of the model gradient r = g + H d at the active bounds
+   void TruncatedCGSubproblem::set_multipliers(size_t number_variables, const Vector<double>& primal_direction,
+         Multipliers& direction_multipliers) const {
+      direction_multipliers.reset();
+      for (size_t variable_index: Range(number_variables)) {
+         const double residual_component = this->residual[variable_index];
+         if (primal_direction[variable_index] <= this->direction_lower_bounds[variable_index] && 0. < residual_component) {
+            direction_multipliers.lower_bounds[variable_index] = residual_component;
+         }
+         else if (this->direction_upper_bounds[variable_index] <= primal_direction[variable_index] && residual_component < 0.) {
+            direction_multipliers.upper_bounds[variable_index] = residual_component;
+         }
+      }
+   }
+} // namespace
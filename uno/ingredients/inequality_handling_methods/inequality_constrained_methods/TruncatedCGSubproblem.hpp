@@ -0,0 +1,51 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_TRUNCATEDCGSUBPROBLEM_H
+#define UNO_TRUNCATEDCGSUBPROBLEM_H
+
+#include "InequalityConstrainedMethod.hpp"
+#include "linear_algebra/SparseVector.hpp"
+
+namespace uno {
+   /*! \class TruncatedCGSubproblem
+    * \brief Steihaug-Toint truncated conjugate gradient for problems without general constraints
+    *
+    *  Approximately minimizes the quadratic model g^T d + 1/2 d^T H d over the box defined by the variable bounds and the
+    *  (infinity-norm) trust region, with Hessian-vector products only (O(n) memory). CG runs on the free variables and is
+    *  truncated when it leaves the box or meets negative curvature; the blocking variable is then fixed at its bound and CG is
+    *  restarted. Variables at a bound whose multiplier has the wrong sign are released
+    */
+   class TruncatedCGSubproblem : public InequalityConstrainedMethod {
+   public:
+      TruncatedCGSubproblem(size_t number_variables, size_t number_hessian_nonzeros, const Options& options);
+
+      void generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) override;
+      void solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
+            Direction& direction, WarmstartInformation& warmstart_information) override;
+      [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      void report_memory(MemoryReport& report) const override;
+
+   protected:
+      const size_t max_iterations;
+      SparseVector<double> objective_gradient;
+      // dense gradient g and residual r = g + H d of the current model
+      Vector<double> gradient;
+      Vector<double> residual;
+      Vector<double> cg_direction;
+      Vector<double> hessian_cg_direction;
+      std::vector<bool> is_free{};
+      // point at which the Hessian-vector products are evaluated
+      const OptimizationProblem* hessian_problem{nullptr};
+      Vector<double> hessian_primals{};
+      Vector<double> hessian_multipliers{};
+      mutable Vector<double> hessian_product;
+
+      void compute_hessian_product(size_t number_variables, const Vector<double>& vector, Vector<double>& result) const;
+      // fixes the variables at a bound whose multiplier has the right sign. Returns the norm of the free residual
+      double determine_free_variables(size_t number_variables, const Vector<double>& primal_direction);
+      void set_multipliers(size_t number_variables, const Vector<double>& primal_direction, Multipliers& direction_multipliers) const;
+   };
+} // namespace
+
+#endif // UNO_TRUNCATEDCGSUBPROBLEM_H
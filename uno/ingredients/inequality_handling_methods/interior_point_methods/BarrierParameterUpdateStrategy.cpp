@@ -3,22 +3,48 @@
 
 #include <cassert>
 #include <cmath>
+#include <limits>
+#include <stdexcept>
 #include "BarrierParameterUpdateStrategy.hpp"
 #include "optimization/Iterate.hpp"
 #include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
 #include "symbolic/VectorExpression.hpp"
+#include "tools/Checkpoint.hpp"
 #include "tools/Logger.hpp"
 #include "options/Options.hpp"
 
 namespace uno {
+   BarrierUpdateRule barrier_update_rule_from_string(const std::string& rule) {
+      if (rule == "monotone") {
+         return BarrierUpdateRule::MONOTONE;
+      }
+      else if (rule == "loqo") {
+         return BarrierUpdateRule::LOQO;
+      }
+      else if (rule == "quality_function") {
+         return BarrierUpdateRule::QUALITY_FUNCTION;
+      }
+      throw std::invalid_argument("The barrier update rule " + rule + " does not exist");
+   }
+
    BarrierParameterUpdateStrategy::BarrierParameterUpdateStrategy(const Options& options):
-      barrier_parameter(options.get_double("barrier_initial_parameter")),
+      initial_barrier_parameter(options.get_double("barrier_initial_parameter")),
+      barrier_parameter(this->initial_barrier_parameter),
       tolerance(options.get_double("tolerance")),
       parameters({
          options.get_double("barrier_k_mu"),
          options.get_double("barrier_theta_mu"),
          options.get_double("barrier_k_epsilon"),
          options.get_double("barrier_update_fraction")
+      }),
+      rule(barrier_update_rule_from_string(options.get_string("barrier_update_rule"))),
+      adaptive_parameters({
+         options.get_double("barrier_adaptive_sufficient_decrease"),
+         options.get_unsigned_int("barrier_adaptive_max_stalls"),
+         options.get_double("barrier_adaptive_monotone_fraction"),
+         options.get_double("barrier_min_parameter"),
+         options.get_double("barrier_quality_function_sigma_max"),
+         options.get_unsigned_int("barrier_quality_function_golden_section_iterations")
       }) {
    }
 
@@ -26,16 +52,49 @@ namespace uno {
       return this->barrier_parameter;
    }
 
+   void BarrierParameterUpdateStrategy::reset() {
+      this->barrier_parameter = this->initial_barrier_parameter;
+      this->free_mode = true;
+      this->reference_error = INF<double>;
+      this->number_stalls = 0;
+   }
+
+   void BarrierParameterUpdateStrategy::save_state(CheckpointWriter& writer) const {
+      writer.write(this->barrier_parameter);
+      writer.write(this->free_mode);
+      writer.write(this->reference_error);
+      writer.write(this->number_stalls);
+   }
+
+   void BarrierParameterUpdateStrategy::load_state(CheckpointReader& reader) {
+      this->barrier_parameter = reader.read_double();
+      this->free_mode = reader.read_bool();
+      this->reference_error = reader.read_double();
+      this->number_stalls = reader.read_size_t();
+   }
+
    void BarrierParameterUpdateStrategy::set_barrier_parameter(double new_barrier_parameter) {
       assert(0. <= new_barrier_parameter && "The barrier parameter should be positive.");
       this->barrier_parameter = new_barrier_parameter;
    }
 
+   bool BarrierParameterUpdateStrategy::requires_quality_function() const {
+      return (this->rule == BarrierUpdateRule::QUALITY_FUNCTION && this->free_mode);
+   }
+
    bool BarrierParameterUpdateStrategy::update_barrier_parameter(const OptimizationProblem& problem, const Iterate& current_iterate,
          const Multipliers& current_multipliers, const DualResiduals& residuals) {
       // primal-dual errors
       const double scaled_stationarity = residuals.stationarity / residuals.stationarity_scaling;
       const double primal_feasibility = (problem.get_objective_multiplier() == 0.) ? 0. : current_iterate.primal_feasibility;
+      if (this->rule == BarrierUpdateRule::MONOTONE) {
+         return this->update_monotone(problem, current_iterate, current_multipliers, residuals, scaled_stationarity, primal_feasibility);
+      }
+      return this->update_adaptive(problem, current_iterate, current_multipliers, residuals, scaled_stationarity, primal_feasibility);
+   }
+
+   bool BarrierParameterUpdateStrategy::update_monotone(const OptimizationProblem& problem, const Iterate& current_iterate,
+         const Multipliers& current_multipliers, const DualResiduals& residuals, double scaled_stationarity, double primal_feasibility) {
       double primal_dual_error = std::max({
          scaled_stationarity,
          primal_feasibility,
@@ -64,6 +123,140 @@ namespace uno {
       return parameter_updated;
    }
 
+   // the adaptive rules are safeguarded: if the KKT error does not decrease sufficiently for a number of iterations, switch to monotone
+   // mode until the barrier subproblem is solved
+   bool BarrierParameterUpdateStrategy::update_adaptive(const OptimizationProblem& problem, const Iterate& current_iterate,
+         const Multipliers& current_multipliers, const DualResiduals& residuals, double scaled_stationarity, double primal_feasibility) {
+      const double kkt_error = std::max({
+         scaled_stationarity,
+         primal_feasibility,
+         BarrierParameterUpdateStrategy::compute_shifted_complementarity_error(problem, current_iterate.primals, current_multipliers, 0.) /
+            residuals.complementarity_scaling
+      });
+      if (this->free_mode) {
+         if (kkt_error <= (1. - this->adaptive_parameters.sufficient_decrease) * this->reference_error) {
+            this->reference_error = kkt_error;
+            this->number_stalls = 0;
+         }
+         else {
+            this->number_stalls++;
+         }
+         if (this->adaptive_parameters.max_stalls < this->number_stalls) {
+            // fallback: monotone mode
+            this->free_mode = false;
+            const double average_complementarity = BarrierParameterUpdateStrategy::compute_average_complementarity(problem,
+                  current_iterate.primals, current_multipliers);
+            const double tolerance_fraction = this->tolerance / this->parameters.update_fraction;
+            this->barrier_parameter = std::max(tolerance_fraction, std::min(this->barrier_parameter,
+                  this->adaptive_parameters.monotone_fraction * average_complementarity));
+            DEBUG << "Insufficient progress of the adaptive barrier update: switching to monotone mode with mu = " << this->barrier_parameter << '\n';
+            return true;
+         }
+         if (this->rule == BarrierUpdateRule::LOQO) {
+            const double new_barrier_parameter = this->compute_loqo_barrier_parameter(problem, current_iterate.primals, current_multipliers);
+            const bool parameter_updated = (new_barrier_parameter != this->barrier_parameter);
+            this->barrier_parameter = new_barrier_parameter;
+            DEBUG << "Barrier parameter mu updated to " << this->barrier_parameter << " (LOQO rule)\n";
+            return parameter_updated;
+         }
+         // the quality function is minimized by the interior-point method (see minimize_quality_function)
+         return false;
+      }
+      else {
+         const bool parameter_updated = this->update_monotone(problem, current_iterate, current_multipliers, residuals, scaled_stationarity,
+               primal_feasibility);
+         if (parameter_updated) {
+            // the barrier subproblem was solved: back to free mode
+            DEBUG << "Barrier subproblem solved: switching back to free mode\n";
+            this->free_mode = true;
+            this->reference_error = kkt_error;
+            this->number_stalls = 0;
+         }
+         return parameter_updated;
+      }
+   }
+
+   // Section 3 in "Interior-point methods for nonconvex nonlinear programming: orderings and higher-order methods" (Vanderbei and Shanno)
+   double BarrierParameterUpdateStrategy::compute_loqo_barrier_parameter(const OptimizationProblem& problem, const Vector<double>& primals,
+         const Multipliers& multipliers) const {
+      double sum_complementarity = 0.;
+      double min_complementarity = INF<double>;
+      size_t number_bounds = 0;
+      problem.get_lower_bounded_variables().for_each([&](size_t variable_index) {
+         const double complementarity = (primals[variable_index] - problem.variable_lower_bound(variable_index)) * multipliers.lower_bounds[variable_index];
+         sum_complementarity += complementarity;
+         min_complementarity = std::min(min_complementarity, complementarity);
+         number_bounds++;
+      });
+      problem.get_upper_bounded_variables().for_each([&](size_t variable_index) {
+         const double complementarity = (primals[variable_index] - problem.variable_upper_bound(variable_index)) * multipliers.upper_bounds[variable_index];
+         sum_complementarity += complementarity;
+         min_complementarity = std::min(min_complementarity, complementarity);
+         number_bounds++;
+      });
+      if (number_bounds == 0 || sum_complementarity <= 0.) {
+         return this->barrier_parameter;
+      }
+      const double average_complementarity = sum_complementarity / static_cast<double>(number_bounds);
+      // centrality measure in (0, 1]
+      const double centrality = std::max(min_complementarity / average_complementarity, std::numeric_limits<double>::epsilon());
+      const double centering = 0.1 * std::pow(std::min(0.05 * (1. - centrality) / centrality, 2.), 3);
+      return std::max(this->adaptive_parameters.min_barrier_parameter, centering * average_complementarity);
+   }
+
+   // golden-section search of the centering parameter sigma (in logarithmic scale)
+   bool BarrierParameterUpdateStrategy::minimize_quality_function(const std::function<double(double)>& quality_function,
+         double average_complementarity) {
+      if (average_complementarity <= 0.) {
+         return false;
+      }
+      const double sigma_min = std::min(1., this->adaptive_parameters.min_barrier_parameter / average_complementarity);
+      double lower = std::log(std::max(sigma_min, std::numeric_limits<double>::min()));
+      double upper = std::log(this->adaptive_parameters.sigma_max);
+      static const double golden_ratio = (std::sqrt(5.) - 1.) / 2.;
+      double left = upper - golden_ratio * (upper - lower);
+      double right = lower + golden_ratio * (upper - lower);
+      double left_value = quality_function(std::exp(left));
+      double right_value = quality_function(std::exp(right));
+      for (size_t iteration = 0; iteration < this->adaptive_parameters.golden_section_iterations; iteration++) {
+         if (left_value <= right_value) {
+            upper = right;
+            right = left;
+            right_value = left_value;
+            left = upper - golden_ratio * (upper - lower);
+            left_value = quality_function(std::exp(left));
+         }
+         else {
+            lower = left;
+            left = right;
+            left_value = right_value;
+            right = lower + golden_ratio * (upper - lower);
+            right_value = quality_function(std::exp(right));
+         }
+      }
+      const double sigma = std::exp((left_value <= right_value) ? left : right);
+      const double new_barrier_parameter = std::max(this->adaptive_parameters.min_barrier_parameter, sigma * average_complementarity);
+      const bool parameter_updated = (new_barrier_parameter != this->barrier_parameter);
+      this->barrier_parameter = new_barrier_parameter;
+      DEBUG << "Barrier parameter mu updated to " << this->barrier_parameter << " (quality function, sigma = " << sigma << ")\n";
+      return parameter_updated;
+   }
+
+   double BarrierParameterUpdateStrategy::compute_average_complementarity(const OptimizationProblem& problem, const Vector<double>& primals,
+         const Multipliers& multipliers) {
+      double sum_complementarity = 0.;
+      size_t number_bounds = 0;
+      problem.get_lower_bounded_variables().for_each([&](size_t variable_index) {
+         sum_complementarity += (primals[variable_index] - problem.variable_lower_bound(variable_index)) * multipliers.lower_bounds[variable_index];
+         number_bounds++;
+      });
+      problem.get_upper_bounded_variables().for_each([&](size_t variable_index) {
+         sum_complementarity += (primals[variable_index] - problem.variable_upper_bound(variable_index)) * multipliers.upper_bounds[variable_index];
+         number_bounds++;
+      });
+      return (0 < number_bounds) ? sum_complementarity / static_cast<double>(number_bounds) : 0.;
+   }
+
    double BarrierParameterUpdateStrategy::compute_shifted_complementarity_error(const OptimizationProblem& problem, const Vector<double>& primals,
          const Multipliers& multipliers, double shift_value) {
       const Range variables_range = Range(problem.number_variables);
@@ -4,8 +4,15 @@
 #ifndef UNO_BARRIERPARAMETERUPDATESTRATEGY_H
 #define UNO_BARRIERPARAMETERUPDATESTRATEGY_H
 
+#include <cstddef>
+#include <functional>
+#include <string>
+#include "tools/Infinity.hpp"
+
 namespace uno {
    // forward declarations
+   class CheckpointReader;
+   class CheckpointWriter;
    class Iterate;
    class Multipliers;
    class OptimizationProblem;
@@ -21,18 +28,59 @@ namespace uno {
       double update_fraction;
    };
 
+   // monotone: Fiacco-McCormick rule (Eq. 7 in IPOPT paper)
+   // loqo: complementarity-based rule of Vanderbei and Shanno
+   // quality_function: mu minimizes a linear model of the KKT error along the direction (Nocedal, Waechter and Waltz)
+   enum class BarrierUpdateRule {MONOTONE, LOQO, QUALITY_FUNCTION};
+
+   BarrierUpdateRule barrier_update_rule_from_string(const std::string& rule);
+
+   struct AdaptiveParameters {
+      double sufficient_decrease; // required decrease of the KKT error in free mode
+      size_t max_stalls; // number of iterations without sufficient decrease before switching to monotone mode
+      double monotone_fraction; // mu = fraction * average complementarity when switching to monotone mode
+      double min_barrier_parameter;
+      double sigma_max; // upper bound of the centering parameter of the quality function
+      size_t golden_section_iterations;
+   };
+
    class BarrierParameterUpdateStrategy {
    public:
       explicit BarrierParameterUpdateStrategy(const Options& options);
       [[nodiscard]] double get_barrier_parameter() const;
       void set_barrier_parameter(double new_barrier_parameter);
+      // back to the initial barrier parameter (in free mode), at the beginning of a solve
+      void reset();
+      void save_state(CheckpointWriter& writer) const;
+      void load_state(CheckpointReader& reader);
       [[nodiscard]] bool update_barrier_parameter(const OptimizationProblem& problem, const Iterate& current_iterate, const Multipliers& current_multipliers,
             const DualResiduals& residuals);
+      // in free mode, the quality-function rule needs the directions computed by the interior-point method
+      [[nodiscard]] bool requires_quality_function() const;
+      // quality_function(sigma) is the KKT error model along the direction computed with mu = sigma * average_complementarity
+      [[nodiscard]] bool minimize_quality_function(const std::function<double(double)>& quality_function, double average_complementarity);
+
+      [[nodiscard]] static double compute_average_complementarity(const OptimizationProblem& problem, const Vector<double>& primals,
+            const Multipliers& multipliers);
 
    protected:
+      const double initial_barrier_parameter;
       double barrier_parameter;
       const double tolerance;
       const UpdateParameters parameters;
+      const BarrierUpdateRule rule;
+      const AdaptiveParameters adaptive_parameters;
+      // safeguard of the adaptive rules: free mode or monotone mode
+      bool free_mode{true};
+      double reference_error{INF<double>};
+      size_t number_stalls{0};
+
+      [[nodiscard]] bool update_monotone(const OptimizationProblem& problem, const Iterate& current_iterate, const Multipliers& current_multipliers,
+            const DualResiduals& residuals, double scaled_stationarity, double primal_feasibility);
+      [[nodiscard]] bool update_adaptive(const OptimizationProblem& problem, const Iterate& current_iterate, const Multipliers& current_multipliers,
+            const DualResiduals& residuals, double scaled_stationarity, double primal_feasibility);
+      [[nodiscard]] double compute_loqo_barrier_parameter(const OptimizationProblem& problem, const Vector<double>& primals,
+            const Multipliers& multipliers) const;
 
       [[nodiscard]] static double compute_shifted_complementarity_error(const OptimizationProblem& problem, const Vector<double>& primals,
             const Multipliers& multipliers, double shift_value);
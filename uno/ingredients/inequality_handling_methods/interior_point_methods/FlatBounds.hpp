@@ -0,0 +1,81 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FLATBOUNDS_H
+#define UNO_FLATBOUNDS_H
+
+#include <cstddef>
+#include <vector>
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // indices of a set of bounded variables and the corresponding bounds, stored contiguously
+   struct BoundList {
+      std::vector<size_t> variables{};
+      Vector<double> bounds{};
+
+      [[nodiscard]] size_t size() const { return this->variables.size(); }
+   };
+
+   /*! \class FlatBounds
+    * \brief flat copies of the bounded variables of a problem (or model) and of their bounds
+    *
+    *  The barrier-term loops traverse these arrays instead of the (possibly concatenated) collections and the virtual bound accessors.
+    *  The arrays are built once per problem: update() is a no-op as long as the problem is the same.
+    *  The bounds of the same problem may change between two solves (e.g. a re-solve with new parameters): invalidate() forces the next
+    *  update()
+    */
+   class FlatBounds {
+   public:
+      BoundList lower{};
+      BoundList upper{};
+      BoundList single_lower{};
+      BoundList single_upper{};
+
+      FlatBounds() = default;
+
+      // Problem is an OptimizationProblem or a Model
+      template <typename Problem>
+      void update(const Problem& problem);
+      void invalidate() { this->source = nullptr; }
+
+   protected:
+      const void* source{nullptr};
+      size_t number_variables{0};
+
+      template <typename Collection, typename BoundFunction>
+      static void fill(BoundList& list, const Collection& variables, const BoundFunction& bound_function);
+   };
+
+   // implementation
+
+   template <typename Problem>
+   void FlatBounds::update(const Problem& problem) {
+      if (this->source == &problem && this->number_variables == problem.number_variables) {
+         return;
+      }
+      this->source = &problem;
+      this->number_variables = problem.number_variables;
+      const auto lower_bound = [&](size_t variable_index) { return problem.variable_lower_bound(variable_index); };
+      const auto upper_bound = [&](size_t variable_index) { return problem.variable_upper_bound(variable_index); };
+      FlatBounds::fill(this->lower, problem.get_lower_bounded_variables(), lower_bound);
+      FlatBounds::fill(this->upper, problem.get_upper_bounded_variables(), upper_bound);
+      FlatBounds::fill(this->single_lower, problem.get_single_lower_bounded_variables(), lower_bound);
+      FlatBounds::fill(this->single_upper, problem.get_single_upper_bounded_variables(), upper_bound);
+   }
+
+   template <typename Collection, typename BoundFunction>
+   void FlatBounds::fill(BoundList& list, const Collection& variables, const BoundFunction& bound_function) {
+      list.variables.clear();
+      list.variables.reserve(variables.size());
+      variables.for_each([&](size_t variable_index) {
+         list.variables.emplace_back(variable_index);
+      });
+      list.bounds.resize(list.variables.size());
+      for (size_t bound_index: Range(list.variables.size())) {
+         list.bounds[bound_index] = bound_function(list.variables[bound_index]);
+      }
+   }
+} // namespace
+
+#endif // UNO_FLATBOUNDS_H
@@ -0,0 +1,187 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include "InteriorPointCrossoverMethod.hpp"
+#include "PrimalDualInteriorPointMethod.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "ingredients/inequality_handling_methods/inequality_constrained_methods/QPSubproblem.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Multipliers.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   InteriorPointCrossoverMethod::InteriorPointCrossoverMethod(size_t number_variables, size_t number_constraints,
+         size_t number_objective_gradient_nonzeros, size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options):
+         // the Hessian models are those of the two methods
+         InequalityHandlingMethod("zero", number_variables, 0, false, options),
+         interior_point_method(std::make_unique<PrimalDualInteriorPointMethod>(number_variables, number_constraints, number_jacobian_nonzeros,
+               number_hessian_nonzeros, options)),
+         QP_method(std::make_unique<QPSubproblem>(number_variables, number_constraints, number_objective_gradient_nonzeros,
+               number_jacobian_nonzeros, number_hessian_nonzeros, options)),
+         active_set(number_variables, 0),
+         previous_active_set(number_variables, 0),
+         stable_active_set_iterations(options.get_unsigned_int("crossover_stable_active_set_iterations")) {
+   }
+
+   InteriorPointCrossoverMethod::~InteriorPointCrossoverMethod() { }
+
+   void InteriorPointCrossoverMethod::initialize_statistics(Statistics& statistics, const Options& options) {
+      this->interior_point_method->initialize_statistics(statistics, options);
+      this->QP_method->initialize_statistics(statistics, options);
+   }
+
+   void InteriorPointCrossoverMethod::generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) {
+      // each solve (e.g. a re-solve with the same solver) starts with the interior-point phase
+      this->crossover_performed = false;
+      this->solving_feasibility_problem = false;
+      this->is_active_set_estimated = false;
+      this->number_stable_iterations = 0;
+      this->interior_point_method->generate_initial_iterate(statistics, problem, initial_iterate);
+      this->forward_subproblem_definition_change();
+   }
+
+   void InteriorPointCrossoverMethod::forget_hessian_evaluation() {
+      this->interior_point_method->forget_hessian_evaluation();
+      this->QP_method->forget_hessian_evaluation();
+   }
+
+   void InteriorPointCrossoverMethod::solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers, Direction& direction, WarmstartInformation& warmstart_information) {
+      // the active set is estimated once per iterate (the constraints are linearized at each new iterate), and not during the
+      // feasibility restoration phase whose multipliers are those of the feasibility problem
+      if (!this->crossover_performed && !this->solving_feasibility_problem && warmstart_information.constraints_changed) {
+         this->update_active_set_estimate(problem, current_iterate, current_multipliers);
+         if (this->stable_active_set_iterations <= this->number_stable_iterations) {
+            INFO << "Crossover to the QP subproblem: the estimated active set is unchanged for " << this->number_stable_iterations <<
+               " iterations\n";
+            this->crossover_performed = true;
+            // the QP solver is warm-started from the current primal-dual point, but holds none of the problem data
+            warmstart_information.whole_problem_changed();
+            // the barrier terms disappear from the progress measures
+            this->subproblem_definition_changed = true;
+         }
+      }
+      InequalityHandlingMethod& method = this->active_method();
+      method.set_trust_region_radius(this->trust_region_radius);
+      method.solve(statistics, problem, current_iterate, current_multipliers, direction, warmstart_information);
+      this->number_subproblems_solved++;
+      this->forward_subproblem_definition_change();
+   }
+
+   bool InteriorPointCrossoverMethod::compute_second_order_correction(const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers, Iterate& trial_iterate, Direction& direction) {
+      return this->active_method().compute_second_order_correction(problem, current_iterate, current_multipliers, trial_iterate, direction);
+   }
+
+   void InteriorPointCrossoverMethod::initialize_feasibility_problem(const l1RelaxedProblem& problem, Iterate& current_iterate) {
+      this->solving_feasibility_problem = true;
+      this->active_method().initialize_feasibility_problem(problem, current_iterate);
+      this->forward_subproblem_definition_change();
+   }
+
+   void InteriorPointCrossoverMethod::set_elastic_variable_values(const l1RelaxedProblem& problem, Iterate& current_iterate) {
+      this->active_method().set_elastic_variable_values(problem, current_iterate);
+   }
+
+   double InteriorPointCrossoverMethod::proximal_coefficient(const Iterate& current_iterate) const {
+      return this->active_method().proximal_coefficient(current_iterate);
+   }
+
+   void InteriorPointCrossoverMethod::exit_feasibility_problem(const OptimizationProblem& problem, Iterate& trial_iterate) {
+      this->solving_feasibility_problem = false;
+      this->active_method().exit_feasibility_problem(problem, trial_iterate);
+      this->forward_subproblem_definition_change();
+      // the active set is estimated anew
+      this->is_active_set_estimated = false;
+      this->number_stable_iterations = 0;
+   }
+
+   double InteriorPointCrossoverMethod::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      return this->active_method().hessian_quadratic_product(primal_direction);
+   }
+
+   void InteriorPointCrossoverMethod::set_auxiliary_measure(const Model& model, Iterate& iterate) {
+      this->active_method().set_auxiliary_measure(model, iterate);
+   }
+
+   double InteriorPointCrossoverMethod::compute_predicted_auxiliary_reduction_model(const Model& model, const Iterate& current_iterate,
+         const Vector<double>& primal_direction, double step_length) const {
+      return this->active_method().compute_predicted_auxiliary_reduction_model(model, current_iterate, primal_direction, step_length);
+   }
+
+   void InteriorPointCrossoverMethod::postprocess_iterate(const OptimizationProblem& problem, Iterate& iterate) {
+      this->active_method().postprocess_iterate(problem, iterate);
+   }
+
+   size_t InteriorPointCrossoverMethod::get_hessian_evaluation_count() const {
+      return this->interior_point_method->get_hessian_evaluation_count() + this->QP_method->get_hessian_evaluation_count();
+   }
+
+   size_t InteriorPointCrossoverMethod::get_peak_workspace_size() const {
+      return std::max(this->interior_point_method->get_peak_workspace_size(), this->QP_method->get_peak_workspace_size());
+   }
+
+   FactorizationStatistics InteriorPointCrossoverMethod::get_factorization_statistics() const {
+      FactorizationStatistics statistics = this->interior_point_method->get_factorization_statistics();
+      statistics.accumulate(this->QP_method->get_factorization_statistics());
+      return statistics;
+   }
+
+   // factors of the last interior point iteration (the crossover does not factorize the primal-dual system)
+   void InteriorPointCrossoverMethod::solve_sensitivity_systems(const Vector<double>& rhs, Vector<double>& result, size_t number_rhs) {
+      this->interior_point_method->solve_sensitivity_systems(rhs, result, number_rhs);
+   }
+
+   void InteriorPointCrossoverMethod::report_memory(MemoryReport& report) const {
+      this->interior_point_method->report_memory(report);
+      this->QP_method->report_memory(report);
+   }
+
+   void InteriorPointCrossoverMethod::set_initial_point(const Vector<double>& initial_point) {
+      this->interior_point_method->set_initial_point(initial_point);
+      this->QP_method->set_initial_point(initial_point);
+   }
+
+   InequalityHandlingMethod& InteriorPointCrossoverMethod::active_method() const {
+      if (this->crossover_performed) {
+         return *this->QP_method;
+      }
+      return *this->interior_point_method;
+   }
+
+   void InteriorPointCrossoverMethod::update_active_set_estimate(const OptimizationProblem& problem, const Iterate& current_iterate,
+         const Multipliers& current_multipliers) {
+      std::swap(this->active_set, this->previous_active_set);
+      // a bound is deemed active if its multiplier dominates the distance of the variable to the bound
+      for (size_t variable_index: Range(problem.number_variables)) {
+         const double primal = current_iterate.primals[variable_index];
+         const double lower_bound = problem.variable_lower_bound(variable_index);
+         const double upper_bound = problem.variable_upper_bound(variable_index);
+         int activity = 0;
+         if (is_finite(lower_bound) && primal - lower_bound <= current_multipliers.lower_bounds[variable_index]) {
+            activity = 1;
+         }
+         else if (is_finite(upper_bound) && upper_bound - primal <= -current_multipliers.upper_bounds[variable_index]) {
+            activity = -1;
+         }
+         this->active_set[variable_index] = activity;
+      }
+      const bool active_set_unchanged = this->is_active_set_estimated && std::equal(this->active_set.cbegin(), this->active_set.cbegin() +
+         static_cast<std::ptrdiff_t>(problem.number_variables), this->previous_active_set.cbegin());
+      this->number_stable_iterations = active_set_unchanged ? this->number_stable_iterations + 1 : 0;
+      this->is_active_set_estimated = true;
+      DEBUG << "Estimated active set unchanged for " << this->number_stable_iterations << " iterations\n";
+   }
+
+   // the reformulations signaled by the active method (e.g. barrier parameter updates) are signaled to the constraint relaxation strategy
+   void InteriorPointCrossoverMethod::forward_subproblem_definition_change() {
+      InequalityHandlingMethod& method = this->active_method();
+      this->subproblem_definition_changed = this->subproblem_definition_changed || method.subproblem_definition_changed;
+      method.subproblem_definition_changed = false;
+   }
+} // namespace
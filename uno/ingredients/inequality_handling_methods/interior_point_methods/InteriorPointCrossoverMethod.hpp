@@ -0,0 +1,77 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_INTERIORPOINTCROSSOVERMETHOD_H
+#define UNO_INTERIORPOINTCROSSOVERMETHOD_H
+
+#include <memory>
+#include <vector>
+#include "../InequalityHandlingMethod.hpp"
+
+namespace uno {
+   // forward references
+   class PrimalDualInteriorPointMethod;
+   class QPSubproblem;
+
+   /*! \class InteriorPointCrossoverMethod
+    * \brief Hybrid method: primal-dual interior-point iterations followed by a crossover to SQP iterations
+    *
+    *  At each accepted iterate, the active bounds are estimated from the bound multipliers of the interior-point method: a bound is
+    *  deemed active when its multiplier is larger than the distance of the variable to the bound. Since the model is reformulated with
+    *  slacks, the activity of the inequality constraints is that of the bounds of their slacks. Once the estimated active set has
+    *  remained unchanged for a given number of consecutive iterations, the QP subproblem takes over, warm-started from the primal-dual
+    *  point of the interior-point method. The crossover is final
+    */
+   class InteriorPointCrossoverMethod : public InequalityHandlingMethod {
+   public:
+      InteriorPointCrossoverMethod(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
+            size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options);
+      ~InteriorPointCrossoverMethod() override;
+
+      void initialize_statistics(Statistics& statistics, const Options& options) override;
+      void generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) override;
+      void forget_hessian_evaluation() override;
+      void solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
+            Direction& direction, WarmstartInformation& warmstart_information) override;
+      [[nodiscard]] bool compute_second_order_correction(const OptimizationProblem& problem, Iterate& current_iterate,
+            const Multipliers& current_multipliers, Iterate& trial_iterate, Direction& direction) override;
+
+      void initialize_feasibility_problem(const l1RelaxedProblem& problem, Iterate& current_iterate) override;
+      void set_elastic_variable_values(const l1RelaxedProblem& problem, Iterate& current_iterate) override;
+      [[nodiscard]] double proximal_coefficient(const Iterate& current_iterate) const override;
+      void exit_feasibility_problem(const OptimizationProblem& problem, Iterate& trial_iterate) override;
+
+      [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      void set_auxiliary_measure(const Model& model, Iterate& iterate) override;
+      [[nodiscard]] double compute_predicted_auxiliary_reduction_model(const Model& model, const Iterate& current_iterate,
+            const Vector<double>& primal_direction, double step_length) const override;
+
+      void postprocess_iterate(const OptimizationProblem& problem, Iterate& iterate) override;
+
+      [[nodiscard]] size_t get_hessian_evaluation_count() const override;
+      [[nodiscard]] size_t get_peak_workspace_size() const override;
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const override;
+      void solve_sensitivity_systems(const Vector<double>& rhs, Vector<double>& result, size_t number_rhs) override;
+      void report_memory(MemoryReport& report) const override;
+      void set_initial_point(const Vector<double>& initial_point) override;
+
+   protected:
+      const std::unique_ptr<PrimalDualInteriorPointMethod> interior_point_method;
+      const std::unique_ptr<QPSubproblem> QP_method;
+      bool crossover_performed{false};
+      bool solving_feasibility_problem{false};
+
+      // estimated activity of the bounds: +1 (lower bound), -1 (upper bound) or 0 (inactive)
+      std::vector<int> active_set;
+      std::vector<int> previous_active_set;
+      bool is_active_set_estimated{false};
+      size_t number_stable_iterations{0};
+      const size_t stable_active_set_iterations;
+
+      [[nodiscard]] InequalityHandlingMethod& active_method() const;
+      void update_active_set_estimate(const OptimizationProblem& problem, const Iterate& current_iterate, const Multipliers& current_multipliers);
+      void forward_subproblem_definition_change();
+   };
+} // namespace
+
+#endif // UNO_INTERIORPOINTCROSSOVERMETHOD_H
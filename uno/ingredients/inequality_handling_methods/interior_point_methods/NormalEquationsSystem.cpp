@@ -0,0 +1,153 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "NormalEquationsSystem.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   NormalEquationsSystem::NormalEquationsSystem(size_t number_variables, size_t number_constraints):
+         primal_diagonal(number_variables),
+         normal_matrix(number_constraints),
+         scattered_row(number_variables),
+         residual(number_variables + number_constraints),
+         correction(number_variables + number_constraints) {
+   }
+
+   std::unique_ptr<NormalEquationsSystem> NormalEquationsSystem::create(size_t number_variables, size_t number_constraints,
+         const Options& options) {
+      const std::string& mode = options.get_string("barrier_normal_equations");
+      if (mode != "auto" && mode != "yes" && mode != "no") {
+         throw std::invalid_argument("The value " + mode + " of barrier_normal_equations is unknown");
+      }
+      // the inexact solves work on the augmented system
+      if (mode == "no" || options.get_string("barrier_kkt_solver") == "MINRES" || number_constraints == 0 ||
+            NormalEquationsSystem::maximum_number_constraints < number_constraints) {
+         return nullptr;
+      }
+      // automatic mode: the m x m normal matrix should be much smaller than the augmented matrix
+      if (mode == "auto" && number_variables < 2 * number_constraints) {
+         return nullptr;
+      }
+      return std::make_unique<NormalEquationsSystem>(number_variables, number_constraints);
+   }
+
+   bool NormalEquationsSystem::assemble_primal_diagonal(const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& barrier_diagonal,
+         size_t number_variables) {
+      this->number_variables = number_variables;
+      for (size_t variable_index: Range(number_variables)) {
+         this->primal_diagonal[variable_index] = barrier_diagonal[variable_index];
+      }
+      bool is_diagonal = true;
+      hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+         if (row_index == column_index) {
+            this->primal_diagonal[row_index] += element;
+         }
+         else if (element != 0.) {
+            is_diagonal = false;
+         }
+      });
+      if (!is_diagonal) {
+         return false;
+      }
+      for (size_t variable_index: Range(number_variables)) {
+         if (this->primal_diagonal[variable_index] <= 0.) {
+            DEBUG << "The normal equations are not defined: the primal diagonal is not positive\n";
+            return false;
+         }
+      }
+      return true;
+   }
+
+   bool NormalEquationsSystem::factorize(const RectangularMatrixView<double>& constraint_jacobian, size_t number_constraints) {
+      this->number_constraints = number_constraints;
+      this->normal_matrix.resize(number_constraints);
+      this->normal_matrix.reset();
+      // (J D^-1 J^T)_ki = J_k . (D^-1 J_i), for k >= i
+      size_t number_jacobian_nonzeros = 0;
+      for (size_t constraint_index: Range(number_constraints)) {
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            this->scattered_row[variable_index] += derivative / this->primal_diagonal[variable_index];
+            number_jacobian_nonzeros++;
+         }
+         for (size_t other_constraint_index: Range(constraint_index, number_constraints)) {
+            double product = 0.;
+            for (const auto [variable_index, derivative]: constraint_jacobian[other_constraint_index]) {
+               product += derivative * this->scattered_row[variable_index];
+            }
+            this->normal_matrix.entry(other_constraint_index, constraint_index) = product;
+         }
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            this->scattered_row[variable_index] = 0.;
+         }
+      }
+      const size_t number_factor_nonzeros = number_constraints * (number_constraints + 1) / 2;
+      this->factorization_statistics.record_analysis(number_jacobian_nonzeros, number_factor_nonzeros);
+      const bool is_positive_definite = this->normal_matrix.factorize(NormalEquationsSystem::pivot_tolerance);
+      this->factorization_statistics.record_factorization(number_factor_nonzeros, std::pow(static_cast<double>(number_constraints), 3) / 3.,
+         this->normal_matrix.memory_size(), 0, 0, 0);
+      if (!is_positive_definite) {
+         DEBUG << "The normal matrix is not positive definite\n";
+      }
+      return is_positive_definite;
+   }
+
+   void NormalEquationsSystem::solve(const RectangularMatrixView<double>& constraint_jacobian, const Vector<double>& rhs, Vector<double>& solution) {
+      this->solve_once(constraint_jacobian, rhs.data(), solution.data());
+      // residual of the augmented system: [r_x; r_y] - [D dx + J^T y; J dx]
+      const size_t n = this->number_variables;
+      for (size_t variable_index: Range(n)) {
+         this->residual[variable_index] = rhs[variable_index] - this->primal_diagonal[variable_index] * solution[variable_index];
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         double constraint_residual = rhs[n + constraint_index];
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            this->residual[variable_index] -= derivative * solution[n + constraint_index];
+            constraint_residual -= derivative * solution[variable_index];
+         }
+         this->residual[n + constraint_index] = constraint_residual;
+      }
+      // one step of iterative refinement
+      this->solve_once(constraint_jacobian, this->residual.data(), this->correction.data());
+      for (size_t index: Range(n + this->number_constraints)) {
+         solution[index] += this->correction[index];
+      }
+   }
+
+   size_t NormalEquationsSystem::memory_size() const {
+      return this->primal_diagonal.memory_size() + this->normal_matrix.memory_size() + this->scattered_row.memory_size() +
+         this->residual.memory_size() + this->correction.memory_size();
+   }
+
+   void NormalEquationsSystem::solve_once(const RectangularMatrixView<double>& constraint_jacobian, const double* rhs, double* solution) {
+      const size_t n = this->number_variables;
+      // y solves (J D^-1 J^T) y = J D^-1 r_x - r_y
+      double* dual_solution = solution + n;
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         double product = -rhs[n + constraint_index];
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            product += derivative * rhs[variable_index] / this->primal_diagonal[variable_index];
+         }
+         dual_solution[constraint_index] = product;
+      }
+      this->normal_matrix.solve(dual_solution);
+      // dx = D^-1 (r_x - J^T y)
+      for (size_t variable_index: Range(n)) {
+         solution[variable_index] = rhs[variable_index];
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            solution[variable_index] -= derivative * dual_solution[constraint_index];
+         }
+      }
+      for (size_t variable_index: Range(n)) {
+         solution[variable_index] /= this->primal_diagonal[variable_index];
+      }
+   }
+} // namespace
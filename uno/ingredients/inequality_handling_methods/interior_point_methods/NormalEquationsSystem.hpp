@@ -0,0 +1,66 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NORMALEQUATIONSSYSTEM_H
+#define UNO_NORMALEQUATIONSSYSTEM_H
+
+#include <cstddef>
+#include <memory>
+#include "ingredients/subproblem_solvers/FactorizationStatistics.hpp"
+#include "linear_algebra/DenseCholesky.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declarations
+   class Options;
+   template <typename ElementType>
+   class RectangularMatrixView;
+   template <typename IndexType, typename ElementType>
+   class SymmetricMatrix;
+
+   /*! \class NormalEquationsSystem
+    * \brief Normal equations of the primal-dual augmented system with a diagonal primal block
+    *
+    *  The augmented system [D J^T; J 0] [dx; y] = [r_x; r_y], where D = diag(H) + Sigma is positive, is reduced to the m x m
+    *  positive definite system (J D^-1 J^T) y = J D^-1 r_x - r_y, then dx = D^-1 (r_x - J^T y). The normal matrix is formed row
+    *  by row (a dense column of J does not increase the cost of the product) and factorized with a dense Cholesky factorization.
+    *  The solution is refined once on the residual of the augmented system
+    */
+   class NormalEquationsSystem {
+   public:
+      NormalEquationsSystem(size_t number_variables, size_t number_constraints);
+      // nullptr if the normal equations are disabled (option barrier_normal_equations) or not worth it (m not much smaller than n)
+      [[nodiscard]] static std::unique_ptr<NormalEquationsSystem> create(size_t number_variables, size_t number_constraints,
+            const Options& options);
+
+      // returns false if the Hessian is not diagonal or D is not positive
+      [[nodiscard]] bool assemble_primal_diagonal(const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& barrier_diagonal,
+            size_t number_variables);
+      // returns false if the normal matrix is not numerically positive definite (e.g. J does not have full row rank)
+      [[nodiscard]] bool factorize(const RectangularMatrixView<double>& constraint_jacobian, size_t number_constraints);
+      // the vectors are laid out like those of the augmented system
+      void solve(const RectangularMatrixView<double>& constraint_jacobian, const Vector<double>& rhs, Vector<double>& solution);
+
+      [[nodiscard]] const FactorizationStatistics& get_factorization_statistics() const { return this->factorization_statistics; }
+      [[nodiscard]] size_t memory_size() const;
+
+   protected:
+      size_t number_variables{0};
+      size_t number_constraints{0};
+      Vector<double> primal_diagonal;
+      DenseCholesky<double> normal_matrix;
+      Vector<double> scattered_row; // row of J scaled by D^-1
+      Vector<double> residual;
+      Vector<double> correction;
+      FactorizationStatistics factorization_statistics{};
+
+      // the normal matrix is dense
+      static constexpr size_t maximum_number_constraints{1000};
+      // relative tolerance of the pivots of the Cholesky factorization
+      static constexpr double pivot_tolerance{1e-14};
+
+      void solve_once(const RectangularMatrixView<double>& constraint_jacobian, const double* rhs, double* solution);
+   };
+} // namespace
+
+#endif // UNO_NORMALEQUATIONSSYSTEM_H
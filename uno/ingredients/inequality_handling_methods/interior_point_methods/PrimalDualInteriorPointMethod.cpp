@@ -1,10 +1,13 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
 #include "PrimalDualInteriorPointMethod.hpp"
 #include "PrimalDualInteriorPointProblem.hpp"
 #include "ingredients/constraint_relaxation_strategies/l1RelaxedProblem.hpp"
+#include "ingredients/inequality_handling_methods/InequalityHandlingMethodFactory.hpp"
 #include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 #include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
 #include "linear_algebra/SparseStorageFactory.hpp"
@@ -13,28 +16,52 @@
 #include "optimization/WarmstartInformation.hpp"
 #include "preprocessing/Preprocessing.hpp"
 #include "symbolic/VectorView.hpp"
+#include "tools/ConcurrentTasks.hpp"
 #include "tools/Infinity.hpp"
+#include "tools/MemoryReport.hpp"
 
 namespace uno {
+   namespace {
+      // border [W; M] of the low-rank term: all the entries of W and the upper triangle of M
+      size_t border_number_nonzeros(size_t number_variables, size_t low_rank_dimension) {
+         return number_variables * low_rank_dimension + low_rank_dimension * (low_rank_dimension + 1) / 2;
+      }
+   } // namespace
+
    PrimalDualInteriorPointMethod::PrimalDualInteriorPointMethod(size_t number_variables, size_t number_constraints,
          size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options):
          InequalityHandlingMethod("exact", number_variables, number_hessian_nonzeros, false, options),
          objective_gradient(2 * number_variables), // original variables + barrier terms
          constraints(number_constraints),
-         constraint_jacobian(number_constraints, number_variables),
          hessian(number_variables, number_hessian_nonzeros, false, "COO"),
-         augmented_system(options.get_string("sparse_format"), number_variables + number_constraints,
+         hessian_low_rank_dimension(InequalityHandlingMethodFactory::hessian_low_rank_dimension(options)),
+         hessian_low_rank_factors(number_variables * this->hessian_low_rank_dimension),
+         hessian_middle_matrix(this->hessian_low_rank_dimension * this->hessian_low_rank_dimension),
+         middle_matrix_factorization(this->hessian_low_rank_dimension),
+         augmented_system(options.get_string("sparse_format"), number_variables + number_constraints + this->hessian_low_rank_dimension,
                number_hessian_nonzeros
                + number_variables /* diagonal barrier terms for bound constraints */
-               + number_jacobian_nonzeros /* Jacobian */,
+               + number_jacobian_nonzeros /* Jacobian */
+               + border_number_nonzeros(number_variables, this->hessian_low_rank_dimension) /* low-rank term */,
                true, /* use regularization */
-               options),
-         linear_solver(SymmetricIndefiniteLinearSolverFactory::create(number_variables + number_constraints,
+               options, 1 /* Fortran indices */),
+         linear_solver(options.get_string("barrier_kkt_solver") == "MINRES" ? nullptr :
+               SymmetricIndefiniteLinearSolverFactory::create<int>(number_variables + number_constraints + this->hessian_low_rank_dimension,
                number_hessian_nonzeros
                + number_variables + number_constraints /* regularization */
                + 2 * number_variables /* diagonal barrier terms */
-               + number_jacobian_nonzeros, /* Jacobian */
+               + number_jacobian_nonzeros /* Jacobian */
+               + border_number_nonzeros(number_variables, this->hessian_low_rank_dimension), /* low-rank term */
                options)),
+         iterative_solver(options.get_string("barrier_kkt_solver") == "MINRES" ?
+               std::make_unique<MINRESSolver<int, double>>(number_variables + number_constraints + this->hessian_low_rank_dimension, options) :
+               nullptr),
+         inexact_newton_factor(options.get_double("barrier_inexact_newton_factor")),
+         inexact_newton_max_tolerance(options.get_double("barrier_inexact_newton_max_tolerance")),
+         inexact_newton_min_tolerance(options.get_double("MINRES_relative_tolerance")),
+         normal_equations(NormalEquationsSystem::create(number_variables, number_constraints, options)),
+         curvature_regularization(this->linear_solver != nullptr && (options.get_string("regularization_test") == "curvature" ||
+               !this->linear_solver->provides_inertia())),
          barrier_parameter_update_strategy(options),
          previous_barrier_parameter(options.get_double("barrier_initial_parameter")),
          default_multiplier(options.get_double("barrier_default_multiplier")),
@@ -46,17 +73,68 @@ namespace uno {
                options.get_double("barrier_push_variable_to_interior_k1"),
                options.get_double("barrier_push_variable_to_interior_k2")
          }),
-         least_square_multiplier_max_norm(options.get_double("least_square_multiplier_max_norm")),
+         warm_start({
+               options.get_bool("barrier_warm_start"),
+               options.get_double("barrier_warm_start_bound_push"),
+               options.get_double("barrier_warm_start_bound_fraction"),
+               options.get_double("barrier_warm_start_multiplier_bound_push"),
+               options.get_double("barrier_warm_start_initial_parameter"),
+               options.get_bool("barrier_warm_start_least_square_multipliers")
+         }),
+         least_square_multiplier_solver((options.get_string("barrier_kkt_solver") == "MINRES" || number_constraints == 0) ? nullptr :
+               LeastSquareMultiplierSolver<int>::create(number_variables, number_constraints, number_jacobian_nonzeros, options,
+               1 /* Fortran indices */)),
          damping_factor(options.get_double("barrier_damping_factor")),
-         l1_constraint_violation_coefficient(options.get_double("l1_constraint_violation_coefficient")) {
+         l1_constraint_violation_coefficient(options.get_double("l1_constraint_violation_coefficient")),
+         condense_slacks(options.get_bool("barrier_condense_slacks")),
+         concurrent_evaluations(options.get_bool("barrier_concurrent_evaluations")),
+         predictor_corrector(options.get_bool("barrier_predictor_corrector")),
+         barrier_min_parameter(options.get_double("barrier_min_parameter")),
+         lower_bound_targets(number_variables),
+         upper_bound_targets(number_variables),
+         affine_primals(number_variables),
+         affine_multipliers(number_variables, number_constraints),
+         centering_primals(number_variables),
+         centering_multipliers(number_variables, number_constraints),
+         trial_primals(number_variables),
+         trial_multipliers(number_variables, number_constraints),
+         max_centrality_correctors(options.get_unsigned_int("barrier_centrality_correctors")),
+         adaptive_centrality_correctors(options.get_bool("barrier_adaptive_centrality_correctors")),
+         centrality_step_increase(options.get_double("barrier_centrality_step_increase")),
+         centrality_min_improvement(options.get_double("barrier_centrality_min_improvement")),
+         centrality_neighborhood(options.get_double("barrier_centrality_neighborhood")),
+         lower_bound_corrections(number_variables),
+         upper_bound_corrections(number_variables),
+         corrector_solution(number_variables + number_constraints + this->hessian_low_rank_dimension),
+         second_order_constraints(number_constraints),
+         trial_constraints(number_constraints),
+         barrier_diagonal(number_variables) {
+      const std::string& regularization_test = options.get_string("regularization_test");
+      if (regularization_test != "inertia" && regularization_test != "curvature") {
+         throw std::invalid_argument("The regularization test " + regularization_test + " is unknown");
+      }
+      if (this->centrality_neighborhood < 1.) {
+         throw std::invalid_argument("The centrality neighborhood barrier_centrality_neighborhood should be at least 1");
+      }
    }
 
    void PrimalDualInteriorPointMethod::initialize_statistics(Statistics& statistics, const Options& options) {
       statistics.add_column("regulariz", Statistics::double_width - 4, options.get_int("statistics_regularization_column_order"));
+      statistics.add_column("factoriz", Statistics::int_width + 3, options.get_int("statistics_factorizations_column_order"));
+      statistics.add_column("fact time", Statistics::double_width - 4, options.get_int("statistics_factorization_time_column_order"));
+      statistics.add_column("fill", Statistics::double_width - 4, options.get_int("statistics_fill_column_order"));
+      statistics.add_column("delayed", Statistics::int_width + 2, options.get_int("statistics_delayed_pivots_column_order"));
       statistics.add_column("barrier", Statistics::double_width - 5, options.get_int("statistics_barrier_parameter_column_order"));
    }
 
-   void PrimalDualInteriorPointMethod::generate_initial_iterate(const OptimizationProblem& problem, Iterate& initial_iterate) {
+   void PrimalDualInteriorPointMethod::generate_initial_iterate(Statistics& /*statistics*/, const OptimizationProblem& problem, Iterate& initial_iterate) {
+      // the bounds may have changed since the previous solve
+      this->problem_bounds.invalidate();
+      this->model_bounds.invalidate();
+      // so may the values of the constant derivatives (e.g. re-solve of a modified model)
+      this->constant_jacobian_problem = nullptr;
+      this->constant_hessian_problem = nullptr;
+      this->problem_bounds.update(problem);
       if (problem.has_inequality_constraints()) {
          throw std::runtime_error("The problem has inequality constraints. Create an instance of HomogeneousEqualityConstrainedModel");
       }
@@ -72,14 +150,32 @@ namespace uno {
       // add the slacks to the initial iterate
       initial_iterate.set_number_variables(problem.number_variables);
       // make the initial point strictly feasible wrt the bounds
+      bool is_point_pushed = false;
       for (size_t variable_index: Range(problem.number_variables)) {
-         initial_iterate.primals[variable_index] = PrimalDualInteriorPointMethod::push_variable_to_interior(initial_iterate.primals[variable_index],
+         const double pushed_value = PrimalDualInteriorPointMethod::push_variable_to_interior(initial_iterate.primals[variable_index],
                problem.variable_lower_bound(variable_index), problem.variable_upper_bound(variable_index));
+         is_point_pushed = is_point_pushed || (pushed_value != initial_iterate.primals[variable_index]);
+         initial_iterate.primals[variable_index] = pushed_value;
+      }
+      // the evaluations of an initial iterate that was already evaluated (e.g. a warm start from a previous solution) are outdated
+      if (is_point_pushed) {
+         initial_iterate.is_objective_computed = false;
+         initial_iterate.is_objective_gradient_computed = false;
+         initial_iterate.are_constraints_computed = false;
+         initial_iterate.is_constraint_jacobian_computed = false;
       }
 
       // set the slack variables (if any)
       if (!problem.model.get_slacks().is_empty()) {
-         // evaluate the constraints at the original point
+         // evaluate the constraints at the original point. The slacks of a warm start (e.g. a previous solution) are discarded
+         bool has_nonzero_slack = false;
+         for (const auto [constraint_index, slack_index]: problem.model.get_slacks()) {
+            has_nonzero_slack = has_nonzero_slack || (initial_iterate.primals[slack_index] != 0.);
+            initial_iterate.primals[slack_index] = 0.;
+         }
+         if (has_nonzero_slack) {
+            initial_iterate.are_constraints_computed = false;
+         }
          initial_iterate.evaluate_constraints(problem.model);
 
          // set the slacks to the constraint values
@@ -93,56 +189,165 @@ namespace uno {
          initial_iterate.is_constraint_jacobian_computed = false;
       }
 
+      // a new solve starts from the initial barrier parameter
+      this->barrier_parameter_update_strategy.reset();
+      this->previous_barrier_parameter = this->barrier_parameter_update_strategy.get_barrier_parameter();
+      this->solving_feasibility_problem = false;
+      this->first_feasibility_iteration = false;
+
       // set the bound multipliers
-      for (const size_t variable_index: problem.get_lower_bounded_variables()) {
-         initial_iterate.multipliers.lower_bounds[variable_index] = this->default_multiplier;
+      if (this->warm_start.enabled) {
+         this->barrier_parameter_update_strategy.set_barrier_parameter(this->warm_start.initial_barrier_parameter);
+         this->previous_barrier_parameter = this->warm_start.initial_barrier_parameter;
+         this->set_warm_start_bound_multipliers(initial_iterate);
       }
-      for (const size_t variable_index: problem.get_upper_bounded_variables()) {
-         initial_iterate.multipliers.upper_bounds[variable_index] = -this->default_multiplier;
+      else {
+         for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+            const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+            initial_iterate.multipliers.lower_bounds[variable_index] = this->default_multiplier;
+         }
+         for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+            const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+            initial_iterate.multipliers.upper_bounds[variable_index] = -this->default_multiplier;
+         }
       }
 
-      // compute least-square multipliers
-      if (problem.is_constrained()) {
+      // compute least-square multipliers (a warm start keeps the constraint multipliers of the initial iterate by default)
+      if (problem.is_constrained() && (!this->warm_start.enabled || this->warm_start.least_square_multipliers)) {
          this->compute_least_square_multipliers(problem, initial_iterate, initial_iterate.multipliers.constraints);
       }
    }
 
+   // bound multipliers of a warm start: the given multipliers are pushed away from zero. The missing (zero or wrongly signed) multipliers
+   // are set such that the complementarity products equal the initial barrier parameter
+   void PrimalDualInteriorPointMethod::set_warm_start_bound_multipliers(Iterate& initial_iterate) const {
+      const double barrier_parameter = this->warm_start.initial_barrier_parameter;
+      for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+         const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+         double& multiplier = initial_iterate.multipliers.lower_bounds[variable_index];
+         if (multiplier <= 0.) {
+            const double distance_to_bound = initial_iterate.primals[variable_index] - this->problem_bounds.lower.bounds[bound_index];
+            multiplier = barrier_parameter / distance_to_bound;
+         }
+         multiplier = std::max(multiplier, this->warm_start.multiplier_bound_push);
+      }
+      for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+         const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+         double& multiplier = initial_iterate.multipliers.upper_bounds[variable_index];
+         if (0. <= multiplier) {
+            const double distance_to_bound = initial_iterate.primals[variable_index] - this->problem_bounds.upper.bounds[bound_index];
+            multiplier = barrier_parameter / distance_to_bound;
+         }
+         multiplier = std::min(multiplier, -this->warm_start.multiplier_bound_push);
+      }
+   }
+
    double PrimalDualInteriorPointMethod::barrier_parameter() const {
       return this->barrier_parameter_update_strategy.get_barrier_parameter();
    }
 
    double PrimalDualInteriorPointMethod::push_variable_to_interior(double variable_value, double lower_bound, double upper_bound) const {
+      // a warm start uses smaller perturbations
+      const double k1 = this->warm_start.enabled ? this->warm_start.bound_push : this->parameters.push_variable_to_interior_k1;
+      const double k2 = this->warm_start.enabled ? this->warm_start.bound_fraction : this->parameters.push_variable_to_interior_k2;
       const double range = upper_bound - lower_bound;
-      const double perturbation_lb = std::min(this->parameters.push_variable_to_interior_k1 * std::max(1., std::abs(lower_bound)),
-            this->parameters.push_variable_to_interior_k2 * range);
-      const double perturbation_ub = std::min(this->parameters.push_variable_to_interior_k1 * std::max(1., std::abs(upper_bound)),
-            this->parameters.push_variable_to_interior_k2 * range);
+      const double perturbation_lb = std::min(k1 * std::max(1., std::abs(lower_bound)), k2 * range);
+      const double perturbation_ub = std::min(k1 * std::max(1., std::abs(upper_bound)), k2 * range);
       variable_value = std::max(variable_value, lower_bound + perturbation_lb);
       variable_value = std::min(variable_value, upper_bound - perturbation_ub);
       return variable_value;
    }
 
-   void PrimalDualInteriorPointMethod::evaluate_functions(Statistics& statistics, const PrimalDualInteriorPointProblem& barrier_problem,
-         Iterate& current_iterate, const Multipliers& current_multipliers, const WarmstartInformation& warmstart_information) {
+   void PrimalDualInteriorPointMethod::evaluate_functions(Statistics& statistics, const OptimizationProblem& problem,
+         const PrimalDualInteriorPointProblem& barrier_problem, Iterate& current_iterate, const Multipliers& current_multipliers, const WarmstartInformation& warmstart_information) {
       // barrier objective gradient
-      if (warmstart_information.objective_changed) {
-         barrier_problem.evaluate_objective_gradient(current_iterate, this->objective_gradient);
-      }
+      const auto evaluate_objective_gradient = [&]() {
+         if (warmstart_information.objective_changed) {
+            barrier_problem.evaluate_objective_gradient(current_iterate, this->objective_gradient);
+         }
+      };
 
       // constraints and Jacobian
-      if (warmstart_information.constraints_changed) {
-         barrier_problem.evaluate_constraints(current_iterate, this->constraints);
-         barrier_problem.evaluate_constraint_jacobian(current_iterate, this->constraint_jacobian);
+      bool jacobian_changed = false;
+      const auto evaluate_constraints = [&]() {
+         if (warmstart_information.constraints_changed) {
+            barrier_problem.evaluate_constraints(current_iterate, this->constraints);
+            // the view is rebound at no cost: the Jacobian is not copied
+            barrier_problem.evaluate_constraint_jacobian(current_iterate, this->constraint_jacobian);
+            // linear constraints: the Jacobian block of the augmented matrix is still current
+            if (!problem.has_constant_jacobian() || this->constant_jacobian_problem != &problem) {
+               this->constant_jacobian_problem = problem.has_constant_jacobian() ? &problem : nullptr;
+               jacobian_changed = true;
+            }
+         }
+      };
+
+      // Lagrangian Hessian (without the barrier terms)
+      bool hessian_changed = false;
+      const auto evaluate_hessian = [&]() {
+         if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
+            const bool is_hessian_current = problem.has_constant_hessian() && this->constant_hessian_problem == &problem &&
+               this->constant_hessian_objective_multiplier == problem.get_objective_multiplier();
+            if (!is_hessian_current) {
+               this->hessian_model->evaluate(statistics, problem, current_iterate.primals, current_multipliers.constraints, this->hessian);
+               if (0 < this->hessian_low_rank_dimension) {
+                  this->evaluate_hessian_low_rank_term(problem);
+               }
+               this->constant_hessian_problem = problem.has_constant_hessian() ? &problem : nullptr;
+               this->constant_hessian_objective_multiplier = problem.get_objective_multiplier();
+               hessian_changed = true;
+            }
+         }
+      };
+
+      // the barrier terms form a separate diagonal layer of the augmented matrix
+      const auto evaluate_barrier_diagonal = [&]() {
+         this->evaluate_barrier_diagonal(current_iterate.primals, current_multipliers);
+      };
+
+      // the evaluations are independent: they write into separate members and evaluation flags of the iterate
+      run_concurrently(this->concurrent_evaluations && problem.model.supports_concurrent_evaluations(), evaluate_objective_gradient,
+            evaluate_constraints, evaluate_hessian, evaluate_barrier_diagonal);
+      // if the derivatives are constant, only the diagonal layer of the augmented matrix is updated
+      this->matrix_values_changed = jacobian_changed || hessian_changed;
+   }
+
+   void PrimalDualInteriorPointMethod::evaluate_hessian_low_rank_term(const OptimizationProblem& problem) {
+      if (problem.model.hessian_low_rank_dimension() != this->hessian_low_rank_dimension) {
+         throw std::runtime_error("The low-rank term of the Hessian model does not match the augmented system of the interior-point method");
       }
+      problem.evaluate_hessian_low_rank_term(this->hessian_low_rank_factors, this->hessian_middle_matrix);
+      this->augmented_system.set_low_rank_term(this->hessian_low_rank_factors, this->hessian_middle_matrix, problem.number_variables,
+            this->hessian_low_rank_dimension);
+      // factors of M for the curvature term of the subproblem objective
+      for (size_t column_index: Range(this->hessian_low_rank_dimension)) {
+         for (size_t row_index: Range(column_index, this->hessian_low_rank_dimension)) {
+            this->middle_matrix_factorization.entry(row_index, column_index) =
+               this->hessian_middle_matrix[row_index + column_index * this->hessian_low_rank_dimension];
+         }
+      }
+      this->middle_matrix_factorization.factorize();
+   }
 
-      // barrier Lagrangian Hessian
-      if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
-         this->hessian_model->evaluate(statistics, barrier_problem, current_iterate.primals, current_multipliers.constraints, this->hessian);
+   // diagonal barrier terms Sigma = Z_L / (X - X_L) + Z_U / (X - X_U)
+   void PrimalDualInteriorPointMethod::evaluate_barrier_diagonal(const Vector<double>& primals, const Multipliers& multipliers) {
+      // the terms beyond the current number of variables are also reset
+      this->barrier_diagonal.fill(0.);
+      for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+         const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+         const double distance_to_bound = primals[variable_index] - this->problem_bounds.lower.bounds[bound_index];
+         this->barrier_diagonal[variable_index] += multipliers.lower_bounds[variable_index] / distance_to_bound;
+      }
+      for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+         const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+         const double distance_to_bound = primals[variable_index] - this->problem_bounds.upper.bounds[bound_index];
+         this->barrier_diagonal[variable_index] += multipliers.upper_bounds[variable_index] / distance_to_bound;
       }
    }
 
    void PrimalDualInteriorPointMethod::solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
          const Multipliers& current_multipliers, Direction& direction, WarmstartInformation& warmstart_information) {
+      this->problem_bounds.update(problem);
       if (problem.has_inequality_constraints()) {
          throw std::runtime_error("The problem has inequality constraints. Create an instance of HomogeneousEqualityConstrainedModel");
       }
@@ -150,55 +355,195 @@ namespace uno {
          throw std::runtime_error("The interior-point subproblem has a trust region. This is not implemented yet");
       }
 
-      // possibly update the barrier parameter
+      // possibly update the barrier parameter (the predictor-corrector variant updates it after the predictor step)
       const auto& residuals = this->solving_feasibility_problem ? current_iterate.feasibility_residuals : current_iterate.residuals;
-      if (!this->first_feasibility_iteration) {
-         this->update_barrier_parameter(problem, current_iterate, current_multipliers, residuals);
+      const bool update_barrier_parameter = !this->first_feasibility_iteration;
+      if (update_barrier_parameter) {
+         if (!this->predictor_corrector) {
+            this->update_barrier_parameter(problem, current_iterate, current_multipliers, residuals);
+         }
       }
       else {
          this->first_feasibility_iteration = false;
       }
-      statistics.set("barrier", this->barrier_parameter());
 
       // create a barrier problem
       PrimalDualInteriorPointProblem barrier_problem(problem, current_multipliers, this->barrier_parameter());
 
       // evaluate the functions at the current iterate
-      this->evaluate_functions(statistics, barrier_problem, current_iterate, current_multipliers, warmstart_information);
+      this->evaluate_functions(statistics, problem, barrier_problem, current_iterate, current_multipliers, warmstart_information);
 
       // compute the primal-dual solution
       this->assemble_augmented_system(statistics, problem, current_multipliers, warmstart_information);
-      this->augmented_system.solve(*this->linear_solver);
+      this->set_complementarity_targets(this->barrier_parameter());
+      if (update_barrier_parameter) {
+         // the additional solves share the factorization
+         if (this->predictor_corrector) {
+            this->compute_predictor_corrector_rhs(problem, current_iterate, current_multipliers);
+         }
+         else if (this->barrier_parameter_update_strategy.requires_quality_function()) {
+            this->compute_quality_function_rhs(problem, current_iterate, current_multipliers, residuals);
+         }
+      }
+      statistics.set("barrier", this->barrier_parameter());
+      // the curvature test of the inexact solves has already solved the system, unless the rhs has changed
+      if (!this->is_solution_current) {
+         this->solve_augmented_system();
+      }
+      this->compute_centrality_correctors(problem, current_iterate.primals, current_multipliers);
       assert(direction.status == SubproblemStatus::OPTIMAL && "The primal-dual perturbed subproblem was not solved to optimality");
       this->number_subproblems_solved++;
 
       this->assemble_primal_dual_direction(problem, current_iterate.primals, current_multipliers, direction.primals, direction.multipliers);
       direction.subproblem_objective = this->evaluate_subproblem_objective(direction);
+      this->number_second_order_corrections = 0;
+   }
+
+   // second-order correction (Section 2.4 in IPOPT paper): the rhs of the constraints is replaced with the accumulated constraint values
+   // c_soc = alpha c_soc + c(x_trial), where alpha is the step length of the previous (corrected) direction. The factorization is reused
+   bool PrimalDualInteriorPointMethod::compute_second_order_correction(const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers, Iterate& trial_iterate, Direction& direction) {
+      this->problem_bounds.update(problem);
+      if (!problem.is_constrained()) {
+         return false;
+      }
+      if (this->number_second_order_corrections == 0) {
+         this->second_order_constraints = this->constraints;
+      }
+      this->number_second_order_corrections++;
+      problem.evaluate_constraints(trial_iterate, this->trial_constraints);
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         this->second_order_constraints[constraint_index] = this->primal_step_length * this->second_order_constraints[constraint_index] +
+            this->trial_constraints[constraint_index];
+         this->augmented_system.rhs[problem.number_variables + constraint_index] = -this->second_order_constraints[constraint_index];
+      }
+      this->solve_augmented_system();
+      DEBUG << "Second-order correction " << this->number_second_order_corrections << '\n';
+      this->assemble_primal_dual_direction(problem, current_iterate.primals, current_multipliers, direction.primals, direction.multipliers);
+      direction.subproblem_objective = this->evaluate_subproblem_objective(direction);
+      return true;
    }
 
    double PrimalDualInteriorPointMethod::hessian_quadratic_product(const Vector<double>& /*primal_direction*/) const {
       throw std::runtime_error("PrimalDualInteriorPointMethod::hessian_quadratic_product not implemented");
    }
 
+   // stages of the rows of the augmented matrix: the primal variables, then the constraints (see Model::get_stages)
+   void PrimalDualInteriorPointMethod::set_stage_partition(const OptimizationProblem& problem) {
+      if (this->linear_solver == nullptr) {
+         return;
+      }
+      std::vector<size_t> variable_stages{}, constraint_stages{};
+      if (!problem.get_stages(variable_stages, constraint_stages)) {
+         this->linear_solver->set_stage_partition({});
+         return;
+      }
+      variable_stages.insert(variable_stages.end(), constraint_stages.cbegin(), constraint_stages.cend());
+      this->linear_solver->set_stage_partition(variable_stages);
+   }
+
    void PrimalDualInteriorPointMethod::assemble_augmented_system(Statistics& statistics, const OptimizationProblem& problem,
          const Multipliers& current_multipliers, WarmstartInformation& warmstart_information) {
-      // assemble, factorize and regularize the augmented matrix
-      this->augmented_system.assemble_matrix(this->hessian, this->constraint_jacobian, problem.number_variables, problem.number_constraints);
-      DEBUG << "Testing factorization with regularization factors (0, 0)\n";
-      this->augmented_system.factorize_matrix(*this->linear_solver, warmstart_information);
+      // with a diagonal Hessian and a positive primal block, the normal equations are factorized instead of the augmented matrix. The
+      // augmented system takes over if they are not positive definite
+      if (this->normal_equations != nullptr && 0 < problem.number_constraints && this->hessian_low_rank_dimension == 0) {
+         this->use_normal_equations = this->normal_equations->assemble_primal_diagonal(this->hessian, this->barrier_diagonal,
+               problem.number_variables) && this->normal_equations->factorize(this->constraint_jacobian, problem.number_constraints);
+         if (this->use_normal_equations) {
+            DEBUG << "Factorizing the normal equations\n";
+            this->is_augmented_matrix_outdated = this->is_augmented_matrix_outdated || this->matrix_values_changed;
+            this->number_factorizations++;
+            statistics.set("regulariz", 0.);
+            statistics.set("factoriz", size_t(1));
+            statistics.set("fill", this->normal_equations->get_factorization_statistics().fill());
+            this->assemble_augmented_rhs(current_multipliers, problem.number_variables, problem.number_constraints);
+            return;
+         }
+      }
+
+      // assemble, factorize and regularize the augmented matrix. The slacks are possibly eliminated (condensed system).
+      // If only the barrier terms changed, the diagonal layer is updated in place
+      this->augmented_system.set_primal_diagonal(this->barrier_diagonal, problem.number_variables);
+      if (!this->matrix_values_changed && !this->is_augmented_matrix_outdated && !warmstart_information.hessian_sparsity_changed &&
+            !warmstart_information.jacobian_sparsity_changed &&
+            this->augmented_system.can_update_primal_diagonal(problem.number_variables, problem.number_constraints)) {
+         DEBUG << "Updating the barrier terms of the augmented matrix in place\n";
+         this->augmented_system.update_primal_diagonal();
+      }
+      else if (this->condense_slacks && !problem.model.get_slacks().is_empty() && this->hessian_low_rank_dimension == 0) {
+         // the rows of the condensed matrix are not those of the problem: the stages are computed by the linear solver
+         if (this->linear_solver != nullptr) {
+            this->linear_solver->set_stage_partition({});
+         }
+         this->augmented_system.assemble_condensed_matrix(this->hessian, this->constraint_jacobian, problem.number_variables,
+               problem.number_constraints, problem.model.get_slacks());
+      }
+      else {
+         if (warmstart_information.hessian_sparsity_changed || warmstart_information.jacobian_sparsity_changed) {
+            this->set_stage_partition(problem);
+         }
+         this->augmented_system.assemble_matrix(this->hessian, this->constraint_jacobian, problem.number_variables, problem.number_constraints,
+               warmstart_information);
+      }
+      this->is_augmented_matrix_outdated = false;
+      const size_t size_primal_block = this->augmented_system.primal_block_dimension();
       const double dual_regularization_parameter = std::pow(this->barrier_parameter(), this->parameters.regularization_exponent);
-      this->augmented_system.regularize_matrix(statistics, *this->linear_solver, problem.number_variables, problem.number_constraints,
-            dual_regularization_parameter, warmstart_information);
+      if (this->iterative_solver != nullptr) {
+         // inexact Newton: the tolerance decreases with the barrier parameter. The regularization is determined by a curvature test on
+         // the solution of the system
+         this->iterative_solver->set_primal_block_dimension(size_primal_block);
+         this->iterative_solver->set_relative_tolerance(std::max(this->inexact_newton_min_tolerance,
+               std::min(this->inexact_newton_max_tolerance, this->inexact_newton_factor * this->barrier_parameter())));
+         this->assemble_augmented_rhs(current_multipliers, problem.number_variables, problem.number_constraints);
+         this->augmented_system.solve_and_regularize_by_curvature(statistics, *this->iterative_solver, size_primal_block,
+               problem.number_constraints, dual_regularization_parameter);
+         this->is_solution_current = true;
+         return;
+      }
+      if (this->curvature_regularization) {
+         // the regularization is determined by a curvature test on the solution of the factorized system
+         this->assemble_augmented_rhs(current_multipliers, problem.number_variables, problem.number_constraints);
+         this->augmented_system.factorize_and_regularize_by_curvature(statistics, *this->linear_solver, size_primal_block,
+               problem.number_constraints, dual_regularization_parameter, warmstart_information);
+         this->number_factorizations += this->augmented_system.get_number_factorizations();
+         this->is_solution_current = true;
+         return;
+      }
+      this->augmented_system.factorize_and_regularize_matrix(statistics, *this->linear_solver, size_primal_block,
+            problem.number_constraints, dual_regularization_parameter, warmstart_information);
+      this->number_factorizations += this->augmented_system.get_number_factorizations();
 
-      // check the inertia
-      [[maybe_unused]] auto [number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues] = this->linear_solver->get_inertia();
-      assert(number_pos_eigenvalues == problem.number_variables && number_neg_eigenvalues == problem.number_constraints &&
-         number_zero_eigenvalues == 0);
+      // check the inertia (the border of the low-rank term contributes as many positive as negative eigenvalues)
+      [[maybe_unused]] auto [number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues] =
+            this->augmented_system.active_solver(*this->linear_solver).get_inertia();
+      assert(number_pos_eigenvalues == size_primal_block + this->hessian_low_rank_dimension / 2 &&
+         number_neg_eigenvalues == problem.number_constraints + this->hessian_low_rank_dimension / 2 && number_zero_eigenvalues == 0);
 
       // rhs
       this->assemble_augmented_rhs(current_multipliers, problem.number_variables, problem.number_constraints);
    }
 
+   SymmetricIndefiniteLinearSolver<int, double>& PrimalDualInteriorPointMethod::augmented_system_solver() const {
+      if (this->iterative_solver != nullptr) {
+         return *this->iterative_solver;
+      }
+      return *this->linear_solver;
+   }
+
+   // iterative refinement is pointless for inexact (iterative) solves. The direct solves are refined, and refactorized with a larger
+   // pivot tolerance if the refined solution remains inaccurate
+   void PrimalDualInteriorPointMethod::solve_augmented_system() {
+      if (this->use_normal_equations) {
+         this->normal_equations->solve(this->constraint_jacobian, this->augmented_system.rhs, this->augmented_system.solution);
+         return;
+      }
+      if (this->iterative_solver != nullptr) {
+         this->augmented_system.solve(*this->iterative_solver, false);
+         return;
+      }
+      this->augmented_system.solve_and_increase_accuracy(*this->linear_solver);
+   }
+
    void PrimalDualInteriorPointMethod::initialize_feasibility_problem(const l1RelaxedProblem& /*problem*/, Iterate& current_iterate) {
       this->solving_feasibility_problem = true;
       this->first_feasibility_iteration = true;
@@ -259,20 +604,25 @@ namespace uno {
    }
 
    void PrimalDualInteriorPointMethod::set_auxiliary_measure(const Model& model, Iterate& iterate) {
+      this->model_bounds.update(model);
       // auxiliary measure: barrier terms
       double barrier_terms = 0.;
-      for (const size_t variable_index: model.get_lower_bounded_variables()) {
-         barrier_terms -= std::log(iterate.primals[variable_index] - model.variable_lower_bound(variable_index));
+      for (size_t bound_index: Range(this->model_bounds.lower.size())) {
+         const size_t variable_index = this->model_bounds.lower.variables[bound_index];
+         barrier_terms -= std::log(iterate.primals[variable_index] - this->model_bounds.lower.bounds[bound_index]);
       }
-      for (const size_t variable_index: model.get_upper_bounded_variables()) {
-         barrier_terms -= std::log(model.variable_upper_bound(variable_index) - iterate.primals[variable_index]);
+      for (size_t bound_index: Range(this->model_bounds.upper.size())) {
+         const size_t variable_index = this->model_bounds.upper.variables[bound_index];
+         barrier_terms -= std::log(this->model_bounds.upper.bounds[bound_index] - iterate.primals[variable_index]);
       }
       // damping
-      for (const size_t variable_index: model.get_single_lower_bounded_variables()) {
-         barrier_terms += this->damping_factor*(iterate.primals[variable_index] - model.variable_lower_bound(variable_index));
+      for (size_t bound_index: Range(this->model_bounds.single_lower.size())) {
+         const size_t variable_index = this->model_bounds.single_lower.variables[bound_index];
+         barrier_terms += this->damping_factor*(iterate.primals[variable_index] - this->model_bounds.single_lower.bounds[bound_index]);
       }
-      for (const size_t variable_index: model.get_single_upper_bounded_variables()) {
-         barrier_terms += this->damping_factor*(model.variable_upper_bound(variable_index) - iterate.primals[variable_index]);
+      for (size_t bound_index: Range(this->model_bounds.single_upper.size())) {
+         const size_t variable_index = this->model_bounds.single_upper.variables[bound_index];
+         barrier_terms += this->damping_factor*(this->model_bounds.single_upper.bounds[bound_index] - iterate.primals[variable_index]);
       }
       barrier_terms *= this->barrier_parameter();
       assert(!std::isnan(barrier_terms) && "The auxiliary measure is not an number.");
@@ -288,20 +638,25 @@ namespace uno {
 
    double PrimalDualInteriorPointMethod::compute_barrier_term_directional_derivative(const Model& model, const Iterate& current_iterate,
          const Vector<double>& primal_direction) const {
+      this->model_bounds.update(model);
       double directional_derivative = 0.;
-      for (const size_t variable_index: model.get_lower_bounded_variables()) {
+      for (size_t bound_index: Range(this->model_bounds.lower.size())) {
+         const size_t variable_index = this->model_bounds.lower.variables[bound_index];
          directional_derivative += -this->barrier_parameter() / (current_iterate.primals[variable_index] -
-                                                                 model.variable_lower_bound(variable_index)) * primal_direction[variable_index];
+                                                                 this->model_bounds.lower.bounds[bound_index]) * primal_direction[variable_index];
       }
-      for (const size_t variable_index: model.get_upper_bounded_variables()) {
+      for (size_t bound_index: Range(this->model_bounds.upper.size())) {
+         const size_t variable_index = this->model_bounds.upper.variables[bound_index];
          directional_derivative += -this->barrier_parameter() / (current_iterate.primals[variable_index] -
-                                                                 model.variable_upper_bound(variable_index)) * primal_direction[variable_index];
+                                                                 this->model_bounds.upper.bounds[bound_index]) * primal_direction[variable_index];
       }
       // damping
-      for (const size_t variable_index: model.get_single_lower_bounded_variables()) {
+      for (size_t bound_index: Range(this->model_bounds.single_lower.size())) {
+         const size_t variable_index = this->model_bounds.single_lower.variables[bound_index];
          directional_derivative += this->damping_factor * this->barrier_parameter() * primal_direction[variable_index];
       }
-      for (const size_t variable_index: model.get_single_upper_bounded_variables()) {
+      for (size_t bound_index: Range(this->model_bounds.single_upper.size())) {
+         const size_t variable_index = this->model_bounds.single_upper.variables[bound_index];
          directional_derivative -= this->damping_factor * this->barrier_parameter() * primal_direction[variable_index];
       }
       return directional_derivative;
@@ -328,59 +683,56 @@ namespace uno {
 
    double PrimalDualInteriorPointMethod::evaluate_subproblem_objective(const Direction& direction) const {
       const double linear_term = dot(direction.primals, this->objective_gradient);
-      const double quadratic_term = this->hessian.quadratic_product(direction.primals, direction.primals) / 2.;
-      return linear_term + quadratic_term;
-   }
-
-   // TODO use a single function for primal and dual fraction-to-boundary rules
-   double PrimalDualInteriorPointMethod::primal_fraction_to_boundary(const OptimizationProblem& problem, const Vector<double>& current_primals,
-         const Vector<double>& primal_direction, double tau) {
-      double step_length = 1.;
-      for (const size_t variable_index: problem.get_lower_bounded_variables()) {
-         if (primal_direction[variable_index] < 0.) {
-            double distance = -tau * (current_primals[variable_index] - problem.variable_lower_bound(variable_index)) / primal_direction[variable_index];
-            if (0. < distance) {
-               step_length = std::min(step_length, distance);
-            }
-         }
+      double quadratic_term = this->hessian.quadratic_product(direction.primals, direction.primals);
+      for (size_t variable_index: Range(direction.primals.size())) {
+         quadratic_term += this->barrier_diagonal[variable_index] * std::pow(direction.primals[variable_index], 2);
       }
-      for (const size_t variable_index: problem.get_upper_bounded_variables()) {
-         if (0. < primal_direction[variable_index]) {
-            double distance = -tau * (current_primals[variable_index] - problem.variable_upper_bound(variable_index)) / primal_direction[variable_index];
-            if (0. < distance) {
-               step_length = std::min(step_length, distance);
+      // low-rank term -d^T W M^{-1} W^T d
+      if (0 < this->hessian_low_rank_dimension) {
+         const size_t number_variables = direction.number_variables;
+         std::vector<double> projection(this->hessian_low_rank_dimension);
+         for (size_t column_index: Range(this->hessian_low_rank_dimension)) {
+            for (size_t variable_index: Range(number_variables)) {
+               projection[column_index] += this->hessian_low_rank_factors[variable_index + column_index * number_variables] *
+                  direction.primals[variable_index];
             }
          }
+         std::vector<double> solution = projection;
+         this->middle_matrix_factorization.solve(solution.data());
+         for (size_t column_index: Range(this->hessian_low_rank_dimension)) {
+            quadratic_term -= projection[column_index] * solution[column_index];
+         }
       }
-      assert(0. < step_length && step_length <= 1. && "The primal fraction-to-boundary step length is not in (0, 1]");
-      return step_length;
+      quadratic_term /= 2.;
+      return linear_term + quadratic_term;
    }
 
-   double PrimalDualInteriorPointMethod::dual_fraction_to_boundary(const OptimizationProblem& problem, const Multipliers& current_multipliers,
-         Multipliers& direction_multipliers, double tau) {
-      double step_length = 1.;
-      for (const size_t variable_index: problem.get_lower_bounded_variables()) {
-         if (direction_multipliers.lower_bounds[variable_index] < 0.) {
-            double distance = -tau * current_multipliers.lower_bounds[variable_index] / direction_multipliers.lower_bounds[variable_index];
-            if (0. < distance) {
-               step_length = std::min(step_length, distance);
-            }
-         }
+   // "fraction-to-boundary" rules for the primal variables and the bound duals, computed in a single sweep over the bounds
+   FractionToBoundary PrimalDualInteriorPointMethod::fraction_to_boundary(const FlatBounds& bounds, const Vector<double>& current_primals,
+         const Multipliers& current_multipliers, const Vector<double>& primal_direction, const Multipliers& direction_multipliers, double tau) {
+      FractionToBoundary step_lengths{};
+      for (size_t bound_index: Range(bounds.lower.size())) {
+         const size_t variable_index = bounds.lower.variables[bound_index];
+         const double distance_to_bound = current_primals[variable_index] - bounds.lower.bounds[bound_index];
+         step_lengths.update_primal(distance_to_bound, primal_direction[variable_index], tau);
+         step_lengths.update_dual(current_multipliers.lower_bounds[variable_index], direction_multipliers.lower_bounds[variable_index], tau);
       }
-      for (const size_t variable_index: problem.get_upper_bounded_variables()) {
-         if (0. < direction_multipliers.upper_bounds[variable_index]) {
-            double distance = -tau * current_multipliers.upper_bounds[variable_index] / direction_multipliers.upper_bounds[variable_index];
-            if (0. < distance) {
-               step_length = std::min(step_length, distance);
-            }
-         }
+      for (size_t bound_index: Range(bounds.upper.size())) {
+         const size_t variable_index = bounds.upper.variables[bound_index];
+         const double distance_to_bound = current_primals[variable_index] - bounds.upper.bounds[bound_index];
+         step_lengths.update_primal(distance_to_bound, primal_direction[variable_index], tau);
+         step_lengths.update_dual(current_multipliers.upper_bounds[variable_index], direction_multipliers.upper_bounds[variable_index], tau);
       }
-      assert(0. < step_length && step_length <= 1. && "The dual fraction-to-boundary step length is not in (0, 1]");
-      return step_length;
+      assert(0. < step_lengths.primal_step_length && step_lengths.primal_step_length <= 1. &&
+         "The primal fraction-to-boundary step length is not in (0, 1]");
+      assert(0. < step_lengths.dual_step_length && step_lengths.dual_step_length <= 1. &&
+         "The dual fraction-to-boundary step length is not in (0, 1]");
+      return step_lengths;
    }
 
    // generate the right-hand side
    void PrimalDualInteriorPointMethod::assemble_augmented_rhs(const Multipliers& current_multipliers, size_t number_variables, size_t number_constraints) {
+      this->is_solution_current = false;
       this->augmented_system.rhs.fill(0.);
 
       // objective gradient
@@ -399,7 +751,7 @@ namespace uno {
          // constraints
          this->augmented_system.rhs[number_variables + constraint_index] = -this->constraints[constraint_index];
       }
-      DEBUG2 << "RHS: "; print_vector(DEBUG2, view(this->augmented_system.rhs, 0, number_variables + number_constraints)); DEBUG << '\n';
+      DEBUG2 << "RHS: " << view(this->augmented_system.rhs, 0, number_variables + number_constraints) << '\n';
    }
 
    void PrimalDualInteriorPointMethod::assemble_primal_dual_direction(const OptimizationProblem& problem, const Vector<double>& current_primals,
@@ -409,7 +761,12 @@ namespace uno {
       // retrieve the duals with correct signs (note the minus sign)
       direction_multipliers.constraints = view(-this->augmented_system.solution, problem.number_variables,
             problem.number_variables + problem.number_constraints);
-      this->compute_bound_dual_direction(problem, current_primals, current_multipliers, direction_primals, direction_multipliers);
+      // bound-dual direction and "fraction-to-boundary" rule for primal variables and bound multipliers
+      const double tau = std::max(this->parameters.tau_min, 1. - this->barrier_parameter());
+      const FractionToBoundary step_lengths = this->compute_bound_dual_direction(current_primals, current_multipliers, direction_primals,
+         direction_multipliers, tau);
+      this->primal_step_length = step_lengths.primal_step_length;
+      const double bound_dual_step_length = step_lengths.dual_step_length;
 
       // determine if the direction is a "small direction" (Section 3.9 of the Ipopt paper) TODO
       const bool is_small_step = PrimalDualInteriorPointMethod::is_small_step(problem, current_primals, direction_primals);
@@ -417,50 +774,367 @@ namespace uno {
          DEBUG << "This is a small step\n";
       }
 
-      // "fraction-to-boundary" rule for primal variables and constraints multipliers
-      const double tau = std::max(this->parameters.tau_min, 1. - this->barrier_parameter());
-      const double primal_step_length = PrimalDualInteriorPointMethod::primal_fraction_to_boundary(problem, current_primals, direction_primals, tau);
-      const double bound_dual_step_length = PrimalDualInteriorPointMethod::dual_fraction_to_boundary(problem, current_multipliers, direction_multipliers, tau);
       DEBUG << "Fraction-to-boundary rules:\n";
-      DEBUG << "primal step length = " << primal_step_length << '\n';
+      DEBUG << "primal step length = " << this->primal_step_length << '\n';
       DEBUG << "bound dual step length = " << bound_dual_step_length << "\n\n";
       // scale the primal-dual variables
-      direction_primals.scale(primal_step_length);
-      direction_multipliers.constraints.scale(primal_step_length);
-      direction_multipliers.lower_bounds.scale(bound_dual_step_length);
-      direction_multipliers.upper_bounds.scale(bound_dual_step_length);
+      direction_primals.scale(this->primal_step_length);
+      direction_multipliers.constraints.scale(this->primal_step_length);
+      // the bound duals of the unbounded variables are zero: only the bounds are swept
+      for (size_t variable_index: this->problem_bounds.lower.variables) {
+         direction_multipliers.lower_bounds[variable_index] *= bound_dual_step_length;
+      }
+      for (size_t variable_index: this->problem_bounds.upper.variables) {
+         direction_multipliers.upper_bounds[variable_index] *= bound_dual_step_length;
+      }
    }
 
-   void PrimalDualInteriorPointMethod::compute_bound_dual_direction(const OptimizationProblem& problem, const Vector<double>& current_primals,
-         const Multipliers& current_multipliers, const Vector<double>& primal_direction, Multipliers& direction_multipliers) {
+   // fused kernel: a single sweep over the bounds computes the bound-dual direction, the fraction-to-boundary step lengths
+   // and the current average complementarity
+   FractionToBoundary PrimalDualInteriorPointMethod::compute_bound_dual_direction(const Vector<double>& current_primals,
+         const Multipliers& current_multipliers, const Vector<double>& primal_direction, Multipliers& direction_multipliers, double tau) {
       direction_multipliers.lower_bounds.fill(0.);
       direction_multipliers.upper_bounds.fill(0.);
-      for (const size_t variable_index: problem.get_lower_bounded_variables()) {
-         const double distance_to_bound = current_primals[variable_index] - problem.variable_lower_bound(variable_index);
-         direction_multipliers.lower_bounds[variable_index] = (this->barrier_parameter() - primal_direction[variable_index] * current_multipliers.lower_bounds[variable_index]) /
-                                                              distance_to_bound - current_multipliers.lower_bounds[variable_index];
-         assert(is_finite(direction_multipliers.lower_bounds[variable_index]) && "The lower bound dual is infinite");
+      FractionToBoundary step_lengths{};
+      double complementarity = 0.;
+      for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+         const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+         const double distance_to_bound = current_primals[variable_index] - this->problem_bounds.lower.bounds[bound_index];
+         const double multiplier = current_multipliers.lower_bounds[variable_index];
+         const double direction = (this->lower_bound_targets[variable_index] - primal_direction[variable_index] * multiplier) /
+            distance_to_bound - multiplier;
+         assert(is_finite(direction) && "The lower bound dual is infinite");
+         direction_multipliers.lower_bounds[variable_index] = direction;
+         step_lengths.update_primal(distance_to_bound, primal_direction[variable_index], tau);
+         step_lengths.update_dual(multiplier, direction, tau);
+         complementarity += distance_to_bound * multiplier;
       }
-      for (const size_t variable_index: problem.get_upper_bounded_variables()) {
-         const double distance_to_bound = current_primals[variable_index] - problem.variable_upper_bound(variable_index);
-         direction_multipliers.upper_bounds[variable_index] = (this->barrier_parameter() - primal_direction[variable_index] * current_multipliers.upper_bounds[variable_index]) /
-                                                              distance_to_bound - current_multipliers.upper_bounds[variable_index];
-         assert(is_finite(direction_multipliers.upper_bounds[variable_index]) && "The upper bound dual is infinite");
+      for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+         const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+         const double distance_to_bound = current_primals[variable_index] - this->problem_bounds.upper.bounds[bound_index];
+         const double multiplier = current_multipliers.upper_bounds[variable_index];
+         const double direction = (this->upper_bound_targets[variable_index] - primal_direction[variable_index] * multiplier) /
+            distance_to_bound - multiplier;
+         assert(is_finite(direction) && "The upper bound dual is infinite");
+         direction_multipliers.upper_bounds[variable_index] = direction;
+         step_lengths.update_primal(distance_to_bound, primal_direction[variable_index], tau);
+         step_lengths.update_dual(multiplier, direction, tau);
+         complementarity += distance_to_bound * multiplier;
+      }
+      const size_t number_bounds = this->problem_bounds.lower.size() + this->problem_bounds.upper.size();
+      step_lengths.average_complementarity = (0 < number_bounds) ? complementarity / static_cast<double>(number_bounds) : 0.;
+      return step_lengths;
+   }
+
+   void PrimalDualInteriorPointMethod::set_complementarity_targets(double target) {
+      for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+         const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+         this->lower_bound_targets[variable_index] = target;
+      }
+      for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+         const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+         this->upper_bound_targets[variable_index] = target;
       }
    }
 
+   // the rhs was assembled with the complementarity target mu: account for the actual targets
+   void PrimalDualInteriorPointMethod::add_complementarity_targets_to_rhs(const Vector<double>& current_primals,
+         double barrier_parameter) {
+      this->is_solution_current = false;
+      for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+         const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+         const double distance_to_bound = current_primals[variable_index] - this->problem_bounds.lower.bounds[bound_index];
+         this->augmented_system.rhs[variable_index] += (this->lower_bound_targets[variable_index] - barrier_parameter) / distance_to_bound;
+      }
+      for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+         const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+         const double distance_to_bound = current_primals[variable_index] - this->problem_bounds.upper.bounds[bound_index];
+         this->augmented_system.rhs[variable_index] += (this->upper_bound_targets[variable_index] - barrier_parameter) / distance_to_bound;
+      }
+   }
+
+   // solve the augmented system with zero complementarity targets. The rhs encodes the targets barrier_parameter on entry and zero on exit
+   FractionToBoundary PrimalDualInteriorPointMethod::compute_affine_scaling_direction(const OptimizationProblem& problem,
+         const Vector<double>& current_primals, const Multipliers& current_multipliers, double barrier_parameter) {
+      this->set_complementarity_targets(0.);
+      this->add_complementarity_targets_to_rhs(current_primals, barrier_parameter);
+      this->solve_augmented_system();
+      this->affine_primals = view(this->augmented_system.solution, 0, problem.number_variables);
+      const double tau = std::max(this->parameters.tau_min, 1. - barrier_parameter);
+      return this->compute_bound_dual_direction(current_primals, current_multipliers, this->affine_primals, this->affine_multipliers, tau);
+   }
+
+   // set the barrier parameter and assemble the rhs of the corresponding barrier problem (complementarity targets: barrier parameter)
+   void PrimalDualInteriorPointMethod::assemble_barrier_rhs(const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers, double barrier_parameter) {
+      if (barrier_parameter != this->barrier_parameter()) {
+         this->barrier_parameter_update_strategy.set_barrier_parameter(barrier_parameter);
+         this->subproblem_definition_changed = true;
+      }
+      const PrimalDualInteriorPointProblem barrier_problem(problem, current_multipliers, barrier_parameter);
+      barrier_problem.evaluate_objective_gradient(current_iterate, this->objective_gradient);
+      this->assemble_augmented_rhs(current_multipliers, problem.number_variables, problem.number_constraints);
+      this->set_complementarity_targets(barrier_parameter);
+   }
+
+   // Mehrotra predictor-corrector: the affine-scaling predictor determines the barrier parameter (centering) and the second-order
+   // correction of the complementarity targets. On exit, the rhs of the augmented system is that of the corrector
+   void PrimalDualInteriorPointMethod::compute_predictor_corrector_rhs(const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers) {
+      const Vector<double>& current_primals = current_iterate.primals;
+      const double initial_barrier_parameter = this->barrier_parameter();
+      if (this->problem_bounds.lower.size() + this->problem_bounds.upper.size() == 0) {
+         return;
+      }
+
+      // affine-scaling predictor and complementarity after the (fraction-to-boundary) affine-scaling step
+      const FractionToBoundary step_lengths = this->compute_affine_scaling_direction(problem, current_primals, current_multipliers,
+         initial_barrier_parameter);
+      const double current_complementarity = step_lengths.average_complementarity;
+      if (current_complementarity <= 0.) {
+         // restore the rhs of the barrier problem
+         this->assemble_barrier_rhs(problem, current_iterate, current_multipliers, initial_barrier_parameter);
+         return;
+      }
+      const double affine_complementarity = PrimalDualInteriorPointMethod::average_complementarity(this->problem_bounds, current_primals, current_multipliers,
+            this->affine_primals, this->affine_multipliers, step_lengths.primal_step_length, step_lengths.dual_step_length);
+
+      // centering parameter sigma = (mu_aff / mu)^3
+      const double centering = std::min(1., std::pow(affine_complementarity / current_complementarity, 3));
+      const double barrier_parameter = std::max(this->barrier_min_parameter, centering * current_complementarity);
+      DEBUG << "Predictor-corrector: affine complementarity = " << affine_complementarity << ", centering = " << centering << '\n';
+
+      // corrector: rhs of the barrier problem with the new barrier parameter and second-order correction of the complementarity targets
+      this->assemble_barrier_rhs(problem, current_iterate, current_multipliers, barrier_parameter);
+      for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+         const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+         this->lower_bound_targets[variable_index] = barrier_parameter -
+            this->affine_primals[variable_index] * this->affine_multipliers.lower_bounds[variable_index];
+      }
+      for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+         const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+         this->upper_bound_targets[variable_index] = barrier_parameter -
+            this->affine_primals[variable_index] * this->affine_multipliers.upper_bounds[variable_index];
+      }
+      this->add_complementarity_targets_to_rhs(current_primals, barrier_parameter);
+   }
+
+   // quality-function rule (Nocedal, Waechter and Waltz): the direction is affine in the barrier parameter mu = sigma * average complementarity,
+   // d(sigma) = d_aff + sigma (d_cen - d_aff). sigma minimizes a linear model of the KKT error after the fraction-to-boundary step.
+   // On exit, the rhs of the augmented system is that of the barrier problem with the new barrier parameter
+   void PrimalDualInteriorPointMethod::compute_quality_function_rhs(const OptimizationProblem& problem, Iterate& current_iterate,
+         const Multipliers& current_multipliers, const DualResiduals& residuals) {
+      const Vector<double>& current_primals = current_iterate.primals;
+      const double initial_barrier_parameter = this->barrier_parameter();
+      const double average_complementarity = BarrierParameterUpdateStrategy::compute_average_complementarity(problem, current_primals,
+            current_multipliers);
+      if (average_complementarity <= 0.) {
+         return;
+      }
+
+      // affine-scaling and centering (targets: average complementarity) directions
+      this->compute_affine_scaling_direction(problem, current_primals, current_multipliers, initial_barrier_parameter);
+      this->set_complementarity_targets(average_complementarity);
+      this->add_complementarity_targets_to_rhs(current_primals, 0.);
+      this->solve_augmented_system();
+      this->centering_primals = view(this->augmented_system.solution, 0, problem.number_variables);
+      this->compute_bound_dual_direction(current_primals, current_multipliers, this->centering_primals, this->centering_multipliers,
+         std::max(this->parameters.tau_min, 1. - initial_barrier_parameter));
+
+      // linear model of the KKT error
+      const double squared_stationarity = std::pow(residuals.stationarity / residuals.stationarity_scaling, 2);
+      const double squared_primal_feasibility = (problem.get_objective_multiplier() == 0.) ? 0. : std::pow(current_iterate.primal_feasibility, 2);
+      const double tau = std::max(this->parameters.tau_min, 1. - initial_barrier_parameter);
+      const auto quality_function = [&](double sigma) {
+         for (size_t variable_index: Range(problem.number_variables)) {
+            this->trial_primals[variable_index] = this->affine_primals[variable_index] +
+               sigma * (this->centering_primals[variable_index] - this->affine_primals[variable_index]);
+         }
+         for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+            const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+            this->trial_multipliers.lower_bounds[variable_index] = this->affine_multipliers.lower_bounds[variable_index] +
+               sigma * (this->centering_multipliers.lower_bounds[variable_index] - this->affine_multipliers.lower_bounds[variable_index]);
+         }
+         for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+            const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+            this->trial_multipliers.upper_bounds[variable_index] = this->affine_multipliers.upper_bounds[variable_index] +
+               sigma * (this->centering_multipliers.upper_bounds[variable_index] - this->affine_multipliers.upper_bounds[variable_index]);
+         }
+         const FractionToBoundary step_lengths = PrimalDualInteriorPointMethod::fraction_to_boundary(this->problem_bounds, current_primals,
+            current_multipliers, this->trial_primals, this->trial_multipliers, tau);
+         return std::pow(1. - step_lengths.dual_step_length, 2) * squared_stationarity +
+            std::pow(1. - step_lengths.primal_step_length, 2) * squared_primal_feasibility +
+            PrimalDualInteriorPointMethod::mean_squared_complementarity(this->problem_bounds, current_primals, current_multipliers, this->trial_primals,
+               this->trial_multipliers, step_lengths.primal_step_length, step_lengths.dual_step_length);
+      };
+      if (this->barrier_parameter_update_strategy.minimize_quality_function(quality_function, average_complementarity)) {
+         this->subproblem_definition_changed = true;
+      }
+      this->assemble_barrier_rhs(problem, current_iterate, current_multipliers, this->barrier_parameter());
+   }
+
+   // number of centrality correctors of the current iteration. The adaptive rule (Gondzio, 1996) follows the ratio of the cost of a
+   // factorization to that of a solve (forward and backward substitutions: about 4 flops per nonzero of the factors)
+   size_t PrimalDualInteriorPointMethod::number_centrality_correctors() const {
+      if (!this->adaptive_centrality_correctors) {
+         return this->max_centrality_correctors;
+      }
+      const FactorizationStatistics statistics = this->get_factorization_statistics();
+      if (statistics.number_factorizations == 0 || statistics.flops <= 0. || statistics.factor_nonzeros == 0) {
+         // the backend does not report its costs
+         return this->max_centrality_correctors;
+      }
+      const double factorization_flops = statistics.flops / static_cast<double>(statistics.number_factorizations);
+      const double cost_ratio = factorization_flops / (4. * static_cast<double>(statistics.factor_nonzeros));
+      const size_t number_correctors = (cost_ratio <= 10.) ? 1 : (cost_ratio <= 30.) ? 2 : (cost_ratio <= 50.) ? 3 : this->max_centrality_correctors;
+      return std::min(number_correctors, this->max_centrality_correctors);
+   }
+
+   // Gondzio's multiple centrality correctors: the complementarity products at the aspiration step length alpha + delta are
+   // projected onto the neighborhood [mu / beta, beta mu] and the differences are added to the complementarity targets. The
+   // corrected direction is a back-solve with the current factorization. It is accepted if its step length increases by at least
+   // gamma delta, otherwise the previous direction is restored and the correction stops
+   void PrimalDualInteriorPointMethod::compute_centrality_correctors(const OptimizationProblem& problem, const Vector<double>& current_primals,
+         const Multipliers& current_multipliers) {
+      const size_t number_correctors = this->number_centrality_correctors();
+      if (number_correctors == 0 || this->problem_bounds.lower.size() + this->problem_bounds.upper.size() == 0) {
+         return;
+      }
+      const double barrier_parameter = this->barrier_parameter();
+      const double tau = std::max(this->parameters.tau_min, 1. - barrier_parameter);
+      const double smallest_target = barrier_parameter / this->centrality_neighborhood;
+      const double largest_target = this->centrality_neighborhood * barrier_parameter;
+      // correction of a complementarity product that leaves the neighborhood. The large products are not reduced by more than the
+      // largest target (Gondzio)
+      const auto correction = [&](double product) {
+         if (product < smallest_target) {
+            return smallest_target - product;
+         }
+         if (largest_target < product) {
+            return std::max(largest_target - product, -largest_target);
+         }
+         return 0.;
+      };
+
+      this->trial_primals = view(this->augmented_system.solution, 0, problem.number_variables);
+      FractionToBoundary step_lengths = this->compute_bound_dual_direction(current_primals, current_multipliers, this->trial_primals,
+         this->trial_multipliers, tau);
+      double step_length = std::min(step_lengths.primal_step_length, step_lengths.dual_step_length);
+      for (size_t corrector_index: Range(number_correctors)) {
+         if (step_length == 1.) {
+            break;
+         }
+         const double aspiration_step_length = std::min(1., step_length + this->centrality_step_increase);
+         // the correction is added to the targets and to the rhs
+         for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+            const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+            const double distance_to_bound = current_primals[variable_index] - this->problem_bounds.lower.bounds[bound_index];
+            const double product = (distance_to_bound + aspiration_step_length * this->trial_primals[variable_index]) *
+               (current_multipliers.lower_bounds[variable_index] + aspiration_step_length * this->trial_multipliers.lower_bounds[variable_index]);
+            this->lower_bound_corrections[variable_index] = correction(product);
+            this->lower_bound_targets[variable_index] += this->lower_bound_corrections[variable_index];
+            this->augmented_system.rhs[variable_index] += this->lower_bound_corrections[variable_index] / distance_to_bound;
+         }
+         for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+            const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+            const double distance_to_bound = current_primals[variable_index] - this->problem_bounds.upper.bounds[bound_index];
+            const double product = (distance_to_bound + aspiration_step_length * this->trial_primals[variable_index]) *
+               (current_multipliers.upper_bounds[variable_index] + aspiration_step_length * this->trial_multipliers.upper_bounds[variable_index]);
+            this->upper_bound_corrections[variable_index] = correction(product);
+            this->upper_bound_targets[variable_index] += this->upper_bound_corrections[variable_index];
+            this->augmented_system.rhs[variable_index] += this->upper_bound_corrections[variable_index] / distance_to_bound;
+         }
+         this->corrector_solution = this->augmented_system.solution;
+         this->solve_augmented_system();
+         this->trial_primals = view(this->augmented_system.solution, 0, problem.number_variables);
+         step_lengths = this->compute_bound_dual_direction(current_primals, current_multipliers, this->trial_primals, this->trial_multipliers, tau);
+         const double corrected_step_length = std::min(step_lengths.primal_step_length, step_lengths.dual_step_length);
+         DEBUG << "Centrality corrector " << corrector_index + 1 << ": step length " << step_length << " -> " << corrected_step_length << '\n';
+         if (corrected_step_length < step_length + this->centrality_min_improvement * this->centrality_step_increase) {
+            // restore the targets, the rhs and the solution of the previous direction
+            for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+               const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+               const double distance_to_bound = current_primals[variable_index] - this->problem_bounds.lower.bounds[bound_index];
+               this->lower_bound_targets[variable_index] -= this->lower_bound_corrections[variable_index];
+               this->augmented_system.rhs[variable_index] -= this->lower_bound_corrections[variable_index] / distance_to_bound;
+            }
+            for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+               const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+               const double distance_to_bound = current_primals[variable_index] - this->problem_bounds.upper.bounds[bound_index];
+               this->upper_bound_targets[variable_index] -= this->upper_bound_corrections[variable_index];
+               this->augmented_system.rhs[variable_index] -= this->upper_bound_corrections[variable_index] / distance_to_bound;
+            }
+            this->augmented_system.solution = this->corrector_solution;
+            break;
+         }
+         step_length = corrected_step_length;
+      }
+   }
+
+   double PrimalDualInteriorPointMethod::average_complementarity(const FlatBounds& bounds, const Vector<double>& current_primals,
+         const Multipliers& current_multipliers, const Vector<double>& primal_direction, const Multipliers& direction_multipliers,
+         double primal_step_length, double dual_step_length) {
+      double complementarity = 0.;
+      size_t number_bounds = 0;
+      for (size_t bound_index: Range(bounds.lower.size())) {
+         const size_t variable_index = bounds.lower.variables[bound_index];
+         const double distance_to_bound = current_primals[variable_index] + primal_step_length * primal_direction[variable_index] -
+            bounds.lower.bounds[bound_index];
+         complementarity += distance_to_bound * (current_multipliers.lower_bounds[variable_index] +
+            dual_step_length * direction_multipliers.lower_bounds[variable_index]);
+         number_bounds++;
+      }
+      for (size_t bound_index: Range(bounds.upper.size())) {
+         const size_t variable_index = bounds.upper.variables[bound_index];
+         const double distance_to_bound = current_primals[variable_index] + primal_step_length * primal_direction[variable_index] -
+            bounds.upper.bounds[bound_index];
+         complementarity += distance_to_bound * (current_multipliers.upper_bounds[variable_index] +
+            dual_step_length * direction_multipliers.upper_bounds[variable_index]);
+         number_bounds++;
+      }
+      return (0 < number_bounds) ? complementarity / static_cast<double>(number_bounds) : 0.;
+   }
+
+   double PrimalDualInteriorPointMethod::mean_squared_complementarity(const FlatBounds& bounds, const Vector<double>& current_primals,
+         const Multipliers& current_multipliers, const Vector<double>& primal_direction, const Multipliers& direction_multipliers,
+         double primal_step_length, double dual_step_length) {
+      double squared_complementarity = 0.;
+      size_t number_bounds = 0;
+      for (size_t bound_index: Range(bounds.lower.size())) {
+         const size_t variable_index = bounds.lower.variables[bound_index];
+         const double distance_to_bound = current_primals[variable_index] + primal_step_length * primal_direction[variable_index] -
+            bounds.lower.bounds[bound_index];
+         squared_complementarity += std::pow(distance_to_bound * (current_multipliers.lower_bounds[variable_index] +
+            dual_step_length * direction_multipliers.lower_bounds[variable_index]), 2);
+         number_bounds++;
+      }
+      for (size_t bound_index: Range(bounds.upper.size())) {
+         const size_t variable_index = bounds.upper.variables[bound_index];
+         const double distance_to_bound = current_primals[variable_index] + primal_step_length * primal_direction[variable_index] -
+            bounds.upper.bounds[bound_index];
+         squared_complementarity += std::pow(distance_to_bound * (current_multipliers.upper_bounds[variable_index] +
+            dual_step_length * direction_multipliers.upper_bounds[variable_index]), 2);
+         number_bounds++;
+      }
+      return (0 < number_bounds) ? squared_complementarity / static_cast<double>(number_bounds) : 0.;
+   }
+
    void PrimalDualInteriorPointMethod::compute_least_square_multipliers(const OptimizationProblem& problem, Iterate& iterate,
          Vector<double>& constraint_multipliers) {
-      this->augmented_system.matrix.set_dimension(problem.number_variables + problem.number_constraints);
-      this->augmented_system.matrix.reset();
-      Preprocessing::compute_least_square_multipliers(problem.model, this->augmented_system.matrix, this->augmented_system.rhs, *this->linear_solver,
-            iterate, constraint_multipliers, this->least_square_multiplier_max_norm);
+      if (this->least_square_multiplier_solver == nullptr) {
+         // the least-square system requires a factorization: the multipliers are kept
+         DEBUG << "No direct linear solver: the least-square multipliers are not computed\n";
+         return;
+      }
+      this->least_square_multiplier_solver->compute_multipliers(problem.model, iterate, constraint_multipliers);
    }
 
    void PrimalDualInteriorPointMethod::postprocess_iterate(const OptimizationProblem& problem, Iterate& iterate) {
+      this->problem_bounds.update(problem);
       // rescale the bound multipliers (Eq. 16 in Ipopt paper)
-      for (const size_t variable_index: problem.get_lower_bounded_variables()) {
-         const double coefficient = this->barrier_parameter() / (iterate.primals[variable_index] - problem.variable_lower_bound(variable_index));
+      for (size_t bound_index: Range(this->problem_bounds.lower.size())) {
+         const size_t variable_index = this->problem_bounds.lower.variables[bound_index];
+         const double coefficient = this->barrier_parameter() / (iterate.primals[variable_index] - this->problem_bounds.lower.bounds[bound_index]);
          if (is_finite(coefficient)) {
             const double lb = coefficient / this->parameters.k_sigma;
             const double ub = coefficient * this->parameters.k_sigma;
@@ -477,8 +1151,9 @@ namespace uno {
          }
 
       }
-      for (const size_t variable_index: problem.get_upper_bounded_variables()) {
-         const double coefficient = this->barrier_parameter() / (iterate.primals[variable_index] - problem.variable_upper_bound(variable_index));
+      for (size_t bound_index: Range(this->problem_bounds.upper.size())) {
+         const size_t variable_index = this->problem_bounds.upper.variables[bound_index];
+         const double coefficient = this->barrier_parameter() / (iterate.primals[variable_index] - this->problem_bounds.upper.bounds[bound_index]);
          if (is_finite(coefficient)) {
             const double lb = coefficient * this->parameters.k_sigma;
             const double ub = coefficient / this->parameters.k_sigma;
@@ -499,4 +1174,88 @@ namespace uno {
    void PrimalDualInteriorPointMethod::set_initial_point(const Vector<double>& /*point*/) {
       // do nothing
    }
+
+   void PrimalDualInteriorPointMethod::save_state(CheckpointWriter& writer) const {
+      this->barrier_parameter_update_strategy.save_state(writer);
+      writer.write(this->previous_barrier_parameter);
+      writer.write(this->solving_feasibility_problem);
+      writer.write(this->first_feasibility_iteration);
+      this->augmented_system.save_regularization_state(writer);
+   }
+
+   void PrimalDualInteriorPointMethod::load_state(CheckpointReader& reader) {
+      this->barrier_parameter_update_strategy.load_state(reader);
+      this->previous_barrier_parameter = reader.read_double();
+      this->solving_feasibility_problem = reader.read_bool();
+      this->first_feasibility_iteration = reader.read_bool();
+      this->augmented_system.load_regularization_state(reader);
+      this->subproblem_definition_changed = true;
+   }
+
+   // storage of the factors of the linear solver (grown when a factorization runs out of space)
+   size_t PrimalDualInteriorPointMethod::get_peak_workspace_size() const {
+      return (this->linear_solver != nullptr) ? this->linear_solver->get_peak_workspace_size() : 0;
+   }
+
+   // the iterative solver does not factorize
+   FactorizationStatistics PrimalDualInteriorPointMethod::get_factorization_statistics() const {
+      FactorizationStatistics statistics = (this->linear_solver != nullptr) ? this->augmented_system.get_factorization_statistics(*this->linear_solver) :
+         FactorizationStatistics{};
+      if (this->normal_equations != nullptr) {
+         statistics.accumulate(this->normal_equations->get_factorization_statistics());
+      }
+      return statistics;
+   }
+
+   // the factors are those of the augmented system (or of the normal equations) of the last iteration (barrier terms and
+   // regularization included)
+   void PrimalDualInteriorPointMethod::solve_sensitivity_systems(const Vector<double>& rhs, Vector<double>& result, size_t number_rhs) {
+      if (this->linear_solver == nullptr) {
+         throw std::runtime_error("The sensitivities require a direct linear solver");
+      }
+      if (this->solving_feasibility_problem) {
+         throw std::runtime_error("The sensitivities are not available in the feasibility restoration phase");
+      }
+      if (0 < this->hessian_low_rank_dimension) {
+         throw std::runtime_error("The sensitivities are not available with a low-rank term of the Hessian in the augmented system");
+      }
+      if (this->use_normal_equations) {
+         // the rhs are solved one by one
+         const size_t dimension = this->augmented_system.rhs.size();
+         Vector<double> single_rhs(dimension), single_result(dimension);
+         const size_t block_size = rhs.size() / number_rhs;
+         for (size_t rhs_index: Range(number_rhs)) {
+            std::copy(rhs.data() + rhs_index * block_size, rhs.data() + (rhs_index + 1) * block_size, single_rhs.data());
+            this->normal_equations->solve(this->constraint_jacobian, single_rhs, single_result);
+            std::copy(single_result.data(), single_result.data() + block_size, result.data() + rhs_index * block_size);
+         }
+         return;
+      }
+      this->augmented_system.solve_multiple(*this->linear_solver, rhs, result, number_rhs);
+   }
+
+   void PrimalDualInteriorPointMethod::report_memory(MemoryReport& report) const {
+      InequalityHandlingMethod::report_memory(report);
+      report.add("interior point/constraints", MemoryReport::memory_size(this->constraints) +
+            MemoryReport::memory_size(this->second_order_constraints) + MemoryReport::memory_size(this->trial_constraints));
+      report.add("interior point/objective gradient", this->objective_gradient.memory_size());
+      report.add("interior point/Hessian", this->hessian.memory_size());
+      report.add("interior point/augmented system", this->augmented_system.memory_size());
+      if (this->normal_equations != nullptr) {
+         report.add("interior point/normal equations", this->normal_equations->memory_size());
+      }
+      report.add("interior point/linear solver", (this->linear_solver != nullptr ? this->linear_solver->memory_size() : 0) +
+            (this->iterative_solver != nullptr ? this->iterative_solver->memory_size() : 0));
+      if (this->least_square_multiplier_solver != nullptr) {
+         report.add("interior point/least-square multipliers", this->least_square_multiplier_solver->memory_size());
+      }
+      size_t primal_dual_size = this->affine_multipliers.memory_size() + this->centering_multipliers.memory_size() +
+            this->trial_multipliers.memory_size();
+      for (const Vector<double>* vector: {&this->lower_bound_targets, &this->upper_bound_targets, &this->affine_primals,
+            &this->centering_primals, &this->trial_primals, &this->barrier_diagonal, &this->lower_bound_corrections,
+            &this->upper_bound_corrections, &this->corrector_solution}) {
+         primal_dual_size += vector->memory_size();
+      }
+      report.add("interior point/primal-dual vectors", primal_dual_size);
+   }
 } // namespace
@@ -4,10 +4,17 @@
 #ifndef UNO_INFEASIBLEINTERIORPOINTMETHOD_H
 #define UNO_INFEASIBLEINTERIORPOINTMETHOD_H
 
+#include <algorithm>
 #include "../InequalityHandlingMethod.hpp"
 #include "PrimalDualInteriorPointProblem.hpp"
+#include "linear_algebra/DenseLDLT.hpp"
 #include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "ingredients/subproblem_solvers/MINRESSolver.hpp"
+#include "preprocessing/LeastSquareMultiplierSolver.hpp"
+#include "optimization/Multipliers.hpp"
 #include "BarrierParameterUpdateStrategy.hpp"
+#include "FlatBounds.hpp"
+#include "NormalEquationsSystem.hpp"
 
 namespace uno {
    // forward references
@@ -24,14 +31,50 @@ namespace uno {
       double push_variable_to_interior_k2;
    };
 
-   class PrimalDualInteriorPointMethod : public InequalityHandlingMethod {
+   // "fraction-to-boundary" step lengths of a primal-dual direction and average complementarity at the current point
+   struct FractionToBoundary {
+      double primal_step_length{1.};
+      double dual_step_length{1.};
+      double average_complementarity{0.};
+
+      // distance_to_bound is x - x_L (nonnegative) or x - x_U (nonpositive)
+      void update_primal(double distance_to_bound, double primal_direction, double tau) {
+         if (primal_direction * distance_to_bound < 0.) {
+            this->primal_step_length = std::min(this->primal_step_length, -tau * distance_to_bound / primal_direction);
+         }
+      }
+      // multiplier is z_L (nonnegative) or z_U (nonpositive)
+      void update_dual(double multiplier, double multiplier_direction, double tau) {
+         if (multiplier_direction * multiplier < 0.) {
+            this->dual_step_length = std::min(this->dual_step_length, -tau * multiplier / multiplier_direction);
+         }
+      }
+   };
+
+   // warm start from the primal-dual point of the initial iterate (Ipopt's warm_start_* options)
+   struct InteriorPointWarmStartParameters {
+      bool enabled;
+      double bound_push;
+      double bound_fraction;
+      double multiplier_bound_push;
+      double initial_barrier_parameter;
+      bool least_square_multipliers;
+   };
+
+   class PrimalDualInteriorPointMethod final : public InequalityHandlingMethod {
    public:
       PrimalDualInteriorPointMethod(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros,
             size_t number_hessian_nonzeros, const Options& options);
 
       void initialize_statistics(Statistics& statistics, const Options& options) override;
-      void generate_initial_iterate(const OptimizationProblem& problem, Iterate& initial_iterate) override;
+      void generate_initial_iterate(Statistics& statistics, const OptimizationProblem& problem, Iterate& initial_iterate) override;
       void set_initial_point(const Vector<double>& point) override;
+      void save_state(CheckpointWriter& writer) const override;
+      void load_state(CheckpointReader& reader) override;
+      void report_memory(MemoryReport& report) const override;
+      [[nodiscard]] size_t get_peak_workspace_size() const override;
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const override;
+      void solve_sensitivity_systems(const Vector<double>& rhs, Vector<double>& result, size_t number_rhs) override;
 
       void initialize_feasibility_problem(const l1RelaxedProblem& problem, Iterate& current_iterate) override;
       void set_elastic_variable_values(const l1RelaxedProblem& problem, Iterate& constraint_index) override;
@@ -40,6 +83,8 @@ namespace uno {
 
       void solve(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,  const Multipliers& current_multipliers,
             Direction& direction, WarmstartInformation& warmstart_information) override;
+      [[nodiscard]] bool compute_second_order_correction(const OptimizationProblem& problem, Iterate& current_iterate,
+            const Multipliers& current_multipliers, Iterate& trial_iterate, Direction& direction) override;
       [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
 
       void set_auxiliary_measure(const Model& model, Iterate& iterate) override;
@@ -51,44 +96,134 @@ namespace uno {
    protected:
       SparseVector<double> objective_gradient; /*!< Sparse Jacobian of the objective */
       std::vector<double> constraints; /*!< Constraint values (size \f$m)\f$ */
-      RectangularMatrix<double> constraint_jacobian; /*!< Sparse Jacobian of the constraints */
+      RectangularMatrixView<double> constraint_jacobian; /*!< view of the Jacobian of the current iterate */
       SymmetricMatrix<size_t, double> hessian;
-
-      SymmetricIndefiniteLinearSystem<double> augmented_system;
-      const std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> linear_solver;
+      // low-rank term of the Hessian model (e.g. L-BFGS) in compact form W M^{-1} W^T, bordering the augmented matrix (0 if none)
+      const size_t hessian_low_rank_dimension;
+      Vector<double> hessian_low_rank_factors;
+      Vector<double> hessian_middle_matrix;
+      DenseLDLT<double> middle_matrix_factorization; // factors of M for the subproblem objective
+      // LP/QP structure: the constant derivatives are evaluated once per problem (and objective multiplier)
+      const OptimizationProblem* constant_jacobian_problem{nullptr};
+      const OptimizationProblem* constant_hessian_problem{nullptr};
+      double constant_hessian_objective_multiplier{0.};
+
+      // 1-based int indices: the Fortran linear solvers borrow the sparsity pattern of the augmented matrix
+      SymmetricIndefiniteLinearSystem<int, double> augmented_system;
+      const std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<int, double>> linear_solver;
+      // inexact (iterative) solves of the augmented system: the tolerance of the iterative solver is tied to the barrier parameter
+      const std::unique_ptr<MINRESSolver<int, double>> iterative_solver;
+      const double inexact_newton_factor;
+      const double inexact_newton_max_tolerance;
+      const double inexact_newton_min_tolerance;
+      bool is_solution_current{false}; // the solution of the augmented system corresponds to its rhs
+      // normal equations, used instead of the augmented system when the Hessian is diagonal (nullptr if disabled)
+      const std::unique_ptr<NormalEquationsSystem> normal_equations;
+      bool use_normal_equations{false}; // the normal equations are factorized at the current iterate
+      bool is_augmented_matrix_outdated{false}; // the derivatives changed while the normal equations were used
+      // inertia-free regularization of the direct solves (option, or linear solver without inertia)
+      const bool curvature_regularization;
 
       BarrierParameterUpdateStrategy barrier_parameter_update_strategy;
       double previous_barrier_parameter;
       const double default_multiplier;
       const InteriorPointParameters parameters;
-      const double least_square_multiplier_max_norm;
+      const InteriorPointWarmStartParameters warm_start;
+      // least-square multipliers (with their own matrix and linear solver). nullptr without a direct linear solver or constraints
+      const std::unique_ptr<LeastSquareMultiplierSolver<int>> least_square_multiplier_solver;
       const double damping_factor; // (Section 3.7 in IPOPT paper)
       const double l1_constraint_violation_coefficient; // (rho in Section 3.3.1 in IPOPT paper)
 
+      // contiguous bounded variables and bounds of the current problem and of the model
+      FlatBounds problem_bounds{};
+      mutable FlatBounds model_bounds{};
+
       bool solving_feasibility_problem{false};
       bool first_feasibility_iteration{false};
 
+      // eliminate the slacks from the augmented system (condensed KKT system)
+      const bool condense_slacks;
+      // evaluate the gradient, the constraints and Jacobian, the Hessian and the barrier terms concurrently (if the model allows it)
+      const bool concurrent_evaluations;
+
+      // Mehrotra predictor-corrector
+      const bool predictor_corrector;
+      const double barrier_min_parameter;
+      // complementarity targets of the Newton system: (x - x_L) z_L = target_L and (x - x_U) z_U = target_U
+      Vector<double> lower_bound_targets;
+      Vector<double> upper_bound_targets;
+      Vector<double> affine_primals;
+      Multipliers affine_multipliers;
+      // quality-function rule of the barrier parameter update
+      Vector<double> centering_primals;
+      Multipliers centering_multipliers;
+      Vector<double> trial_primals;
+      Multipliers trial_multipliers;
+      // Gondzio's multiple centrality correctors: corrections of the complementarity targets and solution of the last accepted direction
+      const size_t max_centrality_correctors;
+      const bool adaptive_centrality_correctors;
+      const double centrality_step_increase;
+      const double centrality_min_improvement;
+      const double centrality_neighborhood;
+      Vector<double> lower_bound_corrections;
+      Vector<double> upper_bound_corrections;
+      Vector<double> corrector_solution;
+
+      // second-order corrections (Section 2.4 in IPOPT paper): accumulated constraint values c_soc
+      std::vector<double> second_order_constraints;
+      std::vector<double> trial_constraints;
+      size_t number_second_order_corrections{0};
+      double primal_step_length{1.}; // fraction-to-boundary step length of the last direction
+
+      // diagonal barrier terms, kept as a separate layer of the augmented matrix. If the Hessian and the Jacobian are unchanged,
+      // the layer is updated in place
+      Vector<double> barrier_diagonal;
+      bool matrix_values_changed{true};
+
       [[nodiscard]] double barrier_parameter() const;
       [[nodiscard]] double push_variable_to_interior(double variable_value, double lower_bound, double upper_bound) const;
-      void evaluate_functions(Statistics& statistics, const PrimalDualInteriorPointProblem& barrier_problem, Iterate& current_iterate,
-            const Multipliers& current_multipliers, const WarmstartInformation& warmstart_information);
+      void set_warm_start_bound_multipliers(Iterate& initial_iterate) const;
+      void evaluate_functions(Statistics& statistics, const OptimizationProblem& problem, const PrimalDualInteriorPointProblem& barrier_problem,
+            Iterate& current_iterate, const Multipliers& current_multipliers, const WarmstartInformation& warmstart_information);
+      void evaluate_barrier_diagonal(const Vector<double>& primals, const Multipliers& multipliers);
+      // W and M at the current iterate, passed to the augmented system
+      void evaluate_hessian_low_rank_term(const OptimizationProblem& problem);
       void update_barrier_parameter(const OptimizationProblem& problem, const Iterate& current_iterate, const Multipliers& current_multipliers,
             const DualResiduals& residuals);
       [[nodiscard]] bool is_small_step(const OptimizationProblem& problem, const Vector<double>& current_primals, const Vector<double>& direction_primals) const;
       [[nodiscard]] double evaluate_subproblem_objective(const Direction& direction) const;
       [[nodiscard]] double compute_barrier_term_directional_derivative(const Model& model, const Iterate& current_iterate,
             const Vector<double>& primal_direction) const;
-      [[nodiscard]] static double primal_fraction_to_boundary(const OptimizationProblem& problem, const Vector<double>& current_primals,
-            const Vector<double>& primal_direction, double tau);
-      [[nodiscard]] static double dual_fraction_to_boundary(const OptimizationProblem& problem, const Multipliers& current_multipliers,
-            Multipliers& direction_multipliers, double tau);
+      [[nodiscard]] static FractionToBoundary fraction_to_boundary(const FlatBounds& bounds, const Vector<double>& current_primals,
+            const Multipliers& current_multipliers, const Vector<double>& primal_direction, const Multipliers& direction_multipliers, double tau);
       void assemble_augmented_system(Statistics& statistics, const OptimizationProblem& problem, const Multipliers& current_multipliers,
             WarmstartInformation& warmstart_information);
       void assemble_augmented_rhs(const Multipliers& current_multipliers, size_t number_variables, size_t number_constraints);
+      void set_stage_partition(const OptimizationProblem& problem);
       void assemble_primal_dual_direction(const OptimizationProblem& problem, const Vector<double>& current_primals, const Multipliers& current_multipliers,
             Vector<double>& direction_primals, Multipliers& direction_multipliers);
-      void compute_bound_dual_direction(const OptimizationProblem& problem, const Vector<double>& current_primals, const Multipliers& current_multipliers,
-            const Vector<double>& primal_direction, Multipliers& direction_multipliers);
+      FractionToBoundary compute_bound_dual_direction(const Vector<double>& current_primals, const Multipliers& current_multipliers,
+            const Vector<double>& primal_direction, Multipliers& direction_multipliers, double tau);
+      void set_complementarity_targets(double target);
+      void add_complementarity_targets_to_rhs(const Vector<double>& current_primals, double barrier_parameter);
+      FractionToBoundary compute_affine_scaling_direction(const OptimizationProblem& problem, const Vector<double>& current_primals,
+            const Multipliers& current_multipliers, double barrier_parameter);
+      void assemble_barrier_rhs(const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
+            double barrier_parameter);
+      void compute_predictor_corrector_rhs(const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers);
+      void compute_quality_function_rhs(const OptimizationProblem& problem, Iterate& current_iterate, const Multipliers& current_multipliers,
+            const DualResiduals& residuals);
+      [[nodiscard]] size_t number_centrality_correctors() const;
+      void compute_centrality_correctors(const OptimizationProblem& problem, const Vector<double>& current_primals,
+            const Multipliers& current_multipliers);
+      [[nodiscard]] static double average_complementarity(const FlatBounds& bounds, const Vector<double>& current_primals,
+            const Multipliers& current_multipliers, const Vector<double>& primal_direction, const Multipliers& direction_multipliers,
+            double primal_step_length, double dual_step_length);
+      [[nodiscard]] static double mean_squared_complementarity(const FlatBounds& bounds, const Vector<double>& current_primals,
+            const Multipliers& current_multipliers, const Vector<double>& primal_direction, const Multipliers& direction_multipliers,
+            double primal_step_length, double dual_step_length);
+      [[nodiscard]] SymmetricIndefiniteLinearSolver<int, double>& augmented_system_solver() const;
+      void solve_augmented_system();
       void compute_least_square_multipliers(const OptimizationProblem& problem, Iterate& iterate, Vector<double>& constraint_multipliers);
    };
 } // namespace
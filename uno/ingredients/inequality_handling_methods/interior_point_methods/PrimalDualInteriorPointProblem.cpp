@@ -44,7 +44,7 @@ namespace uno {
       problem.evaluate_constraints(iterate, constraints);
    }
 
-   void PrimalDualInteriorPointProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const {
+   void PrimalDualInteriorPointProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrixView<double>& constraint_jacobian) const {
       problem.evaluate_constraint_jacobian(iterate, constraint_jacobian);
    }
 
@@ -55,16 +55,18 @@ namespace uno {
 
       // barrier terms
       for (size_t variable_index: Range(this->problem.number_variables)) {
-         double diagonal_barrier_term = 0.;
-         if (is_finite(this->problem.variable_lower_bound(variable_index))) { // lower bounded
-            const double distance_to_bound = x[variable_index] - problem.variable_lower_bound(variable_index);
-            diagonal_barrier_term += this->current_multipliers.lower_bounds[variable_index] / distance_to_bound;
-         }
-         if (is_finite(this->problem.variable_upper_bound(variable_index))) { // upper bounded
-            const double distance_to_bound = x[variable_index] - problem.variable_upper_bound(variable_index);
-            diagonal_barrier_term += this->current_multipliers.upper_bounds[variable_index] / distance_to_bound;
-         }
-         hessian.insert(diagonal_barrier_term, variable_index, variable_index);
+         hessian.insert(this->diagonal_barrier_term(x, variable_index), variable_index, variable_index);
+      }
+   }
+
+   void PrimalDualInteriorPointProblem::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& multipliers,
+         const Vector<double>& vector, Vector<double>& result) const {
+      // original Lagrangian Hessian
+      this->problem.evaluate_lagrangian_hessian_vector_product(x, multipliers, vector, result);
+
+      // barrier terms
+      for (size_t variable_index: Range(this->problem.number_variables)) {
+         result[variable_index] += this->diagonal_barrier_term(x, variable_index) * vector[variable_index];
       }
    }
 
@@ -132,28 +134,56 @@ namespace uno {
 
       // barrier terms
       for (size_t variable_index: Range(this->problem.number_variables)) {
-         double barrier_term = 0.;
-         if (is_finite(problem.variable_lower_bound(variable_index))) { // lower bounded
-            barrier_term += -this->barrier_parameter/(iterate.primals[variable_index] - problem.variable_lower_bound(variable_index));
-            // damping
-            if (!is_finite(problem.variable_upper_bound(variable_index))) {
-               barrier_term += this->damping_factor * this->barrier_parameter;
-            }
+         // the objective contribution of the Lagrangian gradient may be scaled. Barrier terms go into the constraint contribution
+         lagrangian_gradient.constraints_contribution[variable_index] += this->barrier_term(iterate, variable_index);
+      }
+   }
+
+   double PrimalDualInteriorPointProblem::evaluate_stationarity_error(Vector<double>& lagrangian_gradient, Iterate& iterate,
+         const Multipliers& multipliers, double objective_multiplier, Norm residual_norm) const {
+      // the barrier terms are added to the vector assembled by the reformulated problem, then the norm is recomputed
+      [[maybe_unused]] const double error = this->problem.evaluate_stationarity_error(lagrangian_gradient, iterate, multipliers,
+            objective_multiplier, residual_norm);
+      return fused_norm(residual_norm, this->problem.number_variables, [&](size_t variable_index) {
+         lagrangian_gradient[variable_index] += this->barrier_term(iterate, variable_index);
+         return lagrangian_gradient[variable_index];
+      });
+   }
+
+   double PrimalDualInteriorPointProblem::barrier_term(const Iterate& iterate, size_t variable_index) const {
+      double barrier_term = 0.;
+      if (is_finite(problem.variable_lower_bound(variable_index))) { // lower bounded
+         barrier_term += -this->barrier_parameter/(iterate.primals[variable_index] - problem.variable_lower_bound(variable_index));
+         // damping
+         if (!is_finite(problem.variable_upper_bound(variable_index))) {
+            barrier_term += this->damping_factor * this->barrier_parameter;
          }
-         if (is_finite(problem.variable_upper_bound(variable_index))) { // upper bounded
-            barrier_term += -this->barrier_parameter/(iterate.primals[variable_index] - problem.variable_upper_bound(variable_index));
-            // damping
-            if (!is_finite(problem.variable_lower_bound(variable_index))) {
-               barrier_term -= this->damping_factor * this->barrier_parameter;
-            }
+      }
+      if (is_finite(problem.variable_upper_bound(variable_index))) { // upper bounded
+         barrier_term += -this->barrier_parameter/(iterate.primals[variable_index] - problem.variable_upper_bound(variable_index));
+         // damping
+         if (!is_finite(problem.variable_lower_bound(variable_index))) {
+            barrier_term -= this->damping_factor * this->barrier_parameter;
          }
-         // the objective contribution of the Lagrangian gradient may be scaled. Barrier terms go into the constraint contribution
-         lagrangian_gradient.constraints_contribution[variable_index] += barrier_term;
       }
+      return barrier_term;
    }
 
    double PrimalDualInteriorPointProblem::complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
          const Multipliers& multipliers, double shift_value, Norm residual_norm) const {
       return this->problem.complementarity_error(primals, constraints, multipliers, shift_value, residual_norm);
    }
+
+   double PrimalDualInteriorPointProblem::diagonal_barrier_term(const Vector<double>& x, size_t variable_index) const {
+      double diagonal_barrier_term = 0.;
+      if (is_finite(this->problem.variable_lower_bound(variable_index))) { // lower bounded
+         const double distance_to_bound = x[variable_index] - this->problem.variable_lower_bound(variable_index);
+         diagonal_barrier_term += this->current_multipliers.lower_bounds[variable_index] / distance_to_bound;
+      }
+      if (is_finite(this->problem.variable_upper_bound(variable_index))) { // upper bounded
+         const double distance_to_bound = x[variable_index] - this->problem.variable_upper_bound(variable_index);
+         diagonal_barrier_term += this->current_multipliers.upper_bounds[variable_index] / distance_to_bound;
+      }
+      return diagonal_barrier_term;
+   }
 } // namespace
\ No newline at end of file
@@ -15,9 +15,11 @@ namespace uno {
       [[nodiscard]] double get_objective_multiplier() const override;
       void evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const override;
       void evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const override;
-      void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrixView<double>& constraint_jacobian) const override;
       void evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers,
             SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& multipliers, const Vector<double>& vector,
+            Vector<double>& result) const override;
 
       [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
       [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
@@ -34,6 +36,8 @@ namespace uno {
 
       void evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate,
             const Multipliers& multipliers) const override;
+      [[nodiscard]] double evaluate_stationarity_error(Vector<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers,
+            double objective_multiplier, Norm residual_norm) const override;
       [[nodiscard]] double complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
             const Multipliers& multipliers, double shift_value, Norm residual_norm) const override;
 
@@ -42,6 +46,9 @@ namespace uno {
       const Multipliers& current_multipliers;
       const double barrier_parameter;
       const double damping_factor{1e-5};
+
+      [[nodiscard]] double diagonal_barrier_term(const Vector<double>& x, size_t variable_index) const;
+      [[nodiscard]] double barrier_term(const Iterate& iterate, size_t variable_index) const;
    };
 } // namespace
 
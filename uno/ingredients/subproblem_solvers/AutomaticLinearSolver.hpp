@@ -0,0 +1,225 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_AUTOMATICLINEARSOLVER_H
+#define UNO_AUTOMATICLINEARSOLVER_H
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Timer.hpp"
+
+namespace uno {
+   /*! \class AutomaticLinearSolver
+    * \brief Linear solver chosen by timing two candidates (linear_solver = auto)
+    *
+    *  The first matrix is analyzed and factorized by both candidates. The candidate with the shorter analysis + factorization time
+    *  (or the only one that succeeds) is kept and the other one is released: all subsequent operations are delegated to the winner
+    */
+   template <typename IndexType>
+   class AutomaticLinearSolver: public DirectSymmetricIndefiniteLinearSolver<IndexType, double> {
+   public:
+      using Candidate = std::pair<std::string, std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, double>>>;
+
+      AutomaticLinearSolver(size_t dimension, Candidate first_candidate, Candidate second_candidate);
+      ~AutomaticLinearSolver() override = default;
+
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+            size_t number_rhs) override;
+      void set_pivot_order(const std::vector<size_t>& pivot_order) override;
+      void set_static_pivoting(bool static_pivoting) override;
+
+      [[nodiscard]] bool has_converged() const override { return this->solver().has_converged(); }
+      [[nodiscard]] bool provides_inertia() const override { return this->solver().provides_inertia(); }
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override { return this->solver().get_inertia(); }
+      [[nodiscard]] size_t number_negative_eigenvalues() const override { return this->solver().number_negative_eigenvalues(); }
+      [[nodiscard]] bool matrix_is_singular() const override { return this->solver().matrix_is_singular(); }
+      [[nodiscard]] size_t rank() const override { return this->solver().rank(); }
+      [[nodiscard]] size_t memory_size() const override;
+      [[nodiscard]] size_t get_peak_workspace_size() const override;
+      // the statistics of the candidates that were not discarded
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const override;
+
+      // name of the selected solver (empty before the first factorization)
+      [[nodiscard]] std::string selected_solver() const;
+
+   protected:
+      std::array<Candidate, 2> candidates;
+      std::array<double, 2> durations{0., 0.}; // analysis + factorization times of the first matrix
+      std::array<bool, 2> is_valid{true, true}; // the candidate did not fail
+      size_t selected_index{0};
+      bool is_selected{false};
+
+      [[nodiscard]] DirectSymmetricIndefiniteLinearSolver<IndexType, double>& solver() const;
+      void select_fastest_candidate();
+   };
+
+   // implementation
+
+   template <typename IndexType>
+   AutomaticLinearSolver<IndexType>::AutomaticLinearSolver(size_t dimension, Candidate first_candidate, Candidate second_candidate):
+         DirectSymmetricIndefiniteLinearSolver<IndexType, double>(dimension),
+         candidates{std::move(first_candidate), std::move(second_candidate)} {
+   }
+
+   template <typename IndexType>
+   void AutomaticLinearSolver<IndexType>::do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) {
+      if (this->is_selected) {
+         this->solver().do_symbolic_analysis(matrix);
+         return;
+      }
+      for (size_t candidate_index: Range(this->candidates.size())) {
+         if (this->is_valid[candidate_index]) {
+            const Timer timer{};
+            try {
+               this->candidates[candidate_index].second->do_symbolic_analysis(matrix);
+            }
+            catch (const std::exception& exception) {
+               DEBUG << "linear_solver auto: the analysis with " << this->candidates[candidate_index].first << " failed (" << exception.what() << ")\n";
+               this->is_valid[candidate_index] = false;
+            }
+            this->durations[candidate_index] += timer.get_duration();
+         }
+      }
+      if (!this->is_valid[0] && !this->is_valid[1]) {
+         throw std::runtime_error("linear_solver auto: the symbolic analysis failed with both candidates");
+      }
+   }
+
+   template <typename IndexType>
+   void AutomaticLinearSolver<IndexType>::do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) {
+      if (this->is_selected) {
+         this->solver().do_numerical_factorization(matrix);
+         return;
+      }
+      for (size_t candidate_index: Range(this->candidates.size())) {
+         if (this->is_valid[candidate_index]) {
+            const Timer timer{};
+            try {
+               this->candidates[candidate_index].second->do_numerical_factorization(matrix);
+            }
+            catch (const std::exception& exception) {
+               DEBUG << "linear_solver auto: the factorization with " << this->candidates[candidate_index].first << " failed (" << exception.what() << ")\n";
+               this->is_valid[candidate_index] = false;
+            }
+            this->durations[candidate_index] += timer.get_duration();
+         }
+      }
+      if (!this->is_valid[0] && !this->is_valid[1]) {
+         throw std::runtime_error("linear_solver auto: the numerical factorization failed with both candidates");
+      }
+      this->select_fastest_candidate();
+   }
+
+   template <typename IndexType>
+   void AutomaticLinearSolver<IndexType>::solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs,
+         Vector<double>& result) {
+      this->solver().solve_indefinite_system(matrix, rhs, result);
+   }
+
+   template <typename IndexType>
+   void AutomaticLinearSolver<IndexType>::solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs,
+         Vector<double>& result, size_t number_rhs) {
+      this->solver().solve_indefinite_systems(matrix, rhs, result, number_rhs);
+   }
+
+   template <typename IndexType>
+   void AutomaticLinearSolver<IndexType>::set_pivot_order(const std::vector<size_t>& pivot_order) {
+      if (this->is_selected) {
+         this->solver().set_pivot_order(pivot_order);
+         return;
+      }
+      // the pivot order must be accepted by both candidates, otherwise the comparison would be biased
+      for (Candidate& candidate: this->candidates) {
+         candidate.second->set_pivot_order(pivot_order);
+      }
+   }
+
+   template <typename IndexType>
+   void AutomaticLinearSolver<IndexType>::set_static_pivoting(bool static_pivoting) {
+      for (Candidate& candidate: this->candidates) {
+         if (candidate.second != nullptr) {
+            candidate.second->set_static_pivoting(static_pivoting);
+         }
+      }
+   }
+
+   template <typename IndexType>
+   size_t AutomaticLinearSolver<IndexType>::memory_size() const {
+      size_t memory_size = 0;
+      for (const Candidate& candidate: this->candidates) {
+         if (candidate.second != nullptr) {
+            memory_size += candidate.second->memory_size();
+         }
+      }
+      return memory_size;
+   }
+
+   template <typename IndexType>
+   size_t AutomaticLinearSolver<IndexType>::get_peak_workspace_size() const {
+      size_t peak_workspace_size = 0;
+      for (const Candidate& candidate: this->candidates) {
+         if (candidate.second != nullptr) {
+            peak_workspace_size = std::max(peak_workspace_size, candidate.second->get_peak_workspace_size());
+         }
+      }
+      return peak_workspace_size;
+   }
+
+   template <typename IndexType>
+   FactorizationStatistics AutomaticLinearSolver<IndexType>::get_factorization_statistics() const {
+      FactorizationStatistics statistics{};
+      for (const Candidate& candidate: this->candidates) {
+         if (candidate.second != nullptr) {
+            statistics.accumulate(candidate.second->get_factorization_statistics());
+         }
+      }
+      return statistics;
+   }
+
+   template <typename IndexType>
+   std::string AutomaticLinearSolver<IndexType>::selected_solver() const {
+      return this->is_selected ? this->candidates[this->selected_index].first : std::string{};
+   }
+
+   // before the selection, the operations (e.g. the solves of the first factorization) are delegated to the first valid candidate
+   template <typename IndexType>
+   DirectSymmetricIndefiniteLinearSolver<IndexType, double>& AutomaticLinearSolver<IndexType>::solver() const {
+      const size_t candidate_index = this->is_selected ? this->selected_index : (this->is_valid[0] ? 0 : 1);
+      return *this->candidates[candidate_index].second;
+   }
+
+   template <typename IndexType>
+   void AutomaticLinearSolver<IndexType>::select_fastest_candidate() {
+      if (!this->is_valid[0]) {
+         this->selected_index = 1;
+      }
+      else if (!this->is_valid[1]) {
+         this->selected_index = 0;
+      }
+      else {
+         this->selected_index = (this->durations[1] < this->durations[0]) ? 1 : 0;
+      }
+      this->is_selected = true;
+      DEBUG << "linear_solver auto: " << this->candidates[0].first << " took " << this->durations[0] << "s, " << this->candidates[1].first <<
+            " took " << this->durations[1] << "s. " << this->candidates[this->selected_index].first << " is selected\n";
+      // the other candidate is released
+      this->candidates[1 - this->selected_index].second.reset();
+   }
+} // namespace
+
+#endif // UNO_AUTOMATICLINEARSOLVER_H
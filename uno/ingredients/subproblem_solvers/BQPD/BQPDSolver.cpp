@@ -1,7 +1,10 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <cassert>
+#include <mutex>
+#include <string>
 #include "BQPDSolver.hpp"
 #include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
 #include "ingredients/hessian_models/HessianModel.hpp"
@@ -11,8 +14,10 @@
 #include "optimization/Iterate.hpp"
 #include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
+#include "tools/Statistics.hpp"
 #include "tools/Infinity.hpp"
 #include "tools/Logger.hpp"
+#include "tools/MemoryReport.hpp"
 #include "fortran_interface.h"
 
 #define WSC FC_GLOBAL(wsc, WSC)
@@ -42,6 +47,14 @@ extern "C" {
 namespace uno {
    #define BIG 1e30
 
+   // guards the Fortran common blocks: WSC and ALPHAC (read by gdotx during the solve), and the factors and pointers of the other
+   // common blocks (bqpdc, sparsec, factorc, ...) reused by the hot starts
+   static std::mutex bqpd_mutex;
+   // solver that called BQPD last: the factors kept in the common blocks describe its workspace (guarded by bqpd_mutex)
+   static const BQPDSolver* last_bqpd_solver{nullptr};
+   // solver whose matrix-free Hessian is used by gdotx during the solve (nullptr: the Hessian is stored in the workspace)
+   static const BQPDSolver* matrix_free_bqpd_solver{nullptr};
+
    // preallocate a bunch of stuff
    BQPDSolver::BQPDSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros, size_t number_jacobian_nonzeros,
          size_t number_hessian_nonzeros, BQPDProblemType problem_type, const Options& options):
@@ -50,30 +63,39 @@ namespace uno {
          upper_bounds(number_variables + number_constraints),
          constraints(number_constraints),
          linear_objective(number_objective_gradient_nonzeros),
-         constraint_jacobian(number_constraints, number_variables),
          bqpd_jacobian(number_jacobian_nonzeros + number_objective_gradient_nonzeros), // Jacobian + objective gradient
          bqpd_jacobian_sparsity(number_jacobian_nonzeros + number_objective_gradient_nonzeros + number_constraints + 3),
-         hessian(number_variables, number_hessian_nonzeros, options.get_string("globalization_mechanism") != "TR" || options.get_bool("convexify_QP"),
+         hessian(number_variables, number_hessian_nonzeros, options.get_string("globalization_mechanism") == "LS" || options.get_bool("convexify_QP"),
                "CSC"),
-         kmax(problem_type == BQPDProblemType::QP ? options.get_int("BQPD_kmax") : 0), alp(static_cast<size_t>(this->mlp)),
+         number_variables(number_variables),
+         kmax(problem_type == BQPDProblemType::QP ? std::min(options.get_int("BQPD_kmax"), static_cast<int>(number_variables)) : 0),
+         // sparse factors of the basis matrix: a few times the number of nonzeros of the Jacobian (with the objective gradient)
+         mxwk0(10000 + 5 * (number_jacobian_nonzeros + number_objective_gradient_nonzeros) + 10 * (number_variables + number_constraints)),
+         mxiwk0(5000 + 5 * (number_jacobian_nonzeros + number_objective_gradient_nonzeros) + 10 * (number_variables + number_constraints)),
+         alp(static_cast<size_t>(this->mlp)),
          lp(static_cast<size_t>(this->mlp)),
          active_set(number_variables + number_constraints),
          w(number_variables + number_constraints), gradient_solution(number_variables), residuals(number_variables + number_constraints),
          e(number_variables + number_constraints),
          size_hessian_sparsity(problem_type == BQPDProblemType::QP ? number_hessian_nonzeros + number_variables + 3 : 0),
-         size_hessian_workspace(number_hessian_nonzeros + static_cast<size_t>(this->kmax * (this->kmax + 9) / 2) + 2 * number_variables +
-                                number_constraints + this->mxwk0),
-         size_hessian_sparsity_workspace(this->size_hessian_sparsity + static_cast<size_t>(this->kmax) + this->mxiwk0),
-         workspace(this->size_hessian_workspace),
-         workspace_sparsity(this->size_hessian_sparsity_workspace),
+         size_hessian_workspace(number_hessian_nonzeros + 2 * number_variables + number_constraints),
          current_hessian_indices(number_variables),
+         matrix_free_hessian(options.get_bool("BQPD_matrix_free_hessian")),
+         hessian_vector(number_variables),
+         hessian_product(number_variables),
          print_subproblem(options.get_bool("print_subproblem")) {
+      this->allocate_workspaces();
       // default active set
       for (size_t variable_index: Range(number_variables + number_constraints)) {
          this->active_set[variable_index] = static_cast<int>(variable_index) + this->fortran_shift;
       }
    }
 
+   void BQPDSolver::initialize_statistics(Statistics& statistics, const Options& options) {
+      statistics.add_column("hot/cold", Statistics::int_width + 4, options.get_int("statistics_QP_starts_column_order"));
+      statistics.add_column("QP iter", Statistics::int_width, options.get_int("statistics_subproblem_iterations_column_order"));
+   }
+
    void BQPDSolver::solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& initial_point, Direction& direction,
          double trust_region_radius, const WarmstartInformation& warmstart_information) {
       if (this->print_subproblem) {
@@ -88,28 +110,75 @@ namespace uno {
          double trust_region_radius, const WarmstartInformation& warmstart_information) {
       this->set_up_subproblem(problem, current_iterate, trust_region_radius, warmstart_information);
       if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
-         hessian_model.evaluate(statistics, problem, current_iterate.primals, current_multipliers, this->hessian);
-         this->save_hessian_to_local_format();
+         this->is_hessian_matrix_free = this->matrix_free_hessian && hessian_model.supports_matrix_free_products();
+         if (this->is_hessian_matrix_free) {
+            // gdotx computes the products at the current primal-dual point: no Hessian in the workspace
+            this->hessian_problem = &problem;
+            this->hessian_model = &hessian_model;
+            this->hessian_primals = current_iterate.primals;
+            this->hessian_multipliers = current_multipliers;
+            this->hessian_workspace_length = 0;
+            this->hessian_sparsity_workspace_length = 0;
+            this->is_hessian_sparsity_valid = false;
+         }
+         else {
+            hessian_model.evaluate(statistics, problem, current_iterate.primals, current_multipliers, this->hessian);
+            // the sparsity pattern is rebuilt only if it changed; otherwise, only the values are scattered
+            if (warmstart_information.hessian_sparsity_changed || !this->save_hessian_values()) {
+               this->save_hessian_to_local_format();
+            }
+         }
       }
       if (this->print_subproblem) {
          DEBUG << "QP:\n";
       }
-      DEBUG << "Hessian: " << this->hessian;
+      if (!this->is_hessian_matrix_free) {
+         DEBUG << "Hessian: " << this->hessian;
+      }
       this->solve_subproblem(problem, initial_point, direction, warmstart_information);
+      statistics.set("hot/cold", std::to_string(this->number_hot_starts) + "/" + std::to_string(this->number_cold_starts));
+      // number of pivots of the last solve
+      statistics.set("QP iter", this->info[0]);
    }
 
    double BQPDSolver::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      if (this->is_hessian_matrix_free) {
+         this->hessian_model->compute_hessian_vector_product(*this->hessian_problem, this->hessian_primals, this->hessian_multipliers,
+               primal_direction, this->hessian_product);
+         double quadratic_product = 0.;
+         for (size_t variable_index: Range(this->hessian_problem->number_variables)) {
+            quadratic_product += primal_direction[variable_index] * this->hessian_product[variable_index];
+         }
+         return quadratic_product;
+      }
       return this->hessian.quadratic_product(primal_direction, primal_direction);
    }
 
+   void BQPDSolver::report_memory(MemoryReport& report) const {
+      report.add("QP solver/bounds", MemoryReport::memory_size(this->lower_bounds) + MemoryReport::memory_size(this->upper_bounds));
+      report.add("QP solver/constraints", MemoryReport::memory_size(this->constraints));
+      report.add("QP solver/objective gradient", this->linear_objective.memory_size());
+      report.add("QP solver/BQPD gradients", MemoryReport::memory_size(this->bqpd_jacobian) +
+            MemoryReport::memory_size(this->bqpd_jacobian_sparsity));
+      report.add("QP solver/Hessian", this->hessian.memory_size() + this->current_hessian_indices.memory_size());
+      report.add("QP solver/workspaces", MemoryReport::memory_size(this->workspace) + MemoryReport::memory_size(this->workspace_sparsity) +
+            MemoryReport::memory_size(this->alp) + MemoryReport::memory_size(this->lp) + MemoryReport::memory_size(this->active_set) +
+            MemoryReport::memory_size(this->w) + MemoryReport::memory_size(this->gradient_solution) + MemoryReport::memory_size(this->residuals) +
+            MemoryReport::memory_size(this->e));
+      report.add("QP solver/matrix-free Hessian", this->hessian_primals.memory_size() + this->hessian_multipliers.memory_size() +
+            this->hessian_vector.memory_size() + this->hessian_product.memory_size());
+   }
+
+   void BQPDSolver::compute_hessian_vector_product(const double* vector, double* result) const {
+      const size_t number_variables = this->hessian_problem->number_variables;
+      std::copy(vector, vector + number_variables, this->hessian_vector.data());
+      this->hessian_model->compute_hessian_vector_product(*this->hessian_problem, this->hessian_primals, this->hessian_multipliers,
+            this->hessian_vector, this->hessian_product);
+      std::copy(this->hessian_product.data(), this->hessian_product.data() + number_variables, result);
+   }
+
    void BQPDSolver::set_up_subproblem(const OptimizationProblem& problem, Iterate& current_iterate, double trust_region_radius,
          const WarmstartInformation& warmstart_information) {
-      // initialize wsc_ common block (Hessian & workspace for BQPD)
-      // setting the common block here ensures that several instances of BQPD can run simultaneously
-      WSC.mxws = static_cast<int>(this->size_hessian_workspace);
-      WSC.mxlws = static_cast<int>(this->size_hessian_sparsity_workspace);
-      ALPHAC.alpha = 0; // inertia control
-
       // function evaluations
       if (warmstart_information.objective_changed) {
          problem.evaluate_objective_gradient(current_iterate, this->linear_objective);
@@ -121,7 +190,10 @@ namespace uno {
 
       // Jacobian (objective and constraints)
       if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
-         this->save_gradients_to_local_format(problem.number_constraints);
+         // the sparsity pattern is rebuilt only if it changed; otherwise, only the values are scattered
+         if (warmstart_information.jacobian_sparsity_changed || !this->save_gradient_values(problem.number_constraints)) {
+            this->save_gradients_to_local_format(problem.number_constraints);
+         }
       }
 
       // variable bounds
@@ -176,19 +248,61 @@ namespace uno {
       const int n = static_cast<int>(problem.number_variables);
       const int m = static_cast<int>(problem.number_constraints);
 
-      const BQPDMode mode = BQPDSolver::determine_mode(warmstart_information);
-      const int mode_integer = static_cast<int>(mode);
-
-      // solve the LP/QP
-      DEBUG2 << "Running BQPD\n";
-      BQPD(&n, &m, &this->k, &this->kmax, this->bqpd_jacobian.data(), this->bqpd_jacobian_sparsity.data(), direction.primals.data(),
-            this->lower_bounds.data(), this->upper_bounds.data(), &direction.subproblem_objective, &this->fmin, this->gradient_solution.data(),
-            this->residuals.data(), this->w.data(), this->e.data(), this->active_set.data(), this->alp.data(), this->lp.data(), &this->mlp,
-            &this->peq_solution, this->workspace.data(), this->workspace_sparsity.data(), &mode_integer, &this->ifail, this->info.data(),
-            &this->iprint, &this->nout);
-      DEBUG2 << "Ran BQPD\n";
-      const BQPDStatus bqpd_status = BQPDSolver::bqpd_status_from_int(this->ifail);
+      BQPDMode mode = this->determine_mode(warmstart_information);
+      // first cold start: hot start from the basis provided by the user (e.g. AMPL's sstatus suffixes)
+      if (mode == BQPDMode::ACTIVE_SET_EQUALITIES && !this->is_initial_basis_requested) {
+         this->is_initial_basis_requested = true;
+         if (this->set_initial_active_set(problem)) {
+            DEBUG << "BQPD: hot start from the initial basis\n";
+            mode = BQPDMode::USER_DEFINED;
+         }
+      }
+
+      // solve the LP/QP. If a workspace is too small, grow it and solve again (cold start)
+      BQPDStatus bqpd_status = BQPDStatus::UNDEFINED;
+      size_t number_regrowths = 0;
+      bool solve = true;
+      while (solve) {
+         {
+            // the common blocks are process-wide: serialize the calls and load the state of this instance
+            const std::lock_guard<std::mutex> lock(bqpd_mutex);
+            // the factors in the common blocks belong to another instance: a hot start would read them against this workspace
+            if (last_bqpd_solver != this && BQPDMode::USER_DEFINED < mode) {
+               DEBUG << "BQPD: another instance was solved in the meantime, cold start\n";
+               mode = BQPDMode::ACTIVE_SET_EQUALITIES;
+               direction.primals = initial_point;
+            }
+            last_bqpd_solver = this;
+            if (number_regrowths == 0) {
+               if (mode == BQPDMode::ACTIVE_SET_EQUALITIES) {
+                  this->number_cold_starts++;
+               }
+               else {
+                  this->number_hot_starts++;
+               }
+            }
+            const int mode_integer = static_cast<int>(mode);
+            DEBUG2 << "Running BQPD in mode " << mode_integer << '\n';
+            this->load_common_blocks();
+            matrix_free_bqpd_solver = this->is_hessian_matrix_free ? this : nullptr;
+            BQPD(&n, &m, &this->k, &this->kmax, this->bqpd_jacobian.data(), this->bqpd_jacobian_sparsity.data(), direction.primals.data(),
+                  this->lower_bounds.data(), this->upper_bounds.data(), &direction.subproblem_objective, &this->fmin, this->gradient_solution.data(),
+                  this->residuals.data(), this->w.data(), this->e.data(), this->active_set.data(), this->alp.data(), this->lp.data(), &this->mlp,
+                  &this->peq_solution, this->workspace.data(), this->workspace_sparsity.data(), &mode_integer, &this->ifail, this->info.data(),
+                  &this->iprint, &this->nout);
+         }
+         DEBUG2 << "Ran BQPD\n";
+         bqpd_status = BQPDSolver::bqpd_status_from_int(this->ifail);
+         solve = (number_regrowths < BQPDSolver::maximum_number_regrowths) && this->grow_workspaces(bqpd_status);
+         if (solve) {
+            number_regrowths++;
+            mode = BQPDMode::ACTIVE_SET_EQUALITIES;
+            direction.primals = initial_point;
+         }
+      }
       direction.status = BQPDSolver::status_from_bqpd_status(bqpd_status);
+      // the active set and the factors can be reused only after a successful solve
+      this->is_active_set_valid = (bqpd_status == BQPDStatus::OPTIMAL);
 
       // project solution into bounds
       for (size_t variable_index: Range(problem.number_variables)) {
@@ -198,18 +312,105 @@ namespace uno {
       this->set_multipliers(problem.number_variables, direction.multipliers);
    }
 
-   BQPDMode BQPDSolver::determine_mode(const WarmstartInformation& warmstart_information) {
-      BQPDMode mode = BQPDMode::USER_DEFINED;
-      // if problem structure changed, use cold start
-      if (warmstart_information.hessian_sparsity_changed || warmstart_information.jacobian_sparsity_changed) {
-         mode = BQPDMode::ACTIVE_SET_EQUALITIES;
+   BQPDMode BQPDSolver::determine_mode(const WarmstartInformation& warmstart_information) const {
+      // if the problem structure changed or the last solve failed, use cold start
+      if (!this->is_active_set_valid || warmstart_information.hessian_sparsity_changed || warmstart_information.jacobian_sparsity_changed) {
+         return BQPDMode::ACTIVE_SET_EQUALITIES;
+      }
+      // if only the bounds changed (e.g. trust-region radius decrease), the Jacobian (with the objective gradient) and the Hessian are
+      // unchanged: reuse the active set, the Jacobian information and the reduced Hessian factors
+      if (not warmstart_information.objective_changed && not warmstart_information.constraints_changed) {
+         return (0 < this->kmax) ? BQPDMode::UNCHANGED_ACTIVE_SET_AND_JACOBIAN_AND_REDUCED_HESSIAN : BQPDMode::UNCHANGED_ACTIVE_SET_AND_JACOBIAN;
+      }
+      // new iterate: reuse the active set of the previous call
+      return BQPDMode::UNCHANGED_ACTIVE_SET;
+   }
+
+   // active set (ls) and dimension of the null space (k) from the basis provided by the user: the nonbasic variables and constraints are
+   // active (a negative index denotes an upper bound), followed by the basic ones
+   bool BQPDSolver::set_initial_active_set(const OptimizationProblem& problem) {
+      std::vector<BasisStatus> variable_statuses{};
+      std::vector<BasisStatus> constraint_statuses{};
+      if (!problem.get_initial_basis(variable_statuses, constraint_statuses)) {
+         return false;
+      }
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints = problem.number_constraints;
+      const auto status = [&](size_t index) {
+         return (index < number_variables) ? variable_statuses[index] : constraint_statuses[index - number_variables];
+      };
+      size_t number_active_constraints = 0;
+      for (size_t index: Range(number_variables + number_constraints)) {
+         if (status(index) != BasisStatus::BASIC) {
+            number_active_constraints++;
+         }
+      }
+      // the null space cannot exceed the size of the reduced Hessian
+      if (number_variables < number_active_constraints || this->kmax < static_cast<int>(number_variables - number_active_constraints)) {
+         DEBUG << "BQPD: the initial basis is inconsistent, it is discarded\n";
+         return false;
+      }
+      size_t active_position = 0;
+      size_t inactive_position = number_active_constraints;
+      for (size_t index: Range(number_variables + number_constraints)) {
+         const int bqpd_index = static_cast<int>(index) + this->fortran_shift;
+         const BasisStatus index_status = status(index);
+         if (index_status == BasisStatus::BASIC) {
+            this->active_set[inactive_position++] = bqpd_index;
+         }
+         else {
+            this->active_set[active_position++] = (index_status == BasisStatus::AT_UPPER_BOUND) ? -bqpd_index : bqpd_index;
+         }
+      }
+      this->k = static_cast<int>(number_variables - number_active_constraints);
+      return true;
+   }
+
+   // copy the state of this instance into the common blocks (Hessian and workspace sizes)
+   void BQPDSolver::load_common_blocks() const {
+      WSC.kk = this->hessian_workspace_length; // length of ws that is used by gdotx
+      WSC.ll = this->hessian_sparsity_workspace_length; // length of lws that is used by gdotx
+      WSC.mxws = static_cast<int>(this->workspace.size());
+      WSC.mxlws = static_cast<int>(this->workspace_sparsity.size());
+      ALPHAC.alpha = 0; // inertia control
+   }
+
+   // grow the workspace that caused an insufficient-space status. Returns false if the status is not a space issue or if kmax reached n
+   bool BQPDSolver::grow_workspaces(BQPDStatus bqpd_status) {
+      if (bqpd_status == BQPDStatus::LP_INSUFFICIENT_SPACE) {
+         this->mlp *= static_cast<int>(BQPDSolver::workspace_growth_factor);
+         this->alp.resize(static_cast<size_t>(this->mlp));
+         this->lp.resize(static_cast<size_t>(this->mlp));
+         DEBUG << "BQPD: mlp increased to " << this->mlp << '\n';
+         return true;
+      }
+      else if (bqpd_status == BQPDStatus::HESSIAN_INSUFFICIENT_SPACE) {
+         const int kmax_limit = static_cast<int>(this->number_variables);
+         if (this->kmax == 0 || kmax_limit <= this->kmax) {
+            return false;
+         }
+         this->kmax = std::min(static_cast<int>(BQPDSolver::workspace_growth_factor) * this->kmax, kmax_limit);
+         DEBUG << "BQPD: kmax increased to " << this->kmax << '\n';
       }
-      // if only the variable bounds changed, reuse the active set estimate and the Jacobian information
-      else if (warmstart_information.variable_bounds_changed && not warmstart_information.objective_changed &&
-               not warmstart_information.constraints_changed && not warmstart_information.constraint_bounds_changed) {
-         mode = BQPDMode::UNCHANGED_ACTIVE_SET_AND_JACOBIAN;
+      else if (bqpd_status == BQPDStatus::SPARSE_INSUFFICIENT_SPACE) {
+         this->mxwk0 *= BQPDSolver::workspace_growth_factor;
+         this->mxiwk0 *= BQPDSolver::workspace_growth_factor;
+         DEBUG << "BQPD: sparse workspaces increased to " << this->mxwk0 << " and " << this->mxiwk0 << '\n';
       }
-      return mode;
+      else {
+         return false;
+      }
+      this->allocate_workspaces();
+      return true;
+   }
+
+   // the Hessian is stored at the beginning of the workspaces: resizing preserves it
+   void BQPDSolver::allocate_workspaces() {
+      const size_t kmax_size = static_cast<size_t>(this->kmax);
+      this->workspace.resize(this->size_hessian_workspace + kmax_size * (kmax_size + 9) / 2 + this->mxwk0);
+      this->workspace_sparsity.resize(this->size_hessian_sparsity + kmax_size + this->mxiwk0);
+      this->peak_workspace_size = std::max(this->peak_workspace_size, this->workspace.size() * sizeof(double) +
+         this->workspace_sparsity.size() * sizeof(int));
    }
 
    // save Hessian (in arbitrary format) to a "weak" CSC format: compressed columns but row indices are not sorted, nor unique
@@ -224,9 +425,9 @@ namespace uno {
       for (size_t column_index: Range(this->hessian.dimension() + 1)) {
          column_starts[column_index] = 0;
       }
-      for (const auto [row_index, column_index, element]: this->hessian) {
+      this->hessian.for_each([&](size_t /*row_index*/, size_t column_index, double /*element*/) {
          column_starts[column_index + 1]++;
-      }
+      });
       // carry over the column starts
       for (size_t column_index: Range(1, this->hessian.dimension() + 1)) {
          column_starts[column_index] += column_starts[column_index - 1];
@@ -236,16 +437,43 @@ namespace uno {
       // copy the entries
       //std::vector<int> current_indices(hessian.dimension());
       this->current_hessian_indices.fill(0);
-      for (const auto [row_index, column_index, element]: this->hessian) {
+      this->hessian.for_each([&](size_t row_index, size_t column_index, double element) {
          const size_t index = static_cast<size_t>(column_starts[column_index] + this->current_hessian_indices[column_index] - this->fortran_shift);
          assert(index <= static_cast<size_t>(column_starts[column_index + 1]) &&
                 "BQPD: error in converting the Hessian matrix to the local format. Try setting the sparse format to CSC");
          this->workspace[index] = element;
          row_indices[index] = static_cast<int>(row_index) + this->fortran_shift;
          this->current_hessian_indices[column_index]++;
+      });
+      this->hessian_workspace_length = static_cast<int>(this->hessian.number_nonzeros());
+      this->hessian_sparsity_workspace_length = static_cast<int>(this->hessian.number_nonzeros() + this->hessian.dimension() + 2);
+      this->is_hessian_sparsity_valid = true;
+      // the factors refer to the previous sparsity pattern
+      this->is_active_set_valid = false;
+   }
+
+   // scatter the Hessian values into the cached sparsity pattern. Returns false if the pattern does not match
+   bool BQPDSolver::save_hessian_values() {
+      if (!this->is_hessian_sparsity_valid || this->hessian_workspace_length != static_cast<int>(this->hessian.number_nonzeros())) {
+         return false;
       }
-      WSC.kk = static_cast<int>(this->hessian.number_nonzeros()); // length of ws that is used by gdotx
-      WSC.ll = static_cast<int>(this->hessian.number_nonzeros() + this->hessian.dimension() + 2); // length of lws that is used by gdotx
+      const size_t header_size = 1;
+      const int* row_indices = &this->workspace_sparsity[header_size];
+      const int* column_starts = &this->workspace_sparsity[header_size + this->hessian.number_nonzeros()];
+      bool is_pattern_identical = true;
+      this->current_hessian_indices.fill(0);
+      this->hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+         const size_t index = static_cast<size_t>(column_starts[column_index] + this->current_hessian_indices[column_index] - this->fortran_shift);
+         if (is_pattern_identical && index < static_cast<size_t>(column_starts[column_index + 1] - this->fortran_shift) &&
+               row_indices[index] == static_cast<int>(row_index) + this->fortran_shift) {
+            this->workspace[index] = element;
+            this->current_hessian_indices[column_index]++;
+         }
+         else {
+            is_pattern_identical = false;
+         }
+      });
+      return is_pattern_identical;
    }
 
    void BQPDSolver::save_gradients_to_local_format(size_t number_constraints) {
@@ -276,6 +504,42 @@ namespace uno {
          this->bqpd_jacobian_sparsity[current_index] = static_cast<int>(size);
          current_index++;
       }
+      this->is_jacobian_sparsity_valid = true;
+      // the factors refer to the previous sparsity pattern
+      this->is_active_set_valid = false;
+   }
+
+   // scatter the objective gradient and the constraint Jacobian into the cached sparsity pattern. Returns false if the pattern does not match
+   bool BQPDSolver::save_gradient_values(size_t number_constraints) {
+      if (!this->is_jacobian_sparsity_valid) {
+         return false;
+      }
+      // the row starts follow the column indices of the nonzeros
+      const int* row_starts = &this->bqpd_jacobian_sparsity[static_cast<size_t>(this->bqpd_jacobian_sparsity[0])];
+      const auto save_row = [&](const auto& row, size_t row_index) {
+         const size_t row_start = static_cast<size_t>(row_starts[row_index] - this->fortran_shift);
+         if (row.size() != static_cast<size_t>(row_starts[row_index + 1] - row_starts[row_index])) {
+            return false;
+         }
+         size_t current_index = row_start;
+         for (const auto [variable_index, derivative]: row) {
+            if (this->bqpd_jacobian_sparsity[current_index + 1] != static_cast<int>(variable_index) + this->fortran_shift) {
+               return false;
+            }
+            this->bqpd_jacobian[current_index] = derivative;
+            current_index++;
+         }
+         return true;
+      };
+      if (!save_row(this->linear_objective, 0)) {
+         return false;
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         if (!save_row(this->constraint_jacobian[constraint_index], constraint_index + 1)) {
+            return false;
+         }
+      }
+      return true;
    }
 
    void BQPDSolver::set_multipliers(size_t number_variables, Multipliers& direction_multipliers) {
@@ -350,6 +614,11 @@ namespace uno {
 void hessian_vector_product(int *n, const double x[], const double ws[], const int lws[], double v[]) {
    assert(n != nullptr && "BQPDSolver::hessian_vector_product: the dimension n passed by pointer is NULL");
 
+   if (uno::matrix_free_bqpd_solver != nullptr) {
+      uno::matrix_free_bqpd_solver->compute_hessian_vector_product(x, v);
+      return;
+   }
+
    for (size_t i = 0; i < static_cast<size_t>(*n); i++) {
       v[i] = 0.;
    }
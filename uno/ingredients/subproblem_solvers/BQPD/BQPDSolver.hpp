@@ -7,7 +7,7 @@
 #include <array>
 #include <vector>
 #include "ingredients/subproblem_solvers/SubproblemStatus.hpp"
-#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
 #include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "linear_algebra/Vector.hpp"
@@ -51,6 +51,8 @@ namespace uno {
       BQPDSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros, size_t number_jacobian_nonzeros,
             size_t number_hessian_nonzeros, BQPDProblemType problem_type, const Options& options);
 
+      void initialize_statistics(Statistics& statistics, const Options& options) override;
+
       void solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& initial_point, Direction& direction,
             double trust_region_radius, const WarmstartInformation& warmstart_information) override;
 
@@ -59,25 +61,33 @@ namespace uno {
             const WarmstartInformation& warmstart_information) override;
 
       [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      void report_memory(MemoryReport& report) const override;
+      // matrix-free Hessian-vector product (called by gdotx)
+      void compute_hessian_vector_product(const double* vector, double* result) const;
+      [[nodiscard]] size_t get_peak_workspace_size() const override { return this->peak_workspace_size; }
 
    private:
       std::vector<double> lower_bounds{}, upper_bounds{}; // lower and upper bounds of variables and constraints
       std::vector<double> constraints;
       SparseVector<double> linear_objective;
-      RectangularMatrix<double> constraint_jacobian;
+      RectangularMatrixView<double> constraint_jacobian; /*!< view of the Jacobian of the current iterate */
       std::vector<double> bqpd_jacobian{};
       std::vector<int> bqpd_jacobian_sparsity{};
       SymmetricMatrix<size_t, double> hessian;
 
+      const size_t number_variables;
       int kmax{0}, mlp{1000};
-      size_t mxwk0{2000000}, mxiwk0{500000};
+      // sizes of the sparse factors (real and integer workspaces), estimated from the problem dimensions and grown on demand
+      size_t mxwk0, mxiwk0;
       std::array<int, 100> info{};
       std::vector<double> alp{};
       std::vector<int> lp{}, active_set{};
       std::vector<double> w{}, gradient_solution{}, residuals{}, e{};
       size_t size_hessian_sparsity{};
-      size_t size_hessian_workspace{};
-      size_t size_hessian_sparsity_workspace{};
+      size_t size_hessian_workspace{}; // without the reduced Hessian and the sparse factors
+      // lengths of the Hessian in the workspaces (WSC.kk and WSC.ll)
+      int hessian_workspace_length{0};
+      int hessian_sparsity_workspace_length{0};
       std::vector<double> workspace{};
       std::vector<int> workspace_sparsity{};
       int k{0};
@@ -87,15 +97,44 @@ namespace uno {
       const int fortran_shift{1};
       Vector<int> current_hessian_indices{};
 
+      // matrix-free Hessian: the products are computed by the Hessian model at the primal-dual point of the last evaluation
+      const bool matrix_free_hessian;
+      bool is_hessian_matrix_free{false};
+      const OptimizationProblem* hessian_problem{nullptr};
+      HessianModel* hessian_model{nullptr};
+      Vector<double> hessian_primals{};
+      Vector<double> hessian_multipliers{};
+      mutable Vector<double> hessian_vector{};
+      mutable Vector<double> hessian_product{};
+
       const bool print_subproblem;
+      // hot starts: the active set (ls), the steepest-edge weights (e) and the factors in the workspace are kept across calls as long as
+      // the last solve succeeded and the structure of the subproblem is unchanged
+      bool is_active_set_valid{false};
+      // the basis provided by the user (if any) is used at the first cold start only
+      bool is_initial_basis_requested{false};
+      // the integer sparsity patterns of the Jacobian and the Hessian are built once and reused until they change
+      bool is_jacobian_sparsity_valid{false};
+      bool is_hessian_sparsity_valid{false};
+      size_t number_hot_starts{0};
+      size_t number_cold_starts{0};
+      size_t peak_workspace_size{0}; // in bytes
+      static constexpr size_t workspace_growth_factor{2};
+      static constexpr size_t maximum_number_regrowths{10};
 
       void set_up_subproblem(const OptimizationProblem& problem, Iterate& current_iterate, double trust_region_radius,
             const WarmstartInformation& warmstart_information);
       void solve_subproblem(const OptimizationProblem& problem, const Vector<double>& initial_point, Direction& direction,
             const WarmstartInformation& warmstart_information);
-      [[nodiscard]] static BQPDMode determine_mode(const WarmstartInformation& warmstart_information);
+      [[nodiscard]] BQPDMode determine_mode(const WarmstartInformation& warmstart_information) const;
+      [[nodiscard]] bool set_initial_active_set(const OptimizationProblem& problem);
+      [[nodiscard]] bool grow_workspaces(BQPDStatus bqpd_status);
+      void allocate_workspaces();
+      void load_common_blocks() const;
       void save_hessian_to_local_format();
+      [[nodiscard]] bool save_hessian_values();
       void save_gradients_to_local_format(size_t number_constraints);
+      [[nodiscard]] bool save_gradient_values(size_t number_constraints);
       void set_multipliers(size_t number_variables, Multipliers& direction_multipliers);
       static BQPDStatus bqpd_status_from_int(int ifail);
       static SubproblemStatus status_from_bqpd_status(BQPDStatus bqpd_status);
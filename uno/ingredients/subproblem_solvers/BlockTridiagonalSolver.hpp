@@ -0,0 +1,443 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BLOCKTRIDIAGONALSOLVER_H
+#define UNO_BLOCKTRIDIAGONALSOLVER_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/DenseLDLT.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   /*! \class BlockTridiagonalSolver
+    * \brief Block-tridiagonal (Riccati) factorization of stage-structured symmetric indefinite systems (linear_solver = block_tridiagonal)
+    *
+    *  The indices are partitioned into N stages such that the nonzeros only couple consecutive stages (e.g. discretized optimal
+    *  control): K = tridiag(B_k, K_k, B_{k+1}^T), where B_k couples the stage k with the stage k-1. The Schur complements
+    *  S_0 = K_0, S_k = K_k - B_k S_{k-1}^{-1} B_k^T are formed and factorized densely with Bunch-Kaufman pivoting (DenseLDLT), in
+    *  O(N n^3) operations for stages of size n. By the Haynsworth inertia additivity, the inertia of K is the sum of the inertias of
+    *  the S_k. The stages are supplied by the model (see Model::get_stages and set_stage_partition): the indices without stage
+    *  (e.g. slacks, elastic variables, multipliers of constraints without stage) take the stage of a neighbor. Without stages, or if
+    *  the stages do not make the matrix block tridiagonal, the stages are pairs of consecutive levels of a breadth-first search from a
+    *  pseudo-peripheral index, which are block tridiagonal by construction
+    */
+   template <typename IndexType>
+   class BlockTridiagonalSolver: public DirectSymmetricIndefiniteLinearSolver<IndexType, double> {
+   public:
+      static constexpr size_t no_stage = std::numeric_limits<size_t>::max(); // see Model::no_stage
+
+      explicit BlockTridiagonalSolver(size_t dimension, double relative_pivot_tolerance = 0.);
+      ~BlockTridiagonalSolver() override = default;
+
+      void set_stage_partition(const std::vector<size_t>& stage_of_index) override;
+
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override { return std::get<1>(this->get_inertia()); }
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override { return this->analyzed_dimension - std::get<2>(this->get_inertia()); }
+      [[nodiscard]] size_t memory_size() const override;
+
+      [[nodiscard]] size_t number_stages() const { return this->stages.size(); }
+      // stage of each index after the last symbolic analysis
+      [[nodiscard]] const std::vector<size_t>& get_stage_of_index() const { return this->stage_of_index; }
+
+   protected:
+      struct Stage {
+         std::vector<size_t> indices{}; /*!< global indices of the stage */
+         std::unique_ptr<DenseLDLT<double>> schur_complement{}; /*!< S_k */
+         std::vector<double> coupling{}; /*!< B_k, dense column-major (stage dimension x dimension of the previous stage) */
+      };
+      // destination of a nonzero of the matrix: entry (row, column) of K_k (row >= column) or of B_k
+      struct NonzeroDestination {
+         bool is_coupling;
+         size_t stage;
+         size_t row;
+         size_t column;
+      };
+
+      const double relative_pivot_tolerance;
+      std::vector<size_t> user_stages{};
+      std::vector<size_t> stage_of_index{};
+      std::vector<size_t> local_indices{}; /*!< position of each index in its stage */
+      std::vector<Stage> stages{};
+      std::vector<NonzeroDestination> destinations{}; /*!< in the traversal order of the matrix */
+      size_t analyzed_dimension{0};
+      // workspaces
+      std::vector<double> forward_solution{};
+      std::vector<double> stage_workspace{};
+
+      void compute_stages(const std::vector<size_t>& adjacency_starts, const std::vector<size_t>& adjacency);
+      void assign_levels(const std::vector<size_t>& adjacency_starts, const std::vector<size_t>& adjacency);
+      [[nodiscard]] bool is_block_tridiagonal(const std::vector<size_t>& adjacency_starts, const std::vector<size_t>& adjacency) const;
+      // x_k -= B_k y_{k-1} (transpose = false) or x_{k-1} -= B_k^T y_k (transpose = true)
+      void subtract_coupling_product(const Stage& stage, size_t previous_dimension, const double* y, double* x, bool transpose) const;
+   };
+
+   // implementation
+
+   template <typename IndexType>
+   BlockTridiagonalSolver<IndexType>::BlockTridiagonalSolver(size_t dimension, double relative_pivot_tolerance):
+         DirectSymmetricIndefiniteLinearSolver<IndexType, double>(dimension),
+         relative_pivot_tolerance(relative_pivot_tolerance) {
+   }
+
+   template <typename IndexType>
+   void BlockTridiagonalSolver<IndexType>::set_stage_partition(const std::vector<size_t>& stage_of_index) {
+      this->user_stages = stage_of_index;
+   }
+
+   template <typename IndexType>
+   void BlockTridiagonalSolver<IndexType>::do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) {
+      const size_t dimension = matrix.dimension();
+      this->analyzed_dimension = dimension;
+      // graph of the matrix (CSR, without the diagonal)
+      std::vector<size_t> adjacency_starts(dimension + 1, 0);
+      matrix.for_each([&](size_t row_index, size_t column_index, double /*element*/) {
+         if (row_index != column_index) {
+            adjacency_starts[row_index + 1]++;
+            adjacency_starts[column_index + 1]++;
+         }
+      });
+      for (size_t index: Range(dimension)) {
+         adjacency_starts[index + 1] += adjacency_starts[index];
+      }
+      std::vector<size_t> adjacency(adjacency_starts[dimension]);
+      std::vector<size_t> positions(adjacency_starts.begin(), adjacency_starts.end() - 1);
+      matrix.for_each([&](size_t row_index, size_t column_index, double /*element*/) {
+         if (row_index != column_index) {
+            adjacency[positions[row_index]++] = column_index;
+            adjacency[positions[column_index]++] = row_index;
+         }
+      });
+      this->compute_stages(adjacency_starts, adjacency);
+
+      // stages and local indices
+      size_t number_stages = 0;
+      for (const size_t stage: this->stage_of_index) {
+         number_stages = std::max(number_stages, stage + 1);
+      }
+      this->stages.clear();
+      this->stages.resize(number_stages);
+      this->local_indices.resize(dimension);
+      for (size_t index: Range(dimension)) {
+         Stage& stage = this->stages[this->stage_of_index[index]];
+         this->local_indices[index] = stage.indices.size();
+         stage.indices.emplace_back(index);
+      }
+      size_t maximum_stage_dimension = 0;
+      size_t factor_size = 0;
+      for (size_t stage_index: Range(number_stages)) {
+         Stage& stage = this->stages[stage_index];
+         const size_t stage_dimension = stage.indices.size();
+         const size_t previous_dimension = (0 < stage_index) ? this->stages[stage_index - 1].indices.size() : 0;
+         stage.schur_complement = std::make_unique<DenseLDLT<double>>(stage_dimension);
+         stage.coupling.resize(stage_dimension * previous_dimension);
+         maximum_stage_dimension = std::max(maximum_stage_dimension, stage_dimension);
+         factor_size += stage_dimension * (stage_dimension + 1) / 2 + stage_dimension * previous_dimension;
+      }
+      // destinations of the nonzeros
+      this->destinations.clear();
+      this->destinations.reserve(matrix.number_nonzeros());
+      matrix.for_each([&](size_t row_index, size_t column_index, double /*element*/) {
+         const size_t row_stage = this->stage_of_index[row_index];
+         const size_t column_stage = this->stage_of_index[column_index];
+         if (row_stage == column_stage) {
+            this->destinations.push_back({false, row_stage, std::max(this->local_indices[row_index], this->local_indices[column_index]),
+               std::min(this->local_indices[row_index], this->local_indices[column_index])});
+         }
+         else if (column_stage < row_stage) {
+            this->destinations.push_back({true, row_stage, this->local_indices[row_index], this->local_indices[column_index]});
+         }
+         else {
+            this->destinations.push_back({true, column_stage, this->local_indices[column_index], this->local_indices[row_index]});
+         }
+      });
+      this->forward_solution.resize(dimension);
+      this->stage_workspace.resize(maximum_stage_dimension);
+      DEBUG << "Block-tridiagonal solver: " << number_stages << " stages of maximum dimension " << maximum_stage_dimension << '\n';
+      this->factorization_statistics.record_analysis(matrix.number_nonzeros(), factor_size);
+   }
+
+   template <typename IndexType>
+   void BlockTridiagonalSolver<IndexType>::do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) {
+      // the analysis is redone if the structure changed
+      if (this->destinations.size() != matrix.number_nonzeros() || this->analyzed_dimension != matrix.dimension()) {
+         this->do_symbolic_analysis(matrix);
+      }
+      for (Stage& stage: this->stages) {
+         stage.schur_complement->reset();
+         std::fill(stage.coupling.begin(), stage.coupling.end(), 0.);
+      }
+      double largest_entry = 0.;
+      size_t nonzero_index = 0;
+      matrix.for_each([&](size_t /*row_index*/, size_t /*column_index*/, double element) {
+         const NonzeroDestination& destination = this->destinations[nonzero_index];
+         Stage& stage = this->stages[destination.stage];
+         if (destination.is_coupling) {
+            stage.coupling[destination.column * stage.indices.size() + destination.row] += element;
+         }
+         else {
+            stage.schur_complement->entry(destination.row, destination.column) += element;
+         }
+         largest_entry = std::max(largest_entry, std::abs(element));
+         nonzero_index++;
+      });
+
+      // S_k = K_k - B_k S_{k-1}^{-1} B_k^T, one column at a time
+      const double pivot_tolerance = this->relative_pivot_tolerance * largest_entry;
+      double flops = 0.;
+      size_t factor_size = 0;
+      size_t number_two_by_two_pivots = 0;
+      for (size_t stage_index: Range(this->stages.size())) {
+         Stage& stage = this->stages[stage_index];
+         const size_t stage_dimension = stage.indices.size();
+         if (0 < stage_index) {
+            const Stage& previous_stage = this->stages[stage_index - 1];
+            const size_t previous_dimension = previous_stage.indices.size();
+            for (size_t column: Range(stage_dimension)) {
+               // w = S_{k-1}^{-1} B_k(column, :)^T
+               for (size_t previous_index: Range(previous_dimension)) {
+                  this->stage_workspace[previous_index] = stage.coupling[previous_index * stage_dimension + column];
+               }
+               previous_stage.schur_complement->solve(this->stage_workspace.data());
+               for (size_t row = column; row < stage_dimension; row++) {
+                  double product = 0.;
+                  for (size_t previous_index: Range(previous_dimension)) {
+                     product += stage.coupling[previous_index * stage_dimension + row] * this->stage_workspace[previous_index];
+                  }
+                  stage.schur_complement->entry(row, column) -= product;
+               }
+            }
+            flops += static_cast<double>(stage_dimension) * static_cast<double>(previous_dimension) *
+               static_cast<double>(2 * previous_dimension + stage_dimension);
+            factor_size += stage_dimension * previous_dimension;
+         }
+         stage.schur_complement->factorize(pivot_tolerance);
+         flops += std::pow(static_cast<double>(stage_dimension), 3) / 3.;
+         factor_size += stage_dimension * (stage_dimension + 1) / 2;
+         number_two_by_two_pivots += stage.schur_complement->number_two_by_two_pivots();
+      }
+      this->factorization_statistics.record_factorization(factor_size, flops, this->memory_size(), 0, 0, number_two_by_two_pivots);
+   }
+
+   template <typename IndexType>
+   void BlockTridiagonalSolver<IndexType>::solve_indefinite_system(const SymmetricMatrix<IndexType, double>& /*matrix*/,
+         const Vector<double>& rhs, Vector<double>& result) {
+      // the vectors are stored stage by stage in forward_solution
+      std::vector<size_t> offsets(this->stages.size() + 1, 0);
+      for (size_t stage_index: Range(this->stages.size())) {
+         offsets[stage_index + 1] = offsets[stage_index] + this->stages[stage_index].indices.size();
+      }
+      // forward substitution: w_k = S_k^{-1} (r_k - B_k w_{k-1})
+      for (size_t stage_index: Range(this->stages.size())) {
+         const Stage& stage = this->stages[stage_index];
+         double* stage_solution = this->forward_solution.data() + offsets[stage_index];
+         for (size_t local_index: Range(stage.indices.size())) {
+            stage_solution[local_index] = rhs[stage.indices[local_index]];
+         }
+         if (0 < stage_index) {
+            this->subtract_coupling_product(stage, this->stages[stage_index - 1].indices.size(),
+               this->forward_solution.data() + offsets[stage_index - 1], stage_solution, false);
+         }
+         stage.schur_complement->solve(stage_solution);
+      }
+      // backward substitution: x_k = w_k - S_k^{-1} B_{k+1}^T x_{k+1}
+      for (size_t stage_index = this->stages.size(); 0 < stage_index; stage_index--) {
+         const Stage& stage = this->stages[stage_index - 1];
+         double* stage_solution = this->forward_solution.data() + offsets[stage_index - 1];
+         if (stage_index < this->stages.size()) {
+            const size_t stage_dimension = stage.indices.size();
+            std::fill(this->stage_workspace.begin(), this->stage_workspace.begin() + static_cast<std::ptrdiff_t>(stage_dimension), 0.);
+            this->subtract_coupling_product(this->stages[stage_index], stage_dimension, this->forward_solution.data() + offsets[stage_index],
+               this->stage_workspace.data(), true);
+            stage.schur_complement->solve(this->stage_workspace.data());
+            for (size_t local_index: Range(stage_dimension)) {
+               stage_solution[local_index] += this->stage_workspace[local_index];
+            }
+         }
+         for (size_t local_index: Range(stage.indices.size())) {
+            result[stage.indices[local_index]] = stage_solution[local_index];
+         }
+      }
+   }
+
+   template <typename IndexType>
+   std::tuple<size_t, size_t, size_t> BlockTridiagonalSolver<IndexType>::get_inertia() const {
+      size_t number_positive = 0, number_negative = 0, number_zero = 0;
+      for (const Stage& stage: this->stages) {
+         const auto [stage_positive, stage_negative, stage_zero] = stage.schur_complement->get_inertia();
+         number_positive += stage_positive;
+         number_negative += stage_negative;
+         number_zero += stage_zero;
+      }
+      return {number_positive, number_negative, number_zero};
+   }
+
+   template <typename IndexType>
+   bool BlockTridiagonalSolver<IndexType>::matrix_is_singular() const {
+      return std::any_of(this->stages.cbegin(), this->stages.cend(), [](const Stage& stage) {
+         return stage.schur_complement->is_singular();
+      });
+   }
+
+   template <typename IndexType>
+   size_t BlockTridiagonalSolver<IndexType>::memory_size() const {
+      size_t size = (this->user_stages.capacity() + this->stage_of_index.capacity() + this->local_indices.capacity()) * sizeof(size_t) +
+         this->destinations.capacity() * sizeof(NonzeroDestination) +
+         (this->forward_solution.capacity() + this->stage_workspace.capacity()) * sizeof(double);
+      for (const Stage& stage: this->stages) {
+         size += stage.indices.capacity() * sizeof(size_t) + stage.schur_complement->memory_size() + stage.coupling.capacity() * sizeof(double);
+      }
+      return size;
+   }
+
+   // the stages of the model are propagated to the indices without stage, then checked
+   template <typename IndexType>
+   void BlockTridiagonalSolver<IndexType>::compute_stages(const std::vector<size_t>& adjacency_starts, const std::vector<size_t>& adjacency) {
+      const size_t dimension = adjacency_starts.size() - 1;
+      this->stage_of_index.assign(dimension, no_stage);
+      bool has_user_stages = false;
+      for (size_t index: Range(std::min(dimension, this->user_stages.size()))) {
+         this->stage_of_index[index] = this->user_stages[index];
+         has_user_stages = has_user_stages || (this->user_stages[index] != no_stage);
+      }
+      if (has_user_stages) {
+         // breadth-first propagation from the indices with a stage
+         std::vector<size_t> queue{};
+         queue.reserve(dimension);
+         for (size_t index: Range(dimension)) {
+            if (this->stage_of_index[index] != no_stage) {
+               queue.emplace_back(index);
+            }
+         }
+         for (size_t position = 0; position < queue.size(); position++) {
+            const size_t index = queue[position];
+            for (size_t adjacency_index: Range(adjacency_starts[index], adjacency_starts[index + 1])) {
+               const size_t neighbor = adjacency[adjacency_index];
+               if (this->stage_of_index[neighbor] == no_stage) {
+                  this->stage_of_index[neighbor] = this->stage_of_index[index];
+                  queue.emplace_back(neighbor);
+               }
+            }
+         }
+      }
+      // the components without stage are numbered by levels
+      this->assign_levels(adjacency_starts, adjacency);
+      // consecutive numbering of the nonempty stages
+      std::vector<size_t> labels(this->stage_of_index);
+      std::sort(labels.begin(), labels.end());
+      labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+      for (size_t& stage: this->stage_of_index) {
+         stage = static_cast<size_t>(std::lower_bound(labels.begin(), labels.end(), stage) - labels.begin());
+      }
+      if (has_user_stages && !this->is_block_tridiagonal(adjacency_starts, adjacency)) {
+         WARNING << "The stages of the model do not make the matrix block tridiagonal, the stages are recomputed\n";
+         this->stage_of_index.assign(dimension, no_stage);
+         this->assign_levels(adjacency_starts, adjacency);
+      }
+   }
+
+   // levels of a breadth-first search from a pseudo-peripheral index (George and Liu) in each component without stage. Two
+   // consecutive levels form a stage: a level of multipliers alone has a zero diagonal block, whose Schur complement may be singular
+   template <typename IndexType>
+   void BlockTridiagonalSolver<IndexType>::assign_levels(const std::vector<size_t>& adjacency_starts, const std::vector<size_t>& adjacency) {
+      const size_t dimension = adjacency_starts.size() - 1;
+      std::vector<size_t> levels(dimension, no_stage);
+      std::vector<size_t> component{};
+      const auto breadth_first_search = [&](size_t root) {
+         for (const size_t index: component) {
+            levels[index] = no_stage;
+         }
+         component.assign(1, root);
+         levels[root] = 0;
+         for (size_t position = 0; position < component.size(); position++) {
+            const size_t index = component[position];
+            for (size_t adjacency_index: Range(adjacency_starts[index], adjacency_starts[index + 1])) {
+               const size_t neighbor = adjacency[adjacency_index];
+               if (levels[neighbor] == no_stage) {
+                  levels[neighbor] = levels[index] + 1;
+                  component.emplace_back(neighbor);
+               }
+            }
+         }
+         return levels[component.back()];
+      };
+      const auto degree = [&](size_t index) {
+         return adjacency_starts[index + 1] - adjacency_starts[index];
+      };
+      for (size_t start: Range(dimension)) {
+         if (this->stage_of_index[start] != no_stage || levels[start] != no_stage) {
+            continue;
+         }
+         component.clear();
+         size_t eccentricity = breadth_first_search(start);
+         // restart from an index of smallest degree in the last level, as long as the number of levels increases. The eccentricity
+         // of the candidate is at least that of the root, so that the last search is kept
+         size_t candidate_eccentricity;
+         do {
+            size_t candidate = component.back();
+            for (const size_t index: component) {
+               if (levels[index] == eccentricity && degree(index) < degree(candidate)) {
+                  candidate = index;
+               }
+            }
+            candidate_eccentricity = eccentricity;
+            eccentricity = breadth_first_search(candidate);
+         } while (candidate_eccentricity < eccentricity);
+         for (const size_t index: component) {
+            this->stage_of_index[index] = levels[index] / 2;
+         }
+      }
+   }
+
+   template <typename IndexType>
+   bool BlockTridiagonalSolver<IndexType>::is_block_tridiagonal(const std::vector<size_t>& adjacency_starts,
+         const std::vector<size_t>& adjacency) const {
+      for (size_t index: Range(adjacency_starts.size() - 1)) {
+         for (size_t adjacency_index: Range(adjacency_starts[index], adjacency_starts[index + 1])) {
+            const size_t first_stage = this->stage_of_index[index];
+            const size_t second_stage = this->stage_of_index[adjacency[adjacency_index]];
+            if (first_stage + 1 < second_stage || second_stage + 1 < first_stage) {
+               return false;
+            }
+         }
+      }
+      return true;
+   }
+
+   template <typename IndexType>
+   void BlockTridiagonalSolver<IndexType>::subtract_coupling_product(const Stage& stage, size_t previous_dimension, const double* y,
+         double* x, bool transpose) const {
+      const size_t stage_dimension = stage.indices.size();
+      for (size_t previous_index: Range(previous_dimension)) {
+         const double* coupling_column = stage.coupling.data() + previous_index * stage_dimension;
+         if (transpose) {
+            double product = 0.;
+            for (size_t local_index: Range(stage_dimension)) {
+               product += coupling_column[local_index] * y[local_index];
+            }
+            x[previous_index] -= product;
+         }
+         else {
+            for (size_t local_index: Range(stage_dimension)) {
+               x[local_index] -= coupling_column[local_index] * y[previous_index];
+            }
+         }
+      }
+   }
+} // namespace
+
+#endif // UNO_BLOCKTRIDIAGONALSOLVER_H
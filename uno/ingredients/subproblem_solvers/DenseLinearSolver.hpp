@@ -0,0 +1,124 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DENSELINEARSOLVER_H
+#define UNO_DENSELINEARSOLVER_H
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/DenseLDLT.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   /*! \class DenseLinearSolver
+    * \brief Dense Bunch-Kaufman factorization of small symmetric indefinite matrices (linear_solver = dense)
+    *
+    *  The symbolic analysis records the position of each nonzero in the lower triangle of a preallocated dense buffer; the
+    *  numerical factorization scatters the values (duplicates are summed) and factorizes the buffer with DenseLDLT. The inertia is
+    *  read from the block diagonal factor. A pivot below the relative pivot tolerance (times the largest entry) counts as a zero
+    *  eigenvalue. On small KKT systems, this avoids the sparse analysis and the index handling of the sparse solvers.
+    *  A positive MaximumDimension selects the fixed-capacity storage of DenseLDLT for the dense KKT buffer (tiny systems whose
+    *  dimension is known at compile time)
+    */
+   template <typename IndexType, size_t MaximumDimension = 0>
+   class DenseLinearSolver: public DirectSymmetricIndefiniteLinearSolver<IndexType, double> {
+   public:
+      explicit DenseLinearSolver(size_t dimension, double relative_pivot_tolerance = 0.);
+      ~DenseLinearSolver() override = default;
+
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override { return this->factorization->get_inertia(); }
+      [[nodiscard]] size_t number_negative_eigenvalues() const override { return std::get<1>(this->get_inertia()); }
+      [[nodiscard]] bool matrix_is_singular() const override { return this->factorization->is_singular(); }
+      [[nodiscard]] size_t rank() const override { return this->factorization->dimension() - std::get<2>(this->get_inertia()); }
+      [[nodiscard]] size_t memory_size() const override;
+
+   protected:
+      const double relative_pivot_tolerance;
+      // the buffer has the dimension of the current matrix, and is reallocated only if the dimension changes (never with a fixed capacity)
+      std::unique_ptr<DenseLDLT<double, MaximumDimension>> factorization;
+      // (row, column) position in the lower triangle of each nonzero, in the traversal order of the matrix
+      std::vector<std::pair<size_t, size_t>> positions{};
+
+      void allocate(size_t dimension);
+   };
+
+   // implementation
+
+   template <typename IndexType, size_t MaximumDimension>
+   DenseLinearSolver<IndexType, MaximumDimension>::DenseLinearSolver(size_t dimension, double relative_pivot_tolerance):
+         DirectSymmetricIndefiniteLinearSolver<IndexType, double>(dimension),
+         relative_pivot_tolerance(relative_pivot_tolerance),
+         factorization(std::make_unique<DenseLDLT<double, MaximumDimension>>(dimension)) {
+   }
+
+   template <typename IndexType, size_t MaximumDimension>
+   void DenseLinearSolver<IndexType, MaximumDimension>::do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) {
+      this->allocate(matrix.dimension());
+      this->positions.clear();
+      this->positions.reserve(matrix.number_nonzeros());
+      matrix.for_each([&](size_t row_index, size_t column_index, double /*element*/) {
+         this->positions.emplace_back(std::max(row_index, column_index), std::min(row_index, column_index));
+      });
+      const size_t dimension = matrix.dimension();
+      this->factorization_statistics.record_analysis(matrix.number_nonzeros(), dimension * (dimension + 1) / 2);
+   }
+
+   template <typename IndexType, size_t MaximumDimension>
+   void DenseLinearSolver<IndexType, MaximumDimension>::do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) {
+      // the analysis is redone if the structure changed
+      if (this->positions.size() != matrix.number_nonzeros() || this->factorization->dimension() != matrix.dimension()) {
+         this->do_symbolic_analysis(matrix);
+      }
+      this->factorization->reset();
+      double largest_entry = 0.;
+      size_t nonzero_index = 0;
+      matrix.for_each([&](size_t /*row_index*/, size_t /*column_index*/, double element) {
+         const auto [row, column] = this->positions[nonzero_index];
+         this->factorization->entry(row, column) += element;
+         largest_entry = std::max(largest_entry, std::abs(element));
+         nonzero_index++;
+      });
+      this->factorization->factorize(this->relative_pivot_tolerance * largest_entry);
+      // the dense factorization costs n^3/3 flops
+      const size_t dimension = this->factorization->dimension();
+      this->factorization_statistics.record_factorization(dimension * (dimension + 1) / 2, std::pow(static_cast<double>(dimension), 3) / 3.,
+         this->factorization->memory_size(), 0, 0, this->factorization->number_two_by_two_pivots());
+   }
+
+   template <typename IndexType, size_t MaximumDimension>
+   void DenseLinearSolver<IndexType, MaximumDimension>::solve_indefinite_system(const SymmetricMatrix<IndexType, double>& /*matrix*/, const Vector<double>& rhs,
+         Vector<double>& result) {
+      const size_t dimension = this->factorization->dimension();
+      std::copy(rhs.data(), rhs.data() + dimension, result.data());
+      this->factorization->solve(result.data());
+   }
+
+   template <typename IndexType, size_t MaximumDimension>
+   size_t DenseLinearSolver<IndexType, MaximumDimension>::memory_size() const {
+      return this->factorization->memory_size() + this->positions.capacity() * sizeof(std::pair<size_t, size_t>);
+   }
+
+   template <typename IndexType, size_t MaximumDimension>
+   void DenseLinearSolver<IndexType, MaximumDimension>::allocate(size_t dimension) {
+      if (this->factorization->dimension() != dimension) {
+         if constexpr (0 < MaximumDimension) {
+            this->factorization->set_dimension(dimension);
+         }
+         else {
+            this->factorization = std::make_unique<DenseLDLT<double, MaximumDimension>>(dimension);
+         }
+      }
+   }
+} // namespace
+
+#endif // UNO_DENSELINEARSOLVER_H
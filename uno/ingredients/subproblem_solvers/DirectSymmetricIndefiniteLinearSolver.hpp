@@ -4,7 +4,12 @@
 #ifndef UNO_DIRECTSYMMETRICINDEFINITELINEARSOLVER_H
 #define UNO_DIRECTSYMMETRICINDEFINITELINEARSOLVER_H
 
+#include <stdexcept>
+#include <vector>
+#include "FactorizationStatistics.hpp"
 #include "SymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
 
 namespace uno {
    template <typename IndexType, typename ElementType>
@@ -15,13 +20,56 @@ namespace uno {
 
       virtual void do_symbolic_analysis(const SymmetricMatrix<IndexType, ElementType>& matrix) = 0;
       virtual void do_numerical_factorization(const SymmetricMatrix<IndexType, ElementType>& matrix) = 0;
+      // user-supplied pivot order: pivot_order[k] is the (0-based) index of the k-th pivot
+      virtual void set_pivot_order(const std::vector<size_t>& /*pivot_order*/) {
+         throw std::invalid_argument("This linear solver does not accept a user-supplied pivot order");
+      }
+      // static pivoting: the numerical factorization follows the pivot order of the symbolic analysis (no numerical pivoting), which
+      // is stable for quasi-definite matrices. By default, the solver pivots
+      virtual void set_static_pivoting(bool /*static_pivoting*/) { }
+      // stage of each row of the matrix (Model::no_stage if unknown) for solvers that exploit a block-tridiagonal structure. By
+      // default, the partition is ignored
+      virtual void set_stage_partition(const std::vector<size_t>& /*stage_of_index*/) { }
+      // increase the threshold of the numerical pivoting for the next factorizations (more stable, but more fill-in). Returns false
+      // if the tolerance cannot be increased. By default, the solver has no adjustable pivot tolerance
+      [[nodiscard]] virtual bool increase_pivot_tolerance() { return false; }
 
+      // solve the system with a block of number_rhs right-hand sides, stored column-major (dimension x number_rhs) in rhs and result.
+      // The default implementation solves the systems one by one with the same factors
+      virtual void solve_indefinite_systems(const SymmetricMatrix<IndexType, ElementType>& matrix, const Vector<ElementType>& rhs,
+            Vector<ElementType>& result, size_t number_rhs);
+
+      // whether get_inertia() is available. Otherwise, the regularization relies on a curvature test
+      [[nodiscard]] virtual bool provides_inertia() const { return true; }
       [[nodiscard]] virtual std::tuple<size_t, size_t, size_t> get_inertia() const = 0;
       [[nodiscard]] virtual size_t number_negative_eigenvalues() const = 0;
       // [[nodiscard]] virtual bool matrix_is_positive_definite() const = 0;
       [[nodiscard]] virtual bool matrix_is_singular() const = 0;
       [[nodiscard]] virtual size_t rank() const = 0;
+      // fill, flops, memory and pivots of the analyses and factorizations since the creation of the solver
+      [[nodiscard]] virtual FactorizationStatistics get_factorization_statistics() const { return this->factorization_statistics; }
+
+   protected:
+      FactorizationStatistics factorization_statistics{};
    };
+
+   // implementation
+
+   template <typename IndexType, typename ElementType>
+   void DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>::solve_indefinite_systems(const SymmetricMatrix<IndexType, ElementType>& matrix,
+         const Vector<ElementType>& rhs, Vector<ElementType>& result, size_t number_rhs) {
+      const size_t dimension = matrix.dimension();
+      assert(dimension * number_rhs <= rhs.size() && "DirectSymmetricIndefiniteLinearSolver: the rhs block is too small");
+      assert(dimension * number_rhs <= result.size() && "DirectSymmetricIndefiniteLinearSolver: the result block is too small");
+      Vector<ElementType> column_rhs(dimension);
+      Vector<ElementType> column_result(dimension);
+      for (size_t rhs_index: Range(number_rhs)) {
+         const size_t offset = rhs_index * dimension;
+         std::copy(rhs.data() + offset, rhs.data() + offset + dimension, column_rhs.data());
+         this->solve_indefinite_system(matrix, column_rhs, column_result);
+         std::copy(column_result.data(), column_result.data() + dimension, result.data() + offset);
+      }
+   }
 } // namespace
 
 #endif // UNO_DIRECTSYMMETRICINDEFINITELINEARSOLVER_H
\ No newline at end of file
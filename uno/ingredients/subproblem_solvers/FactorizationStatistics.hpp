@@ -0,0 +1,80 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FACTORIZATIONSTATISTICS_H
+#define UNO_FACTORIZATIONSTATISTICS_H
+
+#include <algorithm>
+#include <cstddef>
+#include "tools/Metrics.hpp"
+
+namespace uno {
+   // statistics of the symbolic analyses and numerical factorizations of a direct linear solver. The quantities that a backend
+   // does not report remain 0
+   struct FactorizationStatistics {
+      size_t number_analyses{0};
+      size_t number_factorizations{0};
+      size_t matrix_nonzeros{0}; // of the last analyzed matrix
+      size_t factor_nonzeros{0}; // of the last factorization (forecast by the analysis until the first factorization)
+      size_t peak_factor_nonzeros{0};
+      double flops{0.}; // cumulated over the factorizations
+      size_t peak_memory{0}; // storage of the factors, in bytes
+      size_t delayed_pivots{0}; // cumulated over the factorizations
+      size_t perturbed_pivots{0}; // cumulated over the factorizations (static pivoting)
+      size_t two_by_two_pivots{0}; // of the last factorization
+
+      void record_analysis(size_t new_matrix_nonzeros, size_t forecast_factor_nonzeros) {
+         this->number_analyses++;
+         this->matrix_nonzeros = new_matrix_nonzeros;
+         this->factor_nonzeros = forecast_factor_nonzeros;
+      }
+
+      void record_factorization(size_t new_factor_nonzeros, double factorization_flops, size_t memory, size_t new_delayed_pivots,
+            size_t new_perturbed_pivots, size_t new_two_by_two_pivots) {
+         this->number_factorizations++;
+         this->factor_nonzeros = new_factor_nonzeros;
+         this->peak_factor_nonzeros = std::max(this->peak_factor_nonzeros, new_factor_nonzeros);
+         this->flops += factorization_flops;
+         this->peak_memory = std::max(this->peak_memory, memory);
+         this->delayed_pivots += new_delayed_pivots;
+         this->perturbed_pivots += new_perturbed_pivots;
+         this->two_by_two_pivots = new_two_by_two_pivots;
+         metrics::increment(Metric::FACTORIZATIONS);
+         if (0 < new_perturbed_pivots) {
+            metrics::increment(Metric::PERTURBED_PIVOTS, static_cast<double>(new_perturbed_pivots));
+         }
+      }
+
+      // statistics of independent solvers (e.g. the blocks of a Schur complement or several subproblems): the sizes are summed
+      void accumulate(const FactorizationStatistics& other) {
+         this->number_analyses += other.number_analyses;
+         this->number_factorizations += other.number_factorizations;
+         this->matrix_nonzeros += other.matrix_nonzeros;
+         this->factor_nonzeros += other.factor_nonzeros;
+         this->peak_factor_nonzeros += other.peak_factor_nonzeros;
+         this->flops += other.flops;
+         this->peak_memory += other.peak_memory;
+         this->delayed_pivots += other.delayed_pivots;
+         this->perturbed_pivots += other.perturbed_pivots;
+         this->two_by_two_pivots += other.two_by_two_pivots;
+      }
+
+      // the cumulated quantities since an earlier snapshot of the same solver. The sizes are those of the current statistics
+      [[nodiscard]] FactorizationStatistics since(const FactorizationStatistics& snapshot) const {
+         FactorizationStatistics difference = *this;
+         difference.number_analyses -= snapshot.number_analyses;
+         difference.number_factorizations -= snapshot.number_factorizations;
+         difference.flops -= snapshot.flops;
+         difference.delayed_pivots -= snapshot.delayed_pivots;
+         difference.perturbed_pivots -= snapshot.perturbed_pivots;
+         return difference;
+      }
+
+      // ratio of the nonzeros of the factors to those of the matrix (0 if unknown)
+      [[nodiscard]] double fill() const {
+         return (this->matrix_nonzeros == 0) ? 0. : static_cast<double>(this->factor_nonzeros) / static_cast<double>(this->matrix_nonzeros);
+      }
+   };
+} // namespace
+
+#endif // UNO_FACTORIZATIONSTATISTICS_H
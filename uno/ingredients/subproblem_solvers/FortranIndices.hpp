@@ -0,0 +1,117 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FORTRANINDICES_H
+#define UNO_FORTRANINDICES_H
+
+#include <type_traits>
+#include <vector>
+#include "linear_algebra/COOSparseStorage.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+
+namespace uno {
+   /*! \class FortranIndices
+    * \brief 1-based int coordinate indices of a symmetric matrix, as expected by the Fortran solvers (MA57, MA27, MUMPS)
+    *
+    *  If the matrix is stored in COO format with int indices shifted by 1, its index arrays are borrowed (zero copy).
+    *  Otherwise, the indices are copied into internal arrays. ElementType is the element type of the matrix
+    */
+   template <typename IndexType, typename ElementType = double>
+   class FortranIndices {
+   public:
+      static constexpr size_t fortran_shift{1};
+      // patterns above this number of nonzeros are converted by the OpenMP threads (if available)
+      static constexpr size_t parallel_conversion_nonzeros_threshold{100000};
+
+      FortranIndices() = default;
+
+      // borrow or copy the sparsity pattern of the matrix
+      void save(const SymmetricMatrix<IndexType, ElementType>& matrix);
+      // the borrowed arrays may be reallocated when the matrix is reassembled
+      void update_pointers(const SymmetricMatrix<IndexType, ElementType>& matrix);
+
+      [[nodiscard]] const int* row_indices() const { return this->row_indices_pointer; }
+      [[nodiscard]] const int* column_indices() const { return this->column_indices_pointer; }
+      [[nodiscard]] int* row_indices() { return const_cast<int*>(this->row_indices_pointer); }
+      [[nodiscard]] int* column_indices() { return const_cast<int*>(this->column_indices_pointer); }
+      [[nodiscard]] bool is_borrowed() const { return this->borrowed; }
+      // memory of the copies (in bytes): zero if the indices are borrowed
+      [[nodiscard]] size_t memory_size() const {
+         return (this->row_indices_copy.capacity() + this->column_indices_copy.capacity()) * sizeof(int);
+      }
+
+   protected:
+      std::vector<int> row_indices_copy{};
+      std::vector<int> column_indices_copy{};
+      const int* row_indices_pointer{nullptr};
+      const int* column_indices_pointer{nullptr};
+      bool borrowed{false};
+
+      [[nodiscard]] static const COOSparseStorage<int, ElementType>* borrowable_storage(const SymmetricMatrix<IndexType, ElementType>& matrix);
+   };
+
+   // implementation
+
+   template <typename IndexType, typename ElementType>
+   void FortranIndices<IndexType, ElementType>::save(const SymmetricMatrix<IndexType, ElementType>& matrix) {
+      if (const auto* storage = FortranIndices::borrowable_storage(matrix)) {
+         this->row_indices_pointer = storage->row_indices_pointer();
+         this->column_indices_pointer = storage->column_indices_pointer();
+         this->borrowed = true;
+      }
+      else {
+         // fallback: copy the pattern. The buffers are allocated only in this case
+         const size_t number_nonzeros = matrix.number_nonzeros();
+         this->row_indices_copy.resize(number_nonzeros);
+         this->column_indices_copy.resize(number_nonzeros);
+         if (const auto* storage = matrix.template get_storage_if<COOSparseStorage<IndexType, ElementType>>()) {
+            // the coordinates are independent: the conversion is distributed among the OpenMP threads (if available)
+            const IndexType* rows = storage->row_indices_pointer();
+            const IndexType* columns = storage->column_indices_pointer();
+            const int shift = static_cast<int>(FortranIndices::fortran_shift) - static_cast<int>(matrix.index_shift());
+            [[maybe_unused]] const bool parallel = (parallel_conversion_nonzeros_threshold <= number_nonzeros);
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(static) if(parallel)
+#endif
+            for (size_t nonzero_index = 0; nonzero_index < number_nonzeros; nonzero_index++) {
+               this->row_indices_copy[nonzero_index] = static_cast<int>(rows[nonzero_index]) + shift;
+               this->column_indices_copy[nonzero_index] = static_cast<int>(columns[nonzero_index]) + shift;
+            }
+         }
+         else {
+            size_t nonzero_index = 0;
+            matrix.for_each([&](size_t row_index, size_t column_index, ElementType /*element*/) {
+               this->row_indices_copy[nonzero_index] = static_cast<int>(row_index + FortranIndices::fortran_shift);
+               this->column_indices_copy[nonzero_index] = static_cast<int>(column_index + FortranIndices::fortran_shift);
+               nonzero_index++;
+            });
+         }
+         this->row_indices_pointer = this->row_indices_copy.data();
+         this->column_indices_pointer = this->column_indices_copy.data();
+         this->borrowed = false;
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void FortranIndices<IndexType, ElementType>::update_pointers(const SymmetricMatrix<IndexType, ElementType>& matrix) {
+      if (this->borrowed) {
+         if (const auto* storage = FortranIndices::borrowable_storage(matrix)) {
+            this->row_indices_pointer = storage->row_indices_pointer();
+            this->column_indices_pointer = storage->column_indices_pointer();
+         }
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   const COOSparseStorage<int, ElementType>* FortranIndices<IndexType, ElementType>::borrowable_storage(
+         [[maybe_unused]] const SymmetricMatrix<IndexType, ElementType>& matrix) {
+      if constexpr (std::is_same_v<IndexType, int>) {
+         if (matrix.index_shift() == FortranIndices::fortran_shift) {
+            return matrix.template get_storage_if<COOSparseStorage<int, ElementType>>();
+         }
+      }
+      return nullptr;
+   }
+} // namespace
+
+#endif // UNO_FORTRANINDICES_H
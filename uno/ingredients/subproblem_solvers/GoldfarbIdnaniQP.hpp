@@ -0,0 +1,491 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_GOLDFARBIDNANIQP_H
+#define UNO_GOLDFARBIDNANIQP_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "SubproblemStatus.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Cancellation.hpp"
+
+namespace uno {
+   enum class DenseConstraintType {ABSENT, EQUALITY, INEQUALITY};
+
+   /*! \class GoldfarbIdnaniQP
+    * \brief Dense dual active-set method of Goldfarb and Idnani for strictly convex QPs
+    *
+    *  min 1/2 x^T G x + g^T x  s.t.  a_k^T x = b_k (equality constraints), a_k^T x >= b_k (inequality constraints)
+    *  The Cholesky factor L of G and the QR factors of the active constraints (J = L^{-T} Q, R) are updated with Givens rotations.
+    *  All the storage is allocated by the constructor for the maximum dimensions. The constraints keep their indices across solves:
+    *  a warm start adds first the violated constraints that were active at the previous solution
+    */
+   template <typename ElementType>
+   class GoldfarbIdnaniQP {
+   public:
+      GoldfarbIdnaniQP(size_t maximum_dimension, size_t maximum_number_constraints, ElementType feasibility_tolerance);
+
+      // problem data. Only the lower triangle of the Hessian is read. reset() sets the gradient and the constraints to 0;
+      // the Hessian (and its factorization) is kept until reset_hessian() is called
+      void reset(size_t dimension, size_t number_constraints);
+      void reset_hessian();
+      ElementType& hessian(size_t row_index, size_t column_index) { return this->G[this->index(row_index, column_index)]; }
+      ElementType& gradient(size_t variable_index) { return this->g[variable_index]; }
+      // constraint gradient a_k (column k)
+      ElementType& constraint(size_t variable_index, size_t constraint_index) {
+         return this->A[constraint_index * this->maximum_dimension + variable_index];
+      }
+      void set_constraint(size_t constraint_index, DenseConstraintType type, ElementType bound);
+
+      // Cholesky factorization of G + regularization I. Returns false if the matrix is not (numerically) positive definite
+      [[nodiscard]] bool factorize(ElementType regularization);
+      SubproblemStatus solve(bool warmstart);
+
+      [[nodiscard]] const Vector<ElementType>& solution() const { return this->x; }
+      // multiplier of constraint k (nonnegative for inequality constraints), 0 if inactive
+      [[nodiscard]] ElementType multiplier(size_t constraint_index) const { return this->multipliers[constraint_index]; }
+      [[nodiscard]] bool is_active(size_t constraint_index) const { return this->active_constraints[constraint_index]; }
+      [[nodiscard]] size_t get_number_iterations() const { return this->number_iterations; }
+      // allocated memory of the dense matrices and vectors (in bytes)
+      [[nodiscard]] size_t memory_size() const;
+
+   protected:
+      const size_t maximum_dimension;
+      const size_t maximum_number_constraints;
+      const ElementType feasibility_tolerance;
+      size_t dimension{0};
+      size_t number_constraints{0};
+      size_t number_active_constraints{0};
+      size_t number_iterations{0};
+      ElementType R_norm{1};
+
+      // data (column-major dense matrices with leading dimension maximum_dimension)
+      Vector<ElementType> G;
+      Vector<ElementType> g;
+      Vector<ElementType> A;
+      Vector<ElementType> b;
+      std::vector<DenseConstraintType> types;
+      // factors and iterates
+      Vector<ElementType> L;
+      Vector<ElementType> J;
+      Vector<ElementType> R;
+      Vector<ElementType> x;
+      Vector<ElementType> u; // multipliers of the active constraints
+      Vector<ElementType> d;
+      Vector<ElementType> z;
+      Vector<ElementType> r;
+      Vector<ElementType> multipliers;
+      std::vector<size_t> active_set;
+      std::vector<bool> active_constraints;
+      std::vector<bool> previously_active_constraints;
+
+      [[nodiscard]] size_t index(size_t row_index, size_t column_index) const { return column_index * this->maximum_dimension + row_index; }
+      [[nodiscard]] ElementType constraint_value(size_t constraint_index) const;
+      [[nodiscard]] size_t select_violated_constraint(bool warmstart, ElementType& violation) const;
+      void compute_inverse_factor();
+      void compute_step_directions(size_t constraint_index);
+      [[nodiscard]] bool add_constraint();
+      void delete_constraint(size_t position);
+   };
+
+   // implementation
+
+   template <typename ElementType>
+   GoldfarbIdnaniQP<ElementType>::GoldfarbIdnaniQP(size_t maximum_dimension, size_t maximum_number_constraints,
+         ElementType feasibility_tolerance):
+         maximum_dimension(maximum_dimension), maximum_number_constraints(maximum_number_constraints),
+         feasibility_tolerance(feasibility_tolerance),
+         G(maximum_dimension * maximum_dimension), g(maximum_dimension), A(maximum_dimension * maximum_number_constraints),
+         b(maximum_number_constraints), types(maximum_number_constraints, DenseConstraintType::ABSENT),
+         L(maximum_dimension * maximum_dimension), J(maximum_dimension * maximum_dimension), R(maximum_dimension * maximum_dimension),
+         x(maximum_dimension), u(maximum_dimension), d(maximum_dimension), z(maximum_dimension), r(maximum_dimension),
+         multipliers(maximum_number_constraints), active_set(maximum_dimension), active_constraints(maximum_number_constraints, false),
+         previously_active_constraints(maximum_number_constraints, false) {
+   }
+
+   template <typename ElementType>
+   size_t GoldfarbIdnaniQP<ElementType>::memory_size() const {
+      size_t size = 0;
+      for (const Vector<ElementType>* vector: {&this->G, &this->g, &this->A, &this->b, &this->L, &this->J, &this->R, &this->x, &this->u,
+            &this->d, &this->z, &this->r, &this->multipliers}) {
+         size += vector->memory_size();
+      }
+      // the boolean vectors are bit sets
+      return size + this->types.capacity() * sizeof(DenseConstraintType) + this->active_set.capacity() * sizeof(size_t) +
+            (this->active_constraints.capacity() + this->previously_active_constraints.capacity()) / 8;
+   }
+
+   template <typename ElementType>
+   void GoldfarbIdnaniQP<ElementType>::reset(size_t dimension, size_t number_constraints) {
+      assert(dimension <= this->maximum_dimension && number_constraints <= this->maximum_number_constraints &&
+         "GoldfarbIdnaniQP: the dimensions exceed the allocated dimensions");
+      this->dimension = dimension;
+      this->number_constraints = number_constraints;
+      std::fill(this->g.begin(), this->g.end(), ElementType(0));
+      std::fill(this->A.begin(), this->A.end(), ElementType(0));
+      std::fill(this->b.begin(), this->b.end(), ElementType(0));
+      std::fill(this->types.begin(), this->types.end(), DenseConstraintType::ABSENT);
+   }
+
+   template <typename ElementType>
+   void GoldfarbIdnaniQP<ElementType>::reset_hessian() {
+      std::fill(this->G.begin(), this->G.end(), ElementType(0));
+   }
+
+   template <typename ElementType>
+   void GoldfarbIdnaniQP<ElementType>::set_constraint(size_t constraint_index, DenseConstraintType type, ElementType bound) {
+      this->types[constraint_index] = type;
+      this->b[constraint_index] = bound;
+   }
+
+   template <typename ElementType>
+   bool GoldfarbIdnaniQP<ElementType>::factorize(ElementType regularization) {
+      constexpr ElementType machine_epsilon = std::numeric_limits<ElementType>::epsilon();
+      const size_t n = this->dimension;
+      for (size_t column_index: Range(n)) {
+         const ElementType diagonal_entry = this->G[this->index(column_index, column_index)] + regularization;
+         ElementType pivot = diagonal_entry;
+         for (size_t k: Range(column_index)) {
+            pivot -= this->L[this->index(column_index, k)] * this->L[this->index(column_index, k)];
+         }
+         if (pivot <= machine_epsilon * (ElementType(1) + std::abs(diagonal_entry))) {
+            return false;
+         }
+         const ElementType diagonal_factor = std::sqrt(pivot);
+         this->L[this->index(column_index, column_index)] = diagonal_factor;
+         for (size_t row_index: Range(column_index + 1, n)) {
+            ElementType entry = this->G[this->index(row_index, column_index)];
+            for (size_t k: Range(column_index)) {
+               entry -= this->L[this->index(row_index, k)] * this->L[this->index(column_index, k)];
+            }
+            this->L[this->index(row_index, column_index)] = entry / diagonal_factor;
+         }
+      }
+      return true;
+   }
+
+   template <typename ElementType>
+   SubproblemStatus GoldfarbIdnaniQP<ElementType>::solve(bool warmstart) {
+      const size_t n = this->dimension;
+      const size_t maximum_number_iterations = 10 * (n + this->number_constraints) + 10;
+      this->compute_inverse_factor();
+      this->number_active_constraints = 0;
+      this->number_iterations = 0;
+      this->R_norm = ElementType(1);
+      std::fill(this->active_constraints.begin(), this->active_constraints.end(), false);
+      std::fill(this->multipliers.begin(), this->multipliers.end(), ElementType(0));
+
+      // unconstrained minimizer x = -G^{-1} g = -J J^T g
+      for (size_t i: Range(n)) {
+         this->d[i] = ElementType(0);
+         for (size_t j: Range(n)) {
+            this->d[i] += this->J[this->index(j, i)] * this->g[j];
+         }
+      }
+      for (size_t i: Range(n)) {
+         this->x[i] = ElementType(0);
+         for (size_t j: Range(n)) {
+            this->x[i] -= this->J[this->index(i, j)] * this->d[j];
+         }
+      }
+
+      // equality constraints: full steps. The active-set iterations are cancellation points (deadline of real-time solves)
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (this->types[constraint_index] == DenseConstraintType::EQUALITY) {
+            Cancellation::check();
+            this->number_iterations++;
+            this->compute_step_directions(constraint_index);
+            ElementType step_length;
+            ElementType z_norm2 = ElementType(0);
+            ElementType z_dot_a = ElementType(0);
+            for (size_t i: Range(n)) {
+               z_norm2 += this->z[i] * this->z[i];
+               z_dot_a += this->z[i] * this->constraint(i, constraint_index);
+            }
+            if (z_norm2 <= std::numeric_limits<ElementType>::epsilon()) {
+               // linearly dependent on the active equality constraints: redundant or inconsistent
+               const ElementType value = this->constraint_value(constraint_index);
+               if (std::abs(value) <= this->feasibility_tolerance * (ElementType(1) + std::abs(this->b[constraint_index]))) {
+                  continue;
+               }
+               return SubproblemStatus::INFEASIBLE;
+            }
+            step_length = -this->constraint_value(constraint_index) / z_dot_a;
+            for (size_t i: Range(n)) {
+               this->x[i] += step_length * this->z[i];
+            }
+            for (size_t i: Range(this->number_active_constraints)) {
+               this->u[i] -= step_length * this->r[i];
+            }
+            this->u[this->number_active_constraints] = step_length;
+            this->active_set[this->number_active_constraints] = constraint_index;
+            if (!this->add_constraint()) {
+               // linearly dependent equality constraints
+               return SubproblemStatus::ERROR;
+            }
+            this->active_constraints[constraint_index] = true;
+         }
+      }
+
+      // inequality constraints
+      ElementType violation;
+      size_t violated_constraint = this->select_violated_constraint(warmstart, violation);
+      while (violated_constraint < this->number_constraints) {
+         ElementType new_multiplier = ElementType(0);
+         bool is_added = false;
+         while (!is_added) {
+            Cancellation::check();
+            this->number_iterations++;
+            if (maximum_number_iterations < this->number_iterations) {
+               return SubproblemStatus::ERROR;
+            }
+            this->compute_step_directions(violated_constraint);
+            // partial (dual) step length: first active inequality constraint whose multiplier vanishes
+            ElementType dual_step_length = std::numeric_limits<ElementType>::infinity();
+            size_t blocking_position = this->number_active_constraints;
+            for (size_t position: Range(this->number_active_constraints)) {
+               if (this->types[this->active_set[position]] == DenseConstraintType::INEQUALITY && ElementType(0) < this->r[position] &&
+                     this->u[position] / this->r[position] < dual_step_length) {
+                  dual_step_length = this->u[position] / this->r[position];
+                  blocking_position = position;
+               }
+            }
+            // full (primal) step length: the violated constraint becomes active
+            ElementType primal_step_length = std::numeric_limits<ElementType>::infinity();
+            ElementType z_norm2 = ElementType(0);
+            ElementType z_dot_a = ElementType(0);
+            for (size_t i: Range(n)) {
+               z_norm2 += this->z[i] * this->z[i];
+               z_dot_a += this->z[i] * this->constraint(i, violated_constraint);
+            }
+            if (std::numeric_limits<ElementType>::epsilon() < z_norm2) {
+               primal_step_length = -violation / z_dot_a;
+            }
+            const ElementType step_length = std::min(dual_step_length, primal_step_length);
+            // no primal step and no multiplier vanishes: the constraints are inconsistent
+            if (step_length == std::numeric_limits<ElementType>::infinity()) {
+               return SubproblemStatus::INFEASIBLE;
+            }
+
+            // take the step
+            if (primal_step_length < std::numeric_limits<ElementType>::infinity()) {
+               for (size_t i: Range(n)) {
+                  this->x[i] += step_length * this->z[i];
+               }
+            }
+            for (size_t position: Range(this->number_active_constraints)) {
+               this->u[position] -= step_length * this->r[position];
+            }
+            new_multiplier += step_length;
+            if (step_length == primal_step_length) {
+               this->u[this->number_active_constraints] = new_multiplier;
+               this->active_set[this->number_active_constraints] = violated_constraint;
+               if (!this->add_constraint()) {
+                  return SubproblemStatus::ERROR;
+               }
+               this->active_constraints[violated_constraint] = true;
+               is_added = true;
+            }
+            else {
+               // drop the blocking constraint and recompute the violation
+               this->delete_constraint(blocking_position);
+               violation = this->constraint_value(violated_constraint);
+            }
+         }
+         violated_constraint = this->select_violated_constraint(warmstart, violation);
+      }
+
+      // multipliers of the constraints
+      for (size_t position: Range(this->number_active_constraints)) {
+         this->multipliers[this->active_set[position]] = this->u[position];
+      }
+      for (size_t constraint_index: Range(this->maximum_number_constraints)) {
+         this->previously_active_constraints[constraint_index] = (constraint_index < this->number_constraints) &&
+            this->active_constraints[constraint_index];
+      }
+      return SubproblemStatus::OPTIMAL;
+   }
+
+   // a_k^T x - b_k
+   template <typename ElementType>
+   ElementType GoldfarbIdnaniQP<ElementType>::constraint_value(size_t constraint_index) const {
+      ElementType value = -this->b[constraint_index];
+      for (size_t i: Range(this->dimension)) {
+         value += this->A[constraint_index * this->maximum_dimension + i] * this->x[i];
+      }
+      return value;
+   }
+
+   // most violated inactive inequality constraint, among the previously active ones first (warm start).
+   // Returns number_constraints if x is feasible
+   template <typename ElementType>
+   size_t GoldfarbIdnaniQP<ElementType>::select_violated_constraint(bool warmstart, ElementType& violation) const {
+      size_t selected_constraint = this->number_constraints;
+      bool is_selected_previously_active = false;
+      violation = ElementType(0);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (this->types[constraint_index] == DenseConstraintType::INEQUALITY && !this->active_constraints[constraint_index]) {
+            const ElementType value = this->constraint_value(constraint_index);
+            if (value < -this->feasibility_tolerance * (ElementType(1) + std::abs(this->b[constraint_index]))) {
+               const bool is_previously_active = warmstart && this->previously_active_constraints[constraint_index];
+               if ((is_previously_active && !is_selected_previously_active) ||
+                     (is_previously_active == is_selected_previously_active && value < violation)) {
+                  selected_constraint = constraint_index;
+                  is_selected_previously_active = is_previously_active;
+                  violation = value;
+               }
+            }
+         }
+      }
+      return selected_constraint;
+   }
+
+   // J = L^{-T}
+   template <typename ElementType>
+   void GoldfarbIdnaniQP<ElementType>::compute_inverse_factor() {
+      const size_t n = this->dimension;
+      for (size_t i: Range(n)) {
+         // row i of J is the solution of L z = e_i
+         for (size_t j: Range(i)) {
+            this->J[this->index(i, j)] = ElementType(0);
+         }
+         this->J[this->index(i, i)] = ElementType(1) / this->L[this->index(i, i)];
+         for (size_t j: Range(i + 1, n)) {
+            ElementType entry = ElementType(0);
+            for (size_t k: Range(i, j)) {
+               entry -= this->L[this->index(j, k)] * this->J[this->index(i, k)];
+            }
+            this->J[this->index(i, j)] = entry / this->L[this->index(j, j)];
+         }
+      }
+   }
+
+   // d = J^T a, primal direction z = J2 d2 and dual direction r = R^{-1} d1
+   template <typename ElementType>
+   void GoldfarbIdnaniQP<ElementType>::compute_step_directions(size_t constraint_index) {
+      const size_t n = this->dimension;
+      const size_t q = this->number_active_constraints;
+      for (size_t i: Range(n)) {
+         this->d[i] = ElementType(0);
+         for (size_t j: Range(n)) {
+            this->d[i] += this->J[this->index(j, i)] * this->constraint(j, constraint_index);
+         }
+      }
+      for (size_t i: Range(n)) {
+         this->z[i] = ElementType(0);
+         for (size_t j: Range(q, n)) {
+            this->z[i] += this->J[this->index(i, j)] * this->d[j];
+         }
+      }
+      for (size_t i = q; i-- > 0;) {
+         ElementType entry = this->d[i];
+         for (size_t j: Range(i + 1, q)) {
+            entry -= this->R[this->index(i, j)] * this->r[j];
+         }
+         this->r[i] = entry / this->R[this->index(i, i)];
+      }
+   }
+
+   // append d to R and rotate J accordingly. Returns false if the new constraint is (numerically) linearly dependent
+   template <typename ElementType>
+   bool GoldfarbIdnaniQP<ElementType>::add_constraint() {
+      const size_t n = this->dimension;
+      const size_t q = this->number_active_constraints;
+      if (n <= q) {
+         return false;
+      }
+      for (size_t j = n - 1; q < j; j--) {
+         ElementType cc = this->d[j - 1];
+         ElementType ss = this->d[j];
+         const ElementType h = std::hypot(cc, ss);
+         if (h == ElementType(0)) {
+            continue;
+         }
+         this->d[j] = ElementType(0);
+         ss /= h;
+         cc /= h;
+         if (cc < ElementType(0)) {
+            cc = -cc;
+            ss = -ss;
+            this->d[j - 1] = -h;
+         }
+         else {
+            this->d[j - 1] = h;
+         }
+         const ElementType xny = ss / (ElementType(1) + cc);
+         for (size_t k: Range(n)) {
+            const ElementType t1 = this->J[this->index(k, j - 1)];
+            const ElementType t2 = this->J[this->index(k, j)];
+            this->J[this->index(k, j - 1)] = t1 * cc + t2 * ss;
+            this->J[this->index(k, j)] = xny * (t1 + this->J[this->index(k, j - 1)]) - t2;
+         }
+      }
+      for (size_t i: Range(q + 1)) {
+         this->R[this->index(i, q)] = this->d[i];
+      }
+      if (std::abs(this->d[q]) <= std::numeric_limits<ElementType>::epsilon() * this->R_norm) {
+         return false;
+      }
+      this->R_norm = std::max(this->R_norm, std::abs(this->d[q]));
+      this->number_active_constraints++;
+      return true;
+   }
+
+   // remove the active constraint at a given position and restore the triangular structure of R
+   template <typename ElementType>
+   void GoldfarbIdnaniQP<ElementType>::delete_constraint(size_t position) {
+      const size_t n = this->dimension;
+      this->active_constraints[this->active_set[position]] = false;
+      for (size_t i: Range(position, this->number_active_constraints - 1)) {
+         this->active_set[i] = this->active_set[i + 1];
+         this->u[i] = this->u[i + 1];
+         for (size_t j: Range(this->number_active_constraints)) {
+            this->R[this->index(j, i)] = this->R[this->index(j, i + 1)];
+         }
+      }
+      this->number_active_constraints--;
+      const size_t q = this->number_active_constraints;
+      for (size_t j: Range(q + 1)) {
+         this->R[this->index(j, q)] = ElementType(0);
+      }
+      for (size_t j: Range(position, q)) {
+         ElementType cc = this->R[this->index(j, j)];
+         ElementType ss = this->R[this->index(j + 1, j)];
+         const ElementType h = std::hypot(cc, ss);
+         if (h == ElementType(0)) {
+            continue;
+         }
+         cc /= h;
+         ss /= h;
+         this->R[this->index(j + 1, j)] = ElementType(0);
+         if (cc < ElementType(0)) {
+            this->R[this->index(j, j)] = -h;
+            cc = -cc;
+            ss = -ss;
+         }
+         else {
+            this->R[this->index(j, j)] = h;
+         }
+         const ElementType xny = ss / (ElementType(1) + cc);
+         for (size_t k: Range(j + 1, q)) {
+            const ElementType t1 = this->R[this->index(j, k)];
+            const ElementType t2 = this->R[this->index(j + 1, k)];
+            this->R[this->index(j, k)] = t1 * cc + t2 * ss;
+            this->R[this->index(j + 1, k)] = xny * (t1 + this->R[this->index(j, k)]) - t2;
+         }
+         for (size_t k: Range(n)) {
+            const ElementType t1 = this->J[this->index(k, j)];
+            const ElementType t2 = this->J[this->index(k, j + 1)];
+            this->J[this->index(k, j)] = t1 * cc + t2 * ss;
+            this->J[this->index(k, j + 1)] = xny * (this->J[this->index(k, j)] + t1) - t2;
+         }
+      }
+   }
+} // namespace
+
+#endif // UNO_GOLDFARBIDNANIQP_H
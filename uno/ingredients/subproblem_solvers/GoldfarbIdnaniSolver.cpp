@@ -0,0 +1,253 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <stdexcept>
+#include "GoldfarbIdnaniSolver.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "ingredients/hessian_models/HessianModel.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "options/Options.hpp"
+#include "symbolic/VectorView.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+#include "tools/MemoryReport.hpp"
+
+namespace uno {
+   GoldfarbIdnaniSolver::GoldfarbIdnaniSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
+         size_t /*number_jacobian_nonzeros*/, size_t number_hessian_nonzeros, const Options& options):
+         QPSolver(),
+         lower_bounds(number_variables + number_constraints),
+         upper_bounds(number_variables + number_constraints),
+         constraints(number_constraints),
+         linear_objective(number_objective_gradient_nonzeros),
+         hessian(number_variables, number_hessian_nonzeros, options.get_string("globalization_mechanism") == "LS" || options.get_bool("convexify_QP"),
+               "CSC"),
+         // two (lower and upper) bound rows per variable and per constraint
+         qp_solver(number_variables, 2 * (number_variables + number_constraints), options.get_double("GoldfarbIdnani_feasibility_tolerance")),
+         regularization_initial_value(options.get_double("regularization_initial_value")),
+         regularization_increase_factor(options.get_double("regularization_increase_factor")),
+         regularization_failure_threshold(options.get_double("regularization_failure_threshold")),
+         regularization_max_factorizations(options.get_unsigned_int("regularization_max_factorizations")),
+         print_subproblem(options.get_bool("print_subproblem")) {
+   }
+
+   void GoldfarbIdnaniSolver::solve_LP(const OptimizationProblem& /*problem*/, Iterate& /*current_iterate*/, const Vector<double>& /*initial_point*/,
+         Direction& /*direction*/, double /*trust_region_radius*/, const WarmstartInformation& /*warmstart_information*/) {
+      throw std::runtime_error("GoldfarbIdnaniSolver::solve_LP: the Goldfarb-Idnani method requires a positive definite Hessian");
+   }
+
+   void GoldfarbIdnaniSolver::solve_QP(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Vector<double>& current_multipliers, const Vector<double>& /*initial_point*/, Direction& direction, HessianModel& hessian_model,
+         double trust_region_radius, const WarmstartInformation& warmstart_information) {
+      if (this->print_subproblem) {
+         DEBUG << "QP:\n";
+      }
+      this->set_up_subproblem(problem, current_iterate, trust_region_radius, warmstart_information);
+      // the Hessian is factorized again only if it changed
+      const bool hessian_changed = warmstart_information.objective_changed || warmstart_information.constraints_changed ||
+            this->dimension != problem.number_variables || !this->is_hessian_factorized;
+      if (hessian_changed) {
+         hessian_model.evaluate(statistics, problem, current_iterate.primals, current_multipliers, this->hessian);
+      }
+      DEBUG << "Hessian: " << this->hessian;
+      // warm start from the active set of the previous QP with the same dimensions
+      const bool warmstart = this->is_active_set_valid && this->dimension == problem.number_variables &&
+            this->solved_number_constraints == problem.number_constraints;
+      this->load_dense_QP(problem, hessian_changed);
+      if (hessian_changed) {
+         this->is_hessian_factorized = this->factorize_hessian();
+         if (!this->is_hessian_factorized) {
+            DEBUG << "Goldfarb-Idnani: the Hessian could not be convexified\n";
+            direction.status = SubproblemStatus::ERROR;
+            this->is_active_set_valid = false;
+            return;
+         }
+      }
+
+      // an interrupted solve (see Cancellation) leaves no valid active set
+      this->is_active_set_valid = false;
+      direction.status = this->qp_solver.solve(warmstart);
+      DEBUG << "Goldfarb-Idnani: " << this->qp_solver.get_number_iterations() << " iterations" << (warmstart ? " (warm start)\n" : "\n");
+      this->is_active_set_valid = (direction.status == SubproblemStatus::OPTIMAL);
+      if (direction.status != SubproblemStatus::OPTIMAL) {
+         return;
+      }
+      // project the solution into the bounds
+      const Vector<double>& solution = this->qp_solver.solution();
+      for (size_t variable_index: Range(problem.number_variables)) {
+         direction.primals[variable_index] = std::min(std::max(solution[variable_index], this->lower_bounds[variable_index]),
+               this->upper_bounds[variable_index]);
+      }
+      this->set_multipliers(problem, direction.multipliers);
+      direction.subproblem_objective = this->evaluate_subproblem_objective(direction.primals);
+   }
+
+   double GoldfarbIdnaniSolver::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      double product = this->hessian.quadratic_product(primal_direction, primal_direction);
+      // diagonal regularization used to convexify the Hessian
+      for (size_t variable_index: Range(this->dimension)) {
+         product += this->regularization_factor * primal_direction[variable_index] * primal_direction[variable_index];
+      }
+      return product;
+   }
+
+   void GoldfarbIdnaniSolver::report_memory(MemoryReport& report) const {
+      report.add("QP solver/bounds", this->lower_bounds.memory_size() + this->upper_bounds.memory_size());
+      report.add("QP solver/constraints", MemoryReport::memory_size(this->constraints));
+      report.add("QP solver/objective gradient", this->linear_objective.memory_size());
+      report.add("QP solver/Hessian", this->hessian.memory_size());
+      report.add("QP solver/dense QP", this->qp_solver.memory_size());
+   }
+
+   void GoldfarbIdnaniSolver::set_up_subproblem(const OptimizationProblem& problem, Iterate& current_iterate, double trust_region_radius,
+         const WarmstartInformation& warmstart_information) {
+      // function evaluations
+      if (warmstart_information.objective_changed) {
+         problem.evaluate_objective_gradient(current_iterate, this->linear_objective);
+      }
+      if (warmstart_information.constraints_changed) {
+         problem.evaluate_constraints(current_iterate, this->constraints);
+         problem.evaluate_constraint_jacobian(current_iterate, this->constraint_jacobian);
+      }
+
+      // variable bounds
+      if (warmstart_information.variable_bounds_changed) {
+         // bounds of original variables intersected with trust region
+         for (size_t variable_index: Range(problem.get_number_original_variables())) {
+            this->lower_bounds[variable_index] = std::max(-trust_region_radius,
+                  problem.variable_lower_bound(variable_index) - current_iterate.primals[variable_index]);
+            this->upper_bounds[variable_index] = std::min(trust_region_radius,
+                  problem.variable_upper_bound(variable_index) - current_iterate.primals[variable_index]);
+         }
+         // bounds of additional variables (no trust region!)
+         for (size_t variable_index: Range(problem.get_number_original_variables(), problem.number_variables)) {
+            this->lower_bounds[variable_index] = problem.variable_lower_bound(variable_index) - current_iterate.primals[variable_index];
+            this->upper_bounds[variable_index] = problem.variable_upper_bound(variable_index) - current_iterate.primals[variable_index];
+         }
+      }
+
+      // constraint bounds
+      if (warmstart_information.constraint_bounds_changed || warmstart_information.constraints_changed) {
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            this->lower_bounds[problem.number_variables + constraint_index] = problem.constraint_lower_bound(constraint_index) -
+                  this->constraints[constraint_index];
+            this->upper_bounds[problem.number_variables + constraint_index] = problem.constraint_upper_bound(constraint_index) -
+                  this->constraints[constraint_index];
+         }
+      }
+
+      if (this->print_subproblem) {
+         DEBUG << "objective gradient: " << this->linear_objective;
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            DEBUG << "gradient c" << constraint_index << ": " << this->constraint_jacobian[constraint_index];
+         }
+         for (size_t variable_index: Range(problem.number_variables)) {
+            DEBUG << "d" << variable_index << " in [" << this->lower_bounds[variable_index] << ", " << this->upper_bounds[variable_index] << "]\n";
+         }
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            DEBUG << "linearized c" << constraint_index << " in [" << this->lower_bounds[problem.number_variables + constraint_index] << ", " <<
+                  this->upper_bounds[problem.number_variables + constraint_index] << "]\n";
+         }
+      }
+   }
+
+   // copy the QP into the dense arrays. The two-sided bounds l <= a^T d <= u become the rows a^T d >= l and -a^T d >= -u
+   void GoldfarbIdnaniSolver::load_dense_QP(const OptimizationProblem& problem, bool hessian_changed) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints = problem.number_constraints;
+      this->qp_solver.reset(number_variables, 2 * (number_variables + number_constraints));
+      this->dimension = number_variables;
+      this->solved_number_constraints = number_constraints;
+
+      // objective
+      for (const auto [variable_index, derivative]: this->linear_objective) {
+         this->qp_solver.gradient(variable_index) = derivative;
+      }
+      if (hessian_changed) {
+         // lower triangle
+         this->qp_solver.reset_hessian();
+         this->hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+            this->qp_solver.hessian(std::max(row_index, column_index), std::min(row_index, column_index)) += element;
+         });
+      }
+
+      const auto set_bound_rows = [&](size_t row_index, double lower_bound, double upper_bound) {
+         if (lower_bound == upper_bound) {
+            this->qp_solver.set_constraint(row_index, DenseConstraintType::EQUALITY, lower_bound);
+            return;
+         }
+         if (is_finite(lower_bound)) {
+            this->qp_solver.set_constraint(row_index, DenseConstraintType::INEQUALITY, lower_bound);
+         }
+         if (is_finite(upper_bound)) {
+            this->qp_solver.set_constraint(row_index + 1, DenseConstraintType::INEQUALITY, -upper_bound);
+         }
+      };
+      // linearized constraints
+      for (size_t constraint_index: Range(number_constraints)) {
+         const size_t row_index = 2 * constraint_index;
+         for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
+            this->qp_solver.constraint(variable_index, row_index) = derivative;
+            this->qp_solver.constraint(variable_index, row_index + 1) = -derivative;
+         }
+         set_bound_rows(row_index, this->lower_bounds[number_variables + constraint_index], this->upper_bounds[number_variables + constraint_index]);
+      }
+      // variable bounds
+      for (size_t variable_index: Range(number_variables)) {
+         const size_t row_index = 2 * (number_constraints + variable_index);
+         this->qp_solver.constraint(variable_index, row_index) = 1.;
+         this->qp_solver.constraint(variable_index, row_index + 1) = -1.;
+         set_bound_rows(row_index, this->lower_bounds[variable_index], this->upper_bounds[variable_index]);
+      }
+   }
+
+   // factorize the Hessian, regularized (on all the variables) until it is positive definite
+   bool GoldfarbIdnaniSolver::factorize_hessian() {
+      this->regularization_factor = 0.;
+      size_t number_factorizations = 1;
+      while (!this->qp_solver.factorize(this->regularization_factor)) {
+         if (0 < this->regularization_max_factorizations && this->regularization_max_factorizations <= number_factorizations) {
+            return false;
+         }
+         number_factorizations++;
+         this->regularization_factor = (this->regularization_factor == 0.) ? this->regularization_initial_value :
+               this->regularization_increase_factor * this->regularization_factor;
+         DEBUG << "Goldfarb-Idnani: testing factorization with regularization factor " << this->regularization_factor << '\n';
+         if (this->regularization_failure_threshold < this->regularization_factor) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   void GoldfarbIdnaniSolver::set_multipliers(const OptimizationProblem& problem, Multipliers& direction_multipliers) const {
+      direction_multipliers.reset();
+      // the multiplier of an equality row is signed
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         const size_t row_index = 2 * constraint_index;
+         direction_multipliers.constraints[constraint_index] = this->qp_solver.multiplier(row_index) - this->qp_solver.multiplier(row_index + 1);
+      }
+      for (size_t variable_index: Range(problem.number_variables)) {
+         const size_t row_index = 2 * (problem.number_constraints + variable_index);
+         const double bound_multiplier = this->qp_solver.multiplier(row_index) - this->qp_solver.multiplier(row_index + 1);
+         if (0. < bound_multiplier) {
+            direction_multipliers.lower_bounds[variable_index] = bound_multiplier;
+         }
+         else if (bound_multiplier < 0.) {
+            direction_multipliers.upper_bounds[variable_index] = bound_multiplier;
+         }
+      }
+   }
+
+   // g^T d + 1/2 d^T (H + regularization I) d
+   double GoldfarbIdnaniSolver::evaluate_subproblem_objective(const Vector<double>& primal_direction) const {
+      double objective = 0.5 * this->hessian_quadratic_product(primal_direction);
+      for (const auto [variable_index, derivative]: this->linear_objective) {
+         objective += derivative * primal_direction[variable_index];
+      }
+      return objective;
+   }
+} // namespace
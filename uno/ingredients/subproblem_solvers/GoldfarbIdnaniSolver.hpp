@@ -0,0 +1,72 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_GOLDFARBIDNANISOLVER_H
+#define UNO_GOLDFARBIDNANISOLVER_H
+
+#include <vector>
+#include "GoldfarbIdnaniQP.hpp"
+#include "QPSolver.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declarations
+   class Multipliers;
+   class Options;
+
+   /*! \class GoldfarbIdnaniSolver
+    * \brief Dense QP solver for small subproblems (dual active-set method of Goldfarb and Idnani)
+    *
+    *  The QP is copied into dense arrays allocated once by the constructor. The Hessian is convexified by a diagonal regularization
+    *  of all the variables if its Cholesky factorization fails. The active set of the previous QP is used as a warm start.
+    *  Rows of the dense constraint matrix: 2j and 2j+1 are the lower and upper bounds of constraint j; 2(m+i) and 2(m+i)+1 are the
+    *  lower and upper bounds of variable i
+    */
+   class GoldfarbIdnaniSolver : public QPSolver {
+   public:
+      GoldfarbIdnaniSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
+            size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options);
+
+      void solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& initial_point, Direction& direction,
+            double trust_region_radius, const WarmstartInformation& warmstart_information) override;
+
+      void solve_QP(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& current_multipliers,
+            const Vector<double>& initial_point, Direction& direction, HessianModel& hessian_model, double trust_region_radius,
+            const WarmstartInformation& warmstart_information) override;
+
+      [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      void report_memory(MemoryReport& report) const override;
+
+   protected:
+      Vector<double> lower_bounds{}; // lower bounds of the variables and constraints
+      Vector<double> upper_bounds{}; // upper bounds of the variables and constraints
+      std::vector<double> constraints;
+      SparseVector<double> linear_objective;
+      RectangularMatrixView<double> constraint_jacobian; /*!< view of the Jacobian of the current iterate */
+      SymmetricMatrix<size_t, double> hessian;
+      GoldfarbIdnaniQP<double> qp_solver;
+      size_t dimension{0};
+      size_t solved_number_constraints{0};
+      bool is_hessian_factorized{false};
+      bool is_active_set_valid{false};
+      double regularization_factor{0.};
+
+      const double regularization_initial_value;
+      const double regularization_increase_factor;
+      const double regularization_failure_threshold;
+      const size_t regularization_max_factorizations; /*!< 0: no limit */
+      const bool print_subproblem;
+
+      void set_up_subproblem(const OptimizationProblem& problem, Iterate& current_iterate, double trust_region_radius,
+            const WarmstartInformation& warmstart_information);
+      void load_dense_QP(const OptimizationProblem& problem, bool hessian_changed);
+      [[nodiscard]] bool factorize_hessian();
+      void set_multipliers(const OptimizationProblem& problem, Multipliers& direction_multipliers) const;
+      [[nodiscard]] double evaluate_subproblem_objective(const Vector<double>& primal_direction) const;
+   };
+} // namespace
+
+#endif // UNO_GOLDFARBIDNANISOLVER_H
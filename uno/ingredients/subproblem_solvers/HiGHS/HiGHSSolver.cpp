@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
 #include "HiGHSSolver.hpp"
 #include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "ingredients/hessian_models/HessianModel.hpp"
 #include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "optimization/Direction.hpp"
@@ -8,15 +11,28 @@
 #include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
 #include "symbolic/VectorView.hpp"
+#include "tools/MemoryReport.hpp"
+#include "tools/Statistics.hpp"
+#include "tools/ThreadPool.hpp"
 
 namespace uno {
    HiGHSSolver::HiGHSSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
-         size_t number_jacobian_nonzeros, size_t /*number_hessian_nonzeros*/, const Options& options):
-         LPSolver(),
+         size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options):
+         QPSolver(),
          constraints(number_constraints),
          linear_objective(number_objective_gradient_nonzeros),
-         constraint_jacobian(number_constraints, number_variables),
-         print_subproblem(options.get_bool("print_subproblem")) {
+         // the QPs are convexified: the Hessian has room for a diagonal regularization
+         hessian(number_variables, number_hessian_nonzeros, true, "CSC"),
+         current_hessian_indices(number_variables),
+         print_subproblem(options.get_bool("print_subproblem")),
+         LP_algorithm(HiGHSSolver::choose_LP_algorithm(number_variables, number_jacobian_nonzeros, options)),
+         adaptive_tolerance_factor(options.get_double("HiGHS_adaptive_tolerance_factor")),
+         minimum_tolerance(options.get_double("HiGHS_minimum_tolerance")),
+         maximum_tolerance(options.get_double("HiGHS_maximum_tolerance")),
+         accuracy(options) {
+      if (this->maximum_tolerance < this->minimum_tolerance) {
+         throw std::invalid_argument("HiGHS_minimum_tolerance should not exceed HiGHS_maximum_tolerance");
+      }
       this->model.lp_.sense_ = ObjSense::kMinimize;
       this->model.lp_.offset_ = 0.;
       // the linear part of the objective is a dense vector
@@ -34,6 +50,63 @@ namespace uno {
       this->model.lp_.a_matrix_.start_.reserve(number_variables + 1);
 
       this->highs_solver.setOptionValue("output_flag", "false");
+      // parallelism: 0 uses the threads of the thread pool, or leaves the number of threads to HiGHS without pool
+      const int number_threads = ThreadPool::linear_solver_threads(options, "HiGHS_threads");
+      if (0 < number_threads) {
+         this->highs_solver.setOptionValue("threads", static_cast<HighsInt>(number_threads));
+      }
+      // the parallel dual simplex depends on the thread timings: it is disabled in deterministic mode
+      if (options.get_bool("deterministic")) {
+         this->highs_solver.setOptionValue("parallel", "off");
+      }
+      else {
+         this->highs_solver.setOptionValue("parallel", (1 < number_threads) ? "on" : "choose");
+      }
+   }
+
+   // small LPs are solved with the (warm-started) dual simplex; the interior-point method and PDLP scale better on large LPs
+   std::string HiGHSSolver::choose_LP_algorithm(size_t number_variables, size_t number_jacobian_nonzeros, const Options& options) {
+      const std::string& LP_algorithm = options.get_string("HiGHS_LP_algorithm");
+      if (LP_algorithm == "simplex" || LP_algorithm == "ipm" || LP_algorithm == "pdlp") {
+         return LP_algorithm;
+      }
+      else if (LP_algorithm == "auto") {
+         const size_t problem_size = number_variables + number_jacobian_nonzeros;
+         if (options.get_unsigned_int("HiGHS_pdlp_size_threshold") <= problem_size) {
+            return "pdlp";
+         }
+         else if (options.get_unsigned_int("HiGHS_ipm_size_threshold") <= problem_size) {
+            return "ipm";
+         }
+         return "simplex";
+      }
+      throw std::invalid_argument("The HiGHS LP algorithm " + LP_algorithm + " is unknown");
+   }
+
+   // inexact subproblem solves far from a KKT point: the tolerances are proportional to the KKT error of the current iterate
+   void HiGHSSolver::set_LP_tolerances(const Iterate& current_iterate) {
+      const double KKT_error = std::max({current_iterate.primal_feasibility, current_iterate.residuals.stationarity,
+            current_iterate.residuals.complementarity});
+      const double tolerance = std::clamp(this->adaptive_tolerance_factor * KKT_error, this->minimum_tolerance, this->maximum_tolerance);
+      this->highs_solver.setOptionValue("primal_feasibility_tolerance", tolerance);
+      this->highs_solver.setOptionValue("dual_feasibility_tolerance", tolerance);
+      if (this->LP_algorithm == "ipm") {
+         this->highs_solver.setOptionValue("ipm_optimality_tolerance", tolerance);
+      }
+      else {
+         this->highs_solver.setOptionValue("pdlp_d_gap_tol", tolerance);
+      }
+   }
+
+   // active-set solves (simplex method and QP solver): the feasibility tolerances are loosened far from a KKT point
+   void HiGHSSolver::set_feasibility_tolerances(const Iterate& current_iterate) {
+      const double tolerance = this->accuracy.tolerance(current_iterate, HiGHSSolver::default_feasibility_tolerance);
+      this->highs_solver.setOptionValue("primal_feasibility_tolerance", tolerance);
+      this->highs_solver.setOptionValue("dual_feasibility_tolerance", tolerance);
+   }
+
+   void HiGHSSolver::initialize_statistics(Statistics& statistics, const Options& options) {
+      statistics.add_column("QP iter", Statistics::int_width, options.get_int("statistics_subproblem_iterations_column_order"));
    }
 
    void HiGHSSolver::solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& /*initial_point*/,
@@ -41,12 +114,64 @@ namespace uno {
       if (this->print_subproblem) {
          DEBUG << "LP:\n";
       }
-      this->set_up_subproblem(problem, current_iterate, trust_region_radius, warmstart_information);
+      this->highs_solver.setOptionValue("solver", this->LP_algorithm);
+      if (this->LP_algorithm != "simplex") {
+         this->set_LP_tolerances(current_iterate);
+      }
+      else {
+         this->set_feasibility_tolerances(current_iterate);
+      }
+      this->set_up_subproblem(problem, current_iterate, trust_region_radius, warmstart_information, false);
       this->solve_subproblem(problem, direction);
    }
 
+   void HiGHSSolver::solve_QP(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Vector<double>& current_multipliers, const Vector<double>& /*initial_point*/, Direction& direction, HessianModel& hessian_model,
+         double trust_region_radius, const WarmstartInformation& warmstart_information) {
+      const bool hessian_changed = warmstart_information.objective_changed || warmstart_information.constraints_changed;
+      if (hessian_changed) {
+         hessian_model.evaluate(statistics, problem, current_iterate.primals, current_multipliers, this->hessian);
+         this->save_hessian_to_local_format();
+      }
+      if (this->print_subproblem) {
+         DEBUG << "QP:\n";
+      }
+      // the QP solver of HiGHS is an active-set method
+      this->highs_solver.setOptionValue("solver", "choose");
+      this->set_feasibility_tolerances(current_iterate);
+      DEBUG << "Hessian: " << this->hessian;
+      this->set_up_subproblem(problem, current_iterate, trust_region_radius, warmstart_information, hessian_changed);
+      this->solve_subproblem(problem, direction);
+      const HighsInfo& info = this->highs_solver.getInfo();
+      statistics.set("QP iter", static_cast<int>(info.simplex_iteration_count + info.qp_iteration_count));
+   }
+
+   double HiGHSSolver::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      return this->hessian.quadratic_product(primal_direction, primal_direction);
+   }
+
+   void HiGHSSolver::report_memory(MemoryReport& report) const {
+      report.add("LP/QP solver/constraints", MemoryReport::memory_size(this->constraints));
+      report.add("LP/QP solver/objective gradient", this->linear_objective.memory_size());
+      report.add("LP/QP solver/Hessian", this->hessian.memory_size() + MemoryReport::memory_size(this->current_hessian_indices));
+      // copy of the problem held by HiGHS
+      const HighsSparseMatrix& matrix = this->model.lp_.a_matrix_;
+      report.add("LP/QP solver/HiGHS model", MemoryReport::memory_size(this->model.lp_.col_cost_) +
+            MemoryReport::memory_size(this->model.lp_.col_lower_) + MemoryReport::memory_size(this->model.lp_.col_upper_) +
+            MemoryReport::memory_size(this->model.lp_.row_lower_) + MemoryReport::memory_size(this->model.lp_.row_upper_) +
+            MemoryReport::memory_size(matrix.start_) + MemoryReport::memory_size(matrix.index_) + MemoryReport::memory_size(matrix.value_) +
+            MemoryReport::memory_size(this->model.hessian_.start_) + MemoryReport::memory_size(this->model.hessian_.index_) +
+            MemoryReport::memory_size(this->model.hessian_.value_));
+   }
+
    void HiGHSSolver::set_up_subproblem(const OptimizationProblem& problem, Iterate& current_iterate, double trust_region_radius,
-         const WarmstartInformation& warmstart_information) {
+         const WarmstartInformation& warmstart_information, bool hessian_changed) {
+      // the dimensions change when switching between the optimality and feasibility problems: the model is passed again
+      if (this->model.lp_.num_col_ != static_cast<HighsInt>(problem.number_variables) ||
+            this->model.lp_.num_row_ != static_cast<HighsInt>(problem.number_constraints)) {
+         this->is_model_loaded = false;
+         this->basis.valid = false;
+      }
       this->model.lp_.num_col_ = static_cast<HighsInt>(problem.number_variables);
       this->model.lp_.num_row_ = static_cast<HighsInt>(problem.number_constraints);
 
@@ -67,27 +192,6 @@ namespace uno {
          problem.evaluate_constraint_jacobian(current_iterate, this->constraint_jacobian);
       }
 
-      // linear part of the objective
-      for (const auto [variable_index, value]: this->linear_objective) {
-         this->model.lp_.col_cost_[variable_index] = value;
-      }
-
-      // constraint matrix
-      this->model.lp_.a_matrix_.value_.clear();
-      this->model.lp_.a_matrix_.index_.clear();
-      this->model.lp_.a_matrix_.start_.clear();
-
-      size_t number_nonzeros = 0;
-      this->model.lp_.a_matrix_.start_.emplace_back(number_nonzeros);
-      for (size_t constraint_index: Range(problem.number_constraints)) {
-         for (const auto [variable_index, value]: this->constraint_jacobian[constraint_index]) {
-            this->model.lp_.a_matrix_.value_.emplace_back(value);
-            this->model.lp_.a_matrix_.index_.emplace_back(variable_index);
-            number_nonzeros++;
-         }
-         this->model.lp_.a_matrix_.start_.emplace_back(number_nonzeros);
-      }
-
       // variable bounds
       if (warmstart_information.variable_bounds_changed) {
          // bounds of original variables intersected with trust region
@@ -112,12 +216,14 @@ namespace uno {
          }
       }
 
+      this->load_model(problem, warmstart_information, hessian_changed);
+
       if (this->print_subproblem) {
-         DEBUG << "Linear objective part: "; print_vector(DEBUG, view(this->model.lp_.col_cost_, 0, problem.number_variables));
+         DEBUG << "Linear objective part: " << view(this->model.lp_.col_cost_, 0, problem.number_variables);
          DEBUG << "Jacobian:\n";
-         DEBUG << "J = "; print_vector(DEBUG, this->model.lp_.a_matrix_.value_);
-         DEBUG << "with column start: "; print_vector(DEBUG, this->model.lp_.a_matrix_.start_);
-         DEBUG << "and row index: "; print_vector(DEBUG, this->model.lp_.a_matrix_.index_);
+         DEBUG << "J = " << view(this->model.lp_.a_matrix_.value_, 0, this->model.lp_.a_matrix_.value_.size());
+         DEBUG << "with column start: " << view(this->model.lp_.a_matrix_.start_, 0, this->model.lp_.a_matrix_.start_.size());
+         DEBUG << "and row index: " << view(this->model.lp_.a_matrix_.index_, 0, this->model.lp_.a_matrix_.index_.size());
          for (size_t variable_index = 0; variable_index < problem.number_variables; variable_index++) {
             DEBUG << "d" << variable_index << " in [" << this->model.lp_.col_lower_[variable_index] << ", " <<
                this->model.lp_.col_upper_[variable_index] << "]\n";
@@ -129,12 +235,184 @@ namespace uno {
       }
    }
 
+   // CSR constraint matrix (each row is a constraint gradient)
+   void HiGHSSolver::assemble_constraint_matrix(size_t number_constraints) {
+      this->model.lp_.a_matrix_.value_.clear();
+      this->model.lp_.a_matrix_.index_.clear();
+      this->model.lp_.a_matrix_.start_.clear();
+
+      size_t number_nonzeros = 0;
+      this->model.lp_.a_matrix_.start_.emplace_back(number_nonzeros);
+      for (size_t constraint_index: Range(number_constraints)) {
+         for (const auto [variable_index, value]: this->constraint_jacobian[constraint_index]) {
+            this->model.lp_.a_matrix_.value_.emplace_back(value);
+            this->model.lp_.a_matrix_.index_.emplace_back(variable_index);
+            number_nonzeros++;
+         }
+         this->model.lp_.a_matrix_.start_.emplace_back(number_nonzeros);
+      }
+   }
+
+   // compare the sparsity pattern of the Jacobian with that of the constraint matrix loaded into HiGHS
+   bool HiGHSSolver::has_same_jacobian_sparsity(size_t number_constraints) const {
+      const HighsSparseMatrix& a_matrix = this->model.lp_.a_matrix_;
+      if (a_matrix.start_.size() != number_constraints + 1) {
+         return false;
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         HighsInt nonzero_index = a_matrix.start_[constraint_index];
+         for (const auto [variable_index, value]: this->constraint_jacobian[constraint_index]) {
+            if (a_matrix.start_[constraint_index + 1] <= nonzero_index ||
+                  a_matrix.index_[static_cast<size_t>(nonzero_index)] != static_cast<HighsInt>(variable_index)) {
+               return false;
+            }
+            nonzero_index++;
+         }
+         if (nonzero_index != a_matrix.start_[constraint_index + 1]) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   // Uno stores the upper triangle of the Hessian column-wise, HiGHS expects the lower triangle column-wise: the CSC arrays are transposed
+   // (the duplicate diagonal entries introduced by the regularization are summed)
+   void HiGHSSolver::save_hessian_to_local_format() {
+      HighsHessian& highs_hessian = this->model.hessian_;
+      const size_t dimension = this->hessian.dimension();
+      highs_hessian.dim_ = static_cast<HighsInt>(dimension);
+      highs_hessian.format_ = HessianFormat::kTriangular;
+      highs_hessian.start_.assign(dimension + 1, 0);
+      highs_hessian.index_.resize(this->hessian.number_nonzeros());
+      highs_hessian.value_.resize(this->hessian.number_nonzeros());
+      // count the elements in each column of the lower triangle
+      this->hessian.for_each([&](size_t row_index, size_t /*column_index*/, double /*element*/) {
+         highs_hessian.start_[row_index + 1]++;
+      });
+      for (size_t column_index: Range(1, dimension + 1)) {
+         highs_hessian.start_[column_index] += highs_hessian.start_[column_index - 1];
+      }
+      // copy the entries: the row indices are sorted in each column
+      for (size_t column_index: Range(dimension)) {
+         this->current_hessian_indices[column_index] = highs_hessian.start_[column_index];
+      }
+      this->hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+         const size_t index = static_cast<size_t>(this->current_hessian_indices[row_index]++);
+         highs_hessian.index_[index] = static_cast<HighsInt>(column_index);
+         highs_hessian.value_[index] = element;
+      });
+      // sum the duplicate entries
+      HighsInt number_nonzeros = 0;
+      for (size_t column_index: Range(dimension)) {
+         const HighsInt column_start = highs_hessian.start_[column_index];
+         const HighsInt column_end = highs_hessian.start_[column_index + 1];
+         highs_hessian.start_[column_index] = number_nonzeros;
+         for (HighsInt index = column_start; index < column_end; index++) {
+            const size_t position = static_cast<size_t>(index);
+            if (highs_hessian.start_[column_index] < number_nonzeros &&
+                  highs_hessian.index_[static_cast<size_t>(number_nonzeros - 1)] == highs_hessian.index_[position]) {
+               highs_hessian.value_[static_cast<size_t>(number_nonzeros - 1)] += highs_hessian.value_[position];
+            }
+            else {
+               highs_hessian.index_[static_cast<size_t>(number_nonzeros)] = highs_hessian.index_[position];
+               highs_hessian.value_[static_cast<size_t>(number_nonzeros)] = highs_hessian.value_[position];
+               number_nonzeros++;
+            }
+         }
+      }
+      highs_hessian.start_[dimension] = number_nonzeros;
+      highs_hessian.index_.resize(static_cast<size_t>(number_nonzeros));
+      highs_hessian.value_.resize(static_cast<size_t>(number_nonzeros));
+   }
+
+   void HiGHSSolver::set_initial_basis(const OptimizationProblem& problem) {
+      this->is_initial_basis_requested = true;
+      std::vector<BasisStatus> variable_statuses{};
+      std::vector<BasisStatus> constraint_statuses{};
+      if (problem.get_initial_basis(variable_statuses, constraint_statuses)) {
+         this->basis.col_status.resize(problem.number_variables);
+         for (size_t variable_index: Range(problem.number_variables)) {
+            this->basis.col_status[variable_index] = HiGHSSolver::to_highs_status(variable_statuses[variable_index]);
+         }
+         this->basis.row_status.resize(problem.number_constraints);
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            this->basis.row_status[constraint_index] = HiGHSSolver::to_highs_status(constraint_statuses[constraint_index]);
+         }
+         this->basis.valid = true;
+         DEBUG << "HiGHS: hot start from the initial basis\n";
+      }
+   }
+
+   HighsBasisStatus HiGHSSolver::to_highs_status(BasisStatus status) {
+      switch (status) {
+         case BasisStatus::AT_LOWER_BOUND:
+            return HighsBasisStatus::kLower;
+         case BasisStatus::AT_UPPER_BOUND:
+            return HighsBasisStatus::kUpper;
+         default:
+            return HighsBasisStatus::kBasic;
+      }
+   }
+
+   void HiGHSSolver::load_model(const OptimizationProblem& problem, const WarmstartInformation& warmstart_information, bool hessian_changed) {
+      const HighsInt number_variables = this->model.lp_.num_col_;
+      const HighsInt number_constraints = this->model.lp_.num_row_;
+      if (this->is_model_loaded && (warmstart_information.jacobian_sparsity_changed ||
+            (warmstart_information.constraints_changed && !this->has_same_jacobian_sparsity(problem.number_constraints)))) {
+         this->is_model_loaded = false;
+      }
+
+      if (!this->is_model_loaded) {
+         // pass the whole model, then restore the basis of the previous solve or the basis provided by the user (if any)
+         this->assemble_constraint_matrix(problem.number_constraints);
+         [[maybe_unused]] HighsStatus return_status = this->highs_solver.passModel(this->model);
+         assert(return_status == HighsStatus::kOk);
+         if (!this->basis.valid && !this->is_initial_basis_requested) {
+            this->set_initial_basis(problem);
+         }
+         if (this->basis.valid) {
+            return_status = this->highs_solver.setBasis(this->basis);
+            // a user basis may be rejected (e.g. wrong number of basic entries): HiGHS starts from its own basis
+            if (return_status == HighsStatus::kError) {
+               this->basis.valid = false;
+            }
+         }
+         this->is_model_loaded = true;
+         return;
+      }
+
+      // incremental modifications: HiGHS keeps the current basis
+      if (warmstart_information.objective_changed) {
+         this->highs_solver.changeColsCost(0, number_variables - 1, this->model.lp_.col_cost_.data());
+      }
+      if (warmstart_information.variable_bounds_changed) {
+         this->highs_solver.changeColsBounds(0, number_variables - 1, this->model.lp_.col_lower_.data(), this->model.lp_.col_upper_.data());
+      }
+      if (0 < number_constraints && (warmstart_information.constraint_bounds_changed || warmstart_information.constraints_changed)) {
+         this->highs_solver.changeRowsBounds(0, number_constraints - 1, this->model.lp_.row_lower_.data(), this->model.lp_.row_upper_.data());
+      }
+      if (warmstart_information.constraints_changed) {
+         // same sparsity pattern: only the modified coefficients are updated
+         size_t nonzero_index = 0;
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            for (const auto [variable_index, value]: this->constraint_jacobian[constraint_index]) {
+               if (this->model.lp_.a_matrix_.value_[nonzero_index] != value) {
+                  this->model.lp_.a_matrix_.value_[nonzero_index] = value;
+                  this->highs_solver.changeCoeff(static_cast<HighsInt>(constraint_index), static_cast<HighsInt>(variable_index), value);
+               }
+               nonzero_index++;
+            }
+         }
+      }
+      if (hessian_changed) {
+         [[maybe_unused]] const HighsStatus return_status = this->highs_solver.passHessian(this->model.hessian_);
+         assert(return_status != HighsStatus::kError);
+      }
+   }
+
    void HiGHSSolver::solve_subproblem(const OptimizationProblem& problem, Direction& direction) {
       // solve the LP
-      HighsStatus return_status = this->highs_solver.passModel(this->model);
-      assert(return_status == HighsStatus::kOk);
-
-      return_status = this->highs_solver.run(); // solve
+      HighsStatus return_status = this->highs_solver.run(); // solve
       DEBUG << "HiGHS status: " << static_cast<int>(return_status) << '\n';
 
       // if HiGHS could not optimize (e.g. because of indefinite Hessian), return an error
@@ -155,6 +433,7 @@ namespace uno {
       }
       
       direction.status = SubproblemStatus::OPTIMAL;
+      this->basis = this->highs_solver.getBasis();
       const HighsSolution& solution = this->highs_solver.getSolution();
       // read the primal solution and bound dual solution
       for (size_t variable_index = 0; variable_index < problem.number_variables; variable_index++) {
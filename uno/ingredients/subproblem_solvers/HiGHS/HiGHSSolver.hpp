@@ -1,35 +1,76 @@
 #ifndef UNO_HIGHSSOLVER_H
 #define UNO_HIGHSSOLVER_H
 
-#include "ingredients/subproblem_solvers/LPSolver.hpp"
+#include <string>
+#include "ingredients/subproblem_solvers/QPSolver.hpp"
+#include "ingredients/subproblem_solvers/SubproblemAccuracy.hpp"
 #include "Highs.h"
-#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
 #include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/Model.hpp"
 
 namespace uno {
    // forward declaration
    class Options;
 
-   class HiGHSSolver : public LPSolver {
+   // LPs are solved with the simplex method, the interior-point method or PDLP (HiGHS_LP_algorithm). QPs must be convex: the Hessian
+   // model should be convexified
+   class HiGHSSolver : public QPSolver {
    public:
       HiGHSSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros, size_t number_jacobian_nonzeros,
             size_t number_hessian_nonzeros, const Options& options);
 
+      void initialize_statistics(Statistics& statistics, const Options& options) override;
       void solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& initial_point, Direction& direction,
             double trust_region_radius, const WarmstartInformation& warmstart_information) override;
 
+      void solve_QP(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& current_multipliers,
+            const Vector<double>& initial_point, Direction& direction, HessianModel& hessian_model, double trust_region_radius,
+            const WarmstartInformation& warmstart_information) override;
+
+      [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      void report_memory(MemoryReport& report) const override;
+
    protected:
       HighsModel model;
       Highs highs_solver;
 
       std::vector<double> constraints;
       SparseVector<double> linear_objective;
-      RectangularMatrix<double> constraint_jacobian;
+      RectangularMatrixView<double> constraint_jacobian; /*!< view of the Jacobian of the current iterate */
+      SymmetricMatrix<size_t, double> hessian;
+      std::vector<HighsInt> current_hessian_indices{};
 
       const bool print_subproblem;
+      // the model is loaded into HiGHS once, then modified incrementally: HiGHS keeps the simplex basis across the modifications
+      bool is_model_loaded{false};
+      // basis of the last solve, restored after a model is passed again with the same dimensions
+      HighsBasis basis;
+      // the basis provided by the user (if any) is used at the first solve only
+      bool is_initial_basis_requested{false};
+      // LP algorithm (simplex, ipm or pdlp), chosen from the size of the problem if HiGHS_LP_algorithm is "auto"
+      const std::string LP_algorithm;
+      // the tolerances of the interior-point method and PDLP follow the KKT error of the outer iterate
+      const double adaptive_tolerance_factor;
+      const double minimum_tolerance;
+      const double maximum_tolerance;
+      // the feasibility tolerances of the simplex method and the QP solver follow the accuracy schedule (subproblem_accuracy)
+      const SubproblemAccuracy accuracy;
+      static constexpr double default_feasibility_tolerance{1e-7};
+
+      [[nodiscard]] static std::string choose_LP_algorithm(size_t number_variables, size_t number_jacobian_nonzeros, const Options& options);
+      void set_LP_tolerances(const Iterate& current_iterate);
+      void set_feasibility_tolerances(const Iterate& current_iterate);
 
       void set_up_subproblem(const OptimizationProblem& problem, Iterate& current_iterate, double trust_region_radius,
-            const WarmstartInformation& warmstart_information);
+            const WarmstartInformation& warmstart_information, bool hessian_changed);
+      void assemble_constraint_matrix(size_t number_constraints);
+      [[nodiscard]] bool has_same_jacobian_sparsity(size_t number_constraints) const;
+      void set_initial_basis(const OptimizationProblem& problem);
+      [[nodiscard]] static HighsBasisStatus to_highs_status(BasisStatus status);
+      void save_hessian_to_local_format();
+      void load_model(const OptimizationProblem& problem, const WarmstartInformation& warmstart_information, bool hessian_changed);
       void solve_subproblem(const OptimizationProblem& problem, Direction& direction);
    };
 } // namespace
@@ -0,0 +1,564 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include "InteriorPointQPSolver.hpp"
+#include "SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "ingredients/hessian_models/HessianModel.hpp"
+#include "ingredients/hessian_models/UnstableRegularization.hpp"
+#include "linear_algebra/Norm.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "symbolic/VectorView.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+#include "tools/MemoryReport.hpp"
+
+namespace uno {
+   InteriorPointQPSolver::InteriorPointQPSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
+         size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options):
+         QPSolver(),
+         lower_bounds(number_variables + number_constraints),
+         upper_bounds(number_variables + number_constraints),
+         constraints(number_constraints),
+         linear_objective(number_objective_gradient_nonzeros),
+         // the Hessian is convexified (see QPSubproblem)
+         hessian(number_variables, number_hessian_nonzeros, true, "COO"),
+         zero_hessian(number_variables, 0, false, "COO"),
+         slack_of_constraint(number_constraints, InteriorPointQPSolver::no_slack),
+         // one slack per inequality constraint
+         extended_jacobian(number_constraints, number_variables + number_constraints),
+         primals_lower_bounds(number_variables + number_constraints),
+         primals_upper_bounds(number_variables + number_constraints),
+         constraint_rhs(number_constraints),
+         primals(number_variables + number_constraints),
+         lower_bound_multipliers(number_variables + number_constraints),
+         upper_bound_multipliers(number_variables + number_constraints),
+         constraint_multipliers(number_constraints),
+         dual_residuals(number_variables + number_constraints),
+         primal_residuals(number_constraints),
+         barrier_diagonal(number_variables + number_constraints),
+         primal_direction(number_variables + number_constraints),
+         lower_bound_multipliers_direction(number_variables + number_constraints),
+         upper_bound_multipliers_direction(number_variables + number_constraints),
+         constraint_multipliers_direction(number_constraints),
+         affine_primal_direction(number_variables + number_constraints),
+         affine_lower_bound_multipliers_direction(number_variables + number_constraints),
+         affine_upper_bound_multipliers_direction(number_variables + number_constraints),
+         // the augmented matrix is assembled block by block (the SQP presets use the CSC format for the Hessian)
+         augmented_system("COO", number_variables + 2 * number_constraints,
+               number_hessian_nonzeros
+               + number_variables + number_constraints /* diagonal barrier terms */
+               + number_jacobian_nonzeros + number_constraints /* Jacobian and slacks */,
+               true, /* use regularization */
+               options, 1 /* Fortran indices */),
+         linear_solver(SymmetricIndefiniteLinearSolverFactory::create<int>(number_variables + 2 * number_constraints,
+               number_hessian_nonzeros
+               + number_variables + 2 * number_constraints /* regularization */
+               + number_variables + number_constraints /* diagonal barrier terms */
+               + number_jacobian_nonzeros + number_constraints, /* Jacobian and slacks */
+               options)),
+         inner_statistics(options),
+         tolerance(options.get_double("InteriorPointQP_tolerance")),
+         maximum_number_iterations(options.get_unsigned_int("InteriorPointQP_max_iterations")),
+         accuracy(options),
+         solve_tolerance(this->tolerance),
+         solve_iteration_limit(this->maximum_number_iterations),
+         tau_min(options.get_double("barrier_tau_min")),
+         regularization_exponent(options.get_double("barrier_regularization_exponent")),
+         push_variable_to_interior_k1(options.get_double("barrier_push_variable_to_interior_k1")),
+         push_variable_to_interior_k2(options.get_double("barrier_push_variable_to_interior_k2")),
+         default_multiplier(options.get_double("barrier_default_multiplier")),
+         print_subproblem(options.get_bool("print_subproblem")) {
+   }
+
+   void InteriorPointQPSolver::initialize_statistics(Statistics& statistics, const Options& options) {
+      statistics.add_column("QP iter", Statistics::int_width, options.get_int("statistics_subproblem_iterations_column_order"));
+   }
+
+   void InteriorPointQPSolver::solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& /*initial_point*/,
+         Direction& direction, double trust_region_radius, const WarmstartInformation& warmstart_information) {
+      if (this->print_subproblem) {
+         DEBUG << "LP:\n";
+      }
+      this->set_up_subproblem(problem, current_iterate, trust_region_radius, warmstart_information);
+      if (!this->is_LP) {
+         // the Hessian block of the augmented matrix is dropped
+         this->augmented_system_warmstart_information.hessian_sparsity_changed = true;
+         this->is_LP = true;
+      }
+      this->set_up_primal_dual_problem(problem, warmstart_information);
+      this->set_accuracy(current_iterate);
+      this->solve_subproblem(problem, direction);
+   }
+
+   void InteriorPointQPSolver::solve_QP(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Vector<double>& current_multipliers, const Vector<double>& /*initial_point*/, Direction& direction, HessianModel& hessian_model,
+         double trust_region_radius, const WarmstartInformation& warmstart_information) {
+      if (this->print_subproblem) {
+         DEBUG << "QP:\n";
+      }
+      this->set_up_subproblem(problem, current_iterate, trust_region_radius, warmstart_information);
+      if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
+         hessian_model.evaluate(statistics, problem, current_iterate.primals, current_multipliers, this->hessian);
+      }
+      if (this->is_LP) {
+         this->augmented_system_warmstart_information.hessian_sparsity_changed = true;
+         this->is_LP = false;
+      }
+      DEBUG << "Hessian: " << this->hessian;
+      this->set_up_primal_dual_problem(problem, warmstart_information);
+      this->set_accuracy(current_iterate);
+      this->solve_subproblem(problem, direction);
+      statistics.set("QP iter", this->number_iterations);
+   }
+
+   double InteriorPointQPSolver::hessian_quadratic_product(const Vector<double>& primal_direction) const {
+      return this->hessian.quadratic_product(primal_direction, primal_direction);
+   }
+
+   FactorizationStatistics InteriorPointQPSolver::get_factorization_statistics() const {
+      return this->linear_solver->get_factorization_statistics();
+   }
+
+   void InteriorPointQPSolver::report_memory(MemoryReport& report) const {
+      report.add("QP solver/bounds", this->lower_bounds.memory_size() + this->upper_bounds.memory_size());
+      report.add("QP solver/constraints", MemoryReport::memory_size(this->constraints));
+      report.add("QP solver/objective gradient", this->linear_objective.memory_size());
+      report.add("QP solver/extended Jacobian", this->extended_jacobian.memory_size());
+      report.add("QP solver/Hessian", this->hessian.memory_size() + this->zero_hessian.memory_size());
+      size_t primal_dual_size = MemoryReport::memory_size(this->slack_of_constraint);
+      for (const Vector<double>* vector: {&this->primals_lower_bounds, &this->primals_upper_bounds, &this->constraint_rhs, &this->primals,
+            &this->lower_bound_multipliers, &this->upper_bound_multipliers, &this->constraint_multipliers, &this->dual_residuals,
+            &this->primal_residuals, &this->barrier_diagonal, &this->primal_direction, &this->lower_bound_multipliers_direction,
+            &this->upper_bound_multipliers_direction, &this->constraint_multipliers_direction, &this->affine_primal_direction,
+            &this->affine_lower_bound_multipliers_direction, &this->affine_upper_bound_multipliers_direction}) {
+         primal_dual_size += vector->memory_size();
+      }
+      report.add("QP solver/primal-dual vectors", primal_dual_size);
+      report.add("QP solver/augmented system", this->augmented_system.memory_size());
+      report.add("QP solver/linear solver", this->linear_solver->memory_size());
+   }
+
+   void InteriorPointQPSolver::set_up_subproblem(const OptimizationProblem& problem, Iterate& current_iterate, double trust_region_radius,
+         const WarmstartInformation& warmstart_information) {
+      // function evaluations
+      if (warmstart_information.objective_changed) {
+         problem.evaluate_objective_gradient(current_iterate, this->linear_objective);
+      }
+      if (warmstart_information.constraints_changed) {
+         problem.evaluate_constraints(current_iterate, this->constraints);
+         problem.evaluate_constraint_jacobian(current_iterate, this->constraint_jacobian);
+      }
+
+      // variable bounds
+      if (warmstart_information.variable_bounds_changed) {
+         // bounds of original variables intersected with trust region
+         for (size_t variable_index: Range(problem.get_number_original_variables())) {
+            this->lower_bounds[variable_index] = std::max(-trust_region_radius,
+                  problem.variable_lower_bound(variable_index) - current_iterate.primals[variable_index]);
+            this->upper_bounds[variable_index] = std::min(trust_region_radius,
+                  problem.variable_upper_bound(variable_index) - current_iterate.primals[variable_index]);
+         }
+         // bounds of additional variables (no trust region!)
+         for (size_t variable_index: Range(problem.get_number_original_variables(), problem.number_variables)) {
+            this->lower_bounds[variable_index] = problem.variable_lower_bound(variable_index) - current_iterate.primals[variable_index];
+            this->upper_bounds[variable_index] = problem.variable_upper_bound(variable_index) - current_iterate.primals[variable_index];
+         }
+      }
+
+      // constraint bounds
+      if (warmstart_information.constraint_bounds_changed || warmstart_information.constraints_changed) {
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            this->lower_bounds[problem.number_variables + constraint_index] = problem.constraint_lower_bound(constraint_index) -
+                  this->constraints[constraint_index];
+            this->upper_bounds[problem.number_variables + constraint_index] = problem.constraint_upper_bound(constraint_index) -
+                  this->constraints[constraint_index];
+         }
+      }
+
+      if (this->print_subproblem) {
+         DEBUG << "objective gradient: " << this->linear_objective;
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            DEBUG << "gradient c" << constraint_index << ": " << this->constraint_jacobian[constraint_index];
+         }
+         for (size_t variable_index: Range(problem.number_variables)) {
+            DEBUG << "d" << variable_index << " in [" << this->lower_bounds[variable_index] << ", " << this->upper_bounds[variable_index] << "]\n";
+         }
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            DEBUG << "linearized c" << constraint_index << " in [" << this->lower_bounds[problem.number_variables + constraint_index] << ", " <<
+                  this->upper_bounds[problem.number_variables + constraint_index] << "]\n";
+         }
+      }
+   }
+
+   // append the slacks of the inequality constraints: l <= a^T d <= u becomes a^T d - s = 0, l <= s <= u
+   void InteriorPointQPSolver::set_up_primal_dual_problem(const OptimizationProblem& problem, const WarmstartInformation& warmstart_information) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints = problem.number_constraints;
+      bool structure_changed = warmstart_information.hessian_sparsity_changed || warmstart_information.jacobian_sparsity_changed;
+      size_t number_primals = number_variables;
+      for (size_t constraint_index: Range(number_constraints)) {
+         const double lower_bound = this->lower_bounds[number_variables + constraint_index];
+         const double upper_bound = this->upper_bounds[number_variables + constraint_index];
+         const size_t slack_index = (lower_bound == upper_bound) ? InteriorPointQPSolver::no_slack : number_primals++;
+         structure_changed = structure_changed || (this->slack_of_constraint[constraint_index] != slack_index);
+         this->slack_of_constraint[constraint_index] = slack_index;
+         this->constraint_rhs[constraint_index] = (slack_index == InteriorPointQPSolver::no_slack) ? lower_bound : 0.;
+      }
+      structure_changed = structure_changed || (this->number_primals != number_primals);
+      this->number_primals = number_primals;
+      if (structure_changed) {
+         this->augmented_system_warmstart_information.hessian_sparsity_changed = true;
+         this->augmented_system_warmstart_information.jacobian_sparsity_changed = true;
+      }
+
+      // bounds of the primal variables
+      for (size_t variable_index: Range(number_variables)) {
+         this->primals_lower_bounds[variable_index] = this->lower_bounds[variable_index];
+         this->primals_upper_bounds[variable_index] = this->upper_bounds[variable_index];
+      }
+      // extended Jacobian [J -I]
+      this->extended_jacobian.clear();
+      for (size_t constraint_index: Range(number_constraints)) {
+         for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
+            this->extended_jacobian[constraint_index].insert(variable_index, derivative);
+         }
+         const size_t slack_index = this->slack_of_constraint[constraint_index];
+         if (slack_index != InteriorPointQPSolver::no_slack) {
+            this->extended_jacobian[constraint_index].insert(slack_index, -1.);
+            this->primals_lower_bounds[slack_index] = this->lower_bounds[number_variables + constraint_index];
+            this->primals_upper_bounds[slack_index] = this->upper_bounds[number_variables + constraint_index];
+         }
+      }
+   }
+
+   // inexact solves far from a KKT point
+   void InteriorPointQPSolver::set_accuracy(const Iterate& current_iterate) {
+      this->solve_tolerance = this->accuracy.tolerance(current_iterate, this->tolerance);
+      this->solve_iteration_limit = this->accuracy.iteration_limit(this->solve_tolerance, this->tolerance, this->maximum_number_iterations);
+      DEBUG << "IPM QP: tolerance " << this->solve_tolerance << ", at most " << this->solve_iteration_limit << " iterations\n";
+   }
+
+   void InteriorPointQPSolver::solve_subproblem(const OptimizationProblem& problem, Direction& direction) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints = problem.number_constraints;
+      const SymmetricMatrix<size_t, double>& subproblem_hessian = this->is_LP ? this->zero_hessian : this->hessian;
+      this->initialize_primal_dual_point(number_variables, number_constraints);
+
+      // scaled termination tolerances
+      const double dual_tolerance = this->solve_tolerance * std::max(1., norm_inf(this->linear_objective));
+      const double primal_tolerance = this->solve_tolerance * std::max(1., norm_inf(view(this->constraint_rhs, 0, number_constraints)));
+      double primal_residual_norm = INF<double>;
+      direction.status = SubproblemStatus::ERROR;
+      this->number_iterations = 0;
+      try {
+         while (this->number_iterations < this->solve_iteration_limit) {
+            const double complementarity = this->compute_residuals(number_constraints);
+            primal_residual_norm = norm_inf(view(this->primal_residuals, 0, number_constraints));
+            const double dual_residual_norm = norm_inf(view(this->dual_residuals, 0, this->number_primals));
+            DEBUG2 << "IPM QP iteration " << this->number_iterations << ": primal residual " << primal_residual_norm << ", dual residual " <<
+                  dual_residual_norm << ", complementarity " << complementarity << '\n';
+            if (primal_residual_norm <= primal_tolerance && dual_residual_norm <= dual_tolerance && complementarity <= this->solve_tolerance) {
+               direction.status = SubproblemStatus::OPTIMAL;
+               break;
+            }
+            this->number_iterations++;
+
+            // assemble the augmented matrix at the first iteration, then only update the barrier terms
+            this->compute_barrier_diagonal();
+            this->augmented_system.set_primal_diagonal(this->barrier_diagonal, this->number_primals);
+            if (1 < this->number_iterations && this->augmented_system.can_update_primal_diagonal(this->number_primals, number_constraints)) {
+               this->augmented_system.update_primal_diagonal();
+            }
+            else {
+               this->augmented_system.assemble_matrix(subproblem_hessian, this->extended_jacobian, this->number_primals, number_constraints,
+                     this->augmented_system_warmstart_information);
+            }
+            const double dual_regularization_parameter = std::pow(complementarity, this->regularization_exponent);
+            this->augmented_system.factorize_and_regularize_matrix(this->inner_statistics, *this->linear_solver, this->number_primals,
+                  number_constraints, dual_regularization_parameter, this->augmented_system_warmstart_information);
+
+            // predictor (affine scaling) step
+            this->compute_direction(number_constraints, 0., false);
+            const auto [affine_primal_step_length, affine_dual_step_length] = this->compute_step_lengths(1.);
+            // Mehrotra's centering parameter
+            const double affine_complementarity = this->complementarity_after_step(affine_primal_step_length, affine_dual_step_length);
+            const double centering_parameter = (0. < complementarity) ? std::min(1., std::pow(affine_complementarity / complementarity, 3)) : 0.;
+            for (size_t variable_index: Range(this->number_primals)) {
+               this->affine_primal_direction[variable_index] = this->primal_direction[variable_index];
+               this->affine_lower_bound_multipliers_direction[variable_index] = this->lower_bound_multipliers_direction[variable_index];
+               this->affine_upper_bound_multipliers_direction[variable_index] = this->upper_bound_multipliers_direction[variable_index];
+            }
+
+            // corrector step with the same factorization
+            this->compute_direction(number_constraints, centering_parameter * complementarity, true);
+            const double tau = std::max(this->tau_min, 1. - complementarity);
+            const auto [primal_step_length, dual_step_length] = this->compute_step_lengths(tau);
+            // common step length: the dual residual of a QP mixes the primal and dual variables
+            const double step_length = std::min(primal_step_length, dual_step_length);
+            for (size_t variable_index: Range(this->number_primals)) {
+               this->primals[variable_index] += step_length * this->primal_direction[variable_index];
+               this->lower_bound_multipliers[variable_index] += step_length * this->lower_bound_multipliers_direction[variable_index];
+               this->upper_bound_multipliers[variable_index] += step_length * this->upper_bound_multipliers_direction[variable_index];
+            }
+            for (size_t constraint_index: Range(number_constraints)) {
+               this->constraint_multipliers[constraint_index] += step_length * this->constraint_multipliers_direction[constraint_index];
+            }
+         }
+      }
+      catch (const UnstableRegularization&) {
+         // typically, the multipliers diverge when the linearized constraints are infeasible
+         DEBUG << "IPM QP: the augmented matrix could not be regularized\n";
+      }
+      DEBUG << "IPM QP: " << this->number_iterations << " iterations\n";
+      // the iteration limit of an inexact solve was reached: a primal feasible point is an acceptable (inexact) solution
+      if (direction.status == SubproblemStatus::ERROR && this->number_iterations == this->solve_iteration_limit &&
+            this->solve_iteration_limit < this->maximum_number_iterations) {
+         [[maybe_unused]] const double complementarity = this->compute_residuals(number_constraints);
+         primal_residual_norm = norm_inf(view(this->primal_residuals, 0, number_constraints));
+         if (primal_residual_norm <= primal_tolerance) {
+            DEBUG << "IPM QP: inexact solution\n";
+            direction.status = SubproblemStatus::OPTIMAL;
+         }
+      }
+      if (direction.status != SubproblemStatus::OPTIMAL) {
+         // the iterates did not converge: a large primal residual indicates infeasible linearized constraints
+         direction.status = (primal_tolerance < primal_residual_norm) ? SubproblemStatus::INFEASIBLE : SubproblemStatus::ERROR;
+         return;
+      }
+
+      // project the solution into the bounds
+      for (size_t variable_index: Range(number_variables)) {
+         direction.primals[variable_index] = std::min(std::max(this->primals[variable_index], this->lower_bounds[variable_index]),
+               this->upper_bounds[variable_index]);
+      }
+      this->set_multipliers(number_variables, number_constraints, direction.multipliers);
+      direction.subproblem_objective = this->evaluate_subproblem_objective(direction.primals);
+   }
+
+   // starting point pushed into the interior of the bounds, unit bound multipliers
+   void InteriorPointQPSolver::initialize_primal_dual_point(size_t number_variables, size_t number_constraints) {
+      for (size_t variable_index: Range(number_variables)) {
+         this->primals[variable_index] = this->push_into_interior(0., this->primals_lower_bounds[variable_index],
+               this->primals_upper_bounds[variable_index]);
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         const size_t slack_index = this->slack_of_constraint[constraint_index];
+         if (slack_index != InteriorPointQPSolver::no_slack) {
+            double constraint_value = 0.;
+            for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
+               constraint_value += derivative * this->primals[variable_index];
+            }
+            this->primals[slack_index] = this->push_into_interior(constraint_value, this->primals_lower_bounds[slack_index],
+                  this->primals_upper_bounds[slack_index]);
+         }
+         this->constraint_multipliers[constraint_index] = 0.;
+      }
+      for (size_t variable_index: Range(this->number_primals)) {
+         this->lower_bound_multipliers[variable_index] = is_finite(this->primals_lower_bounds[variable_index]) ? this->default_multiplier : 0.;
+         this->upper_bound_multipliers[variable_index] = is_finite(this->primals_upper_bounds[variable_index]) ? -this->default_multiplier : 0.;
+      }
+   }
+
+   // same perturbations as the barrier method
+   double InteriorPointQPSolver::push_into_interior(double value, double lower_bound, double upper_bound) const {
+      const double range = upper_bound - lower_bound;
+      if (is_finite(lower_bound)) {
+         const double perturbation = std::min(this->push_variable_to_interior_k1 * std::max(1., std::abs(lower_bound)),
+               this->push_variable_to_interior_k2 * range);
+         value = std::max(value, lower_bound + perturbation);
+      }
+      if (is_finite(upper_bound)) {
+         const double perturbation = std::min(this->push_variable_to_interior_k1 * std::max(1., std::abs(upper_bound)),
+               this->push_variable_to_interior_k2 * range);
+         value = std::min(value, upper_bound - perturbation);
+      }
+      return value;
+   }
+
+   // dual residuals g + H d - A^T y - z_L - z_U and primal residuals A x - b. Returns the average complementarity
+   double InteriorPointQPSolver::compute_residuals(size_t number_constraints) {
+      this->dual_residuals.fill(0.);
+      for (const auto [variable_index, derivative]: this->linear_objective) {
+         this->dual_residuals[variable_index] = derivative;
+      }
+      if (!this->is_LP) {
+         this->hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+            this->dual_residuals[row_index] += element * this->primals[column_index];
+            if (row_index != column_index) {
+               this->dual_residuals[column_index] += element * this->primals[row_index];
+            }
+         });
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         double constraint_value = 0.;
+         for (const auto [variable_index, derivative]: this->extended_jacobian[constraint_index]) {
+            this->dual_residuals[variable_index] -= this->constraint_multipliers[constraint_index] * derivative;
+            constraint_value += derivative * this->primals[variable_index];
+         }
+         this->primal_residuals[constraint_index] = constraint_value - this->constraint_rhs[constraint_index];
+      }
+      double complementarity = 0.;
+      for (size_t variable_index: Range(this->number_primals)) {
+         this->dual_residuals[variable_index] -= this->lower_bound_multipliers[variable_index] + this->upper_bound_multipliers[variable_index];
+         if (is_finite(this->primals_lower_bounds[variable_index])) {
+            complementarity += this->lower_bound_multipliers[variable_index] *
+                  (this->primals[variable_index] - this->primals_lower_bounds[variable_index]);
+         }
+         if (is_finite(this->primals_upper_bounds[variable_index])) {
+            complementarity += this->upper_bound_multipliers[variable_index] *
+                  (this->primals[variable_index] - this->primals_upper_bounds[variable_index]);
+         }
+      }
+      const size_t number_bounds = this->number_bounds();
+      return (0 < number_bounds) ? complementarity / static_cast<double>(number_bounds) : 0.;
+   }
+
+   // Sigma = Z_L (X - L)^{-1} + Z_U (X - U)^{-1}
+   void InteriorPointQPSolver::compute_barrier_diagonal() {
+      for (size_t variable_index: Range(this->number_primals)) {
+         this->barrier_diagonal[variable_index] = 0.;
+         if (is_finite(this->primals_lower_bounds[variable_index])) {
+            this->barrier_diagonal[variable_index] += this->lower_bound_multipliers[variable_index] /
+                  (this->primals[variable_index] - this->primals_lower_bounds[variable_index]);
+         }
+         if (is_finite(this->primals_upper_bounds[variable_index])) {
+            this->barrier_diagonal[variable_index] += this->upper_bound_multipliers[variable_index] /
+                  (this->primals[variable_index] - this->primals_upper_bounds[variable_index]);
+         }
+      }
+   }
+
+   // solve the augmented system with the complementarity target mu. The corrector step includes the second-order terms of the predictor
+   // step (stored in the affine directions)
+   void InteriorPointQPSolver::compute_direction(size_t number_constraints, double target_complementarity, bool corrector) {
+      // rhs: -(g + H d - A^T y) + (mu - corrections) (X - L)^{-1} + (mu - corrections) (X - U)^{-1}
+      for (size_t variable_index: Range(this->number_primals)) {
+         double rhs = -(this->dual_residuals[variable_index] + this->lower_bound_multipliers[variable_index] +
+               this->upper_bound_multipliers[variable_index]);
+         if (is_finite(this->primals_lower_bounds[variable_index])) {
+            const double correction = corrector ? this->affine_primal_direction[variable_index] *
+                  this->affine_lower_bound_multipliers_direction[variable_index] : 0.;
+            rhs += (target_complementarity - correction) / (this->primals[variable_index] - this->primals_lower_bounds[variable_index]);
+         }
+         if (is_finite(this->primals_upper_bounds[variable_index])) {
+            const double correction = corrector ? this->affine_primal_direction[variable_index] *
+                  this->affine_upper_bound_multipliers_direction[variable_index] : 0.;
+            rhs += (target_complementarity - correction) / (this->primals[variable_index] - this->primals_upper_bounds[variable_index]);
+         }
+         this->augmented_system.rhs[variable_index] = rhs;
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         this->augmented_system.rhs[this->number_primals + constraint_index] = -this->primal_residuals[constraint_index];
+      }
+      this->augmented_system.solve(*this->linear_solver);
+
+      // primal and constraint dual directions (note the minus sign)
+      for (size_t variable_index: Range(this->number_primals)) {
+         this->primal_direction[variable_index] = this->augmented_system.solution[variable_index];
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         this->constraint_multipliers_direction[constraint_index] = -this->augmented_system.solution[this->number_primals + constraint_index];
+      }
+      // bound dual directions from the linearized complementarity
+      for (size_t variable_index: Range(this->number_primals)) {
+         this->lower_bound_multipliers_direction[variable_index] = 0.;
+         this->upper_bound_multipliers_direction[variable_index] = 0.;
+         if (is_finite(this->primals_lower_bounds[variable_index])) {
+            const double distance = this->primals[variable_index] - this->primals_lower_bounds[variable_index];
+            const double correction = corrector ? this->affine_primal_direction[variable_index] *
+                  this->affine_lower_bound_multipliers_direction[variable_index] : 0.;
+            this->lower_bound_multipliers_direction[variable_index] = (target_complementarity - correction) / distance -
+                  this->lower_bound_multipliers[variable_index] * (1. + this->primal_direction[variable_index] / distance);
+         }
+         if (is_finite(this->primals_upper_bounds[variable_index])) {
+            const double distance = this->primals[variable_index] - this->primals_upper_bounds[variable_index];
+            const double correction = corrector ? this->affine_primal_direction[variable_index] *
+                  this->affine_upper_bound_multipliers_direction[variable_index] : 0.;
+            this->upper_bound_multipliers_direction[variable_index] = (target_complementarity - correction) / distance -
+                  this->upper_bound_multipliers[variable_index] * (1. + this->primal_direction[variable_index] / distance);
+         }
+      }
+   }
+
+   // fraction-to-boundary rule for the primal variables and the bound multipliers
+   std::pair<double, double> InteriorPointQPSolver::compute_step_lengths(double tau) const {
+      double primal_step_length = 1.;
+      double dual_step_length = 1.;
+      for (size_t variable_index: Range(this->number_primals)) {
+         const double direction = this->primal_direction[variable_index];
+         if (is_finite(this->primals_lower_bounds[variable_index])) {
+            if (direction < 0.) {
+               const double distance = this->primals[variable_index] - this->primals_lower_bounds[variable_index];
+               primal_step_length = std::min(primal_step_length, -tau * distance / direction);
+            }
+            if (this->lower_bound_multipliers_direction[variable_index] < 0.) {
+               dual_step_length = std::min(dual_step_length, -tau * this->lower_bound_multipliers[variable_index] /
+                     this->lower_bound_multipliers_direction[variable_index]);
+            }
+         }
+         if (is_finite(this->primals_upper_bounds[variable_index])) {
+            if (0. < direction) {
+               const double distance = this->primals[variable_index] - this->primals_upper_bounds[variable_index];
+               primal_step_length = std::min(primal_step_length, -tau * distance / direction);
+            }
+            if (0. < this->upper_bound_multipliers_direction[variable_index]) {
+               dual_step_length = std::min(dual_step_length, -tau * this->upper_bound_multipliers[variable_index] /
+                     this->upper_bound_multipliers_direction[variable_index]);
+            }
+         }
+      }
+      return {primal_step_length, dual_step_length};
+   }
+
+   double InteriorPointQPSolver::complementarity_after_step(double primal_step_length, double dual_step_length) const {
+      double complementarity = 0.;
+      for (size_t variable_index: Range(this->number_primals)) {
+         const double trial_primal = this->primals[variable_index] + primal_step_length * this->primal_direction[variable_index];
+         if (is_finite(this->primals_lower_bounds[variable_index])) {
+            complementarity += (trial_primal - this->primals_lower_bounds[variable_index]) * (this->lower_bound_multipliers[variable_index] +
+                  dual_step_length * this->lower_bound_multipliers_direction[variable_index]);
+         }
+         if (is_finite(this->primals_upper_bounds[variable_index])) {
+            complementarity += (trial_primal - this->primals_upper_bounds[variable_index]) * (this->upper_bound_multipliers[variable_index] +
+                  dual_step_length * this->upper_bound_multipliers_direction[variable_index]);
+         }
+      }
+      const size_t number_bounds = this->number_bounds();
+      return (0 < number_bounds) ? complementarity / static_cast<double>(number_bounds) : 0.;
+   }
+
+   size_t InteriorPointQPSolver::number_bounds() const {
+      size_t number_bounds = 0;
+      for (size_t variable_index: Range(this->number_primals)) {
+         number_bounds += (is_finite(this->primals_lower_bounds[variable_index]) ? 1 : 0) +
+               (is_finite(this->primals_upper_bounds[variable_index]) ? 1 : 0);
+      }
+      return number_bounds;
+   }
+
+   // the multiplier of an inequality constraint is that of the active bound of its slack
+   void InteriorPointQPSolver::set_multipliers(size_t number_variables, size_t number_constraints, Multipliers& direction_multipliers) const {
+      direction_multipliers.reset();
+      for (size_t constraint_index: Range(number_constraints)) {
+         direction_multipliers.constraints[constraint_index] = this->constraint_multipliers[constraint_index];
+      }
+      for (size_t variable_index: Range(number_variables)) {
+         direction_multipliers.lower_bounds[variable_index] = this->lower_bound_multipliers[variable_index];
+         direction_multipliers.upper_bounds[variable_index] = this->upper_bound_multipliers[variable_index];
+      }
+   }
+
+   // g^T d + 1/2 d^T H d
+   double InteriorPointQPSolver::evaluate_subproblem_objective(const Vector<double>& primal_direction) const {
+      double objective = this->is_LP ? 0. : 0.5 * this->hessian_quadratic_product(primal_direction);
+      for (const auto [variable_index, derivative]: this->linear_objective) {
+         objective += derivative * primal_direction[variable_index];
+      }
+      return objective;
+   }
+} // namespace
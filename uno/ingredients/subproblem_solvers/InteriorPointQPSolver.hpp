@@ -0,0 +1,115 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_INTERIORPOINTQPSOLVER_H
+#define UNO_INTERIORPOINTQPSOLVER_H
+
+#include <limits>
+#include <memory>
+#include <vector>
+#include "QPSolver.hpp"
+#include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "SubproblemAccuracy.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "tools/Statistics.hpp"
+
+namespace uno {
+   // forward declarations
+   class Multipliers;
+   class Options;
+
+   /*! \class InteriorPointQPSolver
+    * \brief Sparse primal-dual interior-point QP solver (Mehrotra predictor-corrector)
+    *
+    *  The inequality constraints l <= a^T d <= u are reformulated with slacks a^T d - s = 0, l <= s <= u. The augmented systems
+    *  [H + Sigma  A^T; A  0] are assembled, factorized and regularized by a SymmetricIndefiniteLinearSystem with the linear solver
+    *  given by the option linear_solver: the predictor and the corrector steps share the same factorization, and only the barrier
+    *  terms Sigma of the matrix are updated between the iterations. The Hessian is expected to be convex
+    */
+   class InteriorPointQPSolver : public QPSolver {
+   public:
+      InteriorPointQPSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
+            size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options);
+
+      void initialize_statistics(Statistics& statistics, const Options& options) override;
+
+      void solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& initial_point, Direction& direction,
+            double trust_region_radius, const WarmstartInformation& warmstart_information) override;
+
+      void solve_QP(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& current_multipliers,
+            const Vector<double>& initial_point, Direction& direction, HessianModel& hessian_model, double trust_region_radius,
+            const WarmstartInformation& warmstart_information) override;
+
+      [[nodiscard]] double hessian_quadratic_product(const Vector<double>& primal_direction) const override;
+      void report_memory(MemoryReport& report) const override;
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const override;
+
+   protected:
+      Vector<double> lower_bounds{}; // lower bounds of the variables and constraints
+      Vector<double> upper_bounds{}; // upper bounds of the variables and constraints
+      std::vector<double> constraints;
+      SparseVector<double> linear_objective;
+      RectangularMatrixView<double> constraint_jacobian; /*!< view of the Jacobian of the current iterate */
+      SymmetricMatrix<size_t, double> hessian;
+      const SymmetricMatrix<size_t, double> zero_hessian; // Hessian of the LPs
+      bool is_LP{false};
+
+      // primal-dual problem: the variables x = (d, s) are the original variables followed by the slacks of the inequality constraints
+      static constexpr size_t no_slack{std::numeric_limits<size_t>::max()};
+      std::vector<size_t> slack_of_constraint; // index of the slack of each constraint in x (no_slack for equality constraints)
+      size_t number_primals{0};
+      RectangularMatrix<double> extended_jacobian; // [J -I] (the columns of the equality constraints are omitted)
+      Vector<double> primals_lower_bounds, primals_upper_bounds, constraint_rhs;
+      Vector<double> primals, lower_bound_multipliers, upper_bound_multipliers, constraint_multipliers;
+      Vector<double> dual_residuals, primal_residuals;
+      Vector<double> barrier_diagonal;
+      // predictor (affine) and corrector directions
+      Vector<double> primal_direction, lower_bound_multipliers_direction, upper_bound_multipliers_direction, constraint_multipliers_direction;
+      Vector<double> affine_primal_direction, affine_lower_bound_multipliers_direction, affine_upper_bound_multipliers_direction;
+
+      SymmetricIndefiniteLinearSystem<int, double> augmented_system;
+      const std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<int, double>> linear_solver;
+      // the structure of the augmented matrix changed since its last symbolic analysis
+      WarmstartInformation augmented_system_warmstart_information{};
+      // the regularizations and factorization counts of the inner iterations are not reported in the log
+      Statistics inner_statistics;
+      size_t number_iterations{0};
+
+      const double tolerance;
+      const size_t maximum_number_iterations;
+      // tolerance and iteration limit of the current solve (adaptive accuracy)
+      const SubproblemAccuracy accuracy;
+      double solve_tolerance;
+      size_t solve_iteration_limit;
+      const double tau_min;
+      const double regularization_exponent;
+      const double push_variable_to_interior_k1;
+      const double push_variable_to_interior_k2;
+      const double default_multiplier;
+      const bool print_subproblem;
+
+      void set_up_subproblem(const OptimizationProblem& problem, Iterate& current_iterate, double trust_region_radius,
+            const WarmstartInformation& warmstart_information);
+      void set_accuracy(const Iterate& current_iterate);
+      void set_up_primal_dual_problem(const OptimizationProblem& problem, const WarmstartInformation& warmstart_information);
+      void solve_subproblem(const OptimizationProblem& problem, Direction& direction);
+      void initialize_primal_dual_point(size_t number_variables, size_t number_constraints);
+      [[nodiscard]] double push_into_interior(double value, double lower_bound, double upper_bound) const;
+      [[nodiscard]] double compute_residuals(size_t number_constraints);
+      void compute_barrier_diagonal();
+      void compute_direction(size_t number_constraints, double target_complementarity, bool corrector);
+      [[nodiscard]] std::pair<double, double> compute_step_lengths(double tau) const;
+      [[nodiscard]] double complementarity_after_step(double primal_step_length, double dual_step_length) const;
+      [[nodiscard]] size_t number_bounds() const;
+      void set_multipliers(size_t number_variables, size_t number_constraints, Multipliers& direction_multipliers) const;
+      [[nodiscard]] double evaluate_subproblem_objective(const Vector<double>& primal_direction) const;
+   };
+} // namespace
+
+#endif // UNO_INTERIORPOINTQPSOLVER_H
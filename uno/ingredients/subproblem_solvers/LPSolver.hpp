@@ -4,12 +4,15 @@
 #ifndef UNO_LPSOLVER_H
 #define UNO_LPSOLVER_H
 
+#include <cstddef>
 #include <vector>
+#include "FactorizationStatistics.hpp"
 
 namespace uno {
    // forward declarations
    class Direction;
    class Iterate;
+   class MemoryReport;
    class OptimizationProblem;
    template <typename ElementType>
    class RectangularMatrix;
@@ -30,6 +33,13 @@ namespace uno {
 
       virtual void solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& initial_point, Direction& direction,
             double trust_region_radius, const WarmstartInformation& warmstart_information) = 0;
+
+      // memory of the internal workspaces (in bytes)
+      [[nodiscard]] virtual size_t get_peak_workspace_size() const { return 0; }
+      // statistics of the linear solver (empty if the solver does not factorize with a direct linear solver)
+      [[nodiscard]] virtual FactorizationStatistics get_factorization_statistics() const { return {}; }
+      // memory of the buffers of the solver, per component
+      virtual void report_memory(MemoryReport& /*report*/) const { }
    };
 } // namespace
 
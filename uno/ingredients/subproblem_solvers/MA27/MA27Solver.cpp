@@ -1,11 +1,15 @@
 // Copyright (c) 2024 Manuel Schaich
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <stdexcept>
 #include "MA27Solver.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
 #include "tools/Logger.hpp"
 #include "fortran_interface.h"
 
@@ -109,14 +113,28 @@ namespace uno {
    };
 
 
-   MA27Solver::MA27Solver(size_t max_dimension, size_t max_number_nonzeros):
-         DirectSymmetricIndefiniteLinearSolver<size_t, double>(max_dimension),
+   template <typename IndexType>
+   MA27Solver<IndexType>::MA27Solver(size_t max_dimension, size_t max_number_nonzeros, const Options& options):
+         DirectSymmetricIndefiniteLinearSolver<IndexType, double>(max_dimension),
          n(static_cast<int>(max_dimension)), nnz(static_cast<int>(max_number_nonzeros)),
-         irn(max_number_nonzeros), icn(max_number_nonzeros),
+         pivoting_threshold(options.get_double("MA27_pivot_tolerance")),
+         pivoting_threshold_max(options.get_double("MA27_pivot_tolerance_max")),
          iw((2 * max_number_nonzeros + 3 * max_dimension + 1) * 6 / 5), // 20% more than 2*nnz + 3*n + 1
-         ikeep(3 * max_dimension), iw1(2 * max_dimension) {
+         ikeep(3 * max_dimension), iw1(2 * max_dimension),
+         ordering(fill_reducing_ordering_from_string(options.get_string("MA27_ordering"))),
+         ordering_cache(options.get_unsigned_int("ordering_cache_size")),
+         analysis_repository("MA27", options) {
+      // MA27 only provides its minimum degree ordering
+      if (this->ordering != FillReducingOrdering::AUTOMATIC && this->ordering != FillReducingOrdering::MINIMUM_DEGREE &&
+            this->ordering != FillReducingOrdering::USER) {
+         throw std::invalid_argument("MA27: the available orderings are automatic, minimum_degree and user");
+      }
+      if (this->pivoting_threshold <= 0. || this->pivoting_threshold_max < this->pivoting_threshold || 0.5 < this->pivoting_threshold_max) {
+         throw std::invalid_argument("MA27: the pivot tolerances should satisfy 0 < MA27_pivot_tolerance <= MA27_pivot_tolerance_max <= 0.5");
+      }
       // initialization: set the default values of the controlling parameters
       MA27ID(icntl.data(), cntl.data());
+      this->cntl[eCNTL::U] = this->pivoting_threshold;
       // a suitable pivot order is to be chosen automatically
       iflag = 0;
       // suppress warning messages
@@ -125,39 +143,138 @@ namespace uno {
       icntl[eICNTL::LDIAG] = 0;
    }
 
-   void MA27Solver::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) {
+   template <typename IndexType>
+   void MA27Solver<IndexType>::do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) {
       assert(matrix.dimension() <= iw1.capacity() && "MA27Solver: the dimension of the matrix is larger than the preallocated size");
-      assert(matrix.number_nonzeros() <= irn.capacity() &&
-             "MA27Solver: the number of nonzeros of the matrix is larger than the preallocated size");
 
-      // build the internal matrix representation
-      save_matrix_to_local_format(matrix);
+      // borrow the sparsity pattern of the matrix, or build the internal matrix representation
+      this->indices.save(matrix);
 
       n = static_cast<int>(matrix.dimension());
       nnz = static_cast<int>(matrix.number_nonzeros());
 
+      // pivot order: reuse the cached order of this sparsity pattern, if any
+      const size_t pattern_key = OrderingCache::pattern_key(matrix.dimension(), matrix.number_nonzeros(), this->indices.row_indices(),
+            this->indices.column_indices());
+      // the symbolic analysis of this pattern may have been persisted by a previous solve
+      if (this->restore_symbolic_analysis(pattern_key)) {
+         return;
+      }
+      const bool compute_pivot_order = this->set_pivot_order_in_ikeep(pattern_key);
+
       // symbolic analysis
       int liw = static_cast<int>(iw.size());
       MA27AD(&n, &nnz,                                   /* size info */
-            irn.data(), icn.data(),                     /* matrix indices */
+            this->indices.row_indices(), this->indices.column_indices(), /* matrix indices */
             iw.data(), &liw, ikeep.data(), iw1.data(),  /* solver workspace */
             &nsteps, &iflag, icntl.data(), cntl.data(), info.data(), &ops);
 
-      // resize the factor by at least INFO(5) (here, 50% more)
-      factor.resize(static_cast<size_t>(3 * info[eINFO::NRLNEC] / 2));
+      // on exit of MA27AD, IKEEP(1:N) holds the position of each variable in the pivot order
+      if (compute_pivot_order) {
+         this->ordering_cache.insert(pattern_key, std::vector<int>(this->ikeep.begin(), this->ikeep.begin() + n));
+      }
+
+      // resize the factor by at least INFO(5) (here, 50% more) and iw by at least INFO(6)
+      this->reserve_factor_storage(static_cast<size_t>(3 * info[eINFO::NRLNEC] / 2), static_cast<size_t>(3 * info[eINFO::NIRNEC] / 2));
+      this->factorization_statistics.record_analysis(matrix.number_nonzeros(), static_cast<size_t>(info[eINFO::NRLADU]));
 
       assert(info[eINFO::IFLAG] == eIFLAG::SUCCESS && "MA27: the symbolic analysis failed");
       if (info[eINFO::IFLAG] != eIFLAG::SUCCESS) {
          WARNING << "MA27 has issued a warning: IFLAG = " << info[eINFO::IFLAG] << " additional info, IERROR = " << info[eINFO::IERROR] << '\n';
       }
+      this->persist_symbolic_analysis(pattern_key);
+   }
+
+   // U = CNTL(1) = 0: no numerical pivoting, the factorization continues after a change of sign of the pivots (quasi-definite matrices)
+   template <typename IndexType>
+   void MA27Solver<IndexType>::set_static_pivoting(bool static_pivoting) {
+      this->cntl[eCNTL::U] = static_pivoting ? 0. : this->pivoting_threshold;
+   }
+
+   // IPOPT's update u <- min(u_max, u^0.75). The tolerance is not used with static pivoting
+   template <typename IndexType>
+   bool MA27Solver<IndexType>::increase_pivot_tolerance() {
+      if (this->cntl[eCNTL::U] == 0. || this->pivoting_threshold_max <= this->pivoting_threshold) {
+         return false;
+      }
+      this->pivoting_threshold = std::min(this->pivoting_threshold_max, std::pow(this->pivoting_threshold, 0.75));
+      this->cntl[eCNTL::U] = this->pivoting_threshold;
+      DEBUG << "MA27: the pivot tolerance is increased to " << this->pivoting_threshold << '\n';
+      return true;
+   }
+
+   template <typename IndexType>
+   void MA27Solver<IndexType>::set_pivot_order(const std::vector<size_t>& pivot_order) {
+      if (this->ordering != FillReducingOrdering::USER) {
+         throw std::invalid_argument("MA27: a pivot order was supplied but the option MA27_ordering is not set to user");
+      }
+      this->user_pivot_order = pivot_order;
+   }
+
+   template <typename IndexType>
+   bool MA27Solver<IndexType>::set_pivot_order_in_ikeep(size_t pattern_key) {
+      const size_t dimension = static_cast<size_t>(n);
+      if (this->ordering == FillReducingOrdering::USER) {
+         if (this->user_pivot_order.size() != dimension) {
+            throw std::invalid_argument("MA27: the user-supplied pivot order does not match the dimension of the matrix");
+         }
+         // IKEEP(i) is the position of variable i in the pivot order (inverse permutation)
+         for (size_t position: Range(dimension)) {
+            this->ikeep[this->user_pivot_order[position]] = static_cast<int>(position + FortranIndices<IndexType>::fortran_shift);
+         }
+         iflag = 1;
+         return false;
+      }
+      else if (const std::vector<int>* cached_pivot_order = this->ordering_cache.find(pattern_key)) {
+         DEBUG << "MA27: reusing the cached pivot order\n";
+         std::copy(cached_pivot_order->begin(), cached_pivot_order->end(), this->ikeep.begin());
+         iflag = 1;
+         return false;
+      }
+      else {
+         // a suitable pivot order is to be chosen automatically
+         iflag = 0;
+         return true;
+      }
+   }
+
+   template <typename IndexType>
+   bool MA27Solver<IndexType>::restore_symbolic_analysis(size_t pattern_key) {
+      if (!this->analysis_repository.is_enabled()) {
+         return false;
+      }
+      const std::optional<SymbolicAnalysis> analysis = this->analysis_repository.find(pattern_key, static_cast<size_t>(n), static_cast<size_t>(nnz));
+      // layout: NSTEPS, size of the factor, IKEEP
+      if (!analysis.has_value() || analysis->data.size() < 2 || this->ikeep.size() < analysis->data.size() - 2) {
+         return false;
+      }
+      DEBUG << "MA27: restoring the persisted symbolic analysis\n";
+      nsteps = analysis->data[0];
+      this->reserve_factor_storage(static_cast<size_t>(analysis->data[1]), iw.size());
+      std::copy(analysis->data.begin() + 2, analysis->data.end(), this->ikeep.begin());
+      return true;
+   }
+
+   template <typename IndexType>
+   void MA27Solver<IndexType>::persist_symbolic_analysis(size_t pattern_key) const {
+      if (this->analysis_repository.is_enabled()) {
+         SymbolicAnalysis analysis{static_cast<size_t>(n), static_cast<size_t>(nnz), {}};
+         analysis.data.reserve(2 + this->ikeep.size());
+         analysis.data.emplace_back(nsteps);
+         analysis.data.emplace_back(static_cast<int>(factor.size()));
+         analysis.data.insert(analysis.data.end(), this->ikeep.begin(), this->ikeep.begin() + 3 * n);
+         this->analysis_repository.store(pattern_key, analysis);
+      }
    }
 
-   void MA27Solver::do_numerical_factorization([[maybe_unused]] const SymmetricMatrix<size_t, double>& matrix) {
+   template <typename IndexType>
+   void MA27Solver<IndexType>::do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) {
       assert(matrix.dimension() <= iw1.capacity() && "MA27Solver: the dimension of the matrix is larger than the preallocated size");
       assert(nnz == static_cast<int>(matrix.number_nonzeros()) && "MA27Solver: the numbers of nonzeros do not match");
 
-      // initialize factor with the entries of the matrix. It will be modified by MA27BD
-      std::copy(matrix.data_pointer(), matrix.data_pointer() + matrix.number_nonzeros(), factor.begin());
+      this->indices.update_pointers(matrix);
+
+      this->reserve_factor_storage(matrix.number_nonzeros(), iw.size());
 
       // numerical factorization
       // may fail because of insufficient space. In this case, more memory is allocated and the factorization tried again
@@ -168,31 +285,40 @@ namespace uno {
          if (this->number_factorization_attempts < attempt) {
             throw std::runtime_error("MA27 reached the maximum number of factorization attempts");
          }
+         // initialize factor with the entries of the matrix. It is overwritten by MA27BD, including by a failed attempt
+         std::copy(matrix.data_pointer(), matrix.data_pointer() + matrix.number_nonzeros(), factor.begin());
 
          int la = static_cast<int>(factor.size());
          int liw = static_cast<int>(iw.size());
-         MA27BD(&n, &nnz, irn.data(), icn.data(), factor.data(), &la, iw.data(), &liw, ikeep.data(), &nsteps, &maxfrt, iw1.data(), icntl.data(),
-               cntl.data(), info.data());
+         MA27BD(&n, &nnz, this->indices.row_indices(), this->indices.column_indices(), factor.data(), &la, iw.data(), &liw, ikeep.data(), &nsteps,
+               &maxfrt, iw1.data(), icntl.data(), cntl.data(), info.data());
          factorization_done = true;
 
+         // INFO(2) is a length that may suffice: grow geometrically so that the number of attempts stays small
          if (info[eINFO::IFLAG] == eIFLAG::INSUFFICIENTINTEGER) {
             INFO << "MA27: insufficient integer workspace, resizing and retrying. \n";
             // increase the size of iw
-            iw.resize(static_cast<size_t>(info[eINFO::IERROR]));
+            const size_t grown_size = static_cast<size_t>(this->storage_growth_factor * static_cast<double>(iw.size()));
+            this->reserve_factor_storage(factor.size(), std::max(static_cast<size_t>(info[eINFO::IERROR]), grown_size));
             factorization_done = false;
          }
          if (info[eINFO::IFLAG] == eIFLAG::INSUFFICIENTREAL) {
             INFO << "MA27: insufficient real workspace, resizing and retrying. \n";
             // increase the size of factor
-            factor.resize(static_cast<size_t>(info[eINFO::IERROR]));
+            const size_t grown_size = static_cast<size_t>(this->storage_growth_factor * static_cast<double>(factor.size()));
+            this->reserve_factor_storage(std::max(static_cast<size_t>(info[eINFO::IERROR]), grown_size), iw.size());
             factorization_done = false;
          }
       }
       this->w.resize(static_cast<size_t>(maxfrt));
       this->check_factorization_status();
+      // MA27 forecasts the flops (OPS) in the analysis and does not report the delayed pivots
+      this->factorization_statistics.record_factorization(static_cast<size_t>(info[eINFO::NRLBDU]), ops, this->peak_workspace_size, 0, 0,
+         static_cast<size_t>(info[eINFO::NTWO]));
    }
 
-   void MA27Solver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& /*matrix*/, const Vector<double>& rhs, Vector<double>& result) {
+   template <typename IndexType>
+   void MA27Solver<IndexType>::solve_indefinite_system(const SymmetricMatrix<IndexType, double>& /*matrix*/, const Vector<double>& rhs, Vector<double>& result) {
       int la = static_cast<int>(factor.size());
       int liw = static_cast<int>(iw.size());
 
@@ -206,7 +332,24 @@ namespace uno {
       }
    }
 
-   std::tuple<size_t, size_t, size_t> MA27Solver::get_inertia() const {
+   template <typename IndexType>
+   void MA27Solver<IndexType>::solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& /*matrix*/, const Vector<double>& rhs,
+         Vector<double>& result, size_t number_rhs) {
+      int la = static_cast<int>(factor.size());
+      int liw = static_cast<int>(iw.size());
+      const size_t dimension = static_cast<size_t>(n);
+
+      // MA27CD solves one rhs at a time: solve in place in each column of the result block
+      std::copy(rhs.data(), rhs.data() + dimension * number_rhs, result.data());
+      for (size_t rhs_index: Range(number_rhs)) {
+         MA27CD(&n, factor.data(), &la, iw.data(), &liw, w.data(), &maxfrt, result.data() + rhs_index * dimension, iw1.data(), &nsteps,
+               icntl.data(), info.data());
+         assert(info[eINFO::IFLAG] == eIFLAG::SUCCESS && "MA27: the linear solve failed");
+      }
+   }
+
+   template <typename IndexType>
+   std::tuple<size_t, size_t, size_t> MA27Solver<IndexType>::get_inertia() const {
       // rank = number_positive_eigenvalues + number_negative_eigenvalues
       // n = rank + number_zero_eigenvalues
       const size_t rankA = rank();
@@ -216,32 +359,30 @@ namespace uno {
       return std::make_tuple(num_positive_eigenvalues, num_negative_eigenvalues, num_zero_eigenvalues);
    }
 
-   size_t MA27Solver::number_negative_eigenvalues() const {
+   template <typename IndexType>
+   size_t MA27Solver<IndexType>::number_negative_eigenvalues() const {
       return static_cast<size_t>(info[eINFO::NEIG]);
    }
 
-   bool MA27Solver::matrix_is_singular() const {
+   template <typename IndexType>
+   bool MA27Solver<IndexType>::matrix_is_singular() const {
       return (info[eINFO::IFLAG] == eIFLAG::SINGULAR || info[eINFO::IFLAG] == eIFLAG::RANK_DEFICIENT);
    }
 
-   size_t MA27Solver::rank() const {
+   template <typename IndexType>
+   size_t MA27Solver<IndexType>::rank() const {
       return (info[eINFO::IFLAG] == eIFLAG::RANK_DEFICIENT) ? static_cast<size_t>(info[eINFO::IERROR]) : static_cast<size_t>(n);
    }
 
-   void MA27Solver::save_matrix_to_local_format(const SymmetricMatrix<size_t, double>& matrix) {
-      // build the internal matrix representation
-      irn.clear();
-      icn.clear();
-      factor.clear();
-      constexpr auto fortran_shift = 1;
-      for (const auto [row_index, column_index, element]: matrix) {
-         irn.emplace_back(static_cast<int>(row_index + fortran_shift));
-         icn.emplace_back(static_cast<int>(column_index + fortran_shift));
-         factor.emplace_back(element);
-      }
+   template <typename IndexType>
+   void MA27Solver<IndexType>::reserve_factor_storage(size_t la, size_t liw) {
+      this->factor.resize(std::max(la, this->factor.size()));
+      this->iw.resize(std::max(liw, this->iw.size()));
+      this->peak_workspace_size = std::max(this->peak_workspace_size, this->factor.size() * sizeof(double) + this->iw.size() * sizeof(int));
    }
 
-   void MA27Solver::check_factorization_status() {
+   template <typename IndexType>
+   void MA27Solver<IndexType>::check_factorization_status() {
       switch (info[eINFO::IFLAG]) {
          case NSTEPS:
             WARNING << "MA27BD: Value of NSTEPS outside the range 1 ≤ NSTEPS ≤ N" << '\n';
@@ -271,4 +412,7 @@ namespace uno {
             break;
       }
    }
+
+   template class MA27Solver<size_t>;
+   template class MA27Solver<int>;
 } // namespace
@@ -7,20 +7,33 @@
 #include <array>
 #include <vector>
 #include "../DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "../FortranIndices.hpp"
+#include "../OrderingCache.hpp"
+#include "../SymbolicAnalysisRepository.hpp"
 
 namespace uno {
-   // forward declaration
+   // forward declarations
+   class Options;
    template <typename ElementType>
    class Vector;
 
-   class MA27Solver: public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+   // the sparsity pattern of a COO matrix with 1-based int indices is passed without copy (see FortranIndices)
+   // the pivot order is computed once per sparsity pattern and cached (see OrderingCache)
+   // the symbolic analysis (IKEEP, NSTEPS) can be persisted across solves (see SymbolicAnalysisRepository)
+   template <typename IndexType = size_t>
+   class MA27Solver: public DirectSymmetricIndefiniteLinearSolver<IndexType, double> {
    public:
-      explicit MA27Solver(size_t max_dimension, size_t max_number_nonzeros);
+      MA27Solver(size_t max_dimension, size_t max_number_nonzeros, const Options& options);
       ~MA27Solver() override = default;
 
-      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) override;
-      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
-      void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+            size_t number_rhs) override;
+      void set_pivot_order(const std::vector<size_t>& pivot_order) override;
+      void set_static_pivoting(bool static_pivoting) override;
+      [[nodiscard]] bool increase_pivot_tolerance() override;
 
 
       [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
@@ -28,15 +41,17 @@ namespace uno {
       // [[nodiscard]] bool matrix_is_positive_definite() const override;
       [[nodiscard]] bool matrix_is_singular() const override;
       [[nodiscard]] size_t rank() const override;
+      [[nodiscard]] size_t get_peak_workspace_size() const override { return this->peak_workspace_size; }
 
    private:
       int n{};                         // dimension of current factorisation (maximal value here is <= max_dimension)
       int nnz{};                     // number of nonzeros of current factorisation
       std::array<int, 30> icntl{};      // integer array of length 30; integer control values
       std::array<double, 5> cntl{};     // double array of length 5; double control values
+      double pivoting_threshold;        // value of CNTL(1), restored when static pivoting is disabled
+      const double pivoting_threshold_max; // upper bound of the increases of CNTL(1)
 
-      std::vector<int> irn{};          // row index of input
-      std::vector<int> icn{};          // col index of input
+      FortranIndices<IndexType> indices{}; // row and col indices of input (borrowed from the matrix if possible)
 
       std::vector<int> iw{};           // integer workspace of length liw
       std::vector<int> ikeep{};        // integer array of 3*n; pivot sequence
@@ -46,15 +61,29 @@ namespace uno {
       std::array<int, 20> info{};       // integer array of length 20
       double ops{};                    // double, operations count
 
-      std::vector<double> factor{};    // data array of length la;
+      std::vector<double> factor{};    // data array of length la; initialized with the entries of the matrix before factorization
       int maxfrt{};                    // integer, to be set by ma27
       std::vector<double> w{};         // double workspace
       const size_t number_factorization_attempts{5};
+      const double storage_growth_factor{2.};
+      size_t peak_workspace_size{0}; // in bytes
 
+      // fill-reducing ordering
+      const FillReducingOrdering ordering;
+      OrderingCache ordering_cache;
+      std::vector<size_t> user_pivot_order{};
+      // symbolic analyses persisted across solves
+      const SymbolicAnalysisRepository analysis_repository;
 
-      // bool use_iterative_refinement{false}; // Not sure how to do this with ma27
-      void save_matrix_to_local_format(const SymmetricMatrix<size_t, double>& matrix);
+      // the iterative refinement of the solutions is carried out by the linear system (see SymmetricIndefiniteLinearSystem)
       void check_factorization_status();
+      // factor and iw never shrink: a pattern whose factorization needed more space (delayed pivots) keeps it
+      void reserve_factor_storage(size_t la, size_t liw);
+      // returns true if the pivot order must be computed by MA27AD
+      bool set_pivot_order_in_ikeep(size_t pattern_key);
+      // returns true if a persisted symbolic analysis of the pattern was restored
+      bool restore_symbolic_analysis(size_t pattern_key);
+      void persist_symbolic_analysis(size_t pattern_key) const;
    };
 } // namespace
 
@@ -1,10 +1,15 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <stdexcept>
 #include "MA57Solver.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
 #include "tools/Logger.hpp"
 #include "fortran_interface.h"
 
@@ -34,38 +39,83 @@ namespace uno {
          double cntl[], int info[], double rinfo[]);
    }
 
-   MA57Solver::MA57Solver(size_t dimension, size_t number_nonzeros) : DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension),
+   template <typename IndexType>
+   MA57Solver<IndexType>::MA57Solver(size_t dimension, size_t number_nonzeros, const Options& options) :
+         DirectSymmetricIndefiniteLinearSolver<IndexType, double>(dimension),
          lkeep(static_cast<int>(5 * dimension + number_nonzeros + std::max(dimension, number_nonzeros) + 42)),
          keep(static_cast<size_t>(lkeep)),
          iwork(5 * dimension),
          lwork(static_cast<int>(1.2 * static_cast<double>(dimension))),
-         work(static_cast<size_t>(this->lwork)), residuals(dimension) {
-      this->row_indices.reserve(number_nonzeros);
-      this->column_indices.reserve(number_nonzeros);
+         work(static_cast<size_t>(this->lwork)),
+         pivot_tolerance(options.get_double("MA57_pivot_tolerance")),
+         pivot_tolerance_max(options.get_double("MA57_pivot_tolerance_max")),
+         ordering(fill_reducing_ordering_from_string(options.get_string("MA57_ordering"))),
+         ordering_cache(options.get_unsigned_int("ordering_cache_size")),
+         analysis_repository("MA57", options),
+         residuals(dimension) {
+      if (this->pivot_tolerance <= 0. || this->pivot_tolerance_max < this->pivot_tolerance || 0.5 < this->pivot_tolerance_max) {
+         throw std::invalid_argument("MA57: the pivot tolerances should satisfy 0 < MA57_pivot_tolerance <= MA57_pivot_tolerance_max <= 0.5");
+      }
       // set the default values of the controlling parameters
       MA57ID(this->cntl.data(), this->icntl.data());
+      this->cntl[0] = this->pivot_tolerance;
       // suppress warning messages
       this->icntl[4] = 0;
       // iterative refinement enabled
       this->icntl[8] = 1;
    }
 
-   void MA57Solver::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) {
+   template <typename IndexType>
+   void MA57Solver<IndexType>::set_pivot_order(const std::vector<size_t>& pivot_order) {
+      if (this->ordering != FillReducingOrdering::USER) {
+         throw std::invalid_argument("MA57: a pivot order was supplied but the option MA57_ordering is not set to user");
+      }
+      this->user_pivot_order = pivot_order;
+   }
+
+   // ICNTL(7) = 1: numerical pivoting with the threshold CNTL(1) (default). ICNTL(7) = 3: no pivoting, the factorization stops at a
+   // zero pivot (|pivot| <= CNTL(2))
+   template <typename IndexType>
+   void MA57Solver<IndexType>::set_static_pivoting(bool static_pivoting) {
+      this->icntl[6] = static_pivoting ? 3 : 1;
+   }
+
+   // IPOPT's update u <- min(u_max, u^0.75). The tolerance is not used with static pivoting
+   template <typename IndexType>
+   bool MA57Solver<IndexType>::increase_pivot_tolerance() {
+      if (this->icntl[6] == 3 || this->pivot_tolerance_max <= this->pivot_tolerance) {
+         return false;
+      }
+      this->pivot_tolerance = std::min(this->pivot_tolerance_max, std::pow(this->pivot_tolerance, 0.75));
+      this->cntl[0] = this->pivot_tolerance;
+      DEBUG << "MA57: the pivot tolerance is increased to " << this->pivot_tolerance << '\n';
+      return true;
+   }
+
+   template <typename IndexType>
+   void MA57Solver<IndexType>::do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) {
       assert(matrix.dimension() <= this->dimension && "MA57Solver: the dimension of the matrix is larger than the preallocated size");
-      assert(matrix.number_nonzeros() <= this->row_indices.capacity() &&
-             "MA57Solver: the number of nonzeros of the matrix is larger than the preallocated size");
 
-      // build the internal matrix representation
-      this->save_sparsity_pattern_internally(matrix);
+      // borrow the sparsity pattern of the matrix, or build the internal matrix representation
+      this->indices.save(matrix);
 
       const int n = static_cast<int>(matrix.dimension());
       const int nnz = static_cast<int>(matrix.number_nonzeros());
 
+      // pivot order: reuse the cached order of this sparsity pattern, if any
+      const size_t pattern_key = OrderingCache::pattern_key(matrix.dimension(), matrix.number_nonzeros(), this->indices.row_indices(),
+            this->indices.column_indices());
+      // the symbolic analysis of this pattern may have been persisted by a previous solve
+      if (this->restore_symbolic_analysis(pattern_key, n, nnz)) {
+         return;
+      }
+      const bool compute_pivot_order = this->set_pivot_order_in_keep(pattern_key, matrix.dimension());
+
       // symbolic analysis
       MA57AD(/* const */ &n,
             /* const */ &nnz,
-            /* const */ this->row_indices.data(),
-            /* const */ this->column_indices.data(),
+            /* const */ this->indices.row_indices(),
+            /* const */ this->indices.column_indices(),
             /* const */ &this->lkeep,
             /* const */ this->keep.data(),
             /* out */ this->iwork.data(),
@@ -78,38 +128,79 @@ namespace uno {
          WARNING << "MA57 has issued a warning: info(1) = " << info[0] << '\n';
       }
 
-      // get LFACT and LIFACT and resize FACT and IFACT (no effect if resized to <= size)
-      int lfact = 2 * this->info[8];
-      int lifact = 2 * this->info[9];
-      this->fact.resize(static_cast<size_t>(lfact));
-      this->ifact.resize(static_cast<size_t>(lifact));
+      // on exit of MA57AD, KEEP(1:N) holds the pivot order
+      if (compute_pivot_order) {
+         this->ordering_cache.insert(pattern_key, std::vector<int>(this->keep.begin(), this->keep.begin() + n));
+      }
 
-      // store the sizes of the symbolic analysis
-      this->factorization = {n, nnz, lfact, lifact};
+      // size FACT and IFACT with twice the estimates of MA57AD (INFO(9) and INFO(10))
+      this->factorization.n = n;
+      this->factorization.nnz = nnz;
+      this->reserve_factor_storage(2 * this->info[8], 2 * this->info[9]);
+      this->persist_symbolic_analysis(pattern_key);
+      // INFO(5): forecast number of reals in the factors
+      this->factorization_statistics.record_analysis(matrix.number_nonzeros(), static_cast<size_t>(this->info[4]));
    }
 
-   void MA57Solver::do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) {
+   template <typename IndexType>
+   void MA57Solver<IndexType>::do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) {
       assert(matrix.dimension() <= this->dimension && "MA57Solver: the dimension of the matrix is larger than the preallocated size");
       assert(this->factorization.nnz == static_cast<int>(matrix.number_nonzeros()) && "MA57Solver: the numbers of nonzeros do not match");
+      this->indices.update_pointers(matrix);
 
       const int n = static_cast<int>(matrix.dimension());
       int nnz = static_cast<int>(matrix.number_nonzeros());
 
       // numerical factorization
-      MA57BD(&n,
-            &nnz,
-            /* const */ matrix.data_pointer(),
-            /* out */ this->fact.data(),
-            /* const */ &this->factorization.lfact,
-            /* out */ this->ifact.data(),
-            /* const */ &this->factorization.lifact,
-            /* const */ &this->lkeep,
-            /* const */ this->keep.data(), this->iwork.data(), this->icntl.data(), this->cntl.data(),
-            /* out */ this->info.data(),
-            /* out */ this->rinfo.data());
+      // may fail because of insufficient space (delayed pivots). In this case, the storage is grown and the factorization tried again
+      bool factorization_done = false;
+      size_t attempt = 0;
+      while (not factorization_done) {
+         attempt++;
+         if (this->number_factorization_attempts < attempt) {
+            throw std::runtime_error("MA57 reached the maximum number of factorization attempts");
+         }
+
+         MA57BD(&n,
+               &nnz,
+               /* const */ matrix.data_pointer(),
+               /* out */ this->fact.data(),
+               /* const */ &this->factorization.lfact,
+               /* out */ this->ifact.data(),
+               /* const */ &this->factorization.lifact,
+               /* const */ &this->lkeep,
+               /* const */ this->keep.data(), this->iwork.data(), this->icntl.data(), this->cntl.data(),
+               /* out */ this->info.data(),
+               /* out */ this->rinfo.data());
+         factorization_done = true;
+
+         // the factorization restarts from the matrix: the previous content of FACT and IFACT need not be copied (MA57ED)
+         if (this->info[0] == -3) {
+            // insufficient real space: INFO(17) is the minimum length of FACT
+            INFO << "MA57: insufficient real workspace, resizing and retrying\n";
+            const int lfact = std::max(this->info[16], static_cast<int>(this->storage_growth_factor * this->factorization.lfact));
+            this->reserve_factor_storage(lfact, this->factorization.lifact);
+            factorization_done = false;
+         }
+         else if (this->info[0] == -4) {
+            // insufficient integer space: INFO(18) is the minimum length of IFACT
+            INFO << "MA57: insufficient integer workspace, resizing and retrying\n";
+            const int lifact = std::max(this->info[17], static_cast<int>(this->storage_growth_factor * this->factorization.lifact));
+            this->reserve_factor_storage(this->factorization.lfact, lifact);
+            factorization_done = false;
+         }
+      }
+      if (this->info[0] < 0) {
+         WARNING << "MA57 has issued an error: info(1) = " << this->info[0] << '\n';
+      }
+      // INFO(14): entries in the factors, RINFO(3) + RINFO(4): flops of the assembly and the elimination, INFO(23): delayed pivots,
+      // INFO(22): 2x2 pivots
+      this->factorization_statistics.record_factorization(static_cast<size_t>(this->info[13]), this->rinfo[2] + this->rinfo[3],
+         this->peak_workspace_size, static_cast<size_t>(this->info[22]), 0, static_cast<size_t>(this->info[21]));
    }
 
-   void MA57Solver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) {
+   template <typename IndexType>
+   void MA57Solver<IndexType>::solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) {
       // solve
       const int n = static_cast<int>(matrix.dimension());
       int nnz = static_cast<int>(matrix.number_nonzeros());
@@ -117,7 +208,7 @@ namespace uno {
 
       // solve the linear system
       if (this->use_iterative_refinement) {
-         MA57DD(&this->job, &n, &nnz, matrix.data_pointer(), this->row_indices.data(), this->column_indices.data(),
+         MA57DD(&this->job, &n, &nnz, matrix.data_pointer(), this->indices.row_indices(), this->indices.column_indices(),
                this->fact.data(), &this->factorization.lfact, this->ifact.data(), &this->factorization.lifact,
                rhs.data(), result.data(), this->residuals.data(), this->work.data(), this->iwork.data(), this->icntl.data(),
                this->cntl.data(), this->info.data(), this->rinfo.data());
@@ -132,7 +223,109 @@ namespace uno {
       }
    }
 
-   std::tuple<size_t, size_t, size_t> MA57Solver::get_inertia() const {
+   template <typename IndexType>
+   int MA57Solver<IndexType>::get_ordering_control(FillReducingOrdering ordering) {
+      switch (ordering) {
+         case FillReducingOrdering::AMD:
+            return 2; // approximate minimum degree with dense row detection (MC47)
+         case FillReducingOrdering::MINIMUM_DEGREE:
+            return 3; // minimum degree (MA27)
+         case FillReducingOrdering::METIS:
+            return 4; // nested dissection (METIS_NodeND)
+         case FillReducingOrdering::USER:
+            return 1; // pivot order supplied in KEEP
+         default:
+            return 5; // automatic choice between AMD and METIS
+      }
+   }
+
+   template <typename IndexType>
+   void MA57Solver<IndexType>::reserve_factor_storage(int lfact, int lifact) {
+      this->factorization.lfact = std::max(lfact, static_cast<int>(this->fact.size()));
+      this->factorization.lifact = std::max(lifact, static_cast<int>(this->ifact.size()));
+      this->fact.resize(static_cast<size_t>(this->factorization.lfact));
+      this->ifact.resize(static_cast<size_t>(this->factorization.lifact));
+      this->peak_workspace_size = std::max(this->peak_workspace_size, this->fact.size() * sizeof(double) + this->ifact.size() * sizeof(int));
+   }
+
+   template <typename IndexType>
+   bool MA57Solver<IndexType>::set_pivot_order_in_keep(size_t pattern_key, size_t dimension) {
+      if (this->ordering == FillReducingOrdering::USER) {
+         if (this->user_pivot_order.size() != dimension) {
+            throw std::invalid_argument("MA57: the user-supplied pivot order does not match the dimension of the matrix");
+         }
+         for (size_t position: Range(dimension)) {
+            this->keep[position] = static_cast<int>(this->user_pivot_order[position] + FortranIndices<IndexType>::fortran_shift);
+         }
+         this->icntl[5] = MA57Solver::get_ordering_control(FillReducingOrdering::USER);
+         return false;
+      }
+      else if (const std::vector<int>* cached_pivot_order = this->ordering_cache.find(pattern_key)) {
+         DEBUG << "MA57: reusing the cached pivot order\n";
+         std::copy(cached_pivot_order->begin(), cached_pivot_order->end(), this->keep.begin());
+         this->icntl[5] = MA57Solver::get_ordering_control(FillReducingOrdering::USER);
+         return false;
+      }
+      else {
+         this->icntl[5] = MA57Solver::get_ordering_control(this->ordering);
+         return true;
+      }
+   }
+
+   template <typename IndexType>
+   void MA57Solver<IndexType>::solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs,
+         Vector<double>& result, size_t number_rhs) {
+      const int n = static_cast<int>(matrix.dimension());
+      const int block_nrhs = static_cast<int>(number_rhs);
+      const int lrhs = n; // leading dimension of the column-major block
+      const size_t block_size = matrix.dimension() * number_rhs;
+
+      // copy the rhs block into result (overwritten by MA57)
+      std::copy(rhs.data(), rhs.data() + block_size, result.data());
+      // MA57CD requires a workspace of size n * nrhs
+      if (this->work.size() < block_size) {
+         this->work.resize(block_size);
+         this->lwork = static_cast<int>(block_size);
+      }
+      MA57CD(&this->job, &n, this->fact.data(), &this->factorization.lfact, this->ifact.data(),
+            &this->factorization.lifact, &block_nrhs, result.data(), &lrhs, this->work.data(), &this->lwork, this->iwork.data(),
+            this->icntl.data(), this->info.data());
+   }
+
+   template <typename IndexType>
+   bool MA57Solver<IndexType>::restore_symbolic_analysis(size_t pattern_key, int n, int nnz) {
+      if (!this->analysis_repository.is_enabled()) {
+         return false;
+      }
+      const std::optional<SymbolicAnalysis> analysis = this->analysis_repository.find(pattern_key, static_cast<size_t>(n), static_cast<size_t>(nnz));
+      // layout: LFACT, LIFACT, KEEP
+      if (!analysis.has_value() || analysis->data.size() < 2 || this->keep.size() < analysis->data.size() - 2) {
+         return false;
+      }
+      DEBUG << "MA57: restoring the persisted symbolic analysis\n";
+      const int lfact = analysis->data[0];
+      const int lifact = analysis->data[1];
+      std::copy(analysis->data.begin() + 2, analysis->data.end(), this->keep.begin());
+      this->factorization.n = n;
+      this->factorization.nnz = nnz;
+      this->reserve_factor_storage(lfact, lifact);
+      return true;
+   }
+
+   template <typename IndexType>
+   void MA57Solver<IndexType>::persist_symbolic_analysis(size_t pattern_key) const {
+      if (this->analysis_repository.is_enabled()) {
+         SymbolicAnalysis analysis{static_cast<size_t>(this->factorization.n), static_cast<size_t>(this->factorization.nnz), {}};
+         analysis.data.reserve(2 + this->keep.size());
+         analysis.data.emplace_back(this->factorization.lfact);
+         analysis.data.emplace_back(this->factorization.lifact);
+         analysis.data.insert(analysis.data.end(), this->keep.begin(), this->keep.end());
+         this->analysis_repository.store(pattern_key, analysis);
+      }
+   }
+
+   template <typename IndexType>
+   std::tuple<size_t, size_t, size_t> MA57Solver<IndexType>::get_inertia() const {
       // rank = number_positive_eigenvalues + number_negative_eigenvalues
       // n = rank + number_zero_eigenvalues
       const size_t rank = this->rank();
@@ -142,7 +335,8 @@ namespace uno {
       return std::make_tuple(number_positive_eigenvalues, number_negative_eigenvalues, number_zero_eigenvalues);
    }
 
-   size_t MA57Solver::number_negative_eigenvalues() const {
+   template <typename IndexType>
+   size_t MA57Solver<IndexType>::number_negative_eigenvalues() const {
       return static_cast<size_t>(this->info[23]);
    }
 
@@ -153,21 +347,22 @@ namespace uno {
    }
    */
 
-   bool MA57Solver::matrix_is_singular() const {
+   template <typename IndexType>
+   bool MA57Solver<IndexType>::matrix_is_singular() const {
       return (this->info[0] == 4);
    }
 
-   size_t MA57Solver::rank() const {
+   template <typename IndexType>
+   size_t MA57Solver<IndexType>::rank() const {
       return static_cast<size_t>(this->info[24]);
    }
 
-   void MA57Solver::save_sparsity_pattern_internally(const SymmetricMatrix<size_t, double>& matrix) {
-      // build the internal matrix representation
-      this->row_indices.clear();
-      this->column_indices.clear();
-      for (const auto [row_index, column_index, _]: matrix) {
-         this->row_indices.emplace_back(static_cast<int>(row_index + this->fortran_shift));
-         this->column_indices.emplace_back(static_cast<int>(column_index + this->fortran_shift));
-      }
+   template <typename IndexType>
+   size_t MA57Solver<IndexType>::memory_size() const {
+      return this->indices.memory_size() + (this->fact.capacity() + this->work.capacity() + this->residuals.capacity()) * sizeof(double) +
+            (this->ifact.capacity() + this->keep.capacity() + this->iwork.capacity()) * sizeof(int);
    }
+
+   template class MA57Solver<size_t>;
+   template class MA57Solver<int>;
 } // namespace
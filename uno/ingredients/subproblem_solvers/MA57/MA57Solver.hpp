@@ -7,9 +7,14 @@
 #include <array>
 #include <vector>
 #include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "ingredients/subproblem_solvers/FortranIndices.hpp"
+#include "ingredients/subproblem_solvers/OrderingCache.hpp"
+#include "ingredients/subproblem_solvers/SymbolicAnalysisRepository.hpp"
+#include "linear_algebra/AlignedAllocator.hpp"
 
 namespace uno {
-   // forward declaration
+   // forward declarations
+   class Options;
    template <typename ElementType>
    class Vector;
 
@@ -27,31 +32,44 @@ namespace uno {
     * see https://github.com/YimingYAN/linSolve
     *
     *  Interface to the symmetric indefinite linear solver MA57
+    *  The sparsity pattern of a COO matrix with 1-based int indices is passed without copy (see FortranIndices)
+    *  The pivot order (ICNTL(6)) is computed once per sparsity pattern and cached (see OrderingCache)
+    *  The KEEP array of the symbolic analysis can be persisted across solves (see SymbolicAnalysisRepository)
     */
-   class MA57Solver : public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+   template <typename IndexType = size_t>
+   class MA57Solver : public DirectSymmetricIndefiniteLinearSolver<IndexType, double> {
    public:
-      MA57Solver(size_t dimension, size_t number_nonzeros);
+      MA57Solver(size_t dimension, size_t number_nonzeros, const Options& options);
       ~MA57Solver() override = default;
 
-      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) override;
-      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
-      void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+            size_t number_rhs) override;
+      void set_pivot_order(const std::vector<size_t>& pivot_order) override;
+      void set_static_pivoting(bool static_pivoting) override;
+      [[nodiscard]] bool increase_pivot_tolerance() override;
 
       [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
       [[nodiscard]] size_t number_negative_eigenvalues() const override;
       // [[nodiscard]] bool matrix_is_positive_definite() const override;
       [[nodiscard]] bool matrix_is_singular() const override;
       [[nodiscard]] size_t rank() const override;
+      [[nodiscard]] size_t memory_size() const override;
+      [[nodiscard]] size_t get_peak_workspace_size() const override { return this->peak_workspace_size; }
 
    private:
-      // internal matrix representation
-      std::vector<int> row_indices;
-      std::vector<int> column_indices;
+      // internal matrix representation (borrowed from the matrix if possible)
+      FortranIndices<IndexType> indices{};
 
       // factorization
       MA57Factorization factorization{};
-      std::vector<double> fact{0}; // do not initialize, resize at every iteration
-      std::vector<int> ifact{0}; // do not initialize, resize at every iteration
+      std::vector<double, AlignedAllocator<double>> fact{0}; // do not initialize, grown when the factorization runs out of space and kept across iterations
+      std::vector<int, AlignedAllocator<int>> ifact{0}; // do not initialize, grown when the factorization runs out of space and kept across iterations
+      const double storage_growth_factor{2.};
+      const size_t number_factorization_attempts{5};
+      size_t peak_workspace_size{0}; // in bytes
       const int lkeep;
       std::vector<int> keep{};
       std::vector<int> iwork{};
@@ -63,14 +81,31 @@ namespace uno {
       std::array<int, 20> icntl{};
       std::array<double, 20> rinfo{};
       std::array<int, 40> info{};
+      // threshold of the numerical pivoting CNTL(1) and upper bound of its increases
+      double pivot_tolerance;
+      const double pivot_tolerance_max;
+
+      // fill-reducing ordering
+      const FillReducingOrdering ordering;
+      OrderingCache ordering_cache;
+      std::vector<size_t> user_pivot_order{};
+      // symbolic analyses persisted across solves
+      const SymbolicAnalysisRepository analysis_repository;
 
       const int nrhs{1}; // number of right hand side being solved
       const int job{1};
       std::vector<double> residuals;
-      const size_t fortran_shift{1};
 
       bool use_iterative_refinement{false};
-      void save_sparsity_pattern_internally(const SymmetricMatrix<size_t, double>& matrix);
+
+      [[nodiscard]] static int get_ordering_control(FillReducingOrdering ordering);
+      // the factors never shrink: a pattern whose factorization needed more space (delayed pivots) keeps it
+      void reserve_factor_storage(int lfact, int lifact);
+      // returns true if the pivot order must be computed by MA57AD
+      bool set_pivot_order_in_keep(size_t pattern_key, size_t dimension);
+      // returns true if a persisted symbolic analysis of the pattern was restored
+      bool restore_symbolic_analysis(size_t pattern_key, int n, int nnz);
+      void persist_symbolic_analysis(size_t pattern_key) const;
    };
 } // namespace
 
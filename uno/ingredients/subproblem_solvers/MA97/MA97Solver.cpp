@@ -0,0 +1,133 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include "MA97Solver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   extern "C" {
+   // HSL_MA97 (C interface, double precision)
+   // default values of controlling parameters
+   void ma97_default_control_d(MA97Control* control);
+   // symbolic analysis of a matrix in coordinate format
+   void ma97_analyse_coord_d(int n, int ne, const int row[], const int col[], const double val[], void** akeep, const MA97Control* control,
+         MA97Info* info, int order[]);
+   // numerical factorization (ptr and row are NULL when the analysis was performed in coordinate format)
+   void ma97_factor_d(int matrix_type, const int ptr[], const int row[], const double val[], void** akeep, void** fkeep,
+         const MA97Control* control, MA97Info* info, double scale[]);
+   // linear system solve
+   void ma97_solve_d(int job, int nrhs, double* x, int ldx, void** akeep, void** fkeep, const MA97Control* control, MA97Info* info);
+   // free the memory
+   void ma97_finalise_d(void** akeep, void** fkeep);
+   }
+
+   template <typename IndexType>
+   MA97Solver<IndexType>::MA97Solver(size_t dimension, size_t /*number_nonzeros*/) : DirectSymmetricIndefiniteLinearSolver<IndexType, double>(dimension) {
+      // set the default values of the controlling parameters
+      ma97_default_control_d(&this->control);
+      // Fortran (1-based) indices
+      this->control.f_arrays = 1;
+      // continue the factorization of singular matrices (to compute the inertia)
+      this->control.action = 1;
+      // suppress the messages
+      this->control.print_level = -1;
+      this->control.unit_diagnostics = -1;
+      this->control.unit_error = -1;
+      this->control.unit_warning = -1;
+   }
+
+   template <typename IndexType>
+   MA97Solver<IndexType>::~MA97Solver() {
+      ma97_finalise_d(&this->akeep, &this->fkeep);
+   }
+
+   template <typename IndexType>
+   void MA97Solver<IndexType>::do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "MA97Solver: the dimension of the matrix is larger than the preallocated size");
+
+      // borrow the sparsity pattern of the matrix, or build the internal matrix representation
+      this->indices.save(matrix);
+      this->n = static_cast<int>(matrix.dimension());
+      const int nnz = static_cast<int>(matrix.number_nonzeros());
+
+      // discard the previous analysis and factorization
+      ma97_finalise_d(&this->akeep, &this->fkeep);
+      ma97_analyse_coord_d(this->n, nnz, this->indices.row_indices(), this->indices.column_indices(), nullptr, &this->akeep, &this->control,
+            &this->info, nullptr);
+
+      assert(0 <= this->info.flag && "MA97: the symbolic analysis failed");
+      if (0 < this->info.flag) {
+         WARNING << "MA97 has issued a warning: flag = " << this->info.flag << '\n';
+      }
+      this->factorization_statistics.record_analysis(matrix.number_nonzeros(), static_cast<size_t>(this->info.num_factor));
+   }
+
+   template <typename IndexType>
+   void MA97Solver<IndexType>::do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "MA97Solver: the dimension of the matrix is larger than the preallocated size");
+      assert(this->n == static_cast<int>(matrix.dimension()) && "MA97Solver: the dimensions do not match");
+
+      // the values are passed in the order of the coordinate analysis. The symbolic factorization is reused
+      ma97_factor_d(MA97Solver::REAL_SYMMETRIC_INDEFINITE, nullptr, nullptr, matrix.data_pointer(), &this->akeep, &this->fkeep, &this->control,
+            &this->info, nullptr);
+      if (this->info.flag < 0) {
+         WARNING << "MA97 failed to factorize the matrix: flag = " << this->info.flag << '\n';
+      }
+      // the factors are held by MA97: their memory is reported as the storage of their entries
+      this->factorization_statistics.record_factorization(static_cast<size_t>(this->info.num_factor), static_cast<double>(this->info.num_flops),
+         static_cast<size_t>(this->info.num_factor) * sizeof(double), static_cast<size_t>(this->info.num_delay), 0,
+         static_cast<size_t>(this->info.num_two));
+   }
+
+   template <typename IndexType>
+   void MA97Solver<IndexType>::solve_indefinite_system(const SymmetricMatrix<IndexType, double>& /*matrix*/, const Vector<double>& rhs,
+         Vector<double>& result) {
+      // copy rhs into result (overwritten by MA97)
+      result = rhs;
+      ma97_solve_d(MA97Solver::FULL_SOLVE, 1, result.data(), this->n, &this->akeep, &this->fkeep, &this->control, &this->info);
+      assert(0 <= this->info.flag && "MA97: the linear solve failed");
+   }
+
+   template <typename IndexType>
+   void MA97Solver<IndexType>::solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& /*matrix*/, const Vector<double>& rhs,
+         Vector<double>& result, size_t number_rhs) {
+      // copy the rhs block into result (overwritten by MA97)
+      std::copy(rhs.data(), rhs.data() + static_cast<size_t>(this->n) * number_rhs, result.data());
+      ma97_solve_d(MA97Solver::FULL_SOLVE, static_cast<int>(number_rhs), result.data(), this->n, &this->akeep, &this->fkeep, &this->control,
+            &this->info);
+      assert(0 <= this->info.flag && "MA97: the linear solve failed");
+   }
+
+   template <typename IndexType>
+   std::tuple<size_t, size_t, size_t> MA97Solver<IndexType>::get_inertia() const {
+      // rank = number_positive_eigenvalues + number_negative_eigenvalues
+      // n = rank + number_zero_eigenvalues
+      const size_t rank = this->rank();
+      const size_t number_negative_eigenvalues = this->number_negative_eigenvalues();
+      const size_t number_positive_eigenvalues = rank - number_negative_eigenvalues;
+      const size_t number_zero_eigenvalues = static_cast<size_t>(this->n) - rank;
+      return std::make_tuple(number_positive_eigenvalues, number_negative_eigenvalues, number_zero_eigenvalues);
+   }
+
+   template <typename IndexType>
+   size_t MA97Solver<IndexType>::number_negative_eigenvalues() const {
+      return static_cast<size_t>(this->info.num_neg);
+   }
+
+   template <typename IndexType>
+   bool MA97Solver<IndexType>::matrix_is_singular() const {
+      return (this->info.matrix_rank < this->n);
+   }
+
+   template <typename IndexType>
+   size_t MA97Solver<IndexType>::rank() const {
+      return static_cast<size_t>(this->info.matrix_rank);
+   }
+
+   template class MA97Solver<size_t>;
+   template class MA97Solver<int>;
+} // namespace
@@ -0,0 +1,101 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MA97SOLVER_H
+#define UNO_MA97SOLVER_H
+
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "ingredients/subproblem_solvers/FortranIndices.hpp"
+
+namespace uno {
+   // forward declaration
+   template <typename ElementType>
+   class Vector;
+
+   // control and information structures of the C interface of HSL_MA97 (see hsl_ma97d.h)
+   struct MA97Control {
+      int f_arrays; // use C or Fortran numbering
+      int action; // continue on singularity if != 0, otherwise abort
+      int nemin; // supernode amalgamation if parent and child have fewer than nemin eliminations
+      double multiplier; // amount of extra memory to allow for delays
+      int ordering; // ordering algorithm
+      int print_level; // diagnostic printing
+      int scaling; // scaling algorithm
+      double small; // minimum value to count as nonzero
+      double u; // pivoting parameter
+      int unit_diagnostics; // Fortran unit for diagnostics (< 0 disables)
+      int unit_error; // Fortran unit for error messages (< 0 disables)
+      int unit_warning; // Fortran unit for warning messages (< 0 disables)
+      long factor_min; // minimum number of flops for parallel execution
+      int solve_blas3; // use BLAS3 in solve if true, else BLAS2
+      long solve_min; // minimum number of entries for parallel execution
+      int solve_mf; // if true, use multifrontal solve, else supernodal
+      double consist_tol; // consistent equation tolerance
+      int ispare[5];
+      double rspare[10];
+   };
+
+   struct MA97Info {
+      int flag; // < 0 on error, > 0 on warning
+      int flag68;
+      int flag77;
+      int matrix_dup; // number of duplicate entries
+      int matrix_rank; // rank of the factorized matrix
+      int matrix_outrange; // number of out-of-range entries
+      int matrix_missing_diag; // number of missing diagonal entries
+      int maxdepth; // height of the assembly tree
+      int maxfront; // maximum dimension of a front
+      int num_delay; // number of delayed pivots
+      long num_factor; // number of entries in the factor
+      long num_flops; // number of flops for the factorization
+      int num_neg; // number of negative pivots
+      int num_sup; // number of supernodes
+      int num_two; // number of 2x2 pivots
+      int ordering; // ordering used
+      int stat; // error code from failed memory allocation
+      int maxsupernode; // maximum number of columns in a supernode
+      int ispare[4];
+      double rspare[10];
+   };
+
+   /*! \class MA97Solver
+    * \brief Interface for HSL_MA97
+    *
+    *  Interface to the multithreaded (OpenMP) symmetric indefinite linear solver HSL_MA97.
+    *  The matrix is passed in coordinate format with Fortran indices: the sparsity pattern of a COO matrix with 1-based int
+    *  indices is passed without copy (see FortranIndices)
+    */
+   template <typename IndexType = size_t>
+   class MA97Solver : public DirectSymmetricIndefiniteLinearSolver<IndexType, double> {
+   public:
+      MA97Solver(size_t dimension, size_t number_nonzeros);
+      ~MA97Solver() override;
+
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+            size_t number_rhs) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override;
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override;
+
+   private:
+      // internal matrix representation (borrowed from the matrix if possible)
+      FortranIndices<IndexType> indices{};
+      int n{0};
+
+      // symbolic and numerical factorizations (opaque pointers managed by MA97)
+      void* akeep{nullptr};
+      void* fkeep{nullptr};
+      MA97Control control{};
+      MA97Info info{};
+
+      static const int REAL_SYMMETRIC_INDEFINITE = 4;
+      static const int FULL_SOLVE = 0;
+   };
+} // namespace
+
+#endif // UNO_MA97SOLVER_H
@@ -0,0 +1,237 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MINRESSOLVER_H
+#define UNO_MINRESSOLVER_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "SymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   /*! \class MINRESSolver
+    * \brief Preconditioned MINRES (Paige and Saunders) for symmetric indefinite systems
+    *
+    *  The matrix is only accessed through matrix-vector products: no factorization is stored. The (symmetric positive definite)
+    *  preconditioner is diagonal. If the block structure of the augmented matrix is known, it approximates the constraint preconditioner
+    *  diag(|D|, J |D|^{-1} J^T), where D is the diagonal of the primal block; otherwise, it is the Jacobi preconditioner |D|.
+    *  The solver does not report the inertia of the matrix: the regularization relies on a curvature test
+    *  (see SymmetricIndefiniteLinearSystem::solve_and_regularize_by_curvature)
+    */
+   template <typename IndexType, typename ElementType>
+   class MINRESSolver: public SymmetricIndefiniteLinearSolver<IndexType, ElementType> {
+   public:
+      MINRESSolver(size_t dimension, const Options& options);
+      ~MINRESSolver() override = default;
+
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, ElementType>& matrix, const Vector<ElementType>& rhs,
+            Vector<ElementType>& result) override;
+
+      // size of the primal block of the augmented matrix (0: unknown structure, Jacobi preconditioner)
+      void set_primal_block_dimension(size_t primal_block_dimension) { this->primal_block_dimension = primal_block_dimension; }
+      // inexact solves: tolerance on the (preconditioned) residual, relative to that of the initial point x = 0
+      void set_relative_tolerance(ElementType relative_tolerance) { this->relative_tolerance = relative_tolerance; }
+      [[nodiscard]] ElementType get_relative_tolerance() const { return this->relative_tolerance; }
+      [[nodiscard]] size_t get_number_iterations() const { return this->number_iterations; }
+      [[nodiscard]] ElementType get_relative_residual() const { return this->relative_residual; }
+      [[nodiscard]] bool has_converged() const override { return this->converged; }
+      [[nodiscard]] size_t memory_size() const override {
+         return this->preconditioner.memory_size() + this->v.memory_size() + this->y.memory_size() + this->r1.memory_size() +
+               this->r2.memory_size() + this->w.memory_size() + this->w1.memory_size() + this->w2.memory_size();
+      }
+
+   protected:
+      const size_t max_iterations;
+      const ElementType preconditioner_floor;
+      ElementType relative_tolerance;
+      size_t primal_block_dimension{0};
+      size_t number_iterations{0};
+      ElementType relative_residual{0};
+      bool converged{false};
+      // diagonal preconditioner and Lanczos vectors
+      Vector<ElementType> preconditioner;
+      Vector<ElementType> v;
+      Vector<ElementType> y;
+      Vector<ElementType> r1;
+      Vector<ElementType> r2;
+      Vector<ElementType> w;
+      Vector<ElementType> w1;
+      Vector<ElementType> w2;
+
+      void compute_preconditioner(const SymmetricMatrix<IndexType, ElementType>& matrix, size_t dimension);
+      // the (numerically) zero entries of the preconditioner are replaced with 1
+      [[nodiscard]] ElementType safeguard(ElementType entry) const { return (entry < this->preconditioner_floor) ? ElementType(1) : entry; }
+      // result = matrix * x (only one triangle is stored)
+      static void product(const SymmetricMatrix<IndexType, ElementType>& matrix, const Vector<ElementType>& x, Vector<ElementType>& result,
+            size_t dimension);
+      [[nodiscard]] static ElementType dot(const Vector<ElementType>& x, const Vector<ElementType>& y, size_t dimension);
+   };
+
+   // implementation
+
+   template <typename IndexType, typename ElementType>
+   MINRESSolver<IndexType, ElementType>::MINRESSolver(size_t dimension, const Options& options):
+         SymmetricIndefiniteLinearSolver<IndexType, ElementType>(dimension),
+         max_iterations(options.get_unsigned_int("MINRES_max_iterations")),
+         preconditioner_floor(ElementType(options.get_double("MINRES_preconditioner_floor"))),
+         relative_tolerance(ElementType(options.get_double("MINRES_relative_tolerance"))),
+         preconditioner(dimension), v(dimension), y(dimension), r1(dimension), r2(dimension), w(dimension), w1(dimension), w2(dimension) {
+   }
+
+   template <typename IndexType, typename ElementType>
+   void MINRESSolver<IndexType, ElementType>::solve_indefinite_system(const SymmetricMatrix<IndexType, ElementType>& matrix,
+         const Vector<ElementType>& rhs, Vector<ElementType>& result) {
+      const size_t dimension = matrix.dimension();
+      assert(dimension <= this->dimension && "MINRESSolver: the matrix is larger than the allocated dimension");
+      this->compute_preconditioner(matrix, dimension);
+      this->number_iterations = 0;
+      this->converged = false;
+
+      // initial point x = 0
+      for (size_t index: Range(dimension)) {
+         result[index] = ElementType(0);
+         this->r1[index] = this->r2[index] = rhs[index];
+         this->y[index] = rhs[index] / this->preconditioner[index];
+         this->w[index] = this->w2[index] = ElementType(0);
+      }
+      const ElementType beta1 = std::sqrt(MINRESSolver::dot(this->r1, this->y, dimension));
+      if (beta1 == ElementType(0)) {
+         this->relative_residual = ElementType(0);
+         this->converged = true;
+         return;
+      }
+      this->relative_residual = ElementType(1);
+
+      constexpr ElementType machine_epsilon = std::numeric_limits<ElementType>::epsilon();
+      ElementType old_beta = ElementType(0);
+      ElementType beta = beta1;
+      ElementType delta_bar = ElementType(0);
+      ElementType epsilon = ElementType(0);
+      ElementType phi_bar = beta1;
+      ElementType cs = ElementType(-1);
+      ElementType sn = ElementType(0);
+      while (this->number_iterations < this->max_iterations) {
+         this->number_iterations++;
+         // Lanczos step
+         for (size_t index: Range(dimension)) {
+            this->v[index] = this->y[index] / beta;
+         }
+         MINRESSolver::product(matrix, this->v, this->y, dimension);
+         if (2 <= this->number_iterations) {
+            for (size_t index: Range(dimension)) {
+               this->y[index] -= (beta / old_beta) * this->r1[index];
+            }
+         }
+         const ElementType alpha = MINRESSolver::dot(this->v, this->y, dimension);
+         for (size_t index: Range(dimension)) {
+            this->y[index] -= (alpha / beta) * this->r2[index];
+            this->r1[index] = this->r2[index];
+            this->r2[index] = this->y[index];
+            this->y[index] = this->r2[index] / this->preconditioner[index];
+         }
+         old_beta = beta;
+         beta = std::sqrt(std::max(ElementType(0), MINRESSolver::dot(this->r2, this->y, dimension)));
+
+         // apply the previous rotation, then compute and apply the new one
+         const ElementType old_epsilon = epsilon;
+         const ElementType delta = cs * delta_bar + sn * alpha;
+         const ElementType gamma_bar = sn * delta_bar - cs * alpha;
+         epsilon = sn * beta;
+         delta_bar = -cs * beta;
+         const ElementType gamma = std::hypot(gamma_bar, beta);
+         if (gamma <= machine_epsilon) {
+            // the matrix is singular and the system is inconsistent
+            DEBUG << "MINRES: breakdown (singular matrix)\n";
+            break;
+         }
+         cs = gamma_bar / gamma;
+         sn = beta / gamma;
+         const ElementType phi = cs * phi_bar;
+         phi_bar = sn * phi_bar;
+
+         // update the solution
+         for (size_t index: Range(dimension)) {
+            this->w1[index] = this->w2[index];
+            this->w2[index] = this->w[index];
+            this->w[index] = (this->v[index] - old_epsilon * this->w1[index] - delta * this->w2[index]) / gamma;
+            result[index] += phi * this->w[index];
+         }
+         this->relative_residual = phi_bar / beta1;
+         if (this->relative_residual <= this->relative_tolerance) {
+            this->converged = true;
+            break;
+         }
+         // breakdown: the Krylov subspace is invariant
+         if (beta == ElementType(0)) {
+            break;
+         }
+      }
+      DEBUG << "MINRES: " << this->number_iterations << " iterations, relative residual " << this->relative_residual << '\n';
+      if (!this->converged) {
+         WARNING << "MINRES did not converge: relative residual " << this->relative_residual << " after " << this->number_iterations <<
+            " iterations\n";
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void MINRESSolver<IndexType, ElementType>::compute_preconditioner(const SymmetricMatrix<IndexType, ElementType>& matrix, size_t dimension) {
+      const size_t primal_dimension = (this->primal_block_dimension == 0) ? dimension : std::min(this->primal_block_dimension, dimension);
+      for (size_t index: Range(dimension)) {
+         this->preconditioner[index] = ElementType(0);
+      }
+      // diagonal of the matrix (primal block: D)
+      matrix.for_each([&](size_t row_index, size_t column_index, ElementType element) {
+         if (row_index == column_index) {
+            this->preconditioner[row_index] += element;
+         }
+      });
+      for (size_t index: Range(dimension)) {
+         this->preconditioner[index] = std::abs(this->preconditioner[index]);
+      }
+      for (size_t index: Range(primal_dimension)) {
+         this->preconditioner[index] = this->safeguard(this->preconditioner[index]);
+      }
+      // dual block: diagonal of J |D|^{-1} J^T (plus the dual regularization)
+      matrix.for_each([&](size_t row_index, size_t column_index, ElementType element) {
+         const size_t dual_index = std::max(row_index, column_index);
+         const size_t primal_index = std::min(row_index, column_index);
+         if (primal_dimension <= dual_index && primal_index < primal_dimension) {
+            this->preconditioner[dual_index] += element * element / this->preconditioner[primal_index];
+         }
+      });
+      for (size_t index: Range(primal_dimension, dimension)) {
+         this->preconditioner[index] = this->safeguard(this->preconditioner[index]);
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void MINRESSolver<IndexType, ElementType>::product(const SymmetricMatrix<IndexType, ElementType>& matrix, const Vector<ElementType>& x,
+         Vector<ElementType>& result, size_t dimension) {
+      for (size_t index: Range(dimension)) {
+         result[index] = ElementType(0);
+      }
+      matrix.for_each([&](size_t row_index, size_t column_index, ElementType element) {
+         result[row_index] += element * x[column_index];
+         if (row_index != column_index) {
+            result[column_index] += element * x[row_index];
+         }
+      });
+   }
+
+   template <typename IndexType, typename ElementType>
+   ElementType MINRESSolver<IndexType, ElementType>::dot(const Vector<ElementType>& x, const Vector<ElementType>& y, size_t dimension) {
+      ElementType result = ElementType(0);
+      for (size_t index: Range(dimension)) {
+         result += x[index] * y[index];
+      }
+      return result;
+   }
+} // namespace
+
+#endif // UNO_MINRESSOLVER_H
@@ -1,29 +1,81 @@
 // Copyright (c) 2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
 #include "MUMPSSolver.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
-#if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
-#include "mpi.h"
-#endif
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
 
 #define USE_COMM_WORLD (-987654)
 
 namespace uno {
-   MUMPSSolver::MUMPSSolver(size_t dimension, size_t number_nonzeros) : DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension) {
-      this->row_indices.reserve(number_nonzeros);
-      this->column_indices.reserve(number_nonzeros);
+#if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
+   // MPI is initialized by the first MUMPS instance (unless the application did it) and finalized upon exit
+   static void initialize_MPI() {
+      int is_initialized = 0;
+      MPI_Initialized(&is_initialized);
+      if (!is_initialized) {
+         MPI_Init(nullptr, nullptr);
+         std::atexit([]() {
+            int is_finalized = 0;
+            MPI_Finalized(&is_finalized);
+            if (!is_finalized) {
+               MPI_Finalize();
+            }
+         });
+      }
+   }
+#endif
 
+   // the counts that exceed the range of int are reported as -(count in millions)
+   static size_t mumps_count(int value) {
+      return (value < 0) ? static_cast<size_t>(-static_cast<long long>(value)) * 1000000 : static_cast<size_t>(value);
+   }
+
+   template <typename IndexType, typename ElementType>
+   MUMPSSolver<IndexType, ElementType>::MUMPSSolver(size_t dimension, size_t /*number_nonzeros*/, const Options& options) :
+         DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>(dimension),
+         distributed_entry(options.get_bool("MUMPS_distributed_entry")),
+         out_of_core_mode(MUMPSSolver::get_out_of_core_mode(options.get_string("MUMPS_out_of_core"))),
+         memory_budget(options.get_int("MUMPS_memory_budget")) {
+      if (this->memory_budget < 0) {
+         throw std::invalid_argument("The option MUMPS_memory_budget should be non-negative");
+      }
       this->mumps_structure.sym = MUMPSSolver::GENERAL_SYMMETRIC;
+      // PAR = 1: the host also takes part in the factorization and the solve
+      this->mumps_structure.par = options.get_bool("MUMPS_host_participates") ? 1 : 0;
+      const std::string& communicator_name = options.get_string("MUMPS_communicator");
 #if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
-      // TODO load number of processes from option file
-      this->mumps_structure.par = 1;
+      initialize_MPI();
+      if (communicator_name == "world") {
+         this->communicator = MPI_COMM_WORLD;
+      }
+      else if (communicator_name == "self") {
+         this->communicator = MPI_COMM_SELF;
+      }
+      else {
+         throw std::invalid_argument("The MUMPS communicator " + communicator_name + " is unknown");
+      }
+      MPI_Comm_rank(this->communicator, &this->process_rank);
+      MPI_Comm_size(this->communicator, &this->number_processes);
+      this->mumps_structure.comm_fortran = static_cast<MUMPS_INT>(MPI_Comm_c2f(this->communicator));
 #else
-      this->mumps_structure.par = 1;
+      // sequential MUMPS: a single process
+      if (communicator_name != "world" && communicator_name != "self") {
+         throw std::invalid_argument("The MUMPS communicator " + communicator_name + " is unknown");
+      }
+      this->mumps_structure.comm_fortran = USE_COMM_WORLD;
 #endif
+      if (this->mumps_structure.par == 0 && this->number_processes == 1) {
+         throw std::invalid_argument("MUMPS_host_participates = no requires at least two MPI processes");
+      }
       this->mumps_structure.job = MUMPSSolver::JOB_INIT;
-      this->mumps_structure.comm_fortran = USE_COMM_WORLD;
-      dmumps_c(&this->mumps_structure);
+      MUMPSArithmetic<ElementType>::call(this->mumps_structure);
       // control parameters
       this->mumps_structure.icntl[0] = -1;
       this->mumps_structure.icntl[1] = -1;
@@ -34,6 +86,20 @@ namespace uno {
 
       this->mumps_structure.icntl[12] = 1;
       this->mumps_structure.icntl[23] = 1; // ICNTL(24) controls the detection of “null pivot rows”
+      this->mumps_structure.icntl[6] = MUMPSSolver::get_ordering(options.get_string("MUMPS_ordering")); // ICNTL(7): sequential ordering
+      // ICNTL(16): number of OpenMP threads (0: those of the thread pool, or OMP_NUM_THREADS without pool)
+      this->mumps_structure.icntl[15] = ThreadPool::linear_solver_threads(options, "MUMPS_threads");
+      // ICNTL(48): the tree parallelism with OpenMP distributes the subtrees dynamically among the threads. It is disabled in
+      // deterministic mode (the nodes are still factorized by multithreaded BLAS)
+      if (options.get_bool("deterministic")) {
+         this->mumps_structure.icntl[47] = 0;
+      }
+      this->mumps_structure.icntl[17] = this->distributed_entry ? MUMPSSolver::DISTRIBUTED_ENTRY : MUMPSSolver::CENTRALIZED_ENTRY; // ICNTL(18)
+      this->pivoting_threshold = this->mumps_structure.cntl[0];
+      // ICNTL(22): in-core (0) or out-of-core (1) factorization. ICNTL(23): maximum working memory in MB per process
+      this->mumps_structure.icntl[21] = (this->out_of_core_mode == OutOfCoreMode::YES) ? 1 : 0;
+      this->mumps_structure.icntl[22] = this->memory_budget;
+      this->set_out_of_core_directory(options.get_string("MUMPS_ooc_directory"));
 
       /*
       // debug for MUMPS team
@@ -41,75 +107,219 @@ namespace uno {
       this->mumps_structure.icntl[2] = 6; // ICNTL(3)=6
       this->mumps_structure.icntl[3] = 6; // ICNTL(4)=2
        */
+   }
 
-      this->row_indices.reserve(number_nonzeros);
-      this->column_indices.reserve(number_nonzeros);
+   // CNTL(1) = 0: no numerical pivoting, the numerical factorization follows the pivot order of the analysis
+   template <typename IndexType, typename ElementType>
+   void MUMPSSolver<IndexType, ElementType>::set_static_pivoting(bool static_pivoting) {
+      this->mumps_structure.cntl[0] = static_pivoting ? ElementType(0) : this->pivoting_threshold;
    }
 
-   MUMPSSolver::~MUMPSSolver() {
+   template <typename IndexType, typename ElementType>
+   MUMPSSolver<IndexType, ElementType>::~MUMPSSolver() {
       this->mumps_structure.job = MUMPSSolver::JOB_END;
-      dmumps_c(&this->mumps_structure);
+      MUMPSArithmetic<ElementType>::call(this->mumps_structure);
    }
    
-   void MUMPSSolver::do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) {
+   template <typename IndexType, typename ElementType>
+   void MUMPSSolver<IndexType, ElementType>::do_symbolic_analysis(const SymmetricMatrix<IndexType, ElementType>& matrix) {
       this->mumps_structure.job = MUMPSSolver::JOB_ANALYSIS;
       this->mumps_structure.n = static_cast<int>(matrix.dimension());
       this->mumps_structure.nnz = static_cast<int>(matrix.number_nonzeros());
       this->mumps_structure.a = nullptr;
-      this->save_sparsity_to_local_format(matrix);
-      // connect the local sparsity with the pointers in the structure
-      this->mumps_structure.irn = this->row_indices.data();
-      this->mumps_structure.jcn = this->column_indices.data();
+      // borrow the sparsity pattern of the matrix, or build the internal matrix representation
+      this->indices.save(matrix);
+      // connect the sparsity with the pointers in the structure
+      this->set_local_entries(matrix);
       this->mumps_structure.a = nullptr;
-      dmumps_c(&this->mumps_structure);
+      this->mumps_structure.a_loc = nullptr;
+      MUMPSArithmetic<ElementType>::call(this->mumps_structure);
       this->mumps_structure.icntl[7] = 8; // ICNTL(8) = 8: recompute scaling before factorization
+      // INFOG(20): estimated number of entries in the factors
+      this->factorization_statistics.record_analysis(matrix.number_nonzeros(), mumps_count(this->mumps_structure.infog[19]));
+
+      // switch to the out-of-core factorization if the in-core estimate of the factorization (INFOG(16), in MB, maximum over the
+      // processes) exceeds the budget
+      if (this->out_of_core_mode == OutOfCoreMode::AUTOMATIC && 0 < this->memory_budget) {
+         const int in_core_estimate = this->mumps_structure.infog[15];
+         this->mumps_structure.icntl[21] = (this->memory_budget < in_core_estimate) ? 1 : 0;
+         if (this->mumps_structure.icntl[21] == 1) {
+            DEBUG << "MUMPS: the in-core estimate " << in_core_estimate << " MB exceeds the memory budget " << this->memory_budget <<
+               " MB, switching to the out-of-core factorization\n";
+            // INFOG(26): out-of-core estimate (maximum over the processes)
+            if (this->memory_budget < this->mumps_structure.infog[25]) {
+               WARNING << "MUMPS: the out-of-core estimate " << this->mumps_structure.infog[25] << " MB exceeds the memory budget " <<
+                  this->memory_budget << " MB\n";
+            }
+         }
+      }
    }
 
-   void MUMPSSolver::do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) {
+   template <typename IndexType, typename ElementType>
+   void MUMPSSolver<IndexType, ElementType>::do_numerical_factorization(const SymmetricMatrix<IndexType, ElementType>& matrix) {
       this->mumps_structure.job = MUMPSSolver::JOB_FACTORIZATION;
-      this->mumps_structure.a = const_cast<double*>(matrix.data_pointer());
-      dmumps_c(&this->mumps_structure);
+      // the arrays are also accessed during the factorization (scaling)
+      this->indices.update_pointers(matrix);
+      this->set_local_entries(matrix);
+      MUMPSArithmetic<ElementType>::call(this->mumps_structure);
+      // INFOG(29): entries in the factors, RINFOG(3): flops of the elimination, INFOG(22): memory used by the factorization (in MB),
+      // INFOG(13): delayed pivots
+      this->factorization_statistics.record_factorization(mumps_count(this->mumps_structure.infog[28]),
+         static_cast<double>(this->mumps_structure.rinfog[2]), static_cast<size_t>(this->mumps_structure.infog[21]) * 1000000,
+         static_cast<size_t>(this->mumps_structure.infog[12]), 0, 0);
    }
 
-   void MUMPSSolver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& /*matrix*/, const Vector<double>& rhs, Vector<double>& result) {
+   template <typename IndexType, typename ElementType>
+   void MUMPSSolver<IndexType, ElementType>::solve_indefinite_system(const SymmetricMatrix<IndexType, ElementType>& /*matrix*/, const Vector<ElementType>& rhs, Vector<ElementType>& result) {
       result = rhs;
+      // the right-hand side and the solution are centralized on the host
+      this->mumps_structure.rhs = result.data();
+      this->mumps_structure.job = MUMPSSolver::JOB_SOLVE;
+      MUMPSArithmetic<ElementType>::call(this->mumps_structure);
+#if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
+      // all the processes run the same optimization: broadcast the solution
+      if (1 < this->number_processes) {
+         MPI_Bcast(result.data(), static_cast<int>(result.size()), MUMPSArithmetic<ElementType>::mpi_type(), 0, this->communicator);
+      }
+#endif
+   }
+
+   template <typename IndexType, typename ElementType>
+   void MUMPSSolver<IndexType, ElementType>::solve_indefinite_systems(const SymmetricMatrix<IndexType, ElementType>& /*matrix*/, const Vector<ElementType>& rhs,
+         Vector<ElementType>& result, size_t number_rhs) {
+      const size_t block_size = static_cast<size_t>(this->mumps_structure.n) * number_rhs;
+      std::copy(rhs.data(), rhs.data() + block_size, result.data());
+      // the column-major rhs block and the solutions are centralized on the host
       this->mumps_structure.rhs = result.data();
+      this->mumps_structure.nrhs = static_cast<int>(number_rhs);
+      this->mumps_structure.lrhs = this->mumps_structure.n;
       this->mumps_structure.job = MUMPSSolver::JOB_SOLVE;
-      dmumps_c(&this->mumps_structure);
+      MUMPSArithmetic<ElementType>::call(this->mumps_structure);
+      this->mumps_structure.nrhs = 1;
+#if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
+      // all the processes run the same optimization: broadcast the solutions
+      if (1 < this->number_processes) {
+         MPI_Bcast(result.data(), static_cast<int>(block_size), MUMPSArithmetic<ElementType>::mpi_type(), 0, this->communicator);
+      }
+#endif
    }
 
-   std::tuple<size_t, size_t, size_t> MUMPSSolver::get_inertia() const {
+   template <typename IndexType, typename ElementType>
+   std::tuple<size_t, size_t, size_t> MUMPSSolver<IndexType, ElementType>::get_inertia() const {
       const size_t number_negative_eigenvalues = this->number_negative_eigenvalues();
       const size_t number_zero_eigenvalues = this->number_zero_eigenvalues();
       const size_t number_positive_eigenvalues = static_cast<size_t>(this->mumps_structure.n) - (number_negative_eigenvalues + number_zero_eigenvalues);
       return std::make_tuple(number_positive_eigenvalues, number_negative_eigenvalues, number_zero_eigenvalues);
    }
 
-   size_t MUMPSSolver::number_negative_eigenvalues() const {
+   template <typename IndexType, typename ElementType>
+   size_t MUMPSSolver<IndexType, ElementType>::number_negative_eigenvalues() const {
       // INFOG(12)
       return static_cast<size_t>(this->mumps_structure.infog[11]);
    }
 
-   size_t MUMPSSolver::number_zero_eigenvalues() const {
+   template <typename IndexType, typename ElementType>
+   size_t MUMPSSolver<IndexType, ElementType>::number_zero_eigenvalues() const {
       // INFOG(28)
       return static_cast<size_t>(this->mumps_structure.infog[27]);
    }
 
-   bool MUMPSSolver::matrix_is_singular() const {
+   template <typename IndexType, typename ElementType>
+   bool MUMPSSolver<IndexType, ElementType>::matrix_is_singular() const {
       return (this->number_zero_eigenvalues() > 0);
    }
 
-   size_t MUMPSSolver::rank() const {
+   template <typename IndexType, typename ElementType>
+   size_t MUMPSSolver<IndexType, ElementType>::rank() const {
       return this->dimension - this->number_zero_eigenvalues();
    }
 
-   void MUMPSSolver::save_sparsity_to_local_format(const SymmetricMatrix<size_t, double>& matrix) {
-      // build the internal matrix representation
-      this->row_indices.clear();
-      this->column_indices.clear();
-      for (const auto [row_index, column_index, _]: matrix) {
-         this->row_indices.emplace_back(static_cast<int>(row_index + this->fortran_shift));
-         this->column_indices.emplace_back(static_cast<int>(column_index + this->fortran_shift));
+   template <typename IndexType, typename ElementType>
+   void MUMPSSolver<IndexType, ElementType>::set_local_entries(const SymmetricMatrix<IndexType, ElementType>& matrix) {
+      ElementType* entries = const_cast<ElementType*>(matrix.data_pointer());
+      if (this->distributed_entry) {
+         // contiguous slice of the nonzeros owned by the current process. With PAR = 0, MUMPS ignores the local entries of the host
+         // (rank 0): the nonzeros are split among the workers only
+         const size_t number_nonzeros = matrix.number_nonzeros();
+         const size_t first_worker = (this->mumps_structure.par == 0) ? 1 : 0;
+         const size_t number_workers = static_cast<size_t>(this->number_processes) - first_worker;
+         const size_t process_rank = static_cast<size_t>(this->process_rank);
+         size_t start = 0;
+         size_t end = 0;
+         if (first_worker <= process_rank) {
+            const size_t worker_rank = process_rank - first_worker;
+            start = (worker_rank * number_nonzeros) / number_workers;
+            end = ((worker_rank + 1) * number_nonzeros) / number_workers;
+         }
+         this->mumps_structure.nnz_loc = static_cast<MUMPS_INT8>(end - start);
+         this->mumps_structure.irn_loc = this->indices.row_indices() + start;
+         this->mumps_structure.jcn_loc = this->indices.column_indices() + start;
+         this->mumps_structure.a_loc = entries + start;
+      }
+      else {
+         this->mumps_structure.irn = this->indices.row_indices();
+         this->mumps_structure.jcn = this->indices.column_indices();
+         this->mumps_structure.a = entries;
       }
    }
+
+   // OOC_TMPDIR (set before the analysis). An empty directory leaves the MUMPS default
+   template <typename IndexType, typename ElementType>
+   void MUMPSSolver<IndexType, ElementType>::set_out_of_core_directory(const std::string& directory) {
+      if (!directory.empty()) {
+         if (sizeof(this->mumps_structure.ooc_tmpdir) <= directory.size()) {
+            throw std::invalid_argument("The MUMPS out-of-core directory " + directory + " is too long");
+         }
+         std::strncpy(this->mumps_structure.ooc_tmpdir, directory.c_str(), sizeof(this->mumps_structure.ooc_tmpdir) - 1);
+         this->mumps_structure.ooc_tmpdir[sizeof(this->mumps_structure.ooc_tmpdir) - 1] = '\0';
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   OutOfCoreMode MUMPSSolver<IndexType, ElementType>::get_out_of_core_mode(const std::string& out_of_core) {
+      if (out_of_core == "no") {
+         return OutOfCoreMode::NO;
+      }
+      else if (out_of_core == "yes") {
+         return OutOfCoreMode::YES;
+      }
+      else if (out_of_core == "automatic") {
+         return OutOfCoreMode::AUTOMATIC;
+      }
+      throw std::invalid_argument("The MUMPS out-of-core mode " + out_of_core + " is unknown (no|yes|automatic)");
+   }
+
+   template <typename IndexType, typename ElementType>
+   int MUMPSSolver<IndexType, ElementType>::get_ordering(const std::string& ordering_name) {
+      // ICNTL(7)
+      if (ordering_name == "AMD") {
+         return 0;
+      }
+      else if (ordering_name == "AMF") {
+         return 2;
+      }
+      else if (ordering_name == "SCOTCH") {
+         return 3;
+      }
+      else if (ordering_name == "PORD") {
+         return 4;
+      }
+      else if (ordering_name == "METIS") {
+         return 5;
+      }
+      else if (ordering_name == "QAMD") {
+         return 6;
+      }
+      else if (ordering_name == "automatic") {
+         return 7;
+      }
+      throw std::invalid_argument("The MUMPS ordering " + ordering_name + " is unknown");
+   }
+
+   template class MUMPSSolver<size_t, double>;
+   template class MUMPSSolver<int, double>;
+#ifdef HAS_SMUMPS
+   template class MUMPSSolver<size_t, float>;
+   template class MUMPSSolver<int, float>;
+#endif
 } // namespace
@@ -4,19 +4,62 @@
 #ifndef UNO_MUMPSSOLVER_H
 #define UNO_MUMPSSOLVER_H
 
+#include <string>
 #include <vector>
 #include "../DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "../FortranIndices.hpp"
 #include "dmumps_c.h"
+#ifdef HAS_SMUMPS
+#include "smumps_c.h"
+#endif
+#if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
+#include "mpi.h"
+#endif
 
 namespace uno {
-   class MUMPSSolver : public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+   // forward declaration
+   class Options;
+
+   // MUMPS arithmetic of an element type: structure and driver (dmumps_c for double, smumps_c for float)
+   template <typename ElementType>
+   struct MUMPSArithmetic;
+
+   template <>
+   struct MUMPSArithmetic<double> {
+      using Structure = DMUMPS_STRUC_C;
+      static void call(Structure& structure) { dmumps_c(&structure); }
+#if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
+      static MPI_Datatype mpi_type() { return MPI_DOUBLE; }
+#endif
+   };
+
+#ifdef HAS_SMUMPS
+   template <>
+   struct MUMPSArithmetic<float> {
+      using Structure = SMUMPS_STRUC_C;
+      static void call(Structure& structure) { smumps_c(&structure); }
+#if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
+      static MPI_Datatype mpi_type() { return MPI_FLOAT; }
+#endif
+   };
+#endif
+
+   enum class OutOfCoreMode {NO, YES, AUTOMATIC};
+
+   // the sparsity pattern of a COO matrix with 1-based int indices is passed without copy (see FortranIndices).
+   // The single-precision solver (ElementType = float) is available if the smumps library was found
+   template <typename IndexType = size_t, typename ElementType = double>
+   class MUMPSSolver : public DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType> {
    public:
-      explicit MUMPSSolver(size_t dimension, size_t number_nonzeros);
+      MUMPSSolver(size_t dimension, size_t number_nonzeros, const Options& options);
       ~MUMPSSolver() override;
 
-      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& matrix) override;
-      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
-      void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, ElementType>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, ElementType>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, ElementType>& matrix, const Vector<ElementType>& rhs, Vector<ElementType>& result) override;
+      void solve_indefinite_systems(const SymmetricMatrix<IndexType, ElementType>& matrix, const Vector<ElementType>& rhs, Vector<ElementType>& result,
+            size_t number_rhs) override;
+      void set_static_pivoting(bool static_pivoting) override;
 
       [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
       [[nodiscard]] size_t number_negative_eigenvalues() const override;
@@ -24,13 +67,27 @@ namespace uno {
       // [[nodiscard]] bool matrix_is_positive_definite() const override;
       [[nodiscard]] bool matrix_is_singular() const override;
       [[nodiscard]] size_t rank() const override;
+      [[nodiscard]] size_t memory_size() const override { return this->indices.memory_size(); }
 
    protected:
-      DMUMPS_STRUC_C mumps_structure{};
+      typename MUMPSArithmetic<ElementType>::Structure mumps_structure{};
+
+      // matrix sparsity (borrowed from the matrix if possible)
+      FortranIndices<IndexType, ElementType> indices{};
 
-      // matrix sparsity
-      std::vector<int> row_indices{};
-      std::vector<int> column_indices{};
+      // parallelism
+#if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
+      MPI_Comm communicator{MPI_COMM_WORLD};
+#endif
+      int process_rank{0};
+      int number_processes{1};
+      // distributed matrix entry (ICNTL(18) = 3): each process provides a contiguous slice of the nonzeros
+      const bool distributed_entry;
+      // default value of CNTL(1) (relative threshold of the numerical pivoting), restored when static pivoting is disabled
+      ElementType pivoting_threshold{};
+      // out-of-core factorization (ICNTL(22)): always, or when the in-core estimate (INFOG(16)) exceeds the budget
+      const OutOfCoreMode out_of_core_mode;
+      const int memory_budget; /*!< in MB per process (0: no budget) */
 
       static const int JOB_INIT = -1;
       static const int JOB_END = -2;
@@ -39,9 +96,13 @@ namespace uno {
       static const int JOB_SOLVE = 3;
 
       static const int GENERAL_SYMMETRIC = 2;
+      static const int CENTRALIZED_ENTRY = 0;
+      static const int DISTRIBUTED_ENTRY = 3;
 
-      const size_t fortran_shift{1};
-      void save_sparsity_to_local_format(const SymmetricMatrix<size_t, double>& matrix);
+      void set_local_entries(const SymmetricMatrix<IndexType, ElementType>& matrix);
+      void set_out_of_core_directory(const std::string& directory);
+      [[nodiscard]] static int get_ordering(const std::string& ordering_name);
+      [[nodiscard]] static OutOfCoreMode get_out_of_core_mode(const std::string& out_of_core);
    };
 } // namespace
 
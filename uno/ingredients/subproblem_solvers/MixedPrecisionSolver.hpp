@@ -0,0 +1,110 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MIXEDPRECISIONSOLVER_H
+#define UNO_MIXEDPRECISIONSOLVER_H
+
+#include <memory>
+#include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   /*! \class MixedPrecisionSolver
+    * \brief Double-precision interface to a single-precision linear solver
+    *
+    *  The matrix is rounded to single precision and factorized by the single-precision solver. The loss of accuracy of the
+    *  solutions is recovered by the double-precision iterative refinement of SymmetricIndefiniteLinearSystem::solve
+    */
+   template <typename IndexType>
+   class MixedPrecisionSolver: public DirectSymmetricIndefiniteLinearSolver<IndexType, double> {
+   public:
+      MixedPrecisionSolver(size_t dimension, size_t number_nonzeros,
+            std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, float>> single_precision_solver);
+      ~MixedPrecisionSolver() override = default;
+
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void set_static_pivoting(bool static_pivoting) override { this->single_precision_solver->set_static_pivoting(static_pivoting); }
+
+      [[nodiscard]] bool provides_inertia() const override { return this->single_precision_solver->provides_inertia(); }
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override { return this->single_precision_solver->get_inertia(); }
+      [[nodiscard]] size_t number_negative_eigenvalues() const override { return this->single_precision_solver->number_negative_eigenvalues(); }
+      [[nodiscard]] bool matrix_is_singular() const override { return this->single_precision_solver->matrix_is_singular(); }
+      [[nodiscard]] size_t rank() const override { return this->single_precision_solver->rank(); }
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const override {
+         return this->single_precision_solver->get_factorization_statistics();
+      }
+
+   protected:
+      const size_t number_nonzeros;
+      const std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, float>> single_precision_solver;
+      std::unique_ptr<SymmetricMatrix<IndexType, float>> single_precision_matrix{};
+      Vector<float> single_precision_rhs;
+      Vector<float> single_precision_result;
+
+      void round_values(const SymmetricMatrix<IndexType, double>& matrix);
+   };
+
+   // implementation
+
+   template <typename IndexType>
+   MixedPrecisionSolver<IndexType>::MixedPrecisionSolver(size_t dimension, size_t number_nonzeros,
+         std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, float>> single_precision_solver):
+         DirectSymmetricIndefiniteLinearSolver<IndexType, double>(dimension),
+         number_nonzeros(number_nonzeros),
+         single_precision_solver(std::move(single_precision_solver)),
+         single_precision_rhs(dimension),
+         single_precision_result(dimension) {
+   }
+
+   template <typename IndexType>
+   void MixedPrecisionSolver<IndexType>::do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) {
+      // copy the sparsity pattern (COO with the same index shift, so that Fortran solvers can borrow the indices)
+      if (this->single_precision_matrix == nullptr || this->single_precision_matrix->capacity() < matrix.number_nonzeros()) {
+         this->single_precision_matrix = std::make_unique<SymmetricMatrix<IndexType, float>>(this->dimension,
+               std::max(this->number_nonzeros, matrix.number_nonzeros()), false, "COO", matrix.index_shift());
+      }
+      this->single_precision_matrix->reset();
+      this->single_precision_matrix->set_dimension(matrix.dimension());
+      matrix.for_each([&](size_t row_index, size_t column_index, double element) {
+         this->single_precision_matrix->insert(static_cast<float>(element), static_cast<IndexType>(row_index), static_cast<IndexType>(column_index));
+      });
+      this->single_precision_solver->do_symbolic_analysis(*this->single_precision_matrix);
+   }
+
+   template <typename IndexType>
+   void MixedPrecisionSolver<IndexType>::do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) {
+      this->round_values(matrix);
+      this->single_precision_solver->do_numerical_factorization(*this->single_precision_matrix);
+   }
+
+   template <typename IndexType>
+   void MixedPrecisionSolver<IndexType>::solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs,
+         Vector<double>& result) {
+      for (size_t index: Range(matrix.dimension())) {
+         this->single_precision_rhs[index] = static_cast<float>(rhs[index]);
+      }
+      this->single_precision_solver->solve_indefinite_system(*this->single_precision_matrix, this->single_precision_rhs,
+            this->single_precision_result);
+      for (size_t index: Range(matrix.dimension())) {
+         result[index] = static_cast<double>(this->single_precision_result[index]);
+      }
+   }
+
+   template <typename IndexType>
+   void MixedPrecisionSolver<IndexType>::round_values(const SymmetricMatrix<IndexType, double>& matrix) {
+      assert(this->single_precision_matrix != nullptr && "MixedPrecisionSolver: the symbolic analysis was not performed");
+      assert(this->single_precision_matrix->number_nonzeros() == matrix.number_nonzeros() && "MixedPrecisionSolver: the numbers of nonzeros do not match");
+      // the nonzeros were inserted in the traversal order of the matrix
+      float* entries = this->single_precision_matrix->data_pointer();
+      size_t nonzero_index = 0;
+      matrix.for_each([&](size_t /*row_index*/, size_t /*column_index*/, double element) {
+         entries[nonzero_index] = static_cast<float>(element);
+         nonzero_index++;
+      });
+   }
+} // namespace
+
+#endif // UNO_MIXEDPRECISIONSOLVER_H
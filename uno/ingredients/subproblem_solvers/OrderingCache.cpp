@@ -0,0 +1,73 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include "OrderingCache.hpp"
+
+namespace uno {
+   FillReducingOrdering fill_reducing_ordering_from_string(const std::string& ordering_name) {
+      if (ordering_name == "automatic") {
+         return FillReducingOrdering::AUTOMATIC;
+      }
+      else if (ordering_name == "AMD") {
+         return FillReducingOrdering::AMD;
+      }
+      else if (ordering_name == "minimum_degree") {
+         return FillReducingOrdering::MINIMUM_DEGREE;
+      }
+      else if (ordering_name == "METIS") {
+         return FillReducingOrdering::METIS;
+      }
+      else if (ordering_name == "user") {
+         return FillReducingOrdering::USER;
+      }
+      throw std::invalid_argument("The ordering " + ordering_name + " is unknown");
+   }
+
+   OrderingCache::OrderingCache(size_t capacity): capacity(capacity) {
+      this->pivot_orders.reserve(capacity);
+   }
+
+   size_t OrderingCache::pattern_key(size_t dimension, size_t number_nonzeros, const int* row_indices, const int* column_indices) {
+      // FNV-1a hash of the dimensions and the indices
+      size_t key = 14695981039346656037ULL;
+      const auto combine = [&](size_t value) {
+         key ^= value;
+         key *= 1099511628211ULL;
+      };
+      combine(dimension);
+      combine(number_nonzeros);
+      for (size_t nonzero_index = 0; nonzero_index < number_nonzeros; nonzero_index++) {
+         combine(static_cast<size_t>(row_indices[nonzero_index]));
+         combine(static_cast<size_t>(column_indices[nonzero_index]));
+      }
+      return key;
+   }
+
+   const std::vector<int>* OrderingCache::find(size_t key) const {
+      for (const auto& [cached_key, pivot_order]: this->pivot_orders) {
+         if (cached_key == key) {
+            return &pivot_order;
+         }
+      }
+      return nullptr;
+   }
+
+   void OrderingCache::insert(size_t key, std::vector<int>&& pivot_order) {
+      if (this->capacity == 0) {
+         return;
+      }
+      if (this->pivot_orders.size() == this->capacity) {
+         this->pivot_orders.erase(this->pivot_orders.begin());
+      }
+      this->pivot_orders.emplace_back(key, std::move(pivot_order));
+   }
+
+   size_t OrderingCache::size() const {
+      return this->pivot_orders.size();
+   }
+
+   void OrderingCache::clear() {
+      this->pivot_orders.clear();
+   }
+} // namespace
@@ -0,0 +1,46 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_ORDERINGCACHE_H
+#define UNO_ORDERINGCACHE_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace uno {
+   // fill-reducing orderings of the Fortran solvers (MA57, MA27)
+   enum class FillReducingOrdering {AUTOMATIC, AMD, MINIMUM_DEGREE, METIS, USER};
+
+   [[nodiscard]] FillReducingOrdering fill_reducing_ordering_from_string(const std::string& ordering_name);
+
+   /*! \class OrderingCache
+    * \brief Pivot orders computed during symbolic analyses, indexed by sparsity pattern
+    *
+    *  The same solver successively analyzes a handful of sparsity patterns (optimality phase, feasibility restoration phase,
+    *  least-square multipliers). Caching the pivot order of each pattern avoids rerunning the ordering algorithm.
+    *  A key collision is harmless: any pivot order of the right dimension is valid, only the fill-in may be worse
+    */
+   class OrderingCache {
+   public:
+      explicit OrderingCache(size_t capacity);
+
+      // key of a sparsity pattern given by its 1-based coordinate indices
+      [[nodiscard]] static size_t pattern_key(size_t dimension, size_t number_nonzeros, const int* row_indices, const int* column_indices);
+
+      // nullptr if the pattern is not cached
+      [[nodiscard]] const std::vector<int>* find(size_t key) const;
+      // the oldest order is evicted when the cache is full
+      void insert(size_t key, std::vector<int>&& pivot_order);
+
+      [[nodiscard]] size_t size() const;
+      void clear();
+
+   protected:
+      const size_t capacity;
+      std::vector<std::pair<size_t, std::vector<int>>> pivot_orders{};
+   };
+} // namespace
+
+#endif // UNO_ORDERINGCACHE_H
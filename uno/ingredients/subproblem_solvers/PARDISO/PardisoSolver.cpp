@@ -0,0 +1,212 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include "PardisoSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+
+#ifdef HAS_PANUA_PARDISO
+extern "C" {
+   void pardisoinit(void* pt, int* mtype, int* solver, int* iparm, double* dparm, int* error);
+   void pardiso(void* pt, int* maxfct, int* mnum, int* mtype, int* phase, int* n, double* a, int* ia, int* ja, int* perm, int* nrhs,
+         int* iparm, int* msglvl, double* b, double* x, int* error, double* dparm);
+}
+#else
+#include "mkl_pardiso.h"
+#include "mkl_service.h"
+
+// the int arrays are passed as MKL_INT (LP64 interface)
+static_assert(sizeof(MKL_INT) == sizeof(int), "PardisoSolver requires the LP64 interface of MKL");
+#endif
+
+namespace uno {
+   template <typename IndexType>
+   PardisoSolver<IndexType>::PardisoSolver(size_t dimension, size_t /*number_nonzeros*/, const Options& options) :
+         DirectSymmetricIndefiniteLinearSolver<IndexType, double>(dimension) {
+      int matrix_type = PardisoSolver::REAL_SYMMETRIC_INDEFINITE;
+      // 0: the threads of the thread pool, or the default of PARDISO without pool
+      const int number_threads = ThreadPool::linear_solver_threads(options, "PARDISO_threads");
+      // default values of the parameters
+#ifdef HAS_PANUA_PARDISO
+      int solver = 0; // sparse direct solver
+      int error = 0;
+      pardisoinit(this->handle.data(), &matrix_type, &solver, this->iparm.data(), this->dparm.data(), &error);
+      if (error != 0) {
+         throw std::runtime_error("Panua Pardiso could not be initialized (error " + std::to_string(error) + ")");
+      }
+      // IPARM(3): number of threads (required by Panua Pardiso)
+      this->iparm[2] = (0 < number_threads) ? number_threads : this->iparm[2];
+#else
+      pardisoinit(this->handle.data(), &matrix_type, this->iparm.data());
+      // the threads are shared by the MKL functions of the calling thread (0: MKL default)
+      if (0 < number_threads) {
+         mkl_set_num_threads_local(number_threads);
+      }
+#endif
+      this->iparm[0] = 1; // IPARM(1): no default values
+      this->iparm[1] = PardisoSolver::get_ordering(options.get_string("PARDISO_ordering")); // IPARM(2): fill-in reducing ordering
+      this->iparm[7] = 0; // IPARM(8): no iterative refinement (performed by Uno)
+      this->iparm[9] = 8; // IPARM(10): pivots perturbed by 1e-8
+      // IPARM(11), IPARM(13): no scaling and no weighted matching, so that the analysis does not depend on the values
+      this->iparm[10] = 0;
+      this->iparm[12] = 0;
+      this->iparm[17] = -1; // IPARM(18): report the number of nonzeros of the factors
+      this->iparm[18] = -1; // IPARM(19): report the MFlops of the factorization
+      this->iparm[20] = 1; // IPARM(21): Bunch-Kaufman pivoting (1x1 and 2x2 pivots)
+      this->iparm[23] = 0; // IPARM(24): classic factorization (reports the inertia)
+      this->iparm[26] = 0; // IPARM(27): no matrix checker
+      this->iparm[34] = 0; // IPARM(35): 1-based indices
+#ifndef HAS_PANUA_PARDISO
+      // conditional numerical reproducibility: bit-identical factors with the same number of threads. The parallel nested dissection
+      // is not reproducible
+      if (options.get_bool("deterministic")) {
+         if (this->iparm[1] == 3) {
+            throw std::invalid_argument("The PARDISO ordering parallel_METIS is not deterministic");
+         }
+         this->iparm[33] = (0 < number_threads) ? number_threads : mkl_get_max_threads(); // IPARM(34): number of threads in CNR mode
+         // the CNR mode of MKL is global and can only be set before the first MKL computation
+         if (mkl_cbwr_set(MKL_CBWR_AUTO) != MKL_CBWR_SUCCESS) {
+            WARNING << "The conditional numerical reproducibility of MKL could not be enabled\n";
+         }
+      }
+#endif
+   }
+
+   template <typename IndexType>
+   PardisoSolver<IndexType>::~PardisoSolver() {
+      if (this->is_analyzed) {
+         // release the internal memory
+         this->call(PardisoSolver::PHASE_RELEASE, 1, nullptr, nullptr);
+      }
+   }
+
+   template <typename IndexType>
+   void PardisoSolver<IndexType>::do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "PardisoSolver: the dimension of the matrix is larger than the preallocated size");
+
+      // discard the previous analysis and factorization
+      if (this->is_analyzed) {
+         this->call(PardisoSolver::PHASE_RELEASE, 1, nullptr, nullptr);
+         this->is_analyzed = false;
+      }
+      this->csr_matrix.analyze(matrix);
+      this->csr_matrix.update_values(matrix);
+      this->n = static_cast<int>(matrix.dimension());
+      // IPARM(18) and IPARM(19) are reported if they are negative on entry
+      this->iparm[17] = this->iparm[18] = -1;
+      this->call(PardisoSolver::PHASE_ANALYSIS, 1, nullptr, nullptr);
+      this->is_analyzed = true;
+      this->factorization_statistics.record_analysis(matrix.number_nonzeros(), static_cast<size_t>(this->iparm[17]));
+   }
+
+   template <typename IndexType>
+   void PardisoSolver<IndexType>::do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) {
+      assert(this->is_analyzed && "PardisoSolver: the symbolic analysis was not performed");
+      assert(this->n == static_cast<int>(matrix.dimension()) && "PardisoSolver: the dimensions do not match");
+
+      // scatter the values into the CSR arrays of the analysis
+      this->csr_matrix.update_values(matrix);
+      // a failed factorization reports no nonzero eigenvalue (singular matrix)
+      this->iparm[21] = this->iparm[22] = 0;
+      this->call(PardisoSolver::PHASE_NUMERICAL_FACTORIZATION, 1, nullptr, nullptr);
+      // IPARM(15): peak memory of the analysis, IPARM(16) + IPARM(17): permanent and factorization memory (in KB)
+      const size_t peak_memory = static_cast<size_t>(std::max(this->iparm[14], this->iparm[15] + this->iparm[16])) * 1024;
+      this->peak_workspace_size = std::max(this->peak_workspace_size, peak_memory);
+      // IPARM(18): nonzeros of the factors, IPARM(19): MFlops of the factorization, IPARM(14): perturbed pivots
+      this->factorization_statistics.record_factorization(static_cast<size_t>(this->iparm[17]), 1e6 * static_cast<double>(this->iparm[18]),
+         peak_memory, 0, static_cast<size_t>(this->iparm[13]), 0);
+   }
+
+   template <typename IndexType>
+   void PardisoSolver<IndexType>::solve_indefinite_system(const SymmetricMatrix<IndexType, double>& /*matrix*/, const Vector<double>& rhs,
+         Vector<double>& result) {
+      this->call(PardisoSolver::PHASE_SOLVE, 1, const_cast<double*>(rhs.data()), result.data());
+   }
+
+   template <typename IndexType>
+   void PardisoSolver<IndexType>::solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& /*matrix*/, const Vector<double>& rhs,
+         Vector<double>& result, size_t number_rhs) {
+      // the column-major rhs block is solved at once
+      this->call(PardisoSolver::PHASE_SOLVE, static_cast<int>(number_rhs), const_cast<double*>(rhs.data()), result.data());
+   }
+
+   template <typename IndexType>
+   std::tuple<size_t, size_t, size_t> PardisoSolver<IndexType>::get_inertia() const {
+      // IPARM(22): number of positive eigenvalues, IPARM(23): number of negative eigenvalues. The zero pivots are perturbed
+      const size_t number_positive_eigenvalues = static_cast<size_t>(this->iparm[21]);
+      const size_t number_negative_eigenvalues = this->number_negative_eigenvalues();
+      const size_t number_zero_eigenvalues = static_cast<size_t>(this->n) - (number_positive_eigenvalues + number_negative_eigenvalues);
+      return std::make_tuple(number_positive_eigenvalues, number_negative_eigenvalues, number_zero_eigenvalues);
+   }
+
+   template <typename IndexType>
+   size_t PardisoSolver<IndexType>::number_negative_eigenvalues() const {
+      return static_cast<size_t>(this->iparm[22]);
+   }
+
+   template <typename IndexType>
+   bool PardisoSolver<IndexType>::matrix_is_singular() const {
+      // IPARM(14): number of perturbed pivots
+      return (0 < this->iparm[13] || 0 < std::get<2>(this->get_inertia()));
+   }
+
+   template <typename IndexType>
+   size_t PardisoSolver<IndexType>::rank() const {
+      return static_cast<size_t>(this->n) - std::get<2>(this->get_inertia());
+   }
+
+   template <typename IndexType>
+   void PardisoSolver<IndexType>::call(int phase, int number_rhs, double* rhs, double* solution) {
+      int maximum_number_factors = 1;
+      int matrix_number = 1;
+      int matrix_type = PardisoSolver::REAL_SYMMETRIC_INDEFINITE;
+      int message_level = 0;
+      int error = 0;
+      int* permutation = nullptr;
+#ifdef HAS_PANUA_PARDISO
+      pardiso(this->handle.data(), &maximum_number_factors, &matrix_number, &matrix_type, &phase, &this->n, this->csr_matrix.values(),
+            this->csr_matrix.row_starts(), this->csr_matrix.column_indices(), permutation, &number_rhs, this->iparm.data(), &message_level,
+            rhs, solution, &error, this->dparm.data());
+#else
+      pardiso(this->handle.data(), &maximum_number_factors, &matrix_number, &matrix_type, &phase, &this->n, this->csr_matrix.values(),
+            this->csr_matrix.row_starts(), this->csr_matrix.column_indices(), permutation, &number_rhs, this->iparm.data(), &message_level,
+            rhs, solution, &error);
+#endif
+      if (error != 0) {
+         if (phase == PardisoSolver::PHASE_NUMERICAL_FACTORIZATION) {
+            // the inertia (no nonzero eigenvalue) reveals the failure to the regularization
+            WARNING << "PARDISO failed to factorize the matrix: error = " << error << '\n';
+         }
+         else if (phase != PardisoSolver::PHASE_RELEASE) {
+            throw std::runtime_error("PARDISO failed in phase " + std::to_string(phase) + " (error " + std::to_string(error) + ")");
+         }
+      }
+   }
+
+   template <typename IndexType>
+   int PardisoSolver<IndexType>::get_ordering(const std::string& ordering_name) {
+      // IPARM(2)
+      if (ordering_name == "minimum_degree") {
+         return 0;
+      }
+      else if (ordering_name == "METIS") {
+         return 2;
+      }
+#ifndef HAS_PANUA_PARDISO
+      else if (ordering_name == "parallel_METIS") {
+         return 3;
+      }
+#endif
+      throw std::invalid_argument("The PARDISO ordering " + ordering_name + " is unknown");
+   }
+
+   template class PardisoSolver<size_t>;
+   template class PardisoSolver<int>;
+} // namespace
@@ -0,0 +1,66 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PARDISOSOLVER_H
+#define UNO_PARDISOSOLVER_H
+
+#include <array>
+#include <string>
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/CompressedTriangularMatrix.hpp"
+
+namespace uno {
+   // forward declarations
+   class Options;
+   template <typename ElementType>
+   class Vector;
+
+   /*! \class PardisoSolver
+    * \brief Interface for PARDISO (Intel MKL PARDISO, or Panua Pardiso if HAS_PANUA_PARDISO is defined)
+    *
+    *  Parallel supernodal LDL^T factorization of real symmetric indefinite matrices with Bunch-Kaufman pivoting. The analysis
+    *  (phase 11: ordering and symbolic factorization) is kept as long as the sparsity pattern does not change: a value update only
+    *  triggers the numerical factorization (phase 22). The matrix is converted into the 1-based CSR representation of its upper
+    *  triangle with a cached permutation of the nonzeros (see CompressedTriangularMatrix)
+    */
+   template <typename IndexType = size_t>
+   class PardisoSolver : public DirectSymmetricIndefiniteLinearSolver<IndexType, double> {
+   public:
+      PardisoSolver(size_t dimension, size_t number_nonzeros, const Options& options);
+      ~PardisoSolver() override;
+
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+            size_t number_rhs) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override;
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override;
+      [[nodiscard]] size_t memory_size() const override { return this->csr_matrix.memory_size(); }
+      [[nodiscard]] size_t get_peak_workspace_size() const override { return this->peak_workspace_size; }
+
+   private:
+      // internal handle (opaque pointers managed by PARDISO) and parameters
+      std::array<void*, 64> handle{};
+      std::array<int, 64> iparm{};
+      std::array<double, 64> dparm{}; // Panua Pardiso only
+      CompressedTriangularMatrix<int, double> csr_matrix{1 /* Fortran indices */, true /* explicit diagonal */};
+      int n{0};
+      bool is_analyzed{false};
+      size_t peak_workspace_size{0}; // in bytes
+
+      static constexpr int REAL_SYMMETRIC_INDEFINITE = -2;
+      static constexpr int PHASE_ANALYSIS = 11;
+      static constexpr int PHASE_NUMERICAL_FACTORIZATION = 22;
+      static constexpr int PHASE_SOLVE = 33;
+      static constexpr int PHASE_RELEASE = -1;
+
+      void call(int phase, int number_rhs, double* rhs, double* solution);
+      [[nodiscard]] static int get_ordering(const std::string& ordering_name);
+   };
+} // namespace
+
+#endif // UNO_PARDISOSOLVER_H
@@ -26,6 +26,8 @@ namespace uno {
       QPSolver(): LPSolver() { }
       ~QPSolver() override = default;
 
+      virtual void initialize_statistics(Statistics& /*statistics*/, const Options& /*options*/) { }
+
       void solve_LP(const OptimizationProblem& problem, Iterate& current_iterate, const Vector<double>& initial_point, Direction& direction,
             double trust_region_radius, const WarmstartInformation& warmstart_information) override = 0;
 
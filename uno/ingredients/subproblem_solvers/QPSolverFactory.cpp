@@ -6,10 +6,16 @@
 #include "linear_algebra/Vector.hpp"
 #include "options/Options.hpp"
 #include "QPSolver.hpp"
+#include "GoldfarbIdnaniSolver.hpp"
+#include "InteriorPointQPSolver.hpp"
+#include "SymmetricIndefiniteLinearSolverFactory.hpp"
 
 #ifdef HAS_BQPD
 #include "ingredients/subproblem_solvers/BQPD/BQPDSolver.hpp"
 #endif
+#ifdef HAS_HIGHS
+#include "ingredients/subproblem_solvers/HiGHS/HiGHSSolver.hpp"
+#endif
 
 namespace uno {
    std::unique_ptr<QPSolver> QPSolverFactory::create([[maybe_unused]] size_t number_variables, [[maybe_unused]] size_t number_constraints,
@@ -23,6 +29,20 @@ namespace uno {
                   number_hessian_nonzeros, BQPDProblemType::QP, options);
          }
 #endif
+#ifdef HAS_HIGHS
+         if (QP_solver_name == "HiGHS") {
+            return std::make_unique<HiGHSSolver>(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros,
+                  number_hessian_nonzeros, options);
+         }
+#endif
+         if (QP_solver_name == "InteriorPointQP" && !SymmetricIndefiniteLinearSolverFactory::available_solvers().empty()) {
+            return std::make_unique<InteriorPointQPSolver>(number_variables, number_constraints, number_objective_gradient_nonzeros,
+                  number_jacobian_nonzeros, number_hessian_nonzeros, options);
+         }
+         if (QP_solver_name == "GoldfarbIdnani") {
+            return std::make_unique<GoldfarbIdnaniSolver>(number_variables, number_constraints, number_objective_gradient_nonzeros,
+                  number_jacobian_nonzeros, number_hessian_nonzeros, options);
+         }
          std::string message = "The QP solver ";
          message.append(QP_solver_name).append(" is unknown").append("\n").append("The following values are available: ")
                .append(join(QPSolverFactory::available_solvers(), ", "));
@@ -41,6 +61,15 @@ namespace uno {
 #ifdef HAS_BQPD
       solvers.emplace_back("BQPD");
 #endif
+#ifdef HAS_HIGHS
+      solvers.emplace_back("HiGHS");
+#endif
+      // sparse interior-point solver, available with a linear solver
+      if (!SymmetricIndefiniteLinearSolverFactory::available_solvers().empty()) {
+         solvers.emplace_back("InteriorPointQP");
+      }
+      // dense solver for small problems, always available
+      solvers.emplace_back("GoldfarbIdnani");
       return solvers;
    }
 } // namespace
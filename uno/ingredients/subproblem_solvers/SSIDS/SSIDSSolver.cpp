@@ -0,0 +1,118 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include "SSIDSSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   template <typename IndexType>
+   SSIDSSolver<IndexType>::SSIDSSolver(size_t dimension, size_t /*number_nonzeros*/, const Options& options) :
+         DirectSymmetricIndefiniteLinearSolver<IndexType, double>(dimension) {
+      // set the default values of the controlling parameters
+      spral_ssids_default_options(&this->ssids_options);
+      // Fortran (1-based) indices
+      this->ssids_options.array_base = 1;
+      // continue the factorization of singular matrices (to compute the inertia)
+      this->ssids_options.action = true;
+      // suppress the messages
+      this->ssids_options.print_level = -1;
+      // factorize on the GPU(s), if any. The GPU kernels are not bit-reproducible: the factorization stays on the CPU in deterministic mode
+      this->ssids_options.use_gpu = options.get_bool("SSIDS_use_gpu") && !options.get_bool("deterministic");
+   }
+
+   template <typename IndexType>
+   SSIDSSolver<IndexType>::~SSIDSSolver() {
+      spral_ssids_free(&this->akeep, &this->fkeep);
+   }
+
+   template <typename IndexType>
+   void SSIDSSolver<IndexType>::do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "SSIDSSolver: the dimension of the matrix is larger than the preallocated size");
+
+      // borrow the sparsity pattern of the matrix, or build the internal matrix representation
+      this->indices.save(matrix);
+      this->n = static_cast<int>(matrix.dimension());
+      const int64_t nnz = static_cast<int64_t>(matrix.number_nonzeros());
+
+      // discard the previous analysis and factorization
+      spral_ssids_free(&this->akeep, &this->fkeep);
+      spral_ssids_analyse_coord(this->n, nullptr, nnz, this->indices.row_indices(), this->indices.column_indices(), nullptr, &this->akeep,
+            &this->ssids_options, &this->inform);
+
+      assert(0 <= this->inform.flag && "SSIDS: the symbolic analysis failed");
+      if (0 < this->inform.flag) {
+         WARNING << "SSIDS has issued a warning: flag = " << this->inform.flag << '\n';
+      }
+      this->factorization_statistics.record_analysis(matrix.number_nonzeros(), static_cast<size_t>(this->inform.num_factor));
+   }
+
+   template <typename IndexType>
+   void SSIDSSolver<IndexType>::do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "SSIDSSolver: the dimension of the matrix is larger than the preallocated size");
+      assert(this->n == static_cast<int>(matrix.dimension()) && "SSIDSSolver: the dimensions do not match");
+
+      // the values are passed in the order of the coordinate analysis (ptr and row are not used)
+      spral_ssids_factor(false /* indefinite */, nullptr, nullptr, matrix.data_pointer(), nullptr, this->akeep, &this->fkeep,
+            &this->ssids_options, &this->inform);
+      if (this->inform.flag < 0) {
+         WARNING << "SSIDS failed to factorize the matrix: flag = " << this->inform.flag << '\n';
+      }
+      // the factors are held by SSIDS: their memory is reported as the storage of their entries
+      this->factorization_statistics.record_factorization(static_cast<size_t>(this->inform.num_factor),
+         static_cast<double>(this->inform.num_flops), static_cast<size_t>(this->inform.num_factor) * sizeof(double),
+         static_cast<size_t>(this->inform.num_delay), 0, static_cast<size_t>(this->inform.num_two));
+   }
+
+   template <typename IndexType>
+   void SSIDSSolver<IndexType>::solve_indefinite_system(const SymmetricMatrix<IndexType, double>& /*matrix*/, const Vector<double>& rhs,
+         Vector<double>& result) {
+      // copy rhs into result (overwritten by SSIDS)
+      result = rhs;
+      spral_ssids_solve1(SSIDSSolver::FULL_SOLVE, result.data(), this->akeep, this->fkeep, &this->ssids_options, &this->inform);
+      assert(0 <= this->inform.flag && "SSIDS: the linear solve failed");
+   }
+
+   template <typename IndexType>
+   void SSIDSSolver<IndexType>::solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& /*matrix*/, const Vector<double>& rhs,
+         Vector<double>& result, size_t number_rhs) {
+      // copy the rhs block into result (overwritten by SSIDS)
+      std::copy(rhs.data(), rhs.data() + static_cast<size_t>(this->n) * number_rhs, result.data());
+      spral_ssids_solve(SSIDSSolver::FULL_SOLVE, static_cast<int>(number_rhs), result.data(), this->n, this->akeep, this->fkeep,
+            &this->ssids_options, &this->inform);
+      assert(0 <= this->inform.flag && "SSIDS: the linear solve failed");
+   }
+
+   template <typename IndexType>
+   std::tuple<size_t, size_t, size_t> SSIDSSolver<IndexType>::get_inertia() const {
+      // rank = number_positive_eigenvalues + number_negative_eigenvalues
+      // n = rank + number_zero_eigenvalues
+      const size_t rank = this->rank();
+      const size_t number_negative_eigenvalues = this->number_negative_eigenvalues();
+      const size_t number_positive_eigenvalues = rank - number_negative_eigenvalues;
+      const size_t number_zero_eigenvalues = static_cast<size_t>(this->n) - rank;
+      return std::make_tuple(number_positive_eigenvalues, number_negative_eigenvalues, number_zero_eigenvalues);
+   }
+
+   template <typename IndexType>
+   size_t SSIDSSolver<IndexType>::number_negative_eigenvalues() const {
+      return static_cast<size_t>(this->inform.num_neg);
+   }
+
+   template <typename IndexType>
+   bool SSIDSSolver<IndexType>::matrix_is_singular() const {
+      return (this->inform.matrix_rank < this->n);
+   }
+
+   template <typename IndexType>
+   size_t SSIDSSolver<IndexType>::rank() const {
+      return static_cast<size_t>(this->inform.matrix_rank);
+   }
+
+   template class SSIDSSolver<size_t>;
+   template class SSIDSSolver<int>;
+} // namespace
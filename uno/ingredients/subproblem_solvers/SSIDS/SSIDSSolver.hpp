@@ -0,0 +1,57 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SSIDSSOLVER_H
+#define UNO_SSIDSSOLVER_H
+
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "ingredients/subproblem_solvers/FortranIndices.hpp"
+#include "spral_ssids.h"
+
+namespace uno {
+   // forward declarations
+   class Options;
+   template <typename ElementType>
+   class Vector;
+
+   /*! \class SSIDSSolver
+    * \brief Interface for SPRAL SSIDS
+    *
+    *  Interface to the GPU-capable symmetric indefinite linear solver SSIDS (SPRAL).
+    *  The analysis (and its device data) is kept across factorizations as long as the sparsity pattern does not change: only the
+    *  values of the matrix are transferred at each factorization. The sparsity pattern of a COO matrix with 1-based int indices is
+    *  passed without copy (see FortranIndices)
+    */
+   template <typename IndexType = size_t>
+   class SSIDSSolver : public DirectSymmetricIndefiniteLinearSolver<IndexType, double> {
+   public:
+      SSIDSSolver(size_t dimension, size_t number_nonzeros, const Options& options);
+      ~SSIDSSolver() override;
+
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void solve_indefinite_systems(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+            size_t number_rhs) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override;
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override;
+
+   private:
+      // internal matrix representation (borrowed from the matrix if possible)
+      FortranIndices<IndexType> indices{};
+      int n{0};
+
+      // symbolic and numerical factorizations (opaque pointers managed by SSIDS)
+      void* akeep{nullptr};
+      void* fkeep{nullptr};
+      spral_ssids_options ssids_options{};
+      spral_ssids_inform inform{};
+
+      static const int FULL_SOLVE = 0;
+   };
+} // namespace
+
+#endif // UNO_SSIDSSOLVER_H
@@ -0,0 +1,470 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SCHURCOMPLEMENTSOLVER_H
+#define UNO_SCHURCOMPLEMENTSOLVER_H
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/BlockPartition.hpp"
+#include "linear_algebra/DenseLDLT.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   /*! \class SchurComplementSolver
+    * \brief Structure-aware solver of block-angular (multi-scenario) symmetric indefinite systems
+    *
+    *  The indices are partitioned into S independent blocks and a small set of linking indices (see BlockPartition):
+    *  K = [K_1 ... C_1; ...; C_1^T ... K_0]. The blocks K_i are factorized concurrently by their own solver instances, then the
+    *  dense Schur complement S = K_0 - sum_i C_i^T K_i^{-1} C_i is formed and factorized with Bunch-Kaufman pivoting. By the
+    *  Haynsworth inertia additivity, the inertia of K is the sum of the inertias of the blocks and of S.
+    *  The partition is supplied by the user (set_block_partition) or detected from the graph of the matrix at each symbolic analysis
+    */
+   template <typename IndexType>
+   class SchurComplementSolver: public DirectSymmetricIndefiniteLinearSolver<IndexType, double> {
+   public:
+      using BlockSolverFactory = std::function<std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, double>>(size_t /*dimension*/,
+            size_t /*number_nonzeros*/)>;
+
+      SchurComplementSolver(size_t dimension, BlockSolverFactory block_solver_factory, double linking_degree_factor);
+      ~SchurComplementSolver() override = default;
+
+      // block_of_index[i] is the block of index i, or BlockPartition::linking
+      void set_block_partition(const std::vector<size_t>& block_of_index);
+
+      void do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<IndexType, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void set_static_pivoting(bool static_pivoting) override;
+
+      [[nodiscard]] bool provides_inertia() const override;
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override;
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override;
+      [[nodiscard]] size_t memory_size() const override;
+      [[nodiscard]] size_t get_peak_workspace_size() const override;
+      // the sizes, flops and pivots of the blocks and of the Schur complement
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics() const override;
+
+      [[nodiscard]] const BlockPartition& get_block_partition() const { return this->partition; }
+
+   protected:
+      enum class Destination {BLOCK, COUPLING, LINKING};
+      // destination of a nonzero of the matrix: nonzero of a block matrix, entry of a coupling matrix C_i or of K_0
+      struct NonzeroDestination {
+         Destination destination;
+         size_t block;
+         size_t position;
+      };
+      struct Block {
+         std::vector<size_t> indices{}; /*!< global indices of the block */
+         std::unique_ptr<SymmetricMatrix<IndexType, double>> matrix{};
+         std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, double>> solver{};
+         size_t solver_dimension{0};
+         size_t solver_number_nonzeros{0};
+         Vector<double> coupling{}; /*!< C_i, dense column-major (block dimension x number of linking indices) */
+         Vector<double> coupled_solution{}; /*!< K_i^{-1} C_i */
+         Vector<double> rhs{};
+         Vector<double> solution{};
+      };
+
+      const BlockSolverFactory block_solver_factory;
+      const double linking_degree_factor;
+      std::vector<size_t> user_partition{};
+      BlockPartition partition{};
+      std::vector<Block> blocks{};
+      std::vector<size_t> linking_indices{};
+      std::vector<size_t> local_index{}; /*!< position of each index in its block, or in the linking set */
+      std::vector<NonzeroDestination> nonzero_destinations{};
+      std::unique_ptr<DenseLDLT<double>> schur_complement{};
+      Vector<double> linking_solution{};
+      size_t matrix_dimension{0};
+      bool static_pivoting{false};
+
+      void factorize_blocks();
+      void assemble_schur_complement();
+      // runs the function on each block (concurrently with OpenMP) and rethrows the first exception, if any
+      template <typename Function>
+      void for_each_block(const Function& function);
+   };
+
+   // implementation
+
+   template <typename IndexType>
+   SchurComplementSolver<IndexType>::SchurComplementSolver(size_t dimension, BlockSolverFactory block_solver_factory, double linking_degree_factor):
+         DirectSymmetricIndefiniteLinearSolver<IndexType, double>(dimension),
+         block_solver_factory(std::move(block_solver_factory)),
+         linking_degree_factor(linking_degree_factor),
+         local_index(dimension) {
+      if (linking_degree_factor < 0.) {
+         throw std::invalid_argument("SchurComplementSolver: the linking degree factor should be nonnegative");
+      }
+   }
+
+   template <typename IndexType>
+   void SchurComplementSolver<IndexType>::set_block_partition(const std::vector<size_t>& block_of_index) {
+      this->user_partition = block_of_index;
+   }
+
+   template <typename IndexType>
+   template <typename Function>
+   void SchurComplementSolver<IndexType>::for_each_block(const Function& function) {
+      const size_t number_blocks = this->blocks.size();
+      // the exceptions of the block solvers must not escape the parallel region
+      std::vector<std::exception_ptr> exceptions(number_blocks);
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic) if(1 < number_blocks)
+#endif
+      for (size_t block_index = 0; block_index < number_blocks; block_index++) {
+         try {
+            function(this->blocks[block_index]);
+         }
+         catch (...) {
+            exceptions[block_index] = std::current_exception();
+         }
+      }
+      for (const std::exception_ptr& exception: exceptions) {
+         if (exception) {
+            std::rethrow_exception(exception);
+         }
+      }
+   }
+
+   // the blocks are factorized with static pivoting, the dense Schur complement keeps its Bunch-Kaufman pivoting
+   template <typename IndexType>
+   void SchurComplementSolver<IndexType>::set_static_pivoting(bool static_pivoting) {
+      this->static_pivoting = static_pivoting;
+      for (Block& block: this->blocks) {
+         if (block.solver != nullptr) {
+            block.solver->set_static_pivoting(static_pivoting);
+         }
+      }
+   }
+
+   template <typename IndexType>
+   void SchurComplementSolver<IndexType>::do_symbolic_analysis(const SymmetricMatrix<IndexType, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "SchurComplementSolver: the dimension of the matrix is larger than the preallocated size");
+      this->matrix_dimension = matrix.dimension();
+
+      // block partition (user-supplied or detected)
+      if (!this->user_partition.empty()) {
+         if (this->user_partition.size() != matrix.dimension()) {
+            throw std::invalid_argument("SchurComplementSolver: the block partition does not match the dimension of the matrix");
+         }
+         this->partition = BlockPartition(std::vector<size_t>(this->user_partition));
+      }
+      else {
+         this->partition = BlockPartition::detect(matrix, this->linking_degree_factor);
+      }
+
+      // indices of the blocks and of the linking set
+      const size_t number_blocks = this->partition.number_blocks;
+      this->blocks.resize(number_blocks);
+      for (Block& block: this->blocks) {
+         block.indices.clear();
+      }
+      this->linking_indices.clear();
+      for (size_t index: Range(matrix.dimension())) {
+         const size_t block_index = this->partition.block_of_index[index];
+         if (block_index == BlockPartition::linking) {
+            this->local_index[index] = this->linking_indices.size();
+            this->linking_indices.emplace_back(index);
+         }
+         else {
+            this->local_index[index] = this->blocks[block_index].indices.size();
+            this->blocks[block_index].indices.emplace_back(index);
+         }
+      }
+      const size_t number_linking_indices = this->linking_indices.size();
+
+      // destinations of the nonzeros
+      std::vector<size_t> block_number_nonzeros(number_blocks, 0);
+      this->nonzero_destinations.clear();
+      this->nonzero_destinations.reserve(matrix.number_nonzeros());
+      matrix.for_each([&](size_t row_index, size_t column_index, double /*element*/) {
+         const size_t row_block = this->partition.block_of_index[row_index];
+         const size_t column_block = this->partition.block_of_index[column_index];
+         if (row_block == BlockPartition::linking && column_block == BlockPartition::linking) {
+            this->nonzero_destinations.push_back({Destination::LINKING, 0, 0});
+         }
+         else if (row_block == BlockPartition::linking || column_block == BlockPartition::linking) {
+            const size_t block_index = (row_block == BlockPartition::linking) ? column_block : row_block;
+            const size_t block_row = this->local_index[(row_block == BlockPartition::linking) ? column_index : row_index];
+            const size_t linking_column = this->local_index[(row_block == BlockPartition::linking) ? row_index : column_index];
+            const size_t block_dimension = this->blocks[block_index].indices.size();
+            this->nonzero_destinations.push_back({Destination::COUPLING, block_index, linking_column * block_dimension + block_row});
+         }
+         else if (row_block == column_block) {
+            this->nonzero_destinations.push_back({Destination::BLOCK, row_block, block_number_nonzeros[row_block]});
+            block_number_nonzeros[row_block]++;
+         }
+         else {
+            throw std::invalid_argument("SchurComplementSolver: a nonzero couples two different blocks of the partition");
+         }
+      });
+
+      // block matrices (pattern only) and block solvers, reused when they are large enough
+      for (size_t block_index: Range(number_blocks)) {
+         Block& block = this->blocks[block_index];
+         const size_t block_dimension = block.indices.size();
+         const size_t number_nonzeros = block_number_nonzeros[block_index];
+         // a user partition may skip block numbers: the empty blocks have no solver
+         if (block_dimension == 0) {
+            continue;
+         }
+         if (block.solver == nullptr || block.solver_dimension < block_dimension || block.solver_number_nonzeros < number_nonzeros) {
+            block.solver = this->block_solver_factory(block_dimension, number_nonzeros);
+            block.solver->set_static_pivoting(this->static_pivoting);
+            block.solver_dimension = block_dimension;
+            block.solver_number_nonzeros = number_nonzeros;
+         }
+         if (block.matrix == nullptr || block.matrix->capacity() < number_nonzeros) {
+            block.matrix = std::make_unique<SymmetricMatrix<IndexType, double>>(block_dimension, number_nonzeros, false, "COO",
+                  matrix.index_shift());
+         }
+         block.matrix->reset();
+         block.matrix->set_dimension(block_dimension);
+         block.coupling.resize(block_dimension * number_linking_indices);
+         block.coupled_solution.resize(block_dimension * number_linking_indices);
+         block.rhs.resize(block_dimension);
+         block.solution.resize(block_dimension);
+      }
+      matrix.for_each([&](size_t row_index, size_t column_index, double /*element*/) {
+         const size_t block_index = this->partition.block_of_index[row_index];
+         if (block_index != BlockPartition::linking && block_index == this->partition.block_of_index[column_index]) {
+            this->blocks[block_index].matrix->insert(0., static_cast<IndexType>(this->local_index[row_index]),
+                  static_cast<IndexType>(this->local_index[column_index]));
+         }
+      });
+      this->for_each_block([&](Block& block) {
+         if (!block.indices.empty()) {
+            block.solver->do_symbolic_analysis(*block.matrix);
+         }
+      });
+
+      // dense Schur complement
+      if (this->schur_complement == nullptr || this->schur_complement->dimension() != number_linking_indices) {
+         this->schur_complement = std::make_unique<DenseLDLT<double>>(number_linking_indices);
+      }
+      this->linking_solution.resize(number_linking_indices);
+      this->factorization_statistics.record_analysis(matrix.number_nonzeros(), number_linking_indices * (number_linking_indices + 1) / 2);
+   }
+
+   template <typename IndexType>
+   void SchurComplementSolver<IndexType>::do_numerical_factorization(const SymmetricMatrix<IndexType, double>& matrix) {
+      assert(matrix.dimension() == this->matrix_dimension && "SchurComplementSolver: the symbolic analysis was not performed");
+      assert(matrix.number_nonzeros() == this->nonzero_destinations.size() && "SchurComplementSolver: the numbers of nonzeros do not match");
+
+      // scatter the values into the block matrices, the coupling matrices and K_0
+      for (Block& block: this->blocks) {
+         block.coupling.fill(0.);
+      }
+      this->schur_complement->reset();
+      size_t nonzero_index = 0;
+      matrix.for_each([&](size_t row_index, size_t column_index, double element) {
+         const NonzeroDestination& destination = this->nonzero_destinations[nonzero_index];
+         if (destination.destination == Destination::BLOCK) {
+            this->blocks[destination.block].matrix->data_pointer()[destination.position] = element;
+         }
+         else if (destination.destination == Destination::COUPLING) {
+            this->blocks[destination.block].coupling[destination.position] += element;
+         }
+         else {
+            const size_t row = std::max(this->local_index[row_index], this->local_index[column_index]);
+            const size_t column = std::min(this->local_index[row_index], this->local_index[column_index]);
+            this->schur_complement->entry(row, column) += element;
+         }
+         nonzero_index++;
+      });
+
+      this->factorize_blocks();
+      this->assemble_schur_complement();
+      this->schur_complement->factorize();
+      const size_t number_linking_indices = this->linking_indices.size();
+      this->factorization_statistics.record_factorization(number_linking_indices * (number_linking_indices + 1) / 2,
+         std::pow(static_cast<double>(number_linking_indices), 3) / 3., this->schur_complement->memory_size(), 0, 0,
+         this->schur_complement->number_two_by_two_pivots());
+   }
+
+   // factorize each block and solve K_i X_i = C_i with the block of right-hand sides
+   template <typename IndexType>
+   void SchurComplementSolver<IndexType>::factorize_blocks() {
+      const size_t number_linking_indices = this->linking_indices.size();
+      this->for_each_block([&](Block& block) {
+         if (!block.indices.empty()) {
+            block.solver->do_numerical_factorization(*block.matrix);
+            if (0 < number_linking_indices) {
+               block.solver->solve_indefinite_systems(*block.matrix, block.coupling, block.coupled_solution, number_linking_indices);
+            }
+         }
+      });
+   }
+
+   // S = K_0 - sum_i C_i^T X_i (lower triangle). The columns of S are independent
+   template <typename IndexType>
+   void SchurComplementSolver<IndexType>::assemble_schur_complement() {
+      const size_t number_linking_indices = this->linking_indices.size();
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic) if(1 < number_linking_indices)
+#endif
+      for (size_t column = 0; column < number_linking_indices; column++) {
+         for (size_t row = column; row < number_linking_indices; row++) {
+            double product = 0.;
+            for (const Block& block: this->blocks) {
+               const size_t block_dimension = block.indices.size();
+               const double* coupling_column = block.coupling.data() + row * block_dimension;
+               const double* solution_column = block.coupled_solution.data() + column * block_dimension;
+               for (size_t index: Range(block_dimension)) {
+                  product += coupling_column[index] * solution_column[index];
+               }
+            }
+            this->schur_complement->entry(row, column) -= product;
+         }
+      }
+   }
+
+   template <typename IndexType>
+   void SchurComplementSolver<IndexType>::solve_indefinite_system(const SymmetricMatrix<IndexType, double>& /*matrix*/, const Vector<double>& rhs,
+         Vector<double>& result) {
+      const size_t number_linking_indices = this->linking_indices.size();
+      // y_i = K_i^{-1} r_i
+      this->for_each_block([&](Block& block) {
+         if (!block.indices.empty()) {
+            for (size_t index: Range(block.indices.size())) {
+               block.rhs[index] = rhs[block.indices[index]];
+            }
+            block.solver->solve_indefinite_system(*block.matrix, block.rhs, block.solution);
+         }
+      });
+      // x_0 = S^{-1} (r_0 - sum_i C_i^T y_i)
+      for (size_t linking_index: Range(number_linking_indices)) {
+         double reduced_rhs = rhs[this->linking_indices[linking_index]];
+         for (const Block& block: this->blocks) {
+            const size_t block_dimension = block.indices.size();
+            const double* coupling_column = block.coupling.data() + linking_index * block_dimension;
+            for (size_t index: Range(block_dimension)) {
+               reduced_rhs -= coupling_column[index] * block.solution[index];
+            }
+         }
+         this->linking_solution[linking_index] = reduced_rhs;
+      }
+      if (0 < number_linking_indices) {
+         this->schur_complement->solve(this->linking_solution.data());
+      }
+      // x_i = y_i - X_i x_0
+      this->for_each_block([&](Block& block) {
+         const size_t block_dimension = block.indices.size();
+         for (size_t linking_index: Range(number_linking_indices)) {
+            const double linking_value = this->linking_solution[linking_index];
+            const double* solution_column = block.coupled_solution.data() + linking_index * block_dimension;
+            for (size_t index: Range(block_dimension)) {
+               block.solution[index] -= solution_column[index] * linking_value;
+            }
+         }
+         for (size_t index: Range(block_dimension)) {
+            result[block.indices[index]] = block.solution[index];
+         }
+      });
+      for (size_t linking_index: Range(number_linking_indices)) {
+         result[this->linking_indices[linking_index]] = this->linking_solution[linking_index];
+      }
+   }
+
+   // the dense Schur complement always provides its inertia
+   template <typename IndexType>
+   bool SchurComplementSolver<IndexType>::provides_inertia() const {
+      return std::all_of(this->blocks.cbegin(), this->blocks.cend(), [](const Block& block) {
+         return block.indices.empty() || block.solver->provides_inertia();
+      });
+   }
+
+   template <typename IndexType>
+   std::tuple<size_t, size_t, size_t> SchurComplementSolver<IndexType>::get_inertia() const {
+      // Haynsworth inertia additivity: In(K) = sum_i In(K_i) + In(S)
+      auto [number_positive, number_negative, number_zero] = this->schur_complement->get_inertia();
+      for (const Block& block: this->blocks) {
+         if (!block.indices.empty()) {
+            const auto [block_positive, block_negative, block_zero] = block.solver->get_inertia();
+            number_positive += block_positive;
+            number_negative += block_negative;
+            number_zero += block_zero;
+         }
+      }
+      return {number_positive, number_negative, number_zero};
+   }
+
+   template <typename IndexType>
+   size_t SchurComplementSolver<IndexType>::number_negative_eigenvalues() const {
+      return std::get<1>(this->get_inertia());
+   }
+
+   template <typename IndexType>
+   bool SchurComplementSolver<IndexType>::matrix_is_singular() const {
+      return 0 < std::get<2>(this->get_inertia());
+   }
+
+   template <typename IndexType>
+   size_t SchurComplementSolver<IndexType>::rank() const {
+      return this->matrix_dimension - std::get<2>(this->get_inertia());
+   }
+
+   template <typename IndexType>
+   size_t SchurComplementSolver<IndexType>::memory_size() const {
+      size_t size = (this->user_partition.capacity() + this->partition.block_of_index.capacity() + this->linking_indices.capacity() +
+            this->local_index.capacity()) * sizeof(size_t) + this->nonzero_destinations.capacity() * sizeof(NonzeroDestination) +
+            this->linking_solution.memory_size();
+      if (this->schur_complement != nullptr) {
+         size += this->schur_complement->memory_size();
+      }
+      for (const Block& block: this->blocks) {
+         size += block.indices.capacity() * sizeof(size_t) + block.coupling.memory_size() + block.coupled_solution.memory_size() +
+               block.rhs.memory_size() + block.solution.memory_size();
+         if (block.matrix != nullptr) {
+            size += block.matrix->memory_size();
+         }
+         if (block.solver != nullptr) {
+            size += block.solver->memory_size();
+         }
+      }
+      return size;
+   }
+
+   template <typename IndexType>
+   size_t SchurComplementSolver<IndexType>::get_peak_workspace_size() const {
+      size_t size = 0;
+      for (const Block& block: this->blocks) {
+         if (block.solver != nullptr) {
+            size += block.solver->get_peak_workspace_size();
+         }
+      }
+      return size;
+   }
+
+   template <typename IndexType>
+   FactorizationStatistics SchurComplementSolver<IndexType>::get_factorization_statistics() const {
+      FactorizationStatistics statistics{};
+      for (const Block& block: this->blocks) {
+         if (block.solver != nullptr) {
+            statistics.accumulate(block.solver->get_factorization_statistics());
+         }
+      }
+      statistics.accumulate(this->factorization_statistics);
+      // the blocks are analyzed and factorized together with the whole matrix
+      statistics.number_analyses = this->factorization_statistics.number_analyses;
+      statistics.number_factorizations = this->factorization_statistics.number_factorizations;
+      statistics.matrix_nonzeros = this->factorization_statistics.matrix_nonzeros;
+      return statistics;
+   }
+} // namespace
+
+#endif // UNO_SCHURCOMPLEMENTSOLVER_H
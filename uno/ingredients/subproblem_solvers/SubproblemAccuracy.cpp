@@ -0,0 +1,61 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "SubproblemAccuracy.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   SubproblemAccuracy::SubproblemAccuracy(const Options& options):
+         adaptive(SubproblemAccuracy::is_adaptive_mode(options.get_string("subproblem_accuracy"))),
+         tolerance_factor(options.get_double("subproblem_accuracy_factor")),
+         loosest_tolerance(options.get_double("subproblem_loosest_tolerance")),
+         loosest_iteration_fraction(options.get_double("subproblem_loosest_iteration_fraction")) {
+      if (this->tolerance_factor <= 0.) {
+         throw std::invalid_argument("subproblem_accuracy_factor should be positive");
+      }
+      if (this->loosest_iteration_fraction <= 0. || 1. < this->loosest_iteration_fraction) {
+         throw std::invalid_argument("subproblem_loosest_iteration_fraction should be in (0, 1]");
+      }
+   }
+
+   bool SubproblemAccuracy::is_adaptive_mode(const std::string& mode) {
+      if (mode == "exact") {
+         return false;
+      }
+      else if (mode == "adaptive") {
+         return true;
+      }
+      throw std::invalid_argument("The subproblem accuracy " + mode + " is unknown");
+   }
+
+   // tolerance proportional to the KKT error of the current iterate, clamped to [tight tolerance, loosest tolerance]
+   double SubproblemAccuracy::tolerance(const Iterate& current_iterate, double tight_tolerance) const {
+      if (!this->adaptive || this->loosest_tolerance <= tight_tolerance) {
+         return tight_tolerance;
+      }
+      return std::clamp(this->tolerance_factor * SubproblemAccuracy::KKT_error(current_iterate), tight_tolerance, this->loosest_tolerance);
+   }
+
+   // iteration limit interpolated on a logarithmic scale between the loosest tolerance and the tight tolerance
+   size_t SubproblemAccuracy::iteration_limit(double tolerance, double tight_tolerance, size_t maximum_number_iterations) const {
+      if (!this->adaptive || tolerance <= tight_tolerance || this->loosest_tolerance <= tight_tolerance) {
+         return maximum_number_iterations;
+      }
+      const double progress = std::log(this->loosest_tolerance / tolerance) / std::log(this->loosest_tolerance / tight_tolerance);
+      const double fraction = this->loosest_iteration_fraction + (1. - this->loosest_iteration_fraction) * std::clamp(progress, 0., 1.);
+      const size_t limit = static_cast<size_t>(std::ceil(fraction * static_cast<double>(maximum_number_iterations)));
+      return std::clamp(limit, size_t(1), maximum_number_iterations);
+   }
+
+   // in the feasibility restoration phase, the stationarity of the optimality problem may not be computed
+   double SubproblemAccuracy::KKT_error(const Iterate& current_iterate) {
+      const double stationarity = is_finite(current_iterate.residuals.stationarity) ? current_iterate.residuals.stationarity :
+            current_iterate.feasibility_residuals.stationarity;
+      return std::max({current_iterate.primal_feasibility, stationarity, current_iterate.residuals.complementarity});
+   }
+} // namespace
@@ -0,0 +1,42 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SUBPROBLEMACCURACY_H
+#define UNO_SUBPROBLEMACCURACY_H
+
+#include <cstddef>
+#include <string>
+
+namespace uno {
+   // forward declarations
+   class Iterate;
+   class Options;
+
+   /*! \class SubproblemAccuracy
+    * \brief Accuracy schedule of the LP/QP solves
+    *
+    *  Far from a KKT point, the subproblems need not be solved to tight tolerances: in adaptive mode, the tolerance of a solve is
+    *  proportional to the KKT error of the current (outer) iterate, clamped between the tight tolerance of the solver and a loosest
+    *  tolerance. The iteration limit follows the tolerance (on a logarithmic scale), from a fraction of the maximum number of
+    *  iterations at the loosest tolerance to the maximum number of iterations at the tight tolerance
+    */
+   class SubproblemAccuracy {
+   public:
+      explicit SubproblemAccuracy(const Options& options);
+
+      [[nodiscard]] bool is_adaptive() const { return this->adaptive; }
+      [[nodiscard]] double tolerance(const Iterate& current_iterate, double tight_tolerance) const;
+      [[nodiscard]] size_t iteration_limit(double tolerance, double tight_tolerance, size_t maximum_number_iterations) const;
+
+   protected:
+      const bool adaptive;
+      const double tolerance_factor;
+      const double loosest_tolerance;
+      const double loosest_iteration_fraction;
+
+      [[nodiscard]] static bool is_adaptive_mode(const std::string& mode);
+      [[nodiscard]] static double KKT_error(const Iterate& current_iterate);
+   };
+} // namespace
+
+#endif // UNO_SUBPROBLEMACCURACY_H
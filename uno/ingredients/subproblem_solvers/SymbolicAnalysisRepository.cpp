@@ -0,0 +1,113 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include "SymbolicAnalysisRepository.hpp"
+#include "options/Options.hpp"
+
+namespace uno {
+   namespace {
+      // analyses shared by the solver instances of the process
+      std::map<std::pair<std::string, size_t>, SymbolicAnalysis> memory_analyses{};
+      std::mutex memory_mutex{};
+
+      constexpr uint64_t FILE_FORMAT_VERSION = 1;
+   }
+
+   SymbolicAnalysisRepository::SymbolicAnalysisRepository(std::string solver_name, const Options& options):
+         SymbolicAnalysisRepository(std::move(solver_name), SymbolicAnalysisRepository::persistence_from_string(
+               options.get_string("symbolic_analysis_persistence")), options.get_string("symbolic_analysis_directory"),
+               options.get_unsigned_int("symbolic_analysis_cache_size")) {
+   }
+
+   SymbolicAnalysisRepository::SymbolicAnalysisRepository(std::string solver_name, Persistence persistence, std::string directory,
+         size_t cache_size):
+         solver_name(std::move(solver_name)), persistence(persistence), directory(std::move(directory)), cache_size(cache_size) {
+   }
+
+   std::optional<SymbolicAnalysis> SymbolicAnalysisRepository::find(size_t pattern_key, size_t dimension, size_t number_nonzeros) const {
+      std::optional<SymbolicAnalysis> analysis{};
+      const auto recent_analysis = std::find_if(this->recent_analyses.cbegin(), this->recent_analyses.cend(), [=](const auto& key_analysis) {
+         return key_analysis.first == pattern_key;
+      });
+      if (recent_analysis != this->recent_analyses.cend()) {
+         analysis = recent_analysis->second;
+      }
+      else if (this->persistence == Persistence::MEMORY) {
+         const std::lock_guard<std::mutex> lock(memory_mutex);
+         const auto iterator = memory_analyses.find({this->solver_name, pattern_key});
+         if (iterator != memory_analyses.end()) {
+            analysis = iterator->second;
+         }
+      }
+      else if (this->persistence == Persistence::FILE) {
+         std::ifstream file(this->file_name(pattern_key), std::ios::binary);
+         uint64_t header[4]{};
+         if (file && file.read(reinterpret_cast<char*>(header), sizeof(header)) && header[0] == FILE_FORMAT_VERSION) {
+            SymbolicAnalysis file_analysis{static_cast<size_t>(header[1]), static_cast<size_t>(header[2]), std::vector<int>(header[3])};
+            if (file.read(reinterpret_cast<char*>(file_analysis.data.data()), static_cast<std::streamsize>(header[3] * sizeof(int)))) {
+               analysis = std::move(file_analysis);
+            }
+         }
+      }
+      // guard against key collisions
+      if (analysis.has_value() && (analysis->dimension != dimension || analysis->number_nonzeros != number_nonzeros)) {
+         analysis.reset();
+      }
+      return analysis;
+   }
+
+   void SymbolicAnalysisRepository::store(size_t pattern_key, const SymbolicAnalysis& analysis) const {
+      if (0 < this->cache_size) {
+         const auto recent_analysis = std::remove_if(this->recent_analyses.begin(), this->recent_analyses.end(), [=](const auto& key_analysis) {
+            return key_analysis.first == pattern_key;
+         });
+         this->recent_analyses.erase(recent_analysis, this->recent_analyses.end());
+         if (this->recent_analyses.size() == this->cache_size) {
+            this->recent_analyses.pop_front();
+         }
+         this->recent_analyses.emplace_back(pattern_key, analysis);
+      }
+      if (this->persistence == Persistence::MEMORY) {
+         const std::lock_guard<std::mutex> lock(memory_mutex);
+         memory_analyses[{this->solver_name, pattern_key}] = analysis;
+      }
+      else if (this->persistence == Persistence::FILE) {
+         std::ofstream file(this->file_name(pattern_key), std::ios::binary | std::ios::trunc);
+         if (!file) {
+            throw std::runtime_error("The symbolic analysis could not be written to " + this->file_name(pattern_key));
+         }
+         const uint64_t header[4]{FILE_FORMAT_VERSION, analysis.dimension, analysis.number_nonzeros, analysis.data.size()};
+         file.write(reinterpret_cast<const char*>(header), sizeof(header));
+         file.write(reinterpret_cast<const char*>(analysis.data.data()), static_cast<std::streamsize>(analysis.data.size() * sizeof(int)));
+      }
+   }
+
+   void SymbolicAnalysisRepository::clear_memory() {
+      const std::lock_guard<std::mutex> lock(memory_mutex);
+      memory_analyses.clear();
+   }
+
+   std::string SymbolicAnalysisRepository::file_name(size_t pattern_key) const {
+      return this->directory + "/" + this->solver_name + "_" + std::to_string(pattern_key) + ".analysis";
+   }
+
+   SymbolicAnalysisRepository::Persistence SymbolicAnalysisRepository::persistence_from_string(const std::string& persistence_name) {
+      if (persistence_name == "none") {
+         return Persistence::NONE;
+      }
+      else if (persistence_name == "memory") {
+         return Persistence::MEMORY;
+      }
+      else if (persistence_name == "file") {
+         return Persistence::FILE;
+      }
+      throw std::invalid_argument("The symbolic analysis persistence " + persistence_name + " is unknown");
+   }
+} // namespace
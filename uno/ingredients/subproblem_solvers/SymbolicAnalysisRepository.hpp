@@ -0,0 +1,60 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SYMBOLICANALYSISREPOSITORY_H
+#define UNO_SYMBOLICANALYSISREPOSITORY_H
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   // solver-specific artifacts of a symbolic analysis (e.g. the KEEP array of MA57)
+   struct SymbolicAnalysis {
+      size_t dimension{0};
+      size_t number_nonzeros{0};
+      std::vector<int> data{};
+   };
+
+   /*! \class SymbolicAnalysisRepository
+    * \brief Symbolic analyses persisted across solves of models with the same structure
+    *
+    *  The analyses are indexed by linear solver and sparsity pattern (see OrderingCache::pattern_key). They are kept in memory
+    *  (shared by the solver instances of the process) or in files <directory>/<solver>_<key>.analysis.
+    *  Independently of the persistence, each instance keeps the most recent analyses (e.g. one per phase of the feasibility
+    *  restoration strategy, whose problems alternate) so that switching back to a pattern does not trigger a new analysis
+    */
+   class SymbolicAnalysisRepository {
+   public:
+      enum class Persistence {NONE, MEMORY, FILE};
+
+      SymbolicAnalysisRepository(std::string solver_name, const Options& options);
+      SymbolicAnalysisRepository(std::string solver_name, Persistence persistence, std::string directory, size_t cache_size = 0);
+
+      [[nodiscard]] bool is_enabled() const { return this->persistence != Persistence::NONE || 0 < this->cache_size; }
+      [[nodiscard]] std::optional<SymbolicAnalysis> find(size_t pattern_key, size_t dimension, size_t number_nonzeros) const;
+      void store(size_t pattern_key, const SymbolicAnalysis& analysis) const;
+
+      // discard the analyses kept in memory
+      static void clear_memory();
+
+   protected:
+      const std::string solver_name;
+      const Persistence persistence;
+      const std::string directory;
+      // most recent analyses of this instance (most recent last)
+      const size_t cache_size;
+      mutable std::deque<std::pair<size_t, SymbolicAnalysis>> recent_analyses{};
+
+      [[nodiscard]] std::string file_name(size_t pattern_key) const;
+      [[nodiscard]] static Persistence persistence_from_string(const std::string& persistence_name);
+   };
+} // namespace
+
+#endif // UNO_SYMBOLICANALYSISREPOSITORY_H
@@ -23,6 +23,12 @@ namespace uno {
 
       virtual void solve_indefinite_system(const SymmetricMatrix<IndexType, ElementType>& matrix, const Vector<ElementType>& rhs,
             Vector<ElementType>& result) = 0;
+      // whether the last solve reached the required accuracy (always true for direct solvers)
+      [[nodiscard]] virtual bool has_converged() const { return true; }
+      // memory of the arrays allocated by Uno for the solver (in bytes). The memory allocated by the solver library is not included
+      [[nodiscard]] virtual size_t memory_size() const { return 0; }
+      // largest storage of the factors over the factorizations (in bytes). Solvers whose storage does not grow report 0
+      [[nodiscard]] virtual size_t get_peak_workspace_size() const { return 0; }
 
    protected:
       const size_t dimension;
@@ -1,10 +1,16 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include "SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "AutomaticLinearSolver.hpp"
+#include "BlockTridiagonalSolver.hpp"
+#include "DenseLinearSolver.hpp"
 #include "DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "MixedPrecisionSolver.hpp"
+#include "SchurComplementSolver.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "options/Options.hpp"
 
@@ -17,6 +23,8 @@
 #endif
 
 #ifdef HAS_HSL
+#include "ingredients/subproblem_solvers/MA97/MA97Solver.hpp"
+
 namespace uno {
    extern "C" {
       bool LIBHSL_isfunctional();
@@ -28,18 +36,91 @@ namespace uno {
 #include "ingredients/subproblem_solvers/MUMPS/MUMPSSolver.hpp"
 #endif
 
+#ifdef HAS_SPRAL
+#include "ingredients/subproblem_solvers/SSIDS/SSIDSSolver.hpp"
+#endif
+
+#ifdef HAS_PARDISO
+#include "ingredients/subproblem_solvers/PARDISO/PardisoSolver.hpp"
+#endif
+
 namespace uno {
-   std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> SymmetricIndefiniteLinearSolverFactory::create([[maybe_unused]] size_t dimension,
+   template <typename IndexType>
+   std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, double>> SymmetricIndefiniteLinearSolverFactory::create([[maybe_unused]] size_t dimension,
          [[maybe_unused]] size_t number_nonzeros, const Options& options) {
       try {
-         [[maybe_unused]] const std::string& linear_solver_name = options.get_string("linear_solver");
+         std::string linear_solver_name = options.get_string("linear_solver");
+         // small systems: dense factorization
+         if (linear_solver_name == "auto" && dimension <= options.get_unsigned_int("linear_solver_auto_dense_dimension") &&
+               options.get_string("linear_solver_precision") == "double" && options.get_string("MUMPS_out_of_core") != "yes") {
+            linear_solver_name = "dense";
+         }
+         if (linear_solver_name == "auto") {
+            const std::vector<std::string> candidates = SymmetricIndefiniteLinearSolverFactory::rank_solvers(
+                  SymmetricIndefiniteLinearSolverFactory::available_solvers(), dimension, number_nonzeros, options);
+            if (candidates.empty()) {
+               throw std::invalid_argument("The linear solver auto requires at least one linear solver");
+            }
+            // time the first factorization with the two preferred candidates and keep the faster one. The timings vary between runs:
+            // in deterministic mode, the preferred candidate is kept
+            if (options.get_bool("linear_solver_auto_benchmark") && !options.get_bool("deterministic") && 2 <= candidates.size() &&
+                  options.get_string("linear_solver_precision") == "double" && options.get_string("MUMPS_out_of_core") != "yes") {
+               Options first_options = options;
+               first_options["linear_solver"] = candidates[0];
+               Options second_options = options;
+               second_options["linear_solver"] = candidates[1];
+               return std::make_unique<AutomaticLinearSolver<IndexType>>(dimension,
+                     typename AutomaticLinearSolver<IndexType>::Candidate{candidates[0],
+                        SymmetricIndefiniteLinearSolverFactory::create<IndexType>(dimension, number_nonzeros, first_options)},
+                     typename AutomaticLinearSolver<IndexType>::Candidate{candidates[1],
+                        SymmetricIndefiniteLinearSolverFactory::create<IndexType>(dimension, number_nonzeros, second_options)});
+            }
+            linear_solver_name = candidates[0];
+         }
+         // only MUMPS can store its factors out of core (the Schur complement solver checks its block solver)
+         if (options.get_string("MUMPS_out_of_core") == "yes" && linear_solver_name != "MUMPS" && linear_solver_name != "Schur") {
+            throw std::invalid_argument("The out-of-core factorization is not supported by the linear solver " + linear_solver_name);
+         }
+         const std::string& precision = options.get_string("linear_solver_precision");
+         if (precision == "mixed") {
+            // single-precision factorization, double-precision iterative refinement
+#if defined(HAS_MUMPS) && defined(HAS_SMUMPS)
+            if (linear_solver_name == "MUMPS") {
+               return std::make_unique<MixedPrecisionSolver<IndexType>>(dimension, number_nonzeros,
+                     std::make_unique<MUMPSSolver<IndexType, float>>(dimension, number_nonzeros, options));
+            }
+#endif
+            throw std::invalid_argument("The linear solver " + linear_solver_name + " has no single-precision version available");
+         }
+         else if (precision != "double") {
+            throw std::invalid_argument("The linear solver precision " + precision + " is unknown (double|mixed)");
+         }
+         if (linear_solver_name == "dense") {
+            return std::make_unique<DenseLinearSolver<IndexType>>(dimension, options.get_double("dense_relative_pivot_tolerance"));
+         }
+         if (linear_solver_name == "block_tridiagonal") {
+            return std::make_unique<BlockTridiagonalSolver<IndexType>>(dimension, options.get_double("dense_relative_pivot_tolerance"));
+         }
+         if (linear_solver_name == "Schur") {
+            // the blocks are factorized by their own instances of the block solver
+            Options block_options = options;
+            block_options["linear_solver"] = options.get_string("Schur_block_linear_solver");
+            if (block_options["linear_solver"] == "Schur") {
+               throw std::invalid_argument("The Schur complement solver cannot be its own block solver");
+            }
+            auto block_solver_factory = [block_options](size_t block_dimension, size_t block_number_nonzeros) {
+               return SymmetricIndefiniteLinearSolverFactory::create<IndexType>(block_dimension, block_number_nonzeros, block_options);
+            };
+            return std::make_unique<SchurComplementSolver<IndexType>>(dimension, block_solver_factory,
+                  options.get_double("Schur_linking_degree_factor"));
+         }
 #if defined(HAS_HSL) || defined(HAS_MA57)
          if (linear_solver_name == "MA57"
    #ifdef HAS_HSL
             && LIBHSL_isfunctional()
    #endif
                ) {
-            return std::make_unique<MA57Solver>(dimension, number_nonzeros);
+            return std::make_unique<MA57Solver<IndexType>>(dimension, number_nonzeros, options);
          }
 #endif
 
@@ -49,13 +130,31 @@ namespace uno {
             && LIBHSL_isfunctional()         
    # endif
          ) {
-            return std::make_unique<MA27Solver>(dimension, number_nonzeros);
+            return std::make_unique<MA27Solver<IndexType>>(dimension, number_nonzeros, options);
          }
 #endif // HAS_HSL || HAS_MA27
 
+#ifdef HAS_HSL
+         if (linear_solver_name == "MA97" && LIBHSL_isfunctional()) {
+            return std::make_unique<MA97Solver<IndexType>>(dimension, number_nonzeros);
+         }
+#endif
+
 #ifdef HAS_MUMPS
          if (linear_solver_name == "MUMPS") {
-            return std::make_unique<MUMPSSolver>(dimension, number_nonzeros);
+            return std::make_unique<MUMPSSolver<IndexType>>(dimension, number_nonzeros, options);
+         }
+#endif
+
+#ifdef HAS_SPRAL
+         if (linear_solver_name == "SSIDS") {
+            return std::make_unique<SSIDSSolver<IndexType>>(dimension, number_nonzeros, options);
+         }
+#endif
+
+#ifdef HAS_PARDISO
+         if (linear_solver_name == "PARDISO") {
+            return std::make_unique<PardisoSolver<IndexType>>(dimension, number_nonzeros, options);
          }
 #endif
          std::string message = "The linear solver ";
@@ -71,6 +170,37 @@ namespace uno {
       }
    }
 
+   template std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> SymmetricIndefiniteLinearSolverFactory::create<size_t>(size_t,
+         size_t, const Options&);
+   template std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<int, double>> SymmetricIndefiniteLinearSolverFactory::create<int>(size_t,
+         size_t, const Options&);
+
+   // small matrices: the multifrontal MA27 (smallest overhead), then MA57. Large matrices: the threaded solvers PARDISO, MA97 and
+   // MUMPS. The size of the matrix (dimension + number of nonzeros) stands for the fill of the factors, unknown before the analysis
+   std::vector<std::string> SymmetricIndefiniteLinearSolverFactory::rank_solvers(const std::vector<std::string>& available_solvers,
+         size_t dimension, size_t number_nonzeros, const Options& options) {
+      static const std::vector<std::string> small_preferences{"MA27", "MA57", "MUMPS", "SSIDS", "MA97", "PARDISO"};
+      static const std::vector<std::string> medium_preferences{"MA57", "MA27", "MUMPS", "MA97", "SSIDS", "PARDISO"};
+      static const std::vector<std::string> large_preferences{"PARDISO", "MA97", "MUMPS", "SSIDS", "MA57", "MA27"};
+      const size_t size = dimension + number_nonzeros;
+      const std::vector<std::string>& preferences = (size < options.get_unsigned_int("linear_solver_auto_medium_size")) ? small_preferences :
+            (size < options.get_unsigned_int("linear_solver_auto_large_size")) ? medium_preferences : large_preferences;
+      std::vector<std::string> ranking{};
+      // only MUMPS supports the single-precision factorization and the out-of-core storage
+      if (options.get_string("linear_solver_precision") == "mixed" || options.get_string("MUMPS_out_of_core") == "yes") {
+         if (std::find(available_solvers.cbegin(), available_solvers.cend(), "MUMPS") != available_solvers.cend()) {
+            ranking.emplace_back("MUMPS");
+         }
+         return ranking;
+      }
+      for (const std::string& solver: preferences) {
+         if (std::find(available_solvers.cbegin(), available_solvers.cend(), solver) != available_solvers.cend()) {
+            ranking.emplace_back(solver);
+         }
+      }
+      return ranking;
+   }
+
    // return the list of available solvers
    std::vector<std::string> SymmetricIndefiniteLinearSolverFactory::available_solvers() {
       std::vector<std::string> solvers{};
@@ -78,6 +208,7 @@ namespace uno {
       if (LIBHSL_isfunctional()) {
             solvers.emplace_back("MA57");
             solvers.emplace_back("MA27");
+            solvers.emplace_back("MA97");
          }
 #else
    #ifdef HAS_MA57
@@ -91,6 +222,18 @@ namespace uno {
 #ifdef HAS_MUMPS
       solvers.emplace_back("MUMPS");
 #endif
+
+#ifdef HAS_SPRAL
+      solvers.emplace_back("SSIDS");
+#endif
+
+#ifdef HAS_PARDISO
+      solvers.emplace_back("PARDISO");
+#endif
+      // the Schur complement solver delegates the factorization of the blocks to one of the solvers above
+      if (!solvers.empty()) {
+         solvers.emplace_back("Schur");
+      }
       return solvers;
    }
 } // namespace
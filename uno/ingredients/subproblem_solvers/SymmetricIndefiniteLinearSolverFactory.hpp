@@ -5,6 +5,7 @@
 #define UNO_LINEARSOLVERFACTORY_H
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace uno {
@@ -15,11 +16,18 @@ namespace uno {
 
    class SymmetricIndefiniteLinearSolverFactory {
    public:
-      static std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> create([[maybe_unused]] size_t dimension,
+      // IndexType is the index type of the matrices (size_t or int). The solvers borrow the indices of COO matrices with
+      // 1-based int indices (see FortranIndices)
+      template <typename IndexType = size_t>
+      static std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, double>> create([[maybe_unused]] size_t dimension,
             [[maybe_unused]] size_t number_nonzeros, const Options& options);
 
       // return the list of available solvers
       static std::vector<std::string> available_solvers();
+
+      // linear_solver = auto: the available solvers (except Schur), ordered by preference for a matrix of the given size
+      [[nodiscard]] static std::vector<std::string> rank_solvers(const std::vector<std::string>& available_solvers, size_t dimension,
+            size_t number_nonzeros, const Options& options);
    };
 } // namespace
 
@@ -0,0 +1,58 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_ALIGNEDALLOCATOR_H
+#define UNO_ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include "tools/MemoryPolicy.hpp"
+
+namespace uno {
+   // allocator that aligns the memory on the given boundary (by default, a cache line, which is also the width of AVX-512 registers).
+   // The large buffers are placed according to the MemoryPolicy (NUMA first touch, huge pages); their mappings are page-aligned
+   template <typename ElementType, std::size_t Alignment = 64>
+   class AlignedAllocator {
+   public:
+      using value_type = ElementType;
+      static_assert(alignof(ElementType) <= Alignment, "AlignedAllocator: the alignment is too small for the element type");
+      static_assert(Alignment <= 4096, "AlignedAllocator: the alignment should not exceed a page");
+
+      template <typename OtherElementType>
+      struct rebind {
+         using other = AlignedAllocator<OtherElementType, Alignment>;
+      };
+
+      AlignedAllocator() noexcept = default;
+      template <typename OtherElementType>
+      AlignedAllocator(const AlignedAllocator<OtherElementType, Alignment>& /*other*/) noexcept { }
+
+      [[nodiscard]] ElementType* allocate(std::size_t number_elements) {
+         if (std::numeric_limits<std::size_t>::max() / sizeof(ElementType) < number_elements) {
+            throw std::bad_array_new_length();
+         }
+         const std::size_t size = number_elements * sizeof(ElementType);
+         if (MemoryPolicy::large_buffer_threshold <= size) {
+            if (void* buffer = MemoryPolicy::allocate_large_buffer(size); buffer != nullptr) {
+               return static_cast<ElementType*>(buffer);
+            }
+         }
+         return static_cast<ElementType*>(::operator new(size, std::align_val_t(Alignment)));
+      }
+
+      void deallocate(ElementType* pointer, std::size_t number_elements) noexcept {
+         if (MemoryPolicy::deallocate_large_buffer(pointer, number_elements * sizeof(ElementType))) {
+            return;
+         }
+         ::operator delete(pointer, std::align_val_t(Alignment));
+      }
+
+      template <typename OtherElementType>
+      bool operator==(const AlignedAllocator<OtherElementType, Alignment>& /*other*/) const noexcept { return true; }
+      template <typename OtherElementType>
+      bool operator!=(const AlignedAllocator<OtherElementType, Alignment>& /*other*/) const noexcept { return false; }
+   };
+} // namespace
+
+#endif // UNO_ALIGNEDALLOCATOR_H
@@ -0,0 +1,195 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BATCHEDDENSELDLT_H
+#define UNO_BATCHEDDENSELDLT_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "AlignedAllocator.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   /*! \class BatchedDenseLDLT
+    * \brief Dense LDL^T factorizations of a batch of symmetric matrices with the same dimension
+    *
+    *  The matrices are stored as a structure of arrays: the entry (i, j) of all the instances is contiguous, so that the innermost
+    *  loop runs over the instances and is vectorized by the compiler (one instance per SIMD lane). The factorization is
+    *  right-looking without pivoting, which keeps the control flow identical across the batch. A pivot whose magnitude does not
+    *  exceed the pivot tolerance is replaced by 1 and the instance is flagged as singular; the other instances are unaffected
+    */
+   template <typename ElementType>
+   class BatchedDenseLDLT {
+   public:
+      BatchedDenseLDLT(size_t dimension, size_t batch_size);
+
+      [[nodiscard]] size_t dimension() const { return this->matrix_dimension; }
+      [[nodiscard]] size_t batch_size() const { return this->number_instances; }
+
+      // entry (row, column) of an instance. Only the lower triangle (row >= column) is read by the factorization
+      [[nodiscard]] ElementType& entry(size_t row, size_t column, size_t instance);
+      [[nodiscard]] const ElementType& entry(size_t row, size_t column, size_t instance) const;
+      void reset();
+
+      // overwrites the lower triangle with L (unit diagonal implicit) and the diagonal with D
+      void factorize(ElementType pivot_tolerance = ElementType(0));
+      // solves the systems in place. The right-hand sides are stored as a structure of arrays: rhs[i * batch_size + instance]
+      void solve(std::vector<ElementType, AlignedAllocator<ElementType>>& rhs) const;
+
+      [[nodiscard]] bool is_singular(size_t instance) const { return 0 < this->zero_pivots[instance]; }
+      // (number of positive, negative and zero eigenvalues) of an instance
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia(size_t instance) const;
+
+   protected:
+      const size_t matrix_dimension;
+      const size_t number_instances;
+      std::vector<ElementType, AlignedAllocator<ElementType>> factors;
+      std::vector<ElementType, AlignedAllocator<ElementType>> scaled_column; /*!< column of L times the pivot, for each instance */
+      std::vector<size_t> zero_pivots; /*!< number of replaced pivots of each instance */
+      bool is_factorized{false};
+
+      [[nodiscard]] size_t offset(size_t row, size_t column) const { return (column * this->matrix_dimension + row) * this->number_instances; }
+   };
+
+   // implementation
+
+   template <typename ElementType>
+   BatchedDenseLDLT<ElementType>::BatchedDenseLDLT(size_t dimension, size_t batch_size):
+         matrix_dimension(dimension), number_instances(batch_size),
+         factors(dimension * dimension * batch_size, ElementType(0)),
+         scaled_column(batch_size, ElementType(0)),
+         zero_pivots(batch_size, 0) {
+      if (batch_size == 0) {
+         throw std::invalid_argument("BatchedDenseLDLT: the batch is empty");
+      }
+   }
+
+   template <typename ElementType>
+   ElementType& BatchedDenseLDLT<ElementType>::entry(size_t row, size_t column, size_t instance) {
+      this->is_factorized = false;
+      return this->factors[this->offset(row, column) + instance];
+   }
+
+   template <typename ElementType>
+   const ElementType& BatchedDenseLDLT<ElementType>::entry(size_t row, size_t column, size_t instance) const {
+      return this->factors[this->offset(row, column) + instance];
+   }
+
+   template <typename ElementType>
+   void BatchedDenseLDLT<ElementType>::reset() {
+      std::fill(this->factors.begin(), this->factors.end(), ElementType(0));
+      std::fill(this->zero_pivots.begin(), this->zero_pivots.end(), size_t(0));
+      this->is_factorized = false;
+   }
+
+   template <typename ElementType>
+   void BatchedDenseLDLT<ElementType>::factorize(ElementType pivot_tolerance) {
+      const size_t n = this->matrix_dimension;
+      const size_t batch = this->number_instances;
+      ElementType* const A = this->factors.data();
+      ElementType* const scaled_entries = this->scaled_column.data();
+      std::fill(this->zero_pivots.begin(), this->zero_pivots.end(), size_t(0));
+      for (size_t k: Range(n)) {
+         // pivot
+         ElementType* const diagonal = A + this->offset(k, k);
+         for (size_t instance: Range(batch)) {
+            if (std::abs(diagonal[instance]) <= pivot_tolerance) {
+               diagonal[instance] = ElementType(1);
+               this->zero_pivots[instance]++;
+            }
+         }
+         // column of L
+         for (size_t i = k + 1; i < n; i++) {
+            ElementType* const column_entry = A + this->offset(i, k);
+            for (size_t instance = 0; instance < batch; instance++) {
+               column_entry[instance] /= diagonal[instance];
+            }
+         }
+         // rank-one update of the trailing lower triangle: A(i, j) -= L(i, k) D(k) L(j, k)
+         for (size_t j = k + 1; j < n; j++) {
+            const ElementType* const L_jk = A + this->offset(j, k);
+            for (size_t instance = 0; instance < batch; instance++) {
+               scaled_entries[instance] = L_jk[instance] * diagonal[instance];
+            }
+            for (size_t i = j; i < n; i++) {
+               const ElementType* const L_ik = A + this->offset(i, k);
+               ElementType* const A_ij = A + this->offset(i, j);
+               for (size_t instance = 0; instance < batch; instance++) {
+                  A_ij[instance] -= L_ik[instance] * scaled_entries[instance];
+               }
+            }
+         }
+      }
+      this->is_factorized = true;
+   }
+
+   template <typename ElementType>
+   void BatchedDenseLDLT<ElementType>::solve(std::vector<ElementType, AlignedAllocator<ElementType>>& rhs) const {
+      if (!this->is_factorized) {
+         throw std::runtime_error("BatchedDenseLDLT: the matrices are not factorized");
+      }
+      const size_t n = this->matrix_dimension;
+      const size_t batch = this->number_instances;
+      if (rhs.size() != n * batch) {
+         throw std::invalid_argument("BatchedDenseLDLT: the right-hand sides do not have the dimension of the batch");
+      }
+      const ElementType* const A = this->factors.data();
+      ElementType* const x = rhs.data();
+      // forward substitution L y = b
+      for (size_t k: Range(n)) {
+         const ElementType* const x_k = x + k * batch;
+         for (size_t i = k + 1; i < n; i++) {
+            const ElementType* const L_ik = A + this->offset(i, k);
+            ElementType* const x_i = x + i * batch;
+            for (size_t instance = 0; instance < batch; instance++) {
+               x_i[instance] -= L_ik[instance] * x_k[instance];
+            }
+         }
+      }
+      // diagonal D z = y
+      for (size_t k: Range(n)) {
+         const ElementType* const diagonal = A + this->offset(k, k);
+         ElementType* const x_k = x + k * batch;
+         for (size_t instance = 0; instance < batch; instance++) {
+            x_k[instance] /= diagonal[instance];
+         }
+      }
+      // backward substitution L^T x = z
+      for (size_t k = n; k-- > 0;) {
+         ElementType* const x_k = x + k * batch;
+         for (size_t i = k + 1; i < n; i++) {
+            const ElementType* const L_ik = A + this->offset(i, k);
+            const ElementType* const x_i = x + i * batch;
+            for (size_t instance = 0; instance < batch; instance++) {
+               x_k[instance] -= L_ik[instance] * x_i[instance];
+            }
+         }
+      }
+   }
+
+   template <typename ElementType>
+   std::tuple<size_t, size_t, size_t> BatchedDenseLDLT<ElementType>::get_inertia(size_t instance) const {
+      if (!this->is_factorized) {
+         throw std::runtime_error("BatchedDenseLDLT: the matrices are not factorized");
+      }
+      // without pivoting, the inertia of an instance is that of its pivots (Sylvester's law of inertia). The replaced pivots (1)
+      // are counted as zero eigenvalues
+      size_t number_positive = 0, number_negative = 0;
+      for (size_t k: Range(this->matrix_dimension)) {
+         if (ElementType(0) < this->factors[this->offset(k, k) + instance]) {
+            number_positive++;
+         }
+         else {
+            number_negative++;
+         }
+      }
+      const size_t number_zero = this->zero_pivots[instance];
+      return {number_positive - number_zero, number_negative, number_zero};
+   }
+} // namespace
+
+#endif // UNO_BATCHEDDENSELDLT_H
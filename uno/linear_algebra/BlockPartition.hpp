@@ -0,0 +1,122 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BLOCKPARTITION_H
+#define UNO_BLOCKPARTITION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "SymmetricMatrix.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   /*! \class BlockPartition
+    * \brief Partition of the indices of a symmetric matrix into independent blocks and a (possibly empty) linking set
+    *
+    *  Two indices in different blocks are never coupled by a nonzero: the matrix is block diagonal with a border made of the
+    *  linking indices (block-angular structure of multi-scenario problems)
+    */
+   class BlockPartition {
+   public:
+      static constexpr size_t linking = std::numeric_limits<size_t>::max();
+
+      std::vector<size_t> block_of_index{}; /*!< block of each index, or BlockPartition::linking */
+      size_t number_blocks{0};
+
+      BlockPartition() = default;
+      // the blocks are numbered 0, ..., number_blocks-1
+      explicit BlockPartition(std::vector<size_t>&& block_of_index);
+
+      [[nodiscard]] size_t dimension() const { return this->block_of_index.size(); }
+      [[nodiscard]] size_t number_linking_indices() const;
+
+      // connected components of the graph of the matrix once the linking indices are removed. The indices whose degree exceeds
+      // linking_degree_factor times the average degree are linking indices (no index is linking if the factor is 0)
+      template <typename IndexType, typename ElementType>
+      static BlockPartition detect(const SymmetricMatrix<IndexType, ElementType>& matrix, double linking_degree_factor);
+   };
+
+   // implementation
+
+   inline BlockPartition::BlockPartition(std::vector<size_t>&& block_of_index): block_of_index(std::move(block_of_index)) {
+      for (const size_t block: this->block_of_index) {
+         if (block != BlockPartition::linking) {
+            this->number_blocks = std::max(this->number_blocks, block + 1);
+         }
+      }
+   }
+
+   inline size_t BlockPartition::number_linking_indices() const {
+      size_t number_linking_indices = 0;
+      for (const size_t block: this->block_of_index) {
+         if (block == BlockPartition::linking) {
+            number_linking_indices++;
+         }
+      }
+      return number_linking_indices;
+   }
+
+   template <typename IndexType, typename ElementType>
+   BlockPartition BlockPartition::detect(const SymmetricMatrix<IndexType, ElementType>& matrix, double linking_degree_factor) {
+      const size_t dimension = matrix.dimension();
+      // linking indices: the indices with a large degree
+      std::vector<bool> is_linking(dimension, false);
+      if (0. < linking_degree_factor && 0 < dimension) {
+         std::vector<size_t> degrees(dimension, 0);
+         size_t number_off_diagonal_nonzeros = 0;
+         matrix.for_each([&](size_t row_index, size_t column_index, ElementType /*element*/) {
+            if (row_index != column_index) {
+               degrees[row_index]++;
+               degrees[column_index]++;
+               number_off_diagonal_nonzeros++;
+            }
+         });
+         const double average_degree = 2. * static_cast<double>(number_off_diagonal_nonzeros) / static_cast<double>(dimension);
+         for (size_t index: Range(dimension)) {
+            is_linking[index] = (linking_degree_factor * average_degree < static_cast<double>(degrees[index]));
+         }
+      }
+
+      // union-find with path halving over the nonzeros between regular indices
+      std::vector<size_t> parent(dimension);
+      std::iota(parent.begin(), parent.end(), size_t(0));
+      const auto find_root = [&](size_t index) {
+         while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+         }
+         return index;
+      };
+      matrix.for_each([&](size_t row_index, size_t column_index, ElementType /*element*/) {
+         if (row_index != column_index && !is_linking[row_index] && !is_linking[column_index]) {
+            const size_t row_root = find_root(row_index);
+            const size_t column_root = find_root(column_index);
+            if (row_root != column_root) {
+               parent[std::max(row_root, column_root)] = std::min(row_root, column_root);
+            }
+         }
+      });
+
+      // number the components in the order of their smallest index
+      std::vector<size_t> block_of_index(dimension, BlockPartition::linking);
+      std::vector<size_t> block_of_root(dimension, BlockPartition::linking);
+      size_t number_blocks = 0;
+      for (size_t index: Range(dimension)) {
+         if (!is_linking[index]) {
+            const size_t root = find_root(index);
+            if (block_of_root[root] == BlockPartition::linking) {
+               block_of_root[root] = number_blocks;
+               number_blocks++;
+            }
+            block_of_index[index] = block_of_root[root];
+         }
+      }
+      return BlockPartition(std::move(block_of_index));
+   }
+} // namespace
+
+#endif // UNO_BLOCKPARTITION_H
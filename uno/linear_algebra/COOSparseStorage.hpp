@@ -6,6 +6,7 @@
 
 #include <cassert>
 #include <vector>
+#include "AlignedAllocator.hpp"
 #include "SparseStorage.hpp"
 #include "symbolic/Range.hpp"
 
@@ -15,19 +16,39 @@ namespace uno {
     * https://en.wikipedia.org/wiki/Sparse_matrix#Coordinate_list_(COO)
     */
    template <typename IndexType, typename ElementType>
-   class COOSparseStorage : public SparseStorage<IndexType, ElementType> {
+   class COOSparseStorage final : public SparseStorage<IndexType, ElementType> {
    public:
-      COOSparseStorage(size_t dimension, size_t capacity, bool use_regularization);
+      COOSparseStorage(size_t dimension, size_t capacity, bool use_regularization, size_t index_shift = 0);
 
       void reset() override;
       void insert(ElementType term, IndexType row_index, IndexType column_index) override;
       void finalize_column(IndexType /*column_index*/) override { /* do nothing */ }
-      void set_regularization(const std::function<ElementType(size_t index)>& regularization_function) override;
+      // the regularization function is any callable size_t -> ElementType
+      template <typename Function>
+      void set_regularization(const Function& regularization_function);
       const ElementType* data_pointer() const noexcept override { return this->entries.data(); }
       ElementType* data_pointer() noexcept override { return this->entries.data(); }
+      [[nodiscard]] size_t memory_size() const override {
+         return SparseStorage<IndexType, ElementType>::memory_size() + this->entries.capacity() * sizeof(ElementType) +
+            (this->row_indices.capacity() + this->column_indices.capacity()) * sizeof(IndexType) +
+            this->block_diagonal_offsets.capacity() * sizeof(size_t);
+      }
 
       void print(std::ostream& stream) const override;
 
+      // appends a block of nonzeros with a fixed sparsity pattern (0-based indices, the arrays must not change between calls) and
+      // returns the address of its elements, so that they can be written in place. The indices are only written if the block is not
+      // already stored at the same position, e.g. when the matrix is refilled in the same order after reset()
+      ElementType* insert_block(const IndexType* block_row_indices, const IndexType* block_column_indices, size_t block_size);
+
+      // non-virtual traversal of the nonzeros (row index, column index, element)
+      template <typename Function>
+      void for_each(const Function& function) const;
+      // traversal of the diagonal terms (index, element)
+      template <typename Function>
+      void for_each_diagonal(const Function& function) const;
+
+      // the stored indices are shifted by index_shift
       const IndexType* row_indices_pointer() const {
          return this->row_indices.data();
       }
@@ -42,9 +63,16 @@ namespace uno {
       }
 
    protected:
-      std::vector<ElementType> entries;
+      // the arrays are not shrunk by reset(): the first number_nonzeros elements are the nonzeros
+      std::vector<ElementType, AlignedAllocator<ElementType>> entries;
       std::vector<IndexType> row_indices;
       std::vector<IndexType> column_indices;
+      // last inserted block, whose indices are still stored if is_block_stored
+      const IndexType* block_pattern{nullptr};
+      size_t block_start{0};
+      size_t block_size{0};
+      bool is_block_stored{false};
+      std::vector<size_t> block_diagonal_offsets{};
 
       void initialize_regularization();
 
@@ -56,8 +84,8 @@ namespace uno {
    // implementation
 
    template <typename IndexType, typename ElementType>
-   COOSparseStorage<IndexType, ElementType>::COOSparseStorage(size_t dimension, size_t capacity, bool use_regularization):
-         SparseStorage<IndexType, ElementType>(dimension, capacity, use_regularization) {
+   COOSparseStorage<IndexType, ElementType>::COOSparseStorage(size_t dimension, size_t capacity, bool use_regularization, size_t index_shift):
+         SparseStorage<IndexType, ElementType>(dimension, capacity, use_regularization, index_shift) {
       this->entries.reserve(this->capacity);
       this->row_indices.reserve(this->capacity);
       this->column_indices.reserve(this->capacity);
@@ -70,11 +98,10 @@ namespace uno {
 
    template <typename IndexType, typename ElementType>
    void COOSparseStorage<IndexType, ElementType>::reset() {
-      // empty the matrix
+      // empty the matrix (the arrays keep their elements, so that a block may be reused)
       this->number_nonzeros = 0;
-      this->entries.clear();
-      this->row_indices.clear();
-      this->column_indices.clear();
+      this->diagonal_slots.clear();
+      this->regularization_slots.clear();
 
       // initialize regularization terms
       if (this->use_regularization) {
@@ -84,22 +111,89 @@ namespace uno {
 
    template <typename IndexType, typename ElementType>
    void COOSparseStorage<IndexType, ElementType>::insert(ElementType term, IndexType row_index, IndexType column_index) {
-      assert(this->number_nonzeros <= this->row_indices.size() && "The COO matrix doesn't have a sufficient capacity");
-
-      this->entries.emplace_back(term);
-      this->row_indices.emplace_back(row_index);
-      this->column_indices.emplace_back(column_index);
+      const size_t position = this->number_nonzeros;
+      if (row_index == column_index) {
+         this->diagonal_slots.emplace_back(position);
+      }
+      if (position < this->entries.size()) {
+         this->entries[position] = term;
+         this->row_indices[position] = row_index + this->index_shift;
+         this->column_indices[position] = column_index + this->index_shift;
+         // the stored block is overwritten
+         if (this->is_block_stored && this->block_start <= position && position < this->block_start + this->block_size) {
+            this->is_block_stored = false;
+         }
+      }
+      else {
+         this->entries.emplace_back(term);
+         this->row_indices.emplace_back(row_index + this->index_shift);
+         this->column_indices.emplace_back(column_index + this->index_shift);
+      }
       this->number_nonzeros++;
    }
 
    template <typename IndexType, typename ElementType>
-   void COOSparseStorage<IndexType, ElementType>::set_regularization(const std::function<ElementType(size_t /*index*/)>& regularization_function) {
+   ElementType* COOSparseStorage<IndexType, ElementType>::insert_block(const IndexType* block_row_indices, const IndexType* block_column_indices,
+         size_t block_size) {
+      const size_t start = this->number_nonzeros;
+      const size_t end = start + block_size;
+      if (this->entries.size() < end) {
+         this->entries.resize(end);
+         this->row_indices.resize(end);
+         this->column_indices.resize(end);
+      }
+      const bool is_block_reused = this->is_block_stored && this->block_pattern == block_row_indices && this->block_start == start &&
+         this->block_size == block_size;
+      if (!is_block_reused) {
+         this->block_diagonal_offsets.clear();
+         for (size_t index: Range(block_size)) {
+            this->row_indices[start + index] = block_row_indices[index] + this->index_shift;
+            this->column_indices[start + index] = block_column_indices[index] + this->index_shift;
+            if (block_row_indices[index] == block_column_indices[index]) {
+               this->block_diagonal_offsets.emplace_back(index);
+            }
+         }
+         this->block_pattern = block_row_indices;
+         this->block_start = start;
+         this->block_size = block_size;
+         this->is_block_stored = true;
+      }
+      for (size_t offset: this->block_diagonal_offsets) {
+         this->diagonal_slots.emplace_back(start + offset);
+      }
+      this->number_nonzeros = end;
+      return this->entries.data() + start;
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename Function>
+   void COOSparseStorage<IndexType, ElementType>::set_regularization(const Function& regularization_function) {
       assert(this->use_regularization && "You are trying to regularize a matrix where regularization was not preallocated.");
 
       // the regularization terms (that lie at the start of the entries vector) can be directly modified
       for (size_t row_index: Range(this->dimension)) {
          const ElementType element = regularization_function(row_index);
-         this->entries[row_index] = element;
+         this->entries[this->regularization_slots[row_index]] = element;
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename Function>
+   inline void COOSparseStorage<IndexType, ElementType>::for_each(const Function& function) const {
+      const IndexType* rows = this->row_indices.data();
+      const IndexType* columns = this->column_indices.data();
+      const ElementType* elements = this->entries.data();
+      const IndexType shift = this->index_shift;
+      for (size_t nonzero_index: Range(this->number_nonzeros)) {
+         function(rows[nonzero_index] - shift, columns[nonzero_index] - shift, elements[nonzero_index]);
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename Function>
+   inline void COOSparseStorage<IndexType, ElementType>::for_each_diagonal(const Function& function) const {
+      for (size_t nonzero_index: this->diagonal_slots) {
+         function(this->row_indices[nonzero_index] - this->index_shift, this->entries[nonzero_index]);
       }
    }
 
@@ -114,6 +208,7 @@ namespace uno {
    void COOSparseStorage<IndexType, ElementType>::initialize_regularization() {
       // introduce elements at the start of the entries
       for (size_t row_index: Range(this->dimension)) {
+         this->regularization_slots.emplace_back(this->number_nonzeros);
          this->insert(ElementType(0), IndexType(row_index), IndexType(row_index));
       }
    }
@@ -121,7 +216,8 @@ namespace uno {
    template <typename IndexType, typename ElementType>
    std::tuple<IndexType, IndexType, ElementType> COOSparseStorage<IndexType, ElementType>::dereference_iterator(size_t /*column_index*/,
          size_t nonzero_index) const {
-      return {this->row_indices[nonzero_index], this->column_indices[nonzero_index], this->entries[nonzero_index]};
+      return {this->row_indices[nonzero_index] - this->index_shift, this->column_indices[nonzero_index] - this->index_shift,
+         this->entries[nonzero_index]};
    }
 
    template <typename IndexType, typename ElementType>
@@ -6,9 +6,11 @@
 
 #include <cassert>
 #include <vector>
+#include "AlignedAllocator.hpp"
 #include "SparseStorage.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "tools/Infinity.hpp"
+#include "symbolic/Range.hpp"
 #include "symbolic/VectorView.hpp"
 
 namespace uno {
@@ -18,21 +20,42 @@ namespace uno {
  */
 
    template <typename IndexType, typename ElementType>
-   class CSCSparseStorage : public SparseStorage<IndexType, ElementType> {
+   class CSCSparseStorage final : public SparseStorage<IndexType, ElementType> {
    public:
-      CSCSparseStorage(size_t dimension, size_t capacity, bool use_regularization);
+      CSCSparseStorage(size_t dimension, size_t capacity, bool use_regularization, size_t index_shift = 0);
 
       void reset() override;
       void insert(ElementType term, IndexType row_index, IndexType column_index) override;
       void finalize_column(IndexType column_index) override;
-      void set_regularization(const std::function<ElementType(IndexType /*index*/)>& regularization_function) override;
+      // the regularization function is any callable size_t -> ElementType
+      template <typename Function>
+      void set_regularization(const Function& regularization_function);
       const ElementType* data_pointer() const noexcept override { return this->entries.data(); }
       ElementType* data_pointer() noexcept override { return this->entries.data(); }
+      [[nodiscard]] size_t memory_size() const override {
+         return SparseStorage<IndexType, ElementType>::memory_size() + this->entries.capacity() * sizeof(ElementType) +
+            this->column_starts.memory_size() + this->row_indices.capacity() * sizeof(IndexType);
+      }
 
       void print(std::ostream& stream) const override;
 
+      // non-virtual traversal of the nonzeros (row index, column index, element)
+      template <typename Function>
+      void for_each(const Function& function) const;
+      // traversal of the diagonal terms (index, element)
+      template <typename Function>
+      void for_each_diagonal(const Function& function) const;
+
+      // the stored row indices are shifted by index_shift, the column starts are not
+      const IndexType* column_starts_pointer() const {
+         return this->column_starts.data();
+      }
+      const IndexType* row_indices_pointer() const {
+         return this->row_indices.data();
+      }
+
    protected:
-      std::vector<ElementType> entries;
+      std::vector<ElementType, AlignedAllocator<ElementType>> entries;
       // entries and row_indices have nnz elements
       // column_starts has dimension+1 elements
       Vector<IndexType> column_starts{};
@@ -40,13 +63,13 @@ namespace uno {
       IndexType current_column{0};
 
       // iterator functions
-      [[nodiscard]] std::tuple<IndexType, IndexType, ElementType> dereference_iterator(IndexType column_index, size_t nonzero_index) const override;
-      void increment_iterator(IndexType& column_index, IndexType& nonzero_index) const override;
+      [[nodiscard]] std::tuple<IndexType, IndexType, ElementType> dereference_iterator(size_t column_index, size_t nonzero_index) const override;
+      void increment_iterator(size_t& column_index, size_t& nonzero_index) const override;
    };
 
    template <typename IndexType, typename ElementType>
-   CSCSparseStorage<IndexType, ElementType>::CSCSparseStorage(size_t dimension, size_t capacity, bool use_regularization):
-         SparseStorage<IndexType, ElementType>(dimension, capacity, use_regularization),
+   CSCSparseStorage<IndexType, ElementType>::CSCSparseStorage(size_t dimension, size_t capacity, bool use_regularization, size_t index_shift):
+         SparseStorage<IndexType, ElementType>(dimension, capacity, use_regularization, index_shift),
          column_starts(dimension + 1) {
       this->entries.reserve(this->capacity);
       this->row_indices.reserve(this->capacity);
@@ -60,56 +83,88 @@ namespace uno {
       this->row_indices.clear();
       this->column_starts.fill(0);
       this->current_column = 0;
+      this->diagonal_slots.clear();
+      this->regularization_slots.clear();
    }
 
    template <typename IndexType, typename ElementType>
    void CSCSparseStorage<IndexType, ElementType>::insert(ElementType term, IndexType row_index, IndexType column_index) {
       assert(column_index == this->current_column && "The previous columns should be finalized");
 
+      if (row_index == column_index) {
+         this->diagonal_slots.emplace_back(this->number_nonzeros);
+      }
       this->entries.emplace_back(term);
-      this->row_indices.emplace_back(row_index);
-      this->column_starts[column_index + 1]++;
+      this->row_indices.emplace_back(row_index + this->index_shift);
+      this->column_starts[static_cast<size_t>(column_index) + 1]++;
       this->number_nonzeros++;
    }
 
    template <typename IndexType, typename ElementType>
    void CSCSparseStorage<IndexType, ElementType>::finalize_column(IndexType column_index) {
       assert(column_index == this->current_column && "You are not finalizing the current column");
-      assert(column_index < this->dimension && "The dimension of the matrix was exceeded");
+      assert(static_cast<size_t>(column_index) < this->dimension && "The dimension of the matrix was exceeded");
 
       // possibly add regularization
       if (this->use_regularization) {
+         this->regularization_slots.emplace_back(this->number_nonzeros);
          this->insert(ElementType(0), column_index, column_index);
       }
       this->current_column++;
 
       // start the next column at the current start
-      if (column_index < this->dimension - 1) {
-         this->column_starts[column_index + 2] = this->column_starts[column_index + 1];
+      const size_t column = static_cast<size_t>(column_index);
+      if (column < this->dimension - 1) {
+         this->column_starts[column + 2] = this->column_starts[column + 1];
       }
    }
 
    template <typename IndexType, typename ElementType>
-   void CSCSparseStorage<IndexType, ElementType>::set_regularization(const std::function<ElementType(IndexType /*index*/)>& regularization_function) {
+   template <typename Function>
+   void CSCSparseStorage<IndexType, ElementType>::set_regularization(const Function& regularization_function) {
       assert(this->use_regularization && "You are trying to regularize a matrix where regularization was not preallocated.");
 
+      assert(this->dimension <= this->regularization_slots.size() && "Some columns were not finalized");
+
+      // the regularization term of each column was recorded when the column was finalized
       for (size_t row_index: Range(this->dimension)) {
-         // the regularization term is located at the end of the column, that is right before the start of the next column
-         const size_t k = static_cast<size_t>(this->column_starts[row_index + 1] - 1);
          const ElementType element = regularization_function(row_index);
-         this->entries[k] = element;
+         this->entries[this->regularization_slots[row_index]] = element;
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename Function>
+   inline void CSCSparseStorage<IndexType, ElementType>::for_each(const Function& function) const {
+      const IndexType* rows = this->row_indices.data();
+      const ElementType* elements = this->entries.data();
+      const IndexType shift = this->index_shift;
+      for (size_t column_index: Range(this->dimension)) {
+         const size_t column_end = static_cast<size_t>(this->column_starts[column_index + 1]);
+         for (size_t nonzero_index = static_cast<size_t>(this->column_starts[column_index]); nonzero_index < column_end; nonzero_index++) {
+            function(rows[nonzero_index] - shift, static_cast<IndexType>(column_index), elements[nonzero_index]);
+         }
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename Function>
+   inline void CSCSparseStorage<IndexType, ElementType>::for_each_diagonal(const Function& function) const {
+      for (size_t nonzero_index: this->diagonal_slots) {
+         function(this->row_indices[nonzero_index] - this->index_shift, this->entries[nonzero_index]);
       }
    }
 
    template <typename IndexType, typename ElementType>
-   std::tuple<IndexType, IndexType, ElementType> CSCSparseStorage<IndexType, ElementType>::dereference_iterator(IndexType column_index,
+   std::tuple<IndexType, IndexType, ElementType> CSCSparseStorage<IndexType, ElementType>::dereference_iterator(size_t column_index,
          size_t nonzero_index) const {
-      return {this->row_indices[nonzero_index], column_index, this->entries[nonzero_index]};
+      return {this->row_indices[nonzero_index] - this->index_shift, static_cast<IndexType>(column_index), this->entries[nonzero_index]};
    }
 
    template <typename IndexType, typename ElementType>
-   void CSCSparseStorage<IndexType, ElementType>::increment_iterator(IndexType& column_index, IndexType& nonzero_index) const {
-      if (this->column_starts[column_index] <= nonzero_index && nonzero_index + 1 < this->column_starts[column_index + 1]) {
+   void CSCSparseStorage<IndexType, ElementType>::increment_iterator(size_t& column_index, size_t& nonzero_index) const {
+      if (static_cast<size_t>(this->column_starts[column_index]) <= nonzero_index &&
+            nonzero_index + 1 < static_cast<size_t>(this->column_starts[column_index + 1])) {
          // stay in the column
          nonzero_index++;
       }
@@ -118,7 +173,7 @@ namespace uno {
          do {
             column_index++;
          } while (column_index < this->dimension && this->column_starts[column_index] == this->column_starts[column_index + 1]);
-         nonzero_index = this->column_starts[column_index];
+         nonzero_index = static_cast<size_t>(this->column_starts[column_index]);
       }
    }
 
@@ -0,0 +1,147 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_COMPRESSEDTRIANGULARMATRIX_H
+#define UNO_COMPRESSEDTRIANGULARMATRIX_H
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   /*! \class CompressedTriangularMatrix
+    * \brief Compressed representation of a symmetric matrix with sorted and deduplicated indices, for the solvers that require it
+    *
+    *  The arrays are the CSR representation of the upper triangle, or equivalently the CSC representation of the lower triangle.
+    *  Each nonzero (i, j) of the matrix (in any storage format, in any triangle) is mapped to the slot (min(i, j), max(i, j)) and
+    *  the duplicates are summed; the diagonal entries may be made explicit (possibly zero). The pattern is computed once per
+    *  sparsity pattern with two counting sorts (O(nnz + n)) and the slots of the nonzeros are cached: a value update is then a
+    *  single O(nnz) scatter of the elements of the matrix
+    */
+   template <typename IndexType = int, typename ElementType = double>
+   class CompressedTriangularMatrix {
+   public:
+      // index_base: 0 (C) or 1 (Fortran) indices. explicit_diagonal: every diagonal entry is stored
+      explicit CompressedTriangularMatrix(IndexType index_base = 0, bool explicit_diagonal = true):
+         index_base(index_base), explicit_diagonal(explicit_diagonal) { }
+
+      template <typename MatrixIndexType>
+      void analyze(const SymmetricMatrix<MatrixIndexType, ElementType>& matrix);
+      // the sparsity pattern of the matrix is that of the last analysis
+      template <typename MatrixIndexType>
+      void update_values(const SymmetricMatrix<MatrixIndexType, ElementType>& matrix);
+
+      [[nodiscard]] size_t dimension() const { return this->starts.empty() ? 0 : this->starts.size() - 1; }
+      [[nodiscard]] size_t number_nonzeros() const { return this->indices.size(); }
+      // CSR of the upper triangle
+      [[nodiscard]] IndexType* row_starts() { return this->starts.data(); }
+      [[nodiscard]] IndexType* column_indices() { return this->indices.data(); }
+      // CSC of the lower triangle (same arrays)
+      [[nodiscard]] IndexType* column_starts() { return this->starts.data(); }
+      [[nodiscard]] IndexType* row_indices() { return this->indices.data(); }
+      [[nodiscard]] ElementType* values() { return this->values_.data(); }
+      [[nodiscard]] const ElementType* values() const { return this->values_.data(); }
+      // memory of the arrays (in bytes)
+      [[nodiscard]] size_t memory_size() const {
+         return (this->starts.capacity() + this->indices.capacity()) * sizeof(IndexType) + this->values_.capacity() * sizeof(ElementType) +
+            this->slots.capacity() * sizeof(size_t);
+      }
+
+   protected:
+      const IndexType index_base;
+      const bool explicit_diagonal;
+      std::vector<IndexType> starts{};
+      std::vector<IndexType> indices{};
+      std::vector<ElementType> values_{};
+      std::vector<size_t> slots{}; // slots[k] is the slot of the k-th nonzero of the matrix (in storage order)
+
+      // workspace of the analysis: (outer index, inner index, nonzero index) of the entries
+      struct Entry {
+         size_t outer_index;
+         size_t inner_index;
+         size_t nonzero_index;
+      };
+      static constexpr size_t diagonal_entry = std::numeric_limits<size_t>::max();
+   };
+
+   // implementation
+
+   template <typename IndexType, typename ElementType>
+   template <typename MatrixIndexType>
+   void CompressedTriangularMatrix<IndexType, ElementType>::analyze(const SymmetricMatrix<MatrixIndexType, ElementType>& matrix) {
+      const size_t dimension = matrix.dimension();
+      const size_t number_nonzeros = matrix.number_nonzeros();
+      const size_t number_entries = number_nonzeros + (this->explicit_diagonal ? dimension : 0);
+
+      // gather the entries (the explicit diagonal entries first) in the upper triangle: outer = min(i, j), inner = max(i, j)
+      std::vector<Entry> entries{};
+      entries.reserve(number_entries);
+      if (this->explicit_diagonal) {
+         for (size_t index: Range(dimension)) {
+            entries.push_back({index, index, CompressedTriangularMatrix::diagonal_entry});
+         }
+      }
+      size_t nonzero_index = 0;
+      matrix.for_each([&](size_t row_index, size_t column_index, ElementType /*element*/) {
+         entries.push_back({std::min(row_index, column_index), std::max(row_index, column_index), nonzero_index});
+         nonzero_index++;
+      });
+
+      // two stable counting sorts: by inner index, then by outer index. The entries are then sorted lexicographically
+      std::vector<Entry> sorted_entries(number_entries);
+      std::vector<size_t> bucket_starts(dimension + 1);
+      const auto counting_sort = [&](const std::vector<Entry>& source, std::vector<Entry>& destination, size_t Entry::* key) {
+         std::fill(bucket_starts.begin(), bucket_starts.end(), 0);
+         for (const Entry& entry: source) {
+            bucket_starts[entry.*key + 1]++;
+         }
+         for (size_t index: Range(dimension)) {
+            bucket_starts[index + 1] += bucket_starts[index];
+         }
+         for (const Entry& entry: source) {
+            destination[bucket_starts[entry.*key]++] = entry;
+         }
+      };
+      counting_sort(entries, sorted_entries, &Entry::inner_index);
+      counting_sort(sorted_entries, entries, &Entry::outer_index);
+
+      // merge the duplicates
+      this->starts.assign(dimension + 1, this->index_base);
+      this->indices.clear();
+      this->indices.reserve(number_entries);
+      this->slots.resize(number_nonzeros);
+      size_t entry_index = 0;
+      for (size_t outer_index: Range(dimension)) {
+         size_t previous_inner_index = CompressedTriangularMatrix::diagonal_entry;
+         for (; entry_index < number_entries && entries[entry_index].outer_index == outer_index; entry_index++) {
+            const Entry& entry = entries[entry_index];
+            if (entry.inner_index != previous_inner_index) {
+               this->indices.emplace_back(static_cast<IndexType>(entry.inner_index) + this->index_base);
+               previous_inner_index = entry.inner_index;
+            }
+            if (entry.nonzero_index != CompressedTriangularMatrix::diagonal_entry) {
+               this->slots[entry.nonzero_index] = this->indices.size() - 1;
+            }
+         }
+         this->starts[outer_index + 1] = static_cast<IndexType>(this->indices.size()) + this->index_base;
+      }
+      this->values_.resize(this->indices.size());
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename MatrixIndexType>
+   void CompressedTriangularMatrix<IndexType, ElementType>::update_values(const SymmetricMatrix<MatrixIndexType, ElementType>& matrix) {
+      assert(matrix.number_nonzeros() == this->slots.size() && "CompressedTriangularMatrix: the sparsity pattern of the matrix has changed");
+      std::fill(this->values_.begin(), this->values_.end(), ElementType(0));
+      // the elements are stored in the order of the traversal
+      const ElementType* elements = matrix.data_pointer();
+      for (size_t nonzero_index: Range(this->slots.size())) {
+         this->values_[this->slots[nonzero_index]] += elements[nonzero_index];
+      }
+   }
+} // namespace
+
+#endif // UNO_COMPRESSEDTRIANGULARMATRIX_H
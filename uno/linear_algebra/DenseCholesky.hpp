@@ -0,0 +1,120 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DENSECHOLESKY_H
+#define UNO_DENSECHOLESKY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   /*! \class DenseCholesky
+    * \brief Dense Cholesky factorization A = L L^T of a symmetric positive definite matrix
+    *
+    *  The matrix is stored column-major and only its lower triangle is read. The factorization fails (and the factors are
+    *  invalid) if a pivot does not exceed the pivot tolerance relative to the largest diagonal entry of the matrix
+    */
+   template <typename ElementType>
+   class DenseCholesky {
+   public:
+      explicit DenseCholesky(size_t maximum_dimension);
+
+      [[nodiscard]] size_t dimension() const { return this->matrix_dimension; }
+      // the leading block of the storage is used
+      void resize(size_t dimension);
+
+      // entry (row, column), with row >= column
+      [[nodiscard]] ElementType& entry(size_t row, size_t column) { return this->factors[column * this->matrix_dimension + row]; }
+      [[nodiscard]] const ElementType& entry(size_t row, size_t column) const { return this->factors[column * this->matrix_dimension + row]; }
+      void reset();
+
+      // returns whether the matrix is (numerically) positive definite
+      [[nodiscard]] bool factorize(ElementType relative_pivot_tolerance);
+      // solves the system in place (x contains the right-hand side on entry)
+      void solve(ElementType* x) const;
+
+      [[nodiscard]] size_t memory_size() const { return this->factors.capacity() * sizeof(ElementType); }
+
+   protected:
+      size_t matrix_dimension{0};
+      std::vector<ElementType> factors;
+   };
+
+   // implementation
+
+   template <typename ElementType>
+   DenseCholesky<ElementType>::DenseCholesky(size_t maximum_dimension):
+         matrix_dimension(maximum_dimension),
+         factors(maximum_dimension * maximum_dimension, ElementType(0)) {
+   }
+
+   template <typename ElementType>
+   void DenseCholesky<ElementType>::resize(size_t dimension) {
+      this->matrix_dimension = dimension;
+      if (this->factors.size() < dimension * dimension) {
+         this->factors.resize(dimension * dimension);
+      }
+   }
+
+   template <typename ElementType>
+   void DenseCholesky<ElementType>::reset() {
+      std::fill(this->factors.begin(), this->factors.begin() + static_cast<std::ptrdiff_t>(this->matrix_dimension * this->matrix_dimension),
+         ElementType(0));
+   }
+
+   // right-looking column elimination
+   template <typename ElementType>
+   bool DenseCholesky<ElementType>::factorize(ElementType relative_pivot_tolerance) {
+      const size_t n = this->matrix_dimension;
+      ElementType largest_diagonal_entry(0);
+      for (size_t index: Range(n)) {
+         largest_diagonal_entry = std::max(largest_diagonal_entry, this->entry(index, index));
+      }
+      const ElementType pivot_tolerance = relative_pivot_tolerance * std::max(ElementType(1), largest_diagonal_entry);
+      for (size_t k: Range(n)) {
+         const ElementType pivot = this->entry(k, k);
+         if (pivot <= pivot_tolerance) {
+            return false;
+         }
+         const ElementType diagonal = std::sqrt(pivot);
+         this->entry(k, k) = diagonal;
+         for (size_t row = k + 1; row < n; row++) {
+            this->entry(row, k) /= diagonal;
+         }
+         // update of the trailing submatrix (lower triangle)
+         for (size_t column = k + 1; column < n; column++) {
+            const ElementType multiplier = this->entry(column, k);
+            if (multiplier != ElementType(0)) {
+               for (size_t row = column; row < n; row++) {
+                  this->entry(row, column) -= this->entry(row, k) * multiplier;
+               }
+            }
+         }
+      }
+      return true;
+   }
+
+   template <typename ElementType>
+   void DenseCholesky<ElementType>::solve(ElementType* x) const {
+      const size_t n = this->matrix_dimension;
+      // L y = b
+      for (size_t column: Range(n)) {
+         x[column] /= this->entry(column, column);
+         for (size_t row = column + 1; row < n; row++) {
+            x[row] -= this->entry(row, column) * x[column];
+         }
+      }
+      // L^T x = y
+      for (size_t row = n; row-- > 0;) {
+         for (size_t column = row + 1; column < n; column++) {
+            x[row] -= this->entry(column, row) * x[column];
+         }
+         x[row] /= this->entry(row, row);
+      }
+   }
+} // namespace
+
+#endif // UNO_DENSECHOLESKY_H
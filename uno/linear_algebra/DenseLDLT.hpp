@@ -0,0 +1,350 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DENSELDLT_H
+#define UNO_DENSELDLT_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   // storage of the dense factorizations: a heap-allocated array, or an inline array of fixed capacity
+   template <typename ElementType, size_t Capacity>
+   using DenseStorage = std::conditional_t<Capacity == 0, std::vector<ElementType>, std::array<ElementType, Capacity>>;
+
+   /*! \class DenseLDLT
+    * \brief Dense LDL^T factorization of a symmetric indefinite matrix with Bunch-Kaufman pivoting
+    *
+    *  P A P^T = L D L^T, where P is a symmetric permutation, L is unit lower triangular and D is block diagonal with 1x1 and 2x2
+    *  blocks. The matrix is stored column-major and only its lower triangle is read. A 1x1 pivot whose column does not exceed the
+    *  pivot tolerance is counted as a zero eigenvalue; the corresponding components of the solution are set to 0.
+    *  If MaximumDimension is positive, the factors and the workspaces are stored inline in arrays of fixed capacity and the leading
+    *  dimension is the compile-time constant MaximumDimension: tiny systems (e.g. MPC) are factorized without heap allocations
+    */
+   template <typename ElementType, size_t MaximumDimension = 0>
+   class DenseLDLT {
+   public:
+      explicit DenseLDLT(size_t dimension);
+
+      [[nodiscard]] size_t dimension() const { return this->matrix_dimension; }
+      // fixed capacity: changes the dimension of the matrix without reallocation
+      void set_dimension(size_t dimension);
+
+      // entry (row, column), with row >= column
+      [[nodiscard]] ElementType& entry(size_t row, size_t column);
+      [[nodiscard]] const ElementType& entry(size_t row, size_t column) const;
+      void reset();
+
+      void factorize(ElementType pivot_tolerance = ElementType(0));
+      // solves the system in place (x contains the right-hand side on entry)
+      void solve(ElementType* x) const;
+
+      [[nodiscard]] bool is_singular() const { return 0 < this->number_zero_pivots; }
+      // (number of positive, negative and zero eigenvalues)
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const;
+      [[nodiscard]] size_t number_two_by_two_pivots() const {
+         return static_cast<size_t>(std::count(this->pivot_sizes.begin(), this->pivot_sizes.end(), 2));
+      }
+      [[nodiscard]] size_t memory_size() const;
+
+   protected:
+      size_t matrix_dimension;
+      const size_t leading_dimension;
+      DenseStorage<ElementType, MaximumDimension * MaximumDimension> factors{};
+      DenseStorage<size_t, MaximumDimension> permutation{}; /*!< permutation[k] is the original index of the k-th pivot */
+      DenseStorage<size_t, MaximumDimension> pivot_sizes{}; /*!< 1 or 2 at the first position of a pivot, 0 at the second position of a 2x2 pivot */
+      mutable DenseStorage<ElementType, MaximumDimension> workspace{};
+      size_t number_zero_pivots{0};
+      bool is_factorized{false};
+
+      [[nodiscard]] ElementType& at(size_t row, size_t column) { return this->factors[column * this->leading_dimension + row]; }
+      [[nodiscard]] const ElementType& at(size_t row, size_t column) const { return this->factors[column * this->leading_dimension + row]; }
+      // entry (i, j) of the symmetric matrix stored in the lower triangle
+      [[nodiscard]] ElementType& symmetric_at(size_t i, size_t j) { return (j <= i) ? this->at(i, j) : this->at(j, i); }
+      void interchange(size_t k, size_t first, size_t second);
+   };
+
+   // implementation
+
+   template <typename ElementType, size_t MaximumDimension>
+   DenseLDLT<ElementType, MaximumDimension>::DenseLDLT(size_t dimension):
+         matrix_dimension(dimension),
+         leading_dimension((MaximumDimension == 0) ? dimension : MaximumDimension) {
+      if constexpr (MaximumDimension == 0) {
+         this->factors.resize(dimension * dimension, ElementType(0));
+         this->permutation.resize(dimension);
+         this->pivot_sizes.resize(dimension);
+         this->workspace.resize(dimension);
+      }
+      else {
+         if (MaximumDimension < dimension) {
+            throw std::invalid_argument("DenseLDLT: the dimension " + std::to_string(dimension) + " exceeds the fixed capacity " +
+               std::to_string(MaximumDimension));
+         }
+         this->factors.fill(ElementType(0));
+      }
+   }
+
+   template <typename ElementType, size_t MaximumDimension>
+   void DenseLDLT<ElementType, MaximumDimension>::set_dimension(size_t dimension) {
+      static_assert(0 < MaximumDimension, "DenseLDLT: only the fixed-capacity factorization can change its dimension");
+      if (MaximumDimension < dimension) {
+         throw std::invalid_argument("DenseLDLT: the dimension " + std::to_string(dimension) + " exceeds the fixed capacity " +
+            std::to_string(MaximumDimension));
+      }
+      this->matrix_dimension = dimension;
+      this->is_factorized = false;
+   }
+
+   template <typename ElementType, size_t MaximumDimension>
+   ElementType& DenseLDLT<ElementType, MaximumDimension>::entry(size_t row, size_t column) {
+      this->is_factorized = false;
+      return this->at(row, column);
+   }
+
+   template <typename ElementType, size_t MaximumDimension>
+   const ElementType& DenseLDLT<ElementType, MaximumDimension>::entry(size_t row, size_t column) const {
+      return this->at(row, column);
+   }
+
+   template <typename ElementType, size_t MaximumDimension>
+   void DenseLDLT<ElementType, MaximumDimension>::reset() {
+      std::fill(this->factors.begin(), this->factors.end(), ElementType(0));
+      this->is_factorized = false;
+   }
+
+   // symmetric interchange of the indices first < second in the trailing submatrix A(k:n, k:n) and in the computed columns of L
+   template <typename ElementType, size_t MaximumDimension>
+   void DenseLDLT<ElementType, MaximumDimension>::interchange(size_t k, size_t first, size_t second) {
+      const size_t n = this->matrix_dimension;
+      std::swap(this->permutation[first], this->permutation[second]);
+      // rows of the computed columns of L
+      for (size_t column: Range(k)) {
+         std::swap(this->at(first, column), this->at(second, column));
+      }
+      // trailing submatrix (lower triangle)
+      for (size_t column = k; column < first; column++) {
+         std::swap(this->at(first, column), this->at(second, column));
+      }
+      for (size_t index = first + 1; index < second; index++) {
+         std::swap(this->at(index, first), this->at(second, index));
+      }
+      for (size_t row = second + 1; row < n; row++) {
+         std::swap(this->at(row, first), this->at(row, second));
+      }
+      std::swap(this->at(first, first), this->at(second, second));
+   }
+
+   template <typename ElementType, size_t MaximumDimension>
+   void DenseLDLT<ElementType, MaximumDimension>::factorize(ElementType pivot_tolerance) {
+      const size_t n = this->matrix_dimension;
+      // growth bound of Bunch and Kaufman
+      const ElementType alpha = (ElementType(1) + std::sqrt(ElementType(17))) / ElementType(8);
+      for (size_t index: Range(n)) {
+         this->permutation[index] = index;
+         this->pivot_sizes[index] = 0;
+      }
+      this->number_zero_pivots = 0;
+
+      size_t k = 0;
+      while (k < n) {
+         // largest off-diagonal entry of column k
+         const ElementType absakk = std::abs(this->at(k, k));
+         size_t imax = k;
+         ElementType colmax = ElementType(0);
+         for (size_t row = k + 1; row < n; row++) {
+            if (colmax < std::abs(this->at(row, k))) {
+               colmax = std::abs(this->at(row, k));
+               imax = row;
+            }
+         }
+
+         // zero column: the pivot is a zero eigenvalue and nothing is eliminated
+         if (std::max(absakk, colmax) <= pivot_tolerance) {
+            this->at(k, k) = ElementType(0);
+            for (size_t row = k + 1; row < n; row++) {
+               this->at(row, k) = ElementType(0);
+            }
+            this->pivot_sizes[k] = 1;
+            this->number_zero_pivots++;
+            k++;
+            continue;
+         }
+
+         size_t pivot_size = 1;
+         size_t pivot_index = k;
+         if (absakk < alpha * colmax) {
+            // largest off-diagonal entry of row/column imax in the trailing submatrix
+            ElementType rowmax = ElementType(0);
+            for (size_t index = k; index < n; index++) {
+               if (index != imax) {
+                  rowmax = std::max(rowmax, std::abs(this->symmetric_at(imax, index)));
+               }
+            }
+            if (alpha * colmax * (colmax / rowmax) <= absakk) {
+               pivot_index = k;
+            }
+            else if (alpha * rowmax <= std::abs(this->at(imax, imax))) {
+               pivot_index = imax;
+            }
+            else {
+               pivot_index = imax;
+               pivot_size = 2;
+            }
+         }
+         const size_t kk = k + pivot_size - 1;
+         if (pivot_index != kk) {
+            this->interchange(k, kk, pivot_index);
+         }
+         this->pivot_sizes[k] = pivot_size;
+
+         if (pivot_size == 1) {
+            const ElementType pivot = this->at(k, k);
+            // column of L and rank-one update of the trailing lower triangle
+            for (size_t row = k + 1; row < n; row++) {
+               this->workspace[row] = this->at(row, k);
+               this->at(row, k) /= pivot;
+            }
+            for (size_t column = k + 1; column < n; column++) {
+               const ElementType scaled_entry = this->workspace[column];
+               if (scaled_entry != ElementType(0)) {
+                  for (size_t row = column; row < n; row++) {
+                     this->at(row, column) -= this->at(row, k) * scaled_entry;
+                  }
+               }
+            }
+         }
+         else {
+            // inverse of the 2x2 pivot [[d11, d21], [d21, d22]]
+            const ElementType d11 = this->at(k, k);
+            const ElementType d21 = this->at(k + 1, k);
+            const ElementType d22 = this->at(k + 1, k + 1);
+            const ElementType determinant = d11 * d22 - d21 * d21;
+            // columns of L: [l1 l2] = [a1 a2] D^{-1}, and rank-two update with the original columns [a1 a2]
+            for (size_t row = k + 2; row < n; row++) {
+               const ElementType a1 = this->at(row, k);
+               const ElementType a2 = this->at(row, k + 1);
+               this->at(row, k) = (d22 * a1 - d21 * a2) / determinant;
+               this->at(row, k + 1) = (d11 * a2 - d21 * a1) / determinant;
+            }
+            for (size_t column = k + 2; column < n; column++) {
+               // original entries (row column of the 2x2 pivot) at index column: a = l D
+               const ElementType l1 = this->at(column, k);
+               const ElementType l2 = this->at(column, k + 1);
+               const ElementType a1 = d11 * l1 + d21 * l2;
+               const ElementType a2 = d21 * l1 + d22 * l2;
+               for (size_t row = column; row < n; row++) {
+                  this->at(row, column) -= this->at(row, k) * a1 + this->at(row, k + 1) * a2;
+               }
+            }
+         }
+         k += pivot_size;
+      }
+      this->is_factorized = true;
+   }
+
+   template <typename ElementType, size_t MaximumDimension>
+   void DenseLDLT<ElementType, MaximumDimension>::solve(ElementType* x) const {
+      if (!this->is_factorized) {
+         throw std::runtime_error("DenseLDLT: the matrix is not factorized");
+      }
+      const size_t n = this->matrix_dimension;
+      ElementType* const y = this->workspace.data();
+      // permutation y = P x
+      for (size_t k: Range(n)) {
+         y[k] = x[this->permutation[k]];
+      }
+      // forward substitution L z = y (the off-diagonal entry of a 2x2 pivot belongs to D)
+      for (size_t k = 0; k < n; k += this->pivot_sizes[k]) {
+         for (size_t column = k; column < k + this->pivot_sizes[k]; column++) {
+            for (size_t row = k + this->pivot_sizes[k]; row < n; row++) {
+               y[row] -= this->at(row, column) * y[column];
+            }
+         }
+      }
+      // block diagonal D w = z
+      for (size_t k = 0; k < n; k += this->pivot_sizes[k]) {
+         if (this->pivot_sizes[k] == 1) {
+            const ElementType pivot = this->at(k, k);
+            y[k] = (pivot != ElementType(0)) ? y[k] / pivot : ElementType(0);
+         }
+         else {
+            const ElementType d11 = this->at(k, k);
+            const ElementType d21 = this->at(k + 1, k);
+            const ElementType d22 = this->at(k + 1, k + 1);
+            const ElementType determinant = d11 * d22 - d21 * d21;
+            const ElementType y1 = y[k];
+            const ElementType y2 = y[k + 1];
+            y[k] = (d22 * y1 - d21 * y2) / determinant;
+            y[k + 1] = (d11 * y2 - d21 * y1) / determinant;
+         }
+      }
+      // backward substitution L^T v = w
+      for (size_t k = n; k-- > 0;) {
+         if (this->pivot_sizes[k] == 0) {
+            continue; // second position of a 2x2 pivot, handled with the first position
+         }
+         for (size_t column = k; column < k + this->pivot_sizes[k]; column++) {
+            for (size_t row = k + this->pivot_sizes[k]; row < n; row++) {
+               y[column] -= this->at(row, column) * y[row];
+            }
+         }
+      }
+      // permutation x = P^T v
+      for (size_t k: Range(n)) {
+         x[this->permutation[k]] = y[k];
+      }
+   }
+
+   template <typename ElementType, size_t MaximumDimension>
+   std::tuple<size_t, size_t, size_t> DenseLDLT<ElementType, MaximumDimension>::get_inertia() const {
+      if (!this->is_factorized) {
+         throw std::runtime_error("DenseLDLT: the matrix is not factorized");
+      }
+      // Sylvester's law of inertia: the inertia of A is that of D
+      size_t number_positive = 0, number_negative = 0;
+      for (size_t k = 0; k < this->matrix_dimension; k += this->pivot_sizes[k]) {
+         if (this->pivot_sizes[k] == 1) {
+            const ElementType pivot = this->at(k, k);
+            if (ElementType(0) < pivot) {
+               number_positive++;
+            }
+            else if (pivot < ElementType(0)) {
+               number_negative++;
+            }
+         }
+         else {
+            const ElementType d11 = this->at(k, k);
+            const ElementType determinant = d11 * this->at(k + 1, k + 1) - this->at(k + 1, k) * this->at(k + 1, k);
+            if (determinant < ElementType(0)) {
+               number_positive++;
+               number_negative++;
+            }
+            else if (ElementType(0) < d11) {
+               number_positive += 2;
+            }
+            else {
+               number_negative += 2;
+            }
+         }
+      }
+      return {number_positive, number_negative, this->number_zero_pivots};
+   }
+
+   template <typename ElementType, size_t MaximumDimension>
+   size_t DenseLDLT<ElementType, MaximumDimension>::memory_size() const {
+      return (this->factors.size() + this->workspace.size()) * sizeof(ElementType) +
+            (this->permutation.size() + this->pivot_sizes.size()) * sizeof(size_t);
+   }
+} // namespace
+
+#endif // UNO_DENSELDLT_H
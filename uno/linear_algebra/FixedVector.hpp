@@ -0,0 +1,96 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FIXEDVECTOR_H
+#define UNO_FIXEDVECTOR_H
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include "symbolic/StridedSpan.hpp"
+
+namespace uno {
+   // dense vector whose dimension is known at compile time. The elements are stored inline (no heap allocation) and aligned on a
+   // cache line; the loops over the elements have a constant trip count, so that the compiler unrolls and vectorizes them
+   template <typename ElementType, size_t Dimension>
+   class FixedVector {
+   public:
+      using value_type = ElementType;
+      using iterator = typename std::array<ElementType, Dimension>::iterator;
+      using const_iterator = typename std::array<ElementType, Dimension>::const_iterator;
+
+      FixedVector() { this->fill(ElementType(0)); }
+      explicit FixedVector(ElementType value) { this->fill(value); }
+      FixedVector(std::initializer_list<ElementType> initializer_list) {
+         this->fill(ElementType(0));
+         size_t index = 0;
+         for (const ElementType& element: initializer_list) {
+            this->vector[index++] = element;
+         }
+      }
+
+      // assignment operator from some expression (see StridedSpan.hpp)
+      template <typename Expression, typename = std::enable_if_t<!std::is_same_v<Expression, FixedVector>>>
+      FixedVector& operator=(const Expression& expression) {
+         static_assert(std::is_same_v<typename Expression::value_type, ElementType>);
+         const auto& block = strided_block(expression);
+         for (size_t index = 0; index < Dimension; index++) {
+            this->vector[index] = block[index];
+         }
+         return *this;
+      }
+
+      template <typename Expression>
+      FixedVector& operator+=(const Expression& expression) {
+         const auto& block = strided_block(expression);
+         for (size_t index = 0; index < Dimension; index++) {
+            this->vector[index] += block[index];
+         }
+         return *this;
+      }
+
+      ElementType& operator[](size_t index) { return this->vector[index]; }
+      const ElementType& operator[](size_t index) const { return this->vector[index]; }
+
+      [[nodiscard]] static constexpr size_t size() { return Dimension; }
+      [[nodiscard]] static constexpr bool empty() { return (Dimension == 0); }
+
+      iterator begin() noexcept { return this->vector.begin(); }
+      iterator end() noexcept { return this->vector.end(); }
+      const_iterator begin() const noexcept { return this->vector.cbegin(); }
+      const_iterator end() const noexcept { return this->vector.cend(); }
+
+      void fill(ElementType value) {
+         for (size_t index = 0; index < Dimension; index++) {
+            this->vector[index] = value;
+         }
+      }
+
+      void scale(ElementType factor) {
+         for (size_t index = 0; index < Dimension; index++) {
+            this->vector[index] *= factor;
+         }
+      }
+
+      ElementType* data() { return this->vector.data(); }
+      const ElementType* data() const { return this->vector.data(); }
+
+      // span over the elements (see StridedSpan.hpp)
+      [[nodiscard]] StridedSpan<const ElementType> block() const { return {this->vector.data(), Dimension}; }
+
+   protected:
+      alignas(64) std::array<ElementType, Dimension> vector;
+   };
+
+   template <typename ElementType, size_t Dimension>
+   ElementType dot(const FixedVector<ElementType, Dimension>& x, const FixedVector<ElementType, Dimension>& y) {
+      ElementType dot_product = ElementType(0);
+      for (size_t index = 0; index < Dimension; index++) {
+         dot_product += x[index] * y[index];
+      }
+      return dot_product;
+   }
+} // namespace
+
+#endif // UNO_FIXEDVECTOR_H
@@ -7,11 +7,28 @@
 #include <algorithm>
 #include <cmath>
 #include <string>
+#include <type_traits>
+#include <vector>
+#include "SIMDKernels.hpp"
 #include "symbolic/Range.hpp"
 
 namespace uno {
+   // forward declaration
+   template <typename ElementType>
+   class Vector;
+
    // norms of any array with elements of any type
 
+   // contiguous arrays of doubles are reduced with the vectorized kernels, the other arrays (e.g. expressions) element by element
+   template <typename Array>
+   struct is_contiguous_double_array: std::false_type { };
+   template <>
+   struct is_contiguous_double_array<Vector<double>>: std::true_type { };
+   template <typename Allocator>
+   struct is_contiguous_double_array<std::vector<double, Allocator>>: std::true_type { };
+   template <typename Array>
+   constexpr bool is_contiguous_double_array_v = is_contiguous_double_array<Array>::value;
+
    enum class Norm {L1, L2, L2_SQUARED, INF};
 
    inline Norm norm_from_string(const std::string& norm_string) {
@@ -62,7 +79,12 @@ namespace uno {
 
    template <typename Array, typename ElementType = typename Array::value_type>
    ElementType norm_1(const Array& x) {
-      return generic_norm(x, norm_1_accumulation<ElementType>);
+      if constexpr (is_contiguous_double_array_v<Array>) {
+         return simd_norm_1(x.data(), x.size());
+      }
+      else {
+         return generic_norm(x, norm_1_accumulation<ElementType>);
+      }
    }
 
    // l1 norm of several arrays
@@ -81,7 +103,12 @@ namespace uno {
 
    template <typename Array, typename ElementType = typename Array::value_type>
    ElementType norm_2_squared(const Array& x) {
-      return generic_norm(x, norm_2_squared_accumulation<ElementType>);
+      if constexpr (is_contiguous_double_array_v<Array>) {
+         return simd_norm_2_squared(x.data(), x.size());
+      }
+      else {
+         return generic_norm(x, norm_2_squared_accumulation<ElementType>);
+      }
    }
 
    // l2 squared norm of several arrays
@@ -114,7 +141,12 @@ namespace uno {
 
    template <typename Array, typename ElementType = typename Array::value_type>
    ElementType norm_inf(const Array& x) {
-      return generic_norm(x, norm_inf_accumulation<ElementType>);
+      if constexpr (is_contiguous_double_array_v<Array>) {
+         return simd_norm_inf(x.data(), x.size());
+      }
+      else {
+         return generic_norm(x, norm_inf_accumulation<ElementType>);
+      }
    }
 
    // inf norm of several arrays
@@ -143,6 +175,69 @@ namespace uno {
       }
       throw std::invalid_argument("The norm is not known");
    }
+
+   // norm of the bound violations max(0, lb - c, c - ub) of contiguous arrays, computed without forming the violations
+   inline double bound_violation_norm(Norm norm, const double* values, const double* lower_bounds, const double* upper_bounds, size_t size) {
+      if (norm == Norm::L1) {
+         return simd_bound_violation_sum(values, lower_bounds, upper_bounds, size, false);
+      }
+      else if (norm == Norm::L2) {
+         return std::sqrt(simd_bound_violation_sum(values, lower_bounds, upper_bounds, size, true));
+      }
+      else if (norm == Norm::L2_SQUARED) {
+         return simd_bound_violation_sum(values, lower_bounds, upper_bounds, size, true);
+      }
+      else if (norm == Norm::INF) {
+         return simd_bound_violation_max(values, lower_bounds, upper_bounds, size);
+      }
+      throw std::invalid_argument("The norm is not known");
+   }
+
+   // norm of the elements element(0), ..., element(size-1) computed on the fly. A fused kernel can form (and store) each element
+   // and accumulate the norm in the same sweep. The dispatch happens once, outside the loop
+   template <typename ElementFunction>
+   double fused_norm(Norm norm, size_t size, const ElementFunction& element) {
+      double result = 0.;
+      if (norm == Norm::L1) {
+         for (size_t index: Range(size)) {
+            norm_1_accumulation(result, element(index));
+         }
+         return result;
+      }
+      else if (norm == Norm::L2 || norm == Norm::L2_SQUARED) {
+         for (size_t index: Range(size)) {
+            norm_2_squared_accumulation(result, element(index));
+         }
+         return (norm == Norm::L2) ? std::sqrt(result) : result;
+      }
+      else if (norm == Norm::INF) {
+         for (size_t index: Range(size)) {
+            norm_inf_accumulation(result, element(index));
+         }
+         return result;
+      }
+      throw std::invalid_argument("The norm is not known");
+   }
+
+   // norm of the elements passed by a sweep to its accumulation function (e.g. sweeps over sparse index collections). The sweep is
+   // called once with the accumulation function of the norm: the dispatch happens once, outside the loops
+   template <typename Sweep>
+   double fused_norm(Norm norm, const Sweep& sweep) {
+      double result = 0.;
+      if (norm == Norm::L1) {
+         sweep([&](double element) { norm_1_accumulation(result, element); });
+         return result;
+      }
+      else if (norm == Norm::L2 || norm == Norm::L2_SQUARED) {
+         sweep([&](double element) { norm_2_squared_accumulation(result, element); });
+         return (norm == Norm::L2) ? std::sqrt(result) : result;
+      }
+      else if (norm == Norm::INF) {
+         sweep([&](double element) { norm_inf_accumulation(result, element); });
+         return result;
+      }
+      throw std::invalid_argument("The norm is not known");
+   }
 } // namespace
 
 #endif // UNO_NORM_H
@@ -4,42 +4,315 @@
 #ifndef UNO_RECTANGULARMATRIX_H
 #define UNO_RECTANGULARMATRIX_H
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <ostream>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include "SparseVector.hpp"
+#include "AlignedAllocator.hpp"
+#include "symbolic/Range.hpp"
 
 namespace uno {
-   // TODO use more appropriate sparse representation
-   //template <typename ElementType>
-   //using RectangularMatrix = std::vector<SparseVector<ElementType>>;
+   // view of a row of a RectangularMatrix. The row behaves like a SparseVector: its column indices are neither unique nor sorted
+   // Matrix is either RectangularMatrix<ElementType> or const RectangularMatrix<ElementType>
+   template <typename Matrix>
+   class SparseRow {
+   public:
+      using value_type = typename std::remove_const_t<Matrix>::value_type;
+
+      class iterator {
+      public:
+         using value_type = std::pair<size_t, typename SparseRow::value_type>;
+
+         iterator(const size_t* column_index, const typename SparseRow::value_type* element): column_index(column_index), element(element) { }
+
+         value_type operator*() const {
+            return {*this->column_index, *this->element};
+         }
+
+         iterator& operator++() {
+            this->column_index++;
+            this->element++;
+            return *this;
+         }
+
+         friend bool operator!=(const iterator& a, const iterator& b) {
+            return a.column_index != b.column_index;
+         }
 
+      protected:
+         const size_t* column_index;
+         const typename SparseRow::value_type* element;
+      };
+
+      SparseRow(Matrix& matrix, size_t row_index): matrix(matrix), row_index(row_index) { }
+
+      [[nodiscard]] size_t size() const { return this->matrix.row_sizes[this->row_index]; }
+      [[nodiscard]] bool is_empty() const { return (this->size() == 0); }
+
+      // only available for mutable rows
+      void insert(size_t column_index, value_type element) { this->matrix.insert(this->row_index, column_index, element); }
+      void clear() { this->matrix.clear_row(this->row_index); }
+      template <typename Function>
+      void transform(const Function& f);
+
+      [[nodiscard]] iterator begin() const {
+         const size_t start = this->matrix.row_starts[this->row_index];
+         return iterator(this->matrix.column_indices.data() + start, this->matrix.entries.data() + start);
+      }
+      [[nodiscard]] iterator end() const {
+         const size_t end = this->matrix.row_starts[this->row_index] + this->size();
+         return iterator(this->matrix.column_indices.data() + end, this->matrix.entries.data() + end);
+      }
+
+   protected:
+      Matrix& matrix;
+      const size_t row_index;
+   };
+
+   /*
+    * Compressed Sparse Row
+    * https://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_(CSR,_CRS_or_Yale_format)
+    * All rows share a single array of column indices and a single array of entries. Since the rows can be filled in any order and
+    * the sparsity pattern is only known after the first evaluation, each row owns a slice of the arrays that may grow (the row is
+    * then relocated at the end of the arrays). clear() compacts the slices in row order, so that subsequent evaluations with the
+    * same sparsity pattern fill a gap-free CSR matrix
+    */
    template <typename ElementType>
    class RectangularMatrix {
    public:
       using value_type = ElementType;
 
-      RectangularMatrix(size_t number_rows, size_t number_columns): matrix(number_rows) {
-         for (auto& row: this->matrix) {
-            row.reserve(number_columns);
+      RectangularMatrix(size_t number_rows, size_t number_columns);
+
+      [[nodiscard]] size_t number_rows() const { return this->row_sizes.size(); }
+      [[nodiscard]] size_t number_columns() const { return this->columns; }
+      [[nodiscard]] size_t number_nonzeros() const;
+      // allocated memory (in bytes), including the spare capacity of the rows
+      [[nodiscard]] size_t memory_size() const;
+
+      SparseRow<RectangularMatrix<ElementType>> operator[](size_t row_index) {
+         return {*this, row_index};
+      }
+
+      SparseRow<const RectangularMatrix<ElementType>> operator[](size_t row_index) const {
+         return {*this, row_index};
+      }
+
+      void insert(size_t row_index, size_t column_index, ElementType element);
+      void clear_row(size_t row_index);
+      void clear();
+
+      // raw arrays: the nonzeros of row i are stored in positions [row_start(i), row_start(i) + row_size(i))
+      [[nodiscard]] size_t row_start(size_t row_index) const { return this->row_starts[row_index]; }
+      [[nodiscard]] size_t row_size(size_t row_index) const { return this->row_sizes[row_index]; }
+      [[nodiscard]] const size_t* column_indices_pointer() const noexcept { return this->column_indices.data(); }
+      [[nodiscard]] const ElementType* data_pointer() const noexcept { return this->entries.data(); }
+      [[nodiscard]] ElementType* data_pointer() noexcept { return this->entries.data(); }
+
+   protected:
+      size_t columns;
+      std::vector<size_t> row_starts;
+      std::vector<size_t> row_sizes;
+      std::vector<size_t> row_capacities;
+      std::vector<size_t> column_indices{};
+      std::vector<ElementType, AlignedAllocator<ElementType>> entries{};
+      // true if relocated rows left gaps in the arrays
+      bool fragmented{false};
+
+      void grow_row(size_t row_index);
+
+      friend class SparseRow<RectangularMatrix<ElementType>>;
+      friend class SparseRow<const RectangularMatrix<ElementType>>;
+   };
+
+   // implementation
+
+   template <typename Matrix>
+   template <typename Function>
+   void SparseRow<Matrix>::transform(const Function& f) {
+      const size_t start = this->matrix.row_starts[this->row_index];
+      for (size_t index: Range(start, start + this->size())) {
+         this->matrix.entries[index] = f(this->matrix.entries[index]);
+      }
+   }
+
+   template <typename ElementType>
+   RectangularMatrix<ElementType>::RectangularMatrix(size_t number_rows, size_t number_columns):
+         columns(number_columns), row_starts(number_rows, 0), row_sizes(number_rows, 0), row_capacities(number_rows, 0) {
+   }
+
+   template <typename ElementType>
+   size_t RectangularMatrix<ElementType>::number_nonzeros() const {
+      size_t number_nonzeros = 0;
+      for (size_t row_size: this->row_sizes) {
+         number_nonzeros += row_size;
+      }
+      return number_nonzeros;
+   }
+
+   template <typename ElementType>
+   size_t RectangularMatrix<ElementType>::memory_size() const {
+      return (this->row_starts.capacity() + this->row_sizes.capacity() + this->row_capacities.capacity() +
+            this->column_indices.capacity()) * sizeof(size_t) + this->entries.capacity() * sizeof(ElementType);
+   }
+
+   template <typename ElementType>
+   inline void RectangularMatrix<ElementType>::insert(size_t row_index, size_t column_index, ElementType element) {
+      assert(row_index < this->number_rows() && "RectangularMatrix::insert: the row index is out of bounds");
+      if (this->row_sizes[row_index] == this->row_capacities[row_index]) {
+         this->grow_row(row_index);
+      }
+      const size_t position = this->row_starts[row_index] + this->row_sizes[row_index];
+      this->column_indices[position] = column_index;
+      this->entries[position] = element;
+      this->row_sizes[row_index]++;
+   }
+
+   template <typename ElementType>
+   void RectangularMatrix<ElementType>::clear_row(size_t row_index) {
+      this->row_sizes[row_index] = 0;
+   }
+
+   template <typename ElementType>
+   void RectangularMatrix<ElementType>::clear() {
+      if (this->fragmented) {
+         // compact the layout: the capacity of each row is its current size
+         size_t current_start = 0;
+         for (size_t row_index: Range(this->number_rows())) {
+            this->row_starts[row_index] = current_start;
+            this->row_capacities[row_index] = this->row_sizes[row_index];
+            current_start += this->row_sizes[row_index];
          }
+         this->column_indices.resize(current_start);
+         this->entries.resize(current_start);
+         this->fragmented = false;
+      }
+      std::fill(this->row_sizes.begin(), this->row_sizes.end(), size_t(0));
+   }
+
+   template <typename ElementType>
+   void RectangularMatrix<ElementType>::grow_row(size_t row_index) {
+      const size_t size = this->row_sizes[row_index];
+      const size_t old_start = this->row_starts[row_index];
+      const size_t new_capacity = std::max(size_t(4), 2 * this->row_capacities[row_index]);
+      // if the row is located at the end of the arrays, it can be extended in place
+      if (old_start + this->row_capacities[row_index] == this->entries.size()) {
+         this->column_indices.resize(old_start + new_capacity);
+         this->entries.resize(old_start + new_capacity);
+      }
+      // otherwise, relocate the row at the end of the arrays
+      else {
+         const size_t new_start = this->entries.size();
+         this->column_indices.resize(new_start + new_capacity);
+         this->entries.resize(new_start + new_capacity);
+         std::copy(this->column_indices.begin() + static_cast<std::ptrdiff_t>(old_start),
+               this->column_indices.begin() + static_cast<std::ptrdiff_t>(old_start + size),
+               this->column_indices.begin() + static_cast<std::ptrdiff_t>(new_start));
+         std::copy(this->entries.begin() + static_cast<std::ptrdiff_t>(old_start), this->entries.begin() + static_cast<std::ptrdiff_t>(old_start + size),
+               this->entries.begin() + static_cast<std::ptrdiff_t>(new_start));
+         this->row_starts[row_index] = new_start;
+      }
+      this->row_capacities[row_index] = new_capacity;
+      // the spare capacity is trimmed at the next clear()
+      this->fragmented = true;
+   }
+
+   // free functions
+
+   template <typename Matrix>
+   std::ostream& operator<<(std::ostream& stream, const SparseRow<Matrix>& row) {
+      stream << "sparse vector with " << row.size() << " nonzeros\n";
+      for (const auto [index, element]: row) {
+         stream << "index " << index << ", value " << element << '\n';
+      }
+      return stream;
+   }
+
+   template <typename Matrix, typename ElementType = typename SparseRow<Matrix>::value_type>
+   ElementType norm_inf(const SparseRow<Matrix>& row) {
+      ElementType norm = ElementType(0);
+      for (const auto [_, element]: row) {
+         norm = std::max(norm, std::abs(element));
       }
+      return norm;
+   }
 
-      SparseVector<ElementType>& operator[](size_t row_index) {
-         return this->matrix[row_index];
+   template <typename Vector, typename Matrix, typename ElementType = typename SparseRow<Matrix>::value_type>
+   ElementType dot(const Vector& x, const SparseRow<Matrix>& row) {
+      static_assert(std::is_same_v<typename Vector::value_type, ElementType>);
+
+      ElementType dot_product = ElementType(0);
+      for (const auto [index, row_element]: row) {
+         assert(index < x.size() && "Vector.dot: the sparse row is larger than the dense vector x");
+         dot_product += x[index] * row_element;
       }
+      return dot_product;
+   }
+
+   // precondition: factor != 0
+   template <typename ElementType>
+   void scale(SparseRow<RectangularMatrix<ElementType>> row, ElementType factor) {
+      row.transform([=](ElementType element) {
+         return factor * element;
+      });
+   }
+
+   // rows above this threshold are distributed among the OpenMP threads (if available)
+   constexpr size_t parallel_product_rows_threshold = 10000;
 
-      const SparseVector<ElementType>& operator[](size_t row_index) const {
-         return this->matrix[row_index];
+   // result = J x, where result is a preallocated dense vector of size (at least) the number of rows of J
+   template <typename ElementType, typename Array, typename ResultArray>
+   void jacobian_product(const RectangularMatrix<ElementType>& matrix, const Array& x, ResultArray& result) {
+      const size_t number_rows = matrix.number_rows();
+      assert(number_rows <= result.size() && "jacobian_product: the result vector is too small");
+      const size_t* column_indices = matrix.column_indices_pointer();
+      const ElementType* entries = matrix.data_pointer();
+      // the rows are independent: embarrassingly parallel
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) if(parallel_product_rows_threshold <= number_rows)
+#endif
+      for (size_t row_index = 0; row_index < number_rows; row_index++) {
+         const size_t row_start = matrix.row_start(row_index);
+         const size_t row_end = row_start + matrix.row_size(row_index);
+         ElementType row_product = ElementType(0);
+         for (size_t nonzero_index = row_start; nonzero_index < row_end; nonzero_index++) {
+            row_product += entries[nonzero_index] * x[column_indices[nonzero_index]];
+         }
+         result[row_index] = row_product;
       }
+   }
 
-      void clear() {
-         for (auto& row: this->matrix) {
-            row.clear();
+   // result += scaling_factor * J^T y, where result is a preallocated dense vector
+   // the rows with a zero coefficient in y are skipped. The product scatters into the columns, therefore it is sequential
+   template <typename ElementType, typename Array, typename ResultArray>
+   void add_jacobian_transposed_product(const RectangularMatrix<ElementType>& matrix, const Array& y, ElementType scaling_factor,
+         ResultArray& result) {
+      const size_t* column_indices = matrix.column_indices_pointer();
+      const ElementType* entries = matrix.data_pointer();
+      for (size_t row_index: Range(matrix.number_rows())) {
+         if (y[row_index] != ElementType(0)) {
+            const ElementType coefficient = scaling_factor * y[row_index];
+            const size_t row_start = matrix.row_start(row_index);
+            const size_t row_end = row_start + matrix.row_size(row_index);
+            for (size_t nonzero_index = row_start; nonzero_index < row_end; nonzero_index++) {
+               assert(column_indices[nonzero_index] < result.size() && "jacobian_transposed_product: the result vector is too small");
+               result[column_indices[nonzero_index]] += coefficient * entries[nonzero_index];
+            }
          }
       }
+   }
 
-   protected:
-      std::vector<SparseVector<ElementType>> matrix;
-   };
+   // result = J^T y, where result is a preallocated dense vector that is entirely overwritten
+   template <typename ElementType, typename Array, typename ResultArray>
+   void jacobian_transposed_product(const RectangularMatrix<ElementType>& matrix, const Array& y, ResultArray& result) {
+      for (size_t index: Range(result.size())) {
+         result[index] = ElementType(0);
+      }
+      add_jacobian_transposed_product(matrix, y, ElementType(1), result);
+   }
 } // namespace
 
 #endif // UNO_RECTANGULARMATRIX_H
@@ -0,0 +1,152 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_RECTANGULARMATRIXVIEW_H
+#define UNO_RECTANGULARMATRIXVIEW_H
+
+#include <array>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "RectangularMatrix.hpp"
+
+namespace uno {
+   /*! \class RectangularMatrixView
+    * \brief Const view of a RectangularMatrix extended with structured columns
+    *
+    *  A structured column contributes at most one entry per row: a column index (or RectangularMatrixView::none) and a coefficient
+    *  shared by all the rows. The extra entries are enumerated on the fly after the entries of the underlying matrix, so that a
+    *  reformulation (e.g. elastic variables) does not copy the matrix it extends. The view does not own the matrix: it must be
+    *  rebound (reset) whenever the underlying matrix may have been moved
+    */
+   template <typename ElementType>
+   class RectangularMatrixView {
+   public:
+      using value_type = ElementType;
+      static constexpr size_t none = std::numeric_limits<size_t>::max();
+      // the l1 relaxation needs two columns (positive and negative parts); a fixed capacity avoids allocations in the loop
+      static constexpr size_t max_structured_columns = 2;
+
+      class Row {
+      public:
+         class iterator {
+         public:
+            iterator(const Row& row, size_t position, size_t structured_column): row(row), position(position),
+                  structured_column(structured_column) {
+               this->skip_missing_entries();
+            }
+
+            std::pair<size_t, ElementType> operator*() const {
+               if (this->position < this->row.end_position) {
+                  const RectangularMatrix<ElementType>& matrix = *this->row.view.matrix;
+                  return {matrix.column_indices_pointer()[this->position], matrix.data_pointer()[this->position]};
+               }
+               const auto& [columns, coefficient] = this->row.view.structured_columns[this->structured_column];
+               return {(*columns)[this->row.row_index], coefficient};
+            }
+
+            iterator& operator++() {
+               if (this->position < this->row.end_position) {
+                  this->position++;
+               }
+               else {
+                  this->structured_column++;
+               }
+               this->skip_missing_entries();
+               return *this;
+            }
+
+            friend bool operator!=(const iterator& a, const iterator& b) {
+               return a.position != b.position || a.structured_column != b.structured_column;
+            }
+
+         protected:
+            const Row& row;
+            size_t position;
+            size_t structured_column;
+
+            void skip_missing_entries() {
+               if (this->position < this->row.end_position) {
+                  return;
+               }
+               while (this->structured_column < this->row.view.number_structured_columns &&
+                     (*this->row.view.structured_columns[this->structured_column].first)[this->row.row_index] == none) {
+                  this->structured_column++;
+               }
+            }
+         };
+
+         Row(const RectangularMatrixView& view, size_t row_index): view(view), row_index(row_index),
+               start_position(view.matrix->row_start(row_index)), end_position(this->start_position + view.matrix->row_size(row_index)) { }
+
+         [[nodiscard]] size_t size() const {
+            size_t row_size = this->end_position - this->start_position;
+            for (size_t index: Range(this->view.number_structured_columns)) {
+               if ((*this->view.structured_columns[index].first)[this->row_index] != none) {
+                  row_size++;
+               }
+            }
+            return row_size;
+         }
+         [[nodiscard]] bool is_empty() const { return (this->size() == 0); }
+
+         [[nodiscard]] iterator begin() const { return {*this, this->start_position, 0}; }
+         [[nodiscard]] iterator end() const { return {*this, this->end_position, this->view.number_structured_columns}; }
+
+         friend std::ostream& operator<<(std::ostream& stream, const Row& row) {
+            stream << "sparse vector with " << row.size() << " nonzeros\n";
+            for (const auto [index, element]: row) {
+               stream << "index " << index << ", value " << element << '\n';
+            }
+            return stream;
+         }
+
+      protected:
+         const RectangularMatrixView& view;
+         const size_t row_index;
+         const size_t start_position;
+         const size_t end_position;
+      };
+
+      RectangularMatrixView() = default;
+      explicit RectangularMatrixView(const RectangularMatrix<ElementType>& matrix): matrix(&matrix) { }
+
+      // binds the view to a matrix and discards the structured columns
+      void reset(const RectangularMatrix<ElementType>& matrix) {
+         this->matrix = &matrix;
+         this->number_structured_columns = 0;
+         this->number_structured_nonzeros = 0;
+      }
+      // columns[i] is the column index of the entry of row i, or none. The vector must outlive the view
+      void add_structured_column(const std::vector<size_t>& columns, ElementType coefficient) {
+         if (this->number_structured_columns == max_structured_columns) {
+            throw std::length_error("RectangularMatrixView: too many structured columns");
+         }
+         this->structured_columns[this->number_structured_columns] = {&columns, coefficient};
+         this->number_structured_columns++;
+         for (const size_t column_index: columns) {
+            if (column_index != none) {
+               this->number_structured_nonzeros++;
+            }
+         }
+      }
+
+      [[nodiscard]] bool is_bound() const { return (this->matrix != nullptr); }
+      [[nodiscard]] size_t number_rows() const { return this->matrix->number_rows(); }
+      [[nodiscard]] size_t number_nonzeros() const { return this->matrix->number_nonzeros() + this->number_structured_nonzeros; }
+
+      Row operator[](size_t row_index) const {
+         return {*this, row_index};
+      }
+
+   protected:
+      const RectangularMatrix<ElementType>* matrix{nullptr};
+      std::array<std::pair<const std::vector<size_t>*, ElementType>, max_structured_columns> structured_columns{};
+      size_t number_structured_columns{0};
+      size_t number_structured_nonzeros{0};
+   };
+} // namespace
+
+#endif // UNO_RECTANGULARMATRIXVIEW_H
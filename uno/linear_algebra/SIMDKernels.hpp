@@ -0,0 +1,289 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SIMDKERNELS_H
+#define UNO_SIMDKERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace uno {
+   // vectorized reductions over contiguous arrays of doubles. The instruction set is selected at compile time
+   // (AVX-512, AVX2 or NEON, see the CMake option WITH_NATIVE_ARCH), with a scalar fallback.
+   // Unaligned loads are used throughout, the arrays of Vector are nevertheless aligned (see AlignedAllocator)
+
+   // scalar fallback: several independent accumulators break the dependency chain
+   inline double scalar_sum_abs(const double* x, size_t size) {
+      double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+      size_t index = 0;
+      for (; index + 4 <= size; index += 4) {
+         s0 += std::abs(x[index]);
+         s1 += std::abs(x[index + 1]);
+         s2 += std::abs(x[index + 2]);
+         s3 += std::abs(x[index + 3]);
+      }
+      for (; index < size; index++) {
+         s0 += std::abs(x[index]);
+      }
+      return (s0 + s1) + (s2 + s3);
+   }
+
+   inline double scalar_dot(const double* x, const double* y, size_t size) {
+      double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+      size_t index = 0;
+      for (; index + 4 <= size; index += 4) {
+         s0 += x[index] * y[index];
+         s1 += x[index + 1] * y[index + 1];
+         s2 += x[index + 2] * y[index + 2];
+         s3 += x[index + 3] * y[index + 3];
+      }
+      for (; index < size; index++) {
+         s0 += x[index] * y[index];
+      }
+      return (s0 + s1) + (s2 + s3);
+   }
+
+   inline double scalar_max_abs(const double* x, size_t size) {
+      double m0 = 0., m1 = 0.;
+      size_t index = 0;
+      for (; index + 2 <= size; index += 2) {
+         m0 = std::max(m0, std::abs(x[index]));
+         m1 = std::max(m1, std::abs(x[index + 1]));
+      }
+      for (; index < size; index++) {
+         m0 = std::max(m0, std::abs(x[index]));
+      }
+      return std::max(m0, m1);
+   }
+
+   // violation max(0, lb - c, c - ub) of the bounds lb <= c <= ub. A NaN value is not counted (as in Model::constraint_violation)
+   inline double scalar_bound_violation(double value, double lower_bound, double upper_bound) {
+      return std::max(0., std::max(lower_bound - value, value - upper_bound));
+   }
+
+   inline double scalar_bound_violation_sum(const double* values, const double* lower_bounds, const double* upper_bounds, size_t size,
+         bool squared) {
+      double s0 = 0., s1 = 0.;
+      size_t index = 0;
+      for (; index + 2 <= size; index += 2) {
+         const double violation0 = scalar_bound_violation(values[index], lower_bounds[index], upper_bounds[index]);
+         const double violation1 = scalar_bound_violation(values[index + 1], lower_bounds[index + 1], upper_bounds[index + 1]);
+         s0 += squared ? violation0 * violation0 : violation0;
+         s1 += squared ? violation1 * violation1 : violation1;
+      }
+      for (; index < size; index++) {
+         const double violation = scalar_bound_violation(values[index], lower_bounds[index], upper_bounds[index]);
+         s0 += squared ? violation * violation : violation;
+      }
+      return s0 + s1;
+   }
+
+   inline double scalar_bound_violation_max(const double* values, const double* lower_bounds, const double* upper_bounds, size_t size) {
+      double maximum = 0.;
+      for (size_t index = 0; index < size; index++) {
+         maximum = std::max(maximum, scalar_bound_violation(values[index], lower_bounds[index], upper_bounds[index]));
+      }
+      return maximum;
+   }
+
+   // ||x||_1
+   inline double simd_norm_1(const double* x, size_t size) {
+#if defined(__AVX512F__)
+      __m512d accumulator = _mm512_setzero_pd();
+      size_t index = 0;
+      for (; index + 8 <= size; index += 8) {
+         accumulator = _mm512_add_pd(accumulator, _mm512_abs_pd(_mm512_loadu_pd(x + index)));
+      }
+      return _mm512_reduce_add_pd(accumulator) + scalar_sum_abs(x + index, size - index);
+#elif defined(__AVX2__)
+      const __m256d sign_mask = _mm256_set1_pd(-0.);
+      __m256d accumulator = _mm256_setzero_pd();
+      size_t index = 0;
+      for (; index + 4 <= size; index += 4) {
+         accumulator = _mm256_add_pd(accumulator, _mm256_andnot_pd(sign_mask, _mm256_loadu_pd(x + index)));
+      }
+      alignas(32) double partial_sums[4];
+      _mm256_store_pd(partial_sums, accumulator);
+      return (partial_sums[0] + partial_sums[1]) + (partial_sums[2] + partial_sums[3]) + scalar_sum_abs(x + index, size - index);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      float64x2_t accumulator = vdupq_n_f64(0.);
+      size_t index = 0;
+      for (; index + 2 <= size; index += 2) {
+         accumulator = vaddq_f64(accumulator, vabsq_f64(vld1q_f64(x + index)));
+      }
+      return vaddvq_f64(accumulator) + scalar_sum_abs(x + index, size - index);
+#else
+      return scalar_sum_abs(x, size);
+#endif
+   }
+
+   // x^T y
+   inline double simd_dot(const double* x, const double* y, size_t size) {
+#if defined(__AVX512F__)
+      __m512d accumulator = _mm512_setzero_pd();
+      size_t index = 0;
+      for (; index + 8 <= size; index += 8) {
+         accumulator = _mm512_fmadd_pd(_mm512_loadu_pd(x + index), _mm512_loadu_pd(y + index), accumulator);
+      }
+      return _mm512_reduce_add_pd(accumulator) + scalar_dot(x + index, y + index, size - index);
+#elif defined(__AVX2__)
+      __m256d accumulator = _mm256_setzero_pd();
+      size_t index = 0;
+      for (; index + 4 <= size; index += 4) {
+#if defined(__FMA__)
+         accumulator = _mm256_fmadd_pd(_mm256_loadu_pd(x + index), _mm256_loadu_pd(y + index), accumulator);
+#else
+         accumulator = _mm256_add_pd(accumulator, _mm256_mul_pd(_mm256_loadu_pd(x + index), _mm256_loadu_pd(y + index)));
+#endif
+      }
+      alignas(32) double partial_sums[4];
+      _mm256_store_pd(partial_sums, accumulator);
+      return (partial_sums[0] + partial_sums[1]) + (partial_sums[2] + partial_sums[3]) + scalar_dot(x + index, y + index, size - index);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      float64x2_t accumulator = vdupq_n_f64(0.);
+      size_t index = 0;
+      for (; index + 2 <= size; index += 2) {
+         accumulator = vfmaq_f64(accumulator, vld1q_f64(x + index), vld1q_f64(y + index));
+      }
+      return vaddvq_f64(accumulator) + scalar_dot(x + index, y + index, size - index);
+#else
+      return scalar_dot(x, y, size);
+#endif
+   }
+
+   // ||x||_2^2
+   inline double simd_norm_2_squared(const double* x, size_t size) {
+      return simd_dot(x, x, size);
+   }
+
+   // ||x||_inf
+   inline double simd_norm_inf(const double* x, size_t size) {
+#if defined(__AVX512F__)
+      __m512d accumulator = _mm512_setzero_pd();
+      size_t index = 0;
+      for (; index + 8 <= size; index += 8) {
+         accumulator = _mm512_max_pd(accumulator, _mm512_abs_pd(_mm512_loadu_pd(x + index)));
+      }
+      return std::max(_mm512_reduce_max_pd(accumulator), scalar_max_abs(x + index, size - index));
+#elif defined(__AVX2__)
+      const __m256d sign_mask = _mm256_set1_pd(-0.);
+      __m256d accumulator = _mm256_setzero_pd();
+      size_t index = 0;
+      for (; index + 4 <= size; index += 4) {
+         accumulator = _mm256_max_pd(accumulator, _mm256_andnot_pd(sign_mask, _mm256_loadu_pd(x + index)));
+      }
+      alignas(32) double partial_maxima[4];
+      _mm256_store_pd(partial_maxima, accumulator);
+      const double maximum = std::max(std::max(partial_maxima[0], partial_maxima[1]), std::max(partial_maxima[2], partial_maxima[3]));
+      return std::max(maximum, scalar_max_abs(x + index, size - index));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      float64x2_t accumulator = vdupq_n_f64(0.);
+      size_t index = 0;
+      for (; index + 2 <= size; index += 2) {
+         accumulator = vmaxq_f64(accumulator, vabsq_f64(vld1q_f64(x + index)));
+      }
+      return std::max(vmaxvq_f64(accumulator), scalar_max_abs(x + index, size - index));
+#else
+      return scalar_max_abs(x, size);
+#endif
+   }
+
+   // sum of the bound violations max(0, lb - c, c - ub) (or of their squares) over contiguous arrays. The max instructions return
+   // their second operand (here 0) when the first one is NaN
+   inline double simd_bound_violation_sum(const double* values, const double* lower_bounds, const double* upper_bounds, size_t size,
+         bool squared) {
+#if defined(__AVX512F__)
+      const __m512d zero = _mm512_setzero_pd();
+      __m512d accumulator = _mm512_setzero_pd();
+      size_t index = 0;
+      for (; index + 8 <= size; index += 8) {
+         const __m512d value = _mm512_loadu_pd(values + index);
+         const __m512d violation = _mm512_max_pd(_mm512_max_pd(_mm512_sub_pd(_mm512_loadu_pd(lower_bounds + index), value),
+               _mm512_sub_pd(value, _mm512_loadu_pd(upper_bounds + index))), zero);
+         accumulator = _mm512_add_pd(accumulator, squared ? _mm512_mul_pd(violation, violation) : violation);
+      }
+      return _mm512_reduce_add_pd(accumulator) +
+            scalar_bound_violation_sum(values + index, lower_bounds + index, upper_bounds + index, size - index, squared);
+#elif defined(__AVX2__)
+      const __m256d zero = _mm256_setzero_pd();
+      __m256d accumulator = _mm256_setzero_pd();
+      size_t index = 0;
+      for (; index + 4 <= size; index += 4) {
+         const __m256d value = _mm256_loadu_pd(values + index);
+         const __m256d violation = _mm256_max_pd(_mm256_max_pd(_mm256_sub_pd(_mm256_loadu_pd(lower_bounds + index), value),
+               _mm256_sub_pd(value, _mm256_loadu_pd(upper_bounds + index))), zero);
+         accumulator = _mm256_add_pd(accumulator, squared ? _mm256_mul_pd(violation, violation) : violation);
+      }
+      alignas(32) double partial_sums[4];
+      _mm256_store_pd(partial_sums, accumulator);
+      return (partial_sums[0] + partial_sums[1]) + (partial_sums[2] + partial_sums[3]) +
+            scalar_bound_violation_sum(values + index, lower_bounds + index, upper_bounds + index, size - index, squared);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      // vmaxnmq returns the number when the other operand is NaN
+      const float64x2_t zero = vdupq_n_f64(0.);
+      float64x2_t accumulator = vdupq_n_f64(0.);
+      size_t index = 0;
+      for (; index + 2 <= size; index += 2) {
+         const float64x2_t value = vld1q_f64(values + index);
+         const float64x2_t violation = vmaxnmq_f64(vmaxq_f64(vsubq_f64(vld1q_f64(lower_bounds + index), value),
+               vsubq_f64(value, vld1q_f64(upper_bounds + index))), zero);
+         accumulator = squared ? vfmaq_f64(accumulator, violation, violation) : vaddq_f64(accumulator, violation);
+      }
+      return vaddvq_f64(accumulator) +
+            scalar_bound_violation_sum(values + index, lower_bounds + index, upper_bounds + index, size - index, squared);
+#else
+      return scalar_bound_violation_sum(values, lower_bounds, upper_bounds, size, squared);
+#endif
+   }
+
+   // maximum bound violation max(0, lb - c, c - ub) over contiguous arrays
+   inline double simd_bound_violation_max(const double* values, const double* lower_bounds, const double* upper_bounds, size_t size) {
+#if defined(__AVX512F__)
+      __m512d accumulator = _mm512_setzero_pd();
+      size_t index = 0;
+      for (; index + 8 <= size; index += 8) {
+         const __m512d value = _mm512_loadu_pd(values + index);
+         const __m512d violation = _mm512_max_pd(_mm512_sub_pd(_mm512_loadu_pd(lower_bounds + index), value),
+               _mm512_sub_pd(value, _mm512_loadu_pd(upper_bounds + index)));
+         accumulator = _mm512_max_pd(violation, accumulator);
+      }
+      return std::max(_mm512_reduce_max_pd(accumulator),
+            scalar_bound_violation_max(values + index, lower_bounds + index, upper_bounds + index, size - index));
+#elif defined(__AVX2__)
+      __m256d accumulator = _mm256_setzero_pd();
+      size_t index = 0;
+      for (; index + 4 <= size; index += 4) {
+         const __m256d value = _mm256_loadu_pd(values + index);
+         const __m256d violation = _mm256_max_pd(_mm256_sub_pd(_mm256_loadu_pd(lower_bounds + index), value),
+               _mm256_sub_pd(value, _mm256_loadu_pd(upper_bounds + index)));
+         accumulator = _mm256_max_pd(violation, accumulator);
+      }
+      alignas(32) double partial_maxima[4];
+      _mm256_store_pd(partial_maxima, accumulator);
+      const double maximum = std::max(std::max(partial_maxima[0], partial_maxima[1]), std::max(partial_maxima[2], partial_maxima[3]));
+      return std::max(maximum, scalar_bound_violation_max(values + index, lower_bounds + index, upper_bounds + index, size - index));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      float64x2_t accumulator = vdupq_n_f64(0.);
+      size_t index = 0;
+      for (; index + 2 <= size; index += 2) {
+         const float64x2_t value = vld1q_f64(values + index);
+         const float64x2_t violation = vmaxq_f64(vsubq_f64(vld1q_f64(lower_bounds + index), value),
+               vsubq_f64(value, vld1q_f64(upper_bounds + index)));
+         accumulator = vmaxnmq_f64(violation, accumulator);
+      }
+      return std::max(vmaxvq_f64(accumulator),
+            scalar_bound_violation_max(values + index, lower_bounds + index, upper_bounds + index, size - index));
+#else
+      return scalar_bound_violation_max(values, lower_bounds, upper_bounds, size);
+#endif
+   }
+} // namespace
+
+#endif // UNO_SIMDKERNELS_H
@@ -0,0 +1,275 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SPARSELU_H
+#define UNO_SPARSELU_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   /*! \class SparseLU
+    * \brief Left-looking sparse LU factorization B = L U of a basis of the columns of a rectangular m x n matrix
+    *
+    *  The candidate columns of the matrix (stored by columns) are processed in the given order (Gilbert and Peierls, 1988). Each
+    *  candidate column is eliminated with the columns of L computed so far: the structure of the solution is the set of rows
+    *  reachable from the nonzeros of the column in the graph of L (depth-first search), so that the elimination costs O(flops).
+    *  The pivot is chosen by partial pivoting among the rows that are not pivoted yet. A column whose largest candidate pivot does
+    *  not exceed the dependency tolerance relative to its largest entry depends linearly on the previous ones and is skipped.
+    *  The factorization stops when m columns are basic: the basis is selected and factorized in a single pass.
+    *  L has a unit diagonal (its pivot rows are implicit) and U is stored by columns with the indices of the elimination steps
+    */
+   template <typename ElementType>
+   class SparseLU {
+   public:
+      static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+      explicit SparseLU(size_t maximum_number_rows);
+
+      // factorizes the basis made of the first linearly independent candidate columns. Returns the rank of the basis
+      size_t factorize(size_t number_rows, const std::vector<size_t>& column_starts, const std::vector<size_t>& row_indices,
+            const std::vector<ElementType>& values, const std::vector<size_t>& candidate_columns, ElementType dependency_tolerance);
+
+      [[nodiscard]] size_t rank() const { return this->basic_columns.size(); }
+      // basic_columns()[k] is the column of the matrix pivoted at step k
+      [[nodiscard]] const std::vector<size_t>& get_basic_columns() const { return this->basic_columns; }
+      [[nodiscard]] size_t number_factor_nonzeros() const { return this->L_values.size() + this->U_values.size() + this->U_diagonal.size(); }
+      [[nodiscard]] double flops() const { return this->number_flops; }
+
+      // precondition: the basis has full rank m
+      // solves B z = b: b is indexed by the rows, z by the elimination steps (the basic columns)
+      void solve(const ElementType* rhs, ElementType* solution) const;
+      // solves B^T y = c: c is indexed by the elimination steps, y by the rows
+      void solve_transpose(const ElementType* rhs, ElementType* solution) const;
+
+      [[nodiscard]] size_t memory_size() const;
+
+   protected:
+      size_t number_rows{0};
+      std::vector<size_t> basic_columns{};
+      std::vector<size_t> pivot_rows{}; // row pivoted at step k
+      std::vector<size_t> pivot_steps; // step at which the row is pivoted, or none
+      // columns of L (original row indices) and of U (step indices), without their diagonals
+      std::vector<size_t> L_starts{};
+      std::vector<size_t> L_rows{};
+      std::vector<ElementType> L_values{};
+      std::vector<size_t> U_starts{};
+      std::vector<size_t> U_steps{};
+      std::vector<ElementType> U_values{};
+      std::vector<ElementType> U_diagonal{};
+      double number_flops{0.};
+
+      // workspaces of the elimination
+      std::vector<ElementType> dense_column;
+      std::vector<size_t> visit_stamps;
+      size_t current_stamp{0};
+      std::vector<size_t> reach{}; // rows of the structure of the eliminated column, in postorder
+      std::vector<std::pair<size_t, size_t>> stack{}; // (row, position in its column of L)
+      mutable std::vector<ElementType> workspace;
+
+      void compute_reach(size_t row_index);
+   };
+
+   // implementation
+
+   template <typename ElementType>
+   SparseLU<ElementType>::SparseLU(size_t maximum_number_rows):
+         pivot_steps(maximum_number_rows, none),
+         dense_column(maximum_number_rows, ElementType(0)),
+         visit_stamps(maximum_number_rows, 0),
+         workspace(maximum_number_rows) {
+      this->basic_columns.reserve(maximum_number_rows);
+      this->pivot_rows.reserve(maximum_number_rows);
+      this->L_starts.reserve(maximum_number_rows + 1);
+      this->U_starts.reserve(maximum_number_rows + 1);
+      this->U_diagonal.reserve(maximum_number_rows);
+      this->reach.reserve(maximum_number_rows);
+      this->stack.reserve(maximum_number_rows);
+   }
+
+   template <typename ElementType>
+   size_t SparseLU<ElementType>::factorize(size_t number_rows, const std::vector<size_t>& column_starts, const std::vector<size_t>& row_indices,
+         const std::vector<ElementType>& values, const std::vector<size_t>& candidate_columns, ElementType dependency_tolerance) {
+      this->number_rows = number_rows;
+      if (this->pivot_steps.size() < number_rows) {
+         this->pivot_steps.resize(number_rows);
+         this->dense_column.resize(number_rows, ElementType(0));
+         this->visit_stamps.resize(number_rows, 0);
+         this->workspace.resize(number_rows);
+      }
+      std::fill(this->pivot_steps.begin(), this->pivot_steps.begin() + static_cast<std::ptrdiff_t>(number_rows), none);
+      this->basic_columns.clear();
+      this->pivot_rows.clear();
+      this->L_starts.assign(1, 0);
+      this->L_rows.clear();
+      this->L_values.clear();
+      this->U_starts.assign(1, 0);
+      this->U_steps.clear();
+      this->U_values.clear();
+      this->U_diagonal.clear();
+      this->number_flops = 0.;
+
+      for (const size_t column_index: candidate_columns) {
+         if (this->basic_columns.size() == number_rows) {
+            break;
+         }
+         // scatter the column and compute the structure of L^-1 a
+         this->current_stamp++;
+         this->reach.clear();
+         ElementType largest_entry(0);
+         for (size_t position: Range(column_starts[column_index], column_starts[column_index + 1])) {
+            const size_t row_index = row_indices[position];
+            this->dense_column[row_index] += values[position];
+            largest_entry = std::max(largest_entry, std::abs(values[position]));
+            if (this->visit_stamps[row_index] != this->current_stamp) {
+               this->compute_reach(row_index);
+            }
+         }
+         // eliminate in topological order (reverse postorder)
+         for (size_t position = this->reach.size(); position-- > 0;) {
+            const size_t row_index = this->reach[position];
+            const size_t step = this->pivot_steps[row_index];
+            const ElementType value = this->dense_column[row_index];
+            if (step != none && value != ElementType(0)) {
+               for (size_t L_position: Range(this->L_starts[step], this->L_starts[step + 1])) {
+                  this->dense_column[this->L_rows[L_position]] -= this->L_values[L_position] * value;
+               }
+               this->number_flops += 2. * static_cast<double>(this->L_starts[step + 1] - this->L_starts[step]);
+            }
+         }
+         // partial pivoting among the rows that are not pivoted yet
+         size_t pivot_row = none;
+         ElementType largest_pivot(0);
+         for (const size_t row_index: this->reach) {
+            if (this->pivot_steps[row_index] == none && largest_pivot < std::abs(this->dense_column[row_index])) {
+               largest_pivot = std::abs(this->dense_column[row_index]);
+               pivot_row = row_index;
+            }
+         }
+         if (pivot_row != none && dependency_tolerance * largest_entry < largest_pivot) {
+            const size_t step = this->basic_columns.size();
+            const ElementType pivot = this->dense_column[pivot_row];
+            for (const size_t row_index: this->reach) {
+               const ElementType value = this->dense_column[row_index];
+               if (row_index == pivot_row || value == ElementType(0)) {
+                  continue;
+               }
+               if (this->pivot_steps[row_index] != none) {
+                  this->U_steps.emplace_back(this->pivot_steps[row_index]);
+                  this->U_values.emplace_back(value);
+               }
+               else {
+                  this->L_rows.emplace_back(row_index);
+                  this->L_values.emplace_back(value / pivot);
+               }
+            }
+            this->U_diagonal.emplace_back(pivot);
+            this->L_starts.emplace_back(this->L_rows.size());
+            this->U_starts.emplace_back(this->U_steps.size());
+            this->pivot_steps[pivot_row] = step;
+            this->pivot_rows.emplace_back(pivot_row);
+            this->basic_columns.emplace_back(column_index);
+         }
+         for (const size_t row_index: this->reach) {
+            this->dense_column[row_index] = ElementType(0);
+         }
+      }
+      return this->basic_columns.size();
+   }
+
+   // nonrecursive depth-first search in the graph of L: the children of a pivoted row are the rows of its column of L
+   template <typename ElementType>
+   void SparseLU<ElementType>::compute_reach(size_t row_index) {
+      this->stack.clear();
+      this->visit_stamps[row_index] = this->current_stamp;
+      const size_t step = this->pivot_steps[row_index];
+      this->stack.emplace_back(row_index, (step != none) ? this->L_starts[step] : 0);
+      while (!this->stack.empty()) {
+         auto& [current_row, position] = this->stack.back();
+         const size_t current_step = this->pivot_steps[current_row];
+         bool has_unvisited_child = false;
+         if (current_step != none) {
+            while (position < this->L_starts[current_step + 1]) {
+               const size_t child_row = this->L_rows[position];
+               position++;
+               if (this->visit_stamps[child_row] != this->current_stamp) {
+                  this->visit_stamps[child_row] = this->current_stamp;
+                  const size_t child_step = this->pivot_steps[child_row];
+                  this->stack.emplace_back(child_row, (child_step != none) ? this->L_starts[child_step] : 0);
+                  has_unvisited_child = true;
+                  break;
+               }
+            }
+         }
+         if (!has_unvisited_child) {
+            this->reach.emplace_back(current_row);
+            this->stack.pop_back();
+         }
+      }
+   }
+
+   template <typename ElementType>
+   void SparseLU<ElementType>::solve(const ElementType* rhs, ElementType* solution) const {
+      const size_t m = this->number_rows;
+      for (size_t row_index: Range(m)) {
+         this->workspace[row_index] = rhs[row_index];
+      }
+      // L y = b, y indexed by the steps
+      for (size_t step: Range(m)) {
+         const ElementType value = this->workspace[this->pivot_rows[step]];
+         solution[step] = value;
+         if (value != ElementType(0)) {
+            for (size_t position: Range(this->L_starts[step], this->L_starts[step + 1])) {
+               this->workspace[this->L_rows[position]] -= this->L_values[position] * value;
+            }
+         }
+      }
+      // U z = y
+      for (size_t step = m; step-- > 0;) {
+         solution[step] /= this->U_diagonal[step];
+         const ElementType value = solution[step];
+         if (value != ElementType(0)) {
+            for (size_t position: Range(this->U_starts[step], this->U_starts[step + 1])) {
+               solution[this->U_steps[position]] -= this->U_values[position] * value;
+            }
+         }
+      }
+   }
+
+   template <typename ElementType>
+   void SparseLU<ElementType>::solve_transpose(const ElementType* rhs, ElementType* solution) const {
+      const size_t m = this->number_rows;
+      // U^T w = c, w indexed by the steps
+      for (size_t step: Range(m)) {
+         ElementType value = rhs[step];
+         for (size_t position: Range(this->U_starts[step], this->U_starts[step + 1])) {
+            value -= this->U_values[position] * this->workspace[this->U_steps[position]];
+         }
+         this->workspace[step] = value / this->U_diagonal[step];
+      }
+      // L^T y = w: the rows of the column of L of a step are pivoted at later steps
+      for (size_t step = m; step-- > 0;) {
+         ElementType value = this->workspace[step];
+         for (size_t position: Range(this->L_starts[step], this->L_starts[step + 1])) {
+            value -= this->L_values[position] * solution[this->L_rows[position]];
+         }
+         solution[this->pivot_rows[step]] = value;
+      }
+   }
+
+   template <typename ElementType>
+   size_t SparseLU<ElementType>::memory_size() const {
+      return (this->basic_columns.capacity() + this->pivot_rows.capacity() + this->pivot_steps.capacity() + this->L_starts.capacity() +
+            this->L_rows.capacity() + this->U_starts.capacity() + this->U_steps.capacity() + this->visit_stamps.capacity() +
+            this->reach.capacity() + 2 * this->stack.capacity()) * sizeof(size_t) +
+         (this->L_values.capacity() + this->U_values.capacity() + this->U_diagonal.capacity() + this->dense_column.capacity() +
+            this->workspace.capacity()) * sizeof(ElementType);
+   }
+} // namespace
+
+#endif // UNO_SPARSELU_H
@@ -5,7 +5,7 @@
 #define UNO_SPARSESTORAGE_H
 
 #include <ostream>
-#include <functional>
+#include <vector>
 
 namespace uno {
    // abstract class
@@ -43,7 +43,7 @@ namespace uno {
       size_t number_nonzeros{0};
       size_t capacity;
 
-      SparseStorage(size_t dimension, size_t capacity, bool use_regularization);
+      SparseStorage(size_t dimension, size_t capacity, bool use_regularization, size_t index_shift);
       virtual ~SparseStorage() = default;
 
       virtual void reset() = 0;
@@ -53,9 +53,16 @@ namespace uno {
       virtual void insert(ElementType term, IndexType row_index, IndexType column_index) = 0;
       // this method will be used by the CSCSparseStorage subclass
       virtual void finalize_column(IndexType column_index) = 0;
-      virtual void set_regularization(const std::function<ElementType(size_t /*index*/)>& regularization_function) = 0;
       virtual const ElementType* data_pointer() const noexcept = 0;
       virtual ElementType* data_pointer() noexcept = 0;
+      // allocated memory (in bytes)
+      [[nodiscard]] virtual size_t memory_size() const {
+         return (this->diagonal_slots.capacity() + this->regularization_slots.capacity()) * sizeof(size_t);
+      }
+      // nonzero indices of the diagonal terms (including the regularization terms)
+      [[nodiscard]] const std::vector<size_t>& get_diagonal_slots() const { return this->diagonal_slots; }
+      // offset added to the stored indices (1 for Fortran-style, 1-based solvers). The traversals return 0-based indices
+      [[nodiscard]] size_t get_index_shift() const { return static_cast<size_t>(this->index_shift); }
 
       [[nodiscard]] iterator begin() const {
          return iterator(*this, 0, 0);
@@ -71,6 +78,11 @@ namespace uno {
    protected:
       // regularization
       const bool use_regularization;
+      const IndexType index_shift;
+      // the positions of the diagonal and regularization terms are recorded during the assembly, so that the diagonal can be
+      // read and regularized without traversing the whole matrix
+      std::vector<size_t> diagonal_slots{};
+      std::vector<size_t> regularization_slots{};
 
       // virtual iterator functions
       [[nodiscard]] virtual std::tuple<IndexType, IndexType, ElementType> dereference_iterator(size_t column_index, size_t nonzero_index) const = 0;
@@ -80,11 +92,16 @@ namespace uno {
    // implementation
 
    template <typename IndexType, typename ElementType>
-   SparseStorage<IndexType, ElementType>::SparseStorage(size_t dimension, size_t capacity, bool use_regularization) :
+   SparseStorage<IndexType, ElementType>::SparseStorage(size_t dimension, size_t capacity, bool use_regularization, size_t index_shift) :
          dimension(dimension),
          // if regularization is used, allocate the necessary space
          capacity(capacity + (use_regularization ? dimension : 0)),
-         use_regularization(use_regularization) {
+         use_regularization(use_regularization),
+         index_shift(static_cast<IndexType>(index_shift)) {
+      this->diagonal_slots.reserve(dimension);
+      if (use_regularization) {
+         this->regularization_slots.reserve(dimension);
+      }
    }
 
    template <typename IndexType, typename ElementType>
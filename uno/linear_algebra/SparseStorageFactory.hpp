@@ -4,29 +4,38 @@
 #ifndef UNO_SPARSESTORAGEFACTORY_H
 #define UNO_SPARSESTORAGEFACTORY_H
 
+#include <stdexcept>
+#include <string>
+#include <variant>
 #include "SparseStorage.hpp"
 #include "COOSparseStorage.hpp"
 #include "CSCSparseStorage.hpp"
 
 namespace uno {
+   // closed set of storage formats: the concrete type is resolved once per traversal with std::visit instead of once per nonzero
+   template <typename IndexType, typename ElementType>
+   using SparseStorageVariant = std::variant<COOSparseStorage<IndexType, ElementType>, CSCSparseStorage<IndexType, ElementType>>;
+
    template <typename IndexType, typename ElementType>
    class SparseStorageFactory {
    public:
-      static std::unique_ptr<SparseStorage<IndexType, ElementType>> create(const std::string& sparse_storage_type, size_t dimension,
-            size_t capacity, bool use_regularization);
+      static SparseStorageVariant<IndexType, ElementType> create(const std::string& sparse_storage_type, size_t dimension, size_t capacity,
+            bool use_regularization, size_t index_shift = 0);
    };
 
    template <typename IndexType, typename ElementType>
-   std::unique_ptr<SparseStorage<IndexType, ElementType>> SparseStorageFactory<IndexType, ElementType>::create(const std::string& sparse_storage_type,
-         size_t dimension, size_t capacity, bool use_regularization) {
+   SparseStorageVariant<IndexType, ElementType> SparseStorageFactory<IndexType, ElementType>::create(const std::string& sparse_storage_type,
+         size_t dimension, size_t capacity, bool use_regularization, size_t index_shift) {
       if (sparse_storage_type == "COO") {
-         return std::make_unique<COOSparseStorage<IndexType, ElementType>>(dimension, capacity, use_regularization);
+         return SparseStorageVariant<IndexType, ElementType>(std::in_place_type<COOSparseStorage<IndexType, ElementType>>, dimension, capacity,
+               use_regularization, index_shift);
       }
       else if (sparse_storage_type == "CSC") {
-         return std::make_unique<CSCSparseStorage<IndexType, ElementType>>(dimension, capacity, use_regularization);
+         return SparseStorageVariant<IndexType, ElementType>(std::in_place_type<CSCSparseStorage<IndexType, ElementType>>, dimension, capacity,
+               use_regularization, index_shift);
       }
       throw std::invalid_argument("Sparse storage " + sparse_storage_type + " unknown");
    }
 } // namespace
 
-#endif // UNO_SPARSESTORAGEFACTORY_H
\ No newline at end of file
+#endif // UNO_SPARSESTORAGEFACTORY_H
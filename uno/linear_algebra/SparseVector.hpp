@@ -4,8 +4,8 @@
 #ifndef UNO_SPARSEVECTOR_H
 #define UNO_SPARSEVECTOR_H
 
+#include <algorithm>
 #include <cassert>
-#include <functional>
 #include <vector>
 #include "tools/Logger.hpp"
 #include "symbolic/Range.hpp"
@@ -15,7 +15,9 @@ namespace uno {
    // SparseVector is a sparse vector that uses contiguous memory. It contains:
    // - a vector of indices of type size_t
    // - a vector of values of type ElementType
-   // the indices are neither unique nor sorted
+   // the indices are neither unique nor sorted in general. The vector is canonical when its indices are unique and sorted in
+   // increasing order: this is the case when the indices are inserted in increasing order, or after canonicalize().
+   // Canonical vectors support binary-search lookup and merge-based operations
    template <typename ElementType>
    class SparseVector {
    public:
@@ -49,12 +51,29 @@ namespace uno {
 
       [[nodiscard]] size_t size() const;
       void reserve(size_t capacity);
+      // allocated memory (in bytes)
+      [[nodiscard]] size_t memory_size() const {
+         return this->indices.capacity() * sizeof(size_t) + this->values.capacity() * sizeof(ElementType);
+      }
 
       void insert(size_t index, ElementType value);
-      void transform(const std::function<ElementType(ElementType)>& f);
+      // applies the element-wise function (any callable ElementType -> ElementType) in place
+      template <typename Function>
+      void transform(const Function& f);
+      // multiplies each element by the factor of its index
+      template <typename Array>
+      void scale_elements(const Array& factors);
       void clear();
       [[nodiscard]] bool is_empty() const;
 
+      // canonical form
+      [[nodiscard]] bool is_canonical() const { return this->canonical; }
+      void canonicalize();
+      // precondition: the vector is canonical. Adds value to the element at index (possibly a new nonzero)
+      void insert_or_accumulate(size_t index, ElementType value);
+      // element at index (binary search if the vector is canonical, linear scan otherwise)
+      [[nodiscard]] ElementType get(size_t index) const;
+
       [[nodiscard]] iterator begin() const { return iterator(*this, 0); }
       [[nodiscard]] iterator end() const { return iterator(*this, this->number_nonzeros); }
 
@@ -65,6 +84,12 @@ namespace uno {
       std::vector<size_t> indices{};
       std::vector<ElementType> values{};
       size_t number_nonzeros{0};
+      bool canonical{true};
+
+      template <typename E>
+      friend E dot(const SparseVector<E>& x, const SparseVector<E>& y);
+      template <typename E>
+      friend void add(const SparseVector<E>& x, const SparseVector<E>& y, SparseVector<E>& result);
    };
 
    // SparseVector methods
@@ -86,6 +111,9 @@ namespace uno {
 
    template <typename ElementType>
    void SparseVector<ElementType>::insert(size_t index, ElementType value) {
+      if (0 < this->number_nonzeros && index <= this->indices[this->number_nonzeros - 1]) {
+         this->canonical = false;
+      }
       this->indices.emplace_back(index);
       this->values.emplace_back(value);
       this->number_nonzeros++;
@@ -96,6 +124,7 @@ namespace uno {
       this->indices.clear();
       this->values.clear();
       this->number_nonzeros = 0;
+      this->canonical = true;
    }
 
    template <typename ElementType>
@@ -104,12 +133,89 @@ namespace uno {
    }
 
    template <typename ElementType>
-   void SparseVector<ElementType>::transform(const std::function<ElementType (ElementType)>& f) {
+   template <typename Function>
+   void SparseVector<ElementType>::transform(const Function& f) {
       for (size_t index: Range(this->number_nonzeros)) {
          this->values[index] = f(this->values[index]);
       }
    }
 
+   template <typename ElementType>
+   template <typename Array>
+   void SparseVector<ElementType>::scale_elements(const Array& factors) {
+      for (size_t index: Range(this->number_nonzeros)) {
+         this->values[index] *= factors[this->indices[index]];
+      }
+   }
+
+   template <typename ElementType>
+   void SparseVector<ElementType>::canonicalize() {
+      if (this->canonical) {
+         return;
+      }
+      // sort the positions by index. Ties are broken by position, so that the duplicates are summed in the insertion order
+      std::vector<size_t> permutation(this->number_nonzeros);
+      for (size_t position: Range(this->number_nonzeros)) {
+         permutation[position] = position;
+      }
+      std::sort(permutation.begin(), permutation.end(), [&](size_t position1, size_t position2) {
+         return (this->indices[position1] < this->indices[position2]) ||
+            (this->indices[position1] == this->indices[position2] && position1 < position2);
+      });
+      // merge the duplicates
+      std::vector<size_t> sorted_indices;
+      std::vector<ElementType> sorted_values;
+      sorted_indices.reserve(this->indices.capacity());
+      sorted_values.reserve(this->values.capacity());
+      for (size_t position: permutation) {
+         if (!sorted_indices.empty() && sorted_indices.back() == this->indices[position]) {
+            sorted_values.back() += this->values[position];
+         }
+         else {
+            sorted_indices.emplace_back(this->indices[position]);
+            sorted_values.emplace_back(this->values[position]);
+         }
+      }
+      this->indices = std::move(sorted_indices);
+      this->values = std::move(sorted_values);
+      this->number_nonzeros = this->indices.size();
+      this->canonical = true;
+   }
+
+   template <typename ElementType>
+   void SparseVector<ElementType>::insert_or_accumulate(size_t index, ElementType value) {
+      assert(this->canonical && "SparseVector::insert_or_accumulate: the vector is not canonical");
+      const auto position = std::lower_bound(this->indices.begin(), this->indices.end(), index);
+      const auto offset = position - this->indices.begin();
+      if (position != this->indices.end() && *position == index) {
+         this->values[static_cast<size_t>(offset)] += value;
+      }
+      else {
+         this->indices.insert(position, index);
+         this->values.insert(this->values.begin() + offset, value);
+         this->number_nonzeros++;
+      }
+   }
+
+   template <typename ElementType>
+   ElementType SparseVector<ElementType>::get(size_t index) const {
+      if (this->canonical) {
+         const auto position = std::lower_bound(this->indices.begin(), this->indices.end(), index);
+         if (position != this->indices.end() && *position == index) {
+            return this->values[static_cast<size_t>(position - this->indices.begin())];
+         }
+         return ElementType(0);
+      }
+      // the duplicates are accumulated
+      ElementType element = ElementType(0);
+      for (size_t position: Range(this->number_nonzeros)) {
+         if (this->indices[position] == index) {
+            element += this->values[position];
+         }
+      }
+      return element;
+   }
+
    template <typename ElementType>
    std::ostream& operator<<(std::ostream& stream, const SparseVector<ElementType>& x) {
       stream << "sparse vector with " << x.size() << " nonzeros\n";
@@ -142,6 +248,53 @@ namespace uno {
       return dot_product;
    }
 
+   // merge-based dot product of two canonical sparse vectors
+   template <typename ElementType>
+   ElementType dot(const SparseVector<ElementType>& x, const SparseVector<ElementType>& y) {
+      assert(x.is_canonical() && y.is_canonical() && "dot: the sparse vectors are not canonical");
+      ElementType dot_product = ElementType(0);
+      size_t x_position = 0, y_position = 0;
+      while (x_position < x.number_nonzeros && y_position < y.number_nonzeros) {
+         if (x.indices[x_position] < y.indices[y_position]) {
+            x_position++;
+         }
+         else if (y.indices[y_position] < x.indices[x_position]) {
+            y_position++;
+         }
+         else {
+            dot_product += x.values[x_position] * y.values[y_position];
+            x_position++;
+            y_position++;
+         }
+      }
+      return dot_product;
+   }
+
+   // merge-based sum of two canonical sparse vectors: result = x + y (result is canonical)
+   template <typename ElementType>
+   void add(const SparseVector<ElementType>& x, const SparseVector<ElementType>& y, SparseVector<ElementType>& result) {
+      assert(x.is_canonical() && y.is_canonical() && "add: the sparse vectors are not canonical");
+      assert(&result != &x && &result != &y && "add: the result must not alias the operands");
+      result.clear();
+      result.reserve(x.number_nonzeros + y.number_nonzeros);
+      size_t x_position = 0, y_position = 0;
+      while (x_position < x.number_nonzeros || y_position < y.number_nonzeros) {
+         if (y_position == y.number_nonzeros || (x_position < x.number_nonzeros && x.indices[x_position] < y.indices[y_position])) {
+            result.insert(x.indices[x_position], x.values[x_position]);
+            x_position++;
+         }
+         else if (x_position == x.number_nonzeros || y.indices[y_position] < x.indices[x_position]) {
+            result.insert(y.indices[y_position], y.values[y_position]);
+            y_position++;
+         }
+         else {
+            result.insert(x.indices[x_position], x.values[x_position] + y.values[y_position]);
+            x_position++;
+            y_position++;
+         }
+      }
+   }
+
    // precondition: factor != 0
    template <typename ElementType>
    void scale(SparseVector<ElementType>& x, ElementType factor) {
@@ -4,34 +4,129 @@
 #ifndef UNO_SYMMETRICINDEFINITELINEARSYSTEM_H
 #define UNO_SYMMETRICINDEFINITELINEARSYSTEM_H
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "SparseVector.hpp"
 #include "SymmetricMatrix.hpp"
 #include "SparseStorageFactory.hpp"
 #include "RectangularMatrix.hpp"
+#include "RectangularMatrixView.hpp"
 #include "ingredients/hessian_models/UnstableRegularization.hpp"
 #include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "ingredients/subproblem_solvers/SchurComplementSolver.hpp"
+#include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
 #include "model/Model.hpp"
 #include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Checkpoint.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Metrics.hpp"
+#include "tools/Profiler.hpp"
 #include "tools/Statistics.hpp"
+#include "tools/Timeline.hpp"
+#include "tools/Timer.hpp"
 
 namespace uno {
-   template <typename ElementType>
+   // systems above this number of nonzeros have their values reassembled by the OpenMP threads (if available)
+   constexpr size_t parallel_assembly_nonzeros_threshold = 100000;
+
+   enum class IterativeRefinementMethod {
+      CLASSIC = 0, /* x += M^-1 r, with M the factorization */
+      FGMRES /* flexible GMRES right-preconditioned by the factorization */
+   };
+
+   // the indices of the augmented matrix are of type IndexType (e.g. 32-bit indices for Fortran solvers)
+   template <typename IndexType, typename ElementType>
    class SymmetricIndefiniteLinearSystem {
    public:
-      SymmetricMatrix<size_t, ElementType> matrix;
+      SymmetricMatrix<IndexType, ElementType> matrix;
       Vector<ElementType> rhs{};
       Vector<ElementType> solution{};
 
       SymmetricIndefiniteLinearSystem(const std::string& sparse_format, size_t dimension, size_t number_non_zeros, bool use_regularization,
-            const Options& options);
-      void assemble_matrix(const SymmetricMatrix<size_t, double>& hessian, const RectangularMatrix<double>& constraint_jacobian,
-            size_t number_variables, size_t number_constraints);
-      void factorize_matrix(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver, WarmstartInformation& warmstart_information);
-      void regularize_matrix(Statistics& statistics, DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver,
+            const Options& options, size_t index_shift = 0);
+      // Jacobian is either RectangularMatrix<double> or RectangularMatrixView<double>
+      template <typename Jacobian>
+      void assemble_matrix(const SymmetricMatrix<size_t, double>& hessian, const Jacobian& constraint_jacobian,
+            size_t number_variables, size_t number_constraints, const WarmstartInformation& warmstart_information);
+      // condensed system: the slack variables (diagonal Hessian block, single Jacobian entry in their constraint) are eliminated
+      // analytically. The matrix has dimension (number_variables - number_slacks + number_constraints), while the rhs and the solution
+      // keep the full dimension: solve() condenses the rhs and recovers the slack components of the solution
+      template <typename Jacobian>
+      void assemble_condensed_matrix(const SymmetricMatrix<size_t, double>& hessian, const Jacobian& constraint_jacobian,
+            size_t number_variables, size_t number_constraints, const SparseVector<size_t>& slacks);
+      // diagonal layer of the primal block (e.g. the barrier terms), stored separately from the Hessian. It is part of the next assembly
+      void set_primal_diagonal(const Vector<double>& diagonal, size_t number_variables);
+      // O(n) in-place update of the diagonal layer of the assembled matrix, when the Hessian and the Jacobian are unchanged
+      [[nodiscard]] bool can_update_primal_diagonal(size_t number_variables, size_t number_constraints) const;
+      void update_primal_diagonal();
+      // low-rank term of the primal block, kept in compact form: H - W M^{-1} W^T with W (number_variables x dimension, column-major) and
+      // M (dimension x dimension, column-major) is represented by the border [H W; W^T M] of the matrix, whose inertia is shifted by
+      // (dimension/2, dimension/2). It is part of the next assembly (not of the condensed matrix)
+      void set_low_rank_term(const Vector<double>& factors, const Vector<double>& middle_matrix, size_t number_variables, size_t dimension);
+      // reset the matrix to another use (e.g. the least-square multiplier system): the next assembly starts from scratch
+      void reset_matrix(size_t dimension);
+      // dimension of the primal block of the matrix (the eliminated slacks and the border of the low-rank term excluded)
+      [[nodiscard]] size_t primal_block_dimension() const {
+         return this->matrix.dimension() - this->number_constraints - this->assembled_low_rank_dimension;
+      }
+      void factorize_matrix(DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, WarmstartInformation& warmstart_information);
+      void regularize_matrix(Statistics& statistics, DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
+            size_t size_primal_block, size_t size_dual_block, ElementType dual_regularization_parameter, WarmstartInformation& warmstart_information);
+      // factorize the matrix and correct its inertia. If the previous iterations needed a regularization, the factorization of the
+      // unregularized matrix (likely to fail) is skipped
+      void factorize_and_regularize_matrix(Statistics& statistics, DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
             size_t size_primal_block, size_t size_dual_block, ElementType dual_regularization_parameter, WarmstartInformation& warmstart_information);
-      void solve(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver);
-      // [[nodiscard]] T get_primal_regularization() const;
+      // inertia-free regularization (Chiang and Zavala, 2016) for linear solvers that do not compute the inertia (e.g. iterative solvers):
+      // the system is solved and the regularization is increased until the primal components d of the solution have sufficient curvature
+      // d^T (W + Sigma + delta_w I) d >= kappa d^T d. On exit, the solution is that of the regularized system
+      void solve_and_regularize_by_curvature(Statistics& statistics, SymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
+            size_t size_primal_block, size_t size_dual_block, ElementType dual_regularization_parameter);
+      // same test with a direct solver: each regularization is factorized, then the system is solved. The inertia is not used, which
+      // also accepts the directions of sufficient curvature computed from a matrix with a wrong inertia
+      void factorize_and_regularize_by_curvature(Statistics& statistics, DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
+            size_t size_primal_block, size_t size_dual_block, ElementType dual_regularization_parameter, WarmstartInformation& warmstart_information);
+      // solve the system, then (optionally) refine the solution while the residual is above the tolerance. If the matrix was equilibrated
+      // before its factorization, the scaled system (D A D) (D^-1 x) = D b is solved and refined
+      void solve(SymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, bool iterative_refinement = true);
+      // solve and refine the system with the factors of a direct solver. While the residual ratio of the refined solution remains
+      // above the threshold, the pivot tolerance of the solver is increased, the matrix refactorized and the system solved again
+      // (IPOPT's quality increase). The solver keeps the increased tolerance for the next factorizations
+      void solve_and_increase_accuracy(DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver);
+      // solve the system with the current factors for a block of number_rhs right-hand sides, stored column-major in rhs and result
+      // (each column has dimension number_variables + number_constraints). The rhs and the solution of the system are overwritten if the matrix is condensed
+      void solve_multiple(DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, const Vector<ElementType>& multiple_rhs,
+            Vector<ElementType>& multiple_result, size_t number_rhs);
+      [[nodiscard]] ElementType get_primal_regularization() const { return this->primal_regularization; }
+      [[nodiscard]] size_t get_number_factorizations() const { return this->number_factorizations; }
+      [[nodiscard]] double get_cumulative_factorization_time() const { return this->cumulative_factorization_time; }
+      [[nodiscard]] size_t get_number_refinement_steps() const { return this->number_refinement_steps; }
+      // ||r|| / (min(||x||, 1e6 ||b||) + ||b||) of the last refined solve (0 without refinement)
+      [[nodiscard]] ElementType get_residual_ratio() const { return this->residual_ratio; }
+      [[nodiscard]] size_t get_number_pivot_tolerance_increases() const { return this->number_pivot_tolerance_increases; }
+      // statistics of linear_solver and of the solver of the independent blocks
+      [[nodiscard]] FactorizationStatistics get_factorization_statistics(
+            const DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver) const;
+      // allocated memory of the matrix and of the internal vectors (in bytes)
+      [[nodiscard]] size_t memory_size() const;
+      // regularization history (last regularizations, number of consecutive regularizations) in a checkpoint
+      void save_regularization_state(CheckpointWriter& writer) const;
+      void load_regularization_state(CheckpointReader& reader);
+      // solver of the independent blocks (by default, instances of the linear solver of the options)
+      void set_block_solver_factory(typename SchurComplementSolver<IndexType>::BlockSolverFactory block_solver_factory);
+      [[nodiscard]] size_t number_independent_blocks() const { return this->use_block_solver ? this->block_partition.number_blocks : 1; }
+      // solver that factorized the matrix: linear_solver, or the solver of the independent blocks if linear_solver was replaced
+      [[nodiscard]] DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& active_solver(
+            DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver) const;
+      [[nodiscard]] SymmetricIndefiniteLinearSolver<IndexType, ElementType>& active_solver(
+            SymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver) const;
 
    protected:
       ElementType primal_regularization{0.};
@@ -45,12 +140,128 @@ namespace uno {
       const ElementType primal_regularization_fast_increase_factor;
       const ElementType primal_regularization_slow_increase_factor;
       const size_t threshold_unsuccessful_attempts;
+      const size_t regularization_max_factorizations; /*!< 0: no limit */
+      const bool predictive_regularization;
+      const size_t predictive_regularization_history;
+      const bool dual_regularization_always;
+      const bool use_regularization;
+      const bool values_only_reassembly;
+      const size_t iterative_refinement_max_steps;
+      const ElementType iterative_refinement_tolerance;
+      const IterativeRefinementMethod iterative_refinement_method;
+      const ElementType pivot_tolerance_residual_ratio; /*!< 0: the pivot tolerance is never increased */
+      const ElementType curvature_threshold;
+      // quasi-definite mode: the layer delta I (primal block) and -gamma I (dual block) is added to every factorized matrix, which is
+      // then factorized with static pivoting. The iterative refinement is performed against the matrix without the layer
+      const bool quasi_definite;
+      const ElementType quasi_definite_primal_regularization;
+      const ElementType quasi_definite_dual_regularization;
+      size_t quasi_definite_primal_block{0};
+      bool has_quasi_definite_layer{false};
+      // symmetric Ruiz equilibration D A D of the matrix before its factorization. The factors are computed for each new matrix and
+      // reused across its inertia corrections. The matrix remains scaled until its next modification
+      const bool use_scaling;
+      const size_t scaling_max_iterations;
+      const ElementType scaling_tolerance;
+      Vector<ElementType> scaling_factors{};
+      Vector<ElementType> row_norms{};
+      Vector<ElementType> scaled_rhs{};
+      Vector<ElementType> scaled_solution{};
+      Vector<ElementType> scaled_multiple_rhs{};
+      bool is_matrix_scaled{false};
+      Vector<ElementType> residual{};
+      Vector<ElementType> correction{};
+      size_t number_refinement_steps{0}; // in the last call to solve
+      ElementType residual_ratio{0.}; // of the last call to solve
+      size_t number_pivot_tolerance_increases{0};
+      // FGMRES refinement: orthonormal Krylov basis (max steps + 1 vectors), preconditioned basis (max steps vectors), Hessenberg
+      // matrix (column-major, max steps + 1 rows) reduced by Givens rotations, and rhs of the least-squares problem
+      std::vector<Vector<ElementType>> krylov_basis{};
+      std::vector<Vector<ElementType>> preconditioned_basis{};
+      Vector<ElementType> hessenberg{};
+      Vector<ElementType> givens_cosines{};
+      Vector<ElementType> givens_sines{};
+      Vector<ElementType> least_squares_rhs{};
+      // slack elimination
+      static constexpr size_t eliminated{std::numeric_limits<size_t>::max()};
+      bool condensed{false};
+      size_t number_variables{0};
+      size_t number_constraints{0};
+      std::vector<size_t> condensed_indices{}; // index of each variable in the condensed matrix (eliminated for slacks)
+      std::vector<size_t> slack_of_constraint{}; // eliminated slack of each constraint (eliminated if none)
+      Vector<ElementType> slack_diagonal{}; // diagonal Hessian term of each slack
+      Vector<ElementType> slack_coefficient{}; // Jacobian term of the slack of each constraint
+      Vector<ElementType> condensed_rhs{};
+      Vector<ElementType> condensed_solution{};
+      // scatter map: positions of the Hessian and Jacobian nonzeros in the entries of the augmented matrix
+      std::vector<size_t> hessian_slots{};
+      std::vector<size_t> jacobian_slots{};
+      std::vector<size_t> jacobian_row_offsets{}; // position of the first nonzero of each constraint in jacobian_slots
+      // diagonal layer of the primal block and its positions in the entries of the augmented matrix
+      Vector<ElementType> primal_diagonal{};
+      size_t number_diagonal_terms{0};
+      std::vector<size_t> diagonal_slots{};
+      // low-rank term (border of the matrix)
+      Vector<ElementType> low_rank_factors{};
+      Vector<ElementType> low_rank_middle_matrix{};
+      size_t low_rank_dimension{0};
+      size_t assembled_low_rank_dimension{0}; // dimension of the border of the assembled matrix
+      bool scatter_map_recorded{false};
+      // number of consecutive calls that required a primal regularization
+      size_t number_consecutive_regularizations{0};
+      bool previous_dual_regularization{false}; // whether the last successful regularization regularized the constraints
+      size_t number_factorizations{0}; // in the current call to factorize_and_regularize_matrix
+      double cumulative_factorization_time{0.};
+      // independent diagonal blocks of the matrix, detected when its sparsity pattern changes and factorized concurrently
+      const bool independent_blocks_factorization;
+      typename SchurComplementSolver<IndexType>::BlockSolverFactory block_solver_factory{};
+      std::unique_ptr<SchurComplementSolver<IndexType>> block_solver{};
+      BlockPartition block_partition{};
+      bool use_block_solver{false};
+      const SymmetricIndefiniteLinearSolver<IndexType, ElementType>* replaced_solver{nullptr};
+
+      template <typename Jacobian>
+      [[nodiscard]] bool can_reassemble_values_only(const SymmetricMatrix<size_t, double>& hessian, const Jacobian& constraint_jacobian,
+            size_t number_variables, size_t number_constraints, const WarmstartInformation& warmstart_information) const;
+      template <typename Jacobian>
+      void reassemble_values(const SymmetricMatrix<size_t, double>& hessian, const Jacobian& constraint_jacobian,
+            size_t number_constraints);
+      [[nodiscard]] bool is_regularization_predicted() const;
+      // the border of the low-rank term contributes (dimension/2, dimension/2) to the inertia
+      [[nodiscard]] bool has_expected_inertia(DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
+            size_t size_primal_block, size_t size_dual_block) const;
+      void correct_inertia(Statistics& statistics, DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
+            size_t size_primal_block, size_t size_dual_block, WarmstartInformation& warmstart_information, size_t number_attempts);
+      // the regularization of a scaled matrix is scaled: D (A + regularization) D
+      void detect_independent_blocks(DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver);
+      void set_matrix_regularization(size_t size_primal_block, ElementType primal_regularization, ElementType dual_regularization);
+      void compute_scaling_factors();
+      void scale_matrix();
+      void unscale_matrix();
+      void set_statistics(Statistics& statistics) const;
+      void set_factorization_statistics(Statistics& statistics, const DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver) const;
+      void solve_with_refinement(SymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, const Vector<ElementType>& system_rhs,
+            Vector<ElementType>& system_solution, bool iterative_refinement);
+      void solve_and_refine(SymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, const Vector<ElementType>& system_rhs,
+            Vector<ElementType>& system_solution, bool iterative_refinement);
+      // FGMRES started from system_solution, whose residual is stored in residual. Returns the number of Krylov steps
+      size_t refine_by_fgmres(SymmetricIndefiniteLinearSolver<IndexType, ElementType>& solver, Vector<ElementType>& system_solution,
+            ElementType tolerance);
+      // solve_regularized_system() solves the system with the current regularization factors and returns whether the solution is reliable
+      template <typename RegularizedSolve>
+      void regularize_by_curvature(Statistics& statistics, size_t size_primal_block, ElementType dual_regularization_parameter,
+            const RegularizedSolve& solve_regularized_system);
+      [[nodiscard]] bool has_sufficient_curvature(size_t size_primal_block) const;
+      // residual = rhs - matrix * solution. Returns its infinity norm
+      ElementType compute_residual(const Vector<ElementType>& system_rhs, const Vector<ElementType>& system_solution);
+      // product = matrix * vector, the quasi-definite layer excluded
+      void multiply_matrix(const Vector<ElementType>& vector, Vector<ElementType>& product) const;
    };
 
-   template <typename ElementType>
-   SymmetricIndefiniteLinearSystem<ElementType>::SymmetricIndefiniteLinearSystem(const std::string& sparse_format, size_t dimension,
-         size_t number_non_zeros, bool use_regularization, const Options& options):
-         matrix(dimension, number_non_zeros, use_regularization, sparse_format),
+   template <typename IndexType, typename ElementType>
+   SymmetricIndefiniteLinearSystem<IndexType, ElementType>::SymmetricIndefiniteLinearSystem(const std::string& sparse_format, size_t dimension,
+         size_t number_non_zeros, bool use_regularization, const Options& options, size_t index_shift):
+         matrix(dimension, number_non_zeros, use_regularization, sparse_format, index_shift),
          rhs(dimension),
          solution(dimension),
          regularization_failure_threshold(ElementType(options.get_double("regularization_failure_threshold"))),
@@ -60,69 +271,481 @@ namespace uno {
          primal_regularization_decrease_factor(ElementType(options.get_double("primal_regularization_decrease_factor"))),
          primal_regularization_fast_increase_factor(ElementType(options.get_double("primal_regularization_fast_increase_factor"))),
          primal_regularization_slow_increase_factor(ElementType(options.get_double("primal_regularization_slow_increase_factor"))),
-         threshold_unsuccessful_attempts(options.get_unsigned_int("threshold_unsuccessful_attempts")) {
+         threshold_unsuccessful_attempts(options.get_unsigned_int("threshold_unsuccessful_attempts")),
+         regularization_max_factorizations(options.get_unsigned_int("regularization_max_factorizations")),
+         predictive_regularization(options.get_bool("predictive_regularization")),
+         predictive_regularization_history(options.get_unsigned_int("predictive_regularization_history")),
+         dual_regularization_always(options.get_bool("dual_regularization_always")),
+         use_regularization(use_regularization),
+         values_only_reassembly(options.get_bool("values_only_reassembly")),
+         iterative_refinement_max_steps(options.get_unsigned_int("iterative_refinement_max_steps")),
+         iterative_refinement_tolerance(ElementType(options.get_double("iterative_refinement_tolerance"))),
+         iterative_refinement_method(options.get_string("iterative_refinement_method") == "FGMRES" ? IterativeRefinementMethod::FGMRES :
+            IterativeRefinementMethod::CLASSIC),
+         pivot_tolerance_residual_ratio(ElementType(options.get_double("pivot_tolerance_residual_ratio"))),
+         curvature_threshold(ElementType(options.get_double("curvature_test_threshold"))),
+         quasi_definite(use_regularization && options.get_bool("quasi_definite_regularization")),
+         quasi_definite_primal_regularization(ElementType(options.get_double("quasi_definite_primal_regularization"))),
+         quasi_definite_dual_regularization(ElementType(options.get_double("quasi_definite_dual_regularization"))),
+         use_scaling(options.get_string("linear_system_scaling") == "ruiz"),
+         scaling_max_iterations(options.get_unsigned_int("linear_system_scaling_max_iterations")),
+         scaling_tolerance(ElementType(options.get_double("linear_system_scaling_tolerance"))),
+         scaling_factors(this->use_scaling ? dimension : 0),
+         row_norms(this->use_scaling ? dimension : 0),
+         scaled_rhs(this->use_scaling ? dimension : 0),
+         scaled_solution(this->use_scaling ? dimension : 0),
+         residual(dimension),
+         correction(dimension),
+         independent_blocks_factorization(options.get_bool("independent_blocks_factorization")) {
+      const std::string& scaling = options.get_string("linear_system_scaling");
+      if (scaling != "none" && scaling != "ruiz") {
+         throw std::invalid_argument("The linear system scaling " + scaling + " is unknown");
+      }
+      if (this->quasi_definite && (this->quasi_definite_primal_regularization <= ElementType(0) ||
+            this->quasi_definite_dual_regularization <= ElementType(0))) {
+         throw std::invalid_argument("The quasi-definite regularization requires positive primal and dual regularizations");
+      }
+      const std::string& refinement_method = options.get_string("iterative_refinement_method");
+      if (refinement_method != "classic" && refinement_method != "FGMRES") {
+         throw std::invalid_argument("The iterative refinement method " + refinement_method + " is unknown");
+      }
+      if (this->iterative_refinement_method == IterativeRefinementMethod::FGMRES) {
+         const size_t max_steps = this->iterative_refinement_max_steps;
+         this->krylov_basis.assign(max_steps + 1, Vector<ElementType>(dimension));
+         this->preconditioned_basis.assign(max_steps, Vector<ElementType>(dimension));
+         this->hessenberg = Vector<ElementType>((max_steps + 1) * max_steps);
+         this->givens_cosines = Vector<ElementType>(max_steps);
+         this->givens_sines = Vector<ElementType>(max_steps);
+         this->least_squares_rhs = Vector<ElementType>(max_steps + 1);
+      }
+      if (this->independent_blocks_factorization) {
+         this->block_solver_factory = [options](size_t block_dimension, size_t block_number_nonzeros) {
+            return SymmetricIndefiniteLinearSolverFactory::create<IndexType>(block_dimension, block_number_nonzeros, options);
+         };
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::set_block_solver_factory(
+         typename SchurComplementSolver<IndexType>::BlockSolverFactory block_solver_factory) {
+      this->block_solver_factory = std::move(block_solver_factory);
+      this->block_solver = nullptr;
+      this->use_block_solver = false;
+   }
+
+   template <typename IndexType, typename ElementType>
+   DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& SymmetricIndefiniteLinearSystem<IndexType, ElementType>::active_solver(
+         DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver) const {
+      const SymmetricIndefiniteLinearSolver<IndexType, ElementType>* solver = &linear_solver;
+      if (this->use_block_solver && solver == this->replaced_solver) {
+         return *this->block_solver;
+      }
+      return linear_solver;
    }
 
-   template <typename ElementType>
-   void SymmetricIndefiniteLinearSystem<ElementType>::assemble_matrix(const SymmetricMatrix<size_t, double>& hessian,
-         const RectangularMatrix<double>& constraint_jacobian, size_t number_variables, size_t number_constraints) {
-      this->matrix.set_dimension(number_variables + number_constraints);
+   template <typename IndexType, typename ElementType>
+   SymmetricIndefiniteLinearSolver<IndexType, ElementType>& SymmetricIndefiniteLinearSystem<IndexType, ElementType>::active_solver(
+         SymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver) const {
+      if (this->use_block_solver && &linear_solver == this->replaced_solver) {
+         return *this->block_solver;
+      }
+      return linear_solver;
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename Jacobian>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::assemble_matrix(const SymmetricMatrix<size_t, double>& hessian,
+         const Jacobian& constraint_jacobian, size_t number_variables, size_t number_constraints,
+         const WarmstartInformation& warmstart_information) {
+      const ScopedTimer assembly_timer("KKT assembly");
+      // all the entries are overwritten
+      this->is_matrix_scaled = false;
+      this->condensed = false;
+      this->number_variables = number_variables;
+      this->number_constraints = number_constraints;
+      // if the sparsity pattern is frozen, only overwrite the values (the indices are untouched)
+      if (this->can_reassemble_values_only(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information)) {
+         this->reassemble_values(hessian, constraint_jacobian, number_constraints);
+         return;
+      }
+
+      this->assembled_low_rank_dimension = this->low_rank_dimension;
+      this->matrix.set_dimension(number_variables + number_constraints + this->low_rank_dimension);
       this->matrix.reset();
+      this->has_quasi_definite_layer = false;
+      this->hessian_slots.clear();
+      this->jacobian_slots.clear();
+      this->jacobian_row_offsets.clear();
+      this->diagonal_slots.clear();
       // copy the Lagrangian Hessian in the top left block
       //size_t current_column = 0;
-      for (const auto [row_index, column_index, element]: hessian) {
+      hessian.for_each([&](size_t row_index, size_t column_index, double element) {
          // finalize all empty columns
          /*for (size_t column: Range(current_column, column_index)) {
             this->matrix.finalize_column(column);
             current_column++;
          }*/
-         this->matrix.insert(element, row_index, column_index);
+         // the entries are stored contiguously in the insertion order: record the slot of the term
+         this->hessian_slots.emplace_back(this->matrix.number_nonzeros());
+         this->matrix.insert(static_cast<ElementType>(element), static_cast<IndexType>(row_index), static_cast<IndexType>(column_index));
+      });
+      // diagonal layer
+      for (size_t variable_index: Range(this->number_diagonal_terms)) {
+         this->diagonal_slots.emplace_back(this->matrix.number_nonzeros());
+         this->matrix.insert(this->primal_diagonal[variable_index], static_cast<IndexType>(variable_index), static_cast<IndexType>(variable_index));
       }
 
       // Jacobian of general constraints
       for (size_t column_index: Range(number_constraints)) {
+         this->jacobian_row_offsets.emplace_back(this->jacobian_slots.size());
          for (const auto [row_index, derivative]: constraint_jacobian[column_index]) {
-            this->matrix.insert(derivative, row_index, number_variables + column_index);
+            this->jacobian_slots.emplace_back(this->matrix.number_nonzeros());
+            this->matrix.insert(static_cast<ElementType>(derivative), static_cast<IndexType>(row_index),
+                  static_cast<IndexType>(number_variables + column_index));
          }
-         this->matrix.finalize_column(column_index);
+         this->matrix.finalize_column(static_cast<IndexType>(column_index));
       }
+      this->jacobian_row_offsets.emplace_back(this->jacobian_slots.size());
+
+      // border of the low-rank term: columns of W and upper triangle of M
+      const size_t border_offset = number_variables + number_constraints;
+      for (size_t column_index: Range(this->low_rank_dimension)) {
+         for (size_t variable_index: Range(number_variables)) {
+            this->matrix.insert(this->low_rank_factors[variable_index + column_index * number_variables], static_cast<IndexType>(variable_index),
+                  static_cast<IndexType>(border_offset + column_index));
+         }
+         for (size_t row_index: Range(column_index + 1)) {
+            this->matrix.insert(this->low_rank_middle_matrix[row_index + column_index * this->low_rank_dimension],
+                  static_cast<IndexType>(border_offset + row_index), static_cast<IndexType>(border_offset + column_index));
+         }
+         this->matrix.finalize_column(static_cast<IndexType>(number_constraints + column_index));
+      }
+      this->scatter_map_recorded = true;
    }
 
-   template <typename ElementType>
-   void SymmetricIndefiniteLinearSystem<ElementType>::factorize_matrix(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver,
+   template <typename IndexType, typename ElementType>
+   template <typename Jacobian>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::assemble_condensed_matrix(const SymmetricMatrix<size_t, double>& hessian,
+         const Jacobian& constraint_jacobian, size_t number_variables, size_t number_constraints, const SparseVector<size_t>& slacks) {
+      const ScopedTimer assembly_timer("KKT assembly");
+      if (0 < this->low_rank_dimension) {
+         throw std::runtime_error("The slack variables cannot be eliminated from a matrix with a low-rank term");
+      }
+      this->is_matrix_scaled = false;
+      this->condensed = true;
+      this->assembled_low_rank_dimension = 0;
+      this->number_variables = number_variables;
+      this->number_constraints = number_constraints;
+      // the condensed matrix is reassembled from scratch
+      this->scatter_map_recorded = false;
+
+      // number the remaining variables
+      this->condensed_indices.assign(number_variables, 0);
+      this->slack_of_constraint.assign(number_constraints, SymmetricIndefiniteLinearSystem::eliminated);
+      for (const auto [constraint_index, slack_index]: slacks) {
+         this->condensed_indices[slack_index] = SymmetricIndefiniteLinearSystem::eliminated;
+         this->slack_of_constraint[constraint_index] = slack_index;
+      }
+      size_t number_condensed_variables = 0;
+      for (size_t variable_index: Range(number_variables)) {
+         if (this->condensed_indices[variable_index] != SymmetricIndefiniteLinearSystem::eliminated) {
+            this->condensed_indices[variable_index] = number_condensed_variables;
+            number_condensed_variables++;
+         }
+      }
+      this->slack_diagonal.resize(number_variables);
+      this->slack_coefficient.resize(number_constraints);
+      this->condensed_rhs.resize(number_condensed_variables + number_constraints);
+      this->condensed_solution.resize(number_condensed_variables + number_constraints);
+      for (const auto [_, slack_index]: slacks) {
+         this->slack_diagonal[slack_index] = ElementType(0);
+      }
+
+      this->matrix.set_dimension(number_condensed_variables + number_constraints);
+      this->matrix.reset();
+      this->has_quasi_definite_layer = false;
+      // Hessian: the slack terms are diagonal
+      hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+         const size_t condensed_row = this->condensed_indices[row_index];
+         const size_t condensed_column = this->condensed_indices[column_index];
+         if (condensed_row == SymmetricIndefiniteLinearSystem::eliminated || condensed_column == SymmetricIndefiniteLinearSystem::eliminated) {
+            if (row_index != column_index) {
+               throw std::runtime_error("The slack variables cannot be eliminated: their Hessian block is not diagonal");
+            }
+            this->slack_diagonal[row_index] += static_cast<ElementType>(element);
+         }
+         else {
+            this->matrix.insert(static_cast<ElementType>(element), static_cast<IndexType>(condensed_row), static_cast<IndexType>(condensed_column));
+         }
+      });
+      // diagonal layer
+      for (size_t variable_index: Range(this->number_diagonal_terms)) {
+         const size_t condensed_index = this->condensed_indices[variable_index];
+         if (condensed_index == SymmetricIndefiniteLinearSystem::eliminated) {
+            this->slack_diagonal[variable_index] += this->primal_diagonal[variable_index];
+         }
+         else {
+            this->matrix.insert(this->primal_diagonal[variable_index], static_cast<IndexType>(condensed_index),
+                  static_cast<IndexType>(condensed_index));
+         }
+      }
+
+      // Jacobian of general constraints and diagonal terms -a^2/D of the eliminated slacks
+      for (size_t constraint_index: Range(number_constraints)) {
+         const size_t slack_index = this->slack_of_constraint[constraint_index];
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            const size_t condensed_index = this->condensed_indices[variable_index];
+            if (condensed_index != SymmetricIndefiniteLinearSystem::eliminated) {
+               this->matrix.insert(static_cast<ElementType>(derivative), static_cast<IndexType>(condensed_index),
+                     static_cast<IndexType>(number_condensed_variables + constraint_index));
+            }
+            else if (variable_index == slack_index) {
+               this->slack_coefficient[constraint_index] = static_cast<ElementType>(derivative);
+            }
+            else {
+               throw std::runtime_error("The slack variables cannot be eliminated: a slack appears in several constraints");
+            }
+         }
+         if (slack_index != SymmetricIndefiniteLinearSystem::eliminated) {
+            const ElementType diagonal = this->slack_diagonal[slack_index];
+            if (diagonal <= ElementType(0)) {
+               throw std::runtime_error("The slack variables cannot be eliminated: their diagonal term is not positive");
+            }
+            const ElementType coefficient = this->slack_coefficient[constraint_index];
+            this->matrix.insert(-coefficient * coefficient / diagonal, static_cast<IndexType>(number_condensed_variables + constraint_index),
+                  static_cast<IndexType>(number_condensed_variables + constraint_index));
+         }
+         this->matrix.finalize_column(static_cast<IndexType>(constraint_index));
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename Jacobian>
+   bool SymmetricIndefiniteLinearSystem<IndexType, ElementType>::can_reassemble_values_only(const SymmetricMatrix<size_t, double>& hessian,
+         const Jacobian& constraint_jacobian, size_t number_variables, size_t number_constraints,
+         const WarmstartInformation& warmstart_information) const {
+      return this->values_only_reassembly && this->scatter_map_recorded &&
+         !warmstart_information.hessian_sparsity_changed && !warmstart_information.jacobian_sparsity_changed &&
+         this->low_rank_dimension == 0 && this->matrix.dimension() == number_variables + number_constraints &&
+         hessian.number_nonzeros() == this->hessian_slots.size() &&
+         constraint_jacobian.number_nonzeros() == this->jacobian_slots.size() &&
+         this->jacobian_row_offsets.size() == number_constraints + 1 &&
+         this->number_diagonal_terms == this->diagonal_slots.size();
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename Jacobian>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::reassemble_values(const SymmetricMatrix<size_t, double>& hessian,
+         const Jacobian& constraint_jacobian, size_t number_constraints) {
+      // discard the regularization of the previous factorization
+      if (this->use_regularization) {
+         this->matrix.set_regularization([](size_t /*index*/) {
+            return ElementType(0);
+         });
+         this->has_quasi_definite_layer = false;
+      }
+      // each slot of the augmented matrix has a single writer: the blocks are distributed among the threads without synchronization
+      [[maybe_unused]] const bool parallel = (parallel_assembly_nonzeros_threshold <= this->matrix.number_nonzeros());
+      ElementType* entries = this->matrix.data_pointer();
+      // the Hessian storage is traversed by for_each in the order of its entries
+      const double* hessian_entries = hessian.data_pointer();
+      const size_t number_hessian_nonzeros = this->hessian_slots.size();
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) if(parallel)
+#endif
+      for (size_t hessian_index = 0; hessian_index < number_hessian_nonzeros; hessian_index++) {
+         entries[this->hessian_slots[hessian_index]] = static_cast<ElementType>(hessian_entries[hessian_index]);
+      }
+      // the rows of the Jacobian start at the recorded offsets of the scatter map
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) if(parallel)
+#endif
+      for (size_t constraint_index = 0; constraint_index < number_constraints; constraint_index++) {
+         size_t jacobian_index = this->jacobian_row_offsets[constraint_index];
+         for (const auto [_, derivative]: constraint_jacobian[constraint_index]) {
+            entries[this->jacobian_slots[jacobian_index]] = static_cast<ElementType>(derivative);
+            jacobian_index++;
+         }
+      }
+      for (size_t variable_index: Range(this->number_diagonal_terms)) {
+         entries[this->diagonal_slots[variable_index]] = this->primal_diagonal[variable_index];
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::set_primal_diagonal(const Vector<double>& diagonal, size_t number_variables) {
+      if (this->primal_diagonal.size() < number_variables) {
+         this->primal_diagonal.resize(number_variables);
+      }
+      for (size_t variable_index: Range(number_variables)) {
+         this->primal_diagonal[variable_index] = static_cast<ElementType>(diagonal[variable_index]);
+      }
+      this->number_diagonal_terms = number_variables;
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::set_low_rank_term(const Vector<double>& factors,
+         const Vector<double>& middle_matrix, size_t number_variables, size_t dimension) {
+      if (this->low_rank_factors.size() < number_variables * dimension) {
+         this->low_rank_factors.resize(number_variables * dimension);
+      }
+      if (this->low_rank_middle_matrix.size() < dimension * dimension) {
+         this->low_rank_middle_matrix.resize(dimension * dimension);
+      }
+      for (size_t index: Range(number_variables * dimension)) {
+         this->low_rank_factors[index] = static_cast<ElementType>(factors[index]);
+      }
+      for (size_t index: Range(dimension * dimension)) {
+         this->low_rank_middle_matrix[index] = static_cast<ElementType>(middle_matrix[index]);
+      }
+      this->low_rank_dimension = dimension;
+   }
+
+   template <typename IndexType, typename ElementType>
+   bool SymmetricIndefiniteLinearSystem<IndexType, ElementType>::can_update_primal_diagonal(size_t number_variables,
+         size_t number_constraints) const {
+      return this->scatter_map_recorded && !this->condensed && this->number_variables == number_variables &&
+         this->number_constraints == number_constraints && this->number_diagonal_terms == this->diagonal_slots.size() &&
+         this->assembled_low_rank_dimension == this->low_rank_dimension;
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::update_primal_diagonal() {
+      assert(this->can_update_primal_diagonal(this->number_variables, this->number_constraints) && "The diagonal layer cannot be updated");
+      // the other entries are kept
+      this->unscale_matrix();
+      // discard the regularization of the previous factorization
+      if (this->use_regularization) {
+         this->matrix.set_regularization([](size_t /*index*/) {
+            return ElementType(0);
+         });
+      }
+      ElementType* entries = this->matrix.data_pointer();
+      for (size_t variable_index: Range(this->number_diagonal_terms)) {
+         entries[this->diagonal_slots[variable_index]] = this->primal_diagonal[variable_index];
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::reset_matrix(size_t dimension) {
+      this->matrix.set_dimension(dimension);
+      this->matrix.reset();
+      this->has_quasi_definite_layer = false;
+      this->scatter_map_recorded = false;
+      this->is_matrix_scaled = false;
+   }
+
+   template <typename IndexType, typename ElementType>
+   size_t SymmetricIndefiniteLinearSystem<IndexType, ElementType>::memory_size() const {
+      size_t size = this->matrix.memory_size();
+      for (const Vector<ElementType>* vector: {&this->rhs, &this->solution, &this->scaling_factors, &this->row_norms, &this->scaled_rhs,
+            &this->scaled_solution, &this->residual, &this->correction, &this->slack_diagonal, &this->slack_coefficient, &this->condensed_rhs,
+            &this->condensed_solution, &this->primal_diagonal, &this->scaled_multiple_rhs, &this->low_rank_factors,
+            &this->low_rank_middle_matrix}) {
+         size += vector->memory_size();
+      }
+      for (const Vector<ElementType>* vector: {&this->hessenberg, &this->givens_cosines, &this->givens_sines, &this->least_squares_rhs}) {
+         size += vector->memory_size();
+      }
+      for (const std::vector<Vector<ElementType>>* basis: {&this->krylov_basis, &this->preconditioned_basis}) {
+         for (const Vector<ElementType>& vector: *basis) {
+            size += vector.memory_size();
+         }
+      }
+      for (const std::vector<size_t>* indices: {&this->condensed_indices, &this->slack_of_constraint, &this->hessian_slots,
+            &this->jacobian_slots, &this->jacobian_row_offsets, &this->diagonal_slots}) {
+         size += indices->capacity() * sizeof(size_t);
+      }
+      size += this->block_partition.block_of_index.capacity() * sizeof(size_t);
+      if (this->block_solver != nullptr) {
+         size += this->block_solver->memory_size();
+      }
+      return size;
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::save_regularization_state(CheckpointWriter& writer) const {
+      writer.write(static_cast<double>(this->primal_regularization));
+      writer.write(static_cast<double>(this->dual_regularization));
+      writer.write(static_cast<double>(this->previous_primal_regularization));
+      writer.write(this->number_consecutive_regularizations);
+      writer.write(this->previous_dual_regularization);
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::load_regularization_state(CheckpointReader& reader) {
+      this->primal_regularization = static_cast<ElementType>(reader.read_double());
+      this->dual_regularization = static_cast<ElementType>(reader.read_double());
+      this->previous_primal_regularization = static_cast<ElementType>(reader.read_double());
+      this->number_consecutive_regularizations = reader.read_size_t();
+      this->previous_dual_regularization = reader.read_bool();
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::factorize_matrix(DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
          WarmstartInformation& warmstart_information) {
+      if (this->use_scaling && !this->is_matrix_scaled) {
+         this->compute_scaling_factors();
+         this->scale_matrix();
+      }
+      if (this->quasi_definite) {
+         this->active_solver(linear_solver).set_static_pivoting(this->has_quasi_definite_layer);
+      }
       if (warmstart_information.hessian_sparsity_changed || warmstart_information.jacobian_sparsity_changed) {
+         if (this->independent_blocks_factorization) {
+            this->detect_independent_blocks(linear_solver);
+         }
          DEBUG << "Performing symbolic analysis of the indefinite system\n";
-         linear_solver.do_symbolic_analysis(this->matrix);
+         const ScopedTimer symbolic_analysis_timer("symbolic analysis");
+         this->active_solver(linear_solver).do_symbolic_analysis(this->matrix);
          warmstart_information.hessian_sparsity_changed = warmstart_information.jacobian_sparsity_changed = false;
       }
       DEBUG << "Performing numerical factorization of the indefinite system\n";
-      linear_solver.do_numerical_factorization(this->matrix);
+      const Timer timer{};
+      const ScopedTimer factorization_timer("numerical factorization");
+      this->active_solver(linear_solver).do_numerical_factorization(this->matrix);
+      this->cumulative_factorization_time += timer.get_duration();
+      this->number_factorizations++;
+   }
+
+   // connected components of the graph of the matrix. If there are several, linear_solver is replaced with a Schur complement
+   // solver without linking indices: each block is factorized by its own solver instance and the inertias are summed
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::detect_independent_blocks(
+         DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver) {
+      this->block_partition = BlockPartition::detect(this->matrix, 0.);
+      this->use_block_solver = (1 < this->block_partition.number_blocks);
+      this->replaced_solver = &linear_solver;
+      DEBUG << "The augmented matrix has " << this->block_partition.number_blocks << " independent blocks\n";
+      if (this->use_block_solver) {
+         if (this->block_solver == nullptr) {
+            this->block_solver = std::make_unique<SchurComplementSolver<IndexType>>(this->rhs.size(), this->block_solver_factory, 0.);
+         }
+         this->block_solver->set_block_partition(this->block_partition.block_of_index);
+      }
    }
 
    // the matrix has been factorized prior to calling this function
-   template <typename ElementType>
-   void SymmetricIndefiniteLinearSystem<ElementType>::regularize_matrix(Statistics& statistics,
-         DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver, size_t size_primal_block, size_t size_dual_block,
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::regularize_matrix(Statistics& statistics,
+         DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, size_t size_primal_block, size_t size_dual_block,
          ElementType dual_regularization_parameter, WarmstartInformation& warmstart_information) {
       DEBUG2 << "Original matrix\n" << this->matrix << '\n';
       this->primal_regularization = ElementType(0.);
-      this->dual_regularization = ElementType(0.);
+      this->dual_regularization = this->dual_regularization_always ? this->dual_regularization_fraction * dual_regularization_parameter :
+            ElementType(0.);
       size_t number_attempts = 1;
       DEBUG << "Number of attempts: " << number_attempts << "\n\n";
 
-      auto [number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues] = linear_solver.get_inertia();
-      DEBUG << "Expected inertia  (" << size_primal_block << ", " << size_dual_block << ", 0)\n";
-      DEBUG << "Estimated inertia (" << number_pos_eigenvalues << ", " << number_neg_eigenvalues << ", " << number_zero_eigenvalues << ")\n";
-
-      if (number_pos_eigenvalues == size_primal_block && number_neg_eigenvalues == size_dual_block && number_zero_eigenvalues == 0) {
+      if (this->has_expected_inertia(linear_solver, size_primal_block, size_dual_block)) {
          DEBUG << "The inertia is correct\n";
-         statistics.set("regulariz", this->primal_regularization);
+         this->number_consecutive_regularizations = 0;
+         this->set_statistics(statistics);
          return;
       }
 
       // set the constraint regularization coefficient
-      if (linear_solver.matrix_is_singular()) {
+      if (this->active_solver(linear_solver).matrix_is_singular()) {
          DEBUG << "Matrix is singular\n";
          this->dual_regularization = this->dual_regularization_fraction * dual_regularization_parameter;
       }
@@ -134,30 +757,90 @@ namespace uno {
          this->primal_regularization = std::max(this->primal_regularization_lb,
                this->previous_primal_regularization / this->primal_regularization_decrease_factor);
       }
+      this->correct_inertia(statistics, linear_solver, size_primal_block, size_dual_block, warmstart_information, number_attempts);
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::factorize_and_regularize_matrix(Statistics& statistics,
+         DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, size_t size_primal_block, size_t size_dual_block,
+         ElementType dual_regularization_parameter, WarmstartInformation& warmstart_information) {
+      this->number_factorizations = 0;
+      if (this->is_regularization_predicted()) {
+         // start from the last successful regularization (as IPOPT does when the previous iterations were regularized)
+         DEBUG << "Predicting the regularization from the " << this->number_consecutive_regularizations << " previous iterations\n";
+         this->primal_regularization = std::max(this->primal_regularization_lb,
+               this->previous_primal_regularization / this->primal_regularization_decrease_factor);
+         this->dual_regularization = (this->dual_regularization_always || this->previous_dual_regularization) ?
+               this->dual_regularization_fraction * dual_regularization_parameter : ElementType(0.);
+         this->correct_inertia(statistics, linear_solver, size_primal_block, size_dual_block, warmstart_information, 0);
+      }
+      else {
+         ElementType initial_dual_regularization = ElementType(0.);
+         if ((this->dual_regularization_always || this->quasi_definite) && this->use_regularization) {
+            // similar to IPOPT's perturb_always_cd: the constraints are regularized from the first factorization
+            if (this->dual_regularization_always) {
+               initial_dual_regularization = this->dual_regularization_fraction * dual_regularization_parameter;
+            }
+            // in quasi-definite mode, the layer is added to the first factorization
+            this->set_matrix_regularization(size_primal_block, ElementType(0.), initial_dual_regularization);
+         }
+         DEBUG << "Testing factorization with regularization factors (0, " << initial_dual_regularization << ")\n";
+         this->factorize_matrix(linear_solver, warmstart_information);
+         this->regularize_matrix(statistics, linear_solver, size_primal_block, size_dual_block, dual_regularization_parameter,
+               warmstart_information);
+      }
+      this->set_factorization_statistics(statistics, linear_solver);
+   }
 
+   template <typename IndexType, typename ElementType>
+   bool SymmetricIndefiniteLinearSystem<IndexType, ElementType>::is_regularization_predicted() const {
+      // once the predicted regularization has decreased to its lower bound, the unregularized matrix is tried again
+      return this->predictive_regularization && this->use_regularization &&
+         0 < this->predictive_regularization_history && this->predictive_regularization_history <= this->number_consecutive_regularizations &&
+         this->primal_regularization_lb < this->previous_primal_regularization / this->primal_regularization_decrease_factor;
+   }
+
+   template <typename IndexType, typename ElementType>
+   bool SymmetricIndefiniteLinearSystem<IndexType, ElementType>::has_expected_inertia(
+         DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, size_t size_primal_block,
+         size_t size_dual_block) const {
+      const size_t size_border_block = this->assembled_low_rank_dimension / 2;
+      auto [number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues] = this->active_solver(linear_solver).get_inertia();
+      DEBUG << "Expected inertia  (" << size_primal_block + size_border_block << ", " << size_dual_block + size_border_block << ", 0)\n";
+      DEBUG << "Estimated inertia (" << number_pos_eigenvalues << ", " << number_neg_eigenvalues << ", " << number_zero_eigenvalues << ")\n";
+      return number_pos_eigenvalues == size_primal_block + size_border_block && number_neg_eigenvalues == size_dual_block + size_border_block &&
+         number_zero_eigenvalues == 0;
+   }
+
+   // increase the regularization until the inertia is correct
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::correct_inertia(Statistics& statistics,
+         DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, size_t size_primal_block, size_t size_dual_block,
+         WarmstartInformation& warmstart_information, size_t number_attempts) {
+      const Timeline::Event inertia_correction_event(Timeline::current(), "inertia correction");
       // regularize the augmented matrix
-      this->matrix.set_regularization([=](size_t row_index) {
-         return (row_index < size_primal_block) ? this->primal_regularization : -this->dual_regularization;
-      });
+      this->set_matrix_regularization(size_primal_block, this->primal_regularization, this->dual_regularization);
 
       bool good_inertia = false;
       while (!good_inertia) {
+         Cancellation::check();
          DEBUG << "Testing factorization with regularization factors (" << this->primal_regularization << ", " << this->dual_regularization << ")\n";
          DEBUG2 << this->matrix << '\n';
          this->factorize_matrix(linear_solver, warmstart_information);
          number_attempts++;
          DEBUG << "Number of attempts: " << number_attempts << "\n";
 
-         std::tie(number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues) = linear_solver.get_inertia();
-         DEBUG << "Expected inertia  (" << size_primal_block << ", " << size_dual_block << ", 0)\n";
-         DEBUG << "Estimated inertia (" << number_pos_eigenvalues << ", " << number_neg_eigenvalues << ", " << number_zero_eigenvalues << ")\n";
-
-         if (number_pos_eigenvalues == size_primal_block && number_neg_eigenvalues == size_dual_block && number_zero_eigenvalues == 0) {
+         if (this->has_expected_inertia(linear_solver, size_primal_block, size_dual_block)) {
             good_inertia = true;
             DEBUG << "The inertia is correct\n";
             this->previous_primal_regularization = this->primal_regularization;
+            this->previous_dual_regularization = (0. < this->dual_regularization);
          }
          else {
+            // bounded number of factorizations: the inertia correction is abandoned
+            if (0 < this->regularization_max_factorizations && this->regularization_max_factorizations <= number_attempts) {
+               throw UnstableRegularization();
+            }
             if (this->previous_primal_regularization == 0. || this->threshold_unsuccessful_attempts < number_attempts) {
                this->primal_regularization *= this->primal_regularization_fast_increase_factor;
             }
@@ -167,29 +850,573 @@ namespace uno {
 
             if (this->primal_regularization <= this->regularization_failure_threshold) {
                // regularize the augmented matrix
-               this->matrix.set_regularization([=](size_t row_index) {
-                  return (row_index < size_primal_block) ? this->primal_regularization : -this->dual_regularization;
-               });
+               this->set_matrix_regularization(size_primal_block, this->primal_regularization, this->dual_regularization);
             }
             else {
                throw UnstableRegularization();
             }
          }
       }
+      this->number_consecutive_regularizations++;
+      metrics::increment(Metric::REGULARIZATIONS);
+      this->set_statistics(statistics);
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::set_matrix_regularization(size_t size_primal_block,
+         ElementType primal_regularization, ElementType dual_regularization) {
+      if (this->quasi_definite) {
+         primal_regularization += this->quasi_definite_primal_regularization;
+         dual_regularization += this->quasi_definite_dual_regularization;
+         this->quasi_definite_primal_block = size_primal_block;
+         this->has_quasi_definite_layer = true;
+      }
+      // the border of the low-rank term is not regularized
+      const size_t border_offset = this->matrix.dimension() - this->assembled_low_rank_dimension;
+      this->matrix.set_regularization([=](size_t row_index) {
+         const ElementType regularization = (border_offset <= row_index) ? ElementType(0) :
+            (row_index < size_primal_block) ? primal_regularization : -dual_regularization;
+         return this->is_matrix_scaled ? this->scaling_factors[row_index] * regularization * this->scaling_factors[row_index] : regularization;
+      });
+   }
+
+   // Ruiz (2001): the rows (and columns) of D A D are divided by the square roots of their infinity norms until the norms are close to 1
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::compute_scaling_factors() {
+      const size_t dimension = this->matrix.dimension();
+      if (this->scaling_factors.size() < dimension) {
+         this->scaling_factors.resize(dimension);
+         this->row_norms.resize(dimension);
+         this->scaled_rhs.resize(dimension);
+         this->scaled_solution.resize(dimension);
+      }
+      this->scaling_factors.fill(ElementType(1));
+      for (size_t iteration: Range(this->scaling_max_iterations)) {
+         std::fill(this->row_norms.begin(), this->row_norms.begin() + static_cast<std::ptrdiff_t>(dimension), ElementType(0));
+         this->matrix.for_each([&](size_t row_index, size_t column_index, ElementType element) {
+            const ElementType scaled_element = std::abs(this->scaling_factors[row_index] * element * this->scaling_factors[column_index]);
+            this->row_norms[row_index] = std::max(this->row_norms[row_index], scaled_element);
+            this->row_norms[column_index] = std::max(this->row_norms[column_index], scaled_element);
+         });
+         ElementType largest_deviation = ElementType(0);
+         for (size_t index: Range(dimension)) {
+            // the empty rows are not scaled
+            if (ElementType(0) < this->row_norms[index]) {
+               largest_deviation = std::max(largest_deviation, std::abs(ElementType(1) - this->row_norms[index]));
+            }
+         }
+         DEBUG2 << "Ruiz iteration " << iteration << ": largest deviation of the row norms " << largest_deviation << '\n';
+         if (largest_deviation <= this->scaling_tolerance) {
+            break;
+         }
+         for (size_t index: Range(dimension)) {
+            if (ElementType(0) < this->row_norms[index]) {
+               this->scaling_factors[index] /= std::sqrt(this->row_norms[index]);
+            }
+         }
+      }
+   }
+
+   // the entries are traversed in storage order
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::scale_matrix() {
+      ElementType* entries = this->matrix.data_pointer();
+      size_t nonzero_index = 0;
+      this->matrix.for_each([&](size_t row_index, size_t column_index, ElementType /*element*/) {
+         entries[nonzero_index] *= this->scaling_factors[row_index] * this->scaling_factors[column_index];
+         nonzero_index++;
+      });
+      this->is_matrix_scaled = true;
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::unscale_matrix() {
+      if (this->is_matrix_scaled) {
+         ElementType* entries = this->matrix.data_pointer();
+         size_t nonzero_index = 0;
+         this->matrix.for_each([&](size_t row_index, size_t column_index, ElementType /*element*/) {
+            entries[nonzero_index] /= this->scaling_factors[row_index] * this->scaling_factors[column_index];
+            nonzero_index++;
+         });
+         this->is_matrix_scaled = false;
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::solve_and_regularize_by_curvature(Statistics& statistics,
+         SymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, size_t size_primal_block, size_t size_dual_block,
+         ElementType dual_regularization_parameter) {
+      DEBUG << "Expected primal and dual blocks (" << size_primal_block << ", " << size_dual_block << ")\n";
+      this->regularize_by_curvature(statistics, size_primal_block, dual_regularization_parameter, [&]() {
+         if (this->use_regularization) {
+            const size_t border_offset = this->matrix.dimension() - this->assembled_low_rank_dimension;
+            this->matrix.set_regularization([=](size_t row_index) {
+               return (border_offset <= row_index) ? ElementType(0) :
+                  (row_index < size_primal_block) ? this->primal_regularization : -this->dual_regularization;
+            });
+         }
+         this->solve(linear_solver, false);
+         this->number_factorizations++; // number of solves
+         // a solve that did not converge (e.g. singular matrix) is also regularized
+         return linear_solver.has_converged();
+      });
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::factorize_and_regularize_by_curvature(Statistics& statistics,
+         DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver, size_t size_primal_block, size_t size_dual_block,
+         ElementType dual_regularization_parameter, WarmstartInformation& warmstart_information) {
+      DEBUG << "Expected primal and dual blocks (" << size_primal_block << ", " << size_dual_block << ")\n";
+      this->regularize_by_curvature(statistics, size_primal_block, dual_regularization_parameter, [&]() {
+         if (this->use_regularization) {
+            // the scaling factors of the matrix are computed by the first factorization
+            if (this->use_scaling && !this->is_matrix_scaled) {
+               this->compute_scaling_factors();
+               this->scale_matrix();
+            }
+            this->set_matrix_regularization(size_primal_block, this->primal_regularization, this->dual_regularization);
+         }
+         this->factorize_matrix(linear_solver, warmstart_information);
+         // a singular matrix is regularized: the constraints are regularized from the next factorization
+         if (this->use_regularization && this->active_solver(linear_solver).matrix_is_singular()) {
+            DEBUG << "Matrix is singular\n";
+            this->dual_regularization = this->dual_regularization_fraction * dual_regularization_parameter;
+            return false;
+         }
+         this->solve(linear_solver);
+         return true;
+      });
+      this->set_factorization_statistics(statistics, linear_solver);
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename RegularizedSolve>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::regularize_by_curvature(Statistics& statistics, size_t size_primal_block,
+         ElementType dual_regularization_parameter, const RegularizedSolve& solve_regularized_system) {
+      const Timeline::Event curvature_test_event(Timeline::current(), "curvature test");
+      // the unregularized system is tried first, unless the previous iterations needed a regularization
+      const bool predicted = this->is_regularization_predicted();
+      this->primal_regularization = predicted ? std::max(this->primal_regularization_lb,
+            this->previous_primal_regularization / this->primal_regularization_decrease_factor) : ElementType(0.);
+      this->dual_regularization = (this->dual_regularization_always || (predicted && this->previous_dual_regularization)) ?
+            this->dual_regularization_fraction * dual_regularization_parameter : ElementType(0.);
+      this->number_factorizations = 0;
+      while (true) {
+         Cancellation::check();
+         DEBUG << "Testing curvature with regularization factors (" << this->primal_regularization << ", " << this->dual_regularization << ")\n";
+         const bool reliable_solution = solve_regularized_system();
+         if (!this->use_regularization || (reliable_solution && this->has_sufficient_curvature(size_primal_block))) {
+            DEBUG << "The curvature is sufficient\n";
+            break;
+         }
+         if (0 < this->regularization_max_factorizations && this->regularization_max_factorizations <= this->number_factorizations) {
+            throw UnstableRegularization();
+         }
+         // increase the regularization
+         if (this->primal_regularization == 0.) {
+            this->primal_regularization = (this->previous_primal_regularization == 0.) ? this->primal_regularization_initial_factor :
+                  std::max(this->primal_regularization_lb, this->previous_primal_regularization / this->primal_regularization_decrease_factor);
+         }
+         else if (this->previous_primal_regularization == 0. || this->threshold_unsuccessful_attempts < this->number_factorizations) {
+            this->primal_regularization *= this->primal_regularization_fast_increase_factor;
+         }
+         else {
+            this->primal_regularization *= this->primal_regularization_slow_increase_factor;
+         }
+         if (this->regularization_failure_threshold < this->primal_regularization) {
+            throw UnstableRegularization();
+         }
+      }
+      this->previous_primal_regularization = this->primal_regularization;
+      this->previous_dual_regularization = (0. < this->dual_regularization);
+      this->number_consecutive_regularizations = (0. < this->primal_regularization) ? this->number_consecutive_regularizations + 1 : 0;
+      if (0. < this->primal_regularization) {
+         metrics::increment(Metric::REGULARIZATIONS);
+      }
+      this->set_statistics(statistics);
+   }
+
+   // curvature test on the primal block of the (possibly condensed) matrix, regularization included. With a low-rank term, the border
+   // components u = -M^{-1} W^T d of the solution give d^T (H - W M^{-1} W^T) d = d^T H d + d^T W u
+   template <typename IndexType, typename ElementType>
+   bool SymmetricIndefiniteLinearSystem<IndexType, ElementType>::has_sufficient_curvature(size_t size_primal_block) const {
+      const Vector<ElementType>& system_solution = this->condensed ? this->condensed_solution : this->solution;
+      const size_t border_offset = this->matrix.dimension() - this->assembled_low_rank_dimension;
+      ElementType curvature = ElementType(0);
+      this->matrix.for_each([&](size_t row_index, size_t column_index, ElementType element) {
+         const size_t primal_index = std::min(row_index, column_index);
+         const size_t other_index = std::max(row_index, column_index);
+         if (primal_index < size_primal_block && (other_index < size_primal_block || border_offset <= other_index)) {
+            // the curvature of the unscaled matrix: (D A D)_ij / (D_i D_j) = A_ij
+            const ElementType unscaled_element = this->is_matrix_scaled ?
+               element / (this->scaling_factors[row_index] * this->scaling_factors[column_index]) : element;
+            const ElementType term = unscaled_element * system_solution[row_index] * system_solution[column_index];
+            curvature += (row_index == column_index || border_offset <= other_index) ? term : ElementType(2) * term;
+         }
+      });
+      ElementType squared_norm = ElementType(0);
+      for (size_t index: Range(size_primal_block)) {
+         squared_norm += system_solution[index] * system_solution[index];
+      }
+      DEBUG << "Curvature " << curvature << ", threshold " << this->curvature_threshold * squared_norm << '\n';
+      return this->curvature_threshold * squared_norm <= curvature;
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::set_statistics(Statistics& statistics) const {
       statistics.set("regulariz", this->primal_regularization);
+      statistics.set("factoriz", this->number_factorizations);
+      statistics.set("fact time", this->cumulative_factorization_time);
+   }
+
+   // the fill of the last factorization and the cumulated delayed pivots (hidden columns by default)
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::set_factorization_statistics(Statistics& statistics,
+         const DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver) const {
+      const bool is_replaced = (this->use_block_solver && &linear_solver == this->replaced_solver);
+      const DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& solver = is_replaced ? *this->block_solver : linear_solver;
+      const FactorizationStatistics factorization_statistics = solver.get_factorization_statistics();
+      statistics.set("fill", factorization_statistics.fill());
+      statistics.set("delayed", factorization_statistics.delayed_pivots);
    }
 
-   template <typename ElementType>
-   void SymmetricIndefiniteLinearSystem<ElementType>::solve(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver) {
-      linear_solver.solve_indefinite_system(this->matrix, this->rhs, this->solution);
+   template <typename IndexType, typename ElementType>
+   FactorizationStatistics SymmetricIndefiniteLinearSystem<IndexType, ElementType>::get_factorization_statistics(
+         const DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver) const {
+      FactorizationStatistics factorization_statistics = linear_solver.get_factorization_statistics();
+      if (this->block_solver != nullptr) {
+         factorization_statistics.accumulate(this->block_solver->get_factorization_statistics());
+      }
+      return factorization_statistics;
    }
 
-   /*
-   template <typename ElementType>
-   ElementType SymmetricIndefiniteLinearSystem<ElementType>::get_primal_regularization() const {
-      return this->primal_regularization;
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::solve(SymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
+         bool iterative_refinement) {
+      if (!this->condensed) {
+         this->solve_with_refinement(linear_solver, this->rhs, this->solution, iterative_refinement);
+         return;
+      }
+
+      // condense the rhs: the slack row D ds + a dy = r_s is substituted into the constraint row
+      const size_t number_condensed_variables = this->primal_block_dimension();
+      for (size_t variable_index: Range(this->number_variables)) {
+         const size_t condensed_index = this->condensed_indices[variable_index];
+         if (condensed_index != SymmetricIndefiniteLinearSystem::eliminated) {
+            this->condensed_rhs[condensed_index] = this->rhs[variable_index];
+         }
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         ElementType constraint_rhs = this->rhs[this->number_variables + constraint_index];
+         const size_t slack_index = this->slack_of_constraint[constraint_index];
+         if (slack_index != SymmetricIndefiniteLinearSystem::eliminated) {
+            constraint_rhs -= this->slack_coefficient[constraint_index] * this->rhs[slack_index] / this->slack_diagonal[slack_index];
+         }
+         this->condensed_rhs[number_condensed_variables + constraint_index] = constraint_rhs;
+      }
+
+      this->solve_with_refinement(linear_solver, this->condensed_rhs, this->condensed_solution, iterative_refinement);
+
+      // recover the full solution
+      for (size_t variable_index: Range(this->number_variables)) {
+         const size_t condensed_index = this->condensed_indices[variable_index];
+         if (condensed_index != SymmetricIndefiniteLinearSystem::eliminated) {
+            this->solution[variable_index] = this->condensed_solution[condensed_index];
+         }
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         const ElementType dual_component = this->condensed_solution[number_condensed_variables + constraint_index];
+         this->solution[this->number_variables + constraint_index] = dual_component;
+         const size_t slack_index = this->slack_of_constraint[constraint_index];
+         if (slack_index != SymmetricIndefiniteLinearSystem::eliminated) {
+            this->solution[slack_index] = (this->rhs[slack_index] - this->slack_coefficient[constraint_index] * dual_component) /
+               this->slack_diagonal[slack_index];
+         }
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::solve_multiple(DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
+         const Vector<ElementType>& multiple_rhs, Vector<ElementType>& multiple_result, size_t number_rhs) {
+      const size_t dimension = this->number_variables + this->number_constraints;
+      if (multiple_rhs.size() != dimension * number_rhs || multiple_result.size() != dimension * number_rhs) {
+         throw std::invalid_argument("SymmetricIndefiniteLinearSystem::solve_multiple: the blocks do not match the dimension of the system");
+      }
+      if (this->condensed) {
+         // the rhs are condensed one by one
+         for (size_t rhs_index: Range(number_rhs)) {
+            const size_t offset = rhs_index * dimension;
+            std::copy(multiple_rhs.data() + offset, multiple_rhs.data() + offset + dimension, this->rhs.data());
+            this->solve(linear_solver);
+            std::copy(this->solution.data(), this->solution.data() + dimension, multiple_result.data() + offset);
+         }
+         return;
+      }
+
+      const ScopedTimer solve_timer("linear solve");
+      DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& solver = this->active_solver(linear_solver);
+      if (!this->is_matrix_scaled) {
+         solver.solve_indefinite_systems(this->matrix, multiple_rhs, multiple_result, number_rhs);
+         return;
+      }
+      // (D A D) (D^-1 X) = D B
+      this->scaled_multiple_rhs.resize(dimension * number_rhs);
+      for (size_t rhs_index: Range(number_rhs)) {
+         for (size_t index: Range(dimension)) {
+            this->scaled_multiple_rhs[rhs_index * dimension + index] = this->scaling_factors[index] * multiple_rhs[rhs_index * dimension + index];
+         }
+      }
+      solver.solve_indefinite_systems(this->matrix, this->scaled_multiple_rhs, multiple_result, number_rhs);
+      for (size_t rhs_index: Range(number_rhs)) {
+         for (size_t index: Range(dimension)) {
+            multiple_result[rhs_index * dimension + index] *= this->scaling_factors[index];
+         }
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::solve_with_refinement(SymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
+         const Vector<ElementType>& system_rhs, Vector<ElementType>& system_solution, bool iterative_refinement) {
+      const ScopedTimer solve_timer("linear solve");
+      if (!this->is_matrix_scaled) {
+         this->solve_and_refine(linear_solver, system_rhs, system_solution, iterative_refinement);
+         return;
+      }
+      // (D A D) (D^-1 x) = D b
+      const size_t dimension = this->matrix.dimension();
+      for (size_t index: Range(dimension)) {
+         this->scaled_rhs[index] = this->scaling_factors[index] * system_rhs[index];
+      }
+      this->solve_and_refine(linear_solver, this->scaled_rhs, this->scaled_solution, iterative_refinement);
+      for (size_t index: Range(dimension)) {
+         system_solution[index] = this->scaling_factors[index] * this->scaled_solution[index];
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::solve_and_increase_accuracy(
+         DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver) {
+      this->solve(linear_solver);
+      this->number_pivot_tolerance_increases = 0;
+      while (ElementType(0) < this->pivot_tolerance_residual_ratio && this->pivot_tolerance_residual_ratio < this->residual_ratio &&
+            this->active_solver(linear_solver).increase_pivot_tolerance()) {
+         DEBUG << "The residual ratio " << this->residual_ratio << " of the refined solution is too large: the matrix is refactorized " <<
+            "with a larger pivot tolerance\n";
+         const Timer timer{};
+         {
+            const ScopedTimer factorization_timer("numerical factorization");
+            this->active_solver(linear_solver).do_numerical_factorization(this->matrix);
+         }
+         this->cumulative_factorization_time += timer.get_duration();
+         this->number_factorizations++;
+         this->number_pivot_tolerance_increases++;
+         this->solve(linear_solver);
+      }
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::solve_and_refine(SymmetricIndefiniteLinearSolver<IndexType, ElementType>& linear_solver,
+         const Vector<ElementType>& system_rhs, Vector<ElementType>& system_solution, bool iterative_refinement) {
+      SymmetricIndefiniteLinearSolver<IndexType, ElementType>& solver = this->active_solver(linear_solver);
+      solver.solve_indefinite_system(this->matrix, system_rhs, system_solution);
+      this->number_refinement_steps = 0;
+      this->residual_ratio = ElementType(0);
+      if (!iterative_refinement || this->iterative_refinement_max_steps == 0) {
+         return;
+      }
+
+      // relative tolerance on the residual
+      const size_t dimension = this->matrix.dimension();
+      ElementType rhs_norm = ElementType(0);
+      for (size_t index: Range(dimension)) {
+         rhs_norm = std::max(rhs_norm, std::abs(system_rhs[index]));
+      }
+      const ElementType tolerance = this->iterative_refinement_tolerance * std::max(ElementType(1), rhs_norm);
+
+      // the refinement is skipped when the solution is already accurate
+      ElementType residual_norm = this->compute_residual(system_rhs, system_solution);
+      if (this->iterative_refinement_method == IterativeRefinementMethod::FGMRES) {
+         if (tolerance < residual_norm) {
+            // the correction of the Krylov steps is stored in correction
+            this->number_refinement_steps = this->refine_by_fgmres(solver, system_solution, tolerance);
+            const ElementType new_residual_norm = this->compute_residual(system_rhs, system_solution);
+            DEBUG2 << "FGMRES refinement in " << this->number_refinement_steps << " steps: residual " << new_residual_norm << '\n';
+            // stagnation (e.g. singular matrix): discard the correction
+            if (residual_norm <= new_residual_norm) {
+               for (size_t index: Range(dimension)) {
+                  system_solution[index] -= this->correction[index];
+               }
+            }
+            else {
+               residual_norm = new_residual_norm;
+            }
+         }
+      }
+      else {
+         while (this->number_refinement_steps < this->iterative_refinement_max_steps && tolerance < residual_norm) {
+            solver.solve_indefinite_system(this->matrix, this->residual, this->correction);
+            for (size_t index: Range(dimension)) {
+               system_solution[index] += this->correction[index];
+            }
+            this->number_refinement_steps++;
+            const ElementType new_residual_norm = this->compute_residual(system_rhs, system_solution);
+            DEBUG2 << "Iterative refinement step " << this->number_refinement_steps << ": residual " << new_residual_norm << '\n';
+            // stagnation (e.g. singular matrix): discard the correction
+            if (residual_norm <= new_residual_norm) {
+               for (size_t index: Range(dimension)) {
+                  system_solution[index] -= this->correction[index];
+               }
+               break;
+            }
+            residual_norm = new_residual_norm;
+         }
+      }
+
+      // residual ratio of IPOPT
+      ElementType solution_norm = ElementType(0);
+      for (size_t index: Range(dimension)) {
+         solution_norm = std::max(solution_norm, std::abs(system_solution[index]));
+      }
+      const ElementType denominator = std::min(solution_norm, ElementType(1e6) * rhs_norm) + rhs_norm;
+      this->residual_ratio = (ElementType(0) < denominator) ? residual_norm / denominator : ElementType(0);
+   }
+
+   // Saad, 1993: the preconditioned vectors z_j = M^-1 v_j are stored, since M (the factorization) may be inaccurate. The correction
+   // x - x0 = Z y minimizes the 2-norm of the residual over the span of the z_j
+   template <typename IndexType, typename ElementType>
+   size_t SymmetricIndefiniteLinearSystem<IndexType, ElementType>::refine_by_fgmres(SymmetricIndefiniteLinearSolver<IndexType, ElementType>& solver,
+         Vector<ElementType>& system_solution, ElementType tolerance) {
+      const size_t dimension = this->matrix.dimension();
+      const size_t max_steps = this->iterative_refinement_max_steps;
+      const auto hessenberg_entry = [&](size_t row_index, size_t column_index) -> ElementType& {
+         return this->hessenberg[row_index + column_index * (max_steps + 1)];
+      };
+      const auto dot = [&](const Vector<ElementType>& vector1, const Vector<ElementType>& vector2) {
+         ElementType result = ElementType(0);
+         for (size_t index: Range(dimension)) {
+            result += vector1[index] * vector2[index];
+         }
+         return result;
+      };
+
+      // v_0 = r_0 / ||r_0||
+      const ElementType initial_residual_norm = std::sqrt(dot(this->residual, this->residual));
+      for (size_t index: Range(dimension)) {
+         this->correction[index] = ElementType(0);
+      }
+      if (initial_residual_norm == ElementType(0)) {
+         return 0;
+      }
+      for (size_t index: Range(dimension)) {
+         this->krylov_basis[0][index] = this->residual[index] / initial_residual_norm;
+      }
+      this->least_squares_rhs.fill(ElementType(0));
+      this->least_squares_rhs[0] = initial_residual_norm;
+
+      size_t number_steps = 0;
+      while (number_steps < max_steps) {
+         const size_t step = number_steps;
+         // z_j = M^-1 v_j, w = A z_j
+         solver.solve_indefinite_system(this->matrix, this->krylov_basis[step], this->preconditioned_basis[step]);
+         Vector<ElementType>& next_vector = this->krylov_basis[step + 1];
+         this->multiply_matrix(this->preconditioned_basis[step], next_vector);
+         // modified Gram-Schmidt
+         for (size_t basis_index: Range(step + 1)) {
+            const ElementType projection = dot(next_vector, this->krylov_basis[basis_index]);
+            hessenberg_entry(basis_index, step) = projection;
+            for (size_t index: Range(dimension)) {
+               next_vector[index] -= projection * this->krylov_basis[basis_index][index];
+            }
+         }
+         const ElementType next_norm = std::sqrt(dot(next_vector, next_vector));
+         hessenberg_entry(step + 1, step) = next_norm;
+         if (ElementType(0) < next_norm) {
+            for (size_t index: Range(dimension)) {
+               next_vector[index] /= next_norm;
+            }
+         }
+         // apply the previous Givens rotations to the new column, then eliminate its subdiagonal entry
+         for (size_t rotation_index: Range(step)) {
+            const ElementType upper = hessenberg_entry(rotation_index, step);
+            const ElementType lower = hessenberg_entry(rotation_index + 1, step);
+            hessenberg_entry(rotation_index, step) = this->givens_cosines[rotation_index] * upper + this->givens_sines[rotation_index] * lower;
+            hessenberg_entry(rotation_index + 1, step) = -this->givens_sines[rotation_index] * upper + this->givens_cosines[rotation_index] * lower;
+         }
+         const ElementType diagonal = hessenberg_entry(step, step);
+         const ElementType subdiagonal = hessenberg_entry(step + 1, step);
+         const ElementType radius = std::hypot(diagonal, subdiagonal);
+         this->givens_cosines[step] = (radius == ElementType(0)) ? ElementType(1) : diagonal / radius;
+         this->givens_sines[step] = (radius == ElementType(0)) ? ElementType(0) : subdiagonal / radius;
+         hessenberg_entry(step, step) = radius;
+         hessenberg_entry(step + 1, step) = ElementType(0);
+         this->least_squares_rhs[step + 1] = -this->givens_sines[step] * this->least_squares_rhs[step];
+         this->least_squares_rhs[step] = this->givens_cosines[step] * this->least_squares_rhs[step];
+         number_steps++;
+         // |g_{j+1}| is the 2-norm of the residual, an upper bound of its infinity norm. A zero norm is a lucky breakdown
+         if (std::abs(this->least_squares_rhs[step + 1]) <= tolerance || next_norm == ElementType(0)) {
+            break;
+         }
+      }
+
+      // upper triangular solve H y = g (y overwrites g), then x = x0 + Z y
+      for (size_t row_index = number_steps; 0 < row_index--;) {
+         ElementType value = this->least_squares_rhs[row_index];
+         for (size_t column_index: Range(row_index + 1, number_steps)) {
+            value -= hessenberg_entry(row_index, column_index) * this->least_squares_rhs[column_index];
+         }
+         const ElementType diagonal = hessenberg_entry(row_index, row_index);
+         this->least_squares_rhs[row_index] = (diagonal == ElementType(0)) ? ElementType(0) : value / diagonal;
+      }
+      for (size_t basis_index: Range(number_steps)) {
+         const ElementType coefficient = this->least_squares_rhs[basis_index];
+         for (size_t index: Range(dimension)) {
+            this->correction[index] += coefficient * this->preconditioned_basis[basis_index][index];
+         }
+      }
+      for (size_t index: Range(dimension)) {
+         system_solution[index] += this->correction[index];
+      }
+      return number_steps;
+   }
+
+   template <typename IndexType, typename ElementType>
+   ElementType SymmetricIndefiniteLinearSystem<IndexType, ElementType>::compute_residual(const Vector<ElementType>& system_rhs,
+         const Vector<ElementType>& system_solution) {
+      const size_t dimension = this->matrix.dimension();
+      this->multiply_matrix(system_solution, this->residual);
+      ElementType residual_norm = ElementType(0);
+      for (size_t index: Range(dimension)) {
+         this->residual[index] = system_rhs[index] - this->residual[index];
+         residual_norm = std::max(residual_norm, std::abs(this->residual[index]));
+      }
+      return residual_norm;
+   }
+
+   template <typename IndexType, typename ElementType>
+   void SymmetricIndefiniteLinearSystem<IndexType, ElementType>::multiply_matrix(const Vector<ElementType>& vector,
+         Vector<ElementType>& product) const {
+      const size_t dimension = this->matrix.dimension();
+      for (size_t index: Range(dimension)) {
+         product[index] = ElementType(0);
+      }
+      // only one triangle is stored
+      this->matrix.for_each([&](size_t row_index, size_t column_index, ElementType element) {
+         product[row_index] += element * vector[column_index];
+         if (row_index != column_index) {
+            product[column_index] += element * vector[row_index];
+         }
+      });
+      // quasi-definite mode: product with the matrix without the layer, whose effect on the solution is removed by the refinement
+      if (this->has_quasi_definite_layer) {
+         for (size_t index: Range(dimension)) {
+            const ElementType regularization = (index < this->quasi_definite_primal_block) ? this->quasi_definite_primal_regularization :
+                  -this->quasi_definite_dual_regularization;
+            const ElementType scaled_regularization = this->is_matrix_scaled ?
+                  this->scaling_factors[index] * regularization * this->scaling_factors[index] : regularization;
+            product[index] -= scaled_regularization * vector[index];
+         }
+      }
    }
-   */
 } // namespace
 
 #endif // UNO_SYMMETRICINDEFINITELINEARSYSTEM_H
@@ -6,10 +6,12 @@
 
 #include <algorithm>
 #include <memory>
-#include <functional>
 #include <cassert>
+#include <variant>
+#include <vector>
 #include "SparseStorage.hpp"
 #include "SparseStorageFactory.hpp"
+#include "symbolic/Range.hpp"
 #include "tools/Infinity.hpp"
 
 namespace uno {
@@ -19,64 +21,125 @@ namespace uno {
    public:
       using value_type = ElementType;
       
-      SymmetricMatrix(size_t dimension, size_t capacity, bool use_regularization, const std::string& sparse_format);
+      // index_shift is added to the stored indices (e.g. 1 for Fortran solvers), see SparseStorage
+      SymmetricMatrix(size_t dimension, size_t capacity, bool use_regularization, const std::string& sparse_format, size_t index_shift = 0);
       ~SymmetricMatrix() = default;
 
-      void reset() { this->sparse_storage->reset(); }
-      [[nodiscard]] size_t dimension() const { return this->sparse_storage->dimension; }
-      void set_dimension(size_t new_dimension) { this->sparse_storage->set_dimension(new_dimension); }
-      [[nodiscard]] size_t number_nonzeros() const { return this->sparse_storage->number_nonzeros; }
-      [[nodiscard]] size_t capacity() const { return this->sparse_storage->capacity; }
+      void reset() { std::visit([](auto& storage) { storage.reset(); }, this->sparse_storage); }
+      [[nodiscard]] size_t dimension() const { return this->storage().dimension; }
+      void set_dimension(size_t new_dimension) { std::visit([=](auto& storage) { storage.set_dimension(new_dimension); }, this->sparse_storage); }
+      [[nodiscard]] size_t number_nonzeros() const { return this->storage().number_nonzeros; }
+      [[nodiscard]] size_t capacity() const { return this->storage().capacity; }
+      [[nodiscard]] size_t index_shift() const { return this->storage().get_index_shift(); }
+      // allocated memory (in bytes)
+      [[nodiscard]] size_t memory_size() const {
+         return this->storage().memory_size() + this->diagonal_entries.capacity() * sizeof(ElementType);
+      }
       template <typename Vector1, typename Vector2>
       ElementType quadratic_product(const Vector1& x, const Vector2& y) const;
 
       // build the matrix incrementally
       void insert(ElementType term, IndexType row_index, IndexType column_index);
-      void finalize_column(IndexType column_index) { this->sparse_storage->finalize_column(column_index); }
+      void finalize_column(IndexType column_index) {
+         std::visit([=](auto& storage) { storage.finalize_column(column_index); }, this->sparse_storage);
+      }
+      // appends a block with a fixed sparsity pattern whose elements are then written in place (see COOSparseStorage::insert_block).
+      // Only available in COO format: nullptr otherwise
+      ElementType* insert_block(const IndexType* row_indices, const IndexType* column_indices, size_t block_size) {
+         if (auto* storage = std::get_if<COOSparseStorage<IndexType, ElementType>>(&this->sparse_storage)) {
+            return storage->insert_block(row_indices, column_indices, block_size);
+         }
+         return nullptr;
+      }
       
+      // diagonal entries of the matrix (the duplicates are accumulated), written in the first dimension() elements of diagonal
+      template <typename Array>
+      void get_diagonal(Array& diagonal) const;
       [[nodiscard]] ElementType smallest_diagonal_entry(size_t max_dimension) const;
       
-      void set_regularization(const std::function<ElementType(size_t /*index*/)>& regularization_function) {
-         this->sparse_storage->set_regularization(regularization_function);
+      // the regularization function (any callable size_t -> ElementType) is inlined into the loops of the storages
+      template <typename Function>
+      void set_regularization(const Function& regularization_function) {
+         std::visit([&](auto& storage) { storage.set_regularization(regularization_function); }, this->sparse_storage);
       }
 
       static SymmetricMatrix<IndexType, ElementType> zero(size_t dimension) {
          return {dimension, 0, false, "COO"}; // TODO change
       }
 
-      typename SparseStorage<IndexType, ElementType>::iterator begin() const { return this->sparse_storage->begin(); }
-      typename SparseStorage<IndexType, ElementType>::iterator end() const { return this->sparse_storage->end(); }
+      // traverse the nonzeros (row index, column index, element) without virtual dispatch
+      template <typename Function>
+      void for_each(const Function& function) const;
+
+      typename SparseStorage<IndexType, ElementType>::iterator begin() const { return this->storage().begin(); }
+      typename SparseStorage<IndexType, ElementType>::iterator end() const { return this->storage().end(); }
 
-      [[nodiscard]] const ElementType* data_pointer() const noexcept { return this->sparse_storage->data_pointer(); }
-      [[nodiscard]] ElementType* data_pointer() noexcept { return this->sparse_storage->data_pointer(); }
+      [[nodiscard]] const ElementType* data_pointer() const noexcept {
+         return std::visit([](const auto& storage) { return storage.data_pointer(); }, this->sparse_storage);
+      }
+      [[nodiscard]] ElementType* data_pointer() noexcept {
+         return std::visit([](auto& storage) { return storage.data_pointer(); }, this->sparse_storage);
+      }
+
+      // concrete storage (nullptr if the matrix is stored in another format)
+      template <typename Storage>
+      [[nodiscard]] const Storage* get_storage_if() const noexcept { return std::get_if<Storage>(&this->sparse_storage); }
 
-      void print(std::ostream& stream) const { this->sparse_storage->print(stream); }
+      void print(std::ostream& stream) const { this->storage().print(stream); }
       template <typename Index, typename Element>
       friend std::ostream& operator<<(std::ostream& stream, const SymmetricMatrix<Index, Element>& matrix);
 
    protected:
-      std::unique_ptr<SparseStorage<IndexType, ElementType>> sparse_storage;
+      SparseStorageVariant<IndexType, ElementType> sparse_storage;
+      mutable std::vector<ElementType> diagonal_entries{}; // buffer for smallest_diagonal_entry
+
+      [[nodiscard]] const SparseStorage<IndexType, ElementType>& storage() const {
+         return std::visit([](const auto& storage) -> const SparseStorage<IndexType, ElementType>& { return storage; }, this->sparse_storage);
+      }
    };
 
    // implementation
 
    template <typename IndexType, typename ElementType>
-   SymmetricMatrix<IndexType, ElementType>::SymmetricMatrix(size_t dimension, size_t capacity, bool use_regularization, const std::string& sparse_format) :
-         sparse_storage(SparseStorageFactory<IndexType, ElementType>::create(sparse_format, dimension, capacity, use_regularization)) {
+   SymmetricMatrix<IndexType, ElementType>::SymmetricMatrix(size_t dimension, size_t capacity, bool use_regularization, const std::string& sparse_format,
+         size_t index_shift) :
+         sparse_storage(SparseStorageFactory<IndexType, ElementType>::create(sparse_format, dimension, capacity, use_regularization, index_shift)),
+         diagonal_entries(dimension) {
    }
 
    template <typename IndexType, typename ElementType>
-   inline ElementType SymmetricMatrix<IndexType, ElementType>::smallest_diagonal_entry(size_t max_dimension) const {
+   template <typename Array>
+   inline void SymmetricMatrix<IndexType, ElementType>::get_diagonal(Array& diagonal) const {
+      const size_t dimension = this->dimension();
+      for (size_t index: Range(dimension)) {
+         diagonal[index] = ElementType(0);
+      }
       // diagonal entries might be at several locations and must be accumulated
-      // TODO preallocate this vector somewhere
-      std::vector<ElementType> diagonal_entries(max_dimension, ElementType(0));
+      std::visit([&](const auto& storage) {
+         storage.for_each_diagonal([&](IndexType index, ElementType element) {
+            if (static_cast<size_t>(index) < dimension) {
+               diagonal[static_cast<size_t>(index)] += element;
+            }
+         });
+      }, this->sparse_storage);
+   }
 
-      for (const auto [row_index, column_index, element]: *this->sparse_storage) {
-         if (row_index == column_index && row_index < max_dimension) {
-            diagonal_entries[row_index] += element;
-         }
+   template <typename IndexType, typename ElementType>
+   inline ElementType SymmetricMatrix<IndexType, ElementType>::smallest_diagonal_entry(size_t max_dimension) const {
+      // the buffer only grows
+      const size_t buffer_size = std::max(max_dimension, this->dimension());
+      if (this->diagonal_entries.size() < buffer_size) {
+         this->diagonal_entries.resize(buffer_size);
       }
-      return *std::min_element(diagonal_entries.begin(), diagonal_entries.end());
+      std::fill(this->diagonal_entries.begin(), this->diagonal_entries.begin() + static_cast<std::ptrdiff_t>(max_dimension), ElementType(0));
+      std::visit([&](const auto& storage) {
+         storage.for_each_diagonal([&](IndexType index, ElementType element) {
+            if (static_cast<size_t>(index) < max_dimension) {
+               this->diagonal_entries[static_cast<size_t>(index)] += element;
+            }
+         });
+      }, this->sparse_storage);
+      return *std::min_element(this->diagonal_entries.begin(), this->diagonal_entries.begin() + static_cast<std::ptrdiff_t>(max_dimension));
    }
    
    template <typename IndexType, typename ElementType>
@@ -87,7 +150,7 @@ namespace uno {
       assert(x.size() == y.size() && "SymmetricMatrix::quadratic_product: the two vectors x and y do not have the same size");
 
       ElementType result = ElementType(0);
-      for (const auto [row_index, column_index, element]: *this) {
+      this->for_each([&](IndexType row_index, IndexType column_index, ElementType element) {
          if (row_index == column_index) {
             // diagonal term
             result += element * x[row_index] * y[row_index];
@@ -96,14 +159,20 @@ namespace uno {
             // off-diagonal term
             result += element * (x[row_index] * y[column_index] + x[column_index] * y[row_index]);
          }
-      }
+      });
       return result;
    }
 
+   template <typename IndexType, typename ElementType>
+   template <typename Function>
+   inline void SymmetricMatrix<IndexType, ElementType>::for_each(const Function& function) const {
+      std::visit([&](const auto& storage) { storage.for_each(function); }, this->sparse_storage);
+   }
+
    template <typename IndexType, typename ElementType>
    inline void SymmetricMatrix<IndexType, ElementType>::insert(ElementType term, IndexType row_index, IndexType column_index) {
       // check if element in upper/lower triangular part
-      this->sparse_storage->insert(term, row_index, column_index);
+      std::visit([=](auto& storage) { storage.insert(term, row_index, column_index); }, this->sparse_storage);
    }
    
    template <typename Index, typename Element>
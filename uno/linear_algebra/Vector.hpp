@@ -4,20 +4,27 @@
 #ifndef UNO_VECTOR_H
 #define UNO_VECTOR_H
 
+#include <cassert>
 #include <iostream>
 #include <limits>
+#include <type_traits>
 #include <vector>
 #include <initializer_list>
+#include "AlignedAllocator.hpp"
+#include "SIMDKernels.hpp"
 #include "symbolic/Range.hpp"
+#include "symbolic/StridedSpan.hpp"
 
 namespace uno {
+   // dense vector. The elements are aligned on a cache line to enable vectorized kernels
    template <typename ElementType>
    class Vector {
    public:
       using value_type = ElementType;
+      using storage_type = std::vector<ElementType, AlignedAllocator<ElementType>>;
       // iterators
-      using iterator = typename std::vector<ElementType>::iterator;
-      using const_iterator = typename std::vector<ElementType>::const_iterator;
+      using iterator = typename storage_type::iterator;
+      using const_iterator = typename storage_type::const_iterator;
 
       // constructors and destructor
       explicit Vector(size_t capacity = 0): vector(capacity) { }
@@ -44,11 +51,14 @@ namespace uno {
       }
 
       // assignment operator from some expression
+      // the expression is lowered onto the raw arrays of its operands and evaluated in a single fused loop
       template <typename Expression>
       Vector<ElementType>& operator=(const Expression& expression) {
          static_assert(std::is_same_v<typename Expression::value_type, ElementType>);
+         const auto& block = strided_block(expression);
+         ElementType* destination = this->vector.data();
          for (size_t index = 0; index < this->size(); index++) {
-            this->vector[index] = expression[index];
+            destination[index] = block[index];
          }
          return *this;
       }
@@ -56,8 +66,10 @@ namespace uno {
       // sum operator
       template <typename Expression>
       Vector<ElementType>& operator+=(const Expression& expression) {
+         const auto& block = strided_block(expression);
+         ElementType* destination = this->vector.data();
          for (size_t index = 0; index < this->size(); index++) {
-            this->vector[index] += expression[index];
+            destination[index] += block[index];
          }
          return *this;
       }
@@ -73,6 +85,8 @@ namespace uno {
       // size and capacity
       void reserve(size_t new_capacity) { this->vector.reserve(new_capacity); }
       void resize(size_t new_size) { this->vector.resize(new_size); }
+      // allocated memory (in bytes)
+      [[nodiscard]] size_t memory_size() const { return this->vector.capacity() * sizeof(ElementType); }
 
       // iterators
       iterator begin() noexcept { return this->vector.begin(); }
@@ -103,6 +117,9 @@ namespace uno {
       ElementType* data() { return this->vector.data(); }
       const ElementType* data() const { return this->vector.data(); }
 
+      // span over the elements (see StridedSpan.hpp)
+      [[nodiscard]] StridedSpan<const ElementType> block() const { return {this->vector.data(), this->size()}; }
+
       void print(std::ostream& stream) const {
          for (const ElementType& element: *this) {
             stream << element << ' ';
@@ -110,7 +127,7 @@ namespace uno {
       }
 
    protected:
-      std::vector<ElementType> vector;
+      storage_type vector;
    };
 
    // use && to allow temporaries (such as std::cout or logger DEBUG, WARNING, etc)
@@ -136,6 +153,22 @@ namespace uno {
       }
    }
 
+   // dense dot product
+   template <typename ElementType>
+   ElementType dot(const Vector<ElementType>& x, const Vector<ElementType>& y) {
+      assert(x.size() == y.size() && "dot: the two vectors do not have the same size");
+      if constexpr (std::is_same_v<ElementType, double>) {
+         return simd_dot(x.data(), y.data(), x.size());
+      }
+      else {
+         ElementType dot_product = ElementType(0);
+         for (size_t index: Range(x.size())) {
+            dot_product += x[index] * y[index];
+         }
+         return dot_product;
+      }
+   }
+
    template <typename Container>
    std::string join(const Container& vector, const std::string& separator) {
       std::string result{};
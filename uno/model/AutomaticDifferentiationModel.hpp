@@ -0,0 +1,609 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_AUTOMATICDIFFERENTIATIONMODEL_H
+#define UNO_AUTOMATICDIFFERENTIATIONMODEL_H
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Model.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/EvaluationErrors.hpp"
+#include "optimization/Iterate.hpp"
+#include "symbolic/AutomaticDifferentiation.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   /*! \class AutomaticDifferentiationModel
+    * \brief Model whose derivatives are computed by automatic differentiation of a single function template
+    *
+    *  Functions provides the template
+    *     template <typename Number>
+    *     void operator()(const std::vector<Number>& x, Number& objective, std::vector<Number>& constraints) const;
+    *  that is instantiated with double (values), Dual<double> (Jacobian, forward mode), Reverse<double> (gradients, reverse mode),
+    *  Reverse<Dual<double>> (Hessian-vector products, forward over reverse) and SparsityTracer. The sparsity patterns and the function
+    *  types (LINEAR or NONLINEAR) are detected once by tracing the evaluation at the initial point: the control flow of the function
+    *  should not change the patterns. The columns of the Jacobian and of the Hessian are grouped by a greedy distance-2 coloring, so
+    *  that a Jacobian costs one forward evaluation per color and a Hessian one Hessian-vector product per color
+    */
+   template <typename Functions>
+   class AutomaticDifferentiationModel: public Model {
+   public:
+      AutomaticDifferentiationModel(std::string name, Functions functions, std::vector<double> variable_lower_bounds,
+            std::vector<double> variable_upper_bounds, std::vector<double> constraint_lower_bounds, std::vector<double> constraint_upper_bounds,
+            std::vector<double> initial_primals, double objective_sign = 1.);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->variable_lower_bounds[variable_index]; }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->variable_upper_bounds[variable_index]; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override { return this->variable_status[variable_index]; }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->lower_bounded_variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override {
+         return this->single_lower_bounded_variables_collection;
+      }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+         return this->single_upper_bounded_variables_collection;
+      }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->constraint_lower_bounds[constraint_index]; }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->constraint_upper_bounds[constraint_index]; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return this->objective_type; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->constraint_type[constraint_index]; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override { return this->constraint_status[constraint_index]; }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->equality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->inequality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->linear_constraints_collection; }
+
+      void initial_primal_point(Vector<double>& x) const override;
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->gradient_indices.size(); }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->jacobian_column_indices.size(); }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->hessian_row_indices.size(); }
+
+      [[nodiscard]] size_t number_jacobian_colors() const { return this->jacobian_color_starts.size() - 1; }
+      [[nodiscard]] size_t number_hessian_colors() const { return this->hessian_color_starts.size() - 1; }
+
+   private:
+      static constexpr size_t UNCOLORED = std::numeric_limits<size_t>::max();
+      const Functions functions;
+
+      // sparsity patterns: gradient indices, Jacobian (CSR), upper triangle of the Hessian (CSC) and its full adjacency (CSR)
+      std::vector<size_t> gradient_indices{};
+      std::vector<size_t> jacobian_row_starts{};
+      std::vector<size_t> jacobian_column_indices{};
+      std::vector<size_t> hessian_column_starts{};
+      std::vector<size_t> hessian_row_indices{};
+      // colors of the columns and columns of each color (CSR)
+      std::vector<size_t> jacobian_colors{};
+      std::vector<size_t> jacobian_color_starts{};
+      std::vector<size_t> jacobian_color_columns{};
+      std::vector<size_t> hessian_colors{};
+      std::vector<size_t> hessian_color_starts{};
+      std::vector<size_t> hessian_color_columns{};
+
+      // workspaces of the evaluations
+      mutable std::vector<double> primals;
+      mutable std::vector<double> constraint_values;
+      mutable std::vector<Dual<double>> tangent_primals;
+      mutable std::vector<Dual<double>> tangent_constraints;
+      mutable Tape<double> tape{};
+      mutable std::vector<Reverse<double>> reverse_primals;
+      mutable std::vector<Reverse<double>> reverse_constraints;
+      mutable std::vector<double> adjoints{};
+      mutable Tape<Dual<double>> second_order_tape{};
+      mutable std::vector<Reverse<Dual<double>>> second_order_primals;
+      mutable std::vector<Reverse<Dual<double>>> second_order_constraints;
+      mutable std::vector<Dual<double>> second_order_adjoints{};
+      mutable std::vector<double> hessian_vector_product;
+      mutable std::vector<double> jacobian_values{}; /*!< in the order of the CSR pattern */
+      mutable std::vector<double> hessian_values{}; /*!< in the order of the CSC pattern */
+
+      std::vector<double> variable_lower_bounds;
+      std::vector<double> variable_upper_bounds;
+      std::vector<double> constraint_lower_bounds;
+      std::vector<double> constraint_upper_bounds;
+      std::vector<double> initial_primals;
+      std::vector<BoundType> variable_status;
+      std::vector<BoundType> constraint_status;
+      FunctionType objective_type{NONLINEAR};
+      std::vector<FunctionType> constraint_type;
+
+      std::vector<size_t> linear_constraints{};
+      CollectionAdapter<std::vector<size_t>&> linear_constraints_collection;
+      std::vector<size_t> equality_constraints{};
+      CollectionAdapter<std::vector<size_t>&> equality_constraints_collection;
+      std::vector<size_t> inequality_constraints{};
+      CollectionAdapter<std::vector<size_t>&> inequality_constraints_collection;
+      SparseVector<size_t> slacks{};
+      std::vector<size_t> lower_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> lower_bounded_variables_collection;
+      std::vector<size_t> upper_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> upper_bounded_variables_collection;
+      std::vector<size_t> single_lower_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> single_lower_bounded_variables_collection;
+      std::vector<size_t> single_upper_bounded_variables{};
+      CollectionAdapter<std::vector<size_t>&> single_upper_bounded_variables_collection;
+      Vector<size_t> fixed_variables{};
+
+      void generate_variables();
+      void generate_constraints();
+      void detect_sparsity();
+      // adjoints of the variables (reverse mode) for the given seed of the outputs (objective, then constraints)
+      template <typename Seed>
+      void evaluate_adjoints(const Vector<double>& x, const Seed& seed) const;
+      // Hessian-vector products of the Lagrangian rho f - lambda^T c along the tangent set by the function (forward over reverse)
+      template <typename Tangent>
+      void evaluate_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Tangent& tangent) const;
+      // greedy coloring of the columns such that two columns of the same color have no nonzero in the same row (CSR pattern)
+      static void color_columns(size_t number_columns, const std::vector<size_t>& row_starts, const std::vector<size_t>& column_indices,
+            std::vector<size_t>& colors, std::vector<size_t>& color_starts, std::vector<size_t>& color_columns);
+      static void determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds,
+            std::vector<BoundType>& status);
+      static void check_finite(double value);
+   };
+
+   template <typename Functions>
+   AutomaticDifferentiationModel<Functions>::AutomaticDifferentiationModel(std::string name, Functions functions,
+         std::vector<double> variable_lower_bounds, std::vector<double> variable_upper_bounds, std::vector<double> constraint_lower_bounds,
+         std::vector<double> constraint_upper_bounds, std::vector<double> initial_primals, double objective_sign):
+         Model(std::move(name), variable_lower_bounds.size(), constraint_lower_bounds.size(), objective_sign),
+         functions(std::move(functions)),
+         primals(this->number_variables),
+         constraint_values(this->number_constraints),
+         tangent_primals(this->number_variables),
+         tangent_constraints(this->number_constraints),
+         reverse_primals(this->number_variables),
+         reverse_constraints(this->number_constraints),
+         second_order_primals(this->number_variables),
+         second_order_constraints(this->number_constraints),
+         hessian_vector_product(this->number_variables),
+         variable_lower_bounds(std::move(variable_lower_bounds)),
+         variable_upper_bounds(std::move(variable_upper_bounds)),
+         constraint_lower_bounds(std::move(constraint_lower_bounds)),
+         constraint_upper_bounds(std::move(constraint_upper_bounds)),
+         initial_primals(std::move(initial_primals)),
+         variable_status(this->number_variables),
+         constraint_status(this->number_constraints),
+         constraint_type(this->number_constraints, NONLINEAR),
+         linear_constraints_collection(this->linear_constraints),
+         equality_constraints_collection(this->equality_constraints),
+         inequality_constraints_collection(this->inequality_constraints),
+         lower_bounded_variables_collection(this->lower_bounded_variables),
+         upper_bounded_variables_collection(this->upper_bounded_variables),
+         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
+         single_upper_bounded_variables_collection(this->single_upper_bounded_variables) {
+      if (this->variable_upper_bounds.size() != this->number_variables || this->initial_primals.size() != this->number_variables) {
+         throw std::invalid_argument("The variable bounds and the initial point should have " + std::to_string(this->number_variables) + " elements");
+      }
+      if (this->constraint_upper_bounds.size() != this->number_constraints) {
+         throw std::invalid_argument("The constraint bounds should have " + std::to_string(this->number_constraints) + " elements");
+      }
+      if (objective_sign != 1. && objective_sign != -1.) {
+         throw std::invalid_argument("The objective sign should be 1 or -1");
+      }
+      this->generate_variables();
+      this->generate_constraints();
+      this->detect_sparsity();
+   }
+
+   template <typename Functions>
+   double AutomaticDifferentiationModel<Functions>::evaluate_objective(const Vector<double>& x) const {
+      std::copy(x.data(), x.data() + this->number_variables, this->primals.begin());
+      double objective = 0.;
+      this->functions(this->primals, objective, this->constraint_values);
+      if (!is_finite(objective)) {
+         throw FunctionEvaluationError();
+      }
+      return this->objective_sign * objective;
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->evaluate_adjoints(x, [&](const Reverse<double>& objective, const std::vector<Reverse<double>>& /*constraints*/) {
+         if (objective.node != Reverse<double>::NO_NODE) {
+            this->adjoints[objective.node] = 1.;
+         }
+      });
+      for (size_t variable_index: this->gradient_indices) {
+         // the independent variables are the first nodes of the tape
+         const double derivative = this->objective_sign * this->adjoints[variable_index];
+         AutomaticDifferentiationModel::check_finite(derivative);
+         gradient.insert(variable_index, derivative);
+      }
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      if (!this->is_constrained()) {
+         return;
+      }
+      std::copy(x.data(), x.data() + this->number_variables, this->primals.begin());
+      double objective = 0.;
+      this->functions(this->primals, objective, constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (!is_finite(constraints[constraint_index])) {
+            throw FunctionEvaluationError();
+         }
+      }
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index,
+         SparseVector<double>& gradient) const {
+      this->evaluate_adjoints(x, [&](const Reverse<double>& /*objective*/, const std::vector<Reverse<double>>& constraints) {
+         if (constraints[constraint_index].node != Reverse<double>::NO_NODE) {
+            this->adjoints[constraints[constraint_index].node] = 1.;
+         }
+      });
+      gradient.clear();
+      for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+         const size_t variable_index = this->jacobian_column_indices[nonzero_index];
+         AutomaticDifferentiationModel::check_finite(this->adjoints[variable_index]);
+         gradient.insert(variable_index, this->adjoints[variable_index]);
+      }
+   }
+
+   // one forward evaluation per color: the tangent is the sum of the unit vectors of the columns of the color. Since these columns
+   // have no nonzero in a common row, the tangent of a constraint is the derivative with respect to the column of its row
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::evaluate_constraint_jacobian(const Vector<double>& x,
+         RectangularMatrix<double>& constraint_jacobian) const {
+      if (!this->is_constrained()) {
+         return;
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraint_jacobian[constraint_index].clear();
+      }
+      this->jacobian_values.resize(this->jacobian_column_indices.size());
+      for (size_t color: Range(this->number_jacobian_colors())) {
+         for (size_t variable_index: Range(this->number_variables)) {
+            this->tangent_primals[variable_index] = Dual<double>(x[variable_index], (this->jacobian_colors[variable_index] == color) ? 1. : 0.);
+         }
+         Dual<double> objective(0.);
+         this->functions(this->tangent_primals, objective, this->tangent_constraints);
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+               if (this->jacobian_colors[this->jacobian_column_indices[nonzero_index]] == color) {
+                  this->jacobian_values[nonzero_index] = this->tangent_constraints[constraint_index].tangent;
+               }
+            }
+         }
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         auto constraint_gradient = constraint_jacobian[constraint_index];
+         for (size_t nonzero_index: Range(this->jacobian_row_starts[constraint_index], this->jacobian_row_starts[constraint_index + 1])) {
+            AutomaticDifferentiationModel::check_finite(this->jacobian_values[nonzero_index]);
+            constraint_gradient.insert(this->jacobian_column_indices[nonzero_index], this->jacobian_values[nonzero_index]);
+         }
+      }
+   }
+
+   // one Hessian-vector product per color: the product with the sum of the unit vectors of the columns of the color is the sum of
+   // these columns, which have no nonzero in a common row
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, SymmetricMatrix<size_t, double>& hessian) const {
+      assert(hessian.capacity() >= this->hessian_row_indices.size());
+      this->hessian_values.resize(this->hessian_row_indices.size());
+      for (size_t color: Range(this->number_hessian_colors())) {
+         this->evaluate_hessian_vector_product(x, objective_multiplier, multipliers, [&](size_t variable_index) {
+            return (this->hessian_colors[variable_index] == color) ? 1. : 0.;
+         });
+         for (size_t column_index: Range(this->hessian_color_starts[color], this->hessian_color_starts[color + 1])) {
+            const size_t variable_index = this->hessian_color_columns[column_index];
+            for (size_t nonzero_index: Range(this->hessian_column_starts[variable_index], this->hessian_column_starts[variable_index + 1])) {
+               this->hessian_values[nonzero_index] = this->hessian_vector_product[this->hessian_row_indices[nonzero_index]];
+            }
+         }
+      }
+      hessian.reset();
+      for (size_t column_index: Range(this->number_variables)) {
+         for (size_t nonzero_index: Range(this->hessian_column_starts[column_index], this->hessian_column_starts[column_index + 1])) {
+            AutomaticDifferentiationModel::check_finite(this->hessian_values[nonzero_index]);
+            hessian.insert(this->hessian_values[nonzero_index], this->hessian_row_indices[nonzero_index], column_index);
+         }
+         hessian.finalize_column(column_index);
+      }
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      this->evaluate_hessian_vector_product(x, objective_multiplier, multipliers, [&](size_t variable_index) {
+         return vector[variable_index];
+      });
+      for (size_t variable_index: Range(this->number_variables)) {
+         AutomaticDifferentiationModel::check_finite(this->hessian_vector_product[variable_index]);
+         result[variable_index] = this->hessian_vector_product[variable_index];
+      }
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::initial_primal_point(Vector<double>& x) const {
+      assert(x.size() >= this->number_variables);
+      std::copy(this->initial_primals.cbegin(), this->initial_primals.cend(), x.begin());
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::initial_dual_point(Vector<double>& multipliers) const {
+      assert(multipliers.size() >= this->number_constraints);
+      std::fill(multipliers.begin(), multipliers.begin() + static_cast<std::ptrdiff_t>(this->number_constraints), 0.);
+   }
+
+   // flip the signs of the multipliers and the objective if we maximize
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::postprocess_solution(Iterate& iterate, IterateStatus /*termination_status*/) const {
+      iterate.multipliers.constraints *= this->objective_sign;
+      iterate.multipliers.lower_bounds *= this->objective_sign;
+      iterate.multipliers.upper_bounds *= this->objective_sign;
+      iterate.evaluations.objective *= this->objective_sign;
+   }
+
+   template <typename Functions>
+   template <typename Seed>
+   void AutomaticDifferentiationModel<Functions>::evaluate_adjoints(const Vector<double>& x, const Seed& seed) const {
+      const TapeScope<double> tape_scope(this->tape);
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->reverse_primals[variable_index] = Reverse<double>::independent(x[variable_index]);
+      }
+      Reverse<double> objective(0.);
+      std::fill(this->reverse_constraints.begin(), this->reverse_constraints.end(), Reverse<double>(0.));
+      this->functions(this->reverse_primals, objective, this->reverse_constraints);
+      this->adjoints.assign(this->tape.size(), 0.);
+      seed(objective, this->reverse_constraints);
+      this->tape.propagate(this->adjoints);
+   }
+
+   template <typename Functions>
+   template <typename Tangent>
+   void AutomaticDifferentiationModel<Functions>::evaluate_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Tangent& tangent) const {
+      const TapeScope<Dual<double>> tape_scope(this->second_order_tape);
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->second_order_primals[variable_index] = Reverse<Dual<double>>::independent(Dual<double>(x[variable_index], tangent(variable_index)));
+      }
+      Reverse<Dual<double>> objective(0.);
+      std::fill(this->second_order_constraints.begin(), this->second_order_constraints.end(), Reverse<Dual<double>>(0.));
+      this->functions(this->second_order_primals, objective, this->second_order_constraints);
+      // seeds: gradient of the Lagrangian rho f - lambda^T c with respect to the outputs
+      this->second_order_adjoints.assign(this->second_order_tape.size(), Dual<double>(0.));
+      if (objective.node != Reverse<Dual<double>>::NO_NODE) {
+         this->second_order_adjoints[objective.node] = Dual<double>(this->objective_sign * objective_multiplier);
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         const size_t node = this->second_order_constraints[constraint_index].node;
+         if (node != Reverse<Dual<double>>::NO_NODE) {
+            this->second_order_adjoints[node] += Dual<double>(-multipliers[constraint_index]);
+         }
+      }
+      this->second_order_tape.propagate(this->second_order_adjoints);
+      // the tangents of the adjoints of the variables form the Hessian-vector product
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->hessian_vector_product[variable_index] = this->second_order_adjoints[variable_index].tangent;
+      }
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::detect_sparsity() {
+      std::set<std::pair<size_t, size_t>> hessian_pattern{};
+      std::vector<SparsityTracer> traced_primals(this->number_variables);
+      for (size_t variable_index: Range(this->number_variables)) {
+         traced_primals[variable_index] = SparsityTracer::independent(this->initial_primals[variable_index], variable_index);
+      }
+      SparsityTracer objective(0.);
+      std::vector<SparsityTracer> traced_constraints(this->number_constraints, SparsityTracer(0.));
+      SparsityTracer::hessian_pattern = &hessian_pattern;
+      try {
+         this->functions(traced_primals, objective, traced_constraints);
+      }
+      catch (...) {
+         SparsityTracer::hessian_pattern = nullptr;
+         throw;
+      }
+      SparsityTracer::hessian_pattern = nullptr;
+
+      // objective gradient and function types
+      this->gradient_indices = objective.dependencies;
+      this->objective_type = objective.nonlinear ? NONLINEAR : LINEAR;
+      this->linear_constraints.clear();
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->constraint_type[constraint_index] = traced_constraints[constraint_index].nonlinear ? NONLINEAR : LINEAR;
+         if (this->constraint_type[constraint_index] == LINEAR) {
+            this->linear_constraints.emplace_back(constraint_index);
+         }
+      }
+      // Jacobian (CSR)
+      this->jacobian_row_starts.assign(1, 0);
+      for (const SparsityTracer& constraint: traced_constraints) {
+         this->jacobian_column_indices.insert(this->jacobian_column_indices.end(), constraint.dependencies.cbegin(), constraint.dependencies.cend());
+         this->jacobian_row_starts.emplace_back(this->jacobian_column_indices.size());
+      }
+      // upper triangle of the Hessian (CSC): the pairs are sorted by row, then column
+      std::vector<size_t> column_counts(this->number_variables, 0);
+      for (const auto& [row_index, column_index]: hessian_pattern) {
+         column_counts[column_index]++;
+      }
+      this->hessian_column_starts.assign(this->number_variables + 1, 0);
+      for (size_t column_index: Range(this->number_variables)) {
+         this->hessian_column_starts[column_index + 1] = this->hessian_column_starts[column_index] + column_counts[column_index];
+      }
+      this->hessian_row_indices.resize(hessian_pattern.size());
+      std::vector<size_t> next_slot(this->hessian_column_starts.cbegin(), this->hessian_column_starts.cend() - 1);
+      for (const auto& [row_index, column_index]: hessian_pattern) {
+         this->hessian_row_indices[next_slot[column_index]++] = row_index;
+      }
+      // full symmetric pattern of the Hessian (rows of the CSR adjacency) for the coloring
+      std::vector<std::vector<size_t>> hessian_rows(this->number_variables);
+      for (const auto& [row_index, column_index]: hessian_pattern) {
+         hessian_rows[row_index].emplace_back(column_index);
+         if (row_index != column_index) {
+            hessian_rows[column_index].emplace_back(row_index);
+         }
+      }
+      std::vector<size_t> hessian_row_starts{0};
+      std::vector<size_t> hessian_adjacency{};
+      for (const std::vector<size_t>& row: hessian_rows) {
+         hessian_adjacency.insert(hessian_adjacency.end(), row.cbegin(), row.cend());
+         hessian_row_starts.emplace_back(hessian_adjacency.size());
+      }
+
+      AutomaticDifferentiationModel::color_columns(this->number_variables, this->jacobian_row_starts, this->jacobian_column_indices,
+            this->jacobian_colors, this->jacobian_color_starts, this->jacobian_color_columns);
+      AutomaticDifferentiationModel::color_columns(this->number_variables, hessian_row_starts, hessian_adjacency, this->hessian_colors,
+            this->hessian_color_starts, this->hessian_color_columns);
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::color_columns(size_t number_columns, const std::vector<size_t>& row_starts,
+         const std::vector<size_t>& column_indices, std::vector<size_t>& colors, std::vector<size_t>& color_starts,
+         std::vector<size_t>& color_columns) {
+      const size_t number_rows = row_starts.size() - 1;
+      // rows of each column (CSC)
+      std::vector<size_t> column_starts(number_columns + 1, 0);
+      for (size_t column_index: column_indices) {
+         column_starts[column_index + 1]++;
+      }
+      for (size_t column_index: Range(number_columns)) {
+         column_starts[column_index + 1] += column_starts[column_index];
+      }
+      std::vector<size_t> row_indices(column_indices.size());
+      std::vector<size_t> next_slot(column_starts.cbegin(), column_starts.cend() - 1);
+      for (size_t row_index: Range(number_rows)) {
+         for (size_t nonzero_index: Range(row_starts[row_index], row_starts[row_index + 1])) {
+            row_indices[next_slot[column_indices[nonzero_index]]++] = row_index;
+         }
+      }
+
+      colors.assign(number_columns, UNCOLORED);
+      // forbidden_colors[c] == j + 1 if the color c is forbidden for the column j
+      std::vector<size_t> forbidden_colors(number_columns + 1, 0);
+      size_t number_colors = 0;
+      for (size_t column_index: Range(number_columns)) {
+         for (size_t row_nonzero: Range(column_starts[column_index], column_starts[column_index + 1])) {
+            const size_t row_index = row_indices[row_nonzero];
+            for (size_t nonzero_index: Range(row_starts[row_index], row_starts[row_index + 1])) {
+               const size_t other_color = colors[column_indices[nonzero_index]];
+               if (other_color != UNCOLORED) {
+                  forbidden_colors[other_color] = column_index + 1;
+               }
+            }
+         }
+         size_t color = 0;
+         while (forbidden_colors[color] == column_index + 1) {
+            color++;
+         }
+         colors[column_index] = color;
+         number_colors = std::max(number_colors, color + 1);
+      }
+
+      // columns of each color
+      color_starts.assign(number_colors + 1, 0);
+      for (size_t color: colors) {
+         color_starts[color + 1]++;
+      }
+      for (size_t color: Range(number_colors)) {
+         color_starts[color + 1] += color_starts[color];
+      }
+      color_columns.resize(number_columns);
+      std::vector<size_t> next_column(color_starts.cbegin(), color_starts.cend() - 1);
+      for (size_t column_index: Range(number_columns)) {
+         color_columns[next_column[colors[column_index]]++] = column_index;
+      }
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::generate_variables() {
+      this->fixed_variables.reserve(this->number_variables);
+      for (size_t variable_index: Range(this->number_variables)) {
+         if (this->variable_lower_bounds[variable_index] == this->variable_upper_bounds[variable_index]) {
+            this->fixed_variables.emplace_back(variable_index);
+         }
+      }
+      AutomaticDifferentiationModel::determine_bounds_types(this->variable_lower_bounds, this->variable_upper_bounds, this->variable_status);
+      for (size_t variable_index: Range(this->number_variables)) {
+         const BoundType status = this->variable_status[variable_index];
+         if (status == BOUNDED_LOWER || status == BOUNDED_BOTH_SIDES) {
+            this->lower_bounded_variables.emplace_back(variable_index);
+            if (status == BOUNDED_LOWER) {
+               this->single_lower_bounded_variables.emplace_back(variable_index);
+            }
+         }
+         if (status == BOUNDED_UPPER || status == BOUNDED_BOTH_SIDES) {
+            this->upper_bounded_variables.emplace_back(variable_index);
+            if (status == BOUNDED_UPPER) {
+               this->single_upper_bounded_variables.emplace_back(variable_index);
+            }
+         }
+      }
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::generate_constraints() {
+      AutomaticDifferentiationModel::determine_bounds_types(this->constraint_lower_bounds, this->constraint_upper_bounds, this->constraint_status);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (this->constraint_status[constraint_index] == EQUAL_BOUNDS) {
+            this->equality_constraints.emplace_back(constraint_index);
+         }
+         else {
+            this->inequality_constraints.emplace_back(constraint_index);
+         }
+      }
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::determine_bounds_types(const std::vector<double>& lower_bounds,
+         const std::vector<double>& upper_bounds, std::vector<BoundType>& status) {
+      for (size_t index: Range(lower_bounds.size())) {
+         if (lower_bounds[index] == upper_bounds[index]) {
+            status[index] = EQUAL_BOUNDS;
+         }
+         else if (is_finite(lower_bounds[index]) && is_finite(upper_bounds[index])) {
+            status[index] = BOUNDED_BOTH_SIDES;
+         }
+         else if (is_finite(lower_bounds[index])) {
+            status[index] = BOUNDED_LOWER;
+         }
+         else if (is_finite(upper_bounds[index])) {
+            status[index] = BOUNDED_UPPER;
+         }
+         else {
+            status[index] = UNBOUNDED;
+         }
+      }
+   }
+
+   template <typename Functions>
+   void AutomaticDifferentiationModel<Functions>::check_finite(double value) {
+      if (!is_finite(value)) {
+         throw GradientEvaluationError();
+      }
+   }
+} // namespace
+
+#endif // UNO_AUTOMATICDIFFERENTIATIONMODEL_H
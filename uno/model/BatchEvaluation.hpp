@@ -0,0 +1,43 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BATCHEVALUATION_H
+#define UNO_BATCHEVALUATION_H
+
+#include <cstddef>
+#include <exception>
+#include <vector>
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   /*! \struct BatchEvaluation
+    * \brief Points and results of a multi-point evaluation (see Model::evaluate_batch)
+    *
+    *  The objective, the constraints and (if requested) the objective gradient are evaluated at each point independently. An
+    *  evaluation error at a point is recorded in errors and does not interrupt the evaluations at the other points. The storage
+    *  is allocated once and reused across batches of the same size
+    */
+   struct BatchEvaluation {
+      BatchEvaluation(size_t number_points, size_t number_variables, size_t number_constraints, bool evaluate_objective_gradients):
+            points(number_points, Vector<double>(number_variables)),
+            evaluate_objective_gradients(evaluate_objective_gradients),
+            objectives(number_points),
+            constraints(number_points, std::vector<double>(number_constraints)),
+            objective_gradients(evaluate_objective_gradients ? number_points : 0, SparseVector<double>(number_variables)),
+            errors(number_points) {
+      }
+
+      std::vector<Vector<double>> points;
+      const bool evaluate_objective_gradients;
+      std::vector<double> objectives;
+      std::vector<std::vector<double>> constraints;
+      std::vector<SparseVector<double>> objective_gradients; // empty if the gradients are not requested
+      std::vector<std::exception_ptr> errors; // nullptr if the evaluations at the point succeeded
+
+      [[nodiscard]] size_t number_points() const { return this->points.size(); }
+      [[nodiscard]] bool is_evaluated(size_t point_index) const { return !this->errors[point_index]; }
+   };
+} // namespace
+
+#endif // UNO_BATCHEVALUATION_H
@@ -32,6 +32,15 @@ namespace uno {
             SymmetricMatrix<size_t, double>& hessian) const override {
          this->model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
       }
+      void evaluate_batch(BatchEvaluation& evaluation) const override { this->model->evaluate_batch(evaluation); }
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override {
+         this->model->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+      }
+      [[nodiscard]] size_t hessian_low_rank_dimension() const override { return this->model->hessian_low_rank_dimension(); }
+      void evaluate_hessian_low_rank_term(Vector<double>& factors, size_t leading_dimension, Vector<double>& middle_matrix) const override {
+         this->model->evaluate_hessian_low_rank_term(factors, leading_dimension, middle_matrix);
+      }
 
       // only these two functions are redefined
       [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
@@ -46,6 +55,7 @@ namespace uno {
 
       [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->model->constraint_lower_bound(constraint_index); }
       [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->model->constraint_upper_bound(constraint_index); }
+      [[nodiscard]] FunctionType get_objective_type() const override { return this->model->get_objective_type(); }
       [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->model->get_constraint_type(constraint_index); }
       [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override { return this->model->get_constraint_bound_type(constraint_index); }
       [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->model->get_equality_constraints(); }
@@ -61,6 +71,19 @@ namespace uno {
       [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->model->number_objective_gradient_nonzeros(); }
       [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->model->number_jacobian_nonzeros(); }
       [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->model->number_hessian_nonzeros(); }
+      void set_current_point(const Vector<double>& x) const override { this->model->set_current_point(x); }
+      void invalidate_point() const override { this->model->invalidate_point(); }
+      void refresh() override { this->model->refresh(); }
+      [[nodiscard]] bool supports_concurrent_evaluations() const override { return this->model->supports_concurrent_evaluations(); }
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override {
+         return this->model->get_initial_basis(variable_statuses, constraint_statuses);
+      }
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override {
+         return this->model->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers);
+      }
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override {
+         return this->model->get_stages(variable_stages, constraint_stages);
+      }
 
    private:
       const std::unique_ptr<Model> model{};
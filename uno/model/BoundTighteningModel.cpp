@@ -0,0 +1,205 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include "BoundTighteningModel.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   namespace {
+      // a linear constraint l <= sum_i a_i x_i <= u, with the constant moved to the bounds
+      struct LinearRow {
+         std::vector<std::pair<size_t, double>> coefficients{};
+         double lower_bound{-INF<double>};
+         double upper_bound{INF<double>};
+      };
+
+      // range of an activity sum_i a_i x_i: finite part and number of infinite contributions
+      struct Activity {
+         double finite_sum{0.};
+         size_t number_infinite_terms{0};
+
+         void add(double term) {
+            if (is_finite(term)) {
+               this->finite_sum += term;
+            }
+            else {
+               this->number_infinite_terms++;
+            }
+         }
+
+         // the activity without one of its terms (infinite if another term is infinite)
+         [[nodiscard]] double without(double term) const {
+            if (is_finite(term)) {
+               return (this->number_infinite_terms == 0) ? this->finite_sum - term : INF<double>;
+            }
+            return (this->number_infinite_terms == 1) ? this->finite_sum : INF<double>;
+         }
+      };
+   } // namespace
+
+   BoundTighteningModel::BoundTighteningModel(std::unique_ptr<Model> original_model, bool report_tightened_bounds, const Options& options):
+         Model(original_model->name + " -> bounds tightened", original_model->number_variables, original_model->number_constraints,
+               original_model->objective_sign),
+         model(std::move(original_model)),
+         report_tightened_bounds(report_tightened_bounds),
+         work_limit(options.get_unsigned_int("bound_tightening_work_limit")),
+         tolerance(options.get_double("presolve_tolerance")),
+         tightened_lower_bounds(this->number_variables),
+         tightened_upper_bounds(this->number_variables) {
+      this->tighten_bounds();
+   }
+
+   double BoundTighteningModel::variable_lower_bound(size_t variable_index) const {
+      const double lower_bound = this->model->variable_lower_bound(variable_index);
+      // a finite bound remains finite and the variable does not become fixed
+      if (this->report_tightened_bounds && is_finite(lower_bound) &&
+            this->tightened_lower_bounds[variable_index] < this->tightened_upper_bounds[variable_index]) {
+         return this->tightened_lower_bounds[variable_index];
+      }
+      return lower_bound;
+   }
+
+   double BoundTighteningModel::variable_upper_bound(size_t variable_index) const {
+      const double upper_bound = this->model->variable_upper_bound(variable_index);
+      if (this->report_tightened_bounds && is_finite(upper_bound) &&
+            this->tightened_lower_bounds[variable_index] < this->tightened_upper_bounds[variable_index]) {
+         return this->tightened_upper_bounds[variable_index];
+      }
+      return upper_bound;
+   }
+
+   void BoundTighteningModel::initial_primal_point(Vector<double>& x) const {
+      this->model->initial_primal_point(x);
+      for (size_t variable_index: Range(this->number_variables)) {
+         x[variable_index] = std::max(std::min(x[variable_index], this->tightened_upper_bounds[variable_index]),
+            this->tightened_lower_bounds[variable_index]);
+      }
+   }
+
+   void BoundTighteningModel::refresh() {
+      this->model->refresh();
+      this->tighten_bounds();
+   }
+
+   void BoundTighteningModel::tighten_bounds() {
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->tightened_lower_bounds[variable_index] = this->model->variable_lower_bound(variable_index);
+         this->tightened_upper_bounds[variable_index] = this->model->variable_upper_bound(variable_index);
+      }
+      this->number_tightenings = 0;
+      if (this->model->get_linear_constraints().empty() || this->work_limit == 0) {
+         return;
+      }
+
+      // the coefficients of the linear constraints do not depend on the point
+      Vector<double> x(this->number_variables);
+      this->model->initial_primal_point(x);
+      this->model->project_onto_variable_bounds(x);
+      std::vector<double> constraints(this->number_constraints);
+      RectangularMatrix<double> jacobian(this->number_constraints, this->number_variables);
+      this->model->set_current_point(x);
+      this->model->evaluate_constraints(x, constraints);
+      this->model->evaluate_constraint_jacobian(x, jacobian);
+      this->model->invalidate_point();
+      std::vector<LinearRow> rows{};
+      for (size_t constraint_index: this->model->get_linear_constraints()) {
+         LinearRow row{};
+         for (const auto [variable_index, coefficient]: jacobian[constraint_index]) {
+            row.coefficients.emplace_back(variable_index, coefficient);
+         }
+         // accumulate the duplicate entries and discard the zeros
+         std::sort(row.coefficients.begin(), row.coefficients.end());
+         size_t number_coefficients = 0;
+         for (const auto& [variable_index, coefficient]: row.coefficients) {
+            if (0 < number_coefficients && row.coefficients[number_coefficients - 1].first == variable_index) {
+               row.coefficients[number_coefficients - 1].second += coefficient;
+            }
+            else {
+               row.coefficients[number_coefficients++] = {variable_index, coefficient};
+            }
+         }
+         row.coefficients.resize(number_coefficients);
+         row.coefficients.erase(std::remove_if(row.coefficients.begin(), row.coefficients.end(), [](const auto& entry) {
+            return entry.second == 0.;
+         }), row.coefficients.end());
+         double constant = constraints[constraint_index];
+         for (const auto& [variable_index, coefficient]: row.coefficients) {
+            constant -= coefficient * x[variable_index];
+         }
+         row.lower_bound = this->model->constraint_lower_bound(constraint_index) - constant;
+         row.upper_bound = this->model->constraint_upper_bound(constraint_index) - constant;
+         // a row with at least one finite bound may tighten the bounds of its variables
+         if (!row.coefficients.empty() && (is_finite(row.lower_bound) || is_finite(row.upper_bound))) {
+            rows.emplace_back(std::move(row));
+         }
+      }
+
+      // a new bound is accepted if it improves the current bound significantly
+      const auto improves = [](double new_bound, double bound, double sign) {
+         return std::abs(new_bound) <= maximum_implied_bound &&
+            (!is_finite(bound) || minimum_relative_improvement * std::max(1., std::abs(bound)) < sign * (bound - new_bound));
+      };
+      std::vector<double>& lower_bounds = this->tightened_lower_bounds;
+      std::vector<double>& upper_bounds = this->tightened_upper_bounds;
+      size_t work = 0;
+      size_t number_passes = 0;
+      bool bounds_changed = true;
+      while (bounds_changed && work < this->work_limit) {
+         bounds_changed = false;
+         number_passes++;
+         for (const LinearRow& row: rows) {
+            if (this->work_limit <= work) {
+               break;
+            }
+            // activity range of the row over the current bounds
+            Activity minimum_activity{}, maximum_activity{};
+            for (const auto& [variable_index, coefficient]: row.coefficients) {
+               minimum_activity.add(coefficient * ((0. < coefficient) ? lower_bounds[variable_index] : upper_bounds[variable_index]));
+               maximum_activity.add(coefficient * ((0. < coefficient) ? upper_bounds[variable_index] : lower_bounds[variable_index]));
+            }
+            for (const auto& [variable_index, coefficient]: row.coefficients) {
+               const double minimum_term = coefficient * ((0. < coefficient) ? lower_bounds[variable_index] : upper_bounds[variable_index]);
+               const double maximum_term = coefficient * ((0. < coefficient) ? upper_bounds[variable_index] : lower_bounds[variable_index]);
+               // l - max(other terms) <= a_i x_i <= u - min(other terms)
+               const double term_upper_bound = row.upper_bound - minimum_activity.without(minimum_term);
+               const double term_lower_bound = row.lower_bound - maximum_activity.without(maximum_term);
+               const double new_upper_bound = (0. < coefficient) ? term_upper_bound / coefficient : term_lower_bound / coefficient;
+               const double new_lower_bound = (0. < coefficient) ? term_lower_bound / coefficient : term_upper_bound / coefficient;
+               if (is_finite(new_upper_bound) && improves(new_upper_bound, upper_bounds[variable_index], 1.)) {
+                  upper_bounds[variable_index] = new_upper_bound;
+                  this->number_tightenings++;
+                  bounds_changed = true;
+               }
+               if (is_finite(new_lower_bound) && improves(new_lower_bound, lower_bounds[variable_index], -1.)) {
+                  lower_bounds[variable_index] = new_lower_bound;
+                  this->number_tightenings++;
+                  bounds_changed = true;
+               }
+               const double crossing = lower_bounds[variable_index] - upper_bounds[variable_index];
+               if (this->tolerance * std::max(1., std::abs(upper_bounds[variable_index])) < crossing) {
+                  WARNING << "Bound tightening: the bounds of the variable " << variable_index << " cross, the linear constraints are infeasible\n";
+                  // the tightened bounds are discarded
+                  for (size_t index: Range(this->number_variables)) {
+                     lower_bounds[index] = this->model->variable_lower_bound(index);
+                     upper_bounds[index] = this->model->variable_upper_bound(index);
+                  }
+                  this->number_tightenings = 0;
+                  return;
+               }
+               // the bounds may cross within the tolerance
+               upper_bounds[variable_index] = std::max(lower_bounds[variable_index], upper_bounds[variable_index]);
+            }
+            work += 2 * row.coefficients.size();
+         }
+      }
+      DEBUG << "Bound tightening: " << this->number_tightenings << " bounds were tightened in " << number_passes << " passes\n";
+   }
+} // namespace
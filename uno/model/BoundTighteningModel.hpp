@@ -0,0 +1,145 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BOUNDTIGHTENINGMODEL_H
+#define UNO_BOUNDTIGHTENINGMODEL_H
+
+#include <memory>
+#include <vector>
+#include "Model.hpp"
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   /*! \class BoundTighteningModel
+    * \brief Feasibility-based bound tightening (FBBT) of the variables
+    *
+    *  The activity ranges of the linear constraints (whose coefficients are read from the Jacobian at the initial point) are
+    *  propagated to the variable bounds, pass after pass over the rows, until no bound improves or the number of visited
+    *  nonzeros exceeds a work limit. The tightened bounds are valid for all the feasible points. They are not reported as model
+    *  changes: the bound types and the index collections remain those of the original model, and the multipliers are not
+    *  modified. They are used:
+    *  - to project the initial point (including onto the implied bounds of the unbounded variables);
+    *  - optionally, as the finite bounds of the model, before they are relaxed by the interior-point reformulation (BoundRelaxedModel)
+    */
+   class BoundTighteningModel: public Model {
+   public:
+      BoundTighteningModel(std::unique_ptr<Model> original_model, bool report_tightened_bounds, const Options& options);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override { return this->model->evaluate_objective(x); }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         this->model->evaluate_objective_gradient(x, gradient);
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         this->model->evaluate_constraints(x, constraints);
+      }
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override {
+         this->model->evaluate_constraint_gradient(x, constraint_index, gradient);
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+         this->model->evaluate_constraint_jacobian(x, constraint_jacobian);
+      }
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         this->model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+      }
+      void evaluate_batch(BatchEvaluation& evaluation) const override { this->model->evaluate_batch(evaluation); }
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override {
+         this->model->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+      }
+      void evaluate_scaled_objective_gradient(const Vector<double>& x, const EvaluationScaling& scaling, SparseVector<double>& gradient) const override {
+         this->model->evaluate_scaled_objective_gradient(x, scaling, gradient);
+      }
+      void evaluate_scaled_constraints(const Vector<double>& x, const EvaluationScaling& scaling, std::vector<double>& constraints) const override {
+         this->model->evaluate_scaled_constraints(x, scaling, constraints);
+      }
+      void evaluate_scaled_constraint_jacobian(const Vector<double>& x, const EvaluationScaling& scaling,
+            RectangularMatrix<double>& constraint_jacobian) const override {
+         this->model->evaluate_scaled_constraint_jacobian(x, scaling, constraint_jacobian);
+      }
+      void evaluate_scaled_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const EvaluationScaling& scaling, SymmetricMatrix<size_t, double>& hessian) const override {
+         this->model->evaluate_scaled_lagrangian_hessian(x, objective_multiplier, multipliers, scaling, hessian);
+      }
+
+      // only the finite bounds may be replaced with the tightened bounds
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override { return this->model->get_variable_bound_type(variable_index); }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->model->get_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->model->get_upper_bounded_variables(); }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->model->get_slacks(); }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override {
+         return this->model->get_single_lower_bounded_variables();
+      }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+         return this->model->get_single_upper_bounded_variables();
+      }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->model->get_fixed_variables(); }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->model->constraint_lower_bound(constraint_index); }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->model->constraint_upper_bound(constraint_index); }
+      [[nodiscard]] FunctionType get_objective_type() const override { return this->model->get_objective_type(); }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->model->get_constraint_type(constraint_index); }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override {
+         return this->model->get_constraint_bound_type(constraint_index);
+      }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->model->get_equality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->model->get_inequality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->model->get_linear_constraints(); }
+
+      void initial_primal_point(Vector<double>& x) const override;
+      void initial_dual_point(Vector<double>& multipliers) const override { this->model->initial_dual_point(multipliers); }
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override {
+         this->model->postprocess_solution(iterate, termination_status);
+      }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->model->number_objective_gradient_nonzeros(); }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->model->number_jacobian_nonzeros(); }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->model->number_hessian_nonzeros(); }
+      void set_current_point(const Vector<double>& x) const override { this->model->set_current_point(x); }
+      void invalidate_point() const override { this->model->invalidate_point(); }
+      // the bounds are tightened again from the new bounds and constraints
+      void refresh() override;
+      [[nodiscard]] bool supports_concurrent_evaluations() const override { return this->model->supports_concurrent_evaluations(); }
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override {
+         return this->model->declare_hessian_sparsity(row_indices, column_indices);
+      }
+      [[nodiscard]] bool get_user_variable_scaling(Vector<double>& scaling_factors) const override {
+         return this->model->get_user_variable_scaling(scaling_factors);
+      }
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override {
+         return this->model->get_initial_basis(variable_statuses, constraint_statuses);
+      }
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override {
+         return this->model->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers);
+      }
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override {
+         return this->model->get_stages(variable_stages, constraint_stages);
+      }
+
+      [[nodiscard]] double tightened_variable_lower_bound(size_t variable_index) const { return this->tightened_lower_bounds[variable_index]; }
+      [[nodiscard]] double tightened_variable_upper_bound(size_t variable_index) const { return this->tightened_upper_bounds[variable_index]; }
+      [[nodiscard]] size_t number_tightened_bounds() const { return this->number_tightenings; }
+
+   private:
+      const std::unique_ptr<Model> model{};
+      const bool report_tightened_bounds;
+      const size_t work_limit; /*!< maximum number of visited Jacobian nonzeros */
+      const double tolerance;
+      std::vector<double> tightened_lower_bounds;
+      std::vector<double> tightened_upper_bounds;
+      size_t number_tightenings{0};
+
+      // a bound is updated if it improves by this fraction
+      static constexpr double minimum_relative_improvement{1e-3};
+      // the implied bounds beyond this value are numerically unreliable
+      static constexpr double maximum_implied_bound{1e10};
+
+      void tighten_bounds();
+   };
+} // namespace
+
+#endif // UNO_BOUNDTIGHTENINGMODEL_H
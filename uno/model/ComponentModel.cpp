@@ -0,0 +1,304 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <string>
+#include "ComponentModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   ComponentModel::ComponentModel(const Model& model, const ModelDecomposition& decomposition, size_t component_index,
+         const Vector<double>& reference_point):
+         Model(model.name + " -> component " + std::to_string(component_index), decomposition.variables[component_index].size(),
+               decomposition.constraints[component_index].size(), model.objective_sign),
+         model(model),
+         decomposition(decomposition),
+         component_index(component_index),
+         variables(decomposition.variables[component_index]),
+         constraints(decomposition.constraints[component_index]),
+         reference_point(reference_point),
+         lower_bounded_variables_collection(this->lower_bounded_variables),
+         upper_bounded_variables_collection(this->upper_bounded_variables),
+         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
+         single_upper_bounded_variables_collection(this->single_upper_bounded_variables),
+         equality_constraints_collection(this->equality_constraints),
+         inequality_constraints_collection(this->inequality_constraints),
+         linear_constraints_collection(this->linear_constraints),
+         original_point(reference_point),
+         original_constraints(model.number_constraints),
+         original_multipliers(model.number_constraints, 0.),
+         original_gradient(model.number_objective_gradient_nonzeros()),
+         original_jacobian(model.number_constraints, model.number_variables),
+         original_hessian(model.number_variables, model.number_hessian_nonzeros(), false, "COO"),
+         original_vector(model.number_variables, 0.),
+         original_result(model.number_variables) {
+      // the collections of the component
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double lower_bound = this->variable_lower_bound(variable_index);
+         const double upper_bound = this->variable_upper_bound(variable_index);
+         if (is_finite(lower_bound)) {
+            this->lower_bounded_variables.emplace_back(variable_index);
+            if (!is_finite(upper_bound)) {
+               this->single_lower_bounded_variables.emplace_back(variable_index);
+            }
+         }
+         if (is_finite(upper_bound)) {
+            this->upper_bounded_variables.emplace_back(variable_index);
+            if (!is_finite(lower_bound)) {
+               this->single_upper_bounded_variables.emplace_back(variable_index);
+            }
+         }
+      }
+      for (const size_t variable_index: this->model.get_fixed_variables()) {
+         if (this->contains_variable(variable_index)) {
+            this->fixed_variables.emplace_back(this->decomposition.local_index_of_variable[variable_index]);
+         }
+      }
+      for (const auto [constraint_index, slack_index]: this->model.get_slacks()) {
+         if (this->decomposition.component_of_constraint[constraint_index] == this->component_index) {
+            this->slacks.insert(this->decomposition.local_index_of_constraint[constraint_index],
+                  this->decomposition.local_index_of_variable[slack_index]);
+         }
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (this->get_constraint_bound_type(constraint_index) == EQUAL_BOUNDS) {
+            this->equality_constraints.emplace_back(constraint_index);
+         }
+         else {
+            this->inequality_constraints.emplace_back(constraint_index);
+         }
+         if (this->get_constraint_type(constraint_index) == LINEAR) {
+            this->linear_constraints.emplace_back(constraint_index);
+         }
+      }
+   }
+
+   bool ComponentModel::contains_variable(size_t original_index) const {
+      return (this->decomposition.component_of_variable[original_index] == this->component_index);
+   }
+
+   const Vector<double>& ComponentModel::expand_point(const Vector<double>& x) const {
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->original_point[this->variables[variable_index]] = x[variable_index];
+      }
+      return this->original_point;
+   }
+
+   void ComponentModel::reduce_gradient(SparseVector<double>& gradient) const {
+      for (const auto [variable_index, derivative]: this->original_gradient) {
+         if (this->contains_variable(variable_index)) {
+            gradient.insert(this->decomposition.local_index_of_variable[variable_index], derivative);
+         }
+      }
+   }
+
+   double ComponentModel::evaluate_objective(const Vector<double>& x) const {
+      return this->model.evaluate_objective(this->expand_point(x));
+   }
+
+   void ComponentModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->original_gradient.clear();
+      this->model.evaluate_objective_gradient(this->expand_point(x), this->original_gradient);
+      this->reduce_gradient(gradient);
+   }
+
+   void ComponentModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      this->model.evaluate_constraints(this->expand_point(x), this->original_constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraints[constraint_index] = this->original_constraints[this->constraints[constraint_index]];
+      }
+   }
+
+   void ComponentModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      this->original_gradient.clear();
+      this->model.evaluate_constraint_gradient(this->expand_point(x), this->constraints[constraint_index], this->original_gradient);
+      this->reduce_gradient(gradient);
+   }
+
+   void ComponentModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      this->original_jacobian.clear();
+      this->model.evaluate_constraint_jacobian(this->expand_point(x), this->original_jacobian);
+      // the rows of the component only involve the variables of the component
+      const double* entries = this->original_jacobian.data_pointer();
+      const size_t* column_indices = this->original_jacobian.column_indices_pointer();
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         const size_t original_index = this->constraints[constraint_index];
+         const size_t row_start = this->original_jacobian.row_start(original_index);
+         const size_t row_end = row_start + this->original_jacobian.row_size(original_index);
+         for (size_t nonzero_index = row_start; nonzero_index < row_end; nonzero_index++) {
+            constraint_jacobian.insert(constraint_index, this->decomposition.local_index_of_variable[column_indices[nonzero_index]],
+                  entries[nonzero_index]);
+         }
+      }
+   }
+
+   void ComponentModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      // the multipliers of the other components are zero
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->original_multipliers[this->constraints[constraint_index]] = multipliers[constraint_index];
+      }
+      this->model.evaluate_lagrangian_hessian(this->expand_point(x), objective_multiplier, this->original_multipliers, this->original_hessian);
+      // keep the rows and columns of the component (the objective terms of the other components). The original Hessian is filled
+      // column by column and the local indices preserve the original order
+      hessian.reset();
+      size_t current_column = 0;
+      this->original_hessian.for_each([&](size_t row_index, size_t column_index, double entry) {
+         if (this->contains_variable(row_index) && this->contains_variable(column_index)) {
+            const size_t local_column_index = this->decomposition.local_index_of_variable[column_index];
+            while (current_column < local_column_index) {
+               hessian.finalize_column(current_column);
+               current_column++;
+            }
+            hessian.insert(entry, this->decomposition.local_index_of_variable[row_index], local_column_index);
+         }
+      });
+      for (; current_column < this->number_variables; current_column++) {
+         hessian.finalize_column(current_column);
+      }
+   }
+
+   void ComponentModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->original_multipliers[this->constraints[constraint_index]] = multipliers[constraint_index];
+      }
+      // the components of the other variables are zero
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->original_vector[this->variables[variable_index]] = vector[variable_index];
+      }
+      this->model.evaluate_lagrangian_hessian_vector_product(this->expand_point(x), objective_multiplier, this->original_multipliers,
+            this->original_vector, this->original_result);
+      for (size_t variable_index: Range(this->number_variables)) {
+         result[variable_index] = this->original_result[this->variables[variable_index]];
+      }
+   }
+
+   double ComponentModel::variable_lower_bound(size_t variable_index) const {
+      return this->model.variable_lower_bound(this->variables[variable_index]);
+   }
+
+   double ComponentModel::variable_upper_bound(size_t variable_index) const {
+      return this->model.variable_upper_bound(this->variables[variable_index]);
+   }
+
+   BoundType ComponentModel::get_variable_bound_type(size_t variable_index) const {
+      return this->model.get_variable_bound_type(this->variables[variable_index]);
+   }
+
+   const Collection<size_t>& ComponentModel::get_lower_bounded_variables() const {
+      return this->lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& ComponentModel::get_upper_bounded_variables() const {
+      return this->upper_bounded_variables_collection;
+   }
+
+   const SparseVector<size_t>& ComponentModel::get_slacks() const {
+      return this->slacks;
+   }
+
+   const Collection<size_t>& ComponentModel::get_single_lower_bounded_variables() const {
+      return this->single_lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& ComponentModel::get_single_upper_bounded_variables() const {
+      return this->single_upper_bounded_variables_collection;
+   }
+
+   const Vector<size_t>& ComponentModel::get_fixed_variables() const {
+      return this->fixed_variables;
+   }
+
+   double ComponentModel::constraint_lower_bound(size_t constraint_index) const {
+      return this->model.constraint_lower_bound(this->constraints[constraint_index]);
+   }
+
+   double ComponentModel::constraint_upper_bound(size_t constraint_index) const {
+      return this->model.constraint_upper_bound(this->constraints[constraint_index]);
+   }
+
+   FunctionType ComponentModel::get_objective_type() const {
+      return this->model.get_objective_type();
+   }
+
+   FunctionType ComponentModel::get_constraint_type(size_t constraint_index) const {
+      return this->model.get_constraint_type(this->constraints[constraint_index]);
+   }
+
+   BoundType ComponentModel::get_constraint_bound_type(size_t constraint_index) const {
+      return this->model.get_constraint_bound_type(this->constraints[constraint_index]);
+   }
+
+   const Collection<size_t>& ComponentModel::get_equality_constraints() const {
+      return this->equality_constraints_collection;
+   }
+
+   const Collection<size_t>& ComponentModel::get_inequality_constraints() const {
+      return this->inequality_constraints_collection;
+   }
+
+   const Collection<size_t>& ComponentModel::get_linear_constraints() const {
+      return this->linear_constraints_collection;
+   }
+
+   void ComponentModel::initial_primal_point(Vector<double>& x) const {
+      for (size_t variable_index: Range(this->number_variables)) {
+         x[variable_index] = this->reference_point[this->variables[variable_index]];
+      }
+   }
+
+   void ComponentModel::initial_dual_point(Vector<double>& multipliers) const {
+      Vector<double> original_multipliers(this->model.number_constraints);
+      this->model.initial_dual_point(original_multipliers);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         multipliers[constraint_index] = original_multipliers[this->constraints[constraint_index]];
+      }
+   }
+
+   void ComponentModel::postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const {
+      // the solutions of the components are merged and postprocessed by the original model
+   }
+
+   size_t ComponentModel::number_objective_gradient_nonzeros() const {
+      return this->number_variables;
+   }
+
+   size_t ComponentModel::number_jacobian_nonzeros() const {
+      return this->decomposition.jacobian_nonzeros[this->component_index];
+   }
+
+   size_t ComponentModel::number_hessian_nonzeros() const {
+      return this->decomposition.hessian_nonzeros[this->component_index];
+   }
+
+   void ComponentModel::set_current_point(const Vector<double>& x) const {
+      this->model.set_current_point(this->expand_point(x));
+   }
+
+   void ComponentModel::invalidate_point() const {
+      this->model.invalidate_point();
+   }
+
+   bool ComponentModel::supports_concurrent_evaluations() const {
+      // the workspaces in the original spaces are shared by the evaluations
+      return false;
+   }
+
+   bool ComponentModel::declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const {
+      std::vector<size_t> original_row_indices{}, original_column_indices{};
+      if (!this->model.declare_hessian_sparsity(original_row_indices, original_column_indices)) {
+         return false;
+      }
+      for (size_t nonzero_index: Range(original_row_indices.size())) {
+         const size_t row_index = original_row_indices[nonzero_index];
+         const size_t column_index = original_column_indices[nonzero_index];
+         if (this->contains_variable(row_index) && this->contains_variable(column_index)) {
+            row_indices.emplace_back(this->decomposition.local_index_of_variable[row_index]);
+            column_indices.emplace_back(this->decomposition.local_index_of_variable[column_index]);
+         }
+      }
+      return true;
+   }
+} // namespace
@@ -0,0 +1,114 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_COMPONENTMODEL_H
+#define UNO_COMPONENTMODEL_H
+
+#include <vector>
+#include "Model.hpp"
+#include "ModelDecomposition.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+
+namespace uno {
+   /*! \class ComponentModel
+    * \brief Non-owning view of an independent component of a model
+    *
+    *  The variables and constraints of the component (see ModelDecomposition) form a model of their own. The functions of the
+    *  original model are evaluated at the reference point in which the variables of the component are replaced, and restricted to
+    *  the component: the objective differs from the objective of the component by the (constant) terms of the other components.
+    *  The solution is left in the space of the component, to be merged with the other components by its owner
+    */
+   class ComponentModel: public Model {
+   public:
+      ComponentModel(const Model& model, const ModelDecomposition& decomposition, size_t component_index, const Vector<double>& reference_point);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override;
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override;
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override;
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override;
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override;
+      [[nodiscard]] FunctionType get_objective_type() const override;
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override;
+
+      void initial_primal_point(Vector<double>& x) const override;
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override;
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+      void set_current_point(const Vector<double>& x) const override;
+      void invalidate_point() const override;
+      [[nodiscard]] bool supports_concurrent_evaluations() const override;
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override;
+
+      // indices of a variable and a constraint of the component in the original model
+      [[nodiscard]] size_t original_variable_index(size_t variable_index) const { return this->variables[variable_index]; }
+      [[nodiscard]] size_t original_constraint_index(size_t constraint_index) const { return this->constraints[constraint_index]; }
+
+   private:
+      const Model& model;
+      const ModelDecomposition& decomposition;
+      const size_t component_index;
+      const std::vector<size_t>& variables;
+      const std::vector<size_t>& constraints;
+      const Vector<double>& reference_point;
+      Vector<size_t> lower_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> lower_bounded_variables_collection;
+      Vector<size_t> upper_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> upper_bounded_variables_collection;
+      Vector<size_t> single_lower_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> single_lower_bounded_variables_collection;
+      Vector<size_t> single_upper_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> single_upper_bounded_variables_collection;
+      Vector<size_t> fixed_variables{};
+      SparseVector<size_t> slacks{};
+      Vector<size_t> equality_constraints{};
+      CollectionAdapter<Vector<size_t>&> equality_constraints_collection;
+      Vector<size_t> inequality_constraints{};
+      CollectionAdapter<Vector<size_t>&> inequality_constraints_collection;
+      Vector<size_t> linear_constraints{};
+      CollectionAdapter<Vector<size_t>&> linear_constraints_collection;
+      // workspaces of the evaluations in the original spaces. The entries outside the component are not modified
+      mutable Vector<double> original_point;
+      mutable std::vector<double> original_constraints;
+      mutable Vector<double> original_multipliers;
+      mutable SparseVector<double> original_gradient;
+      mutable RectangularMatrix<double> original_jacobian;
+      mutable SymmetricMatrix<size_t, double> original_hessian;
+      mutable Vector<double> original_vector;
+      mutable Vector<double> original_result;
+
+      [[nodiscard]] bool contains_variable(size_t original_index) const;
+      // the reference point in which the variables of the component are replaced with x
+      [[nodiscard]] const Vector<double>& expand_point(const Vector<double>& x) const;
+      void reduce_gradient(SparseVector<double>& gradient) const;
+   };
+} // namespace
+
+#endif // UNO_COMPONENTMODEL_H
@@ -0,0 +1,112 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include "DenseQuasiNewtonModel.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   DenseQuasiNewtonModel::DenseQuasiNewtonModel(std::unique_ptr<Model> original_model, QuasiNewtonUpdate update_formula):
+         QuasiNewtonModel(update_formula == QuasiNewtonUpdate::BFGS ? " -> BFGS" : " -> SR1", std::move(original_model)),
+         update_formula(update_formula) {
+      this->reset_approximation();
+   }
+
+   void DenseQuasiNewtonModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      this->update(x, objective_multiplier, multipliers);
+      hessian.reset();
+      // upper triangle, column by column
+      for (size_t column_index: Range(this->number_variables)) {
+         for (size_t row_index: Range(column_index + 1)) {
+            hessian.insert(this->matrix[row_index + column_index * this->number_variables], row_index, column_index);
+         }
+         hessian.finalize_column(column_index);
+      }
+   }
+
+   void DenseQuasiNewtonModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      this->update(x, objective_multiplier, multipliers);
+      this->compute_product(vector, result);
+   }
+
+   void DenseQuasiNewtonModel::add_pair(Vector<double>&& s, Vector<double>&& y) const {
+      const double sy = dot(s, y);
+      const double yy = dot(y, y);
+      // scale the initial matrix with the curvature of the first pair
+      if (this->is_initial_matrix && 0. < sy) {
+         for (size_t variable_index: Range(this->number_variables)) {
+            this->matrix[variable_index + variable_index * this->number_variables] = yy / sy;
+         }
+      }
+      Vector<double> Bs(this->number_variables);
+      this->compute_product(s, Bs);
+      const double sBs = dot(s, Bs);
+
+      if (this->update_formula == QuasiNewtonUpdate::BFGS) {
+         // Powell damping: keep the curvature s^T y sufficiently positive with respect to s^T B s
+         double damped_sy = sy;
+         if (sy < 0.2 * sBs) {
+            const double theta = 0.8 * sBs / (sBs - sy);
+            for (size_t variable_index: Range(this->number_variables)) {
+               y[variable_index] = theta * y[variable_index] + (1. - theta) * Bs[variable_index];
+            }
+            damped_sy = dot(s, y);
+         }
+         if (damped_sy <= 1e-8 * std::sqrt(dot(s, s) * dot(y, y)) || sBs <= 0.) {
+            return;
+         }
+         // B+ = B - Bs (Bs)^T / s^T B s + y y^T / s^T y
+         this->add_rank_one_term(-1. / sBs, Bs);
+         this->add_rank_one_term(1. / damped_sy, y);
+      }
+      else {
+         // B+ = B + r r^T / s^T r, with r = y - Bs
+         Vector<double> r(this->number_variables);
+         for (size_t variable_index: Range(this->number_variables)) {
+            r[variable_index] = y[variable_index] - Bs[variable_index];
+         }
+         const double sr = dot(s, r);
+         if (std::abs(sr) <= 1e-8 * std::sqrt(dot(s, s) * dot(r, r))) {
+            return;
+         }
+         this->add_rank_one_term(1. / sr, r);
+      }
+      this->is_initial_matrix = false;
+   }
+
+   void DenseQuasiNewtonModel::reset_approximation() const {
+      this->matrix.assign(this->number_variables * this->number_variables, 0.);
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->matrix[variable_index + variable_index * this->number_variables] = 1.;
+      }
+      this->is_initial_matrix = true;
+   }
+
+   void DenseQuasiNewtonModel::compute_product(const Vector<double>& vector, Vector<double>& result) const {
+      for (size_t row_index: Range(this->number_variables)) {
+         result[row_index] = 0.;
+      }
+      for (size_t column_index: Range(this->number_variables)) {
+         const double coefficient = vector[column_index];
+         if (coefficient != 0.) {
+            const double* column = this->matrix.data() + column_index * this->number_variables;
+            for (size_t row_index: Range(this->number_variables)) {
+               result[row_index] += column[row_index] * coefficient;
+            }
+         }
+      }
+   }
+
+   void DenseQuasiNewtonModel::add_rank_one_term(double coefficient, const Vector<double>& u) const {
+      for (size_t column_index: Range(this->number_variables)) {
+         const double scaled_entry = coefficient * u[column_index];
+         double* column = this->matrix.data() + column_index * this->number_variables;
+         for (size_t row_index: Range(this->number_variables)) {
+            column[row_index] += scaled_entry * u[row_index];
+         }
+      }
+   }
+} // namespace
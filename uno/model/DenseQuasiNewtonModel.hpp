@@ -0,0 +1,44 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DENSEQUASINEWTONMODEL_H
+#define UNO_DENSEQUASINEWTONMODEL_H
+
+#include <vector>
+#include "QuasiNewtonModel.hpp"
+
+namespace uno {
+   enum class QuasiNewtonUpdate {BFGS, SR1};
+
+   /*! \class DenseQuasiNewtonModel
+    * \brief Model whose Lagrangian Hessian is replaced by a dense quasi-Newton matrix, for small problems
+    *
+    *  BFGS: Powell-damped update, the matrix remains positive definite.
+    *  SR1: the update is skipped when |s^T (y - Bs)| is small. The matrix may become indefinite and is then convexified by the Hessian model.
+    *  The initial matrix delta I is scaled with delta = y^T y / s^T y at the first pair
+    */
+   class DenseQuasiNewtonModel: public QuasiNewtonModel {
+   public:
+      DenseQuasiNewtonModel(std::unique_ptr<Model> original_model, QuasiNewtonUpdate update_formula);
+
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+
+   protected:
+      void add_pair(Vector<double>&& s, Vector<double>&& y) const override;
+      void reset_approximation() const override;
+
+   private:
+      const QuasiNewtonUpdate update_formula;
+      mutable std::vector<double> matrix; /*!< column-major, both triangles */
+      mutable bool is_initial_matrix{true};
+
+      void compute_product(const Vector<double>& vector, Vector<double>& result) const;
+      // B += coefficient u u^T
+      void add_rank_one_term(double coefficient, const Vector<double>& u) const;
+   };
+} // namespace
+
+#endif // UNO_DENSEQUASINEWTONMODEL_H
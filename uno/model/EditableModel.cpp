@@ -0,0 +1,240 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include <string>
+#include "EditableModel.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   namespace {
+      BoundType bound_type(double lower_bound, double upper_bound) {
+         if (lower_bound == upper_bound) {
+            return EQUAL_BOUNDS;
+         }
+         else if (is_finite(lower_bound) && is_finite(upper_bound)) {
+            return BOUNDED_BOTH_SIDES;
+         }
+         else if (is_finite(lower_bound)) {
+            return BOUNDED_LOWER;
+         }
+         else if (is_finite(upper_bound)) {
+            return BOUNDED_UPPER;
+         }
+         return UNBOUNDED;
+      }
+
+      void check_bounds(double lower_bound, double upper_bound) {
+         if (upper_bound < lower_bound) {
+            throw std::invalid_argument("The lower bound should not be larger than the upper bound");
+         }
+      }
+   } // namespace
+
+   EditableModel::EditableModel(std::unique_ptr<Model> original_model, size_t maximum_number_linear_constraints,
+         size_t maximum_linear_constraint_nonzeros):
+         Model(original_model->name, original_model->number_variables, original_model->number_constraints + maximum_number_linear_constraints,
+               original_model->objective_sign),
+         // transfer ownership of the pointer
+         model(std::move(original_model)),
+         maximum_linear_constraint_nonzeros(maximum_linear_constraint_nonzeros),
+         variable_lower_bounds(this->number_variables),
+         variable_upper_bounds(this->number_variables),
+         // the slots are unbounded
+         constraint_lower_bounds(this->number_constraints, -INF<double>),
+         constraint_upper_bounds(this->number_constraints, INF<double>),
+         linear_constraints_coefficients(maximum_number_linear_constraints),
+         is_slot_used(maximum_number_linear_constraints, false) {
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->variable_lower_bounds[variable_index] = this->model->variable_lower_bound(variable_index);
+         this->variable_upper_bounds[variable_index] = this->model->variable_upper_bound(variable_index);
+      }
+      for (size_t constraint_index: Range(this->model->number_constraints)) {
+         this->constraint_lower_bounds[constraint_index] = this->model->constraint_lower_bound(constraint_index);
+         this->constraint_upper_bounds[constraint_index] = this->model->constraint_upper_bound(constraint_index);
+      }
+      // the original linear constraints, followed by the slots
+      for (size_t constraint_index: this->model->get_linear_constraints()) {
+         this->linear_constraints.insert(constraint_index);
+      }
+      this->linear_constraints.insert(this->model->number_constraints, this->number_constraints);
+      this->register_collections();
+      this->changes.no_changes();
+   }
+
+   void EditableModel::set_variable_bounds(size_t variable_index, double lower_bound, double upper_bound) {
+      check_bounds(lower_bound, upper_bound);
+      this->variable_lower_bounds[variable_index] = lower_bound;
+      this->variable_upper_bounds[variable_index] = upper_bound;
+      this->changes.variable_bounds_changed = true;
+   }
+
+   void EditableModel::set_variable_bounds(const std::vector<BoundChange>& bound_changes) {
+      for (const BoundChange& bound_change: bound_changes) {
+         this->set_variable_bounds(bound_change.variable_index, bound_change.lower_bound, bound_change.upper_bound);
+      }
+   }
+
+   void EditableModel::fix_variable(size_t variable_index, double value) {
+      this->set_variable_bounds(variable_index, value, value);
+   }
+
+   // an original constraint is removed by relaxing its bounds
+   void EditableModel::set_constraint_bounds(size_t constraint_index, double lower_bound, double upper_bound) {
+      check_bounds(lower_bound, upper_bound);
+      if (this->is_added_constraint(constraint_index) && !this->is_slot_used[constraint_index - this->model->number_constraints]) {
+         throw std::invalid_argument("The constraint " + std::to_string(constraint_index) + " is a free slot");
+      }
+      this->constraint_lower_bounds[constraint_index] = lower_bound;
+      this->constraint_upper_bounds[constraint_index] = upper_bound;
+      this->changes.constraint_bounds_changed = true;
+   }
+
+   // the first free slot is used
+   size_t EditableModel::add_linear_constraint(const SparseVector<double>& coefficients, double lower_bound, double upper_bound) {
+      check_bounds(lower_bound, upper_bound);
+      for (const auto [variable_index, coefficient]: coefficients) {
+         if (this->number_variables <= variable_index) {
+            throw std::invalid_argument("The linear constraint has a coefficient for the variable " + std::to_string(variable_index) +
+               ", but the model has " + std::to_string(this->number_variables) + " variables");
+         }
+      }
+      size_t slot_index = 0;
+      while (slot_index < this->is_slot_used.size() && this->is_slot_used[slot_index]) {
+         slot_index++;
+      }
+      if (slot_index == this->is_slot_used.size()) {
+         throw std::runtime_error("All the " + std::to_string(this->is_slot_used.size()) + " linear constraint slots are used");
+      }
+      if (this->maximum_linear_constraint_nonzeros < this->number_added_nonzeros + coefficients.size()) {
+         throw std::runtime_error("The linear constraints exceed the " + std::to_string(this->maximum_linear_constraint_nonzeros) +
+            " reserved nonzeros");
+      }
+      this->linear_constraints_coefficients[slot_index] = coefficients;
+      this->is_slot_used[slot_index] = true;
+      this->number_added_constraints++;
+      this->number_added_nonzeros += coefficients.size();
+      const size_t constraint_index = this->model->number_constraints + slot_index;
+      this->constraint_lower_bounds[constraint_index] = lower_bound;
+      this->constraint_upper_bounds[constraint_index] = upper_bound;
+      this->changes.constraints_changed = true;
+      this->changes.constraint_bounds_changed = true;
+      this->changes.jacobian_sparsity_changed = true;
+      return constraint_index;
+   }
+
+   // the slot is freed (unbounded constraint without nonzeros)
+   void EditableModel::remove_linear_constraint(size_t constraint_index) {
+      if (!this->is_added_constraint(constraint_index) || constraint_index >= this->number_constraints ||
+            !this->is_slot_used[constraint_index - this->model->number_constraints]) {
+         throw std::invalid_argument("The constraint " + std::to_string(constraint_index) + " is not an appended linear constraint");
+      }
+      const size_t slot_index = constraint_index - this->model->number_constraints;
+      this->number_added_constraints--;
+      this->number_added_nonzeros -= this->linear_constraints_coefficients[slot_index].size();
+      this->linear_constraints_coefficients[slot_index].clear();
+      this->is_slot_used[slot_index] = false;
+      this->constraint_lower_bounds[constraint_index] = -INF<double>;
+      this->constraint_upper_bounds[constraint_index] = INF<double>;
+      this->changes.constraints_changed = true;
+      this->changes.constraint_bounds_changed = true;
+      this->changes.jacobian_sparsity_changed = true;
+   }
+
+   // the original model evaluates the first constraints
+   void EditableModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      this->model->evaluate_constraints(x, constraints);
+      for (size_t slot_index: Range(this->linear_constraints_coefficients.size())) {
+         double value = 0.;
+         for (const auto [variable_index, coefficient]: this->linear_constraints_coefficients[slot_index]) {
+            value += coefficient * x[variable_index];
+         }
+         constraints[this->model->number_constraints + slot_index] = value;
+      }
+   }
+
+   void EditableModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      if (this->is_added_constraint(constraint_index)) {
+         for (const auto [variable_index, coefficient]: this->linear_constraints_coefficients[constraint_index - this->model->number_constraints]) {
+            gradient.insert(variable_index, coefficient);
+         }
+      }
+      else {
+         this->model->evaluate_constraint_gradient(x, constraint_index, gradient);
+      }
+   }
+
+   void EditableModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      this->model->evaluate_constraint_jacobian(x, constraint_jacobian);
+      for (size_t slot_index: Range(this->linear_constraints_coefficients.size())) {
+         auto row = constraint_jacobian[this->model->number_constraints + slot_index];
+         for (const auto [variable_index, coefficient]: this->linear_constraints_coefficients[slot_index]) {
+            row.insert(variable_index, coefficient);
+         }
+      }
+   }
+
+   BoundType EditableModel::get_variable_bound_type(size_t variable_index) const {
+      return bound_type(this->variable_lower_bounds[variable_index], this->variable_upper_bounds[variable_index]);
+   }
+
+   FunctionType EditableModel::get_constraint_type(size_t constraint_index) const {
+      return this->is_added_constraint(constraint_index) ? LINEAR : this->model->get_constraint_type(constraint_index);
+   }
+
+   BoundType EditableModel::get_constraint_bound_type(size_t constraint_index) const {
+      return bound_type(this->constraint_lower_bounds[constraint_index], this->constraint_upper_bounds[constraint_index]);
+   }
+
+   void EditableModel::initial_dual_point(Vector<double>& multipliers) const {
+      this->model->initial_dual_point(multipliers);
+      for (size_t constraint_index: Range(this->model->number_constraints, this->number_constraints)) {
+         multipliers[constraint_index] = 0.;
+      }
+   }
+
+   void EditableModel::refresh() {
+      this->model->refresh();
+      this->register_collections();
+   }
+
+   // the index collections are recomputed from the bounds
+   void EditableModel::register_collections() {
+      this->lower_bounded_variables.clear();
+      this->upper_bounded_variables.clear();
+      this->single_lower_bounded_variables.clear();
+      this->single_upper_bounded_variables.clear();
+      this->fixed_variables.resize(0);
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double lower_bound = this->variable_lower_bounds[variable_index];
+         const double upper_bound = this->variable_upper_bounds[variable_index];
+         if (lower_bound == upper_bound) {
+            this->fixed_variables.emplace_back(variable_index);
+         }
+         if (is_finite(lower_bound)) {
+            this->lower_bounded_variables.insert(variable_index);
+            if (!is_finite(upper_bound)) {
+               this->single_lower_bounded_variables.insert(variable_index);
+            }
+         }
+         if (is_finite(upper_bound)) {
+            this->upper_bounded_variables.insert(variable_index);
+            if (!is_finite(lower_bound)) {
+               this->single_upper_bounded_variables.insert(variable_index);
+            }
+         }
+      }
+      this->equality_constraints.clear();
+      this->inequality_constraints.clear();
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         if (this->constraint_lower_bounds[constraint_index] == this->constraint_upper_bounds[constraint_index]) {
+            this->equality_constraints.insert(constraint_index);
+         }
+         else {
+            this->inequality_constraints.insert(constraint_index);
+         }
+      }
+   }
+} // namespace
@@ -0,0 +1,150 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_EDITABLEMODEL_H
+#define UNO_EDITABLEMODEL_H
+
+#include <memory>
+#include <vector>
+#include "Model.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "symbolic/IndexSet.hpp"
+
+namespace uno {
+   // new bounds of a variable (e.g. a branching decision of a branch-and-bound node with respect to its parent)
+   struct BoundChange {
+      size_t variable_index;
+      double lower_bound;
+      double upper_bound;
+   };
+
+   /*! \class EditableModel
+    * \brief Model modified in place between solves
+    *
+    *  Changes the bounds of the variables and constraints, fixes variables and appends linear constraints (e.g. the cuts of an
+    *  outer-approximation loop) without rebuilding the model, its reformulations and the strategies. The dimensions are fixed at
+    *  construction: a number of linear constraint slots (with a number of nonzeros) is reserved after the original constraints.
+    *  An empty slot is an unbounded linear constraint without nonzeros. The interior-point reformulation (one slack per inequality
+    *  constraint, the fixed variables moved to the constraints) requires that the numbers of inequality constraints and of fixed
+    *  variables remain those at the creation of the reformulation.
+    *  After a series of edits, call refresh() on the reformulated (outermost) model, then Uno::resolve with get_changes()
+    */
+   class EditableModel: public Model {
+   public:
+      EditableModel(std::unique_ptr<Model> original_model, size_t maximum_number_linear_constraints, size_t maximum_linear_constraint_nonzeros);
+
+      // edits. The constraint index of an appended linear constraint a^T x is returned
+      void set_variable_bounds(size_t variable_index, double lower_bound, double upper_bound);
+      void fix_variable(size_t variable_index, double value);
+      void set_variable_bounds(const std::vector<BoundChange>& bound_changes);
+      void set_constraint_bounds(size_t constraint_index, double lower_bound, double upper_bound);
+      size_t add_linear_constraint(const SparseVector<double>& coefficients, double lower_bound, double upper_bound);
+      void remove_linear_constraint(size_t constraint_index);
+      [[nodiscard]] size_t number_linear_constraints_added() const { return this->number_added_constraints; }
+      // the changes since the last call to clear_changes()
+      [[nodiscard]] const WarmstartInformation& get_changes() const { return this->changes; }
+      void clear_changes() { this->changes.no_changes(); }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override { return this->model->evaluate_objective(x); }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         this->model->evaluate_objective_gradient(x, gradient);
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      // the appended constraints are linear: they do not enter the Lagrangian Hessian
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         this->model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+      }
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override {
+         this->model->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->variable_lower_bounds[variable_index]; }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->variable_upper_bounds[variable_index]; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->lower_bounded_variables; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->model->get_slacks(); }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override {
+         return this->single_lower_bounded_variables;
+      }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+         return this->single_upper_bounded_variables;
+      }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->constraint_lower_bounds[constraint_index]; }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->constraint_upper_bounds[constraint_index]; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return this->model->get_objective_type(); }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->equality_constraints; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->inequality_constraints; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->linear_constraints; }
+
+      void initial_primal_point(Vector<double>& x) const override { this->model->initial_primal_point(x); }
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override {
+         this->model->postprocess_solution(iterate, termination_status);
+      }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->model->number_objective_gradient_nonzeros(); }
+      // the nonzeros of the reserved slots are counted
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override {
+         return this->model->number_jacobian_nonzeros() + this->maximum_linear_constraint_nonzeros;
+      }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->model->number_hessian_nonzeros(); }
+      void set_current_point(const Vector<double>& x) const override { this->model->set_current_point(x); }
+      void invalidate_point() const override { this->model->invalidate_point(); }
+      void refresh() override;
+      [[nodiscard]] bool supports_concurrent_evaluations() const override { return this->model->supports_concurrent_evaluations(); }
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override {
+         return this->model->declare_hessian_sparsity(row_indices, column_indices);
+      }
+      [[nodiscard]] bool get_user_variable_scaling(Vector<double>& scaling_factors) const override {
+         return this->model->get_user_variable_scaling(scaling_factors);
+      }
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override {
+         return this->model->get_initial_basis(variable_statuses, constraint_statuses);
+      }
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override {
+         return this->model->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers);
+      }
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override {
+         return this->model->get_stages(variable_stages, constraint_stages);
+      }
+
+   private:
+      const std::unique_ptr<Model> model{};
+      const size_t maximum_linear_constraint_nonzeros;
+      std::vector<double> variable_lower_bounds;
+      std::vector<double> variable_upper_bounds;
+      std::vector<double> constraint_lower_bounds;
+      std::vector<double> constraint_upper_bounds;
+      // coefficients of the slots (empty if the slot is free)
+      std::vector<SparseVector<double>> linear_constraints_coefficients;
+      std::vector<bool> is_slot_used;
+      size_t number_added_constraints{0};
+      size_t number_added_nonzeros{0};
+      WarmstartInformation changes{};
+
+      IndexSet lower_bounded_variables{};
+      IndexSet upper_bounded_variables{};
+      IndexSet single_lower_bounded_variables{};
+      IndexSet single_upper_bounded_variables{};
+      Vector<size_t> fixed_variables{};
+      IndexSet equality_constraints{};
+      IndexSet inequality_constraints{};
+      IndexSet linear_constraints{};
+
+      [[nodiscard]] bool is_added_constraint(size_t constraint_index) const { return this->model->number_constraints <= constraint_index; }
+      void register_collections();
+   };
+} // namespace
+
+#endif // UNO_EDITABLEMODEL_H
@@ -0,0 +1,105 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "EvaluationCacheModel.hpp"
+#include "optimization/EvaluationCounters.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   EvaluationCacheModel::EvaluationCacheModel(std::unique_ptr<Model> original_model, const Options& options):
+         Model(original_model->name, original_model->number_variables, original_model->number_constraints, original_model->objective_sign),
+         model(std::move(original_model)),
+         capacity(options.get_unsigned_int("evaluation_cache_size")) {
+      if (this->capacity == 0) {
+         throw std::invalid_argument("The size of the evaluation cache should be positive");
+      }
+   }
+
+   double EvaluationCacheModel::evaluate_objective(const Vector<double>& x) const {
+      CachedEvaluations& entry = this->find_or_insert(x);
+      if (entry.is_objective_computed) {
+         EvaluationCounters::current().cache_hits++;
+         return entry.objective;
+      }
+      EvaluationCounters::current().cache_misses++;
+      entry.objective = this->model->evaluate_objective(x);
+      entry.is_objective_computed = true;
+      return entry.objective;
+   }
+
+   void EvaluationCacheModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      CachedEvaluations& entry = this->find_or_insert(x);
+      if (entry.is_objective_gradient_computed) {
+         EvaluationCounters::current().cache_hits++;
+         for (const auto [variable_index, derivative]: entry.objective_gradient) {
+            gradient.insert(variable_index, derivative);
+         }
+         return;
+      }
+      EvaluationCounters::current().cache_misses++;
+      this->model->evaluate_objective_gradient(x, gradient);
+      entry.objective_gradient = gradient;
+      entry.is_objective_gradient_computed = true;
+   }
+
+   void EvaluationCacheModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      CachedEvaluations& entry = this->find_or_insert(x);
+      if (entry.are_constraints_computed) {
+         EvaluationCounters::current().cache_hits++;
+         std::copy(entry.constraints.cbegin(), entry.constraints.cend(), constraints.begin());
+         return;
+      }
+      EvaluationCounters::current().cache_misses++;
+      this->model->evaluate_constraints(x, constraints);
+      entry.constraints.assign(constraints.cbegin(), constraints.cbegin() + static_cast<std::ptrdiff_t>(this->number_constraints));
+      entry.are_constraints_computed = true;
+   }
+
+   // the functions may have been modified in place (e.g. appended cuts, new coefficients): the cached evaluations are discarded
+   void EvaluationCacheModel::refresh() {
+      this->model->refresh();
+      this->entries.clear();
+   }
+
+   // FNV-1a hash of the bit patterns of the primal variables
+   size_t EvaluationCacheModel::hash(const Vector<double>& x) const {
+      std::uint64_t hash = 14695981039346656037ULL;
+      for (size_t variable_index: Range(this->number_variables)) {
+         std::uint64_t bits;
+         std::memcpy(&bits, &x[variable_index], sizeof(bits));
+         hash = (hash ^ bits) * 1099511628211ULL;
+      }
+      return static_cast<size_t>(hash);
+   }
+
+   // returns the entry of the point x, after moving it to the front of the cache. If x is not cached, the least recently used
+   // entry is recycled
+   EvaluationCacheModel::CachedEvaluations& EvaluationCacheModel::find_or_insert(const Vector<double>& x) const {
+      const size_t point_hash = this->hash(x);
+      for (auto entry = this->entries.begin(); entry != this->entries.end(); ++entry) {
+         if (entry->hash == point_hash && std::equal(x.data(), x.data() + this->number_variables, entry->point.data())) {
+            this->entries.splice(this->entries.begin(), this->entries, entry);
+            return this->entries.front();
+         }
+      }
+      if (this->entries.size() < this->capacity) {
+         this->entries.emplace_front(CachedEvaluations{point_hash, Vector<double>(this->number_variables), false, 0., false,
+            std::vector<double>(this->number_constraints), false, SparseVector<double>(this->number_objective_gradient_nonzeros())});
+      }
+      else {
+         this->entries.splice(this->entries.begin(), this->entries, std::prev(this->entries.end()));
+      }
+      CachedEvaluations& entry = this->entries.front();
+      entry.hash = point_hash;
+      std::copy(x.data(), x.data() + this->number_variables, entry.point.data());
+      entry.is_objective_computed = false;
+      entry.are_constraints_computed = false;
+      entry.is_objective_gradient_computed = false;
+      return entry;
+   }
+} // namespace
@@ -0,0 +1,117 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_EVALUATIONCACHEMODEL_H
+#define UNO_EVALUATIONCACHEMODEL_H
+
+#include <list>
+#include <memory>
+#include <vector>
+#include "Model.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   /*! \class EvaluationCacheModel
+    * \brief Least-recently-used cache of the function evaluations of a model
+    *
+    *  The objective, the constraints and the objective gradient are stored for the last few points, keyed by a hash of the primal
+    *  vector (the points are compared exactly on a hash match). Evaluations at a point that was already visited (e.g. when iterates
+    *  are copied or when the restoration phase is entered or left) are served from the cache
+    */
+   class EvaluationCacheModel: public Model {
+   public:
+      EvaluationCacheModel(std::unique_ptr<Model> original_model, const Options& options);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override {
+         this->model->evaluate_constraint_gradient(x, constraint_index, gradient);
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+         this->model->evaluate_constraint_jacobian(x, constraint_jacobian);
+      }
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         this->model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+      }
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override {
+         this->model->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->model->variable_lower_bound(variable_index); }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->model->variable_upper_bound(variable_index); }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override { return this->model->get_variable_bound_type(variable_index); }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->model->get_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->model->get_upper_bounded_variables(); }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->model->get_slacks(); }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->model->get_single_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->model->get_single_upper_bounded_variables(); }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->model->get_fixed_variables(); }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->model->constraint_lower_bound(constraint_index); }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->model->constraint_upper_bound(constraint_index); }
+      [[nodiscard]] FunctionType get_objective_type() const override { return this->model->get_objective_type(); }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->model->get_constraint_type(constraint_index); }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override { return this->model->get_constraint_bound_type(constraint_index); }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->model->get_equality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->model->get_inequality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->model->get_linear_constraints(); }
+
+      void initial_primal_point(Vector<double>& x) const override { this->model->initial_primal_point(x); }
+      void initial_dual_point(Vector<double>& multipliers) const override { this->model->initial_dual_point(multipliers); }
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override {
+         this->model->postprocess_solution(iterate, termination_status);
+      }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->model->number_objective_gradient_nonzeros(); }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->model->number_jacobian_nonzeros(); }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->model->number_hessian_nonzeros(); }
+      void set_current_point(const Vector<double>& x) const override { this->model->set_current_point(x); }
+      void invalidate_point() const override { this->model->invalidate_point(); }
+      void refresh() override;
+      // the cache is shared by all the evaluations
+      [[nodiscard]] bool supports_concurrent_evaluations() const override { return false; }
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override {
+         return this->model->declare_hessian_sparsity(row_indices, column_indices);
+      }
+      [[nodiscard]] bool get_user_variable_scaling(Vector<double>& scaling_factors) const override {
+         return this->model->get_user_variable_scaling(scaling_factors);
+      }
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override {
+         return this->model->get_initial_basis(variable_statuses, constraint_statuses);
+      }
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override {
+         return this->model->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers);
+      }
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override {
+         return this->model->get_stages(variable_stages, constraint_stages);
+      }
+
+   private:
+      struct CachedEvaluations {
+         size_t hash;
+         Vector<double> point;
+         bool is_objective_computed{false};
+         double objective{0.};
+         bool are_constraints_computed{false};
+         std::vector<double> constraints;
+         bool is_objective_gradient_computed{false};
+         SparseVector<double> objective_gradient;
+      };
+
+      const std::unique_ptr<Model> model{};
+      const size_t capacity;
+      mutable std::list<CachedEvaluations> entries{}; // the most recently used entry comes first
+
+      [[nodiscard]] size_t hash(const Vector<double>& x) const;
+      [[nodiscard]] CachedEvaluations& find_or_insert(const Vector<double>& x) const;
+   };
+} // namespace
+
+#endif // UNO_EVALUATIONCACHEMODEL_H
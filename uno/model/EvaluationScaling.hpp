@@ -0,0 +1,31 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_EVALUATIONSCALING_H
+#define UNO_EVALUATIONSCALING_H
+
+#include <cstddef>
+
+namespace uno {
+   /*! \struct EvaluationScaling
+    * \brief Factors applied to the functions of a model while they are evaluated
+    *
+    *  The objective is multiplied by objective, the constraint j by constraints[j] and the derivatives with respect to the variable i
+    *  by variables[i] (see ScaledModel). A null array stands for unit factors. The bulk evaluators apply the factors while they
+    *  scatter the values into the output
+    */
+   struct EvaluationScaling {
+      double objective{1.};
+      const double* constraints{nullptr};
+      const double* variables{nullptr};
+
+      [[nodiscard]] double constraint(size_t constraint_index) const {
+         return (this->constraints != nullptr) ? this->constraints[constraint_index] : 1.;
+      }
+      [[nodiscard]] double variable(size_t variable_index) const {
+         return (this->variables != nullptr) ? this->variables[variable_index] : 1.;
+      }
+   };
+} // namespace
+
+#endif // UNO_EVALUATIONSCALING_H
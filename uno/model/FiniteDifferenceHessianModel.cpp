@@ -0,0 +1,328 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include "FiniteDifferenceHessianModel.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Timeline.hpp"
+
+namespace uno {
+   namespace {
+      constexpr size_t UNCOLORED = std::numeric_limits<size_t>::max();
+   } // namespace
+
+   FiniteDifferenceHessianModel::FiniteDifferenceHessianModel(std::unique_ptr<Model> original_model, const Options& options):
+         Model(original_model->name + " -> finite-difference Hessian", original_model->number_variables, original_model->number_constraints,
+            original_model->objective_sign),
+         model(std::move(original_model)),
+         relative_step(options.get_double("finite_difference_relative_step")),
+         reference_workspace(this->create_workspace()),
+         steps(this->number_variables) {
+      if (this->relative_step <= 0.) {
+         throw std::invalid_argument("The finite-difference relative step should be positive");
+      }
+      this->compute_sparsity();
+      this->compute_star_coloring();
+      this->compute_recovery();
+      this->color_workspaces.reserve(this->number_colors());
+      for ([[maybe_unused]] size_t color: Range(this->number_colors())) {
+         this->color_workspaces.emplace_back(this->create_workspace());
+      }
+   }
+
+   void FiniteDifferenceHessianModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, SymmetricMatrix<size_t, double>& hessian) const {
+      // reference gradient
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->reference_workspace.point[variable_index] = x[variable_index];
+      }
+      this->evaluate_lagrangian_gradient(this->reference_workspace, objective_multiplier, multipliers);
+
+      // one perturbed gradient per color. The steps are representable in floating-point arithmetic
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double step = this->relative_step * std::max(1., std::abs(x[variable_index]));
+         this->steps[variable_index] = (x[variable_index] + step) - x[variable_index];
+      }
+      const int number_colors = static_cast<int>(this->number_colors());
+      std::vector<std::exception_ptr> evaluation_errors(this->number_colors());
+      // the worker threads record their evaluations in the timeline of the solving thread
+      Timeline* const timeline = Timeline::current();
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic) if(this->model->supports_concurrent_evaluations())
+#endif
+      for (int color_index = 0; color_index < number_colors; color_index++) {
+         const size_t color = static_cast<size_t>(color_index);
+         GradientWorkspace& workspace = this->color_workspaces[color];
+         // exceptions cannot leave the parallel region: they are raised again after the loop
+         try {
+            const Timeline::Event evaluation_event(timeline, "finite-difference gradient evaluation");
+            workspace.point = this->reference_workspace.point;
+            for (size_t index: Range(this->color_starts[color], this->color_starts[color + 1])) {
+               const size_t variable_index = this->color_variables[index];
+               workspace.point[variable_index] += this->steps[variable_index];
+            }
+            this->evaluate_lagrangian_gradient(workspace, objective_multiplier, multipliers);
+            for (size_t variable_index: Range(this->number_variables)) {
+               workspace.lagrangian_gradient[variable_index] -= this->reference_workspace.lagrangian_gradient[variable_index];
+            }
+         }
+         catch (...) {
+            evaluation_errors[color] = std::current_exception();
+         }
+      }
+      for (const std::exception_ptr& evaluation_error: evaluation_errors) {
+         if (evaluation_error) {
+            std::rethrow_exception(evaluation_error);
+         }
+      }
+
+      // recover the nonzeros directly: H_ij is read in row i of the group of column j, or in row j of the group of column i
+      hessian.reset();
+      for (size_t column_index: Range(this->number_variables)) {
+         for (size_t nonzero_index: Range(this->hessian_column_starts[column_index], this->hessian_column_starts[column_index + 1])) {
+            const size_t row_index = this->hessian_row_indices[nonzero_index];
+            const size_t color = this->recovery_colors[nonzero_index];
+            const Vector<double>& difference = this->color_workspaces[color].lagrangian_gradient;
+            const double entry = (color == this->colors[column_index]) ? difference[row_index] / this->steps[column_index] :
+               difference[column_index] / this->steps[row_index];
+            hessian.insert(entry, row_index, column_index);
+         }
+         hessian.finalize_column(column_index);
+      }
+   }
+
+   // directional difference of the Lagrangian gradients
+   void FiniteDifferenceHessianModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      double x_norm = 0.;
+      double vector_norm = 0.;
+      for (size_t variable_index: Range(this->number_variables)) {
+         x_norm = std::max(x_norm, std::abs(x[variable_index]));
+         vector_norm = std::max(vector_norm, std::abs(vector[variable_index]));
+      }
+      if (vector_norm == 0.) { // includes the case without variables
+         for (size_t variable_index: Range(this->number_variables)) {
+            result[variable_index] = 0.;
+         }
+         return;
+      }
+      const double step = this->relative_step * std::max(1., x_norm) / vector_norm;
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->reference_workspace.point[variable_index] = x[variable_index];
+      }
+      this->evaluate_lagrangian_gradient(this->reference_workspace, objective_multiplier, multipliers);
+      GradientWorkspace& workspace = this->color_workspaces[0];
+      for (size_t variable_index: Range(this->number_variables)) {
+         workspace.point[variable_index] = x[variable_index] + step * vector[variable_index];
+      }
+      this->evaluate_lagrangian_gradient(workspace, objective_multiplier, multipliers);
+      for (size_t variable_index: Range(this->number_variables)) {
+         result[variable_index] = (workspace.lagrangian_gradient[variable_index] - this->reference_workspace.lagrangian_gradient[variable_index]) / step;
+      }
+   }
+
+   // the sparsity is either declared by the model, or deduced from the first derivatives: (i, j) is a nonzero of the Hessian if x_i and
+   // x_j appear in the same nonlinear function
+   void FiniteDifferenceHessianModel::compute_sparsity() {
+      std::vector<std::vector<size_t>> neighbors(this->number_variables);
+      std::vector<bool> has_diagonal(this->number_variables, false);
+      std::vector<size_t> row_indices, column_indices;
+      if (this->model->declare_hessian_sparsity(row_indices, column_indices)) {
+         for (size_t nonzero_index: Range(row_indices.size())) {
+            const size_t row_index = row_indices[nonzero_index];
+            const size_t column_index = column_indices[nonzero_index];
+            if (row_index == column_index) {
+               has_diagonal[row_index] = true;
+            }
+            neighbors[row_index].emplace_back(column_index);
+            neighbors[column_index].emplace_back(row_index);
+         }
+      }
+      else {
+         Vector<double> initial_point(this->number_variables);
+         this->model->initial_primal_point(initial_point);
+         this->model->evaluate_objective_gradient(initial_point, this->reference_workspace.objective_gradient);
+         this->model->evaluate_constraint_jacobian(initial_point, this->reference_workspace.constraint_jacobian);
+
+         std::vector<size_t> support;
+         const auto add_clique = [&]() {
+            std::sort(support.begin(), support.end());
+            support.erase(std::unique(support.begin(), support.end()), support.end());
+            for (size_t variable_index: support) {
+               has_diagonal[variable_index] = true;
+               neighbors[variable_index].insert(neighbors[variable_index].end(), support.cbegin(), support.cend());
+            }
+         };
+         if (this->model->get_objective_type() != LINEAR) {
+            support.clear();
+            for (const auto [variable_index, derivative]: this->reference_workspace.objective_gradient) {
+               support.emplace_back(variable_index);
+            }
+            add_clique();
+         }
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            if (this->model->get_constraint_type(constraint_index) != LINEAR) {
+               support.clear();
+               for (const auto [variable_index, derivative]: this->reference_workspace.constraint_jacobian[constraint_index]) {
+                  support.emplace_back(variable_index);
+               }
+               add_clique();
+            }
+         }
+         this->reference_workspace.objective_gradient.clear();
+         this->reference_workspace.constraint_jacobian.clear();
+      }
+
+      // adjacency graph (without the diagonal) and upper triangle of the Hessian
+      this->adjacency_starts.assign(this->number_variables + 1, 0);
+      this->hessian_column_starts.assign(this->number_variables + 1, 0);
+      for (size_t variable_index: Range(this->number_variables)) {
+         std::vector<size_t>& variable_neighbors = neighbors[variable_index];
+         std::sort(variable_neighbors.begin(), variable_neighbors.end());
+         variable_neighbors.erase(std::unique(variable_neighbors.begin(), variable_neighbors.end()), variable_neighbors.end());
+         for (size_t neighbor: variable_neighbors) {
+            if (neighbor != variable_index) {
+               this->adjacency.emplace_back(neighbor);
+            }
+            if (neighbor < variable_index || (neighbor == variable_index && has_diagonal[variable_index])) {
+               this->hessian_row_indices.emplace_back(neighbor);
+            }
+         }
+         this->adjacency_starts[variable_index + 1] = this->adjacency.size();
+         this->hessian_column_starts[variable_index + 1] = this->hessian_row_indices.size();
+      }
+   }
+
+   // greedy star coloring: a distance-1 coloring in which every path on four vertices uses at least three colors
+   void FiniteDifferenceHessianModel::compute_star_coloring() {
+      this->colors.assign(this->number_variables, UNCOLORED);
+      // forbidden_colors[c] == v + 1 if the color c is forbidden for the vertex v
+      std::vector<size_t> forbidden_colors(this->number_variables + 1, 0);
+      std::vector<size_t> neighbor_color_count(this->number_variables + 1, 0);
+      size_t number_colors = 0;
+      for (size_t vertex: Range(this->number_variables)) {
+         const size_t stamp = vertex + 1;
+         const auto neighbors_begin = this->adjacency.cbegin() + static_cast<std::ptrdiff_t>(this->adjacency_starts[vertex]);
+         const auto neighbors_end = this->adjacency.cbegin() + static_cast<std::ptrdiff_t>(this->adjacency_starts[vertex + 1]);
+         for (auto neighbor = neighbors_begin; neighbor != neighbors_end; ++neighbor) {
+            if (this->colors[*neighbor] != UNCOLORED) {
+               forbidden_colors[this->colors[*neighbor]] = stamp;
+               neighbor_color_count[this->colors[*neighbor]]++;
+            }
+         }
+         for (auto neighbor = neighbors_begin; neighbor != neighbors_end; ++neighbor) {
+            const size_t neighbor_color = this->colors[*neighbor];
+            if (neighbor_color == UNCOLORED) {
+               continue;
+            }
+            for (size_t index: Range(this->adjacency_starts[*neighbor], this->adjacency_starts[*neighbor + 1])) {
+               const size_t second_neighbor = this->adjacency[index];
+               const size_t second_neighbor_color = this->colors[second_neighbor];
+               if (second_neighbor == vertex || second_neighbor_color == UNCOLORED || forbidden_colors[second_neighbor_color] == stamp) {
+                  continue;
+               }
+               // path u - vertex - neighbor - second_neighbor with color(u) == color(neighbor)
+               bool bicolored_path = (1 < neighbor_color_count[neighbor_color]);
+               // path vertex - neighbor - second_neighbor - y with color(y) == color(neighbor)
+               for (size_t third_index = this->adjacency_starts[second_neighbor]; !bicolored_path &&
+                     third_index < this->adjacency_starts[second_neighbor + 1]; third_index++) {
+                  const size_t third_neighbor = this->adjacency[third_index];
+                  bicolored_path = (third_neighbor != *neighbor && this->colors[third_neighbor] == neighbor_color);
+               }
+               if (bicolored_path) {
+                  forbidden_colors[second_neighbor_color] = stamp;
+               }
+            }
+         }
+         size_t color = 0;
+         while (forbidden_colors[color] == stamp) {
+            color++;
+         }
+         this->colors[vertex] = color;
+         number_colors = std::max(number_colors, color + 1);
+         for (auto neighbor = neighbors_begin; neighbor != neighbors_end; ++neighbor) {
+            if (this->colors[*neighbor] != UNCOLORED) {
+               neighbor_color_count[this->colors[*neighbor]] = 0;
+            }
+         }
+      }
+
+      // variables of each color
+      this->color_starts.assign(number_colors + 1, 0);
+      for (size_t color: this->colors) {
+         this->color_starts[color + 1]++;
+      }
+      for (size_t color: Range(number_colors)) {
+         this->color_starts[color + 1] += this->color_starts[color];
+      }
+      this->color_variables.resize(this->number_variables);
+      std::vector<size_t> positions(this->color_starts.cbegin(), this->color_starts.cend() - 1);
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->color_variables[positions[this->colors[variable_index]]++] = variable_index;
+      }
+   }
+
+   // H_ij can be read in the group of column j if no other column of the group has a nonzero in row i
+   void FiniteDifferenceHessianModel::compute_recovery() {
+      this->recovery_colors.resize(this->hessian_row_indices.size());
+      const auto is_unique_in_group = [&](size_t row_index, size_t column_index) {
+         for (size_t index: Range(this->adjacency_starts[row_index], this->adjacency_starts[row_index + 1])) {
+            const size_t other_column = this->adjacency[index];
+            if (other_column != column_index && this->colors[other_column] == this->colors[column_index]) {
+               return false;
+            }
+         }
+         return true;
+      };
+      for (size_t column_index: Range(this->number_variables)) {
+         for (size_t nonzero_index: Range(this->hessian_column_starts[column_index], this->hessian_column_starts[column_index + 1])) {
+            const size_t row_index = this->hessian_row_indices[nonzero_index];
+            if (is_unique_in_group(row_index, column_index)) {
+               this->recovery_colors[nonzero_index] = this->colors[column_index];
+            }
+            else if (is_unique_in_group(column_index, row_index)) {
+               this->recovery_colors[nonzero_index] = this->colors[row_index];
+            }
+            else {
+               throw std::runtime_error("FiniteDifferenceHessianModel: the coloring is not a star coloring");
+            }
+         }
+      }
+   }
+
+   FiniteDifferenceHessianModel::GradientWorkspace FiniteDifferenceHessianModel::create_workspace() const {
+      return {Vector<double>(this->number_variables), SparseVector<double>(this->number_variables),
+         RectangularMatrix<double>(this->number_constraints, this->number_variables), Vector<double>(this->number_variables)};
+   }
+
+   // sigma grad f(x) - J(x)^T lambda
+   void FiniteDifferenceHessianModel::evaluate_lagrangian_gradient(GradientWorkspace& workspace, double objective_multiplier,
+         const Vector<double>& multipliers) const {
+      workspace.lagrangian_gradient.fill(0.);
+      if (objective_multiplier != 0.) {
+         workspace.objective_gradient.clear();
+         this->model->evaluate_objective_gradient(workspace.point, workspace.objective_gradient);
+         for (const auto [variable_index, derivative]: workspace.objective_gradient) {
+            workspace.lagrangian_gradient[variable_index] += objective_multiplier * derivative;
+         }
+      }
+      if (0 < this->number_constraints) {
+         workspace.constraint_jacobian.clear();
+         this->model->evaluate_constraint_jacobian(workspace.point, workspace.constraint_jacobian);
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            const double multiplier = multipliers[constraint_index];
+            if (multiplier != 0.) {
+               for (const auto [variable_index, derivative]: workspace.constraint_jacobian[constraint_index]) {
+                  workspace.lagrangian_gradient[variable_index] -= multiplier * derivative;
+               }
+            }
+         }
+      }
+   }
+} // namespace
@@ -0,0 +1,132 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FINITEDIFFERENCEHESSIANMODEL_H
+#define UNO_FINITEDIFFERENCEHESSIANMODEL_H
+
+#include <memory>
+#include <vector>
+#include "Model.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   /*! \class FiniteDifferenceHessianModel
+    * \brief Model whose Lagrangian Hessian is approximated by finite differences of the Lagrangian gradients
+    *
+    *  The sparsity of the Hessian is deduced from the sparsity of the first derivatives: (i, j) is a nonzero if x_i and x_j appear
+    *  in the same function. The columns are grouped by a star coloring of the adjacency graph (Gebremedhin, Manne and Pothen, 2005),
+    *  so that a Hessian costs one gradient evaluation per color. Each nonzero is recovered directly from one of the two
+    *  groups of its row and column. The perturbed gradients are evaluated in parallel when the model supports concurrent evaluations
+    */
+   class FiniteDifferenceHessianModel: public Model {
+   public:
+      FiniteDifferenceHessianModel(std::unique_ptr<Model> original_model, const Options& options);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override { return this->model->evaluate_objective(x); }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         this->model->evaluate_objective_gradient(x, gradient);
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         this->model->evaluate_constraints(x, constraints);
+      }
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override {
+         this->model->evaluate_constraint_gradient(x, constraint_index, gradient);
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+         this->model->evaluate_constraint_jacobian(x, constraint_jacobian);
+      }
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->model->variable_lower_bound(variable_index); }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->model->variable_upper_bound(variable_index); }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override { return this->model->get_variable_bound_type(variable_index); }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->model->get_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->model->get_upper_bounded_variables(); }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->model->get_slacks(); }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->model->get_single_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->model->get_single_upper_bounded_variables(); }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->model->get_fixed_variables(); }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->model->constraint_lower_bound(constraint_index); }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->model->constraint_upper_bound(constraint_index); }
+      [[nodiscard]] FunctionType get_objective_type() const override { return this->model->get_objective_type(); }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->model->get_constraint_type(constraint_index); }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override { return this->model->get_constraint_bound_type(constraint_index); }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->model->get_equality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->model->get_inequality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->model->get_linear_constraints(); }
+
+      void initial_primal_point(Vector<double>& x) const override { this->model->initial_primal_point(x); }
+      void initial_dual_point(Vector<double>& multipliers) const override { this->model->initial_dual_point(multipliers); }
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override {
+         this->model->postprocess_solution(iterate, termination_status);
+      }
+      void evaluate_batch(BatchEvaluation& evaluation) const override { this->model->evaluate_batch(evaluation); }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->model->number_objective_gradient_nonzeros(); }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->model->number_jacobian_nonzeros(); }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->hessian_row_indices.size(); }
+      void set_current_point(const Vector<double>& x) const override { this->model->set_current_point(x); }
+      void invalidate_point() const override { this->model->invalidate_point(); }
+      void refresh() override { this->model->refresh(); }
+      [[nodiscard]] bool supports_concurrent_evaluations() const override { return this->model->supports_concurrent_evaluations(); }
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override {
+         return this->model->declare_hessian_sparsity(row_indices, column_indices);
+      }
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override {
+         return this->model->get_initial_basis(variable_statuses, constraint_statuses);
+      }
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override {
+         return this->model->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers);
+      }
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override {
+         return this->model->get_stages(variable_stages, constraint_stages);
+      }
+
+      [[nodiscard]] size_t number_colors() const { return this->color_starts.size() - 1; }
+      [[nodiscard]] const std::vector<size_t>& get_colors() const { return this->colors; }
+
+   private:
+      // workspace of the evaluation of a Lagrangian gradient (one per color, so that the colors can be evaluated concurrently)
+      struct GradientWorkspace {
+         Vector<double> point;
+         SparseVector<double> objective_gradient;
+         RectangularMatrix<double> constraint_jacobian;
+         Vector<double> lagrangian_gradient;
+      };
+
+      const std::unique_ptr<Model> model{};
+      const double relative_step;
+      // adjacency graph of the Hessian (CSR, without the diagonal)
+      std::vector<size_t> adjacency_starts{};
+      std::vector<size_t> adjacency{};
+      // colors of the variables and variables of each color (CSR)
+      std::vector<size_t> colors{};
+      std::vector<size_t> color_starts{};
+      std::vector<size_t> color_variables{};
+      // upper triangle of the Hessian (CSC) and color of the group from which each nonzero is recovered
+      std::vector<size_t> hessian_column_starts{};
+      std::vector<size_t> hessian_row_indices{};
+      std::vector<size_t> recovery_colors{};
+
+      mutable GradientWorkspace reference_workspace;
+      mutable std::vector<GradientWorkspace> color_workspaces{};
+      mutable Vector<double> steps;
+
+      void compute_sparsity();
+      void compute_star_coloring();
+      void compute_recovery();
+      [[nodiscard]] GradientWorkspace create_workspace() const;
+      void evaluate_lagrangian_gradient(GradientWorkspace& workspace, double objective_multiplier, const Vector<double>& multipliers) const;
+   };
+} // namespace
+
+#endif // UNO_FINITEDIFFERENCEHESSIANMODEL_H
@@ -1,6 +1,7 @@
 // Copyright (c) 2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <stdexcept>
 #include "FixedBoundsConstraintsModel.hpp"
 #include "optimization/Iterate.hpp"
 
@@ -74,6 +75,21 @@ namespace uno {
       this->model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
    }
 
+   void FixedBoundsConstraintsModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      // the bound constraints of the fixed variables are linear
+      this->model->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+   }
+
+   size_t FixedBoundsConstraintsModel::hessian_low_rank_dimension() const {
+      return this->model->hessian_low_rank_dimension();
+   }
+
+   void FixedBoundsConstraintsModel::evaluate_hessian_low_rank_term(Vector<double>& factors, size_t leading_dimension,
+         Vector<double>& middle_matrix) const {
+      this->model->evaluate_hessian_low_rank_term(factors, leading_dimension, middle_matrix);
+   }
+
    double FixedBoundsConstraintsModel::variable_lower_bound(size_t variable_index) const {
       if (this->model->variable_lower_bound(variable_index) == this->model->variable_upper_bound(variable_index)) {
       // remove bounds of fixed variables
@@ -148,6 +164,10 @@ namespace uno {
       }
    }
 
+   FunctionType FixedBoundsConstraintsModel::get_objective_type() const {
+      return this->model->get_objective_type();
+   }
+
    FunctionType FixedBoundsConstraintsModel::get_constraint_type(size_t constraint_index) const {
       if (constraint_index < this->model->number_constraints) {
 // original constraint
@@ -219,4 +239,59 @@ namespace uno {
    size_t FixedBoundsConstraintsModel::number_hessian_nonzeros() const {
       return this->model->number_hessian_nonzeros();
    }
-} // namespace
\ No newline at end of file
+
+   void FixedBoundsConstraintsModel::set_current_point(const Vector<double>& x) const {
+      this->model->set_current_point(x);
+   }
+
+   void FixedBoundsConstraintsModel::invalidate_point() const {
+      this->model->invalidate_point();
+   }
+
+   void FixedBoundsConstraintsModel::refresh() {
+      this->model->refresh();
+      // the number of general constraints depends on the number of fixed variables
+      if (this->model->get_fixed_variables().size() != this->number_constraints - this->model->number_constraints) {
+         throw std::runtime_error("The number of fixed variables cannot be modified in place");
+      }
+      this->lower_bounded_variables.resize(0);
+      this->upper_bounded_variables.resize(0);
+      for (size_t variable_index: Range(this->model->number_variables)) {
+         if (is_finite(this->variable_lower_bound(variable_index))) {
+            this->lower_bounded_variables.emplace_back(variable_index);
+         }
+         if (is_finite(this->variable_upper_bound(variable_index))) {
+            this->upper_bounded_variables.emplace_back(variable_index);
+         }
+      }
+   }
+
+   bool FixedBoundsConstraintsModel::supports_concurrent_evaluations() const {
+      return this->model->supports_concurrent_evaluations();
+   }
+
+   // the bounds of the fixed variables are general constraints: their multipliers are discarded
+   bool FixedBoundsConstraintsModel::get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const {
+      if (!this->model->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers)) {
+         return false;
+      }
+      for (size_t variable_index: this->model->get_fixed_variables()) {
+         lower_bound_multipliers[variable_index] = 0.;
+         upper_bound_multipliers[variable_index] = 0.;
+      }
+      return true;
+   }
+
+   // the constraints x_i = x_i^0 belong to the stage of the fixed variable
+   bool FixedBoundsConstraintsModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      if (!this->model->get_stages(variable_stages, constraint_stages)) {
+         return false;
+      }
+      size_t constraint_index = this->model->number_constraints;
+      for (size_t variable_index: this->model->get_fixed_variables()) {
+         constraint_stages[constraint_index] = variable_stages[variable_index];
+         constraint_index++;
+      }
+      return true;
+   }
+} // namespace
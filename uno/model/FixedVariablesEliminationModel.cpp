@@ -0,0 +1,357 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include "FixedVariablesEliminationModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "tools/AllocationTracker.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   namespace {
+      std::vector<size_t> find_free_variables(const Model& model) {
+         std::vector<size_t> free_variables{};
+         free_variables.reserve(model.number_variables);
+         for (size_t variable_index: Range(model.number_variables)) {
+            if (model.variable_lower_bound(variable_index) != model.variable_upper_bound(variable_index)) {
+               free_variables.emplace_back(variable_index);
+            }
+         }
+         return free_variables;
+      }
+   } // namespace
+
+   FixedVariablesEliminationModel::FixedVariablesEliminationModel(std::unique_ptr<Model> original_model):
+         Model(original_model->name + " -> fixed variables eliminated", find_free_variables(*original_model).size(),
+               original_model->number_constraints, original_model->objective_sign),
+         model(std::move(original_model)),
+         free_variables(find_free_variables(*this->model)),
+         reduced_indices(this->model->number_variables, ELIMINATED),
+         fixed_values(this->model->number_variables, 0.),
+         lower_bounded_variables_collection(this->lower_bounded_variables),
+         upper_bounded_variables_collection(this->upper_bounded_variables),
+         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
+         single_upper_bounded_variables_collection(this->single_upper_bounded_variables),
+         original_gradient(this->model->number_objective_gradient_nonzeros()),
+         original_jacobian(this->model->number_constraints, this->model->number_variables),
+         original_hessian(this->model->number_variables, this->model->number_hessian_nonzeros(), false, "COO"),
+         original_vector(this->model->number_variables, 0.),
+         original_result(this->model->number_variables) {
+      for (size_t variable_index: Range(this->model->number_variables)) {
+         if (this->model->variable_lower_bound(variable_index) == this->model->variable_upper_bound(variable_index)) {
+            this->fixed_values[variable_index] = this->model->variable_lower_bound(variable_index);
+         }
+      }
+      // the collections of the reduced model
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->reduced_indices[this->free_variables[variable_index]] = variable_index;
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double lower_bound = this->variable_lower_bound(variable_index);
+         const double upper_bound = this->variable_upper_bound(variable_index);
+         if (is_finite(lower_bound)) {
+            this->lower_bounded_variables.emplace_back(variable_index);
+            if (!is_finite(upper_bound)) {
+               this->single_lower_bounded_variables.emplace_back(variable_index);
+            }
+         }
+         if (is_finite(upper_bound)) {
+            this->upper_bounded_variables.emplace_back(variable_index);
+            if (!is_finite(lower_bound)) {
+               this->single_upper_bounded_variables.emplace_back(variable_index);
+            }
+         }
+      }
+      for (const auto [constraint_index, slack_index]: this->model->get_slacks()) {
+         if (this->reduced_indices[slack_index] != ELIMINATED) {
+            this->slacks.insert(constraint_index, this->reduced_indices[slack_index]);
+         }
+      }
+      DEBUG << (this->model->number_variables - this->number_variables) << " fixed variables were eliminated\n";
+   }
+
+   const Vector<double>& FixedVariablesEliminationModel::expand_point(const Vector<double>& x) const {
+      // one workspace per thread: the points may be evaluated concurrently
+      thread_local Vector<double> original_point{};
+      if (original_point.size() != this->model->number_variables) {
+         const AllocationTracker::Prohibition allowed_allocation(false);
+         original_point.resize(this->model->number_variables);
+      }
+      for (size_t variable_index: Range(this->model->number_variables)) {
+         const size_t reduced_index = this->reduced_indices[variable_index];
+         original_point[variable_index] = (reduced_index == ELIMINATED) ? this->fixed_values[variable_index] : x[reduced_index];
+      }
+      return original_point;
+   }
+
+   void FixedVariablesEliminationModel::reduce_gradient(SparseVector<double>& gradient) const {
+      for (const auto [variable_index, derivative]: this->original_gradient) {
+         const size_t reduced_index = this->reduced_indices[variable_index];
+         if (reduced_index != ELIMINATED) {
+            gradient.insert(reduced_index, derivative);
+         }
+      }
+   }
+
+   double FixedVariablesEliminationModel::evaluate_objective(const Vector<double>& x) const {
+      return this->model->evaluate_objective(this->expand_point(x));
+   }
+
+   void FixedVariablesEliminationModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->original_gradient.clear();
+      this->model->evaluate_objective_gradient(this->expand_point(x), this->original_gradient);
+      this->reduce_gradient(gradient);
+   }
+
+   void FixedVariablesEliminationModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      this->model->evaluate_constraints(this->expand_point(x), constraints);
+   }
+
+   void FixedVariablesEliminationModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index,
+         SparseVector<double>& gradient) const {
+      this->original_gradient.clear();
+      this->model->evaluate_constraint_gradient(this->expand_point(x), constraint_index, this->original_gradient);
+      this->reduce_gradient(gradient);
+   }
+
+   void FixedVariablesEliminationModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      this->original_jacobian.clear();
+      this->model->evaluate_constraint_jacobian(this->expand_point(x), this->original_jacobian);
+      // remove the columns of the fixed variables
+      const double* entries = this->original_jacobian.data_pointer();
+      const size_t* column_indices = this->original_jacobian.column_indices_pointer();
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         const size_t row_start = this->original_jacobian.row_start(constraint_index);
+         const size_t row_end = row_start + this->original_jacobian.row_size(constraint_index);
+         for (size_t nonzero_index = row_start; nonzero_index < row_end; nonzero_index++) {
+            const size_t reduced_index = this->reduced_indices[column_indices[nonzero_index]];
+            if (reduced_index != ELIMINATED) {
+               constraint_jacobian.insert(constraint_index, reduced_index, entries[nonzero_index]);
+            }
+         }
+      }
+   }
+
+   void FixedVariablesEliminationModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, SymmetricMatrix<size_t, double>& hessian) const {
+      this->model->evaluate_lagrangian_hessian(this->expand_point(x), objective_multiplier, multipliers, this->original_hessian);
+      // remove the rows and columns of the fixed variables. The original Hessian is filled column by column
+      hessian.reset();
+      size_t current_column = 0;
+      this->original_hessian.for_each([&](size_t row_index, size_t column_index, double entry) {
+         const size_t reduced_row_index = this->reduced_indices[row_index];
+         const size_t reduced_column_index = this->reduced_indices[column_index];
+         if (reduced_row_index != ELIMINATED && reduced_column_index != ELIMINATED) {
+            while (current_column < reduced_column_index) {
+               hessian.finalize_column(current_column);
+               current_column++;
+            }
+            hessian.insert(entry, reduced_row_index, reduced_column_index);
+         }
+      });
+      for (; current_column < this->number_variables; current_column++) {
+         hessian.finalize_column(current_column);
+      }
+   }
+
+   void FixedVariablesEliminationModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      // the components of the fixed variables are zero
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->original_vector[this->free_variables[variable_index]] = vector[variable_index];
+      }
+      this->model->evaluate_lagrangian_hessian_vector_product(this->expand_point(x), objective_multiplier, multipliers, this->original_vector,
+            this->original_result);
+      for (size_t variable_index: Range(this->number_variables)) {
+         result[variable_index] = this->original_result[this->free_variables[variable_index]];
+      }
+   }
+
+   double FixedVariablesEliminationModel::variable_lower_bound(size_t variable_index) const {
+      return this->model->variable_lower_bound(this->free_variables[variable_index]);
+   }
+
+   double FixedVariablesEliminationModel::variable_upper_bound(size_t variable_index) const {
+      return this->model->variable_upper_bound(this->free_variables[variable_index]);
+   }
+
+   BoundType FixedVariablesEliminationModel::get_variable_bound_type(size_t variable_index) const {
+      return this->model->get_variable_bound_type(this->free_variables[variable_index]);
+   }
+
+   const Collection<size_t>& FixedVariablesEliminationModel::get_lower_bounded_variables() const {
+      return this->lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& FixedVariablesEliminationModel::get_upper_bounded_variables() const {
+      return this->upper_bounded_variables_collection;
+   }
+
+   const SparseVector<size_t>& FixedVariablesEliminationModel::get_slacks() const {
+      return this->slacks;
+   }
+
+   const Collection<size_t>& FixedVariablesEliminationModel::get_single_lower_bounded_variables() const {
+      return this->single_lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& FixedVariablesEliminationModel::get_single_upper_bounded_variables() const {
+      return this->single_upper_bounded_variables_collection;
+   }
+
+   const Vector<size_t>& FixedVariablesEliminationModel::get_fixed_variables() const {
+      return this->fixed_variables;
+   }
+
+   double FixedVariablesEliminationModel::constraint_lower_bound(size_t constraint_index) const {
+      return this->model->constraint_lower_bound(constraint_index);
+   }
+
+   double FixedVariablesEliminationModel::constraint_upper_bound(size_t constraint_index) const {
+      return this->model->constraint_upper_bound(constraint_index);
+   }
+
+   FunctionType FixedVariablesEliminationModel::get_objective_type() const {
+      return this->model->get_objective_type();
+   }
+
+   FunctionType FixedVariablesEliminationModel::get_constraint_type(size_t constraint_index) const {
+      return this->model->get_constraint_type(constraint_index);
+   }
+
+   BoundType FixedVariablesEliminationModel::get_constraint_bound_type(size_t constraint_index) const {
+      return this->model->get_constraint_bound_type(constraint_index);
+   }
+
+   const Collection<size_t>& FixedVariablesEliminationModel::get_equality_constraints() const {
+      return this->model->get_equality_constraints();
+   }
+
+   const Collection<size_t>& FixedVariablesEliminationModel::get_inequality_constraints() const {
+      return this->model->get_inequality_constraints();
+   }
+
+   const Collection<size_t>& FixedVariablesEliminationModel::get_linear_constraints() const {
+      return this->model->get_linear_constraints();
+   }
+
+   void FixedVariablesEliminationModel::initial_primal_point(Vector<double>& x) const {
+      Vector<double> original_point(this->model->number_variables);
+      this->model->initial_primal_point(original_point);
+      for (size_t variable_index: Range(this->number_variables)) {
+         x[variable_index] = original_point[this->free_variables[variable_index]];
+      }
+   }
+
+   void FixedVariablesEliminationModel::initial_dual_point(Vector<double>& multipliers) const {
+      this->model->initial_dual_point(multipliers);
+   }
+
+   void FixedVariablesEliminationModel::postprocess_solution(Iterate& iterate, IterateStatus termination_status) const {
+      // reinsert the fixed variables. Since the original index of a free variable is not smaller than its reduced index, the
+      // primals and the bound multipliers are moved from the last variable to the first
+      iterate.set_number_variables(this->model->number_variables);
+      for (size_t variable_index = this->model->number_variables; 0 < variable_index; variable_index--) {
+         const size_t original_index = variable_index - 1;
+         const size_t reduced_index = this->reduced_indices[original_index];
+         if (reduced_index == ELIMINATED) {
+            iterate.primals[original_index] = this->fixed_values[original_index];
+            iterate.multipliers.lower_bounds[original_index] = 0.;
+            iterate.multipliers.upper_bounds[original_index] = 0.;
+         }
+         else {
+            iterate.primals[original_index] = iterate.primals[reduced_index];
+            iterate.multipliers.lower_bounds[original_index] = iterate.multipliers.lower_bounds[reduced_index];
+            iterate.multipliers.upper_bounds[original_index] = iterate.multipliers.upper_bounds[reduced_index];
+         }
+      }
+      // the bound multipliers of the fixed variables satisfy the stationarity of the Lagrangian: z = sigma grad f - J^T lambda
+      if (this->number_variables < this->model->number_variables) {
+         Vector<double> bound_multipliers(this->model->number_variables, 0.);
+         this->original_gradient.clear();
+         this->model->evaluate_objective_gradient(iterate.primals, this->original_gradient);
+         for (const auto [variable_index, derivative]: this->original_gradient) {
+            bound_multipliers[variable_index] += iterate.objective_multiplier * derivative;
+         }
+         this->original_jacobian.clear();
+         this->model->evaluate_constraint_jacobian(iterate.primals, this->original_jacobian);
+         const double* entries = this->original_jacobian.data_pointer();
+         const size_t* column_indices = this->original_jacobian.column_indices_pointer();
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            const size_t row_start = this->original_jacobian.row_start(constraint_index);
+            const size_t row_end = row_start + this->original_jacobian.row_size(constraint_index);
+            for (size_t nonzero_index = row_start; nonzero_index < row_end; nonzero_index++) {
+               bound_multipliers[column_indices[nonzero_index]] -= iterate.multipliers.constraints[constraint_index] * entries[nonzero_index];
+            }
+         }
+         for (size_t variable_index: Range(this->model->number_variables)) {
+            if (this->reduced_indices[variable_index] == ELIMINATED) {
+               if (0. < bound_multipliers[variable_index]) {
+                  iterate.multipliers.lower_bounds[variable_index] = bound_multipliers[variable_index];
+               }
+               else {
+                  iterate.multipliers.upper_bounds[variable_index] = bound_multipliers[variable_index];
+               }
+            }
+         }
+      }
+      this->model->postprocess_solution(iterate, termination_status);
+   }
+
+   size_t FixedVariablesEliminationModel::number_objective_gradient_nonzeros() const {
+      return this->model->number_objective_gradient_nonzeros();
+   }
+
+   size_t FixedVariablesEliminationModel::number_jacobian_nonzeros() const {
+      return this->model->number_jacobian_nonzeros();
+   }
+
+   size_t FixedVariablesEliminationModel::number_hessian_nonzeros() const {
+      return this->model->number_hessian_nonzeros();
+   }
+
+   void FixedVariablesEliminationModel::set_current_point(const Vector<double>& x) const {
+      this->model->set_current_point(this->expand_point(x));
+   }
+
+   void FixedVariablesEliminationModel::invalidate_point() const {
+      this->model->invalidate_point();
+   }
+
+   void FixedVariablesEliminationModel::refresh() {
+      // the eliminated variables are those fixed at the creation of the reformulation
+      throw std::runtime_error("The elimination of the fixed variables does not support in-place modifications of the model");
+   }
+
+   bool FixedVariablesEliminationModel::supports_concurrent_evaluations() const {
+      return this->model->supports_concurrent_evaluations();
+   }
+
+   bool FixedVariablesEliminationModel::declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const {
+      std::vector<size_t> original_row_indices{}, original_column_indices{};
+      if (!this->model->declare_hessian_sparsity(original_row_indices, original_column_indices)) {
+         return false;
+      }
+      for (size_t nonzero_index: Range(original_row_indices.size())) {
+         const size_t reduced_row_index = this->reduced_indices[original_row_indices[nonzero_index]];
+         const size_t reduced_column_index = this->reduced_indices[original_column_indices[nonzero_index]];
+         if (reduced_row_index != ELIMINATED && reduced_column_index != ELIMINATED) {
+            row_indices.emplace_back(reduced_row_index);
+            column_indices.emplace_back(reduced_column_index);
+         }
+      }
+      return true;
+   }
+
+   bool FixedVariablesEliminationModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      std::vector<size_t> original_variable_stages(this->model->number_variables, Model::no_stage);
+      if (!this->model->get_stages(original_variable_stages, constraint_stages)) {
+         return false;
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         variable_stages[variable_index] = original_variable_stages[this->free_variables[variable_index]];
+      }
+      return true;
+   }
+} // namespace
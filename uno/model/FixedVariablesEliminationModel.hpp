@@ -0,0 +1,105 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FIXEDVARIABLESELIMINATIONMODEL_H
+#define UNO_FIXEDVARIABLESELIMINATIONMODEL_H
+
+#include <memory>
+#include <vector>
+#include "Model.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+
+namespace uno {
+   /*! \class FixedVariablesEliminationModel
+    * \brief Presolve that eliminates the fixed variables
+    *
+    *  The fixed variables are substituted by their values in the function evaluations and removed from the variable space: the
+    *  derivatives only involve the free variables, and neither the Jacobian nor the augmented systems contain the fixed variables
+    *  (unlike FixedBoundsConstraintsModel). The free variables keep their relative order. The fixed variables are reinserted in
+    *  postprocess_solution, where their bound multipliers are recovered from the stationarity of the Lagrangian
+    */
+   class FixedVariablesEliminationModel: public Model {
+   public:
+      explicit FixedVariablesEliminationModel(std::unique_ptr<Model> original_model);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override;
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override;
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override;
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override;
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override;
+      [[nodiscard]] FunctionType get_objective_type() const override;
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override;
+
+      void initial_primal_point(Vector<double>& x) const override;
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override;
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+      void set_current_point(const Vector<double>& x) const override;
+      void invalidate_point() const override;
+      void refresh() override;
+      [[nodiscard]] bool supports_concurrent_evaluations() const override;
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override;
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override;
+
+      // index of a free variable in the original model
+      [[nodiscard]] size_t original_index(size_t variable_index) const { return this->free_variables[variable_index]; }
+
+   private:
+      static constexpr size_t ELIMINATED{static_cast<size_t>(-1)};
+
+      const std::unique_ptr<Model> model{};
+      const std::vector<size_t> free_variables; /*!< original indices of the variables of the reduced model */
+      std::vector<size_t> reduced_indices; /*!< reduced index of each original variable (ELIMINATED if fixed) */
+      Vector<double> fixed_values; /*!< original point with the values of the fixed variables */
+      Vector<size_t> lower_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> lower_bounded_variables_collection;
+      Vector<size_t> upper_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> upper_bounded_variables_collection;
+      Vector<size_t> single_lower_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> single_lower_bounded_variables_collection;
+      Vector<size_t> single_upper_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> single_upper_bounded_variables_collection;
+      SparseVector<size_t> slacks{};
+      const Vector<size_t> fixed_variables{};
+      // workspaces of the derivatives in the original variable space
+      mutable SparseVector<double> original_gradient;
+      mutable RectangularMatrix<double> original_jacobian;
+      mutable SymmetricMatrix<size_t, double> original_hessian;
+      mutable Vector<double> original_vector;
+      mutable Vector<double> original_result;
+
+      // the point of the original model that corresponds to the reduced point x
+      [[nodiscard]] const Vector<double>& expand_point(const Vector<double>& x) const;
+      void reduce_gradient(SparseVector<double>& gradient) const;
+   };
+} // namespace
+
+#endif // UNO_FIXEDVARIABLESELIMINATIONMODEL_H
@@ -0,0 +1,63 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include "FlattenedModel.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   FlattenedModel::FlattenedModel(std::unique_ptr<Model> original_model):
+         Model(original_model->name, original_model->number_variables, original_model->number_constraints, original_model->objective_sign),
+         // transfer ownership of the pointer
+         model(std::move(original_model)),
+         variable_lower_bounds(this->number_variables),
+         variable_upper_bounds(this->number_variables),
+         variable_bound_types(this->number_variables),
+         constraint_lower_bounds(this->number_constraints),
+         constraint_upper_bounds(this->number_constraints),
+         constraint_bound_types(this->number_constraints),
+         objective_type(this->model->get_objective_type()),
+         constraint_types(this->number_constraints),
+         slacks(this->model->get_slacks()),
+         fixed_variables(this->model->get_fixed_variables()),
+         objective_gradient_nonzeros(this->model->number_objective_gradient_nonzeros()),
+         jacobian_nonzeros(this->model->number_jacobian_nonzeros()),
+         lower_bounded_variables(this->model->get_lower_bounded_variables()),
+         upper_bounded_variables(this->model->get_upper_bounded_variables()),
+         single_lower_bounded_variables(this->model->get_single_lower_bounded_variables()),
+         single_upper_bounded_variables(this->model->get_single_upper_bounded_variables()),
+         equality_constraints(this->model->get_equality_constraints()),
+         inequality_constraints(this->model->get_inequality_constraints()),
+         linear_constraints(this->model->get_linear_constraints()) {
+      this->materialize_bounds();
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->constraint_types[constraint_index] = this->model->get_constraint_type(constraint_index);
+      }
+   }
+
+   // the bounds and the index collections may change in place (see EditableModel), the function types and the sparsity may not
+   void FlattenedModel::refresh() {
+      this->model->refresh();
+      this->slacks = this->model->get_slacks();
+      this->fixed_variables = this->model->get_fixed_variables();
+      this->lower_bounded_variables = IndexSet(this->model->get_lower_bounded_variables());
+      this->upper_bounded_variables = IndexSet(this->model->get_upper_bounded_variables());
+      this->single_lower_bounded_variables = IndexSet(this->model->get_single_lower_bounded_variables());
+      this->single_upper_bounded_variables = IndexSet(this->model->get_single_upper_bounded_variables());
+      this->equality_constraints = IndexSet(this->model->get_equality_constraints());
+      this->inequality_constraints = IndexSet(this->model->get_inequality_constraints());
+      this->materialize_bounds();
+   }
+
+   void FlattenedModel::materialize_bounds() {
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->variable_lower_bounds[variable_index] = this->model->variable_lower_bound(variable_index);
+         this->variable_upper_bounds[variable_index] = this->model->variable_upper_bound(variable_index);
+         this->variable_bound_types[variable_index] = this->model->get_variable_bound_type(variable_index);
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->constraint_lower_bounds[constraint_index] = this->model->constraint_lower_bound(constraint_index);
+         this->constraint_upper_bounds[constraint_index] = this->model->constraint_upper_bound(constraint_index);
+         this->constraint_bound_types[constraint_index] = this->model->get_constraint_bound_type(constraint_index);
+      }
+   }
+} // namespace
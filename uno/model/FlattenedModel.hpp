@@ -0,0 +1,130 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FLATTENEDMODEL_H
+#define UNO_FLATTENEDMODEL_H
+
+#include <memory>
+#include <vector>
+#include "Model.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/IndexSet.hpp"
+
+namespace uno {
+   /*! \class FlattenedModel
+    * \brief Composition of a stack of reformulations
+    *
+    *  The bounds, bound types, function types and slacks of the reformulated model are materialized once into contiguous arrays,
+    *  and its index collections into run-length compressed index sets, so that the per-element queries do not traverse the stack
+    *  of wrappers. The function evaluations are forwarded to the stack
+    */
+   class FlattenedModel: public Model {
+   public:
+      explicit FlattenedModel(std::unique_ptr<Model> original_model);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override { return this->model->evaluate_objective(x); }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         this->model->evaluate_objective_gradient(x, gradient);
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         this->model->evaluate_constraints(x, constraints);
+      }
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override {
+         this->model->evaluate_constraint_gradient(x, constraint_index, gradient);
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+         this->model->evaluate_constraint_jacobian(x, constraint_jacobian);
+      }
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         this->model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+      }
+      void evaluate_batch(BatchEvaluation& evaluation) const override { this->model->evaluate_batch(evaluation); }
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override {
+         this->model->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+      }
+      [[nodiscard]] size_t hessian_low_rank_dimension() const override { return this->model->hessian_low_rank_dimension(); }
+      void evaluate_hessian_low_rank_term(Vector<double>& factors, size_t leading_dimension, Vector<double>& middle_matrix) const override {
+         this->model->evaluate_hessian_low_rank_term(factors, leading_dimension, middle_matrix);
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->variable_lower_bounds[variable_index]; }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->variable_upper_bounds[variable_index]; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override { return this->variable_bound_types[variable_index]; }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->lower_bounded_variables; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override {
+         return this->single_lower_bounded_variables;
+      }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+         return this->single_upper_bounded_variables;
+      }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->constraint_lower_bounds[constraint_index]; }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->constraint_upper_bounds[constraint_index]; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return this->objective_type; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->constraint_types[constraint_index]; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override {
+         return this->constraint_bound_types[constraint_index];
+      }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->equality_constraints; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->inequality_constraints; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->linear_constraints; }
+
+      void initial_primal_point(Vector<double>& x) const override { this->model->initial_primal_point(x); }
+      void initial_dual_point(Vector<double>& multipliers) const override { this->model->initial_dual_point(multipliers); }
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override {
+         this->model->postprocess_solution(iterate, termination_status);
+      }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->objective_gradient_nonzeros; }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->jacobian_nonzeros; }
+      // not materialized: the stack may compute the Hessian sparsity upon the first request
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->model->number_hessian_nonzeros(); }
+      void set_current_point(const Vector<double>& x) const override { this->model->set_current_point(x); }
+      void invalidate_point() const override { this->model->invalidate_point(); }
+      void refresh() override;
+      [[nodiscard]] bool supports_concurrent_evaluations() const override { return this->model->supports_concurrent_evaluations(); }
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override {
+         return this->model->get_initial_basis(variable_statuses, constraint_statuses);
+      }
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override {
+         return this->model->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers);
+      }
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override {
+         return this->model->get_stages(variable_stages, constraint_stages);
+      }
+
+   private:
+      const std::unique_ptr<Model> model{};
+
+      std::vector<double> variable_lower_bounds;
+      std::vector<double> variable_upper_bounds;
+      std::vector<BoundType> variable_bound_types;
+      std::vector<double> constraint_lower_bounds;
+      std::vector<double> constraint_upper_bounds;
+      std::vector<BoundType> constraint_bound_types;
+      const FunctionType objective_type;
+      std::vector<FunctionType> constraint_types;
+      SparseVector<size_t> slacks;
+      Vector<size_t> fixed_variables;
+      const size_t objective_gradient_nonzeros;
+      const size_t jacobian_nonzeros;
+
+      IndexSet lower_bounded_variables;
+      IndexSet upper_bounded_variables;
+      IndexSet single_lower_bounded_variables;
+      IndexSet single_upper_bounded_variables;
+      IndexSet equality_constraints;
+      IndexSet inequality_constraints;
+      IndexSet linear_constraints;
+
+      void materialize_bounds();
+   };
+} // namespace
+
+#endif // UNO_FLATTENEDMODEL_H
@@ -1,11 +1,11 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
+#include <stdexcept>
 #include "HomogeneousEqualityConstrainedModel.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "optimization/Iterate.hpp"
-#include "symbolic/Concatenation.hpp"
-#include "symbolic/CollectionAdapter.hpp"
 #include "symbolic/Range.hpp"
 #include "tools/Infinity.hpp"
 
@@ -23,13 +23,7 @@ namespace uno {
          // all constraints are equality constraints
          equality_constraints(Range(this->number_constraints)),
          inequality_constraints(Range(0)),
-         slacks(this->model->get_inequality_constraints().size()),
-         lower_bounded_slacks(this->slacks.size()),
-         upper_bounded_slacks(this->slacks.size()),
-         lower_bounded_variables(concatenate(this->model->get_lower_bounded_variables(), adapt(this->lower_bounded_slacks))),
-         upper_bounded_variables(concatenate(this->model->get_upper_bounded_variables(), adapt(this->upper_bounded_slacks))),
-         single_lower_bounded_variables(concatenate(this->model->get_single_lower_bounded_variables(), adapt(this->single_lower_bounded_slacks))),
-         single_upper_bounded_variables(concatenate(this->model->get_single_upper_bounded_variables(), adapt(this->single_upper_bounded_slacks))){
+         slacks(this->model->get_inequality_constraints().size()) {
       // register the inequality constraint of each slack
       size_t inequality_index = 0;
       for (const size_t constraint_index: this->model->get_inequality_constraints()) {
@@ -37,19 +31,30 @@ namespace uno {
          this->constraint_index_of_inequality_index[inequality_index] = constraint_index;
          this->slack_index_of_constraint_index[constraint_index] = slack_variable_index;
          this->slacks.insert(constraint_index, slack_variable_index);
+         inequality_index++;
+      }
+      this->register_bounded_variables();
+   }
+
+   // original bounded variables followed by the bounded slacks
+   void HomogeneousEqualityConstrainedModel::register_bounded_variables() {
+      this->lower_bounded_variables = IndexSet(this->model->get_lower_bounded_variables());
+      this->upper_bounded_variables = IndexSet(this->model->get_upper_bounded_variables());
+      this->single_lower_bounded_variables = IndexSet(this->model->get_single_lower_bounded_variables());
+      this->single_upper_bounded_variables = IndexSet(this->model->get_single_upper_bounded_variables());
+      for (const auto [constraint_index, slack_variable_index]: this->slacks) {
          if (is_finite(this->model->constraint_lower_bound(constraint_index))) {
-            this->lower_bounded_slacks.emplace_back(slack_variable_index);
+            this->lower_bounded_variables.insert(slack_variable_index);
             if (!is_finite(this->model->constraint_upper_bound(constraint_index))) {
-               this->single_lower_bounded_slacks.emplace_back(slack_variable_index);
+               this->single_lower_bounded_variables.insert(slack_variable_index);
             }
          }
          if (is_finite(this->model->constraint_upper_bound(constraint_index))) {
-            this->upper_bounded_slacks.emplace_back(slack_variable_index);
+            this->upper_bounded_variables.insert(slack_variable_index);
             if (!is_finite(this->model->constraint_lower_bound(constraint_index))) {
-               this->single_upper_bounded_slacks.emplace_back(slack_variable_index);
+               this->single_upper_bounded_variables.insert(slack_variable_index);
             }
          }
-         inequality_index++;
       }
    }
 
@@ -101,6 +106,30 @@ namespace uno {
       }
    }
 
+   void HomogeneousEqualityConstrainedModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      this->model->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+      // the slacks do not enter the Hessian
+      for (size_t slack_index: Range(this->model->number_variables, this->number_variables)) {
+         result[slack_index] = 0.;
+      }
+   }
+
+   size_t HomogeneousEqualityConstrainedModel::hessian_low_rank_dimension() const {
+      return this->model->hessian_low_rank_dimension();
+   }
+
+   void HomogeneousEqualityConstrainedModel::evaluate_hessian_low_rank_term(Vector<double>& factors, size_t leading_dimension,
+         Vector<double>& middle_matrix) const {
+      this->model->evaluate_hessian_low_rank_term(factors, leading_dimension, middle_matrix);
+      // the slacks do not enter the Hessian
+      for (size_t column_index: Range(this->hessian_low_rank_dimension())) {
+         for (size_t slack_index: Range(this->model->number_variables, this->number_variables)) {
+            factors[slack_index + column_index * leading_dimension] = 0.;
+         }
+      }
+   }
+
    double HomogeneousEqualityConstrainedModel::variable_lower_bound(size_t variable_index) const {
       if (variable_index < this->model->number_variables) { // original variable
          return this->model->variable_lower_bound(variable_index);
@@ -160,6 +189,10 @@ namespace uno {
    double HomogeneousEqualityConstrainedModel::constraint_upper_bound(size_t /*constraint_index*/) const {
       return 0.; }
 
+   FunctionType HomogeneousEqualityConstrainedModel::get_objective_type() const {
+      return this->model->get_objective_type();
+   }
+
    FunctionType HomogeneousEqualityConstrainedModel::get_constraint_type(size_t constraint_index) const {
       return this->model->get_constraint_type(constraint_index); }
 
@@ -211,4 +244,51 @@ namespace uno {
    size_t HomogeneousEqualityConstrainedModel::number_hessian_nonzeros() const {
       return this->model->number_hessian_nonzeros();
    }
-} // namespace
\ No newline at end of file
+
+   void HomogeneousEqualityConstrainedModel::set_current_point(const Vector<double>& x) const {
+      this->model->set_current_point(x);
+   }
+
+   void HomogeneousEqualityConstrainedModel::invalidate_point() const {
+      this->model->invalidate_point();
+   }
+
+   void HomogeneousEqualityConstrainedModel::refresh() {
+      this->model->refresh();
+      // each inequality constraint has its own slack
+      if (this->model->get_inequality_constraints().size() != this->number_variables - this->model->number_variables) {
+         throw std::runtime_error("The number of inequality constraints cannot be modified in place");
+      }
+      this->register_bounded_variables();
+   }
+
+   bool HomogeneousEqualityConstrainedModel::supports_concurrent_evaluations() const {
+      return this->model->supports_concurrent_evaluations();
+   }
+
+   // the bound multipliers of the slack of c(x) - s = 0 are those of the constraint
+   bool HomogeneousEqualityConstrainedModel::get_initial_bound_duals(Vector<double>& lower_bound_multipliers,
+         Vector<double>& upper_bound_multipliers) const {
+      if (!this->model->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers)) {
+         return false;
+      }
+      Vector<double> constraint_multipliers(this->number_constraints);
+      this->model->initial_dual_point(constraint_multipliers);
+      for (const auto [constraint_index, slack_index]: this->get_slacks()) {
+         lower_bound_multipliers[slack_index] = std::max(0., constraint_multipliers[constraint_index]);
+         upper_bound_multipliers[slack_index] = std::min(0., constraint_multipliers[constraint_index]);
+      }
+      return true;
+   }
+
+   // the slack of c(x) - s = 0 belongs to the stage of the constraint
+   bool HomogeneousEqualityConstrainedModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      if (!this->model->get_stages(variable_stages, constraint_stages)) {
+         return false;
+      }
+      for (const auto [constraint_index, slack_index]: this->get_slacks()) {
+         variable_stages[slack_index] = constraint_stages[constraint_index];
+      }
+      return true;
+   }
+} // namespace
@@ -7,8 +7,8 @@
 #include <memory>
 #include "Model.hpp"
 #include "linear_algebra/SparseVector.hpp"
-#include "symbolic/CollectionAdapter.hpp"
-#include "symbolic/Concatenation.hpp"
+#include "symbolic/IndexSet.hpp"
+#include "symbolic/Range.hpp"
 
 namespace uno {
    // generate an equality-constrained model by:
@@ -26,6 +26,10 @@ namespace uno {
       void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
       void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
             SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+      [[nodiscard]] size_t hessian_low_rank_dimension() const override;
+      void evaluate_hessian_low_rank_term(Vector<double>& factors, size_t leading_dimension, Vector<double>& middle_matrix) const override;
 
       [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
       [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
@@ -38,6 +42,7 @@ namespace uno {
 
       [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override;
       [[nodiscard]] double constraint_upper_bound(size_t /*constraint_index*/) const override;
+      [[nodiscard]] FunctionType get_objective_type() const override;
       [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
       [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override;
       [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override;
@@ -52,6 +57,12 @@ namespace uno {
       [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
       [[nodiscard]] size_t number_jacobian_nonzeros() const override;
       [[nodiscard]] size_t number_hessian_nonzeros() const override;
+      void set_current_point(const Vector<double>& x) const override;
+      void invalidate_point() const override;
+      void refresh() override;
+      [[nodiscard]] bool supports_concurrent_evaluations() const override;
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override;
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override;
 
    protected:
       const std::unique_ptr<Model> model{};
@@ -61,14 +72,13 @@ namespace uno {
       ForwardRange equality_constraints;
       ForwardRange inequality_constraints;
       SparseVector<size_t> slacks;
-      std::vector<size_t> lower_bounded_slacks;
-      std::vector<size_t> upper_bounded_slacks;
-      std::vector<size_t> single_lower_bounded_slacks;
-      std::vector<size_t> single_upper_bounded_slacks;
-      Concatenation<const Collection<size_t>&, CollectionAdapter<std::vector<size_t>>> lower_bounded_variables;
-      Concatenation<const Collection<size_t>&, CollectionAdapter<std::vector<size_t>>> upper_bounded_variables;
-      Concatenation<const Collection<size_t>&, CollectionAdapter<std::vector<size_t>>> single_lower_bounded_variables;
-      Concatenation<const Collection<size_t>&, CollectionAdapter<std::vector<size_t>>> single_upper_bounded_variables;
+      // original bounded variables followed by the bounded slacks (usually a few runs)
+      IndexSet lower_bounded_variables;
+      IndexSet upper_bounded_variables;
+      IndexSet single_lower_bounded_variables;
+      IndexSet single_upper_bounded_variables;
+
+      void register_bounded_variables();
    };
 } // namespace
 
@@ -0,0 +1,115 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_INSTANCEMODEL_H
+#define UNO_INSTANCEMODEL_H
+
+#include "Model.hpp"
+
+namespace uno {
+   /*! \class InstanceModel
+    * \brief Non-owning view of one instance of a family of models with identical structure
+    *
+    *  The strategies and the solver are created once for the view, then the view is switched from an instance to the next one
+    *  (see BatchSolver). The instances must have the same dimensions, sparsity patterns and function types as the first one
+    */
+   class InstanceModel: public Model {
+   public:
+      explicit InstanceModel(const Model& first_instance):
+            Model(first_instance.name, first_instance.number_variables, first_instance.number_constraints, first_instance.objective_sign),
+            instance(&first_instance) { }
+
+      void set_instance(const Model& new_instance) { this->instance = &new_instance; }
+      [[nodiscard]] const Model& get_instance() const { return *this->instance; }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override { return this->instance->evaluate_objective(x); }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         this->instance->evaluate_objective_gradient(x, gradient);
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         this->instance->evaluate_constraints(x, constraints);
+      }
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override {
+         this->instance->evaluate_constraint_gradient(x, constraint_index, gradient);
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+         this->instance->evaluate_constraint_jacobian(x, constraint_jacobian);
+      }
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         this->instance->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+      }
+      void evaluate_batch(BatchEvaluation& evaluation) const override { this->instance->evaluate_batch(evaluation); }
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override {
+         this->instance->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+      }
+      void evaluate_scaled_objective_gradient(const Vector<double>& x, const EvaluationScaling& scaling, SparseVector<double>& gradient) const override {
+         this->instance->evaluate_scaled_objective_gradient(x, scaling, gradient);
+      }
+      void evaluate_scaled_constraints(const Vector<double>& x, const EvaluationScaling& scaling, std::vector<double>& constraints) const override {
+         this->instance->evaluate_scaled_constraints(x, scaling, constraints);
+      }
+      void evaluate_scaled_constraint_jacobian(const Vector<double>& x, const EvaluationScaling& scaling,
+            RectangularMatrix<double>& constraint_jacobian) const override {
+         this->instance->evaluate_scaled_constraint_jacobian(x, scaling, constraint_jacobian);
+      }
+      void evaluate_scaled_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const EvaluationScaling& scaling, SymmetricMatrix<size_t, double>& hessian) const override {
+         this->instance->evaluate_scaled_lagrangian_hessian(x, objective_multiplier, multipliers, scaling, hessian);
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->instance->variable_lower_bound(variable_index); }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->instance->variable_upper_bound(variable_index); }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override { return this->instance->get_variable_bound_type(variable_index); }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->instance->get_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->instance->get_upper_bounded_variables(); }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->instance->get_slacks(); }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->instance->get_single_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->instance->get_single_upper_bounded_variables(); }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->instance->get_fixed_variables(); }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->instance->constraint_lower_bound(constraint_index); }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->instance->constraint_upper_bound(constraint_index); }
+      [[nodiscard]] FunctionType get_objective_type() const override { return this->instance->get_objective_type(); }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->instance->get_constraint_type(constraint_index); }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override { return this->instance->get_constraint_bound_type(constraint_index); }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->instance->get_equality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->instance->get_inequality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->instance->get_linear_constraints(); }
+
+      void initial_primal_point(Vector<double>& x) const override { this->instance->initial_primal_point(x); }
+      void initial_dual_point(Vector<double>& multipliers) const override { this->instance->initial_dual_point(multipliers); }
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override {
+         this->instance->postprocess_solution(iterate, termination_status);
+      }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->instance->number_objective_gradient_nonzeros(); }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->instance->number_jacobian_nonzeros(); }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->instance->number_hessian_nonzeros(); }
+      void set_current_point(const Vector<double>& x) const override { this->instance->set_current_point(x); }
+      void invalidate_point() const override { this->instance->invalidate_point(); }
+      [[nodiscard]] bool supports_concurrent_evaluations() const override { return this->instance->supports_concurrent_evaluations(); }
+
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override {
+         return this->instance->declare_hessian_sparsity(row_indices, column_indices);
+      }
+      [[nodiscard]] bool get_user_variable_scaling(Vector<double>& scaling_factors) const override {
+         return this->instance->get_user_variable_scaling(scaling_factors);
+      }
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override {
+         return this->instance->get_initial_basis(variable_statuses, constraint_statuses);
+      }
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override {
+         return this->instance->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers);
+      }
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override {
+         return this->instance->get_stages(variable_stages, constraint_stages);
+      }
+
+   private:
+      const Model* instance;
+   };
+} // namespace
+
+#endif // UNO_INSTANCEMODEL_H
\ No newline at end of file
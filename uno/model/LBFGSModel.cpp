@@ -0,0 +1,272 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include "LBFGSModel.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   namespace {
+      // in-place LU factorization with partial pivoting of a small dense (column-major) matrix
+      void factorize_dense(std::vector<double>& matrix, std::vector<size_t>& permutation, size_t dimension) {
+         permutation.resize(dimension);
+         for (size_t row_index: Range(dimension)) {
+            permutation[row_index] = row_index;
+         }
+         for (size_t column_index: Range(dimension)) {
+            size_t pivot_index = column_index;
+            for (size_t row_index: Range(column_index + 1, dimension)) {
+               if (std::abs(matrix[pivot_index + column_index * dimension]) < std::abs(matrix[row_index + column_index * dimension])) {
+                  pivot_index = row_index;
+               }
+            }
+            if (pivot_index != column_index) {
+               for (size_t index: Range(dimension)) {
+                  std::swap(matrix[column_index + index * dimension], matrix[pivot_index + index * dimension]);
+               }
+               std::swap(permutation[column_index], permutation[pivot_index]);
+            }
+            const double pivot = matrix[column_index + column_index * dimension];
+            if (pivot == 0.) {
+               throw std::runtime_error("LBFGSModel: the middle matrix of the compact representation is singular");
+            }
+            for (size_t row_index: Range(column_index + 1, dimension)) {
+               const double factor = matrix[row_index + column_index * dimension] / pivot;
+               matrix[row_index + column_index * dimension] = factor;
+               for (size_t index: Range(column_index + 1, dimension)) {
+                  matrix[row_index + index * dimension] -= factor * matrix[column_index + index * dimension];
+               }
+            }
+         }
+      }
+   } // namespace
+
+   LBFGSModel::LBFGSModel(std::unique_ptr<Model> original_model, const Options& options, bool compact_hessian):
+         QuasiNewtonModel(compact_hessian ? " -> compact L-BFGS" : " -> L-BFGS", std::move(original_model)),
+         memory_size(options.get_unsigned_int("LBFGS_memory_size")),
+         compact_hessian(compact_hessian) {
+      if (this->memory_size == 0) {
+         throw std::invalid_argument("The L-BFGS memory size should be positive");
+      }
+   }
+
+   size_t LBFGSModel::number_hessian_nonzeros() const {
+      // compact form: diagonal delta I
+      return this->compact_hessian ? this->number_variables : QuasiNewtonModel::number_hessian_nonzeros();
+   }
+
+   void LBFGSModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      this->update(x, objective_multiplier, multipliers);
+      hessian.reset();
+      const size_t number_pairs = this->s_vectors.size();
+      if (number_pairs == 0 || this->compact_hessian) {
+         for (size_t variable_index: Range(this->number_variables)) {
+            hessian.insert(this->scaling, variable_index, variable_index);
+            hessian.finalize_column(variable_index);
+         }
+         return;
+      }
+      // precompute the rows w_i of W and the solutions z_j = M^{-1} w_j, then B_ij = delta [i == j] - w_i^T z_j
+      const size_t dimension = 2 * number_pairs;
+      std::vector<double> low_rank_rows(this->number_variables * dimension);
+      std::vector<double> solutions(this->number_variables * dimension);
+      std::vector<double> row(dimension);
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->compute_low_rank_row(variable_index, row);
+         std::copy(row.cbegin(), row.cend(), low_rank_rows.begin() + static_cast<std::ptrdiff_t>(variable_index * dimension));
+         this->solve_middle_system(row);
+         std::copy(row.cbegin(), row.cend(), solutions.begin() + static_cast<std::ptrdiff_t>(variable_index * dimension));
+      }
+      // upper triangle, column by column
+      for (size_t column_index: Range(this->number_variables)) {
+         const double* solution = solutions.data() + column_index * dimension;
+         for (size_t row_index: Range(column_index + 1)) {
+            const double* low_rank_row = low_rank_rows.data() + row_index * dimension;
+            double entry = (row_index == column_index) ? this->scaling : 0.;
+            for (size_t index: Range(dimension)) {
+               entry -= low_rank_row[index] * solution[index];
+            }
+            hessian.insert(entry, row_index, column_index);
+         }
+         hessian.finalize_column(column_index);
+      }
+   }
+
+   void LBFGSModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      this->update(x, objective_multiplier, multipliers);
+      this->compute_product(vector, result);
+   }
+
+   size_t LBFGSModel::hessian_low_rank_dimension() const {
+      return this->compact_hessian ? 2 * this->memory_size : 0;
+   }
+
+   // W = [delta S, 0, Y, 0] and M = [delta S^T S, 0, L, 0; 0, I, 0, 0; L^T, 0, -D, 0; 0, 0, 0, -I] with memory_size columns per part.
+   // The entries of M scale like ||s||^2: the columns of the pair (s, y) are scaled by 1/||s|| (W M^{-1} W^T = (W F) (F M F)^{-1} (W F)^T
+   // for any diagonal F), which keeps W and M well scaled as the steps vanish
+   void LBFGSModel::evaluate_hessian_low_rank_term(Vector<double>& factors, size_t leading_dimension, Vector<double>& middle_matrix) const {
+      if (!this->compact_hessian) {
+         return;
+      }
+      const size_t number_pairs = this->s_vectors.size();
+      const size_t dimension = 2 * this->memory_size;
+      const size_t compact_dimension = 2 * number_pairs;
+      // position of the rows/columns of the stored middle matrix in the fixed layout, and their scaling
+      const auto position = [&](size_t index) {
+         return (index < number_pairs) ? index : this->memory_size + (index - number_pairs);
+      };
+      std::vector<double> pair_scaling(number_pairs);
+      for (size_t pair_index: Range(number_pairs)) {
+         pair_scaling[pair_index] = 1. / std::sqrt(dot(this->s_vectors[pair_index], this->s_vectors[pair_index]));
+      }
+      const auto scaling = [&](size_t index) {
+         return pair_scaling[(index < number_pairs) ? index : index - number_pairs];
+      };
+      for (size_t column_index: Range(dimension)) {
+         for (size_t variable_index: Range(this->number_variables)) {
+            factors[variable_index + column_index * leading_dimension] = 0.;
+         }
+         for (size_t row_index: Range(dimension)) {
+            middle_matrix[row_index + column_index * dimension] = 0.;
+         }
+         // padding
+         middle_matrix[column_index + column_index * dimension] = (column_index < this->memory_size) ? 1. : -1.;
+      }
+      for (size_t pair_index: Range(number_pairs)) {
+         for (size_t variable_index: Range(this->number_variables)) {
+            factors[variable_index + pair_index * leading_dimension] = pair_scaling[pair_index] * this->scaling *
+               this->s_vectors[pair_index][variable_index];
+            factors[variable_index + (this->memory_size + pair_index) * leading_dimension] = pair_scaling[pair_index] *
+               this->y_vectors[pair_index][variable_index];
+         }
+      }
+      for (size_t column_index: Range(compact_dimension)) {
+         for (size_t row_index: Range(compact_dimension)) {
+            middle_matrix[position(row_index) + position(column_index) * dimension] = scaling(row_index) * scaling(column_index) *
+               this->middle_matrix_values[row_index + column_index * compact_dimension];
+         }
+      }
+   }
+
+   void LBFGSModel::add_pair(Vector<double>&& s, Vector<double>&& y) const {
+      // Powell damping: keep the curvature s^T y sufficiently positive with respect to s^T B s
+      Vector<double> Bs(this->number_variables);
+      this->compute_product(s, Bs);
+      const double sBs = dot(s, Bs);
+      double sy = dot(s, y);
+      if (sy < 0.2 * sBs) {
+         const double theta = 0.8 * sBs / (sBs - sy);
+         for (size_t variable_index: Range(this->number_variables)) {
+            y[variable_index] = theta * y[variable_index] + (1. - theta) * Bs[variable_index];
+         }
+         sy = dot(s, y);
+      }
+      // skip the pairs with vanishing curvature
+      const double yy = dot(y, y);
+      if (sy <= 1e-8 * std::sqrt(dot(s, s) * yy)) {
+         return;
+      }
+      if (this->s_vectors.size() == this->memory_size) {
+         this->s_vectors.pop_front();
+         this->y_vectors.pop_front();
+      }
+      this->s_vectors.emplace_back(std::move(s));
+      this->y_vectors.emplace_back(std::move(y));
+      this->scaling = yy / sy;
+      this->factorize_middle_matrix();
+   }
+
+   void LBFGSModel::reset_approximation() const {
+      this->s_vectors.clear();
+      this->y_vectors.clear();
+      this->scaling = 1.;
+      this->middle_matrix_values.clear();
+      this->middle_matrix_factors.clear();
+      this->middle_matrix_permutation.clear();
+   }
+
+   // M = [delta S^T S, L; L^T, -D], with L the strictly lower triangular part of S^T Y and D its diagonal
+   void LBFGSModel::factorize_middle_matrix() const {
+      const size_t number_pairs = this->s_vectors.size();
+      const size_t dimension = 2 * number_pairs;
+      this->middle_matrix_factors.assign(dimension * dimension, 0.);
+      for (size_t i: Range(number_pairs)) {
+         for (size_t j: Range(number_pairs)) {
+            this->middle_matrix_factors[i + j * dimension] = this->scaling * dot(this->s_vectors[i], this->s_vectors[j]);
+            const double sy = dot(this->s_vectors[i], this->y_vectors[j]);
+            if (j < i) {
+               this->middle_matrix_factors[i + (number_pairs + j) * dimension] = sy;
+               this->middle_matrix_factors[(number_pairs + j) + i * dimension] = sy;
+            }
+            else if (i == j) {
+               this->middle_matrix_factors[(number_pairs + i) + (number_pairs + i) * dimension] = -sy;
+            }
+         }
+      }
+      this->middle_matrix_values = this->middle_matrix_factors;
+      factorize_dense(this->middle_matrix_factors, this->middle_matrix_permutation, dimension);
+   }
+
+   void LBFGSModel::compute_low_rank_row(size_t variable_index, std::vector<double>& row) const {
+      const size_t number_pairs = this->s_vectors.size();
+      for (size_t pair_index: Range(number_pairs)) {
+         row[pair_index] = this->scaling * this->s_vectors[pair_index][variable_index];
+         row[number_pairs + pair_index] = this->y_vectors[pair_index][variable_index];
+      }
+   }
+
+   void LBFGSModel::solve_middle_system(std::vector<double>& rhs) const {
+      const size_t dimension = this->middle_matrix_permutation.size();
+      std::vector<double> solution(dimension);
+      for (size_t index: Range(dimension)) {
+         solution[index] = rhs[this->middle_matrix_permutation[index]];
+      }
+      // forward substitution (unit lower triangle)
+      for (size_t row_index: Range(dimension)) {
+         for (size_t column_index: Range(row_index)) {
+            solution[row_index] -= this->middle_matrix_factors[row_index + column_index * dimension] * solution[column_index];
+         }
+      }
+      // backward substitution
+      for (size_t row_index = dimension; row_index-- > 0;) {
+         for (size_t column_index: Range(row_index + 1, dimension)) {
+            solution[row_index] -= this->middle_matrix_factors[row_index + column_index * dimension] * solution[column_index];
+         }
+         solution[row_index] /= this->middle_matrix_factors[row_index + row_index * dimension];
+      }
+      rhs = std::move(solution);
+   }
+
+   // B v = delta v - W M^{-1} W^T v, in O(nk) operations
+   void LBFGSModel::compute_product(const Vector<double>& vector, Vector<double>& result) const {
+      const size_t number_pairs = this->s_vectors.size();
+      std::vector<double> projection(2 * number_pairs);
+      for (size_t pair_index: Range(number_pairs)) {
+         double sv = 0.;
+         double yv = 0.;
+         for (size_t variable_index: Range(this->number_variables)) {
+            sv += this->s_vectors[pair_index][variable_index] * vector[variable_index];
+            yv += this->y_vectors[pair_index][variable_index] * vector[variable_index];
+         }
+         projection[pair_index] = this->scaling * sv;
+         projection[number_pairs + pair_index] = yv;
+      }
+      if (0 < number_pairs) {
+         this->solve_middle_system(projection);
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         double entry = this->scaling * vector[variable_index];
+         for (size_t pair_index: Range(number_pairs)) {
+            entry -= this->scaling * this->s_vectors[pair_index][variable_index] * projection[pair_index] +
+               this->y_vectors[pair_index][variable_index] * projection[number_pairs + pair_index];
+         }
+         result[variable_index] = entry;
+      }
+   }
+} // namespace
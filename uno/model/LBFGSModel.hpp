@@ -0,0 +1,63 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_LBFGSMODEL_H
+#define UNO_LBFGSMODEL_H
+
+#include <deque>
+#include <vector>
+#include "QuasiNewtonModel.hpp"
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   /*! \class LBFGSModel
+    * \brief Model whose Lagrangian Hessian is replaced by a limited-memory BFGS approximation
+    *
+    *  The approximation is kept in compact form B = delta I - W M^{-1} W^T, with W = [delta S, Y] and the small middle matrix
+    *  M = [delta S^T S, L; L^T, -D] (Byrd, Nocedal and Schnabel, 1994). Nonconvex curvature is handled by Powell damping, and pairs
+    *  with vanishing curvature are skipped. The Hessian-vector products use the compact form directly. The Hessian matrix is
+    *  materialized (dense upper triangle), unless the compact form is requested: the evaluated Hessian is then the diagonal delta I and
+    *  the low-rank term W M^{-1} W^T is exposed with a fixed dimension 2 x memory size (the unused columns of W are zero and the
+    *  unused diagonal entries of M are +1 and -1, which preserves its inertia)
+    */
+   class LBFGSModel: public QuasiNewtonModel {
+   public:
+      LBFGSModel(std::unique_ptr<Model> original_model, const Options& options, bool compact_hessian = false);
+
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+      [[nodiscard]] size_t hessian_low_rank_dimension() const override;
+      void evaluate_hessian_low_rank_term(Vector<double>& factors, size_t leading_dimension, Vector<double>& middle_matrix) const override;
+
+   protected:
+      void add_pair(Vector<double>&& s, Vector<double>&& y) const override;
+      void reset_approximation() const override;
+
+   private:
+      const size_t memory_size;
+      const bool compact_hessian;
+
+      // pairs (s, y), from the oldest to the most recent
+      mutable std::deque<Vector<double>> s_vectors{};
+      mutable std::deque<Vector<double>> y_vectors{};
+      mutable double scaling{1.}; /*!< delta = y^T y / s^T y of the most recent pair */
+      // middle matrix M, of size 2k x 2k (k pairs), and its LU factors (with row permutation)
+      mutable std::vector<double> middle_matrix_values{};
+      mutable std::vector<double> middle_matrix_factors{};
+      mutable std::vector<size_t> middle_matrix_permutation{};
+
+      void factorize_middle_matrix() const;
+      // row of W = [delta S, Y] associated with a variable
+      void compute_low_rank_row(size_t variable_index, std::vector<double>& row) const;
+      // solves M z = rhs in place with the LU factors of the middle matrix
+      void solve_middle_system(std::vector<double>& rhs) const;
+      void compute_product(const Vector<double>& vector, Vector<double>& result) const;
+   };
+} // namespace
+
+#endif // UNO_LBFGSMODEL_H
@@ -0,0 +1,489 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include "LinearPresolveModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "tools/AllocationTracker.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   namespace {
+      // a linear constraint sum_i a_i x_i + b, with the coefficients sorted by variable index
+      struct LinearRow {
+         std::vector<std::pair<size_t, double>> coefficients{};
+         double constant{0.};
+      };
+
+      bool is_below(double value, double bound, double tolerance) {
+         return value <= bound + tolerance * std::max(1., std::abs(bound));
+      }
+
+      size_t hash_sparsity(const LinearRow& row) {
+         size_t hash = row.coefficients.size();
+         for (const auto& [variable_index, coefficient]: row.coefficients) {
+            hash ^= std::hash<size_t>{}(variable_index) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+         }
+         return hash;
+      }
+
+      // the ratio alpha such that row = alpha * other_row (up to the constants), or 0 if the rows are not proportional
+      double proportionality_ratio(const LinearRow& row, const LinearRow& other_row, double tolerance) {
+         if (row.coefficients.size() != other_row.coefficients.size()) {
+            return 0.;
+         }
+         const double ratio = row.coefficients[0].second / other_row.coefficients[0].second;
+         for (size_t nonzero_index: Range(row.coefficients.size())) {
+            const auto& [variable_index, coefficient] = row.coefficients[nonzero_index];
+            const auto& [other_variable_index, other_coefficient] = other_row.coefficients[nonzero_index];
+            if (variable_index != other_variable_index || tolerance * std::abs(coefficient) < std::abs(coefficient - ratio * other_coefficient)) {
+               return 0.;
+            }
+         }
+         return ratio;
+      }
+   } // namespace
+
+   LinearPresolveModel::LinearPresolveModel(std::unique_ptr<Model> original_model, double tolerance):
+         LinearPresolveModel(std::move(original_model), LinearPresolveModel::presolve(*original_model, tolerance)) {
+   }
+
+   LinearPresolveModel::LinearPresolveModel(std::unique_ptr<Model>&& original_model, Reduction&& reduction):
+         Model(original_model->name + " -> presolved", original_model->number_variables, reduction.remaining_constraints.size(),
+               original_model->objective_sign),
+         model(std::move(original_model)),
+         reduction(std::move(reduction)),
+         lower_bounded_variables_collection(this->lower_bounded_variables),
+         upper_bounded_variables_collection(this->upper_bounded_variables),
+         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
+         single_upper_bounded_variables_collection(this->single_upper_bounded_variables),
+         equality_constraints_collection(this->equality_constraints),
+         inequality_constraints_collection(this->inequality_constraints),
+         linear_constraints_collection(this->linear_constraints),
+         original_jacobian(this->model->number_constraints, this->model->number_variables),
+         original_multipliers(this->model->number_constraints, 0.) {
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double lower_bound = this->variable_lower_bound(variable_index);
+         const double upper_bound = this->variable_upper_bound(variable_index);
+         if (lower_bound == upper_bound) {
+            this->fixed_variables.emplace_back(variable_index);
+         }
+         if (is_finite(lower_bound)) {
+            this->lower_bounded_variables.emplace_back(variable_index);
+            if (!is_finite(upper_bound)) {
+               this->single_lower_bounded_variables.emplace_back(variable_index);
+            }
+         }
+         if (is_finite(upper_bound)) {
+            this->upper_bounded_variables.emplace_back(variable_index);
+            if (!is_finite(lower_bound)) {
+               this->single_upper_bounded_variables.emplace_back(variable_index);
+            }
+         }
+      }
+      std::vector<size_t> reduced_indices(this->model->number_constraints, NO_ROW);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         reduced_indices[this->original_index(constraint_index)] = constraint_index;
+         if (this->get_constraint_bound_type(constraint_index) == EQUAL_BOUNDS) {
+            this->equality_constraints.emplace_back(constraint_index);
+         }
+         else {
+            this->inequality_constraints.emplace_back(constraint_index);
+         }
+         if (this->get_constraint_type(constraint_index) == LINEAR) {
+            this->linear_constraints.emplace_back(constraint_index);
+         }
+      }
+      for (const auto [constraint_index, slack_index]: this->model->get_slacks()) {
+         if (reduced_indices[constraint_index] != NO_ROW) {
+            this->slacks.insert(reduced_indices[constraint_index], slack_index);
+         }
+      }
+      DEBUG << "Presolve: " << (this->model->number_constraints - this->number_constraints) << " linear constraints were removed\n";
+   }
+
+   LinearPresolveModel::Reduction LinearPresolveModel::presolve(const Model& model, double tolerance) {
+      Reduction reduction{};
+      reduction.variable_lower_bounds.resize(model.number_variables);
+      reduction.variable_upper_bounds.resize(model.number_variables);
+      reduction.variable_lower_bound_sources.resize(model.number_variables);
+      reduction.variable_upper_bound_sources.resize(model.number_variables);
+      for (size_t variable_index: Range(model.number_variables)) {
+         reduction.variable_lower_bounds[variable_index] = model.variable_lower_bound(variable_index);
+         reduction.variable_upper_bounds[variable_index] = model.variable_upper_bound(variable_index);
+      }
+      std::vector<double> constraint_lower_bounds(model.number_constraints), constraint_upper_bounds(model.number_constraints);
+      std::vector<BoundSource> constraint_lower_bound_sources(model.number_constraints), constraint_upper_bound_sources(model.number_constraints);
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         constraint_lower_bounds[constraint_index] = model.constraint_lower_bound(constraint_index);
+         constraint_upper_bounds[constraint_index] = model.constraint_upper_bound(constraint_index);
+      }
+      std::vector<bool> is_removed(model.number_constraints, false);
+
+      if (!model.get_linear_constraints().empty()) {
+         // the coefficients of the linear constraints do not depend on the point
+         Vector<double> x(model.number_variables);
+         model.initial_primal_point(x);
+         model.project_onto_variable_bounds(x);
+         std::vector<double> constraints(model.number_constraints);
+         RectangularMatrix<double> jacobian(model.number_constraints, model.number_variables);
+         model.set_current_point(x);
+         model.evaluate_constraints(x, constraints);
+         model.evaluate_constraint_jacobian(x, jacobian);
+         model.invalidate_point();
+         std::vector<LinearRow> rows(model.number_constraints);
+         for (size_t constraint_index: model.get_linear_constraints()) {
+            LinearRow& row = rows[constraint_index];
+            for (const auto [variable_index, coefficient]: jacobian[constraint_index]) {
+               row.coefficients.emplace_back(variable_index, coefficient);
+            }
+            std::sort(row.coefficients.begin(), row.coefficients.end());
+            // accumulate the duplicate entries and discard the zeros
+            size_t number_coefficients = 0;
+            for (const auto& [variable_index, coefficient]: row.coefficients) {
+               if (0 < number_coefficients && row.coefficients[number_coefficients - 1].first == variable_index) {
+                  row.coefficients[number_coefficients - 1].second += coefficient;
+               }
+               else {
+                  row.coefficients[number_coefficients++] = {variable_index, coefficient};
+               }
+            }
+            row.coefficients.resize(number_coefficients);
+            row.coefficients.erase(std::remove_if(row.coefficients.begin(), row.coefficients.end(), [](const auto& entry) {
+               return entry.second == 0.;
+            }), row.coefficients.end());
+            row.constant = constraints[constraint_index];
+            for (const auto& [variable_index, coefficient]: row.coefficients) {
+               row.constant -= coefficient * x[variable_index];
+            }
+         }
+
+         std::unordered_map<size_t, std::vector<size_t>> rows_by_sparsity{};
+         for (size_t constraint_index: model.get_linear_constraints()) {
+            const LinearRow& row = rows[constraint_index];
+            const double lower_bound = constraint_lower_bounds[constraint_index] - row.constant;
+            const double upper_bound = constraint_upper_bounds[constraint_index] - row.constant;
+            // empty row: b ∈ [l, u]
+            if (row.coefficients.empty()) {
+               if (is_below(lower_bound, 0., tolerance) && is_below(0., upper_bound, tolerance)) {
+                  is_removed[constraint_index] = true;
+               }
+               else {
+                  WARNING << "Presolve: the empty constraint " << constraint_index << " is infeasible\n";
+               }
+            }
+            // singleton row: l <= a x_i + b <= u becomes a bound constraint of x_i
+            else if (row.coefficients.size() == 1) {
+               const auto [variable_index, coefficient] = row.coefficients[0];
+               const double variable_lower_bound = ((0. < coefficient) ? lower_bound : upper_bound) / coefficient;
+               const double variable_upper_bound = ((0. < coefficient) ? upper_bound : lower_bound) / coefficient;
+               const double new_lower_bound = std::max(reduction.variable_lower_bounds[variable_index], variable_lower_bound);
+               const double new_upper_bound = std::min(reduction.variable_upper_bounds[variable_index], variable_upper_bound);
+               if (is_below(new_lower_bound, new_upper_bound, tolerance)) {
+                  if (reduction.variable_lower_bounds[variable_index] < variable_lower_bound) {
+                     reduction.variable_lower_bounds[variable_index] = variable_lower_bound;
+                     reduction.variable_lower_bound_sources[variable_index] = {constraint_index, coefficient};
+                  }
+                  if (variable_upper_bound < reduction.variable_upper_bounds[variable_index]) {
+                     reduction.variable_upper_bounds[variable_index] = variable_upper_bound;
+                     reduction.variable_upper_bound_sources[variable_index] = {constraint_index, coefficient};
+                  }
+                  // the bounds may cross within the tolerance
+                  reduction.variable_upper_bounds[variable_index] = std::max(reduction.variable_lower_bounds[variable_index],
+                     reduction.variable_upper_bounds[variable_index]);
+                  is_removed[constraint_index] = true;
+               }
+            }
+            // duplicate row: a_j = alpha a_k. The bounds of c_j are expressed in terms of c_k and intersected with those of c_k
+            else {
+               std::vector<size_t>& candidates = rows_by_sparsity[hash_sparsity(row)];
+               for (size_t other_constraint_index: candidates) {
+                  const double ratio = proportionality_ratio(row, rows[other_constraint_index], tolerance);
+                  if (ratio != 0.) {
+                     const double other_constant = rows[other_constraint_index].constant;
+                     const double other_lower_bound = ((0. < ratio) ? lower_bound : upper_bound) / ratio + other_constant;
+                     const double other_upper_bound = ((0. < ratio) ? upper_bound : lower_bound) / ratio + other_constant;
+                     double& current_lower_bound = constraint_lower_bounds[other_constraint_index];
+                     double& current_upper_bound = constraint_upper_bounds[other_constraint_index];
+                     if (is_below(std::max(current_lower_bound, other_lower_bound), std::min(current_upper_bound, other_upper_bound), tolerance)) {
+                        if (current_lower_bound < other_lower_bound) {
+                           current_lower_bound = other_lower_bound;
+                           constraint_lower_bound_sources[other_constraint_index] = {constraint_index, ratio};
+                        }
+                        if (other_upper_bound < current_upper_bound) {
+                           current_upper_bound = other_upper_bound;
+                           constraint_upper_bound_sources[other_constraint_index] = {constraint_index, ratio};
+                        }
+                        current_upper_bound = std::max(current_lower_bound, current_upper_bound);
+                        is_removed[constraint_index] = true;
+                     }
+                     break;
+                  }
+               }
+               if (!is_removed[constraint_index]) {
+                  candidates.emplace_back(constraint_index);
+               }
+            }
+         }
+
+         // dominated rows: the activity range over the variable bounds lies within the bounds
+         for (size_t constraint_index: model.get_linear_constraints()) {
+            if (!is_removed[constraint_index] && !rows[constraint_index].coefficients.empty()) {
+               double minimum_activity = rows[constraint_index].constant;
+               double maximum_activity = rows[constraint_index].constant;
+               for (const auto& [variable_index, coefficient]: rows[constraint_index].coefficients) {
+                  const double lower_bound = reduction.variable_lower_bounds[variable_index];
+                  const double upper_bound = reduction.variable_upper_bounds[variable_index];
+                  minimum_activity += (0. < coefficient) ? coefficient * lower_bound : coefficient * upper_bound;
+                  maximum_activity += (0. < coefficient) ? coefficient * upper_bound : coefficient * lower_bound;
+               }
+               if (is_below(constraint_lower_bounds[constraint_index], minimum_activity, tolerance) &&
+                     is_below(maximum_activity, constraint_upper_bounds[constraint_index], tolerance)) {
+                  is_removed[constraint_index] = true;
+               }
+            }
+         }
+      }
+
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         if (!is_removed[constraint_index]) {
+            reduction.remaining_constraints.emplace_back(constraint_index);
+            reduction.constraint_lower_bounds.emplace_back(constraint_lower_bounds[constraint_index]);
+            reduction.constraint_upper_bounds.emplace_back(constraint_upper_bounds[constraint_index]);
+            reduction.constraint_lower_bound_sources.emplace_back(constraint_lower_bound_sources[constraint_index]);
+            reduction.constraint_upper_bound_sources.emplace_back(constraint_upper_bound_sources[constraint_index]);
+         }
+      }
+      return reduction;
+   }
+
+   BoundType LinearPresolveModel::determine_bound_type(double lower_bound, double upper_bound) {
+      if (lower_bound == upper_bound) {
+         return EQUAL_BOUNDS;
+      }
+      else if (is_finite(lower_bound) && is_finite(upper_bound)) {
+         return BOUNDED_BOTH_SIDES;
+      }
+      else if (is_finite(lower_bound)) {
+         return BOUNDED_LOWER;
+      }
+      else if (is_finite(upper_bound)) {
+         return BOUNDED_UPPER;
+      }
+      return UNBOUNDED;
+   }
+
+   double LinearPresolveModel::evaluate_objective(const Vector<double>& x) const {
+      return this->model->evaluate_objective(x);
+   }
+
+   void LinearPresolveModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->model->evaluate_objective_gradient(x, gradient);
+   }
+
+   void LinearPresolveModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      // one workspace per thread: the points may be evaluated concurrently
+      thread_local std::vector<double> original_constraints{};
+      if (original_constraints.size() != this->model->number_constraints) {
+         const AllocationTracker::Prohibition allowed_allocation(false);
+         original_constraints.resize(this->model->number_constraints);
+      }
+      this->model->evaluate_constraints(x, original_constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraints[constraint_index] = original_constraints[this->original_index(constraint_index)];
+      }
+   }
+
+   void LinearPresolveModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      this->model->evaluate_constraint_gradient(x, this->original_index(constraint_index), gradient);
+   }
+
+   void LinearPresolveModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      this->original_jacobian.clear();
+      this->model->evaluate_constraint_jacobian(x, this->original_jacobian);
+      const double* entries = this->original_jacobian.data_pointer();
+      const size_t* column_indices = this->original_jacobian.column_indices_pointer();
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         const size_t row_start = this->original_jacobian.row_start(this->original_index(constraint_index));
+         const size_t row_end = row_start + this->original_jacobian.row_size(this->original_index(constraint_index));
+         for (size_t nonzero_index = row_start; nonzero_index < row_end; nonzero_index++) {
+            constraint_jacobian.insert(constraint_index, column_indices[nonzero_index], entries[nonzero_index]);
+         }
+      }
+   }
+
+   void LinearPresolveModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      // the removed constraints are linear
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->original_multipliers[this->original_index(constraint_index)] = multipliers[constraint_index];
+      }
+      this->model->evaluate_lagrangian_hessian(x, objective_multiplier, this->original_multipliers, hessian);
+   }
+
+   void LinearPresolveModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->original_multipliers[this->original_index(constraint_index)] = multipliers[constraint_index];
+      }
+      this->model->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, this->original_multipliers, vector, result);
+   }
+
+   double LinearPresolveModel::variable_lower_bound(size_t variable_index) const {
+      return this->reduction.variable_lower_bounds[variable_index];
+   }
+
+   double LinearPresolveModel::variable_upper_bound(size_t variable_index) const {
+      return this->reduction.variable_upper_bounds[variable_index];
+   }
+
+   BoundType LinearPresolveModel::get_variable_bound_type(size_t variable_index) const {
+      return LinearPresolveModel::determine_bound_type(this->variable_lower_bound(variable_index), this->variable_upper_bound(variable_index));
+   }
+
+   const Collection<size_t>& LinearPresolveModel::get_lower_bounded_variables() const {
+      return this->lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& LinearPresolveModel::get_upper_bounded_variables() const {
+      return this->upper_bounded_variables_collection;
+   }
+
+   const SparseVector<size_t>& LinearPresolveModel::get_slacks() const {
+      return this->slacks;
+   }
+
+   const Collection<size_t>& LinearPresolveModel::get_single_lower_bounded_variables() const {
+      return this->single_lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& LinearPresolveModel::get_single_upper_bounded_variables() const {
+      return this->single_upper_bounded_variables_collection;
+   }
+
+   const Vector<size_t>& LinearPresolveModel::get_fixed_variables() const {
+      return this->fixed_variables;
+   }
+
+   double LinearPresolveModel::constraint_lower_bound(size_t constraint_index) const {
+      return this->reduction.constraint_lower_bounds[constraint_index];
+   }
+
+   double LinearPresolveModel::constraint_upper_bound(size_t constraint_index) const {
+      return this->reduction.constraint_upper_bounds[constraint_index];
+   }
+
+   FunctionType LinearPresolveModel::get_objective_type() const {
+      return this->model->get_objective_type();
+   }
+
+   FunctionType LinearPresolveModel::get_constraint_type(size_t constraint_index) const {
+      return this->model->get_constraint_type(this->original_index(constraint_index));
+   }
+
+   BoundType LinearPresolveModel::get_constraint_bound_type(size_t constraint_index) const {
+      return LinearPresolveModel::determine_bound_type(this->constraint_lower_bound(constraint_index), this->constraint_upper_bound(constraint_index));
+   }
+
+   const Collection<size_t>& LinearPresolveModel::get_equality_constraints() const {
+      return this->equality_constraints_collection;
+   }
+
+   const Collection<size_t>& LinearPresolveModel::get_inequality_constraints() const {
+      return this->inequality_constraints_collection;
+   }
+
+   const Collection<size_t>& LinearPresolveModel::get_linear_constraints() const {
+      return this->linear_constraints_collection;
+   }
+
+   void LinearPresolveModel::initial_primal_point(Vector<double>& x) const {
+      this->model->initial_primal_point(x);
+   }
+
+   void LinearPresolveModel::initial_dual_point(Vector<double>& multipliers) const {
+      Vector<double> original_dual_point(this->model->number_constraints);
+      this->model->initial_dual_point(original_dual_point);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         multipliers[constraint_index] = original_dual_point[this->original_index(constraint_index)];
+      }
+   }
+
+   void LinearPresolveModel::postprocess_solution(Iterate& iterate, IterateStatus termination_status) const {
+      // the multiplier of an active bound is moved to the row that provided it: if the bounded quantity is r = c / ratio, then
+      // lambda_c = lambda_r / ratio
+      Vector<double> constraint_multipliers(this->model->number_constraints, 0.);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         const double multiplier = iterate.multipliers.constraints[constraint_index];
+         const BoundSource& source = (0. < multiplier) ? this->reduction.constraint_lower_bound_sources[constraint_index] :
+            this->reduction.constraint_upper_bound_sources[constraint_index];
+         if (source.row == NO_ROW) {
+            constraint_multipliers[this->original_index(constraint_index)] = multiplier;
+         }
+         else {
+            constraint_multipliers[source.row] = multiplier / source.ratio;
+         }
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         const BoundSource& lower_source = this->reduction.variable_lower_bound_sources[variable_index];
+         if (0. < iterate.multipliers.lower_bounds[variable_index] && lower_source.row != NO_ROW) {
+            constraint_multipliers[lower_source.row] += iterate.multipliers.lower_bounds[variable_index] / lower_source.ratio;
+            iterate.multipliers.lower_bounds[variable_index] = 0.;
+         }
+         const BoundSource& upper_source = this->reduction.variable_upper_bound_sources[variable_index];
+         if (iterate.multipliers.upper_bounds[variable_index] < 0. && upper_source.row != NO_ROW) {
+            constraint_multipliers[upper_source.row] += iterate.multipliers.upper_bounds[variable_index] / upper_source.ratio;
+            iterate.multipliers.upper_bounds[variable_index] = 0.;
+         }
+      }
+      iterate.number_constraints = this->model->number_constraints;
+      iterate.multipliers.constraints = constraint_multipliers;
+      iterate.evaluations.constraints.resize(this->model->number_constraints);
+      this->model->set_current_point(iterate.primals);
+      this->model->evaluate_constraints(iterate.primals, iterate.evaluations.constraints);
+      this->model->postprocess_solution(iterate, termination_status);
+   }
+
+   size_t LinearPresolveModel::number_objective_gradient_nonzeros() const {
+      return this->model->number_objective_gradient_nonzeros();
+   }
+
+   size_t LinearPresolveModel::number_jacobian_nonzeros() const {
+      return this->model->number_jacobian_nonzeros();
+   }
+
+   size_t LinearPresolveModel::number_hessian_nonzeros() const {
+      return this->model->number_hessian_nonzeros();
+   }
+
+   void LinearPresolveModel::set_current_point(const Vector<double>& x) const {
+      this->model->set_current_point(x);
+   }
+
+   void LinearPresolveModel::invalidate_point() const {
+      this->model->invalidate_point();
+   }
+
+   void LinearPresolveModel::refresh() {
+      // the reductions were derived from the bounds and the constraints at the creation of the reformulation
+      throw std::runtime_error("The linear presolve does not support in-place modifications of the model");
+   }
+
+   bool LinearPresolveModel::supports_concurrent_evaluations() const {
+      return this->model->supports_concurrent_evaluations();
+   }
+
+   bool LinearPresolveModel::declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const {
+      return this->model->declare_hessian_sparsity(row_indices, column_indices);
+   }
+
+   bool LinearPresolveModel::get_user_variable_scaling(Vector<double>& scaling_factors) const {
+      return this->model->get_user_variable_scaling(scaling_factors);
+   }
+} // namespace
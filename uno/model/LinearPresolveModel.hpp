@@ -0,0 +1,130 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_LINEARPRESOLVEMODEL_H
+#define UNO_LINEARPRESOLVEMODEL_H
+
+#include <memory>
+#include <vector>
+#include "Model.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+
+namespace uno {
+   /*! \class LinearPresolveModel
+    * \brief Structural presolve of the linear constraints
+    *
+    *  The coefficients of the linear constraints are read from the Jacobian at the initial point, then:
+    *  - the singleton rows a x_i + b ∈ [l, u] are converted into bounds of x_i;
+    *  - the empty rows are removed (if they are consistent);
+    *  - the duplicate rows (proportional coefficients, detected by hashing the sparsity patterns) are merged into one row whose
+    *    bounds are the intersection of their bounds;
+    *  - the dominated rows, whose activity range over the variable bounds lies within their bounds, are removed.
+    *  The remaining constraints keep their relative order. In postprocess_solution, the multipliers of the rows are recovered from
+    *  the multiplier of the bound or row that replaced them
+    */
+   class LinearPresolveModel: public Model {
+   public:
+      LinearPresolveModel(std::unique_ptr<Model> original_model, double tolerance);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override;
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override;
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override;
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override;
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override;
+      [[nodiscard]] FunctionType get_objective_type() const override;
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override;
+
+      void initial_primal_point(Vector<double>& x) const override;
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override;
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+      void set_current_point(const Vector<double>& x) const override;
+      void invalidate_point() const override;
+      void refresh() override;
+      [[nodiscard]] bool supports_concurrent_evaluations() const override;
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override;
+      [[nodiscard]] bool get_user_variable_scaling(Vector<double>& scaling_factors) const override;
+
+      // index of a remaining constraint in the original model
+      [[nodiscard]] size_t original_index(size_t constraint_index) const { return this->reduction.remaining_constraints[constraint_index]; }
+
+   private:
+      static constexpr size_t NO_ROW{static_cast<size_t>(-1)};
+
+      // row of the original model that provides a bound, with the ratio of its coefficients to those of the bounded quantity
+      struct BoundSource {
+         size_t row{NO_ROW};
+         double ratio{1.};
+      };
+
+      // outcome of the presolve
+      struct Reduction {
+         std::vector<double> variable_lower_bounds{};
+         std::vector<double> variable_upper_bounds{};
+         std::vector<BoundSource> variable_lower_bound_sources{};
+         std::vector<BoundSource> variable_upper_bound_sources{};
+         std::vector<size_t> remaining_constraints{}; /*!< original indices of the constraints of the presolved model */
+         std::vector<double> constraint_lower_bounds{};
+         std::vector<double> constraint_upper_bounds{};
+         std::vector<BoundSource> constraint_lower_bound_sources{};
+         std::vector<BoundSource> constraint_upper_bound_sources{};
+      };
+
+      const std::unique_ptr<Model> model{};
+      const Reduction reduction;
+
+      Vector<size_t> lower_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> lower_bounded_variables_collection;
+      Vector<size_t> upper_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> upper_bounded_variables_collection;
+      Vector<size_t> single_lower_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> single_lower_bounded_variables_collection;
+      Vector<size_t> single_upper_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> single_upper_bounded_variables_collection;
+      Vector<size_t> fixed_variables{};
+      Vector<size_t> equality_constraints{};
+      CollectionAdapter<Vector<size_t>&> equality_constraints_collection;
+      Vector<size_t> inequality_constraints{};
+      CollectionAdapter<Vector<size_t>&> inequality_constraints_collection;
+      Vector<size_t> linear_constraints{};
+      CollectionAdapter<Vector<size_t>&> linear_constraints_collection;
+      SparseVector<size_t> slacks{};
+
+      // workspaces in the original constraint space
+      mutable RectangularMatrix<double> original_jacobian;
+      mutable Vector<double> original_multipliers;
+
+      LinearPresolveModel(std::unique_ptr<Model>&& original_model, Reduction&& reduction);
+      [[nodiscard]] static Reduction presolve(const Model& model, double tolerance);
+      [[nodiscard]] static BoundType determine_bound_type(double lower_bound, double upper_bound);
+   };
+} // namespace
+
+#endif // UNO_LINEARPRESOLVEMODEL_H
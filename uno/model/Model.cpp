@@ -5,7 +5,15 @@
 #include <iostream>
 #include <utility>
 #include "Model.hpp"
+#include "BatchEvaluation.hpp"
+#include "EvaluationScaling.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "tools/AllocationTracker.hpp"
+#include "tools/ThreadPool.hpp"
+#include "tools/Timeline.hpp"
 
 namespace uno {
    // abstract Problem class
@@ -23,6 +31,180 @@ namespace uno {
       return (0 < this->number_constraints);
    }
 
+   bool Model::has_constant_jacobian() const {
+      return (this->get_linear_constraints().size() == this->number_constraints);
+   }
+
+   bool Model::has_constant_hessian() const {
+      return (this->get_objective_type() != NONLINEAR && this->has_constant_jacobian());
+   }
+
+   void Model::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         const Vector<double>& vector, Vector<double>& result) const {
+      SymmetricMatrix<size_t, double> hessian(this->number_variables, this->number_hessian_nonzeros(), false, "COO");
+      this->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+      for (size_t variable_index: Range(this->number_variables)) {
+         result[variable_index] = 0.;
+      }
+      hessian.for_each([&](size_t row_index, size_t column_index, double entry) {
+         result[row_index] += entry * vector[column_index];
+         if (row_index != column_index) {
+            result[column_index] += entry * vector[row_index];
+         }
+      });
+   }
+
+   size_t Model::hessian_low_rank_dimension() const {
+      return 0;
+   }
+
+   void Model::evaluate_hessian_low_rank_term(Vector<double>& /*factors*/, size_t /*leading_dimension*/, Vector<double>& /*middle_matrix*/) const {
+   }
+
+   void Model::evaluate_scaled_objective_gradient(const Vector<double>& x, const EvaluationScaling& scaling, SparseVector<double>& gradient) const {
+      this->evaluate_objective_gradient(x, gradient);
+      scale(gradient, scaling.objective);
+      if (scaling.variables != nullptr) {
+         gradient.scale_elements(scaling.variables);
+      }
+   }
+
+   void Model::evaluate_scaled_constraints(const Vector<double>& x, const EvaluationScaling& scaling, std::vector<double>& constraints) const {
+      this->evaluate_constraints(x, constraints);
+      if (scaling.constraints != nullptr) {
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            constraints[constraint_index] *= scaling.constraints[constraint_index];
+         }
+      }
+   }
+
+   // scales the rows of the Jacobian by the constraint factors and its columns by the variable factors
+   void Model::evaluate_scaled_constraint_jacobian(const Vector<double>& x, const EvaluationScaling& scaling,
+         RectangularMatrix<double>& constraint_jacobian) const {
+      this->evaluate_constraint_jacobian(x, constraint_jacobian);
+      double* entries = constraint_jacobian.data_pointer();
+      const size_t* column_indices = constraint_jacobian.column_indices_pointer();
+      for (size_t constraint_index: Range(constraint_jacobian.number_rows())) {
+         const double row_scaling = scaling.constraint(constraint_index);
+         const size_t row_start = constraint_jacobian.row_start(constraint_index);
+         const size_t row_end = row_start + constraint_jacobian.row_size(constraint_index);
+         for (size_t nonzero_index = row_start; nonzero_index < row_end; nonzero_index++) {
+            entries[nonzero_index] *= row_scaling * scaling.variable(column_indices[nonzero_index]);
+         }
+      }
+   }
+
+   void Model::evaluate_scaled_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         const EvaluationScaling& scaling, SymmetricMatrix<size_t, double>& hessian) const {
+      // scale the objective and constraint multipliers. One workspace per thread: the points may be evaluated concurrently
+      thread_local Vector<double> scaled_multipliers{};
+      if (scaled_multipliers.size() != this->number_constraints) {
+         const AllocationTracker::Prohibition allowed_allocation(false);
+         scaled_multipliers.resize(this->number_constraints);
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         scaled_multipliers[constraint_index] = scaling.constraint(constraint_index) * multipliers[constraint_index];
+      }
+      this->evaluate_lagrangian_hessian(x, scaling.objective * objective_multiplier, scaled_multipliers, hessian);
+      // S H S: the entries are visited in storage order
+      if (scaling.variables != nullptr) {
+         double* entries = hessian.data_pointer();
+         size_t nonzero_index = 0;
+         hessian.for_each([&](size_t row_index, size_t column_index, double /*entry*/) {
+            entries[nonzero_index] *= scaling.variables[row_index] * scaling.variables[column_index];
+            nonzero_index++;
+         });
+      }
+   }
+
+   // the points are distributed among the threads of the installed pool, or among the OpenMP threads
+   void Model::evaluate_batch(BatchEvaluation& evaluation) const {
+      // the worker threads record their evaluations in the timeline of the calling thread
+      Timeline* const timeline = Timeline::current();
+      const auto evaluate_point = [&](size_t point_index) {
+         // the errors are recorded, so that the other points are evaluated
+         try {
+            const Timeline::Event evaluation_event(timeline, "batch evaluation");
+            const Vector<double>& x = evaluation.points[point_index];
+            evaluation.objectives[point_index] = this->evaluate_objective(x);
+            if (this->is_constrained()) {
+               this->evaluate_constraints(x, evaluation.constraints[point_index]);
+            }
+            if (evaluation.evaluate_objective_gradients) {
+               evaluation.objective_gradients[point_index].clear();
+               this->evaluate_objective_gradient(x, evaluation.objective_gradients[point_index]);
+            }
+            evaluation.errors[point_index] = nullptr;
+         }
+         catch (...) {
+            evaluation.errors[point_index] = std::current_exception();
+         }
+      };
+      const bool concurrent_evaluations = this->supports_concurrent_evaluations();
+      if (ThreadPool* pool = ThreadPool::current(); pool != nullptr && concurrent_evaluations) {
+         pool->parallel_for(0, evaluation.number_points(), evaluate_point);
+         return;
+      }
+      const int number_points = static_cast<int>(evaluation.number_points());
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic) if(concurrent_evaluations)
+#endif
+      for (int point_index = 0; point_index < number_points; point_index++) {
+         evaluate_point(static_cast<size_t>(point_index));
+      }
+   }
+
+   void Model::set_current_point(const Vector<double>& /*x*/) const {
+   }
+
+   void Model::invalidate_point() const {
+   }
+
+   void Model::refresh() {
+   }
+
+   bool Model::supports_concurrent_evaluations() const {
+      return false;
+   }
+
+   bool Model::declare_hessian_sparsity(std::vector<size_t>& /*row_indices*/, std::vector<size_t>& /*column_indices*/) const {
+      return false;
+   }
+
+   bool Model::get_user_variable_scaling(Vector<double>& /*scaling_factors*/) const {
+      return false;
+   }
+
+   bool Model::get_initial_basis(std::vector<BasisStatus>& /*variable_statuses*/, std::vector<BasisStatus>& /*constraint_statuses*/) const {
+      return false;
+   }
+
+   bool Model::get_initial_bound_duals(Vector<double>& /*lower_bound_multipliers*/, Vector<double>& /*upper_bound_multipliers*/) const {
+      return false;
+   }
+
+   bool Model::get_stages(std::vector<size_t>& /*variable_stages*/, std::vector<size_t>& /*constraint_stages*/) const {
+      return false;
+   }
+
+   // the arrays are only written if the bounds changed: concurrent solves of the same unchanged model only read them
+   void Model::materialize_constraint_bounds() const {
+      const std::lock_guard<std::mutex> lock(this->constraint_bounds_mutex);
+      bool are_bounds_unchanged = (this->flat_constraint_lower_bounds.size() == this->number_constraints);
+      for (size_t constraint_index = 0; are_bounds_unchanged && constraint_index < this->number_constraints; constraint_index++) {
+         are_bounds_unchanged = (this->flat_constraint_lower_bounds[constraint_index] == this->constraint_lower_bound(constraint_index) &&
+               this->flat_constraint_upper_bounds[constraint_index] == this->constraint_upper_bound(constraint_index));
+      }
+      if (!are_bounds_unchanged) {
+         this->flat_constraint_lower_bounds.resize(this->number_constraints);
+         this->flat_constraint_upper_bounds.resize(this->number_constraints);
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            this->flat_constraint_lower_bounds[constraint_index] = this->constraint_lower_bound(constraint_index);
+            this->flat_constraint_upper_bounds[constraint_index] = this->constraint_upper_bound(constraint_index);
+         }
+      }
+   }
+
    // individual constraint violation
    double Model::constraint_violation(double constraint_value, size_t constraint_index) const {
       const double lower_bound_violation = std::max(0., this->constraint_lower_bound(constraint_index) - constraint_value);
@@ -4,6 +4,9 @@
 #ifndef UNO_MODEL_H
 #define UNO_MODEL_H
 
+#include <cassert>
+#include <limits>
+#include <mutex>
 #include <string>
 #include <vector>
 #include "linear_algebra/Norm.hpp"
@@ -23,11 +26,15 @@ namespace uno {
    template <typename ElementType>
    class Vector;
 
-   enum FunctionType {LINEAR, NONLINEAR};
+   enum FunctionType {LINEAR, QUADRATIC, NONLINEAR};
    enum BoundType {EQUAL_BOUNDS, BOUNDED_LOWER, BOUNDED_UPPER, BOUNDED_BOTH_SIDES, UNBOUNDED};
+   // status of a variable or a constraint in a basis (the fixed variables and the equality constraints are at their lower bound)
+   enum class BasisStatus {BASIC, AT_LOWER_BOUND, AT_UPPER_BOUND};
 
-   // forward declaration
+   // forward declarations
    class Iterate;
+   struct BatchEvaluation;
+   struct EvaluationScaling;
 
    /*! \class Problem
     * \brief Optimization problem
@@ -51,6 +58,29 @@ namespace uno {
       virtual void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const = 0;
       virtual void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
             SymmetricMatrix<size_t, double>& hessian) const = 0;
+      // matrix-free second-order information: overwrites the first number_variables entries of result with the product of the
+      // Lagrangian Hessian and vector. By default, the Hessian is formed explicitly
+      virtual void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const;
+      // compact low-rank term of the Lagrangian Hessian (e.g. limited-memory quasi-Newton): the Hessian is the matrix evaluated by
+      // evaluate_lagrangian_hessian minus W M^{-1} W^T, with W of size number_variables x dimension and the symmetric matrix M of size
+      // dimension x dimension and inertia (dimension/2, dimension/2, 0). By default, the evaluated matrix is the whole Hessian (dimension 0)
+      [[nodiscard]] virtual size_t hessian_low_rank_dimension() const;
+      // W (column-major, leading dimension at least number_variables: the rows beyond number_variables are untouched) and M (column-major)
+      // at the point of the last Hessian evaluation
+      virtual void evaluate_hessian_low_rank_term(Vector<double>& factors, size_t leading_dimension, Vector<double>& middle_matrix) const;
+      // evaluations with the factors of scaling (see EvaluationScaling): the gradient rho_f S_x g, the constraints S_c c, the Jacobian
+      // S_c J S_x and the Lagrangian Hessian S_x H(rho_f sigma, S_c y) S_x. By default, the functions are evaluated, then scaled
+      virtual void evaluate_scaled_objective_gradient(const Vector<double>& x, const EvaluationScaling& scaling, SparseVector<double>& gradient) const;
+      virtual void evaluate_scaled_constraints(const Vector<double>& x, const EvaluationScaling& scaling, std::vector<double>& constraints) const;
+      virtual void evaluate_scaled_constraint_jacobian(const Vector<double>& x, const EvaluationScaling& scaling,
+            RectangularMatrix<double>& constraint_jacobian) const;
+      virtual void evaluate_scaled_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const EvaluationScaling& scaling, SymmetricMatrix<size_t, double>& hessian) const;
+      // evaluations at the points of a batch (multistart candidates, speculative line-search trials, ...). The models that evaluate
+      // several points at once (vectorized or accelerator callbacks) override it, and the wrappers that do not transform the points
+      // forward the whole batch. By default, the points are evaluated one by one, concurrently if the model supports it
+      virtual void evaluate_batch(BatchEvaluation& evaluation) const;
 
       // purely virtual functions
       [[nodiscard]] virtual double variable_lower_bound(size_t variable_index) const = 0;
@@ -65,6 +95,7 @@ namespace uno {
 
       [[nodiscard]] virtual double constraint_lower_bound(size_t constraint_index) const = 0;
       [[nodiscard]] virtual double constraint_upper_bound(size_t constraint_index) const = 0;
+      [[nodiscard]] virtual FunctionType get_objective_type() const = 0;
       [[nodiscard]] virtual FunctionType get_constraint_type(size_t constraint_index) const = 0;
       [[nodiscard]] virtual BoundType get_constraint_bound_type(size_t constraint_index) const = 0;
       [[nodiscard]] virtual const Collection<size_t>& get_equality_constraints() const = 0;
@@ -82,16 +113,61 @@ namespace uno {
       // auxiliary functions
       void project_onto_variable_bounds(Vector<double>& x) const;
       [[nodiscard]] bool is_constrained() const;
+      // problem class: the Jacobian is constant if all constraints are linear, the Lagrangian Hessian is constant if, in addition,
+      // the objective is at most quadratic
+      [[nodiscard]] bool has_constant_jacobian() const;
+      [[nodiscard]] bool has_constant_hessian() const;
+      // point registration: the evaluations that follow are carried out at x, until another point is registered or the point is
+      // invalidated. Models that share work between the evaluations at the same point (e.g. common subexpressions) override them
+      virtual void set_current_point(const Vector<double>& x) const;
+      virtual void invalidate_point() const;
+      // the model was modified in place since the reformulations were created (bounds, appended constraints; see EditableModel):
+      // the reformulations that cache bounds, index collections or evaluations recompute them. By default, nothing is cached
+      virtual void refresh();
+      // the objective and constraints may be evaluated concurrently at different points (e.g. speculative line-search trials).
+      // By default, the model is not assumed thread-safe
+      [[nodiscard]] virtual bool supports_concurrent_evaluations() const;
+      // sparsity pattern (upper triangle, row_index <= column_index) of the Lagrangian Hessian, for the models that do not provide
+      // second derivatives but know their structure. By default, no pattern is declared
+      [[nodiscard]] virtual bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const;
+      // positive scaling factors s of the variables provided by the user (the scaled variables are x / s). By default, none
+      [[nodiscard]] virtual bool get_user_variable_scaling(Vector<double>& scaling_factors) const;
+      // basis of a previous solve provided by the user (hot start of the active-set LP/QP solvers). The statuses of the variables and
+      // constraints of the model are written at the beginning of the vectors. By default, none
+      [[nodiscard]] virtual bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const;
+      // bound multipliers of a previous solve provided by the user (warm start of the interior-point methods). By default, none
+      [[nodiscard]] virtual bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const;
+      // stages of the variables and constraints of a stage-structured model (e.g. the states, controls and dynamics of each time step of
+      // a discretized optimal-control problem), exploited by the block-tridiagonal linear solver. The stages are written at the
+      // beginning of the vectors, which are filled with no_stage. By default, none
+      [[nodiscard]] virtual bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const;
+      static constexpr size_t no_stage = std::numeric_limits<size_t>::max();
 
       // constraint violation
       [[nodiscard]] virtual double constraint_violation(double constraint_value, size_t constraint_index) const;
       template <typename Array>
       double constraint_violation(const Array& constraints, Norm residual_norm) const;
+      // copy the constraint bounds into contiguous arrays, so that the violation of contiguous constraint arrays is computed by a
+      // vectorized kernel. Called at the beginning of each solve, since the bounds may change between solves (e.g. parametric re-solves)
+      void materialize_constraint_bounds() const;
+
+   private:
+      mutable std::vector<double> flat_constraint_lower_bounds{};
+      mutable std::vector<double> flat_constraint_upper_bounds{};
+      mutable std::mutex constraint_bounds_mutex{};
    };
 
    // compute ||c||
    template <typename Array>
    double Model::constraint_violation(const Array& constraints, Norm residual_norm) const {
+      // contiguous constraints and materialized bounds: no virtual call per constraint
+      if constexpr (is_contiguous_double_array_v<Array>) {
+         if (this->flat_constraint_lower_bounds.size() == constraints.size()) {
+            assert(constraints.size() == this->number_constraints && "The constraint array does not have the size of the model");
+            return bound_violation_norm(residual_norm, constraints.data(), this->flat_constraint_lower_bounds.data(),
+                  this->flat_constraint_upper_bounds.data(), constraints.size());
+         }
+      }
       const Range constraints_range = Range(constraints.size());
       const VectorExpression constraint_violation{constraints_range, [&](size_t constraint_index) {
          return this->constraint_violation(constraints[constraint_index], constraint_index);
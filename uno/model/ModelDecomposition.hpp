@@ -0,0 +1,33 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MODELDECOMPOSITION_H
+#define UNO_MODELDECOMPOSITION_H
+
+#include <cstddef>
+#include <vector>
+
+namespace uno {
+   /*! \class ModelDecomposition
+    * \brief Partition of the variables and constraints of a model into independent components
+    *
+    *  No constraint and no second derivative of the Lagrangian couples two variables of different components: the objective is
+    *  separable and the model splits into independent subproblems (see ComponentModel). The variables and constraints of a
+    *  component are sorted by original index; their local index is their position in the component
+    */
+   class ModelDecomposition {
+   public:
+      std::vector<size_t> component_of_variable{};
+      std::vector<size_t> local_index_of_variable{};
+      std::vector<size_t> component_of_constraint{};
+      std::vector<size_t> local_index_of_constraint{};
+      std::vector<std::vector<size_t>> variables{}; /*!< original indices of the variables of each component */
+      std::vector<std::vector<size_t>> constraints{}; /*!< original indices of the constraints of each component */
+      std::vector<size_t> jacobian_nonzeros{}; /*!< number of Jacobian nonzeros of each component */
+      std::vector<size_t> hessian_nonzeros{}; /*!< number of Lagrangian Hessian nonzeros of each component */
+
+      [[nodiscard]] size_t number_components() const { return this->variables.size(); }
+   };
+} // namespace
+
+#endif // UNO_MODELDECOMPOSITION_H
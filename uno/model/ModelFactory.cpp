@@ -1,16 +1,94 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
 #include "ModelFactory.hpp"
 #include "FixedBoundsConstraintsModel.hpp"
 #include "HomogeneousEqualityConstrainedModel.hpp"
 #include "BoundRelaxedModel.hpp"
+#include "BoundTighteningModel.hpp"
+#include "EvaluationCacheModel.hpp"
+#include "DenseQuasiNewtonModel.hpp"
+#include "FiniteDifferenceHessianModel.hpp"
+#include "FixedVariablesEliminationModel.hpp"
+#include "FlattenedModel.hpp"
+#include "LBFGSModel.hpp"
+#include "LinearPresolveModel.hpp"
+#include "ReorderedModel.hpp"
+#include "ScaledModel.hpp"
+#include "ingredients/inequality_handling_methods/InequalityHandlingMethodFactory.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
 #include "options/Options.hpp"
+#include "symbolic/Range.hpp"
 
 namespace uno {
    // note: ownership of the pointer is transferred
    std::unique_ptr<Model> ModelFactory::reformulate(std::unique_ptr<Model> model, const Options& options) {
-      if (options.get_string("subproblem") == "primal_dual_interior_point") {
+      // cache the evaluations of the original functions, underneath the reformulations
+      if (0 < options.get_unsigned_int("evaluation_cache_size")) {
+         model = std::make_unique<EvaluationCacheModel>(std::move(model), options);
+      }
+      // presolve: structural reductions of the linear constraints
+      if (options.get_bool("presolve_linear_constraints")) {
+         model = std::make_unique<LinearPresolveModel>(std::move(model), options.get_double("presolve_tolerance"));
+      }
+      // the augmented Lagrangian subproblems only have bound constraints (the constraints are moved to the objective)
+      const bool augmented_lagrangian = (options.get_string("constraint_relaxation_strategy") == "augmented_lagrangian");
+      const std::string& subproblem = options.get_string("subproblem");
+      const bool interior_point = !augmented_lagrangian && (subproblem == "primal_dual_interior_point" || subproblem == "interior_point_crossover");
+      // presolve: tighten the variable bounds over the linear constraints. The tightened bounds project the initial point and,
+      // for interior points, replace the finite bounds before they are relaxed
+      if (options.get_bool("presolve_bound_tightening")) {
+         model = std::make_unique<BoundTighteningModel>(std::move(model), interior_point, options);
+      }
+      // scale the functions and/or the variables
+      if (options.get_bool("scale_functions") || options.get_string("scale_variables") != "none") {
+         model = std::make_unique<ScaledModel>(std::move(model), options);
+      }
+      // presolve: eliminate the fixed variables
+      if (options.get_bool("eliminate_fixed_variables") && !model->get_fixed_variables().empty()) {
+         model = std::make_unique<FixedVariablesEliminationModel>(std::move(model));
+      }
+      // renumber the variables and the constraints for the locality of the sparse kernels
+      const std::string& reordering = options.get_string("reorder_model");
+      if (reordering == "RCM") {
+         ModelOrdering ordering = Reordering::compute_model_ordering(*model, options.get_unsigned_int("reordering_dense_row_size"));
+         model = std::make_unique<ReorderedModel>(std::move(model), std::move(ordering));
+      }
+      else if (reordering != "none") {
+         throw std::invalid_argument("The reordering " + reordering + " is unknown");
+      }
+      // the L-BFGS-B subproblem handles the bounds and approximates the curvature itself
+      if (InequalityHandlingMethodFactory::uses_LBFGSB_subproblem(augmented_lagrangian ? 0 : model->number_constraints, options)) {
+         return model;
+      }
+      // the reduced-space subproblem approximates the reduced Hessian itself and requires equality constraints (with slacks)
+      if (!augmented_lagrangian && subproblem == "reduced_space") {
+         model = std::make_unique<HomogeneousEqualityConstrainedModel>(std::move(model));
+         return std::make_unique<FlattenedModel>(std::move(model));
+      }
+      // replace the Lagrangian Hessian with a quasi-Newton approximation
+      const std::string& hessian_model = options.get_string("hessian_model");
+      if (hessian_model == "LBFGS") {
+         // the interior-point method keeps the compact form in its augmented system
+         const bool compact_hessian = (0 < InequalityHandlingMethodFactory::hessian_low_rank_dimension(options));
+         model = std::make_unique<LBFGSModel>(std::move(model), options, compact_hessian);
+      }
+      else if (hessian_model == "BFGS") {
+         model = std::make_unique<DenseQuasiNewtonModel>(std::move(model), QuasiNewtonUpdate::BFGS);
+      }
+      else if (hessian_model == "SR1") {
+         model = std::make_unique<DenseQuasiNewtonModel>(std::move(model), QuasiNewtonUpdate::SR1);
+      }
+      else if (hessian_model == "finite_differences") {
+         model = std::make_unique<FiniteDifferenceHessianModel>(std::move(model), options);
+      }
+      if (interior_point) {
          // move the fixed variables to the set of general constraints
          if (!model->get_fixed_variables().empty()) {
             model = std::make_unique<FixedBoundsConstraintsModel>(std::move(model), options);
@@ -19,7 +97,103 @@ namespace uno {
          model = std::make_unique<HomogeneousEqualityConstrainedModel>(std::move(model));
          // slightly relax the bound constraints
          model = std::make_unique<BoundRelaxedModel>(std::move(model), options);
+         // materialize the bounds and collections of the stack of reformulations
+         model = std::make_unique<FlattenedModel>(std::move(model));
       }
       return model;
    }
+
+   ModelDecomposition ModelFactory::decompose(const Model& model, const Vector<double>& point, size_t minimum_component_size) {
+      const size_t number_variables = model.number_variables;
+      // sparsity patterns of the Jacobian and the Lagrangian Hessian (all the constraints contribute)
+      RectangularMatrix<double> jacobian(model.number_constraints, number_variables);
+      model.evaluate_constraint_jacobian(point, jacobian);
+      std::vector<size_t> hessian_row_indices{}, hessian_column_indices{};
+      if (!model.declare_hessian_sparsity(hessian_row_indices, hessian_column_indices)) {
+         SymmetricMatrix<size_t, double> hessian(number_variables, model.number_hessian_nonzeros(), false, "COO");
+         const Vector<double> multipliers(model.number_constraints, 1.);
+         model.evaluate_lagrangian_hessian(point, 1., multipliers, hessian);
+         hessian.for_each([&](size_t row_index, size_t column_index, double /*entry*/) {
+            hessian_row_indices.emplace_back(row_index);
+            hessian_column_indices.emplace_back(column_index);
+         });
+      }
+
+      // union-find with path halving over the variables
+      std::vector<size_t> parent(number_variables);
+      std::iota(parent.begin(), parent.end(), size_t(0));
+      const auto find_root = [&](size_t index) {
+         while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+         }
+         return index;
+      };
+      const auto merge = [&](size_t first_index, size_t second_index) {
+         const size_t first_root = find_root(first_index);
+         const size_t second_root = find_root(second_index);
+         if (first_root != second_root) {
+            parent[std::max(first_root, second_root)] = std::min(first_root, second_root);
+         }
+      };
+      const size_t* column_indices = jacobian.column_indices_pointer();
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         const size_t row_start = jacobian.row_start(constraint_index);
+         for (size_t nonzero_index = row_start + 1; nonzero_index < row_start + jacobian.row_size(constraint_index); nonzero_index++) {
+            merge(column_indices[row_start], column_indices[nonzero_index]);
+         }
+      }
+      for (size_t nonzero_index: Range(hessian_row_indices.size())) {
+         merge(hessian_row_indices[nonzero_index], hessian_column_indices[nonzero_index]);
+      }
+
+      // the components, numbered in the order of their smallest variable, are grouped until they have minimum_component_size variables
+      ModelDecomposition decomposition;
+      decomposition.component_of_variable.resize(number_variables);
+      decomposition.local_index_of_variable.resize(number_variables);
+      std::vector<size_t> group_of_root(number_variables, number_variables);
+      std::vector<size_t> root_sizes(number_variables, 0);
+      for (size_t variable_index: Range(number_variables)) {
+         root_sizes[find_root(variable_index)]++;
+      }
+      size_t number_grouped_variables = 0;
+      for (size_t variable_index: Range(number_variables)) {
+         const size_t root = find_root(variable_index);
+         if (root == variable_index) {
+            if (decomposition.variables.empty() || minimum_component_size <= number_grouped_variables) {
+               decomposition.variables.emplace_back();
+               number_grouped_variables = 0;
+            }
+            group_of_root[root] = decomposition.variables.size() - 1;
+            number_grouped_variables += root_sizes[root];
+         }
+         const size_t component_index = group_of_root[root];
+         decomposition.component_of_variable[variable_index] = component_index;
+         decomposition.local_index_of_variable[variable_index] = decomposition.variables[component_index].size();
+         decomposition.variables[component_index].emplace_back(variable_index);
+      }
+      if (decomposition.variables.empty()) {
+         decomposition.variables.emplace_back();
+      }
+      const size_t number_components = decomposition.number_components();
+
+      // a constraint belongs to the component of its variables (the constraints without variables belong to the first component)
+      decomposition.constraints.resize(number_components);
+      decomposition.component_of_constraint.resize(model.number_constraints);
+      decomposition.local_index_of_constraint.resize(model.number_constraints);
+      decomposition.jacobian_nonzeros.assign(number_components, 0);
+      decomposition.hessian_nonzeros.assign(number_components, 0);
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         const size_t row_size = jacobian.row_size(constraint_index);
+         const size_t component_index = (row_size == 0) ? 0 : decomposition.component_of_variable[column_indices[jacobian.row_start(constraint_index)]];
+         decomposition.component_of_constraint[constraint_index] = component_index;
+         decomposition.local_index_of_constraint[constraint_index] = decomposition.constraints[component_index].size();
+         decomposition.constraints[component_index].emplace_back(constraint_index);
+         decomposition.jacobian_nonzeros[component_index] += row_size;
+      }
+      for (const size_t row_index: hessian_row_indices) {
+         decomposition.hessian_nonzeros[decomposition.component_of_variable[row_index]]++;
+      }
+      return decomposition;
+   }
 } // namespace
\ No newline at end of file
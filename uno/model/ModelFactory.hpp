@@ -6,14 +6,21 @@
 
 #include <memory>
 #include "Model.hpp"
+#include "ModelDecomposition.hpp"
 
 namespace uno {
    // forward declaration
    class Options;
+   template <typename ElementType>
+   class Vector;
 
    class ModelFactory {
    public:
       static std::unique_ptr<Model> reformulate(std::unique_ptr<Model> model, const Options& options);
+      // connected components of the graph whose edges are the constraints and the off-diagonal Lagrangian Hessian entries, detected
+      // with the sparsity patterns at the point. The consecutive components are grouped until they have at least
+      // minimum_component_size variables. Each component is a ComponentModel view of the model
+      static ModelDecomposition decompose(const Model& model, const Vector<double>& point, size_t minimum_component_size);
    };
 } // namespace
 
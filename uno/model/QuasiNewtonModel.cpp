@@ -0,0 +1,73 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <utility>
+#include "QuasiNewtonModel.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   QuasiNewtonModel::QuasiNewtonModel(const std::string& name, std::unique_ptr<Model> original_model):
+         Model(original_model->name + name, original_model->number_variables, original_model->number_constraints,
+            original_model->objective_sign),
+         model(std::move(original_model)),
+         previous_point(this->number_variables),
+         previous_objective_gradient(this->number_variables),
+         previous_jacobian(this->number_constraints, this->number_variables),
+         current_jacobian(this->number_constraints, this->number_variables),
+         objective_gradient(this->number_variables),
+         current_objective_gradient(this->number_variables),
+         jacobian_transposed_multipliers(this->number_variables) {
+   }
+
+   void QuasiNewtonModel::update(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers) const {
+      // the pairs of another Lagrangian (switch to or from the restoration phase) are discarded
+      const bool objective_multiplier_changed = this->has_previous_point && (objective_multiplier != this->previous_objective_multiplier);
+      if (objective_multiplier_changed) {
+         this->reset_approximation();
+      }
+      bool same_point = this->has_previous_point && !objective_multiplier_changed;
+      for (size_t variable_index = 0; same_point && variable_index < this->number_variables; variable_index++) {
+         same_point = (x[variable_index] == this->previous_point[variable_index]);
+      }
+      if (same_point) {
+         return;
+      }
+
+      // derivatives at the current point
+      this->objective_gradient.clear();
+      this->model->evaluate_objective_gradient(x, this->objective_gradient);
+      this->current_objective_gradient.fill(0.);
+      for (const auto [variable_index, derivative]: this->objective_gradient) {
+         this->current_objective_gradient[variable_index] += derivative;
+      }
+      this->current_jacobian.clear();
+      this->model->evaluate_constraint_jacobian(x, this->current_jacobian);
+
+      if (this->has_previous_point && !objective_multiplier_changed) {
+         // difference of the Lagrangian gradients at the current multipliers:
+         // y = sigma (grad f(x) - grad f(x_prev)) - (J(x) - J(x_prev))^T lambda
+         Vector<double> s(this->number_variables);
+         Vector<double> y(this->number_variables);
+         jacobian_transposed_product(this->current_jacobian, multipliers, this->jacobian_transposed_multipliers);
+         for (size_t variable_index: Range(this->number_variables)) {
+            s[variable_index] = x[variable_index] - this->previous_point[variable_index];
+            y[variable_index] = objective_multiplier * (this->current_objective_gradient[variable_index] -
+               this->previous_objective_gradient[variable_index]) - this->jacobian_transposed_multipliers[variable_index];
+         }
+         jacobian_transposed_product(this->previous_jacobian, multipliers, this->jacobian_transposed_multipliers);
+         for (size_t variable_index: Range(this->number_variables)) {
+            y[variable_index] += this->jacobian_transposed_multipliers[variable_index];
+         }
+         this->add_pair(std::move(s), std::move(y));
+      }
+
+      // store the current point and derivatives
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->previous_point[variable_index] = x[variable_index];
+      }
+      std::swap(this->previous_objective_gradient, this->current_objective_gradient);
+      std::swap(this->previous_jacobian, this->current_jacobian);
+      this->previous_objective_multiplier = objective_multiplier;
+      this->has_previous_point = true;
+   }
+} // namespace
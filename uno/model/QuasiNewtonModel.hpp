@@ -0,0 +1,110 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_QUASINEWTONMODEL_H
+#define UNO_QUASINEWTONMODEL_H
+
+#include <memory>
+#include "Model.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   /*! \class QuasiNewtonModel
+    * \brief Model whose Lagrangian Hessian is replaced by a quasi-Newton approximation
+    *
+    *  A new pair (s, y) is formed each time the Hessian is requested at a new point, with y the difference of the Lagrangian gradients
+    *  at the current multipliers. The approximation is reset when the objective multiplier changes (switch to or from the restoration
+    *  phase), since the pairs then describe another Lagrangian
+    */
+   class QuasiNewtonModel: public Model {
+   public:
+      QuasiNewtonModel(const std::string& name, std::unique_ptr<Model> original_model);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override { return this->model->evaluate_objective(x); }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         this->model->evaluate_objective_gradient(x, gradient);
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         this->model->evaluate_constraints(x, constraints);
+      }
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override {
+         this->model->evaluate_constraint_gradient(x, constraint_index, gradient);
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+         this->model->evaluate_constraint_jacobian(x, constraint_jacobian);
+      }
+      void evaluate_batch(BatchEvaluation& evaluation) const override { this->model->evaluate_batch(evaluation); }
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->model->variable_lower_bound(variable_index); }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->model->variable_upper_bound(variable_index); }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override { return this->model->get_variable_bound_type(variable_index); }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->model->get_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->model->get_upper_bounded_variables(); }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->model->get_slacks(); }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->model->get_single_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->model->get_single_upper_bounded_variables(); }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->model->get_fixed_variables(); }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->model->constraint_lower_bound(constraint_index); }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->model->constraint_upper_bound(constraint_index); }
+      // the approximation varies with the point: the Lagrangian Hessian of a quadratic objective is not constant
+      [[nodiscard]] FunctionType get_objective_type() const override {
+         const FunctionType objective_type = this->model->get_objective_type();
+         return (objective_type == QUADRATIC) ? NONLINEAR : objective_type;
+      }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->model->get_constraint_type(constraint_index); }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override { return this->model->get_constraint_bound_type(constraint_index); }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->model->get_equality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->model->get_inequality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->model->get_linear_constraints(); }
+
+      void initial_primal_point(Vector<double>& x) const override { this->model->initial_primal_point(x); }
+      void initial_dual_point(Vector<double>& multipliers) const override { this->model->initial_dual_point(multipliers); }
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override {
+         this->model->postprocess_solution(iterate, termination_status);
+      }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->model->number_objective_gradient_nonzeros(); }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->model->number_jacobian_nonzeros(); }
+      // dense upper triangle
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->number_variables * (this->number_variables + 1) / 2; }
+      void set_current_point(const Vector<double>& x) const override { this->model->set_current_point(x); }
+      void invalidate_point() const override { this->model->invalidate_point(); }
+      void refresh() override { this->model->refresh(); }
+      [[nodiscard]] bool supports_concurrent_evaluations() const override { return this->model->supports_concurrent_evaluations(); }
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override {
+         return this->model->get_initial_basis(variable_statuses, constraint_statuses);
+      }
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override {
+         return this->model->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers);
+      }
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override {
+         return this->model->get_stages(variable_stages, constraint_stages);
+      }
+
+
+   protected:
+      const std::unique_ptr<Model> model{};
+
+      // forms a new pair (s, y) when the point has changed
+      void update(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers) const;
+      virtual void add_pair(Vector<double>&& s, Vector<double>&& y) const = 0;
+      virtual void reset_approximation() const = 0;
+
+   private:
+      // previous point and derivatives
+      mutable bool has_previous_point{false};
+      mutable double previous_objective_multiplier{0.};
+      mutable Vector<double> previous_point;
+      mutable Vector<double> previous_objective_gradient;
+      mutable RectangularMatrix<double> previous_jacobian;
+      mutable RectangularMatrix<double> current_jacobian;
+      mutable SparseVector<double> objective_gradient;
+      mutable Vector<double> current_objective_gradient;
+      mutable Vector<double> jacobian_transposed_multipliers;
+   };
+} // namespace
+
+#endif // UNO_QUASINEWTONMODEL_H
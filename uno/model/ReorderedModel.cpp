@@ -0,0 +1,406 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <stdexcept>
+#include "ReorderedModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "tools/AllocationTracker.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   namespace {
+      std::vector<size_t> inverse_permutation(const std::vector<size_t>& order) {
+         std::vector<size_t> positions(order.size());
+         for (size_t index: Range(order.size())) {
+            positions[order[index]] = index;
+         }
+         return positions;
+      }
+
+      // a[order[k]] = b[k] for the first size elements
+      template <typename Array>
+      void permute_back(Array& array, const std::vector<size_t>& order) {
+         std::vector<typename Array::value_type> copy(order.size());
+         for (size_t index: Range(order.size())) {
+            copy[index] = array[index];
+         }
+         for (size_t index: Range(order.size())) {
+            array[order[index]] = copy[index];
+         }
+      }
+   } // namespace
+
+   ReorderedModel::ReorderedModel(std::unique_ptr<Model> original_model, ModelOrdering ordering):
+         Model(original_model->name + " -> reordered", original_model->number_variables, original_model->number_constraints,
+               original_model->objective_sign),
+         model(std::move(original_model)),
+         variable_order(std::move(ordering.variable_order)),
+         constraint_order(std::move(ordering.constraint_order)),
+         variable_positions(inverse_permutation(this->variable_order)),
+         constraint_positions(inverse_permutation(this->constraint_order)),
+         lower_bounded_variables_collection(this->lower_bounded_variables),
+         upper_bounded_variables_collection(this->upper_bounded_variables),
+         single_lower_bounded_variables_collection(this->single_lower_bounded_variables),
+         single_upper_bounded_variables_collection(this->single_upper_bounded_variables),
+         equality_constraints_collection(this->equality_constraints),
+         inequality_constraints_collection(this->inequality_constraints),
+         linear_constraints_collection(this->linear_constraints),
+         original_gradient(this->model->number_objective_gradient_nonzeros()),
+         original_jacobian(this->model->number_constraints, this->model->number_variables),
+         original_hessian(this->model->number_variables, this->model->number_hessian_nonzeros(), false, "COO"),
+         original_multipliers(this->model->number_constraints),
+         original_vector(this->model->number_variables),
+         original_result(this->model->number_variables),
+         hessian_column_starts(this->model->number_variables + 1),
+         hessian_row_indices(this->model->number_hessian_nonzeros()),
+         hessian_entries(this->model->number_hessian_nonzeros()) {
+      if (this->variable_order.size() != this->number_variables || this->constraint_order.size() != this->number_constraints) {
+         throw std::invalid_argument("The ordering does not have the dimensions of the model");
+      }
+      // the collections of the reordered model
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double lower_bound = this->variable_lower_bound(variable_index);
+         const double upper_bound = this->variable_upper_bound(variable_index);
+         if (is_finite(lower_bound)) {
+            this->lower_bounded_variables.emplace_back(variable_index);
+            if (!is_finite(upper_bound)) {
+               this->single_lower_bounded_variables.emplace_back(variable_index);
+            }
+         }
+         if (is_finite(upper_bound)) {
+            this->upper_bounded_variables.emplace_back(variable_index);
+            if (!is_finite(lower_bound)) {
+               this->single_upper_bounded_variables.emplace_back(variable_index);
+            }
+         }
+      }
+      for (const auto [constraint_index, slack_index]: this->model->get_slacks()) {
+         this->slacks.insert(this->constraint_positions[constraint_index], this->variable_positions[slack_index]);
+      }
+      for (size_t variable_index: this->model->get_fixed_variables()) {
+         this->fixed_variables.emplace_back(this->variable_positions[variable_index]);
+      }
+      std::sort(this->fixed_variables.begin(), this->fixed_variables.end());
+      ReorderedModel::permute_collection(this->model->get_equality_constraints(), this->constraint_positions, this->equality_constraints);
+      ReorderedModel::permute_collection(this->model->get_inequality_constraints(), this->constraint_positions, this->inequality_constraints);
+      ReorderedModel::permute_collection(this->model->get_linear_constraints(), this->constraint_positions, this->linear_constraints);
+   }
+
+   void ReorderedModel::permute_collection(const Collection<size_t>& original_collection, const std::vector<size_t>& positions,
+         Vector<size_t>& collection) {
+      original_collection.for_each([&](size_t element) {
+         collection.emplace_back(positions[element]);
+      });
+      std::sort(collection.begin(), collection.end());
+   }
+
+   const Vector<double>& ReorderedModel::original_point(const Vector<double>& x) const {
+      // one workspace per thread: the points may be evaluated concurrently
+      thread_local Vector<double> point{};
+      if (point.size() != this->number_variables) {
+         const AllocationTracker::Prohibition allowed_allocation(false);
+         point.resize(this->number_variables);
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         point[this->variable_order[variable_index]] = x[variable_index];
+      }
+      return point;
+   }
+
+   void ReorderedModel::permute_multipliers(const Vector<double>& multipliers) const {
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->original_multipliers[this->constraint_order[constraint_index]] = multipliers[constraint_index];
+      }
+   }
+
+   void ReorderedModel::permute_gradient(SparseVector<double>& gradient) const {
+      for (const auto [variable_index, derivative]: this->original_gradient) {
+         gradient.insert(this->variable_positions[variable_index], derivative);
+      }
+   }
+
+   double ReorderedModel::evaluate_objective(const Vector<double>& x) const {
+      return this->model->evaluate_objective(this->original_point(x));
+   }
+
+   void ReorderedModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
+      this->original_gradient.clear();
+      this->model->evaluate_objective_gradient(this->original_point(x), this->original_gradient);
+      this->permute_gradient(gradient);
+   }
+
+   void ReorderedModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      // one workspace per thread: the points may be evaluated concurrently
+      thread_local std::vector<double> original_constraints{};
+      if (original_constraints.size() != this->number_constraints) {
+         const AllocationTracker::Prohibition allowed_allocation(false);
+         original_constraints.resize(this->number_constraints);
+      }
+      this->model->evaluate_constraints(this->original_point(x), original_constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraints[constraint_index] = original_constraints[this->constraint_order[constraint_index]];
+      }
+   }
+
+   void ReorderedModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
+      this->original_gradient.clear();
+      this->model->evaluate_constraint_gradient(this->original_point(x), this->constraint_order[constraint_index], this->original_gradient);
+      this->permute_gradient(gradient);
+   }
+
+   void ReorderedModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      this->original_jacobian.clear();
+      this->model->evaluate_constraint_jacobian(this->original_point(x), this->original_jacobian);
+      const double* entries = this->original_jacobian.data_pointer();
+      const size_t* column_indices = this->original_jacobian.column_indices_pointer();
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         const size_t original_constraint_index = this->constraint_order[constraint_index];
+         const size_t row_start = this->original_jacobian.row_start(original_constraint_index);
+         const size_t row_end = row_start + this->original_jacobian.row_size(original_constraint_index);
+         for (size_t nonzero_index = row_start; nonzero_index < row_end; nonzero_index++) {
+            constraint_jacobian.insert(constraint_index, this->variable_positions[column_indices[nonzero_index]], entries[nonzero_index]);
+         }
+      }
+   }
+
+   void ReorderedModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      this->permute_multipliers(multipliers);
+      this->model->evaluate_lagrangian_hessian(this->original_point(x), objective_multiplier, this->original_multipliers, this->original_hessian);
+      // the permuted entries (in the upper triangle) are sorted by column, so that the Hessian is filled column by column
+      std::fill(this->hessian_column_starts.begin(), this->hessian_column_starts.end(), size_t(0));
+      this->original_hessian.for_each([&](size_t row_index, size_t column_index, double /*entry*/) {
+         const size_t permuted_column_index = std::max(this->variable_positions[row_index], this->variable_positions[column_index]);
+         this->hessian_column_starts[permuted_column_index + 1]++;
+      });
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->hessian_column_starts[variable_index + 1] += this->hessian_column_starts[variable_index];
+      }
+      this->original_hessian.for_each([&](size_t row_index, size_t column_index, double entry) {
+         const size_t permuted_row_index = std::min(this->variable_positions[row_index], this->variable_positions[column_index]);
+         const size_t permuted_column_index = std::max(this->variable_positions[row_index], this->variable_positions[column_index]);
+         const size_t position = this->hessian_column_starts[permuted_column_index]++;
+         this->hessian_row_indices[position] = permuted_row_index;
+         this->hessian_entries[position] = entry;
+      });
+      // the starts were shifted by one column
+      hessian.reset();
+      size_t position = 0;
+      for (size_t variable_index: Range(this->number_variables)) {
+         for (; position < this->hessian_column_starts[variable_index]; position++) {
+            hessian.insert(this->hessian_entries[position], this->hessian_row_indices[position], variable_index);
+         }
+         hessian.finalize_column(variable_index);
+      }
+   }
+
+   void ReorderedModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      this->permute_multipliers(multipliers);
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->original_vector[this->variable_order[variable_index]] = vector[variable_index];
+      }
+      this->model->evaluate_lagrangian_hessian_vector_product(this->original_point(x), objective_multiplier, this->original_multipliers,
+            this->original_vector, this->original_result);
+      for (size_t variable_index: Range(this->number_variables)) {
+         result[variable_index] = this->original_result[this->variable_order[variable_index]];
+      }
+   }
+
+   double ReorderedModel::variable_lower_bound(size_t variable_index) const {
+      return this->model->variable_lower_bound(this->variable_order[variable_index]);
+   }
+
+   double ReorderedModel::variable_upper_bound(size_t variable_index) const {
+      return this->model->variable_upper_bound(this->variable_order[variable_index]);
+   }
+
+   BoundType ReorderedModel::get_variable_bound_type(size_t variable_index) const {
+      return this->model->get_variable_bound_type(this->variable_order[variable_index]);
+   }
+
+   const Collection<size_t>& ReorderedModel::get_lower_bounded_variables() const {
+      return this->lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& ReorderedModel::get_upper_bounded_variables() const {
+      return this->upper_bounded_variables_collection;
+   }
+
+   const SparseVector<size_t>& ReorderedModel::get_slacks() const {
+      return this->slacks;
+   }
+
+   const Collection<size_t>& ReorderedModel::get_single_lower_bounded_variables() const {
+      return this->single_lower_bounded_variables_collection;
+   }
+
+   const Collection<size_t>& ReorderedModel::get_single_upper_bounded_variables() const {
+      return this->single_upper_bounded_variables_collection;
+   }
+
+   const Vector<size_t>& ReorderedModel::get_fixed_variables() const {
+      return this->fixed_variables;
+   }
+
+   double ReorderedModel::constraint_lower_bound(size_t constraint_index) const {
+      return this->model->constraint_lower_bound(this->constraint_order[constraint_index]);
+   }
+
+   double ReorderedModel::constraint_upper_bound(size_t constraint_index) const {
+      return this->model->constraint_upper_bound(this->constraint_order[constraint_index]);
+   }
+
+   FunctionType ReorderedModel::get_objective_type() const {
+      return this->model->get_objective_type();
+   }
+
+   FunctionType ReorderedModel::get_constraint_type(size_t constraint_index) const {
+      return this->model->get_constraint_type(this->constraint_order[constraint_index]);
+   }
+
+   BoundType ReorderedModel::get_constraint_bound_type(size_t constraint_index) const {
+      return this->model->get_constraint_bound_type(this->constraint_order[constraint_index]);
+   }
+
+   const Collection<size_t>& ReorderedModel::get_equality_constraints() const {
+      return this->equality_constraints_collection;
+   }
+
+   const Collection<size_t>& ReorderedModel::get_inequality_constraints() const {
+      return this->inequality_constraints_collection;
+   }
+
+   const Collection<size_t>& ReorderedModel::get_linear_constraints() const {
+      return this->linear_constraints_collection;
+   }
+
+   void ReorderedModel::initial_primal_point(Vector<double>& x) const {
+      this->model->initial_primal_point(this->original_vector);
+      for (size_t variable_index: Range(this->number_variables)) {
+         x[variable_index] = this->original_vector[this->variable_order[variable_index]];
+      }
+   }
+
+   void ReorderedModel::initial_dual_point(Vector<double>& multipliers) const {
+      this->model->initial_dual_point(this->original_multipliers);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         multipliers[constraint_index] = this->original_multipliers[this->constraint_order[constraint_index]];
+      }
+   }
+
+   void ReorderedModel::postprocess_solution(Iterate& iterate, IterateStatus termination_status) const {
+      // restore the original order of the primals, the multipliers and the constraints
+      permute_back(iterate.primals, this->variable_order);
+      permute_back(iterate.multipliers.lower_bounds, this->variable_order);
+      permute_back(iterate.multipliers.upper_bounds, this->variable_order);
+      permute_back(iterate.multipliers.constraints, this->constraint_order);
+      if (iterate.are_constraints_computed) {
+         permute_back(iterate.evaluations.constraints, this->constraint_order);
+      }
+      // the derivatives are not permuted back
+      iterate.is_objective_gradient_computed = false;
+      iterate.is_constraint_jacobian_computed = false;
+      this->model->postprocess_solution(iterate, termination_status);
+   }
+
+   size_t ReorderedModel::number_objective_gradient_nonzeros() const {
+      return this->model->number_objective_gradient_nonzeros();
+   }
+
+   size_t ReorderedModel::number_jacobian_nonzeros() const {
+      return this->model->number_jacobian_nonzeros();
+   }
+
+   size_t ReorderedModel::number_hessian_nonzeros() const {
+      return this->model->number_hessian_nonzeros();
+   }
+
+   void ReorderedModel::set_current_point(const Vector<double>& x) const {
+      this->model->set_current_point(this->original_point(x));
+   }
+
+   void ReorderedModel::invalidate_point() const {
+      this->model->invalidate_point();
+   }
+
+   void ReorderedModel::refresh() {
+      // the permutation and the index collections are those of the model at the creation of the reformulation
+      throw std::runtime_error("The reordering of the model does not support in-place modifications of the model");
+   }
+
+   bool ReorderedModel::supports_concurrent_evaluations() const {
+      return this->model->supports_concurrent_evaluations();
+   }
+
+   bool ReorderedModel::declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const {
+      std::vector<size_t> original_row_indices{}, original_column_indices{};
+      if (!this->model->declare_hessian_sparsity(original_row_indices, original_column_indices)) {
+         return false;
+      }
+      for (size_t nonzero_index: Range(original_row_indices.size())) {
+         const size_t row_index = this->variable_positions[original_row_indices[nonzero_index]];
+         const size_t column_index = this->variable_positions[original_column_indices[nonzero_index]];
+         row_indices.emplace_back(std::min(row_index, column_index));
+         column_indices.emplace_back(std::max(row_index, column_index));
+      }
+      return true;
+   }
+
+   bool ReorderedModel::get_user_variable_scaling(Vector<double>& scaling_factors) const {
+      if (!this->model->get_user_variable_scaling(this->original_vector)) {
+         return false;
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         scaling_factors[variable_index] = this->original_vector[this->variable_order[variable_index]];
+      }
+      return true;
+   }
+
+   bool ReorderedModel::get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const {
+      if (!this->model->get_initial_basis(variable_statuses, constraint_statuses)) {
+         return false;
+      }
+      // the statuses of the original model are at the beginning of the vectors
+      const std::vector<BasisStatus> original_variable_statuses(variable_statuses.begin(), variable_statuses.begin() +
+         static_cast<std::ptrdiff_t>(this->number_variables));
+      for (size_t variable_index: Range(this->number_variables)) {
+         variable_statuses[variable_index] = original_variable_statuses[this->variable_order[variable_index]];
+      }
+      const std::vector<BasisStatus> original_constraint_statuses(constraint_statuses.begin(), constraint_statuses.begin() +
+         static_cast<std::ptrdiff_t>(this->number_constraints));
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraint_statuses[constraint_index] = original_constraint_statuses[this->constraint_order[constraint_index]];
+      }
+      return true;
+   }
+
+   bool ReorderedModel::get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const {
+      Vector<double> original_lower_bound_multipliers(this->number_variables), original_upper_bound_multipliers(this->number_variables);
+      if (!this->model->get_initial_bound_duals(original_lower_bound_multipliers, original_upper_bound_multipliers)) {
+         return false;
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         lower_bound_multipliers[variable_index] = original_lower_bound_multipliers[this->variable_order[variable_index]];
+         upper_bound_multipliers[variable_index] = original_upper_bound_multipliers[this->variable_order[variable_index]];
+      }
+      return true;
+   }
+
+   bool ReorderedModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      std::vector<size_t> original_variable_stages(this->number_variables, Model::no_stage);
+      std::vector<size_t> original_constraint_stages(this->number_constraints, Model::no_stage);
+      if (!this->model->get_stages(original_variable_stages, original_constraint_stages)) {
+         return false;
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         variable_stages[variable_index] = original_variable_stages[this->variable_order[variable_index]];
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraint_stages[constraint_index] = original_constraint_stages[this->constraint_order[constraint_index]];
+      }
+      return true;
+   }
+} // namespace
@@ -0,0 +1,119 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_REORDEREDMODEL_H
+#define UNO_REORDEREDMODEL_H
+
+#include <memory>
+#include <vector>
+#include "Model.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "preprocessing/Reordering.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+
+namespace uno {
+   /*! \class ReorderedModel
+    * \brief Internal permutation of the variables and the constraints
+    *
+    *  The variables and the constraints of the original model are renumbered (see Reordering), so that the nonzeros of the Jacobian
+    *  and the Hessian are clustered around the diagonal: the sparse kernels and the factorizations of the augmented systems access
+    *  memory with a better locality. The evaluations are permuted on the fly and the solution is permuted back in
+    *  postprocess_solution
+    */
+   class ReorderedModel: public Model {
+   public:
+      ReorderedModel(std::unique_ptr<Model> original_model, ModelOrdering ordering);
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override;
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override;
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override;
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override;
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override;
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override;
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override;
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override;
+      [[nodiscard]] FunctionType get_objective_type() const override;
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override;
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override;
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override;
+
+      void initial_primal_point(Vector<double>& x) const override;
+      void initial_dual_point(Vector<double>& multipliers) const override;
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override;
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override;
+      [[nodiscard]] size_t number_hessian_nonzeros() const override;
+      void set_current_point(const Vector<double>& x) const override;
+      void invalidate_point() const override;
+      void refresh() override;
+      [[nodiscard]] bool supports_concurrent_evaluations() const override;
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override;
+      [[nodiscard]] bool get_user_variable_scaling(Vector<double>& scaling_factors) const override;
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override;
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override;
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override;
+
+   private:
+      const std::unique_ptr<Model> model{};
+      const std::vector<size_t> variable_order; /*!< original index of each variable */
+      const std::vector<size_t> constraint_order; /*!< original index of each constraint */
+      std::vector<size_t> variable_positions; /*!< index of each original variable */
+      std::vector<size_t> constraint_positions; /*!< index of each original constraint */
+      Vector<size_t> lower_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> lower_bounded_variables_collection;
+      Vector<size_t> upper_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> upper_bounded_variables_collection;
+      Vector<size_t> single_lower_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> single_lower_bounded_variables_collection;
+      Vector<size_t> single_upper_bounded_variables{};
+      CollectionAdapter<Vector<size_t>&> single_upper_bounded_variables_collection;
+      SparseVector<size_t> slacks{};
+      Vector<size_t> fixed_variables{};
+      Vector<size_t> equality_constraints{};
+      CollectionAdapter<Vector<size_t>&> equality_constraints_collection;
+      Vector<size_t> inequality_constraints{};
+      CollectionAdapter<Vector<size_t>&> inequality_constraints_collection;
+      Vector<size_t> linear_constraints{};
+      CollectionAdapter<Vector<size_t>&> linear_constraints_collection;
+      // workspaces of the evaluations in the original order
+      mutable SparseVector<double> original_gradient;
+      mutable RectangularMatrix<double> original_jacobian;
+      mutable SymmetricMatrix<size_t, double> original_hessian;
+      mutable Vector<double> original_multipliers;
+      mutable Vector<double> original_vector;
+      mutable Vector<double> original_result;
+      // Hessian entries sorted by column (counting sort)
+      mutable std::vector<size_t> hessian_column_starts;
+      mutable std::vector<size_t> hessian_row_indices;
+      mutable std::vector<double> hessian_entries;
+
+      // the point of the original model that corresponds to the reordered point x
+      [[nodiscard]] const Vector<double>& original_point(const Vector<double>& x) const;
+      void permute_multipliers(const Vector<double>& multipliers) const;
+      void permute_gradient(SparseVector<double>& gradient) const;
+      static void permute_collection(const Collection<size_t>& original_collection, const std::vector<size_t>& positions,
+            Vector<size_t>& collection);
+   };
+} // namespace
+
+#endif // UNO_REORDEREDMODEL_H
@@ -1,30 +1,31 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <cmath>
+#include <stdexcept>
 #include "ScaledModel.hpp"
 #include "Model.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
 #include "optimization/Iterate.hpp"
 #include "options/Options.hpp"
+#include "tools/AllocationTracker.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
 
 namespace uno {
-   ScaledModel::ScaledModel(std::unique_ptr<Model> original_model, Iterate& initial_iterate, const Options& options):
+   ScaledModel::ScaledModel(std::unique_ptr<Model> original_model, const Options& options):
          Model(original_model->name + " -> scaled", original_model->number_variables, original_model->number_constraints,
                original_model->objective_sign),
          model(std::move(original_model)),
-         scaling(this->model->number_constraints, options.get_double("function_scaling_threshold")) {
+         scaling(this->model->number_constraints, options.get_double("function_scaling_threshold")),
+         variable_scaling(this->model->number_variables, 1.),
+         scaled_multipliers(this->model->number_constraints) {
+      this->compute_variable_scaling(options.get_string("scale_variables"), options.get_double("variable_scaling_maximum_factor"));
       if (options.get_bool("scale_functions")) {
-         // evaluate the gradients at the current point
-         initial_iterate.evaluate_objective_gradient(*this->model);
-         initial_iterate.evaluate_constraint_jacobian(*this->model);
-         this->scaling.compute(initial_iterate.evaluations.objective_gradient, initial_iterate.evaluations.constraint_jacobian);
-         // scale the gradients
-         scale(initial_iterate.evaluations.objective_gradient, this->scaling.get_objective_scaling());
-         for (size_t constraint_index: Range(this->model->number_constraints)) {
-            scale(initial_iterate.evaluations.constraint_jacobian[constraint_index], this->scaling.get_constraint_scaling(constraint_index));
-         }
-         // since the definition of the constraints changed, reset the evaluation flags
-         initial_iterate.is_objective_gradient_computed = false;
-         initial_iterate.is_constraint_jacobian_computed = false;
+         this->compute_function_scaling();
+         this->evaluation_scaling.objective = this->scaling.get_objective_scaling();
+         this->evaluation_scaling.constraints = this->scaling.get_constraint_scalings().data();
       }
       // check the scaling factors
       assert(0 < this->scaling.get_objective_scaling() && "Objective scaling failed.");
@@ -33,53 +34,145 @@ namespace uno {
       }
    }
 
+   void ScaledModel::compute_variable_scaling(const std::string& strategy, double maximum_factor) {
+      if (strategy == "user") {
+         if (!this->model->get_user_variable_scaling(this->variable_scaling)) {
+            WARNING << "The model provides no variable scaling, the variables are not scaled\n";
+         }
+         for (size_t variable_index: Range(this->number_variables)) {
+            if (!(0. < this->variable_scaling[variable_index]) || !is_finite(this->variable_scaling[variable_index])) {
+               throw std::invalid_argument("The scaling factor of variable " + std::to_string(variable_index) + " is not positive");
+            }
+         }
+      }
+      else if (strategy == "automatic") {
+         // typical magnitude of each variable, rounded to a power of 2 in [1/maximum_factor, maximum_factor]
+         Vector<double> initial_point(this->number_variables);
+         this->model->initial_primal_point(initial_point);
+         for (size_t variable_index: Range(this->number_variables)) {
+            double magnitude = std::abs(initial_point[variable_index]);
+            for (const double bound: {this->model->variable_lower_bound(variable_index), this->model->variable_upper_bound(variable_index)}) {
+               if (is_finite(bound)) {
+                  magnitude = std::max(magnitude, std::abs(bound));
+               }
+            }
+            if (0. < magnitude) {
+               magnitude = std::min(std::max(magnitude, 1. / maximum_factor), maximum_factor);
+               this->variable_scaling[variable_index] = std::exp2(std::round(std::log2(magnitude)));
+            }
+         }
+      }
+      else if (strategy != "none") {
+         throw std::invalid_argument("The variable scaling strategy " + strategy + " is unknown");
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->are_variables_scaled = this->are_variables_scaled || (this->variable_scaling[variable_index] != 1.);
+      }
+      if (this->are_variables_scaled) {
+         this->evaluation_scaling.variables = this->variable_scaling.data();
+      }
+      DEBUG2 << "Variable scaling: " << this->variable_scaling << '\n';
+   }
+
+   void ScaledModel::compute_function_scaling() {
+      // evaluate the gradients of the variable-scaled functions at the initial point
+      Vector<double> initial_point(this->number_variables);
+      this->model->initial_primal_point(initial_point);
+      this->model->project_onto_variable_bounds(initial_point);
+      SparseVector<double> objective_gradient(this->model->number_objective_gradient_nonzeros());
+      RectangularMatrix<double> constraint_jacobian(this->number_constraints, this->number_variables);
+      const EvaluationScaling variable_scaling_only{1., nullptr, this->evaluation_scaling.variables};
+      this->model->evaluate_scaled_objective_gradient(initial_point, variable_scaling_only, objective_gradient);
+      this->model->evaluate_scaled_constraint_jacobian(initial_point, variable_scaling_only, constraint_jacobian);
+      this->scaling.compute(objective_gradient, constraint_jacobian);
+   }
+
+   const Vector<double>& ScaledModel::unscale_point(const Vector<double>& x) const {
+      if (!this->are_variables_scaled) {
+         return x;
+      }
+      // one workspace per thread: the points may be evaluated concurrently
+      thread_local Vector<double> unscaled_point{};
+      if (unscaled_point.size() != x.size()) {
+         const AllocationTracker::Prohibition allowed_allocation(false);
+         unscaled_point.resize(x.size());
+      }
+      // the reformulations on top of this model may append variables (e.g. slacks): they are not scaled
+      for (size_t variable_index: Range(x.size())) {
+         unscaled_point[variable_index] = (variable_index < this->number_variables) ? this->variable_scaling[variable_index] * x[variable_index] :
+            x[variable_index];
+      }
+      return unscaled_point;
+   }
+
+   double ScaledModel::get_variable_scaling(size_t variable_index) const {
+      return this->variable_scaling[variable_index];
+   }
+
    double ScaledModel::evaluate_objective(const Vector<double>& x) const {
-      const double objective = this->model->evaluate_objective(x);
+      const double objective = this->model->evaluate_objective(this->unscale_point(x));
       return this->scaling.get_objective_scaling()*objective;
    }
 
    void ScaledModel::evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const {
-      this->model->evaluate_objective_gradient(x, gradient);
-      scale(gradient, this->scaling.get_objective_scaling());
+      this->model->evaluate_scaled_objective_gradient(this->unscale_point(x), this->evaluation_scaling, gradient);
    }
 
    void ScaledModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
-      this->model->evaluate_constraints(x, constraints);
-      for (size_t constraint_index: Range(this->number_constraints)) {
-         constraints[constraint_index] *= this->scaling.get_constraint_scaling(constraint_index);
-      }
+      this->model->evaluate_scaled_constraints(this->unscale_point(x), this->evaluation_scaling, constraints);
    }
 
    void ScaledModel::evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const {
-      this->model->evaluate_constraint_gradient(x, constraint_index, gradient);
+      this->model->evaluate_constraint_gradient(this->unscale_point(x), constraint_index, gradient);
       scale(gradient, this->scaling.get_constraint_scaling(constraint_index));
+      if (this->are_variables_scaled) {
+         gradient.scale_elements(this->variable_scaling);
+      }
    }
 
    void ScaledModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
-      this->model->evaluate_constraint_jacobian(x, constraint_jacobian);
-      for (size_t constraint_index: Range(this->number_constraints)) {
-         scale(constraint_jacobian[constraint_index], this->scaling.get_constraint_scaling(constraint_index));
-      }
+      this->model->evaluate_scaled_constraint_jacobian(this->unscale_point(x), this->evaluation_scaling, constraint_jacobian);
    }
 
    void ScaledModel::evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
          SymmetricMatrix<size_t, double>& hessian) const {
+      this->model->evaluate_scaled_lagrangian_hessian(this->unscale_point(x), objective_multiplier, multipliers, this->evaluation_scaling, hessian);
+   }
+
+   void ScaledModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
       // scale the objective and constraint multipliers
       const double scaled_objective_multiplier = objective_multiplier*this->scaling.get_objective_scaling();
-      // TODO preallocate this vector
-      static Vector<double> scaled_multipliers(this->number_constraints);
       for (size_t constraint_index: Range(this->number_constraints)) {
-         scaled_multipliers[constraint_index] = this->scaling.get_constraint_scaling(constraint_index) * multipliers[constraint_index];
+         this->scaled_multipliers[constraint_index] = this->scaling.get_constraint_scaling(constraint_index) * multipliers[constraint_index];
+      }
+      if (!this->are_variables_scaled) {
+         this->model->evaluate_lagrangian_hessian_vector_product(x, scaled_objective_multiplier, this->scaled_multipliers, vector, result);
+         return;
+      }
+      // S H (S v)
+      thread_local Vector<double> unscaled_vector{};
+      if (unscaled_vector.size() != vector.size()) {
+         const AllocationTracker::Prohibition allowed_allocation(false);
+         unscaled_vector.resize(vector.size());
+      }
+      for (size_t variable_index: Range(vector.size())) {
+         unscaled_vector[variable_index] = (variable_index < this->number_variables) ?
+            this->variable_scaling[variable_index] * vector[variable_index] : vector[variable_index];
+      }
+      this->model->evaluate_lagrangian_hessian_vector_product(this->unscale_point(x), scaled_objective_multiplier, this->scaled_multipliers,
+            unscaled_vector, result);
+      for (size_t variable_index: Range(this->number_variables)) {
+         result[variable_index] *= this->variable_scaling[variable_index];
       }
-      this->model->evaluate_lagrangian_hessian(x, scaled_objective_multiplier, scaled_multipliers, hessian);
    }
 
    double ScaledModel::variable_lower_bound(size_t variable_index) const {
-      return this->model->variable_lower_bound(variable_index);
+      return this->model->variable_lower_bound(variable_index) / this->variable_scaling[variable_index];
    }
 
    double ScaledModel::variable_upper_bound(size_t variable_index) const {
-      return this->model->variable_upper_bound(variable_index);
+      return this->model->variable_upper_bound(variable_index) / this->variable_scaling[variable_index];
    }
 
    BoundType ScaledModel::get_variable_bound_type(size_t variable_index) const {
@@ -118,6 +211,10 @@ namespace uno {
       return this->scaling.get_constraint_scaling(constraint_index) * this->model->constraint_upper_bound(constraint_index);
    }
 
+   FunctionType ScaledModel::get_objective_type() const {
+      return this->model->get_objective_type();
+   }
+
    FunctionType ScaledModel::get_constraint_type(size_t constraint_index) const {
       return this->model->get_constraint_type(constraint_index);
    }
@@ -140,6 +237,9 @@ namespace uno {
 
    void ScaledModel::initial_primal_point(Vector<double>& x) const {
       this->model->initial_primal_point(x);
+      for (size_t variable_index: Range(this->number_variables)) {
+         x[variable_index] /= this->variable_scaling[variable_index];
+      }
    }
    
    void ScaledModel::initial_dual_point(Vector<double>& multipliers) const {
@@ -153,14 +253,16 @@ namespace uno {
       }
 
       // unscale the constraint multipliers
-      for (size_t constraint_index: Range(iterate.number_constraints)) {
+      for (size_t constraint_index: Range(this->number_constraints)) {
          iterate.multipliers.constraints[constraint_index] *= this->scaling.get_constraint_scaling(constraint_index) / this->scaling.get_objective_scaling();
       }
 
-      // unscale the bound multipliers
-      for (size_t variable_index: Range(iterate.number_variables)) {
-         iterate.multipliers.lower_bounds[variable_index] /= this->scaling.get_objective_scaling();
-         iterate.multipliers.upper_bounds[variable_index] /= this->scaling.get_objective_scaling();
+      // unscale the primals and the bound multipliers
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double variable_scaling = this->variable_scaling[variable_index];
+         iterate.primals[variable_index] *= variable_scaling;
+         iterate.multipliers.lower_bounds[variable_index] /= this->scaling.get_objective_scaling() * variable_scaling;
+         iterate.multipliers.upper_bounds[variable_index] /= this->scaling.get_objective_scaling() * variable_scaling;
       }
       this->model->postprocess_solution(iterate, termination_status);
    }
@@ -176,5 +278,47 @@ namespace uno {
    size_t ScaledModel::number_hessian_nonzeros() const {
       return this->model->number_hessian_nonzeros();
    }
-} // namespace
 
+   void ScaledModel::set_current_point(const Vector<double>& x) const {
+      this->model->set_current_point(this->unscale_point(x));
+   }
+
+   void ScaledModel::invalidate_point() const {
+      this->model->invalidate_point();
+   }
+
+   // the scaling factors are those of the initial bounds
+   void ScaledModel::refresh() {
+      this->model->refresh();
+   }
+
+   bool ScaledModel::supports_concurrent_evaluations() const {
+      return this->model->supports_concurrent_evaluations();
+   }
+
+   bool ScaledModel::declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const {
+      return this->model->declare_hessian_sparsity(row_indices, column_indices);
+   }
+
+   // the scaling factors are positive: the statuses are unchanged
+   bool ScaledModel::get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const {
+      return this->model->get_initial_basis(variable_statuses, constraint_statuses);
+   }
+
+   // scale the bound multipliers (inverse of postprocess_solution)
+   bool ScaledModel::get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const {
+      if (!this->model->get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers)) {
+         return false;
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double scaling = this->scaling.get_objective_scaling() * this->variable_scaling[variable_index];
+         lower_bound_multipliers[variable_index] *= scaling;
+         upper_bound_multipliers[variable_index] *= scaling;
+      }
+      return true;
+   }
+
+   bool ScaledModel::get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const {
+      return this->model->get_stages(variable_stages, constraint_stages);
+   }
+} // namespace
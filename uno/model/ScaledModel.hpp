@@ -5,16 +5,29 @@
 #define UNO_SCALEDMODEL_H
 
 #include <memory>
+#include <string>
+#include "EvaluationScaling.hpp"
 #include "Model.hpp"
+#include "linear_algebra/Vector.hpp"
 #include "preprocessing/Scaling.hpp"
 
 namespace uno {
    // forward declaration
    class Options;
 
+   /*! \class ScaledModel
+    * \brief Scaled reformulation of a model
+    *
+    *  The objective and the constraints are multiplied by positive factors computed from the gradients at the initial point
+    *  (option scale_functions). The variables are divided by positive factors s (option scale_variables): the scaled model is
+    *  expressed in x~ = x / s and its derivatives are scaled by s accordingly. The factors are provided by the user (see
+    *  Model::get_user_variable_scaling) or computed from the magnitudes of the initial point and of the bounds (powers of 2, the
+    *  scaling is then exact in floating-point arithmetic). The factors are passed down with the evaluations (see EvaluationScaling),
+    *  so that the evaluators apply them while they write their output
+    */
    class ScaledModel: public Model {
    public:
-      ScaledModel(std::unique_ptr<Model> original_model, Iterate& initial_iterate, const Options& options);
+      ScaledModel(std::unique_ptr<Model> original_model, const Options& options);
 
       [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override;
       void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override;
@@ -23,6 +36,8 @@ namespace uno {
       void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
       void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
             SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
 
       [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
       [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
@@ -36,6 +51,7 @@ namespace uno {
 
       [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override;
       [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override;
+      [[nodiscard]] FunctionType get_objective_type() const override;
       [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override;
       [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override;
       [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override;
@@ -49,10 +65,29 @@ namespace uno {
       [[nodiscard]] size_t number_objective_gradient_nonzeros() const override;
       [[nodiscard]] size_t number_jacobian_nonzeros() const override;
       [[nodiscard]] size_t number_hessian_nonzeros() const override;
+      void set_current_point(const Vector<double>& x) const override;
+      void invalidate_point() const override;
+      void refresh() override;
+      [[nodiscard]] bool supports_concurrent_evaluations() const override;
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override;
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override;
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override;
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override;
+
+      [[nodiscard]] double get_variable_scaling(size_t variable_index) const;
 
    private:
       const std::unique_ptr<Model> model{};
       Scaling scaling;
+      Vector<double> variable_scaling; /*!< x = variable_scaling * x~ */
+      bool are_variables_scaled{false};
+      EvaluationScaling evaluation_scaling{}; /*!< factors passed down with the evaluations */
+      mutable Vector<double> scaled_multipliers;
+
+      void compute_variable_scaling(const std::string& strategy, double maximum_factor);
+      void compute_function_scaling();
+      // the point of the original model that corresponds to the scaled point x~
+      [[nodiscard]] const Vector<double>& unscale_point(const Vector<double>& x) const;
    };
 } // namespace
 
@@ -0,0 +1,123 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SHAREDMODEL_H
+#define UNO_SHAREDMODEL_H
+
+#include <utility>
+#include "Model.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   /*! \class SharedModel
+    * \brief Non-owning view of a model
+    *
+    *  Read-only view of a model shared by several solves (e.g. the starts of a multistart), with its own initial primal point.
+    *  The postprocessing of the solution is left to the owner of the model, unless it is explicitly enabled
+    */
+   class SharedModel: public Model {
+   public:
+      SharedModel(const Model& model, Vector<double> initial_point):
+            Model(model.name, model.number_variables, model.number_constraints, model.objective_sign),
+            model(model), initial_point(std::move(initial_point)) { }
+
+      void enable_postprocessing() { this->is_postprocessing_enabled = true; }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override { return this->model.evaluate_objective(x); }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         this->model.evaluate_objective_gradient(x, gradient);
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         this->model.evaluate_constraints(x, constraints);
+      }
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override {
+         this->model.evaluate_constraint_gradient(x, constraint_index, gradient);
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+         this->model.evaluate_constraint_jacobian(x, constraint_jacobian);
+      }
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         this->model.evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+      }
+      void evaluate_batch(BatchEvaluation& evaluation) const override { this->model.evaluate_batch(evaluation); }
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override {
+         this->model.evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+      }
+      void evaluate_scaled_objective_gradient(const Vector<double>& x, const EvaluationScaling& scaling, SparseVector<double>& gradient) const override {
+         this->model.evaluate_scaled_objective_gradient(x, scaling, gradient);
+      }
+      void evaluate_scaled_constraints(const Vector<double>& x, const EvaluationScaling& scaling, std::vector<double>& constraints) const override {
+         this->model.evaluate_scaled_constraints(x, scaling, constraints);
+      }
+      void evaluate_scaled_constraint_jacobian(const Vector<double>& x, const EvaluationScaling& scaling,
+            RectangularMatrix<double>& constraint_jacobian) const override {
+         this->model.evaluate_scaled_constraint_jacobian(x, scaling, constraint_jacobian);
+      }
+      void evaluate_scaled_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const EvaluationScaling& scaling, SymmetricMatrix<size_t, double>& hessian) const override {
+         this->model.evaluate_scaled_lagrangian_hessian(x, objective_multiplier, multipliers, scaling, hessian);
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->model.variable_lower_bound(variable_index); }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->model.variable_upper_bound(variable_index); }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override { return this->model.get_variable_bound_type(variable_index); }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->model.get_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->model.get_upper_bounded_variables(); }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->model.get_slacks(); }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->model.get_single_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->model.get_single_upper_bounded_variables(); }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->model.get_fixed_variables(); }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return this->model.constraint_lower_bound(constraint_index); }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return this->model.constraint_upper_bound(constraint_index); }
+      [[nodiscard]] FunctionType get_objective_type() const override { return this->model.get_objective_type(); }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override { return this->model.get_constraint_type(constraint_index); }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override { return this->model.get_constraint_bound_type(constraint_index); }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->model.get_equality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->model.get_inequality_constraints(); }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->model.get_linear_constraints(); }
+
+      // the reformulations may append variables (e.g. slacks) after the original ones
+      void initial_primal_point(Vector<double>& x) const override {
+         for (size_t variable_index: Range(this->number_variables)) {
+            x[variable_index] = this->initial_point[variable_index];
+         }
+      }
+      void initial_dual_point(Vector<double>& multipliers) const override { this->model.initial_dual_point(multipliers); }
+      void postprocess_solution(Iterate& iterate, IterateStatus termination_status) const override {
+         if (this->is_postprocessing_enabled) {
+            this->model.postprocess_solution(iterate, termination_status);
+         }
+      }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->model.number_objective_gradient_nonzeros(); }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->model.number_jacobian_nonzeros(); }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->model.number_hessian_nonzeros(); }
+      void set_current_point(const Vector<double>& x) const override { this->model.set_current_point(x); }
+      void invalidate_point() const override { this->model.invalidate_point(); }
+      [[nodiscard]] bool supports_concurrent_evaluations() const override { return this->model.supports_concurrent_evaluations(); }
+
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override {
+         return this->model.declare_hessian_sparsity(row_indices, column_indices);
+      }
+      [[nodiscard]] bool get_initial_basis(std::vector<BasisStatus>& variable_statuses, std::vector<BasisStatus>& constraint_statuses) const override {
+         return this->model.get_initial_basis(variable_statuses, constraint_statuses);
+      }
+      [[nodiscard]] bool get_initial_bound_duals(Vector<double>& lower_bound_multipliers, Vector<double>& upper_bound_multipliers) const override {
+         return this->model.get_initial_bound_duals(lower_bound_multipliers, upper_bound_multipliers);
+      }
+      [[nodiscard]] bool get_stages(std::vector<size_t>& variable_stages, std::vector<size_t>& constraint_stages) const override {
+         return this->model.get_stages(variable_stages, constraint_stages);
+      }
+
+   private:
+      const Model& model;
+      const Vector<double> initial_point;
+      bool is_postprocessing_enabled{false};
+   };
+} // namespace
+
+#endif // UNO_SHAREDMODEL_H
\ No newline at end of file
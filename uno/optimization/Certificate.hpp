@@ -0,0 +1,35 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CERTIFICATE_H
+#define UNO_CERTIFICATE_H
+
+#include <string>
+#include <vector>
+
+namespace uno {
+   enum class CertificateType {
+      NONE = 0,
+      INFEASIBILITY, /* approximate Farkas certificate */
+      UNBOUNDEDNESS /* approximate primal ray */
+   };
+
+   /*! \struct Certificate
+    * \brief Evidence of an infeasible or unbounded termination (IterateStatus INFEASIBLE_STATIONARY_POINT or UNBOUNDED)
+    *
+    *  Infeasibility: the multipliers (y, z_L, z_U), normalized to unit infinity norm, for which J(x)^T y + z_L + z_U is approximately
+    *  zero while the constraints are violated. Unboundedness: the last primal step, normalized to unit infinity norm, along which
+    *  the objective decreases without bound. The test identifies the detection that produced the certificate
+    */
+   struct Certificate {
+      CertificateType type{CertificateType::NONE};
+      std::string test{}; /*!< "stationary point", "stalled restoration", "dual ray", "objective threshold" or "objective divergence" */
+      double residual{0.}; /*!< stationarity residual of the test (infeasibility) */
+      std::vector<double> constraint_multipliers{};
+      std::vector<double> lower_bound_multipliers{};
+      std::vector<double> upper_bound_multipliers{};
+      std::vector<double> primal_ray{};
+   };
+} // namespace
+
+#endif // UNO_CERTIFICATE_H
@@ -9,7 +9,7 @@ namespace uno {
    Direction::Direction(size_t number_variables, size_t number_constraints) :
          number_variables(number_variables), number_constraints(number_constraints),
          primals(number_variables), multipliers(number_variables, number_constraints),
-         feasibility_multipliers(number_variables, number_constraints)  {
+         feasibility_multipliers(number_variables, number_constraints), jacobian_product(number_constraints) {
    }
 
    void Direction::set_dimensions(size_t new_number_variables, size_t new_number_constraints) {
@@ -21,6 +21,7 @@ namespace uno {
       this->primals.fill(0.);
       this->multipliers.reset();
       this->feasibility_multipliers.reset();
+      this->invalidate_cached_products();
    }
 
    std::string status_to_string(SubproblemStatus status) {
@@ -27,8 +27,15 @@ namespace uno {
       double norm{INF<double>}; /*!< Norm of \f$x\f$ */
       double subproblem_objective{INF<double>}; /*!< Objective value */
 
+      // products that only depend on the primal direction, computed once per direction by the predicted reduction models
+      mutable Vector<double> jacobian_product; /*!< \f$\nabla c(x)^T d\f$ */
+      mutable double hessian_quadratic_product{0.}; /*!< \f$d^T H d\f$ */
+      mutable bool are_products_cached{false};
+
       void set_dimensions(size_t new_number_variables, size_t new_number_constraints);
       void reset();
+      // to be called whenever the primal direction is modified
+      void invalidate_cached_products() { this->are_products_cached = false; }
 
       friend std::ostream& operator<<(std::ostream& stream, const Direction& direction);
    };
@@ -4,7 +4,7 @@
 #ifndef UNO_DUALRESIDUALS_H
 #define UNO_DUALRESIDUALS_H
 
-#include "optimization/LagrangianGradient.hpp"
+#include "linear_algebra/Vector.hpp"
 #include "tools/Infinity.hpp"
 
 namespace uno {
@@ -18,7 +18,8 @@ namespace uno {
       double stationarity_scaling{INF<double>};
       double complementarity_scaling{INF<double>};
 
-      LagrangianGradient<double> lagrangian_gradient;
+      // scaled Lagrangian gradient, assembled by the fused stationarity kernel
+      Vector<double> lagrangian_gradient;
    };
 } // namespace
 
@@ -0,0 +1,34 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include "EvaluationCounters.hpp"
+
+namespace uno {
+   namespace {
+      thread_local EvaluationCounters fallback_counters{};
+      thread_local EvaluationCounters* installed_counters{nullptr};
+   } // namespace
+
+   EvaluationCounters& EvaluationCounters::current() {
+      return (installed_counters != nullptr) ? *installed_counters : fallback_counters;
+   }
+
+   EvaluationCounters& EvaluationCounters::operator+=(const EvaluationCounters& other) {
+      this->objective += other.objective;
+      this->constraints += other.constraints;
+      this->objective_gradient += other.objective_gradient;
+      this->jacobian += other.jacobian;
+      this->cache_hits += other.cache_hits;
+      this->cache_misses += other.cache_misses;
+      this->time += other.time;
+      return *this;
+   }
+
+   EvaluationCounters::Scope::Scope(EvaluationCounters& counters): previous_counters(installed_counters) {
+      installed_counters = &counters;
+   }
+
+   EvaluationCounters::Scope::~Scope() {
+      installed_counters = this->previous_counters;
+   }
+} // namespace
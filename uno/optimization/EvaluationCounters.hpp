@@ -0,0 +1,61 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_EVALUATIONCOUNTERS_H
+#define UNO_EVALUATIONCOUNTERS_H
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+#include "tools/Profiler.hpp"
+
+namespace uno {
+   // numbers of function evaluations of a single solve. The counters of a solve are installed on the solving thread for its
+   // duration (see Scope), so that concurrent solves on different threads do not share any mutable state
+   struct EvaluationCounters {
+      size_t objective{0};
+      size_t constraints{0};
+      size_t objective_gradient{0};
+      size_t jacobian{0};
+      size_t cache_hits{0};
+      size_t cache_misses{0};
+      // cumulative wall time (in seconds) of the evaluations measured by EvaluationTimer
+      double time{0.};
+
+      // accumulates the counters of another thread (e.g. a concurrent task)
+      EvaluationCounters& operator+=(const EvaluationCounters& other);
+
+      // counters installed on the calling thread (or a thread-local fallback if no solve is running on this thread)
+      [[nodiscard]] static EvaluationCounters& current();
+
+      // installs counters on the calling thread and restores the previous ones upon destruction
+      class Scope {
+      public:
+         explicit Scope(EvaluationCounters& counters);
+         ~Scope();
+         Scope(const Scope&) = delete;
+         Scope& operator=(const Scope&) = delete;
+
+      private:
+         EvaluationCounters* const previous_counters;
+      };
+   };
+
+   // measures the scope as a phase of the current profiler and adds its duration to the evaluation time of the current counters
+   class EvaluationTimer {
+   public:
+      explicit EvaluationTimer(std::string_view name): phase_timer(name) { }
+      ~EvaluationTimer() {
+         const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - this->start_time;
+         EvaluationCounters::current().time += duration.count();
+      }
+      EvaluationTimer(const EvaluationTimer&) = delete;
+      EvaluationTimer& operator=(const EvaluationTimer&) = delete;
+
+   private:
+      const ScopedTimer phase_timer;
+      const std::chrono::steady_clock::time_point start_time{std::chrono::steady_clock::now()};
+   };
+} // namespace
+
+#endif // UNO_EVALUATIONCOUNTERS_H
@@ -21,6 +21,11 @@ namespace uno {
             objective_gradient(number_variables),
             constraint_jacobian(number_constraints, number_variables) {
       }
+
+      // allocated memory (in bytes)
+      [[nodiscard]] size_t memory_size() const {
+         return this->constraints.capacity() * sizeof(double) + this->objective_gradient.memory_size() + this->constraint_jacobian.memory_size();
+      }
    };
 } // namespace
 
@@ -1,19 +1,16 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include "Iterate.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "model/Model.hpp"
+#include "optimization/EvaluationCounters.hpp"
 #include "optimization/EvaluationErrors.hpp"
 #include "tools/Logger.hpp"
 
 namespace uno {
-   size_t Iterate::number_eval_objective = 0;
-   size_t Iterate::number_eval_constraints = 0;
-   size_t Iterate::number_eval_objective_gradient = 0;
-   size_t Iterate::number_eval_jacobian = 0;
-
    Iterate::Iterate(size_t number_variables, size_t number_constraints) :
          number_variables(number_variables), number_constraints(number_constraints),
          primals(number_variables), multipliers(number_variables, number_constraints), feasibility_multipliers(number_variables, number_constraints),
@@ -22,9 +19,11 @@ namespace uno {
 
    void Iterate::evaluate_objective(const Model& model) {
       if (!this->is_objective_computed) {
+         const EvaluationTimer evaluation_timer("objective evaluation");
+         model.set_current_point(this->primals);
          // evaluate the objective
          this->evaluations.objective = model.evaluate_objective(this->primals);
-         Iterate::number_eval_objective++;
+         EvaluationCounters::current().objective++;
          if (!is_finite(this->evaluations.objective)) {
             throw FunctionEvaluationError();
          }
@@ -35,9 +34,11 @@ namespace uno {
    void Iterate::evaluate_constraints(const Model& model) {
       if (!this->are_constraints_computed) {
          if (model.is_constrained()) {
+            const EvaluationTimer evaluation_timer("constraint evaluation");
+            model.set_current_point(this->primals);
             // evaluate the constraints
             model.evaluate_constraints(this->primals, this->evaluations.constraints);
-            Iterate::number_eval_constraints++;
+            EvaluationCounters::current().constraints++;
             // check finiteness
             if (std::any_of(this->evaluations.constraints.cbegin(), this->evaluations.constraints.cend(), [](double constraint_j) {
                return !is_finite(constraint_j);
@@ -51,11 +52,13 @@ namespace uno {
 
    void Iterate::evaluate_objective_gradient(const Model& model) {
       if (!this->is_objective_gradient_computed) {
+         const EvaluationTimer evaluation_timer("objective gradient evaluation");
          this->evaluations.objective_gradient.clear();
+         model.set_current_point(this->primals);
          // evaluate the objective gradient
          model.evaluate_objective_gradient(this->primals, this->evaluations.objective_gradient);
          this->is_objective_gradient_computed = true;
-         Iterate::number_eval_objective_gradient++;
+         EvaluationCounters::current().objective_gradient++;
       }
    }
 
@@ -63,13 +66,24 @@ namespace uno {
       if (!this->is_constraint_jacobian_computed) {
          this->evaluations.constraint_jacobian.clear();
          if (model.is_constrained()) {
+            const EvaluationTimer evaluation_timer("Jacobian evaluation");
+            model.set_current_point(this->primals);
             model.evaluate_constraint_jacobian(this->primals, this->evaluations.constraint_jacobian);
-            Iterate::number_eval_jacobian++;
+            EvaluationCounters::current().jacobian++;
          }
          this->is_constraint_jacobian_computed = true;
       }
    }
 
+   size_t Iterate::memory_size() const {
+      size_t size = this->primals.memory_size() + this->multipliers.memory_size() + this->feasibility_multipliers.memory_size() +
+            this->evaluations.memory_size();
+      for (const DualResiduals* dual_residuals: {&this->residuals, &this->feasibility_residuals}) {
+         size += dual_residuals->lagrangian_gradient.memory_size();
+      }
+      return size;
+   }
+
    void Iterate::set_number_variables(size_t new_number_variables) {
       this->number_variables = new_number_variables;
       this->primals.resize(new_number_variables);
@@ -79,6 +93,38 @@ namespace uno {
       this->residuals.lagrangian_gradient.resize(new_number_variables);
    }
 
+   // restore the state of a newly constructed iterate. The buffers are kept if the dimensions are unchanged
+   void Iterate::reset(size_t new_number_variables, size_t new_number_constraints) {
+      if (new_number_variables != this->number_variables || new_number_constraints != this->number_constraints ||
+            this->primals.size() != new_number_variables) {
+         *this = Iterate(new_number_variables, new_number_constraints);
+         return;
+      }
+      this->primals.fill(0.);
+      this->multipliers.reset();
+      this->feasibility_multipliers.reset();
+      this->objective_multiplier = 1.;
+      this->evaluations.objective = INF<double>;
+      std::fill(this->evaluations.constraints.begin(), this->evaluations.constraints.end(), 0.);
+      this->evaluations.objective_gradient.clear();
+      this->evaluations.constraint_jacobian.clear();
+      this->is_objective_computed = false;
+      this->are_constraints_computed = false;
+      this->is_objective_gradient_computed = false;
+      this->is_constraint_jacobian_computed = false;
+      this->are_feasibility_residuals_computed = false;
+      this->primal_feasibility = INF<double>;
+      for (DualResiduals* dual_residuals: {&this->residuals, &this->feasibility_residuals}) {
+         dual_residuals->stationarity = INF<double>;
+         dual_residuals->complementarity = INF<double>;
+         dual_residuals->stationarity_scaling = INF<double>;
+         dual_residuals->complementarity_scaling = INF<double>;
+         dual_residuals->lagrangian_gradient.fill(0.);
+      }
+      this->progress = {INF<double>, {}, INF<double>};
+      this->status = IterateStatus::NOT_OPTIMAL;
+   }
+
    std::ostream& operator<<(std::ostream& stream, const Iterate& iterate) {
       stream << "Primal variables: " << iterate.primals << '\n';
       stream << "            ┌ Constraint: " << iterate.multipliers.constraints << '\n';
@@ -92,10 +138,10 @@ namespace uno {
 
       stream << "          ┌ Stationarity: " << iterate.residuals.stationarity << '\n';
       stream << "Residuals │ Complementarity: " << iterate.residuals.complementarity << '\n';
-      stream << "          └ Lagrangian gradient: " << iterate.residuals.lagrangian_gradient;
+      stream << "          └ Lagrangian gradient: " << iterate.residuals.lagrangian_gradient << '\n';
       stream << "Feasibility residuals ┌ Stationarity: " << iterate.feasibility_residuals.stationarity << '\n';
       stream << "                      │ Complementarity: " << iterate.feasibility_residuals.complementarity << '\n';
-      stream << "                      └ Lagrangian gradient: " << iterate.feasibility_residuals.lagrangian_gradient;
+      stream << "                      └ Lagrangian gradient: " << iterate.feasibility_residuals.lagrangian_gradient << '\n';
 
       stream << "                  ┌ Infeasibility: " << iterate.progress.infeasibility << '\n';
       stream << "Progress measures │ Optimality: " << iterate.progress.objective(1.) << '\n';
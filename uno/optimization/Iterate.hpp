@@ -19,6 +19,8 @@ namespace uno {
       Iterate(size_t number_variables, size_t number_constraints);
       Iterate(const Iterate& other) = default;
       Iterate(Iterate&& other) = default;
+      // the assignments reuse the buffers of the iterate when the dimensions do not grow
+      Iterate& operator=(const Iterate& other) = default;
       Iterate& operator=(Iterate&& other) = default;
 
       size_t number_variables;
@@ -30,15 +32,12 @@ namespace uno {
 
       // evaluations
       Evaluations evaluations;
-      static size_t number_eval_objective;
-      static size_t number_eval_constraints;
-      static size_t number_eval_objective_gradient;
-      static size_t number_eval_jacobian;
       // lazy evaluation flags
       bool is_objective_computed{false};
       bool are_constraints_computed{false};
       bool is_objective_gradient_computed{false}; /*!< Flag that indicates if the objective gradient has already been computed */
       bool is_constraint_jacobian_computed{false}; /*!< Flag that indicates if the constraint Jacobian has already been computed */
+      bool are_feasibility_residuals_computed{false}; /*!< Flag that indicates if the feasibility residuals are up to date */
 
       // primal-dual residuals
       double primal_feasibility{INF<double>};
@@ -57,6 +56,9 @@ namespace uno {
       void evaluate_constraint_jacobian(const Model& model);
 
       void set_number_variables(size_t number_variables);
+      void reset(size_t number_variables, size_t number_constraints);
+      // allocated memory of the primal-dual point, the evaluations and the residuals (in bytes)
+      [[nodiscard]] size_t memory_size() const;
 
       friend std::ostream& operator<<(std::ostream& stream, const Iterate& iterate);
    };
@@ -0,0 +1,40 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include "IteratePool.hpp"
+
+namespace uno {
+   Iterate& IteratePool::acquire(size_t number_variables, size_t number_constraints) {
+      if (this->number_used < this->iterates.size()) {
+         Iterate& iterate = *this->iterates[this->number_used++];
+         iterate.reset(number_variables, number_constraints);
+         return iterate;
+      }
+      this->iterates.emplace_back(std::make_unique<Iterate>(number_variables, number_constraints));
+      this->number_used++;
+      return *this->iterates.back();
+   }
+
+   Iterate& IteratePool::acquire(const Iterate& other) {
+      if (this->number_used < this->iterates.size()) {
+         Iterate& iterate = *this->iterates[this->number_used++];
+         iterate = other;
+         return iterate;
+      }
+      this->iterates.emplace_back(std::make_unique<Iterate>(other));
+      this->number_used++;
+      return *this->iterates.back();
+   }
+
+   void IteratePool::release_all() {
+      this->number_used = 0;
+   }
+
+   size_t IteratePool::memory_size() const {
+      size_t size = 0;
+      for (const std::unique_ptr<Iterate>& iterate: this->iterates) {
+         size += iterate->memory_size();
+      }
+      return size;
+   }
+} // namespace
@@ -0,0 +1,37 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_ITERATEPOOL_H
+#define UNO_ITERATEPOOL_H
+
+#include <memory>
+#include <vector>
+#include "Iterate.hpp"
+
+namespace uno {
+   // Pool of iterates whose buffers (primals, multipliers, evaluations, residuals) survive across solves.
+   // An acquired iterate is overwritten in place: no allocation occurs as long as the dimensions do not grow.
+   // release_all() hands all the iterates back to the pool without freeing them
+   class IteratePool {
+   public:
+      IteratePool() = default;
+
+      // iterate in the state of a newly constructed Iterate(number_variables, number_constraints)
+      [[nodiscard]] Iterate& acquire(size_t number_variables, size_t number_constraints);
+      // copy of an existing iterate
+      [[nodiscard]] Iterate& acquire(const Iterate& other);
+      void release_all();
+
+      [[nodiscard]] size_t number_acquired() const { return this->number_used; }
+      [[nodiscard]] size_t capacity() const { return this->iterates.size(); }
+      // allocated memory of all the iterates of the pool (in bytes)
+      [[nodiscard]] size_t memory_size() const;
+
+   protected:
+      // the iterates are stored by pointer so that the acquired references remain valid when the pool grows
+      std::vector<std::unique_ptr<Iterate>> iterates{};
+      size_t number_used{0};
+   };
+} // namespace
+
+#endif // UNO_ITERATEPOOL_H
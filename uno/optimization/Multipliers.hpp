@@ -22,6 +22,10 @@ namespace uno {
 
       void reset();
       [[nodiscard]] bool not_all_zero(size_t number_variables, double tolerance) const;
+      // allocated memory (in bytes)
+      [[nodiscard]] size_t memory_size() const {
+         return this->lower_bounds.memory_size() + this->upper_bounds.memory_size() + this->constraints.memory_size();
+      }
    };
 } // namespace
 
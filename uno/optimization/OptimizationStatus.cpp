@@ -20,6 +20,12 @@ namespace uno {
       else if (status == OptimizationStatus::ALGORITHMIC_ERROR) {
          return "Algorithmic error";
       }
+      else if (status == OptimizationStatus::USER_TERMINATION) {
+         return "User termination";
+      }
+      else if (status == OptimizationStatus::OBJECTIVE_CUTOFF) {
+         return "Objective cutoff";
+      }
       return "Unknown";
    }
 } // namespace
\ No newline at end of file
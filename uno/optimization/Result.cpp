@@ -39,7 +39,16 @@ namespace uno {
          DISCRETE << "Objective multiplier:\t\t\t" << this->solution.objective_multiplier << '\n';
       }
 
-      DISCRETE << "CPU time:\t\t\t\t" << this->cpu_time << "s\n";
+      if (this->certificate.type == CertificateType::INFEASIBILITY) {
+         DISCRETE << "Infeasibility certificate:\t\t" << this->certificate.test << " (residual " << this->certificate.residual << ")\n";
+      }
+      else if (this->certificate.type == CertificateType::UNBOUNDEDNESS) {
+         DISCRETE << "Unboundedness certificate:\t\t" << this->certificate.test << '\n';
+      }
+      if (!this->preset.empty()) {
+         DISCRETE << "Preset:\t\t\t\t\t" << this->preset << '\n';
+      }
+      DISCRETE << "Solve time:\t\t\t\t" << this->solve_time << "s\n";
       DISCRETE << "Iterations:\t\t\t\t" << this->iteration << '\n';
       DISCRETE << "Objective evaluations:\t\t\t" << this->objective_evaluations << '\n';
       DISCRETE << "Constraints evaluations:\t\t" << this->constraint_evaluations << '\n';
@@ -47,5 +56,42 @@ namespace uno {
       DISCRETE << "Jacobian evaluations:\t\t\t" << this->jacobian_evaluations << '\n';
       DISCRETE << "Hessian evaluations:\t\t\t" << this->hessian_evaluations << '\n';
       DISCRETE << "Number of subproblems solved:\t\t" << this->number_subproblems_solved << '\n';
+      if (0 < this->number_factorizations) {
+         DISCRETE << "Number of factorizations:\t\t" << this->number_factorizations << '\n';
+      }
+      if (0 < this->factorization_statistics.number_factorizations) {
+         DISCRETE << "Nonzeros of the factors:\t\t" << this->factorization_statistics.factor_nonzeros << " (fill " <<
+            this->factorization_statistics.fill() << ")\n";
+         DISCRETE << "Factorization flops:\t\t\t" << this->factorization_statistics.flops << '\n';
+         DISCRETE << "Delayed pivots:\t\t\t\t" << this->factorization_statistics.delayed_pivots << '\n';
+      }
+      if (0 < this->peak_subproblem_workspace_size) {
+         DISCRETE << "Peak subproblem workspace:\t\t" << this->peak_subproblem_workspace_size << " bytes\n";
+      }
+      if (0 < this->evaluation_cache_hits + this->evaluation_cache_misses) {
+         DISCRETE << "Evaluation cache hits:\t\t\t" << this->evaluation_cache_hits << '\n';
+         DISCRETE << "Evaluation cache misses:\t\t" << this->evaluation_cache_misses << '\n';
+      }
+      if (AllocationTracker::is_enabled) {
+         DISCRETE << "Heap allocations (setup):\t\t" << this->setup_allocations.allocations << " (" << this->setup_allocations.bytes <<
+            " bytes)\n";
+         DISCRETE << "Heap allocations (iterations):\t\t" << this->loop_allocations.allocations << " (" << this->loop_allocations.bytes <<
+            " bytes), at most " << this->peak_iteration_allocations << " per iteration\n";
+      }
+      if (!this->memory_usages.empty()) {
+         size_t total_size = 0;
+         DISCRETE << "Memory usage:\n";
+         for (const MemoryUsage& usage: this->memory_usages) {
+            DISCRETE << "  " << usage.component << ": " << usage.bytes << " bytes\n";
+            total_size += usage.bytes;
+         }
+         DISCRETE << "  total: " << total_size << " bytes\n";
+      }
+      if (!this->phase_timings.empty()) {
+         DISCRETE << "Phase timings:\n";
+         for (const PhaseTiming& phase_timing: this->phase_timings) {
+            DISCRETE << "  " << phase_timing.path << ": " << phase_timing.time << "s (" << phase_timing.calls << " calls)\n";
+         }
+      }
    }
 } // namespace
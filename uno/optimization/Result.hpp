@@ -4,8 +4,15 @@
 #ifndef UNO_RESULT_H
 #define UNO_RESULT_H
 
+#include <string>
+#include <vector>
+#include "Certificate.hpp"
 #include "Iterate.hpp"
 #include "OptimizationStatus.hpp"
+#include "ingredients/subproblem_solvers/FactorizationStatistics.hpp"
+#include "tools/AllocationTracker.hpp"
+#include "tools/MemoryReport.hpp"
+#include "tools/Profiler.hpp"
 
 namespace uno {
    struct Result {
@@ -16,13 +23,26 @@ namespace uno {
       size_t number_variables;
       size_t number_constraints;
       size_t iteration;
-      double cpu_time;
+      double solve_time; // wall clock, in seconds
       size_t objective_evaluations;
       size_t constraint_evaluations;
       size_t objective_gradient_evaluations;
       size_t jacobian_evaluations;
       size_t hessian_evaluations;
       size_t number_subproblems_solved;
+      size_t number_factorizations;
+      size_t peak_subproblem_workspace_size; // in bytes
+      size_t evaluation_cache_hits;
+      size_t evaluation_cache_misses;
+      std::vector<PhaseTiming> phase_timings; // empty if the profiler is disabled
+      std::string preset{}; // winning preset of a portfolio (empty otherwise)
+      // heap allocations (zero if Uno was built without WITH_ALLOCATION_TRACKING), see AllocationTracker
+      AllocationCounters setup_allocations{};
+      AllocationCounters loop_allocations{};
+      size_t peak_iteration_allocations{0};
+      std::vector<MemoryUsage> memory_usages{}; // empty if the option memory_report is disabled
+      FactorizationStatistics factorization_statistics{}; // of the direct linear solvers
+      Certificate certificate{}; // of an infeasible or unbounded termination
 
       void print(bool print_primal_dual_solution) const;
    };
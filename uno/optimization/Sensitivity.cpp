@@ -0,0 +1,46 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include <string>
+#include "Sensitivity.hpp"
+#include "Iterate.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   Sensitivity::Sensitivity(size_t number_variables, size_t number_constraints, size_t number_parameters):
+         number_variables(number_variables),
+         number_constraints(number_constraints),
+         number_parameters(number_parameters),
+         primal_derivatives(number_variables * number_parameters),
+         constraint_multiplier_derivatives(number_constraints * number_parameters) {
+   }
+
+   void Sensitivity::approximate_solution(const Iterate& solution, const Vector<double>& parameter_change, Vector<double>& primals,
+         Vector<double>& constraint_multipliers) const {
+      if (parameter_change.size() != this->number_parameters) {
+         throw std::invalid_argument("Sensitivity::approximate_solution: the parameter change has " + std::to_string(parameter_change.size()) +
+            " components instead of " + std::to_string(this->number_parameters));
+      }
+      primals.resize(this->number_variables);
+      constraint_multipliers.resize(this->number_constraints);
+      for (size_t variable_index: Range(this->number_variables)) {
+         primals[variable_index] = solution.primals[variable_index];
+      }
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraint_multipliers[constraint_index] = solution.multipliers.constraints[constraint_index];
+      }
+      for (size_t parameter_index: Range(this->number_parameters)) {
+         const double change = parameter_change[parameter_index];
+         if (change != 0.) {
+            for (size_t variable_index: Range(this->number_variables)) {
+               primals[variable_index] += this->primal_derivatives[parameter_index * this->number_variables + variable_index] * change;
+            }
+            for (size_t constraint_index: Range(this->number_constraints)) {
+               constraint_multipliers[constraint_index] +=
+                  this->constraint_multiplier_derivatives[parameter_index * this->number_constraints + constraint_index] * change;
+            }
+         }
+      }
+   }
+} // namespace
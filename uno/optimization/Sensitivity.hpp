@@ -0,0 +1,36 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SENSITIVITY_H
+#define UNO_SENSITIVITY_H
+
+#include <cstddef>
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declaration
+   class Iterate;
+
+   /*! \struct Sensitivity
+    * \brief First-order sensitivities of a primal-dual solution with respect to parameters p (sIPOPT-style)
+    *
+    *  The derivatives are stored column-major: column k is the derivative with respect to p_k. They are computed with the factors
+    *  of the last primal-dual system of the solve (see Uno::compute_sensitivity)
+    */
+   struct Sensitivity {
+      const size_t number_variables;
+      const size_t number_constraints;
+      const size_t number_parameters;
+      Vector<double> primal_derivatives; /*!< dx*\/dp (number_variables x number_parameters) */
+      Vector<double> constraint_multiplier_derivatives; /*!< dλ*\/dp (number_constraints x number_parameters) */
+
+      Sensitivity(size_t number_variables, size_t number_constraints, size_t number_parameters);
+
+      // first-order approximation of the solution for the parameter change Δp: x*(p + Δp) ≈ x*(p) + dx*/dp Δp (idem for the
+      // constraint multipliers). The bounds are not enforced
+      void approximate_solution(const Iterate& solution, const Vector<double>& parameter_change, Vector<double>& primals,
+            Vector<double>& constraint_multipliers) const;
+   };
+} // namespace
+
+#endif // UNO_SENSITIVITY_H
@@ -23,11 +23,14 @@ namespace uno {
       this->jacobian_sparsity_changed = false;
    }
 
+   // new iterate, same problem structure
    void WarmstartInformation::iterate_changed() {
       this->objective_changed = true;
       this->constraints_changed = true;
       this->constraint_bounds_changed = true;
       this->variable_bounds_changed = true;
+      this->hessian_sparsity_changed = false;
+      this->jacobian_sparsity_changed = false;
    }
 
    void WarmstartInformation::whole_problem_changed() {
@@ -39,6 +42,15 @@ namespace uno {
       this->jacobian_sparsity_changed = true;
    }
 
+   void WarmstartInformation::only_variable_bounds_changed() {
+      this->objective_changed = false;
+      this->constraints_changed = false;
+      this->constraint_bounds_changed = false;
+      this->variable_bounds_changed = true;
+      this->hessian_sparsity_changed = false;
+      this->jacobian_sparsity_changed = false;
+   }
+
    void WarmstartInformation::only_objective_changed() {
       this->objective_changed = true;
       this->constraints_changed = false;
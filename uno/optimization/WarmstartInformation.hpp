@@ -19,6 +19,7 @@ namespace uno {
       void iterate_changed();
       void whole_problem_changed();
       void only_objective_changed();
+      void only_variable_bounds_changed();
    };
 } // namespace
 
@@ -19,16 +19,37 @@ namespace uno {
       options["loose_tolerance_consecutive_iteration_threshold"] = "15";
       // maximum outer iterations
       options["max_iterations"] = "2000";
-      // CPU time limit (in seconds)
+      // wall-clock time limit (in seconds)
       options["time_limit"] = "inf";
       // print optimal solution (yes|no)
       options["print_solution"] = "no";
+      // file in which the primal-dual solution and the status are written in binary ("" for no file). See SolutionFile
+      options["solution_file"] = "";
       // threshold on objective to declare unbounded NLP
       options["unbounded_objective_threshold"] = "-1e20";
+      // early detection of infeasibility and unboundedness before the regular tests, with a certificate in the result (yes|no):
+      // - stalled restoration: the infeasibility decreased by less than early_infeasibility_stall_reduction (relative) over the
+      //   window and the feasibility problem is stationary to within early_infeasibility_tolerance
+      // - dual ray: the multipliers exceed dual_ray_threshold and, normalized, are stationary to within early_infeasibility_tolerance
+      // - objective divergence: at a feasible point, the objective decreased monotonically and doubled in magnitude over the
+      //   window, below -unbounded_divergence_threshold
+      options["early_termination"] = "yes";
+      // number of accepted iterates over which the early termination tests measure the progress
+      options["early_termination_window"] = "10";
+      options["early_infeasibility_stall_reduction"] = "0.01";
+      options["early_infeasibility_tolerance"] = "1e-6";
+      options["dual_ray_threshold"] = "1e10";
+      options["unbounded_divergence_threshold"] = "1e10";
+      // upon a non-optimal termination (time or iteration limit, failure), return the best accepted iterate (smallest constraint
+      // violation, then smallest objective) instead of the last one (yes|no)
+      options["return_best_iterate"] = "no";
+      // use the compile-time pipelines of the ipopt and filtersqp ingredients (yes|no)
+      options["specialized_pipelines"] = "yes";
       // enforce linear constraints at the initial point (yes|no)
       options["enforce_linear_constraints"] = "no";
 
       /** statistics table **/
+      // the columns are sorted by order. A negative order hides the column
       options["statistics_print_header_frequency"] = "15";
       options["statistics_major_column_order"] = "1";
       options["statistics_minor_column_order"] = "2";
@@ -39,7 +60,17 @@ namespace uno {
       options["statistics_LS_step_length_column_order"] = "10";
       options["statistics_restoration_phase_column_order"] = "20";
       options["statistics_regularization_column_order"] = "21";
+      options["statistics_factorizations_column_order"] = "22";
+      options["statistics_factorization_time_column_order"] = "23";
+      options["statistics_QP_starts_column_order"] = "24";
       options["statistics_funnel_width_column_order"] = "25";
+      options["statistics_subproblem_iterations_column_order"] = "26";
+      // wall time and evaluation time of each line (hidden by default)
+      options["statistics_iteration_time_column_order"] = "-1";
+      options["statistics_evaluation_time_column_order"] = "-1";
+      // fill of the factors and cumulated delayed pivots of the direct linear solver (hidden by default)
+      options["statistics_fill_column_order"] = "-1";
+      options["statistics_delayed_pivots_column_order"] = "-1";
       options["statistics_step_norm_column_order"] = "31";
       options["statistics_objective_column_order"] = "100";
       options["statistics_primal_feasibility_column_order"] = "101";
@@ -47,19 +78,68 @@ namespace uno {
       options["statistics_stationarity_column_order"] = "104";
       options["statistics_complementarity_column_order"] = "105";
       options["statistics_status_column_order"] = "200";
+      // file in which the numerical statistics of each iteration are written ("" for no trace)
+      options["statistics_trace_file"] = "";
+      // format of the iteration trace: csv or binary
+      options["statistics_trace_format"] = "csv";
+
+      /** checkpoint options **/
+      // file in which the state of the solve is written ("" for no checkpoint). See Uno::resume
+      options["checkpoint_file"] = "";
+      // number of iterations between two checkpoints (0: only upon request, e.g. SIGUSR1 in the AMPL driver)
+      options["checkpoint_frequency"] = "0";
+      // checkpoint from which the AMPL driver resumes the solve ("" for a new solve)
+      options["checkpoint_resume_file"] = "";
 
       /** main options **/
       // logging level (SILENT|DISCRETE|WARNING|INFO|DEBUG|DEBUG2|DEBUG3)
       options["logger"] = "INFO";
-      // Hessian model (exact|zero)
+      // measure the wall-clock time of the phases of the solve (evaluations, linear algebra, subproblems, globalization) (yes|no)
+      options["profiler"] = "no";
+      // file in which the timeline of the solve (evaluations, assembly, factorizations, inertia corrections, subproblems, trials) is
+      // written in the Chrome trace event format, read by chrome://tracing and Perfetto ("" for no timeline)
+      options["timeline_file"] = "";
+      // abort the program upon a heap allocation in the main loop after the first iteration (yes|no). Only available in a build with
+      // WITH_ALLOCATION_TRACKING, which also reports the allocations of the setup and of the iterations
+      options["forbid_loop_allocations"] = "no";
+      // report the memory held by each component (iterates, subproblem, subproblem solvers, linear solvers) at the end of the solve (yes|no)
+      options["memory_report"] = "no";
+      // Hessian model (exact|zero|LBFGS|BFGS|SR1|finite_differences). BFGS and SR1 store a dense matrix and are meant for small problems
       options["hessian_model"] = "exact";
+      // number of pairs (s, y) stored by the L-BFGS Hessian model. The primal-dual interior-point method keeps the compact form in its
+      // augmented system (bordered by 2 x LBFGS_memory_size rows); the other subproblems use the materialized dense Hessian
+      options["LBFGS_memory_size"] = "6";
+      // relative step of the finite differences of the Lagrangian gradients
+      options["finite_difference_relative_step"] = "1.5e-8";
       // sparse matrix format (COO|CSC)
       options["sparse_format"] = "COO";
+      // when the sparsity pattern of the augmented matrix is unchanged, only overwrite its values (yes|no)
+      options["values_only_reassembly"] = "yes";
       // scale the functions (yes|no)
       options["scale_functions"] = "no";
       options["function_scaling_threshold"] = "100";
       // factor scaling
       options["function_scaling_factor"] = "100";
+      // presolve the linear constraints: singleton rows become bounds, empty, duplicate and dominated rows are removed (yes|no)
+      options["presolve_linear_constraints"] = "no";
+      // relative tolerance of the comparisons in the presolve
+      options["presolve_tolerance"] = "1e-12";
+      // tighten the variable bounds by propagating the activity ranges of the linear constraints (yes|no)
+      options["presolve_bound_tightening"] = "no";
+      // maximum number of Jacobian nonzeros visited by the bound tightening
+      options["bound_tightening_work_limit"] = "1000000";
+      // substitute the fixed variables and remove them from the variable space, instead of moving them to the general constraints (yes|no)
+      options["eliminate_fixed_variables"] = "no";
+      // renumber the variables and the constraints to cluster the nonzeros of the Jacobian and the Hessian around the diagonal
+      // (none|RCM: reverse Cuthill-McKee)
+      options["reorder_model"] = "none";
+      // the Jacobian rows with more nonzeros are ignored by the reordering (they would connect all their variables)
+      options["reordering_dense_row_size"] = "100";
+      // scale the variables with factors provided by the model (e.g. AMPL suffix scaling_factor) or with powers of 2 of the magnitudes
+      // of the initial point and bounds (none|user|automatic)
+      options["scale_variables"] = "none";
+      // largest automatic variable scaling factor (its inverse is the smallest)
+      options["variable_scaling_maximum_factor"] = "1e6";
       // scale the errors with respect to the current point (yes|no)
       options["scale_residuals"] = "yes";
       // norm of the progress measures (L1|L2|INF)
@@ -69,11 +149,63 @@ namespace uno {
       options["residual_scaling_threshold"] = "100.";
       options["protect_actual_reduction_against_roundoff"] = "no";
       options["print_subproblem"] = "no";
+      // placement of the large buffers: first touch of their pages by the calling thread or by the OpenMP threads, i.e. on their
+      // NUMA nodes (serial|parallel)
+      options["memory_first_touch"] = "serial";
+      // huge pages backing the large buffers (none|transparent|explicit)
+      options["huge_pages"] = "none";
+      // bit-identical results across runs with the same number of threads (yes|no): the parallel runs (multistart, portfolio) do
+      // not depend on the thread timings, linear_solver=auto does not time its candidates and the subproblem solvers use their
+      // reproducible settings (MUMPS without tree parallelism, HiGHS without parallel simplex, CNR mode of MKL PARDISO, SSIDS on
+      // CPU). The parallel kernels of Uno have a fixed partitioning and ordered reductions in both modes
+      options["deterministic"] = "no";
+      // number of points whose objective, constraints and objective gradient are cached (0: no cache). The cached model does not
+      // support concurrent evaluations (speculative line-search trials, concurrent interior-point evaluations)
+      options["evaluation_cache_size"] = "0";
+      // number of threads of the pool shared by the parallel components of a solve, the calling thread included (0: no pool, each
+      // component uses its own threads). The linear solvers whose number of threads is 0 also use this number of threads
+      options["threads"] = "0";
+      // placement of the threads of the pool (none|compact: the worker i is pinned to the core i, Linux only)
+      options["thread_affinity"] = "none";
+
+      /** multistart options **/
+      // number of starting points (1: no multistart)
+      options["multistart_starts"] = "1";
+      // number of threads on which the starts are solved (0: number of hardware threads)
+      options["multistart_threads"] = "0";
+      // generation of the starting points (perturbation|latin_hypercube)
+      options["multistart_method"] = "perturbation";
+      // relative radius of the perturbations, also used along the infinite bounds by the Latin hypercube sampling
+      options["multistart_radius"] = "1";
+      // seed of the random generator of the starting points
+      options["multistart_seed"] = "0";
+      // a KKT point whose objective is below this target terminates the multistart
+      options["multistart_target_objective"] = "-inf";
+
+      /** portfolio options **/
+      // comma-separated presets raced on the model, e.g. filtersqp,ipopt,byrd ("": no portfolio)
+      options["portfolio_presets"] = "";
+      // number of threads on which the presets are solved (0: number of hardware threads)
+      options["portfolio_threads"] = "0";
+
+      /** decomposition options **/
+      // solve the independent components of the model (no shared constraint or Hessian entry) concurrently (yes|no)
+      options["decompose_model"] = "no";
+      // number of threads on which the components are solved (0: number of hardware threads)
+      options["decomposition_threads"] = "0";
+      // the consecutive components are grouped until they have this number of variables (1: no grouping)
+      options["decomposition_min_component_size"] = "100";
 
       /** globalization strategy options **/
       options["armijo_decrease_fraction"] = "1e-4";
       options["armijo_tolerance"] = "1e-9";
 
+      /** nonmonotone merit function options **/
+      // number of merit values of the last accepted iterates in the reference value
+      options["nonmonotone_merit_memory"] = "5";
+      // maximum number of consecutive iterations in which the full step is tentatively accepted (0: no watchdog)
+      options["nonmonotone_merit_watchdog_iterations"] = "3";
+
       /** switching method options **/
       options["switching_delta"] = "0.999";
       options["switching_infeasibility_exponent"] = "2";
@@ -105,12 +237,26 @@ namespace uno {
       options["LS_backtracking_ratio"] = "0.5";
       // minimum step length
       options["LS_min_step_length"] = "1e-12";
+      // maximum number of trial step lengths per direction (0: no limit). Reaching it has the same effect as the minimum step length
+      options["LS_max_backtracks"] = "0";
       // use the primal-dual and dual step lengths to scale the dual directions when assembling the trial iterate
       options["LS_scale_duals_with_step_length"] = "yes";
+      // maximum number of second-order corrections when the full step is rejected (only the interior-point method computes them)
+      options["LS_max_second_order_corrections"] = "4";
+      // required decrease of the infeasibility between two second-order corrections
+      options["LS_second_order_correction_decrease"] = "0.99";
+      // number of step lengths 1, ratio, ratio^2, ... whose trial iterates are evaluated concurrently (1: no speculative evaluations).
+      // Only used if the model supports concurrent evaluations
+      options["LS_speculative_trials"] = "1";
+      // after a rejected trial, interpolate the next step length (quadratic, then cubic) from the measures of the trial iterates and
+      // their first-order slopes, within [0.1, 0.5] times the step length. Not combined with speculative trials (yes|no)
+      options["LS_interpolate_step_length"] = "no";
 
       /** regularization options **/
       // regularization failure threshold
       options["regularization_failure_threshold"] = "1e40";
+      // maximum number of factorizations of the inertia correction per matrix (0: no limit)
+      options["regularization_max_factorizations"] = "0";
       // Hessian regularization: initial value
       options["regularization_initial_value"] = "1e-4";
       options["regularization_increase_factor"] = "2";
@@ -122,6 +268,49 @@ namespace uno {
       options["primal_regularization_fast_increase_factor"] = "100.";
       options["primal_regularization_slow_increase_factor"] = "8.";
       options["threshold_unsuccessful_attempts"] = "8";
+      // skip the factorization of the unregularized augmented matrix when the previous iterations needed a regularization
+      options["predictive_regularization"] = "no";
+      // number of consecutive regularized iterations that trigger the prediction
+      options["predictive_regularization_history"] = "2";
+      // regularize the constraints from the first factorization (similar to IPOPT's perturb_always_cd)
+      options["dual_regularization_always"] = "no";
+      // quasi-definite mode: the primal and dual regularizations below are always added to the augmented matrix (primal block + delta I,
+      // dual block - gamma I), which is factorized with static pivoting if the linear solver supports it (MA27, MA57, MUMPS). The
+      // iterative refinement removes the effect of the layer on the solution (yes|no)
+      options["quasi_definite_regularization"] = "no";
+      options["quasi_definite_primal_regularization"] = "1e-8";
+      options["quasi_definite_dual_regularization"] = "1e-8";
+      // maximum number of iterative refinement steps of the augmented system solves (0: no refinement)
+      options["iterative_refinement_max_steps"] = "2";
+      // the refinement stops when the residual is below the tolerance (relative to the rhs)
+      options["iterative_refinement_tolerance"] = "1e-10";
+      // refinement method: classic (x += A^-1 r at each step) or FGMRES preconditioned by the factorization (classic|FGMRES)
+      options["iterative_refinement_method"] = "classic";
+      // the pivot tolerance of the linear solver (MA27 and MA57) is increased while the residual ratio of the refined solution
+      // exceeds this threshold (0: never)
+      options["pivot_tolerance_residual_ratio"] = "1e-10";
+      // precision of the factorizations: double, or mixed (single-precision factorization recovered by the iterative refinement) (double|mixed)
+      options["linear_solver_precision"] = "double";
+      // linear_solver = auto: the dense solver (linear_solver = dense) factorizes the matrices up to this dimension. Above, the solver is
+      // chosen among the available ones from the size of the matrix (dimension + number of nonzeros): MA27 first below the medium
+      // size, MA57 first below the large size, then PARDISO, MA97 or MUMPS
+      options["linear_solver_auto_dense_dimension"] = "200";
+      options["linear_solver_auto_medium_size"] = "10000";
+      options["linear_solver_auto_large_size"] = "1000000";
+      // linear_solver = auto: time the first analysis and factorization with the two preferred solvers and keep the faster one (yes|no)
+      options["linear_solver_auto_benchmark"] = "no";
+      // test that triggers the regularization of the interior-point augmented matrix with a direct solver: inertia of the factorization,
+      // or inertia-free curvature test of the direction (Chiang and Zavala, 2016). Solvers without inertia use the curvature test (inertia|curvature)
+      options["regularization_test"] = "inertia";
+      // inertia-free regularization: curvature threshold kappa in d^T (W + Sigma + delta_w I) d >= kappa d^T d
+      options["curvature_test_threshold"] = "1e-8";
+      // symmetric equilibration of the augmented matrix before its factorization (none|ruiz)
+      options["linear_system_scaling"] = "none";
+      // the Ruiz iterations stop when the infinity norms of the rows of the scaled matrix are within the tolerance of 1
+      options["linear_system_scaling_max_iterations"] = "10";
+      options["linear_system_scaling_tolerance"] = "1e-2";
+      // factorize the independent diagonal blocks of the augmented matrix concurrently, each with its own instance of the linear solver (yes|no)
+      options["independent_blocks_factorization"] = "no";
 
       /** trust region options **/
       // initial trust region radius
@@ -138,7 +327,12 @@ namespace uno {
       options["TR_min_radius"] = "1e-7";
       // threshold below which the TR radius is reset
       options["TR_radius_reset_threshold"] = "1e-4";
-      // force QP convexification when in a trust-region setting
+      // maximum number of iterations of the truncated CG subproblem (problems without general constraints)
+      options["truncated_CG_max_iterations"] = "1000";
+      // subproblem of the line-search methods on problems without general constraints (LBFGSB|default). LBFGSB replaces the
+      // subproblem and the Hessian model with a projected L-BFGS step (LBFGS_memory_size pairs); default keeps the "subproblem" option
+      options["bound_constrained_subproblem"] = "LBFGSB";
+      // force QP convexification when in a trust-region setting or with full steps (globalization mechanism "none")
       options["convexify_QP"] = "false";
 
       /** constraint relaxation options **/
@@ -158,9 +352,19 @@ namespace uno {
       // threshold for determining if duals have a zero norm
       options["l1_small_duals_threshold"] = "1e-10";
 
+      // augmented Lagrangian options //
+      // initial value of the penalty parameter
+      options["AL_initial_penalty_parameter"] = "10.";
+      // increase (multiplicative) factor of the penalty parameter when the constraint residual does not decrease enough
+      options["AL_penalty_increase_factor"] = "10.";
+      // largest value of the penalty parameter before the problem is deemed infeasible
+      options["AL_max_penalty_parameter"] = "1e12";
+
       /** feasibility restoration options **/
       // test linearized feasibility when switching back to the optimality phase
       options["switch_to_optimality_requires_linearized_feasibility"] = "yes";
+      // Hessian of the restoration problem: exact (weighted constraint Hessians) or gauss_newton (J^T J, no second derivatives)
+      options["restoration_hessian_model"] = "exact";
 
       /** barrier subproblem options **/
       options["barrier_initial_parameter"] = "0.1";
@@ -178,13 +382,202 @@ namespace uno {
       options["barrier_push_variable_to_interior_k1"] = "1e-2";
       options["barrier_push_variable_to_interior_k2"] = "1e-2";
       options["barrier_damping_factor"] = "1e-5";
+      // solver of the augmented system: factorization with the linear_solver or inexact (iterative) solves (direct|MINRES)
+      options["barrier_kkt_solver"] = "direct";
+      // factorize the normal equations J D^-1 J^T (dense Cholesky) instead of the augmented system when the Hessian is diagonal.
+      // auto: if the number of constraints is at most half the number of variables (auto|yes|no)
+      options["barrier_normal_equations"] = "auto";
+      // inexact solves: relative tolerance min(max_tolerance, factor * barrier parameter)
+      options["barrier_inexact_newton_factor"] = "0.1";
+      options["barrier_inexact_newton_max_tolerance"] = "1e-4";
+      // eliminate the slacks of the inequality constraints from the augmented system before factorization (yes|no)
+      options["barrier_condense_slacks"] = "no";
+      // evaluate the functions and derivatives of an iteration concurrently, if the model supports concurrent evaluations (yes|no)
+      options["barrier_concurrent_evaluations"] = "no";
+      // Mehrotra predictor-corrector: the barrier parameter is set by an affine-scaling predictor step (yes|no)
+      options["barrier_predictor_corrector"] = "no";
+      // lower bound on the barrier parameter of the predictor-corrector and of the adaptive rules
+      options["barrier_min_parameter"] = "1e-11";
+      // maximum number of Gondzio's multiple centrality correctors per iteration (additional solves with the factorization of the
+      // iteration, accepted if they increase the step length). 0 disables them
+      options["barrier_centrality_correctors"] = "0";
+      // the number of correctors follows the ratio of the factorization cost to the solve cost, up to the maximum (yes|no)
+      options["barrier_adaptive_centrality_correctors"] = "yes";
+      // increase delta of the step length targeted by a corrector
+      options["barrier_centrality_step_increase"] = "0.1";
+      // a corrector is accepted if the step length increases by at least this fraction of delta
+      options["barrier_centrality_min_improvement"] = "0.1";
+      // the complementarity products are projected onto [mu / beta, beta mu] (beta >= 1)
+      options["barrier_centrality_neighborhood"] = "10";
+      // barrier parameter update rule: monotone|loqo|quality_function
+      options["barrier_update_rule"] = "monotone";
+      // safeguard of the adaptive rules: relative decrease of the KKT error and number of iterations without decrease
+      options["barrier_adaptive_sufficient_decrease"] = "1e-4";
+      options["barrier_adaptive_max_stalls"] = "4";
+      // mu = fraction * average complementarity when switching to monotone mode
+      options["barrier_adaptive_monotone_fraction"] = "0.8";
+      // quality-function rule: upper bound of the centering parameter and number of golden-section iterations
+      options["barrier_quality_function_sigma_max"] = "100";
+      options["barrier_quality_function_golden_section_iterations"] = "12";
+      // warm start from the primal-dual point of the initial iterate (yes|no). Uno::solve has no separate input for the bound duals: they
+      // are the bound multipliers of the initial iterate, set by the caller (e.g. from Model::get_initial_bound_duals or from a previous
+      // solution). The zero or wrongly signed ones are computed from the initial barrier parameter
+      options["barrier_warm_start"] = "no";
+      // perturbations of the primal variables away from their bounds (warm start)
+      options["barrier_warm_start_bound_push"] = "1e-3";
+      options["barrier_warm_start_bound_fraction"] = "1e-3";
+      // minimum magnitude of the bound multipliers (warm start)
+      options["barrier_warm_start_multiplier_bound_push"] = "1e-3";
+      // initial barrier parameter (warm start)
+      options["barrier_warm_start_initial_parameter"] = "1e-4";
+      // recompute the constraint multipliers with the least-square system instead of keeping those of the initial iterate (yes|no)
+      options["barrier_warm_start_least_square_multipliers"] = "no";
       options["least_square_multiplier_max_norm"] = "1e3";
+      // linear system of the least-square multipliers: augmented system [I J^T; J 0], normal equations J J^T or
+      // automatic (normal equations when there are at least 10 times fewer constraints than variables) (augmented_system|normal_equations|automatic)
+      options["least_square_multiplier_method"] = "augmented_system";
+
+      /** interior-point crossover options **/
+      // number of consecutive iterations during which the estimated active set is unchanged before switching to the QP subproblem
+      options["crossover_stable_active_set_iterations"] = "5";
+
+      /** SLQP subproblem options **/
+      // radius of the infinity-norm trust region of the active-set estimation LP (intersected with the trust region of the method)
+      options["SLQP_LP_trust_region_radius"] = "10.";
+      // relative tolerance below which a linearized constraint or a bound is active at the LP solution
+      options["SLQP_active_set_tolerance"] = "1e-8";
+      // dual regularization of the EQP augmented matrix when the working set is rank deficient
+      options["SLQP_dual_regularization"] = "1e-8";
+
+      /** reduced-space subproblem options **/
+      // relative tolerance below which a column of the equality Jacobian is linearly dependent on the basis under construction
+      options["reduced_space_pivot_tolerance"] = "1e-10";
+
+      /** LP/QP accuracy options **/
+      // accuracy of the LP/QP solves (exact|adaptive). adaptive: the tolerance is subproblem_accuracy_factor * KKT error of the current
+      // iterate, clamped between the tolerance of the solver and subproblem_loosest_tolerance. The iteration limit goes from
+      // subproblem_loosest_iteration_fraction * maximum number of iterations (loosest tolerance) to the maximum (tight tolerance).
+      // Used by the interior-point QP solver and HiGHS (BQPD has fixed internal tolerances)
+      options["subproblem_accuracy"] = "exact";
+      options["subproblem_accuracy_factor"] = "0.1";
+      options["subproblem_loosest_tolerance"] = "1e-3";
+      options["subproblem_loosest_iteration_fraction"] = "0.25";
+
+      /** Schur complement solver options (linear_solver = Schur) **/
+      // the indices whose degree in the graph of the augmented matrix exceeds this multiple of the average degree link the blocks
+      // (0: no linking index is detected, the blocks are the connected components)
+      options["Schur_linking_degree_factor"] = "10";
+
+      /** MA57 and MA27 options **/
+      // fill-reducing ordering of MA57 (automatic|AMD|minimum_degree|METIS|user)
+      options["MA57_ordering"] = "automatic";
+      // fill-reducing ordering of MA27 (automatic|minimum_degree|user)
+      options["MA27_ordering"] = "automatic";
+      // threshold of the numerical pivoting of MA57 (CNTL(1)), and upper bound of its increases when the solutions are inaccurate
+      options["MA57_pivot_tolerance"] = "0.01";
+      options["MA57_pivot_tolerance_max"] = "0.5";
+      // threshold of the numerical pivoting of MA27 (CNTL(1)), and upper bound of its increases when the solutions are inaccurate
+      options["MA27_pivot_tolerance"] = "0.1";
+      options["MA27_pivot_tolerance_max"] = "0.5";
+      // number of pivot orders (one per sparsity pattern) kept by the linear solver (0: no cache)
+      options["ordering_cache_size"] = "4";
+      // persistence of the symbolic analyses across solves of the same structure (none|memory|file)
+      options["symbolic_analysis_persistence"] = "none";
+      // directory of the persisted symbolic analyses (file persistence)
+      options["symbolic_analysis_directory"] = ".";
+      // number of recent symbolic analyses (one per sparsity pattern) kept by each linear solver, e.g. one per restoration phase (0: none)
+      options["symbolic_analysis_cache_size"] = "2";
+
+      /** dense solver options (linear_solver = dense, and the stages of linear_solver = block_tridiagonal) **/
+      // a pivot below this tolerance times the largest entry of the matrix counts as a zero eigenvalue
+      options["dense_relative_pivot_tolerance"] = "1e-14";
+
+      /** MINRES options **/
+      // maximum number of iterations
+      options["MINRES_max_iterations"] = "1000";
+      // tolerance on the preconditioned residual, relative to the rhs (lower bound of the inexact-Newton tolerance)
+      options["MINRES_relative_tolerance"] = "1e-10";
+      // the entries of the diagonal preconditioner below this threshold are replaced with 1
+      options["MINRES_preconditioner_floor"] = "1e-8";
 
       /** BQPD options **/
       options["BQPD_kmax"] = "500";
+      // compute the Hessian-vector products of BQPD with the Hessian model instead of forming the Hessian matrix (yes|no).
+      // Only used if the Hessian model supports matrix-free products (e.g. not convexified)
+      options["BQPD_matrix_free_hessian"] = "no";
+
+      /** Goldfarb-Idnani options **/
+      // tolerance on the violation of the constraints, relative to their bounds
+      options["GoldfarbIdnani_feasibility_tolerance"] = "1e-10";
+
+      /** HiGHS options **/
+      // number of threads of HiGHS (0: option threads if positive, HiGHS default otherwise)
+      options["HiGHS_threads"] = "0";
+      // LP algorithm (auto|simplex|ipm|pdlp). "auto" picks the simplex method (warm-started) for small problems, the interior-point
+      // method and PDLP above the size thresholds (number of variables + number of Jacobian nonzeros)
+      options["HiGHS_LP_algorithm"] = "auto";
+      options["HiGHS_ipm_size_threshold"] = "100000";
+      options["HiGHS_pdlp_size_threshold"] = "10000000";
+      // tolerance of the interior-point method and PDLP: factor * KKT error of the current iterate, clamped to [minimum, maximum]
+      options["HiGHS_adaptive_tolerance_factor"] = "0.1";
+      options["HiGHS_minimum_tolerance"] = "1e-8";
+      options["HiGHS_maximum_tolerance"] = "1e-3";
+
+      /** interior-point QP options **/
+      // tolerance on the primal and dual residuals (scaled) and on the average complementarity
+      options["InteriorPointQP_tolerance"] = "1e-9";
+      options["InteriorPointQP_max_iterations"] = "200";
+
+      /** MUMPS options **/
+      // MPI communicator (world|self)
+      options["MUMPS_communicator"] = "world";
+      // the host process takes part in the factorization (yes|no)
+      options["MUMPS_host_participates"] = "yes";
+      // number of OpenMP threads (0: option threads if positive, OMP_NUM_THREADS otherwise)
+      options["MUMPS_threads"] = "0";
+      // sequential ordering (automatic|AMD|AMF|SCOTCH|PORD|METIS|QAMD)
+      options["MUMPS_ordering"] = "automatic";
+      // distributed matrix entry: each MPI process provides a slice of the nonzeros (yes|no)
+      options["MUMPS_distributed_entry"] = "no";
+      // out-of-core factorization: the factors are written to disk (no|yes|automatic: when the in-core estimate of the analysis
+      // exceeds MUMPS_memory_budget)
+      options["MUMPS_out_of_core"] = "no";
+      // scratch directory of the out-of-core files (empty: MUMPS default, MUMPS_OOC_TMPDIR or /tmp)
+      options["MUMPS_ooc_directory"] = "";
+      // working memory budget per process in MB (ICNTL(23), 0: no budget)
+      options["MUMPS_memory_budget"] = "0";
+
+      /** SSIDS options **/
+      // factorize on the GPU(s) when SPRAL was built with CUDA support (yes|no)
+      options["SSIDS_use_gpu"] = "yes";
+
+      /** PARDISO options **/
+      // number of threads (0: option threads if positive, MKL default or PARDISO default for Panua Pardiso otherwise)
+      options["PARDISO_threads"] = "0";
+      // fill-in reducing ordering (METIS|minimum_degree|parallel_METIS). parallel_METIS is only available in MKL PARDISO
+      options["PARDISO_ordering"] = "METIS";
 
       /** AMPL options **/
       options["AMPL_write_solution_to_file"] = "yes";
+      // store the structure of the model in <model>.nl.unocache and reuse it while the .nl file is unchanged
+      options["AMPL_model_cache"] = "no";
+      // number of threads (each with its own ASL instance) that evaluate the nonlinear constraints and their Jacobian
+      options["AMPL_evaluation_threads"] = "1";
+      // the evaluation threads also evaluate the Lagrangian Hessian, one block of nonlinear constraints each (yes|no)
+      options["AMPL_parallel_hessian"] = "yes";
+      // evaluate the functions and first derivatives with C++ code generated from the .nl file and compiled into a shared library,
+      // reused while the .nl file is unchanged (yes|no). The Lagrangian Hessian is evaluated by ASL
+      options["AMPL_compiled_backend"] = "no";
+      options["AMPL_compiler"] = "c++";
+      options["AMPL_compiler_flags"] = "-O2";
+      // directory of the compiled libraries ("": directory of the .nl file)
+      options["AMPL_compiled_cache_directory"] = "";
+
+      /** CUTEst options **/
+      // CSV benchmark report to which uno_cutest appends the outcome of the solve ("": no report)
+      options["CUTEst_benchmark_file"] = "";
+      // name of the configuration in the records of the benchmark report
+      options["CUTEst_configuration"] = "default";
 
       return options;
    }
@@ -207,6 +600,8 @@ namespace uno {
       const auto linear_solvers = SymmetricIndefiniteLinearSolverFactory::available_solvers();
       if (!linear_solvers.empty()) {
          options["linear_solver"] = linear_solvers[0];
+         // solver of the blocks of the Schur complement solver
+         options["Schur_block_linear_solver"] = linear_solvers[0];
       }
       return options;
    }
@@ -1,6 +1,7 @@
 // Copyright (c) 2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <stdexcept>
 #include "Presets.hpp"
 #include "Options.hpp"
@@ -22,7 +23,12 @@ namespace uno {
          const auto linear_solvers = SymmetricIndefiniteLinearSolverFactory::available_solvers();
          const auto LP_solvers = LPSolverFactory::available_solvers();
 
-         if (!QP_solvers.empty()) {
+         // the dense Goldfarb-Idnani solver (small problems) and the interior-point QP solver (available with any linear solver) do not
+         // determine the default preset
+         const bool has_sparse_QP_solver = std::any_of(QP_solvers.cbegin(), QP_solvers.cend(), [](const std::string& QP_solver) {
+            return QP_solver != "GoldfarbIdnani" && QP_solver != "InteriorPointQP";
+         });
+         if (has_sparse_QP_solver) {
             Presets::set(options, "filtersqp");
          }
          else if (!linear_solvers.empty()) {
@@ -148,6 +154,35 @@ namespace uno {
          options["switch_to_optimality_requires_linearized_feasibility"] = "yes";
          options["protect_actual_reduction_against_roundoff"] = "no";
       }
+      else if (preset_name == "mpc") {
+         // real-time execution (model-predictive control): line-search S l1 QP without restoration phase, with a bounded cost per
+         // iteration (capped backtracks and factorizations, no second-order corrections) and a wall-clock deadline. Upon
+         // termination at the deadline, the best accepted iterate is returned
+         options["constraint_relaxation_strategy"] = "l1_relaxation";
+         options["subproblem"] = "QP";
+         options["globalization_mechanism"] = "LS";
+         options["globalization_strategy"] = "l1_merit";
+         options["l1_relaxation_initial_parameter"] = "1";
+         options["LS_backtracking_ratio"] = "0.5";
+         options["LS_max_backtracks"] = "8";
+         options["LS_max_second_order_corrections"] = "0";
+         options["LS_speculative_trials"] = "1";
+         options["armijo_decrease_fraction"] = "1e-8";
+         options["l1_relaxation_epsilon1"] = "0.1";
+         options["l1_relaxation_epsilon2"] = "0.1";
+         options["l1_constraint_violation_coefficient"] = "1.";
+         options["regularization_max_factorizations"] = "4";
+         options["tolerance"] = "1e-6";
+         options["loose_tolerance"] = "1e-4";
+         options["progress_norm"] = "L1";
+         options["residual_norm"] = "L1";
+         options["sparse_format"] = "CSC";
+         options["LS_scale_duals_with_step_length"] = "no";
+         options["protect_actual_reduction_against_roundoff"] = "no";
+         options["max_iterations"] = "100";
+         options["time_limit"] = "5e-3";
+         options["return_best_iterate"] = "yes";
+      }
       else {
          throw std::runtime_error("The preset " + preset_name + " is not known");
       }
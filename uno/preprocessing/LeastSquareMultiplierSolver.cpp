@@ -0,0 +1,275 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <stdexcept>
+#include "LeastSquareMultiplierSolver.hpp"
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "linear_algebra/Norm.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "symbolic/VectorView.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   // the normal equations are solved automatically when there are at least this many times fewer constraints than variables
+   constexpr size_t NORMAL_EQUATIONS_RATIO = 10;
+
+   template <typename IndexType>
+   LeastSquareMultiplierSolver<IndexType>::LeastSquareMultiplierSolver(LeastSquareMultiplierMethod method, size_t number_variables,
+         size_t number_constraints, size_t number_jacobian_nonzeros, std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, double>> linear_solver,
+         const Options& options, size_t index_shift):
+         method(method),
+         multiplier_max_norm(options.get_double("least_square_multiplier_max_norm")),
+         // the arrays of the matrix grow if needed: the capacity is that of the sparsest matrices
+         matrix(LeastSquareMultiplierSolver::matrix_dimension(method, number_variables, number_constraints),
+               (method == LeastSquareMultiplierMethod::AUGMENTED_SYSTEM ? number_variables : number_constraints) + number_jacobian_nonzeros,
+               false, options.get_string("sparse_format"), index_shift),
+         rhs(LeastSquareMultiplierSolver::matrix_dimension(method, number_variables, number_constraints)),
+         solution(LeastSquareMultiplierSolver::matrix_dimension(method, number_variables, number_constraints)),
+         linear_solver(std::move(linear_solver)),
+         residual(number_variables),
+         accumulator(method == LeastSquareMultiplierMethod::NORMAL_EQUATIONS ? number_constraints : 0),
+         is_touched(method == LeastSquareMultiplierMethod::NORMAL_EQUATIONS ? number_constraints : 0, false) {
+      this->jacobian_pattern.reserve(2 + number_constraints + number_jacobian_nonzeros);
+      this->pattern_workspace.reserve(2 + number_constraints + number_jacobian_nonzeros);
+      if (method == LeastSquareMultiplierMethod::NORMAL_EQUATIONS) {
+         this->transposed_start.reserve(number_variables + 1);
+         this->transposed_rows.reserve(number_jacobian_nonzeros);
+         this->transposed_values.reserve(number_jacobian_nonzeros);
+         this->touched_rows.reserve(number_constraints);
+      }
+   }
+
+   template <typename IndexType>
+   LeastSquareMultiplierSolver<IndexType>::~LeastSquareMultiplierSolver() = default;
+
+   template <typename IndexType>
+   std::unique_ptr<LeastSquareMultiplierSolver<IndexType>> LeastSquareMultiplierSolver<IndexType>::create(size_t number_variables,
+         size_t number_constraints, size_t number_jacobian_nonzeros, const Options& options, size_t index_shift) {
+      const LeastSquareMultiplierMethod method = LeastSquareMultiplierSolver::determine_method(number_variables, number_constraints, options);
+      auto linear_solver = SymmetricIndefiniteLinearSolverFactory::create<IndexType>(
+            LeastSquareMultiplierSolver::matrix_dimension(method, number_variables, number_constraints),
+            LeastSquareMultiplierSolver::matrix_number_nonzeros(method, number_variables, number_constraints, number_jacobian_nonzeros), options);
+      return std::make_unique<LeastSquareMultiplierSolver<IndexType>>(method, number_variables, number_constraints, number_jacobian_nonzeros,
+            std::move(linear_solver), options, index_shift);
+   }
+
+   template <typename IndexType>
+   LeastSquareMultiplierMethod LeastSquareMultiplierSolver<IndexType>::determine_method(size_t number_variables, size_t number_constraints,
+         const Options& options) {
+      const std::string method = options.get_string("least_square_multiplier_method");
+      if (method == "augmented_system") {
+         return LeastSquareMultiplierMethod::AUGMENTED_SYSTEM;
+      }
+      else if (method == "normal_equations") {
+         return LeastSquareMultiplierMethod::NORMAL_EQUATIONS;
+      }
+      else if (method == "automatic") {
+         return (NORMAL_EQUATIONS_RATIO * number_constraints <= number_variables) ? LeastSquareMultiplierMethod::NORMAL_EQUATIONS :
+            LeastSquareMultiplierMethod::AUGMENTED_SYSTEM;
+      }
+      throw std::invalid_argument("The least-square multiplier method " + method + " does not exist");
+   }
+
+   template <typename IndexType>
+   size_t LeastSquareMultiplierSolver<IndexType>::matrix_dimension(LeastSquareMultiplierMethod method, size_t number_variables,
+         size_t number_constraints) {
+      return (method == LeastSquareMultiplierMethod::AUGMENTED_SYSTEM) ? number_variables + number_constraints : number_constraints;
+   }
+
+   template <typename IndexType>
+   size_t LeastSquareMultiplierSolver<IndexType>::matrix_number_nonzeros(LeastSquareMultiplierMethod method, size_t number_variables,
+         size_t number_constraints, size_t number_jacobian_nonzeros) {
+      if (method == LeastSquareMultiplierMethod::AUGMENTED_SYSTEM) {
+         return number_variables + number_jacobian_nonzeros;
+      }
+      // a variable that appears in c constraints contributes at most c(c+1)/2 entries to the upper triangle of J J^T, and c <= m.
+      // The diagonal is always stored
+      const size_t dense_upper_triangle = number_constraints * (number_constraints + 1) / 2;
+      return std::min(dense_upper_triangle, (number_constraints + 1) * number_jacobian_nonzeros / 2 + number_constraints);
+   }
+
+   // compute a least-square approximation of the multipliers by solving a linear system
+   template <typename IndexType>
+   void LeastSquareMultiplierSolver<IndexType>::compute_multipliers(const Model& model, Iterate& current_iterate, Vector<double>& multipliers) {
+      assert(model.number_variables <= this->residual.size() && "LeastSquareMultiplierSolver: the model has too many variables");
+      current_iterate.evaluate_objective_gradient(model);
+      current_iterate.evaluate_constraint_jacobian(model);
+      DEBUG << "Computing least-square multipliers\n";
+      DEBUG2 << "Current primals: " << current_iterate.primals << '\n';
+
+      // residual of the stationarity conditions without the constraint multipliers
+      const auto residual_view = view(this->residual, 0, model.number_variables);
+      this->residual.fill(0.);
+      for (const auto [variable_index, derivative]: current_iterate.evaluations.objective_gradient) {
+         this->residual[variable_index] += model.objective_sign * derivative;
+      }
+      for (size_t variable_index: Range(model.number_variables)) {
+         this->residual[variable_index] -= current_iterate.multipliers.lower_bounds[variable_index] +
+            current_iterate.multipliers.upper_bounds[variable_index];
+      }
+      DEBUG2 << "Residual for least-square multipliers: " << residual_view;
+
+      // if the residuals are all 0, the least-square multipliers are all 0
+      if (norm_inf(residual_view) == 0.) {
+         multipliers.fill(0.);
+         DEBUG << "Least-square multipliers are all 0.\n";
+         return;
+      }
+
+      /* build the symmetric matrix and the right-hand side */
+      const RectangularMatrix<double>& constraint_jacobian = current_iterate.evaluations.constraint_jacobian;
+      if (this->method == LeastSquareMultiplierMethod::AUGMENTED_SYSTEM) {
+         this->assemble_augmented_system(model, constraint_jacobian);
+      }
+      else {
+         this->assemble_normal_equations(model, constraint_jacobian);
+      }
+      DEBUG2 << "Matrix for least-square multipliers:\n" << this->matrix << '\n';
+
+      /* solve the system. The symbolic analysis is performed only when the sparsity pattern of the Jacobian changes */
+      if (this->jacobian_pattern_changed(model, constraint_jacobian)) {
+         this->linear_solver->do_symbolic_analysis(this->matrix);
+         this->symbolic_analyses++;
+      }
+      this->linear_solver->do_numerical_factorization(this->matrix);
+      // a rank-deficient Jacobian makes J J^T singular
+      if (this->method == LeastSquareMultiplierMethod::NORMAL_EQUATIONS && this->linear_solver->matrix_is_singular()) {
+         DEBUG << "The normal equations are singular: ignoring the least-square multipliers\n\n";
+         return;
+      }
+      this->linear_solver->solve_indefinite_system(this->matrix, this->rhs, this->solution);
+
+      // if least-square multipliers too big, discard them. Otherwise, keep them
+      const size_t offset = (this->method == LeastSquareMultiplierMethod::AUGMENTED_SYSTEM) ? model.number_variables : 0;
+      const auto trial_multipliers = view(this->solution, offset, offset + model.number_constraints);
+      DEBUG2 << "Trial multipliers: " << trial_multipliers;
+      if (norm_inf(trial_multipliers) <= this->multiplier_max_norm) {
+         multipliers = trial_multipliers;
+      }
+      else {
+         DEBUG << "Ignoring the least-square multipliers\n";
+      }
+      DEBUG << '\n';
+   }
+
+   template <typename IndexType>
+   bool LeastSquareMultiplierSolver<IndexType>::jacobian_pattern_changed(const Model& model, const RectangularMatrix<double>& constraint_jacobian) {
+      this->pattern_workspace.clear();
+      this->pattern_workspace.emplace_back(model.number_variables);
+      this->pattern_workspace.emplace_back(model.number_constraints);
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         this->pattern_workspace.emplace_back(constraint_jacobian[constraint_index].size());
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            this->pattern_workspace.emplace_back(variable_index);
+         }
+      }
+      if (this->is_analyzed && this->pattern_workspace == this->jacobian_pattern) {
+         return false;
+      }
+      std::swap(this->jacobian_pattern, this->pattern_workspace);
+      this->is_analyzed = true;
+      return true;
+   }
+
+   // [I J^T; J 0] with rhs (σ∇f(x) - z, 0)
+   template <typename IndexType>
+   void LeastSquareMultiplierSolver<IndexType>::assemble_augmented_system(const Model& model, const RectangularMatrix<double>& constraint_jacobian) {
+      this->matrix.set_dimension(model.number_variables + model.number_constraints);
+      this->matrix.reset();
+      // identity block
+      for (size_t variable_index: Range(model.number_variables)) {
+         this->matrix.insert(1., static_cast<IndexType>(variable_index), static_cast<IndexType>(variable_index));
+         this->matrix.finalize_column(static_cast<IndexType>(variable_index));
+      }
+      // Jacobian of general constraints
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         const IndexType column_index = static_cast<IndexType>(model.number_variables + constraint_index);
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            this->matrix.insert(derivative, static_cast<IndexType>(variable_index), column_index);
+         }
+         this->matrix.finalize_column(column_index);
+      }
+      this->rhs.fill(0.);
+      for (size_t variable_index: Range(model.number_variables)) {
+         this->rhs[variable_index] = this->residual[variable_index];
+      }
+   }
+
+   // J J^T with rhs J (σ∇f(x) - z). The upper triangle is assembled column by column from the transposed Jacobian. Its sparsity pattern
+   // is structural (the cancellations are stored), so that it only depends on the sparsity pattern of the Jacobian
+   template <typename IndexType>
+   void LeastSquareMultiplierSolver<IndexType>::assemble_normal_equations(const Model& model, const RectangularMatrix<double>& constraint_jacobian) {
+      // transpose the Jacobian: the constraints of each variable are sorted in increasing order
+      this->transposed_start.assign(model.number_variables + 1, 0);
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            this->transposed_start[variable_index + 1]++;
+         }
+      }
+      for (size_t variable_index: Range(model.number_variables)) {
+         this->transposed_start[variable_index + 1] += this->transposed_start[variable_index];
+      }
+      this->transposed_rows.resize(this->transposed_start[model.number_variables]);
+      this->transposed_values.resize(this->transposed_start[model.number_variables]);
+      // transposed_start[variable_index] is used as a cursor, then shifted back
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            const size_t position = this->transposed_start[variable_index]++;
+            this->transposed_rows[position] = constraint_index;
+            this->transposed_values[position] = derivative;
+         }
+      }
+      for (size_t variable_index = model.number_variables; 0 < variable_index; variable_index--) {
+         this->transposed_start[variable_index] = this->transposed_start[variable_index - 1];
+      }
+      this->transposed_start[0] = 0;
+
+      this->matrix.set_dimension(model.number_constraints);
+      this->matrix.reset();
+      for (size_t column_index: Range(model.number_constraints)) {
+         // the diagonal entry is always stored
+         this->touched_rows.emplace_back(column_index);
+         this->is_touched[column_index] = true;
+         double rhs_entry = 0.;
+         for (const auto [variable_index, derivative]: constraint_jacobian[column_index]) {
+            rhs_entry += derivative * this->residual[variable_index];
+            for (size_t position: Range(this->transposed_start[variable_index], this->transposed_start[variable_index + 1])) {
+               const size_t row_index = this->transposed_rows[position];
+               if (column_index < row_index) {
+                  break;
+               }
+               if (!this->is_touched[row_index]) {
+                  this->touched_rows.emplace_back(row_index);
+                  this->is_touched[row_index] = true;
+               }
+               this->accumulator[row_index] += derivative * this->transposed_values[position];
+            }
+         }
+         std::sort(this->touched_rows.begin(), this->touched_rows.end());
+         for (size_t row_index: this->touched_rows) {
+            this->matrix.insert(this->accumulator[row_index], static_cast<IndexType>(row_index), static_cast<IndexType>(column_index));
+            this->accumulator[row_index] = 0.;
+            this->is_touched[row_index] = false;
+         }
+         this->touched_rows.clear();
+         this->matrix.finalize_column(static_cast<IndexType>(column_index));
+         this->rhs[column_index] = rhs_entry;
+      }
+   }
+
+   template <typename IndexType>
+   size_t LeastSquareMultiplierSolver<IndexType>::memory_size() const {
+      return this->matrix.memory_size() + this->rhs.memory_size() + this->solution.memory_size() + this->linear_solver->memory_size() +
+            (this->jacobian_pattern.capacity() + this->pattern_workspace.capacity() + this->transposed_start.capacity() +
+            this->transposed_rows.capacity() + this->touched_rows.capacity()) * sizeof(size_t) +
+            this->transposed_values.capacity() * sizeof(double) + this->residual.memory_size() + this->accumulator.memory_size();
+   }
+
+   template class LeastSquareMultiplierSolver<size_t>;
+   template class LeastSquareMultiplierSolver<int>;
+} // namespace
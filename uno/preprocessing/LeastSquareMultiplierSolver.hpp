@@ -0,0 +1,86 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_LEASTSQUAREMULTIPLIERSOLVER_H
+#define UNO_LEASTSQUAREMULTIPLIERSOLVER_H
+
+#include <memory>
+#include <vector>
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declarations
+   class Iterate;
+   class Model;
+   class Options;
+   template <typename IndexType, typename ElementType>
+   class DirectSymmetricIndefiniteLinearSolver;
+   template <typename ElementType>
+   class RectangularMatrix;
+
+   enum class LeastSquareMultiplierMethod {AUGMENTED_SYSTEM, NORMAL_EQUATIONS};
+
+   /*! \class LeastSquareMultiplierSolver
+    * \brief Least-square estimate of the constraint multipliers
+    *
+    *  The multipliers λ minimize ||σ∇f(x) - z - J(x)^T λ||_2. They are obtained either from the augmented system [I J^T; J 0] of
+    *  dimension n+m, or from the normal equations J J^T λ = J (σ∇f(x) - z) of dimension m (cheaper when m is much smaller than n).
+    *  The matrix and the linear solver are owned by the solver, which leaves the symbolic state of the KKT system untouched. The
+    *  symbolic analysis is reused as long as the sparsity pattern of the Jacobian does not change
+    */
+   template <typename IndexType>
+   class LeastSquareMultiplierSolver {
+   public:
+      // the linear solver must accept matrices of dimension matrix_dimension() with at most matrix_number_nonzeros() nonzeros
+      LeastSquareMultiplierSolver(LeastSquareMultiplierMethod method, size_t number_variables, size_t number_constraints,
+            size_t number_jacobian_nonzeros, std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, double>> linear_solver,
+            const Options& options, size_t index_shift = 0);
+      ~LeastSquareMultiplierSolver();
+
+      // the method and the linear solver are determined by the options
+      static std::unique_ptr<LeastSquareMultiplierSolver<IndexType>> create(size_t number_variables, size_t number_constraints,
+            size_t number_jacobian_nonzeros, const Options& options, size_t index_shift = 0);
+      [[nodiscard]] static LeastSquareMultiplierMethod determine_method(size_t number_variables, size_t number_constraints, const Options& options);
+      [[nodiscard]] static size_t matrix_dimension(LeastSquareMultiplierMethod method, size_t number_variables, size_t number_constraints);
+      [[nodiscard]] static size_t matrix_number_nonzeros(LeastSquareMultiplierMethod method, size_t number_variables, size_t number_constraints,
+            size_t number_jacobian_nonzeros);
+
+      // overwrite the multipliers with the least-square multipliers if their norm does not exceed the maximum norm
+      void compute_multipliers(const Model& model, Iterate& current_iterate, Vector<double>& multipliers);
+
+      [[nodiscard]] LeastSquareMultiplierMethod get_method() const { return this->method; }
+      [[nodiscard]] size_t number_symbolic_analyses() const { return this->symbolic_analyses; }
+      // allocated memory of the matrix, the vectors and the linear solver (in bytes)
+      [[nodiscard]] size_t memory_size() const;
+
+   private:
+      const LeastSquareMultiplierMethod method;
+      const double multiplier_max_norm;
+      SymmetricMatrix<IndexType, double> matrix;
+      Vector<double> rhs;
+      Vector<double> solution;
+      const std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<IndexType, double>> linear_solver;
+
+      // sparsity pattern of the Jacobian at the last symbolic analysis (dimensions, row sizes and column indices)
+      std::vector<size_t> jacobian_pattern{};
+      std::vector<size_t> pattern_workspace{};
+      bool is_analyzed{false};
+      size_t symbolic_analyses{0};
+
+      // normal equations: transposed Jacobian (compressed by variable), residual σ∇f(x) - z and accumulator of a column of J J^T
+      std::vector<size_t> transposed_start{};
+      std::vector<size_t> transposed_rows{};
+      std::vector<double> transposed_values{};
+      Vector<double> residual;
+      Vector<double> accumulator;
+      std::vector<size_t> touched_rows{};
+      std::vector<bool> is_touched{};
+
+      [[nodiscard]] bool jacobian_pattern_changed(const Model& model, const RectangularMatrix<double>& constraint_jacobian);
+      void assemble_augmented_system(const Model& model, const RectangularMatrix<double>& constraint_jacobian);
+      void assemble_normal_equations(const Model& model, const RectangularMatrix<double>& constraint_jacobian);
+   };
+} // namespace
+
+#endif // UNO_LEASTSQUAREMULTIPLIERSOLVER_H
@@ -0,0 +1,144 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include "LinearProjectionProblem.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/LagrangianGradient.hpp"
+#include "symbolic/Expression.hpp"
+
+namespace uno {
+   namespace {
+      std::vector<size_t> collect_linear_constraints(const Model& model) {
+         std::vector<size_t> linear_constraints;
+         for (size_t constraint_index: model.get_linear_constraints()) {
+            linear_constraints.emplace_back(constraint_index);
+         }
+         return linear_constraints;
+      }
+   } // namespace
+
+   LinearProjectionProblem::LinearProjectionProblem(const Model& model, const Vector<double>& reference_point):
+         OptimizationProblem(model, model.number_variables, model.get_linear_constraints().size()),
+         reference_point(reference_point),
+         linear_constraints(collect_linear_constraints(model)),
+         model_constraints(model.number_constraints),
+         constraint_gradient(model.number_variables),
+         linear_jacobian(this->number_constraints, model.number_variables) {
+   }
+
+   // gradient x - x_ref
+   void LinearProjectionProblem::evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const {
+      objective_gradient.clear();
+      for (size_t variable_index: Range(this->number_variables)) {
+         const double derivative = iterate.primals[variable_index] - this->reference_point[variable_index];
+         if (derivative != 0.) {
+            objective_gradient.insert(variable_index, derivative);
+         }
+      }
+   }
+
+   void LinearProjectionProblem::evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const {
+      this->model.evaluate_constraints(iterate.primals, this->model_constraints);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         constraints[constraint_index] = this->model_constraints[this->linear_constraints[constraint_index]];
+      }
+   }
+
+   // the Jacobian of the linear rows only
+   void LinearProjectionProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrixView<double>& constraint_jacobian) const {
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->constraint_gradient.clear();
+         this->model.evaluate_constraint_gradient(iterate.primals, this->linear_constraints[constraint_index], this->constraint_gradient);
+         this->linear_jacobian[constraint_index].clear();
+         for (const auto [variable_index, derivative]: this->constraint_gradient) {
+            this->linear_jacobian[constraint_index].insert(variable_index, derivative);
+         }
+      }
+      constraint_jacobian.reset(this->linear_jacobian);
+   }
+
+   // identity (the constraints are linear)
+   void LinearProjectionProblem::evaluate_lagrangian_hessian(const Vector<double>& /*x*/, const Vector<double>& /*multipliers*/,
+         SymmetricMatrix<size_t, double>& hessian) const {
+      hessian.reset();
+      for (size_t variable_index: Range(this->number_variables)) {
+         hessian.insert(1., variable_index, variable_index);
+         hessian.finalize_column(variable_index);
+      }
+   }
+
+   void LinearProjectionProblem::evaluate_lagrangian_hessian_vector_product(const Vector<double>& /*x*/, const Vector<double>& /*multipliers*/,
+         const Vector<double>& vector, Vector<double>& result) const {
+      for (size_t variable_index: Range(this->number_variables)) {
+         result[variable_index] = vector[variable_index];
+      }
+   }
+
+   void LinearProjectionProblem::evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate,
+         const Multipliers& multipliers) const {
+      for (size_t variable_index: Range(this->number_variables)) {
+         lagrangian_gradient.objective_contribution[variable_index] = iterate.primals[variable_index] - this->reference_point[variable_index];
+         lagrangian_gradient.constraints_contribution[variable_index] = -(multipliers.lower_bounds[variable_index] +
+            multipliers.upper_bounds[variable_index]);
+      }
+      // the constraints contribute -J^T y
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->constraint_gradient.clear();
+         this->model.evaluate_constraint_gradient(iterate.primals, this->linear_constraints[constraint_index], this->constraint_gradient);
+         for (const auto [variable_index, derivative]: this->constraint_gradient) {
+            lagrangian_gradient.constraints_contribution[variable_index] -= multipliers.constraints[constraint_index] * derivative;
+         }
+      }
+   }
+
+   double LinearProjectionProblem::evaluate_stationarity_error(Vector<double>& lagrangian_gradient, Iterate& iterate,
+         const Multipliers& multipliers, double objective_multiplier, Norm residual_norm) const {
+      // the constraints contribute -J^T y
+      lagrangian_gradient.fill(0.);
+      for (size_t constraint_index: Range(this->number_constraints)) {
+         this->constraint_gradient.clear();
+         this->model.evaluate_constraint_gradient(iterate.primals, this->linear_constraints[constraint_index], this->constraint_gradient);
+         for (const auto [variable_index, derivative]: this->constraint_gradient) {
+            lagrangian_gradient[variable_index] -= multipliers.constraints[constraint_index] * derivative;
+         }
+      }
+      // scaled distance to the reference point and bound constraints, fused with the norm
+      return fused_norm(residual_norm, this->number_variables, [&](size_t variable_index) {
+         lagrangian_gradient[variable_index] += objective_multiplier * (iterate.primals[variable_index] - this->reference_point[variable_index]) -
+            (multipliers.lower_bounds[variable_index] + multipliers.upper_bounds[variable_index]);
+         return lagrangian_gradient[variable_index];
+      });
+   }
+
+   double LinearProjectionProblem::complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
+         const Multipliers& multipliers, double shift_value, Norm residual_norm) const {
+      // bound constraints
+      const Range variables_range = Range(this->number_variables);
+      const VectorExpression variable_complementarity{variables_range, [&](size_t variable_index) {
+         if (0. < multipliers.lower_bounds[variable_index]) {
+            return multipliers.lower_bounds[variable_index] * (primals[variable_index] - this->variable_lower_bound(variable_index)) - shift_value;
+         }
+         if (multipliers.upper_bounds[variable_index] < 0.) {
+            return multipliers.upper_bounds[variable_index] * (primals[variable_index] - this->variable_upper_bound(variable_index)) - shift_value;
+         }
+         return 0.;
+      }};
+
+      // linear constraints
+      const Range constraints_range = Range(this->number_constraints);
+      const VectorExpression constraint_complementarity{constraints_range, [&](size_t constraint_index) {
+         if (0. < multipliers.constraints[constraint_index]) { // lower bound
+            return multipliers.constraints[constraint_index] * (constraints[constraint_index] - this->constraint_lower_bound(constraint_index)) -
+                   shift_value;
+         }
+         else if (multipliers.constraints[constraint_index] < 0.) { // upper bound
+            return multipliers.constraints[constraint_index] * (constraints[constraint_index] - this->constraint_upper_bound(constraint_index)) -
+                   shift_value;
+         }
+         return 0.;
+      }};
+      return norm(residual_norm, variable_complementarity, constraint_complementarity);
+   }
+} // namespace
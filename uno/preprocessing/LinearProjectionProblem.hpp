@@ -0,0 +1,68 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_LINEARPROJECTIONPROBLEM_H
+#define UNO_LINEARPROJECTIONPROBLEM_H
+
+#include <vector>
+#include "ingredients/constraint_relaxation_strategies/OptimizationProblem.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   /*! \class LinearProjectionProblem
+    * \brief Projection of a reference point onto the linear constraints and the bounds of a model
+    *
+    *  min 1/2 ||x - x_ref||^2 s.t. c_L(x) ∈ [l_L, u_L], x ∈ [x_l, x_u], where L is the set of linear constraints (in their order in
+    *  the model). The Jacobian only contains the linear rows
+    */
+   class LinearProjectionProblem: public OptimizationProblem {
+   public:
+      LinearProjectionProblem(const Model& model, const Vector<double>& reference_point);
+
+      [[nodiscard]] double get_objective_multiplier() const override { return 1.; }
+      void evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const override;
+      void evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const override;
+      void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrixView<double>& constraint_jacobian) const override;
+      void evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers, SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& multipliers, const Vector<double>& vector,
+            Vector<double>& result) const override;
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return this->model.variable_lower_bound(variable_index); }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return this->model.variable_upper_bound(variable_index); }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->model.get_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->model.get_upper_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->model.get_single_lower_bounded_variables(); }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->model.get_single_upper_bounded_variables(); }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override {
+         return this->model.constraint_lower_bound(this->linear_constraints[constraint_index]);
+      }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override {
+         return this->model.constraint_upper_bound(this->linear_constraints[constraint_index]);
+      }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->number_variables; }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->model.number_jacobian_nonzeros(); }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->number_variables; }
+
+      void evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers) const override;
+      [[nodiscard]] double evaluate_stationarity_error(Vector<double>& lagrangian_gradient, Iterate& iterate, const Multipliers& multipliers,
+            double objective_multiplier, Norm residual_norm) const override;
+      [[nodiscard]] double complementarity_error(const Vector<double>& primals, const std::vector<double>& constraints,
+            const Multipliers& multipliers, double shift_value, Norm residual_norm) const override;
+
+      // index of a linear constraint in the model
+      [[nodiscard]] size_t original_index(size_t constraint_index) const { return this->linear_constraints[constraint_index]; }
+
+   private:
+      const Vector<double>& reference_point;
+      const std::vector<size_t> linear_constraints;
+      mutable std::vector<double> model_constraints;
+      mutable SparseVector<double> constraint_gradient;
+      mutable RectangularMatrix<double> linear_jacobian; /*!< the linear rows are not stored contiguously in the Jacobian of the iterate */
+   };
+} // namespace
+
+#endif // UNO_LINEARPROJECTIONPROBLEM_H
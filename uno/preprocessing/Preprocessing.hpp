@@ -11,21 +11,12 @@ namespace uno {
    // forward declarations
    class Iterate;
    class Model;
-   class Multipliers;
    class QPSolver;
-   template <typename IndexType, typename ElementType>
-   class DirectSymmetricIndefiniteLinearSolver;
-   template <typename IndexType, typename ElementType>
-   class SymmetricMatrix;
-   template <typename ElementType>
-   class Vector;
+   class Statistics;
 
    class Preprocessing {
    public:
-      static void compute_least_square_multipliers(const Model& model, SymmetricMatrix<size_t, double>& matrix, Vector<double>& rhs,
-            DirectSymmetricIndefiniteLinearSolver<size_t, double>& linear_solver, Iterate& current_iterate, Vector<double>& multipliers,
-            double multiplier_max_norm);
-      static void enforce_linear_constraints(const Model& model, Vector<double>& primals, Multipliers& multipliers, QPSolver& qp_solver);
+      static void enforce_linear_constraints(Statistics& statistics, const Model& model, Iterate& initial_iterate, QPSolver& qp_solver);
    };
 } // namespace
 
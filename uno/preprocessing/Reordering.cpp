@@ -0,0 +1,211 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <limits>
+#include "Reordering.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/Model.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   namespace {
+      constexpr size_t UNVISITED{std::numeric_limits<size_t>::max()};
+
+      // breadth-first search from root over the unvisited nodes: the nodes are appended to order, the neighbors by increasing
+      // degree. Returns the position in order of the first node of the last level
+      size_t breadth_first_search(const std::vector<size_t>& adjacency_starts, const std::vector<size_t>& adjacency, size_t root,
+            std::vector<size_t>& levels, std::vector<size_t>& order, std::vector<size_t>& neighbors) {
+         const auto degree = [&](size_t node) {
+            return adjacency_starts[node + 1] - adjacency_starts[node];
+         };
+         size_t position = order.size();
+         size_t last_level_start = position;
+         levels[root] = 0;
+         order.emplace_back(root);
+         while (position < order.size()) {
+            const size_t node = order[position];
+            if (levels[node] != levels[order[last_level_start]]) {
+               last_level_start = position;
+            }
+            neighbors.clear();
+            for (size_t adjacency_index: Range(adjacency_starts[node], adjacency_starts[node + 1])) {
+               const size_t neighbor = adjacency[adjacency_index];
+               if (levels[neighbor] == UNVISITED) {
+                  levels[neighbor] = levels[node] + 1;
+                  neighbors.emplace_back(neighbor);
+               }
+            }
+            std::stable_sort(neighbors.begin(), neighbors.end(), [&](size_t node1, size_t node2) {
+               return degree(node1) < degree(node2);
+            });
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+            position++;
+         }
+         return last_level_start;
+      }
+
+      // graph of the variables: the pairs of variables of the rows of the Jacobian (except the dense rows) and of the Hessian
+      void build_variable_graph(const Model& model, size_t dense_row_size, std::vector<size_t>& adjacency_starts,
+            std::vector<size_t>& adjacency) {
+         Vector<double> initial_point(model.number_variables);
+         model.initial_primal_point(initial_point);
+         model.project_onto_variable_bounds(initial_point);
+         std::vector<std::vector<size_t>> neighbors(model.number_variables);
+         const auto add_edge = [&](size_t variable1, size_t variable2) {
+            if (variable1 != variable2) {
+               neighbors[variable1].emplace_back(variable2);
+               neighbors[variable2].emplace_back(variable1);
+            }
+         };
+         // Jacobian
+         if (model.is_constrained()) {
+            RectangularMatrix<double> constraint_jacobian(model.number_constraints, model.number_variables);
+            model.evaluate_constraint_jacobian(initial_point, constraint_jacobian);
+            const size_t* column_indices = constraint_jacobian.column_indices_pointer();
+            for (size_t constraint_index: Range(model.number_constraints)) {
+               const size_t row_start = constraint_jacobian.row_start(constraint_index);
+               const size_t row_size = constraint_jacobian.row_size(constraint_index);
+               if (row_size <= dense_row_size) {
+                  for (size_t first_index: Range(row_start, row_start + row_size)) {
+                     for (size_t second_index: Range(first_index + 1, row_start + row_size)) {
+                        add_edge(column_indices[first_index], column_indices[second_index]);
+                     }
+                  }
+               }
+            }
+         }
+         // Hessian: declared pattern, or structure evaluated with unit multipliers
+         std::vector<size_t> row_indices{}, column_indices{};
+         if (model.declare_hessian_sparsity(row_indices, column_indices)) {
+            for (size_t nonzero_index: Range(row_indices.size())) {
+               add_edge(row_indices[nonzero_index], column_indices[nonzero_index]);
+            }
+         }
+         else if (0 < model.number_hessian_nonzeros()) {
+            SymmetricMatrix<size_t, double> hessian(model.number_variables, model.number_hessian_nonzeros(), false, "COO");
+            const Vector<double> multipliers(model.number_constraints, 1.);
+            model.evaluate_lagrangian_hessian(initial_point, 1., multipliers, hessian);
+            hessian.for_each([&](size_t row_index, size_t column_index, double /*entry*/) {
+               add_edge(row_index, column_index);
+            });
+         }
+         // CSR format without duplicates
+         adjacency_starts.assign(model.number_variables + 1, 0);
+         adjacency.clear();
+         for (size_t variable_index: Range(model.number_variables)) {
+            std::vector<size_t>& variable_neighbors = neighbors[variable_index];
+            std::sort(variable_neighbors.begin(), variable_neighbors.end());
+            variable_neighbors.erase(std::unique(variable_neighbors.begin(), variable_neighbors.end()), variable_neighbors.end());
+            adjacency.insert(adjacency.end(), variable_neighbors.begin(), variable_neighbors.end());
+            adjacency_starts[variable_index + 1] = adjacency.size();
+         }
+      }
+   } // namespace
+
+   std::vector<size_t> Reordering::reverse_cuthill_mckee(const std::vector<size_t>& adjacency_starts, const std::vector<size_t>& adjacency) {
+      const size_t number_nodes = adjacency_starts.size() - 1;
+      const auto degree = [&](size_t node) {
+         return adjacency_starts[node + 1] - adjacency_starts[node];
+      };
+      // the components are started from their node of smallest degree, in the original order
+      std::vector<size_t> nodes_by_degree(number_nodes);
+      for (size_t node: Range(number_nodes)) {
+         nodes_by_degree[node] = node;
+      }
+      std::stable_sort(nodes_by_degree.begin(), nodes_by_degree.end(), [&](size_t node1, size_t node2) {
+         return degree(node1) < degree(node2);
+      });
+      std::vector<size_t> levels(number_nodes, UNVISITED);
+      std::vector<size_t> order{};
+      order.reserve(number_nodes);
+      std::vector<size_t> neighbors{};
+      for (const size_t start_node: nodes_by_degree) {
+         if (levels[start_node] != UNVISITED) {
+            continue;
+         }
+         // pseudo-peripheral root (George and Liu): restart the search from a node of smallest degree in the last level, as long
+         // as the number of levels increases
+         const size_t component_start = order.size();
+         size_t root = start_node;
+         size_t last_level_start = breadth_first_search(adjacency_starts, adjacency, root, levels, order, neighbors);
+         size_t eccentricity = levels[order.back()];
+         while (true) {
+            size_t candidate = order[last_level_start];
+            for (size_t position: Range(last_level_start, order.size())) {
+               if (degree(order[position]) < degree(candidate)) {
+                  candidate = order[position];
+               }
+            }
+            for (size_t position: Range(component_start, order.size())) {
+               levels[order[position]] = UNVISITED;
+            }
+            order.resize(component_start);
+            last_level_start = breadth_first_search(adjacency_starts, adjacency, candidate, levels, order, neighbors);
+            if (levels[order.back()] <= eccentricity) {
+               // the candidate does not improve: the search from the candidate is kept (it is as deep as that of the root)
+               break;
+            }
+            root = candidate;
+            eccentricity = levels[order.back()];
+         }
+      }
+      std::reverse(order.begin(), order.end());
+      return order;
+   }
+
+   ModelOrdering Reordering::compute_model_ordering(const Model& model, size_t dense_row_size) {
+      std::vector<size_t> adjacency_starts{}, adjacency{};
+      build_variable_graph(model, dense_row_size, adjacency_starts, adjacency);
+      ModelOrdering ordering{Reordering::reverse_cuthill_mckee(adjacency_starts, adjacency), {}};
+      std::vector<size_t> variable_positions(model.number_variables);
+      for (size_t position: Range(model.number_variables)) {
+         variable_positions[ordering.variable_order[position]] = position;
+      }
+      // constraints by their smallest reordered variable (the constraints without variables come last)
+      std::vector<size_t> first_variables(model.number_constraints, model.number_variables);
+      if (model.is_constrained()) {
+         Vector<double> initial_point(model.number_variables);
+         model.initial_primal_point(initial_point);
+         model.project_onto_variable_bounds(initial_point);
+         RectangularMatrix<double> constraint_jacobian(model.number_constraints, model.number_variables);
+         model.evaluate_constraint_jacobian(initial_point, constraint_jacobian);
+         for (size_t constraint_index: Range(model.number_constraints)) {
+            for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+               first_variables[constraint_index] = std::min(first_variables[constraint_index], variable_positions[variable_index]);
+            }
+         }
+      }
+      ordering.constraint_order.resize(model.number_constraints);
+      for (size_t constraint_index: Range(model.number_constraints)) {
+         ordering.constraint_order[constraint_index] = constraint_index;
+      }
+      std::stable_sort(ordering.constraint_order.begin(), ordering.constraint_order.end(), [&](size_t constraint1, size_t constraint2) {
+         return first_variables[constraint1] < first_variables[constraint2];
+      });
+      std::vector<size_t> original_positions(model.number_variables);
+      for (size_t variable_index: Range(model.number_variables)) {
+         original_positions[variable_index] = variable_index;
+      }
+      DEBUG << "Reordering: the bandwidth of the variable graph is reduced from " <<
+         Reordering::compute_bandwidth(adjacency_starts, adjacency, original_positions) << " to " <<
+         Reordering::compute_bandwidth(adjacency_starts, adjacency, variable_positions) << '\n';
+      return ordering;
+   }
+
+   size_t Reordering::compute_bandwidth(const std::vector<size_t>& adjacency_starts, const std::vector<size_t>& adjacency,
+         const std::vector<size_t>& positions) {
+      size_t bandwidth = 0;
+      for (size_t node: Range(adjacency_starts.size() - 1)) {
+         for (size_t adjacency_index: Range(adjacency_starts[node], adjacency_starts[node + 1])) {
+            const size_t first_position = positions[node];
+            const size_t second_position = positions[adjacency[adjacency_index]];
+            bandwidth = std::max(bandwidth, (first_position < second_position) ? second_position - first_position : first_position - second_position);
+         }
+      }
+      return bandwidth;
+   }
+} // namespace
@@ -0,0 +1,39 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_REORDERING_H
+#define UNO_REORDERING_H
+
+#include <cstddef>
+#include <vector>
+
+namespace uno {
+   // forward declaration
+   class Model;
+
+   // permutation of the variables and the constraints of a model: order[k] is the original index of the k-th element
+   struct ModelOrdering {
+      std::vector<size_t> variable_order{};
+      std::vector<size_t> constraint_order{};
+   };
+
+   class Reordering {
+   public:
+      // reverse Cuthill-McKee order of a symmetric graph in CSR format (adjacency lists without self-loops). Each connected
+      // component is numbered by a breadth-first search from a pseudo-peripheral node, the neighbors by increasing degree, and the
+      // order is reversed. The bandwidth of the adjacency matrix is (heuristically) reduced
+      [[nodiscard]] static std::vector<size_t> reverse_cuthill_mckee(const std::vector<size_t>& adjacency_starts,
+            const std::vector<size_t>& adjacency);
+
+      // locality-improving order of a model, from the structure of its Jacobian and Hessian at the initial point. The variables are
+      // ordered by reverse Cuthill-McKee on the graph of H + J^T J (the rows with more than dense_row_size nonzeros are ignored),
+      // the constraints by their smallest reordered variable
+      [[nodiscard]] static ModelOrdering compute_model_ordering(const Model& model, size_t dense_row_size);
+
+      // bandwidth max |positions[i] - positions[j]| over the edges (i, j) of the graph
+      [[nodiscard]] static size_t compute_bandwidth(const std::vector<size_t>& adjacency_starts, const std::vector<size_t>& adjacency,
+            const std::vector<size_t>& positions);
+   };
+} // namespace
+
+#endif // UNO_REORDERING_H
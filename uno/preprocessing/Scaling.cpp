@@ -6,6 +6,7 @@
 #include "linear_algebra/RectangularMatrix.hpp"
 #include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "symbolic/VectorView.hpp"
 
 namespace uno {
    Scaling::Scaling(size_t number_constraints, double gradient_threshold):
@@ -21,7 +22,7 @@ namespace uno {
          this->constraint_scaling[constraint_index] = std::min(1., this->gradient_threshold / norm_inf(constraint_jacobian[constraint_index]));
       }
       DEBUG2 << "Objective scaling: " << this->objective_scaling << '\n';
-      DEBUG2 << "Constraint scaling: "; print_vector(DEBUG2, this->constraint_scaling);
+      DEBUG2 << "Constraint scaling: " << view(this->constraint_scaling, 0, this->constraint_scaling.size());
    }
 
    double Scaling::get_objective_scaling() const {
@@ -32,4 +33,8 @@ namespace uno {
       assert(constraint_index < this->constraint_scaling.size() && "The constraint index is not valid.");
       return this->constraint_scaling[constraint_index];
    }
+
+   const std::vector<double>& Scaling::get_constraint_scalings() const {
+      return this->constraint_scaling;
+   }
 } // namespace
@@ -20,6 +20,7 @@ namespace uno {
       void compute(const SparseVector<double>& objective_gradient, const RectangularMatrix<double>& constraint_jacobian);
       [[nodiscard]] double get_objective_scaling() const;
       [[nodiscard]] double get_constraint_scaling(size_t constraint_index) const;
+      [[nodiscard]] const std::vector<double>& get_constraint_scalings() const;
 
    protected:
       const double gradient_threshold;
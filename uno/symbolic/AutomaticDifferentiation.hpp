@@ -0,0 +1,405 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_AUTOMATICDIFFERENTIATION_H
+#define UNO_AUTOMATICDIFFERENTIATION_H
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace uno {
+   // second-order interaction of the arguments of an elementary operation (used to detect the sparsity of the Hessian)
+   enum class Interaction {NONE, /*!< piecewise linear in its arguments */
+      CROSS, /*!< bilinear: only the mixed second derivatives are nonzero */
+      QUOTIENT, /*!< linear in the first argument: only the mixed derivatives and the second derivative in the second argument are nonzero */
+      FULL};
+
+   /*! \class Dual
+    * \brief Forward-mode (tangent) number: value and directional derivative
+    *
+    *  No tape: the derivative is propagated along with the value. T is double, or a number type itself (nested modes)
+    */
+   template <typename T>
+   class Dual {
+   public:
+      using ValueType = T;
+      T value{};
+      T tangent{};
+
+      Dual() = default;
+      template <typename Scalar, std::enable_if_t<std::is_arithmetic_v<Scalar>, int> = 0>
+      Dual(Scalar value): value(value), tangent(0.) { }
+      Dual(T value, T tangent): value(std::move(value)), tangent(std::move(tangent)) { }
+
+      static Dual unary(const Dual& a, const T& value, const T& derivative, Interaction /*interaction*/) {
+         return {value, derivative * a.tangent};
+      }
+      static Dual binary(const Dual& a, const Dual& b, const T& value, const T& left_derivative, const T& right_derivative,
+            Interaction /*interaction*/) {
+         return {value, left_derivative * a.tangent + right_derivative * b.tangent};
+      }
+   };
+
+   /*! \class Tape
+    * \brief Record of the elementary operations of an evaluation with Reverse numbers
+    *
+    *  Each node has at most two parents and stores its partial derivatives with respect to them. The tape of the current thread
+    *  is activated by a TapeScope
+    */
+   template <typename T>
+   class Tape {
+   public:
+      static constexpr size_t NO_NODE = std::numeric_limits<size_t>::max();
+
+      size_t record(size_t first_parent, const T& first_derivative, size_t second_parent, const T& second_derivative) {
+         this->nodes.push_back({{first_parent, second_parent}, {first_derivative, second_derivative}});
+         return this->nodes.size() - 1;
+      }
+      [[nodiscard]] size_t size() const { return this->nodes.size(); }
+      void clear() { this->nodes.clear(); }
+
+      // adjoints contains the seeds of the nodes (at least size() entries). The adjoints are propagated from the last node to the first
+      void propagate(std::vector<T>& adjoints) const {
+         for (size_t node_index = this->nodes.size(); 0 < node_index--;) {
+            const Node& node = this->nodes[node_index];
+            for (size_t parent_index: {size_t(0), size_t(1)}) {
+               if (node.parents[parent_index] != NO_NODE) {
+                  adjoints[node.parents[parent_index]] += adjoints[node_index] * node.partial_derivatives[parent_index];
+               }
+            }
+         }
+      }
+
+      [[nodiscard]] static Tape& active() { return *Tape::active_tape; }
+
+   private:
+      struct Node {
+         size_t parents[2];
+         T partial_derivatives[2];
+      };
+      std::vector<Node> nodes{};
+      inline static thread_local Tape* active_tape{nullptr};
+
+      template <typename>
+      friend class TapeScope;
+   };
+
+   // RAII activation of a tape on the current thread. The tape is cleared
+   template <typename T>
+   class TapeScope {
+   public:
+      explicit TapeScope(Tape<T>& tape): previous_tape(Tape<T>::active_tape) {
+         tape.clear();
+         Tape<T>::active_tape = &tape;
+      }
+      ~TapeScope() { Tape<T>::active_tape = this->previous_tape; }
+      TapeScope(const TapeScope&) = delete;
+      TapeScope& operator=(const TapeScope&) = delete;
+
+   private:
+      Tape<T>* const previous_tape;
+   };
+
+   /*! \class Reverse
+    * \brief Reverse-mode (adjoint) number, recorded on the active tape
+    *
+    *  The constants are not recorded. With T = Dual<double>, the propagation of the adjoints along a tangent v yields the Hessian-vector
+    *  product (forward over reverse)
+    */
+   template <typename T>
+   class Reverse {
+   public:
+      using ValueType = T;
+      static constexpr size_t NO_NODE = Tape<T>::NO_NODE;
+      T value{};
+      size_t node{NO_NODE};
+
+      Reverse() = default;
+      template <typename Scalar, std::enable_if_t<std::is_arithmetic_v<Scalar>, int> = 0>
+      Reverse(Scalar value): value(value) { }
+      explicit Reverse(T value, size_t node = NO_NODE): value(std::move(value)), node(node) { }
+
+      // independent variable, recorded as a node without parents
+      static Reverse independent(const T& value) {
+         return Reverse(value, Tape<T>::active().record(NO_NODE, T(0.), NO_NODE, T(0.)));
+      }
+      static Reverse unary(const Reverse& a, const T& value, const T& derivative, Interaction /*interaction*/) {
+         if (a.node == NO_NODE) {
+            return Reverse(value);
+         }
+         return Reverse(value, Tape<T>::active().record(a.node, derivative, NO_NODE, T(0.)));
+      }
+      static Reverse binary(const Reverse& a, const Reverse& b, const T& value, const T& left_derivative, const T& right_derivative,
+            Interaction /*interaction*/) {
+         if (a.node == NO_NODE && b.node == NO_NODE) {
+            return Reverse(value);
+         }
+         return Reverse(value, Tape<T>::active().record(a.node, left_derivative, b.node, right_derivative));
+      }
+   };
+
+   /*! \class SparsityTracer
+    * \brief Number that records the variables it depends on
+    *
+    *  The value is evaluated along, so that the control flow of the function is that of the tracing point. The nonlinear interactions
+    *  of the variables are accumulated into the active Hessian pattern (pairs (i, j) with i <= j): the union over the operations is a
+    *  superset of the pattern of the Hessian of any function of the traced evaluation
+    */
+   class SparsityTracer {
+   public:
+      using ValueType = double;
+      double value{0.};
+      std::vector<size_t> dependencies{}; /*!< sorted indices of the variables */
+      bool nonlinear{false};
+
+      SparsityTracer() = default;
+      template <typename Scalar, std::enable_if_t<std::is_arithmetic_v<Scalar>, int> = 0>
+      SparsityTracer(Scalar value): value(static_cast<double>(value)) { }
+
+      static SparsityTracer independent(double value, size_t variable_index) {
+         SparsityTracer result(value);
+         result.dependencies.push_back(variable_index);
+         return result;
+      }
+      static SparsityTracer unary(const SparsityTracer& a, double value, double /*derivative*/, Interaction interaction) {
+         SparsityTracer result(value);
+         result.dependencies = a.dependencies;
+         result.nonlinear = a.nonlinear || (interaction != Interaction::NONE && !a.dependencies.empty());
+         if (interaction != Interaction::NONE) {
+            SparsityTracer::add_interactions(a.dependencies, a.dependencies);
+         }
+         return result;
+      }
+      static SparsityTracer binary(const SparsityTracer& a, const SparsityTracer& b, double value, double /*left_derivative*/,
+            double /*right_derivative*/, Interaction interaction) {
+         SparsityTracer result(value);
+         std::set_union(a.dependencies.cbegin(), a.dependencies.cend(), b.dependencies.cbegin(), b.dependencies.cend(),
+               std::back_inserter(result.dependencies));
+         result.nonlinear = a.nonlinear || b.nonlinear;
+         if (interaction == Interaction::CROSS) {
+            result.nonlinear = result.nonlinear || (!a.dependencies.empty() && !b.dependencies.empty());
+            SparsityTracer::add_interactions(a.dependencies, b.dependencies);
+         }
+         else if (interaction == Interaction::QUOTIENT) {
+            result.nonlinear = result.nonlinear || !b.dependencies.empty();
+            SparsityTracer::add_interactions(a.dependencies, b.dependencies);
+            SparsityTracer::add_interactions(b.dependencies, b.dependencies);
+         }
+         else if (interaction == Interaction::FULL) {
+            result.nonlinear = result.nonlinear || !result.dependencies.empty();
+            SparsityTracer::add_interactions(result.dependencies, result.dependencies);
+         }
+         return result;
+      }
+
+      // pattern into which the interactions are accumulated on the current thread (none if null)
+      inline static thread_local std::set<std::pair<size_t, size_t>>* hessian_pattern{nullptr};
+
+   private:
+      static void add_interactions(const std::vector<size_t>& first_variables, const std::vector<size_t>& second_variables) {
+         if (SparsityTracer::hessian_pattern == nullptr) {
+            return;
+         }
+         for (size_t first_variable: first_variables) {
+            for (size_t second_variable: second_variables) {
+               SparsityTracer::hessian_pattern->emplace(std::min(first_variable, second_variable), std::max(first_variable, second_variable));
+            }
+         }
+      }
+   };
+
+   template <typename Number>
+   struct IsADNumber: std::false_type { };
+   template <typename T>
+   struct IsADNumber<Dual<T>>: std::true_type { };
+   template <typename T>
+   struct IsADNumber<Reverse<T>>: std::true_type { };
+   template <>
+   struct IsADNumber<SparsityTracer>: std::true_type { };
+
+   template <typename Number>
+   using EnableIfADNumber = std::enable_if_t<IsADNumber<Number>::value, int>;
+   template <typename Number, typename Scalar>
+   using EnableIfMixed = std::enable_if_t<IsADNumber<Number>::value && std::is_arithmetic_v<Scalar>, int>;
+   template <typename Left, typename Right>
+   using EnableIfComparable = std::enable_if_t<(IsADNumber<Left>::value && (IsADNumber<Right>::value || std::is_arithmetic_v<Right>)) ||
+      (std::is_arithmetic_v<Left> && IsADNumber<Right>::value), int>;
+
+   // value of a (possibly nested) number
+   inline double primal_value(double value) {
+      return value;
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   double primal_value(const Number& number) {
+      return primal_value(number.value);
+   }
+
+   // arithmetic operators
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number operator+(const Number& a, const Number& b) {
+      using T = typename Number::ValueType;
+      return Number::binary(a, b, a.value + b.value, T(1.), T(1.), Interaction::NONE);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number operator-(const Number& a, const Number& b) {
+      using T = typename Number::ValueType;
+      return Number::binary(a, b, a.value - b.value, T(1.), T(-1.), Interaction::NONE);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number operator*(const Number& a, const Number& b) {
+      return Number::binary(a, b, a.value * b.value, b.value, a.value, Interaction::CROSS);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number operator/(const Number& a, const Number& b) {
+      using T = typename Number::ValueType;
+      const T value = a.value / b.value;
+      return Number::binary(a, b, value, T(1.) / b.value, -value / b.value, Interaction::QUOTIENT);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number operator-(const Number& a) {
+      using T = typename Number::ValueType;
+      return Number::unary(a, -a.value, T(-1.), Interaction::NONE);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number operator+(const Number& a) {
+      return a;
+   }
+
+   // operations with constants
+   template <typename Number, typename Scalar, EnableIfMixed<Number, Scalar> = 0>
+   Number operator+(const Number& a, Scalar b) { return a + Number(b); }
+   template <typename Number, typename Scalar, EnableIfMixed<Number, Scalar> = 0>
+   Number operator+(Scalar a, const Number& b) { return Number(a) + b; }
+   template <typename Number, typename Scalar, EnableIfMixed<Number, Scalar> = 0>
+   Number operator-(const Number& a, Scalar b) { return a - Number(b); }
+   template <typename Number, typename Scalar, EnableIfMixed<Number, Scalar> = 0>
+   Number operator-(Scalar a, const Number& b) { return Number(a) - b; }
+   template <typename Number, typename Scalar, EnableIfMixed<Number, Scalar> = 0>
+   Number operator*(const Number& a, Scalar b) { return a * Number(b); }
+   template <typename Number, typename Scalar, EnableIfMixed<Number, Scalar> = 0>
+   Number operator*(Scalar a, const Number& b) { return Number(a) * b; }
+   template <typename Number, typename Scalar, EnableIfMixed<Number, Scalar> = 0>
+   Number operator/(const Number& a, Scalar b) { return a / Number(b); }
+   template <typename Number, typename Scalar, EnableIfMixed<Number, Scalar> = 0>
+   Number operator/(Scalar a, const Number& b) { return Number(a) / b; }
+
+   // compound assignments
+   template <typename Number, typename Other, EnableIfADNumber<Number> = 0>
+   Number& operator+=(Number& a, const Other& b) { a = a + b; return a; }
+   template <typename Number, typename Other, EnableIfADNumber<Number> = 0>
+   Number& operator-=(Number& a, const Other& b) { a = a - b; return a; }
+   template <typename Number, typename Other, EnableIfADNumber<Number> = 0>
+   Number& operator*=(Number& a, const Other& b) { a = a * b; return a; }
+   template <typename Number, typename Other, EnableIfADNumber<Number> = 0>
+   Number& operator/=(Number& a, const Other& b) { a = a / b; return a; }
+
+   // comparisons (of the values): the control flow is not differentiated
+   template <typename Left, typename Right, EnableIfComparable<Left, Right> = 0>
+   bool operator<(const Left& a, const Right& b) { return primal_value(a) < primal_value(b); }
+   template <typename Left, typename Right, EnableIfComparable<Left, Right> = 0>
+   bool operator<=(const Left& a, const Right& b) { return primal_value(a) <= primal_value(b); }
+   template <typename Left, typename Right, EnableIfComparable<Left, Right> = 0>
+   bool operator>(const Left& a, const Right& b) { return primal_value(a) > primal_value(b); }
+   template <typename Left, typename Right, EnableIfComparable<Left, Right> = 0>
+   bool operator>=(const Left& a, const Right& b) { return primal_value(a) >= primal_value(b); }
+   template <typename Left, typename Right, EnableIfComparable<Left, Right> = 0>
+   bool operator==(const Left& a, const Right& b) { return primal_value(a) == primal_value(b); }
+   template <typename Left, typename Right, EnableIfComparable<Left, Right> = 0>
+   bool operator!=(const Left& a, const Right& b) { return primal_value(a) != primal_value(b); }
+
+   // elementary functions. The functions of the values are found by argument-dependent lookup for the nested numbers
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number sqrt(const Number& a) {
+      using std::sqrt;
+      const auto value = sqrt(a.value);
+      return Number::unary(a, value, 0.5 / value, Interaction::FULL);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number exp(const Number& a) {
+      using std::exp;
+      const auto value = exp(a.value);
+      return Number::unary(a, value, value, Interaction::FULL);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number log(const Number& a) {
+      using std::log;
+      return Number::unary(a, log(a.value), 1. / a.value, Interaction::FULL);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number sin(const Number& a) {
+      using std::sin, std::cos;
+      return Number::unary(a, sin(a.value), cos(a.value), Interaction::FULL);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number cos(const Number& a) {
+      using std::sin, std::cos;
+      return Number::unary(a, cos(a.value), -sin(a.value), Interaction::FULL);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number tan(const Number& a) {
+      using std::tan;
+      const auto value = tan(a.value);
+      return Number::unary(a, value, 1. + value * value, Interaction::FULL);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number atan(const Number& a) {
+      using std::atan;
+      return Number::unary(a, atan(a.value), 1. / (1. + a.value * a.value), Interaction::FULL);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number tanh(const Number& a) {
+      using std::tanh;
+      const auto value = tanh(a.value);
+      return Number::unary(a, value, 1. - value * value, Interaction::FULL);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number abs(const Number& a) {
+      using std::abs;
+      using T = typename Number::ValueType;
+      return Number::unary(a, abs(a.value), (0. <= primal_value(a)) ? T(1.) : T(-1.), Interaction::NONE);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number fabs(const Number& a) {
+      return abs(a);
+   }
+
+   template <typename Number, typename Scalar, EnableIfMixed<Number, Scalar> = 0>
+   Number pow(const Number& a, Scalar exponent) {
+      using std::pow;
+      const double constant_exponent = static_cast<double>(exponent);
+      return Number::unary(a, pow(a.value, constant_exponent), constant_exponent * pow(a.value, constant_exponent - 1.),
+            (constant_exponent == 1.) ? Interaction::NONE : Interaction::FULL);
+   }
+
+   template <typename Number, EnableIfADNumber<Number> = 0>
+   Number pow(const Number& a, const Number& b) {
+      using std::pow, std::log;
+      const auto value = pow(a.value, b.value);
+      // the derivative with respect to the exponent is only defined for a positive base
+      const auto right_derivative = (0. < primal_value(a)) ? value * log(a.value) : typename Number::ValueType(0.);
+      return Number::binary(a, b, value, b.value * pow(a.value, b.value - 1.), right_derivative, Interaction::FULL);
+   }
+} // namespace
+
+#endif // UNO_AUTOMATICDIFFERENTIATION_H
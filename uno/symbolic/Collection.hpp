@@ -49,7 +49,46 @@ namespace uno {
 
       [[nodiscard]] virtual ElementType dereference_iterator(size_t index) const = 0;
       virtual void increment_iterator(size_t& index) const = 0;
+
+      // traversal of the runs [first, last) of consecutive elements: a single virtual call per run. By default, the runs are
+      // recovered from the elements
+      virtual void for_each_run(const std::function<void(ElementType /*first*/, ElementType /*last*/)>& function) const;
+      // traversal of the elements: plain counted loops over the runs
+      template <typename Function>
+      void for_each(const Function& function) const;
    };
+
+   template <typename ElementType>
+   void Collection<ElementType>::for_each_run(const std::function<void(ElementType, ElementType)>& function) const {
+      bool is_run_open = false;
+      ElementType first{}, last{};
+      for (const ElementType element: *this) {
+         if (is_run_open && element == last) {
+            ++last;
+         }
+         else {
+            if (is_run_open) {
+               function(first, last);
+            }
+            first = last = element;
+            ++last;
+            is_run_open = true;
+         }
+      }
+      if (is_run_open) {
+         function(first, last);
+      }
+   }
+
+   template <typename ElementType>
+   template <typename Function>
+   void Collection<ElementType>::for_each(const Function& function) const {
+      this->for_each_run([&](ElementType first, ElementType last) {
+         for (ElementType element = first; element < last; ++element) {
+            function(element);
+         }
+      });
+   }
 } // namespace
 
 #endif // UNO_COLLECTION_H
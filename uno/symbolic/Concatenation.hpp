@@ -29,9 +29,14 @@ namespace uno {
          index++;
       }
 
+      void for_each_run(const std::function<void(typename Concatenation::value_type, typename Concatenation::value_type)>& function) const override {
+         this->collection1.for_each_run(function);
+         this->collection2.for_each_run(function);
+      }
+
    protected:
-      const Collection1 collection1;
-      const Collection2 collection2;
+      Collection1 collection1;
+      Collection2 collection2;
    };
 
    template <typename Collection1, typename Collection2>
@@ -0,0 +1,98 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_INDEXSET_H
+#define UNO_INDEXSET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "Collection.hpp"
+
+namespace uno {
+   /*! \class IndexSet
+    * \brief Sequence of indices compressed into runs [first, last) of consecutive indices
+    *
+    *  The indices keep their insertion order. Contiguous sets (e.g. all the slacks or all the constraints) are stored as a single
+    *  run, and for_each traverses each run with a counted loop
+    */
+   class IndexSet: public Collection<size_t> {
+   public:
+      using value_type = size_t;
+
+      IndexSet() = default;
+      // compressed copy of a collection
+      explicit IndexSet(const Collection<size_t>& collection);
+
+      // appends an index (merged into the last run if they are consecutive)
+      void insert(size_t index);
+      // appends the indices first, ..., last-1
+      void insert(size_t first, size_t last);
+      void clear();
+
+      [[nodiscard]] size_t size() const override { return this->number_indices; }
+      [[nodiscard]] size_t number_runs() const { return this->runs.size(); }
+
+      [[nodiscard]] size_t dereference_iterator(size_t index) const override;
+      void increment_iterator(size_t& index) const override;
+      void for_each_run(const std::function<void(size_t, size_t)>& function) const override;
+
+   protected:
+      struct Run {
+         size_t first;
+         size_t last;
+         size_t offset; /*!< number of indices in the previous runs */
+      };
+      std::vector<Run> runs{};
+      size_t number_indices{0};
+   };
+
+   inline IndexSet::IndexSet(const Collection<size_t>& collection): Collection<size_t>() {
+      collection.for_each_run([&](size_t first, size_t last) {
+         this->insert(first, last);
+      });
+   }
+
+   inline void IndexSet::insert(size_t index) {
+      this->insert(index, index + 1);
+   }
+
+   inline void IndexSet::insert(size_t first, size_t last) {
+      if (last <= first) {
+         return;
+      }
+      if (!this->runs.empty() && this->runs.back().last == first) {
+         this->runs.back().last = last;
+      }
+      else {
+         this->runs.push_back({first, last, this->number_indices});
+      }
+      this->number_indices += last - first;
+   }
+
+   inline void IndexSet::clear() {
+      this->runs.clear();
+      this->number_indices = 0;
+   }
+
+   // the run that contains the position is found by bisection
+   inline size_t IndexSet::dereference_iterator(size_t index) const {
+      const auto run = std::upper_bound(this->runs.begin(), this->runs.end(), index, [](size_t position, const Run& current_run) {
+         return position < current_run.offset;
+      }) - 1;
+      return run->first + (index - run->offset);
+   }
+
+   inline void IndexSet::increment_iterator(size_t& index) const {
+      index++;
+   }
+
+   inline void IndexSet::for_each_run(const std::function<void(size_t, size_t)>& function) const {
+      for (const Run& run: this->runs) {
+         function(run.first, run.last);
+      }
+   }
+} // namespace
+
+#endif // UNO_INDEXSET_H
@@ -27,6 +27,7 @@ namespace uno {
 
       [[nodiscard]] size_t dereference_iterator(size_t index) const override;
       void increment_iterator(size_t& index) const override;
+      void for_each_run(const std::function<void(size_t, size_t)>& function) const override;
 
    protected:
       const size_t start_value;
@@ -73,6 +74,19 @@ namespace uno {
       index++;
    }
 
+   // a forward range is a single run. The elements of a backward range are decreasing: each one is a run
+   template <RangeDirection direction>
+   void Range<direction>::for_each_run(const std::function<void(size_t, size_t)>& function) const {
+      if constexpr (direction == FORWARD) {
+         if (this->start_value < this->end_value) {
+            function(this->start_value, this->end_value);
+         }
+      }
+      else {
+         Collection<size_t>::for_each_run(function);
+      }
+   }
+
    using ForwardRange = Range<FORWARD>;
    using BackwardRange = Range<BACKWARD>;
 } // namespace
@@ -4,6 +4,8 @@
 #ifndef UNO_SCALARMULTIPLE_H
 #define UNO_SCALARMULTIPLE_H
 
+#include "StridedSpan.hpp"
+
 namespace uno {
    // stores the expression (factor * expression) symbolically
    template <typename Expression>
@@ -18,6 +20,11 @@ namespace uno {
          return (this->factor == value_type(0)) ? value_type(0) : this->factor * this->expression[index];
       }
 
+      // lowered expression (see StridedSpan.hpp)
+      [[nodiscard]] ScalarMultiple<strided_block_t<Expression>> block() const {
+         return {this->factor, strided_block(this->expression)};
+      }
+
    protected:
       const value_type factor;
       Expression expression;
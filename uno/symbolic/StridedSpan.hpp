@@ -0,0 +1,67 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_STRIDEDSPAN_H
+#define UNO_STRIDEDSPAN_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace uno {
+   // non-owning view of the elements pointer[0], pointer[Stride], pointer[2*Stride], ...
+   // The stride is known at compile time, so that unit-stride spans are evaluated with contiguous (vectorizable) loads
+   template <typename ElementType, size_t Stride = 1>
+   class StridedSpan {
+   public:
+      using value_type = std::remove_const_t<ElementType>;
+
+      StridedSpan(ElementType* pointer, size_t size): pointer(pointer), length(size) { }
+
+      [[nodiscard]] size_t size() const { return this->length; }
+      [[nodiscard]] value_type operator[](size_t index) const { return this->pointer[index * Stride]; }
+
+      [[nodiscard]] StridedSpan<ElementType, Stride> subspan(size_t start, size_t end) const {
+         return {this->pointer + start * Stride, end - start};
+      }
+
+   protected:
+      ElementType* const pointer;
+      const size_t length;
+   };
+
+   template <typename Expression>
+   struct is_strided_span: std::false_type { };
+   template <typename ElementType, size_t Stride>
+   struct is_strided_span<StridedSpan<ElementType, Stride>>: std::true_type { };
+
+   // detects the expressions that expose a block() member function
+   template <typename Expression, typename = void>
+   struct has_block: std::false_type { };
+   template <typename Expression>
+   struct has_block<Expression, std::void_t<decltype(std::declval<const Expression&>().block())>>: std::true_type { };
+
+   // strided_block(expression) lowers an expression into an equivalent expression whose leaves (dense arrays) are replaced with
+   // strided spans over their raw storage. The evaluation of the block is then a single fused loop over pointers.
+   // Expressions that cannot be lowered (e.g. std::function-based or sparse expressions) are returned by reference
+   template <typename Expression>
+   decltype(auto) strided_block(const Expression& expression) {
+      if constexpr (has_block<Expression>::value) {
+         return expression.block();
+      }
+      else {
+         return (expression);
+      }
+   }
+
+   template <typename ElementType, typename Allocator>
+   StridedSpan<const ElementType> strided_block(const std::vector<ElementType, Allocator>& vector) {
+      return {vector.data(), vector.size()};
+   }
+
+   // type of the lowered expression
+   template <typename Expression>
+   using strided_block_t = decltype(strided_block(std::declval<const std::remove_reference_t<Expression>&>()));
+} // namespace
+
+#endif // UNO_STRIDEDSPAN_H
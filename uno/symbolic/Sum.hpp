@@ -4,6 +4,8 @@
 #ifndef UNO_SUM_H
 #define UNO_SUM_H
 
+#include "StridedSpan.hpp"
+
 namespace uno {
    // stores the expression (expression1 + expression2) symbolically
    // limited to types that possess value_type
@@ -19,9 +21,14 @@ namespace uno {
       [[nodiscard]] constexpr size_t size() const { return this->expression1.size(); }
       [[nodiscard]] typename Sum::value_type operator[](size_t index) const { return this->expression1[index] + this->expression2[index]; }
 
+      // lowered expression (see StridedSpan.hpp)
+      [[nodiscard]] Sum<strided_block_t<E1>, strided_block_t<E2>> block() const {
+         return {strided_block(this->expression1), strided_block(this->expression2)};
+      }
+
    protected:
-      const E1 expression1;
-      const E2 expression2;
+      E1 expression1;
+      E2 expression2;
    };
 
    // free function
@@ -4,6 +4,8 @@
 #ifndef UNO_UNARYNEGATION_H
 #define UNO_UNARYNEGATION_H
 
+#include "StridedSpan.hpp"
+
 namespace uno {
    // stores the expression -expression symbolically
    // limited to types that possess value_type
@@ -18,6 +20,11 @@ namespace uno {
       [[nodiscard]] constexpr size_t size() const { return this->expression.size(); }
       [[nodiscard]] typename UnaryNegation::value_type operator[](size_t index) const { return -this->expression[index]; }
 
+      // lowered expression (see StridedSpan.hpp)
+      [[nodiscard]] UnaryNegation<strided_block_t<Expression>> block() const {
+         return UnaryNegation<strided_block_t<Expression>>(strided_block(this->expression));
+      }
+
    protected:
       Expression expression;
    };
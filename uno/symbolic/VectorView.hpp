@@ -4,6 +4,8 @@
 #ifndef UNO_VECTORVIEW_H
 #define UNO_VECTORVIEW_H
 
+#include "StridedSpan.hpp"
+
 namespace uno {
    // span of an arbitrary container: allocation-free view of a certain length
    template <typename Expression>
@@ -44,6 +46,16 @@ namespace uno {
       [[nodiscard]] value_type operator[](size_t index) const noexcept { return this->expression[this->start + index]; }
       [[nodiscard]] size_t size() const noexcept { return this->end - this->start; }
 
+      // lowered expression (see StridedSpan.hpp): a view of a span is a subspan
+      [[nodiscard]] decltype(auto) block() const {
+         if constexpr (is_strided_span<strided_block_t<Expression>>::value) {
+            return strided_block(this->expression).subspan(this->start, this->end);
+         }
+         else {
+            return (*this);
+         }
+      }
+
       // [[nodiscard]] iterator begin() const noexcept { return iterator(*this, 0); }
       // [[nodiscard]] iterator end() const noexcept { return iterator(*this, this->length); }
 
@@ -0,0 +1,173 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include "AllocationTracker.hpp"
+#ifdef UNO_ALLOCATION_TRACKING
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace uno {
+   namespace {
+      // trivially initialized: safe to access from operator new
+      thread_local AllocationCounters* installed_counters{nullptr};
+      thread_local bool allocations_forbidden{false};
+   } // namespace
+
+   AllocationTracker::Scope::Scope(AllocationCounters& counters): previous_counters(installed_counters) {
+      installed_counters = &counters;
+   }
+
+   AllocationTracker::Scope::~Scope() {
+      installed_counters = this->previous_counters;
+   }
+
+   AllocationTracker::Prohibition::Prohibition(bool forbid_allocations): previously_forbidden(allocations_forbidden) {
+      allocations_forbidden = forbid_allocations;
+   }
+
+   AllocationTracker::Prohibition::~Prohibition() {
+      allocations_forbidden = this->previously_forbidden;
+   }
+
+#ifdef UNO_ALLOCATION_TRACKING
+   namespace {
+      void record_allocation(std::size_t size) {
+         if (installed_counters != nullptr) {
+            installed_counters->allocations++;
+            installed_counters->bytes += size;
+         }
+         if (allocations_forbidden) {
+            // the message itself must not allocate
+            allocations_forbidden = false;
+            std::fprintf(stderr, "Uno: forbidden heap allocation of %zu bytes\n", size);
+            std::abort();
+         }
+      }
+
+      void* allocate(std::size_t size) {
+         record_allocation(size);
+         void* pointer;
+         while ((pointer = std::malloc((size == 0) ? 1 : size)) == nullptr) {
+            const std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr) {
+               throw std::bad_alloc();
+            }
+            handler();
+         }
+         return pointer;
+      }
+
+      void* allocate(std::size_t size, std::align_val_t alignment) {
+         record_allocation(size);
+         const auto alignment_size = static_cast<std::size_t>(alignment);
+         // the size of std::aligned_alloc is a multiple of the alignment
+         const std::size_t aligned_size = ((size == 0 ? 1 : size) + alignment_size - 1) / alignment_size * alignment_size;
+         void* pointer;
+         while ((pointer = std::aligned_alloc(alignment_size, aligned_size)) == nullptr) {
+            const std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr) {
+               throw std::bad_alloc();
+            }
+            handler();
+         }
+         return pointer;
+      }
+
+      template <typename Allocation>
+      void* allocate_nothrow(const Allocation& allocation) noexcept {
+         try {
+            return allocation();
+         }
+         catch (const std::bad_alloc&) {
+            return nullptr;
+         }
+      }
+   } // namespace
+#endif
+} // namespace
+
+#ifdef UNO_ALLOCATION_TRACKING
+// replacements of the global allocation and deallocation functions
+
+void* operator new(std::size_t size) {
+   return uno::allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+   return uno::allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+   return uno::allocate_nothrow([=]() { return uno::allocate(size); });
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+   return uno::allocate_nothrow([=]() { return uno::allocate(size); });
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+   return uno::allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+   return uno::allocate(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t& /*tag*/) noexcept {
+   return uno::allocate_nothrow([=]() { return uno::allocate(size, alignment); });
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& /*tag*/) noexcept {
+   return uno::allocate_nothrow([=]() { return uno::allocate(size, alignment); });
+}
+
+void operator delete(void* pointer) noexcept {
+   std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+   std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept {
+   std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t /*size*/) noexcept {
+   std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t& /*tag*/) noexcept {
+   std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t& /*tag*/) noexcept {
+   std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t /*alignment*/) noexcept {
+   std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t /*alignment*/) noexcept {
+   std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+   std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+   std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t /*alignment*/, const std::nothrow_t& /*tag*/) noexcept {
+   std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t /*alignment*/, const std::nothrow_t& /*tag*/) noexcept {
+   std::free(pointer);
+}
+#endif
@@ -0,0 +1,58 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_ALLOCATIONTRACKER_H
+#define UNO_ALLOCATIONTRACKER_H
+
+#include <cstddef>
+
+namespace uno {
+   // heap allocations (calls to the global operator new) and allocated bytes
+   struct AllocationCounters {
+      size_t allocations{0};
+      size_t bytes{0};
+   };
+
+   /*! \class AllocationTracker
+    * \brief Instrumentation of the heap allocations
+    *
+    *  When Uno is built with WITH_ALLOCATION_TRACKING, the global operator new is replaced: the allocations of a thread are counted
+    *  in the counters installed on the thread (see Scope), and an allocation on a thread where the allocations are forbidden (see
+    *  Prohibition) aborts the program with a message, at the allocation site (a debugger then shows the culprit).
+    *  Otherwise, the counters remain zero and the prohibitions have no effect
+    */
+   class AllocationTracker {
+   public:
+#ifdef UNO_ALLOCATION_TRACKING
+      static constexpr bool is_enabled{true};
+#else
+      static constexpr bool is_enabled{false};
+#endif
+
+      // installs counters on the calling thread and restores the previous ones upon destruction
+      class Scope {
+      public:
+         explicit Scope(AllocationCounters& counters);
+         ~Scope();
+         Scope(const Scope&) = delete;
+         Scope& operator=(const Scope&) = delete;
+
+      private:
+         AllocationCounters* const previous_counters;
+      };
+
+      // forbids (or allows) the allocations on the calling thread and restores the previous state upon destruction
+      class Prohibition {
+      public:
+         explicit Prohibition(bool forbid_allocations);
+         ~Prohibition();
+         Prohibition(const Prohibition&) = delete;
+         Prohibition& operator=(const Prohibition&) = delete;
+
+      private:
+         const bool previously_forbidden;
+      };
+   };
+} // namespace
+
+#endif // UNO_ALLOCATIONTRACKER_H
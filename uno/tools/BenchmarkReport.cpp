@@ -0,0 +1,312 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include "BenchmarkReport.hpp"
+#include "optimization/IterateStatus.hpp"
+#include "optimization/OptimizationStatus.hpp"
+#include "optimization/Result.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   namespace {
+      const std::string header = "model,configuration,optimization_status,iterate_status,solved,iterations,evaluations,factorizations,wall_time";
+      constexpr size_t number_fields = 9;
+
+      // the fields of a record cannot contain the CSV delimiter
+      std::string sanitize(std::string field) {
+         std::replace_if(field.begin(), field.end(), [](char character) {
+            return character == ',' || character == '\n' || character == '\r';
+         }, ' ');
+         return field;
+      }
+
+      std::string key(const BenchmarkRecord& record) {
+         return record.model + "/" + record.configuration;
+      }
+
+      double metric_floor(BenchmarkMetric metric) {
+         return (metric == BenchmarkMetric::WALL_TIME) ? 1e-3 : 1.;
+      }
+
+      std::string escape_json(const std::string& value) {
+         std::string escaped_value{};
+         for (char character: value) {
+            if (character == '"' || character == '\\') {
+               escaped_value += '\\';
+            }
+            escaped_value += character;
+         }
+         return escaped_value;
+      }
+
+      void write_json_strings(std::ostream& stream, const std::vector<std::string>& values) {
+         stream << '[';
+         for (size_t index = 0; index < values.size(); index++) {
+            stream << ((index == 0) ? "" : ", ") << '"' << escape_json(values[index]) << '"';
+         }
+         stream << ']';
+      }
+   } // namespace
+
+   // record
+
+   BenchmarkRecord BenchmarkRecord::from_result(const std::string& model, const std::string& configuration, const Result& result) {
+      const bool solved = (result.optimization_status == OptimizationStatus::SUCCESS &&
+         result.solution.status == IterateStatus::FEASIBLE_KKT_POINT);
+      const size_t evaluations = result.objective_evaluations + result.constraint_evaluations + result.objective_gradient_evaluations +
+         result.jacobian_evaluations + result.hessian_evaluations;
+      return {model, configuration, optimization_status_to_message(result.optimization_status),
+         iterate_status_to_message(result.solution.status), solved, result.iteration, evaluations, result.number_factorizations,
+         result.solve_time};
+   }
+
+   BenchmarkRecord BenchmarkRecord::from_error(const std::string& model, const std::string& configuration, const std::string& error,
+         double wall_time) {
+      return {model, configuration, "Error", error, false, 0, 0, 0, wall_time};
+   }
+
+   std::string BenchmarkRecord::to_csv() const {
+      std::ostringstream stream;
+      stream << sanitize(this->model) << ',' << sanitize(this->configuration) << ',' << sanitize(this->optimization_status) << ',' <<
+         sanitize(this->iterate_status) << ',' << (this->solved ? 1 : 0) << ',' << this->iterations << ',' << this->evaluations << ',' <<
+         this->factorizations << ',' << std::setprecision(9) << this->wall_time;
+      return stream.str();
+   }
+
+   BenchmarkRecord BenchmarkRecord::from_csv(const std::string& line) {
+      std::vector<std::string> fields{};
+      std::istringstream stream(line);
+      std::string field;
+      while (std::getline(stream, field, ',')) {
+         fields.emplace_back(field);
+      }
+      if (fields.size() != number_fields) {
+         throw std::runtime_error("The benchmark record \"" + line + "\" should have " + std::to_string(number_fields) + " fields");
+      }
+      try {
+         return {fields[0], fields[1], fields[2], fields[3], (fields[4] == "1"), std::stoul(fields[5]), std::stoul(fields[6]),
+            std::stoul(fields[7]), std::stod(fields[8])};
+      }
+      catch (const std::logic_error&) {
+         throw std::runtime_error("The benchmark record \"" + line + "\" has a non-numerical value");
+      }
+   }
+
+   std::string benchmark_metric_to_string(BenchmarkMetric metric) {
+      switch (metric) {
+         case BenchmarkMetric::ITERATIONS:
+            return "iterations";
+         case BenchmarkMetric::EVALUATIONS:
+            return "evaluations";
+         case BenchmarkMetric::FACTORIZATIONS:
+            return "factorizations";
+         default:
+            return "wall_time";
+      }
+   }
+
+   BenchmarkMetric benchmark_metric_from_string(const std::string& metric) {
+      for (BenchmarkMetric benchmark_metric: benchmark_metrics) {
+         if (benchmark_metric_to_string(benchmark_metric) == metric) {
+            return benchmark_metric;
+         }
+      }
+      throw std::invalid_argument("The benchmark metric " + metric + " is unknown (iterations|evaluations|factorizations|wall_time)");
+   }
+
+   double benchmark_metric_value(const BenchmarkRecord& record, BenchmarkMetric metric) {
+      switch (metric) {
+         case BenchmarkMetric::ITERATIONS:
+            return static_cast<double>(record.iterations);
+         case BenchmarkMetric::EVALUATIONS:
+            return static_cast<double>(record.evaluations);
+         case BenchmarkMetric::FACTORIZATIONS:
+            return static_cast<double>(record.factorizations);
+         default:
+            return record.wall_time;
+      }
+   }
+
+   // regression report
+
+   size_t RegressionReport::number_regressions() const {
+      return static_cast<size_t>(std::count_if(this->changes.cbegin(), this->changes.cend(), [](const BenchmarkChange& change) {
+         return change.is_regression;
+      }));
+   }
+
+   size_t RegressionReport::number_improvements() const {
+      return this->changes.size() - this->number_regressions();
+   }
+
+   void RegressionReport::write_json(std::ostream& stream) const {
+      stream << "{\n";
+      stream << "  \"compared\": " << this->number_compared_records << ",\n";
+      stream << "  \"regressions\": " << this->number_regressions() << ",\n";
+      stream << "  \"improvements\": " << this->number_improvements() << ",\n";
+      stream << "  \"missing\": ";
+      write_json_strings(stream, this->missing_records);
+      stream << ",\n  \"new\": ";
+      write_json_strings(stream, this->new_records);
+      stream << ",\n  \"changes\": [";
+      for (size_t index = 0; index < this->changes.size(); index++) {
+         const BenchmarkChange& change = this->changes[index];
+         stream << ((index == 0) ? "\n" : ",\n") << "    {\"model\": \"" << escape_json(change.model) << "\", \"configuration\": \"" <<
+            escape_json(change.configuration) << "\", \"measure\": \"" << change.measure << "\", \"baseline\": " <<
+            std::setprecision(9) << change.baseline_value << ", \"current\": " << change.current_value << ", \"change\": \"" <<
+            (change.is_regression ? "regression" : "improvement") << "\"}";
+      }
+      stream << (this->changes.empty() ? "]\n" : "\n  ]\n") << "}\n";
+   }
+
+   // report
+
+   void BenchmarkReport::add(BenchmarkRecord record) {
+      this->records.emplace_back(std::move(record));
+   }
+
+   void BenchmarkReport::write(std::ostream& stream) const {
+      stream << header << '\n';
+      for (const BenchmarkRecord& record: this->records) {
+         stream << record.to_csv() << '\n';
+      }
+   }
+
+   BenchmarkReport BenchmarkReport::read(std::istream& stream) {
+      std::string line;
+      if (!std::getline(stream, line) || line != header) {
+         throw std::runtime_error("The benchmark report does not start with the header " + header);
+      }
+      BenchmarkReport report{};
+      while (std::getline(stream, line)) {
+         if (!line.empty()) {
+            report.add(BenchmarkRecord::from_csv(line));
+         }
+      }
+      return report;
+   }
+
+   std::vector<PerformanceProfile> BenchmarkReport::compute_performance_profiles(BenchmarkMetric metric) const {
+      // models and configurations in order of appearance
+      std::vector<std::string> models{}, configurations{};
+      std::map<std::pair<std::string, std::string>, double> values{};
+      for (const BenchmarkRecord& record: this->records) {
+         if (std::find(models.cbegin(), models.cend(), record.model) == models.cend()) {
+            models.emplace_back(record.model);
+         }
+         if (std::find(configurations.cbegin(), configurations.cend(), record.configuration) == configurations.cend()) {
+            configurations.emplace_back(record.configuration);
+         }
+         values[{record.model, record.configuration}] = record.solved ?
+            std::max(benchmark_metric_value(record, metric), metric_floor(metric)) : INF<double>;
+      }
+      const auto value = [&](const std::string& model, const std::string& configuration) {
+         const auto iterator = values.find({model, configuration});
+         return (iterator != values.cend()) ? iterator->second : INF<double>;
+      };
+
+      // best value on each model
+      std::map<std::string, double> best_values{};
+      for (const std::string& model: models) {
+         double best_value = INF<double>;
+         for (const std::string& configuration: configurations) {
+            best_value = std::min(best_value, value(model, configuration));
+         }
+         best_values[model] = best_value;
+      }
+
+      std::vector<PerformanceProfile> profiles{};
+      for (const std::string& configuration: configurations) {
+         std::vector<double> ratios{};
+         for (const std::string& model: models) {
+            const double model_value = value(model, configuration);
+            if (is_finite(model_value)) {
+               ratios.emplace_back(model_value / best_values[model]);
+            }
+         }
+         std::sort(ratios.begin(), ratios.end());
+         PerformanceProfile profile{configuration};
+         for (size_t index = 0; index < ratios.size(); index++) {
+            // one breakpoint per distinct ratio
+            if (index + 1 == ratios.size() || ratios[index] < ratios[index + 1]) {
+               profile.breakpoints.emplace_back(ratios[index], static_cast<double>(index + 1) / static_cast<double>(models.size()));
+            }
+         }
+         profiles.emplace_back(std::move(profile));
+      }
+      return profiles;
+   }
+
+   void BenchmarkReport::write_performance_profiles(std::ostream& stream) const {
+      stream << "metric,configuration,tau,fraction\n";
+      for (BenchmarkMetric metric: benchmark_metrics) {
+         for (const PerformanceProfile& profile: this->compute_performance_profiles(metric)) {
+            for (const auto& [tau, fraction]: profile.breakpoints) {
+               stream << benchmark_metric_to_string(metric) << ',' << sanitize(profile.configuration) << ',' << std::setprecision(9) <<
+                  tau << ',' << fraction << '\n';
+            }
+         }
+      }
+   }
+
+   RegressionReport BenchmarkReport::compare(const BenchmarkReport& baseline, const RegressionTolerances& tolerances) const {
+      std::map<std::string, const BenchmarkRecord*> baseline_records{};
+      for (const BenchmarkRecord& record: baseline.records) {
+         baseline_records[key(record)] = &record;
+      }
+      RegressionReport report{};
+      std::map<std::string, bool> is_compared{};
+      for (const BenchmarkRecord& record: this->records) {
+         const auto iterator = baseline_records.find(key(record));
+         if (iterator == baseline_records.cend()) {
+            report.new_records.emplace_back(key(record));
+            continue;
+         }
+         const BenchmarkRecord& baseline_record = *iterator->second;
+         is_compared[key(record)] = true;
+         report.number_compared_records++;
+         if (record.solved != baseline_record.solved) {
+            report.changes.push_back({record.model, record.configuration, "solved", baseline_record.solved ? 1. : 0., record.solved ? 1. : 0.,
+               baseline_record.solved});
+            continue;
+         }
+         // the metrics of unsolved models are not meaningful
+         if (!record.solved) {
+            continue;
+         }
+         for (BenchmarkMetric metric: benchmark_metrics) {
+            const double baseline_value = benchmark_metric_value(baseline_record, metric);
+            const double current_value = benchmark_metric_value(record, metric);
+            double relative_change;
+            double relative_tolerance;
+            if (metric == BenchmarkMetric::WALL_TIME) {
+               if (std::max(baseline_value, current_value) < tolerances.minimum_time) {
+                  continue;
+               }
+               relative_change = (current_value - baseline_value) / std::max(baseline_value, tolerances.minimum_time);
+               relative_tolerance = tolerances.relative_time_tolerance;
+            }
+            else {
+               relative_change = (current_value - baseline_value) / std::max(baseline_value, 1.);
+               relative_tolerance = tolerances.relative_count_tolerance;
+            }
+            if (relative_tolerance < std::abs(relative_change)) {
+               report.changes.push_back({record.model, record.configuration, benchmark_metric_to_string(metric), baseline_value, current_value,
+                  0. < relative_change});
+            }
+         }
+      }
+      for (const auto& [record_key, baseline_record]: baseline_records) {
+         if (!is_compared[record_key]) {
+            report.missing_records.emplace_back(record_key);
+         }
+      }
+      return report;
+   }
+} // namespace
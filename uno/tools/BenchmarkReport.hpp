@@ -0,0 +1,112 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BENCHMARKREPORT_H
+#define UNO_BENCHMARKREPORT_H
+
+#include <array>
+#include <ostream>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace uno {
+   // forward declaration
+   struct Result;
+
+   // outcome of the solve of a model with a configuration (preset or option file)
+   struct BenchmarkRecord {
+      std::string model;
+      std::string configuration;
+      std::string optimization_status;
+      std::string iterate_status;
+      bool solved; // feasible KKT point
+      size_t iterations;
+      size_t evaluations; // objective, constraints, objective gradient, Jacobian and Hessian
+      size_t factorizations;
+      double wall_time; // in seconds
+
+      [[nodiscard]] static BenchmarkRecord from_result(const std::string& model, const std::string& configuration, const Result& result);
+      // the solve failed before producing a result (e.g. the model could not be loaded)
+      [[nodiscard]] static BenchmarkRecord from_error(const std::string& model, const std::string& configuration, const std::string& error,
+            double wall_time);
+
+      // one CSV line (without the newline), see BenchmarkReport::write
+      [[nodiscard]] std::string to_csv() const;
+      [[nodiscard]] static BenchmarkRecord from_csv(const std::string& line);
+   };
+
+   enum class BenchmarkMetric {ITERATIONS = 0, EVALUATIONS, FACTORIZATIONS, WALL_TIME};
+   constexpr std::array<BenchmarkMetric, 4> benchmark_metrics{BenchmarkMetric::ITERATIONS, BenchmarkMetric::EVALUATIONS,
+      BenchmarkMetric::FACTORIZATIONS, BenchmarkMetric::WALL_TIME};
+   std::string benchmark_metric_to_string(BenchmarkMetric metric);
+   BenchmarkMetric benchmark_metric_from_string(const std::string& metric);
+   double benchmark_metric_value(const BenchmarkRecord& record, BenchmarkMetric metric);
+
+   // Dolan-Moré performance profile of a configuration: fraction of the models solved within a ratio tau of the best configuration.
+   // The profile is a step function given by its breakpoints (tau, fraction), with increasing tau
+   struct PerformanceProfile {
+      std::string configuration;
+      std::vector<std::pair<double, double>> breakpoints{};
+   };
+
+   // tolerances above which a metric is reported as changed
+   struct RegressionTolerances {
+      double relative_count_tolerance{0.1}; // iterations, evaluations and factorizations
+      double relative_time_tolerance{0.25};
+      double minimum_time{0.1}; // wall times below this value (in seconds) are not compared
+   };
+
+   // change of a (model, configuration) pair with respect to the baseline: the status ("solved") or a metric
+   struct BenchmarkChange {
+      std::string model;
+      std::string configuration;
+      std::string measure;
+      double baseline_value;
+      double current_value;
+      bool is_regression; // otherwise, improvement
+   };
+
+   struct RegressionReport {
+      size_t number_compared_records{0};
+      std::vector<BenchmarkChange> changes{};
+      std::vector<std::string> missing_records{}; // in the baseline only ("model/configuration")
+      std::vector<std::string> new_records{}; // in the current report only
+
+      [[nodiscard]] size_t number_regressions() const;
+      [[nodiscard]] size_t number_improvements() const;
+      void write_json(std::ostream& stream) const;
+   };
+
+   /*! \class BenchmarkReport
+    * \brief Records of a benchmark campaign
+    *
+    *  The records (one CSV line per solve, with a header) can be stored and read back as a baseline. The performance profiles compare
+    *  the configurations on the models of the report; a configuration that did not solve a model (or has no record for it) never
+    *  reaches its ratio. The values below a floor (1 for the counts, 1 ms for the wall time) are raised to the floor, so that a zero
+    *  count (e.g. factorizations of an SQP method) does not produce infinite ratios
+    */
+   class BenchmarkReport {
+   public:
+      BenchmarkReport() = default;
+
+      void add(BenchmarkRecord record);
+      [[nodiscard]] const std::vector<BenchmarkRecord>& get_records() const { return this->records; }
+
+      void write(std::ostream& stream) const;
+      [[nodiscard]] static BenchmarkReport read(std::istream& stream);
+
+      [[nodiscard]] std::vector<PerformanceProfile> compute_performance_profiles(BenchmarkMetric metric) const;
+      // CSV (metric, configuration, tau, fraction) of the profiles of all metrics
+      void write_performance_profiles(std::ostream& stream) const;
+
+      // changes with respect to a baseline, for the (model, configuration) pairs present in both reports
+      [[nodiscard]] RegressionReport compare(const BenchmarkReport& baseline, const RegressionTolerances& tolerances) const;
+
+   protected:
+      std::vector<BenchmarkRecord> records{};
+   };
+} // namespace
+
+#endif // UNO_BENCHMARKREPORT_H
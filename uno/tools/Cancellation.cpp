@@ -0,0 +1,44 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include "Cancellation.hpp"
+
+namespace uno {
+   namespace {
+      // context of the solve that runs on this thread
+      thread_local const CancellationToken* installed_token{nullptr};
+      thread_local bool has_deadline{false};
+      thread_local std::chrono::steady_clock::time_point deadline{};
+   } // namespace
+
+   void Cancellation::check() {
+      if (installed_token != nullptr && installed_token->is_cancelled()) {
+         throw SolveInterruption(OptimizationStatus::USER_TERMINATION);
+      }
+      if (has_deadline && deadline <= std::chrono::steady_clock::now()) {
+         throw SolveInterruption(OptimizationStatus::TIME_LIMIT);
+      }
+   }
+
+   bool Cancellation::is_cancelled() {
+      return installed_token != nullptr && installed_token->is_cancelled();
+   }
+
+   Cancellation::Scope::Scope(const CancellationToken* token, double time_limit):
+         previous_token(installed_token), previous_has_deadline(has_deadline), previous_deadline(deadline) {
+      installed_token = token;
+      // beyond a few decades, the deadline would overflow the clock
+      has_deadline = std::isfinite(time_limit) && time_limit < 1e9;
+      if (has_deadline) {
+         deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+               std::chrono::duration<double>(time_limit));
+      }
+   }
+
+   Cancellation::Scope::~Scope() {
+      installed_token = this->previous_token;
+      has_deadline = this->previous_has_deadline;
+      deadline = this->previous_deadline;
+   }
+} // namespace
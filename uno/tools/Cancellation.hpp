@@ -0,0 +1,63 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CANCELLATION_H
+#define UNO_CANCELLATION_H
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include "optimization/OptimizationStatus.hpp"
+
+namespace uno {
+   // flag shared with the threads that may cancel a solve (e.g. a request-serving thread with a deadline)
+   class CancellationToken {
+   public:
+      CancellationToken() = default;
+
+      void cancel() { this->cancelled.store(true, std::memory_order_relaxed); }
+      void reset() { this->cancelled.store(false, std::memory_order_relaxed); }
+      [[nodiscard]] bool is_cancelled() const { return this->cancelled.load(std::memory_order_relaxed); }
+
+   private:
+      std::atomic<bool> cancelled{false};
+   };
+
+   // raised at a cancellation point when the solve is cancelled or its time limit is reached. The solve terminates at the current
+   // (last accepted) iterate
+   class SolveInterruption: public std::exception {
+   public:
+      explicit SolveInterruption(OptimizationStatus status): status(status) { }
+
+      [[nodiscard]] const char* what() const noexcept override {
+         return (this->status == OptimizationStatus::TIME_LIMIT) ? "time limit reached" : "solve cancelled";
+      }
+
+      const OptimizationStatus status;
+   };
+
+   // cancellation points of the long-running inner loops (line search, trust region, inertia correction, restoration). The token and
+   // the deadline of a solve are installed for the calling thread (see Scope); without them (or on other threads), check() does nothing
+   class Cancellation {
+   public:
+      // throws a SolveInterruption if the token of the current solve is cancelled or its deadline is passed
+      static void check();
+      [[nodiscard]] static bool is_cancelled();
+
+      class Scope {
+      public:
+         // time limit in seconds (can be inf), from now
+         Scope(const CancellationToken* token, double time_limit);
+         ~Scope();
+         Scope(const Scope&) = delete;
+         Scope& operator=(const Scope&) = delete;
+
+      private:
+         const CancellationToken* const previous_token;
+         const bool previous_has_deadline;
+         const std::chrono::steady_clock::time_point previous_deadline;
+      };
+   };
+} // namespace
+
+#endif // UNO_CANCELLATION_H
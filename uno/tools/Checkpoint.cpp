@@ -0,0 +1,160 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "Checkpoint.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   namespace {
+      constexpr char magic[] = "UNOCHKPT";
+      constexpr size_t magic_length = 8;
+      constexpr std::uint64_t version = 1;
+   } // namespace
+
+   volatile std::sig_atomic_t CheckpointRequest::requested = 0;
+
+   // writer
+
+   CheckpointWriter::CheckpointWriter(const std::string& file_name): file_name(file_name), temporary_file_name(file_name + ".tmp") {
+      this->file.open(this->temporary_file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!this->file) {
+         throw std::runtime_error("The checkpoint file " + this->temporary_file_name + " could not be opened");
+      }
+      this->file.write(magic, magic_length);
+      this->write(static_cast<size_t>(version));
+   }
+
+   void CheckpointWriter::write(double value) {
+      this->file.write(reinterpret_cast<const char*>(&value), sizeof(double));
+   }
+
+   void CheckpointWriter::write(size_t value) {
+      const auto value64 = static_cast<std::uint64_t>(value);
+      this->file.write(reinterpret_cast<const char*>(&value64), sizeof(value64));
+   }
+
+   void CheckpointWriter::write(bool value) {
+      const char byte = value ? 1 : 0;
+      this->file.write(&byte, 1);
+   }
+
+   void CheckpointWriter::write(const std::string& value) {
+      this->write(value.size());
+      this->file.write(value.data(), static_cast<std::streamsize>(value.size()));
+   }
+
+   void CheckpointWriter::write(const Vector<double>& values) {
+      this->write(values.size());
+      this->file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double)));
+   }
+
+   void CheckpointWriter::write(const std::vector<double>& values) {
+      this->write(values.size());
+      this->file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double)));
+   }
+
+   void CheckpointWriter::close() {
+      this->file.close();
+      if (!this->file) {
+         throw std::runtime_error("The checkpoint file " + this->temporary_file_name + " could not be written");
+      }
+      if (std::rename(this->temporary_file_name.c_str(), this->file_name.c_str()) != 0) {
+         throw std::runtime_error("The checkpoint file " + this->temporary_file_name + " could not be renamed to " + this->file_name);
+      }
+   }
+
+   // reader
+
+   CheckpointReader::CheckpointReader(const std::string& file_name): file_name(file_name) {
+      this->file.open(file_name, std::ios::in | std::ios::binary);
+      if (!this->file) {
+         throw std::runtime_error("The checkpoint file " + file_name + " could not be opened");
+      }
+      char file_magic[magic_length];
+      this->read_bytes(file_magic, magic_length);
+      if (std::memcmp(file_magic, magic, magic_length) != 0) {
+         throw std::runtime_error("The file " + file_name + " is not a checkpoint");
+      }
+      const size_t file_version = this->read_size_t();
+      if (file_version != version) {
+         throw std::runtime_error("The checkpoint file " + file_name + " has version " + std::to_string(file_version) + " instead of " +
+            std::to_string(version));
+      }
+   }
+
+   double CheckpointReader::read_double() {
+      double value;
+      this->read_bytes(reinterpret_cast<char*>(&value), sizeof(double));
+      return value;
+   }
+
+   size_t CheckpointReader::read_size_t() {
+      std::uint64_t value64;
+      this->read_bytes(reinterpret_cast<char*>(&value64), sizeof(value64));
+      return static_cast<size_t>(value64);
+   }
+
+   bool CheckpointReader::read_bool() {
+      char byte;
+      this->read_bytes(&byte, 1);
+      return (byte != 0);
+   }
+
+   std::string CheckpointReader::read_string() {
+      const size_t size = this->read_size_t();
+      this->check_size(size, sizeof(char));
+      std::string value(size, '\0');
+      this->read_bytes(value.data(), size);
+      return value;
+   }
+
+   void CheckpointReader::read(Vector<double>& values) {
+      const size_t size = this->read_size_t();
+      this->check_size(size, sizeof(double));
+      values.resize(size);
+      this->read_bytes(reinterpret_cast<char*>(values.data()), size * sizeof(double));
+   }
+
+   void CheckpointReader::read(std::vector<double>& values) {
+      const size_t size = this->read_size_t();
+      this->check_size(size, sizeof(double));
+      values.resize(size);
+      this->read_bytes(reinterpret_cast<char*>(values.data()), size * sizeof(double));
+   }
+
+   void CheckpointReader::read_bytes(char* destination, size_t number_bytes) {
+      this->file.read(destination, static_cast<std::streamsize>(number_bytes));
+      if (!this->file) {
+         throw std::runtime_error("The checkpoint file " + this->file_name + " is truncated");
+      }
+   }
+
+   // a corrupted size would allocate an arbitrarily large buffer
+   void CheckpointReader::check_size(size_t number_elements, size_t element_size) {
+      const std::streampos position = this->file.tellg();
+      this->file.seekg(0, std::ios::end);
+      const auto remaining_bytes = static_cast<size_t>(this->file.tellg() - position);
+      this->file.seekg(position);
+      if (remaining_bytes / element_size < number_elements) {
+         throw std::runtime_error("The checkpoint file " + this->file_name + " is truncated");
+      }
+   }
+
+   // request
+
+   void CheckpointRequest::request() noexcept {
+      CheckpointRequest::requested = 1;
+   }
+
+   bool CheckpointRequest::consume() noexcept {
+      if (CheckpointRequest::requested != 0) {
+         CheckpointRequest::requested = 0;
+         return true;
+      }
+      return false;
+   }
+} // namespace
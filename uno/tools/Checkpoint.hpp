@@ -0,0 +1,74 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CHECKPOINT_H
+#define UNO_CHECKPOINT_H
+
+#include <csignal>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace uno {
+   // forward declaration
+   template <typename ElementType>
+   class Vector;
+
+   // binary checkpoint of a solve: the current iterate and the algorithmic state of the strategies (trust-region radius, penalty and
+   // barrier parameters, filter or funnel, regularization history, ...). The format is: the magic "UNOCHKPT", the version (uint64),
+   // then the fields written by the solver and the strategies, in order. Integers are uint64, vectors are prefixed with their size
+   // (native endianness). The file is written under a temporary name and renamed once complete: an interrupted write leaves the
+   // previous checkpoint intact
+   class CheckpointWriter {
+   public:
+      explicit CheckpointWriter(const std::string& file_name);
+
+      void write(double value);
+      void write(size_t value);
+      void write(bool value);
+      void write(const std::string& value);
+      void write(const Vector<double>& values);
+      void write(const std::vector<double>& values);
+      // flushes the file and renames it
+      void close();
+
+   protected:
+      const std::string file_name;
+      const std::string temporary_file_name;
+      std::ofstream file;
+   };
+
+   class CheckpointReader {
+   public:
+      explicit CheckpointReader(const std::string& file_name);
+
+      [[nodiscard]] double read_double();
+      [[nodiscard]] size_t read_size_t();
+      [[nodiscard]] bool read_bool();
+      [[nodiscard]] std::string read_string();
+      // the vector is resized to the size of the stored vector
+      void read(Vector<double>& values);
+      void read(std::vector<double>& values);
+
+   protected:
+      const std::string file_name;
+      std::ifstream file;
+
+      void read_bytes(char* destination, size_t number_bytes);
+      void check_size(size_t number_elements, size_t element_size);
+   };
+
+   // checkpoint requested asynchronously (e.g. by a signal handler): the solve writes a checkpoint at the end of the current iteration
+   class CheckpointRequest {
+   public:
+      // async-signal-safe
+      static void request() noexcept;
+      // returns whether a checkpoint was requested, and clears the request
+      [[nodiscard]] static bool consume() noexcept;
+
+   private:
+      static volatile std::sig_atomic_t requested;
+   };
+} // namespace
+
+#endif // UNO_CHECKPOINT_H
@@ -0,0 +1,66 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CONCURRENTTASKS_H
+#define UNO_CONCURRENTTASKS_H
+
+#include <array>
+#include <exception>
+#include <utility>
+#include "optimization/EvaluationCounters.hpp"
+#include "tools/ThreadPool.hpp"
+#include "tools/Timeline.hpp"
+
+namespace uno {
+   // runs independent tasks concurrently on the thread pool installed on the calling thread, or on the OpenMP threads without a
+   // pool. The tasks are run in order on the calling thread if concurrent is false (or without pool and OpenMP). Each task is carried out with its own evaluation counters on the timeline of the calling thread; the counters
+   // are then added to those of the calling thread. The exception of the first failed task (in order) is raised again once all the
+   // tasks have completed. No heap allocation is performed
+   template <typename... Tasks>
+   void run_concurrently(bool concurrent, Tasks&&... tasks) {
+      if (!concurrent) {
+         (tasks(), ...);
+         return;
+      }
+      constexpr int number_tasks = static_cast<int>(sizeof...(Tasks));
+      std::array<EvaluationCounters, sizeof...(Tasks)> task_counters{};
+      std::array<std::exception_ptr, sizeof...(Tasks)> task_errors{};
+      Timeline* const timeline = Timeline::current();
+      const auto run_task = [&](int task_index) {
+         // exceptions cannot leave the parallel region
+         try {
+            const EvaluationCounters::Scope counters_scope(task_counters[static_cast<size_t>(task_index)]);
+            const Timeline::Scope timeline_scope(timeline);
+            int index = 0;
+            ((index++ == task_index ? static_cast<void>(tasks()) : static_cast<void>(0)), ...);
+         }
+         catch (...) {
+            task_errors[static_cast<size_t>(task_index)] = std::current_exception();
+         }
+      };
+      if (ThreadPool* thread_pool = ThreadPool::current(); thread_pool != nullptr) {
+         thread_pool->parallel_for(0, sizeof...(Tasks), [&](size_t task_index) {
+            run_task(static_cast<int>(task_index));
+         });
+      }
+      else {
+#ifdef _OPENMP
+         #pragma omp parallel for schedule(dynamic) num_threads(number_tasks)
+#endif
+         for (int task_index = 0; task_index < number_tasks; task_index++) {
+            run_task(task_index);
+         }
+      }
+      EvaluationCounters& counters = EvaluationCounters::current();
+      for (const EvaluationCounters& counters_of_task: task_counters) {
+         counters += counters_of_task;
+      }
+      for (const std::exception_ptr& task_error: task_errors) {
+         if (task_error) {
+            std::rethrow_exception(task_error);
+         }
+      }
+   }
+} // namespace
+
+#endif // UNO_CONCURRENTTASKS_H
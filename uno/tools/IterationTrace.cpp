@@ -0,0 +1,71 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include "IterationTrace.hpp"
+
+namespace uno {
+   namespace {
+      bool is_binary_format(const std::string& format) {
+         if (format == "binary") {
+            return true;
+         }
+         else if (format == "csv") {
+            return false;
+         }
+         throw std::invalid_argument("The statistics trace format " + format + " is unknown");
+      }
+   } // namespace
+
+   IterationTrace::IterationTrace(const std::string& file_name, const std::string& format):
+         is_binary(is_binary_format(format)) {
+      this->file.open(file_name, this->is_binary ? (std::ios::out | std::ios::binary) : std::ios::out);
+      if (!this->file) {
+         throw std::runtime_error("The statistics trace file " + file_name + " could not be opened");
+      }
+      if (!this->is_binary) {
+         this->file << std::setprecision(std::numeric_limits<double>::max_digits10);
+      }
+   }
+
+   void IterationTrace::write_fields(const std::vector<std::string>& column_names) {
+      this->number_fields = 1 + column_names.size();
+      if (this->is_binary) {
+         this->file.write("UNOTRACE", 8);
+         const auto number_fields64 = static_cast<std::uint64_t>(this->number_fields);
+         this->file.write(reinterpret_cast<const char*>(&number_fields64), sizeof(number_fields64));
+         this->file.write("time", 5);
+         for (const std::string& name: column_names) {
+            this->file.write(name.c_str(), static_cast<std::streamsize>(name.size() + 1));
+         }
+      }
+      else {
+         this->file << "time";
+         for (const std::string& name: column_names) {
+            this->file << ',' << name;
+         }
+         this->file << '\n';
+      }
+   }
+
+   void IterationTrace::write_record(double time, const std::vector<double>& values) {
+      if (this->is_binary) {
+         this->file.write(reinterpret_cast<const char*>(&time), sizeof(double));
+         this->file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double)));
+      }
+      else {
+         this->file << time;
+         for (const double value: values) {
+            this->file << ',';
+            if (!std::isnan(value)) {
+               this->file << value;
+            }
+         }
+         this->file << '\n';
+      }
+   }
+} // namespace
@@ -0,0 +1,32 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_ITERATIONTRACE_H
+#define UNO_ITERATIONTRACE_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace uno {
+   // structured per-iteration records of the numerical statistics, for offline analysis without parsing the text table.
+   // Each record starts with the wall-clock time (in seconds) since the beginning of the solve, followed by one value per
+   // column. Columns without a numerical value (unset or textual) are empty in CSV and NaN in binary.
+   // The binary format is: the magic "UNOTRACE", the number of fields (uint64), the null-terminated field names, then the
+   // records as arrays of doubles (native endianness)
+   class IterationTrace {
+   public:
+      IterationTrace(const std::string& file_name, const std::string& format);
+
+      [[nodiscard]] bool has_fields() const { return this->number_fields != 0; }
+      void write_fields(const std::vector<std::string>& column_names);
+      void write_record(double time, const std::vector<double>& values);
+
+   protected:
+      std::ofstream file;
+      const bool is_binary;
+      size_t number_fields{0};
+   };
+} // namespace
+
+#endif // UNO_ITERATIONTRACE_H
@@ -1,33 +1,27 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <stdexcept>
 #include "Logger.hpp"
+#include "symbolic/Range.hpp"
 
 namespace uno {
+   // the levels DEBUG to DEBUG3 are logging macros (see Logger.hpp): the levels are looked up by name
    void Logger::set_logger(const std::string& logger_level) {
-      if (logger_level == "SILENT") {
-         Logger::level = SILENT;
-      }
-      else if (logger_level == "DISCRETE") {
-         Logger::level = DISCRETE;
-      }
-      else if (logger_level == "WARNING") {
-         Logger::level = WARNING;
-      }
-      else if (logger_level == "INFO") {
-         Logger::level = INFO;
-      }
-      else if (logger_level == "DEBUG") {
-         Logger::level = DEBUG;
-      }
-      else if (logger_level == "DEBUG2") {
-         Logger::level = DEBUG2;
-      }
-      else if (logger_level == "DEBUG3") {
-         Logger::level = DEBUG3;
-      }
-      else {
-         throw std::out_of_range("The logger level " + logger_level + " was not found");
+      for (size_t level_index: Range(level_names.size())) {
+         if (logger_level == level_names[level_index]) {
+            Logger::level = static_cast<Level>(level_index);
+            return;
+         }
       }
+      throw std::out_of_range("The logger level " + logger_level + " was not found");
+   }
+
+   Logger::Scope::Scope(const std::string& logger_level): previous_level(Logger::level) {
+      Logger::set_logger(logger_level);
+   }
+
+   Logger::Scope::~Scope() {
+      Logger::level = this->previous_level;
    }
 } // namespace
\ No newline at end of file
@@ -4,6 +4,7 @@
 #ifndef UNO_LOGGER_H
 #define UNO_LOGGER_H
 
+#include <array>
 #include <string>
 #include <iostream>
 
@@ -11,11 +12,26 @@ namespace uno {
    enum Level {
        SILENT = 0, DISCRETE, WARNING, INFO, DEBUG, DEBUG2, DEBUG3
    };
+   // names of the levels, in the order of the enumeration
+   constexpr std::array<const char*, 7> level_names{"SILENT", "DISCRETE", "WARNING", "INFO", "DEBUG", "DEBUG2", "DEBUG3"};
 
    class Logger {
    public:
-       static Level level;
+       // each thread has its own level, so that concurrent solves may log at different levels
+       static thread_local Level level;
        static void set_logger(const std::string& logger_level);
+
+       // sets the level of the calling thread and restores the previous level upon destruction
+       class Scope {
+       public:
+          explicit Scope(const std::string& logger_level);
+          ~Scope();
+          Scope(const Scope&) = delete;
+          Scope& operator=(const Scope&) = delete;
+
+       private:
+          const Level previous_level;
+       };
    };
 
    template <typename T>
@@ -33,6 +49,21 @@ namespace uno {
       }
       return level;
    }
+
+   [[nodiscard]] inline bool is_logged(Level level) {
+      return (level <= Logger::level);
+   }
 } // namespace
 
+// DEBUG, DEBUG2 and DEBUG3 are statements: the operands of "DEBUG << ..." are evaluated only if the level is enabled for the
+// calling thread. With UNO_DISABLE_DEBUG_LOGGING (CMake option WITH_DEBUG_LOGGING=OFF), the messages are compiled out
+#ifdef UNO_DISABLE_DEBUG_LOGGING
+#define UNO_LOG(level) if constexpr (true) {} else std::cout
+#else
+#define UNO_LOG(level) if (!uno::is_logged(level)) {} else std::cout
+#endif
+#define DEBUG UNO_LOG(uno::Level::DEBUG)
+#define DEBUG2 UNO_LOG(uno::Level::DEBUG2)
+#define DEBUG3 UNO_LOG(uno::Level::DEBUG3)
+
 #endif // UNO_LOGGER_H
@@ -0,0 +1,183 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include "MemoryPolicy.hpp"
+#include "options/Options.hpp"
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace uno {
+   namespace {
+      std::atomic<bool> parallel_first_touch{false};
+      std::atomic<HugePages> huge_pages_policy{HugePages::NONE};
+
+      // mapped buffers and their mapped sizes
+      std::mutex large_buffers_mutex;
+      std::unordered_map<void*, size_t> large_buffers;
+      std::atomic<size_t> large_buffers_count{0};
+
+#if defined(__linux__)
+      size_t round_up(size_t size, size_t granularity) {
+         return ((size + granularity - 1) / granularity) * granularity;
+      }
+
+      // anonymous mapping of mapped_size bytes aligned on alignment (a multiple of the page size)
+      void* map_aligned(size_t mapped_size, size_t alignment) {
+         const size_t oversized_size = mapped_size + alignment;
+         void* mapping = mmap(nullptr, oversized_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+         if (mapping == MAP_FAILED) {
+            return nullptr;
+         }
+         // trim the head and the tail so that the mapping starts on the alignment
+         const auto address = reinterpret_cast<std::uintptr_t>(mapping);
+         const std::uintptr_t aligned_address = ((address + alignment - 1) / alignment) * alignment;
+         const size_t head_size = aligned_address - address;
+         if (0 < head_size) {
+            munmap(mapping, head_size);
+         }
+         const size_t tail_size = oversized_size - head_size - mapped_size;
+         if (0 < tail_size) {
+            munmap(reinterpret_cast<void*>(aligned_address + mapped_size), tail_size);
+         }
+         return reinterpret_cast<void*>(aligned_address);
+      }
+
+      // the pages are touched by the threads with the static partitioning of the parallel kernels (see jacobian_product)
+      void touch_pages(void* buffer, size_t mapped_size, size_t page_size) {
+#ifdef _OPENMP
+         char* bytes = static_cast<char*>(buffer);
+         const long long number_pages = static_cast<long long>(mapped_size / page_size);
+         #pragma omp parallel for schedule(static)
+         for (long long page_index = 0; page_index < number_pages; page_index++) {
+            bytes[static_cast<size_t>(page_index) * page_size] = 0;
+         }
+#else
+         // without OpenMP, the pages are touched by the (only) thread that writes them
+         (void) buffer;
+         (void) mapped_size;
+         (void) page_size;
+#endif
+      }
+#endif
+   } // namespace
+
+   void MemoryPolicy::set(bool first_touch, HugePages huge_pages) {
+      parallel_first_touch = first_touch;
+      huge_pages_policy = huge_pages;
+   }
+
+   void MemoryPolicy::set_from_options(const Options& options) {
+      const std::string& first_touch = options.get_string("memory_first_touch");
+      if (first_touch != "serial" && first_touch != "parallel") {
+         throw std::invalid_argument("The memory first touch " + first_touch + " is not supported");
+      }
+      const std::string& huge_pages = options.get_string("huge_pages");
+      HugePages huge_pages_value;
+      if (huge_pages == "none") {
+         huge_pages_value = HugePages::NONE;
+      }
+      else if (huge_pages == "transparent") {
+         huge_pages_value = HugePages::TRANSPARENT;
+      }
+      else if (huge_pages == "explicit") {
+         huge_pages_value = HugePages::EXPLICIT;
+      }
+      else {
+         throw std::invalid_argument("The huge pages mode " + huge_pages + " is not supported");
+      }
+      MemoryPolicy::set(first_touch == "parallel", huge_pages_value);
+   }
+
+   bool MemoryPolicy::is_active() {
+      return parallel_first_touch || huge_pages_policy != HugePages::NONE;
+   }
+
+   bool MemoryPolicy::has_parallel_first_touch() {
+      return parallel_first_touch;
+   }
+
+   HugePages MemoryPolicy::huge_pages() {
+      return huge_pages_policy;
+   }
+
+   void* MemoryPolicy::allocate_large_buffer(size_t size) {
+#if defined(__linux__)
+      if (size < MemoryPolicy::large_buffer_threshold || !MemoryPolicy::is_active()) {
+         return nullptr;
+      }
+      const HugePages huge_pages = huge_pages_policy;
+      const size_t mapped_size = round_up(size, MemoryPolicy::huge_page_size);
+      void* buffer = nullptr;
+      size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+      if (huge_pages == HugePages::EXPLICIT) {
+         void* mapping = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+         if (mapping != MAP_FAILED) {
+            buffer = mapping;
+            page_size = MemoryPolicy::huge_page_size;
+         }
+      }
+      if (buffer == nullptr) {
+         // regular pages, aligned on a huge page so that the kernel can promote them
+         buffer = map_aligned(mapped_size, (huge_pages == HugePages::NONE) ? page_size : MemoryPolicy::huge_page_size);
+         if (buffer == nullptr) {
+            return nullptr;
+         }
+         if (huge_pages != HugePages::NONE) {
+            // a refusal (e.g. transparent huge pages disabled) is not an error
+            madvise(buffer, mapped_size, MADV_HUGEPAGE);
+            page_size = MemoryPolicy::huge_page_size;
+         }
+      }
+      if (parallel_first_touch) {
+         touch_pages(buffer, mapped_size, page_size);
+      }
+      {
+         const std::lock_guard<std::mutex> lock(large_buffers_mutex);
+         large_buffers.emplace(buffer, mapped_size);
+      }
+      large_buffers_count++;
+      return buffer;
+#else
+      (void) size;
+      return nullptr;
+#endif
+   }
+
+   bool MemoryPolicy::deallocate_large_buffer(void* pointer, size_t size) noexcept {
+#if defined(__linux__)
+      // the buffers allocated by operator new (no active policy) are not looked up
+      if (size < MemoryPolicy::large_buffer_threshold || large_buffers_count == 0) {
+         return false;
+      }
+      size_t mapped_size;
+      {
+         const std::lock_guard<std::mutex> lock(large_buffers_mutex);
+         const auto buffer = large_buffers.find(pointer);
+         if (buffer == large_buffers.end()) {
+            return false;
+         }
+         mapped_size = buffer->second;
+         large_buffers.erase(buffer);
+      }
+      large_buffers_count--;
+      munmap(pointer, mapped_size);
+      return true;
+#else
+      (void) pointer;
+      (void) size;
+      return false;
+#endif
+   }
+
+   size_t MemoryPolicy::number_large_buffers() {
+      return large_buffers_count;
+   }
+} // namespace
@@ -0,0 +1,46 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MEMORYPOLICY_H
+#define UNO_MEMORYPOLICY_H
+
+#include <cstddef>
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   enum class HugePages {NONE, TRANSPARENT, EXPLICIT};
+
+   /*! \class MemoryPolicy
+    * \brief Placement of the large buffers (Vector, sparse matrices, Jacobian, factors)
+    *
+    *  The buffers of at least large_buffer_threshold bytes that are obtained from AlignedAllocator are mapped directly and:
+    *  - with parallel first touch, their pages are touched by the OpenMP threads with the static partitioning of the parallel
+    *  kernels, so that they are placed on the NUMA nodes of the threads that later access them;
+    *  - with transparent huge pages, the mapping is aligned on a huge page and madvise(MADV_HUGEPAGE) is requested;
+    *  - with explicit huge pages, the mapping is backed by the reserved huge pages (MAP_HUGETLB), or by regular pages if none is
+    *  available.
+    *  The policy is process-wide and only affects the subsequent allocations: it should be set before the model and the solver
+    *  are created. When no policy is active (default) or on platforms other than Linux, the buffers are allocated by operator new
+    */
+   class MemoryPolicy {
+   public:
+      static constexpr size_t large_buffer_threshold{size_t(1) << 21};
+      static constexpr size_t huge_page_size{size_t(1) << 21};
+
+      static void set(bool parallel_first_touch, HugePages huge_pages);
+      static void set_from_options(const Options& options);
+      [[nodiscard]] static bool is_active();
+      [[nodiscard]] static bool has_parallel_first_touch();
+      [[nodiscard]] static HugePages huge_pages();
+
+      // returns nullptr if no policy is active: the buffer should then be allocated by operator new
+      [[nodiscard]] static void* allocate_large_buffer(size_t size);
+      // returns false if the buffer was not allocated by allocate_large_buffer
+      static bool deallocate_large_buffer(void* pointer, size_t size) noexcept;
+      [[nodiscard]] static size_t number_large_buffers();
+   };
+} // namespace
+
+#endif // UNO_MEMORYPOLICY_H
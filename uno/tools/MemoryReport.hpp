@@ -0,0 +1,49 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MEMORYREPORT_H
+#define UNO_MEMORYREPORT_H
+
+#include <string>
+#include <vector>
+
+namespace uno {
+   // memory allocated by a component of the solver (e.g. "iterates" or "QP solver/constraint Jacobian")
+   struct MemoryUsage {
+      std::string component;
+      size_t bytes;
+   };
+
+   // per-component accounting of the memory held by the solver at the end of a solve. The buffers are measured by their
+   // capacity; the memory managed by external libraries (e.g. the factors of the linear solvers) is not accounted for
+   class MemoryReport {
+   public:
+      MemoryReport() = default;
+
+      // the components with no memory are omitted
+      void add(const std::string& component, size_t bytes) {
+         if (0 < bytes) {
+            this->usages.push_back({component, bytes});
+         }
+      }
+
+      template <typename ElementType, typename Allocator>
+      [[nodiscard]] static size_t memory_size(const std::vector<ElementType, Allocator>& vector) {
+         return vector.capacity() * sizeof(ElementType);
+      }
+
+      [[nodiscard]] const std::vector<MemoryUsage>& get_usages() const { return this->usages; }
+      [[nodiscard]] size_t total_size() const {
+         size_t total = 0;
+         for (const MemoryUsage& usage: this->usages) {
+            total += usage.bytes;
+         }
+         return total;
+      }
+
+   protected:
+      std::vector<MemoryUsage> usages{};
+   };
+} // namespace
+
+#endif // UNO_MEMORYREPORT_H
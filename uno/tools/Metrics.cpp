@@ -0,0 +1,190 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cassert>
+#include <sstream>
+#include "Metrics.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   namespace {
+      thread_local MetricsRegistry* installed_registry{nullptr};
+
+      constexpr std::array<double, max_histogram_buckets> count_buckets{1., 2., 5., 10., 20., 50., 100., 200., 500., 1000.};
+      constexpr std::array<double, max_histogram_buckets> share_buckets{0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.};
+
+      // in the order of the enum Metric
+      const std::array<MetricDefinition, number_metrics> catalogue{{
+         {"uno_solves", MetricType::COUNTER, "Number of solves"},
+         {"uno_solves_with_restoration", MetricType::COUNTER, "Number of solves that entered the feasibility restoration phase"},
+         {"uno_restoration_phases", MetricType::COUNTER, "Number of switches to the feasibility restoration phase"},
+         {"uno_iterations", MetricType::COUNTER, "Number of outer iterations"},
+         {"uno_lp_subproblems", MetricType::COUNTER, "Number of LP subproblems solved"},
+         {"uno_qp_subproblems", MetricType::COUNTER, "Number of QP subproblems solved"},
+         {"uno_factorizations", MetricType::COUNTER, "Number of numerical factorizations of the direct linear solvers"},
+         {"uno_perturbed_pivots", MetricType::COUNTER, "Number of pivots perturbed by the direct linear solvers"},
+         {"uno_regularizations", MetricType::COUNTER, "Number of inertia or curvature corrections of the augmented matrices"},
+         {"uno_function_evaluations", MetricType::COUNTER, "Number of objective and constraint evaluations"},
+         {"uno_derivative_evaluations", MetricType::COUNTER, "Number of objective gradient, Jacobian and Hessian evaluations"},
+         {"uno_solve_seconds", MetricType::COUNTER, "Wall-clock time of the solves"},
+         {"uno_evaluation_seconds", MetricType::COUNTER, "Wall-clock time of the function and derivative evaluations"},
+         {"uno_last_solve_seconds", MetricType::GAUGE, "Wall-clock time of the last solve"},
+         {"uno_solve_iterations", MetricType::HISTOGRAM, "Number of outer iterations per solve", count_buckets, count_buckets.size()},
+         {"uno_solve_factorizations", MetricType::HISTOGRAM, "Number of numerical factorizations per solve", count_buckets,
+            count_buckets.size()},
+         {"uno_solve_evaluation_time_share", MetricType::HISTOGRAM, "Fraction of the solve time spent in the evaluations", share_buckets,
+            share_buckets.size()}
+      }};
+
+      void write_number(std::ostream& stream, double value) {
+         std::ostringstream formatted;
+         formatted.precision(15);
+         formatted << value;
+         stream << formatted.str();
+      }
+   } // namespace
+
+   void MetricsRegistry::increment(Metric metric, double value) {
+      assert(MetricsRegistry::definition(metric).type == MetricType::COUNTER && "The metric is not a counter");
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      this->values[static_cast<size_t>(metric)] += value;
+   }
+
+   void MetricsRegistry::set(Metric metric, double value) {
+      assert(MetricsRegistry::definition(metric).type == MetricType::GAUGE && "The metric is not a gauge");
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      this->values[static_cast<size_t>(metric)] = value;
+   }
+
+   void MetricsRegistry::observe(Metric metric, double value) {
+      const MetricDefinition& definition = MetricsRegistry::definition(metric);
+      assert(definition.type == MetricType::HISTOGRAM && "The metric is not a histogram");
+      size_t bucket_index = 0;
+      while (bucket_index < definition.number_buckets && definition.bucket_upper_bounds[bucket_index] < value) {
+         bucket_index++;
+      }
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      Histogram& histogram = this->histograms[static_cast<size_t>(metric)];
+      histogram.bucket_counts[bucket_index]++;
+      histogram.sum += value;
+      histogram.count++;
+   }
+
+   double MetricsRegistry::value(Metric metric) const {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      return this->values[static_cast<size_t>(metric)];
+   }
+
+   Histogram MetricsRegistry::histogram(Metric metric) const {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      return this->histograms[static_cast<size_t>(metric)];
+   }
+
+   void MetricsRegistry::merge(const MetricsRegistry& other) {
+      if (&other == this) {
+         return;
+      }
+      const std::scoped_lock lock(this->mutex, other.mutex);
+      for (size_t metric_index: Range(number_metrics)) {
+         switch (catalogue[metric_index].type) {
+            case MetricType::COUNTER:
+               this->values[metric_index] += other.values[metric_index];
+               break;
+            case MetricType::GAUGE:
+               this->values[metric_index] = other.values[metric_index];
+               break;
+            case MetricType::HISTOGRAM: {
+               Histogram& histogram = this->histograms[metric_index];
+               const Histogram& other_histogram = other.histograms[metric_index];
+               for (size_t bucket_index: Range(histogram.bucket_counts.size())) {
+                  histogram.bucket_counts[bucket_index] += other_histogram.bucket_counts[bucket_index];
+               }
+               histogram.sum += other_histogram.sum;
+               histogram.count += other_histogram.count;
+               break;
+            }
+         }
+      }
+   }
+
+   void MetricsRegistry::clear() {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      this->values.fill(0.);
+      this->histograms.fill(Histogram{});
+   }
+
+   // https://github.com/OpenObservability/OpenMetrics/blob/main/specification/OpenMetrics.md
+   void MetricsRegistry::write_openmetrics(std::ostream& stream) const {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      for (size_t metric_index: Range(number_metrics)) {
+         const MetricDefinition& definition = catalogue[metric_index];
+         switch (definition.type) {
+            case MetricType::COUNTER:
+               stream << "# TYPE " << definition.name << " counter\n";
+               stream << "# HELP " << definition.name << ' ' << definition.help << '\n';
+               stream << definition.name << "_total ";
+               write_number(stream, this->values[metric_index]);
+               stream << '\n';
+               break;
+            case MetricType::GAUGE:
+               stream << "# TYPE " << definition.name << " gauge\n";
+               stream << "# HELP " << definition.name << ' ' << definition.help << '\n';
+               stream << definition.name << ' ';
+               write_number(stream, this->values[metric_index]);
+               stream << '\n';
+               break;
+            case MetricType::HISTOGRAM: {
+               stream << "# TYPE " << definition.name << " histogram\n";
+               stream << "# HELP " << definition.name << ' ' << definition.help << '\n';
+               // the buckets are cumulative
+               const Histogram& histogram = this->histograms[metric_index];
+               size_t cumulative_count = 0;
+               for (size_t bucket_index: Range(definition.number_buckets)) {
+                  cumulative_count += histogram.bucket_counts[bucket_index];
+                  stream << definition.name << "_bucket{le=\"";
+                  write_number(stream, definition.bucket_upper_bounds[bucket_index]);
+                  stream << "\"} " << cumulative_count << '\n';
+               }
+               stream << definition.name << "_bucket{le=\"+Inf\"} " << histogram.count << '\n';
+               stream << definition.name << "_sum ";
+               write_number(stream, histogram.sum);
+               stream << '\n';
+               stream << definition.name << "_count " << histogram.count << '\n';
+               break;
+            }
+         }
+      }
+      stream << "# EOF\n";
+   }
+
+   std::string MetricsRegistry::to_openmetrics() const {
+      std::ostringstream stream;
+      this->write_openmetrics(stream);
+      return stream.str();
+   }
+
+   const MetricDefinition& MetricsRegistry::definition(Metric metric) {
+      return catalogue[static_cast<size_t>(metric)];
+   }
+
+   std::optional<Metric> MetricsRegistry::find(std::string_view name) {
+      for (size_t metric_index: Range(number_metrics)) {
+         if (catalogue[metric_index].name == name) {
+            return static_cast<Metric>(metric_index);
+         }
+      }
+      return std::nullopt;
+   }
+
+   MetricsRegistry* MetricsRegistry::current() {
+      return installed_registry;
+   }
+
+   MetricsRegistry::Scope::Scope(MetricsRegistry* registry): previous_registry(installed_registry) {
+      installed_registry = registry;
+   }
+
+   MetricsRegistry::Scope::~Scope() {
+      installed_registry = this->previous_registry;
+   }
+} // namespace
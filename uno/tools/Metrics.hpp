@@ -0,0 +1,131 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_METRICS_H
+#define UNO_METRICS_H
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace uno {
+   enum class Metric: size_t {
+      // counters
+      SOLVES = 0,
+      SOLVES_WITH_RESTORATION,
+      RESTORATION_PHASES,
+      ITERATIONS,
+      LP_SUBPROBLEMS,
+      QP_SUBPROBLEMS,
+      FACTORIZATIONS,
+      PERTURBED_PIVOTS,
+      REGULARIZATIONS,
+      FUNCTION_EVALUATIONS,
+      DERIVATIVE_EVALUATIONS,
+      SOLVE_TIME,
+      EVALUATION_TIME,
+      // gauges
+      LAST_SOLVE_TIME,
+      // histograms (one observation per solve)
+      SOLVE_ITERATIONS,
+      SOLVE_FACTORIZATIONS,
+      SOLVE_EVALUATION_TIME_SHARE,
+      NUMBER_METRICS
+   };
+
+   enum class MetricType {COUNTER, GAUGE, HISTOGRAM};
+
+   constexpr size_t number_metrics = static_cast<size_t>(Metric::NUMBER_METRICS);
+   constexpr size_t max_histogram_buckets = 10;
+
+   struct MetricDefinition {
+      std::string_view name;
+      MetricType type;
+      std::string_view help;
+      // finite upper bounds of the buckets (histograms only), followed by the implicit +Inf bucket
+      std::array<double, max_histogram_buckets> bucket_upper_bounds{};
+      size_t number_buckets{0};
+   };
+
+   // observations of a histogram: number of observations in each (non cumulative) bucket, the last one being +Inf
+   struct Histogram {
+      std::array<size_t, max_histogram_buckets + 1> bucket_counts{};
+      double sum{0.};
+      size_t count{0};
+   };
+
+   // registry of the solver metrics (counters, gauges and histograms over a fixed catalogue), aggregated across solves. The
+   // registry is installed on a thread for the duration of the solves (see Scope): the components then record their metrics
+   // through the functions of the metrics namespace. Without a registry, they cost a single thread-local check. Each solve
+   // records into its own registry, merged into the installed one at the end of the solve. No metric allocates memory
+   class MetricsRegistry {
+   public:
+      MetricsRegistry() = default;
+
+      void increment(Metric metric, double value = 1.);
+      void set(Metric metric, double value);
+      void observe(Metric metric, double value);
+      // value of a counter or a gauge
+      [[nodiscard]] double value(Metric metric) const;
+      [[nodiscard]] Histogram histogram(Metric metric) const;
+      // the counters and histograms of another registry are added, its gauges overwrite those of this registry
+      void merge(const MetricsRegistry& other);
+      void clear();
+
+      // OpenMetrics text exposition format
+      void write_openmetrics(std::ostream& stream) const;
+      [[nodiscard]] std::string to_openmetrics() const;
+
+      [[nodiscard]] static const MetricDefinition& definition(Metric metric);
+      // metric of a given name (without the _total suffix of the counters)
+      [[nodiscard]] static std::optional<Metric> find(std::string_view name);
+
+      // registry installed on the calling thread, or nullptr
+      [[nodiscard]] static MetricsRegistry* current();
+
+      // installs a registry on the calling thread and restores the previous one upon destruction
+      class Scope {
+      public:
+         explicit Scope(MetricsRegistry* registry);
+         ~Scope();
+         Scope(const Scope&) = delete;
+         Scope& operator=(const Scope&) = delete;
+
+      private:
+         MetricsRegistry* const previous_registry;
+      };
+
+   protected:
+      // concurrent solves may merge into the same registry
+      mutable std::mutex mutex{};
+      std::array<double, number_metrics> values{};
+      std::array<Histogram, number_metrics> histograms{};
+   };
+
+   // records into the registry installed on the calling thread, if any
+   namespace metrics {
+      inline void increment(Metric metric, double value = 1.) {
+         if (MetricsRegistry* registry = MetricsRegistry::current(); registry != nullptr) {
+            registry->increment(metric, value);
+         }
+      }
+
+      inline void set(Metric metric, double value) {
+         if (MetricsRegistry* registry = MetricsRegistry::current(); registry != nullptr) {
+            registry->set(metric, value);
+         }
+      }
+
+      inline void observe(Metric metric, double value) {
+         if (MetricsRegistry* registry = MetricsRegistry::current(); registry != nullptr) {
+            registry->observe(metric, value);
+         }
+      }
+   } // namespace
+} // namespace
+
+#endif // UNO_METRICS_H
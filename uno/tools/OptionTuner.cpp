@@ -0,0 +1,247 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include "OptionTuner.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   namespace {
+      // shifts of the geometric means: the small values do not dominate the comparison
+      double metric_shift(BenchmarkMetric metric) {
+         return (metric == BenchmarkMetric::WALL_TIME) ? 1. : 10.;
+      }
+
+      std::vector<std::string> split(const std::string& string, char delimiter) {
+         std::vector<std::string> tokens{};
+         std::istringstream stream(string);
+         std::string token;
+         while (std::getline(stream, token, delimiter)) {
+            tokens.emplace_back(token);
+         }
+         return tokens;
+      }
+   }
+
+   // tuned parameter
+
+   std::string TunedParameter::sample(std::mt19937& generator) const {
+      if (!this->values.empty()) {
+         std::uniform_int_distribution<size_t> distribution(0, this->values.size() - 1);
+         return this->values[distribution(generator)];
+      }
+      std::uniform_real_distribution<double> distribution(0., 1.);
+      const double uniform_value = distribution(generator);
+      double value = this->is_logarithmic ?
+            std::exp(std::log(this->lower_bound) + uniform_value * (std::log(this->upper_bound) - std::log(this->lower_bound))) :
+            this->lower_bound + uniform_value * (this->upper_bound - this->lower_bound);
+      if (this->is_integer) {
+         return std::to_string(static_cast<long long>(std::llround(value)));
+      }
+      value = std::clamp(value, this->lower_bound, this->upper_bound);
+      std::ostringstream stream;
+      stream.precision(6);
+      stream << value;
+      return stream.str();
+   }
+
+   TunedParameter TunedParameter::from_line(const std::string& line) {
+      std::istringstream stream(line);
+      TunedParameter parameter{};
+      std::string domain;
+      if (!(stream >> parameter.name >> domain)) {
+         throw std::invalid_argument("The search-space line \"" + line + "\" should contain a name and a domain");
+      }
+      // numerical range lower:upper[:log][:int]
+      if (domain.find(':') != std::string::npos) {
+         const std::vector<std::string> tokens = split(domain, ':');
+         try {
+            parameter.lower_bound = std::stod(tokens[0]);
+            parameter.upper_bound = std::stod(tokens[1]);
+         }
+         catch (const std::exception&) {
+            throw std::invalid_argument("The range of " + parameter.name + " should be lower:upper[:log][:int]");
+         }
+         for (size_t token_index: Range(2, tokens.size())) {
+            if (tokens[token_index] == "log") {
+               parameter.is_logarithmic = true;
+            }
+            else if (tokens[token_index] == "int") {
+               parameter.is_integer = true;
+            }
+            else {
+               throw std::invalid_argument("The range qualifier " + tokens[token_index] + " of " + parameter.name + " is unknown (log|int)");
+            }
+         }
+         if (parameter.upper_bound < parameter.lower_bound) {
+            throw std::invalid_argument("The range of " + parameter.name + " is empty");
+         }
+         if (parameter.is_logarithmic && parameter.lower_bound <= 0.) {
+            throw std::invalid_argument("The logarithmic range of " + parameter.name + " should be positive");
+         }
+      }
+      else {
+         parameter.values = split(domain, '|');
+         parameter.values.erase(std::remove(parameter.values.begin(), parameter.values.end(), ""), parameter.values.end());
+         if (parameter.values.empty()) {
+            throw std::invalid_argument("The parameter " + parameter.name + " has no value");
+         }
+      }
+      return parameter;
+   }
+
+   // score
+
+   bool TuningScore::operator<(const TuningScore& other) const {
+      if (this->number_failures != other.number_failures) {
+         return this->number_failures < other.number_failures;
+      }
+      return this->metric_mean < other.metric_mean;
+   }
+
+   // option tuner
+
+   OptionTuner::OptionTuner(std::vector<TunedParameter> search_space, BenchmarkMetric metric, TuningStrategy strategy,
+         size_t number_configurations, unsigned int seed):
+         search_space(std::move(search_space)),
+         metric(metric),
+         strategy(strategy),
+         number_configurations(number_configurations),
+         generator(seed) {
+      if (this->search_space.empty()) {
+         throw std::invalid_argument("The search space of the tuner is empty");
+      }
+      if (this->number_configurations == 0) {
+         throw std::invalid_argument("The tuner should sample at least one configuration");
+      }
+   }
+
+   // one parameter per line; empty lines and lines starting with # are ignored
+   std::vector<TunedParameter> OptionTuner::read_search_space(std::istream& stream) {
+      std::vector<TunedParameter> search_space{};
+      std::string line;
+      while (std::getline(stream, line)) {
+         if (!line.empty() && line.find('#') != 0 && line.find_first_not_of(" \t\r") != std::string::npos) {
+            search_space.emplace_back(TunedParameter::from_line(line));
+         }
+      }
+      return search_space;
+   }
+
+   TuningStrategy OptionTuner::strategy_from_string(const std::string& strategy) {
+      if (strategy == "random") {
+         return TuningStrategy::RANDOM;
+      }
+      else if (strategy == "successive_halving") {
+         return TuningStrategy::SUCCESSIVE_HALVING;
+      }
+      throw std::invalid_argument("The tuning strategy " + strategy + " is unknown (random|successive_halving)");
+   }
+
+   TuningScore OptionTuner::score(const std::vector<BenchmarkRecord>& records, BenchmarkMetric metric) {
+      TuningScore score{};
+      const double shift = metric_shift(metric);
+      double sum_logarithms = 0.;
+      size_t number_solved = 0;
+      for (const BenchmarkRecord& record: records) {
+         if (record.solved) {
+            sum_logarithms += std::log(benchmark_metric_value(record, metric) + shift);
+            number_solved++;
+         }
+         else {
+            score.number_failures++;
+         }
+      }
+      score.metric_mean = (0 < number_solved) ? std::exp(sum_logarithms / static_cast<double>(number_solved)) - shift : 0.;
+      return score;
+   }
+
+   // the options of the preset (if tuned) are written first, so that the file is self-contained
+   void OptionTuner::write_option_file(std::ostream& stream, const TunedConfiguration& configuration) {
+      stream << "# configuration " << configuration.name << ": " << configuration.score.number_failures << " unsolved models, mean metric " <<
+            configuration.score.metric_mean << " over " << configuration.number_models << " models\n";
+      const auto preset = configuration.parameters.find("preset");
+      if (preset != configuration.parameters.end()) {
+         stream << "# preset " << preset->second << '\n';
+         for (const auto& [option_name, option_value]: Presets::get_preset_options(preset->second)) {
+            if (configuration.parameters.find(option_name) == configuration.parameters.end()) {
+               stream << option_name << ' ' << option_value << '\n';
+            }
+         }
+      }
+      stream << "# tuned options\n";
+      for (const auto& [option_name, option_value]: configuration.parameters) {
+         stream << option_name << ' ' << option_value << '\n';
+      }
+   }
+
+   TunedConfiguration OptionTuner::tune(size_t number_models, const Evaluator& evaluate) {
+      if (number_models == 0) {
+         throw std::invalid_argument("The training set of the tuner is empty");
+      }
+      std::vector<TunedConfiguration> configurations = this->sample_configurations();
+      const auto by_score = [](const TunedConfiguration& configuration1, const TunedConfiguration& configuration2) {
+         return configuration1.score < configuration2.score;
+      };
+      if (this->strategy == TuningStrategy::RANDOM) {
+         for (TunedConfiguration& configuration: configurations) {
+            this->evaluate_configuration(configuration, number_models, evaluate);
+         }
+         std::stable_sort(configurations.begin(), configurations.end(), by_score);
+         return configurations.front();
+      }
+
+      // successive halving: number of rungs such that a single configuration survives
+      size_t number_rungs = 0;
+      size_t rung_models = number_models;
+      for (size_t number_survivors = configurations.size(); 1 < number_survivors;
+           number_survivors = (number_survivors + OptionTuner::reduction_factor - 1) / OptionTuner::reduction_factor) {
+         number_rungs++;
+         rung_models = std::max(size_t(1), rung_models / OptionTuner::reduction_factor);
+      }
+      while (true) {
+         for (TunedConfiguration& configuration: configurations) {
+            this->evaluate_configuration(configuration, rung_models, evaluate);
+         }
+         std::stable_sort(configurations.begin(), configurations.end(), by_score);
+         if (configurations.size() == 1 || rung_models == number_models) {
+            break;
+         }
+         configurations.resize((configurations.size() + OptionTuner::reduction_factor - 1) / OptionTuner::reduction_factor);
+         rung_models = std::min(number_models, rung_models * OptionTuner::reduction_factor);
+      }
+      // the winner is scored on the whole training set
+      TunedConfiguration& best_configuration = configurations.front();
+      if (best_configuration.number_models < number_models) {
+         this->evaluate_configuration(best_configuration, number_models, evaluate);
+      }
+      return best_configuration;
+   }
+
+   std::vector<TunedConfiguration> OptionTuner::sample_configurations() {
+      std::vector<TunedConfiguration> configurations(this->number_configurations);
+      for (size_t configuration_index: Range(this->number_configurations)) {
+         TunedConfiguration& configuration = configurations[configuration_index];
+         configuration.name = "tuned_" + std::to_string(configuration_index);
+         for (const TunedParameter& parameter: this->search_space) {
+            configuration.parameters[parameter.name] = parameter.sample(this->generator);
+         }
+      }
+      return configurations;
+   }
+
+   void OptionTuner::evaluate_configuration(TunedConfiguration& configuration, size_t number_models, const Evaluator& evaluate) {
+      Options parameters(false);
+      for (const auto& [option_name, option_value]: configuration.parameters) {
+         parameters[option_name] = option_value;
+      }
+      configuration.score = OptionTuner::score(evaluate(configuration.name, parameters, number_models), this->metric);
+      configuration.number_models = number_models;
+      this->history.emplace_back(configuration);
+   }
+} // namespace
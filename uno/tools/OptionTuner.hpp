@@ -0,0 +1,93 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_OPTIONTUNER_H
+#define UNO_OPTIONTUNER_H
+
+#include <functional>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "BenchmarkReport.hpp"
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   // dimension of the search space, one per line of a search-space file:
+   // - "name value|value|...": categorical values (e.g. "preset filtersqp|funnelsqp|ipopt")
+   // - "name lower:upper[:log][:int]": range of numerical values, sampled uniformly (or log-uniformly), possibly rounded to integers
+   struct TunedParameter {
+      std::string name;
+      std::vector<std::string> values{}; // categorical parameter if not empty
+      double lower_bound{0.};
+      double upper_bound{0.};
+      bool is_logarithmic{false};
+      bool is_integer{false};
+
+      [[nodiscard]] std::string sample(std::mt19937& generator) const;
+      [[nodiscard]] static TunedParameter from_line(const std::string& line);
+   };
+
+   // score of a configuration on a set of models, compared lexicographically: number of unsolved models, then shifted geometric
+   // mean of the metric over the solved models
+   struct TuningScore {
+      size_t number_failures{0};
+      double metric_mean{0.};
+
+      [[nodiscard]] bool operator<(const TuningScore& other) const;
+   };
+
+   struct TunedConfiguration {
+      std::string name;
+      std::map<std::string, std::string> parameters{};
+      TuningScore score{};
+      size_t number_models{0}; // number of models on which the score was computed
+   };
+
+   enum class TuningStrategy {RANDOM, SUCCESSIVE_HALVING};
+
+   /*! \class OptionTuner
+    * \brief Search of the option values that minimize a benchmark metric over a training set of models
+    *
+    *  The configurations are sampled at random in the search space. The random search scores all of them on the whole training set.
+    *  Successive halving (Jamieson and Talwalkar, 2016) scores them on a small subset of the models, keeps the best 1/eta and
+    *  multiplies the number of models by eta until the whole training set is used. The models are evaluated by a user function
+    *  (typically the benchmark harness) that solves the first number_models models of the training set with the given options
+    */
+   class OptionTuner {
+   public:
+      using Evaluator = std::function<std::vector<BenchmarkRecord>(const std::string& configuration_name, const Options& parameters,
+            size_t number_models)>;
+
+      OptionTuner(std::vector<TunedParameter> search_space, BenchmarkMetric metric, TuningStrategy strategy, size_t number_configurations,
+            unsigned int seed);
+
+      [[nodiscard]] static std::vector<TunedParameter> read_search_space(std::istream& stream);
+      [[nodiscard]] static TuningStrategy strategy_from_string(const std::string& strategy);
+      [[nodiscard]] static TuningScore score(const std::vector<BenchmarkRecord>& records, BenchmarkMetric metric);
+      // option file readable by Options::load_option_file
+      static void write_option_file(std::ostream& stream, const TunedConfiguration& configuration);
+
+      [[nodiscard]] TunedConfiguration tune(size_t number_models, const Evaluator& evaluate);
+      [[nodiscard]] const std::vector<TunedConfiguration>& get_history() const { return this->history; }
+
+      static constexpr size_t reduction_factor{3}; // eta of successive halving
+
+   protected:
+      const std::vector<TunedParameter> search_space;
+      const BenchmarkMetric metric;
+      const TuningStrategy strategy;
+      const size_t number_configurations;
+      std::mt19937 generator;
+      std::vector<TunedConfiguration> history{}; // all the scored configurations
+
+      [[nodiscard]] std::vector<TunedConfiguration> sample_configurations();
+      void evaluate_configuration(TunedConfiguration& configuration, size_t number_models, const Evaluator& evaluate);
+   };
+} // namespace
+
+#endif // UNO_OPTIONTUNER_H
@@ -0,0 +1,63 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include "Profiler.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   namespace {
+      thread_local Profiler* installed_profiler{nullptr};
+   } // namespace
+
+   Profiler::Profiler(): phases{Phase{"", 0}} {
+   }
+
+   void Profiler::start_phase(std::string_view name) {
+      // the children of a phase are few: linear search
+      size_t child_index = this->phases.size();
+      for (size_t phase_index: Range(1, this->phases.size())) {
+         if (this->phases[phase_index].parent == this->current_phase && this->phases[phase_index].name == name) {
+            child_index = phase_index;
+            break;
+         }
+      }
+      if (child_index == this->phases.size()) {
+         this->phases.push_back(Phase{std::string(name), this->current_phase});
+      }
+      this->current_phase = child_index;
+      this->phases[child_index].start_time = std::chrono::steady_clock::now();
+   }
+
+   void Profiler::end_phase() {
+      Phase& phase = this->phases[this->current_phase];
+      phase.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - phase.start_time).count();
+      phase.calls++;
+      this->current_phase = phase.parent;
+   }
+
+   std::vector<PhaseTiming> Profiler::get_phase_timings() const {
+      std::vector<PhaseTiming> phase_timings{};
+      phase_timings.reserve(this->phases.size() - 1);
+      for (size_t phase_index: Range(1, this->phases.size())) {
+         phase_timings.push_back({this->path(phase_index), this->phases[phase_index].calls, this->phases[phase_index].time});
+      }
+      return phase_timings;
+   }
+
+   std::string Profiler::path(size_t phase_index) const {
+      const Phase& phase = this->phases[phase_index];
+      return (phase.parent == 0) ? phase.name : this->path(phase.parent) + "/" + phase.name;
+   }
+
+   Profiler* Profiler::current() {
+      return installed_profiler;
+   }
+
+   Profiler::Scope::Scope(Profiler* profiler): previous_profiler(installed_profiler) {
+      installed_profiler = profiler;
+   }
+
+   Profiler::Scope::~Scope() {
+      installed_profiler = this->previous_profiler;
+   }
+} // namespace
@@ -0,0 +1,84 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PROFILER_H
+#define UNO_PROFILER_H
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Timeline.hpp"
+
+namespace uno {
+   // wall-clock time spent in a phase, identified by its path in the phase hierarchy (e.g. "globalization/subproblem/factorization")
+   struct PhaseTiming {
+      std::string path;
+      size_t calls;
+      double time; // in seconds
+   };
+
+   // hierarchical wall-clock profiler of a solve. The profiler of a solve is installed on the solving thread for its duration
+   // (see Scope): the phases are then measured by ScopedTimer objects. Without a profiler (or on other threads), they cost a
+   // single thread-local check
+   class Profiler {
+   public:
+      Profiler();
+
+      void start_phase(std::string_view name);
+      void end_phase();
+      [[nodiscard]] std::vector<PhaseTiming> get_phase_timings() const;
+
+      // profiler installed on the calling thread, or nullptr
+      [[nodiscard]] static Profiler* current();
+
+      // installs a profiler on the calling thread and restores the previous one upon destruction
+      class Scope {
+      public:
+         explicit Scope(Profiler* profiler);
+         ~Scope();
+         Scope(const Scope&) = delete;
+         Scope& operator=(const Scope&) = delete;
+
+      private:
+         Profiler* const previous_profiler;
+      };
+
+   protected:
+      struct Phase {
+         std::string name;
+         size_t parent;
+         size_t calls{0};
+         double time{0.};
+         std::chrono::steady_clock::time_point start_time{};
+      };
+      // the root (index 0) is the whole solve
+      std::vector<Phase> phases;
+      size_t current_phase{0};
+
+      [[nodiscard]] std::string path(size_t phase_index) const;
+   };
+
+   // measures the scope as a phase of the current profiler and as an event of the current timeline. The name should outlive the scope
+   class ScopedTimer {
+   public:
+      explicit ScopedTimer(std::string_view name): profiler(Profiler::current()), timeline_event(Timeline::current(), name) {
+         if (this->profiler != nullptr) {
+            this->profiler->start_phase(name);
+         }
+      }
+      ~ScopedTimer() {
+         if (this->profiler != nullptr) {
+            this->profiler->end_phase();
+         }
+      }
+      ScopedTimer(const ScopedTimer&) = delete;
+      ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+   private:
+      Profiler* const profiler;
+      const Timeline::Event timeline_event;
+   };
+} // namespace
+
+#endif // UNO_PROFILER_H
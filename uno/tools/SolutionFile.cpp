@@ -0,0 +1,110 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "SolutionFile.hpp"
+#include "optimization/Result.hpp"
+
+namespace uno {
+   namespace {
+      constexpr char magic[] = "UNOSOLN";
+      static_assert(sizeof(magic) == sizeof(SolutionFileHeader::magic));
+      static_assert(sizeof(SolutionFileHeader) % sizeof(double) == 0);
+
+      void write_array(std::ofstream& file, const double* values, size_t size) {
+         file.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(size * sizeof(double)));
+      }
+
+      void read_array(std::ifstream& file, const std::string& file_name, std::vector<double>& values, std::uint64_t size) {
+         values.resize(static_cast<size_t>(size));
+         file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(double)));
+         if (!file) {
+            throw std::runtime_error("The solution file " + file_name + " is truncated");
+         }
+      }
+   } // namespace
+
+   void SolutionFile::write(const std::string& file_name, const Result& result) {
+      const std::string temporary_file_name = file_name + ".tmp";
+      std::ofstream file(temporary_file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!file) {
+         throw std::runtime_error("The solution file " + temporary_file_name + " could not be opened");
+      }
+      SolutionFileHeader header{};
+      std::memcpy(header.magic, magic, sizeof(magic));
+      header.version = SolutionFile::version;
+      header.optimization_status = static_cast<std::uint64_t>(result.optimization_status);
+      header.iterate_status = static_cast<std::uint64_t>(result.solution.status);
+      header.number_variables = result.number_variables;
+      header.number_constraints = result.number_constraints;
+      header.iterations = result.iteration;
+      header.objective = result.solution.evaluations.objective;
+      header.primal_feasibility = result.solution.primal_feasibility;
+      header.stationarity = result.solution.residuals.stationarity;
+      header.complementarity = result.solution.residuals.complementarity;
+      header.objective_multiplier = result.solution.objective_multiplier;
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      // the iterate may have additional (e.g. elastic) variables at the end
+      write_array(file, result.solution.primals.data(), result.number_variables);
+      write_array(file, result.solution.multipliers.constraints.data(), result.number_constraints);
+      write_array(file, result.solution.multipliers.lower_bounds.data(), result.number_variables);
+      write_array(file, result.solution.multipliers.upper_bounds.data(), result.number_variables);
+      file.close();
+      if (!file) {
+         throw std::runtime_error("The solution file " + temporary_file_name + " could not be written");
+      }
+      if (std::rename(temporary_file_name.c_str(), file_name.c_str()) != 0) {
+         throw std::runtime_error("The solution file " + temporary_file_name + " could not be renamed to " + file_name);
+      }
+   }
+
+   size_t SolutionFile::primals_offset() {
+      return sizeof(SolutionFileHeader);
+   }
+
+   size_t SolutionFile::constraint_multipliers_offset(const SolutionFileHeader& header) {
+      return SolutionFile::primals_offset() + static_cast<size_t>(header.number_variables) * sizeof(double);
+   }
+
+   size_t SolutionFile::lower_bound_multipliers_offset(const SolutionFileHeader& header) {
+      return SolutionFile::constraint_multipliers_offset(header) + static_cast<size_t>(header.number_constraints) * sizeof(double);
+   }
+
+   size_t SolutionFile::upper_bound_multipliers_offset(const SolutionFileHeader& header) {
+      return SolutionFile::lower_bound_multipliers_offset(header) + static_cast<size_t>(header.number_variables) * sizeof(double);
+   }
+
+   size_t SolutionFile::file_size(const SolutionFileHeader& header) {
+      return SolutionFile::upper_bound_multipliers_offset(header) + static_cast<size_t>(header.number_variables) * sizeof(double);
+   }
+
+   SolutionFileContents SolutionFileContents::read(const std::string& file_name) {
+      std::ifstream file(file_name, std::ios::in | std::ios::binary | std::ios::ate);
+      if (!file) {
+         throw std::runtime_error("The solution file " + file_name + " could not be opened");
+      }
+      const auto actual_size = static_cast<size_t>(file.tellg());
+      file.seekg(0);
+      SolutionFileContents contents{};
+      file.read(reinterpret_cast<char*>(&contents.header), sizeof(SolutionFileHeader));
+      if (!file || std::memcmp(contents.header.magic, magic, sizeof(magic)) != 0) {
+         throw std::runtime_error("The file " + file_name + " is not a solution file");
+      }
+      if (contents.header.version != SolutionFile::version) {
+         throw std::runtime_error("The solution file " + file_name + " has version " + std::to_string(contents.header.version) +
+            " instead of " + std::to_string(SolutionFile::version));
+      }
+      // a corrupted header would allocate arbitrarily large arrays
+      if (actual_size != SolutionFile::file_size(contents.header)) {
+         throw std::runtime_error("The solution file " + file_name + " is truncated");
+      }
+      read_array(file, file_name, contents.primals, contents.header.number_variables);
+      read_array(file, file_name, contents.constraint_multipliers, contents.header.number_constraints);
+      read_array(file, file_name, contents.lower_bound_multipliers, contents.header.number_variables);
+      read_array(file, file_name, contents.upper_bound_multipliers, contents.header.number_variables);
+      return contents;
+   }
+} // namespace
@@ -0,0 +1,62 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SOLUTIONFILE_H
+#define UNO_SOLUTIONFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace uno {
+   // forward declaration
+   struct Result;
+
+   // header of a binary solution file. All the fields are 8 bytes wide, so that the arrays that follow the header are aligned
+   struct SolutionFileHeader {
+      char magic[8]; /*!< "UNOSOLN" */
+      std::uint64_t version;
+      std::uint64_t optimization_status; /*!< OptimizationStatus */
+      std::uint64_t iterate_status; /*!< IterateStatus */
+      std::uint64_t number_variables;
+      std::uint64_t number_constraints;
+      std::uint64_t iterations;
+      double objective;
+      double primal_feasibility;
+      double stationarity;
+      double complementarity;
+      double objective_multiplier;
+   };
+
+   // binary primal-dual solution of a solve (option solution_file), much faster to write and read than the text outputs for very
+   // large models. The format is: the header, then the primals (number_variables doubles), the constraint multipliers
+   // (number_constraints), the lower bound multipliers and the upper bound multipliers (number_variables each), in native
+   // endianness. The file can be memory-mapped: the arrays start at the offsets below. The file is written under a temporary name
+   // and renamed once complete
+   class SolutionFile {
+   public:
+      static constexpr std::uint64_t version = 1;
+
+      static void write(const std::string& file_name, const Result& result);
+
+      // offsets (in bytes) of the arrays
+      [[nodiscard]] static size_t primals_offset();
+      [[nodiscard]] static size_t constraint_multipliers_offset(const SolutionFileHeader& header);
+      [[nodiscard]] static size_t lower_bound_multipliers_offset(const SolutionFileHeader& header);
+      [[nodiscard]] static size_t upper_bound_multipliers_offset(const SolutionFileHeader& header);
+      [[nodiscard]] static size_t file_size(const SolutionFileHeader& header);
+   };
+
+   // contents of a binary solution file
+   struct SolutionFileContents {
+      SolutionFileHeader header{};
+      std::vector<double> primals{};
+      std::vector<double> constraint_multipliers{};
+      std::vector<double> lower_bound_multipliers{};
+      std::vector<double> upper_bound_multipliers{};
+
+      [[nodiscard]] static SolutionFileContents read(const std::string& file_name);
+   };
+} // namespace
+
+#endif // UNO_SOLUTIONFILE_H
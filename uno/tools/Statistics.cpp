@@ -4,8 +4,11 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <limits>
 #include "Statistics.hpp"
+#include "optimization/EvaluationCounters.hpp"
 #include "options/Options.hpp"
+#include "tools/Logger.hpp"
 
 namespace uno {
    // TODO move this to the option file
@@ -14,35 +17,115 @@ namespace uno {
    int Statistics::string_width = 26;
    int Statistics::numerical_format_size = 4;
 
-   Statistics::Statistics(const Options& options): print_header_frequency(options.get_unsigned_int("statistics_print_header_frequency")) { }
+   Statistics::Statistics(const Options& options):
+         print_header_frequency(options.get_unsigned_int("statistics_print_header_frequency")),
+         // the table is printed only at level INFO
+         is_printing(Logger::level == INFO),
+         trace(options.get_string("statistics_trace_file").empty() ? nullptr :
+            std::make_unique<IterationTrace>(options.get_string("statistics_trace_file"), options.get_string("statistics_trace_format"))) {
+   }
+
+   Statistics::~Statistics() {
+      // flush the last line
+      if (this->trace != nullptr && this->is_line_started) {
+         this->set_line_timings();
+         this->write_trace_record();
+      }
+   }
 
+   // a column with a negative order is hidden
    void Statistics::add_column(std::string_view name, int width, int order) {
+      if (order < 0) {
+         return;
+      }
       this->columns[order] = name;
       this->widths[name] = width;
    }
    
    void Statistics::start_new_line() {
-      for (const auto& column: this->columns) {
-         this->current_line[column.second] = "-";
+      if (this->trace != nullptr) {
+         if (this->is_line_started) {
+            this->set_line_timings();
+            this->write_trace_record();
+         }
+         this->numerical_values.clear();
+         this->is_line_started = true;
+      }
+      this->line_start_time = std::chrono::steady_clock::now();
+      this->line_start_evaluation_time = EvaluationCounters::current().time;
+      if (this->is_printing) {
+         for (const auto& column: this->columns) {
+            this->current_line[column.second] = "-";
+         }
       }
    }
 
    void Statistics::set(std::string_view name, std::string value) {
-      this->current_line[name] = std::move(value);
+      if (this->is_printing) {
+         this->current_line[name] = std::move(value);
+      }
    }
 
    void Statistics::set(std::string_view name, int value) {
-      this->set(name, std::to_string(value));
+      this->set_numerical_value(name, static_cast<double>(value));
+      if (this->is_printing) {
+         this->current_line[name] = std::to_string(value);
+      }
    }
 
    void Statistics::set(std::string_view name, size_t value) {
-      this->set(name, std::to_string(value));
+      this->set_numerical_value(name, static_cast<double>(value));
+      if (this->is_printing) {
+         this->current_line[name] = std::to_string(value);
+      }
    }
 
    void Statistics::set(std::string_view name, double value) {
-      std::ostringstream stream;
-      stream << std::scientific << std::setprecision(Statistics::numerical_format_size) << value;
-      this->set(name, stream.str());
+      this->set_numerical_value(name, value);
+      if (this->is_printing) {
+         std::ostringstream stream;
+         stream << std::scientific << std::setprecision(Statistics::numerical_format_size) << value;
+         this->current_line[name] = stream.str();
+      }
+   }
+
+   // wall time and evaluation time elapsed since the start of the line
+   void Statistics::set_line_timings() {
+      if (this->widths.find("iter time") != this->widths.end()) {
+         this->set("iter time", std::chrono::duration<double>(std::chrono::steady_clock::now() - this->line_start_time).count());
+      }
+      if (this->widths.find("eval time") != this->widths.end()) {
+         this->set("eval time", EvaluationCounters::current().time - this->line_start_evaluation_time);
+      }
+   }
+
+   void Statistics::set_numerical_value(std::string_view name, double value) {
+      if (this->trace != nullptr) {
+         this->numerical_values[name] = value;
+      }
+   }
+
+   void Statistics::write_trace_record() {
+      // the fields are the columns known when the first record is written
+      if (!this->trace->has_fields()) {
+         std::vector<std::string> column_names{};
+         column_names.reserve(this->columns.size());
+         for (const auto& column: this->columns) {
+            column_names.push_back(column.second);
+         }
+         this->trace->write_fields(column_names);
+         this->trace_record.resize(column_names.size());
+      }
+      size_t field_index = 0;
+      for (const auto& column: this->columns) {
+         if (field_index < this->trace_record.size()) {
+            const auto value = this->numerical_values.find(column.second);
+            this->trace_record[field_index] = (value != this->numerical_values.end()) ? value->second : std::numeric_limits<double>::quiet_NaN();
+            field_index++;
+         }
+      }
+      const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->start_time).count();
+      this->trace->write_record(time, this->trace_record);
    }
    
    void Statistics::print_horizontal_line() {
@@ -83,6 +166,7 @@ namespace uno {
    }
 
    void Statistics::print_current_line() {
+      this->set_line_timings();
       if (this->line_number % this->print_header_frequency == 0) {
          this->print_header();
       }
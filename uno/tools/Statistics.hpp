@@ -4,16 +4,23 @@
 #ifndef UNO_STATISTICS_H
 #define UNO_STATISTICS_H
 
+#include <chrono>
 #include <string_view>
 #include <map>
+#include <memory>
+#include "IterationTrace.hpp"
 
 namespace uno {
    // forward declaration
    class Options;
 
+   // the values are captured only if the table is printed (logger level INFO) or if an iteration trace is written:
+   // otherwise, set() is a no-op
    class Statistics {
    public:
       explicit Statistics(const Options& options);
+      ~Statistics();
+      Statistics(Statistics&& other) = default;
 
       static int int_width;
       static int double_width;
@@ -40,6 +47,20 @@ namespace uno {
       std::map<std::string_view, std::string> current_line{};
 
       const size_t print_header_frequency{};
+      const bool is_printing;
+      // optional structured trace of the numerical values
+      std::unique_ptr<IterationTrace> trace;
+      std::map<std::string_view, double> numerical_values{};
+      std::vector<double> trace_record{};
+      bool is_line_started{false};
+      const std::chrono::steady_clock::time_point start_time{std::chrono::steady_clock::now()};
+      // reference points of the "iter time" and "eval time" columns
+      std::chrono::steady_clock::time_point line_start_time{std::chrono::steady_clock::now()};
+      double line_start_evaluation_time{0.};
+
+      void set_line_timings();
+      void set_numerical_value(std::string_view name, double value);
+      void write_trace_record();
       static std::string_view symbol(std::string_view value);
    };
 } // namespace
@@ -0,0 +1,246 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <chrono>
+#include <stdexcept>
+#include "ThreadPool.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace uno {
+   namespace {
+      // pool installed on the thread, and index of the queue of the thread in this pool (0 outside the workers)
+      thread_local ThreadPool* installed_pool{nullptr};
+      thread_local size_t worker_queue_index{0};
+
+      void pin_to_core(std::thread& thread, size_t core_index) {
+#ifdef __linux__
+         const size_t number_cores = std::max(size_t(1), static_cast<size_t>(std::thread::hardware_concurrency()));
+         cpu_set_t cpu_set;
+         CPU_ZERO(&cpu_set);
+         CPU_SET(core_index % number_cores, &cpu_set);
+         if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpu_set) != 0) {
+            WARNING << "The worker " << core_index << " of the thread pool could not be pinned to a core\n";
+         }
+#else
+         (void) thread;
+         (void) core_index;
+#endif
+      }
+   } // namespace
+
+   ThreadPool::ThreadPool(size_t number_threads, ThreadAffinity affinity) {
+      if (number_threads == 0) {
+         throw std::invalid_argument("The thread pool should have at least one thread");
+      }
+#ifndef __linux__
+      if (affinity != ThreadAffinity::NONE) {
+         WARNING << "The thread affinity is only supported on Linux: the threads of the pool are not pinned\n";
+      }
+#endif
+      for ([[maybe_unused]] size_t queue_index: Range(number_threads)) {
+         this->queues.emplace_back(std::make_unique<TaskQueue>());
+      }
+      this->workers.reserve(number_threads - 1);
+      for (size_t worker_index: Range(1, number_threads)) {
+         this->workers.emplace_back(&ThreadPool::work, this, worker_index);
+         if (affinity == ThreadAffinity::COMPACT) {
+            pin_to_core(this->workers.back(), worker_index);
+         }
+      }
+   }
+
+   ThreadPool::~ThreadPool() {
+      {
+         const std::lock_guard<std::mutex> lock(this->sleep_mutex);
+         this->stopping = true;
+      }
+      this->wake_up.notify_all();
+      for (std::thread& worker: this->workers) {
+         worker.join();
+      }
+   }
+
+   std::unique_ptr<ThreadPool> ThreadPool::create(const Options& options) {
+      const size_t number_threads = options.get_unsigned_int("threads");
+      const std::string& affinity_option = options.get_string("thread_affinity");
+      ThreadAffinity affinity;
+      if (affinity_option == "none") {
+         affinity = ThreadAffinity::NONE;
+      }
+      else if (affinity_option == "compact") {
+         affinity = ThreadAffinity::COMPACT;
+      }
+      else {
+         throw std::invalid_argument("The thread affinity " + affinity_option + " is unknown");
+      }
+      if (number_threads <= 1) {
+         return nullptr;
+      }
+      return std::make_unique<ThreadPool>(number_threads, affinity);
+   }
+
+   size_t ThreadPool::number_threads() const {
+      return this->queues.size();
+   }
+
+   ThreadPool* ThreadPool::current() {
+      return installed_pool;
+   }
+
+   size_t ThreadPool::available_threads() {
+      if (installed_pool != nullptr) {
+         return installed_pool->number_threads();
+      }
+      return std::max(size_t(1), static_cast<size_t>(std::thread::hardware_concurrency()));
+   }
+
+   int ThreadPool::linear_solver_threads(const Options& options, const std::string& option_name) {
+      const int number_threads = options.get_int(option_name);
+      if (number_threads < 0) {
+         throw std::invalid_argument("The option " + option_name + " should be nonnegative");
+      }
+      return (0 < number_threads) ? number_threads : static_cast<int>(options.get_unsigned_int("threads"));
+   }
+
+   void ThreadPool::work(size_t worker_index) {
+      installed_pool = this;
+      worker_queue_index = worker_index;
+#ifdef _OPENMP
+      // the OpenMP regions of the tasks do not add threads to those of the pool
+      omp_set_num_threads(1);
+#endif
+      Task task;
+      while (true) {
+         if (this->pop_task(task)) {
+            this->execute(task);
+            continue;
+         }
+         std::unique_lock<std::mutex> lock(this->sleep_mutex);
+         this->wake_up.wait(lock, [&] {
+            return this->stopping || 0 < this->queued_tasks.load(std::memory_order_acquire);
+         });
+         if (this->stopping) {
+            return;
+         }
+      }
+   }
+
+   void ThreadPool::submit(const Task& task) {
+      TaskQueue& queue = *this->queues[(installed_pool == this) ? worker_queue_index : 0];
+      bool is_queued = false;
+      {
+         const std::lock_guard<std::mutex> lock(queue.mutex);
+         if (queue.size < queue_capacity) {
+            queue.tasks[(queue.first + queue.size) % queue_capacity] = task;
+            queue.size++;
+            this->queued_tasks.fetch_add(1, std::memory_order_release);
+            is_queued = true;
+         }
+      }
+      // the queue is full: the task is executed right away
+      if (!is_queued) {
+         this->execute(task);
+         return;
+      }
+      // an empty critical section: a worker that has just found no task cannot miss the notification
+      { const std::lock_guard<std::mutex> lock(this->sleep_mutex); }
+      this->wake_up.notify_one();
+   }
+
+   bool ThreadPool::pop_task(Task& task) {
+      const size_t own_queue_index = (installed_pool == this) ? worker_queue_index : 0;
+      // most recent task of the own queue
+      {
+         TaskQueue& queue = *this->queues[own_queue_index];
+         const std::lock_guard<std::mutex> lock(queue.mutex);
+         if (0 < queue.size) {
+            queue.size--;
+            task = queue.tasks[(queue.first + queue.size) % queue_capacity];
+            this->queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+         }
+      }
+      // oldest task of the other queues
+      const size_t number_queues = this->queues.size();
+      for (size_t offset: Range(1, number_queues)) {
+         TaskQueue& queue = *this->queues[(own_queue_index + offset) % number_queues];
+         const std::lock_guard<std::mutex> lock(queue.mutex);
+         if (0 < queue.size) {
+            task = queue.tasks[queue.first];
+            queue.first = (queue.first + 1) % queue_capacity;
+            queue.size--;
+            this->queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+         }
+      }
+      return false;
+   }
+
+   void ThreadPool::execute(const Task& task) {
+      TaskGroup& group = *task.group;
+      try {
+         task.function(task.body, task.begin, task.end);
+      }
+      catch (...) {
+         const std::lock_guard<std::mutex> lock(group.error_mutex);
+         if (!group.error) {
+            group.error = std::current_exception();
+         }
+      }
+      if (group.pending_tasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+         // the last task of the group wakes up the waiting thread
+         { const std::lock_guard<std::mutex> lock(this->sleep_mutex); }
+         this->wake_up.notify_all();
+      }
+   }
+
+   void ThreadPool::wait(TaskGroup& group) {
+      Task task;
+      while (0 < group.pending_tasks.load(std::memory_order_acquire)) {
+         if (this->pop_task(task)) {
+            this->execute(task);
+         }
+         else {
+            // the remaining tasks of the group are being executed by other threads
+            std::unique_lock<std::mutex> lock(this->sleep_mutex);
+            this->wake_up.wait_for(lock, std::chrono::milliseconds(1), [&] {
+               return group.pending_tasks.load(std::memory_order_acquire) == 0 || 0 < this->queued_tasks.load(std::memory_order_acquire);
+            });
+         }
+      }
+      if (group.error) {
+         std::rethrow_exception(group.error);
+      }
+   }
+
+   // the OpenMP regions of the workers remain sequential
+   ThreadPool::Scope::Scope(ThreadPool* pool): previous_pool(installed_pool), bounds_openmp_threads(pool != nullptr && worker_queue_index == 0),
+#ifdef _OPENMP
+         previous_openmp_threads(omp_get_max_threads()) {
+      if (this->bounds_openmp_threads) {
+         omp_set_num_threads(static_cast<int>(pool->number_threads()));
+      }
+#else
+         previous_openmp_threads(1) {
+#endif
+      installed_pool = pool;
+   }
+
+   ThreadPool::Scope::~Scope() {
+#ifdef _OPENMP
+      if (this->bounds_openmp_threads) {
+         omp_set_num_threads(this->previous_openmp_threads);
+      }
+#endif
+      installed_pool = this->previous_pool;
+   }
+} // namespace
@@ -0,0 +1,174 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_THREADPOOL_H
+#define UNO_THREADPOOL_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   enum class ThreadAffinity {
+      NONE = 0, /* the threads are placed by the operating system */
+      COMPACT /* the worker i is pinned to the core i (Linux only) */
+   };
+
+   // tasks submitted together, and waited for together
+   class TaskGroup {
+   public:
+      TaskGroup() = default;
+      TaskGroup(const TaskGroup&) = delete;
+      TaskGroup& operator=(const TaskGroup&) = delete;
+
+   protected:
+      std::atomic<size_t> pending_tasks{0};
+      std::mutex error_mutex{};
+      std::exception_ptr error{};
+
+      friend class ThreadPool;
+   };
+
+   /*! \class ThreadPool
+    * \brief Work-stealing pool of threads shared by the parallel components of a solve
+    *
+    *  The pool has number_threads - 1 workers; the calling thread is the last one and executes tasks while it waits for them. Each
+    *  worker has its own queue: it pops its most recent task and steals the oldest task of the other queues when its queue is
+    *  empty. The tasks submitted by threads outside the pool go to a shared queue. The queues have a fixed capacity and the tasks
+    *  refer to the callables of the caller, so that submitting a task does not allocate memory (a task is executed by the submitting
+    *  thread when its queue is full). A waiting thread may execute the tasks of other groups: the tasks should install their own
+    *  thread-local context (evaluation counters, timeline, ...), as run_concurrently does.
+    *
+    *  The pool is installed on a thread for the duration of a solve (see Scope) and bounds the number of threads of the parallel
+    *  components: the OpenMP regions of the calling thread use number_threads threads, those of the workers are sequential, the
+    *  multistart/portfolio/decomposition runs are carried out by the workers, and the linear solvers whose number of threads is 0 use
+    *  number_threads threads
+    */
+   class ThreadPool {
+   public:
+      ThreadPool(size_t number_threads, ThreadAffinity affinity);
+      ~ThreadPool();
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+
+      // pool determined by the options threads and thread_affinity (nullptr if threads is 0 or 1)
+      [[nodiscard]] static std::unique_ptr<ThreadPool> create(const Options& options);
+
+      [[nodiscard]] size_t number_threads() const;
+      // calls body(index) for each index in [begin, end), in chunks distributed among the threads, and waits for them. The first
+      // exception raised by the body is raised again once all the chunks have completed
+      template <typename Body>
+      void parallel_for(size_t begin, size_t end, const Body& body);
+
+      // pool installed on the calling thread (the workers of a pool see their pool), or nullptr
+      [[nodiscard]] static ThreadPool* current();
+      // number of threads available to the calling thread: those of the installed pool, or the number of hardware threads
+      [[nodiscard]] static size_t available_threads();
+      // number of threads of a linear solver: the value of its option if positive, otherwise the option threads (0: solver default)
+      [[nodiscard]] static int linear_solver_threads(const Options& options, const std::string& option_name);
+
+      // installs a pool on the calling thread and bounds its OpenMP regions; the previous pool is restored upon destruction
+      class Scope {
+      public:
+         explicit Scope(ThreadPool* pool);
+         ~Scope();
+         Scope(const Scope&) = delete;
+         Scope& operator=(const Scope&) = delete;
+
+      private:
+         ThreadPool* const previous_pool;
+         const bool bounds_openmp_threads;
+         const int previous_openmp_threads;
+      };
+
+   protected:
+      static constexpr size_t queue_capacity = 256;
+
+      struct Task {
+         void (*function)(const void* body, size_t begin, size_t end){nullptr};
+         const void* body{nullptr};
+         size_t begin{0};
+         size_t end{0};
+         TaskGroup* group{nullptr};
+      };
+
+      // ring buffer of tasks
+      struct TaskQueue {
+         std::mutex mutex{};
+         std::array<Task, queue_capacity> tasks{};
+         size_t first{0};
+         size_t size{0};
+      };
+
+      // queue 0 is shared by the threads outside the pool, queue i belongs to the worker i
+      std::vector<std::unique_ptr<TaskQueue>> queues;
+      std::vector<std::thread> workers{};
+      std::atomic<size_t> queued_tasks{0};
+      std::mutex sleep_mutex{};
+      std::condition_variable wake_up{};
+      bool stopping{false};
+
+      void work(size_t worker_index);
+      void submit(const Task& task);
+      [[nodiscard]] bool pop_task(Task& task);
+      void execute(const Task& task);
+      void wait(TaskGroup& group);
+
+      template <typename Body>
+      static void run_chunk(const void* body, size_t begin, size_t end) {
+         const Body& typed_body = *static_cast<const Body*>(body);
+         for (size_t index = begin; index < end; index++) {
+            typed_body(index);
+         }
+      }
+   };
+
+   template <typename Body>
+   void ThreadPool::parallel_for(size_t begin, size_t end, const Body& body) {
+      if (end <= begin) {
+         return;
+      }
+      // a few chunks per thread balance the load
+      const size_t number_indices = end - begin;
+      const size_t number_chunks = std::min(number_indices, 4 * this->number_threads());
+      TaskGroup group;
+      group.pending_tasks.store(number_chunks, std::memory_order_relaxed);
+      for (size_t chunk_index = 0; chunk_index < number_chunks; chunk_index++) {
+         const size_t chunk_begin = begin + chunk_index * number_indices / number_chunks;
+         const size_t chunk_end = begin + (chunk_index + 1) * number_indices / number_chunks;
+         this->submit({&ThreadPool::run_chunk<Body>, &body, chunk_begin, chunk_end, &group});
+      }
+      this->wait(group);
+   }
+
+   // runs the worker function on number_workers threads, the calling thread being one of them (worker(0)): on the installed thread
+   // pool if any, on new threads otherwise
+   template <typename Worker>
+   void run_workers(size_t number_workers, const Worker& worker) {
+      if (ThreadPool* pool = ThreadPool::current(); pool != nullptr) {
+         pool->parallel_for(0, number_workers, worker);
+         return;
+      }
+      std::vector<std::thread> threads{};
+      for (size_t worker_index = 1; worker_index < number_workers; worker_index++) {
+         threads.emplace_back(worker, worker_index);
+      }
+      worker(0);
+      for (std::thread& thread: threads) {
+         thread.join();
+      }
+   }
+} // namespace
+
+#endif // UNO_THREADPOOL_H
@@ -0,0 +1,99 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include "Timeline.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/AllocationTracker.hpp"
+
+namespace uno {
+   namespace {
+      thread_local Timeline* installed_timeline{nullptr};
+      std::atomic<size_t> next_thread_id{1};
+
+      double microseconds(std::chrono::steady_clock::duration duration) {
+         return std::chrono::duration<double, std::micro>(duration).count();
+      }
+
+      void write_json_string(std::ostream& stream, const std::string& string) {
+         stream << '"';
+         for (char character: string) {
+            if (character == '"' || character == '\\') {
+               stream << '\\';
+            }
+            stream << character;
+         }
+         stream << '"';
+      }
+   } // namespace
+
+   Timeline::Timeline() {
+      this->records.reserve(1024);
+   }
+
+   void Timeline::record(std::string_view name, std::chrono::steady_clock::time_point start_time,
+         std::chrono::steady_clock::time_point end_time) {
+      const size_t thread = Timeline::thread_id();
+      // the timeline grows with the solve: its allocations are allowed in the main loop
+      const AllocationTracker::Prohibition allocation_permission(false);
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      size_t name_index = this->names.size();
+      for (size_t index: Range(this->names.size())) {
+         if (this->names[index] == name) {
+            name_index = index;
+            break;
+         }
+      }
+      if (name_index == this->names.size()) {
+         this->names.emplace_back(name);
+      }
+      this->records.push_back({name_index, thread, microseconds(start_time - this->origin), microseconds(end_time - start_time)});
+   }
+
+   size_t Timeline::number_events() const {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      return this->records.size();
+   }
+
+   void Timeline::write(std::ostream& stream) const {
+      const std::lock_guard<std::mutex> lock(this->mutex);
+      stream << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+      stream << std::fixed << std::setprecision(3);
+      for (size_t record_index: Range(this->records.size())) {
+         const Record& record = this->records[record_index];
+         stream << ((record_index == 0) ? "\n" : ",\n") << "{\"name\": ";
+         write_json_string(stream, this->names[record.name]);
+         stream << ", \"cat\": \"uno\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << record.thread << ", \"ts\": " << record.start_time <<
+               ", \"dur\": " << record.duration << "}";
+      }
+      stream << "\n]}\n";
+   }
+
+   void Timeline::write(const std::string& file_name) const {
+      std::ofstream file(file_name);
+      if (!file) {
+         throw std::runtime_error("The timeline file " + file_name + " could not be opened");
+      }
+      this->write(file);
+   }
+
+   Timeline* Timeline::current() {
+      return installed_timeline;
+   }
+
+   size_t Timeline::thread_id() {
+      thread_local const size_t id = next_thread_id++;
+      return id;
+   }
+
+   Timeline::Scope::Scope(Timeline* timeline): previous_timeline(installed_timeline) {
+      installed_timeline = timeline;
+   }
+
+   Timeline::Scope::~Scope() {
+      installed_timeline = this->previous_timeline;
+   }
+} // namespace
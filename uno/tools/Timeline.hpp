@@ -0,0 +1,89 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_TIMELINE_H
+#define UNO_TIMELINE_H
+
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace uno {
+   /*! \class Timeline
+    * \brief Timeline of the events of a solve (evaluations, assembly, factorizations, subproblems, trials)
+    *
+    *  Each event has a name, a begin and an end time, and the id of the thread on which it occurred. The events can be recorded
+    *  concurrently by several threads (e.g. the concurrent evaluations and the runs of a ParallelSolver). The timeline is written
+    *  in the Chrome trace event format (JSON), which is read by chrome://tracing and Perfetto (https://ui.perfetto.dev).
+    *  The timeline of a solve is installed on the solving thread for its duration (see Scope): the phases measured by ScopedTimer
+    *  are then recorded as events. On other threads, events are recorded explicitly (see Event)
+    */
+   class Timeline {
+   public:
+      Timeline();
+
+      // thread-safe
+      void record(std::string_view name, std::chrono::steady_clock::time_point start_time, std::chrono::steady_clock::time_point end_time);
+      [[nodiscard]] size_t number_events() const;
+      void write(std::ostream& stream) const;
+      void write(const std::string& file_name) const;
+
+      // timeline installed on the calling thread, or nullptr
+      [[nodiscard]] static Timeline* current();
+      // small id of the calling thread, in order of first use (the ids of the standard library are not printable numbers)
+      [[nodiscard]] static size_t thread_id();
+
+      // installs a timeline on the calling thread and restores the previous one upon destruction
+      class Scope {
+      public:
+         explicit Scope(Timeline* timeline);
+         ~Scope();
+         Scope(const Scope&) = delete;
+         Scope& operator=(const Scope&) = delete;
+
+      private:
+         Timeline* const previous_timeline;
+      };
+
+      // records the scope as an event of a timeline (if not nullptr) on the calling thread
+      class Event {
+      public:
+         Event(Timeline* timeline, std::string_view name): timeline(timeline), name(name) {
+            if (this->timeline != nullptr) {
+               this->start_time = std::chrono::steady_clock::now();
+            }
+         }
+         ~Event() {
+            if (this->timeline != nullptr) {
+               this->timeline->record(this->name, this->start_time, std::chrono::steady_clock::now());
+            }
+         }
+         Event(const Event&) = delete;
+         Event& operator=(const Event&) = delete;
+
+      private:
+         Timeline* const timeline;
+         const std::string_view name;
+         std::chrono::steady_clock::time_point start_time{};
+      };
+
+   protected:
+      struct Record {
+         size_t name; // index in the names
+         size_t thread;
+         double start_time; // in microseconds since the creation of the timeline
+         double duration; // in microseconds
+      };
+
+      const std::chrono::steady_clock::time_point origin{std::chrono::steady_clock::now()};
+      mutable std::mutex mutex{};
+      // the names are few: they are stored once
+      std::vector<std::string> names{};
+      std::vector<Record> records{};
+   };
+} // namespace
+
+#endif // UNO_TIMELINE_H
@@ -6,11 +6,11 @@
 #include <ctime>
 
 namespace uno {
-   Timer::Timer(): start_time(std::clock()) {
+   Timer::Timer(): start_time(std::chrono::steady_clock::now()) {
    }
 
    double Timer::get_duration() const {
-      return static_cast<double>(std::clock() - this->start_time) / static_cast<double>(CLOCKS_PER_SEC);
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->start_time).count();
    }
 
    char* Timer::get_current_date() {
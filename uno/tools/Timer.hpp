@@ -4,10 +4,10 @@
 #ifndef UNO_TIMER_H
 #define UNO_TIMER_H
 
-#include <ctime>
+#include <chrono>
 
 namespace uno {
-   // timer starts upon creation
+   // wall-clock timer (monotonic), starts upon creation. Unlike the process CPU time, it does not grow with the number of threads
    class Timer {
    public:
       Timer();
@@ -15,7 +15,7 @@ namespace uno {
       [[nodiscard]] static char* get_current_date();
 
    private:
-      std::clock_t start_time;
+      std::chrono::steady_clock::time_point start_time;
    };
 } // namespace
 
@@ -18,6 +18,8 @@ namespace uno {
       virtual void notify_acceptable_iterate(const Vector<double>& primals, const Multipliers& multipliers, double objective_multiplier) = 0;
       virtual void notify_new_primals(const Vector<double>& primals) = 0;
       virtual void notify_new_multipliers(const Multipliers& multipliers) = 0;
+      // polled after each iteration: the solve terminates as soon as it returns true
+      [[nodiscard]] virtual bool should_terminate() { return false; }
    };
 
    class NoUserCallbacks: public UserCallbacks {
@@ -0,0 +1,59 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <benchmark/benchmark.h>
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Expression.hpp"
+#include "symbolic/VectorView.hpp"
+
+using namespace uno;
+
+// trial step x + alpha d evaluated symbolically
+static void BM_SymbolicTrialStep(benchmark::State& state) {
+   const size_t size = static_cast<size_t>(state.range(0));
+   const Vector<double> x(size, 1.), direction(size, 2.);
+   Vector<double> trial_point(size);
+   const double step_length = 0.5;
+   for (auto _: state) {
+      trial_point = x + step_length * direction;
+      benchmark::DoNotOptimize(trial_point.data());
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+// same step with a hand-written loop
+static void BM_HandWrittenTrialStep(benchmark::State& state) {
+   const size_t size = static_cast<size_t>(state.range(0));
+   const Vector<double> x(size, 1.), direction(size, 2.);
+   Vector<double> trial_point(size);
+   const double step_length = 0.5;
+   for (auto _: state) {
+      const double* x_pointer = x.data();
+      const double* direction_pointer = direction.data();
+      double* trial_point_pointer = trial_point.data();
+      for (size_t index = 0; index < size; index++) {
+         trial_point_pointer[index] = x_pointer[index] + step_length * direction_pointer[index];
+      }
+      benchmark::DoNotOptimize(trial_point.data());
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+// negated view, as in the extraction of the multipliers from the augmented system solution
+static void BM_SymbolicNegatedView(benchmark::State& state) {
+   const size_t size = static_cast<size_t>(state.range(0));
+   const Vector<double> solution(2 * size, 1.);
+   Vector<double> multipliers(size);
+   for (auto _: state) {
+      multipliers = view(-solution, size, 2 * size);
+      benchmark::DoNotOptimize(multipliers.data());
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+BENCHMARK(BM_SymbolicTrialStep)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK(BM_HandWrittenTrialStep)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK(BM_SymbolicNegatedView)->RangeMultiplier(8)->Range(64, 1 << 18);
@@ -0,0 +1,52 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include "ingredients/globalization_strategies/switching_methods/filter_methods/filters/Filter.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+
+using namespace uno;
+
+// full filter whose entries lie on the front objective = 1 / infeasibility
+static Filter create_full_filter(size_t capacity) {
+   Options options = DefaultOptions::load();
+   options["filter_capacity"] = std::to_string(capacity);
+   Filter filter(options);
+   for (size_t entry_index = 0; entry_index < capacity; entry_index++) {
+      const double infeasibility = static_cast<double>(entry_index + 1);
+      filter.add(infeasibility, 1. / infeasibility);
+   }
+   return filter;
+}
+
+// acceptance tests of trial points spread along the front, as in a backtracking line search
+static void BM_FilterAcceptable(benchmark::State& state) {
+   const size_t capacity = static_cast<size_t>(state.range(0));
+   Filter filter = create_full_filter(capacity);
+   size_t trial_index = 0;
+   for (auto _: state) {
+      const double trial_infeasibility = static_cast<double>(trial_index % capacity) + 0.5;
+      benchmark::DoNotOptimize(filter.acceptable(trial_infeasibility, 1. / trial_infeasibility));
+      trial_index++;
+   }
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// insertion of an entry that dominates a single entry of a full filter
+static void BM_FilterAdd(benchmark::State& state) {
+   const size_t capacity = static_cast<size_t>(state.range(0));
+   Filter filter = create_full_filter(capacity);
+   size_t trial_index = 0;
+   for (auto _: state) {
+      const double infeasibility = static_cast<double>(trial_index % capacity + 1);
+      filter.add(infeasibility, 1. / infeasibility - 1e-12);
+      trial_index++;
+   }
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// capacities from the default filter_capacity (50) to long runs on degenerate problems
+BENCHMARK(BM_FilterAcceptable)->RangeMultiplier(4)->Range(50, 12800);
+BENCHMARK(BM_FilterAdd)->RangeMultiplier(4)->Range(50, 12800);
@@ -0,0 +1,420 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "ingredients/subproblem_solvers/MINRESSolver.hpp"
+#include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "linear_algebra/BatchedDenseLDLT.hpp"
+#include "linear_algebra/Norm.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "preprocessing/Reordering.hpp"
+#include "symbolic/MatrixVectorProduct.hpp"
+#include "symbolic/Range.hpp"
+
+using namespace uno;
+
+// the benchmarks are parameterized by the number of variables (first argument) and the sparsity pattern (second argument) of a synthetic
+// KKT system with half as many constraints as variables. The throughputs are reported in nonzeros per second
+namespace {
+   enum class Pattern {BANDED = 0, ARROW = 1, RANDOM = 2};
+
+   const std::vector<std::string> pattern_names{"banded", "arrow", "random"};
+
+   struct KKTPattern {
+      size_t number_variables;
+      size_t number_constraints;
+      // lower triangle of the Hessian (row index, column index, element), sorted by column
+      std::vector<std::tuple<size_t, size_t, double>> hessian_terms{};
+      // Jacobian rows (column index, element)
+      std::vector<std::vector<std::pair<size_t, double>>> jacobian_rows{};
+
+      [[nodiscard]] size_t number_jacobian_nonzeros() const {
+         size_t number_nonzeros = 0;
+         for (const auto& row: this->jacobian_rows) {
+            number_nonzeros += row.size();
+         }
+         return number_nonzeros;
+      }
+   };
+
+   // banded: bandwidth 5 in the Hessian, 3 consecutive variables per constraint. Arrow: diagonal Hessian with a dense last row, each
+   // constraint couples one variable with the last one. Random: 4 random subdiagonal entries per Hessian column, 3 random variables per
+   // constraint (fixed seed). The Hessian is diagonally dominant and the Jacobian has a nonzero in a distinct column for each constraint
+   KKTPattern generate_pattern(Pattern pattern, size_t number_variables) {
+      KKTPattern kkt_pattern{number_variables, number_variables / 2};
+      std::mt19937 generator(0);
+      std::uniform_int_distribution<size_t> variable_distribution(0, number_variables - 1);
+      for (size_t column_index: Range(number_variables)) {
+         kkt_pattern.hessian_terms.emplace_back(column_index, column_index, 10.);
+         std::vector<size_t> subdiagonal_rows{};
+         if (pattern == Pattern::BANDED) {
+            for (size_t offset: Range(1, 5)) {
+               if (column_index + offset < number_variables) {
+                  subdiagonal_rows.emplace_back(column_index + offset);
+               }
+            }
+         }
+         else if (pattern == Pattern::ARROW) {
+            if (column_index + 1 < number_variables) {
+               subdiagonal_rows.emplace_back(number_variables - 1);
+            }
+         }
+         else {
+            for ([[maybe_unused]] size_t entry: Range(4)) {
+               const size_t row_index = variable_distribution(generator);
+               if (column_index < row_index) {
+                  subdiagonal_rows.emplace_back(row_index);
+               }
+            }
+            std::sort(subdiagonal_rows.begin(), subdiagonal_rows.end());
+            subdiagonal_rows.erase(std::unique(subdiagonal_rows.begin(), subdiagonal_rows.end()), subdiagonal_rows.end());
+         }
+         for (size_t row_index: subdiagonal_rows) {
+            kkt_pattern.hessian_terms.emplace_back(row_index, column_index, 0.5);
+         }
+      }
+      kkt_pattern.jacobian_rows.resize(kkt_pattern.number_constraints);
+      for (size_t constraint_index: Range(kkt_pattern.number_constraints)) {
+         auto& row = kkt_pattern.jacobian_rows[constraint_index];
+         if (pattern == Pattern::BANDED) {
+            for (size_t offset: Range(3)) {
+               if (2 * constraint_index + offset < number_variables) {
+                  row.emplace_back(2 * constraint_index + offset, 1.);
+               }
+            }
+         }
+         else if (pattern == Pattern::ARROW) {
+            row.emplace_back(constraint_index, 1.);
+            row.emplace_back(number_variables - 1, 1.);
+         }
+         else {
+            std::vector<size_t> column_indices{2 * constraint_index};
+            for ([[maybe_unused]] size_t entry: Range(2)) {
+               column_indices.emplace_back(variable_distribution(generator));
+            }
+            std::sort(column_indices.begin(), column_indices.end());
+            column_indices.erase(std::unique(column_indices.begin(), column_indices.end()), column_indices.end());
+            for (size_t column_index: column_indices) {
+               row.emplace_back(column_index, (column_index == 2 * constraint_index) ? 1. : 0.5);
+            }
+         }
+      }
+      return kkt_pattern;
+   }
+
+   KKTPattern generate_pattern(const benchmark::State& state) {
+      return generate_pattern(static_cast<Pattern>(state.range(1)), static_cast<size_t>(state.range(0)));
+   }
+
+   void fill_hessian(const KKTPattern& kkt_pattern, SymmetricMatrix<size_t, double>& hessian) {
+      hessian.reset();
+      size_t current_column = 0;
+      for (const auto& [row_index, column_index, element]: kkt_pattern.hessian_terms) {
+         while (current_column < column_index) {
+            hessian.finalize_column(current_column++);
+         }
+         hessian.insert(element, row_index, column_index);
+      }
+      while (current_column < kkt_pattern.number_variables) {
+         hessian.finalize_column(current_column++);
+      }
+   }
+
+   SymmetricMatrix<size_t, double> create_hessian(const KKTPattern& kkt_pattern, const std::string& sparse_format) {
+      SymmetricMatrix<size_t, double> hessian(kkt_pattern.number_variables, kkt_pattern.hessian_terms.size(), false, sparse_format);
+      fill_hessian(kkt_pattern, hessian);
+      return hessian;
+   }
+
+   RectangularMatrix<double> create_jacobian(const KKTPattern& kkt_pattern) {
+      RectangularMatrix<double> jacobian(kkt_pattern.number_constraints, kkt_pattern.number_variables);
+      for (size_t constraint_index: Range(kkt_pattern.number_constraints)) {
+         for (const auto& [column_index, element]: kkt_pattern.jacobian_rows[constraint_index]) {
+            jacobian[constraint_index].insert(column_index, element);
+         }
+      }
+      return jacobian;
+   }
+
+   // augmented matrix with a primal regularization of 1 and a dual regularization of -1 (nonsingular)
+   SymmetricIndefiniteLinearSystem<size_t, double> create_augmented_system(const KKTPattern& kkt_pattern, const Options& options) {
+      const size_t dimension = kkt_pattern.number_variables + kkt_pattern.number_constraints;
+      const size_t number_nonzeros = kkt_pattern.hessian_terms.size() + kkt_pattern.number_jacobian_nonzeros() + dimension;
+      SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", dimension, number_nonzeros, true, options);
+      const SymmetricMatrix<size_t, double> hessian = create_hessian(kkt_pattern, "COO");
+      const RectangularMatrix<double> jacobian = create_jacobian(kkt_pattern);
+      const WarmstartInformation warmstart_information{};
+      augmented_system.assemble_matrix(hessian, jacobian, kkt_pattern.number_variables, kkt_pattern.number_constraints,
+         warmstart_information);
+      const size_t number_variables = kkt_pattern.number_variables;
+      augmented_system.matrix.set_regularization([=](size_t index) {
+         return (index < number_variables) ? 1. : -1.;
+      });
+      return augmented_system;
+   }
+
+   void report_nonzeros(benchmark::State& state, size_t number_nonzeros) {
+      state.SetLabel(pattern_names[static_cast<size_t>(state.range(1))]);
+      state.counters["nonzeros/s"] = benchmark::Counter(static_cast<double>(number_nonzeros), benchmark::Counter::kIsIterationInvariantRate);
+   }
+
+   // renumbering of the variables: the variable i becomes positions[i]
+   KKTPattern permute_pattern(const KKTPattern& kkt_pattern, const std::vector<size_t>& positions) {
+      KKTPattern permuted_pattern{kkt_pattern.number_variables, kkt_pattern.number_constraints};
+      for (const auto& [row_index, column_index, element]: kkt_pattern.hessian_terms) {
+         permuted_pattern.hessian_terms.emplace_back(std::max(positions[row_index], positions[column_index]),
+            std::min(positions[row_index], positions[column_index]), element);
+      }
+      std::sort(permuted_pattern.hessian_terms.begin(), permuted_pattern.hessian_terms.end(), [](const auto& term1, const auto& term2) {
+         return std::tie(std::get<1>(term1), std::get<0>(term1)) < std::tie(std::get<1>(term2), std::get<0>(term2));
+      });
+      permuted_pattern.jacobian_rows = kkt_pattern.jacobian_rows;
+      for (auto& row: permuted_pattern.jacobian_rows) {
+         for (auto& [column_index, element]: row) {
+            column_index = positions[column_index];
+         }
+      }
+      return permuted_pattern;
+   }
+
+   // banded pattern whose variables are randomly shuffled (fixed seed), then optionally renumbered by reverse Cuthill-McKee on the
+   // graph of H + J^T J (see Reordering)
+   KKTPattern generate_scrambled_pattern(size_t number_variables, bool reordered) {
+      std::vector<size_t> positions(number_variables);
+      for (size_t variable_index: Range(number_variables)) {
+         positions[variable_index] = variable_index;
+      }
+      std::shuffle(positions.begin(), positions.end(), std::mt19937(0));
+      KKTPattern kkt_pattern = permute_pattern(generate_pattern(Pattern::BANDED, number_variables), positions);
+      if (reordered) {
+         std::vector<std::vector<size_t>> neighbors(number_variables);
+         for (const auto& [row_index, column_index, element]: kkt_pattern.hessian_terms) {
+            if (row_index != column_index) {
+               neighbors[row_index].emplace_back(column_index);
+               neighbors[column_index].emplace_back(row_index);
+            }
+         }
+         for (const auto& row: kkt_pattern.jacobian_rows) {
+            for (const auto& [first_column_index, first_element]: row) {
+               for (const auto& [second_column_index, second_element]: row) {
+                  if (first_column_index != second_column_index) {
+                     neighbors[first_column_index].emplace_back(second_column_index);
+                  }
+               }
+            }
+         }
+         std::vector<size_t> adjacency_starts{0}, adjacency{};
+         for (std::vector<size_t>& variable_neighbors: neighbors) {
+            std::sort(variable_neighbors.begin(), variable_neighbors.end());
+            variable_neighbors.erase(std::unique(variable_neighbors.begin(), variable_neighbors.end()), variable_neighbors.end());
+            adjacency.insert(adjacency.end(), variable_neighbors.begin(), variable_neighbors.end());
+            adjacency_starts.emplace_back(adjacency.size());
+         }
+         const std::vector<size_t> order = Reordering::reverse_cuthill_mckee(adjacency_starts, adjacency);
+         for (size_t position: Range(number_variables)) {
+            positions[order[position]] = position;
+         }
+         kkt_pattern = permute_pattern(kkt_pattern, positions);
+      }
+      return kkt_pattern;
+   }
+
+   void register_sizes_and_patterns(benchmark::internal::Benchmark* benchmark) {
+      benchmark->ArgsProduct({benchmark::CreateRange(256, 1 << 16, 8), {0, 1, 2}})->ArgNames({"n", "pattern"});
+   }
+} // namespace
+
+// Hessian evaluation: insertion of the terms (and finalization of the columns)
+static void BM_SymmetricMatrixInsert(benchmark::State& state, const std::string& sparse_format) {
+   const KKTPattern kkt_pattern = generate_pattern(state);
+   SymmetricMatrix<size_t, double> hessian(kkt_pattern.number_variables, kkt_pattern.hessian_terms.size(), false, sparse_format);
+   for (auto _: state) {
+      fill_hessian(kkt_pattern, hessian);
+      benchmark::DoNotOptimize(hessian.data_pointer());
+      benchmark::ClobberMemory();
+   }
+   report_nonzeros(state, kkt_pattern.hessian_terms.size());
+}
+
+// curvature x^T H x, as in the predicted reduction of the subproblems
+static void BM_QuadraticProduct(benchmark::State& state, const std::string& sparse_format) {
+   const KKTPattern kkt_pattern = generate_pattern(state);
+   const SymmetricMatrix<size_t, double> hessian = create_hessian(kkt_pattern, sparse_format);
+   const Vector<double> x(kkt_pattern.number_variables, 1.);
+   for (auto _: state) {
+      benchmark::DoNotOptimize(hessian.quadratic_product(x, x));
+   }
+   report_nonzeros(state, kkt_pattern.hessian_terms.size());
+}
+
+// assembly of the augmented matrix: full (new sparsity pattern) or values only (same sparsity pattern)
+static void BM_AssembleMatrix(benchmark::State& state, bool sparsity_changed) {
+   const KKTPattern kkt_pattern = generate_pattern(state);
+   const Options options = DefaultOptions::load();
+   SymmetricIndefiniteLinearSystem<size_t, double> augmented_system = create_augmented_system(kkt_pattern, options);
+   const SymmetricMatrix<size_t, double> hessian = create_hessian(kkt_pattern, "COO");
+   const RectangularMatrix<double> jacobian = create_jacobian(kkt_pattern);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.hessian_sparsity_changed = warmstart_information.jacobian_sparsity_changed = sparsity_changed;
+   for (auto _: state) {
+      augmented_system.assemble_matrix(hessian, jacobian, kkt_pattern.number_variables, kkt_pattern.number_constraints,
+         warmstart_information);
+      benchmark::DoNotOptimize(augmented_system.matrix.data_pointer());
+      benchmark::ClobberMemory();
+   }
+   report_nonzeros(state, kkt_pattern.hessian_terms.size() + kkt_pattern.number_jacobian_nonzeros());
+}
+
+// Jacobian-vector product J x
+static void BM_JacobianProduct(benchmark::State& state) {
+   const KKTPattern kkt_pattern = generate_pattern(state);
+   const RectangularMatrix<double> jacobian = create_jacobian(kkt_pattern);
+   const Vector<double> x(kkt_pattern.number_variables, 1.);
+   Vector<double> result(kkt_pattern.number_constraints);
+   for (auto _: state) {
+      const auto product = jacobian * x;
+      for (size_t constraint_index: Range(kkt_pattern.number_constraints)) {
+         result[constraint_index] = product[constraint_index];
+      }
+      benchmark::DoNotOptimize(result.data());
+      benchmark::ClobberMemory();
+   }
+   report_nonzeros(state, kkt_pattern.number_jacobian_nonzeros());
+}
+
+// locality of the sparse kernels (Hessian quadratic product, Jacobian-vector product) on a scrambled banded pattern, before and
+// after reordering
+static void BM_ReorderedKernels(benchmark::State& state, bool reordered) {
+   const KKTPattern kkt_pattern = generate_scrambled_pattern(static_cast<size_t>(state.range(0)), reordered);
+   const SymmetricMatrix<size_t, double> hessian = create_hessian(kkt_pattern, "CSC");
+   const RectangularMatrix<double> jacobian = create_jacobian(kkt_pattern);
+   const Vector<double> x(kkt_pattern.number_variables, 1.);
+   Vector<double> result(kkt_pattern.number_constraints);
+   for (auto _: state) {
+      benchmark::DoNotOptimize(hessian.quadratic_product(x, x));
+      const auto product = jacobian * x;
+      for (size_t constraint_index: Range(kkt_pattern.number_constraints)) {
+         result[constraint_index] = product[constraint_index];
+      }
+      benchmark::DoNotOptimize(result.data());
+      benchmark::ClobberMemory();
+   }
+   state.counters["nonzeros/s"] = benchmark::Counter(static_cast<double>(kkt_pattern.hessian_terms.size() +
+      kkt_pattern.number_jacobian_nonzeros()), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// MINRES solve of the augmented system with the constraint preconditioner
+static void BM_MINRESSolve(benchmark::State& state) {
+   const KKTPattern kkt_pattern = generate_pattern(state);
+   const Options options = DefaultOptions::load();
+   const SymmetricIndefiniteLinearSystem<size_t, double> augmented_system = create_augmented_system(kkt_pattern, options);
+   const size_t dimension = augmented_system.matrix.dimension();
+   MINRESSolver<size_t, double> linear_solver(dimension, options);
+   linear_solver.set_primal_block_dimension(kkt_pattern.number_variables);
+   const Vector<double> rhs(dimension, 1.);
+   Vector<double> solution(dimension);
+   for (auto _: state) {
+      linear_solver.solve_indefinite_system(augmented_system.matrix, rhs, solution);
+      benchmark::DoNotOptimize(solution.data());
+      benchmark::ClobberMemory();
+   }
+   state.counters["iterations"] = static_cast<double>(linear_solver.get_number_iterations());
+   report_nonzeros(state, augmented_system.matrix.number_nonzeros());
+}
+
+// numerical factorization of the augmented system by the first available direct solver (the symbolic analysis is done once)
+static void BM_DirectSolverFactorization(benchmark::State& state) {
+   const std::vector<std::string> available_solvers = SymmetricIndefiniteLinearSolverFactory::available_solvers();
+   if (available_solvers.empty()) {
+      state.SkipWithError("no direct linear solver is available");
+      return;
+   }
+   const KKTPattern kkt_pattern = generate_pattern(state);
+   Options options = DefaultOptions::load();
+   options["linear_solver"] = available_solvers[0];
+   const SymmetricIndefiniteLinearSystem<size_t, double> augmented_system = create_augmented_system(kkt_pattern, options);
+   const size_t dimension = augmented_system.matrix.dimension();
+   auto linear_solver = SymmetricIndefiniteLinearSolverFactory::create(dimension, augmented_system.matrix.number_nonzeros(), options);
+   linear_solver->do_symbolic_analysis(augmented_system.matrix);
+   for (auto _: state) {
+      linear_solver->do_numerical_factorization(augmented_system.matrix);
+      benchmark::ClobberMemory();
+   }
+   report_nonzeros(state, augmented_system.matrix.number_nonzeros());
+}
+
+// the norms are measured on the primal vector
+static void BM_Norm1(benchmark::State& state) {
+   const Vector<double> x(static_cast<size_t>(state.range(0)), -1.5);
+   for (auto _: state) {
+      benchmark::DoNotOptimize(norm_1(x));
+   }
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+static void BM_Norm2(benchmark::State& state) {
+   const Vector<double> x(static_cast<size_t>(state.range(0)), -1.5);
+   for (auto _: state) {
+      benchmark::DoNotOptimize(norm_2(x));
+   }
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+static void BM_NormInf(benchmark::State& state) {
+   const Vector<double> x(static_cast<size_t>(state.range(0)), -1.5);
+   for (auto _: state) {
+      benchmark::DoNotOptimize(norm_inf(x));
+   }
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+// factorization and solve of a batch of small diagonally dominant KKT-like matrices (dimension, batch size)
+static void BM_BatchedDenseLDLT(benchmark::State& state) {
+   const size_t dimension = static_cast<size_t>(state.range(0));
+   const size_t batch_size = static_cast<size_t>(state.range(1));
+   BatchedDenseLDLT<double> batch(dimension, batch_size);
+   std::vector<double, AlignedAllocator<double>> rhs(dimension * batch_size);
+   for (auto _: state) {
+      for (size_t column: Range(dimension)) {
+         for (size_t row = column; row < dimension; row++) {
+            for (size_t instance: Range(batch_size)) {
+               batch.entry(row, column, instance) = (row == column) ? static_cast<double>(dimension + instance) : 1.;
+            }
+         }
+      }
+      std::fill(rhs.begin(), rhs.end(), 1.);
+      batch.factorize();
+      batch.solve(rhs);
+      benchmark::DoNotOptimize(rhs.data());
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(1)));
+}
+
+BENCHMARK_CAPTURE(BM_SymmetricMatrixInsert, COO, std::string("COO"))->Apply(register_sizes_and_patterns);
+BENCHMARK_CAPTURE(BM_SymmetricMatrixInsert, CSC, std::string("CSC"))->Apply(register_sizes_and_patterns);
+BENCHMARK_CAPTURE(BM_QuadraticProduct, COO, std::string("COO"))->Apply(register_sizes_and_patterns);
+BENCHMARK_CAPTURE(BM_QuadraticProduct, CSC, std::string("CSC"))->Apply(register_sizes_and_patterns);
+BENCHMARK_CAPTURE(BM_AssembleMatrix, full, true)->Apply(register_sizes_and_patterns);
+BENCHMARK_CAPTURE(BM_AssembleMatrix, values_only, false)->Apply(register_sizes_and_patterns);
+BENCHMARK(BM_JacobianProduct)->Apply(register_sizes_and_patterns);
+BENCHMARK_CAPTURE(BM_ReorderedKernels, scrambled, false)->RangeMultiplier(8)->Range(256, 1 << 18);
+BENCHMARK_CAPTURE(BM_ReorderedKernels, RCM, true)->RangeMultiplier(8)->Range(256, 1 << 18);
+BENCHMARK(BM_MINRESSolve)->Apply(register_sizes_and_patterns);
+BENCHMARK(BM_DirectSolverFactorization)->Apply(register_sizes_and_patterns);
+BENCHMARK(BM_Norm1)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK(BM_Norm2)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK(BM_NormInf)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK(BM_BatchedDenseLDLT)->ArgsProduct({{8, 32}, {1, 8, 64}});
@@ -0,0 +1,191 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "ParametricSolver.hpp"
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/Model.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+// the benchmarks solve a sweep of a parametric QP (the right-hand side b of the resource constraint decreases), either by creating
+// the whole solver for each value of b or with a persistent ParametricSolver that re-solves from the previous solution
+namespace {
+   // min sum_i (x_i - 1)^2 s.t. sum_i x_i <= b, 0 <= x_i <= 2. The solution is x_i = min(1, b/n). The parameter b defaults to n/2
+   class ResourceAllocationModel: public Model {
+   public:
+      explicit ResourceAllocationModel(size_t dimension):
+            Model("resource allocation", dimension, 1, 1.),
+            parameter(0.5 * static_cast<double>(dimension)),
+            variables(dimension) {
+         for (size_t variable_index: Range(dimension)) {
+            this->variables[variable_index] = variable_index;
+         }
+      }
+
+      void set_parameter(double new_parameter) { this->parameter = new_parameter; }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+         double objective = 0.;
+         for (size_t variable_index: Range(this->number_variables)) {
+            objective += (x[variable_index] - 1.) * (x[variable_index] - 1.);
+         }
+         return objective;
+      }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         for (size_t variable_index: Range(this->number_variables)) {
+            gradient.insert(variable_index, 2. * (x[variable_index] - 1.));
+         }
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         constraints[0] = 0.;
+         for (size_t variable_index: Range(this->number_variables)) {
+            constraints[0] += x[variable_index];
+         }
+      }
+      void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t /*constraint_index*/, SparseVector<double>& gradient) const override {
+         for (size_t variable_index: Range(this->number_variables)) {
+            gradient.insert(variable_index, 1.);
+         }
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& constraint_jacobian) const override {
+         for (size_t variable_index: Range(this->number_variables)) {
+            constraint_jacobian[0].insert(variable_index, 1.);
+         }
+      }
+      void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& /*multipliers*/,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         hessian.reset();
+         for (size_t variable_index: Range(this->number_variables)) {
+            hessian.insert(2. * objective_multiplier, variable_index, variable_index);
+            hessian.finalize_column(variable_index);
+         }
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t /*variable_index*/) const override { return 0.; }
+      [[nodiscard]] double variable_upper_bound(size_t /*variable_index*/) const override { return 2.; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t /*variable_index*/) const override { return BOUNDED_BOTH_SIDES; }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->variables_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->empty_collection; }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return -INF<double>; }
+      [[nodiscard]] double constraint_upper_bound(size_t /*constraint_index*/) const override { return this->parameter; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return QUADRATIC; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return LINEAR; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return BOUNDED_UPPER; }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->constraints_collection; }
+
+      void initial_primal_point(Vector<double>& x) const override { x.fill(0.); }
+      void initial_dual_point(Vector<double>& multipliers) const override { multipliers.fill(0.); }
+      void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->number_variables; }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return this->number_variables; }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->number_variables; }
+
+   protected:
+      double parameter;
+      std::vector<size_t> variables;
+      const std::vector<size_t> constraints{0};
+      const std::vector<size_t> no_indices{};
+      const CollectionAdapter<std::vector<size_t>&> variables_collection{this->variables};
+      const CollectionAdapter<std::vector<size_t>> constraints_collection{this->constraints};
+      const CollectionAdapter<std::vector<size_t>> empty_collection{this->no_indices};
+      const SparseVector<size_t> slacks{};
+      const Vector<size_t> fixed_variables{};
+   };
+
+   constexpr size_t number_parameters = 20;
+
+   // b sweeps [0.75 n, 0.25 n]: the constraint is active for all the values
+   double parameter_value(size_t dimension, size_t step) {
+      const double fraction = 0.75 - 0.5 * static_cast<double>(step) / static_cast<double>(number_parameters - 1);
+      return fraction * static_cast<double>(dimension);
+   }
+
+   // the SQP preset solves the QPs with BQPD, unavailable in most builds: the dense linear solver is always compiled
+   Options sweep_options() {
+      Options options = DefaultOptions::load();
+      options.overwrite_with(Presets::get_preset_options("ipopt"));
+      options["linear_solver"] = "dense";
+      options["barrier_warm_start"] = "yes";
+      options["logger"] = "SILENT";
+      return options;
+   }
+}
+
+// the dimension is the argument. Each value of b is solved from scratch: reformulation, strategies and symbolic analyses
+static void BM_ParameterSweepFromScratch(benchmark::State& state) {
+   const size_t dimension = static_cast<size_t>(state.range(0));
+   Options options = sweep_options();
+   options["barrier_warm_start"] = "no";
+   size_t number_solves = 0;
+   size_t number_iterations = 0;
+   for (auto _: state) {
+      for (size_t step: Range(number_parameters)) {
+         auto resource_model = std::make_unique<ResourceAllocationModel>(dimension);
+         resource_model->set_parameter(parameter_value(dimension, step));
+         const std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(resource_model), options);
+         auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*model, options);
+         auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+         Uno uno(*globalization_mechanism, options);
+         Iterate initial_iterate(model->number_variables, model->number_constraints);
+         model->initial_primal_point(initial_iterate.primals);
+         model->project_onto_variable_bounds(initial_iterate.primals);
+         model->initial_dual_point(initial_iterate.multipliers.constraints);
+         const Result result = uno.solve(*model, initial_iterate, options);
+         benchmark::DoNotOptimize(result.solution.evaluations.objective);
+         number_iterations += result.iteration;
+         number_solves++;
+      }
+   }
+   state.counters["iterations"] = static_cast<double>(number_iterations) / static_cast<double>(std::max(number_solves, size_t(1)));
+}
+
+// the dimension is the argument. The persistent solver only changes the bound of the constraint between two solves
+static void BM_ParameterSweepWarmStarted(benchmark::State& state) {
+   const size_t dimension = static_cast<size_t>(state.range(0));
+   const Options options = sweep_options();
+   ParametricSolver solver(std::make_unique<ResourceAllocationModel>(dimension), options);
+   // the first solve (structure analysis) is excluded
+   solver.resolve();
+   size_t number_solves = 0;
+   size_t number_iterations = 0;
+   for (auto _: state) {
+      for (size_t step: Range(number_parameters)) {
+         solver.update_parameters({{}, {{0, -INF<double>, parameter_value(dimension, step)}}, false});
+         const Result result = solver.resolve();
+         benchmark::DoNotOptimize(result.solution.evaluations.objective);
+         number_iterations += result.iteration;
+         number_solves++;
+      }
+   }
+   state.counters["iterations"] = static_cast<double>(number_iterations) / static_cast<double>(std::max(number_solves, size_t(1)));
+}
+
+BENCHMARK(BM_ParameterSweepFromScratch)->Arg(10)->Arg(50)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParameterSweepWarmStarted)->Arg(10)->Arg(50)->Unit(benchmark::kMillisecond);
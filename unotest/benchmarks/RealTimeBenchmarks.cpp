@@ -0,0 +1,280 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/UserCallbacks.hpp"
+
+using namespace uno;
+
+// the benchmarks solve a sequence of MPC problems with the mpc preset (receding horizon: the initial state of each problem is
+// perturbed, the previous solution is the initial point) and report the percentiles of the latencies of the iterations
+namespace {
+   // pendulum x'' = u - sin(x) discretized by the explicit Euler scheme with N steps of length h, controls in [-2, 2]:
+   // min sum_k x_k^2 + 0.1 v_k^2 + 0.01 u_k^2 s.t. x_{k+1} = x_k + h v_k, v_{k+1} = v_k + h (u_k - sin(x_k)).
+   // Variables: the states x_1..x_N, v_1..v_N then the controls u_0..u_{N-1}. The initial state (x_0, v_0) is a parameter
+   class PendulumMPCModel: public Model {
+   public:
+      explicit PendulumMPCModel(size_t horizon):
+            Model("pendulum MPC", 3 * horizon, 2 * horizon, 1.),
+            horizon(horizon),
+            controls(horizon) {
+         for (size_t control_index: Range(horizon)) {
+            this->controls[control_index] = 2 * horizon + control_index;
+         }
+         for (size_t constraint_index: Range(2 * horizon)) {
+            this->equality_constraints.emplace_back(constraint_index);
+         }
+         for (size_t constraint_index: Range(horizon)) {
+            this->linear_constraints.emplace_back(constraint_index);
+         }
+      }
+
+      void set_initial_state(double angle, double velocity) {
+         this->initial_angle = angle;
+         this->initial_velocity = velocity;
+      }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+         double objective = 0.;
+         for (size_t k: Range(this->horizon)) {
+            const double velocity = x[this->horizon + k];
+            const double control = x[2 * this->horizon + k];
+            objective += x[k] * x[k] + 0.1 * velocity * velocity + 0.01 * control * control;
+         }
+         return objective;
+      }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         for (size_t k: Range(this->horizon)) {
+            gradient.insert(k, 2. * x[k]);
+            gradient.insert(this->horizon + k, 0.2 * x[this->horizon + k]);
+            gradient.insert(2 * this->horizon + k, 0.02 * x[2 * this->horizon + k]);
+         }
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         for (size_t k: Range(this->horizon)) {
+            constraints[k] = x[k] - this->angle(x, k) - this->step_length * this->velocity(x, k);
+            constraints[this->horizon + k] = x[this->horizon + k] - this->velocity(x, k) -
+                  this->step_length * (x[2 * this->horizon + k] - std::sin(this->angle(x, k)));
+         }
+      }
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override {
+         this->insert_constraint_gradient(x, constraint_index, gradient);
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+         for (size_t constraint_index: Range(this->number_constraints)) {
+            auto row = constraint_jacobian[constraint_index];
+            this->insert_constraint_gradient(x, constraint_index, row);
+         }
+      }
+      // the Lagrangian is f - lambda^T c: the curvature of h sin(x_k) in the velocity constraints contributes lambda h sin(x_k)
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         hessian.reset();
+         for (size_t k: Range(this->horizon)) {
+            double element = 2. * objective_multiplier;
+            if (k + 1 < this->horizon) {
+               element += multipliers[this->horizon + k + 1] * this->step_length * std::sin(x[k]);
+            }
+            hessian.insert(element, k, k);
+            hessian.finalize_column(k);
+         }
+         for (size_t k: Range(this->horizon)) {
+            hessian.insert(0.2 * objective_multiplier, this->horizon + k, this->horizon + k);
+            hessian.finalize_column(this->horizon + k);
+         }
+         for (size_t k: Range(this->horizon)) {
+            hessian.insert(0.02 * objective_multiplier, 2 * this->horizon + k, 2 * this->horizon + k);
+            hessian.finalize_column(2 * this->horizon + k);
+         }
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override {
+         return (variable_index < 2 * this->horizon) ? -INF<double> : -2.;
+      }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override {
+         return (variable_index < 2 * this->horizon) ? INF<double> : 2.;
+      }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override {
+         return (variable_index < 2 * this->horizon) ? UNBOUNDED : BOUNDED_BOTH_SIDES;
+      }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->controls_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->controls_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->empty_collection; }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return 0.; }
+      [[nodiscard]] double constraint_upper_bound(size_t /*constraint_index*/) const override { return 0.; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return QUADRATIC; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t constraint_index) const override {
+         return (constraint_index < this->horizon) ? LINEAR : NONLINEAR;
+      }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return EQUAL_BOUNDS; }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->equality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->linear_constraints_collection; }
+
+      void initial_primal_point(Vector<double>& x) const override { x.fill(0.); }
+      void initial_dual_point(Vector<double>& multipliers) const override { multipliers.fill(0.); }
+      void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->number_variables; }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 7 * this->horizon - 4; }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->number_variables; }
+
+   protected:
+      const size_t horizon;
+      const double step_length{0.1};
+      double initial_angle{0.};
+      double initial_velocity{0.};
+      std::vector<size_t> controls;
+      std::vector<size_t> equality_constraints{};
+      std::vector<size_t> linear_constraints{};
+      const std::vector<size_t> no_indices{};
+      const CollectionAdapter<std::vector<size_t>&> controls_collection{this->controls};
+      const CollectionAdapter<std::vector<size_t>&> equality_constraints_collection{this->equality_constraints};
+      const CollectionAdapter<std::vector<size_t>&> linear_constraints_collection{this->linear_constraints};
+      const CollectionAdapter<std::vector<size_t>> empty_collection{this->no_indices};
+      const SparseVector<size_t> slacks{};
+      const Vector<size_t> fixed_variables{};
+
+      // state at the beginning of step k
+      [[nodiscard]] double angle(const Vector<double>& x, size_t k) const { return (k == 0) ? this->initial_angle : x[k - 1]; }
+      [[nodiscard]] double velocity(const Vector<double>& x, size_t k) const {
+         return (k == 0) ? this->initial_velocity : x[this->horizon + k - 1];
+      }
+
+      // the gradient is inserted into a sparse vector or a row of the Jacobian
+      template <typename Gradient>
+      void insert_constraint_gradient(const Vector<double>& x, size_t constraint_index, Gradient& gradient) const {
+         const size_t k = constraint_index % this->horizon;
+         if (constraint_index < this->horizon) {
+            if (0 < k) {
+               gradient.insert(k - 1, -1.);
+               gradient.insert(this->horizon + k - 1, -this->step_length);
+            }
+            gradient.insert(k, 1.);
+         }
+         else {
+            if (0 < k) {
+               gradient.insert(k - 1, this->step_length * std::cos(x[k - 1]));
+               gradient.insert(this->horizon + k - 1, -1.);
+            }
+            gradient.insert(this->horizon + k, 1.);
+            gradient.insert(2 * this->horizon + k, -this->step_length);
+         }
+      }
+   };
+
+   // records the end time of each iteration in a buffer allocated before the solves
+   class IterationClock: public UserCallbacks {
+   public:
+      explicit IterationClock(size_t capacity) { this->end_times.reserve(capacity); }
+
+      void start() {
+         this->end_times.clear();
+      }
+      void notify_acceptable_iterate(const Vector<double>& /*primals*/, const Multipliers& /*multipliers*/, double /*objective_multiplier*/) override { }
+      void notify_new_primals(const Vector<double>& /*primals*/) override {
+         if (this->end_times.size() < this->end_times.capacity()) {
+            this->end_times.emplace_back(std::chrono::steady_clock::now());
+         }
+      }
+      void notify_new_multipliers(const Multipliers& /*multipliers*/) override { }
+
+      // the first iteration of a solve follows the initialization: only the latencies between two iterations are recorded
+      void collect_latencies(std::vector<double>& latencies) const {
+         if (this->end_times.empty()) {
+            return;
+         }
+         for (size_t iteration: Range(1, this->end_times.size())) {
+            const std::chrono::duration<double, std::micro> latency = this->end_times[iteration] - this->end_times[iteration - 1];
+            if (latencies.size() < latencies.capacity()) {
+               latencies.emplace_back(latency.count());
+            }
+         }
+      }
+
+   protected:
+      std::vector<std::chrono::steady_clock::time_point> end_times{};
+   };
+
+   double percentile(const std::vector<double>& sorted_values, double fraction) {
+      if (sorted_values.empty()) {
+         return 0.;
+      }
+      const size_t index = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted_values.size()))) - 1;
+      return sorted_values[std::min(index, sorted_values.size() - 1)];
+   }
+}
+
+// the horizon is the argument. The QP solver is the default one
+static void BM_MPCIterationLatency(benchmark::State& state) {
+   // the line search convexifies the Hessian with a direct linear solver
+   if (SymmetricIndefiniteLinearSolverFactory::available_solvers().empty()) {
+      state.SkipWithError("no direct linear solver is available");
+      return;
+   }
+   const size_t horizon = static_cast<size_t>(state.range(0));
+   Options options = DefaultOptions::load();
+   options.overwrite_with(Presets::get_preset_options("mpc"));
+   options["logger"] = "SILENT";
+
+   PendulumMPCModel model(horizon);
+   auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(model, options);
+   auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+   Uno uno(*globalization_mechanism, options);
+   const size_t max_iterations = options.get_unsigned_int("max_iterations");
+   IterationClock iteration_clock(max_iterations);
+   std::vector<double> latencies{};
+   latencies.reserve(1000000);
+   Iterate iterate(model.number_variables, model.number_constraints);
+   model.initial_primal_point(iterate.primals);
+   model.initial_dual_point(iterate.multipliers.constraints);
+
+   size_t number_solves = 0;
+   size_t number_iterations = 0;
+   for (auto _: state) {
+      // deterministic sequence of initial states
+      const double phase = 0.1 * static_cast<double>(number_solves);
+      model.set_initial_state(std::sin(phase), 0.5 * std::cos(phase));
+      iteration_clock.start();
+      Result result = uno.resolve(model, iterate, options, iteration_clock);
+      iteration_clock.collect_latencies(latencies);
+      number_iterations += result.iteration;
+      // warm start from the previous solution (its evaluations depend on the previous initial state)
+      iterate.reset(model.number_variables, model.number_constraints);
+      iterate.primals = result.solution.primals;
+      iterate.multipliers = result.solution.multipliers;
+      number_solves++;
+   }
+   std::sort(latencies.begin(), latencies.end());
+   state.counters["p50_us"] = percentile(latencies, 0.5);
+   state.counters["p99_us"] = percentile(latencies, 0.99);
+   state.counters["max_us"] = latencies.empty() ? 0. : latencies.back();
+   state.counters["iterations"] = static_cast<double>(number_iterations) / static_cast<double>(std::max(number_solves, size_t(1)));
+}
+
+BENCHMARK(BM_MPCIterationLatency)->Arg(10)->Arg(20)->Arg(40)->Unit(benchmark::kMicrosecond);
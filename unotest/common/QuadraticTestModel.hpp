@@ -0,0 +1,108 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_QUADRATICTESTMODEL_H
+#define UNO_QUADRATICTESTMODEL_H
+
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   // min a x0^2 + 4 x1^2 - 32 x1 s.t. x0 + x1 <= b, -x0 + 2 x1 <= 4, x0 >= 0, 0 <= x1 <= 4. The objective coefficient a defaults to 1
+   // and the parameter b to 7 (solution (2, 3))
+   class QuadraticTestModel: public Model {
+   public:
+      QuadraticTestModel(): Model("quadratic test model", 2, 2, 1.) { }
+
+      void set_parameter(double new_parameter) { this->parameter = new_parameter; }
+      void set_objective_coefficient(double new_coefficient) { this->objective_coefficient = new_coefficient; }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+         return this->objective_coefficient * x[0] * x[0] + 4. * x[1] * x[1] - 32. * x[1];
+      }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         gradient.insert(0, 2. * this->objective_coefficient * x[0]);
+         gradient.insert(1, 8. * x[1] - 32.);
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         constraints[0] = x[0] + x[1];
+         constraints[1] = -x[0] + 2. * x[1];
+      }
+      void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t constraint_index, SparseVector<double>& gradient) const override {
+         gradient.insert(0, (constraint_index == 0) ? 1. : -1.);
+         gradient.insert(1, (constraint_index == 0) ? 1. : 2.);
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& constraint_jacobian) const override {
+         constraint_jacobian[0].insert(0, 1.);
+         constraint_jacobian[0].insert(1, 1.);
+         constraint_jacobian[1].insert(0, -1.);
+         constraint_jacobian[1].insert(1, 2.);
+      }
+      void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& /*multipliers*/,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         hessian.reset();
+         hessian.insert(2. * this->objective_coefficient * objective_multiplier, 0, 0);
+         hessian.finalize_column(0);
+         hessian.insert(8. * objective_multiplier, 1, 1);
+         hessian.finalize_column(1);
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t /*variable_index*/) const override { return 0.; }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return (variable_index == 0) ? INF<double> : 4.; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override {
+         return (variable_index == 0) ? BOUNDED_LOWER : BOUNDED_BOTH_SIDES;
+      }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->lower_bounded_variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override {
+         return this->single_lower_bounded_variables_collection;
+      }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+         return this->single_upper_bounded_variables_collection;
+      }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return -INF<double>; }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return (constraint_index == 0) ? this->parameter : 4.; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return QUADRATIC; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return LINEAR; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return BOUNDED_UPPER; }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->equality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->inequality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->inequality_constraints_collection; }
+
+      void initial_primal_point(Vector<double>& x) const override { x.fill(0.); }
+      void initial_dual_point(Vector<double>& multipliers) const override { multipliers.fill(0.); }
+      void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 2; }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 4; }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return 2; }
+
+   protected:
+      double parameter{7.};
+      double objective_coefficient{1.};
+      const std::vector<size_t> lower_bounded_variables{0, 1};
+      const std::vector<size_t> upper_bounded_variables{1};
+      const std::vector<size_t> single_lower_bounded_variables{0};
+      const std::vector<size_t> single_upper_bounded_variables{};
+      const std::vector<size_t> inequality_constraints{0, 1};
+      const std::vector<size_t> equality_constraints{};
+      const CollectionAdapter<std::vector<size_t>> lower_bounded_variables_collection{this->lower_bounded_variables};
+      const CollectionAdapter<std::vector<size_t>> upper_bounded_variables_collection{this->upper_bounded_variables};
+      const CollectionAdapter<std::vector<size_t>> single_lower_bounded_variables_collection{this->single_lower_bounded_variables};
+      const CollectionAdapter<std::vector<size_t>> single_upper_bounded_variables_collection{this->single_upper_bounded_variables};
+      const CollectionAdapter<std::vector<size_t>> equality_constraints_collection{this->equality_constraints};
+      const CollectionAdapter<std::vector<size_t>> inequality_constraints_collection{this->inequality_constraints};
+      const SparseVector<size_t> slacks{};
+      const Vector<size_t> fixed_variables{};
+   };
+} // namespace
+
+#endif // UNO_QUADRATICTESTMODEL_H
@@ -0,0 +1,93 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_TESTSOLVER_H
+#define UNO_TESTSOLVER_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/Model.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/UserCallbacks.hpp"
+
+namespace uno {
+   // default options with the preset, the QP solver that requires no external library and no output
+   inline Options test_options(const std::string& preset) {
+      Options options = DefaultOptions::load();
+      options.overwrite_with(Presets::get_preset_options(preset));
+      options["QP_solver"] = "GoldfarbIdnani";
+      options["logger"] = "SILENT";
+      return options;
+   }
+
+   // strategies and solver of a model (owned by the caller) for the given options
+   class TestSolver {
+   public:
+      TestSolver(const Model& model, const Options& options):
+            model(model),
+            options(options),
+            constraint_relaxation_strategy(ConstraintRelaxationStrategyFactory::create(model, this->options)),
+            globalization_mechanism(GlobalizationMechanismFactory::create(*this->constraint_relaxation_strategy, this->options)),
+            uno(*this->globalization_mechanism, this->options) {
+      }
+
+      // initial point of the model, whose first components are overwritten by the given primal values (if any), projected onto the
+      // variable bounds
+      [[nodiscard]] Iterate initial_iterate(const std::optional<Vector<double>>& initial_primals = std::nullopt) const {
+         Iterate initial_iterate(this->model.number_variables, this->model.number_constraints);
+         this->model.initial_primal_point(initial_iterate.primals);
+         if (initial_primals.has_value()) {
+            for (size_t variable_index: Range(initial_primals->size())) {
+               initial_iterate.primals[variable_index] = (*initial_primals)[variable_index];
+            }
+         }
+         this->model.project_onto_variable_bounds(initial_iterate.primals);
+         this->model.initial_dual_point(initial_iterate.multipliers.constraints);
+         return initial_iterate;
+      }
+
+      Result solve(const std::optional<Vector<double>>& initial_primals = std::nullopt) {
+         NoUserCallbacks user_callbacks{};
+         return this->solve(user_callbacks, initial_primals);
+      }
+
+      Result solve(UserCallbacks& user_callbacks, const std::optional<Vector<double>>& initial_primals = std::nullopt) {
+         Iterate initial_iterate = this->initial_iterate(initial_primals);
+         return this->uno.solve(this->model, initial_iterate, this->options, user_callbacks);
+      }
+
+      const Model& model;
+      const Options options;
+      const std::unique_ptr<ConstraintRelaxationStrategy> constraint_relaxation_strategy;
+      const std::unique_ptr<GlobalizationMechanism> globalization_mechanism;
+      Uno uno;
+   };
+
+   // single solve of the model
+   inline Result solve_model(const Model& model, const Options& options, const std::optional<Vector<double>>& initial_primals = std::nullopt) {
+      TestSolver solver(model, options);
+      return solver.solve(initial_primals);
+   }
+
+   // single solve of the model reformulated for the strategies (e.g. the slacks of the interior point method)
+   inline Result solve_reformulated_model(std::unique_ptr<Model> original_model, const Options& options,
+         const std::optional<Vector<double>>& initial_primals = std::nullopt) {
+      const std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(original_model), options);
+      return solve_model(*model, options, initial_primals);
+   }
+} // namespace
+
+#endif // UNO_TESTSOLVER_H
@@ -2,14 +2,23 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "ingredients/constraint_relaxation_strategies/OptimalityProblem.hpp"
+#include "ingredients/hessian_models/HessianModel.hpp"
+#include "ingredients/hessian_models/HessianModelFactory.hpp"
 #include "ingredients/subproblem_solvers/BQPD/BQPDSolver.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
 #include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
 #include "optimization/WarmstartInformation.hpp"
+#include "options/DefaultOptions.hpp"
 #include "options/Options.hpp"
 #include "tools/Infinity.hpp"
+#include "tools/Statistics.hpp"
+#include "QuadraticTestModel.hpp"
 
 using namespace uno;
 
@@ -143,4 +152,83 @@ TEST(BQPDSolver, QP) {
       EXPECT_NEAR(direction.multipliers.upper_bounds[index], upper_bound_duals_reference[index], tolerance);
    }
 }
- */
\ No newline at end of file
+ */
+
+// the tests solve the QP of QuadraticTestModel (solution (2, 3), multipliers (0, -4) of the constraints)
+TEST(BQPDSolver, ConcurrentSolves) {
+   // each thread owns its solver instance: the BQPD common blocks must not leak between instances
+   const size_t number_threads = 4;
+   const size_t number_solves = 50;
+   Options options = DefaultOptions::load();
+   options["print_subproblem"] = "no";
+   const QuadraticTestModel model;
+   const OptimalityProblem problem(model);
+   std::vector<size_t> number_correct_solves(number_threads, 0);
+
+   std::vector<std::thread> threads{};
+   for (size_t thread_index: Range(number_threads)) {
+      threads.emplace_back([&, thread_index]() {
+         BQPDSolver bqpd_solver(2, 2, 2, 4, 2, BQPDProblemType::QP, options);
+         const std::unique_ptr<HessianModel> hessian_model = HessianModelFactory::create("exact", 2, 2, false, options);
+         Statistics statistics(options);
+         Vector<double> initial_point(2, 0.);
+         for ([[maybe_unused]] size_t solve_index: Range(number_solves)) {
+            Iterate current_iterate(2, 2);
+            Direction direction(2, 2);
+            WarmstartInformation warmstart_information{};
+            bqpd_solver.solve_QP(statistics, problem, current_iterate, current_iterate.multipliers.constraints, initial_point, direction,
+                  *hessian_model, INF<double>, warmstart_information);
+            if (direction.status == SubproblemStatus::OPTIMAL && std::abs(direction.primals[0] - 2.) <= 1e-8 &&
+                  std::abs(direction.primals[1] - 3.) <= 1e-8 && std::abs(direction.multipliers.constraints[1] + 4.) <= 1e-8) {
+               number_correct_solves[thread_index]++;
+            }
+         }
+      });
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   for (size_t thread_index: Range(number_threads)) {
+      EXPECT_EQ(number_correct_solves[thread_index], number_solves);
+   }
+}
+
+TEST(BQPDSolver, InterleavedHotStarts) {
+   // two instances alternately hot-start their re-solves on different problems: the factors kept in the common blocks by one instance
+   // must not be reused by the other
+   Options options = DefaultOptions::load();
+   options["print_subproblem"] = "no";
+   const QuadraticTestModel model;
+   const OptimalityProblem problem(model);
+   const std::unique_ptr<HessianModel> hessian_model = HessianModelFactory::create("exact", 2, 2, false, options);
+   Statistics statistics(options);
+   const Vector<double> initial_point(2, 0.);
+   // without trust region, the solution is (2, 3). With the trust-region radius 1, the solution is (0, 1) (active bounds)
+   BQPDSolver unbounded_solver(2, 2, 2, 4, 2, BQPDProblemType::QP, options);
+   BQPDSolver trust_region_solver(2, 2, 2, 4, 2, BQPDProblemType::QP, options);
+   WarmstartInformation warmstart_information{};
+   for (size_t solve_index: Range(10)) {
+      // the first solves are cold starts, the next ones only change the bounds (hot starts with the factors of the instance)
+      if (0 < solve_index) {
+         warmstart_information.no_changes();
+      }
+      Iterate unbounded_iterate(2, 2);
+      Direction unbounded_direction(2, 2);
+      unbounded_solver.solve_QP(statistics, problem, unbounded_iterate, unbounded_iterate.multipliers.constraints, initial_point,
+            unbounded_direction, *hessian_model, INF<double>, warmstart_information);
+      ASSERT_EQ(unbounded_direction.status, SubproblemStatus::OPTIMAL);
+      EXPECT_NEAR(unbounded_direction.primals[0], 2., 1e-8);
+      EXPECT_NEAR(unbounded_direction.primals[1], 3., 1e-8);
+      EXPECT_NEAR(unbounded_direction.multipliers.constraints[1], -4., 1e-8);
+
+      Iterate trust_region_iterate(2, 2);
+      Direction trust_region_direction(2, 2);
+      trust_region_solver.solve_QP(statistics, problem, trust_region_iterate, trust_region_iterate.multipliers.constraints, initial_point,
+            trust_region_direction, *hessian_model, 1., warmstart_information);
+      ASSERT_EQ(trust_region_direction.status, SubproblemStatus::OPTIMAL);
+      EXPECT_NEAR(trust_region_direction.primals[0], 0., 1e-8);
+      EXPECT_NEAR(trust_region_direction.primals[1], 1., 1e-8);
+      EXPECT_NEAR(trust_region_direction.multipliers.constraints[0], 0., 1e-8);
+      EXPECT_NEAR(trust_region_direction.multipliers.constraints[1], 0., 1e-8);
+   }
+}
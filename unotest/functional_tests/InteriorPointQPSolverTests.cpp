@@ -0,0 +1,114 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/constraint_relaxation_strategies/OptimalityProblem.hpp"
+#include "ingredients/hessian_models/HessianModel.hpp"
+#include "ingredients/hessian_models/HessianModelFactory.hpp"
+#include "ingredients/subproblem_solvers/InteriorPointQPSolver.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Statistics.hpp"
+#include "QuadraticTestModel.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-6;
+
+static Options interior_point_QP_options() {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(DefaultOptions::determine_solvers());
+   return options;
+}
+
+TEST(InteriorPointQPSolver, QP) {
+   const Options options = interior_point_QP_options();
+   const QuadraticTestModel model;
+   const OptimalityProblem problem(model);
+   InteriorPointQPSolver solver(2, 2, 2, 4, 2, options);
+   const std::unique_ptr<HessianModel> hessian_model = HessianModelFactory::create("exact", 2, 2, false, options);
+   Statistics statistics(options);
+   Iterate current_iterate(2, 2);
+   Direction direction(2, 2);
+   const Vector<double> initial_point(2, 0.);
+   const WarmstartInformation warmstart_information{};
+   solver.solve_QP(statistics, problem, current_iterate, current_iterate.multipliers.constraints, initial_point, direction, *hessian_model,
+         INF<double>, warmstart_information);
+
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 2., tolerance);
+   EXPECT_NEAR(direction.primals[1], 3., tolerance);
+   // only the second constraint is active (upper bound)
+   EXPECT_NEAR(direction.multipliers.constraints[0], 0., tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[1], -4., tolerance);
+   EXPECT_NEAR(direction.subproblem_objective, -56., tolerance);
+}
+
+TEST(InteriorPointQPSolver, LP) {
+   // min -32 x_1 subject to the same constraints: the solution is the vertex (10/3, 11/3)
+   const Options options = interior_point_QP_options();
+   const QuadraticTestModel model;
+   const OptimalityProblem problem(model);
+   InteriorPointQPSolver solver(2, 2, 2, 4, 2, options);
+   Iterate current_iterate(2, 2);
+   Direction direction(2, 2);
+   const Vector<double> initial_point(2, 0.);
+   const WarmstartInformation warmstart_information{};
+   solver.solve_LP(problem, current_iterate, initial_point, direction, INF<double>, warmstart_information);
+
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 10. / 3., tolerance);
+   EXPECT_NEAR(direction.primals[1], 11. / 3., tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[0], -32. / 3., tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[1], -32. / 3., tolerance);
+}
+
+TEST(InteriorPointQPSolver, InfeasibleLinearizedConstraints) {
+   // at x = (10, 0), the first constraint is violated by 3: it cannot be satisfied within a trust region of radius 1
+   const Options options = interior_point_QP_options();
+   const QuadraticTestModel model;
+   const OptimalityProblem problem(model);
+   InteriorPointQPSolver solver(2, 2, 2, 4, 2, options);
+   const std::unique_ptr<HessianModel> hessian_model = HessianModelFactory::create("exact", 2, 2, false, options);
+   Statistics statistics(options);
+   Iterate current_iterate(2, 2);
+   current_iterate.primals[0] = 10.;
+   Direction direction(2, 2);
+   const Vector<double> initial_point(2, 0.);
+   const WarmstartInformation warmstart_information{};
+   solver.solve_QP(statistics, problem, current_iterate, current_iterate.multipliers.constraints, initial_point, direction, *hessian_model,
+         1., warmstart_information);
+   EXPECT_EQ(direction.status, SubproblemStatus::INFEASIBLE);
+
+   // feasible with a larger radius
+   solver.solve_QP(statistics, problem, current_iterate, current_iterate.multipliers.constraints, initial_point, direction, *hessian_model,
+         5., warmstart_information);
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], -5., tolerance);
+   EXPECT_NEAR(direction.primals[1], 2., tolerance);
+}
+
+TEST(InteriorPointQPSolver, AdaptiveAccuracy) {
+   // the KKT error of the current iterate is not computed (infinite): the QP is solved to the loosest tolerance
+   Options options = interior_point_QP_options();
+   options["subproblem_accuracy"] = "adaptive";
+   const QuadraticTestModel model;
+   const OptimalityProblem problem(model);
+   InteriorPointQPSolver solver(2, 2, 2, 4, 2, options);
+   const std::unique_ptr<HessianModel> hessian_model = HessianModelFactory::create("exact", 2, 2, false, options);
+   Statistics statistics(options);
+   Iterate current_iterate(2, 2);
+   Direction direction(2, 2);
+   const Vector<double> initial_point(2, 0.);
+   const WarmstartInformation warmstart_information{};
+   solver.solve_QP(statistics, problem, current_iterate, current_iterate.multipliers.constraints, initial_point, direction, *hessian_model,
+         INF<double>, warmstart_information);
+
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 2., 1e-2);
+   EXPECT_NEAR(direction.primals[1], 3., 1e-2);
+}
@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 #include "ingredients/subproblem_solvers/MA57/MA57Solver.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
+#include "options/DefaultOptions.hpp"
 
 using namespace uno;
 
@@ -23,7 +24,7 @@ TEST(MA57Solver, SystemSize5) {
    result.fill(0.);
    const std::array<double, n> reference{1., 2., 3., 4., 5.};
 
-   MA57Solver solver(n, nnz);
+   MA57Solver solver(n, nnz, DefaultOptions::load());
    solver.do_symbolic_analysis(matrix);
    solver.do_numerical_factorization(matrix);
    solver.solve_indefinite_system(matrix, rhs, result);
@@ -46,7 +47,7 @@ TEST(MA57Solver, Inertia) {
    matrix.insert(5., 2, 3);
    matrix.insert(1., 4, 4);
 
-   MA57Solver solver(n, nnz);
+   MA57Solver solver(n, nnz, DefaultOptions::load());
    solver.do_symbolic_analysis(matrix);
    solver.do_numerical_factorization(matrix);
 
@@ -68,10 +69,161 @@ TEST(MA57Solver, SingularMatrix) {
    matrix.insert(0.625075, 1, 1);
    matrix.insert(0., 2, 2);
    matrix.insert(0., 3, 3);
-   MA57Solver solver(n, nnz);
+   MA57Solver solver(n, nnz, DefaultOptions::load());
    solver.do_symbolic_analysis(matrix);
    solver.do_numerical_factorization(matrix);
 
    // expected inertia (1, 1, 2)
    ASSERT_TRUE(solver.matrix_is_singular());
 }
+
+TEST(MA57Solver, BorrowedIndices) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   // 1-based int indices: the sparsity pattern is not copied by the solver
+   SymmetricMatrix<int, double> matrix(n, nnz, false, "COO", 1);
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   result.fill(0.);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   MA57Solver<int> solver(n, nnz, DefaultOptions::load());
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   const double tolerance = 1e-8;
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], tolerance);
+   }
+}
+
+TEST(MA57Solver, UserPivotOrder) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   result.fill(0.);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   Options options = DefaultOptions::load();
+   options["MA57_ordering"] = "user";
+   MA57Solver solver(n, nnz, options);
+   solver.set_pivot_order({4, 3, 2, 1, 0});
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   const double tolerance = 1e-8;
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], tolerance);
+   }
+}
+
+TEST(MA57Solver, CachedPivotOrder) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   MA57Solver solver(n, nnz, DefaultOptions::load());
+   // the second analysis reuses the pivot order of the first one
+   for (size_t analysis = 0; analysis < 2; analysis++) {
+      result.fill(0.);
+      solver.do_symbolic_analysis(matrix);
+      solver.do_numerical_factorization(matrix);
+      solver.solve_indefinite_system(matrix, rhs, result);
+
+      const double tolerance = 1e-8;
+      for (size_t index: Range(n)) {
+         EXPECT_NEAR(result[index], reference[index], tolerance);
+      }
+   }
+}
+
+TEST(MA57Solver, BlockSolve) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   const size_t number_rhs = 2;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+   // column-major n x 2 block: the second rhs is twice the first one
+   const Vector<double> rhs{8., 45., 31., 15., 17., 16., 90., 62., 30., 34.};
+   Vector<double> result(n * number_rhs);
+   result.fill(0.);
+   const std::array<double, n * number_rhs> reference{1., 2., 3., 4., 5., 2., 4., 6., 8., 10.};
+
+   MA57Solver solver(n, nnz, DefaultOptions::load());
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_systems(matrix, rhs, result, number_rhs);
+
+   const double tolerance = 1e-8;
+   for (size_t index: Range(n * number_rhs)) {
+      EXPECT_NEAR(result[index], reference[index], tolerance);
+   }
+}
+
+TEST(MA57Solver, PersistedSymbolicAnalysis) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   Options options = DefaultOptions::load();
+   options["symbolic_analysis_persistence"] = "memory";
+   SymbolicAnalysisRepository::clear_memory();
+   // the second solver restores the analysis of the first one
+   for (size_t solve = 0; solve < 2; solve++) {
+      MA57Solver solver(n, nnz, options);
+      result.fill(0.);
+      solver.do_symbolic_analysis(matrix);
+      solver.do_numerical_factorization(matrix);
+      solver.solve_indefinite_system(matrix, rhs, result);
+
+      const double tolerance = 1e-8;
+      for (size_t index: Range(n)) {
+         EXPECT_NEAR(result[index], reference[index], tolerance);
+      }
+   }
+   SymbolicAnalysisRepository::clear_memory();
+}
@@ -2,8 +2,12 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include <gtest/gtest.h>
+#include <array>
+#include <stdexcept>
 #include "ingredients/subproblem_solvers/MUMPS/MUMPSSolver.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
 
 using namespace uno;
 
@@ -25,7 +29,7 @@ TEST(MUMPSSolver, SystemSize5) {
    result.fill(0.);
    const std::array<double, n> reference{1., 2., 3., 4., 5.};
 
-   MUMPSSolver solver(n, nnz);
+   MUMPSSolver solver(n, nnz, DefaultOptions::load());
    solver.do_symbolic_analysis(matrix);
    solver.do_numerical_factorization(matrix);
    solver.solve_indefinite_system(matrix, rhs, result);
@@ -64,7 +68,7 @@ TEST(MUMPSSolver, Inertia) {
    matrix.insert(5., 2, 3);
    matrix.insert(1., 4, 4);
 
-   MUMPSSolver solver(n, nnz);
+   MUMPSSolver solver(n, nnz, DefaultOptions::load());
    solver.do_symbolic_analysis(matrix);
    solver.do_numerical_factorization(matrix);
 
@@ -86,10 +90,49 @@ TEST(MUMPSSolver, SingularMatrix) {
    matrix.insert(0.625075, 1, 1);
    matrix.insert(0., 2, 2);
    matrix.insert(0., 3, 3);
-   MUMPSSolver solver(n, nnz);
+   MUMPSSolver solver(n, nnz, DefaultOptions::load());
    solver.do_symbolic_analysis(matrix);
    solver.do_numerical_factorization(matrix);
 
    // expected inertia (1, 1, 2)
    ASSERT_TRUE(solver.matrix_is_singular());
-}
\ No newline at end of file
+}
+
+TEST(MUMPSSolver, OutOfCoreFactorization) {
+   const double tolerance = 1e-8;
+
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   // forced, then automatic (the in-core estimate is compared to the budget): the factors on disk give the same solution
+   for (const char* out_of_core: {"yes", "automatic"}) {
+      Options options = DefaultOptions::load();
+      options["MUMPS_out_of_core"] = out_of_core;
+      options["MUMPS_memory_budget"] = "1";
+      Vector<double> result(n);
+      result.fill(0.);
+      MUMPSSolver solver(n, nnz, options);
+      solver.do_symbolic_analysis(matrix);
+      solver.do_numerical_factorization(matrix);
+      solver.solve_indefinite_system(matrix, rhs, result);
+      for (size_t index: Range(n)) {
+         EXPECT_NEAR(result[index], reference[index], tolerance);
+      }
+   }
+}
+
+TEST(MUMPSSolver, InvalidOutOfCoreMode) {
+   Options options = DefaultOptions::load();
+   options["MUMPS_out_of_core"] = "sometimes";
+   ASSERT_THROW(MUMPSSolver(5, 7, options), std::invalid_argument);
+}
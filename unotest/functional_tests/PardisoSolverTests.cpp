@@ -0,0 +1,99 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <array>
+#include "ingredients/subproblem_solvers/PARDISO/PardisoSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/DefaultOptions.hpp"
+
+using namespace uno;
+
+static SymmetricMatrix<size_t, double> create_matrix() {
+   SymmetricMatrix<size_t, double> matrix(5, 7, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+   return matrix;
+}
+
+TEST(PardisoSolver, SystemSize5) {
+   const double tolerance = 1e-8;
+   const size_t n = 5;
+   const SymmetricMatrix<size_t, double> matrix = create_matrix();
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   result.fill(0.);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   PardisoSolver solver(n, matrix.number_nonzeros(), DefaultOptions::load());
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], tolerance);
+   }
+}
+
+// eigenvalues: -7.83039207, 8.94059148, -3.50815575, 1.7888887, 4.60906763
+TEST(PardisoSolver, Inertia) {
+   const SymmetricMatrix<size_t, double> matrix = create_matrix();
+   PardisoSolver solver(5, matrix.number_nonzeros(), DefaultOptions::load());
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 3);
+   ASSERT_EQ(number_negative, 2);
+   ASSERT_EQ(number_zero, 0);
+   ASSERT_FALSE(solver.matrix_is_singular());
+}
+
+// the analysis is reused by the factorizations of new values
+TEST(PardisoSolver, NumericalFactorizationOnly) {
+   const size_t n = 5;
+   SymmetricMatrix<size_t, double> matrix = create_matrix();
+   PardisoSolver solver(n, matrix.number_nonzeros(), DefaultOptions::load());
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+
+   // the matrix is multiplied by 2
+   double* entries = matrix.data_pointer();
+   for (size_t nonzero_index: Range(matrix.number_nonzeros())) {
+      entries[nonzero_index] *= 2.;
+   }
+   solver.do_numerical_factorization(matrix);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   solver.solve_indefinite_system(matrix, rhs, result);
+   const std::array<double, n> reference{0.5, 1., 1.5, 2., 2.5};
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], 1e-8);
+   }
+}
+
+TEST(PardisoSolver, SingularMatrix) {
+   const size_t n = 4;
+   const size_t nnz = 7;
+   // comes from hs015 solved with byrd preset
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert( -0.0198, 0, 0);
+   matrix.insert(0.625075, 0, 0);
+   matrix.insert(-0.277512, 0, 1);
+   matrix.insert(-0.624975, 1, 1);
+   matrix.insert(0.625075, 1, 1);
+   matrix.insert(0., 2, 2);
+   matrix.insert(0., 3, 3);
+   PardisoSolver solver(n, nnz, DefaultOptions::load());
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+
+   // expected inertia (1, 1, 2): the zero pivots are perturbed
+   ASSERT_TRUE(solver.matrix_is_singular());
+}
@@ -0,0 +1,31 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+static Result solve_with_SLQP(const std::string& preset) {
+   Options options = test_options(preset);
+   options["subproblem"] = "SLQP";
+   return solve_reformulated_model(std::make_unique<QuadraticTestModel>(), options);
+}
+
+TEST(SLQPSubproblem, InequalityConstrainedProblem) {
+   for (const std::string preset: {"filtersqp", "byrd"}) {
+      const Result result = solve_with_SLQP(preset);
+      ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+      ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+      ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+      // the constraint -x0 + 2 x1 <= 4 is active with multiplier -4
+      ASSERT_NEAR(result.solution.multipliers.constraints[1], -4., 1e-6);
+      // one EQP factorization (at least) per iteration
+      ASSERT_LE(result.iteration, result.number_factorizations);
+   }
+}
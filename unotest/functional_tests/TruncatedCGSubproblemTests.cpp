@@ -0,0 +1,178 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/MemoryReport.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+// chained Rosenbrock function sum_i 100 (x_{i+1} - x_i^2)^2 + (1 - x_i)^2, with an optional upper bound on all the variables.
+// Without bound, the solution is (1, ..., 1)
+class ChainedRosenbrockModel: public Model {
+public:
+   ChainedRosenbrockModel(size_t number_variables, double upper_bound, std::vector<double> initial_point):
+         Model("chained Rosenbrock", number_variables, 0, 1.),
+         upper_bound(upper_bound),
+         initial_point(std::move(initial_point)),
+         upper_bounded_variables(is_finite(upper_bound) ? number_variables : 0) {
+      std::iota(this->upper_bounded_variables.begin(), this->upper_bounded_variables.end(), size_t(0));
+   }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+      double objective = 0.;
+      for (size_t index: Range(this->number_variables - 1)) {
+         objective += 100. * std::pow(x[index + 1] - x[index] * x[index], 2) + std::pow(1. - x[index], 2);
+      }
+      return objective;
+   }
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      for (size_t index: Range(this->number_variables)) {
+         double derivative = 0.;
+         if (index + 1 < this->number_variables) {
+            derivative += -400. * x[index] * (x[index + 1] - x[index] * x[index]) - 2. * (1. - x[index]);
+         }
+         if (0 < index) {
+            derivative += 200. * (x[index] - x[index - 1] * x[index - 1]);
+         }
+         gradient.insert(index, derivative);
+      }
+   }
+   void evaluate_constraints(const Vector<double>& /*x*/, std::vector<double>& /*constraints*/) const override { }
+   void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t /*constraint_index*/, SparseVector<double>& /*gradient*/) const override { }
+   void evaluate_constraint_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& /*constraint_jacobian*/) const override { }
+   // tridiagonal Hessian, upper triangle column by column
+   void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& /*multipliers*/,
+         SymmetricMatrix<size_t, double>& hessian) const override {
+      hessian.reset();
+      for (size_t index: Range(this->number_variables)) {
+         double diagonal_entry = 0.;
+         if (0 < index) {
+            hessian.insert(objective_multiplier * -400. * x[index - 1], index - 1, index);
+            diagonal_entry += 200.;
+         }
+         if (index + 1 < this->number_variables) {
+            diagonal_entry += 1200. * x[index] * x[index] - 400. * x[index + 1] + 2.;
+         }
+         hessian.insert(objective_multiplier * diagonal_entry, index, index);
+         hessian.finalize_column(index);
+      }
+   }
+
+   [[nodiscard]] double variable_lower_bound(size_t /*variable_index*/) const override { return -INF<double>; }
+   [[nodiscard]] double variable_upper_bound(size_t /*variable_index*/) const override { return this->upper_bound; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t /*variable_index*/) const override {
+      return is_finite(this->upper_bound) ? BOUNDED_UPPER : UNBOUNDED;
+   }
+   [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables_collection; }
+   [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+   [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+      return this->upper_bounded_variables_collection;
+   }
+   [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+   [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return -INF<double>; }
+   [[nodiscard]] double constraint_upper_bound(size_t /*constraint_index*/) const override { return INF<double>; }
+   [[nodiscard]] FunctionType get_objective_type() const override { return NONLINEAR; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return LINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return UNBOUNDED; }
+   [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->empty_collection; }
+
+   // the initial point is repeated along the variables
+   void initial_primal_point(Vector<double>& x) const override {
+      for (size_t index: Range(this->number_variables)) {
+         x[index] = this->initial_point[index % this->initial_point.size()];
+      }
+   }
+   void initial_dual_point(Vector<double>& /*multipliers*/) const override { }
+   void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+   [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->number_variables; }
+   [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 0; }
+   [[nodiscard]] size_t number_hessian_nonzeros() const override { return 2 * this->number_variables - 1; }
+
+protected:
+   const double upper_bound;
+   const std::vector<double> initial_point;
+   std::vector<size_t> upper_bounded_variables;
+   const std::vector<size_t> no_indices{};
+   const CollectionAdapter<std::vector<size_t>> upper_bounded_variables_collection{this->upper_bounded_variables};
+   const CollectionAdapter<std::vector<size_t>> empty_collection{this->no_indices};
+   const SparseVector<size_t> slacks{};
+   const Vector<size_t> fixed_variables{};
+};
+
+// the trust-region presets solve the problems without general constraints with truncated CG in place of the QP solver
+static Result solve_with_truncated_CG(const std::string& preset, const Model& model) {
+   Options options = test_options(preset);
+   options["memory_report"] = "yes";
+   const Result result = solve_model(model, options);
+   // the CG vectors are reported by the subproblem
+   EXPECT_TRUE(std::any_of(result.memory_usages.cbegin(), result.memory_usages.cend(), [](const MemoryUsage& usage) {
+      return usage.component.find("CG vectors") != std::string::npos;
+   })) << preset;
+   return result;
+}
+
+// unconstrained, from the standard starting point (-1.2, 1, -1.2, 1, ...)
+TEST(TruncatedCGSubproblem, FreeChainedRosenbrock) {
+   for (const std::string preset: {"filtersqp", "funnelsqp"}) {
+      for (const size_t number_variables: {size_t(2), size_t(100)}) {
+         const ChainedRosenbrockModel model(number_variables, INF<double>, {-1.2, 1.});
+         const Result result = solve_with_truncated_CG(preset, model);
+         ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT) << preset << ", n = " << number_variables;
+         for (size_t index: Range(number_variables)) {
+            ASSERT_NEAR(result.solution.primals[index], 1., 1e-5) << preset << ", n = " << number_variables;
+         }
+      }
+   }
+}
+
+// with x <= 0.5, the last variables are at their bound with nonpositive multipliers
+TEST(TruncatedCGSubproblem, BoundActiveChainedRosenbrock) {
+   for (const std::string preset: {"filtersqp", "funnelsqp"}) {
+      const ChainedRosenbrockModel model(100, 0.5, {-1.2, 0.});
+      const Result result = solve_with_truncated_CG(preset, model);
+      ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT) << preset;
+      size_t number_active_bounds = 0;
+      for (size_t index: Range(model.number_variables)) {
+         ASSERT_LE(result.solution.primals[index], 0.5 + 1e-8) << preset;
+         ASSERT_LE(result.solution.multipliers.upper_bounds[index], 1e-8) << preset;
+         if (result.solution.multipliers.upper_bounds[index] < -1e-6) {
+            ASSERT_NEAR(result.solution.primals[index], 0.5, 1e-6) << preset;
+            number_active_bounds++;
+         }
+      }
+      ASSERT_LT(0, number_active_bounds) << preset;
+   }
+}
+
+// at (0, 1), the Hessian diag(-398, 200) is indefinite: CG follows a direction of negative curvature to the trust-region boundary
+TEST(TruncatedCGSubproblem, NegativeCurvatureRosenbrock) {
+   for (const std::string preset: {"filtersqp", "funnelsqp"}) {
+      const ChainedRosenbrockModel model(2, INF<double>, {0., 1.});
+      const Result result = solve_with_truncated_CG(preset, model);
+      ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT) << preset;
+      ASSERT_NEAR(result.solution.primals[0], 1., 1e-5) << preset;
+      ASSERT_NEAR(result.solution.primals[1], 1., 1e-5) << preset;
+   }
+}
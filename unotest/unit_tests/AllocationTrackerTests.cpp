@@ -0,0 +1,50 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "tools/AllocationTracker.hpp"
+
+using namespace uno;
+
+TEST(AllocationTracker, CountsAllocationsOfScope) {
+   AllocationCounters counters{};
+   {
+      const AllocationTracker::Scope scope(counters);
+      const auto value = std::make_unique<double>(1.);
+      ASSERT_EQ(*value, 1.);
+   }
+   // allocations outside the scope are not counted
+   const auto other_value = std::make_unique<double>(2.);
+   if (AllocationTracker::is_enabled) {
+      ASSERT_EQ(counters.allocations, 1);
+      ASSERT_EQ(counters.bytes, sizeof(double));
+   }
+   else {
+      ASSERT_EQ(counters.allocations, 0);
+   }
+}
+
+TEST(AllocationTracker, NestedScopes) {
+   AllocationCounters outer_counters{}, inner_counters{};
+   const AllocationTracker::Scope outer_scope(outer_counters);
+   {
+      const AllocationTracker::Scope inner_scope(inner_counters);
+      const auto value = std::make_unique<int>(1);
+   }
+   const auto value = std::make_unique<int>(2);
+   ASSERT_EQ(outer_counters.allocations, AllocationTracker::is_enabled ? 1 : 0);
+   ASSERT_EQ(inner_counters.allocations, AllocationTracker::is_enabled ? 1 : 0);
+}
+
+TEST(AllocationTracker, ForbiddenAllocationAborts) {
+   if (!AllocationTracker::is_enabled) {
+      GTEST_SKIP() << "Uno was built without WITH_ALLOCATION_TRACKING";
+   }
+   ASSERT_DEATH({
+      const AllocationTracker::Prohibition prohibition(true);
+      const auto value = std::make_unique<int>(1);
+   }, "forbidden heap allocation");
+   // the allocations are allowed again
+   const auto value = std::make_unique<int>(1);
+}
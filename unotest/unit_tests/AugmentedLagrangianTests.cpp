@@ -0,0 +1,46 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+static Result solve_with_augmented_lagrangian(const std::string& preset) {
+   Options options = test_options(preset);
+   options["constraint_relaxation_strategy"] = "augmented_lagrangian";
+   options["max_iterations"] = "1000";
+   return solve_reformulated_model(std::make_unique<QuadraticTestModel>(), options);
+}
+
+TEST(AugmentedLagrangian, InequalityConstrainedProblem) {
+   for (const std::string preset: {"byrd", "ipopt", "filtersqp"}) {
+      const Result result = solve_with_augmented_lagrangian(preset);
+      ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+      ASSERT_NEAR(result.solution.primals[0], 2., 1e-5);
+      ASSERT_NEAR(result.solution.primals[1], 3., 1e-5);
+      // the constraint -x0 + 2 x1 <= 4 is active with multiplier -4
+      ASSERT_NEAR(result.solution.multipliers.constraints[1], -4., 1e-4);
+      // the bound-constrained subproblems are solved without factorization (L-BFGS-B or truncated CG)
+      ASSERT_EQ(result.number_factorizations, 0);
+   }
+}
+
+TEST(AugmentedLagrangian, InvalidPenaltyParameter) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(Presets::get_preset_options("byrd"));
+   options["constraint_relaxation_strategy"] = "augmented_lagrangian";
+   options["AL_initial_penalty_parameter"] = "0";
+   const QuadraticTestModel model;
+   ASSERT_THROW(ConstraintRelaxationStrategyFactory::create(model, options), std::invalid_argument);
+}
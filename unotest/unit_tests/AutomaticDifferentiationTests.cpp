@@ -0,0 +1,146 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/AutomaticDifferentiationModel.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "tools/Infinity.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+// f(x) = x0 x1 + x2^2, c0(x) = x0 + 2 x1, c1(x) = sin(x0) x2, c2(x) = x1 / x3
+struct TestFunctions {
+   template <typename Number>
+   void operator()(const std::vector<Number>& x, Number& objective, std::vector<Number>& constraints) const {
+      objective = x[0] * x[1] + x[2] * x[2];
+      constraints[0] = x[0] + 2. * x[1];
+      constraints[1] = sin(x[0]) * x[2];
+      constraints[2] = x[1] / x[3];
+   }
+};
+
+// min (x0 - 1)^2 + (x1 - 2)^2 s.t. x0 + x1 = 1
+struct ProjectionFunctions {
+   template <typename Number>
+   void operator()(const std::vector<Number>& x, Number& objective, std::vector<Number>& constraints) const {
+      objective = pow(x[0] - 1., 2) + pow(x[1] - 2., 2);
+      constraints[0] = x[0] + x[1];
+   }
+};
+
+static AutomaticDifferentiationModel<TestFunctions> create_test_model() {
+   return AutomaticDifferentiationModel<TestFunctions>("test", TestFunctions{}, std::vector<double>(4, -INF<double>),
+      std::vector<double>(4, INF<double>), {1., -INF<double>, 0.}, {1., 0., 1.}, {1., 2., 3., 4.});
+}
+
+TEST(AutomaticDifferentiation, DetectsSparsityAndFunctionTypes) {
+   const auto model = create_test_model();
+   ASSERT_EQ(model.get_objective_type(), NONLINEAR);
+   ASSERT_EQ(model.get_constraint_type(0), LINEAR);
+   ASSERT_EQ(model.get_constraint_type(1), NONLINEAR);
+   ASSERT_EQ(model.get_constraint_type(2), NONLINEAR);
+   ASSERT_EQ(model.get_linear_constraints().size(), 1);
+   ASSERT_EQ(model.get_equality_constraints().size(), 1);
+   ASSERT_EQ(model.number_objective_gradient_nonzeros(), 3);
+   ASSERT_EQ(model.number_jacobian_nonzeros(), 6);
+   // (0, 0), (0, 1), (0, 2), (2, 2), (1, 3), (3, 3)
+   ASSERT_EQ(model.number_hessian_nonzeros(), 6);
+   // the Jacobian columns {0, 3} and {1, 2} have no nonzero in a common row
+   ASSERT_EQ(model.number_jacobian_colors(), 2);
+}
+
+TEST(AutomaticDifferentiation, FirstDerivatives) {
+   const auto model = create_test_model();
+   const Vector<double> x{0.5, 2., 3., 4.};
+   ASSERT_NEAR(model.evaluate_objective(x), 0.5 * 2. + 9., 1e-14);
+
+   SparseVector<double> gradient(4);
+   model.evaluate_objective_gradient(x, gradient);
+   Vector<double> dense_gradient(4, 0.);
+   for (const auto [variable_index, derivative]: gradient) {
+      dense_gradient[variable_index] = derivative;
+   }
+   ASSERT_NEAR(dense_gradient[0], 2., 1e-14);
+   ASSERT_NEAR(dense_gradient[1], 0.5, 1e-14);
+   ASSERT_NEAR(dense_gradient[2], 6., 1e-14);
+   ASSERT_EQ(dense_gradient[3], 0.);
+
+   RectangularMatrix<double> jacobian(3, 4);
+   model.evaluate_constraint_jacobian(x, jacobian);
+   Vector<double> row(4);
+   const std::vector<std::vector<double>> expected_jacobian{
+      {1., 2., 0., 0.},
+      {std::cos(0.5) * 3., 0., std::sin(0.5), 0.},
+      {0., 1. / 4., 0., -2. / 16.}
+   };
+   for (size_t constraint_index: Range(3)) {
+      row.fill(0.);
+      for (const auto [variable_index, derivative]: jacobian[constraint_index]) {
+         row[variable_index] = derivative;
+      }
+      // the single constraint gradient and the colored Jacobian agree
+      SparseVector<double> constraint_gradient(4);
+      model.evaluate_constraint_gradient(x, constraint_index, constraint_gradient);
+      for (const auto [variable_index, derivative]: constraint_gradient) {
+         ASSERT_NEAR(derivative, row[variable_index], 1e-14);
+      }
+      for (size_t variable_index: Range(4)) {
+         ASSERT_NEAR(row[variable_index], expected_jacobian[constraint_index][variable_index], 1e-14);
+      }
+   }
+}
+
+TEST(AutomaticDifferentiation, LagrangianHessian) {
+   const auto model = create_test_model();
+   const Vector<double> x{0.5, 2., 3., 4.};
+   const double objective_multiplier = 2.;
+   const Vector<double> multipliers{5., -1., 3.};
+   // exact Hessian of rho f - lambda^T c
+   std::vector<std::vector<double>> expected(4, std::vector<double>(4, 0.));
+   expected[0][0] = -multipliers[1] * (-std::sin(0.5) * 3.);
+   expected[0][1] = expected[1][0] = objective_multiplier;
+   expected[0][2] = expected[2][0] = -multipliers[1] * std::cos(0.5);
+   expected[2][2] = 2. * objective_multiplier;
+   expected[1][3] = expected[3][1] = -multipliers[2] * (-1. / 16.);
+   expected[3][3] = -multipliers[2] * (2. * 2. / 64.);
+
+   SymmetricMatrix<size_t, double> hessian(4, model.number_hessian_nonzeros(), false, "COO");
+   model.evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+   size_t number_entries = 0;
+   hessian.for_each([&](size_t row_index, size_t column_index, double entry) {
+      ASSERT_NEAR(entry, expected[row_index][column_index], 1e-13);
+      number_entries++;
+   });
+   ASSERT_EQ(number_entries, 6);
+
+   const Vector<double> vector{1., -2., 0.5, 3.};
+   Vector<double> product(4);
+   model.evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, product);
+   for (size_t row_index: Range(4)) {
+      double expected_product = 0.;
+      for (size_t column_index: Range(4)) {
+         expected_product += expected[row_index][column_index] * vector[column_index];
+      }
+      ASSERT_NEAR(product[row_index], expected_product, 1e-13);
+   }
+}
+
+TEST(AutomaticDifferentiation, Solve) {
+   const Options options = test_options("filtersqp");
+   const AutomaticDifferentiationModel<ProjectionFunctions> model("projection", ProjectionFunctions{}, std::vector<double>(2, -INF<double>),
+      std::vector<double>(2, INF<double>), {1.}, {1.}, {0., 0.});
+   ASSERT_EQ(model.get_objective_type(), NONLINEAR);
+   ASSERT_EQ(model.get_constraint_type(0), LINEAR);
+   const Result result = solve_model(model, options);
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_NEAR(result.solution.primals[0], 0., 1e-8);
+   ASSERT_NEAR(result.solution.primals[1], 1., 1e-8);
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "DenseLDLTSolver.hpp"
+#include "ingredients/subproblem_solvers/AutomaticLinearSolver.hpp"
+#include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+
+using namespace uno;
+
+namespace {
+   class FailingSolver: public DenseLDLTSolver {
+   public:
+      explicit FailingSolver(size_t dimension): DenseLDLTSolver(dimension) { }
+      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& /*matrix*/) override {
+         throw std::runtime_error("FailingSolver: factorization failed");
+      }
+   };
+
+   SymmetricMatrix<size_t, double> indefinite_matrix() {
+      // [2 1; 1 -3]
+      SymmetricMatrix<size_t, double> matrix(2, 3, false, "COO");
+      matrix.insert(2., 0, 0);
+      matrix.insert(1., 0, 1);
+      matrix.insert(-3., 1, 1);
+      return matrix;
+   }
+}
+
+static const std::vector<std::string> all_solvers{"MA57", "MA27", "MA97", "MUMPS", "SSIDS", "PARDISO", "Schur"};
+
+TEST(AutomaticLinearSolver, SmallMatrix) {
+   const Options options = DefaultOptions::load();
+   const std::vector<std::string> ranking = SymmetricIndefiniteLinearSolverFactory::rank_solvers(all_solvers, 100, 500, options);
+   const std::vector<std::string> reference{"MA27", "MA57", "MUMPS", "SSIDS", "MA97", "PARDISO"};
+   ASSERT_EQ(ranking, reference);
+}
+
+TEST(AutomaticLinearSolver, MediumMatrix) {
+   const Options options = DefaultOptions::load();
+   const std::vector<std::string> ranking = SymmetricIndefiniteLinearSolverFactory::rank_solvers(all_solvers, 10000, 50000, options);
+   ASSERT_EQ(ranking.front(), "MA57");
+}
+
+TEST(AutomaticLinearSolver, LargeMatrix) {
+   const Options options = DefaultOptions::load();
+   const std::vector<std::string> ranking = SymmetricIndefiniteLinearSolverFactory::rank_solvers(all_solvers, 500000, 5000000, options);
+   ASSERT_EQ(ranking.front(), "PARDISO");
+   // without PARDISO and HSL, MUMPS is preferred
+   const std::vector<std::string> ranking_without_HSL = SymmetricIndefiniteLinearSolverFactory::rank_solvers({"MUMPS", "SSIDS"}, 500000,
+         5000000, options);
+   ASSERT_EQ(ranking_without_HSL.front(), "MUMPS");
+}
+
+TEST(AutomaticLinearSolver, UnavailableSolversAreSkipped) {
+   const Options options = DefaultOptions::load();
+   ASSERT_EQ(SymmetricIndefiniteLinearSolverFactory::rank_solvers({"MUMPS"}, 100, 500, options), std::vector<std::string>{"MUMPS"});
+   ASSERT_TRUE(SymmetricIndefiniteLinearSolverFactory::rank_solvers({}, 100, 500, options).empty());
+}
+
+TEST(AutomaticLinearSolver, MixedPrecisionRequiresMUMPS) {
+   Options options = DefaultOptions::load();
+   options["linear_solver_precision"] = "mixed";
+   ASSERT_EQ(SymmetricIndefiniteLinearSolverFactory::rank_solvers(all_solvers, 100, 500, options), std::vector<std::string>{"MUMPS"});
+   ASSERT_TRUE(SymmetricIndefiniteLinearSolverFactory::rank_solvers({"MA27", "MA57"}, 100, 500, options).empty());
+}
+
+TEST(AutomaticLinearSolver, FailingCandidateIsDiscarded) {
+   AutomaticLinearSolver<size_t> solver(2, {"failing", std::make_unique<FailingSolver>(2)}, {"dense", std::make_unique<DenseLDLTSolver>(2)});
+   const SymmetricMatrix<size_t, double> matrix = indefinite_matrix();
+   ASSERT_TRUE(solver.selected_solver().empty());
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   ASSERT_EQ(solver.selected_solver(), "dense");
+   ASSERT_EQ(solver.get_inertia(), std::make_tuple(size_t(1), size_t(1), size_t(0)));
+   // the solution of [2 1; 1 -3] x = (3, -2) is (1, 1)
+   Vector<double> rhs{3., -2.};
+   Vector<double> result(2);
+   solver.solve_indefinite_system(matrix, rhs, result);
+   ASSERT_NEAR(result[0], 1., 1e-12);
+   ASSERT_NEAR(result[1], 1., 1e-12);
+   // the subsequent factorizations are delegated to the selected solver
+   solver.do_numerical_factorization(matrix);
+   ASSERT_EQ(solver.selected_solver(), "dense");
+}
+
+TEST(AutomaticLinearSolver, BothCandidatesFail) {
+   AutomaticLinearSolver<size_t> solver(2, {"first", std::make_unique<FailingSolver>(2)}, {"second", std::make_unique<FailingSolver>(2)});
+   const SymmetricMatrix<size_t, double> matrix = indefinite_matrix();
+   solver.do_symbolic_analysis(matrix);
+   ASSERT_THROW(solver.do_numerical_factorization(matrix), std::runtime_error);
+}
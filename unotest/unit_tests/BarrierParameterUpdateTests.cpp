@@ -0,0 +1,114 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "ingredients/constraint_relaxation_strategies/OptimalityProblem.hpp"
+#include "ingredients/inequality_handling_methods/interior_point_methods/BarrierParameterUpdateStrategy.hpp"
+#include "optimization/DualResiduals.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Multipliers.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+
+using namespace uno;
+
+namespace {
+   class BarrierParameterUpdateTestStrategy: public BarrierParameterUpdateStrategy {
+   public:
+      using BarrierParameterUpdateStrategy::BarrierParameterUpdateStrategy;
+      using BarrierParameterUpdateStrategy::compute_loqo_barrier_parameter;
+   };
+
+   Options barrier_options(const std::string& rule) {
+      Options options = DefaultOptions::load();
+      options["barrier_update_rule"] = rule;
+      return options;
+   }
+
+   // the bound complementarity products of QuadraticTestModel at x = (1, 2) are z0, 2 z1 and -2 u1 (x0 >= 0 and 0 <= x1 <= 4)
+   Multipliers bound_multipliers(double first_complementarity, double second_complementarity, double third_complementarity) {
+      Multipliers multipliers(2, 2);
+      multipliers.lower_bounds[0] = first_complementarity;
+      multipliers.lower_bounds[1] = second_complementarity / 2.;
+      multipliers.upper_bounds[1] = -third_complementarity / 2.;
+      return multipliers;
+   }
+} // namespace
+
+// mu = sigma * average complementarity with sigma = 0.1 min(0.05 (1 - xi) / xi, 2)^3, where xi = min complementarity / average
+TEST(BarrierParameterUpdate, LOQOBarrierParameter) {
+   const Options options = barrier_options("loqo");
+   const BarrierParameterUpdateTestStrategy strategy(options);
+   const QuadraticTestModel model;
+   const OptimalityProblem problem(model);
+   const Vector<double> primals{1., 2.};
+   EXPECT_DOUBLE_EQ(BarrierParameterUpdateStrategy::compute_average_complementarity(problem, primals, bound_multipliers(0.1, 0.2, 0.3)), 0.2);
+   // centered point (xi = 1): sigma = 0 and mu is the smallest barrier parameter
+   EXPECT_DOUBLE_EQ(strategy.compute_loqo_barrier_parameter(problem, primals, bound_multipliers(0.1, 0.1, 0.1)),
+      options.get_double("barrier_min_parameter"));
+   // xi = 0.5: sigma = 0.1 * 0.05^3
+   EXPECT_NEAR(strategy.compute_loqo_barrier_parameter(problem, primals, bound_multipliers(0.1, 0.2, 0.3)), 0.1 * std::pow(0.05, 3) * 0.2, 1e-15);
+   // xi = 1e-3: sigma is capped at 0.1 * 2^3
+   EXPECT_NEAR(strategy.compute_loqo_barrier_parameter(problem, primals, bound_multipliers(1e-3, 1., 1.999)), 0.8, 1e-12);
+}
+
+// the golden-section search finds the minimizer sigma* = 0.1 of a unimodal function of log(sigma)
+TEST(BarrierParameterUpdate, QualityFunctionGoldenSection) {
+   Options options = barrier_options("quality_function");
+   options["barrier_quality_function_golden_section_iterations"] = "40";
+   BarrierParameterUpdateStrategy strategy(options);
+   size_t number_evaluations = 0;
+   const auto quality_function = [&](double sigma) {
+      number_evaluations++;
+      return std::pow(std::log(sigma) - std::log(0.1), 2);
+   };
+   ASSERT_TRUE(strategy.minimize_quality_function(quality_function, 0.5));
+   // one evaluation per iteration, plus the two initial points
+   EXPECT_EQ(number_evaluations, 42);
+   EXPECT_NEAR(strategy.get_barrier_parameter(), 0.1 * 0.5, 1e-6);
+
+   // without complementarity, the barrier parameter is unchanged
+   EXPECT_FALSE(strategy.minimize_quality_function(quality_function, 0.));
+   EXPECT_NEAR(strategy.get_barrier_parameter(), 0.1 * 0.5, 1e-6);
+}
+
+// without sufficient decrease of the KKT error for more than barrier_adaptive_max_stalls iterations, the adaptive rule falls back
+// to the monotone rule, and switches back to free mode once the barrier subproblem is solved
+TEST(BarrierParameterUpdate, FallbackToMonotoneRule) {
+   const Options options = barrier_options("quality_function");
+   BarrierParameterUpdateStrategy strategy(options);
+   const QuadraticTestModel model;
+   const OptimalityProblem problem(model);
+   Iterate iterate(2, 2);
+   iterate.primals[0] = 1.;
+   iterate.primals[1] = 2.;
+   iterate.primal_feasibility = 0.;
+   const Multipliers multipliers = bound_multipliers(0.1, 0.1, 0.1);
+   DualResiduals residuals(2);
+   residuals.stationarity = 1.;
+   residuals.stationarity_scaling = 1.;
+   residuals.complementarity = 0.1;
+   residuals.complementarity_scaling = 1.;
+   ASSERT_TRUE(strategy.requires_quality_function());
+
+   // the first iteration sets the reference error, the next ones stall
+   const size_t max_stalls = options.get_unsigned_int("barrier_adaptive_max_stalls");
+   for (size_t iteration = 0; iteration <= max_stalls; iteration++) {
+      EXPECT_FALSE(strategy.update_barrier_parameter(problem, iterate, multipliers, residuals));
+      EXPECT_TRUE(strategy.requires_quality_function());
+   }
+   EXPECT_TRUE(strategy.update_barrier_parameter(problem, iterate, multipliers, residuals));
+   EXPECT_FALSE(strategy.requires_quality_function());
+   // mu = min(mu, monotone fraction * average complementarity)
+   EXPECT_NEAR(strategy.get_barrier_parameter(), options.get_double("barrier_adaptive_monotone_fraction") * 0.1, 1e-15);
+
+   // the barrier subproblem is solved: the monotone rule decreases mu and the free mode resumes
+   residuals.stationarity = 0.;
+   residuals.complementarity = 0.;
+   const double monotone_barrier_parameter = strategy.get_barrier_parameter();
+   EXPECT_TRUE(strategy.update_barrier_parameter(problem, iterate, multipliers, residuals));
+   EXPECT_LT(strategy.get_barrier_parameter(), monotone_barrier_parameter);
+   EXPECT_TRUE(strategy.requires_quality_function());
+}
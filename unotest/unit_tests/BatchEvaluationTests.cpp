@@ -0,0 +1,121 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include "model/BatchEvaluation.hpp"
+#include "model/BoundRelaxedModel.hpp"
+#include "model/SharedModel.hpp"
+#include "optimization/EvaluationErrors.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/ThreadPool.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+// the objective cannot be evaluated for x0 < 0
+class PartiallyDefinedTestModel: public QuadraticTestModel {
+public:
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+      if (x[0] < 0.) {
+         throw FunctionEvaluationError();
+      }
+      return QuadraticTestModel::evaluate_objective(x);
+   }
+   [[nodiscard]] bool supports_concurrent_evaluations() const override { return true; }
+};
+
+// counts the batches that reach the model
+class BatchCountingTestModel: public QuadraticTestModel {
+public:
+   void evaluate_batch(BatchEvaluation& evaluation) const override {
+      this->number_batches++;
+      QuadraticTestModel::evaluate_batch(evaluation);
+   }
+   [[nodiscard]] bool supports_concurrent_evaluations() const override { return true; }
+
+   mutable std::atomic<size_t> number_batches{0};
+};
+
+static void fill_points(BatchEvaluation& evaluation) {
+   for (size_t point_index: Range(evaluation.number_points())) {
+      evaluation.points[point_index][0] = static_cast<double>(point_index) - 2.;
+      evaluation.points[point_index][1] = 0.5 * static_cast<double>(point_index);
+   }
+}
+
+static void check_evaluations(const Model& model, const BatchEvaluation& evaluation) {
+   for (size_t point_index: Range(evaluation.number_points())) {
+      const Vector<double>& x = evaluation.points[point_index];
+      if (x[0] < 0.) {
+         ASSERT_FALSE(evaluation.is_evaluated(point_index));
+         continue;
+      }
+      ASSERT_TRUE(evaluation.is_evaluated(point_index));
+      ASSERT_EQ(evaluation.objectives[point_index], model.evaluate_objective(x));
+      std::vector<double> constraints(model.number_constraints);
+      model.evaluate_constraints(x, constraints);
+      ASSERT_EQ(evaluation.constraints[point_index], constraints);
+      SparseVector<double> gradient(model.number_variables);
+      model.evaluate_objective_gradient(x, gradient);
+      ASSERT_EQ(evaluation.objective_gradients[point_index].size(), gradient.size());
+   }
+}
+
+TEST(BatchEvaluation, ErrorsAreRecordedPerPoint) {
+   const PartiallyDefinedTestModel model;
+   BatchEvaluation evaluation(6, model.number_variables, model.number_constraints, true);
+   fill_points(evaluation);
+   model.evaluate_batch(evaluation);
+   check_evaluations(model, evaluation);
+}
+
+TEST(BatchEvaluation, ConcurrentEvaluationsOnThreadPool) {
+   const PartiallyDefinedTestModel model;
+   ThreadPool pool(3, ThreadAffinity::NONE);
+   const ThreadPool::Scope scope(&pool);
+   BatchEvaluation evaluation(50, model.number_variables, model.number_constraints, true);
+   fill_points(evaluation);
+   model.evaluate_batch(evaluation);
+   check_evaluations(model, evaluation);
+}
+
+TEST(BatchEvaluation, WrappersForwardTheBatch) {
+   const Options options = DefaultOptions::load();
+   auto counting_model = std::make_unique<BatchCountingTestModel>();
+   const BatchCountingTestModel& original_model = *counting_model;
+   const BoundRelaxedModel relaxed_model(std::move(counting_model), options);
+   const SharedModel shared_model(relaxed_model, Vector<double>(relaxed_model.number_variables));
+   BatchEvaluation evaluation(4, shared_model.number_variables, shared_model.number_constraints, false);
+   fill_points(evaluation);
+   shared_model.evaluate_batch(evaluation);
+   // a single batch reaches the model, through both wrappers
+   ASSERT_EQ(original_model.number_batches.load(), 1);
+   ASSERT_TRUE(evaluation.objective_gradients.empty());
+   for (size_t point_index: Range(evaluation.number_points())) {
+      ASSERT_TRUE(evaluation.is_evaluated(point_index));
+      ASSERT_EQ(evaluation.objectives[point_index], original_model.evaluate_objective(evaluation.points[point_index]));
+   }
+}
+
+static Result solve_with_speculative_trials(const std::string& number_speculative_trials) {
+   Options options = test_options("ipopt");
+   options["barrier_kkt_solver"] = "MINRES";
+   options["LS_speculative_trials"] = number_speculative_trials;
+   return solve_reformulated_model(std::make_unique<BatchCountingTestModel>(), options);
+}
+
+// the speculative line-search trials are evaluated as batches and accept the same step lengths
+TEST(BatchEvaluation, SpeculativeLineSearchTrials) {
+   const Result sequential_result = solve_with_speculative_trials("1");
+   const Result speculative_result = solve_with_speculative_trials("3");
+   ASSERT_EQ(speculative_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_EQ(speculative_result.iteration, sequential_result.iteration);
+   ASSERT_NEAR(speculative_result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(speculative_result.solution.primals[1], 3., 1e-6);
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "BatchSolver.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+TEST(BatchSolver, InstancesMatchIndividualSolves) {
+   const Options options = test_options("filtersqp");
+   const std::vector<double> parameters{7., 3., 5., 1., 8.};
+   std::vector<QuadraticTestModel> models(parameters.size());
+   std::vector<const Model*> instances{};
+   for (size_t instance_index = 0; instance_index < parameters.size(); instance_index++) {
+      models[instance_index].set_parameter(parameters[instance_index]);
+      instances.push_back(&models[instance_index]);
+   }
+   BatchSolver batch_solver(1);
+   batch_solver.solve(instances, options);
+   ASSERT_EQ(batch_solver.number_instances(), parameters.size());
+   for (size_t instance_index = 0; instance_index < parameters.size(); instance_index++) {
+      ASSERT_FALSE(batch_solver.get_exception(instance_index));
+      const std::optional<Result>& result = batch_solver.get_result(instance_index);
+      ASSERT_TRUE(result.has_value());
+      const Result reference = solve_model(models[instance_index], options);
+      ASSERT_EQ(result->optimization_status, reference.optimization_status);
+      ASSERT_EQ(result->iteration, reference.iteration);
+      ASSERT_NEAR(result->solution.primals[0], reference.solution.primals[0], 1e-10);
+      ASSERT_NEAR(result->solution.primals[1], reference.solution.primals[1], 1e-10);
+   }
+}
+
+TEST(BatchSolver, InteriorPointIsRejected) {
+   Options options = test_options("filtersqp");
+   options["subproblem"] = "primal_dual_interior_point";
+   const QuadraticTestModel model;
+   BatchSolver batch_solver(1);
+   ASSERT_THROW(batch_solver.solve({&model}, options), std::invalid_argument);
+}
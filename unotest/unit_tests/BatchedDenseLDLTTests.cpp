@@ -0,0 +1,77 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <tuple>
+#include <vector>
+#include "linear_algebra/BatchedDenseLDLT.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-12;
+
+// instance b: [[4 + b, 1, 0], [1, -3, 2], [0, 2, 5]] (indefinite, inertia (2, 1, 0))
+static void fill_indefinite_matrices(BatchedDenseLDLT<double>& batch) {
+   for (size_t instance = 0; instance < batch.batch_size(); instance++) {
+      batch.entry(0, 0, instance) = 4. + static_cast<double>(instance);
+      batch.entry(1, 0, instance) = 1.;
+      batch.entry(1, 1, instance) = -3.;
+      batch.entry(2, 1, instance) = 2.;
+      batch.entry(2, 2, instance) = 5.;
+   }
+}
+
+TEST(BatchedDenseLDLT, Solve) {
+   const size_t dimension = 3, batch_size = 5;
+   BatchedDenseLDLT<double> batch(dimension, batch_size);
+   fill_indefinite_matrices(batch);
+   batch.factorize();
+
+   // right-hand sides A_b x_b = b with x_b = (1, b, -1)
+   std::vector<double, AlignedAllocator<double>> rhs(dimension * batch_size);
+   for (size_t instance = 0; instance < batch_size; instance++) {
+      const double b = static_cast<double>(instance);
+      rhs[0 * batch_size + instance] = (4. + b) + b;
+      rhs[1 * batch_size + instance] = 1. - 3. * b - 2.;
+      rhs[2 * batch_size + instance] = 2. * b - 5.;
+   }
+   batch.solve(rhs);
+   for (size_t instance = 0; instance < batch_size; instance++) {
+      ASSERT_FALSE(batch.is_singular(instance));
+      EXPECT_NEAR(rhs[0 * batch_size + instance], 1., tolerance);
+      EXPECT_NEAR(rhs[1 * batch_size + instance], static_cast<double>(instance), tolerance);
+      EXPECT_NEAR(rhs[2 * batch_size + instance], -1., tolerance);
+      ASSERT_EQ(batch.get_inertia(instance), std::make_tuple(size_t(2), size_t(1), size_t(0)));
+   }
+}
+
+TEST(BatchedDenseLDLT, SingularInstanceIsIsolated) {
+   const size_t dimension = 2, batch_size = 3;
+   BatchedDenseLDLT<double> batch(dimension, batch_size);
+   for (size_t instance = 0; instance < batch_size; instance++) {
+      batch.entry(0, 0, instance) = 2.;
+      batch.entry(1, 0, instance) = 1.;
+      batch.entry(1, 1, instance) = 2.;
+   }
+   // the second instance [[2, 1], [1, 0.5]] is singular
+   batch.entry(1, 1, 1) = 0.5;
+   batch.factorize(1e-14);
+   ASSERT_FALSE(batch.is_singular(0));
+   ASSERT_TRUE(batch.is_singular(1));
+   ASSERT_FALSE(batch.is_singular(2));
+   ASSERT_EQ(batch.get_inertia(0), std::make_tuple(size_t(2), size_t(0), size_t(0)));
+   ASSERT_EQ(batch.get_inertia(1), std::make_tuple(size_t(1), size_t(0), size_t(1)));
+
+   std::vector<double, AlignedAllocator<double>> rhs{3., 3., 3., 3., 3., 3.};
+   batch.solve(rhs);
+   for (size_t instance: {size_t(0), size_t(2)}) {
+      EXPECT_NEAR(rhs[0 * batch_size + instance], 1., tolerance);
+      EXPECT_NEAR(rhs[1 * batch_size + instance], 1., tolerance);
+   }
+}
+
+TEST(BatchedDenseLDLT, SolveRequiresFactorization) {
+   BatchedDenseLDLT<double> batch(2, 2);
+   std::vector<double, AlignedAllocator<double>> rhs(4, 1.);
+   ASSERT_THROW(batch.solve(rhs), std::runtime_error);
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "tools/BenchmarkReport.hpp"
+
+using namespace uno;
+
+static BenchmarkRecord solved_record(const std::string& model, const std::string& configuration, size_t iterations, double wall_time) {
+   return {model, configuration, "Success", "Feasible KKT point", true, iterations, 2 * iterations, 0, wall_time};
+}
+
+static BenchmarkRecord unsolved_record(const std::string& model, const std::string& configuration) {
+   return {model, configuration, "Iteration limit", "Suboptimal point", false, 100, 200, 0, 1.};
+}
+
+TEST(BenchmarkReport, WriteAndRead) {
+   BenchmarkReport report{};
+   report.add(solved_record("hs015", "filtersqp", 5, 0.25));
+   report.add(BenchmarkRecord::from_error("hs071", "ipopt", "The model, hs071, could not be loaded", 0.5));
+   std::stringstream stream;
+   report.write(stream);
+
+   const BenchmarkReport read_report = BenchmarkReport::read(stream);
+   ASSERT_EQ(read_report.get_records().size(), 2);
+   const BenchmarkRecord& record = read_report.get_records()[0];
+   ASSERT_EQ(record.model, "hs015");
+   ASSERT_TRUE(record.solved);
+   ASSERT_EQ(record.iterations, 5);
+   ASSERT_EQ(record.evaluations, 10);
+   ASSERT_EQ(record.wall_time, 0.25);
+   // the delimiters of the error message are replaced
+   ASSERT_FALSE(read_report.get_records()[1].solved);
+   ASSERT_EQ(read_report.get_records()[1].iterate_status, "The model  hs071  could not be loaded");
+
+   std::istringstream invalid_stream("model,configuration\nhs015,filtersqp\n");
+   ASSERT_THROW(static_cast<void>(BenchmarkReport::read(invalid_stream)), std::runtime_error);
+}
+
+TEST(BenchmarkReport, PerformanceProfiles) {
+   BenchmarkReport report{};
+   report.add(solved_record("p1", "A", 10, 1.));
+   report.add(solved_record("p1", "B", 20, 1.));
+   report.add(solved_record("p2", "A", 30, 1.));
+   report.add(solved_record("p2", "B", 10, 1.));
+   report.add(solved_record("p3", "A", 5, 1.));
+   report.add(unsolved_record("p3", "B"));
+   const auto profiles = report.compute_performance_profiles(BenchmarkMetric::ITERATIONS);
+   ASSERT_EQ(profiles.size(), 2);
+   // A: ratios 1, 3, 1
+   ASSERT_EQ(profiles[0].configuration, "A");
+   ASSERT_EQ(profiles[0].breakpoints.size(), 2);
+   ASSERT_DOUBLE_EQ(profiles[0].breakpoints[0].first, 1.);
+   ASSERT_DOUBLE_EQ(profiles[0].breakpoints[0].second, 2. / 3.);
+   ASSERT_DOUBLE_EQ(profiles[0].breakpoints[1].first, 3.);
+   ASSERT_DOUBLE_EQ(profiles[0].breakpoints[1].second, 1.);
+   // B: ratios 2, 1 (p3 not solved)
+   ASSERT_EQ(profiles[1].breakpoints.size(), 2);
+   ASSERT_DOUBLE_EQ(profiles[1].breakpoints[0].first, 1.);
+   ASSERT_DOUBLE_EQ(profiles[1].breakpoints[0].second, 1. / 3.);
+   ASSERT_DOUBLE_EQ(profiles[1].breakpoints[1].first, 2.);
+   ASSERT_DOUBLE_EQ(profiles[1].breakpoints[1].second, 2. / 3.);
+}
+
+TEST(BenchmarkReport, ComparisonWithBaseline) {
+   BenchmarkReport baseline{};
+   baseline.add(solved_record("p1", "A", 10, 1.));
+   baseline.add(solved_record("p2", "A", 10, 1.));
+   baseline.add(solved_record("p3", "A", 10, 0.01));
+   baseline.add(unsolved_record("p4", "A"));
+   baseline.add(solved_record("p5", "A", 10, 1.));
+
+   BenchmarkReport report{};
+   report.add(solved_record("p1", "A", 10, 1.1)); // within the tolerances
+   report.add(solved_record("p2", "A", 8, 2.)); // fewer iterations and evaluations, slower
+   report.add(unsolved_record("p3", "A"));
+   report.add(solved_record("p4", "A", 10, 1.));
+   report.add(solved_record("p6", "A", 10, 1.));
+   const RegressionReport regression_report = report.compare(baseline, RegressionTolerances{});
+   ASSERT_EQ(regression_report.number_compared_records, 4);
+   // p2: iterations and evaluations (improvements), wall time (regression). p3: regression. p4: improvement
+   ASSERT_EQ(regression_report.changes.size(), 5);
+   ASSERT_EQ(regression_report.number_regressions(), 2);
+   ASSERT_EQ(regression_report.number_improvements(), 3);
+   ASSERT_EQ(regression_report.changes[2].measure, "wall_time");
+   ASSERT_TRUE(regression_report.changes[2].is_regression);
+   ASSERT_EQ(regression_report.changes[3].measure, "solved");
+   ASSERT_EQ(regression_report.missing_records, std::vector<std::string>{"p5/A"});
+   ASSERT_EQ(regression_report.new_records, std::vector<std::string>{"p6/A"});
+
+   std::ostringstream stream;
+   regression_report.write_json(stream);
+   ASSERT_NE(stream.str().find("\"regressions\": 2"), std::string::npos);
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+static Result solve(const std::string& max_iterations, const std::string& return_best_iterate) {
+   Options options = test_options("funnelsqp");
+   options["max_iterations"] = max_iterations;
+   options["return_best_iterate"] = return_best_iterate;
+   return solve_model(QuadraticTestModel(), options);
+}
+
+TEST(BestIterate, ConvergedSolveReturnsLastIterate) {
+   const Result last_iterate = solve("2000", "no");
+   const Result best_iterate = solve("2000", "yes");
+   ASSERT_EQ(best_iterate.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_EQ(best_iterate.iteration, last_iterate.iteration);
+   ASSERT_EQ(best_iterate.solution.primals[0], last_iterate.solution.primals[0]);
+   ASSERT_EQ(best_iterate.solution.primals[1], last_iterate.solution.primals[1]);
+}
+
+TEST(BestIterate, IterationLimitReturnsBestIterate) {
+   const double tolerance = 1e-6; // tolerance of funnelsqp
+   for (const std::string max_iterations: {"1", "2", "3"}) {
+      const Result last_iterate = solve(max_iterations, "no");
+      const Result best_iterate = solve(max_iterations, "yes");
+      ASSERT_EQ(best_iterate.iteration, last_iterate.iteration);
+      ASSERT_EQ(best_iterate.optimization_status, last_iterate.optimization_status);
+      const double best_violation = std::max(best_iterate.solution.primal_feasibility, tolerance);
+      const double last_violation = std::max(last_iterate.solution.primal_feasibility, tolerance);
+      ASSERT_LE(best_violation, last_violation);
+      if (best_violation == last_violation) {
+         ASSERT_LE(best_iterate.solution.evaluations.objective, last_iterate.solution.evaluations.objective);
+      }
+   }
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "ingredients/subproblem_solvers/BlockTridiagonalSolver.hpp"
+#include "ingredients/subproblem_solvers/DenseLinearSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/Model.hpp"
+#include "symbolic/Range.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-10;
+const size_t number_time_steps = 5;
+// primals (x_k, u_k) of each time step, then the multipliers of x_0 = x^0 and of the dynamics x_{k+1} = a x_k + b u_k
+const size_t number_primals = 2 * number_time_steps;
+const size_t dimension = number_primals + number_time_steps;
+
+size_t state(size_t time_step) { return 2 * time_step; }
+size_t control(size_t time_step) { return 2 * time_step + 1; }
+size_t dynamics(size_t time_step) { return number_primals + time_step; }
+
+// KKT matrix [H A^T; A 0] of a discretized linear-quadratic control problem
+static SymmetricMatrix<size_t, double> control_KKT_matrix(double control_curvature) {
+   SymmetricMatrix<size_t, double> matrix(dimension, 4 * dimension, false, "COO");
+   for (size_t time_step: Range(number_time_steps)) {
+      matrix.insert(1. + 0.1 * static_cast<double>(time_step), state(time_step), state(time_step));
+      matrix.insert(control_curvature, control(time_step), control(time_step));
+      // x_k appears in the dynamics of the time step k - 1 (or the initial condition) and k
+      matrix.insert(1., state(time_step), dynamics(time_step));
+      if (time_step + 1 < number_time_steps) {
+         matrix.insert(-0.9, state(time_step), dynamics(time_step + 1));
+         matrix.insert(-0.5, control(time_step), dynamics(time_step + 1));
+      }
+   }
+   return matrix;
+}
+
+static std::vector<size_t> time_step_stages() {
+   std::vector<size_t> stages(dimension);
+   for (size_t time_step: Range(number_time_steps)) {
+      stages[state(time_step)] = time_step;
+      stages[control(time_step)] = time_step;
+      stages[dynamics(time_step)] = time_step;
+   }
+   return stages;
+}
+
+static Vector<double> rhs() {
+   Vector<double> rhs(dimension);
+   for (size_t index: Range(dimension)) {
+      rhs[index] = 1. + static_cast<double>(index % 3);
+   }
+   return rhs;
+}
+
+// the solution and the inertia are those of the dense factorization
+static void check_against_dense_solver(BlockTridiagonalSolver<size_t>& solver, const SymmetricMatrix<size_t, double>& matrix) {
+   DenseLinearSolver<size_t> dense_solver(dimension);
+   dense_solver.do_symbolic_analysis(matrix);
+   dense_solver.do_numerical_factorization(matrix);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   ASSERT_EQ(solver.get_inertia(), dense_solver.get_inertia());
+   ASSERT_FALSE(solver.matrix_is_singular());
+
+   Vector<double> solution(dimension), dense_solution(dimension);
+   solver.solve_indefinite_system(matrix, rhs(), solution);
+   dense_solver.solve_indefinite_system(matrix, rhs(), dense_solution);
+   for (size_t index: Range(dimension)) {
+      ASSERT_NEAR(solution[index], dense_solution[index], tolerance);
+   }
+}
+
+TEST(BlockTridiagonalSolver, ModelStages) {
+   BlockTridiagonalSolver<size_t> solver(dimension);
+   solver.set_stage_partition(time_step_stages());
+   const auto matrix = control_KKT_matrix(0.1);
+   check_against_dense_solver(solver, matrix);
+   ASSERT_EQ(solver.number_stages(), number_time_steps);
+   ASSERT_EQ(solver.get_inertia(), std::make_tuple(number_primals, number_time_steps, size_t(0)));
+}
+
+TEST(BlockTridiagonalSolver, PropagatedStages) {
+   // only the states have a stage: the controls and the multipliers take the stage of a neighbor
+   std::vector<size_t> stages(dimension, Model::no_stage);
+   for (size_t time_step: Range(number_time_steps)) {
+      stages[state(time_step)] = time_step;
+   }
+   BlockTridiagonalSolver<size_t> solver(dimension);
+   solver.set_stage_partition(stages);
+   check_against_dense_solver(solver, control_KKT_matrix(0.1));
+   ASSERT_EQ(solver.number_stages(), number_time_steps);
+}
+
+TEST(BlockTridiagonalSolver, AutomaticStages) {
+   // no stages, or stages that couple nonconsecutive stages: the stages are the levels of a breadth-first search
+   BlockTridiagonalSolver<size_t> solver(dimension);
+   check_against_dense_solver(solver, control_KKT_matrix(0.1));
+   ASSERT_LT(1, solver.number_stages());
+
+   std::vector<size_t> stages = time_step_stages();
+   stages[dynamics(number_time_steps - 1)] = 0;
+   solver.set_stage_partition(stages);
+   check_against_dense_solver(solver, control_KKT_matrix(0.1));
+   ASSERT_LT(1, solver.number_stages());
+}
+
+TEST(BlockTridiagonalSolver, IndefiniteHessian) {
+   // negative curvature along the controls: the inertia reveals the additional negative eigenvalues
+   BlockTridiagonalSolver<size_t> solver(dimension);
+   solver.set_stage_partition(time_step_stages());
+   const auto matrix = control_KKT_matrix(-2.);
+   check_against_dense_solver(solver, matrix);
+   ASSERT_LT(number_time_steps, std::get<1>(solver.get_inertia()));
+}
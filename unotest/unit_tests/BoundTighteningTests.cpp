@@ -0,0 +1,61 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "model/BoundTighteningModel.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/Infinity.hpp"
+#include "QuadraticTestModel.hpp"
+
+using namespace uno;
+
+static std::unique_ptr<QuadraticTestModel> quadratic_model(double parameter) {
+   auto model = std::make_unique<QuadraticTestModel>();
+   model->set_parameter(parameter);
+   return model;
+}
+
+// x0 + x1 <= 3 with x0, x1 >= 0 implies x0 <= 3 and x1 <= 3
+TEST(BoundTightening, ImpliedBoundsAreNotReported) {
+   const Options options = DefaultOptions::load();
+   const BoundTighteningModel model(quadratic_model(3.), false, options);
+   ASSERT_EQ(model.tightened_variable_upper_bound(0), 3.);
+   ASSERT_EQ(model.tightened_variable_upper_bound(1), 3.);
+   ASSERT_EQ(model.tightened_variable_lower_bound(0), 0.);
+   ASSERT_EQ(model.number_tightened_bounds(), 2);
+   // the model is unchanged
+   ASSERT_EQ(model.variable_upper_bound(0), INF<double>);
+   ASSERT_EQ(model.variable_upper_bound(1), 4.);
+   ASSERT_EQ(model.get_variable_bound_type(0), BOUNDED_LOWER);
+   ASSERT_EQ(model.get_upper_bounded_variables().size(), 1);
+}
+
+// only the finite bounds are replaced: the bound types and the collections do not change
+TEST(BoundTightening, ReportedFiniteBounds) {
+   const Options options = DefaultOptions::load();
+   const BoundTighteningModel model(quadratic_model(3.), true, options);
+   ASSERT_EQ(model.variable_upper_bound(0), INF<double>);
+   ASSERT_EQ(model.variable_upper_bound(1), 3.);
+   ASSERT_EQ(model.variable_lower_bound(1), 0.);
+}
+
+TEST(BoundTightening, InitialPointProjection) {
+   Options options = DefaultOptions::load();
+   const BoundTighteningModel model(quadratic_model(-1.), false, options);
+   // x0 + x1 <= -1 is infeasible over x >= 0: the bounds are not tightened
+   ASSERT_EQ(model.number_tightened_bounds(), 0);
+
+   // the initial point (0, 0) lies within the tightened bounds [0, 7] x [0, 4]
+   const BoundTighteningModel feasible_model(quadratic_model(7.), false, options);
+   Vector<double> x(2);
+   feasible_model.initial_primal_point(x);
+   ASSERT_EQ(x[0], 0.);
+   ASSERT_EQ(feasible_model.tightened_variable_upper_bound(0), 7.);
+
+   // no nonzero may be visited
+   options["bound_tightening_work_limit"] = "0";
+   const BoundTighteningModel limited_model(quadratic_model(3.), false, options);
+   ASSERT_EQ(limited_model.tightened_variable_upper_bound(0), INF<double>);
+}
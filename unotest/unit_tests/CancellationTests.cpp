@@ -0,0 +1,71 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/UserCallbacks.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+// stops the solve after a given number of iterations
+class IterationBudgetCallbacks: public NoUserCallbacks {
+public:
+   explicit IterationBudgetCallbacks(size_t budget): NoUserCallbacks(), budget(budget) { }
+
+   void notify_new_primals(const Vector<double>& /*primals*/) override { this->number_iterations++; }
+   [[nodiscard]] bool should_terminate() override { return this->budget <= this->number_iterations; }
+
+private:
+   const size_t budget;
+   size_t number_iterations{0};
+};
+
+static Result solve_quadratic_model(const CancellationToken* token, UserCallbacks& user_callbacks) {
+   Options options = test_options("filtersqp");
+   // small trust region: the solve takes several iterations
+   options["TR_radius"] = "0.5";
+   const QuadraticTestModel model;
+   TestSolver solver(model, options);
+   solver.uno.set_cancellation_token(token);
+   return solver.solve(user_callbacks);
+}
+
+TEST(Cancellation, CancelledTokenStopsTheInnerLoops) {
+   CancellationToken token{};
+   token.cancel();
+   NoUserCallbacks user_callbacks{};
+   const Result result = solve_quadratic_model(&token, user_callbacks);
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::USER_TERMINATION);
+   // the solution is the initial iterate
+   ASSERT_EQ(result.solution.primals[0], 0.);
+   ASSERT_EQ(result.solution.primals[1], 0.);
+}
+
+TEST(Cancellation, CallbacksStopTheSolve) {
+   IterationBudgetCallbacks user_callbacks(1);
+   const Result result = solve_quadratic_model(nullptr, user_callbacks);
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::USER_TERMINATION);
+   ASSERT_EQ(result.iteration, 1);
+}
+
+TEST(Cancellation, DeadlineInterruptsTheCancellationPoints) {
+   // no solve on this thread: the cancellation points do nothing
+   ASSERT_NO_THROW(Cancellation::check());
+   {
+      const Cancellation::Scope scope(nullptr, 0.);
+      try {
+         Cancellation::check();
+         FAIL() << "The deadline is passed";
+      }
+      catch (const SolveInterruption& interruption) {
+         ASSERT_EQ(interruption.status, OptimizationStatus::TIME_LIMIT);
+      }
+   }
+   const Cancellation::Scope scope(nullptr, INF<double>);
+   ASSERT_NO_THROW(Cancellation::check());
+}
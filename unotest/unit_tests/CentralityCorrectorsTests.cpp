@@ -0,0 +1,43 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+static Options interior_point_options(const std::string& number_correctors, bool predictor_corrector) {
+   Options options = test_options("ipopt");
+   options["linear_solver"] = "dense";
+   options["barrier_predictor_corrector"] = predictor_corrector ? "yes" : "no";
+   options["barrier_centrality_correctors"] = number_correctors;
+   return options;
+}
+
+TEST(CentralityCorrectors, Convergence) {
+   for (bool predictor_corrector: {false, true}) {
+      const Result reference_result = solve_reformulated_model(std::make_unique<QuadraticTestModel>(),
+            interior_point_options("0", predictor_corrector));
+      const Result result = solve_reformulated_model(std::make_unique<QuadraticTestModel>(),
+            interior_point_options("3", predictor_corrector));
+      ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+      ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+      ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+      ASSERT_LE(result.iteration, reference_result.iteration);
+   }
+}
+
+TEST(CentralityCorrectors, InvalidNeighborhood) {
+   Options options = interior_point_options("3", true);
+   options["barrier_centrality_neighborhood"] = "0.5";
+   const std::unique_ptr<Model> model = ModelFactory::reformulate(std::make_unique<QuadraticTestModel>(), options);
+   ASSERT_THROW(ConstraintRelaxationStrategyFactory::create(*model, options), std::invalid_argument);
+}
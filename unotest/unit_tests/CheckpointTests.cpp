@@ -0,0 +1,125 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "linear_algebra/Vector.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "tools/Checkpoint.hpp"
+#include "tools/UserCallbacks.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+// stops the solve after a given number of iterations
+class IterationBudgetCallbacks: public NoUserCallbacks {
+public:
+   explicit IterationBudgetCallbacks(size_t budget): NoUserCallbacks(), budget(budget) { }
+
+   void notify_new_primals(const Vector<double>& /*primals*/) override { this->number_iterations++; }
+   [[nodiscard]] bool should_terminate() override { return this->budget <= this->number_iterations; }
+
+private:
+   const size_t budget;
+   size_t number_iterations{0};
+};
+
+static Options create_options(const std::string& preset) {
+   Options options = test_options(preset);
+   // small trust region: the solve takes several iterations
+   options["TR_radius"] = "0.5";
+   return options;
+}
+
+// solves the model, or resumes the solve from a checkpoint if the checkpoint file is not empty
+static Result solve_quadratic_model(const Options& options, UserCallbacks& user_callbacks, const std::string& resumed_checkpoint_file = "") {
+   const QuadraticTestModel model;
+   TestSolver solver(model, options);
+   if (resumed_checkpoint_file.empty()) {
+      return solver.solve(user_callbacks);
+   }
+   Iterate initial_iterate = solver.initial_iterate();
+   return solver.uno.resume(model, initial_iterate, resumed_checkpoint_file, options, user_callbacks);
+}
+
+TEST(Checkpoint, WriteAndRead) {
+   const std::string file_name = ::testing::TempDir() + "uno_checkpoint_values";
+   {
+      CheckpointWriter writer(file_name);
+      writer.write(1.5);
+      writer.write(size_t(42));
+      writer.write(true);
+      writer.write(std::string("filter"));
+      writer.write(Vector<double>{1., -2., 3.});
+      writer.close();
+   }
+   CheckpointReader reader(file_name);
+   ASSERT_EQ(reader.read_double(), 1.5);
+   ASSERT_EQ(reader.read_size_t(), 42);
+   ASSERT_TRUE(reader.read_bool());
+   ASSERT_EQ(reader.read_string(), "filter");
+   Vector<double> values{};
+   reader.read(values);
+   ASSERT_EQ(values.size(), 3);
+   ASSERT_EQ(values[1], -2.);
+   // nothing is left to read
+   ASSERT_THROW(static_cast<void>(reader.read_double()), std::runtime_error);
+   std::remove(file_name.c_str());
+}
+
+TEST(Checkpoint, RejectsOtherFiles) {
+   const std::string file_name = ::testing::TempDir() + "uno_checkpoint_invalid";
+   {
+      std::ofstream file(file_name, std::ios::binary);
+      file << "UNOTRACE";
+   }
+   ASSERT_THROW(CheckpointReader{file_name}, std::runtime_error);
+   std::remove(file_name.c_str());
+   ASSERT_THROW(CheckpointReader{file_name}, std::runtime_error);
+}
+
+TEST(Checkpoint, ResumedSolveMatchesUninterruptedSolve) {
+   for (const std::string preset: {"filtersqp", "funnelsqp"}) {
+      const std::string file_name = ::testing::TempDir() + "uno_checkpoint_" + preset;
+      Options options = create_options(preset);
+      NoUserCallbacks no_callbacks{};
+      const Result uninterrupted_result = solve_quadratic_model(options, no_callbacks);
+      ASSERT_EQ(uninterrupted_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT) << preset;
+      ASSERT_LT(2, uninterrupted_result.iteration) << preset;
+
+      // the solve is interrupted after 2 iterations, the last checkpoint is that of iteration 1
+      options["checkpoint_file"] = file_name;
+      options["checkpoint_frequency"] = "1";
+      IterationBudgetCallbacks budget_callbacks(2);
+      const Result interrupted_result = solve_quadratic_model(options, budget_callbacks);
+      ASSERT_EQ(interrupted_result.optimization_status, OptimizationStatus::USER_TERMINATION) << preset;
+
+      options["checkpoint_file"] = "";
+      const Result resumed_result = solve_quadratic_model(options, no_callbacks, file_name);
+      std::remove(file_name.c_str());
+      ASSERT_EQ(resumed_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT) << preset;
+      ASSERT_EQ(resumed_result.iteration, uninterrupted_result.iteration) << preset;
+      ASSERT_NEAR(resumed_result.solution.primals[0], uninterrupted_result.solution.primals[0], 1e-10) << preset;
+      ASSERT_NEAR(resumed_result.solution.primals[1], uninterrupted_result.solution.primals[1], 1e-10) << preset;
+   }
+}
+
+TEST(Checkpoint, ResumeRejectsOtherStrategies) {
+   const std::string file_name = ::testing::TempDir() + "uno_checkpoint_strategies";
+   Options options = create_options("filtersqp");
+   options["checkpoint_file"] = file_name;
+   options["checkpoint_frequency"] = "1";
+   IterationBudgetCallbacks budget_callbacks(2);
+   static_cast<void>(solve_quadratic_model(options, budget_callbacks));
+
+   Options other_options = create_options("funnelsqp");
+   NoUserCallbacks no_callbacks{};
+   ASSERT_THROW(static_cast<void>(solve_quadratic_model(other_options, no_callbacks, file_name)), std::runtime_error);
+   std::remove(file_name.c_str());
+}
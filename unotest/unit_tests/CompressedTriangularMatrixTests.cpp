@@ -0,0 +1,84 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "linear_algebra/CompressedTriangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+
+using namespace uno;
+
+// lower and upper entries, a duplicate diagonal entry and a missing diagonal entry (row 3)
+static SymmetricMatrix<size_t, double> create_matrix() {
+   SymmetricMatrix<size_t, double> matrix(4, 6, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 1, 0);
+   matrix.insert(4., 1, 2);
+   matrix.insert(1., 2, 2);
+   matrix.insert(0.5, 2, 2);
+   matrix.insert(5., 3, 0);
+   return matrix;
+}
+
+TEST(CompressedTriangularMatrix, FortranIndicesWithExplicitDiagonal) {
+   SymmetricMatrix<size_t, double> matrix = create_matrix();
+   CompressedTriangularMatrix<int, double> compressed_matrix(1, true);
+   compressed_matrix.analyze(matrix);
+   compressed_matrix.update_values(matrix);
+
+   // 1-based CSR of the upper triangle: (0, 0), (0, 1), (0, 3), (1, 1), (1, 2), (2, 2), (3, 3)
+   ASSERT_EQ(compressed_matrix.dimension(), 4);
+   ASSERT_EQ(compressed_matrix.number_nonzeros(), 7);
+   const std::vector<int> row_starts(compressed_matrix.row_starts(), compressed_matrix.row_starts() + 5);
+   const std::vector<int> column_indices(compressed_matrix.column_indices(), compressed_matrix.column_indices() + 7);
+   const std::vector<double> values(compressed_matrix.values(), compressed_matrix.values() + 7);
+   ASSERT_EQ(row_starts, (std::vector<int>{1, 4, 6, 7, 8}));
+   ASSERT_EQ(column_indices, (std::vector<int>{1, 2, 4, 2, 3, 3, 4}));
+   ASSERT_EQ(values, (std::vector<double>{2., 3., 5., 0., 4., 1.5, 0.}));
+
+   // new values, same pattern
+   double* entries = matrix.data_pointer();
+   for (size_t nonzero_index: Range(matrix.number_nonzeros())) {
+      entries[nonzero_index] = -entries[nonzero_index];
+   }
+   compressed_matrix.update_values(matrix);
+   const std::vector<double> updated_values(compressed_matrix.values(), compressed_matrix.values() + 7);
+   ASSERT_EQ(updated_values, (std::vector<double>{-2., -3., -5., 0., -4., -1.5, 0.}));
+}
+
+TEST(CompressedTriangularMatrix, CIndicesWithoutExplicitDiagonal) {
+   const SymmetricMatrix<size_t, double> matrix = create_matrix();
+   CompressedTriangularMatrix<long, double> compressed_matrix(0, false);
+   compressed_matrix.analyze(matrix);
+   compressed_matrix.update_values(matrix);
+
+   // 0-based CSC of the lower triangle: column 0 = {0, 1, 3}, column 1 = {2}, column 2 = {2}, column 3 = {}
+   ASSERT_EQ(compressed_matrix.number_nonzeros(), 5);
+   const std::vector<long> column_starts(compressed_matrix.column_starts(), compressed_matrix.column_starts() + 5);
+   const std::vector<long> row_indices(compressed_matrix.row_indices(), compressed_matrix.row_indices() + 5);
+   const std::vector<double> values(compressed_matrix.values(), compressed_matrix.values() + 5);
+   ASSERT_EQ(column_starts, (std::vector<long>{0, 3, 4, 5, 5}));
+   ASSERT_EQ(row_indices, (std::vector<long>{0, 1, 3, 2, 2}));
+   ASSERT_EQ(values, (std::vector<double>{2., 3., 5., 4., 1.5}));
+}
+
+// CSC input (ordered by column): same compressed representation
+TEST(CompressedTriangularMatrix, CSCInput) {
+   SymmetricMatrix<size_t, double> matrix(3, 4, false, "CSC");
+   matrix.insert(1., 0, 0);
+   matrix.insert(2., 2, 0);
+   matrix.finalize_column(0);
+   matrix.insert(3., 1, 1);
+   matrix.finalize_column(1);
+   matrix.insert(4., 2, 2);
+   matrix.finalize_column(2);
+   CompressedTriangularMatrix<int, double> compressed_matrix{};
+   compressed_matrix.analyze(matrix);
+   compressed_matrix.update_values(matrix);
+   const std::vector<int> row_starts(compressed_matrix.row_starts(), compressed_matrix.row_starts() + 4);
+   const std::vector<int> column_indices(compressed_matrix.column_indices(), compressed_matrix.column_indices() + 4);
+   const std::vector<double> values(compressed_matrix.values(), compressed_matrix.values() + 4);
+   ASSERT_EQ(row_starts, (std::vector<int>{0, 2, 3, 4}));
+   ASSERT_EQ(column_indices, (std::vector<int>{0, 2, 1, 2}));
+   ASSERT_EQ(values, (std::vector<double>{1., 2., 3., 4.}));
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+static Result solve_quadratic_model() {
+   return solve_model(QuadraticTestModel(), test_options("filtersqp"));
+}
+
+TEST(ConcurrentSolve, SolvesDoNotShareCounters) {
+   const Level main_thread_level = Logger::level;
+   const Result reference = solve_quadratic_model();
+   ASSERT_EQ(reference.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_NEAR(reference.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(reference.solution.primals[1], 3., 1e-6);
+   ASSERT_LT(0, reference.objective_evaluations);
+   // the logger level of the solve does not leak into the calling thread
+   ASSERT_EQ(Logger::level, main_thread_level);
+
+   constexpr size_t number_threads = 4;
+   std::vector<std::unique_ptr<Result>> results(number_threads);
+   std::vector<std::thread> threads;
+   for (size_t thread_index = 0; thread_index < number_threads; thread_index++) {
+      threads.emplace_back([&results, thread_index]() {
+         results[thread_index] = std::make_unique<Result>(solve_quadratic_model());
+      });
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   for (const std::unique_ptr<Result>& result: results) {
+      ASSERT_NE(result, nullptr);
+      ASSERT_EQ(result->optimization_status, OptimizationStatus::SUCCESS);
+      ASSERT_EQ(result->solution.primals[0], reference.solution.primals[0]);
+      ASSERT_EQ(result->solution.primals[1], reference.solution.primals[1]);
+      ASSERT_EQ(result->iteration, reference.iteration);
+      ASSERT_EQ(result->objective_evaluations, reference.objective_evaluations);
+      ASSERT_EQ(result->constraint_evaluations, reference.constraint_evaluations);
+      ASSERT_EQ(result->objective_gradient_evaluations, reference.objective_gradient_evaluations);
+      ASSERT_EQ(result->jacobian_evaluations, reference.jacobian_evaluations);
+   }
+}
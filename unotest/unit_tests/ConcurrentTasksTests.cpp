@@ -0,0 +1,88 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include "model/ModelFactory.hpp"
+#include "optimization/EvaluationCounters.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "tools/ConcurrentTasks.hpp"
+#include "tools/Timeline.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+class ConcurrentQuadraticTestModel: public QuadraticTestModel {
+public:
+   [[nodiscard]] bool supports_concurrent_evaluations() const override { return true; }
+};
+
+static Result solve_with_interior_point(bool concurrent_evaluations) {
+   Options options = test_options("ipopt");
+   options["barrier_kkt_solver"] = "MINRES";
+   options["barrier_concurrent_evaluations"] = concurrent_evaluations ? "yes" : "no";
+   // the evaluation cache does not support concurrent evaluations
+   options["evaluation_cache_size"] = "0";
+   // the interior-point method requires a reformulation of the inequality constraints
+   const std::unique_ptr<Model> model = ModelFactory::reformulate(std::make_unique<ConcurrentQuadraticTestModel>(), options);
+   // otherwise, the evaluations are sequential in both runs
+   EXPECT_TRUE(model->supports_concurrent_evaluations());
+   return solve_model(*model, options);
+}
+
+TEST(ConcurrentTasks, CountersAreMerged) {
+   for (const bool concurrent: {false, true}) {
+      EvaluationCounters counters{};
+      const EvaluationCounters::Scope scope(counters);
+      Timeline timeline{};
+      const Timeline::Scope timeline_scope(&timeline);
+      double gradient = 0.;
+      double constraint = 0.;
+      run_concurrently(concurrent,
+         [&]() {
+            const Timeline::Event event(Timeline::current(), "gradient");
+            gradient = 1.;
+            EvaluationCounters::current().objective_gradient++;
+         },
+         [&]() {
+            const Timeline::Event event(Timeline::current(), "constraints");
+            constraint = 2.;
+            EvaluationCounters::current().constraints++;
+            EvaluationCounters::current().jacobian++;
+         });
+      ASSERT_EQ(gradient, 1.);
+      ASSERT_EQ(constraint, 2.);
+      ASSERT_EQ(counters.objective_gradient, 1);
+      ASSERT_EQ(counters.constraints, 1);
+      ASSERT_EQ(counters.jacobian, 1);
+      // the tasks record their events in the timeline of the calling thread
+      ASSERT_EQ(timeline.number_events(), 2);
+   }
+}
+
+TEST(ConcurrentTasks, ErrorIsRaisedAfterAllTasks) {
+   bool last_task_completed = false;
+   ASSERT_THROW(run_concurrently(true,
+      []() {
+         throw std::runtime_error("evaluation error");
+      },
+      [&]() {
+         last_task_completed = true;
+      }), std::runtime_error);
+   ASSERT_TRUE(last_task_completed);
+}
+
+// the concurrent evaluations do not change the iterations
+TEST(ConcurrentTasks, InteriorPointEvaluations) {
+   const Result sequential_result = solve_with_interior_point(false);
+   const Result concurrent_result = solve_with_interior_point(true);
+   ASSERT_EQ(concurrent_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_EQ(concurrent_result.iteration, sequential_result.iteration);
+   ASSERT_EQ(concurrent_result.objective_gradient_evaluations, sequential_result.objective_gradient_evaluations);
+   ASSERT_EQ(concurrent_result.jacobian_evaluations, sequential_result.jacobian_evaluations);
+   ASSERT_NEAR(concurrent_result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(concurrent_result.solution.primals[1], 3., 1e-6);
+}
@@ -0,0 +1,164 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "DecompositionSolver.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/Model.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+// two independent copies of the quadratic test model (variables interleaved): min x_i^2 + 4 y_i^2 - 32 y_i s.t. x_i + y_i <= b_i,
+// -x_i + 2 y_i <= 4, x_i >= 0, 0 <= y_i <= 4 with (x_0, y_0) = (x0, x2), b_0 = 7 (solution (2, 3)) and (x_1, y_1) = (x1, x3), b_1 = 3
+// (solution (2/3, 7/3))
+class TwoBlocksModel: public Model {
+public:
+   TwoBlocksModel(): Model("two blocks", 4, 4, 1.) { }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+      return x[0] * x[0] + 4. * x[2] * x[2] - 32. * x[2] + x[1] * x[1] + 4. * x[3] * x[3] - 32. * x[3];
+   }
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, 2. * x[0]);
+      gradient.insert(1, 2. * x[1]);
+      gradient.insert(2, 8. * x[2] - 32.);
+      gradient.insert(3, 8. * x[3] - 32.);
+   }
+   void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+      constraints[0] = x[0] + x[2];
+      constraints[1] = x[1] + x[3];
+      constraints[2] = -x[0] + 2. * x[2];
+      constraints[3] = -x[1] + 2. * x[3];
+   }
+   void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t constraint_index, SparseVector<double>& gradient) const override {
+      gradient.insert(constraint_index % 2, (constraint_index < 2) ? 1. : -1.);
+      gradient.insert(2 + constraint_index % 2, (constraint_index < 2) ? 1. : 2.);
+   }
+   void evaluate_constraint_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& constraint_jacobian) const override {
+      for (size_t constraint_index: Range(4)) {
+         constraint_jacobian[constraint_index].insert(constraint_index % 2, (constraint_index < 2) ? 1. : -1.);
+         constraint_jacobian[constraint_index].insert(2 + constraint_index % 2, (constraint_index < 2) ? 1. : 2.);
+      }
+   }
+   void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& /*multipliers*/,
+         SymmetricMatrix<size_t, double>& hessian) const override {
+      hessian.reset();
+      for (size_t variable_index: Range(4)) {
+         hessian.insert(((variable_index < 2) ? 2. : 8.) * objective_multiplier, variable_index, variable_index);
+         hessian.finalize_column(variable_index);
+      }
+   }
+
+   [[nodiscard]] double variable_lower_bound(size_t /*variable_index*/) const override { return 0.; }
+   [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return (variable_index < 2) ? INF<double> : 4.; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override {
+      return (variable_index < 2) ? BOUNDED_LOWER : BOUNDED_BOTH_SIDES;
+   }
+   [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->lower_bounded_variables_collection; }
+   [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables_collection; }
+   [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+   [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override {
+      return this->single_lower_bounded_variables_collection;
+   }
+   [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+   [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return -INF<double>; }
+   [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override {
+      return (constraint_index == 0) ? 7. : (constraint_index == 1) ? 3. : 4.;
+   }
+   [[nodiscard]] FunctionType get_objective_type() const override { return QUADRATIC; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return LINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return BOUNDED_UPPER; }
+   [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->constraints_collection; }
+   [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->constraints_collection; }
+
+   void initial_primal_point(Vector<double>& x) const override { x.fill(0.); }
+   void initial_dual_point(Vector<double>& multipliers) const override { multipliers.fill(0.); }
+   void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+   [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 4; }
+   [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 8; }
+   [[nodiscard]] size_t number_hessian_nonzeros() const override { return 4; }
+   [[nodiscard]] bool supports_concurrent_evaluations() const override { return true; }
+
+protected:
+   const std::vector<size_t> lower_bounded_variables{0, 1, 2, 3};
+   const std::vector<size_t> upper_bounded_variables{2, 3};
+   const std::vector<size_t> single_lower_bounded_variables{0, 1};
+   const std::vector<size_t> constraints{0, 1, 2, 3};
+   const std::vector<size_t> no_indices{};
+   const CollectionAdapter<std::vector<size_t>> lower_bounded_variables_collection{this->lower_bounded_variables};
+   const CollectionAdapter<std::vector<size_t>> upper_bounded_variables_collection{this->upper_bounded_variables};
+   const CollectionAdapter<std::vector<size_t>> single_lower_bounded_variables_collection{this->single_lower_bounded_variables};
+   const CollectionAdapter<std::vector<size_t>> constraints_collection{this->constraints};
+   const CollectionAdapter<std::vector<size_t>> empty_collection{this->no_indices};
+   const SparseVector<size_t> slacks{};
+   const Vector<size_t> fixed_variables{};
+};
+
+static Options decomposition_options() {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(Presets::get_preset_options("filtersqp"));
+   options["QP_solver"] = "GoldfarbIdnani";
+   options["logger"] = "SILENT";
+   options["decomposition_threads"] = "2";
+   options["decomposition_min_component_size"] = "1";
+   return options;
+}
+
+TEST(DecompositionSolver, DetectsTheComponents) {
+   const TwoBlocksModel model;
+   const Vector<double> point(model.number_variables, 0.);
+   const ModelDecomposition decomposition = ModelFactory::decompose(model, point, 1);
+   ASSERT_EQ(decomposition.number_components(), 2);
+   ASSERT_EQ(decomposition.variables[0], (std::vector<size_t>{0, 2}));
+   ASSERT_EQ(decomposition.variables[1], (std::vector<size_t>{1, 3}));
+   ASSERT_EQ(decomposition.constraints[0], (std::vector<size_t>{0, 2}));
+   ASSERT_EQ(decomposition.constraints[1], (std::vector<size_t>{1, 3}));
+   ASSERT_EQ(decomposition.local_index_of_variable[3], 1);
+   ASSERT_EQ(decomposition.jacobian_nonzeros[1], 4);
+   ASSERT_EQ(decomposition.hessian_nonzeros[0], 2);
+}
+
+TEST(DecompositionSolver, SmallComponentsAreGrouped) {
+   const TwoBlocksModel model;
+   const Vector<double> point(model.number_variables, 0.);
+   const ModelDecomposition decomposition = ModelFactory::decompose(model, point, 3);
+   ASSERT_EQ(decomposition.number_components(), 1);
+   ASSERT_EQ(decomposition.variables[0], (std::vector<size_t>{0, 1, 2, 3}));
+   ASSERT_EQ(decomposition.constraints[0].size(), 4);
+}
+
+TEST(DecompositionSolver, MergesTheSolutionsOfTheComponents) {
+   const Options options = decomposition_options();
+   const TwoBlocksModel model;
+   DecompositionSolver decomposition_solver(options);
+   const Result result = decomposition_solver.solve(model, options);
+   ASSERT_EQ(decomposition_solver.get_number_components(), 2);
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[2], 3., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 2. / 3., 1e-6);
+   ASSERT_NEAR(result.solution.primals[3], 7. / 3., 1e-6);
+   // objectives -56 and -472/9 of the components
+   ASSERT_NEAR(result.solution.evaluations.objective, -56. - 472. / 9., 1e-6);
+   // the multipliers are placed at the original indices of the constraints: x0 + x2 <= 7 is inactive, x1 + x3 <= 3 is active
+   ASSERT_NEAR(result.solution.multipliers.constraints[0], 0., 1e-6);
+   ASSERT_GT(std::abs(result.solution.multipliers.constraints[1]), 1e-6);
+   ASSERT_GT(std::abs(result.solution.multipliers.constraints[2]), 1e-6);
+}
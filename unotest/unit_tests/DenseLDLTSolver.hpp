@@ -0,0 +1,14 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DENSELDLTSOLVER_H
+#define UNO_DENSELDLTSOLVER_H
+
+#include "ingredients/subproblem_solvers/DenseLinearSolver.hpp"
+
+namespace uno {
+   // dense Bunch-Kaufman factorization: computes the inertia
+   using DenseLDLTSolver = DenseLinearSolver<size_t>;
+} // namespace
+
+#endif // UNO_DENSELDLTSOLVER_H
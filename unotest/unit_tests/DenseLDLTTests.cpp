@@ -0,0 +1,106 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <tuple>
+#include <vector>
+#include "linear_algebra/DenseLDLT.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-12;
+
+using DenseMatrix = std::vector<std::vector<double>>;
+
+static void fill(DenseLDLT<double>& factorization, const DenseMatrix& matrix) {
+   for (size_t column = 0; column < matrix.size(); column++) {
+      for (size_t row = column; row < matrix.size(); row++) {
+         factorization.entry(row, column) = matrix[row][column];
+      }
+   }
+}
+
+static std::vector<double> product(const DenseMatrix& matrix, const std::vector<double>& x) {
+   std::vector<double> result(matrix.size(), 0.);
+   for (size_t row = 0; row < matrix.size(); row++) {
+      for (size_t column = 0; column < matrix.size(); column++) {
+         result[row] += matrix[row][column] * x[column];
+      }
+   }
+   return result;
+}
+
+TEST(DenseLDLT, PositiveDefinite) {
+   const DenseMatrix matrix{{4., 1., 0.}, {1., 3., 1.}, {0., 1., 2.}};
+   DenseLDLT<double> factorization(3);
+   fill(factorization, matrix);
+   factorization.factorize();
+   const std::vector<double> solution{1., -2., 3.};
+   std::vector<double> x = product(matrix, solution);
+   factorization.solve(x.data());
+   for (size_t index = 0; index < 3; index++) {
+      EXPECT_NEAR(x[index], solution[index], tolerance);
+   }
+   ASSERT_EQ(factorization.get_inertia(), std::make_tuple(size_t(3), size_t(0), size_t(0)));
+}
+
+// KKT matrix [[H, J^T], [J, 0]] with H positive definite and J full row rank: the zero diagonal requires 2x2 pivots
+TEST(DenseLDLT, KKTMatrixRequiresTwoByTwoPivots) {
+   const DenseMatrix matrix{
+      {0., 0., 1., 1.},
+      {0., 0., 1., -1.},
+      {1., 1., 2., 0.},
+      {1., -1., 0., 3.}
+   };
+   DenseLDLT<double> factorization(4);
+   fill(factorization, matrix);
+   factorization.factorize();
+   const std::vector<double> solution{0.5, -1., 2., 1.5};
+   std::vector<double> x = product(matrix, solution);
+   factorization.solve(x.data());
+   for (size_t index = 0; index < 4; index++) {
+      EXPECT_NEAR(x[index], solution[index], tolerance);
+   }
+   ASSERT_EQ(factorization.get_inertia(), std::make_tuple(size_t(2), size_t(2), size_t(0)));
+}
+
+TEST(DenseLDLT, IndefiniteWithPermutation) {
+   const DenseMatrix matrix{
+      {1e-3, 2., -1., 0.5},
+      {2., -4., 0., 1.},
+      {-1., 0., 5., 2.},
+      {0.5, 1., 2., -1.}
+   };
+   DenseLDLT<double> factorization(4);
+   fill(factorization, matrix);
+   factorization.factorize();
+   const std::vector<double> solution{1., 2., 3., 4.};
+   std::vector<double> x = product(matrix, solution);
+   factorization.solve(x.data());
+   for (size_t index = 0; index < 4; index++) {
+      EXPECT_NEAR(x[index], solution[index], 1e-10);
+   }
+   const auto [number_positive, number_negative, number_zero] = factorization.get_inertia();
+   ASSERT_EQ(number_positive + number_negative, 4);
+   ASSERT_EQ(number_zero, 0);
+   ASSERT_FALSE(factorization.is_singular());
+}
+
+TEST(DenseLDLT, SingularMatrix) {
+   const DenseMatrix matrix{{1., 1.}, {1., 1.}};
+   DenseLDLT<double> factorization(2);
+   fill(factorization, matrix);
+   factorization.factorize(1e-12);
+   ASSERT_TRUE(factorization.is_singular());
+   ASSERT_EQ(factorization.get_inertia(), std::make_tuple(size_t(1), size_t(0), size_t(1)));
+   // consistent right-hand side
+   std::vector<double> x{2., 2.};
+   factorization.solve(x.data());
+   EXPECT_NEAR(x[0] + x[1], 2., tolerance);
+}
+
+TEST(DenseLDLT, SolveBeforeFactorizationThrows) {
+   DenseLDLT<double> factorization(2);
+   std::vector<double> x{1., 1.};
+   ASSERT_THROW(factorization.solve(x.data()), std::runtime_error);
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include "ingredients/subproblem_solvers/DenseLinearSolver.hpp"
+#include "ingredients/subproblem_solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-12;
+
+// KKT matrix [H A^T; A 0] with H = diag(2, 3) and A = [1 1]: inertia (2, 1, 0)
+template <typename IndexType>
+static SymmetricMatrix<IndexType, double> KKT_matrix(const std::string& sparse_format, size_t index_shift) {
+   SymmetricMatrix<IndexType, double> matrix(3, 5, false, sparse_format, index_shift);
+   if (sparse_format == "CSC") {
+      matrix.insert(2., 0, 0);
+      matrix.finalize_column(0);
+      matrix.insert(3., 1, 1);
+      matrix.finalize_column(1);
+      matrix.insert(1., 0, 2);
+      matrix.insert(1., 1, 2);
+      matrix.finalize_column(2);
+   }
+   else {
+      matrix.insert(2., 0, 0);
+      matrix.insert(3., 1, 1);
+      matrix.insert(1., 0, 2);
+      // duplicates are summed
+      matrix.insert(0.5, 1, 2);
+      matrix.insert(0.5, 1, 2);
+   }
+   return matrix;
+}
+
+template <typename IndexType, size_t MaximumDimension>
+static void check_KKT_solve(DenseLinearSolver<IndexType, MaximumDimension>& solver, const SymmetricMatrix<IndexType, double>& matrix) {
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   ASSERT_EQ(solver.get_inertia(), std::make_tuple(size_t(2), size_t(1), size_t(0)));
+   ASSERT_FALSE(solver.matrix_is_singular());
+   ASSERT_EQ(solver.rank(), 3);
+   // the solution of the system with rhs (3, 4, 2) is (1, 1, 1)
+   const Vector<double> rhs{3., 4., 2.};
+   Vector<double> result(3);
+   solver.solve_indefinite_system(matrix, rhs, result);
+   for (size_t index: Range(3)) {
+      ASSERT_NEAR(result[index], 1., tolerance);
+   }
+}
+
+TEST(DenseLinearSolver, COOMatrix) {
+   DenseLinearSolver<size_t> solver(3);
+   check_KKT_solve(solver, KKT_matrix<size_t>("COO", 0));
+}
+
+TEST(DenseLinearSolver, CSCMatrixWithFortranIndices) {
+   DenseLinearSolver<int> solver(3);
+   check_KKT_solve(solver, KKT_matrix<int>("CSC", 1));
+}
+
+TEST(DenseLinearSolver, FactorizationStatistics) {
+   DenseLinearSolver<int> solver(3);
+   const auto matrix = KKT_matrix<int>("CSC", 0);
+   check_KKT_solve(solver, matrix);
+   solver.do_numerical_factorization(matrix);
+   const FactorizationStatistics statistics = solver.get_factorization_statistics();
+   ASSERT_EQ(statistics.number_analyses, 1);
+   ASSERT_EQ(statistics.number_factorizations, 2);
+   // the lower triangle of the 3x3 factors is stored
+   ASSERT_EQ(statistics.matrix_nonzeros, 4);
+   ASSERT_EQ(statistics.factor_nonzeros, 6);
+   ASSERT_NEAR(statistics.fill(), 1.5, tolerance);
+   ASSERT_NEAR(statistics.flops, 18., tolerance);
+   ASSERT_EQ(statistics.delayed_pivots, 0);
+   // the snapshot difference only counts the second factorization
+   FactorizationStatistics snapshot = statistics;
+   solver.do_numerical_factorization(matrix);
+   const FactorizationStatistics difference = solver.get_factorization_statistics().since(snapshot);
+   ASSERT_EQ(difference.number_analyses, 0);
+   ASSERT_EQ(difference.number_factorizations, 1);
+   ASSERT_NEAR(difference.flops, 9., tolerance);
+}
+
+TEST(DenseLinearSolver, SingularMatrix) {
+   // the third row is the sum of the first two rows
+   SymmetricMatrix<size_t, double> matrix(3, 6, false, "COO");
+   matrix.insert(1., 0, 0);
+   matrix.insert(1., 1, 1);
+   matrix.insert(2., 2, 2);
+   matrix.insert(1., 0, 2);
+   matrix.insert(1., 1, 2);
+   DenseLinearSolver<size_t> solver(3, 1e-14);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   ASSERT_TRUE(solver.matrix_is_singular());
+   ASSERT_EQ(solver.rank(), 2);
+}
+
+TEST(DenseLinearSolver, DimensionChange) {
+   // the solver is allocated for dimension 5, the matrix has dimension 3: no spurious zero eigenvalue
+   DenseLinearSolver<size_t> solver(5);
+   check_KKT_solve(solver, KKT_matrix<size_t>("COO", 0));
+}
+
+TEST(DenseLinearSolver, FixedCapacity) {
+   // the dense KKT buffer is stored inline: the dimension changes without reallocation
+   DenseLinearSolver<size_t, 4> solver(4);
+   check_KKT_solve(solver, KKT_matrix<size_t>("COO", 0));
+   ASSERT_EQ(solver.memory_size(), (16 + 4) * sizeof(double) + 8 * sizeof(size_t) + 5 * sizeof(std::pair<size_t, size_t>));
+   using TinySolver = DenseLinearSolver<size_t, 2>;
+   ASSERT_THROW(TinySolver(3), std::invalid_argument);
+}
+
+TEST(DenseLinearSolver, AutomaticSelection) {
+   Options options = DefaultOptions::load();
+   options["linear_solver"] = "auto";
+   const auto small_solver = SymmetricIndefiniteLinearSolverFactory::create<size_t>(100, 500, options);
+   ASSERT_NE(dynamic_cast<DenseLinearSolver<size_t>*>(small_solver.get()), nullptr);
+   options["linear_solver"] = "dense";
+   const auto dense_solver = SymmetricIndefiniteLinearSolverFactory::create<int>(1000, 5000, options);
+   ASSERT_NE(dynamic_cast<DenseLinearSolver<int>*>(dense_solver.get()), nullptr);
+}
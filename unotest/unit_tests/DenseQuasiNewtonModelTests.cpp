@@ -0,0 +1,154 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/DenseQuasiNewtonModel.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+namespace {
+   using Matrix2 = std::array<std::array<double, 2>, 2>;
+
+   // exposes the update with given pairs (s, y)
+   class DenseQuasiNewtonTestModel: public DenseQuasiNewtonModel {
+   public:
+      explicit DenseQuasiNewtonTestModel(QuasiNewtonUpdate update_formula):
+            DenseQuasiNewtonModel(std::make_unique<QuadraticTestModel>(), update_formula) { }
+
+      void add_pair(const std::array<double, 2>& s, const std::array<double, 2>& y) const {
+         DenseQuasiNewtonModel::add_pair(Vector<double>{s[0], s[1]}, Vector<double>{y[0], y[1]});
+      }
+
+      // the matrix is read at a fixed point: no pair is formed by the evaluation itself
+      [[nodiscard]] Matrix2 matrix() const {
+         SymmetricMatrix<size_t, double> hessian(2, this->number_hessian_nonzeros(), false, "COO");
+         this->evaluate_lagrangian_hessian(Vector<double>(2, 0.), 1., Vector<double>(2, 0.), hessian);
+         Matrix2 B{};
+         hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+            B[row_index][column_index] += element;
+            if (row_index != column_index) {
+               B[column_index][row_index] += element;
+            }
+         });
+         return B;
+      }
+   };
+
+   std::array<double, 2> product(const Matrix2& B, const std::array<double, 2>& s) {
+      return {B[0][0] * s[0] + B[0][1] * s[1], B[1][0] * s[0] + B[1][1] * s[1]};
+   }
+
+   void expect_matrix_near(const Matrix2& B, const Matrix2& reference) {
+      for (size_t i: Range(2)) {
+         for (size_t j: Range(2)) {
+            EXPECT_NEAR(B[i][j], reference[i][j], 1e-12) << "entry (" << i << ", " << j << ")";
+         }
+      }
+   }
+} // namespace
+
+// the first pair scales the initial matrix with delta = y^T y / s^T y, then the BFGS update satisfies the secant equation
+TEST(DenseQuasiNewtonModel, BFGSUpdate) {
+   const DenseQuasiNewtonTestModel model(QuasiNewtonUpdate::BFGS);
+   expect_matrix_near(model.matrix(), {{{1., 0.}, {0., 1.}}});
+   const std::array<double, 2> s{1., 0.5};
+   const std::array<double, 2> y{2., 4.};
+   model.add_pair(s, y);
+   // delta = 20 / 4 = 5, Bs = (5, 2.5), s^T B s = 6.25: B = 5 I - Bs Bs^T / 6.25 + y y^T / 4
+   expect_matrix_near(model.matrix(), {{{5. - 4. + 1., -2. + 2.}, {-2. + 2., 5. - 1. + 4.}}});
+   const std::array<double, 2> Bs = product(model.matrix(), s);
+   EXPECT_NEAR(Bs[0], y[0], 1e-12);
+   EXPECT_NEAR(Bs[1], y[1], 1e-12);
+}
+
+// a pair with negative curvature is damped: B s matches theta y + (1 - theta) B s and B remains positive definite
+TEST(DenseQuasiNewtonModel, BFGSPowellDamping) {
+   const DenseQuasiNewtonTestModel model(QuasiNewtonUpdate::BFGS);
+   model.add_pair({1., 0.}, {2., 0.});
+   expect_matrix_near(model.matrix(), {{{2., 0.}, {0., 2.}}});
+   // s^T y = -8 < 0.2 s^T B s = 0.4: theta = 0.8 * 2 / (2 + 8) = 0.16 and the damped y is (0, 0.4)
+   model.add_pair({0., 1.}, {0., -8.});
+   const Matrix2 B = model.matrix();
+   expect_matrix_near(B, {{{2., 0.}, {0., 0.4}}});
+   EXPECT_LT(0., B[0][0]);
+   EXPECT_LT(0., B[0][0] * B[1][1] - B[0][1] * B[1][0]);
+}
+
+// the SR1 update recovers an indefinite matrix
+TEST(DenseQuasiNewtonModel, SR1Update) {
+   const DenseQuasiNewtonTestModel model(QuasiNewtonUpdate::SR1);
+   // s^T y < 0: the initial matrix is not scaled. r = y - Bs = (-2, 0) and B = I + r r^T / s^T r
+   model.add_pair({1., 0.}, {-1., 0.});
+   expect_matrix_near(model.matrix(), {{{-1., 0.}, {0., 1.}}});
+   model.add_pair({0., 1.}, {0., -8.});
+   expect_matrix_near(model.matrix(), {{{-1., 0.}, {0., -8.}}});
+}
+
+// the SR1 update is skipped when s^T (y - Bs) vanishes, although y - Bs does not
+TEST(DenseQuasiNewtonModel, SR1SkippedUpdate) {
+   const DenseQuasiNewtonTestModel model(QuasiNewtonUpdate::SR1);
+   model.add_pair({1., 0.}, {-1., 0.});
+   // Bs = (-1, 1) and r = (2, -2) is orthogonal to s
+   model.add_pair({1., 1.}, {1., -1.});
+   expect_matrix_near(model.matrix(), {{{-1., 0.}, {0., 1.}}});
+}
+
+// a change of objective multiplier (switch to the restoration phase) resets the approximation to the identity
+TEST(DenseQuasiNewtonModel, ResetOnRestoration) {
+   const DenseQuasiNewtonModel model(std::make_unique<QuadraticTestModel>(), QuasiNewtonUpdate::BFGS);
+   SymmetricMatrix<size_t, double> hessian(2, model.number_hessian_nonzeros(), false, "COO");
+   const Vector<double> multipliers{1., 0.5};
+   const auto first_diagonal_entry = [&]() {
+      double entry = 0.;
+      hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+         if (row_index == 0 && column_index == 0) {
+            entry += element;
+         }
+      });
+      return entry;
+   };
+   model.evaluate_lagrangian_hessian(Vector<double>{1., 1.}, 1., multipliers, hessian);
+   model.evaluate_lagrangian_hessian(Vector<double>{2., 1.5}, 1., multipliers, hessian);
+   // the pair (s, y) = ((1, 0.5), (2, 4)) was used: B_00 = 2
+   EXPECT_NEAR(first_diagonal_entry(), 2., 1e-12);
+   model.evaluate_lagrangian_hessian(Vector<double>{3., 2.}, 0., multipliers, hessian);
+   EXPECT_EQ(first_diagonal_entry(), 1.);
+   size_t number_off_diagonal_nonzeros = 0;
+   hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+      if (row_index != column_index && element != 0.) {
+         number_off_diagonal_nonzeros++;
+      }
+   });
+   EXPECT_EQ(number_off_diagonal_nonzeros, 0);
+}
+
+// the interior-point method converges with the dense BFGS approximation
+TEST(DenseQuasiNewtonModel, BFGSSolve) {
+   Options options = test_options("ipopt");
+   options["hessian_model"] = "BFGS";
+   options["linear_solver"] = "dense";
+   const Result result = solve_reformulated_model(std::make_unique<QuadraticTestModel>(), options);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+}
+
+// the interior-point method converges with the dense SR1 approximation
+TEST(DenseQuasiNewtonModel, SR1Solve) {
+   Options options = test_options("ipopt");
+   options["hessian_model"] = "SR1";
+   options["linear_solver"] = "dense";
+   const Result result = solve_reformulated_model(std::make_unique<QuadraticTestModel>(), options);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DENSESOLVER_H
+#define UNO_DENSESOLVER_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Range.hpp"
+
+namespace uno {
+   // dense Gaussian elimination with partial pivoting
+   class DenseSolver: public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+   public:
+      explicit DenseSolver(size_t dimension): DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension) { }
+
+      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& /*matrix*/) override { }
+      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& /*matrix*/) override { }
+      void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override {
+         const size_t dimension = matrix.dimension();
+         std::vector<std::vector<double>> dense(dimension, std::vector<double>(dimension + 1, 0.));
+         matrix.for_each([&](size_t row_index, size_t column_index, double element) {
+            dense[row_index][column_index] += element;
+            if (row_index != column_index) {
+               dense[column_index][row_index] += element;
+            }
+         });
+         for (size_t row_index: Range(dimension)) {
+            dense[row_index][dimension] = rhs[row_index];
+         }
+         for (size_t pivot_index: Range(dimension)) {
+            size_t best_row = pivot_index;
+            for (size_t row_index: Range(pivot_index + 1, dimension)) {
+               if (std::abs(dense[best_row][pivot_index]) < std::abs(dense[row_index][pivot_index])) {
+                  best_row = row_index;
+               }
+            }
+            std::swap(dense[pivot_index], dense[best_row]);
+            for (size_t row_index: Range(pivot_index + 1, dimension)) {
+               const double factor = dense[row_index][pivot_index] / dense[pivot_index][pivot_index];
+               for (size_t column_index: Range(pivot_index, dimension + 1)) {
+                  dense[row_index][column_index] -= factor * dense[pivot_index][column_index];
+               }
+            }
+         }
+         for (size_t row_index = dimension; row_index-- > 0;) {
+            double value = dense[row_index][dimension];
+            for (size_t column_index: Range(row_index + 1, dimension)) {
+               value -= dense[row_index][column_index] * result[column_index];
+            }
+            result[row_index] = value / dense[row_index][row_index];
+         }
+      }
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override { return {0, 0, 0}; }
+      [[nodiscard]] size_t number_negative_eigenvalues() const override { return 0; }
+      [[nodiscard]] bool matrix_is_singular() const override { return false; }
+      [[nodiscard]] size_t rank() const override { return this->dimension; }
+   };
+} // namespace
+
+#endif // UNO_DENSESOLVER_H
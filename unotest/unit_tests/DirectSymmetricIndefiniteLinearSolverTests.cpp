@@ -0,0 +1,54 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/subproblem_solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+
+using namespace uno;
+
+// solver of diagonal systems that only implements the single-rhs solve
+class DiagonalSingleRhsSolver: public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+public:
+   explicit DiagonalSingleRhsSolver(size_t dimension): DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension), diagonal(dimension) { }
+
+   void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& /*matrix*/) override { }
+   void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override {
+      std::fill(this->diagonal.begin(), this->diagonal.end(), 0.);
+      matrix.get_diagonal(this->diagonal);
+   }
+   void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override {
+      for (size_t index: Range(matrix.dimension())) {
+         result[index] = rhs[index] / this->diagonal[index];
+      }
+   }
+
+   [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override { return {this->dimension, 0, 0}; }
+   [[nodiscard]] size_t number_negative_eigenvalues() const override { return 0; }
+   [[nodiscard]] bool matrix_is_singular() const override { return false; }
+   [[nodiscard]] size_t rank() const override { return this->dimension; }
+
+protected:
+   std::vector<double> diagonal;
+};
+
+TEST(DirectSymmetricIndefiniteLinearSolver, BlockSolve) {
+   const size_t n = 3;
+   const size_t number_rhs = 2;
+   SymmetricMatrix<size_t, double> matrix(n, n, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(4., 1, 1);
+   matrix.insert(-5., 2, 2);
+   // column-major n x 2 block
+   const Vector<double> rhs{2., 8., 10., 1., -4., 5.};
+   Vector<double> result(n * number_rhs);
+   const std::array<double, n * number_rhs> reference{1., 2., -2., 0.5, -1., -1.};
+
+   DiagonalSingleRhsSolver solver(n);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_systems(matrix, rhs, result, number_rhs);
+
+   for (size_t index: Range(n * number_rhs)) {
+      EXPECT_DOUBLE_EQ(result[index], reference[index]);
+   }
+}
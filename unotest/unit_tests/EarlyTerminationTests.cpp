@@ -0,0 +1,103 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-8;
+
+// min -x0 + 4 x1^2 - 32 x1 s.t. -x0 + x1 <= b, -x0 + 2 x1 <= 4, x0 >= 0, 0 <= x1 <= 4: unbounded along x0
+class UnboundedTestModel: public QuadraticTestModel {
+public:
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override { return -x[0] + 4. * x[1] * x[1] - 32. * x[1]; }
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, -1.);
+      gradient.insert(1, 8. * x[1] - 32.);
+   }
+   void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+      constraints[0] = -x[0] + x[1];
+      constraints[1] = -x[0] + 2. * x[1];
+   }
+   void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t constraint_index, SparseVector<double>& gradient) const override {
+      gradient.insert(0, -1.);
+      gradient.insert(1, (constraint_index == 0) ? 1. : 2.);
+   }
+   void evaluate_constraint_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& constraint_jacobian) const override {
+      constraint_jacobian[0].insert(0, -1.);
+      constraint_jacobian[0].insert(1, 1.);
+      constraint_jacobian[1].insert(0, -1.);
+      constraint_jacobian[1].insert(1, 2.);
+   }
+   void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& /*multipliers*/,
+         SymmetricMatrix<size_t, double>& hessian) const override {
+      hessian.reset();
+      hessian.insert(0., 0, 0);
+      hessian.finalize_column(0);
+      hessian.insert(8. * objective_multiplier, 1, 1);
+      hessian.finalize_column(1);
+   }
+   [[nodiscard]] FunctionType get_objective_type() const override { return QUADRATIC; }
+};
+
+static Options filtersqp_options(bool early_termination) {
+   Options options = test_options("filtersqp");
+   options["early_termination"] = early_termination ? "yes" : "no";
+   // the objective of the test model is small
+   options["unbounded_divergence_threshold"] = "1e2";
+   return options;
+}
+
+// initial point away from the solutions
+static const Vector<double> initial_point{10., 3.};
+
+TEST(EarlyTermination, InfeasibilityCertificate) {
+   // x0 + x1 <= -1 cannot be satisfied with x >= 0: the certificate is the normalized multiplier of the first constraint
+   QuadraticTestModel model;
+   model.set_parameter(-1.);
+   const Result result = solve_model(model, filtersqp_options(true), initial_point);
+   ASSERT_EQ(result.solution.status, IterateStatus::INFEASIBLE_STATIONARY_POINT);
+   ASSERT_EQ(result.certificate.type, CertificateType::INFEASIBILITY);
+   ASSERT_EQ(result.certificate.test, "stationary point");
+   ASSERT_LT(result.certificate.residual, tolerance);
+   ASSERT_EQ(result.certificate.constraint_multipliers.size(), model.number_constraints);
+   ASSERT_NEAR(result.certificate.constraint_multipliers[0], -1., tolerance);
+   ASSERT_NEAR(result.certificate.constraint_multipliers[1], 0., tolerance);
+}
+
+TEST(EarlyTermination, ObjectiveDivergence) {
+   const UnboundedTestModel model;
+   const Result late_result = solve_model(model, filtersqp_options(false), initial_point);
+   const Result early_result = solve_model(model, filtersqp_options(true), initial_point);
+   ASSERT_EQ(early_result.solution.status, IterateStatus::UNBOUNDED);
+   ASSERT_LT(early_result.iteration, late_result.iteration);
+   ASSERT_EQ(early_result.certificate.type, CertificateType::UNBOUNDEDNESS);
+   ASSERT_EQ(early_result.certificate.test, "objective divergence");
+   // the ray is the direction x0
+   ASSERT_EQ(early_result.certificate.primal_ray.size(), model.number_variables);
+   ASSERT_NEAR(early_result.certificate.primal_ray[0], 1., tolerance);
+   ASSERT_NEAR(early_result.certificate.primal_ray[1], 0., tolerance);
+}
+
+TEST(EarlyTermination, FeasibleModelIsNotAffected) {
+   const QuadraticTestModel model;
+   const Result result = solve_model(model, filtersqp_options(true), initial_point);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_EQ(result.certificate.type, CertificateType::NONE);
+   ASSERT_NEAR(result.solution.primals[0], 2., tolerance);
+   ASSERT_NEAR(result.solution.primals[1], 3., tolerance);
+}
+
+TEST(EarlyTermination, InvalidWindow) {
+   Options options = filtersqp_options(true);
+   options["early_termination_window"] = "0";
+   const QuadraticTestModel model;
+   ASSERT_THROW(ConstraintRelaxationStrategyFactory::create(model, options), std::invalid_argument);
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "model/EditableModel.hpp"
+#include "model/HomogeneousEqualityConstrainedModel.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "tools/Infinity.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+static SparseVector<double> cut_coefficients(double first_coefficient, double second_coefficient) {
+   SparseVector<double> coefficients(2);
+   coefficients.insert(0, first_coefficient);
+   coefficients.insert(1, second_coefficient);
+   return coefficients;
+}
+
+TEST(EditableModel, LinearConstraintSlots) {
+   EditableModel model(std::make_unique<QuadraticTestModel>(), 2, 3);
+   ASSERT_EQ(model.number_constraints, 4);
+   ASSERT_EQ(model.number_jacobian_nonzeros(), 4 + 3);
+   // the free slots are unbounded inequality constraints
+   ASSERT_EQ(model.get_constraint_bound_type(2), UNBOUNDED);
+   ASSERT_EQ(model.get_inequality_constraints().size(), 4);
+   ASSERT_FALSE(model.get_changes().jacobian_sparsity_changed);
+
+   const size_t cut_index = model.add_linear_constraint(cut_coefficients(1., -1.), 1., INF<double>);
+   ASSERT_EQ(cut_index, 2);
+   ASSERT_EQ(model.get_constraint_bound_type(cut_index), BOUNDED_LOWER);
+   ASSERT_TRUE(model.get_changes().jacobian_sparsity_changed);
+   ASSERT_TRUE(model.get_changes().constraint_bounds_changed);
+   ASSERT_FALSE(model.get_changes().variable_bounds_changed);
+
+   const Vector<double> x{3., 1.};
+   std::vector<double> constraints(model.number_constraints);
+   model.evaluate_constraints(x, constraints);
+   ASSERT_EQ(constraints[0], 4.);
+   ASSERT_EQ(constraints[2], 2.);
+   ASSERT_EQ(constraints[3], 0.);
+   RectangularMatrix<double> jacobian(model.number_constraints, model.number_variables);
+   model.evaluate_constraint_jacobian(x, jacobian);
+   ASSERT_EQ(jacobian.row_size(2), 2);
+   ASSERT_EQ(jacobian.row_size(3), 0);
+
+   // the nonzeros are reserved: a second cut with 2 nonzeros does not fit
+   ASSERT_THROW(model.add_linear_constraint(cut_coefficients(1., 1.), -INF<double>, 0.), std::runtime_error);
+   ASSERT_THROW(model.remove_linear_constraint(3), std::invalid_argument);
+   ASSERT_THROW(model.remove_linear_constraint(0), std::invalid_argument);
+   model.remove_linear_constraint(cut_index);
+   ASSERT_EQ(model.number_linear_constraints_added(), 0);
+   ASSERT_EQ(model.add_linear_constraint(cut_coefficients(1., 1.), -INF<double>, 0.), cut_index);
+}
+
+TEST(EditableModel, BoundChanges) {
+   EditableModel model(std::make_unique<QuadraticTestModel>(), 0, 0);
+   ASSERT_TRUE(model.get_fixed_variables().empty());
+   model.fix_variable(1, 2.);
+   model.set_constraint_bounds(1, 4., 4.);
+   ASSERT_TRUE(model.get_changes().variable_bounds_changed);
+   ASSERT_FALSE(model.get_changes().jacobian_sparsity_changed);
+   ASSERT_EQ(model.get_variable_bound_type(1), EQUAL_BOUNDS);
+   ASSERT_THROW(model.set_variable_bounds(0, 1., 0.), std::invalid_argument);
+   // the collections are recomputed upon refresh
+   model.refresh();
+   ASSERT_EQ(model.get_fixed_variables().size(), 1);
+   ASSERT_EQ(model.get_equality_constraints().size(), 1);
+   ASSERT_EQ(model.get_single_lower_bounded_variables().size(), 1);
+   model.clear_changes();
+   ASSERT_FALSE(model.get_changes().variable_bounds_changed);
+}
+
+// the slack of an appended cut is bounded after the refresh of the reformulation
+TEST(EditableModel, EqualityConstrainedReformulation) {
+   auto editable_model = std::make_unique<EditableModel>(std::make_unique<QuadraticTestModel>(), 2, 4);
+   EditableModel& edits = *editable_model;
+   HomogeneousEqualityConstrainedModel model(std::move(editable_model));
+   ASSERT_EQ(model.number_variables, 2 + 4);
+   ASSERT_EQ(model.get_lower_bounded_variables().size(), 2);
+   edits.add_linear_constraint(cut_coefficients(1., -1.), 1., INF<double>);
+   model.refresh();
+   ASSERT_EQ(model.get_lower_bounded_variables().size(), 3);
+   ASSERT_EQ(model.variable_lower_bound(4), 1.);
+   // an appended equality constraint has no slack
+   edits.add_linear_constraint(cut_coefficients(1., 1.), 5., 5.);
+   ASSERT_THROW(model.refresh(), std::runtime_error);
+}
+
+static Options editable_model_options() {
+   Options options = test_options("filtersqp");
+   // the trust region does not require a linear solver
+   options["globalization_mechanism"] = "TR";
+   return options;
+}
+
+// outer-approximation-like loop: cuts are appended, then removed, and a variable is fixed, with the same solver
+TEST(EditableModel, ResolveAfterEdits) {
+   const Options options = editable_model_options();
+   auto editable_model = std::make_unique<EditableModel>(std::make_unique<QuadraticTestModel>(), 1, 1);
+   EditableModel& edits = *editable_model;
+   const std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(editable_model), options);
+   TestSolver solver(*model, options);
+   const auto solve = [&](bool first_solve) {
+      Iterate initial_iterate = solver.initial_iterate();
+      model->refresh();
+      const Result result = first_solve ? solver.uno.solve(*model, initial_iterate, options) :
+         solver.uno.resolve(*model, initial_iterate, options, edits.get_changes());
+      edits.clear_changes();
+      return result;
+   };
+
+   const Result result = solve(true);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+
+   // cut x0 <= 1
+   SparseVector<double> coefficients(1);
+   coefficients.insert(0, 1.);
+   const size_t cut_index = edits.add_linear_constraint(coefficients, -INF<double>, 1.);
+   const Result cut_result = solve(false);
+   ASSERT_EQ(cut_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(cut_result.solution.primals[0], 1., 1e-6);
+   ASSERT_NEAR(cut_result.solution.primals[1], 2.5, 1e-6);
+
+   edits.remove_linear_constraint(cut_index);
+   edits.fix_variable(0, 0.);
+   const Result fixed_result = solve(false);
+   ASSERT_EQ(fixed_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(fixed_result.solution.primals[0], 0., 1e-6);
+   ASSERT_NEAR(fixed_result.solution.primals[1], 2., 1e-6);
+}
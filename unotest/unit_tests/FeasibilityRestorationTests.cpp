@@ -0,0 +1,72 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <string>
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/constraint_relaxation_strategies/FeasibilityRestoration.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+// the constraint x0 + x1 <= b is infeasible for b < 0 (x0, x1 >= 0)
+static Result solve(const std::string& preset, double parameter, bool specialized_pipelines = true) {
+   Options options = test_options(preset);
+   options["specialized_pipelines"] = specialized_pipelines ? "yes" : "no";
+   QuadraticTestModel model;
+   model.set_parameter(parameter);
+   TestSolver solver(model, options);
+   const bool is_specialized = (dynamic_cast<SQPFeasibilityRestoration*>(solver.constraint_relaxation_strategy.get()) != nullptr);
+   EXPECT_EQ(is_specialized, specialized_pipelines && preset == "filtersqp");
+   return solver.solve(Vector<double>{10., 3.});
+}
+
+TEST(FeasibilityRestoration, NoObjectiveGradientInRestoration) {
+   for (const std::string preset: {"filtersqp", "funnelsqp"}) {
+      const Result result = solve(preset, -1.);
+      ASSERT_EQ(result.solution.status, IterateStatus::INFEASIBLE_STATIONARY_POINT);
+      // only the initial iterate (optimality phase) evaluates the objective gradient
+      ASSERT_EQ(result.objective_gradient_evaluations, 1);
+      // the objective measure of the final iterate is set upon termination
+      ASSERT_EQ(result.solution.progress.objective(1.), result.solution.evaluations.objective);
+   }
+}
+
+TEST(FeasibilityRestoration, FeasibleProblemUnchanged) {
+   for (const std::string preset: {"filtersqp", "funnelsqp"}) {
+      const Result result = solve(preset, 7.);
+      ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+      ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+      ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+   }
+}
+
+TEST(FeasibilityRestoration, SpecializedPipelineMatchesRuntimePipeline) {
+   for (const double parameter: {7., -1.}) {
+      const Result specialized_result = solve("filtersqp", parameter, true);
+      const Result runtime_result = solve("filtersqp", parameter, false);
+      ASSERT_EQ(specialized_result.solution.status, runtime_result.solution.status);
+      ASSERT_EQ(specialized_result.iteration, runtime_result.iteration);
+      ASSERT_EQ(specialized_result.solution.primals[0], runtime_result.solution.primals[0]);
+      ASSERT_EQ(specialized_result.solution.primals[1], runtime_result.solution.primals[1]);
+   }
+}
+
+TEST(FeasibilityRestoration, InteriorPointPipelineSelection) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(Presets::get_preset_options("ipopt"));
+   options["linear_solver"] = "dense";
+   QuadraticTestModel model;
+   auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(model, options);
+   ASSERT_NE(dynamic_cast<InteriorPointFeasibilityRestoration*>(constraint_relaxation_strategy.get()), nullptr);
+   // any other ingredient falls back to the runtime pipeline
+   options["globalization_strategy"] = "l1_merit";
+   constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(model, options);
+   ASSERT_EQ(dynamic_cast<InteriorPointFeasibilityRestoration*>(constraint_relaxation_strategy.get()), nullptr);
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <string>
+#include "ingredients/globalization_strategies/switching_methods/filter_methods/filters/Filter.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+
+using namespace uno;
+
+// exposes the entries of the filter
+class InspectableFilter: public Filter {
+public:
+   explicit InspectableFilter(const Options& options): Filter(options) { }
+
+   [[nodiscard]] size_t size() const { return this->number_entries; }
+   [[nodiscard]] double entry_infeasibility(size_t position) const { return this->infeasibility[position]; }
+   [[nodiscard]] double entry_objective(size_t position) const { return this->objective[position]; }
+   [[nodiscard]] double upper_bound() const { return this->infeasibility_upper_bound; }
+
+   // reference: linear scan of the entries
+   [[nodiscard]] bool linear_acceptable(double trial_infeasibility, double trial_objective) const {
+      if (!this->acceptable_wrt_upper_bound(trial_infeasibility)) {
+         return false;
+      }
+      for (size_t position: Range(this->number_entries)) {
+         if (!this->infeasibility_sufficient_reduction(this->infeasibility[position], trial_infeasibility) &&
+               !this->objective_sufficient_reduction(this->objective[position], trial_objective, trial_infeasibility)) {
+            return false;
+         }
+      }
+      return true;
+   }
+};
+
+static Options filter_options(size_t capacity) {
+   Options options = DefaultOptions::load();
+   options["filter_capacity"] = std::to_string(capacity);
+   return options;
+}
+
+// deterministic pseudo-random numbers in [0, 1)
+static double next_random(unsigned long& state) {
+   state = state * 6364136223846793005UL + 1442695040888963407UL;
+   return static_cast<double>(state >> 11) / static_cast<double>(1UL << 53);
+}
+
+TEST(Filter, EntriesFormASortedParetoFront) {
+   InspectableFilter filter(filter_options(1000));
+   unsigned long state = 42;
+   for (size_t trial_index = 0; trial_index < 2000; trial_index++) {
+      const double infeasibility = next_random(state);
+      const double objective = next_random(state);
+      // as in the filter methods, only acceptable points are added
+      if (filter.acceptable(infeasibility, objective)) {
+         filter.add(infeasibility, objective);
+      }
+      for (size_t position = 1; position < filter.size(); position++) {
+         ASSERT_LT(filter.entry_infeasibility(position - 1), filter.entry_infeasibility(position));
+         ASSERT_GT(filter.entry_objective(position - 1), filter.entry_objective(position));
+      }
+   }
+   ASSERT_LT(1, filter.size());
+}
+
+TEST(Filter, AcceptabilityMatchesLinearScan) {
+   InspectableFilter filter(filter_options(1000));
+   unsigned long state = 7;
+   for (size_t entry_index = 0; entry_index < 200; entry_index++) {
+      const double infeasibility = next_random(state);
+      const double objective = next_random(state);
+      if (filter.acceptable(infeasibility, objective)) {
+         filter.add(infeasibility, objective);
+      }
+   }
+   for (size_t trial_index = 0; trial_index < 2000; trial_index++) {
+      const double infeasibility = next_random(state);
+      const double objective = next_random(state);
+      ASSERT_EQ(filter.acceptable(infeasibility, objective), filter.linear_acceptable(infeasibility, objective));
+   }
+}
+
+TEST(Filter, FullFilterLowersUpperBound) {
+   const size_t capacity = 3;
+   InspectableFilter filter(filter_options(capacity));
+   filter.set_infeasibility_upper_bound(10.);
+   for (size_t entry_index: Range(capacity + 1)) {
+      const double infeasibility = static_cast<double>(entry_index + 1);
+      filter.add(infeasibility, -infeasibility);
+   }
+   ASSERT_EQ(filter.size(), capacity);
+   // the last entry made room for the new entry and the upper bound was lowered
+   ASSERT_EQ(filter.entry_infeasibility(capacity - 2), 2.);
+   ASSERT_EQ(filter.entry_infeasibility(capacity - 1), 4.);
+   ASSERT_LT(filter.upper_bound(), 10.);
+}
@@ -0,0 +1,250 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/FiniteDifferenceHessianModel.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+namespace {
+   using Edges = std::vector<std::pair<size_t, size_t>>;
+
+   // unconstrained min sum_i x_i^4 / 4 + sum_{(i, j) in E} x_i^2 x_j^2 / 2, whose Hessian has the sparsity of the graph E
+   class PatternModel: public Model {
+   public:
+      PatternModel(size_t number_variables, Edges edges): Model("pattern model", number_variables, 0, 1.), edges(std::move(edges)) { }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+         double objective = 0.;
+         for (size_t variable_index: Range(this->number_variables)) {
+            objective += std::pow(x[variable_index], 4) / 4.;
+         }
+         for (const auto [i, j]: this->edges) {
+            objective += x[i] * x[i] * x[j] * x[j] / 2.;
+         }
+         return objective;
+      }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         std::vector<double> dense_gradient(this->number_variables);
+         for (size_t variable_index: Range(this->number_variables)) {
+            dense_gradient[variable_index] = std::pow(x[variable_index], 3);
+         }
+         for (const auto [i, j]: this->edges) {
+            dense_gradient[i] += x[i] * x[j] * x[j];
+            dense_gradient[j] += x[i] * x[i] * x[j];
+         }
+         for (size_t variable_index: Range(this->number_variables)) {
+            gradient.insert(variable_index, dense_gradient[variable_index]);
+         }
+      }
+      void evaluate_constraints(const Vector<double>& /*x*/, std::vector<double>& /*constraints*/) const override { }
+      void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t /*constraint_index*/, SparseVector<double>& /*gradient*/) const override { }
+      void evaluate_constraint_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& /*constraint_jacobian*/) const override { }
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& /*multipliers*/,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         const std::vector<std::vector<double>> dense_hessian = this->exact_hessian(x);
+         hessian.reset();
+         for (size_t column_index: Range(this->number_variables)) {
+            for (size_t row_index: Range(column_index + 1)) {
+               if (row_index == column_index || this->are_adjacent(row_index, column_index)) {
+                  hessian.insert(objective_multiplier * dense_hessian[row_index][column_index], row_index, column_index);
+               }
+            }
+            hessian.finalize_column(column_index);
+         }
+      }
+
+      // diagonal 3 x_i^2 + sum_{j adjacent to i} x_j^2, off-diagonal 2 x_i x_j
+      [[nodiscard]] std::vector<std::vector<double>> exact_hessian(const Vector<double>& x) const {
+         std::vector<std::vector<double>> dense_hessian(this->number_variables, std::vector<double>(this->number_variables, 0.));
+         for (size_t variable_index: Range(this->number_variables)) {
+            dense_hessian[variable_index][variable_index] = 3. * x[variable_index] * x[variable_index];
+         }
+         for (const auto [i, j]: this->edges) {
+            dense_hessian[i][i] += x[j] * x[j];
+            dense_hessian[j][j] += x[i] * x[i];
+            dense_hessian[i][j] += 2. * x[i] * x[j];
+            dense_hessian[j][i] += 2. * x[i] * x[j];
+         }
+         return dense_hessian;
+      }
+
+      [[nodiscard]] bool are_adjacent(size_t i, size_t j) const {
+         return std::any_of(this->edges.cbegin(), this->edges.cend(), [&](const std::pair<size_t, size_t>& edge) {
+            return (edge.first == i && edge.second == j) || (edge.first == j && edge.second == i);
+         });
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t /*variable_index*/) const override { return -INF<double>; }
+      [[nodiscard]] double variable_upper_bound(size_t /*variable_index*/) const override { return INF<double>; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t /*variable_index*/) const override { return UNBOUNDED; }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->empty_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->empty_collection; }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return -INF<double>; }
+      [[nodiscard]] double constraint_upper_bound(size_t /*constraint_index*/) const override { return INF<double>; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return NONLINEAR; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return LINEAR; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return UNBOUNDED; }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->empty_collection; }
+
+      void initial_primal_point(Vector<double>& x) const override { x.fill(1.); }
+      void initial_dual_point(Vector<double>& /*multipliers*/) const override { }
+      void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->number_variables; }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 0; }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->number_variables + this->edges.size(); }
+      [[nodiscard]] bool declare_hessian_sparsity(std::vector<size_t>& row_indices, std::vector<size_t>& column_indices) const override {
+         for (size_t variable_index: Range(this->number_variables)) {
+            row_indices.emplace_back(variable_index);
+            column_indices.emplace_back(variable_index);
+         }
+         for (const auto [i, j]: this->edges) {
+            row_indices.emplace_back(std::min(i, j));
+            column_indices.emplace_back(std::max(i, j));
+         }
+         return true;
+      }
+
+   protected:
+      const Edges edges;
+      const std::vector<size_t> empty_vector{};
+      const CollectionAdapter<std::vector<size_t>> empty_collection{this->empty_vector};
+      const SparseVector<size_t> slacks{};
+      const Vector<size_t> fixed_variables{};
+   };
+
+   Edges arrowhead_edges(size_t number_variables) {
+      Edges edges;
+      for (size_t variable_index: Range(1, number_variables)) {
+         edges.emplace_back(0, variable_index);
+      }
+      return edges;
+   }
+
+   Edges tridiagonal_edges(size_t number_variables) {
+      Edges edges;
+      for (size_t variable_index: Range(1, number_variables)) {
+         edges.emplace_back(variable_index - 1, variable_index);
+      }
+      return edges;
+   }
+
+   // dense diagonal blocks of size block_size
+   Edges dense_block_edges(size_t number_blocks, size_t block_size) {
+      Edges edges;
+      for (size_t block_index: Range(number_blocks)) {
+         const size_t offset = block_index * block_size;
+         for (size_t j: Range(block_size)) {
+            for (size_t i: Range(j)) {
+               edges.emplace_back(offset + i, offset + j);
+            }
+         }
+      }
+      return edges;
+   }
+
+   // a distance-1 coloring in which no path u - v - w - t on four vertices is bicolored
+   void check_star_coloring(const PatternModel& model, const std::vector<size_t>& colors) {
+      const size_t n = model.number_variables;
+      ASSERT_EQ(colors.size(), n);
+      for (size_t v: Range(n)) {
+         for (size_t w: Range(n)) {
+            if (!model.are_adjacent(v, w)) {
+               continue;
+            }
+            EXPECT_NE(colors[v], colors[w]) << "adjacent vertices " << v << " and " << w << " share a color";
+            for (size_t u: Range(n)) {
+               if (u == w || !model.are_adjacent(u, v)) {
+                  continue;
+               }
+               for (size_t t: Range(n)) {
+                  if (t == v || t == u || !model.are_adjacent(w, t)) {
+                     continue;
+                  }
+                  EXPECT_FALSE(colors[u] == colors[w] && colors[v] == colors[t]) << "bicolored path " << u << " - " << v << " - " <<
+                     w << " - " << t;
+               }
+            }
+         }
+      }
+   }
+
+   // the recovered nonzeros match the exact Hessian within the accuracy of the forward differences
+   void check_recovery(const PatternModel& model, const FiniteDifferenceHessianModel& finite_difference_model) {
+      const size_t n = model.number_variables;
+      Vector<double> x(n);
+      for (size_t variable_index: Range(n)) {
+         x[variable_index] = 0.5 + 0.25 * static_cast<double>(variable_index % 5);
+      }
+      const Vector<double> multipliers{};
+      SymmetricMatrix<size_t, double> hessian(n, finite_difference_model.number_hessian_nonzeros(), false, "COO");
+      finite_difference_model.evaluate_lagrangian_hessian(x, 1., multipliers, hessian);
+      const std::vector<std::vector<double>> exact_hessian = model.exact_hessian(x);
+      std::vector<std::vector<double>> recovered_hessian(n, std::vector<double>(n, 0.));
+      size_t number_entries = 0;
+      hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+         EXPECT_TRUE(row_index == column_index || model.are_adjacent(row_index, column_index)) << "structural zero (" << row_index << ", " <<
+            column_index << ")";
+         recovered_hessian[row_index][column_index] += element;
+         number_entries++;
+      });
+      EXPECT_EQ(number_entries, model.number_hessian_nonzeros());
+      for (size_t column_index: Range(n)) {
+         for (size_t row_index: Range(column_index + 1)) {
+            const double exact_entry = exact_hessian[row_index][column_index];
+            const double recovered_entry = recovered_hessian[row_index][column_index] + recovered_hessian[column_index][row_index] *
+               static_cast<double>(row_index != column_index);
+            EXPECT_NEAR(recovered_entry, exact_entry, 1e-5 * std::max(1., std::abs(exact_entry))) << "entry (" << row_index << ", " <<
+               column_index << ")";
+         }
+      }
+   }
+
+   void check_pattern(size_t number_variables, const Edges& edges, size_t expected_number_colors) {
+      auto model = std::make_unique<PatternModel>(number_variables, edges);
+      const PatternModel& pattern_model = *model;
+      const Options options = DefaultOptions::load();
+      const FiniteDifferenceHessianModel finite_difference_model(std::move(model), options);
+      EXPECT_EQ(finite_difference_model.number_colors(), expected_number_colors);
+      check_star_coloring(pattern_model, finite_difference_model.get_colors());
+      check_recovery(pattern_model, finite_difference_model);
+   }
+} // namespace
+
+// a star needs 2 colors: the hub and all the leaves
+TEST(FiniteDifferenceHessian, Arrowhead) {
+   check_pattern(10, arrowhead_edges(10), 2);
+}
+
+// a path needs 3 colors: a distance-1 coloring with 2 colors is bicolored along the path
+TEST(FiniteDifferenceHessian, Tridiagonal) {
+   check_pattern(12, tridiagonal_edges(12), 3);
+}
+
+// each dense block is a clique that needs its own colors, which the other blocks reuse
+TEST(FiniteDifferenceHessian, DenseBlocks) {
+   check_pattern(12, dense_block_edges(3, 4), 4);
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "model/FixedVariablesEliminationModel.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+namespace {
+   // the quadratic test model with x0 fixed to 1. Solution (1, 2.5)
+   class FixedVariableTestModel: public QuadraticTestModel {
+   public:
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return (variable_index == 0) ? 1. : 0.; }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return (variable_index == 0) ? 1. : 4.; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override {
+         return (variable_index == 0) ? EQUAL_BOUNDS : BOUNDED_BOTH_SIDES;
+      }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variable; }
+
+   private:
+      const Vector<size_t> fixed_variable{0};
+   };
+} // namespace
+
+TEST(FixedVariablesElimination, ReducedModel) {
+   const FixedVariablesEliminationModel model(std::make_unique<FixedVariableTestModel>());
+   ASSERT_EQ(model.number_variables, 1);
+   ASSERT_EQ(model.original_index(0), 1);
+   ASSERT_EQ(model.variable_upper_bound(0), 4.);
+   ASSERT_TRUE(model.get_fixed_variables().empty());
+   ASSERT_EQ(model.get_lower_bounded_variables().size(), 1);
+
+   // the fixed variable is substituted: f(1, 2) = 1 + 16 - 64
+   const Vector<double> x{2.};
+   ASSERT_EQ(model.evaluate_objective(x), -47.);
+   std::vector<double> constraints(2);
+   model.evaluate_constraints(x, constraints);
+   ASSERT_EQ(constraints[1], 3.);
+   RectangularMatrix<double> jacobian(2, 1);
+   model.evaluate_constraint_jacobian(x, jacobian);
+   ASSERT_EQ(jacobian.number_nonzeros(), 2);
+   ASSERT_EQ(jacobian.data_pointer()[jacobian.row_start(1)], 2.);
+   SymmetricMatrix<size_t, double> hessian(1, 2, false, "COO");
+   model.evaluate_lagrangian_hessian(x, 1., Vector<double>{0., 0.}, hessian);
+   ASSERT_EQ(hessian.number_nonzeros(), 1);
+   hessian.for_each([](size_t row_index, size_t column_index, double entry) {
+      ASSERT_EQ(row_index, 0);
+      ASSERT_EQ(column_index, 0);
+      ASSERT_EQ(entry, 8.);
+   });
+}
+
+TEST(FixedVariablesElimination, SolutionIsReinserted) {
+   const FixedVariablesEliminationModel model(std::make_unique<FixedVariableTestModel>());
+   const Result result = solve_model(model, test_options("filtersqp"));
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_EQ(result.solution.number_variables, 2);
+   ASSERT_EQ(result.solution.primals[0], 1.);
+   ASSERT_NEAR(result.solution.primals[1], 2.5, 1e-6);
+   // stationarity with respect to x0: 2 x0 + lambda_1 = z0
+   ASSERT_NEAR(result.solution.multipliers.constraints[1], -6., 1e-6);
+   ASSERT_NEAR(result.solution.multipliers.lower_bounds[0], 0., 1e-6);
+   ASSERT_NEAR(result.solution.multipliers.upper_bounds[0], -4., 1e-6);
+}
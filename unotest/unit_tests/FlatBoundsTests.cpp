@@ -0,0 +1,53 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "ingredients/inequality_handling_methods/interior_point_methods/FlatBounds.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "symbolic/Concatenation.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+using Adapter = CollectionAdapter<const std::vector<size_t>&>;
+
+// variables 0 and 2 are lower bounded, 1 and 2 are upper bounded
+struct BoundedProblem {
+   const size_t number_variables{3};
+   const std::vector<double> lower_bounds{-1., -INF<double>, 2.};
+   const std::vector<double> upper_bounds{INF<double>, 5., 7.};
+   const std::vector<size_t> lower_bounded_original{0};
+   const std::vector<size_t> lower_bounded_slacks{2};
+   const std::vector<size_t> upper_bounded{1, 2};
+   const std::vector<size_t> single_lower_bounded{0};
+   const std::vector<size_t> single_upper_bounded{1};
+   const Adapter original_collection{lower_bounded_original};
+   const Adapter slacks_collection{lower_bounded_slacks};
+   const Concatenation<const Adapter&, const Adapter&> lower_bounded{concatenate(original_collection, slacks_collection)};
+   const Adapter upper_bounded_collection{upper_bounded};
+   const Adapter single_lower_bounded_collection{single_lower_bounded};
+   const Adapter single_upper_bounded_collection{single_upper_bounded};
+
+   [[nodiscard]] double variable_lower_bound(size_t variable_index) const { return this->lower_bounds[variable_index]; }
+   [[nodiscard]] double variable_upper_bound(size_t variable_index) const { return this->upper_bounds[variable_index]; }
+   [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const { return this->lower_bounded; }
+   [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const { return this->upper_bounded_collection; }
+   [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const { return this->single_lower_bounded_collection; }
+   [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const { return this->single_upper_bounded_collection; }
+};
+
+TEST(FlatBounds, Flattening) {
+   const BoundedProblem problem{};
+   FlatBounds bounds{};
+   bounds.update(problem);
+   // the concatenation is flattened
+   ASSERT_EQ(bounds.lower.variables, (std::vector<size_t>{0, 2}));
+   ASSERT_EQ(bounds.lower.bounds[0], -1.);
+   ASSERT_EQ(bounds.lower.bounds[1], 2.);
+   ASSERT_EQ(bounds.upper.variables, (std::vector<size_t>{1, 2}));
+   ASSERT_EQ(bounds.upper.bounds[0], 5.);
+   ASSERT_EQ(bounds.upper.bounds[1], 7.);
+   ASSERT_EQ(bounds.single_lower.size(), 1);
+   ASSERT_EQ(bounds.single_upper.bounds[0], 5.);
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/subproblem_solvers/FortranIndices.hpp"
+
+using namespace uno;
+
+TEST(FortranIndices, BorrowedFromShiftedIntCOO) {
+   SymmetricMatrix<int, double> matrix(3, 3, false, "COO", 1);
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 2, 2);
+   FortranIndices<int> indices;
+   indices.save(matrix);
+   ASSERT_TRUE(indices.is_borrowed());
+   const auto* storage = matrix.get_storage_if<COOSparseStorage<int, double>>();
+   ASSERT_EQ(indices.row_indices(), storage->row_indices_pointer());
+   ASSERT_EQ(indices.column_indices(), storage->column_indices_pointer());
+   ASSERT_EQ(indices.row_indices()[2], 3);
+   ASSERT_EQ(indices.column_indices()[1], 2);
+}
+
+TEST(FortranIndices, CopiedFromSizeT) {
+   SymmetricMatrix<size_t, double> matrix(3, 3, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 2, 2);
+   FortranIndices<size_t> indices;
+   indices.save(matrix);
+   ASSERT_FALSE(indices.is_borrowed());
+   const std::array<int, 3> row_indices{1, 1, 3};
+   const std::array<int, 3> column_indices{1, 2, 3};
+   for (size_t index: Range(3)) {
+      ASSERT_EQ(indices.row_indices()[index], row_indices[index]);
+      ASSERT_EQ(indices.column_indices()[index], column_indices[index]);
+   }
+}
+
+TEST(FortranIndices, CopiedFromUnshiftedIntCOO) {
+   SymmetricMatrix<int, double> matrix(2, 2, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   FortranIndices<int> indices;
+   indices.save(matrix);
+   ASSERT_FALSE(indices.is_borrowed());
+   ASSERT_EQ(indices.row_indices()[1], 1);
+   ASSERT_EQ(indices.column_indices()[1], 2);
+}
+
+TEST(FortranIndices, CopiedFromShiftedIntCSC) {
+   SymmetricMatrix<int, double> matrix(2, 2, false, "CSC", 1);
+   matrix.insert(2., 0, 0);
+   matrix.finalize_column(0);
+   matrix.insert(3., 0, 1);
+   matrix.finalize_column(1);
+   FortranIndices<int> indices;
+   indices.save(matrix);
+   ASSERT_FALSE(indices.is_borrowed());
+   ASSERT_EQ(indices.row_indices()[1], 1);
+   ASSERT_EQ(indices.column_indices()[1], 2);
+}
+
+TEST(FortranIndices, PointersUpdatedAfterReallocation) {
+   SymmetricMatrix<int, double> matrix(3, 1, false, "COO", 1);
+   matrix.insert(2., 0, 0);
+   FortranIndices<int> indices;
+   indices.save(matrix);
+   // exceed the capacity of the matrix
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 2, 2);
+   indices.update_pointers(matrix);
+   const auto* storage = matrix.get_storage_if<COOSparseStorage<int, double>>();
+   ASSERT_EQ(indices.row_indices(), storage->row_indices_pointer());
+   ASSERT_EQ(indices.row_indices()[2], 3);
+}
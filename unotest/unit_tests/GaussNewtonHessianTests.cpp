@@ -0,0 +1,70 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/constraint_relaxation_strategies/l1RelaxedProblem.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "QuadraticTestModel.hpp"
+
+using namespace uno;
+
+// J = [1 1; -1 2], therefore J^T J = [2 -1; -1 5]
+TEST(GaussNewtonHessian, JacobianTransposeJacobian) {
+   const QuadraticTestModel model;
+   const l1RelaxedProblem problem(model, 0., 1., 0., nullptr, true);
+   ASSERT_EQ(problem.number_hessian_nonzeros(), 3);
+   for (const char* sparse_format: {"COO", "CSC"}) {
+      SymmetricMatrix<size_t, double> hessian(problem.number_variables, problem.number_hessian_nonzeros(), false, sparse_format);
+      const Vector<double> x(problem.number_variables, 1.);
+      const Vector<double> multipliers(problem.number_constraints, 1.);
+      problem.evaluate_lagrangian_hessian(x, multipliers, hessian);
+      ASSERT_EQ(hessian.number_nonzeros(), 3);
+      Vector<double> dense_hessian(4, 0.);
+      hessian.for_each([&](size_t row_index, size_t column_index, double entry) {
+         ASSERT_LE(row_index, column_index);
+         dense_hessian[2*row_index + column_index] += entry;
+      });
+      ASSERT_EQ(dense_hessian[0], 2.);
+      ASSERT_EQ(dense_hessian[1], -1.);
+      ASSERT_EQ(dense_hessian[3], 5.);
+   }
+}
+
+TEST(GaussNewtonHessian, HessianVectorProduct) {
+   const QuadraticTestModel model;
+   const l1RelaxedProblem problem(model, 0., 2., 0., nullptr, true);
+   const Vector<double> x(problem.number_variables, 1.);
+   const Vector<double> multipliers(problem.number_constraints, 1.);
+   Vector<double> vector(problem.number_variables, 1.);
+   vector[1] = -1.;
+   Vector<double> result(problem.number_variables);
+   problem.evaluate_lagrangian_hessian_vector_product(x, multipliers, vector, result);
+   // 2 J^T J (1, -1) = (6, -12). The elastics do not enter the Hessian
+   ASSERT_EQ(result[0], 6.);
+   ASSERT_EQ(result[1], -12.);
+   for (size_t elastic_index: Range(model.number_variables, problem.number_variables)) {
+      ASSERT_EQ(result[elastic_index], 0.);
+   }
+}
+
+TEST(GaussNewtonHessian, ExactHessianWithObjective) {
+   // the Gauss-Newton model is only used when the objective multiplier is 0
+   const QuadraticTestModel model;
+   const l1RelaxedProblem problem(model, 1., 1., 0., nullptr, true);
+   ASSERT_EQ(problem.number_hessian_nonzeros(), model.number_hessian_nonzeros());
+}
+
+TEST(GaussNewtonHessian, InvalidRestorationHessianModel) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(Presets::get_preset_options("filtersqp"));
+   options["restoration_hessian_model"] = "quasi_newton";
+   const QuadraticTestModel model;
+   ASSERT_THROW(ConstraintRelaxationStrategyFactory::create(model, options), std::invalid_argument);
+}
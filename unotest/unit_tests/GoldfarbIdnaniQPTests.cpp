@@ -0,0 +1,124 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <array>
+#include "ingredients/subproblem_solvers/GoldfarbIdnaniQP.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-8;
+
+// https://doc.cgal.org/latest/QP_solver/index.html#title4
+// Min    f  =  1/2 * (2 x_0^2 + 8 x_1^2) - 32 x_1
+// s.t.         x_0 + x_1 <= 7
+//             -x_0 + 2x_1 <= 4
+// 0 <= x_0; 0 <= x_1 <= 4
+static void set_up_QP(GoldfarbIdnaniQP<double>& qp_solver) {
+   qp_solver.reset(2, 5);
+   qp_solver.hessian(0, 0) = 2.;
+   qp_solver.hessian(1, 1) = 8.;
+   qp_solver.gradient(1) = -32.;
+   // -x_0 - x_1 >= -7
+   qp_solver.constraint(0, 0) = -1.;
+   qp_solver.constraint(1, 0) = -1.;
+   qp_solver.set_constraint(0, DenseConstraintType::INEQUALITY, -7.);
+   // x_0 - 2x_1 >= -4
+   qp_solver.constraint(0, 1) = 1.;
+   qp_solver.constraint(1, 1) = -2.;
+   qp_solver.set_constraint(1, DenseConstraintType::INEQUALITY, -4.);
+   // bounds
+   qp_solver.constraint(0, 2) = 1.;
+   qp_solver.set_constraint(2, DenseConstraintType::INEQUALITY, 0.);
+   qp_solver.constraint(1, 3) = 1.;
+   qp_solver.set_constraint(3, DenseConstraintType::INEQUALITY, 0.);
+   qp_solver.constraint(1, 4) = -1.;
+   qp_solver.set_constraint(4, DenseConstraintType::INEQUALITY, -4.);
+}
+
+TEST(GoldfarbIdnaniQP, InequalityConstrained) {
+   GoldfarbIdnaniQP<double> qp_solver(2, 5, 1e-10);
+   set_up_QP(qp_solver);
+   ASSERT_TRUE(qp_solver.factorize(0.));
+   ASSERT_EQ(qp_solver.solve(false), SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(qp_solver.solution()[0], 2., tolerance);
+   EXPECT_NEAR(qp_solver.solution()[1], 3., tolerance);
+   // only the second constraint is active
+   const std::array<double, 5> multipliers_reference{0., 4., 0., 0., 0.};
+   for (size_t constraint_index: Range(5)) {
+      EXPECT_NEAR(qp_solver.multiplier(constraint_index), multipliers_reference[constraint_index], tolerance);
+   }
+}
+
+TEST(GoldfarbIdnaniQP, EqualityConstrained) {
+   // min 1/2 (x_0^2 + x_1^2 + x_2^2)  s.t.  x_0 + x_1 + x_2 = 3, x_0 >= 2
+   GoldfarbIdnaniQP<double> qp_solver(3, 2, 1e-10);
+   qp_solver.reset(3, 2);
+   for (size_t variable_index: Range(3)) {
+      qp_solver.hessian(variable_index, variable_index) = 1.;
+      qp_solver.constraint(variable_index, 0) = 1.;
+   }
+   qp_solver.set_constraint(0, DenseConstraintType::EQUALITY, 3.);
+   qp_solver.constraint(0, 1) = 1.;
+   qp_solver.set_constraint(1, DenseConstraintType::INEQUALITY, 2.);
+   ASSERT_TRUE(qp_solver.factorize(0.));
+   ASSERT_EQ(qp_solver.solve(false), SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(qp_solver.solution()[0], 2., tolerance);
+   EXPECT_NEAR(qp_solver.solution()[1], 0.5, tolerance);
+   EXPECT_NEAR(qp_solver.solution()[2], 0.5, tolerance);
+   EXPECT_NEAR(qp_solver.multiplier(0), 0.5, tolerance);
+   EXPECT_NEAR(qp_solver.multiplier(1), 1.5, tolerance);
+}
+
+TEST(GoldfarbIdnaniQP, Infeasible) {
+   // x_0 >= 1 and -x_0 >= 0
+   GoldfarbIdnaniQP<double> qp_solver(1, 2, 1e-10);
+   qp_solver.reset(1, 2);
+   qp_solver.hessian(0, 0) = 1.;
+   qp_solver.constraint(0, 0) = 1.;
+   qp_solver.set_constraint(0, DenseConstraintType::INEQUALITY, 1.);
+   qp_solver.constraint(0, 1) = -1.;
+   qp_solver.set_constraint(1, DenseConstraintType::INEQUALITY, 0.);
+   ASSERT_TRUE(qp_solver.factorize(0.));
+   ASSERT_EQ(qp_solver.solve(false), SubproblemStatus::INFEASIBLE);
+}
+
+TEST(GoldfarbIdnaniQP, NotPositiveDefinite) {
+   GoldfarbIdnaniQP<double> qp_solver(2, 0, 1e-10);
+   qp_solver.reset(2, 0);
+   qp_solver.hessian(0, 0) = 1.;
+   qp_solver.hessian(1, 0) = 2.;
+   qp_solver.hessian(1, 1) = 1.;
+   ASSERT_FALSE(qp_solver.factorize(0.));
+   ASSERT_TRUE(qp_solver.factorize(2.));
+}
+
+TEST(GoldfarbIdnaniQP, Warmstart) {
+   // min 1/2 ||x - (1, 1)||^2  s.t.  10 x_0 + x_1 <= 1.5, x_0 <= 0
+   // the most violated constraint at the unconstrained minimizer is not active at the solution (0, 1)
+   GoldfarbIdnaniQP<double> qp_solver(2, 2, 1e-10);
+   qp_solver.reset(2, 2);
+   qp_solver.hessian(0, 0) = 1.;
+   qp_solver.hessian(1, 1) = 1.;
+   qp_solver.gradient(0) = -1.;
+   qp_solver.gradient(1) = -1.;
+   qp_solver.constraint(0, 0) = -10.;
+   qp_solver.constraint(1, 0) = -1.;
+   qp_solver.set_constraint(0, DenseConstraintType::INEQUALITY, -1.5);
+   qp_solver.constraint(0, 1) = -1.;
+   qp_solver.set_constraint(1, DenseConstraintType::INEQUALITY, 0.);
+   ASSERT_TRUE(qp_solver.factorize(0.));
+   ASSERT_EQ(qp_solver.solve(false), SubproblemStatus::OPTIMAL);
+   const size_t number_cold_iterations = qp_solver.get_number_iterations();
+   EXPECT_NEAR(qp_solver.solution()[0], 0., tolerance);
+   EXPECT_NEAR(qp_solver.solution()[1], 1., tolerance);
+   EXPECT_FALSE(qp_solver.is_active(0));
+   EXPECT_TRUE(qp_solver.is_active(1));
+
+   // same QP, warm started from the previous active set: the active constraint is added first
+   ASSERT_EQ(qp_solver.solve(true), SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(qp_solver.solution()[0], 0., tolerance);
+   EXPECT_NEAR(qp_solver.solution()[1], 1., tolerance);
+   EXPECT_NEAR(qp_solver.multiplier(1), 1., tolerance);
+   EXPECT_LT(qp_solver.get_number_iterations(), number_cold_iterations);
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "ingredients/constraint_relaxation_strategies/OptimalityProblem.hpp"
+#include "ingredients/hessian_models/HessianModel.hpp"
+#include "ingredients/hessian_models/HessianModelFactory.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/Statistics.hpp"
+#include "QuadraticTestModel.hpp"
+
+using namespace uno;
+
+static double first_diagonal_entry(const SymmetricMatrix<size_t, double>& hessian) {
+   double entry = 0.;
+   hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+      if (row_index == 0 && column_index == 0) {
+         entry += element;
+      }
+   });
+   return entry;
+}
+
+// the functions changed in place: the evaluation at the same primal-dual point is carried out once the last one is forgotten
+TEST(HessianModel, ForgetEvaluation) {
+   const Options options = DefaultOptions::load();
+   QuadraticTestModel model;
+   const OptimalityProblem problem(model);
+   const std::unique_ptr<HessianModel> hessian_model = HessianModelFactory::create("exact", 2, 2, false, options);
+   Statistics statistics(options);
+   SymmetricMatrix<size_t, double> hessian(2, 2, false, "COO");
+   const Vector<double> x(2, 1.);
+   const Vector<double> multipliers(2, 0.);
+   hessian_model->evaluate(statistics, problem, x, multipliers, hessian);
+   ASSERT_EQ(first_diagonal_entry(hessian), 2.);
+
+   model.set_objective_coefficient(10.);
+   hessian_model->evaluate(statistics, problem, x, multipliers, hessian);
+   ASSERT_EQ(hessian_model->evaluation_count, 1);
+   hessian_model->forget_evaluation();
+   hessian_model->evaluate(statistics, problem, x, multipliers, hessian);
+   ASSERT_EQ(hessian_model->evaluation_count, 2);
+   ASSERT_EQ(first_diagonal_entry(hessian), 20.);
+}
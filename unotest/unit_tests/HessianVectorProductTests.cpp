@@ -0,0 +1,303 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "ingredients/constraint_relaxation_strategies/OptimalityProblem.hpp"
+#include "ingredients/constraint_relaxation_strategies/l1RelaxedProblem.hpp"
+#include "ingredients/inequality_handling_methods/interior_point_methods/PrimalDualInteriorPointProblem.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/FixedBoundsConstraintsModel.hpp"
+#include "model/HomogeneousEqualityConstrainedModel.hpp"
+#include "model/Model.hpp"
+#include "model/ScaledModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Multipliers.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+namespace {
+   // min x0^2 x1 + x1 x2^2 + x0^4/4 s.t. x0 x1 + x2 <= 2, x0^2 + x1^2 + x2^2 = 4, x0 >= -1, x1 <= 3, x2 = 0.5.
+   // The Hessian-vector product is computed analytically, independently of the Hessian matrix
+   class HessianProductTestModel: public Model {
+   public:
+      HessianProductTestModel(): Model("Hessian product test model", 3, 2, 1.) { }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+         return x[0] * x[0] * x[1] + x[1] * x[2] * x[2] + x[0] * x[0] * x[0] * x[0] / 4.;
+      }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         gradient.insert(0, 2. * x[0] * x[1] + x[0] * x[0] * x[0]);
+         gradient.insert(1, x[0] * x[0] + x[2] * x[2]);
+         gradient.insert(2, 2. * x[1] * x[2]);
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         constraints[0] = x[0] * x[1] + x[2];
+         constraints[1] = x[0] * x[0] + x[1] * x[1] + x[2] * x[2];
+      }
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t constraint_index, SparseVector<double>& gradient) const override {
+         if (constraint_index == 0) {
+            gradient.insert(0, x[1]);
+            gradient.insert(1, x[0]);
+            gradient.insert(2, 1.);
+         }
+         else {
+            gradient.insert(0, 2. * x[0]);
+            gradient.insert(1, 2. * x[1]);
+            gradient.insert(2, 2. * x[2]);
+         }
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+         constraint_jacobian[0].insert(0, x[1]);
+         constraint_jacobian[0].insert(1, x[0]);
+         constraint_jacobian[0].insert(2, 1.);
+         constraint_jacobian[1].insert(0, 2. * x[0]);
+         constraint_jacobian[1].insert(1, 2. * x[1]);
+         constraint_jacobian[1].insert(2, 2. * x[2]);
+      }
+      // upper triangle, column by column
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         hessian.reset();
+         hessian.insert(objective_multiplier * (2. * x[1] + 3. * x[0] * x[0]) - 2. * multipliers[1], 0, 0);
+         hessian.finalize_column(0);
+         hessian.insert(objective_multiplier * 2. * x[0] - multipliers[0], 0, 1);
+         hessian.insert(-2. * multipliers[1], 1, 1);
+         hessian.finalize_column(1);
+         hessian.insert(objective_multiplier * 2. * x[2], 1, 2);
+         hessian.insert(objective_multiplier * 2. * x[1] - 2. * multipliers[1], 2, 2);
+         hessian.finalize_column(2);
+      }
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override {
+         // sigma H_f v
+         result[0] = objective_multiplier * ((2. * x[1] + 3. * x[0] * x[0]) * vector[0] + 2. * x[0] * vector[1]);
+         result[1] = objective_multiplier * (2. * x[0] * vector[0] + 2. * x[2] * vector[2]);
+         result[2] = objective_multiplier * (2. * x[2] * vector[1] + 2. * x[1] * vector[2]);
+         // - lambda_0 H_c0 v - lambda_1 H_c1 v
+         result[0] -= multipliers[0] * vector[1] + 2. * multipliers[1] * vector[0];
+         result[1] -= multipliers[0] * vector[0] + 2. * multipliers[1] * vector[1];
+         result[2] -= 2. * multipliers[1] * vector[2];
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override {
+         return (variable_index == 0) ? -1. : (variable_index == 1) ? -INF<double> : 0.5;
+      }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override {
+         return (variable_index == 0) ? INF<double> : (variable_index == 1) ? 3. : 0.5;
+      }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override {
+         return (variable_index == 0) ? BOUNDED_LOWER : (variable_index == 1) ? BOUNDED_UPPER : EQUAL_BOUNDS;
+      }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->lower_bounded_variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override {
+         return this->single_lower_bounded_variables_collection;
+      }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+         return this->single_upper_bounded_variables_collection;
+      }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override { return (constraint_index == 0) ? -INF<double> : 4.; }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override { return (constraint_index == 0) ? 2. : 4.; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return NONLINEAR; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return NONLINEAR; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override {
+         return (constraint_index == 0) ? BOUNDED_UPPER : EQUAL_BOUNDS;
+      }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->equality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->inequality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->empty_collection; }
+
+      // the objective gradient and the gradient of the equality constraint exceed the scaling threshold at the initial point
+      void initial_primal_point(Vector<double>& x) const override {
+         x[0] = 60.;
+         x[1] = 1.;
+         x[2] = 0.5;
+      }
+      void initial_dual_point(Vector<double>& multipliers) const override { multipliers.fill(0.); }
+      void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+      [[nodiscard]] bool get_user_variable_scaling(Vector<double>& scaling_factors) const override {
+         scaling_factors[0] = 0.5;
+         scaling_factors[1] = 2.;
+         scaling_factors[2] = 1.;
+         return true;
+      }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 3; }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 6; }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return 5; }
+
+   protected:
+      const std::vector<size_t> lower_bounded_variables{0, 2};
+      const std::vector<size_t> upper_bounded_variables{1, 2};
+      const std::vector<size_t> single_lower_bounded_variables{0};
+      const std::vector<size_t> single_upper_bounded_variables{1};
+      const std::vector<size_t> equality_constraints{1};
+      const std::vector<size_t> inequality_constraints{0};
+      const std::vector<size_t> no_indices{};
+      const CollectionAdapter<std::vector<size_t>> lower_bounded_variables_collection{this->lower_bounded_variables};
+      const CollectionAdapter<std::vector<size_t>> upper_bounded_variables_collection{this->upper_bounded_variables};
+      const CollectionAdapter<std::vector<size_t>> single_lower_bounded_variables_collection{this->single_lower_bounded_variables};
+      const CollectionAdapter<std::vector<size_t>> single_upper_bounded_variables_collection{this->single_upper_bounded_variables};
+      const CollectionAdapter<std::vector<size_t>> equality_constraints_collection{this->equality_constraints};
+      const CollectionAdapter<std::vector<size_t>> inequality_constraints_collection{this->inequality_constraints};
+      const CollectionAdapter<std::vector<size_t>> empty_collection{this->no_indices};
+      const SparseVector<size_t> slacks{};
+      const Vector<size_t> fixed_variables{2};
+   };
+
+   // the components are distinct and nonzero
+   Vector<double> test_vector(size_t size, double offset) {
+      Vector<double> vector(size);
+      for (size_t index: Range(size)) {
+         vector[index] = offset + 0.5 * static_cast<double>(index) * ((index % 2 == 0) ? 1. : -1.);
+      }
+      return vector;
+   }
+
+   // H v with the explicit (upper triangular) Hessian
+   Vector<double> explicit_product(const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& vector) {
+      Vector<double> result(vector.size(), 0.);
+      hessian.for_each([&](size_t row_index, size_t column_index, double entry) {
+         result[row_index] += entry * vector[column_index];
+         if (row_index != column_index) {
+            result[column_index] += entry * vector[row_index];
+         }
+      });
+      return result;
+   }
+
+   // the product overwrites all the components of the result
+   void expect_consistent_product(const Model& model, double objective_multiplier) {
+      const Vector<double> x = test_vector(model.number_variables, 1.);
+      const Vector<double> multipliers = test_vector(model.number_constraints, -0.7);
+      const Vector<double> vector = test_vector(model.number_variables, 0.3);
+      SymmetricMatrix<size_t, double> hessian(model.number_variables, model.number_hessian_nonzeros(), false, "COO");
+      model.evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+      const Vector<double> reference = explicit_product(hessian, vector);
+      Vector<double> result(model.number_variables, 1e10);
+      model.evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+      for (size_t variable_index: Range(model.number_variables)) {
+         EXPECT_NEAR(result[variable_index], reference[variable_index], 1e-10 * std::max(1., std::abs(reference[variable_index])))
+            << model.name << ", component " << variable_index;
+      }
+   }
+
+   void expect_consistent_product(const OptimizationProblem& problem, const Vector<double>& x) {
+      const Vector<double> multipliers = test_vector(problem.number_constraints, -0.7);
+      const Vector<double> vector = test_vector(problem.number_variables, 0.3);
+      SymmetricMatrix<size_t, double> hessian(problem.number_variables, problem.number_hessian_nonzeros(), false, "COO");
+      problem.evaluate_lagrangian_hessian(x, multipliers, hessian);
+      const Vector<double> reference = explicit_product(hessian, vector);
+      Vector<double> result(problem.number_variables, 1e10);
+      problem.evaluate_lagrangian_hessian_vector_product(x, multipliers, vector, result);
+      for (size_t variable_index: Range(problem.number_variables)) {
+         EXPECT_NEAR(result[variable_index], reference[variable_index], 1e-10 * std::max(1., std::abs(reference[variable_index])))
+            << "component " << variable_index;
+      }
+   }
+
+   Options scaling_options() {
+      Options options = DefaultOptions::load();
+      options["scale_functions"] = "yes";
+      options["scale_variables"] = "user";
+      return options;
+   }
+} // namespace
+
+TEST(HessianVectorProduct, Model) {
+   const HessianProductTestModel model;
+   for (const double objective_multiplier: {1., 0., 2.5}) {
+      expect_consistent_product(model, objective_multiplier);
+   }
+}
+
+// the objective, the equality constraint and the variables are scaled
+TEST(HessianVectorProduct, ScaledModel) {
+   const ScaledModel model(std::make_unique<HessianProductTestModel>(), scaling_options());
+   ASSERT_NE(model.get_variable_scaling(0), 1.);
+   for (const double objective_multiplier: {1., 0.}) {
+      expect_consistent_product(model, objective_multiplier);
+   }
+}
+
+// the slack of the inequality constraint does not enter the Hessian
+TEST(HessianVectorProduct, HomogeneousEqualityConstrainedModel) {
+   const HomogeneousEqualityConstrainedModel model(std::make_unique<HessianProductTestModel>());
+   ASSERT_EQ(model.number_variables, 4);
+   expect_consistent_product(model, 1.);
+}
+
+// the bound of the fixed variable becomes a linear constraint, whose multiplier does not enter the Hessian
+TEST(HessianVectorProduct, FixedBoundsConstraintsModel) {
+   const FixedBoundsConstraintsModel model(std::make_unique<HessianProductTestModel>(), DefaultOptions::load());
+   ASSERT_EQ(model.number_constraints, 3);
+   expect_consistent_product(model, 1.);
+}
+
+// stack of the interior point method: scaling, fixed bounds as constraints and slacks
+TEST(HessianVectorProduct, ReformulatedModel) {
+   const Options options = scaling_options();
+   auto model = std::make_unique<HomogeneousEqualityConstrainedModel>(std::make_unique<FixedBoundsConstraintsModel>(
+      std::make_unique<ScaledModel>(std::make_unique<HessianProductTestModel>(), options), options));
+   expect_consistent_product(*model, 1.);
+}
+
+// objective multiplier, proximal term and elastics of the l1 relaxation
+TEST(HessianVectorProduct, l1RelaxedProblem) {
+   const HomogeneousEqualityConstrainedModel model(std::make_unique<HessianProductTestModel>());
+   const std::vector<double> proximal_center{0.1, 4., -2., 1.};
+   for (const double objective_multiplier: {1., 0.}) {
+      const l1RelaxedProblem problem(model, objective_multiplier, 2., 0.5, proximal_center.data());
+      ASSERT_LT(model.number_variables, problem.number_variables);
+      expect_consistent_product(problem, test_vector(problem.number_variables, 1.));
+   }
+}
+
+// the barrier diagonal Z/(x - l) + U/(x - u) of the bounded variables (the slack and the bounds of the original model)
+TEST(HessianVectorProduct, PrimalDualInteriorPointProblem) {
+   const Options options = scaling_options();
+   const HomogeneousEqualityConstrainedModel model(std::make_unique<FixedBoundsConstraintsModel>(
+      std::make_unique<ScaledModel>(std::make_unique<HessianProductTestModel>(), options), options));
+   const OptimalityProblem problem(model);
+   Multipliers current_multipliers(model.number_variables, model.number_constraints);
+   for (size_t variable_index: problem.get_lower_bounded_variables()) {
+      current_multipliers.lower_bounds[variable_index] = 0.5 + static_cast<double>(variable_index);
+   }
+   for (size_t variable_index: problem.get_upper_bounded_variables()) {
+      current_multipliers.upper_bounds[variable_index] = -2. - static_cast<double>(variable_index);
+   }
+   const PrimalDualInteriorPointProblem barrier_problem(problem, current_multipliers, 0.1);
+   // strictly inside the bounds
+   Vector<double> x(model.number_variables);
+   for (size_t variable_index: Range(model.number_variables)) {
+      const double lower_bound = model.variable_lower_bound(variable_index);
+      const double upper_bound = model.variable_upper_bound(variable_index);
+      x[variable_index] = is_finite(lower_bound) ? (is_finite(upper_bound) ? (lower_bound + upper_bound) / 2. : lower_bound + 0.25) :
+         (is_finite(upper_bound) ? upper_bound - 0.75 : 1.);
+   }
+   expect_consistent_product(barrier_problem, x);
+
+   // the barrier diagonal is added to the product of the original problem
+   const Vector<double> vector = test_vector(model.number_variables, 0.3);
+   const Vector<double> multipliers = test_vector(model.number_constraints, -0.7);
+   Vector<double> product(model.number_variables), barrier_product(model.number_variables);
+   problem.evaluate_lagrangian_hessian_vector_product(x, multipliers, vector, product);
+   barrier_problem.evaluate_lagrangian_hessian_vector_product(x, multipliers, vector, barrier_product);
+   for (size_t variable_index: Range(model.number_variables)) {
+      const bool is_bounded = is_finite(model.variable_lower_bound(variable_index)) || is_finite(model.variable_upper_bound(variable_index));
+      EXPECT_EQ(barrier_product[variable_index] != product[variable_index], is_bounded) << "component " << variable_index;
+   }
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+#include "symbolic/CollectionAdapter.hpp"
+#include "symbolic/Concatenation.hpp"
+#include "symbolic/IndexSet.hpp"
+#include "symbolic/Range.hpp"
+
+using namespace uno;
+
+static std::vector<std::pair<size_t, size_t>> runs(const Collection<size_t>& collection) {
+   std::vector<std::pair<size_t, size_t>> result;
+   collection.for_each_run([&](size_t first, size_t last) {
+      result.emplace_back(first, last);
+   });
+   return result;
+}
+
+TEST(IndexSet, ConsecutiveIndicesAreMerged) {
+   IndexSet indices;
+   for (size_t index: {2, 3, 4, 8, 9}) {
+      indices.insert(index);
+   }
+   indices.insert(10, 13);
+   indices.insert(5);
+   ASSERT_EQ(indices.size(), 9);
+   ASSERT_EQ(indices.number_runs(), 3);
+   const std::vector<std::pair<size_t, size_t>> reference_runs{{2, 5}, {8, 13}, {5, 6}};
+   ASSERT_EQ(runs(indices), reference_runs);
+}
+
+TEST(IndexSet, IterationOrder) {
+   IndexSet indices;
+   indices.insert(7, 10);
+   indices.insert(1);
+   indices.insert(4, 6);
+   const std::vector<size_t> reference_indices{7, 8, 9, 1, 4, 5};
+   std::vector<size_t> iterated_indices, visited_indices;
+   for (const size_t index: indices) {
+      iterated_indices.emplace_back(index);
+   }
+   indices.for_each([&](size_t index) {
+      visited_indices.emplace_back(index);
+   });
+   ASSERT_EQ(iterated_indices, reference_indices);
+   ASSERT_EQ(visited_indices, reference_indices);
+}
+
+TEST(IndexSet, CompressedCopyOfCollection) {
+   const std::vector<size_t> slacks{10, 11, 12, 14};
+   const auto collection = concatenate(Range(0, 4), CollectionAdapter(slacks));
+   const IndexSet indices(collection);
+   const std::vector<std::pair<size_t, size_t>> reference_runs{{0, 4}, {10, 13}, {14, 15}};
+   ASSERT_EQ(runs(indices), reference_runs);
+   ASSERT_EQ(indices.size(), collection.size());
+}
+
+TEST(IndexSet, RangeIsSingleRun) {
+   const std::vector<std::pair<size_t, size_t>> reference_runs{{3, 8}};
+   ASSERT_EQ(runs(Range(3, 8)), reference_runs);
+   ASSERT_TRUE(runs(Range(0)).empty());
+   // the elements of a backward range are decreasing
+   const std::vector<std::pair<size_t, size_t>> backward_runs{{5, 6}, {4, 5}, {3, 4}};
+   ASSERT_EQ(runs(BackwardRange(5, 2)), backward_runs);
+}
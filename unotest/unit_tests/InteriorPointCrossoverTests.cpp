@@ -0,0 +1,42 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+static Options crossover_options() {
+   Options options = test_options("ipopt");
+   options["subproblem"] = "interior_point_crossover";
+   options["linear_solver"] = "dense";
+   options["crossover_stable_active_set_iterations"] = "1";
+   return options;
+}
+
+// the second solve with the same solver starts with the interior-point phase, like the first one
+TEST(InteriorPointCrossover, ResolveStartsWithInteriorPointPhase) {
+   const Options options = crossover_options();
+   const std::unique_ptr<Model> model = ModelFactory::reformulate(std::make_unique<QuadraticTestModel>(), options);
+   TestSolver solver(*model, options);
+   const Result first_result = solver.solve();
+   ASSERT_EQ(first_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(first_result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(first_result.solution.primals[1], 3., 1e-6);
+   // the interior-point phase factorizes the primal-dual system
+   ASSERT_GT(first_result.factorization_statistics.number_factorizations, 0);
+
+   Iterate initial_iterate = solver.initial_iterate();
+   const Result second_result = solver.uno.resolve(*model, initial_iterate, options);
+   ASSERT_EQ(second_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_EQ(second_result.iteration, first_result.iteration);
+   ASSERT_EQ(second_result.factorization_statistics.number_factorizations, first_result.factorization_statistics.number_factorizations);
+   ASSERT_NEAR(second_result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(second_result.solution.primals[1], 3., 1e-6);
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "optimization/IteratePool.hpp"
+
+using namespace uno;
+
+TEST(IteratePool, AcquireCopy) {
+   IteratePool pool;
+   Iterate iterate(3, 2);
+   iterate.primals[1] = 5.;
+   iterate.multipliers.constraints[0] = -1.;
+   const Iterate& copy = pool.acquire(iterate);
+   ASSERT_EQ(copy.primals[1], 5.);
+   ASSERT_EQ(copy.multipliers.constraints[0], -1.);
+   ASSERT_EQ(pool.number_acquired(), 1);
+}
+
+TEST(IteratePool, BuffersReusedAfterRelease) {
+   IteratePool pool;
+   Iterate& iterate = pool.acquire(4, 2);
+   const double* primals = iterate.primals.data();
+   const double* constraint_multipliers = iterate.multipliers.constraints.data();
+   iterate.primals[0] = 3.;
+   iterate.is_objective_computed = true;
+   pool.release_all();
+   ASSERT_EQ(pool.number_acquired(), 0);
+
+   Iterate& recycled_iterate = pool.acquire(4, 2);
+   ASSERT_EQ(&recycled_iterate, &iterate);
+   ASSERT_EQ(recycled_iterate.primals.data(), primals);
+   ASSERT_EQ(recycled_iterate.multipliers.constraints.data(), constraint_multipliers);
+   // the iterate is in its initial state
+   ASSERT_EQ(recycled_iterate.primals[0], 0.);
+   ASSERT_FALSE(recycled_iterate.is_objective_computed);
+   ASSERT_EQ(pool.capacity(), 1);
+}
+
+TEST(IteratePool, CopyReusesBuffers) {
+   IteratePool pool;
+   const Iterate iterate(4, 2);
+   const double* primals = pool.acquire(iterate).primals.data();
+   pool.release_all();
+   ASSERT_EQ(pool.acquire(iterate).primals.data(), primals);
+}
+
+TEST(IteratePool, DimensionsChanged) {
+   IteratePool pool;
+   (void) pool.acquire(4, 2);
+   pool.release_all();
+   const Iterate& iterate = pool.acquire(6, 3);
+   ASSERT_EQ(iterate.number_variables, 6);
+   ASSERT_EQ(iterate.primals.size(), 6);
+   ASSERT_EQ(iterate.multipliers.constraints.size(), 3);
+   ASSERT_EQ(iterate.evaluations.constraints.size(), 3);
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ingredients/inequality_handling_methods/InequalityHandlingMethodFactory.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+// chained Rosenbrock function sum_i 100 (x_{i+1} - x_i^2)^2 + (1 - x_i)^2 s.t. x_i <= 0.5 for the even indices
+class BoundedRosenbrockModel: public Model {
+public:
+   explicit BoundedRosenbrockModel(size_t number_variables): Model("bounded Rosenbrock", number_variables, 0, 1.) {
+      for (size_t variable_index: Range(number_variables)) {
+         if (variable_index % 2 == 0) {
+            this->upper_bounded_variables.emplace_back(variable_index);
+         }
+      }
+   }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+      double objective = 0.;
+      for (size_t variable_index: Range(this->number_variables - 1)) {
+         const double residual = x[variable_index + 1] - x[variable_index] * x[variable_index];
+         objective += 100. * residual * residual + (1. - x[variable_index]) * (1. - x[variable_index]);
+      }
+      return objective;
+   }
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      for (size_t variable_index: Range(this->number_variables)) {
+         double derivative = 0.;
+         if (variable_index + 1 < this->number_variables) {
+            const double residual = x[variable_index + 1] - x[variable_index] * x[variable_index];
+            derivative += -400. * x[variable_index] * residual - 2. * (1. - x[variable_index]);
+         }
+         if (0 < variable_index) {
+            derivative += 200. * (x[variable_index] - x[variable_index - 1] * x[variable_index - 1]);
+         }
+         gradient.insert(variable_index, derivative);
+      }
+   }
+   void evaluate_constraints(const Vector<double>& /*x*/, std::vector<double>& /*constraints*/) const override { }
+   void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t /*constraint_index*/, SparseVector<double>& /*gradient*/) const override { }
+   void evaluate_constraint_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& /*constraint_jacobian*/) const override { }
+   void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double /*objective_multiplier*/, const Vector<double>& /*multipliers*/,
+         SymmetricMatrix<size_t, double>& /*hessian*/) const override {
+      throw std::runtime_error("The Hessian of the bounded Rosenbrock model should not be evaluated");
+   }
+
+   [[nodiscard]] double variable_lower_bound(size_t /*variable_index*/) const override { return -INF<double>; }
+   [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return (variable_index % 2 == 0) ? 0.5 : INF<double>; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override {
+      return (variable_index % 2 == 0) ? BOUNDED_UPPER : UNBOUNDED;
+   }
+   [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables_collection; }
+   [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+   [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override {
+      return this->upper_bounded_variables_collection;
+   }
+   [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+   [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return 0.; }
+   [[nodiscard]] double constraint_upper_bound(size_t /*constraint_index*/) const override { return 0.; }
+   [[nodiscard]] FunctionType get_objective_type() const override { return NONLINEAR; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return LINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return EQUAL_BOUNDS; }
+   [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->empty_collection; }
+
+   void initial_primal_point(Vector<double>& x) const override { x.fill(-1.2); }
+   void initial_dual_point(Vector<double>& /*multipliers*/) const override { }
+   void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+   [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->number_variables; }
+   [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 0; }
+   [[nodiscard]] size_t number_hessian_nonzeros() const override { return 2 * this->number_variables; }
+
+protected:
+   std::vector<size_t> upper_bounded_variables{};
+   const std::vector<size_t> no_indices{};
+   const CollectionAdapter<std::vector<size_t>> upper_bounded_variables_collection{this->upper_bounded_variables};
+   const CollectionAdapter<std::vector<size_t>> empty_collection{this->no_indices};
+   const SparseVector<size_t> slacks{};
+   const Vector<size_t> fixed_variables{};
+};
+
+static Result solve_bounded_rosenbrock(size_t number_variables, const std::string& preset, const std::string& tolerance) {
+   Options options = test_options(preset);
+   options["tolerance"] = tolerance;
+   options["max_iterations"] = "1000";
+   return solve_reformulated_model(std::make_unique<BoundedRosenbrockModel>(number_variables), options);
+}
+
+TEST(LBFGSBSubproblem, SelectedForBoundConstrainedLineSearch) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(Presets::get_preset_options("ipopt"));
+   ASSERT_TRUE(InequalityHandlingMethodFactory::uses_LBFGSB_subproblem(0, options));
+   ASSERT_FALSE(InequalityHandlingMethodFactory::uses_LBFGSB_subproblem(1, options));
+   options["bound_constrained_subproblem"] = "default";
+   ASSERT_FALSE(InequalityHandlingMethodFactory::uses_LBFGSB_subproblem(0, options));
+   // the trust-region methods keep the truncated CG subproblem
+   Options trust_region_options = DefaultOptions::load();
+   trust_region_options.overwrite_with(Presets::get_preset_options("filtersqp"));
+   ASSERT_FALSE(InequalityHandlingMethodFactory::uses_LBFGSB_subproblem(0, trust_region_options));
+}
+
+TEST(LBFGSBSubproblem, ActiveBounds) {
+   for (const std::string preset: {"ipopt", "byrd"}) {
+      const Result result = solve_bounded_rosenbrock(2, preset, "1e-8");
+      ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+      // the bound x0 <= 0.5 is active
+      ASSERT_NEAR(result.solution.primals[0], 0.5, 1e-6);
+      ASSERT_NEAR(result.solution.primals[1], 0.25, 1e-6);
+      ASSERT_LT(result.solution.multipliers.upper_bounds[0], 0.);
+      ASSERT_EQ(result.hessian_evaluations, 0);
+      ASSERT_EQ(result.number_factorizations, 0);
+   }
+}
+
+TEST(LBFGSBSubproblem, ChainedProblem) {
+   // the L-BFGS curvature limits the attainable accuracy
+   const Result result = solve_bounded_rosenbrock(1000, "ipopt", "1e-6");
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_EQ(result.hessian_evaluations, 0);
+   ASSERT_EQ(result.number_factorizations, 0);
+   for (size_t variable_index: Range(500)) {
+      ASSERT_LE(result.solution.primals[2 * variable_index], 0.5);
+   }
+}
@@ -0,0 +1,159 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include <vector>
+#include "linear_algebra/DenseLDLT.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/LBFGSModel.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+namespace {
+   using Matrix2 = std::array<std::array<double, 2>, 2>;
+
+   // the Lagrangian Hessian of QuadraticTestModel is diag(2, 8): y = diag(2, 8) s (no damping for these points)
+   const std::vector<std::array<double, 2>> points{{1., 1.}, {2., 1.5}, {1.5, 3.}, {3., 2.5}};
+
+   std::array<double, 2> curvature_pair(const std::array<double, 2>& s) {
+      return {2. * s[0], 8. * s[1]};
+   }
+
+   // B = delta I, then the BFGS updates B <- B - B s s^T B / s^T B s + y y^T / y^T s with the pairs from the oldest to the newest
+   Matrix2 bfgs_recursion(const std::vector<std::array<double, 2>>& s_vectors) {
+      const std::array<double, 2> last_y = curvature_pair(s_vectors.back());
+      const double delta = (last_y[0] * last_y[0] + last_y[1] * last_y[1]) /
+         (s_vectors.back()[0] * last_y[0] + s_vectors.back()[1] * last_y[1]);
+      Matrix2 B{{{delta, 0.}, {0., delta}}};
+      for (const std::array<double, 2>& s: s_vectors) {
+         const std::array<double, 2> y = curvature_pair(s);
+         const std::array<double, 2> Bs{B[0][0] * s[0] + B[0][1] * s[1], B[1][0] * s[0] + B[1][1] * s[1]};
+         const double sBs = s[0] * Bs[0] + s[1] * Bs[1];
+         const double sy = s[0] * y[0] + s[1] * y[1];
+         for (size_t i: Range(2)) {
+            for (size_t j: Range(2)) {
+               B[i][j] += -Bs[i] * Bs[j] / sBs + y[i] * y[j] / sy;
+            }
+         }
+      }
+      return B;
+   }
+
+   Matrix2 to_dense(const SymmetricMatrix<size_t, double>& hessian) {
+      Matrix2 B{};
+      hessian.for_each([&](size_t row_index, size_t column_index, double element) {
+         B[row_index][column_index] += element;
+         if (row_index != column_index) {
+            B[column_index][row_index] += element;
+         }
+      });
+      return B;
+   }
+
+   // B = H - W M^{-1} W^T
+   Matrix2 compact_hessian(const LBFGSModel& model, const SymmetricMatrix<size_t, double>& hessian) {
+      const size_t dimension = model.hessian_low_rank_dimension();
+      Vector<double> factors(2 * dimension);
+      Vector<double> middle_matrix(dimension * dimension);
+      model.evaluate_hessian_low_rank_term(factors, 2, middle_matrix);
+      DenseLDLT<double> factorization(dimension);
+      for (size_t column_index: Range(dimension)) {
+         for (size_t row_index: Range(column_index, dimension)) {
+            factorization.entry(row_index, column_index) = middle_matrix[row_index + column_index * dimension];
+         }
+      }
+      factorization.factorize();
+      // the padding keeps the inertia of M
+      EXPECT_EQ(factorization.get_inertia(), std::make_tuple(dimension / 2, dimension / 2, size_t(0)));
+      Matrix2 B = to_dense(hessian);
+      for (size_t variable_index: Range(2)) {
+         std::vector<double> row(dimension);
+         for (size_t column_index: Range(dimension)) {
+            row[column_index] = factors[variable_index + column_index * 2];
+         }
+         factorization.solve(row.data());
+         for (size_t other_index: Range(2)) {
+            for (size_t column_index: Range(dimension)) {
+               B[other_index][variable_index] -= factors[other_index + column_index * 2] * row[column_index];
+            }
+         }
+      }
+      return B;
+   }
+
+   Options lbfgs_options() {
+      Options options = test_options("ipopt");
+      options["hessian_model"] = "LBFGS";
+      options["LBFGS_memory_size"] = "2";
+      return options;
+   }
+} // namespace
+
+// the Hessian materialized by the model and the compact form (diagonal plus low-rank term) match the BFGS recursion on the last pairs
+TEST(LBFGSModel, HessianMatchesBFGSRecursion) {
+   const Options options = lbfgs_options();
+   const LBFGSModel dense_model(std::make_unique<QuadraticTestModel>(), options);
+   const LBFGSModel compact_model(std::make_unique<QuadraticTestModel>(), options, true);
+   ASSERT_EQ(dense_model.hessian_low_rank_dimension(), 0);
+   ASSERT_EQ(compact_model.hessian_low_rank_dimension(), 4);
+   ASSERT_EQ(compact_model.number_hessian_nonzeros(), 2);
+
+   SymmetricMatrix<size_t, double> dense_hessian(2, dense_model.number_hessian_nonzeros(), false, "COO");
+   SymmetricMatrix<size_t, double> diagonal_hessian(2, compact_model.number_hessian_nonzeros(), false, "COO");
+   const Vector<double> multipliers{1., 0.5};
+   std::vector<std::array<double, 2>> s_vectors{};
+   for (size_t point_index: Range(points.size())) {
+      const Vector<double> x{points[point_index][0], points[point_index][1]};
+      dense_model.evaluate_lagrangian_hessian(x, 1., multipliers, dense_hessian);
+      compact_model.evaluate_lagrangian_hessian(x, 1., multipliers, diagonal_hessian);
+      if (point_index == 0) {
+         continue;
+      }
+      // memory of 2 pairs: the oldest pair is discarded
+      s_vectors.push_back({points[point_index][0] - points[point_index - 1][0], points[point_index][1] - points[point_index - 1][1]});
+      if (2 < s_vectors.size()) {
+         s_vectors.erase(s_vectors.begin());
+      }
+      const Matrix2 reference = bfgs_recursion(s_vectors);
+      const Matrix2 dense = to_dense(dense_hessian);
+      const Matrix2 compact = compact_hessian(compact_model, diagonal_hessian);
+      for (size_t i: Range(2)) {
+         for (size_t j: Range(2)) {
+            EXPECT_NEAR(dense[i][j], reference[i][j], 1e-10);
+            EXPECT_NEAR(compact[i][j], reference[i][j], 1e-10);
+         }
+      }
+   }
+}
+
+// the interior-point method solves the augmented system bordered by the low-rank term
+TEST(LBFGSModel, InteriorPointSolveWithCompactHessian) {
+   Options options = lbfgs_options();
+   options["linear_solver"] = "dense";
+   const std::unique_ptr<Model> model = ModelFactory::reformulate(std::make_unique<QuadraticTestModel>(), options);
+   ASSERT_EQ(model->hessian_low_rank_dimension(), 4);
+   const Result result = solve_model(*model, options);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+}
+
+// the inertia-free regularization accounts for the curvature of the low-rank term
+TEST(LBFGSModel, InteriorPointSolveWithCompactHessianAndCurvatureTest) {
+   Options options = lbfgs_options();
+   options["linear_solver"] = "dense";
+   options["regularization_test"] = "curvature";
+   const Result result = solve_reformulated_model(std::make_unique<QuadraticTestModel>(), options);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "preprocessing/LeastSquareMultiplierSolver.hpp"
+#include "DenseSolver.hpp"
+#include "QuadraticTestModel.hpp"
+
+using namespace uno;
+
+namespace {
+   // counts the symbolic analyses of the dense solver
+   class CountingDenseSolver: public DenseSolver {
+   public:
+      CountingDenseSolver(size_t dimension, size_t& number_analyses): DenseSolver(dimension), number_analyses(number_analyses) { }
+
+      void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& /*matrix*/) override {
+         this->number_analyses++;
+      }
+
+   protected:
+      size_t& number_analyses;
+   };
+
+   Vector<double> least_square_multipliers(LeastSquareMultiplierMethod method, const Vector<double>& primals, size_t& number_analyses) {
+      const QuadraticTestModel model;
+      const Options options = DefaultOptions::load();
+      const size_t dimension = LeastSquareMultiplierSolver<size_t>::matrix_dimension(method, model.number_variables, model.number_constraints);
+      LeastSquareMultiplierSolver<size_t> solver(method, model.number_variables, model.number_constraints, model.number_jacobian_nonzeros(),
+            std::make_unique<CountingDenseSolver>(dimension, number_analyses), options);
+      Iterate iterate(model.number_variables, model.number_constraints);
+      iterate.primals = primals;
+      Vector<double> multipliers(model.number_constraints);
+      solver.compute_multipliers(model, iterate, multipliers);
+      // a second computation with the same sparsity pattern reuses the symbolic analysis
+      iterate.primals[0] += 1.;
+      iterate.is_objective_gradient_computed = iterate.is_constraint_jacobian_computed = false;
+      solver.compute_multipliers(model, iterate, multipliers);
+      return multipliers;
+   }
+} // namespace
+
+TEST(LeastSquareMultiplierSolver, AugmentedSystemAndNormalEquations) {
+   // the second computation is at x = (1, 1), where the gradient (2, -24) is in the range of J^T = [1 -1; 1 2]
+   const Vector<double> primals{0., 1.};
+   size_t augmented_system_analyses = 0;
+   const Vector<double> augmented_multipliers = least_square_multipliers(LeastSquareMultiplierMethod::AUGMENTED_SYSTEM, primals,
+         augmented_system_analyses);
+   size_t normal_equations_analyses = 0;
+   const Vector<double> normal_multipliers = least_square_multipliers(LeastSquareMultiplierMethod::NORMAL_EQUATIONS, primals,
+         normal_equations_analyses);
+   ASSERT_NEAR(augmented_multipliers[0], -20. / 3., 1e-12);
+   ASSERT_NEAR(augmented_multipliers[1], -26. / 3., 1e-12);
+   ASSERT_NEAR(normal_multipliers[0], -20. / 3., 1e-12);
+   ASSERT_NEAR(normal_multipliers[1], -26. / 3., 1e-12);
+   ASSERT_EQ(augmented_system_analyses, 1);
+   ASSERT_EQ(normal_equations_analyses, 1);
+}
+
+TEST(LeastSquareMultiplierSolver, AutomaticMethod) {
+   Options options = DefaultOptions::load();
+   ASSERT_EQ(LeastSquareMultiplierSolver<size_t>::determine_method(100, 10, options), LeastSquareMultiplierMethod::AUGMENTED_SYSTEM);
+   options["least_square_multiplier_method"] = "automatic";
+   ASSERT_EQ(LeastSquareMultiplierSolver<size_t>::determine_method(100, 10, options), LeastSquareMultiplierMethod::NORMAL_EQUATIONS);
+   ASSERT_EQ(LeastSquareMultiplierSolver<size_t>::determine_method(100, 11, options), LeastSquareMultiplierMethod::AUGMENTED_SYSTEM);
+   // the upper triangle of J J^T has at most m(m+1)/2 entries
+   ASSERT_EQ(LeastSquareMultiplierSolver<size_t>::matrix_number_nonzeros(LeastSquareMultiplierMethod::NORMAL_EQUATIONS, 100, 10, 1000), 55);
+}
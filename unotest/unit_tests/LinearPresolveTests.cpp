@@ -0,0 +1,150 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/LinearPresolveModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+namespace {
+   // min (x0 - 3)^2 + (x1 - 4)^2 + x2^2 s.t.
+   // c0: x0 + x1 <= 4, c1: 4 x0 <= 4 (singleton), c2: 1 ∈ [0, 2] (empty), c3: 2 x0 + 2 x1 <= 10 (duplicate of c0),
+   // c4: x1 - x2 >= -20 (dominated), 0 <= x0, x1 <= 10, 0 <= x2 <= 1. Solution (1, 3, 0)
+   class LinearRowsTestModel: public Model {
+   public:
+      LinearRowsTestModel(): Model("linear rows test model", 3, 5, 1.) { }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+         return (x[0] - 3.) * (x[0] - 3.) + (x[1] - 4.) * (x[1] - 4.) + x[2] * x[2];
+      }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         gradient.insert(0, 2. * (x[0] - 3.));
+         gradient.insert(1, 2. * (x[1] - 4.));
+         gradient.insert(2, 2. * x[2]);
+      }
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         constraints[0] = x[0] + x[1];
+         constraints[1] = 4. * x[0];
+         constraints[2] = 1.;
+         constraints[3] = 2. * x[0] + 2. * x[1];
+         constraints[4] = x[1] - x[2];
+      }
+      void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t constraint_index, SparseVector<double>& gradient) const override {
+         RectangularMatrix<double> jacobian(5, 3);
+         this->evaluate_constraint_jacobian(Vector<double>(3), jacobian);
+         for (const auto [variable_index, derivative]: jacobian[constraint_index]) {
+            gradient.insert(variable_index, derivative);
+         }
+      }
+      void evaluate_constraint_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& constraint_jacobian) const override {
+         constraint_jacobian[0].insert(0, 1.);
+         constraint_jacobian[0].insert(1, 1.);
+         constraint_jacobian[1].insert(0, 4.);
+         constraint_jacobian[3].insert(0, 2.);
+         constraint_jacobian[3].insert(1, 2.);
+         constraint_jacobian[4].insert(1, 1.);
+         constraint_jacobian[4].insert(2, -1.);
+      }
+      void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& /*multipliers*/,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         hessian.reset();
+         for (size_t variable_index: Range(3)) {
+            hessian.insert(2. * objective_multiplier, variable_index, variable_index);
+            hessian.finalize_column(variable_index);
+         }
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t /*variable_index*/) const override { return 0.; }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override {
+         return (variable_index == 0) ? INF<double> : (variable_index == 1) ? 10. : 1.;
+      }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override {
+         return (variable_index == 0) ? BOUNDED_LOWER : BOUNDED_BOTH_SIDES;
+      }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->all_variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->upper_bounded_variables_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->first_variable_collection; }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->no_index_collection; }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t constraint_index) const override {
+         return (constraint_index == 2) ? 0. : (constraint_index == 4) ? -20. : -INF<double>;
+      }
+      [[nodiscard]] double constraint_upper_bound(size_t constraint_index) const override {
+         const std::vector<double> upper_bounds{4., 4., 2., 10., INF<double>};
+         return upper_bounds[constraint_index];
+      }
+      [[nodiscard]] FunctionType get_objective_type() const override { return QUADRATIC; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return LINEAR; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t constraint_index) const override {
+         return (constraint_index == 2) ? BOUNDED_BOTH_SIDES : (constraint_index == 4) ? BOUNDED_LOWER : BOUNDED_UPPER;
+      }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->no_index_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->all_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->all_constraints_collection; }
+
+      void initial_primal_point(Vector<double>& x) const override { x.fill(0.); }
+      void initial_dual_point(Vector<double>& multipliers) const override { multipliers.fill(0.); }
+      void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 3; }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 7; }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return 3; }
+
+   protected:
+      const std::vector<size_t> all_variables{0, 1, 2};
+      const std::vector<size_t> upper_bounded_variables{1, 2};
+      const std::vector<size_t> first_variable{0};
+      const std::vector<size_t> no_index{};
+      const std::vector<size_t> all_constraints{0, 1, 2, 3, 4};
+      const CollectionAdapter<std::vector<size_t>> all_variables_collection{this->all_variables};
+      const CollectionAdapter<std::vector<size_t>> upper_bounded_variables_collection{this->upper_bounded_variables};
+      const CollectionAdapter<std::vector<size_t>> first_variable_collection{this->first_variable};
+      const CollectionAdapter<std::vector<size_t>> no_index_collection{this->no_index};
+      const CollectionAdapter<std::vector<size_t>> all_constraints_collection{this->all_constraints};
+      const SparseVector<size_t> slacks{};
+      const Vector<size_t> fixed_variables{};
+   };
+} // namespace
+
+TEST(LinearPresolve, StructuralReductions) {
+   const LinearPresolveModel model(std::make_unique<LinearRowsTestModel>(), 1e-12);
+   // only c0 remains, with the bound of the duplicate c3 (x0 + x1 <= 5) discarded
+   ASSERT_EQ(model.number_constraints, 1);
+   ASSERT_EQ(model.original_index(0), 0);
+   ASSERT_EQ(model.constraint_upper_bound(0), 4.);
+   ASSERT_EQ(model.get_linear_constraints().size(), 1);
+   // the singleton c1 became the bound x0 <= 1
+   ASSERT_EQ(model.variable_upper_bound(0), 1.);
+   ASSERT_EQ(model.get_variable_bound_type(0), BOUNDED_BOTH_SIDES);
+   ASSERT_EQ(model.get_upper_bounded_variables().size(), 3);
+
+   std::vector<double> constraints(1);
+   model.evaluate_constraints(Vector<double>{1., 2., 3.}, constraints);
+   ASSERT_EQ(constraints[0], 3.);
+}
+
+TEST(LinearPresolve, MultipliersAreMappedBack) {
+   const LinearPresolveModel model(std::make_unique<LinearRowsTestModel>(), 1e-12);
+   const Result result = solve_model(model, test_options("filtersqp"));
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_NEAR(result.solution.primals[0], 1., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+   // the multiplier of the bound x0 <= 1 is moved to the singleton row c1: z = 4 lambda_1
+   ASSERT_EQ(result.solution.number_constraints, 5);
+   ASSERT_NEAR(result.solution.multipliers.constraints[0], -2., 1e-6);
+   ASSERT_NEAR(result.solution.multipliers.constraints[1], -0.5, 1e-6);
+   ASSERT_EQ(result.solution.multipliers.constraints[2], 0.);
+   ASSERT_EQ(result.solution.multipliers.constraints[3], 0.);
+   ASSERT_NEAR(result.solution.multipliers.upper_bounds[0], 0., 1e-6);
+   ASSERT_NEAR(result.solution.evaluations.constraints[3], 8., 1e-6);
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include "tools/Logger.hpp"
+
+using namespace uno;
+
+static int number_evaluations = 0;
+
+static int evaluate_operand() {
+   number_evaluations++;
+   return 0;
+}
+
+TEST(Logger, DisabledLevelsAreNotEvaluated) {
+   const Logger::Scope scope("INFO");
+   number_evaluations = 0;
+   DEBUG << evaluate_operand() << '\n';
+   DEBUG2 << evaluate_operand() << '\n';
+   DEBUG3 << evaluate_operand() << '\n';
+   ASSERT_EQ(number_evaluations, 0);
+}
+
+TEST(Logger, EnabledLevelsAreEvaluated) {
+   const Logger::Scope scope("DEBUG");
+   number_evaluations = 0;
+   testing::internal::CaptureStdout();
+   DEBUG << evaluate_operand() << '\n';
+   DEBUG2 << evaluate_operand() << '\n';
+   const std::string output = testing::internal::GetCapturedStdout();
+#ifdef UNO_DISABLE_DEBUG_LOGGING
+   ASSERT_EQ(number_evaluations, 0);
+   ASSERT_TRUE(output.empty());
+#else
+   ASSERT_EQ(number_evaluations, 1);
+   ASSERT_EQ(output, "0\n");
+#endif
+}
+
+TEST(Logger, LevelNames) {
+   const Logger::Scope scope("DEBUG3");
+   ASSERT_EQ(std::string(level_names[Logger::level]), "DEBUG3");
+   ASSERT_THROW(Logger::set_logger("VERBOSE"), std::out_of_range);
+}
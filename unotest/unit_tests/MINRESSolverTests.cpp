@@ -0,0 +1,93 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include "ingredients/subproblem_solvers/MINRESSolver.hpp"
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "options/DefaultOptions.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-8;
+
+// augmented matrix [H J^T; J 0] with H = [4 1; 1 3] and J = [1 2]
+static void assemble_augmented_matrix(SymmetricMatrix<size_t, double>& matrix) {
+   matrix.insert(4., 0, 0);
+   matrix.insert(1., 0, 1);
+   matrix.insert(3., 1, 1);
+   matrix.insert(1., 0, 2);
+   matrix.insert(2., 1, 2);
+}
+
+static std::array<double, 3> solve_augmented_system(size_t primal_block_dimension) {
+   const Options options = DefaultOptions::load();
+   SymmetricMatrix<size_t, double> matrix(3, 5, false, "COO");
+   assemble_augmented_matrix(matrix);
+   // the solution is (1, -1, 2)
+   Vector<double> rhs{5., 2., -1.};
+   Vector<double> result(3);
+
+   MINRESSolver<size_t, double> linear_solver(3, options);
+   linear_solver.set_primal_block_dimension(primal_block_dimension);
+   linear_solver.solve_indefinite_system(matrix, rhs, result);
+   EXPECT_TRUE(linear_solver.has_converged());
+   // at most one iteration per eigenvalue
+   EXPECT_LE(linear_solver.get_number_iterations(), 3);
+   return {result[0], result[1], result[2]};
+}
+
+TEST(MINRESSolver, JacobiPreconditioner) {
+   const std::array<double, 3> reference{1., -1., 2.};
+   const std::array<double, 3> solution = solve_augmented_system(0);
+   for (size_t index: Range(3)) {
+      EXPECT_NEAR(solution[index], reference[index], tolerance);
+   }
+}
+
+TEST(MINRESSolver, ConstraintPreconditioner) {
+   const std::array<double, 3> reference{1., -1., 2.};
+   const std::array<double, 3> solution = solve_augmented_system(2);
+   for (size_t index: Range(3)) {
+      EXPECT_NEAR(solution[index], reference[index], tolerance);
+   }
+}
+
+TEST(MINRESSolver, ZeroRhs) {
+   const Options options = DefaultOptions::load();
+   SymmetricMatrix<size_t, double> matrix(3, 5, false, "COO");
+   assemble_augmented_matrix(matrix);
+   Vector<double> rhs(3, 0.);
+   Vector<double> result(3, 1.);
+   MINRESSolver<size_t, double> linear_solver(3, options);
+   linear_solver.solve_indefinite_system(matrix, rhs, result);
+   ASSERT_TRUE(linear_solver.has_converged());
+   ASSERT_EQ(linear_solver.get_number_iterations(), 0);
+   for (size_t index: Range(3)) {
+      ASSERT_EQ(result[index], 0.);
+   }
+}
+
+TEST(MINRESSolver, CurvatureRegularization) {
+   // H = diag(1, -1) is not positive definite on the null space of J = [1 0]: the direction of the unregularized system has
+   // negative curvature, the primal regularization must exceed 1
+   Options options = DefaultOptions::load();
+   SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", 3, 3, true, options);
+   augmented_system.matrix.insert(1., 0, 0);
+   augmented_system.matrix.insert(-1., 1, 1);
+   augmented_system.matrix.insert(1., 0, 2);
+   augmented_system.rhs[0] = 0.;
+   augmented_system.rhs[1] = 1.;
+   augmented_system.rhs[2] = 0.;
+
+   MINRESSolver<size_t, double> linear_solver(3, options);
+   linear_solver.set_primal_block_dimension(2);
+   Statistics statistics(options);
+   augmented_system.solve_and_regularize_by_curvature(statistics, linear_solver, 2, 1, 0.);
+   // solution of [1 + delta, 0, 1; 0, delta - 1, 0; 1, 0, 0] d = (0, 1, 0) with delta > 1
+   EXPECT_NEAR(augmented_system.solution[0], 0., tolerance);
+   EXPECT_LT(0., augmented_system.solution[1]);
+   EXPECT_NEAR(augmented_system.solution[2], 0., tolerance);
+}
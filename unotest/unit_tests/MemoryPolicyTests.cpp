@@ -0,0 +1,71 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include "linear_algebra/Vector.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/MemoryPolicy.hpp"
+
+using namespace uno;
+
+namespace {
+   // restores the default policy when the test ends
+   struct DefaultMemoryPolicy {
+      ~DefaultMemoryPolicy() {
+         MemoryPolicy::set(false, HugePages::NONE);
+      }
+   };
+
+   constexpr size_t large_size = MemoryPolicy::large_buffer_threshold / sizeof(double) + 1;
+} // namespace
+
+TEST(MemoryPolicy, DefaultPolicyUsesOperatorNew) {
+   const Vector<double> vector(large_size, 1.);
+   ASSERT_FALSE(MemoryPolicy::is_active());
+   ASSERT_EQ(MemoryPolicy::number_large_buffers(), 0);
+}
+
+TEST(MemoryPolicy, TransparentHugePages) {
+   const DefaultMemoryPolicy default_policy;
+   MemoryPolicy::set(true, HugePages::TRANSPARENT);
+   {
+      Vector<double> vector(large_size);
+      // small buffers are not affected
+      const Vector<double> small_vector(10, 1.);
+#if defined(__linux__)
+      ASSERT_EQ(MemoryPolicy::number_large_buffers(), 1);
+      ASSERT_EQ(reinterpret_cast<std::uintptr_t>(vector.data()) % MemoryPolicy::huge_page_size, 0);
+#endif
+      for (size_t index: Range(large_size)) {
+         ASSERT_EQ(vector[index], 0.);
+         vector[index] = static_cast<double>(index);
+      }
+      ASSERT_EQ(vector[large_size - 1], static_cast<double>(large_size - 1));
+      // the buffer is released after the policy is reset
+      MemoryPolicy::set(false, HugePages::NONE);
+   }
+   ASSERT_EQ(MemoryPolicy::number_large_buffers(), 0);
+}
+
+TEST(MemoryPolicy, ExplicitHugePagesFallBack) {
+   const DefaultMemoryPolicy default_policy;
+   MemoryPolicy::set(false, HugePages::EXPLICIT);
+   // without reserved huge pages, the buffer is backed by regular pages
+   Vector<double> vector(large_size, 2.);
+   vector.resize(2 * large_size);
+   ASSERT_EQ(vector[0], 2.);
+   ASSERT_EQ(vector[large_size - 1], 2.);
+}
+
+TEST(MemoryPolicy, InvalidOptions) {
+   Options options = DefaultOptions::load();
+   options["huge_pages"] = "gigantic";
+   ASSERT_THROW(MemoryPolicy::set_from_options(options), std::invalid_argument);
+   options["huge_pages"] = "none";
+   options["memory_first_touch"] = "interleaved";
+   ASSERT_THROW(MemoryPolicy::set_from_options(options), std::invalid_argument);
+   ASSERT_FALSE(MemoryPolicy::is_active());
+}
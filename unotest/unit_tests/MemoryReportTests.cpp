@@ -0,0 +1,65 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "tools/MemoryReport.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+static Result solve(const std::string& memory_report) {
+   Options options = test_options("funnelsqp");
+   options["memory_report"] = memory_report;
+   return solve_model(QuadraticTestModel(), options);
+}
+
+static size_t usage(const Result& result, const std::string& component) {
+   const auto it = std::find_if(result.memory_usages.cbegin(), result.memory_usages.cend(), [&](const MemoryUsage& memory_usage) {
+      return memory_usage.component == component;
+   });
+   return (it != result.memory_usages.cend()) ? it->bytes : 0;
+}
+
+TEST(MemoryReport, EmptyComponentsAreOmitted) {
+   MemoryReport report{};
+   report.add("empty", 0);
+   report.add("vector", 16);
+   report.add("matrix", 32);
+   ASSERT_EQ(report.get_usages().size(), 2);
+   ASSERT_EQ(report.total_size(), 48);
+}
+
+TEST(MemoryReport, RectangularMatrixCapacity) {
+   RectangularMatrix<double> matrix(2, 3);
+   const size_t empty_size = matrix.memory_size();
+   ASSERT_EQ(empty_size, 6 * sizeof(size_t));
+   matrix.insert(0, 0, 1.);
+   matrix.insert(1, 2, 2.);
+   // each row reserves a capacity of (at least) 4 nonzeros
+   ASSERT_GE(matrix.memory_size(), empty_size + 8 * (sizeof(size_t) + sizeof(double)));
+}
+
+TEST(MemoryReport, DisabledByDefault) {
+   const Result result = solve("no");
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_TRUE(result.memory_usages.empty());
+}
+
+TEST(MemoryReport, ReportsComponents) {
+   const Result result = solve("yes");
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   // current and trial iterates
+   ASSERT_GT(usage(result, "iterates"), result.solution.memory_size());
+   // the QP solver reads the Jacobian of the iterate instead of copying it
+   ASSERT_EQ(0, usage(result, "QP solver/constraint Jacobian"));
+   ASSERT_LT(0, usage(result, "QP solver/dense QP"));
+   for (const MemoryUsage& memory_usage: result.memory_usages) {
+      ASSERT_LT(0, memory_usage.bytes);
+   }
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <string>
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "tools/Metrics.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+TEST(Metrics, Registry) {
+   MetricsRegistry registry;
+   registry.increment(Metric::SOLVES);
+   registry.increment(Metric::ITERATIONS, 3.);
+   registry.set(Metric::LAST_SOLVE_TIME, 0.5);
+   registry.observe(Metric::SOLVE_ITERATIONS, 3.);
+   registry.observe(Metric::SOLVE_ITERATIONS, 2000.);
+   ASSERT_EQ(registry.value(Metric::ITERATIONS), 3.);
+   const Histogram histogram = registry.histogram(Metric::SOLVE_ITERATIONS);
+   ASSERT_EQ(histogram.count, 2);
+   ASSERT_EQ(histogram.sum, 2003.);
+   // 3 lies in the bucket (2, 5], 2000 in the +Inf bucket
+   ASSERT_EQ(histogram.bucket_counts[2], 1);
+   ASSERT_EQ(histogram.bucket_counts[10], 1);
+
+   MetricsRegistry other_registry;
+   other_registry.merge(registry);
+   other_registry.merge(registry);
+   ASSERT_EQ(other_registry.value(Metric::SOLVES), 2.);
+   ASSERT_EQ(other_registry.value(Metric::LAST_SOLVE_TIME), 0.5);
+   ASSERT_EQ(other_registry.histogram(Metric::SOLVE_ITERATIONS).count, 4);
+   other_registry.clear();
+   ASSERT_EQ(other_registry.value(Metric::SOLVES), 0.);
+
+   ASSERT_EQ(MetricsRegistry::find("uno_restoration_phases"), Metric::RESTORATION_PHASES);
+   ASSERT_FALSE(MetricsRegistry::find("uno_unknown").has_value());
+}
+
+TEST(Metrics, OpenMetricsExposition) {
+   MetricsRegistry registry;
+   registry.increment(Metric::SOLVES, 2.);
+   registry.observe(Metric::SOLVE_EVALUATION_TIME_SHARE, 0.25);
+   const std::string exposition = registry.to_openmetrics();
+   ASSERT_NE(exposition.find("# TYPE uno_solves counter\n"), std::string::npos);
+   ASSERT_NE(exposition.find("\nuno_solves_total 2\n"), std::string::npos);
+   // cumulative buckets
+   ASSERT_NE(exposition.find("uno_solve_evaluation_time_share_bucket{le=\"0.2\"} 0\n"), std::string::npos);
+   ASSERT_NE(exposition.find("uno_solve_evaluation_time_share_bucket{le=\"0.3\"} 1\n"), std::string::npos);
+   ASSERT_NE(exposition.find("uno_solve_evaluation_time_share_bucket{le=\"+Inf\"} 1\n"), std::string::npos);
+   ASSERT_NE(exposition.find("uno_solve_evaluation_time_share_count 1\n"), std::string::npos);
+   ASSERT_EQ(exposition.substr(exposition.size() - 6), "# EOF\n");
+}
+
+TEST(Metrics, SolvesAreRecorded) {
+   MetricsRegistry registry;
+   const MetricsRegistry::Scope scope(&registry);
+   const QuadraticTestModel model;
+   const Result result = solve_model(model, test_options("filtersqp"));
+   QuadraticTestModel infeasible_model;
+   infeasible_model.set_parameter(-1.);
+   const Result infeasible_result = solve_model(infeasible_model, test_options("filtersqp"));
+
+   ASSERT_EQ(registry.value(Metric::SOLVES), 2.);
+   ASSERT_EQ(registry.value(Metric::ITERATIONS), static_cast<double>(result.iteration + infeasible_result.iteration));
+   ASSERT_EQ(registry.value(Metric::QP_SUBPROBLEMS), static_cast<double>(result.number_subproblems_solved +
+      infeasible_result.number_subproblems_solved));
+   // only the infeasible model enters the restoration phase
+   ASSERT_LE(1., registry.value(Metric::RESTORATION_PHASES));
+   ASSERT_EQ(registry.value(Metric::SOLVES_WITH_RESTORATION), 1.);
+   ASSERT_EQ(registry.histogram(Metric::SOLVE_ITERATIONS).count, 2);
+   ASSERT_EQ(registry.value(Metric::LAST_SOLVE_TIME), infeasible_result.solve_time);
+}
+
+TEST(Metrics, NoRegistry) {
+   ASSERT_EQ(MetricsRegistry::current(), nullptr);
+   // without a registry, the metrics are discarded
+   metrics::increment(Metric::SOLVES);
+   const QuadraticTestModel model;
+   const Result result = solve_model(model, test_options("filtersqp"));
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include "ingredients/subproblem_solvers/MixedPrecisionSolver.hpp"
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "options/DefaultOptions.hpp"
+
+using namespace uno;
+
+// single-precision solver of diagonal systems
+class SingleDiagonalSolver: public DirectSymmetricIndefiniteLinearSolver<size_t, float> {
+public:
+   explicit SingleDiagonalSolver(size_t dimension): DirectSymmetricIndefiniteLinearSolver<size_t, float>(dimension), diagonal(dimension) { }
+
+   void do_symbolic_analysis(const SymmetricMatrix<size_t, float>& /*matrix*/) override { }
+   void do_numerical_factorization(const SymmetricMatrix<size_t, float>& matrix) override {
+      std::fill(this->diagonal.begin(), this->diagonal.end(), 0.f);
+      matrix.get_diagonal(this->diagonal);
+   }
+   void solve_indefinite_system(const SymmetricMatrix<size_t, float>& matrix, const Vector<float>& rhs, Vector<float>& result) override {
+      for (size_t index: Range(matrix.dimension())) {
+         result[index] = rhs[index] / this->diagonal[index];
+      }
+   }
+
+   [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override { return {this->dimension, 0, 0}; }
+   [[nodiscard]] size_t number_negative_eigenvalues() const override { return 0; }
+   [[nodiscard]] bool matrix_is_singular() const override { return false; }
+   [[nodiscard]] size_t rank() const override { return this->dimension; }
+
+protected:
+   std::vector<float> diagonal;
+};
+
+static double solve_mixed_precision(size_t iterative_refinement_max_steps) {
+   const size_t n = 3;
+   Options options = DefaultOptions::load();
+   options["iterative_refinement_max_steps"] = std::to_string(iterative_refinement_max_steps);
+   SymmetricIndefiniteLinearSystem<size_t, double> linear_system("COO", n, n, false, options);
+   linear_system.matrix.insert(3., 0, 0);
+   linear_system.matrix.insert(7., 1, 1);
+   linear_system.matrix.insert(1e-3 / 3., 2, 2);
+   linear_system.rhs[0] = 1.;
+   linear_system.rhs[1] = 1.;
+   linear_system.rhs[2] = 1.;
+
+   MixedPrecisionSolver<size_t> linear_solver(n, n, std::make_unique<SingleDiagonalSolver>(n));
+   linear_solver.do_symbolic_analysis(linear_system.matrix);
+   linear_solver.do_numerical_factorization(linear_system.matrix);
+   linear_system.solve(linear_solver);
+
+   const std::array<double, n> reference{1. / 3., 1. / 7., 3e3};
+   double error = 0.;
+   for (size_t index: Range(n)) {
+      error = std::max(error, std::abs(linear_system.solution[index] - reference[index]) / reference[index]);
+   }
+   return error;
+}
+
+TEST(MixedPrecisionSolver, SinglePrecisionAccuracy) {
+   // without refinement, the solution has single-precision accuracy
+   const double error = solve_mixed_precision(0);
+   ASSERT_GT(error, 1e-12);
+   ASSERT_LT(error, 1e-6);
+}
+
+TEST(MixedPrecisionSolver, IterativeRefinement) {
+   // the refinement in double precision recovers a full-accuracy solution
+   ASSERT_LT(solve_mixed_precision(5), 1e-13);
+}
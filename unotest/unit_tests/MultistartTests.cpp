@@ -0,0 +1,135 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "Multistart.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+
+using namespace uno;
+
+// min (x^2 - 1)^2 + x/2 s.t. -2 <= x <= 2: local minimum near 0.93, global minimum near -1.06
+class DoubleWellModel: public Model {
+public:
+   DoubleWellModel(): Model("double well", 1, 0, 1.) { }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override { return std::pow(x[0] * x[0] - 1., 2) + 0.5 * x[0]; }
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, 4. * x[0] * (x[0] * x[0] - 1.) + 0.5);
+   }
+   void evaluate_constraints(const Vector<double>& /*x*/, std::vector<double>& /*constraints*/) const override { }
+   void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t /*constraint_index*/, SparseVector<double>& /*gradient*/) const override { }
+   void evaluate_constraint_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& /*constraint_jacobian*/) const override { }
+   void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& /*multipliers*/,
+         SymmetricMatrix<size_t, double>& hessian) const override {
+      hessian.reset();
+      hessian.insert(objective_multiplier * (12. * x[0] * x[0] - 4.), 0, 0);
+      hessian.finalize_column(0);
+   }
+
+   [[nodiscard]] double variable_lower_bound(size_t /*variable_index*/) const override { return -2.; }
+   [[nodiscard]] double variable_upper_bound(size_t /*variable_index*/) const override { return 2.; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t /*variable_index*/) const override { return BOUNDED_BOTH_SIDES; }
+   [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->bounded_variables_collection; }
+   [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->bounded_variables_collection; }
+   [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+   [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+   [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return 0.; }
+   [[nodiscard]] double constraint_upper_bound(size_t /*constraint_index*/) const override { return 0.; }
+   [[nodiscard]] FunctionType get_objective_type() const override { return NONLINEAR; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return LINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return EQUAL_BOUNDS; }
+   [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->empty_collection; }
+
+   // the default start lies in the basin of the local minimum
+   void initial_primal_point(Vector<double>& x) const override { x[0] = 1.; }
+   void initial_dual_point(Vector<double>& /*multipliers*/) const override { }
+   void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+   [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 1; }
+   [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 0; }
+   [[nodiscard]] size_t number_hessian_nonzeros() const override { return 1; }
+   [[nodiscard]] bool supports_concurrent_evaluations() const override { return true; }
+
+protected:
+   const std::vector<size_t> bounded_variables{0};
+   const std::vector<size_t> no_indices{};
+   const CollectionAdapter<std::vector<size_t>> bounded_variables_collection{this->bounded_variables};
+   const CollectionAdapter<std::vector<size_t>> empty_collection{this->no_indices};
+   const SparseVector<size_t> slacks{};
+   const Vector<size_t> fixed_variables{};
+};
+
+static Options multistart_options() {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(Presets::get_preset_options("filtersqp"));
+   options["QP_solver"] = "GoldfarbIdnani";
+   options["logger"] = "SILENT";
+   options["multistart_method"] = "latin_hypercube";
+   options["multistart_starts"] = "8";
+   options["multistart_threads"] = "4";
+   return options;
+}
+
+TEST(Multistart, LatinHypercubeFindsGlobalMinimum) {
+   const Options options = multistart_options();
+   const DoubleWellModel model;
+   Multistart multistart(options);
+   const Result result = multistart.solve(model, options);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], -1.0574, 1e-3);
+   ASSERT_NE(multistart.get_best_start(), 0);
+}
+
+TEST(Multistart, TargetObjectiveStopsTheStarts) {
+   Options options = multistart_options();
+   // on a single thread, the first start (local minimum) reaches the target
+   options["multistart_threads"] = "1";
+   options["multistart_target_objective"] = "1";
+   const DoubleWellModel model;
+   Multistart multistart(options);
+   const Result result = multistart.solve(model, options);
+   ASSERT_EQ(multistart.get_best_start(), 0);
+   ASSERT_NEAR(result.solution.primals[0], 0.9304, 1e-3);
+
+   // a single start performs the same evaluations
+   options["multistart_starts"] = "1";
+   Multistart single_start(options);
+   const Result single_result = single_start.solve(model, options);
+   ASSERT_EQ(result.objective_evaluations, single_result.objective_evaluations);
+}
+
+TEST(Multistart, DeterministicModeDoesNotDependOnTheThreads) {
+   Options options = multistart_options();
+   options["multistart_target_objective"] = "1";
+   options["deterministic"] = "yes";
+   const DoubleWellModel model;
+   // the first start reaches the target: the other starts are discarded, whichever ran concurrently
+   for (size_t repetition = 0; repetition < 5; repetition++) {
+      Multistart multistart(options);
+      const Result result = multistart.solve(model, options);
+      ASSERT_EQ(multistart.get_best_start(), 0);
+      ASSERT_NEAR(result.solution.primals[0], 0.9304, 1e-3);
+
+      options["multistart_starts"] = "1";
+      Multistart single_start(options);
+      const Result single_result = single_start.solve(model, options);
+      options["multistart_starts"] = "8";
+      ASSERT_EQ(result.objective_evaluations, single_result.objective_evaluations);
+      ASSERT_EQ(result.solution.primals[0], single_result.solution.primals[0]);
+   }
+}
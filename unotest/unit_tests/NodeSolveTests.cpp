@@ -0,0 +1,74 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "model/EditableModel.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "tools/Infinity.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+// branch and bound on x0 from the root solution (2, 3) of the quadratic test problem
+class NodeSolve: public ::testing::Test {
+protected:
+   void SetUp() override {
+      // the trust region does not require a linear solver
+      this->options["globalization_mechanism"] = "TR";
+   }
+
+   void create_solver() {
+      auto editable_model = std::make_unique<EditableModel>(std::make_unique<QuadraticTestModel>(), 0, 0);
+      this->edits = editable_model.get();
+      this->model = ModelFactory::reformulate(std::move(editable_model), this->options);
+      this->solver = std::make_unique<TestSolver>(*this->model, this->options);
+   }
+
+   Result solve_root() {
+      return this->solver->solve();
+   }
+
+   Options options{test_options("filtersqp")};
+   EditableModel* edits{nullptr};
+   std::unique_ptr<Model> model{};
+   std::unique_ptr<TestSolver> solver{};
+};
+
+TEST_F(NodeSolve, BoundChangesFromParentSolution) {
+   this->create_solver();
+   const Result root = this->solve_root();
+   ASSERT_EQ(root.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+
+   // left child x0 <= 1: solution (1, 2.5)
+   const Result left_child = this->solver->uno.solve_node(*this->model, *this->edits, root.solution, {{0, 0., 1.}}, INF<double>, this->options);
+   ASSERT_EQ(left_child.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_NEAR(left_child.solution.primals[0], 1., 1e-6);
+   ASSERT_NEAR(left_child.solution.primals[1], 2.5, 1e-6);
+   ASSERT_FALSE(this->edits->get_changes().variable_bounds_changed);
+
+   // right child x0 >= 3 (the change replaces both bounds of x0): solution (3, 3.5)
+   const Result right_child = this->solver->uno.solve_node(*this->model, *this->edits, root.solution, {{0, 3., INF<double>}}, INF<double>,
+      this->options);
+   ASSERT_EQ(right_child.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_NEAR(right_child.solution.primals[0], 3., 1e-6);
+   ASSERT_NEAR(right_child.solution.primals[1], 3.5, 1e-6);
+   ASSERT_NEAR(right_child.solution.evaluations.objective, -54., 1e-6);
+}
+
+// the objective of the problem is bounded below by -56: the node is pruned at its first feasible iterate, while a small trust
+// region requires several iterations to reach the solution of the node
+TEST_F(NodeSolve, ObjectiveCutoff) {
+   this->options["TR_radius"] = "0.1";
+   this->create_solver();
+   const Result root = this->solve_root();
+   const Result node = this->solver->uno.solve_node(*this->model, *this->edits, root.solution, {{0, 3., INF<double>}}, -60., this->options);
+   ASSERT_EQ(node.optimization_status, OptimizationStatus::OBJECTIVE_CUTOFF);
+   ASSERT_EQ(node.iteration, 1);
+   ASSERT_LT(-60., node.solution.evaluations.objective);
+   ASSERT_LE(node.solution.primal_feasibility, this->options.get_double("tolerance"));
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/globalization_strategies/NonmonotoneMeritFunction.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+
+static ProgressMeasures progress(double infeasibility, double objective) {
+   return ProgressMeasures{infeasibility, ObjectiveMeasure::scaled(objective), 0.};
+}
+
+TEST(NonmonotoneMeritFunction, ReferenceIsLargestAcceptedMerit) {
+   Options options = DefaultOptions::load();
+   options["nonmonotone_merit_memory"] = "2";
+   options["nonmonotone_merit_watchdog_iterations"] = "0";
+   Statistics statistics(options);
+   NonmonotoneMeritFunction strategy(options);
+   const ProgressMeasures predicted_reduction = progress(0., 1.);
+   // merit 10 -> 5: accepted
+   ASSERT_TRUE(strategy.is_iterate_acceptable(statistics, progress(0., 10.), progress(0., 5.), predicted_reduction, 1.));
+   // merit 5 -> 8: increase, but sufficient decrease with respect to the reference 10
+   ASSERT_TRUE(strategy.is_iterate_acceptable(statistics, progress(0., 5.), progress(0., 8.), predicted_reduction, 1.));
+   // the memory now holds 5 and 8: 8 -> 9 is rejected
+   ASSERT_FALSE(strategy.is_iterate_acceptable(statistics, progress(0., 8.), progress(0., 9.), predicted_reduction, 1.));
+}
+
+TEST(NonmonotoneMeritFunction, WatchdogIsExhausted) {
+   Options options = DefaultOptions::load();
+   options["nonmonotone_merit_memory"] = "1";
+   options["nonmonotone_merit_watchdog_iterations"] = "2";
+   Statistics statistics(options);
+   NonmonotoneMeritFunction strategy(options);
+   const ProgressMeasures predicted_reduction = progress(0., 1.);
+   // two full steps that increase the merit are tentatively accepted
+   ASSERT_TRUE(strategy.is_iterate_acceptable(statistics, progress(0., 1.), progress(0., 2.), predicted_reduction, 1.));
+   ASSERT_TRUE(strategy.is_iterate_acceptable(statistics, progress(0., 2.), progress(0., 3.), predicted_reduction, 1.));
+   // the watchdog is exhausted: the trial iterate must decrease the merit value before the watchdog started
+   ASSERT_FALSE(strategy.is_iterate_acceptable(statistics, progress(0., 3.), progress(0., 1.5), predicted_reduction, 1.));
+   ASSERT_TRUE(strategy.is_iterate_acceptable(statistics, progress(0., 3.), progress(0., 0.5), predicted_reduction, 1.));
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include "linear_algebra/Norm.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/ScalarMultiple.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-12;
+
+// sizes that are not multiples of the vector widths exercise the scalar remainders
+Vector<double> alternating_vector(size_t size) {
+   Vector<double> x(size);
+   for (size_t index: Range(size)) {
+      x[index] = (index % 2 == 0 ? 1. : -1.) * static_cast<double>(index + 1) / 3.;
+   }
+   return x;
+}
+
+TEST(Norm, AlignedStorage) {
+   const Vector<double> x = alternating_vector(13);
+   ASSERT_EQ(reinterpret_cast<std::uintptr_t>(x.data()) % 64, 0);
+}
+
+TEST(Norm, Norm1MatchesScalar) {
+   for (size_t size: {0, 1, 3, 7, 8, 13, 33}) {
+      const Vector<double> x = alternating_vector(size);
+      ASSERT_NEAR(norm_1(x), scalar_sum_abs(x.data(), x.size()), tolerance);
+      // expressions go through the generic path
+      ASSERT_NEAR(norm_1(1. * x), scalar_sum_abs(x.data(), x.size()), tolerance);
+   }
+}
+
+TEST(Norm, Norm2SquaredMatchesScalar) {
+   for (size_t size: {0, 1, 3, 7, 8, 13, 33}) {
+      const Vector<double> x = alternating_vector(size);
+      ASSERT_NEAR(norm_2_squared(x), scalar_dot(x.data(), x.data(), x.size()), tolerance);
+   }
+}
+
+TEST(Norm, NormInfMatchesScalar) {
+   for (size_t size: {0, 1, 3, 7, 8, 13, 33}) {
+      const Vector<double> x = alternating_vector(size);
+      ASSERT_EQ(norm_inf(x), scalar_max_abs(x.data(), x.size()));
+   }
+   const Vector<double> x{-1., 2., -7., 3., 0.5};
+   ASSERT_EQ(norm_inf(x), 7.);
+}
+
+TEST(Norm, Dot) {
+   const Vector<double> x = alternating_vector(13);
+   const Vector<double> y(13, 2.);
+   ASSERT_NEAR(dot(x, y), 2. * scalar_dot(x.data(), Vector<double>(13, 1.).data(), 13), tolerance);
+}
+
+TEST(Norm, FusedNormMatchesMaterializedNorm) {
+   const Vector<double> x = alternating_vector(13);
+   const Vector<double> shift(13, 0.25);
+   for (Norm residual_norm: {Norm::L1, Norm::L2, Norm::L2_SQUARED, Norm::INF}) {
+      // the fused kernel stores the shifted elements while accumulating the norm
+      Vector<double> fused_result(13);
+      const double fused = fused_norm(residual_norm, 13, [&](size_t index) {
+         fused_result[index] = x[index] - shift[index];
+         return fused_result[index];
+      });
+      Vector<double> materialized(13);
+      for (size_t index: Range(13)) {
+         materialized[index] = x[index] - shift[index];
+      }
+      ASSERT_NEAR(fused, norm(residual_norm, materialized), tolerance);
+      for (size_t index: Range(13)) {
+         ASSERT_EQ(fused_result[index], materialized[index]);
+      }
+   }
+}
+
+TEST(Norm, SweepNormMatchesMaterializedNorm) {
+   const Vector<double> x = alternating_vector(13);
+   // the even elements and the odd elements are swept separately (e.g. the lower and upper bounded variables)
+   for (Norm residual_norm: {Norm::L1, Norm::L2, Norm::L2_SQUARED, Norm::INF}) {
+      const double swept = fused_norm(residual_norm, [&](const auto& accumulate) {
+         for (size_t index = 0; index < 13; index += 2) {
+            accumulate(x[index]);
+         }
+         for (size_t index = 1; index < 13; index += 2) {
+            accumulate(x[index]);
+         }
+      });
+      ASSERT_NEAR(swept, norm(residual_norm, x), tolerance);
+   }
+}
+
+TEST(Norm, BoundViolationNormMatchesScalar) {
+   for (size_t size: {0, 1, 3, 7, 8, 13, 33}) {
+      const Vector<double> values = alternating_vector(size);
+      Vector<double> lower_bounds(size), upper_bounds(size);
+      for (size_t index: Range(size)) {
+         // violated lower bounds, violated upper bounds, satisfied and infinite bounds
+         lower_bounds[index] = (index % 3 == 0) ? -INF<double> : 0.5;
+         upper_bounds[index] = (index % 4 == 0) ? INF<double> : 1.;
+      }
+      double sum = 0., sum_squares = 0., maximum = 0.;
+      for (size_t index: Range(size)) {
+         const double violation = scalar_bound_violation(values[index], lower_bounds[index], upper_bounds[index]);
+         sum += violation;
+         sum_squares += violation * violation;
+         maximum = std::max(maximum, violation);
+      }
+      ASSERT_NEAR(bound_violation_norm(Norm::L1, values.data(), lower_bounds.data(), upper_bounds.data(), size), sum, tolerance);
+      ASSERT_NEAR(bound_violation_norm(Norm::L2_SQUARED, values.data(), lower_bounds.data(), upper_bounds.data(), size), sum_squares, tolerance);
+      ASSERT_NEAR(bound_violation_norm(Norm::L2, values.data(), lower_bounds.data(), upper_bounds.data(), size), std::sqrt(sum_squares), tolerance);
+      ASSERT_EQ(bound_violation_norm(Norm::INF, values.data(), lower_bounds.data(), upper_bounds.data(), size), maximum);
+   }
+}
+
+TEST(Norm, BoundViolationNormIgnoresNaN) {
+   const Vector<double> values{std::nan(""), 3., std::nan(""), -2., 0., 0., 0., 0., std::nan("")};
+   const Vector<double> lower_bounds(9, -1.);
+   const Vector<double> upper_bounds(9, 1.);
+   ASSERT_EQ(bound_violation_norm(Norm::L1, values.data(), lower_bounds.data(), upper_bounds.data(), 9), 3.);
+   ASSERT_EQ(bound_violation_norm(Norm::INF, values.data(), lower_bounds.data(), upper_bounds.data(), 9), 2.);
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "ingredients/inequality_handling_methods/interior_point_methods/NormalEquationsSystem.hpp"
+#include "linear_algebra/DenseCholesky.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-12;
+
+TEST(DenseCholesky, Solve) {
+   // A = [4 2; 2 3], b = [2; 1]: x = [0.5; 0]
+   DenseCholesky<double> cholesky(2);
+   cholesky.entry(0, 0) = 4.;
+   cholesky.entry(1, 0) = 2.;
+   cholesky.entry(1, 1) = 3.;
+   ASSERT_TRUE(cholesky.factorize(1e-14));
+   double x[2] = {2., 1.};
+   cholesky.solve(x);
+   ASSERT_NEAR(x[0], 0.5, tolerance);
+   ASSERT_NEAR(x[1], 0., tolerance);
+}
+
+TEST(DenseCholesky, IndefiniteMatrixFails) {
+   DenseCholesky<double> cholesky(2);
+   cholesky.entry(0, 0) = 1.;
+   cholesky.entry(1, 0) = 2.;
+   cholesky.entry(1, 1) = 1.;
+   ASSERT_FALSE(cholesky.factorize(1e-14));
+}
+
+// D = diag(H) + Sigma = diag(2, 2, 4) and J = [1 2 1; 0 1 1]
+TEST(NormalEquationsSystem, SolvesAugmentedSystem) {
+   SymmetricMatrix<size_t, double> hessian(3, 3, false, "COO");
+   hessian.insert(1., 0, 0);
+   hessian.insert(2., 1, 1);
+   Vector<double> barrier_diagonal{1., 0., 4.};
+   RectangularMatrix<double> jacobian(2, 3);
+   jacobian.insert(0, 0, 1.);
+   jacobian.insert(0, 1, 2.);
+   jacobian.insert(0, 2, 1.);
+   jacobian.insert(1, 1, 1.);
+   jacobian.insert(1, 2, 1.);
+   const RectangularMatrixView<double> jacobian_view(jacobian);
+
+   NormalEquationsSystem normal_equations(3, 2);
+   ASSERT_TRUE(normal_equations.assemble_primal_diagonal(hessian, barrier_diagonal, 3));
+   ASSERT_TRUE(normal_equations.factorize(jacobian_view, 2));
+   const Vector<double> rhs{1., 2., 3., 4., 5.};
+   Vector<double> solution(5);
+   normal_equations.solve(jacobian_view, rhs, solution);
+
+   // [D J^T; J 0] [dx; y] = rhs
+   const double D[3] = {2., 2., 4.};
+   const double J[2][3] = {{1., 2., 1.}, {0., 1., 1.}};
+   for (size_t variable_index = 0; variable_index < 3; variable_index++) {
+      const double row = D[variable_index] * solution[variable_index] + J[0][variable_index] * solution[3] + J[1][variable_index] * solution[4];
+      ASSERT_NEAR(row, rhs[variable_index], tolerance);
+   }
+   for (size_t constraint_index = 0; constraint_index < 2; constraint_index++) {
+      double row = 0.;
+      for (size_t variable_index = 0; variable_index < 3; variable_index++) {
+         row += J[constraint_index][variable_index] * solution[variable_index];
+      }
+      ASSERT_NEAR(row, rhs[3 + constraint_index], tolerance);
+   }
+   ASSERT_EQ(normal_equations.get_factorization_statistics().number_factorizations, 1);
+}
+
+TEST(NormalEquationsSystem, RejectsNondiagonalHessian) {
+   SymmetricMatrix<size_t, double> hessian(2, 3, false, "COO");
+   hessian.insert(1., 0, 0);
+   hessian.insert(1., 0, 1);
+   hessian.insert(1., 1, 1);
+   const Vector<double> barrier_diagonal{1., 1.};
+   NormalEquationsSystem normal_equations(2, 1);
+   ASSERT_FALSE(normal_equations.assemble_primal_diagonal(hessian, barrier_diagonal, 2));
+}
+
+TEST(NormalEquationsSystem, RejectsUnknownMode) {
+   Options options = DefaultOptions::load();
+   options["barrier_normal_equations"] = "sometimes";
+   ASSERT_THROW(NormalEquationsSystem::create(4, 1, options), std::invalid_argument);
+   options["barrier_normal_equations"] = "auto";
+   ASSERT_EQ(NormalEquationsSystem::create(4, 3, options), nullptr);
+   ASSERT_NE(NormalEquationsSystem::create(4, 2, options), nullptr);
+}
+
+static Result solve_with_interior_point(const std::string& normal_equations) {
+   Options options = test_options("ipopt");
+   options["linear_solver"] = "dense";
+   options["barrier_normal_equations"] = normal_equations;
+   return solve_reformulated_model(std::make_unique<QuadraticTestModel>(), options);
+}
+
+// the diagonal Hessian of the model lets the interior point method use the normal equations
+TEST(NormalEquationsSystem, InteriorPointMatchesAugmentedSystem) {
+   const Result augmented_result = solve_with_interior_point("no");
+   const Result normal_result = solve_with_interior_point("yes");
+   ASSERT_EQ(augmented_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_EQ(normal_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(normal_result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(normal_result.solution.primals[1], 3., 1e-6);
+   ASSERT_EQ(normal_result.iteration, augmented_result.iteration);
+   // the 2 x 2 normal matrix is cheaper to factorize than the augmented matrix
+   ASSERT_LT(normal_result.factorization_statistics.flops, augmented_result.factorization_statistics.flops);
+}
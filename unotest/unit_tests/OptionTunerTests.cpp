@@ -0,0 +1,132 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "options/Options.hpp"
+#include "tools/OptionTuner.hpp"
+
+using namespace uno;
+
+namespace {
+   // synthetic training set: the number of iterations on model k is minimal for TR_radius = 10. The preset ipopt fails on the odd models
+   struct SyntheticEvaluator {
+      size_t number_solves{0};
+
+      std::vector<BenchmarkRecord> operator()(const std::string& configuration_name, const Options& parameters, size_t number_models) {
+         const double radius = parameters.get_double("TR_radius");
+         const bool is_ipopt = (parameters.get_string("preset") == "ipopt");
+         std::vector<BenchmarkRecord> records{};
+         for (size_t model_index = 0; model_index < number_models; model_index++) {
+            const size_t iterations = 10 + static_cast<size_t>(10. * std::abs(std::log10(radius) - 1.)) + model_index;
+            const bool solved = !(is_ipopt && model_index % 2 == 1);
+            records.push_back({"model" + std::to_string(model_index), configuration_name, "", "", solved, iterations, iterations, 0, 0.});
+            this->number_solves++;
+         }
+         return records;
+      }
+   };
+
+   const std::string search_space_file = "# trust-region radius and preset\n"
+                                         "TR_radius 0.01:1000:log\n"
+                                         "\n"
+                                         "preset filtersqp|ipopt\n";
+}
+
+TEST(OptionTuner, SearchSpace) {
+   std::istringstream stream(search_space_file);
+   const std::vector<TunedParameter> search_space = OptionTuner::read_search_space(stream);
+   ASSERT_EQ(search_space.size(), 2);
+   ASSERT_EQ(search_space[0].name, "TR_radius");
+   ASSERT_EQ(search_space[0].lower_bound, 0.01);
+   ASSERT_EQ(search_space[0].upper_bound, 1000.);
+   ASSERT_TRUE(search_space[0].is_logarithmic);
+   ASSERT_FALSE(search_space[0].is_integer);
+   ASSERT_EQ(search_space[1].values, (std::vector<std::string>{"filtersqp", "ipopt"}));
+
+   ASSERT_THROW(static_cast<void>(TunedParameter::from_line("TR_radius")), std::invalid_argument);
+   ASSERT_THROW(static_cast<void>(TunedParameter::from_line("TR_radius 10:1")), std::invalid_argument);
+   ASSERT_THROW(static_cast<void>(TunedParameter::from_line("TR_radius 0:1:log")), std::invalid_argument);
+   ASSERT_THROW(static_cast<void>(TunedParameter::from_line("TR_radius 1:10:cubic")), std::invalid_argument);
+}
+
+TEST(OptionTuner, Sampling) {
+   std::mt19937 generator(0);
+   const TunedParameter integer_parameter = TunedParameter::from_line("LBFGS_memory_size 3:20:int");
+   const TunedParameter logarithmic_parameter = TunedParameter::from_line("TR_radius 0.01:1000:log");
+   for (size_t sample_index = 0; sample_index < 100; sample_index++) {
+      const int integer_value = std::stoi(integer_parameter.sample(generator));
+      ASSERT_TRUE(3 <= integer_value && integer_value <= 20);
+      const double value = std::stod(logarithmic_parameter.sample(generator));
+      ASSERT_TRUE(0.01 <= value && value <= 1000.);
+   }
+}
+
+TEST(OptionTuner, Score) {
+   const std::vector<BenchmarkRecord> records{
+      {"model0", "configuration", "", "", true, 0, 10, 0, 0.},
+      {"model1", "configuration", "", "", true, 0, 30, 0, 0.},
+      {"model2", "configuration", "", "", false, 0, 1000, 0, 0.}
+   };
+   const TuningScore score = OptionTuner::score(records, BenchmarkMetric::EVALUATIONS);
+   ASSERT_EQ(score.number_failures, 1);
+   // shifted geometric mean (shift 10) of 10 and 30
+   ASSERT_NEAR(score.metric_mean, std::sqrt(20. * 40.) - 10., 1e-12);
+   // the number of unsolved models is compared first
+   ASSERT_TRUE((TuningScore{0, 100.}) < (TuningScore{1, 1.}));
+   ASSERT_TRUE((TuningScore{1, 1.}) < (TuningScore{1, 2.}));
+}
+
+TEST(OptionTuner, RandomSearch) {
+   std::istringstream stream(search_space_file);
+   OptionTuner tuner(OptionTuner::read_search_space(stream), BenchmarkMetric::ITERATIONS, TuningStrategy::RANDOM, 20, 1);
+   SyntheticEvaluator evaluator{};
+   const TunedConfiguration best_configuration = tuner.tune(10, std::ref(evaluator));
+   ASSERT_EQ(evaluator.number_solves, 20 * 10);
+   ASSERT_EQ(best_configuration.number_models, 10);
+   ASSERT_EQ(best_configuration.parameters.at("preset"), "filtersqp");
+   ASSERT_EQ(best_configuration.score.number_failures, 0);
+   for (const TunedConfiguration& configuration: tuner.get_history()) {
+      ASSERT_FALSE(configuration.score < best_configuration.score);
+   }
+}
+
+TEST(OptionTuner, SuccessiveHalving) {
+   std::istringstream stream(search_space_file);
+   OptionTuner tuner(OptionTuner::read_search_space(stream), BenchmarkMetric::ITERATIONS, TuningStrategy::SUCCESSIVE_HALVING, 27, 1);
+   SyntheticEvaluator evaluator{};
+   const TunedConfiguration best_configuration = tuner.tune(27, std::ref(evaluator));
+   // rungs of 27, 9 and 3 configurations on 1, 3 and 9 models, then the winner on the 27 models
+   ASSERT_EQ(evaluator.number_solves, 27 * 1 + 9 * 3 + 3 * 9 + 27);
+   ASSERT_EQ(best_configuration.number_models, 27);
+   ASSERT_EQ(best_configuration.score.number_failures, 0);
+   ASSERT_NEAR(std::log10(std::stod(best_configuration.parameters.at("TR_radius"))), 1., 0.5);
+}
+
+TEST(OptionTuner, WriteOptionFile) {
+   TunedConfiguration configuration{"tuned_0", {{"preset", "filtersqp"}, {"TR_radius", "12.5"}}, {0, 15.}, 10};
+   const std::string file_name = "uno_option_tuner_test.opt";
+   {
+      std::ofstream file(file_name);
+      OptionTuner::write_option_file(file, configuration);
+   }
+   const Options options = Options::load_option_file(file_name);
+   std::remove(file_name.c_str());
+   ASSERT_EQ(options.get_string("TR_radius"), "12.5");
+   ASSERT_EQ(options.get_string("preset"), "filtersqp");
+   // the options of the preset are written too
+   ASSERT_EQ(options.get_string("globalization_strategy"), "fletcher_filter_method");
+}
+
+TEST(OptionTuner, InvalidSettings) {
+   ASSERT_THROW(OptionTuner({}, BenchmarkMetric::ITERATIONS, TuningStrategy::RANDOM, 10, 0), std::invalid_argument);
+   ASSERT_THROW(static_cast<void>(OptionTuner::strategy_from_string("bayesian")), std::invalid_argument);
+   ASSERT_THROW(static_cast<void>(benchmark_metric_from_string("memory")), std::invalid_argument);
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include "ingredients/subproblem_solvers/OrderingCache.hpp"
+
+using namespace uno;
+
+TEST(OrderingCache, PatternKey) {
+   const std::vector<int> row_indices{1, 1, 2, 3};
+   const std::vector<int> column_indices{1, 2, 2, 3};
+   const std::vector<int> other_column_indices{1, 3, 2, 3};
+   const size_t key = OrderingCache::pattern_key(3, 4, row_indices.data(), column_indices.data());
+   ASSERT_EQ(key, OrderingCache::pattern_key(3, 4, row_indices.data(), column_indices.data()));
+   ASSERT_NE(key, OrderingCache::pattern_key(3, 4, row_indices.data(), other_column_indices.data()));
+   ASSERT_NE(key, OrderingCache::pattern_key(4, 4, row_indices.data(), column_indices.data()));
+}
+
+TEST(OrderingCache, FindAndInsert) {
+   OrderingCache cache(2);
+   ASSERT_EQ(cache.find(0), nullptr);
+   cache.insert(0, {3, 1, 2});
+   const std::vector<int>* pivot_order = cache.find(0);
+   ASSERT_NE(pivot_order, nullptr);
+   ASSERT_EQ(*pivot_order, (std::vector<int>{3, 1, 2}));
+}
+
+TEST(OrderingCache, Eviction) {
+   OrderingCache cache(2);
+   cache.insert(0, {1});
+   cache.insert(1, {1, 2});
+   cache.insert(2, {1, 2, 3});
+   ASSERT_EQ(cache.size(), 2);
+   ASSERT_EQ(cache.find(0), nullptr);
+   ASSERT_NE(cache.find(1), nullptr);
+   ASSERT_NE(cache.find(2), nullptr);
+}
+
+TEST(OrderingCache, Disabled) {
+   OrderingCache cache(0);
+   cache.insert(0, {1});
+   ASSERT_EQ(cache.size(), 0);
+   ASSERT_EQ(cache.find(0), nullptr);
+}
+
+TEST(OrderingCache, OrderingFromString) {
+   ASSERT_EQ(fill_reducing_ordering_from_string("METIS"), FillReducingOrdering::METIS);
+   ASSERT_EQ(fill_reducing_ordering_from_string("user"), FillReducingOrdering::USER);
+   ASSERT_THROW(static_cast<void>(fill_reducing_ordering_from_string("unknown")), std::invalid_argument);
+}
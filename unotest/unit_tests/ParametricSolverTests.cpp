@@ -0,0 +1,146 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "ParametricSolver.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "tools/Infinity.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+static Options sqp_options() {
+   Options options = test_options("filtersqp");
+   // the trust region does not require a linear solver
+   options["globalization_mechanism"] = "TR";
+   // a small radius: the solves from scratch take several iterations
+   options["TR_radius"] = "0.5";
+   return options;
+}
+
+static Options interior_point_options() {
+   Options options = test_options("ipopt");
+   options["linear_solver"] = "dense";
+   return options;
+}
+
+// reference: the whole solver is created for the parameter b (upper bound of the constraint x0 + x1 <= b) and the objective
+// coefficient a
+static Result solve_from_scratch(double parameter, const Options& options, double objective_coefficient = 1.) {
+   auto quadratic_model = std::make_unique<QuadraticTestModel>();
+   quadratic_model->set_parameter(parameter);
+   quadratic_model->set_objective_coefficient(objective_coefficient);
+   return solve_reformulated_model(std::move(quadratic_model), options);
+}
+
+// the solutions of the sweep b = 6.75, 6.25, ..., 1.75 are those of the solves from scratch (b = 5, where the constraint becomes
+// weakly active, is avoided). Returns the numbers of iterations of the
+// re-solves (the first solve excluded) of the parametric solver and of the solves from scratch
+static std::pair<size_t, size_t> test_parameter_sweep(const Options& options, const Options& reference_options) {
+   ParametricSolver solver(std::make_unique<QuadraticTestModel>(), options);
+   size_t resolve_iterations = 0;
+   size_t reference_iterations = 0;
+   for (size_t step = 0; step <= 10; step++) {
+      const double parameter = 6.75 - 0.5 * static_cast<double>(step);
+      solver.update_parameters({{}, {{0, -INF<double>, parameter}}, false});
+      const Result result = solver.resolve();
+      const Result reference = solve_from_scratch(parameter, reference_options);
+      EXPECT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+      EXPECT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+      EXPECT_NEAR(result.solution.primals[0], reference.solution.primals[0], 1e-6);
+      EXPECT_NEAR(result.solution.primals[1], reference.solution.primals[1], 1e-6);
+      EXPECT_NEAR(result.solution.evaluations.objective, reference.solution.evaluations.objective, 1e-6);
+      if (0 < step) {
+         resolve_iterations += result.iteration;
+         reference_iterations += reference.iteration;
+      }
+   }
+   EXPECT_EQ(solver.get_number_solves(), 11);
+   return {resolve_iterations, reference_iterations};
+}
+
+// the objective coefficient a (a Hessian and gradient coefficient) is modified in place between the solves: the derivatives
+// evaluated by the previous solve are discarded, and the solutions are those of the solves from scratch
+static void test_coefficient_sweep(const Options& options, const Options& reference_options) {
+   auto quadratic_model = std::make_unique<QuadraticTestModel>();
+   QuadraticTestModel& original_model = *quadratic_model;
+   ParametricSolver solver(std::move(quadratic_model), options);
+   for (const double objective_coefficient: {1., 10., 0.5, 3.}) {
+      original_model.set_objective_coefficient(objective_coefficient);
+      solver.update_parameters({{}, {}, true});
+      const Result result = solver.resolve();
+      const Result reference = solve_from_scratch(7., reference_options, objective_coefficient);
+      EXPECT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+      EXPECT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+      EXPECT_NEAR(result.solution.primals[0], reference.solution.primals[0], 1e-6);
+      EXPECT_NEAR(result.solution.primals[1], reference.solution.primals[1], 1e-6);
+      EXPECT_NEAR(result.solution.evaluations.objective, reference.solution.evaluations.objective, 1e-6);
+   }
+}
+
+TEST(ParametricSolver, TrustRegionFilterSQPSweep) {
+   const Options options = sqp_options();
+   const auto [resolve_iterations, reference_iterations] = test_parameter_sweep(options, options);
+   // the previous solution is close to the next one
+   ASSERT_LT(resolve_iterations, reference_iterations);
+}
+
+TEST(ParametricSolver, InteriorPointSweep) {
+   Options options = interior_point_options();
+   options["barrier_warm_start"] = "yes";
+   const auto [resolve_iterations, reference_iterations] = test_parameter_sweep(options, interior_point_options());
+   // the warm start begins with a small barrier parameter near the previous solution
+   ASSERT_LT(resolve_iterations, reference_iterations);
+}
+
+TEST(ParametricSolver, TrustRegionFilterSQPCoefficientSweep) {
+   test_coefficient_sweep(sqp_options(), sqp_options());
+}
+
+TEST(ParametricSolver, CachedEvaluationsCoefficientSweep) {
+   // the cached evaluations of the previous coefficient are discarded
+   Options options = sqp_options();
+   options["evaluation_cache_size"] = "4";
+   test_coefficient_sweep(options, sqp_options());
+}
+
+TEST(ParametricSolver, InteriorPointCoefficientSweep) {
+   // the QP has a constant Jacobian and a constant Hessian
+   Options options = interior_point_options();
+   options["barrier_warm_start"] = "yes";
+   test_coefficient_sweep(options, interior_point_options());
+   test_coefficient_sweep(interior_point_options(), interior_point_options());
+}
+
+TEST(ParametricSolver, VariableBoundsSweep) {
+   ParametricSolver solver(std::make_unique<QuadraticTestModel>(), sqp_options());
+   // x0 <= u: for u >= 2, the solution (2, 3) of the nominal problem
+   for (const double upper_bound: {3., 2., 1., 0.5}) {
+      solver.update_parameters({{{0, 0., upper_bound}}, {}, false});
+      const Result result = solver.resolve();
+      ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+      // x0 = min(u, 2) and x1 = (4 + x0) / 2
+      const double expected_x0 = std::min(upper_bound, 2.);
+      ASSERT_NEAR(result.solution.primals[0], expected_x0, 1e-6);
+      ASSERT_NEAR(result.solution.primals[1], (4. + expected_x0) / 2., 1e-6);
+   }
+}
+
+// the reformulations depend on the fixed variables and on the equality constraints
+TEST(ParametricSolver, StructuralChangesAreRejected) {
+   ParametricSolver solver(std::make_unique<QuadraticTestModel>(), interior_point_options());
+   ASSERT_THROW(solver.update_parameters({{{0, 1., 1.}}, {}, false}), std::invalid_argument);
+   ASSERT_THROW(solver.update_parameters({{}, {{1, 4., 4.}}, false}), std::invalid_argument);
+   ASSERT_THROW(solver.update_parameters({{{2, 0., 1.}}, {}, false}), std::invalid_argument);
+   ASSERT_THROW(solver.update_parameters({{}, {{2, 0., 1.}}, false}), std::invalid_argument);
+   // the rejected changes were not applied
+   const Result result = solver.resolve();
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "Portfolio.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+
+using namespace uno;
+
+static Options portfolio_options(const std::string& presets) {
+   Options options = DefaultOptions::load();
+   options["QP_solver"] = "GoldfarbIdnani";
+   options["logger"] = "SILENT";
+   options["portfolio_presets"] = presets;
+   options["portfolio_threads"] = "2";
+   return options;
+}
+
+TEST(Portfolio, RecordsTheWinningPreset) {
+   const Options options = portfolio_options("filtersqp,funnelsqp");
+   const QuadraticTestModel model;
+   Portfolio portfolio(options);
+   const Result result = portfolio.solve(model, options);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_TRUE(result.preset == "filtersqp" || result.preset == "funnelsqp");
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+}
+
+TEST(Portfolio, ConvergenceSkipsTheRemainingPresets) {
+   Options options = portfolio_options("filtersqp,ipopt");
+   // on a single thread, the presets are solved in order
+   options["portfolio_threads"] = "1";
+   const QuadraticTestModel model;
+   Portfolio portfolio(options);
+   const Result result = portfolio.solve(model, options);
+   ASSERT_EQ(result.preset, "filtersqp");
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+}
+
+TEST(Portfolio, DeterministicModeKeepsTheFirstConvergedPreset) {
+   Options options = portfolio_options("funnelsqp,filtersqp");
+   options["deterministic"] = "yes";
+   const QuadraticTestModel model;
+   for (size_t repetition = 0; repetition < 5; repetition++) {
+      Portfolio portfolio(options);
+      const Result result = portfolio.solve(model, options);
+      ASSERT_EQ(result.preset, "funnelsqp");
+      ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   }
+}
+
+TEST(Portfolio, UnknownPreset) {
+   const Options options = portfolio_options("filtersqp,unknown");
+   ASSERT_THROW(Portfolio portfolio(options), std::invalid_argument);
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/subproblem_solvers/QPSolver.hpp"
+#include "ingredients/subproblem_solvers/QPSolverFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "preprocessing/Preprocessing.hpp"
+#include "tools/Statistics.hpp"
+#include "QuadraticTestModel.hpp"
+
+using namespace uno;
+
+static void enforce_linear_constraints(const Model& model, Iterate& initial_iterate) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(Presets::get_preset_options("filtersqp"));
+   options["logger"] = "SILENT";
+   options["QP_solver"] = "GoldfarbIdnani";
+   Statistics statistics(options);
+   auto qp_solver = QPSolverFactory::create(model.number_variables, model.number_constraints, model.number_objective_gradient_nonzeros(),
+         model.number_jacobian_nonzeros(), model.number_variables, options);
+   Preprocessing::enforce_linear_constraints(statistics, model, initial_iterate, *qp_solver);
+}
+
+TEST(Preprocessing, LinearConstraintsProjection) {
+   const QuadraticTestModel model;
+   Iterate initial_iterate(model.number_variables, model.number_constraints);
+   // x0 + x1 <= 7 is violated. The projection onto x0 + x1 = 7 violates x1 >= 0, hence (7, 0)
+   initial_iterate.primals = Vector<double>{10., 0.};
+   enforce_linear_constraints(model, initial_iterate);
+   ASSERT_NEAR(initial_iterate.primals[0], 7., 1e-10);
+   ASSERT_NEAR(initial_iterate.primals[1], 0., 1e-10);
+   ASSERT_FALSE(initial_iterate.are_constraints_computed);
+}
+
+TEST(Preprocessing, LinearFeasibleInitialPoint) {
+   const QuadraticTestModel model;
+   Iterate initial_iterate(model.number_variables, model.number_constraints);
+   initial_iterate.primals = Vector<double>{1., 1.};
+   enforce_linear_constraints(model, initial_iterate);
+   // no QP is solved: the point and its constraint evaluations are kept
+   ASSERT_EQ(initial_iterate.primals[0], 1.);
+   ASSERT_EQ(initial_iterate.primals[1], 1.);
+   ASSERT_TRUE(initial_iterate.are_constraints_computed);
+}
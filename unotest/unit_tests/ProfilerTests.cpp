@@ -0,0 +1,43 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "tools/Profiler.hpp"
+
+using namespace uno;
+
+TEST(Profiler, NestedPhases) {
+   Profiler profiler{};
+   {
+      const Profiler::Scope scope(&profiler);
+      for (size_t iteration = 0; iteration < 3; iteration++) {
+         const ScopedTimer globalization_timer("globalization");
+         const ScopedTimer subproblem_timer("subproblem");
+         {
+            const ScopedTimer factorization_timer("numerical factorization");
+         }
+         const ScopedTimer solve_timer("linear solve");
+      }
+      const ScopedTimer evaluation_timer("objective evaluation");
+   }
+   const std::vector<PhaseTiming> phase_timings = profiler.get_phase_timings();
+   ASSERT_EQ(phase_timings.size(), 5);
+   ASSERT_EQ(phase_timings[0].path, "globalization");
+   ASSERT_EQ(phase_timings[0].calls, 3);
+   ASSERT_EQ(phase_timings[1].path, "globalization/subproblem");
+   ASSERT_EQ(phase_timings[2].path, "globalization/subproblem/numerical factorization");
+   ASSERT_EQ(phase_timings[3].path, "globalization/subproblem/linear solve");
+   ASSERT_EQ(phase_timings[3].calls, 3);
+   ASSERT_EQ(phase_timings[4].path, "objective evaluation");
+   ASSERT_EQ(phase_timings[4].calls, 1);
+   ASSERT_LE(phase_timings[1].time, phase_timings[0].time);
+}
+
+TEST(Profiler, NoInstalledProfiler) {
+   Profiler profiler{};
+   {
+      const ScopedTimer timer("globalization");
+   }
+   ASSERT_EQ(Profiler::current(), nullptr);
+   ASSERT_TRUE(profiler.get_phase_timings().empty());
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "RealTimeIteration.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "options/Presets.hpp"
+#include "QuadraticTestModel.hpp"
+
+using namespace uno;
+
+static Options real_time_iteration_options() {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(Presets::get_preset_options("filtersqp"));
+   options["QP_solver"] = "GoldfarbIdnani";
+   options["logger"] = "SILENT";
+   return options;
+}
+
+static Iterate initial_iterate(const Model& model) {
+   Iterate iterate(model.number_variables, model.number_constraints);
+   model.initial_primal_point(iterate.primals);
+   model.initial_dual_point(iterate.multipliers.constraints);
+   return iterate;
+}
+
+// the model is a QP: a full SQP step reaches its solution, including after a change of the bound b
+TEST(RealTimeIteration, FeedbackAfterBoundChange) {
+   const Options options = real_time_iteration_options();
+   QuadraticTestModel model;
+   RealTimeIteration real_time_iteration(model, options);
+   ASSERT_THROW(real_time_iteration.prepare(), std::runtime_error);
+   real_time_iteration.initialize(initial_iterate(model));
+
+   real_time_iteration.prepare();
+   const Iterate& first_iterate = real_time_iteration.feedback();
+   EXPECT_NEAR(first_iterate.primals[0], 2., 1e-8);
+   EXPECT_NEAR(first_iterate.primals[1], 3., 1e-8);
+
+   // new "initial state": the bound b changes between the preparation and the feedback
+   real_time_iteration.prepare();
+   model.set_parameter(3.);
+   const Iterate& second_iterate = real_time_iteration.feedback();
+   EXPECT_NEAR(second_iterate.primals[0], 2. / 3., 1e-8);
+   EXPECT_NEAR(second_iterate.primals[1], 7. / 3., 1e-8);
+   EXPECT_EQ(real_time_iteration.get_number_iterations(), 2);
+}
+
+TEST(RealTimeIteration, ShiftInitialization) {
+   const Options options = real_time_iteration_options();
+   QuadraticTestModel model;
+   RealTimeIteration real_time_iteration(model, options);
+   Iterate iterate = initial_iterate(model);
+   iterate.primals[0] = 1.;
+   iterate.primals[1] = 2.;
+   iterate.multipliers.constraints[0] = -1.;
+   iterate.multipliers.constraints[1] = -2.;
+   real_time_iteration.initialize(iterate);
+
+   real_time_iteration.shift(1, 1);
+   const Iterate& shifted_iterate = real_time_iteration.get_current_iterate();
+   // the last components are duplicated
+   EXPECT_EQ(shifted_iterate.primals[0], 2.);
+   EXPECT_EQ(shifted_iterate.primals[1], 2.);
+   EXPECT_EQ(shifted_iterate.multipliers.constraints[0], -2.);
+   EXPECT_EQ(shifted_iterate.multipliers.constraints[1], -2.);
+   EXPECT_FALSE(shifted_iterate.is_objective_gradient_computed);
+   ASSERT_THROW(real_time_iteration.shift(3, 0), std::invalid_argument);
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+using namespace uno;
+
+static std::vector<std::pair<size_t, double>> row_terms(const RectangularMatrix<double>& matrix, size_t row_index) {
+   std::vector<std::pair<size_t, double>> terms;
+   for (const auto [column_index, element]: matrix[row_index]) {
+      terms.emplace_back(column_index, element);
+   }
+   return terms;
+}
+
+TEST(RectangularMatrix, Empty) {
+   const RectangularMatrix<double> matrix(3, 5);
+   ASSERT_EQ(matrix.number_rows(), 3);
+   ASSERT_EQ(matrix.number_nonzeros(), 0);
+   for (size_t row_index: Range(3)) {
+      ASSERT_TRUE(matrix[row_index].is_empty());
+   }
+}
+
+TEST(RectangularMatrix, InsertInAnyRowOrder) {
+   RectangularMatrix<double> matrix(2, 10);
+   // fill row 0 beyond its initial capacity, then row 1, then append to row 0 again
+   for (size_t column_index: Range(6)) {
+      matrix[0].insert(column_index, static_cast<double>(column_index));
+   }
+   matrix[1].insert(3, -1.);
+   matrix[0].insert(9, 9.);
+   ASSERT_EQ(matrix[0].size(), 7);
+   ASSERT_EQ(matrix[1].size(), 1);
+   ASSERT_EQ(row_terms(matrix, 0).back(), std::make_pair(size_t(9), 9.));
+   ASSERT_EQ(row_terms(matrix, 1).front(), std::make_pair(size_t(3), -1.));
+}
+
+TEST(RectangularMatrix, ClearCompactsLayout) {
+   RectangularMatrix<double> matrix(2, 10);
+   matrix[0].insert(0, 1.);
+   matrix[1].insert(1, 2.);
+   matrix[0].insert(2, 3.);
+   matrix.clear();
+   ASSERT_EQ(matrix.number_nonzeros(), 0);
+   // same sparsity pattern: the rows are stored contiguously, in row order
+   matrix[0].insert(0, 1.);
+   matrix[0].insert(2, 3.);
+   matrix[1].insert(1, 2.);
+   ASSERT_EQ(matrix.row_start(0), 0);
+   ASSERT_EQ(matrix.row_start(1), 2);
+   const std::vector<size_t> reference_column_indices{0, 2, 1};
+   for (size_t index: Range(3)) {
+      ASSERT_EQ(matrix.column_indices_pointer()[index], reference_column_indices[index]);
+   }
+}
+
+TEST(RectangularMatrix, Scale) {
+   RectangularMatrix<double> matrix(1, 2);
+   matrix[0].insert(0, 1.);
+   matrix[0].insert(1, -4.);
+   scale(matrix[0], 0.5);
+   ASSERT_EQ(norm_inf(matrix[0]), 2.);
+}
+
+TEST(RectangularMatrix, JacobianProduct) {
+   // (3, 7, 0)
+   // (0, 1, -2)
+   RectangularMatrix<double> matrix(2, 3);
+   matrix[0].insert(0, 3.);
+   matrix[0].insert(1, 7.);
+   matrix[1].insert(2, -2.);
+   matrix[1].insert(1, 1.);
+   const Vector<double> x{-2., 3., 1.};
+   Vector<double> result(2);
+   jacobian_product(matrix, x, result);
+   ASSERT_EQ(result[0], 15.);
+   ASSERT_EQ(result[1], 1.);
+}
+
+TEST(RectangularMatrix, JacobianTransposedProduct) {
+   RectangularMatrix<double> matrix(2, 3);
+   matrix[0].insert(0, 3.);
+   matrix[0].insert(1, 7.);
+   matrix[1].insert(2, -2.);
+   matrix[1].insert(1, 1.);
+   const Vector<double> y{2., -1.};
+   // the result is overwritten, including the entries beyond the number of columns
+   Vector<double> result(4);
+   result.fill(10.);
+   jacobian_transposed_product(matrix, y, result);
+   const std::vector<double> reference{6., 13., 2., 0.};
+   for (size_t index: Range(4)) {
+      ASSERT_EQ(result[index], reference[index]);
+   }
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/RectangularMatrixView.hpp"
+
+using namespace uno;
+
+static std::vector<std::pair<size_t, double>> row_terms(const RectangularMatrixView<double>& view, size_t row_index) {
+   std::vector<std::pair<size_t, double>> terms;
+   for (const auto [column_index, element]: view[row_index]) {
+      terms.emplace_back(column_index, element);
+   }
+   return terms;
+}
+
+static RectangularMatrix<double> create_matrix() {
+   RectangularMatrix<double> matrix(3, 6);
+   matrix[0].insert(0, 1.);
+   matrix[0].insert(2, 2.);
+   matrix[2].insert(1, 3.);
+   return matrix;
+}
+
+TEST(RectangularMatrixView, NoStructuredColumn) {
+   const RectangularMatrix<double> matrix = create_matrix();
+   const RectangularMatrixView<double> view(matrix);
+   ASSERT_EQ(view.number_rows(), 3);
+   ASSERT_EQ(view.number_nonzeros(), 3);
+   ASSERT_EQ(row_terms(view, 0), (std::vector<std::pair<size_t, double>>{{0, 1.}, {2, 2.}}));
+   ASSERT_TRUE(view[1].is_empty());
+   ASSERT_EQ(row_terms(view, 2), (std::vector<std::pair<size_t, double>>{{1, 3.}}));
+}
+
+TEST(RectangularMatrixView, StructuredColumnsFollowTheMatrixEntries) {
+   const RectangularMatrix<double> matrix = create_matrix();
+   constexpr size_t none = RectangularMatrixView<double>::none;
+   const std::vector<size_t> positive{3, none, 4};
+   const std::vector<size_t> negative{none, 5, none};
+   RectangularMatrixView<double> view(matrix);
+   view.add_structured_column(positive, -1.);
+   view.add_structured_column(negative, 1.);
+   ASSERT_EQ(view.number_nonzeros(), 6);
+   ASSERT_EQ(view[0].size(), 3);
+   ASSERT_EQ(row_terms(view, 0), (std::vector<std::pair<size_t, double>>{{0, 1.}, {2, 2.}, {3, -1.}}));
+   ASSERT_EQ(row_terms(view, 1), (std::vector<std::pair<size_t, double>>{{5, 1.}}));
+   ASSERT_EQ(row_terms(view, 2), (std::vector<std::pair<size_t, double>>{{1, 3.}, {4, -1.}}));
+   // rebinding discards the structured columns
+   view.reset(matrix);
+   ASSERT_EQ(view.number_nonzeros(), 3);
+   ASSERT_TRUE(view[1].is_empty());
+}
+
+TEST(RectangularMatrixView, TooManyStructuredColumns) {
+   const RectangularMatrix<double> matrix = create_matrix();
+   const std::vector<size_t> columns(3, RectangularMatrixView<double>::none);
+   RectangularMatrixView<double> view(matrix);
+   for (size_t index = 0; index < RectangularMatrixView<double>::max_structured_columns; index++) {
+      view.add_structured_column(columns, 1.);
+   }
+   ASSERT_THROW(view.add_structured_column(columns, 1.), std::length_error);
+}
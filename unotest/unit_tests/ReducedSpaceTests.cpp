@@ -0,0 +1,112 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ingredients/inequality_handling_methods/InequalityHandlingMethodFactory.hpp"
+#include "linear_algebra/SparseLU.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-12;
+
+// A = [1 2 0 1; 0 0 3 2; 4 0 1 0] stored by columns
+const std::vector<size_t> column_starts{0, 2, 3, 5, 7};
+const std::vector<size_t> row_indices{0, 2, 0, 1, 2, 0, 1};
+const std::vector<double> values{1., 4., 2., 3., 1., 1., 2.};
+
+TEST(SparseLU, SolvesBasisSystems) {
+   SparseLU<double> factorization(3);
+   const std::vector<size_t> candidate_columns{0, 1, 2, 3};
+   ASSERT_EQ(factorization.factorize(3, column_starts, row_indices, values, candidate_columns, 1e-10), 3);
+   const std::vector<size_t> expected_basis{0, 1, 2};
+   ASSERT_EQ(factorization.get_basic_columns(), expected_basis);
+   // B = [1 2 0; 0 0 3; 4 0 1]
+   const double B[3][3] = {{1., 2., 0.}, {0., 0., 3.}, {4., 0., 1.}};
+   const double rhs[3] = {1., 2., 3.};
+   double solution[3];
+   factorization.solve(rhs, solution);
+   for (size_t row = 0; row < 3; row++) {
+      ASSERT_NEAR(B[row][0] * solution[0] + B[row][1] * solution[1] + B[row][2] * solution[2], rhs[row], tolerance);
+   }
+   factorization.solve_transpose(rhs, solution);
+   for (size_t column = 0; column < 3; column++) {
+      ASSERT_NEAR(B[0][column] * solution[0] + B[1][column] * solution[1] + B[2][column] * solution[2], rhs[column], tolerance);
+   }
+}
+
+TEST(SparseLU, SkipsDependentColumns) {
+   // the second column is twice the first column: it is skipped
+   const std::vector<size_t> dependent_starts{0, 2, 4, 6};
+   const std::vector<size_t> dependent_rows{0, 2, 0, 2, 0, 1};
+   const std::vector<double> dependent_values{1., 4., 2., 8., 1., 3.};
+   SparseLU<double> factorization(3);
+   const std::vector<size_t> candidate_columns{0, 1, 2};
+   ASSERT_EQ(factorization.factorize(3, dependent_starts, dependent_rows, dependent_values, candidate_columns, 1e-10), 2);
+   const std::vector<size_t> expected_basis{0, 2};
+   ASSERT_EQ(factorization.get_basic_columns(), expected_basis);
+}
+
+// counts the requests of the Hessian sparsity
+class HessianSparsityCountingModel: public QuadraticTestModel {
+public:
+   mutable size_t number_sparsity_requests{0};
+
+   [[nodiscard]] size_t number_hessian_nonzeros() const override {
+      this->number_sparsity_requests++;
+      return QuadraticTestModel::number_hessian_nonzeros();
+   }
+};
+
+static Result solve_in_reduced_space(const std::string& globalization_mechanism,
+      std::unique_ptr<Model> original_model = std::make_unique<QuadraticTestModel>()) {
+   Options options = test_options("filtersqp");
+   options["subproblem"] = "reduced_space";
+   options["globalization_mechanism"] = globalization_mechanism;
+   return solve_reformulated_model(std::move(original_model), options);
+}
+
+// the inequality constraints are reformulated with slacks: 4 variables, 2 equality constraints and 2 degrees of freedom
+TEST(ReducedSpaceSubproblem, SolvesWithLineSearch) {
+   const Result result = solve_in_reduced_space("LS");
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+   ASSERT_EQ(result.hessian_evaluations, 0);
+}
+
+TEST(ReducedSpaceSubproblem, SolvesWithTrustRegion) {
+   const Result result = solve_in_reduced_space("TR");
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+}
+
+// the reduced-space method approximates the reduced Hessian: the Hessian sparsity of the model is never requested
+TEST(ReducedSpaceSubproblem, DoesNotRequestHessianSparsity) {
+   auto model = std::make_unique<HessianSparsityCountingModel>();
+   const HessianSparsityCountingModel& counting_model = *model;
+   const Result result = solve_in_reduced_space("LS", std::move(model));
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_EQ(counting_model.number_sparsity_requests, 0);
+
+   Options options = DefaultOptions::load();
+   options["subproblem"] = "reduced_space";
+   ASSERT_FALSE(InequalityHandlingMethodFactory::uses_lagrangian_hessian(2, options));
+   options["subproblem"] = "LP";
+   ASSERT_FALSE(InequalityHandlingMethodFactory::uses_lagrangian_hessian(2, options));
+   options["subproblem"] = "QP";
+   ASSERT_TRUE(InequalityHandlingMethodFactory::uses_lagrangian_hessian(2, options));
+   options["hessian_model"] = "zero";
+   ASSERT_FALSE(InequalityHandlingMethodFactory::uses_lagrangian_hessian(2, options));
+   options["subproblem"] = "primal_dual_interior_point";
+   ASSERT_TRUE(InequalityHandlingMethodFactory::uses_lagrangian_hessian(2, options));
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "model/ReorderedModel.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "preprocessing/Reordering.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+TEST(Reordering, ReverseCuthillMcKeeOfScrambledPath) {
+   // path 0 - 4 - 2 - 5 - 1 - 3 (bandwidth 4 in the original numbering)
+   const std::vector<size_t> path{0, 4, 2, 5, 1, 3};
+   std::vector<std::vector<size_t>> neighbors(path.size());
+   for (size_t index = 0; index + 1 < path.size(); index++) {
+      neighbors[path[index]].emplace_back(path[index + 1]);
+      neighbors[path[index + 1]].emplace_back(path[index]);
+   }
+   std::vector<size_t> adjacency_starts{0}, adjacency{};
+   for (const std::vector<size_t>& node_neighbors: neighbors) {
+      adjacency.insert(adjacency.end(), node_neighbors.begin(), node_neighbors.end());
+      adjacency_starts.emplace_back(adjacency.size());
+   }
+   const std::vector<size_t> identity{0, 1, 2, 3, 4, 5};
+   ASSERT_EQ(Reordering::compute_bandwidth(adjacency_starts, adjacency, identity), 4);
+
+   const std::vector<size_t> order = Reordering::reverse_cuthill_mckee(adjacency_starts, adjacency);
+   ASSERT_EQ(order.size(), path.size());
+   std::vector<size_t> positions(order.size());
+   for (size_t position: Range(order.size())) {
+      positions[order[position]] = position;
+   }
+   ASSERT_EQ(Reordering::compute_bandwidth(adjacency_starts, adjacency, positions), 1);
+}
+
+TEST(Reordering, PermutedEvaluations) {
+   // the variables and the constraints are swapped
+   const ReorderedModel model(std::make_unique<QuadraticTestModel>(), ModelOrdering{{1, 0}, {1, 0}});
+   ASSERT_EQ(model.variable_upper_bound(0), 4.);
+   ASSERT_EQ(model.constraint_upper_bound(1), 7.);
+   ASSERT_EQ(model.get_single_lower_bounded_variables().size(), 1);
+   ASSERT_EQ(*model.get_single_lower_bounded_variables().begin(), 1);
+
+   const Vector<double> x{3., 2.};
+   ASSERT_EQ(model.evaluate_objective(x), 4. + 36. - 96.);
+   std::vector<double> constraints(2);
+   model.evaluate_constraints(x, constraints);
+   ASSERT_EQ(constraints[0], 4.);
+   ASSERT_EQ(constraints[1], 5.);
+   RectangularMatrix<double> jacobian(2, 2);
+   model.evaluate_constraint_jacobian(x, jacobian);
+   // row 0 is -x0 + 2 x1 of the original model: 2 y0 - y1
+   for (const auto [variable_index, derivative]: jacobian[0]) {
+      ASSERT_EQ(derivative, (variable_index == 0) ? 2. : -1.);
+   }
+   SymmetricMatrix<size_t, double> hessian(2, 2, false, "COO");
+   model.evaluate_lagrangian_hessian(x, 1., Vector<double>{0., 0.}, hessian);
+   hessian.for_each([](size_t row_index, size_t column_index, double entry) {
+      ASSERT_EQ(row_index, column_index);
+      ASSERT_EQ(entry, (row_index == 0) ? 8. : 2.);
+   });
+}
+
+TEST(Reordering, SolutionIsPermutedBack) {
+   const ReorderedModel model(std::make_unique<QuadraticTestModel>(), ModelOrdering{{1, 0}, {1, 0}});
+   const Result result = solve_model(model, test_options("filtersqp"));
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+   // only the second constraint -x0 + 2 x1 <= 4 is active
+   ASSERT_NEAR(result.solution.multipliers.constraints[0], 0., 1e-6);
+   ASSERT_NEAR(result.solution.multipliers.constraints[1], -4., 1e-6);
+}
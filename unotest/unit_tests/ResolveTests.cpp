@@ -0,0 +1,142 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <utility>
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+// solving a modified model with a fresh solver and with a reused solver gives the same iterates
+static void test_resolve(const std::string& preset) {
+   Options options = test_options(preset);
+   // the trust region does not require a linear solver
+   options["globalization_mechanism"] = "TR";
+
+   // reference: new solver for the parameter value 3
+   QuadraticTestModel reference_model;
+   reference_model.set_parameter(3.);
+   const Result reference = solve_model(reference_model, options);
+
+   // solve for the parameter value 7, then re-solve for the parameter value 3 with the same solver
+   QuadraticTestModel model;
+   TestSolver solver(model, options);
+   const Result first_result = solver.solve();
+   ASSERT_EQ(first_result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_NEAR(first_result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(first_result.solution.primals[1], 3., 1e-6);
+
+   model.set_parameter(3.);
+   Iterate new_initial_iterate = solver.initial_iterate();
+   const Result result = solver.uno.resolve(model, new_initial_iterate, options);
+   ASSERT_EQ(result.optimization_status, reference.optimization_status);
+   ASSERT_EQ(result.iteration, reference.iteration);
+   ASSERT_EQ(result.objective_evaluations, reference.objective_evaluations);
+   ASSERT_EQ(result.number_subproblems_solved, reference.number_subproblems_solved);
+   ASSERT_NEAR(result.solution.primals[0], reference.solution.primals[0], 1e-10);
+   ASSERT_NEAR(result.solution.primals[1], reference.solution.primals[1], 1e-10);
+}
+
+TEST(Resolve, TrustRegionFilterMethod) {
+   test_resolve("filtersqp");
+}
+
+TEST(Resolve, TrustRegionFunnelMethod) {
+   test_resolve("funnelsqp");
+}
+
+TEST(Resolve, TrustRegionl1Relaxation) {
+   test_resolve("byrd");
+}
+
+// the bounds of the slacks (the constraint bounds of the original model) change between the solves: the interior point method does
+// not reuse the bounds flattened by the previous solve
+TEST(Resolve, InteriorPointMethodAfterBoundChange) {
+   Options options = test_options("ipopt");
+   options["linear_solver"] = "dense";
+
+   auto quadratic_model = std::make_unique<QuadraticTestModel>();
+   QuadraticTestModel& original_model = *quadratic_model;
+   const std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(quadratic_model), options);
+   TestSolver solver(*model, options);
+   const Result first_result = solver.solve();
+   ASSERT_EQ(first_result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_NEAR(first_result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(first_result.solution.primals[1], 3., 1e-6);
+
+   // x0 + x1 <= 3: the solution is (2/3, 7/3)
+   original_model.set_parameter(3.);
+   // the reformulations recompute the bounds of the slacks
+   model->refresh();
+   Iterate new_initial_iterate = solver.initial_iterate();
+   const Result result = solver.uno.resolve(*model, new_initial_iterate, options);
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], 2. / 3., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 7. / 3., 1e-6);
+}
+
+// the contiguous copy of the constraint bounds follows the modifications of the model
+TEST(Resolve, MaterializedConstraintBounds) {
+   QuadraticTestModel model;
+   const std::vector<double> constraints{5., 6.};
+   // generic evaluation (bounds not materialized): violations (0, 2)
+   ASSERT_EQ(model.constraint_violation(constraints, Norm::L1), 2.);
+   model.materialize_constraint_bounds();
+   ASSERT_EQ(model.constraint_violation(constraints, Norm::L1), 2.);
+   model.set_parameter(3.);
+   model.materialize_constraint_bounds();
+   ASSERT_EQ(model.constraint_violation(constraints, Norm::L1), 4.);
+   ASSERT_EQ(model.constraint_violation(constraints, Norm::INF), 2.);
+}
+
+// the perturbed problem (x0 + x1 <= 7.1) is re-solved from the primal-dual solution of the first problem: the warm-started interior
+// point method requires fewer iterations than a cold start, and the bound multipliers keep their signs
+TEST(Resolve, InteriorPointMethodWarmStart) {
+   Options cold_options = test_options("ipopt");
+   cold_options["linear_solver"] = "dense";
+   Options warm_options = cold_options;
+   warm_options["barrier_warm_start"] = "yes";
+
+   auto quadratic_model = std::make_unique<QuadraticTestModel>();
+   QuadraticTestModel& original_model = *quadratic_model;
+   const std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(quadratic_model), cold_options);
+   TestSolver cold_solver(*model, cold_options);
+   const Result first_result = cold_solver.solve();
+   ASSERT_EQ(first_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+
+   original_model.set_parameter(7.1);
+   model->refresh();
+   Iterate cold_initial_iterate = cold_solver.initial_iterate();
+   const Result cold_result = cold_solver.uno.resolve(*model, cold_initial_iterate, cold_options);
+   ASSERT_EQ(cold_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+
+   // the bound multipliers of the warm start are those of the initial iterate
+   TestSolver warm_solver(*model, warm_options);
+   Iterate warm_initial_iterate = warm_solver.initial_iterate(first_result.solution.primals);
+   warm_initial_iterate.multipliers.constraints = first_result.solution.multipliers.constraints;
+   warm_initial_iterate.multipliers.lower_bounds = first_result.solution.multipliers.lower_bounds;
+   warm_initial_iterate.multipliers.upper_bounds = first_result.solution.multipliers.upper_bounds;
+   const Result warm_result = warm_solver.uno.solve(*model, warm_initial_iterate, warm_options);
+   ASSERT_EQ(warm_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_LT(warm_result.iteration, cold_result.iteration);
+   for (size_t variable_index: Range(model->number_variables)) {
+      ASSERT_NEAR(warm_result.solution.primals[variable_index], cold_result.solution.primals[variable_index], 1e-6) << variable_index;
+      ASSERT_LE(0., warm_result.solution.multipliers.lower_bounds[variable_index]) << variable_index;
+      ASSERT_LE(warm_result.solution.multipliers.upper_bounds[variable_index], 0.) << variable_index;
+      // the active bounds remain active
+      if (1e-6 < first_result.solution.multipliers.lower_bounds[variable_index]) {
+         ASSERT_LT(1e-6, warm_result.solution.multipliers.lower_bounds[variable_index]) << variable_index;
+      }
+      if (first_result.solution.multipliers.upper_bounds[variable_index] < -1e-6) {
+         ASSERT_LT(warm_result.solution.multipliers.upper_bounds[variable_index], -1e-6) << variable_index;
+      }
+   }
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "model/EvaluationScaling.hpp"
+#include "model/ScaledModel.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+namespace {
+   class UserScaledTestModel: public QuadraticTestModel {
+   public:
+      [[nodiscard]] bool get_user_variable_scaling(Vector<double>& scaling_factors) const override {
+         scaling_factors[0] = 0.5;
+         scaling_factors[1] = 2.;
+         return true;
+      }
+   };
+
+   // records the factors passed down with the Jacobian evaluations
+   class ScalingRecordingTestModel: public QuadraticTestModel {
+   public:
+      mutable size_t number_scaled_evaluations{0};
+      mutable EvaluationScaling received_scaling{};
+
+      void evaluate_scaled_constraint_jacobian(const Vector<double>& x, const EvaluationScaling& scaling,
+            RectangularMatrix<double>& constraint_jacobian) const override {
+         this->number_scaled_evaluations++;
+         this->received_scaling = scaling;
+         QuadraticTestModel::evaluate_scaled_constraint_jacobian(x, scaling, constraint_jacobian);
+      }
+   };
+} // namespace
+
+TEST(ScaledModel, AutomaticVariableScaling) {
+   Options options = DefaultOptions::load();
+   options["scale_variables"] = "automatic";
+   const ScaledModel model(std::make_unique<QuadraticTestModel>(), options);
+   // x0 is unbounded above and initialized at 0: not scaled. x1 ∈ [0, 4]: scaled by 4
+   ASSERT_EQ(model.get_variable_scaling(0), 1.);
+   ASSERT_EQ(model.get_variable_scaling(1), 4.);
+   ASSERT_EQ(model.variable_upper_bound(1), 1.);
+
+   // evaluations at x~ = (1, 0.5), that is x = (1, 2)
+   const Vector<double> x{1., 0.5};
+   ASSERT_EQ(model.evaluate_objective(x), 1. + 16. - 64.);
+   SparseVector<double> gradient(2);
+   model.evaluate_objective_gradient(x, gradient);
+   ASSERT_EQ(gradient.get(0), 2.);
+   ASSERT_EQ(gradient.get(1), 4. * (16. - 32.));
+   RectangularMatrix<double> jacobian(2, 2);
+   model.evaluate_constraint_jacobian(x, jacobian);
+   // second constraint: (-1, 2) scaled by (1, 4)
+   ASSERT_EQ(jacobian.data_pointer()[jacobian.row_start(1)], -1.);
+   ASSERT_EQ(jacobian.data_pointer()[jacobian.row_start(1) + 1], 8.);
+   SymmetricMatrix<size_t, double> hessian(2, 2, false, "COO");
+   model.evaluate_lagrangian_hessian(x, 1., Vector<double>{0., 0.}, hessian);
+   Vector<double> product(2);
+   model.evaluate_lagrangian_hessian_vector_product(x, 1., Vector<double>{0., 0.}, Vector<double>{1., 1.}, product);
+   ASSERT_EQ(product[0], 2.);
+   ASSERT_EQ(product[1], 128.);
+   hessian.for_each([](size_t row_index, size_t /*column_index*/, double entry) {
+      ASSERT_EQ(entry, (row_index == 0) ? 2. : 128.);
+   });
+}
+
+TEST(ScaledModel, PassesScalingToEvaluations) {
+   Options options = DefaultOptions::load();
+   options["scale_variables"] = "automatic";
+   auto original_model = std::make_unique<ScalingRecordingTestModel>();
+   const ScalingRecordingTestModel& recording_model = *original_model;
+   const ScaledModel model(std::move(original_model), options);
+   const Vector<double> x{1., 0.5};
+   RectangularMatrix<double> jacobian(2, 2);
+   model.evaluate_constraint_jacobian(x, jacobian);
+   // the original model scales its own Jacobian: no pass over the output in the scaled model
+   ASSERT_EQ(recording_model.number_scaled_evaluations, 1);
+   ASSERT_EQ(recording_model.received_scaling.variable(1), 4.);
+   ASSERT_EQ(jacobian.data_pointer()[jacobian.row_start(1)], -1.);
+   ASSERT_EQ(jacobian.data_pointer()[jacobian.row_start(1) + 1], 8.);
+}
+
+TEST(ScaledModel, UserVariableScalingSolve) {
+   Options options = test_options("filtersqp");
+   options["scale_variables"] = "user";
+   const ScaledModel model(std::make_unique<UserScaledTestModel>(), options);
+   ASSERT_EQ(model.get_variable_scaling(0), 0.5);
+   const Result result = solve_model(model, options);
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   // the solution is expressed in the original variables
+   ASSERT_NEAR(result.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 3., 1e-6);
+   ASSERT_NEAR(result.solution.evaluations.objective, -56., 1e-6);
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "ingredients/subproblem_solvers/SchurComplementSolver.hpp"
+#include "DenseLDLTSolver.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-10;
+
+static SchurComplementSolver<size_t> make_solver(size_t dimension, double linking_degree_factor) {
+   return SchurComplementSolver<size_t>(dimension, [](size_t block_dimension, size_t /*number_nonzeros*/) {
+      return std::make_unique<DenseLDLTSolver>(block_dimension);
+   }, linking_degree_factor);
+}
+
+// two-stage problem with one first-stage variable x0 and S scenarios (x_s, y_s, multiplier of the constraint x_s + y_s - x0 = 0).
+// Augmented matrix ordered as [scenario 0 | ... | scenario S-1 | x0]
+static SymmetricMatrix<size_t, double> multi_scenario_matrix(size_t number_scenarios) {
+   const size_t dimension = 3 * number_scenarios + 1;
+   const size_t first_stage = 3 * number_scenarios;
+   SymmetricMatrix<size_t, double> matrix(dimension, 6 * number_scenarios + 1, false, "COO");
+   for (size_t scenario = 0; scenario < number_scenarios; scenario++) {
+      const size_t offset = 3 * scenario;
+      const double weight = 1. + static_cast<double>(scenario);
+      matrix.insert(2. * weight, offset, offset);
+      matrix.insert(0.5, offset + 1, offset);
+      matrix.insert(weight, offset + 1, offset + 1);
+      matrix.insert(1., offset + 2, offset);
+      matrix.insert(1., offset + 2, offset + 1);
+      matrix.insert(-1., first_stage, offset + 2);
+   }
+   matrix.insert(3., first_stage, first_stage);
+   return matrix;
+}
+
+static std::vector<double> product(const SymmetricMatrix<size_t, double>& matrix, const std::vector<double>& x) {
+   std::vector<double> result(matrix.dimension(), 0.);
+   matrix.for_each([&](size_t row_index, size_t column_index, double element) {
+      result[row_index] += element * x[column_index];
+      if (row_index != column_index) {
+         result[column_index] += element * x[row_index];
+      }
+   });
+   return result;
+}
+
+TEST(SchurComplementSolver, UserPartition) {
+   const size_t number_scenarios = 4;
+   const SymmetricMatrix<size_t, double> matrix = multi_scenario_matrix(number_scenarios);
+   const size_t dimension = matrix.dimension();
+   SchurComplementSolver<size_t> solver = make_solver(dimension, 0.);
+   std::vector<size_t> partition(dimension, BlockPartition::linking);
+   for (size_t index = 0; index < 3 * number_scenarios; index++) {
+      partition[index] = index / 3;
+   }
+   solver.set_block_partition(partition);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   ASSERT_EQ(solver.get_block_partition().number_blocks, number_scenarios);
+
+   std::vector<double> solution(dimension);
+   for (size_t index = 0; index < dimension; index++) {
+      solution[index] = 1. + 0.5 * static_cast<double>(index % 5);
+   }
+   const std::vector<double> rhs_values = product(matrix, solution);
+   Vector<double> rhs(dimension), result(dimension);
+   std::copy(rhs_values.begin(), rhs_values.end(), rhs.begin());
+   solver.solve_indefinite_system(matrix, rhs, result);
+   for (size_t index = 0; index < dimension; index++) {
+      EXPECT_NEAR(result[index], solution[index], tolerance);
+   }
+
+   // inertia of the whole matrix: same as a dense factorization
+   DenseLDLTSolver dense_solver(dimension);
+   dense_solver.do_numerical_factorization(matrix);
+   ASSERT_EQ(solver.get_inertia(), dense_solver.get_inertia());
+   ASSERT_FALSE(solver.matrix_is_singular());
+   ASSERT_EQ(solver.rank(), dimension);
+}
+
+TEST(SchurComplementSolver, DetectsLinkingIndex) {
+   const size_t number_scenarios = 8;
+   const SymmetricMatrix<size_t, double> matrix = multi_scenario_matrix(number_scenarios);
+   // the first-stage variable has degree 8, the average degree is close to 3
+   SchurComplementSolver<size_t> solver = make_solver(matrix.dimension(), 2.);
+   solver.do_symbolic_analysis(matrix);
+   const BlockPartition& partition = solver.get_block_partition();
+   ASSERT_EQ(partition.number_blocks, number_scenarios);
+   ASSERT_EQ(partition.number_linking_indices(), 1);
+   ASSERT_EQ(partition.block_of_index.back(), BlockPartition::linking);
+}
+
+TEST(SchurComplementSolver, DecoupledBlocksWithoutLinkingIndices) {
+   // block diagonal matrix: two 2x2 blocks
+   SymmetricMatrix<size_t, double> matrix(4, 6, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(1., 1, 0);
+   matrix.insert(-1., 1, 1);
+   matrix.insert(4., 2, 2);
+   matrix.insert(1., 3, 2);
+   matrix.insert(3., 3, 3);
+   SchurComplementSolver<size_t> solver = make_solver(4, 0.);
+   solver.do_symbolic_analysis(matrix);
+   solver.do_numerical_factorization(matrix);
+   ASSERT_EQ(solver.get_block_partition().number_blocks, 2);
+   ASSERT_EQ(solver.get_block_partition().number_linking_indices(), 0);
+   ASSERT_EQ(solver.get_inertia(), std::make_tuple(size_t(3), size_t(1), size_t(0)));
+
+   Vector<double> rhs{3., 0., 5., 4.}, result(4);
+   solver.solve_indefinite_system(matrix, rhs, result);
+   for (size_t index = 0; index < 4; index++) {
+      EXPECT_NEAR(result[index], 1., tolerance);
+   }
+}
+
+TEST(SchurComplementSolver, CouplingBetweenBlocksThrows) {
+   SymmetricMatrix<size_t, double> matrix(3, 4, false, "COO");
+   matrix.insert(1., 0, 0);
+   matrix.insert(1., 1, 1);
+   matrix.insert(1., 2, 2);
+   matrix.insert(0.5, 1, 0);
+   SchurComplementSolver<size_t> solver = make_solver(3, 0.);
+   solver.set_block_partition({0, 1, BlockPartition::linking});
+   ASSERT_THROW(solver.do_symbolic_analysis(matrix), std::invalid_argument);
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "tools/Infinity.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+// Maratos example: min 2 (x0^2 + x1^2 - 1) - x0 s.t. x0^2 + x1^2 = 1 (solution (1, 0)). Close to the solution, the full Newton step
+// increases both the objective and the infeasibility
+class MaratosModel: public Model {
+public:
+   MaratosModel(): Model("Maratos", 2, 1, 1.) { }
+
+   [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override { return 2. * (x[0] * x[0] + x[1] * x[1] - 1.) - x[0]; }
+   void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, 4. * x[0] - 1.);
+      gradient.insert(1, 4. * x[1]);
+   }
+   void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+      constraints[0] = x[0] * x[0] + x[1] * x[1];
+   }
+   void evaluate_constraint_gradient(const Vector<double>& x, size_t /*constraint_index*/, SparseVector<double>& gradient) const override {
+      gradient.insert(0, 2. * x[0]);
+      gradient.insert(1, 2. * x[1]);
+   }
+   void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+      constraint_jacobian[0].insert(0, 2. * x[0]);
+      constraint_jacobian[0].insert(1, 2. * x[1]);
+   }
+   void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& multipliers,
+         SymmetricMatrix<size_t, double>& hessian) const override {
+      hessian.reset();
+      hessian.insert(4. * objective_multiplier - 2. * multipliers[0], 0, 0);
+      hessian.finalize_column(0);
+      hessian.insert(4. * objective_multiplier - 2. * multipliers[0], 1, 1);
+      hessian.finalize_column(1);
+   }
+
+   [[nodiscard]] double variable_lower_bound(size_t /*variable_index*/) const override { return -INF<double>; }
+   [[nodiscard]] double variable_upper_bound(size_t /*variable_index*/) const override { return INF<double>; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t /*variable_index*/) const override { return UNBOUNDED; }
+   [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+   [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->empty_collection; }
+   [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+   [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return 1.; }
+   [[nodiscard]] double constraint_upper_bound(size_t /*constraint_index*/) const override { return 1.; }
+   [[nodiscard]] FunctionType get_objective_type() const override { return NONLINEAR; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return NONLINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return EQUAL_BOUNDS; }
+   [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->constraints_collection; }
+   [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->empty_collection; }
+   [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->empty_collection; }
+
+   // feasible point close to the solution
+   void initial_primal_point(Vector<double>& x) const override {
+      x[0] = std::cos(0.1);
+      x[1] = std::sin(0.1);
+   }
+   void initial_dual_point(Vector<double>& multipliers) const override { multipliers[0] = 1.5; }
+   void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+   [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 2; }
+   [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 2; }
+   [[nodiscard]] size_t number_hessian_nonzeros() const override { return 2; }
+
+protected:
+   const std::vector<size_t> constraints{0};
+   const std::vector<size_t> no_indices{};
+   const CollectionAdapter<std::vector<size_t>> constraints_collection{this->constraints};
+   const CollectionAdapter<std::vector<size_t>> empty_collection{this->no_indices};
+   const SparseVector<size_t> slacks{};
+   const Vector<size_t> fixed_variables{};
+};
+
+// solve with the ipopt preset, whose statistics (captured in the output) report the corrected steps
+static Result solve_maratos(size_t max_second_order_corrections, std::string& output) {
+   Options options = test_options("ipopt");
+   options["linear_solver"] = "dense";
+   options["LS_max_second_order_corrections"] = std::to_string(max_second_order_corrections);
+   options["logger"] = "INFO";
+   testing::internal::CaptureStdout();
+   const Result result = solve_reformulated_model(std::make_unique<MaratosModel>(), options);
+   output = testing::internal::GetCapturedStdout();
+   return result;
+}
+
+// the full step is rejected by the filter at the first iteration and the corrected step is accepted, which saves the backtracking
+TEST(SecondOrderCorrection, InteriorPointMaratos) {
+   std::string output;
+   const Result result = solve_maratos(4, output);
+   ASSERT_EQ(result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_NEAR(result.solution.primals[0], 1., 1e-6);
+   ASSERT_NEAR(result.solution.primals[1], 0., 1e-6);
+   EXPECT_NE(output.find("accepted (SOC)"), std::string::npos);
+
+   std::string uncorrected_output;
+   const Result uncorrected_result = solve_maratos(0, uncorrected_output);
+   ASSERT_EQ(uncorrected_result.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   EXPECT_EQ(uncorrected_output.find("accepted (SOC)"), std::string::npos);
+   EXPECT_LT(result.iteration, uncorrected_result.iteration);
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "optimization/Sensitivity.hpp"
+#include "options/Options.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+TEST(Sensitivity, ApproximateSolution) {
+   // 2 variables, 1 constraint, 2 parameters
+   Sensitivity sensitivity(2, 1, 2);
+   sensitivity.primal_derivatives = Vector<double>{1., 2., 3., 4.};
+   sensitivity.constraint_multiplier_derivatives = Vector<double>{-1., 5.};
+   Iterate solution(2, 1);
+   solution.primals = Vector<double>{10., 20.};
+   solution.multipliers.constraints = Vector<double>{30.};
+
+   Vector<double> primals, constraint_multipliers;
+   sensitivity.approximate_solution(solution, Vector<double>{0.1, -0.2}, primals, constraint_multipliers);
+   ASSERT_EQ(primals.size(), 2);
+   ASSERT_EQ(constraint_multipliers.size(), 1);
+   EXPECT_NEAR(primals[0], 10. + 0.1 * 1. - 0.2 * 3., 1e-14);
+   EXPECT_NEAR(primals[1], 20. + 0.1 * 2. - 0.2 * 4., 1e-14);
+   EXPECT_NEAR(constraint_multipliers[0], 30. - 0.1 * 1. - 0.2 * 5., 1e-14);
+
+   ASSERT_THROW(sensitivity.approximate_solution(solution, Vector<double>{0.1}, primals, constraint_multipliers), std::invalid_argument);
+}
+
+TEST(Sensitivity, RequiresInteriorPointFactorization) {
+   Options options = test_options("filtersqp");
+   options["globalization_mechanism"] = "TR";
+
+   QuadraticTestModel model;
+   TestSolver solver(model, options);
+   const Vector<double> lagrangian_gradient_derivatives(model.number_variables, 0.);
+   const Vector<double> constraint_derivatives(model.number_constraints, 0.);
+
+   const Result result = solver.solve();
+   ASSERT_EQ(result.optimization_status, OptimizationStatus::SUCCESS);
+   // dimensions of the derivatives
+   ASSERT_THROW((void) solver.uno.compute_sensitivity(result, lagrangian_gradient_derivatives, constraint_derivatives, 2), std::invalid_argument);
+   // the SQP method does not factorize the primal-dual system
+   ASSERT_THROW((void) solver.uno.compute_sensitivity(result, lagrangian_gradient_derivatives, constraint_derivatives, 1), std::runtime_error);
+}
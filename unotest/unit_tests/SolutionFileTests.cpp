@@ -0,0 +1,60 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "optimization/Result.hpp"
+#include "options/Options.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/SolutionFile.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+TEST(SolutionFile, SolutionIsWrittenInBinary) {
+   const std::string file_name = ::testing::TempDir() + "uno_solution";
+   Options options = test_options("filtersqp");
+   options["solution_file"] = file_name;
+
+   const QuadraticTestModel model;
+   const Result result = solve_model(model, options);
+
+   const SolutionFileContents contents = SolutionFileContents::read(file_name);
+   ASSERT_EQ(contents.header.optimization_status, static_cast<std::uint64_t>(result.optimization_status));
+   ASSERT_EQ(contents.header.iterate_status, static_cast<std::uint64_t>(result.solution.status));
+   ASSERT_EQ(contents.header.number_variables, model.number_variables);
+   ASSERT_EQ(contents.header.number_constraints, model.number_constraints);
+   ASSERT_EQ(contents.header.iterations, result.iteration);
+   ASSERT_EQ(contents.header.objective, result.solution.evaluations.objective);
+   for (size_t variable_index: Range(model.number_variables)) {
+      ASSERT_EQ(contents.primals[variable_index], result.solution.primals[variable_index]);
+      ASSERT_EQ(contents.lower_bound_multipliers[variable_index], result.solution.multipliers.lower_bounds[variable_index]);
+      ASSERT_EQ(contents.upper_bound_multipliers[variable_index], result.solution.multipliers.upper_bounds[variable_index]);
+   }
+   for (size_t constraint_index: Range(model.number_constraints)) {
+      ASSERT_EQ(contents.constraint_multipliers[constraint_index], result.solution.multipliers.constraints[constraint_index]);
+   }
+   // the arrays are at fixed offsets (memory mapping)
+   std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+   ASSERT_EQ(static_cast<size_t>(file.tellg()), SolutionFile::file_size(contents.header));
+   file.seekg(static_cast<std::streamoff>(SolutionFile::upper_bound_multipliers_offset(contents.header)));
+   double upper_bound_multiplier;
+   file.read(reinterpret_cast<char*>(&upper_bound_multiplier), sizeof(double));
+   ASSERT_EQ(upper_bound_multiplier, result.solution.multipliers.upper_bounds[0]);
+   std::remove(file_name.c_str());
+}
+
+TEST(SolutionFile, RejectsOtherFiles) {
+   const std::string file_name = ::testing::TempDir() + "uno_solution_invalid";
+   {
+      std::ofstream file(file_name, std::ios::binary);
+      file << "UNOCHKPT";
+   }
+   ASSERT_THROW(SolutionFileContents::read(file_name), std::runtime_error);
+   std::remove(file_name.c_str());
+   ASSERT_THROW(SolutionFileContents::read(file_name), std::runtime_error);
+}
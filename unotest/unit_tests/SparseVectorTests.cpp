@@ -56,3 +56,68 @@ TEST(SparseVector, InsertAfterClear) {
    x.insert(7, 3.);
    ASSERT_EQ(x.size(), 1);
 }
+
+TEST(SparseVector, CanonicalWhenInsertedInOrder) {
+   SparseVector<double> x(3);
+   ASSERT_TRUE(x.is_canonical());
+   x.insert(0, 1.);
+   x.insert(3, 2.);
+   ASSERT_TRUE(x.is_canonical());
+   // duplicate index
+   x.insert(3, 1.);
+   ASSERT_FALSE(x.is_canonical());
+   x.clear();
+   ASSERT_TRUE(x.is_canonical());
+}
+
+TEST(SparseVector, Canonicalize) {
+   SparseVector<double> x(5);
+   x.insert(7, 1.);
+   x.insert(2, 2.);
+   x.insert(7, 3.);
+   x.insert(0, -1.);
+   ASSERT_EQ(x.get(7), 4.);
+   x.canonicalize();
+   ASSERT_TRUE(x.is_canonical());
+   ASSERT_EQ(x.size(), 3);
+   const std::vector<std::pair<size_t, double>> reference{{0, -1.}, {2, 2.}, {7, 4.}};
+   std::vector<std::pair<size_t, double>> elements;
+   for (const auto [index, element]: x) {
+      elements.emplace_back(index, element);
+   }
+   ASSERT_EQ(elements, reference);
+   ASSERT_EQ(x.get(2), 2.);
+   ASSERT_EQ(x.get(5), 0.);
+}
+
+TEST(SparseVector, InsertOrAccumulate) {
+   SparseVector<double> x(3);
+   x.insert(1, 1.);
+   x.insert(4, 1.);
+   x.insert_or_accumulate(4, 2.);
+   x.insert_or_accumulate(0, 5.);
+   x.insert_or_accumulate(2, -1.);
+   ASSERT_TRUE(x.is_canonical());
+   ASSERT_EQ(x.size(), 4);
+   ASSERT_EQ(x.get(0), 5.);
+   ASSERT_EQ(x.get(2), -1.);
+   ASSERT_EQ(x.get(4), 3.);
+}
+
+TEST(SparseVector, MergeOperations) {
+   SparseVector<double> x(3), y(3), sum(0);
+   x.insert(0, 1.);
+   x.insert(2, 2.);
+   x.insert(5, 3.);
+   y.insert(2, 10.);
+   y.insert(3, 20.);
+   y.insert(5, 30.);
+   ASSERT_EQ(dot(x, y), 2. * 10. + 3. * 30.);
+   add(x, y, sum);
+   ASSERT_TRUE(sum.is_canonical());
+   ASSERT_EQ(sum.size(), 4);
+   ASSERT_EQ(sum.get(0), 1.);
+   ASSERT_EQ(sum.get(2), 12.);
+   ASSERT_EQ(sum.get(3), 20.);
+   ASSERT_EQ(sum.get(5), 33.);
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "optimization/EvaluationCounters.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+
+TEST(Statistics, CSVTraceWhenSilent) {
+   const std::string file_name = ::testing::TempDir() + "uno_statistics_trace.csv";
+   const Level previous_level = Logger::level;
+   Logger::level = SILENT;
+   {
+      Options options = DefaultOptions::load();
+      options["statistics_trace_file"] = file_name;
+      Statistics statistics(options);
+      statistics.add_column("iter", Statistics::int_width, 1);
+      statistics.add_column("objective", Statistics::double_width, 2);
+      statistics.add_column("status", Statistics::string_width, 3);
+      statistics.start_new_line();
+      statistics.set("iter", 0);
+      statistics.set("objective", 1.5);
+      statistics.set("status", "initial point");
+      statistics.start_new_line();
+      statistics.set("iter", 1);
+   }
+   Logger::level = previous_level;
+
+   std::ifstream file(file_name);
+   std::string header, first_record, second_record;
+   std::getline(file, header);
+   std::getline(file, first_record);
+   std::getline(file, second_record);
+   std::remove(file_name.c_str());
+   ASSERT_EQ(header, "time,iter,objective,status");
+   // the time field comes first, the textual status is empty
+   ASSERT_EQ(first_record.substr(first_record.find(',')), ",0,1.5,");
+   ASSERT_EQ(second_record.substr(second_record.find(',')), ",1,,");
+}
+
+TEST(Statistics, HiddenAndTimingColumns) {
+   const std::string file_name = ::testing::TempDir() + "uno_statistics_timing_trace.csv";
+   const Level previous_level = Logger::level;
+   Logger::level = SILENT;
+   {
+      EvaluationCounters evaluation_counters{};
+      const EvaluationCounters::Scope evaluation_counters_scope(evaluation_counters);
+      Options options = DefaultOptions::load();
+      options["statistics_trace_file"] = file_name;
+      Statistics statistics(options);
+      statistics.add_column("iter", Statistics::int_width, 1);
+      statistics.add_column("hidden", Statistics::int_width, -1);
+      statistics.add_column("eval time", Statistics::double_width, 2);
+      statistics.start_new_line();
+      statistics.set("iter", 1);
+      statistics.set("hidden", 2);
+      evaluation_counters.time += 0.5;
+   }
+   Logger::level = previous_level;
+
+   std::ifstream file(file_name);
+   std::string header, record;
+   std::getline(file, header);
+   std::getline(file, record);
+   std::remove(file_name.c_str());
+   ASSERT_EQ(header, "time,iter,eval time");
+   // the evaluation time elapsed during the line
+   ASSERT_EQ(record.substr(record.find(',')), ",1,0.5");
+}
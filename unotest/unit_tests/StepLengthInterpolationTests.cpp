@@ -0,0 +1,30 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "ingredients/globalization_mechanisms/StepLengthInterpolation.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-12;
+
+// phi(t) = (t - 0.2)^2: phi(0) = 0.04, phi'(0) = -0.4, phi(1) = 0.64
+TEST(StepLengthInterpolation, QuadraticIsExact) {
+   const double minimizer = interpolated_step_length_minimizer(0.04, -0.4, 1., 0.64, 0., 0., false);
+   ASSERT_NEAR(minimizer, 0.2, tolerance);
+}
+
+// phi(t) = t^3 - t^2 - 0.1 t + 1: the cubic through phi(0), phi'(0), phi(1) and phi(0.5) is phi itself
+TEST(StepLengthInterpolation, CubicIsExact) {
+   const auto phi = [](double t) { return t*t*t - t*t - 0.1*t + 1.; };
+   const double minimizer = interpolated_step_length_minimizer(phi(0.), -0.1, 0.5, phi(0.5), 1., phi(1.), true);
+   // phi'(t) = 3t^2 - 2t - 0.1 = 0
+   ASSERT_NEAR(minimizer, (2. + std::sqrt(4. + 1.2)) / 6., tolerance);
+}
+
+TEST(StepLengthInterpolation, NoMinimizerBelowLinearModel) {
+   // the trial value is below the tangent: the quadratic is concave
+   ASSERT_FALSE(is_finite(interpolated_step_length_minimizer(1., -1., 1., -0.5, 0., 0., false)));
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <type_traits>
+#include <vector>
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Expression.hpp"
+#include "symbolic/StridedSpan.hpp"
+#include "symbolic/VectorView.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+TEST(StridedSpan, Stride) {
+   const std::vector<double> x{1., 2., 3., 4., 5., 6.};
+   const StridedSpan<const double, 2> span(x.data(), 3);
+   ASSERT_EQ(span.size(), 3);
+   ASSERT_EQ(span[0], 1.);
+   ASSERT_EQ(span[1], 3.);
+   ASSERT_EQ(span[2], 5.);
+}
+
+TEST(StridedSpan, LoweredLeaves) {
+   const Vector<double> x{1., 2., 3.};
+   const Vector<double> d{4., 5., 6.};
+   const auto expression = x + 2. * d;
+   // the leaves of the lowered expression are spans
+   using Block = std::remove_const_t<std::remove_reference_t<decltype(strided_block(expression))>>;
+   static_assert(std::is_same_v<Block, Sum<StridedSpan<const double>, ScalarMultiple<StridedSpan<const double>>>>);
+}
+
+TEST(StridedSpan, FusedAssignment) {
+   const Vector<double> x{1., 2., 3., 4., 5.};
+   const Vector<double> d{-1., 1., -1., 1., -1.};
+   Vector<double> result(5);
+   result = x + 0.5 * d;
+   const std::vector<double> reference_result{0.5, 2.5, 2.5, 4.5, 4.5};
+   for (size_t index: Range(result.size())) {
+      ASSERT_EQ(result[index], reference_result[index]);
+   }
+   // in-place update
+   result += -d;
+   for (size_t index: Range(result.size())) {
+      ASSERT_EQ(result[index], reference_result[index] - d[index]);
+   }
+}
+
+TEST(StridedSpan, ViewIsSubspan) {
+   const Vector<double> solution{1., 2., 3., 100., 200., 300.};
+   const auto view_block = strided_block(view(solution, 3, 6));
+   static_assert(std::is_same_v<std::remove_const_t<std::remove_reference_t<decltype(view_block)>>, StridedSpan<const double>>);
+   Vector<double> multipliers(3);
+   multipliers = view(-solution, 3, 6);
+   ASSERT_EQ(multipliers[0], -100.);
+   ASSERT_EQ(multipliers[1], -200.);
+   ASSERT_EQ(multipliers[2], -300.);
+}
+
+TEST(StridedSpan, ZeroFactorIgnoresInfinity) {
+   const Vector<double> x{1., 2.};
+   const Vector<double> d{INF<double>, 1.};
+   Vector<double> result(2);
+   result = x + 0. * d;
+   ASSERT_EQ(result[0], 1.);
+   ASSERT_EQ(result[1], 2.);
+}
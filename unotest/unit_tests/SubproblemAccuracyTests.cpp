@@ -0,0 +1,72 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "ingredients/subproblem_solvers/SubproblemAccuracy.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+
+using namespace uno;
+
+static Iterate iterate_with_KKT_error(double KKT_error) {
+   Iterate iterate(2, 1);
+   iterate.primal_feasibility = KKT_error;
+   iterate.residuals.stationarity = KKT_error / 10.;
+   iterate.residuals.complementarity = 0.;
+   return iterate;
+}
+
+static Options adaptive_options() {
+   Options options = DefaultOptions::load();
+   options["subproblem_accuracy"] = "adaptive";
+   return options;
+}
+
+TEST(SubproblemAccuracy, ExactMode) {
+   const Options options = DefaultOptions::load();
+   const SubproblemAccuracy accuracy(options);
+   ASSERT_FALSE(accuracy.is_adaptive());
+   ASSERT_EQ(accuracy.tolerance(iterate_with_KKT_error(1e2), 1e-9), 1e-9);
+   ASSERT_EQ(accuracy.iteration_limit(1e-3, 1e-9, 200), 200);
+}
+
+TEST(SubproblemAccuracy, ToleranceFollowsKKTError) {
+   const Options options = adaptive_options();
+   const SubproblemAccuracy accuracy(options);
+   // far from a KKT point: loosest tolerance
+   ASSERT_EQ(accuracy.tolerance(iterate_with_KKT_error(1e2), 1e-9), 1e-3);
+   // intermediate: 0.1 * KKT error
+   ASSERT_NEAR(accuracy.tolerance(iterate_with_KKT_error(1e-4), 1e-9), 1e-5, 1e-15);
+   // close to a KKT point: tight tolerance
+   ASSERT_EQ(accuracy.tolerance(iterate_with_KKT_error(1e-12), 1e-9), 1e-9);
+}
+
+TEST(SubproblemAccuracy, RestorationStationarity) {
+   const Options options = adaptive_options();
+   const SubproblemAccuracy accuracy(options);
+   // the stationarity of the optimality problem is not computed: the feasibility stationarity is used
+   Iterate iterate = iterate_with_KKT_error(1e-5);
+   iterate.residuals.stationarity = INF<double>;
+   iterate.feasibility_residuals.stationarity = 1e-6;
+   ASSERT_NEAR(accuracy.tolerance(iterate, 1e-9), 1e-6, 1e-15);
+}
+
+TEST(SubproblemAccuracy, IterationLimit) {
+   const Options options = adaptive_options();
+   const SubproblemAccuracy accuracy(options);
+   ASSERT_EQ(accuracy.iteration_limit(1e-3, 1e-9, 200), 50);
+   ASSERT_EQ(accuracy.iteration_limit(1e-9, 1e-9, 200), 200);
+   // halfway on a logarithmic scale
+   ASSERT_EQ(accuracy.iteration_limit(1e-6, 1e-9, 200), 125);
+}
+
+TEST(SubproblemAccuracy, InvalidOptions) {
+   Options options = adaptive_options();
+   options["subproblem_accuracy"] = "sloppy";
+   ASSERT_THROW(SubproblemAccuracy accuracy(options), std::invalid_argument);
+   options["subproblem_accuracy"] = "adaptive";
+   options["subproblem_loosest_iteration_fraction"] = "0";
+   ASSERT_THROW(SubproblemAccuracy accuracy(options), std::invalid_argument);
+}
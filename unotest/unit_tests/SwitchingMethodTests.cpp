@@ -0,0 +1,38 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/globalization_strategies/switching_methods/filter_methods/FletcherFilterMethod.hpp"
+#include "ingredients/globalization_strategies/switching_methods/funnel_methods/FunnelMethod.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+
+static Iterate initial_iterate(double infeasibility) {
+   Iterate iterate(1, 1);
+   iterate.progress.infeasibility = infeasibility;
+   return iterate;
+}
+
+TEST(SwitchingMethod, FilterRejectsInfeasibilityAboveUpperBound) {
+   Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   FletcherFilterMethod strategy(options);
+   // upper bound max(filter_ubd, filter_fact * 1000) = 1250
+   strategy.initialize(statistics, initial_iterate(1000.), options);
+   ASSERT_TRUE(strategy.is_infeasibility_acceptable(10.));
+   ASSERT_FALSE(strategy.is_infeasibility_acceptable(2000.));
+}
+
+TEST(SwitchingMethod, FunnelRejectsInfeasibilityOutsideFunnel) {
+   Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   FunnelMethod strategy(options);
+   // width max(funnel_ubd, funnel_fact * 10) = 15
+   strategy.initialize(statistics, initial_iterate(10.), options);
+   ASSERT_TRUE(strategy.is_infeasibility_acceptable(15.));
+   ASSERT_FALSE(strategy.is_infeasibility_acceptable(16.));
+}
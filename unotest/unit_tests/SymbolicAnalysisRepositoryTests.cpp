@@ -0,0 +1,71 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ingredients/subproblem_solvers/SymbolicAnalysisRepository.hpp"
+
+using namespace uno;
+
+TEST(SymbolicAnalysisRepository, Memory) {
+   SymbolicAnalysisRepository::clear_memory();
+   const SymbolicAnalysisRepository repository("solver", SymbolicAnalysisRepository::Persistence::MEMORY, "");
+   ASSERT_FALSE(repository.find(42, 3, 5).has_value());
+   repository.store(42, {3, 5, {1, 2, 3}});
+   // another instance of the same solver finds the analysis
+   const SymbolicAnalysisRepository other_repository("solver", SymbolicAnalysisRepository::Persistence::MEMORY, "");
+   const auto analysis = other_repository.find(42, 3, 5);
+   ASSERT_TRUE(analysis.has_value());
+   ASSERT_EQ(analysis->data, (std::vector<int>{1, 2, 3}));
+   // another solver does not
+   const SymbolicAnalysisRepository repository_other_solver("other_solver", SymbolicAnalysisRepository::Persistence::MEMORY, "");
+   ASSERT_FALSE(repository_other_solver.find(42, 3, 5).has_value());
+   SymbolicAnalysisRepository::clear_memory();
+}
+
+TEST(SymbolicAnalysisRepository, File) {
+   const std::string directory = testing::TempDir();
+   const SymbolicAnalysisRepository repository("solver", SymbolicAnalysisRepository::Persistence::FILE, directory);
+   repository.store(7, {2, 3, {4, 5, 6, 7}});
+   const auto analysis = repository.find(7, 2, 3);
+   ASSERT_TRUE(analysis.has_value());
+   ASSERT_EQ(analysis->dimension, 2);
+   ASSERT_EQ(analysis->number_nonzeros, 3);
+   ASSERT_EQ(analysis->data, (std::vector<int>{4, 5, 6, 7}));
+   ASSERT_FALSE(repository.find(8, 2, 3).has_value());
+}
+
+TEST(SymbolicAnalysisRepository, DimensionMismatch) {
+   SymbolicAnalysisRepository::clear_memory();
+   const SymbolicAnalysisRepository repository("solver", SymbolicAnalysisRepository::Persistence::MEMORY, "");
+   repository.store(42, {3, 5, {1, 2, 3}});
+   ASSERT_FALSE(repository.find(42, 3, 6).has_value());
+   SymbolicAnalysisRepository::clear_memory();
+}
+
+TEST(SymbolicAnalysisRepository, Disabled) {
+   const SymbolicAnalysisRepository repository("solver", SymbolicAnalysisRepository::Persistence::NONE, "");
+   ASSERT_FALSE(repository.is_enabled());
+   repository.store(42, {3, 5, {1, 2, 3}});
+   ASSERT_FALSE(repository.find(42, 3, 5).has_value());
+}
+
+TEST(SymbolicAnalysisRepository, RecentAnalyses) {
+   // no persistence: only the two most recent analyses of the instance are kept
+   const SymbolicAnalysisRepository repository("solver", SymbolicAnalysisRepository::Persistence::NONE, "", 2);
+   ASSERT_TRUE(repository.is_enabled());
+   repository.store(1, {3, 5, {1}});
+   repository.store(2, {4, 6, {2}});
+   ASSERT_EQ(repository.find(1, 3, 5)->data, (std::vector<int>{1}));
+   ASSERT_EQ(repository.find(2, 4, 6)->data, (std::vector<int>{2}));
+   // storing an existing pattern replaces it
+   repository.store(1, {3, 5, {10}});
+   ASSERT_EQ(repository.find(1, 3, 5)->data, (std::vector<int>{10}));
+   // the least recently stored analysis is evicted
+   repository.store(3, {2, 2, {3}});
+   ASSERT_FALSE(repository.find(2, 4, 6).has_value());
+   ASSERT_TRUE(repository.find(1, 3, 5).has_value());
+   ASSERT_TRUE(repository.find(3, 2, 2).has_value());
+   // other instances do not share the recent analyses
+   const SymbolicAnalysisRepository other_repository("solver", SymbolicAnalysisRepository::Persistence::NONE, "", 2);
+   ASSERT_FALSE(other_repository.find(1, 3, 5).has_value());
+}
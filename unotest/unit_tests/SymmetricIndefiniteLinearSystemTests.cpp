@@ -0,0 +1,626 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "options/DefaultOptions.hpp"
+#include "DenseLDLTSolver.hpp"
+#include "DenseSolver.hpp"
+
+using namespace uno;
+
+static std::vector<std::tuple<size_t, size_t, double>> matrix_terms(const SymmetricMatrix<size_t, double>& matrix) {
+   std::vector<std::tuple<size_t, size_t, double>> terms;
+   matrix.for_each([&](size_t row_index, size_t column_index, double element) {
+      terms.emplace_back(row_index, column_index, element);
+   });
+   return terms;
+}
+
+TEST(SymmetricIndefiniteLinearSystem, ValuesOnlyReassembly) {
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   const Options options = DefaultOptions::load();
+   SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", number_variables + number_constraints, 6, true, options);
+   SymmetricIndefiniteLinearSystem<size_t, double> reference_system("COO", number_variables + number_constraints, 6, true, options);
+
+   SymmetricMatrix<size_t, double> hessian(number_variables, 3, false, "COO");
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   WarmstartInformation warmstart_information{};
+
+   // first assembly: the scatter map is recorded
+   hessian.insert(1., 0, 0);
+   hessian.insert(2., 1, 0);
+   hessian.insert(3., 1, 1);
+   constraint_jacobian[0].insert(0, 4.);
+   constraint_jacobian[0].insert(1, 5.);
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   augmented_system.matrix.set_regularization([](size_t /*index*/) { return 1.; });
+
+   // new values with the same sparsity pattern
+   warmstart_information.hessian_sparsity_changed = warmstart_information.jacobian_sparsity_changed = false;
+   hessian.reset();
+   hessian.insert(-1., 0, 0);
+   hessian.insert(-2., 1, 0);
+   hessian.insert(-3., 1, 1);
+   constraint_jacobian.clear();
+   constraint_jacobian[0].insert(0, -4.);
+   constraint_jacobian[0].insert(1, -5.);
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+
+   // full assembly from scratch
+   WarmstartInformation reference_warmstart_information{};
+   reference_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, reference_warmstart_information);
+   ASSERT_EQ(matrix_terms(augmented_system.matrix), matrix_terms(reference_system.matrix));
+}
+
+TEST(SymmetricIndefiniteLinearSystem, ParallelValuesOnlyReassembly) {
+   // tridiagonal Hessian and bidiagonal Jacobian, large enough to be reassembled by several threads
+   const size_t number_variables = parallel_assembly_nonzeros_threshold / 2;
+   const size_t number_constraints = number_variables - 1;
+   const size_t number_nonzeros = 2 * number_variables - 1 + 2 * number_constraints + number_variables + number_constraints;
+   const Options options = DefaultOptions::load();
+   SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", number_variables + number_constraints, number_nonzeros, true, options);
+   SymmetricIndefiniteLinearSystem<size_t, double> reference_system("COO", number_variables + number_constraints, number_nonzeros, true, options);
+   SymmetricMatrix<size_t, double> hessian(number_variables, 2 * number_variables - 1, false, "COO");
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   const auto evaluate = [&](double factor) {
+      hessian.reset();
+      constraint_jacobian.clear();
+      for (size_t variable_index: Range(number_variables)) {
+         hessian.insert(factor * static_cast<double>(variable_index + 1), variable_index, variable_index);
+         if (0 < variable_index) {
+            hessian.insert(-factor, variable_index, variable_index - 1);
+         }
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         constraint_jacobian[constraint_index].insert(constraint_index, factor);
+         constraint_jacobian[constraint_index].insert(constraint_index + 1, -2. * factor);
+      }
+   };
+   WarmstartInformation warmstart_information{};
+   evaluate(1.);
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   ASSERT_LE(parallel_assembly_nonzeros_threshold, augmented_system.matrix.number_nonzeros());
+
+   warmstart_information.hessian_sparsity_changed = warmstart_information.jacobian_sparsity_changed = false;
+   evaluate(3.);
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   WarmstartInformation reference_warmstart_information{};
+   reference_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, reference_warmstart_information);
+   ASSERT_EQ(matrix_terms(augmented_system.matrix), matrix_terms(reference_system.matrix));
+}
+
+TEST(SymmetricIndefiniteLinearSystem, PrimalDiagonalUpdate) {
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   const Options options = DefaultOptions::load();
+   SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", number_variables + number_constraints, 10, true, options);
+   SymmetricIndefiniteLinearSystem<size_t, double> reference_system("COO", number_variables + number_constraints, 10, true, options);
+
+   SymmetricMatrix<size_t, double> hessian(number_variables, 3, false, "COO");
+   hessian.insert(1., 0, 0);
+   hessian.insert(2., 1, 0);
+   hessian.insert(3., 1, 1);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian[0].insert(0, 4.);
+   constraint_jacobian[0].insert(1, 5.);
+   WarmstartInformation warmstart_information{};
+
+   // assembly with a first diagonal layer
+   augmented_system.set_primal_diagonal(Vector<double>{10., 20.}, number_variables);
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   augmented_system.matrix.set_regularization([](size_t /*index*/) { return 1.; });
+
+   // in-place update of the diagonal layer
+   ASSERT_TRUE(augmented_system.can_update_primal_diagonal(number_variables, number_constraints));
+   const Vector<double> new_diagonal{30., 40.};
+   augmented_system.set_primal_diagonal(new_diagonal, number_variables);
+   augmented_system.update_primal_diagonal();
+
+   // full assembly from scratch
+   WarmstartInformation reference_warmstart_information{};
+   reference_system.set_primal_diagonal(new_diagonal, number_variables);
+   reference_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, reference_warmstart_information);
+   ASSERT_EQ(matrix_terms(augmented_system.matrix), matrix_terms(reference_system.matrix));
+
+   // the diagonal layer cannot be updated once the matrix has been reset
+   augmented_system.reset_matrix(number_variables + number_constraints);
+   ASSERT_FALSE(augmented_system.can_update_primal_diagonal(number_variables, number_constraints));
+}
+
+TEST(SymmetricIndefiniteLinearSystem, FortranIndices) {
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   const Options options = DefaultOptions::load();
+   // 32-bit, 1-based indices
+   SymmetricIndefiniteLinearSystem<int32_t, double> augmented_system("COO", number_variables + number_constraints, 6, false, options, 1);
+   SymmetricMatrix<size_t, double> hessian(number_variables, 2, false, "COO");
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   WarmstartInformation warmstart_information{};
+   hessian.insert(1., 0, 0);
+   hessian.insert(3., 1, 1);
+   constraint_jacobian[0].insert(1, 5.);
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+
+   ASSERT_EQ(augmented_system.matrix.number_nonzeros(), 3);
+   ASSERT_EQ(augmented_system.matrix.index_shift(), 1);
+   // the traversal returns 0-based indices
+   std::vector<std::tuple<int32_t, int32_t, double>> terms;
+   augmented_system.matrix.for_each([&](int32_t row_index, int32_t column_index, double element) {
+      terms.emplace_back(row_index, column_index, element);
+   });
+   const std::vector<std::tuple<int32_t, int32_t, double>> reference_terms{{0, 0, 1.}, {1, 1, 3.}, {1, 2, 5.}};
+   ASSERT_EQ(terms, reference_terms);
+}
+
+// the inertia of a diagonal matrix is given by the signs of its diagonal entries
+class DiagonalSolver: public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+public:
+   explicit DiagonalSolver(size_t dimension): DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension), diagonal(dimension) { }
+
+   void do_symbolic_analysis(const SymmetricMatrix<size_t, double>& /*matrix*/) override { }
+   void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override {
+      std::fill(this->diagonal.begin(), this->diagonal.end(), 0.);
+      matrix.get_diagonal(this->diagonal);
+   }
+   void solve_indefinite_system(const SymmetricMatrix<size_t, double>& /*matrix*/, const Vector<double>& /*rhs*/,
+         Vector<double>& /*result*/) override { }
+
+   [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override {
+      const auto count = [&](auto predicate) { return static_cast<size_t>(std::count_if(this->diagonal.begin(), this->diagonal.end(), predicate)); };
+      return {count([](double entry) { return 0. < entry; }), count([](double entry) { return entry < 0.; }),
+         count([](double entry) { return entry == 0.; })};
+   }
+   [[nodiscard]] size_t number_negative_eigenvalues() const override { return std::get<1>(this->get_inertia()); }
+   [[nodiscard]] bool matrix_is_singular() const override { return 0 < std::get<2>(this->get_inertia()); }
+   [[nodiscard]] size_t rank() const override { return this->dimension - std::get<2>(this->get_inertia()); }
+
+protected:
+   std::vector<double> diagonal;
+};
+
+static size_t number_factorizations_per_iteration(bool predictive_regularization, size_t number_iterations) {
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   Options options = DefaultOptions::load();
+   options["predictive_regularization"] = predictive_regularization ? "yes" : "no";
+   options["predictive_regularization_history"] = "1";
+   Statistics statistics(options);
+   SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", number_variables + number_constraints, 6, true, options);
+   DiagonalSolver linear_solver(number_variables + number_constraints);
+   // indefinite Hessian and constraint diagonal term
+   SymmetricMatrix<size_t, double> hessian(number_variables, 2, false, "COO");
+   hessian.insert(1., 0, 0);
+   hessian.insert(-1e-3, 1, 1);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian[0].insert(0, 1.);
+   WarmstartInformation warmstart_information{};
+
+   size_t number_factorizations = 0;
+   for ([[maybe_unused]] size_t iteration: Range(number_iterations)) {
+      augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+      augmented_system.factorize_and_regularize_matrix(statistics, linear_solver, number_variables, number_constraints, 1., warmstart_information);
+      number_factorizations = augmented_system.get_number_factorizations();
+   }
+   return number_factorizations;
+}
+
+TEST(SymmetricIndefiniteLinearSystem, PredictiveRegularization) {
+   // without prediction, the unregularized matrix is factorized at every iteration
+   ASSERT_LT(1, number_factorizations_per_iteration(false, 3));
+   // with prediction, the last successful regularization is tried first
+   ASSERT_EQ(number_factorizations_per_iteration(true, 3), 1);
+}
+
+TEST(SymmetricIndefiniteLinearSystem, IndependentBlocksFactorization) {
+   // two decoupled subsystems: (x0, c0) and (x1, c1)
+   const size_t number_variables = 2;
+   const size_t number_constraints = 2;
+   const size_t dimension = number_variables + number_constraints;
+   Options options = DefaultOptions::load();
+   options["independent_blocks_factorization"] = "yes";
+   Statistics statistics(options);
+   SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", dimension, 8, true, options);
+   size_t number_created_solvers = 0;
+   augmented_system.set_block_solver_factory([&](size_t block_dimension, size_t /*number_nonzeros*/) {
+      number_created_solvers++;
+      return std::make_unique<DenseLDLTSolver>(block_dimension);
+   });
+   DenseLDLTSolver linear_solver(dimension);
+   SymmetricMatrix<size_t, double> hessian(number_variables, 2, false, "COO");
+   hessian.insert(2., 0, 0);
+   hessian.insert(3., 1, 1);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian[0].insert(0, 1.);
+   constraint_jacobian[1].insert(1, -2.);
+   WarmstartInformation warmstart_information{};
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   augmented_system.factorize_and_regularize_matrix(statistics, linear_solver, number_variables, number_constraints, 1., warmstart_information);
+   ASSERT_EQ(augmented_system.number_independent_blocks(), 2);
+   ASSERT_EQ(number_created_solvers, 2);
+   ASSERT_EQ(augmented_system.active_solver(linear_solver).get_inertia(), std::make_tuple(number_variables, number_constraints, size_t(0)));
+
+   // same solution as a factorization of the whole matrix
+   augmented_system.rhs = Vector<double>{1., -2., 3., 4.};
+   augmented_system.solve(linear_solver);
+   DenseSolver dense_solver(dimension);
+   Vector<double> reference_solution(dimension);
+   dense_solver.solve_indefinite_system(augmented_system.matrix, augmented_system.rhs, reference_solution);
+   for (size_t index: Range(dimension)) {
+      EXPECT_NEAR(augmented_system.solution[index], reference_solution[index], 1e-12);
+   }
+
+   // the detection is skipped when the sparsity pattern is unchanged
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   augmented_system.factorize_and_regularize_matrix(statistics, linear_solver, number_variables, number_constraints, 1., warmstart_information);
+   ASSERT_EQ(number_created_solvers, 2);
+}
+
+TEST(SymmetricIndefiniteLinearSystem, CondensedSlacks) {
+   // variables (x, s), constraint x - s
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   const Options options = DefaultOptions::load();
+   SymmetricMatrix<size_t, double> hessian(number_variables, 2, false, "COO");
+   hessian.insert(2., 0, 0);
+   hessian.insert(3., 1, 1);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian[0].insert(0, 1.);
+   constraint_jacobian[0].insert(1, -1.);
+   SparseVector<size_t> slacks(1);
+   slacks.insert(0, 1);
+   WarmstartInformation warmstart_information{};
+   DenseSolver linear_solver(number_variables + number_constraints);
+
+   SymmetricIndefiniteLinearSystem<size_t, double> full_system("COO", number_variables + number_constraints, 6, false, options);
+   full_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   full_system.rhs = Vector<double>{1., 2., 3.};
+   full_system.solve(linear_solver);
+
+   SymmetricIndefiniteLinearSystem<size_t, double> condensed_system("COO", number_variables + number_constraints, 6, false, options);
+   condensed_system.assemble_condensed_matrix(hessian, constraint_jacobian, number_variables, number_constraints, slacks);
+   ASSERT_EQ(condensed_system.matrix.dimension(), 2);
+   ASSERT_EQ(condensed_system.primal_block_dimension(), 1);
+   condensed_system.rhs = Vector<double>{1., 2., 3.};
+   condensed_system.solve(linear_solver);
+   for (size_t index: Range(number_variables + number_constraints)) {
+      ASSERT_NEAR(condensed_system.solution[index], full_system.solution[index], 1e-12);
+   }
+}
+
+// the inertia of the test matrices is known
+class InertiaDenseSolver: public DenseSolver {
+public:
+   InertiaDenseSolver(size_t dimension, size_t number_positive_eigenvalues): DenseSolver(dimension),
+         number_positive_eigenvalues(number_positive_eigenvalues) { }
+
+   [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override {
+      return {this->number_positive_eigenvalues, this->dimension - this->number_positive_eigenvalues, 0};
+   }
+
+protected:
+   const size_t number_positive_eigenvalues;
+};
+
+TEST(SymmetricIndefiniteLinearSystem, RuizEquilibration) {
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   // badly scaled Hessian and Jacobian
+   SymmetricMatrix<size_t, double> hessian(number_variables, 2, false, "COO");
+   hessian.insert(1e6, 0, 0);
+   hessian.insert(1e-4, 1, 1);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian[0].insert(0, 1e3);
+   constraint_jacobian[0].insert(1, 1e-2);
+   InertiaDenseSolver linear_solver(number_variables + number_constraints, number_variables);
+   const Vector<double> rhs{1., 2., 3.};
+
+   Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   WarmstartInformation warmstart_information{};
+   SymmetricIndefiniteLinearSystem<size_t, double> reference_system("COO", number_variables + number_constraints, 5, false, options);
+   reference_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   reference_system.factorize_and_regularize_matrix(statistics, linear_solver, number_variables, number_constraints, 1., warmstart_information);
+   reference_system.rhs = rhs;
+   reference_system.solve(linear_solver);
+
+   options["linear_system_scaling"] = "ruiz";
+   SymmetricIndefiniteLinearSystem<size_t, double> scaled_system("COO", number_variables + number_constraints, 5, false, options);
+   warmstart_information.whole_problem_changed();
+   scaled_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   scaled_system.factorize_and_regularize_matrix(statistics, linear_solver, number_variables, number_constraints, 1., warmstart_information);
+   // the rows of the factorized matrix have unit infinity norms
+   std::vector<double> row_norms(number_variables + number_constraints, 0.);
+   scaled_system.matrix.for_each([&](size_t row_index, size_t column_index, double element) {
+      row_norms[row_index] = std::max(row_norms[row_index], std::abs(element));
+      row_norms[column_index] = std::max(row_norms[column_index], std::abs(element));
+   });
+   for (double row_norm: row_norms) {
+      ASSERT_NEAR(row_norm, 1., 1e-2);
+   }
+   // same solution as the unscaled system
+   scaled_system.rhs = rhs;
+   scaled_system.solve(linear_solver);
+   for (size_t index: Range(number_variables + number_constraints)) {
+      ASSERT_NEAR(scaled_system.solution[index], reference_system.solution[index], 1e-10 * std::abs(reference_system.solution[index]));
+   }
+
+   options["linear_system_scaling"] = "MC64";
+   ASSERT_THROW((SymmetricIndefiniteLinearSystem<size_t, double>("COO", 3, 5, false, options)), std::invalid_argument);
+}
+
+TEST(SymmetricIndefiniteLinearSystem, MultipleRightHandSides) {
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   const size_t dimension = number_variables + number_constraints;
+   SymmetricMatrix<size_t, double> hessian(number_variables, 2, false, "COO");
+   hessian.insert(1e4, 0, 0);
+   hessian.insert(1e-2, 1, 1);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian[0].insert(0, 1e2);
+   constraint_jacobian[0].insert(1, 1.);
+   InertiaDenseSolver linear_solver(dimension, number_variables);
+   const Vector<double> multiple_rhs{1., 2., 3., -4., 5., 0.5};
+
+   Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   for (const std::string scaling: {"none", "ruiz"}) {
+      options["linear_system_scaling"] = scaling;
+      WarmstartInformation warmstart_information{};
+      SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", dimension, 5, false, options);
+      augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+      augmented_system.factorize_and_regularize_matrix(statistics, linear_solver, number_variables, number_constraints, 1., warmstart_information);
+      Vector<double> multiple_result(2 * dimension);
+      augmented_system.solve_multiple(linear_solver, multiple_rhs, multiple_result, 2);
+      // same solutions as the systems solved one by one
+      for (size_t rhs_index: Range(2)) {
+         for (size_t index: Range(dimension)) {
+            augmented_system.rhs[index] = multiple_rhs[rhs_index * dimension + index];
+         }
+         augmented_system.solve(linear_solver);
+         for (size_t index: Range(dimension)) {
+            ASSERT_NEAR(multiple_result[rhs_index * dimension + index], augmented_system.solution[index],
+               1e-10 * std::max(1., std::abs(augmented_system.solution[index])));
+         }
+      }
+      Vector<double> small_result(dimension);
+      ASSERT_THROW(augmented_system.solve_multiple(linear_solver, multiple_rhs, small_result, 2), std::invalid_argument);
+   }
+}
+
+// direct solver that does not compute the inertia
+class InertiaFreeDenseSolver: public DenseSolver {
+public:
+   explicit InertiaFreeDenseSolver(size_t dimension): DenseSolver(dimension) { }
+
+   [[nodiscard]] bool provides_inertia() const override { return false; }
+   [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override {
+      throw std::runtime_error("InertiaFreeDenseSolver does not compute the inertia");
+   }
+};
+
+TEST(SymmetricIndefiniteLinearSystem, CurvatureRegularization) {
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   const size_t dimension = number_variables + number_constraints;
+   // indefinite Hessian: the inertia of the unregularized matrix is wrong
+   SymmetricMatrix<size_t, double> hessian(number_variables, 2, false, "COO");
+   hessian.insert(1., 0, 0);
+   hessian.insert(-1e-3, 1, 1);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian[0].insert(0, 1.);
+   const Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   WarmstartInformation warmstart_information{};
+   InertiaFreeDenseSolver linear_solver(dimension);
+   ASSERT_FALSE(linear_solver.provides_inertia());
+   SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", dimension, 6, true, options);
+
+   // the direction (1, 0) has positive curvature: it is accepted without regularization
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   augmented_system.rhs = Vector<double>{1., 0., 1.};
+   augmented_system.factorize_and_regularize_by_curvature(statistics, linear_solver, number_variables, number_constraints, 1.,
+      warmstart_information);
+   ASSERT_EQ(augmented_system.get_number_factorizations(), 1);
+   ASSERT_NEAR(augmented_system.solution[0], 1., 1e-12);
+   ASSERT_NEAR(augmented_system.solution[1], 0., 1e-12);
+   // the inertia correction would have refactorized the matrix
+   DiagonalSolver inertia_solver(dimension);
+   SymmetricIndefiniteLinearSystem<size_t, double> inertia_system("COO", dimension, 6, true, options);
+   inertia_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   inertia_system.factorize_and_regularize_matrix(statistics, inertia_solver, number_variables, number_constraints, 1., warmstart_information);
+   ASSERT_LT(1, inertia_system.get_number_factorizations());
+
+   // the direction (0, -1000) has negative curvature: the Hessian is regularized until the curvature is sufficient
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   augmented_system.rhs = Vector<double>{0., 1., 0.};
+   augmented_system.factorize_and_regularize_by_curvature(statistics, linear_solver, number_variables, number_constraints, 1.,
+      warmstart_information);
+   ASSERT_LT(1, augmented_system.get_number_factorizations());
+   const double primal_regularization = augmented_system.get_primal_regularization();
+   ASSERT_LT(1e-3, primal_regularization);
+   ASSERT_NEAR(augmented_system.solution[1], 1. / (primal_regularization - 1e-3), 1e-10);
+}
+
+// records the pivoting mode requested by the augmented system
+class StaticPivotingDenseSolver: public DenseLDLTSolver {
+public:
+   explicit StaticPivotingDenseSolver(size_t dimension): DenseLDLTSolver(dimension) { }
+
+   void set_static_pivoting(bool static_pivoting) override { this->static_pivoting = static_pivoting; }
+
+   bool static_pivoting{false};
+};
+
+TEST(SymmetricIndefiniteLinearSystem, QuasiDefiniteRegularization) {
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   // convex Hessian and full-rank Jacobian: the regularized matrix is quasi-definite
+   SymmetricMatrix<size_t, double> hessian(number_variables, 2, false, "COO");
+   hessian.insert(2., 0, 0);
+   hessian.insert(3., 1, 1);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian[0].insert(0, 1.);
+   constraint_jacobian[0].insert(1, 1.);
+   const Vector<double> rhs{1., 2., 3.};
+
+   Options options = DefaultOptions::load();
+   options["iterative_refinement_max_steps"] = "10";
+   Statistics statistics(options);
+   WarmstartInformation warmstart_information{};
+   DenseLDLTSolver reference_solver(number_variables + number_constraints);
+   SymmetricIndefiniteLinearSystem<size_t, double> reference_system("COO", number_variables + number_constraints, 6, true, options);
+   reference_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   reference_system.factorize_and_regularize_matrix(statistics, reference_solver, number_variables, number_constraints, 1., warmstart_information);
+   reference_system.rhs = rhs;
+   reference_system.solve(reference_solver);
+
+   // large layer, so that its effect on the unrefined solution is visible
+   options["quasi_definite_regularization"] = "yes";
+   options["quasi_definite_primal_regularization"] = "1e-3";
+   options["quasi_definite_dual_regularization"] = "1e-3";
+   StaticPivotingDenseSolver linear_solver(number_variables + number_constraints);
+   SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", number_variables + number_constraints, 6, true, options);
+   warmstart_information.whole_problem_changed();
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, number_variables, number_constraints, warmstart_information);
+   augmented_system.factorize_and_regularize_matrix(statistics, linear_solver, number_variables, number_constraints, 1., warmstart_information);
+   // a single factorization with static pivoting and the correct inertia
+   ASSERT_EQ(augmented_system.get_number_factorizations(), 1);
+   ASSERT_TRUE(linear_solver.static_pivoting);
+   ASSERT_EQ(linear_solver.get_inertia(), std::make_tuple(number_variables, number_constraints, size_t(0)));
+
+   augmented_system.rhs = rhs;
+   augmented_system.solve(linear_solver, false);
+   double largest_error = 0.;
+   for (size_t index: Range(number_variables + number_constraints)) {
+      largest_error = std::max(largest_error, std::abs(augmented_system.solution[index] - reference_system.solution[index]));
+   }
+   ASSERT_LT(1e-6, largest_error);
+   // the refinement against the matrix without the layer recovers the solution of the original system
+   augmented_system.solve(linear_solver);
+   ASSERT_LT(0, augmented_system.get_number_refinement_steps());
+   for (size_t index: Range(number_variables + number_constraints)) {
+      ASSERT_NEAR(augmented_system.solution[index], reference_system.solution[index], 1e-10);
+   }
+
+   options["quasi_definite_dual_regularization"] = "0";
+   ASSERT_THROW((SymmetricIndefiniteLinearSystem<size_t, double>("COO", 3, 6, true, options)), std::invalid_argument);
+}
+
+// inaccurate factors: the components of the exact solution are damped
+class InaccurateDenseSolver: public InertiaDenseSolver {
+public:
+   InaccurateDenseSolver(size_t dimension, size_t number_positive_eigenvalues): InertiaDenseSolver(dimension, number_positive_eigenvalues) { }
+
+   void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override {
+      InertiaDenseSolver::solve_indefinite_system(matrix, rhs, result);
+      for (size_t index: Range(matrix.dimension())) {
+         result[index] *= 0.5 + 0.1 * static_cast<double>(index);
+      }
+   }
+};
+
+// the factors are accurate once the pivot tolerance exceeds 0.05
+class PivotToleranceDenseSolver: public InertiaDenseSolver {
+public:
+   PivotToleranceDenseSolver(size_t dimension, size_t number_positive_eigenvalues): InertiaDenseSolver(dimension, number_positive_eigenvalues) { }
+
+   void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override {
+      InertiaDenseSolver::solve_indefinite_system(matrix, rhs, result);
+      if (this->pivot_tolerance < 0.05) {
+         for (size_t index: Range(matrix.dimension())) {
+            result[index] *= 1.1;
+         }
+      }
+   }
+
+   [[nodiscard]] bool increase_pivot_tolerance() override {
+      if (0.5 <= this->pivot_tolerance) {
+         return false;
+      }
+      this->pivot_tolerance = std::min(0.5, std::pow(this->pivot_tolerance, 0.75));
+      return true;
+   }
+
+   double pivot_tolerance{0.01};
+};
+
+static void assemble_refinement_system(SymmetricIndefiniteLinearSystem<size_t, double>& augmented_system,
+      DirectSymmetricIndefiniteLinearSolver<size_t, double>& linear_solver, const Options& options) {
+   SymmetricMatrix<size_t, double> hessian(2, 2, false, "COO");
+   hessian.insert(2., 0, 0);
+   hessian.insert(3., 1, 1);
+   RectangularMatrix<double> constraint_jacobian(1, 2);
+   constraint_jacobian[0].insert(0, 1.);
+   constraint_jacobian[0].insert(1, 1.);
+   Statistics statistics(options);
+   WarmstartInformation warmstart_information{};
+   augmented_system.assemble_matrix(hessian, constraint_jacobian, 2, 1, warmstart_information);
+   augmented_system.factorize_and_regularize_matrix(statistics, linear_solver, 2, 1, 1., warmstart_information);
+   augmented_system.rhs = Vector<double>{1., 2., 3.};
+}
+
+TEST(SymmetricIndefiniteLinearSystem, FGMRESRefinement) {
+   // exact solution of [[2, 0, 1], [0, 3, 1], [1, 1, 0]] x = (1, 2, 3)
+   const Vector<double> exact_solution{1.6, 1.4, -2.2};
+   Options options = DefaultOptions::load();
+   options["iterative_refinement_max_steps"] = "3";
+   InaccurateDenseSolver linear_solver(3, 2);
+
+   // the classic refinement contracts the error slowly
+   SymmetricIndefiniteLinearSystem<size_t, double> classic_system("COO", 3, 6, false, options);
+   assemble_refinement_system(classic_system, linear_solver, options);
+   classic_system.solve(linear_solver);
+   ASSERT_EQ(classic_system.get_number_refinement_steps(), 3);
+   ASSERT_LT(1e-4, classic_system.get_residual_ratio());
+
+   // FGMRES preconditioned by the inaccurate factors converges in (at most) dimension steps
+   options["iterative_refinement_method"] = "FGMRES";
+   SymmetricIndefiniteLinearSystem<size_t, double> fgmres_system("COO", 3, 6, false, options);
+   assemble_refinement_system(fgmres_system, linear_solver, options);
+   fgmres_system.solve(linear_solver);
+   ASSERT_LE(fgmres_system.get_number_refinement_steps(), 3);
+   ASSERT_LT(fgmres_system.get_residual_ratio(), 1e-12);
+   for (size_t index: Range(3)) {
+      ASSERT_NEAR(fgmres_system.solution[index], exact_solution[index], 1e-10);
+   }
+
+   options["iterative_refinement_method"] = "Richardson";
+   ASSERT_THROW((SymmetricIndefiniteLinearSystem<size_t, double>("COO", 3, 6, false, options)), std::invalid_argument);
+}
+
+TEST(SymmetricIndefiniteLinearSystem, PivotToleranceIncrease) {
+   const Vector<double> exact_solution{1.6, 1.4, -2.2};
+   Options options = DefaultOptions::load();
+   PivotToleranceDenseSolver linear_solver(3, 2);
+   SymmetricIndefiniteLinearSystem<size_t, double> augmented_system("COO", 3, 6, false, options);
+   assemble_refinement_system(augmented_system, linear_solver, options);
+
+   // the refined solution of the inaccurate factors triggers two increases (0.01 -> 0.0316 -> 0.075)
+   augmented_system.solve_and_increase_accuracy(linear_solver);
+   ASSERT_EQ(augmented_system.get_number_pivot_tolerance_increases(), 2);
+   ASSERT_EQ(augmented_system.get_number_factorizations(), 3);
+   ASSERT_NEAR(linear_solver.pivot_tolerance, std::pow(0.01, 0.75 * 0.75), 1e-12);
+   for (size_t index: Range(3)) {
+      ASSERT_NEAR(augmented_system.solution[index], exact_solution[index], 1e-10);
+   }
+   // the solver keeps its tolerance
+   augmented_system.solve_and_increase_accuracy(linear_solver);
+   ASSERT_EQ(augmented_system.get_number_pivot_tolerance_increases(), 0);
+
+   // no increase when the threshold is 0
+   options["pivot_tolerance_residual_ratio"] = "0";
+   PivotToleranceDenseSolver other_solver(3, 2);
+   SymmetricIndefiniteLinearSystem<size_t, double> other_system("COO", 3, 6, false, options);
+   assemble_refinement_system(other_system, other_solver, options);
+   other_system.solve_and_increase_accuracy(other_solver);
+   ASSERT_EQ(other_system.get_number_pivot_tolerance_increases(), 0);
+   ASSERT_LT(0., other_system.get_residual_ratio());
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+using namespace uno;
+
+// lower triangle of a 3x3 symmetric matrix, built column by column
+static SymmetricMatrix<size_t, double> create_matrix(const std::string& sparse_format, bool use_regularization) {
+   const size_t n = 3;
+   SymmetricMatrix<size_t, double> matrix(n, 4, use_regularization, sparse_format);
+   matrix.insert(2., 0, 0);
+   matrix.insert(1., 1, 0);
+   matrix.finalize_column(0);
+   matrix.insert(3., 1, 1);
+   matrix.finalize_column(1);
+   matrix.insert(-1., 2, 2);
+   matrix.finalize_column(2);
+   return matrix;
+}
+
+TEST(SymmetricMatrix, ForEachMatchesIterator) {
+   for (const std::string sparse_format: {"COO", "CSC"}) {
+      const auto matrix = create_matrix(sparse_format, false);
+      std::vector<std::tuple<size_t, size_t, double>> iterated_terms;
+      for (const auto [row_index, column_index, element]: matrix) {
+         iterated_terms.emplace_back(row_index, column_index, element);
+      }
+      std::vector<std::tuple<size_t, size_t, double>> visited_terms;
+      matrix.for_each([&](size_t row_index, size_t column_index, double element) {
+         visited_terms.emplace_back(row_index, column_index, element);
+      });
+      ASSERT_EQ(visited_terms.size(), matrix.number_nonzeros());
+      ASSERT_EQ(visited_terms, iterated_terms);
+   }
+}
+
+TEST(SymmetricMatrix, QuadraticProduct) {
+   const Vector<double> x{1., 2., 3.};
+   // x^T M x = 2*1 + 2*1*(1*2) + 3*4 - 1*9
+   const double reference = 9.;
+   for (const std::string sparse_format: {"COO", "CSC"}) {
+      const auto matrix = create_matrix(sparse_format, false);
+      ASSERT_EQ(matrix.quadratic_product(x, x), reference);
+   }
+}
+
+TEST(SymmetricMatrix, SmallestDiagonalEntryWithRegularization) {
+   for (const std::string sparse_format: {"COO", "CSC"}) {
+      auto matrix = create_matrix(sparse_format, true);
+      matrix.set_regularization([](size_t /*index*/) { return 0.5; });
+      ASSERT_EQ(matrix.smallest_diagonal_entry(3), -0.5);
+   }
+}
+
+TEST(SymmetricMatrix, DiagonalWithDuplicates) {
+   for (const std::string sparse_format: {"COO", "CSC"}) {
+      SymmetricMatrix<size_t, double> matrix(2, 4, true, sparse_format);
+      matrix.insert(1., 0, 0);
+      matrix.insert(4., 1, 0);
+      matrix.insert(2., 0, 0);
+      matrix.finalize_column(0);
+      matrix.insert(5., 1, 1);
+      matrix.finalize_column(1);
+      matrix.set_regularization([](size_t index) { return (index == 1) ? 1. : 0.; });
+      Vector<double> diagonal(2);
+      matrix.get_diagonal(diagonal);
+      ASSERT_EQ(diagonal[0], 3.);
+      ASSERT_EQ(diagonal[1], 6.);
+      ASSERT_EQ(matrix.smallest_diagonal_entry(2), 3.);
+   }
+}
+
+TEST(SymmetricMatrix, DiagonalAfterReset) {
+   for (const std::string sparse_format: {"COO", "CSC"}) {
+      auto matrix = create_matrix(sparse_format, true);
+      matrix.reset();
+      matrix.insert(7., 0, 0);
+      matrix.finalize_column(0);
+      matrix.insert(8., 1, 1);
+      matrix.finalize_column(1);
+      matrix.insert(9., 2, 2);
+      matrix.finalize_column(2);
+      ASSERT_EQ(matrix.smallest_diagonal_entry(3), 7.);
+      matrix.set_regularization([](size_t /*index*/) { return -10.; });
+      ASSERT_EQ(matrix.smallest_diagonal_entry(3), -3.);
+   }
+}
+
+TEST(SymmetricMatrix, ShiftedInt32Indices) {
+   for (const std::string sparse_format: {"COO", "CSC"}) {
+      SymmetricMatrix<int32_t, double> matrix(3, 4, true, sparse_format, 1);
+      matrix.insert(2., 0, 0);
+      matrix.insert(1., 1, 0);
+      matrix.finalize_column(0);
+      matrix.insert(3., 1, 1);
+      matrix.finalize_column(1);
+      matrix.insert(-1., 2, 2);
+      matrix.finalize_column(2);
+      matrix.set_regularization([](size_t /*index*/) { return 0.5; });
+      // the iterators and the traversals return 0-based indices
+      std::vector<std::tuple<int32_t, int32_t, double>> iterated_terms;
+      for (const auto [row_index, column_index, element]: matrix) {
+         iterated_terms.emplace_back(row_index, column_index, element);
+      }
+      std::vector<std::tuple<int32_t, int32_t, double>> visited_terms;
+      matrix.for_each([&](int32_t row_index, int32_t column_index, double element) {
+         visited_terms.emplace_back(row_index, column_index, element);
+      });
+      ASSERT_EQ(visited_terms, iterated_terms);
+      ASSERT_EQ(matrix.smallest_diagonal_entry(3), -0.5);
+      const Vector<double> x{1., 2., 3.};
+      ASSERT_EQ(matrix.quadratic_product(x, x), 9. + 0.5 * 14.);
+   }
+}
+
+TEST(SymmetricMatrix, InsertBlockInPlace) {
+   SymmetricMatrix<int32_t, double> matrix(3, 5, true, "COO", 1);
+   const int32_t row_indices[] = {0, 0, 1, 2};
+   const int32_t column_indices[] = {0, 1, 1, 2};
+   for (double scaling: {1., 2.}) {
+      matrix.reset();
+      double* values = matrix.insert_block(row_indices, column_indices, 4);
+      ASSERT_NE(values, nullptr);
+      values[0] = 2. * scaling;
+      values[1] = 1. * scaling;
+      values[2] = 3. * scaling;
+      values[3] = -1. * scaling;
+      matrix.insert(4., 1, 1);
+      matrix.set_regularization([](size_t /*index*/) { return 0.5; });
+      ASSERT_EQ(matrix.number_nonzeros(), 3 + 4 + 1);
+      Vector<double> diagonal(3);
+      matrix.get_diagonal(diagonal);
+      ASSERT_EQ(diagonal[0], 2. * scaling + 0.5);
+      ASSERT_EQ(diagonal[1], 3. * scaling + 4. + 0.5);
+      ASSERT_EQ(diagonal[2], -1. * scaling + 0.5);
+      // the block follows the regularization terms, and the iterators return 0-based indices
+      std::vector<std::tuple<int32_t, int32_t, double>> terms;
+      for (const auto [row_index, column_index, element]: matrix) {
+         terms.emplace_back(row_index, column_index, element);
+      }
+      ASSERT_EQ(terms[3 + 1], std::make_tuple(0, 1, 1. * scaling));
+   }
+   SymmetricMatrix<size_t, double> csc_matrix(3, 4, false, "CSC");
+   const size_t csc_indices[] = {0};
+   ASSERT_EQ(csc_matrix.insert_block(csc_indices, csc_indices, 1), nullptr);
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "optimization/EvaluationCounters.hpp"
+#include "optimization/Result.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/ConcurrentTasks.hpp"
+#include "tools/ThreadPool.hpp"
+#include "QuadraticTestModel.hpp"
+#include "TestSolver.hpp"
+
+using namespace uno;
+
+class ConcurrentQuadraticTestModel: public QuadraticTestModel {
+public:
+   [[nodiscard]] bool supports_concurrent_evaluations() const override { return true; }
+};
+
+static Result solve_with_interior_point(const std::string& number_threads) {
+   Options options = test_options("ipopt");
+   options["barrier_kkt_solver"] = "MINRES";
+   options["barrier_concurrent_evaluations"] = "yes";
+   options["threads"] = number_threads;
+   return solve_reformulated_model(std::make_unique<ConcurrentQuadraticTestModel>(), options);
+}
+
+TEST(ThreadPool, ParallelForVisitsEachIndexOnce) {
+   ThreadPool pool(4, ThreadAffinity::NONE);
+   ASSERT_EQ(pool.number_threads(), 4);
+   std::vector<std::atomic<size_t>> visits(1000);
+   std::mutex mutex;
+   std::set<std::thread::id> thread_ids{};
+   pool.parallel_for(0, visits.size(), [&](size_t index) {
+      visits[index]++;
+      const std::lock_guard<std::mutex> lock(mutex);
+      thread_ids.insert(std::this_thread::get_id());
+   });
+   for (const std::atomic<size_t>& number_visits: visits) {
+      ASSERT_EQ(number_visits.load(), 1);
+   }
+   ASSERT_LE(thread_ids.size(), pool.number_threads());
+}
+
+TEST(ThreadPool, NestedParallelFor) {
+   ThreadPool pool(3, ThreadAffinity::NONE);
+   std::atomic<size_t> sum{0};
+   pool.parallel_for(0, 8, [&](size_t outer_index) {
+      // the tasks submitted by the workers go to their own queues, and are stolen by the idle threads
+      pool.parallel_for(0, 100, [&](size_t inner_index) {
+         sum += outer_index * 100 + inner_index;
+      });
+   });
+   ASSERT_EQ(sum.load(), 799 * 800 / 2);
+}
+
+TEST(ThreadPool, ErrorIsRaisedAfterAllChunks) {
+   ThreadPool pool(2, ThreadAffinity::NONE);
+   std::atomic<size_t> number_visits{0};
+   ASSERT_THROW(pool.parallel_for(0, 16, [&](size_t index) {
+      number_visits++;
+      if (index == 0) {
+         throw std::runtime_error("evaluation error");
+      }
+   }), std::runtime_error);
+   // the chunk of index 0 stops at its first index
+   ASSERT_GE(number_visits.load(), 16 - 1);
+}
+
+TEST(ThreadPool, InstalledPoolRunsTheWorkersAndTheTasks) {
+   ThreadPool pool(3, ThreadAffinity::NONE);
+   const ThreadPool::Scope scope(&pool);
+   ASSERT_EQ(ThreadPool::current(), &pool);
+   ASSERT_EQ(ThreadPool::available_threads(), 3);
+   std::vector<std::atomic<size_t>> worker_calls(3);
+   run_workers(3, [&](size_t worker_index) {
+      worker_calls[worker_index]++;
+      // the workers see the pool
+      ASSERT_EQ(ThreadPool::current(), &pool);
+   });
+   for (const std::atomic<size_t>& number_calls: worker_calls) {
+      ASSERT_EQ(number_calls.load(), 1);
+   }
+
+   EvaluationCounters counters{};
+   const EvaluationCounters::Scope counters_scope(counters);
+   run_concurrently(true,
+      []() { EvaluationCounters::current().objective_gradient++; },
+      []() { EvaluationCounters::current().constraints++; });
+   ASSERT_EQ(counters.objective_gradient, 1);
+   ASSERT_EQ(counters.constraints, 1);
+}
+
+TEST(ThreadPool, Options) {
+   Options options = DefaultOptions::load();
+   ASSERT_EQ(ThreadPool::create(options), nullptr);
+   ASSERT_EQ(ThreadPool::linear_solver_threads(options, "MUMPS_threads"), 0);
+   options["threads"] = "4";
+   const std::unique_ptr<ThreadPool> pool = ThreadPool::create(options);
+   ASSERT_NE(pool, nullptr);
+   ASSERT_EQ(pool->number_threads(), 4);
+   // the linear solvers use the threads of the pool, unless their number of threads is set
+   ASSERT_EQ(ThreadPool::linear_solver_threads(options, "MUMPS_threads"), 4);
+   options["MUMPS_threads"] = "2";
+   ASSERT_EQ(ThreadPool::linear_solver_threads(options, "MUMPS_threads"), 2);
+   options["thread_affinity"] = "everywhere";
+   ASSERT_THROW(ThreadPool::create(options), std::invalid_argument);
+}
+
+// the concurrent evaluations on the pool do not change the iterations
+TEST(ThreadPool, InteriorPointEvaluations) {
+   const Result result_without_pool = solve_with_interior_point("0");
+   const Result result_with_pool = solve_with_interior_point("3");
+   ASSERT_EQ(result_with_pool.solution.status, IterateStatus::FEASIBLE_KKT_POINT);
+   ASSERT_EQ(result_with_pool.iteration, result_without_pool.iteration);
+   ASSERT_EQ(result_with_pool.objective_gradient_evaluations, result_without_pool.objective_gradient_evaluations);
+   ASSERT_NEAR(result_with_pool.solution.primals[0], 2., 1e-6);
+   ASSERT_NEAR(result_with_pool.solution.primals[1], 3., 1e-6);
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "tools/Profiler.hpp"
+#include "tools/Timeline.hpp"
+
+using namespace uno;
+
+TEST(Timeline, ScopedTimersAreRecorded) {
+   Timeline timeline{};
+   {
+      const Timeline::Scope scope(&timeline);
+      const ScopedTimer subproblem_timer("subproblem");
+      const ScopedTimer factorization_timer("numerical \"factorization\"");
+   }
+   // without an installed timeline, nothing is recorded
+   {
+      const ScopedTimer timer("subproblem");
+   }
+   ASSERT_EQ(Timeline::current(), nullptr);
+   ASSERT_EQ(timeline.number_events(), 2);
+
+   std::ostringstream stream;
+   timeline.write(stream);
+   const std::string trace = stream.str();
+   ASSERT_NE(trace.find("\"traceEvents\""), std::string::npos);
+   ASSERT_NE(trace.find("\"name\": \"subproblem\", \"cat\": \"uno\", \"ph\": \"X\""), std::string::npos);
+   // the names are escaped
+   ASSERT_NE(trace.find("numerical \\\"factorization\\\""), std::string::npos);
+}
+
+TEST(Timeline, EventsOfSeveralThreads) {
+   Timeline timeline{};
+   {
+      const Timeline::Event event(&timeline, "solving thread");
+      std::thread worker([&]() {
+         const Timeline::Event worker_event(&timeline, "worker thread");
+      });
+      worker.join();
+   }
+   ASSERT_EQ(timeline.number_events(), 2);
+   std::thread worker([]() {
+      ASSERT_NE(Timeline::thread_id(), 0);
+   });
+   const size_t solving_thread_id = Timeline::thread_id();
+   worker.join();
+   // the ids are stable on a thread
+   ASSERT_EQ(Timeline::thread_id(), solving_thread_id);
+
+   std::ostringstream stream;
+   timeline.write(stream);
+   const std::string trace = stream.str();
+   ASSERT_NE(trace.find("\"tid\": " + std::to_string(solving_thread_id)), std::string::npos);
+   // the event of the worker is on another track
+   const size_t worker_event_start = trace.find("worker thread");
+   ASSERT_NE(worker_event_start, std::string::npos);
+   const std::string worker_event = trace.substr(worker_event_start, trace.find('\n', worker_event_start) - worker_event_start);
+   ASSERT_EQ(worker_event.find("\"tid\": " + std::to_string(solving_thread_id) + ","), std::string::npos);
+}
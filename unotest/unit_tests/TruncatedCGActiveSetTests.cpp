@@ -0,0 +1,162 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "ingredients/constraint_relaxation_strategies/OptimalityProblem.hpp"
+#include "ingredients/inequality_handling_methods/inequality_constrained_methods/TruncatedCGSubproblem.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "model/Model.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Multipliers.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+
+namespace {
+   // min 1/2 ||x - c||^2 s.t. l <= x <= u. The last variable is fixed
+   class BoxQPModel: public Model {
+   public:
+      BoxQPModel(): Model("box QP", 6, 0, 1.) { }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+         double objective = 0.;
+         for (size_t variable_index: Range(this->number_variables)) {
+            objective += 0.5 * std::pow(x[variable_index] - this->center[variable_index], 2);
+         }
+         return objective;
+      }
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         for (size_t variable_index: Range(this->number_variables)) {
+            gradient.insert(variable_index, x[variable_index] - this->center[variable_index]);
+         }
+      }
+      void evaluate_constraints(const Vector<double>& /*x*/, std::vector<double>& /*constraints*/) const override { }
+      void evaluate_constraint_gradient(const Vector<double>& /*x*/, size_t /*constraint_index*/, SparseVector<double>& /*gradient*/) const override { }
+      void evaluate_constraint_jacobian(const Vector<double>& /*x*/, RectangularMatrix<double>& /*constraint_jacobian*/) const override { }
+      void evaluate_lagrangian_hessian(const Vector<double>& /*x*/, double objective_multiplier, const Vector<double>& /*multipliers*/,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         hessian.reset();
+         for (size_t variable_index: Range(this->number_variables)) {
+            hessian.insert(objective_multiplier, variable_index, variable_index);
+            hessian.finalize_column(variable_index);
+         }
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t variable_index) const override { return (variable_index == 5) ? 0.3 : 0.; }
+      [[nodiscard]] double variable_upper_bound(size_t variable_index) const override { return (variable_index == 5) ? 0.3 : 1.; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t variable_index) const override {
+         return (variable_index == 5) ? EQUAL_BOUNDS : BOUNDED_BOTH_SIDES;
+      }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->variables_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->empty_collection; }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return -INF<double>; }
+      [[nodiscard]] double constraint_upper_bound(size_t /*constraint_index*/) const override { return INF<double>; }
+      [[nodiscard]] FunctionType get_objective_type() const override { return QUADRATIC; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return LINEAR; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return UNBOUNDED; }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->empty_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->empty_collection; }
+
+      void initial_primal_point(Vector<double>& x) const override { x.fill(0.); }
+      void initial_dual_point(Vector<double>& /*multipliers*/) const override { }
+      void postprocess_solution(Iterate& /*iterate*/, IterateStatus /*termination_status*/) const override { }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return this->number_variables; }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 0; }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return this->number_variables; }
+
+   protected:
+      const std::vector<double> center{-1., 2., 0.5, 0.25, 0.5, 0.};
+      const std::vector<size_t> variables{0, 1, 2, 3, 4, 5};
+      const std::vector<size_t> no_indices{};
+      const CollectionAdapter<std::vector<size_t>> variables_collection{this->variables};
+      const CollectionAdapter<std::vector<size_t>> empty_collection{this->no_indices};
+      const SparseVector<size_t> slacks{};
+      const Vector<size_t> fixed_variables{5};
+   };
+
+   // exposes the active-set steps of the CG iterations
+   class TruncatedCGTestSubproblem: public TruncatedCGSubproblem {
+   public:
+      using TruncatedCGSubproblem::TruncatedCGSubproblem;
+      using TruncatedCGSubproblem::determine_free_variables;
+      using TruncatedCGSubproblem::set_multipliers;
+      using TruncatedCGSubproblem::set_direction_bounds;
+      using TruncatedCGSubproblem::residual;
+      using TruncatedCGSubproblem::is_free;
+   };
+
+   // x0 and x1 are at a bound that attracts them, x3 and x4 are at their lower bound but the model pushes them inside, x5 is fixed
+   Iterate current_iterate() {
+      Iterate iterate(6, 0);
+      iterate.primals = Vector<double>{0., 1., 0.5, 0., 0., 0.3};
+      return iterate;
+   }
+} // namespace
+
+// a variable at a bound is fixed if the model gradient r = g + H d points outside the box; the bound multipliers are the components of r
+TEST(TruncatedCGActiveSet, FreeVariablesAndMultipliers) {
+   const Options options = DefaultOptions::load();
+   const BoxQPModel model;
+   const OptimalityProblem problem(model);
+   TruncatedCGTestSubproblem subproblem(6, 6, options);
+   const Iterate iterate = current_iterate();
+   subproblem.set_direction_bounds(problem, iterate);
+
+   // at d = 0: r = x - c
+   const Vector<double> primal_direction(6, 0.);
+   subproblem.residual = Vector<double>{1., -1., 0., -0.25, -0.5, 0.3};
+   // free residual (x3 and x4)
+   EXPECT_DOUBLE_EQ(subproblem.determine_free_variables(6, primal_direction), std::sqrt(0.25 * 0.25 + 0.5 * 0.5));
+   const std::vector<bool> expected_free_variables{false, false, true, true, true, false};
+   EXPECT_EQ(subproblem.is_free, expected_free_variables);
+
+   Multipliers multipliers(6, 0);
+   subproblem.set_multipliers(6, primal_direction, multipliers);
+   const std::vector<double> expected_lower_bound_multipliers{1., 0., 0., 0., 0., 0.3};
+   const std::vector<double> expected_upper_bound_multipliers{0., -1., 0., 0., 0., 0.};
+   for (size_t variable_index: Range(6)) {
+      EXPECT_EQ(multipliers.lower_bounds[variable_index], expected_lower_bound_multipliers[variable_index]) << variable_index;
+      EXPECT_EQ(multipliers.upper_bounds[variable_index], expected_upper_bound_multipliers[variable_index]) << variable_index;
+   }
+}
+
+// CG on the box QP: the direction goes to the projection of c onto the box, with the same active set
+TEST(TruncatedCGActiveSet, BoxQPDirection) {
+   const Options options = DefaultOptions::load();
+   const BoxQPModel model;
+   const OptimalityProblem problem(model);
+   TruncatedCGTestSubproblem subproblem(6, 6, options);
+   Statistics statistics(options);
+   Iterate iterate = current_iterate();
+   const Multipliers current_multipliers(6, 0);
+   Direction direction(6, 0);
+   WarmstartInformation warmstart_information{};
+   subproblem.solve(statistics, problem, iterate, current_multipliers, direction, warmstart_information);
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   const std::vector<double> expected_direction{0., 0., 0., 0.25, 0.5, 0.};
+   for (size_t variable_index: Range(6)) {
+      EXPECT_NEAR(direction.primals[variable_index], expected_direction[variable_index], 1e-12) << variable_index;
+   }
+   EXPECT_NEAR(direction.multipliers.lower_bounds[0], 1., 1e-12);
+   EXPECT_NEAR(direction.multipliers.upper_bounds[1], -1., 1e-12);
+   EXPECT_NEAR(direction.multipliers.lower_bounds[5], 0.3, 1e-12);
+   EXPECT_EQ(subproblem.is_free, std::vector<bool>({false, false, true, true, true, false}));
+   // 1/2 ||d||^2 + g^T d
+   EXPECT_NEAR(direction.subproblem_objective, 0.5 * (0.25 * 0.25 + 0.5 * 0.5) - 0.25 * 0.25 - 0.5 * 0.5, 1e-12);
+}
@@ -2,7 +2,9 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include <gtest/gtest.h>
+#include "linear_algebra/FixedVector.hpp"
 #include "linear_algebra/Vector.hpp"
+#include "symbolic/Sum.hpp"
 
 using namespace uno;
 
@@ -60,3 +62,16 @@ TEST(Vector, Swap) {
       ASSERT_EQ(element, constant_term);
    }
 }
+
+TEST(FixedVector, ExpressionAssignment) {
+   static_assert(FixedVector<double, 3>::size() == 3);
+   const FixedVector<double, 3> x{1., 2., 3.};
+   const FixedVector<double, 3> y(2.);
+   FixedVector<double, 3> z{};
+   z = x + y;
+   ASSERT_EQ(z[0], 3.);
+   ASSERT_EQ(z[2], 5.);
+   z += x;
+   ASSERT_EQ(z[1], 6.);
+   ASSERT_EQ(dot(x, y), 12.);
+}